@@ -28,6 +28,9 @@
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/OutputReporter.h>
+#include <OpenSim/Analyses/BodyKinematics.h>
+#include <OpenSim/Analyses/ForceReporter.h>
+#include <OpenSim/Analyses/StatesReporter.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Auxiliary/auxiliaryTestMuscleFunctions.h>
 
@@ -36,6 +39,14 @@ using namespace std;
 
 void testTutorialOne();
 
+// Test that processing the frames on multiple threads gives the same results
+// as processing them serially.
+void testParallelFrames();
+
+// Test that an AnalysisSet requires the highest stage required by the
+// analyses that are on.
+void testRequiredStage();
+
 // Test different default activations are respected when activation
 // states are not provided.
 void testTugOfWar(const string& dataFileName, const double& defaultAct);
@@ -49,6 +60,16 @@ int main()
         cout << e.what() << endl; failures.push_back("testTutorialOne");
     }
 
+    try { testParallelFrames(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testParallelFrames");
+    }
+
+    try { testRequiredStage(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testRequiredStage");
+    }
+
     // produce passive force-length curve
     try { testTugOfWar("Tug_of_War_ConstantVelocity.sto", 0.01); }
     catch (const std::exception& e) {
@@ -104,6 +125,52 @@ void testTutorialOne() {
     cout << "testAnalyzeTutorialOne passed" << endl;
 }
 
+void testParallelFrames() {
+    AnalyzeTool analyze("PlotterTool.xml");
+    analyze.setName("BothLegsParallel");
+    analyze.setNumThreads(4);
+    analyze.run();
+    Storage resultFiberLength(
+            "testPlotterTool/BothLegsParallel__FiberLength.sto");
+    Storage standardFiberLength("std_BothLegs_fiberLength.sto");
+    ASSERT(resultFiberLength.getSize() == standardFiberLength.getSize(),
+        __FILE__, __LINE__,
+        "testParallelFrames: number of frames does not match.");
+    CHECK_STORAGE_AGAINST_STANDARD(resultFiberLength, standardFiberLength,
+        std::vector<double>(100, 0.0001), __FILE__, __LINE__,
+        "testParallelFrames failed");
+    cout << "testParallelFrames passed" << endl;
+}
+
+void testRequiredStage() {
+    AnalysisSet analyses;
+    ASSERT(analyses.getRequiredStage() == SimTK::Stage::Position, __FILE__,
+        __LINE__, "An empty set should require only Stage::Position.");
+
+    auto* statesReporter = new StatesReporter();
+    analyses.adoptAndAppend(statesReporter);
+    ASSERT(analyses.getRequiredStage() == SimTK::Stage::Position, __FILE__,
+        __LINE__, "StatesReporter should not require Stage::Velocity.");
+
+    auto* bodyKinematics = new BodyKinematics();
+    analyses.adoptAndAppend(bodyKinematics);
+    ASSERT(analyses.getRequiredStage() == SimTK::Stage::Acceleration,
+        __FILE__, __LINE__, "BodyKinematics should require accelerations.");
+    bodyKinematics->setRecordAccelerations(false);
+    ASSERT(analyses.getRequiredStage() == SimTK::Stage::Velocity, __FILE__,
+        __LINE__, "BodyKinematics without accelerations should require "
+        "only Stage::Velocity.");
+
+    auto* forceReporter = new ForceReporter();
+    analyses.adoptAndAppend(forceReporter);
+    ASSERT(analyses.getRequiredStage() == SimTK::Stage::Dynamics, __FILE__,
+        __LINE__, "ForceReporter should require Stage::Dynamics.");
+    forceReporter->setOn(false);
+    ASSERT(analyses.getRequiredStage() == SimTK::Stage::Velocity, __FILE__,
+        __LINE__, "Analyses that are off should not be considered.");
+    cout << "testRequiredStage passed" << endl;
+}
+
 void testTugOfWar(const string& dataFileName, const double& defaultAct) {
     AnalyzeTool analyze("Tug_of_War_Setup_Analyze.xml");
     analyze.setCoordinatesFileName("");
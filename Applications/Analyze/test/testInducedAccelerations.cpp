@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Analyses/InducedAccelerations.h>
 #include <OpenSim/Analyses/InducedAccelerationsSolver.h>
 
 using namespace OpenSim;
@@ -37,6 +38,8 @@ using namespace std;
 // Prototypes
 void testDoublePendulumWithSolver();
 void testDoublePendulum();
+void testReuseFactorization(const std::string& setupFile,
+        const std::vector<std::string>& resultFiles);
 Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double Torq2, bool gravity, bool velocity);
 
 int main()
@@ -48,6 +51,9 @@ int main()
 
         // check that analysis version still works
         testDoublePendulum();
+        testReuseFactorization("double_pendulum_Setup_IAA.xml",
+            {"double_pendulum_InducedAccelerations_q1.sto",
+             "double_pendulum_InducedAccelerations_q2.sto"});
 
         AnalyzeTool analyze("subject02_Setup_IAA_02_232.xml");
         analyze.run();
@@ -57,6 +63,10 @@ int main()
             std::vector<double>(result1.getSmallestNumberOfStates(), 0.15),
             __FILE__, __LINE__, "Induced Accelerations of Running failed");
         cout << "Induced Accelerations of Running passed\n" << endl;
+
+        // The running model replaces the ground reactions with constraints
+        testReuseFactorization("subject02_Setup_IAA_02_232.xml",
+            {"subject02_running_arms_InducedAccelerations_center_of_mass.sto"});
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -160,6 +170,18 @@ void testDoublePendulumWithSolver()
         
         ASSERT_EQUAL(udot[0], udot_torq2[0], 1e-5, __FILE__, __LINE__, "Induced Accelerations of Torq2 for double pendulum q1 FAILED");
         ASSERT_EQUAL(udot[1], udot_torq2[1], 1e-5, __FILE__, __LINE__, "Induced Accelerations of Torq2 for double pendulum q2 FAILED");
+
+        // The same contribution expressed as applied mobility forces, which
+        // is back-solved with the factorization for this frame (the speeds
+        // of s are zero here).
+        Vector torques(2, 0.0);
+        torques[1] = torq2;
+        Vector_<SpatialVec> bodyForces(
+            pendulum.getMatterSubsystem().getNumBodies(),
+            SpatialVec(Vec3(0), Vec3(0)));
+        Vector udot_mob = iaaSolver.solve(s, torques, bodyForces);
+        ASSERT_EQUAL(udot[0], udot_mob[0], 1e-5, __FILE__, __LINE__, "Induced Accelerations of applied torque for double pendulum q1 FAILED");
+        ASSERT_EQUAL(udot[1], udot_mob[1], 1e-5, __FILE__, __LINE__, "Induced Accelerations of applied torque for double pendulum q2 FAILED");
     }
     cout << "Induced Accelerations Solver on double pendulum passed\n" << endl;
     cout << "Solver computed " << nt << " frames in " << 1.e3*(std::clock()-startTime)/CLOCKS_PER_SEC << "ms\n" << endl;
@@ -228,6 +250,33 @@ void testDoublePendulum()
     cout << "Analysis computed " << nt << " frames in " << 1.e3*(std::clock()-startTime)/CLOCKS_PER_SEC << "ms\n" << endl;
 }
 
+// Rerun an induced accelerations analysis, reusing the factorization of the
+// equations of motion for all contributors, and compare against the results
+// of the analysis that realizes the accelerations of every contributor.
+void testReuseFactorization(const std::string& setupFile,
+        const std::vector<std::string>& resultFiles)
+{
+    std::clock_t startTime = std::clock();
+    AnalyzeTool analyze(setupFile);
+    analyze.setResultsDir("ResultsInducedAccelerationsFactorized");
+    auto& iaa = dynamic_cast<InducedAccelerations&>(
+            analyze.updAnalysisSet().get("InducedAccelerations"));
+    iaa.setReuseFactorization(true);
+    analyze.run();
+
+    for (const auto& file : resultFiles) {
+        Storage factorized("ResultsInducedAccelerationsFactorized/" + file);
+        Storage standard("ResultsInducedAccelerations/" + file);
+        CHECK_STORAGE_AGAINST_STANDARD(factorized, standard,
+            std::vector<double>(standard.getSmallestNumberOfStates(), 1e-5),
+            __FILE__, __LINE__,
+            "Induced Accelerations reusing the factorization failed for "
+            + file);
+    }
+    cout << "Induced Accelerations reusing the factorization (" << setupFile
+         << ") passed\n" << endl;
+    cout << "Analysis computed in " << 1.e3*(std::clock()-startTime)/CLOCKS_PER_SEC << "ms\n" << endl;
+}
 
 Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double Torq2, bool gravity, bool velocity)
 {   
@@ -28,9 +28,48 @@
 using namespace OpenSim;
 using namespace std;
 
+// The reactions extracted from Model::calcMobilizerReactionForces() must match
+// those computed joint by joint.
+void testMobilizerReactionForces()
+{
+    Model model("DoublePendulum3D.osim");
+    SimTK::State& s = model.initSystem();
+    SimTK::Random::Uniform random(-1.0, 1.0);
+    random.setSeed(3);
+    for (int i = 0; i < s.getNQ(); ++i) s.updQ()[i] = random.getValue();
+    for (int i = 0; i < s.getNU(); ++i) s.updU()[i] = random.getValue();
+    model.realizeAcceleration(s);
+
+    SimTK::Vector_<SimTK::SpatialVec> reactions;
+    model.calcMobilizerReactionForces(s, reactions);
+    ASSERT(reactions.size() == model.getMatterSubsystem().getNumBodies());
+
+    for (const auto& joint : model.getComponentList<Joint>()) {
+        const SimTK::SpatialVec onChild =
+                joint.calcReactionOnChildExpressedInGround(s);
+        const SimTK::SpatialVec onParent =
+                joint.calcReactionOnParentExpressedInGround(s);
+        const SimTK::SpatialVec onChildFromBuffer =
+                joint.calcReactionOnChildExpressedInGround(s, reactions);
+        const SimTK::SpatialVec onParentFromBuffer =
+                joint.calcReactionOnParentExpressedInGround(s, reactions);
+        for (int k = 0; k < 2; ++k) {
+            ASSERT_EQUAL(onChild[k], onChildFromBuffer[k], 1e-10,
+                    __FILE__, __LINE__,
+                    "Reaction on child of " + joint.getName() + " differs.");
+            ASSERT_EQUAL(onParent[k], onParentFromBuffer[k], 1e-10,
+                    __FILE__, __LINE__,
+                    "Reaction on parent of " + joint.getName() + " differs.");
+        }
+    }
+    cout << "testMobilizerReactionForces passed" << endl;
+}
+
 int main()
 {
     try {
+        testMobilizerReactionForces();
+
         AnalyzeTool analyze("SinglePin_Setup_JointReaction.xml");
         analyze.run();
         Storage result1("SinglePin_JointReaction_ReactionLoads.sto"),
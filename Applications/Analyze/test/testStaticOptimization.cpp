@@ -46,6 +46,10 @@ void testModelWithPassiveForces();
 
 void testRelativePathInExternalLoads();
 
+void testArm26QuadraticProgramSolver();
+
+void testArm26InParallel();
+
 int main()
 {
     Array<string> muscleModelNames;
@@ -105,6 +109,22 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testArm26QuadraticProgramSolver();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26QuadraticProgramSolver");
+    }
+
+    try {
+        testArm26InParallel();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26InParallel");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +285,70 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+
+void testArm26QuadraticProgramSolver() {
+    // The active-set solver must find the same solution as the optimizer,
+    // with and without active bounds.
+    for (const std::string setup : {"arm26", "arm26_bounds"}) {
+        AnalyzeTool optimizer(setup + "_Setup_StaticOptimization.xml");
+        optimizer.setResultsDir("Results_" + setup + "_SO_Optimizer");
+        optimizer.run();
+
+        AnalyzeTool qp(setup + "_Setup_StaticOptimization.xml");
+        qp.setResultsDir("Results_" + setup + "_SO_QP");
+        auto& so = dynamic_cast<StaticOptimization&>(
+                qp.updAnalysisSet().get("StaticOptimization"));
+        so.setUseQuadraticProgramSolver(true);
+        qp.run();
+
+        Storage activations(qp.getResultsDir() + "/" + setup +
+                            "_StaticOptimization_activation.sto");
+        Storage stdActivations(optimizer.getResultsDir() + "/" + setup +
+                               "_StaticOptimization_activation.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(activations, stdActivations,
+                std::vector<double>(6, 1e-3), __FILE__, __LINE__,
+                setup + " activations with the QP solver failed.");
+
+        Storage forces(qp.getResultsDir() + "/" + setup +
+                       "_StaticOptimization_force.sto");
+        Storage stdForces(optimizer.getResultsDir() + "/" + setup +
+                          "_StaticOptimization_force.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(forces, stdForces,
+                std::vector<double>(6, 0.5), __FILE__, __LINE__,
+                setup + " forces with the QP solver failed.");
+    }
+}
+
+void testArm26InParallel() {
+    // Solving the frames in chunks on several threads gives the same results
+    // as solving them one after the other.
+    AnalyzeTool serial("arm26_Setup_StaticOptimization.xml");
+    serial.setResultsDir("Results_arm26_SO_Serial");
+    serial.run();
+
+    AnalyzeTool parallel("arm26_Setup_StaticOptimization.xml");
+    parallel.setResultsDir("Results_arm26_SO_Parallel");
+    auto& so = dynamic_cast<StaticOptimization&>(
+            parallel.updAnalysisSet().get("StaticOptimization"));
+    so.setNumThreads(3);
+    parallel.run();
+
+    Storage activations(parallel.getResultsDir() +
+                        "/arm26_StaticOptimization_activation.sto");
+    Storage stdActivations(serial.getResultsDir() +
+                           "/arm26_StaticOptimization_activation.sto");
+    ASSERT_EQUAL(stdActivations.getSize(), activations.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(activations, stdActivations,
+            std::vector<double>(6, 1e-3), __FILE__, __LINE__,
+            "Arm26 activations solved in parallel failed.");
+
+    Storage forces(parallel.getResultsDir() +
+                   "/arm26_StaticOptimization_force.sto");
+    Storage stdForces(serial.getResultsDir() +
+                      "/arm26_StaticOptimization_force.sto");
+    ASSERT_EQUAL(stdForces.getSize(), forces.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(forces, stdForces,
+            std::vector<double>(6, 0.5), __FILE__, __LINE__,
+            "Arm26 forces solved in parallel failed.");
+}
@@ -28,11 +28,15 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
 #include <OpenSim/Tools/InverseDynamicsTool.h>
+#include <OpenSim/Simulation/InverseDynamicsSolver.h>
+#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
 using namespace std;
 
+void testTrajectorySolveInParallel();
+
 int main()
 {
     try {
@@ -51,6 +55,9 @@ int main()
             std::vector<double>(23, 2.0), __FILE__, __LINE__,
             "testGait failed");
         cout << "testGait passed" << endl;
+
+        testTrajectorySolveInParallel();
+        cout << "testTrajectorySolveInParallel passed" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -59,3 +66,48 @@ int main()
     cout << "Done" << endl;
     return 0;
 }
+
+void testTrajectorySolveInParallel()
+{
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+
+    Storage coordinates("arm26_InverseKinematics.mot");
+    if (coordinates.isInDegrees()) {
+        model.getSimbodyEngine().convertDegreesToRadians(coordinates);
+    }
+    GCVSplineSet splines(5, &coordinates);
+    FunctionSet Qs;
+    for (const Coordinate* coord : model.getCoordinatesInMultibodyTreeOrder()) {
+        Qs.cloneAndAppend(splines.get(coord->getName()));
+    }
+    SimTK::Array_<double> times;
+    for (int i = 0; i < coordinates.getSize(); ++i) {
+        times.push_back(coordinates.getStateVector(i)->getTime());
+    }
+
+    InverseDynamicsSolver solver(model);
+    SimTK::Array_<SimTK::Vector> serial;
+    solver.solve(s, Qs, times, serial);
+
+    const std::vector<double> timeVector(times.begin(), times.end());
+    const TimeSeriesTable parallel = solver.solve(s, Qs, timeVector, 4);
+    ASSERT(parallel.getNumRows() == times.size());
+    ASSERT(parallel.getColumnLabel(0) == "r_shoulder_elev_moment");
+    for (int i = 0; i < (int)times.size(); ++i) {
+        ASSERT_EQUAL(times[i], parallel.getIndependentColumn()[i], 0.0);
+        for (int j = 0; j < serial[i].size(); ++j) {
+            ASSERT_EQUAL(serial[i][j], parallel.getMatrix()(i, j), 1e-10);
+        }
+    }
+
+    // The splines are also fit by the solver from a table.
+    const TimeSeriesTable fromTable =
+            solver.solve(s, coordinates.exportToTable(), 2);
+    ASSERT(fromTable.getNumRows() == times.size());
+    for (int i = 0; i < (int)times.size(); ++i) {
+        for (int j = 0; j < serial[i].size(); ++j) {
+            ASSERT_EQUAL(serial[i][j], fromTable.getMatrix()(i, j), 1e-6);
+        }
+    }
+}
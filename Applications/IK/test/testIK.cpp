@@ -83,6 +83,21 @@ int main()
             std::vector<double>(24, 0.2), __FILE__, __LINE__, 
             "testInverseKinematicsGait2354 failed");
         cout << "testInverseKinematicsGait2354 passed" << endl;
+
+        // Solving the frames in chunks on multiple threads should reproduce
+        // the serial solution, including at the seams between chunks.
+        InverseKinematicsTool ikParallel(
+                "subject01_Setup_InverseKinematics.xml");
+        ikParallel.setNumThreads(4);
+        ikParallel.setOutputMotionFileName("subject01_walk1_ik_parallel.mot");
+        ikParallel.run();
+        Storage resultParallel(ikParallel.getOutputMotionFileName());
+        ASSERT(resultParallel.getSize() == result1.getSize(), __FILE__,
+                __LINE__, "Parallel IK produced a different number of frames.");
+        CHECK_STORAGE_AGAINST_STANDARD(resultParallel, result1,
+            std::vector<double>(24, 1e-2), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 in parallel failed");
+        cout << "testInverseKinematicsGait2354 in parallel passed" << endl;
     }
     catch (const std::exception& e) {
         cout << e.what() << endl;
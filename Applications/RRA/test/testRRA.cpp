@@ -46,6 +46,23 @@ int main() {
             CHECK_STORAGE_AGAINST_STANDARD(result, standard, 
                 std::vector<double>(24, 0.5), 
                 __FILE__, __LINE__, "testRRA: kinematics comparison failed");
+
+            // A second pass that tracks the same kinematics reuses the
+            // filtered kinematics and splines prepared by the first pass.
+            ASSERT(rra.getDesiredKinematics() != nullptr, __FILE__, __LINE__,
+                "testRRA: the desired kinematics were not kept.");
+            RRATool shared("subject01_Setup_RRA.xml");
+            shared.setResultsDir("ResultsRRA_shared");
+            shared.setOutputModelFileName("subject01_RRA_adjusted_shared.osim");
+            shared.setDesiredKinematics(rra.getDesiredKinematics());
+            if (!shared.run())
+                throw(Exception("testRRA FAILED to run the shared pass."));
+            Storage sharedResult(
+                "ResultsRRA_shared/subject01_walk1_RRA_Kinematics_q.sto");
+            CHECK_STORAGE_AGAINST_STANDARD(sharedResult, result,
+                std::vector<double>(24, 1e-6),
+                __FILE__, __LINE__,
+                "testRRA: kinematics from shared desired kinematics differ");
         }
         else{
             throw(Exception("testRRA FAILED to run to completion."));
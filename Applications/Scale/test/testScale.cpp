@@ -30,6 +30,7 @@
 #include <OpenSim/Common/ScaleSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/ScaleTool.h>
+#include <OpenSim/Tools/ScaleToolBatch.h>
 #include <OpenSim/Common/MarkerData.h>
 #include <OpenSim/Simulation/Model/MarkerSet.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
@@ -52,6 +53,7 @@ using std::cout; using std::endl;
 
 void scaleGait2354();
 void scaleGait2354_GUI(bool useMarkerPlacement);
+void scaleGait2354Batch();
 void scaleModelWithLigament();
 bool compareStdScaleToComputed(const ScaleSet& std, const ScaleSet& comp);
 
@@ -66,6 +68,7 @@ int main()
     try {
         scaleGait2354();
         scaleGait2354_GUI(false);
+        scaleGait2354Batch();
         scaleModelWithLigament();
         scalePhysicalOffsetFrames();
         scaleJointsAndConstraints();
@@ -206,6 +209,43 @@ void scaleGait2354()
                            "std_subject01_simbody.osim", 1.0e-6);
 }
 
+void scaleGait2354Batch()
+{
+    std::string setupFilePath;
+
+    // Remove old results if any
+    FILE* file2Remove = IO::OpenFile(setupFilePath+"subject01_scaleSet_applied.xml", "w");
+    fclose(file2Remove);
+
+    ScaleTool subject("subject01_Setup_Scale.xml");
+    setupFilePath = subject.getPathToSubject();
+
+    // The generic model is read once by the batch rather than by the tool.
+    ScaleToolBatch batch(setupFilePath +
+            subject.getGenericModelMaker().getModelFileName());
+    batch.addSubject(subject);
+    // A subject whose files cannot be found fails without stopping the other.
+    ScaleTool missing(subject);
+    missing.setName("missing_files");
+    missing.setPathToSubject(setupFilePath + "missing_subject/");
+    batch.addSubject(missing);
+    batch.setNumThreads(2);
+    ASSERT(batch.getNumSubjects() == 2);
+
+    const auto results = batch.run();
+    ASSERT(results.size() == 2);
+    ASSERT(results[0].success);
+    ASSERT(results[0].name == subject.getName());
+    ASSERT(!results[1].success);
+    ASSERT(!results[1].errorMessage.empty());
+
+    const ScaleSet stdScaleSet(
+            setupFilePath+"std_subject01_scaleSet_applied.xml");
+    const ScaleSet computedScaleSet(
+            setupFilePath+"subject01_scaleSet_applied.xml");
+    ASSERT(compareStdScaleToComputed(stdScaleSet, computedScaleSet));
+}
+
 void scaleGait2354_GUI(bool useMarkerPlacement)
 {
     // SET OUTPUT FORMATTING
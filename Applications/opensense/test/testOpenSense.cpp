@@ -46,6 +46,34 @@ int main()
     Model stdModel{ "std_calibrated_subject07.osim" };
     ASSERT(model == stdModel);
 
+    // Computing the sensor offsets without writing a model (as for many
+    // sessions) and applying them to the uncalibrated model gives the same
+    // IMU frames.
+    {
+        IMUPlacer batchPlacer("imuPlacer.xml");
+        const auto offsets =
+                batchPlacer.computeSensorOffsets({"imuOrientations.sto"});
+        ASSERT(offsets.size() == 1);
+        STOFileAdapter_<SimTK::Quaternion>::write(
+                offsets[0], "imuOrientations_sensor_offsets.sto");
+        Model offsetModel("subject07.osim");
+        IMUPlacer::applySensorOffsets(offsetModel,
+                TimeSeriesTable_<SimTK::Quaternion>(
+                        "imuOrientations_sensor_offsets.sto"));
+        for (const auto& imuName : offsets[0].getColumnLabels()) {
+            const auto& expected =
+                    model.findComponent<PhysicalOffsetFrame>(imuName)
+                            ->getOffsetTransform();
+            const auto* actual =
+                    offsetModel.findComponent<PhysicalOffsetFrame>(imuName);
+            ASSERT(actual != nullptr);
+            ASSERT_EQUAL(expected.p(), actual->getOffsetTransform().p(),
+                    SimTK::Vec3(1e-10), __FILE__, __LINE__);
+            ASSERT((~expected.R() * actual->getOffsetTransform().R())
+                            .convertRotationToAngleAxis()[0] < 1e-8);
+        }
+    }
+
     // Calibrate model from two different standing trials facing
     // opposite directions to verify that heading correction is working
     IMUPlacer placerX("imuPlacerFaceX.xml");
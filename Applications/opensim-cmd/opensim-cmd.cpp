@@ -23,9 +23,11 @@
 
 #include "opensim-cmd_info.h"
 #include "opensim-cmd_print-xml.h"
+#include "opensim-cmd_run-batch.h"
 #include "opensim-cmd_run-tool.h"
 #include "opensim-cmd_update-file.h"
 #include "opensim-cmd_viz.h"
+#include "opensim-cmd_worker.h"
 #include "parse_arguments.h"
 #include <docopt.h>
 #include <iostream>
@@ -53,6 +55,8 @@ Options:
 
 Available commands:
   run-tool     Run a tool (e.g., Inverse Kinematics) from an XML setup file.
+  run-batch    Run the tools of a list of XML setup files.
+  worker       Run jobs from a list of setup files shared with other workers.
   print-xml    Print a template XML file for a Tool or class.
   info         Show description of properties in an OpenSim class.
   update-file  Update an .xml file (.osim or setup) to this version's format.
@@ -73,6 +77,7 @@ Description of options:
 
 Examples:
   opensim-cmd run-tool InverseDynamics_Setup.xml
+  opensim-cmd run-batch trials.txt
   opensim-cmd print-xml cmc
   opensim-cmd info PathActuator
   opensim-cmd update-file lowerlimb_v3.3.osim lowerlimb_updated.osim
@@ -94,6 +99,8 @@ int main(int argc, const char** argv) {
 
     commands["print-xml"] = print_xml;
     commands["run-tool"] = run_tool;
+    commands["run-batch"] = run_batch;
+    commands["worker"] = worker;
     commands["info"] = info;
     commands["update-file"] = update_file;
     commands["viz"] = viz;
@@ -0,0 +1,170 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  opensim-cmd_run-batch.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include <docopt.h>
+#include "opensim-cmd_run-tool.h"
+#include "parse_arguments.h"
+
+static const char HELP_RUN_BATCH[] =
+R"(Run a batch of tools from a manifest of XML setup files.
+
+Usage:
+  opensim-cmd [options]... run-batch [--stop-on-error] [--cache] <manifest-file>
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  --stop-on-error  Do not run the remaining jobs after a job fails.
+  --cache  Skip jobs whose inputs have not changed since they last ran
+           successfully with this option (see `opensim-cmd run-tool -h`).
+
+Description:
+  The manifest is a text file that lists one setup file per line (any setup
+  file accepted by `opensim-cmd run-tool`). Blank lines and lines starting
+  with '#' are ignored. Relative paths are relative to the directory
+  containing the manifest.
+
+  The jobs are run one after the other in this process, so plugins are loaded
+  and the process is started only once for the whole batch. The messages
+  logged while running a job are also written to a log file next to the
+  setup file (<setup-xml-file>.log). A job that fails does not prevent the
+  remaining jobs from running (unless --stop-on-error is given); a summary of
+  the jobs is printed at the end, and the command fails if any job failed.
+
+Examples:
+  opensim-cmd run-batch trials.txt
+  opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-batch trials.txt
+)";
+
+/// Write the messages that are logged while a job runs to the job's own log
+/// file.
+class RunBatchLogSink : public OpenSim::LogSink {
+public:
+    RunBatchLogSink(const std::string& filepath) : m_stream(filepath) {}
+    bool isOpen() const { return m_stream.is_open(); }
+protected:
+    void sinkImpl(const std::string& msg) override {
+        m_stream << msg << std::endl;
+    }
+    void flushImpl() override { m_stream.flush(); }
+private:
+    std::ofstream m_stream;
+};
+
+/// Read the setup files listed in a manifest; relative paths are made
+/// relative to the directory of the manifest. This is shared with the worker
+/// command.
+std::vector<std::string> read_manifest(const std::string& manifestFile) {
+
+    using namespace OpenSim;
+
+    std::ifstream manifest(manifestFile);
+    if (!manifest.is_open()) {
+        throw Exception("Could not open manifest file '" + manifestFile +
+                "'.");
+    }
+    const std::string manifestDir = IO::getParentDirectory(manifestFile);
+    std::vector<std::string> setupFiles;
+    std::string line;
+    while (std::getline(manifest, line)) {
+        IO::TrimWhitespace(line);
+        if (line.empty() || line[0] == '#') continue;
+        const bool isAbsolute = line[0] == '/' || line[0] == '\\' ||
+                                (line.size() > 1 && line[1] == ':');
+        setupFiles.push_back(isAbsolute ? line : manifestDir + line);
+    }
+    if (setupFiles.empty()) {
+        throw Exception("The manifest file '" + manifestFile +
+                "' does not list any setup files.");
+    }
+    return setupFiles;
+}
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    // Read the manifest.
+    const auto& manifestFile = args["<manifest-file>"].asString();
+    const std::vector<std::string> setupFiles = read_manifest(manifestFile);
+    const bool stopOnError = args["--stop-on-error"].asBool();
+    const bool useCache = args["--cache"].asBool();
+
+    // Run the jobs.
+    std::vector<bool> succeeded;
+    for (int i = 0; i < (int)setupFiles.size(); ++i) {
+        const auto& setupFile = setupFiles[i];
+        log_info("Running job {} of {}: {}.", i + 1, setupFiles.size(),
+                setupFile);
+        auto sink = std::make_shared<RunBatchLogSink>(setupFile + ".log");
+        if (sink->isOpen()) {
+            Logger::addSink(sink);
+        } else {
+            log_warn("Could not open log file '{}.log'.", setupFile);
+        }
+        bool success = false;
+        try {
+            success = run_setup_file(setupFile, useCache);
+        } catch (const std::exception& e) {
+            log_error("{}", e.what());
+        }
+        if (sink->isOpen()) Logger::removeSink(sink);
+        succeeded.push_back(success);
+        if (!success && stopOnError) break;
+    }
+
+    // Summarize.
+    int numFailed = 0;
+    log_cout("Batch summary:");
+    for (int i = 0; i < (int)setupFiles.size(); ++i) {
+        std::string status;
+        if (i >= (int)succeeded.size()) {
+            status = "skipped";
+        } else if (succeeded[i]) {
+            status = "succeeded";
+        } else {
+            status = "failed";
+            ++numFailed;
+        }
+        log_cout("  {:<9}  {}", status, setupFiles[i]);
+    }
+    log_cout("{} of {} jobs succeeded.",
+            std::count(succeeded.begin(), succeeded.end(), true),
+            setupFiles.size());
+
+    if (numFailed == 0 && succeeded.size() == setupFiles.size())
+        return EXIT_SUCCESS;
+    else return EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
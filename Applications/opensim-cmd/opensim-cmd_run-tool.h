@@ -32,12 +32,14 @@ static const char HELP_RUN_TOOL[] =
 R"(Run a tool (e.g., Inverse Kinematics) from an XML setup file.
 
 Usage:
-  opensim-cmd [options]... run-tool <setup-xml-file>
+  opensim-cmd [options]... run-tool [--cache] <setup-xml-file>
   opensim-cmd run-tool -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
   -o <level>, --log <level>  Logging level.
+  --cache  Skip the tool if its inputs have not changed since it last ran
+           successfully with this option.
 
 Description:
   The Tool to run is detected from the setup file you provide. Supported tools
@@ -56,29 +58,25 @@ Description:
 
   Use `opensim-cmd print-xml` to generate a template <setup-xml-file>.
 
+  With --cache, content hashes of the setup and of the files named in the
+  setup (model, data and result files) are recorded in
+  <setup-xml-file>.cache after a successful run. The next run with --cache
+  is skipped if none of the hashes changed; otherwise, the changed inputs
+  are logged and the tool runs again. Delete the .cache file to force a run.
+
 Examples:
   opensim-cmd run-tool CMC_setup.xml
   opensim-cmd -L C:\Plugins\osimMyCustomForce.dll run-tool CMC_setup.xml
   opensim-cmd --library ../plugins/libosimMyPlugin.so run-tool Forward_setup.xml
   opensim-cmd --library=libosimMyCustomForce.dylib run-tool CMC_setup.xml
+  opensim-cmd run-tool --cache IK_setup.xml
 )";
 
-int run_tool(int argc, const char** argv) {
+/// Detect the kind of tool defined by the deserialized setup file and run it.
+bool run_setup_object(OpenSim::Object* obj, const std::string& setupFile) {
 
     using namespace OpenSim;
 
-    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
-            HELP_RUN_TOOL, { argv + 1, argv + argc },
-            true); // show help if requested
-
-    // Deserialize.
-    const auto& setupFile = args["<setup-xml-file>"].asString();
-    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
-    if (obj == nullptr) {
-        throw Exception( "A problem occurred when trying to load file '" +
-                setupFile + "'.");
-    }
-
     // Detect and run the tool.
     if (auto* tool = dynamic_cast<AbstractTool*>(obj.get())) {
         // AbstractTool.
@@ -101,32 +99,71 @@ int run_tool(int argc, const char** argv) {
                      "constructed properly.");
             concreteTool.reset(tool->clone());
         }
-        const bool success = concreteTool->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return concreteTool->run();
     } else if (auto* tool = dynamic_cast<Tool*>(obj.get())) {
         // Tool.
         log_info("Preparing to run {}.", tool->getConcreteClassName());
-        const bool success = tool->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return tool->run();
     } else if (auto* scale = dynamic_cast<ScaleTool*>(obj.get())) {
         // ScaleTool.
         log_info("Preparing to run {}.", scale->getConcreteClassName());
-        const bool success = scale->run();
-        if (success) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return scale->run();
     } else if (auto* study = dynamic_cast<MocoStudy*>(obj.get())) {
         log_info("Preparing to run {}.", study->getConcreteClassName());
         const auto solution = study->solve();
-        if (solution.success()) return EXIT_SUCCESS;
-        else return EXIT_FAILURE;
+        return solution.success();
 
     } else {
         throw Exception("The provided file '" + setupFile + "' does not "
                 "define an OpenSim Tool. Did you intend to load a plugin?");
     }
-    return EXIT_FAILURE;
+    return false;
+}
+
+/// Detect the kind of tool defined in the setup file and run it. Returns
+/// whether the tool succeeded. If useCache is true, the tool is skipped
+/// (and counts as succeeded) if its inputs have not changed since its last
+/// successful run. This is shared with the run-batch command.
+bool run_setup_file(const std::string& setupFile, bool useCache = false) {
+
+    using namespace OpenSim;
+
+    // Deserialize.
+    auto obj = std::unique_ptr<Object>(Object::makeObjectFromFile(setupFile));
+    if (obj == nullptr) {
+        throw Exception( "A problem occurred when trying to load file '" +
+                setupFile + "'.");
+    }
+
+    if (!useCache) return run_setup_object(obj.get(), setupFile);
+
+    const ToolResultCache cache(*obj, setupFile + ".cache");
+    const std::vector<std::string> changed = cache.findChangedStages();
+    if (changed.empty()) {
+        log_info("Skipping '{}': its inputs have not changed since it last "
+                 "ran (see '{}').", setupFile, cache.getCacheFile());
+        return true;
+    }
+    std::string stages;
+    for (const auto& stage : changed) {
+        stages += (stages.empty() ? "" : ", ") + stage;
+    }
+    log_info("Inputs that changed since the last cached run: {}.", stages);
+    const bool success = run_setup_object(obj.get(), setupFile);
+    if (success) cache.write();
+    return success;
+}
+
+int run_tool(int argc, const char** argv) {
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_TOOL, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const auto& setupFile = args["<setup-xml-file>"].asString();
+    if (run_setup_file(setupFile, args["--cache"].asBool()))
+        return EXIT_SUCCESS;
+    else return EXIT_FAILURE;
 }
 
 #endif // OPENSIM_CMD_RUN_TOOL_H_
@@ -23,6 +23,8 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 
 #include <docopt.h>
@@ -33,11 +35,15 @@ R"(Update an .osim, .xml (e.g., setup) or .sto file to this version's format.
 
 Usage:
   opensim-cmd [options]... update-file <input-file> <output-file>
+  opensim-cmd [options]... update-file --in-place [--force] [--jobs=<n>] <file>...
   opensim-cmd update-file -h | --help
 
 Options:
   -L <path>, --library <path>  Load a plugin.
   -o <level>, --log <level>  Logging level.
+  --in-place  Update each of the given files, replacing the original file.
+  --force  With --in-place, also rewrite files that are at the latest version.
+  --jobs=<n>  With --in-place, the number of files updated at once [default: 1].
 
 Description:
   In an OpenSim XML file, the XML file format version appears as
@@ -45,22 +51,53 @@ Description:
   version number is generally not the same as the OpenSim software version
   number.
 
+  With --in-place, any number of files can be updated (e.g., all files of an
+  archive, listed by your shell or with find and xargs). Only the beginning
+  of each file is read to find its version (the "Version" attribute of an XML
+  file, or the "version=" line of an .sto header), and files that are already
+  at the latest version are skipped unless --force is given. Each file is
+  written to a temporary file first, so a file is never left half written.
+  A summary is printed at the end, and the command fails if any file could
+  not be updated.
+
 Examples:
   opensim-cmd update-file lowerlimb_v3.3.osim lowerlimb_updated.osim
   opensim-cmd update-file RRA_taskset_v3.3.xml RRA_taskset_updated.osim
   opensim-cmd update-file data_v3.3.sto data_updated.sto
+  opensim-cmd update-file --in-place --jobs=8 archive/*/*.osim
 )";
 
-int update_file(int argc, const char** argv) {
+/// Get the format version of a file by reading only the beginning of the
+/// file. Returns -1 if the version could not be found.
+int read_file_version(const std::string& file, const std::string& extension) {
+    std::ifstream stream(file);
+    if (!stream.is_open()) return -1;
+    if (extension == ".sto") {
+        // The version is in the header, which ends with "endheader".
+        std::string line;
+        while (std::getline(stream, line) && line != "endheader") {
+            if (line.compare(0, 8, "version=") == 0) {
+                return std::atoi(line.c_str() + 8);
+            }
+        }
+        return -1;
+    }
+    // The OpenSimDocument element is at the top of the file.
+    char buffer[4096];
+    stream.read(buffer, sizeof(buffer));
+    const std::string start(buffer, (std::size_t)stream.gcount());
+    const auto document = start.find("<OpenSimDocument");
+    if (document == std::string::npos) return -1;
+    const auto version = start.find("Version=\"", document);
+    if (version == std::string::npos) return -1;
+    return std::atoi(start.c_str() + version + 9);
+}
 
-    using namespace OpenSim;
+/// Update one file to the latest format.
+void update_one_file(
+        const std::string& inputFile, const std::string& outputFile) {
 
-    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
-            HELP_UPDATE_FILE, { argv + 1, argv + argc },
-            true); // show help if requested
-
-    const std::string inputFile = args["<input-file>"].asString();
-    const std::string outputFile = args["<output-file>"].asString();
+    using namespace OpenSim;
 
     // Grab the file extension.
     std::string::size_type extSep = inputFile.rfind(".");
@@ -73,7 +110,7 @@ int update_file(int argc, const char** argv) {
     // .osim or .xml file.
     if (extension == ".osim" || extension == ".xml") {
         log_info("Loading input file '{}'.", inputFile);
-        const auto* obj = Object::makeObjectFromFile(inputFile);
+        std::unique_ptr<Object> obj(Object::makeObjectFromFile(inputFile));
         if (!obj) {
             throw Exception(
                     "Could not make object from file '" + inputFile + "'.\n"
@@ -81,7 +118,7 @@ int update_file(int argc, const char** argv) {
         }
         log_info("Printing updated file to '{}'.", outputFile);
         obj->print(outputFile);
-        return EXIT_SUCCESS;
+        return;
     }
 
     // .sto file.
@@ -90,12 +127,77 @@ int update_file(int argc, const char** argv) {
         Storage stg(inputFile);
         log_info("Printing updated file to '{}'.", outputFile);
         stg.print(outputFile);
-        return EXIT_SUCCESS;
+        return;
     }
 
     throw Exception(
             "Input file '" + inputFile + "' has an unrecognized extension.");
 }
 
+/// Update many files in place, skipping those at the latest version.
+int update_files_in_place(const std::vector<std::string>& files, bool force,
+        int numJobs) {
+
+    using namespace OpenSim;
+
+    enum Status { Skipped, Updated, Failed };
+    std::vector<Status> status(files.size(), Failed);
+    parallelFor((int)files.size(), [&](int i) {
+        const std::string& file = files[i];
+        try {
+            const auto extSep = file.rfind(".");
+            const std::string extension =
+                    extSep == std::string::npos ? "" : file.substr(extSep);
+            const int latest = extension == ".sto"
+                    ? Storage::getLatestVersion()
+                    : XMLDocument::getLatestVersion();
+            if (!force && read_file_version(file, extension) == latest) {
+                log_info("Skipping '{}', which is at the latest version.",
+                        file);
+                status[i] = Skipped;
+                return;
+            }
+            // Keep the extension, which selects the file format.
+            const std::string tempFile = file + ".updating" + extension;
+            update_one_file(file, tempFile);
+            std::remove(file.c_str());
+            if (std::rename(tempFile.c_str(), file.c_str()) != 0) {
+                throw Exception("Could not replace '" + file + "' with '" +
+                        tempFile + "'.");
+            }
+            status[i] = Updated;
+        } catch (const std::exception& e) {
+            log_error("Could not update '{}': {}", file, e.what());
+        }
+    }, numJobs);
+
+    const auto count = [&](Status s) {
+        return std::count(status.begin(), status.end(), s);
+    };
+    log_cout("Updated {} files; skipped {} files at the latest version; "
+             "{} files failed.", count(Updated), count(Skipped),
+            count(Failed));
+    return count(Failed) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int update_file(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_UPDATE_FILE, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    if (args["--in-place"].asBool()) {
+        return update_files_in_place(args["<file>"].asStringList(),
+                args["--force"].asBool(),
+                std::stoi(args["--jobs"].asString()));
+    }
+
+    update_one_file(args["<input-file>"].asString(),
+            args["<output-file>"].asString());
+    return EXIT_SUCCESS;
+}
+
 
 #endif // OPENSIM_CMD_UPDATE_FILE_H_
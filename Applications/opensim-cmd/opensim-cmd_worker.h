@@ -0,0 +1,176 @@
+#ifndef OPENSIM_CMD_WORKER_H_
+#define OPENSIM_CMD_WORKER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  opensim-cmd_worker.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <thread>
+
+#include <docopt.h>
+#include "opensim-cmd_run-batch.h"
+#include "parse_arguments.h"
+
+static const char HELP_WORKER[] =
+R"(Run the jobs of a manifest that is shared with other workers.
+
+Usage:
+  opensim-cmd [options]... worker [--cache] [--id=<id>] [--max-jobs=<n>] [--wait=<seconds>] <manifest-file>
+  opensim-cmd worker -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  --cache  Skip jobs whose inputs have not changed since they last ran.
+  --id=<id>  Name of this worker in the claim and report files.
+  --max-jobs=<n>  Stop after running this many jobs.
+  --wait=<seconds>  Keep looking for new jobs for this long [default: 0].
+
+Description:
+  The manifest has the same format as for `opensim-cmd run-batch`: one setup
+  file per line (any setup file accepted by `opensim-cmd run-tool`, such as an
+  AnalyzeTool setup or a MocoStudy). Any number of workers, on this machine
+  or on other machines that share the file system, can run jobs from the
+  same manifest at the same time; lines can be appended to the manifest while
+  the workers run.
+
+  A worker claims a job by creating <setup-xml-file>.claim, which fails if
+  another worker has already claimed the job, so each job runs only once.
+  While a job runs, its messages are written to <setup-xml-file>.log. After
+  the job, the worker writes <setup-xml-file>.report with the status of the
+  job, the worker's name, and when the job started and how long it took.
+  To run a job again (e.g., after a worker was stopped while running it),
+  delete its .claim file.
+
+  The worker stops when all jobs are claimed (after waiting --wait seconds
+  for new jobs) or after --max-jobs jobs. The command fails if any of the
+  jobs run by this worker failed. The default name of a worker is the host
+  name followed by a random number.
+
+Examples:
+  opensim-cmd worker sweep.txt
+  opensim-cmd worker --wait=600 --id=node12 /shared/sweep/sweep.txt
+)";
+
+/// Claim the job by creating its claim file; fails if the file exists.
+bool claim_job(const std::string& setupFile, const std::string& workerId) {
+    // The "x" mode makes creating the file fail if it already exists (as in
+    // O_CREAT | O_EXCL).
+    FILE* claim = std::fopen((setupFile + ".claim").c_str(), "wx");
+    if (!claim) return false;
+    std::fprintf(claim, "%s\n", workerId.c_str());
+    std::fclose(claim);
+    return true;
+}
+
+std::string default_worker_id() {
+    const char* host = std::getenv("HOSTNAME");
+    if (!host) host = std::getenv("COMPUTERNAME");
+    std::random_device device;
+    return std::string(host ? host : "worker") + "-" +
+           std::to_string(device() % 1000000);
+}
+
+int worker(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_WORKER, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    const auto& manifestFile = args["<manifest-file>"].asString();
+    const bool useCache = args["--cache"].asBool();
+    const std::string workerId =
+            args["--id"] ? args["--id"].asString() : default_worker_id();
+    const int maxJobs = args["--max-jobs"]
+            ? std::stoi(args["--max-jobs"].asString()) : -1;
+    const double wait = std::stod(args["--wait"].asString());
+
+    using Clock = std::chrono::steady_clock;
+    int numRun = 0;
+    int numFailed = 0;
+    auto lastClaim = Clock::now();
+    log_info("Worker {} started.", workerId);
+    while (maxJobs < 0 || numRun < maxJobs) {
+        // Read the manifest again each time, as jobs may have been added.
+        bool claimed = false;
+        for (const auto& setupFile : read_manifest(manifestFile)) {
+            if (maxJobs >= 0 && numRun >= maxJobs) break;
+            if (!claim_job(setupFile, workerId)) continue;
+            claimed = true;
+
+            log_info("Worker {} is running {}.", workerId, setupFile);
+            auto sink = std::make_shared<RunBatchLogSink>(setupFile + ".log");
+            if (sink->isOpen()) {
+                Logger::addSink(sink);
+            } else {
+                log_warn("Could not open log file '{}.log'.", setupFile);
+            }
+            const std::time_t startTime = std::time(nullptr);
+            const auto start = Clock::now();
+            bool success = false;
+            try {
+                success = run_setup_file(setupFile, useCache);
+            } catch (const std::exception& e) {
+                log_error("{}", e.what());
+            }
+            const double duration =
+                    std::chrono::duration<double>(Clock::now() - start)
+                            .count();
+            if (sink->isOpen()) Logger::removeSink(sink);
+
+            char startString[32];
+            std::strftime(startString, sizeof(startString),
+                    "%Y-%m-%d %H:%M:%S", std::localtime(&startTime));
+            std::ofstream report(setupFile + ".report");
+            report << "status: " << (success ? "succeeded" : "failed") << "\n"
+                   << "worker: " << workerId << "\n"
+                   << "start: " << startString << "\n"
+                   << "duration: " << duration << " s\n";
+            log_info("Worker {} {} {} in {:.3f} s.", workerId,
+                    success ? "finished" : "failed", setupFile, duration);
+
+            ++numRun;
+            if (!success) ++numFailed;
+        }
+        if (claimed) {
+            lastClaim = Clock::now();
+            continue;
+        }
+        if (std::chrono::duration<double>(Clock::now() - lastClaim).count()
+                >= wait) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    log_cout("Worker {} ran {} jobs; {} failed.", workerId, numRun,
+            numFailed);
+    return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // OPENSIM_CMD_WORKER_H_
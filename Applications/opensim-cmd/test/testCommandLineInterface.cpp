@@ -22,8 +22,11 @@
  * -------------------------------------------------------------------------- */
 
 #include <SimTKcommon/Testing.h>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <regex>
 // We do *not* include OpenSim headers, since we are only interacting with
@@ -349,6 +352,116 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run a batch of tools ");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("run-batch putes.txt", EXIT_FAILURE,
+            ContainsSubstring("Could not open manifest file 'putes.txt'."));
+    {
+        std::ofstream manifest("testrunbatch_empty.txt");
+        manifest << "# No setup files.\n\n";
+    }
+    testCommand("run-batch testrunbatch_empty.txt", EXIT_FAILURE,
+            ContainsSubstring("does not list any setup files."));
+
+    // A failing job does not stop the remaining jobs.
+    // ================================================
+    testCommand("print-xml Model testrunbatch_Model.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testrunbatch_Model.xml'.\n"));
+    testCommand("print-xml scale testrunbatch_scale_setup.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testrunbatch_scale_setup.xml'.\n"));
+    {
+        std::ofstream manifest("testrunbatch_manifest.txt");
+        manifest << "# Each job fails.\n"
+                 << "testrunbatch_Model.xml\n"
+                 << "\n"
+                 << "  testrunbatch_scale_setup.xml\n";
+    }
+    testCommand("run-batch testrunbatch_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "(Running job 1 of 2: testrunbatch_Model.xml)" +
+                       RE_ANY + "(does not define an OpenSim Tool)" +
+                       RE_ANY + "(Running job 2 of 2: " +
+                       "testrunbatch_scale_setup.xml)" + RE_ANY +
+                       "(0 of 2 jobs succeeded.)" + RE_ANY));
+    // Each job gets its own log file.
+    SimTK_TEST(std::ifstream("testrunbatch_Model.xml.log").good());
+    testCommand("run-batch --stop-on-error testrunbatch_manifest.txt",
+            EXIT_FAILURE,
+            std::regex(RE_ANY + "(skipped    testrunbatch_scale_setup.xml)" +
+                       RE_ANY));
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("run-batch");
+}
+
+void testWorker() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run the jobs of a manifest ");
+        testCommand("worker -h", EXIT_SUCCESS, output);
+        testCommand("worker -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("worker", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("worker putes.txt", EXIT_FAILURE,
+            ContainsSubstring("Could not open manifest file 'putes.txt'."));
+
+    // Each job is claimed and run once.
+    // =================================
+    testCommand("print-xml Model testworker_Model.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testworker_Model.xml'.\n"));
+    testCommand("print-xml scale testworker_scale_setup.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testworker_scale_setup.xml'.\n"));
+    std::remove("testworker_Model.xml.claim");
+    std::remove("testworker_scale_setup.xml.claim");
+    {
+        std::ofstream manifest("testworker_manifest.txt");
+        manifest << "testworker_Model.xml\n"
+                 << "testworker_scale_setup.xml\n";
+    }
+    // This worker stops after one job.
+    testCommand("worker --id=w1 --max-jobs=1 testworker_manifest.txt",
+            EXIT_FAILURE,
+            std::regex(RE_ANY + "(Worker w1 is running testworker_Model.xml)" +
+                       RE_ANY + "(Worker w1 ran 1 jobs; 1 failed.)" + RE_ANY));
+    {
+        std::ifstream report("testworker_Model.xml.report");
+        std::string status, worker;
+        std::getline(report, status);
+        std::getline(report, worker);
+        SimTK_TEST(status == "status: failed");
+        SimTK_TEST(worker == "worker: w1");
+    }
+    // The first job is claimed, so the next worker runs only the second job.
+    testCommand("worker --id=w2 testworker_manifest.txt", EXIT_FAILURE,
+            std::regex(RE_ANY + "(Worker w2 is running " +
+                       "testworker_scale_setup.xml)" + RE_ANY +
+                       "(Worker w2 ran 1 jobs; 1 failed.)" + RE_ANY));
+    SimTK_TEST(std::ifstream("testworker_scale_setup.xml.log").good());
+    // Nothing is left to run.
+    testCommand("worker --id=w3 testworker_manifest.txt", EXIT_SUCCESS,
+            ContainsSubstring("Worker w3 ran 0 jobs; 0 failed."));
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("worker");
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -485,6 +598,39 @@ void testUpdateFile() {
                            RE_ANY + "(Printing updated file to "
                            "'testupdatefile_Model_updated.osim'.\n)" + RE_ANY));
 
+    // Updating many files in place.
+    // =============================
+    testCommand("update-file --in-place testupdatefile_Model.osim "
+                "testupdatefile_Model_updated.osim", EXIT_SUCCESS,
+            std::regex(RE_ANY + "(Skipping 'testupdatefile_Model.osim', which "
+                       "is at the latest version.)" + RE_ANY + "(Updated 0 "
+                       "files; skipped 2 files at the latest version; 0 "
+                       "files failed.)" + RE_ANY));
+    testCommand("update-file --in-place --force --jobs=2 "
+                "testupdatefile_Model.osim testupdatefile_Model_updated.osim",
+            EXIT_SUCCESS, ContainsSubstring("Updated 2 files; skipped 0 "
+                                            "files"));
+    {
+        // Pretend that the file has an older version.
+        std::string content;
+        {
+            std::ifstream in("testupdatefile_Model.osim");
+            content.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+        }
+        const auto version = content.find("Version=\"");
+        SimTK_TEST(version != std::string::npos);
+        content.replace(version, 14, "Version=\"30000");
+        std::ofstream("testupdatefile_Model_old.osim") << content;
+    }
+    testCommand("update-file --in-place testupdatefile_Model_old.osim "
+                "testupdatefile_x.osim", EXIT_FAILURE,
+            std::regex(RE_ANY + "(Could not update 'testupdatefile_x.osim')" +
+                       RE_ANY + "(Updated 1 files; skipped 0 files at the "
+                       "latest version; 1 files failed.)" + RE_ANY));
+    testCommand("update-file --in-place testupdatefile_Model_old.osim",
+            EXIT_SUCCESS, ContainsSubstring("Updated 0 files; skipped 1"));
+
     // Library option.
     // ===============
     testLoadPluginLibraries("update-file");
@@ -494,6 +640,8 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
+        SimTK_SUBTEST(testWorker);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
@@ -156,6 +156,13 @@ public:
         for (int i = 0; i < size(); ++i) { ret[i][0] = get(i); }
         return ret;
     }
+    /** A DoubleBuffer that shares memory with this vector (no copy). Writing
+    to the buffer modifies the vector. The buffer is invalid once the vector
+    is resized or destroyed, and the vector must have contiguous data. */
+    public java.nio.DoubleBuffer asDoubleBuffer() {
+        return _getDirectByteBuffer()
+                .order(java.nio.ByteOrder.nativeOrder()).asDoubleBuffer();
+    }
 %}
 
 %typemap(javacode) SimTK::Vector_<double> %{
@@ -268,7 +275,49 @@ public:
         }
         return ret;
     }
+    /** A DoubleBuffer that shares memory with this matrix (no copy). The
+    elements are stored column by column: element (i, j) is at index
+    i + j * nrow(). Writing to the buffer modifies the matrix. The buffer is
+    invalid once the matrix is resized or destroyed (for a DataTable, once
+    rows or columns are added or removed), and the matrix must have
+    contiguous data (DataTable.getMatrix() does). */
+    public java.nio.DoubleBuffer asDoubleBuffer() {
+        return _getDirectByteBuffer()
+                .order(java.nio.ByteOrder.nativeOrder()).asDoubleBuffer();
+    }
+%}
+
+// Zero-copy access to the memory of vectors and matrices through
+// java.nio.ByteBuffer (see asDoubleBuffer() above).
+%{
+struct SimTKDirectByteBuffer {
+    void* data;
+    jlong numBytes;
+};
 %}
+%typemap(jni) SimTKDirectByteBuffer "jobject"
+%typemap(jtype) SimTKDirectByteBuffer "java.nio.ByteBuffer"
+%typemap(jstype) SimTKDirectByteBuffer "java.nio.ByteBuffer"
+%typemap(javaout) SimTKDirectByteBuffer { return $jnicall; }
+%typemap(out) SimTKDirectByteBuffer {
+    $result = jenv->NewDirectByteBuffer($1.data, $1.numBytes);
+}
+%extend SimTK::VectorBase<double> {
+    SimTKDirectByteBuffer _getDirectByteBuffer() {
+        if (!$self->hasContiguousData())
+            throw std::runtime_error("Vector data is not contiguous.");
+        return {$self->updContiguousScalarData(),
+                (jlong)($self->size() * sizeof(double))};
+    }
+}
+%extend SimTK::MatrixBase<double> {
+    SimTKDirectByteBuffer _getDirectByteBuffer() {
+        if (!$self->hasContiguousData())
+            throw std::runtime_error("Matrix data is not contiguous.");
+        return {$self->updContiguousScalarData(),
+                (jlong)($self->nelt() * sizeof(double))};
+    }
+}
 
 %typemap(javacode) SimTK::Matrix_<double> %{
     public static Matrix createFromMat(double[][] data) {
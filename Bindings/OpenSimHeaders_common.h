@@ -10,6 +10,7 @@
 #include <OpenSim/Common/AbstractProperty.h>
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/ArrayPtrs.h>
+#include <OpenSim/Common/BinaryFileAdapter.h>
 #include <OpenSim/Common/C3DFileAdapter.h>
 #include <OpenSim/Common/CSVFileAdapter.h>
 #include <OpenSim/Common/CommonUtilities.h>
@@ -36,6 +36,7 @@
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
 #include <OpenSim/Tools/IMUInverseKinematicsTool.h>
+#include <OpenSim/Tools/ToolResultCache.h>
 
 
 #endif // OPENSIM_OPENSIM_HEADERS_TOOLS_H_
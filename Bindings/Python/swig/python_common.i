@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") common
+%module(package="opensim", directors="1", threads="1") common
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -289,6 +289,18 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+%extend OpenSim::DataTable_<double, double> {
+%pythoncode %{
+    def getMatrixNumPyView(self):
+        """Return the data of this table as a NumPy array (rows are times,
+        columns are column labels) that shares memory with the table, so no
+        data is copied. Writing to the array modifies the table. The array is
+        invalid once rows or columns are added to or removed from the table.
+        Use getMatrix().to_numpy() for an independent copy."""
+        return self.updMatrix().to_numpy_view(owner=self)
+%}
+}
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
@@ -1,5 +1,4 @@
-%module(package="opensim", directors="1") moco
-// %module(package="opensim", directors="1", threads="1") moco
+%module(package="opensim", directors="1", threads="1") moco
 #pragma SWIG nowarn=822,451,503,516,325
 #pragma SWIG nowarn=401
 
@@ -391,6 +390,21 @@ using namespace SimTK;
         self._getDerivativesTrajectoryMat(mat)
         return mat
 
+    def getStatesTrajectoryNumPyView(self):
+        """Return the states trajectory as a NumPy array that shares memory
+        with this MocoTrajectory (no copy). The array is invalid once the
+        trajectory is resized (e.g., by setNumTimes() or insertStatesTrajectory())."""
+        return self.getStatesTrajectory().to_numpy_view(owner=self)
+    def getControlsTrajectoryNumPyView(self):
+        """See getStatesTrajectoryNumPyView()."""
+        return self.getControlsTrajectory().to_numpy_view(owner=self)
+    def getMultipliersTrajectoryNumPyView(self):
+        """See getStatesTrajectoryNumPyView()."""
+        return self.getMultipliersTrajectory().to_numpy_view(owner=self)
+    def getDerivativesTrajectoryNumPyView(self):
+        """See getStatesTrajectoryNumPyView()."""
+        return self.getDerivativesTrajectory().to_numpy_view(owner=self)
+
 %};
 }
 
@@ -25,6 +25,36 @@ own project.
 // For reference (doesn't work and should not be necessary):
 // %rename(__add__) operator+;
 
+// Releasing the GIL
+// =================
+/*
+The modules are built with threads="1" so that calls from C++ into Python
+(directors such as LogSink and AnalysisWrapper) acquire the GIL. By default,
+wrapped calls keep holding the GIL, since most calls are short and releasing
+it has a cost. The long-running calls below release the GIL, so that other
+Python threads (e.g., other simulations or I/O) can run in the meantime.
+Objects passed to these calls must not be used by other threads while the call
+runs.
+*/
+%feature("nothreadallow");
+%define OSIM_RELEASE_GIL(NAME)
+%feature("nothreadallow", "0") NAME;
+%enddef
+OSIM_RELEASE_GIL(OpenSim::Model::initSystem);
+OSIM_RELEASE_GIL(OpenSim::Manager::integrate);
+OSIM_RELEASE_GIL(OpenSim::simulate);
+OSIM_RELEASE_GIL(OpenSim::AnalyzeTool::run);
+OSIM_RELEASE_GIL(OpenSim::CMCTool::run);
+OSIM_RELEASE_GIL(OpenSim::ForwardTool::run);
+OSIM_RELEASE_GIL(OpenSim::IMUInverseKinematicsTool::run);
+OSIM_RELEASE_GIL(OpenSim::InverseDynamicsTool::run);
+OSIM_RELEASE_GIL(OpenSim::InverseKinematicsTool::run);
+OSIM_RELEASE_GIL(OpenSim::RRATool::run);
+OSIM_RELEASE_GIL(OpenSim::ScaleTool::run);
+OSIM_RELEASE_GIL(OpenSim::MocoStudy::solve);
+OSIM_RELEASE_GIL(OpenSim::MocoInverse::solve);
+OSIM_RELEASE_GIL(OpenSim::MocoTrack::solve);
+
 // Rename
 // ======
 %rename(NoType) OpenSim::Geometry::None;
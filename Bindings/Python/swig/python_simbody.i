@@ -1,4 +1,4 @@
-%module(package="opensim", directors="1") simbody
+%module(package="opensim", directors="1", threads="1") simbody
 #pragma SWIG nowarn=822,451,503,516,325
 // 401 is "Nothing known about base class *some-class*.
 //         Maybe you forgot to instantiate *some-template* using %template."
@@ -200,9 +200,32 @@ namespace SimTK {
                              $self->size());
         std::copy_n($self->getContiguousScalarData(), n, numpyout);
     }
+    size_t _numpy_view_address() {
+        return $self->size() ? (size_t)&$self->updElt(0, 0) : 0;
+    }
+    int _numpy_view_stride() const {
+        if ($self->size() < 2) return (int)sizeof(double);
+        return (int)((const char*)&$self->getElt(1, 0) -
+                     (const char*)&$self->getElt(0, 0));
+    }
+    void _set_from_numpy(int n, double* numpydata) {
+        SimTK_ASSERT1_ALWAYS(n == $self->size(), "Size of input must be %i.",
+                             $self->size());
+        for (int i = 0; i < n; ++i) $self->updElt(i, 0) = numpydata[i];
+    }
 %pythoncode %{
     def to_numpy(self):
         return self._to_numpy(self.size())
+    def to_numpy_view(self, owner=None):
+        """Return a NumPy array that shares memory with this vector (no
+        copy). Writing to the array modifies the vector. The array is invalid
+        once the vector is resized or destroyed; pass the object that owns the
+        vector as `owner` to keep it alive while the array exists."""
+        return _numpy_view(self, owner, (self.size(),),
+                (self._numpy_view_stride(),))
+    def set_from_numpy(self, arr):
+        """Copy a 1D NumPy array of the same size into this vector."""
+        self._set_from_numpy(arr)
 %};
 }
 
@@ -229,9 +252,30 @@ namespace SimTK {
                              $self->size());
         std::copy_n($self->getContiguousScalarData(), n, numpyout);
     }
+    size_t _numpy_view_address() {
+        return $self->size() ? (size_t)&$self->updElt(0, 0) : 0;
+    }
+    int _numpy_view_stride() const {
+        if ($self->size() < 2) return (int)sizeof(double);
+        return (int)((const char*)&$self->getElt(0, 1) -
+                     (const char*)&$self->getElt(0, 0));
+    }
+    void _set_from_numpy(int n, double* numpydata) {
+        SimTK_ASSERT1_ALWAYS(n == $self->size(), "Size of input must be %i.",
+                             $self->size());
+        for (int i = 0; i < n; ++i) $self->updElt(0, i) = numpydata[i];
+    }
 %pythoncode %{
     def to_numpy(self):
         return self._to_numpy(self.size())
+    def to_numpy_view(self, owner=None):
+        """Return a NumPy array that shares memory with this row vector (no
+        copy). See VectorBase.to_numpy_view()."""
+        return _numpy_view(self, owner, (self.size(),),
+                (self._numpy_view_stride(),))
+    def set_from_numpy(self, arr):
+        """Copy a 1D NumPy array of the same size into this row vector."""
+        self._set_from_numpy(arr)
 %};
 }
 
@@ -249,12 +293,49 @@ namespace SimTK {
                 "Number of columns must be %i.", $self->ncol());
         std::copy_n($self->getContiguousScalarData(), nrow * ncol, numpyout);
     }
+    size_t _numpy_view_address() {
+        return $self->nelt() ? (size_t)&$self->updElt(0, 0) : 0;
+    }
+    int _numpy_view_row_stride() const {
+        if ($self->nrow() < 2 || $self->ncol() < 1) return (int)sizeof(double);
+        return (int)((const char*)&$self->getElt(1, 0) -
+                     (const char*)&$self->getElt(0, 0));
+    }
+    int _numpy_view_col_stride() const {
+        if ($self->ncol() < 2 || $self->nrow() < 1)
+            return (int)sizeof(double) * std::max($self->nrow(), 1);
+        return (int)((const char*)&$self->getElt(0, 1) -
+                     (const char*)&$self->getElt(0, 0));
+    }
+    void _set_from_numpy(int nrow, int ncol, double* numpydata) {
+        SimTK_ASSERT1_ALWAYS(nrow == $self->nrow(),
+                "Number of rows must be %i.", $self->nrow());
+        SimTK_ASSERT1_ALWAYS(ncol == $self->ncol(),
+                "Number of columns must be %i.", $self->ncol());
+        // numpydata is row-major (C order).
+        for (int i = 0; i < nrow; ++i)
+            for (int j = 0; j < ncol; ++j)
+                $self->updElt(i, j) = numpydata[i * ncol + j];
+    }
 %pythoncode %{
     def to_numpy(self):
         import numpy as np
         mat = np.empty([self.nrow(), self.ncol()])
         self._to_numpy(mat)
         return mat
+    def to_numpy_view(self, owner=None):
+        """Return a NumPy array that shares memory with this matrix (no
+        copy). Writing to the array modifies the matrix. Simbody stores
+        matrices column by column, so the array is in Fortran order; use
+        numpy.ascontiguousarray() if a C-ordered copy is needed. The array is
+        invalid once the matrix is resized or destroyed; pass the object that
+        owns the matrix (e.g., a TimeSeriesTable) as `owner` to keep it alive
+        while the array exists."""
+        return _numpy_view(self, owner, (self.nrow(), self.ncol()),
+                (self._numpy_view_row_stride(), self._numpy_view_col_stride()))
+    def set_from_numpy(self, arr):
+        """Copy a 2D NumPy array of the same shape into this matrix."""
+        self._set_from_numpy(arr)
 %};
 }
 
@@ -267,4 +348,29 @@ namespace SimTK {
 
 } // namespace SimTK
 
+%pythoncode %{
+def _numpy_view(simbody_obj, owner, shape, strides):
+    """Wrap the memory of a Simbody vector or matrix in a NumPy array without
+    copying. The returned array holds references to simbody_obj and owner so
+    that the memory outlives the array (unless the memory is reallocated)."""
+    import sys
+    import numpy as np
+    if 0 in shape:
+        return np.empty(shape)
+    class _View(object):
+        def __init__(self):
+            self.__array_interface__ = {
+                'shape': shape,
+                'typestr': '<f8' if sys.byteorder == 'little' else '>f8',
+                'data': (simbody_obj._numpy_view_address(), False),
+                'strides': strides,
+                'version': 3,
+            }
+            self.simbody_obj = simbody_obj
+            self.owner = owner
+    view = _View()
+    # np.asarray() stores `view` as the base of the array.
+    return np.asarray(view)
+%}
+
 
@@ -133,6 +133,37 @@ class TestSimbody(unittest.TestCase):
         with self.assertRaises(TypeError):
             osim.Matrix.createFromMat(npm)
 
+    def test_numpy_views(self):
+        m = osim.Matrix.createFromMat(np.array([[5., 3.], [3., 6.], [8., 1.]]))
+        view = m.to_numpy_view()
+        assert view.shape == (3, 2)
+        assert (view == m.to_numpy()).all()
+        # The view shares memory with the matrix.
+        view[2, 0] = -1.0
+        assert m.get(2, 0) == -1.0
+        m.set(0, 1, 7.0)
+        assert view[0, 1] == 7.0
+
+        m.set_from_numpy(np.array([[1., 2.], [3., 4.], [5., 6.]]))
+        assert view[1, 1] == 4.0
+
+        v = osim.Vector.createFromMat(np.array([1.5, 2.5]))
+        vview = v.to_numpy_view()
+        vview[1] = 3.5
+        assert v.get(1) == 3.5
+
+        # The table stays alive as long as the view does.
+        table = osim.TimeSeriesTable()
+        table.setColumnLabels(['a', 'b'])
+        table.appendRow(0.0, osim.RowVector([1.5, 2.5]))
+        table.appendRow(1.0, osim.RowVector([3.5, 4.5]))
+        tview = table.getMatrixNumPyView()
+        del table
+        assert tview.shape == (2, 2)
+        assert tview[1, 0] == 3.5
+        tview[0, 1] = 0.0
+        assert tview.base.owner.getDependentColumn('b')[0] == 0.0
+
     def test_vector_operators(self):
         v = osim.Vector(5, 3)
 
@@ -16,3 +16,26 @@ class TestSimulationUtilities(unittest.TestCase):
         # updatePre40KinematicsStorageFor40MotionType() is not wrapped.
         osim.updatePre40KinematicsFilesFor40MotionType(model,
                 [kinematics_file])
+
+    def test_integrate_releases_gil(self):
+        # Manager.integrate() releases the GIL, so simulations can run in
+        # multiple Python threads.
+        import threading
+        model = osim.Model(os.path.join(test_dir, 'arm26.osim'))
+        model.initSystem()
+        final_times = [None] * 2
+
+        def run(i):
+            m = osim.Model(model)
+            state = m.initSystem()
+            manager = osim.Manager(m)
+            manager.initialize(state)
+            final_times[i] = manager.integrate(0.2).getTime()
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(2)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for time in final_times:
+            self.assertAlmostEqual(time, 0.2)
@@ -379,6 +379,12 @@ DATATABLE_CLONE(double, SimTK::Rotation_<double>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::Quaternion>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::Vec6>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::SpatialVec>)
+%shared_ptr(OpenSim::BinaryFileAdapter_<double>)
+%shared_ptr(OpenSim::BinaryFileAdapter_<SimTK::Vec3>)
+%shared_ptr(OpenSim::BinaryFileAdapter_<SimTK::UnitVec3>)
+%shared_ptr(OpenSim::BinaryFileAdapter_<SimTK::Quaternion>)
+%shared_ptr(OpenSim::BinaryFileAdapter_<SimTK::Vec6>)
+%shared_ptr(OpenSim::BinaryFileAdapter_<SimTK::SpatialVec>)
 %shared_ptr(OpenSim::CSVFileAdapter)
 %shared_ptr(OpenSim::TRCFileAdapter)
 %shared_ptr(OpenSim::C3DFileAdapter)
@@ -386,13 +392,24 @@ DATATABLE_CLONE(double, SimTK::Rotation_<double>)
         std::map<std::string, std::shared_ptr<OpenSim::DataAdapter>>;
 %template(StdMapStringAbstractDataTable)
         std::map<std::string, std::shared_ptr<OpenSim::AbstractDataTable>>;
+%template(StdVectorStdMapStringAbstractDataTable)
+        std::vector<std::map<std::string,
+                std::shared_ptr<OpenSim::AbstractDataTable>>>;
 %include <OpenSim/Common/DataAdapter.h>
 %include <OpenSim/Common/ExperimentalSensor.h>
+// Streams are returned as std::unique_ptr; scripting users read tables.
+%ignore OpenSim::IMUDataReader::openStream;
+%ignore OpenSim::XsensDataReader::openStream;
+%ignore OpenSim::APDMDataReader::openStream;
+%ignore OpenSim::IMUDataStream;
 %include <OpenSim/Common/IMUDataReader.h>
 %include <OpenSim/Common/XsensDataReaderSettings.h>
 %include <OpenSim/Common/XsensDataReader.h>
 
-
+namespace OpenSim {
+    %ignore FileAdapter::findDelimiter;
+    %ignore FileAdapter::parseDouble;
+}
 %include <OpenSim/Common/FileAdapter.h>
 namespace OpenSim {
     %ignore TRCFileAdapter::TRCFileAdapter(TRCFileAdapter &&);
@@ -414,6 +431,19 @@ namespace OpenSim {
 %template(STOFileAdapterVec6)       OpenSim::STOFileAdapter_<SimTK::Vec6>;
 %template(STOFileAdapterSpatialVec) OpenSim::STOFileAdapter_<SimTK::SpatialVec>;
 
+%ignore OpenSim::MemoryMappedFile;
+%ignore OpenSim::BinaryTableFileInfo;
+%ignore OpenSim::createBinaryFileAdapterForReading;
+%ignore OpenSim::createBinaryFileAdapterForWriting;
+%ignore OpenSim::BinaryFileAdapter_::BinaryFileAdapter_(BinaryFileAdapter_&&);
+%include <OpenSim/Common/BinaryFileAdapter.h>
+%template(BinaryFileAdapter)           OpenSim::BinaryFileAdapter_<double>;
+%template(BinaryFileAdapterVec3)       OpenSim::BinaryFileAdapter_<SimTK::Vec3>;
+%template(BinaryFileAdapterUnitVec3)   OpenSim::BinaryFileAdapter_<SimTK::UnitVec3>;
+%template(BinaryFileAdapterQuaternion) OpenSim::BinaryFileAdapter_<SimTK::Quaternion>;
+%template(BinaryFileAdapterVec6)       OpenSim::BinaryFileAdapter_<SimTK::Vec6>;
+%template(BinaryFileAdapterSpatialVec) OpenSim::BinaryFileAdapter_<SimTK::SpatialVec>;
+
 %include <OpenSim/Common/CSVFileAdapter.h>
 %include <OpenSim/Common/XsensDataReader.h>
 
@@ -457,6 +487,8 @@ namespace OpenSim {
 %template(TableReporterVec3) OpenSim::TableReporter_<SimTK::Vec3>;
 %template(TableReporterSpatialVec) OpenSim::TableReporter_<SimTK::SpatialVec>;
 %template(TableReporterVector) OpenSim::TableReporter_<SimTK::Vector, SimTK::Real>;
+%template(STOFileReporter) OpenSim::STOFileReporter_<SimTK::Real>;
+%template(STOFileReporterVec3) OpenSim::STOFileReporter_<SimTK::Vec3>;
 %template(ConsoleReporter) OpenSim::ConsoleReporter_<SimTK::Real>;
 %template(ConsoleReporterVec3) OpenSim::ConsoleReporter_<SimTK::Vec3>;
 
@@ -117,6 +117,7 @@ EXPOSE_BOUNDS_CONSTRUCTORS_HELPER(MocoFinalBounds);
 %ignore OpenSim::MocoTrajectory::setDerivative(const std::string&,
         std::initializer_list<double>);
 
+%include <OpenSim/Moco/MocoResamplingPlan.h>
 %include <OpenSim/Moco/MocoTrajectory.h>
 
 %include <OpenSim/Moco/MocoSolver.h>
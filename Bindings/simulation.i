@@ -138,6 +138,7 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 %include <OpenSim/Simulation/Control/ControlLinear.h>
 %include <OpenSim/Simulation/Control/Controller.h>
 %include <OpenSim/Simulation/Control/PrescribedController.h>
+%include <OpenSim/Simulation/Control/StreamingController.h>
 
 %include <OpenSim/Simulation/Manager/Manager.h>
 %include <OpenSim/Simulation/Model/AbstractTool.h>
@@ -191,6 +192,7 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 %template(ArrayPointForceDirection) OpenSim::Array<OpenSim::PointForceDirection*>;
 
 %include <OpenSim/Simulation/Model/GeometryPath.h>
+%include <OpenSim/Simulation/Model/FunctionBasedPath.h>
 %include <OpenSim/Simulation/Model/Ligament.h>
 %include <OpenSim/Simulation/Model/Blankevoort1991Ligament.h>
 %include <OpenSim/Simulation/Model/PathActuator.h>
@@ -35,3 +35,4 @@
 %include <OpenSim/Tools/InverseKinematicsToolBase.h>
 %include <OpenSim/Tools/InverseKinematicsTool.h>
 %include <OpenSim/Tools/IMUInverseKinematicsTool.h>
+%include <OpenSim/Tools/ToolResultCache.h>
@@ -87,9 +87,19 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if (m_useLookupTable) m_curve.createLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
+void ActiveForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    m_useLookupTable = useLookupTable;
+    if (isObjectUpToDateWithProperties()) {
+        if (!m_useLookupTable) m_curve.clearLookupTable();
+        else if (!m_curve.hasLookupTable()) m_curve.createLookupTable();
+    }
+}
+
 void ActiveForceLengthCurve::ensureCurveUpToDate()
 {
     if(!isObjectUpToDateWithProperties()) {
@@ -170,6 +180,27 @@ double ActiveForceLengthCurve::calcDerivative(double normFiberLength,
     return m_curve.calcDerivative(normFiberLength,order);
 }
 
+void ActiveForceLengthCurve::calcValues(
+        const SimTK::Vector& normFiberLengths, SimTK::Vector& values) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
+    m_curve.calcValues(normFiberLengths, values);
+}
+
+void ActiveForceLengthCurve::calcDerivatives(
+        const SimTK::Vector& normFiberLengths, int order,
+        SimTK::Vector& derivatives) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ActiveForceLengthCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "ActiveForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(normFiberLengths, order, derivatives);
+}
+
 double ActiveForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
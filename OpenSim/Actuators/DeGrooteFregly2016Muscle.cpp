@@ -590,8 +590,33 @@ void DeGrooteFregly2016Muscle::computeInitialFiberEquilibrium(
                 activation, normTendonForce, normTendonForceDerivative);
     };
 
-    const auto equilNormTendonForce = solveBisection(calcResidual,
-            m_minNormTendonForce, m_maxNormTendonForce, 1e-10, 100);
+    // The equilibrium table, if used, tabulates the static normalized tendon
+    // force; bisect within a small bracket around it if the bracket contains
+    // the root.
+    double left = m_minNormTendonForce;
+    double right = m_maxNormTendonForce;
+    const double guess = lookUpEquilibriumGuess(
+            activation, muscleTendonLength, [&](double a, double lmt) {
+                return solveBisection(
+                        [&](const SimTK::Real& normTendonForce) {
+                            return calcEquilibriumResidual(lmt, 0, a,
+                                    normTendonForce, 0);
+                        },
+                        m_minNormTendonForce, m_maxNormTendonForce, 1e-10,
+                        100);
+            });
+    if (!SimTK::isNaN(guess)) {
+        const double halfWidth = 0.05;
+        const double guessLeft = std::max(left, guess - halfWidth);
+        const double guessRight = std::min(right, guess + halfWidth);
+        if (calcResidual(guessLeft) * calcResidual(guessRight) <= 0) {
+            left = guessLeft;
+            right = guessRight;
+        }
+    }
+
+    const auto equilNormTendonForce =
+            solveBisection(calcResidual, left, right, 1e-10, 100);
 
     setNormalizedTendonForce(s, equilNormTendonForce);
 
@@ -862,6 +887,76 @@ double DeGrooteFregly2016Muscle::getImplicitResidualNormalizedTendonForce(
             s, RESIDUAL_NORMALIZED_TENDON_FORCE_NAME);
 }
 
+Muscle::ForceJacobian DeGrooteFregly2016Muscle::calcForceJacobian(
+        const SimTK::State& s) const {
+    const auto& mli = getMuscleLengthInfo(s);
+    const auto& fvi = getFiberVelocityInfo(s);
+    const SimTK::Real activation = getActivation(s);
+    const auto& maxIsometricForce = get_max_isometric_force();
+    const auto& optimalFiberLength = get_optimal_fiber_length();
+
+    SimTK::Real activeFiberForce;
+    SimTK::Real conPassiveFiberForce;
+    SimTK::Real nonConPassiveFiberForce;
+    SimTK::Real totalFiberForce;
+    calcFiberForce(activation, mli.fiberActiveForceLengthMultiplier,
+            fvi.fiberForceVelocityMultiplier,
+            mli.fiberPassiveForceLengthMultiplier, fvi.normFiberVelocity,
+            activeFiberForce, conPassiveFiberForce, nonConPassiveFiberForce,
+            totalFiberForce);
+
+    const SimTK::Real fiberStiffness = calcFiberStiffness(activation,
+            mli.normFiberLength, fvi.fiberForceVelocityMultiplier);
+    const SimTK::Real partialPennationAnglePartialFiberLength =
+            calcPartialPennationAnglePartialFiberLength(mli.fiberLength);
+
+    // The columns are activation, normalized fiber length, normalized fiber
+    // velocity and muscle-tendon length.
+    ForceJacobian jac;
+    jac.fiberForceAlongTendon[0] = maxIsometricForce *
+                                   mli.fiberActiveForceLengthMultiplier *
+                                   fvi.fiberForceVelocityMultiplier *
+                                   mli.cosPennationAngle;
+    jac.fiberForceAlongTendon[1] =
+            optimalFiberLength *
+            calcPartialFiberForceAlongTendonPartialFiberLength(totalFiberForce,
+                    fiberStiffness, mli.sinPennationAngle,
+                    mli.cosPennationAngle,
+                    partialPennationAnglePartialFiberLength);
+    jac.fiberForceAlongTendon[2] =
+            maxIsometricForce *
+            (activation * mli.fiberActiveForceLengthMultiplier *
+                            calcForceVelocityMultiplierDerivative(
+                                    fvi.normFiberVelocity) +
+                    get_fiber_damping()) *
+            mli.cosPennationAngle;
+
+    if (get_ignore_tendon_compliance()) {
+        jac.tendonForce = jac.fiberForceAlongTendon;
+        return jac;
+    }
+
+    const SimTK::Real tendonStiffness =
+            calcTendonStiffness(mli.normTendonLength);
+    jac.tendonForce[1] = optimalFiberLength *
+                         calcPartialTendonForcePartialFiberLength(
+                                 tendonStiffness, mli.fiberLength,
+                                 mli.sinPennationAngle, mli.cosPennationAngle);
+    jac.tendonForce[3] = tendonStiffness;
+
+    // Eliminate the normalized fiber velocity using the equilibrium residual
+    // (fiberForceAlongTendon - tendonForce = 0); the time derivative of
+    // normalized fiber length is max_contraction_velocity * normFiberVelocity.
+    const SimTK::Vec4 partialResidual =
+            jac.fiberForceAlongTendon - jac.tendonForce;
+    for (int i : {0, 1, 3}) {
+        jac.normFiberLengthDerivative[i] = -get_max_contraction_velocity() *
+                                           partialResidual[i] /
+                                           partialResidual[2];
+    }
+    return jac;
+}
+
 DataTable DeGrooteFregly2016Muscle::exportFiberLengthCurvesToTable(
         const SimTK::Vector& normFiberLengths) const {
     SimTK::Vector def;
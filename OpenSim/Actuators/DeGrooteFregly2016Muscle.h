@@ -231,6 +231,12 @@ public:
     /// force is set to zero since a value is required for the implicit form of
     /// the model.  
     void computeInitialFiberEquilibrium(SimTK::State& s) const override;
+
+    bool hasForceJacobian() const override { return true; }
+    /// The partial derivatives are computed from the muscle-tendon
+    /// equilibrium equation in implicit form, which includes the fiber
+    /// damping force, regardless of `tendon_compliance_dynamics_mode`.
+    ForceJacobian calcForceJacobian(const SimTK::State& s) const override;
     /// @}
 
     /// @name Get methods.
@@ -419,6 +425,15 @@ public:
         return d1 * log(tempLogArg) + d4;
     }
 
+    /// This is the derivative of the force-velocity multiplier with respect
+    /// to normalized fiber velocity.
+    static SimTK::Real calcForceVelocityMultiplierDerivative(
+            const SimTK::Real& normFiberVelocity) {
+        using SimTK::square;
+        const SimTK::Real tempV = d2 * normFiberVelocity + d3;
+        return d1 * d2 / sqrt(square(tempV) + 1.0);
+    }
+
     /// This is the inverse of the force-velocity multiplier function, and
     /// returns the normalized fiber velocity (in [-1, 1]) as a function of
     /// the force-velocity multiplier.
@@ -798,6 +813,9 @@ public:
     /// @}
 
 private:
+    // The group evaluates the curves below for many muscles at once.
+    friend class DeGrooteFregly2016MuscleGroup;
+
     void constructProperties();
 
     void calcMuscleLengthInfoHelper(const SimTK::Real& muscleTendonLength,
@@ -0,0 +1,267 @@
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  DeGrooteFregly2016MuscleGroup.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016MuscleGroup.h"
+
+using namespace OpenSim;
+
+using DGF = DeGrooteFregly2016Muscle;
+
+DeGrooteFregly2016MuscleGroup::DeGrooteFregly2016MuscleGroup() {
+    constructProperties();
+}
+
+void DeGrooteFregly2016MuscleGroup::constructProperties() {
+    constructProperty_muscles();
+}
+
+void DeGrooteFregly2016MuscleGroup::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    const int numMuscles = getProperty_muscles().size();
+    _muscles.clear();
+    _maxIsometricForce.resize(numMuscles);
+    _optimalFiberLength.resize(numMuscles);
+    _tendonSlackLength.resize(numMuscles);
+    _fiberWidth.resize(numMuscles);
+    _maxContractionVelocity.resize(numMuscles);
+    _activeForceWidthScale.resize(numMuscles);
+    _passiveFiberStrain.resize(numMuscles);
+    _passiveForceOffset.resize(numMuscles);
+    _passiveForceDenom.resize(numMuscles);
+    _fiberDamping.resize(numMuscles);
+
+    for (int i = 0; i < numMuscles; ++i) {
+        const auto& muscle =
+                model.getComponent<DeGrooteFregly2016Muscle>(get_muscles(i));
+        OPENSIM_THROW_IF_FRMOBJ(!muscle.get_ignore_tendon_compliance(),
+                Exception,
+                "Expected muscle '{}' to have a rigid tendon "
+                "(ignore_tendon_compliance = true).",
+                get_muscles(i));
+        OPENSIM_THROW_IF_FRMOBJ(muscle.get_appliesForce(), Exception,
+                "Expected muscle '{}' to have appliesForce = false; otherwise, "
+                "its force would be applied twice.",
+                get_muscles(i));
+        _muscles.emplace_back(&muscle);
+
+        _maxIsometricForce[i] = muscle.get_max_isometric_force();
+        _optimalFiberLength[i] = muscle.get_optimal_fiber_length();
+        _tendonSlackLength[i] = muscle.get_tendon_slack_length();
+        _fiberWidth[i] = _optimalFiberLength[i] *
+                         sin(muscle.get_pennation_angle_at_optimal());
+        _maxContractionVelocity[i] =
+                muscle.get_max_contraction_velocity() * _optimalFiberLength[i];
+        _activeForceWidthScale[i] = muscle.get_active_force_width_scale();
+        const double e0 = muscle.get_passive_fiber_strain_at_one_norm_force();
+        _passiveFiberStrain[i] = e0;
+        _passiveForceOffset[i] =
+                exp(DGF::kPE * (DGF::m_minNormFiberLength - 1.0) / e0);
+        _passiveForceDenom[i] = muscle.get_ignore_passive_fiber_force()
+                                        ? SimTK::Infinity
+                                        : exp(DGF::kPE) - _passiveForceOffset[i];
+        _fiberDamping[i] = muscle.get_fiber_damping();
+    }
+
+    // Reporters label the elements of the vector outputs by muscle.
+    std::vector<std::string> muscleNames;
+    for (const auto& muscle : _muscles) {
+        muscleNames.push_back(muscle->getName());
+    }
+    for (const auto& name : getOutputNames()) {
+        auto& output = updOutput(name);
+        if (dynamic_cast<const Output<SimTK::Vector>*>(&output)) {
+            output.setElementLabels(muscleNames);
+        }
+    }
+}
+
+void DeGrooteFregly2016MuscleGroup::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    this->_kinematicsInfoCV = addCacheVariable(
+            "kinematics_info", KinematicsInfo(), SimTK::Stage::Velocity);
+    this->_dynamicsInfoCV = addCacheVariable(
+            "dynamics_info", DynamicsInfo(), SimTK::Stage::Dynamics);
+}
+
+const DeGrooteFregly2016MuscleGroup::KinematicsInfo&
+DeGrooteFregly2016MuscleGroup::getKinematicsInfo(const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _kinematicsInfoCV)) {
+        return getCacheVariableValue(s, _kinematicsInfoCV);
+    }
+    using SimTK::square;
+    KinematicsInfo& ki = updCacheVariableValue(s, _kinematicsInfoCV);
+    const int n = (int)_muscles.size();
+    ki.fiberLength.resize(n);
+    ki.normFiberLength.resize(n);
+    ki.cosPennationAngle.resize(n);
+    ki.pennationAngle.resize(n);
+    ki.fiberVelocity.resize(n);
+    ki.normFiberVelocity.resize(n);
+    ki.activeForceLengthMultiplier.resize(n);
+    ki.passiveForceMultiplier.resize(n);
+    ki.forceVelocityMultiplier.resize(n);
+
+    // The path lengths and speeds are computed (and cached) by each path. We
+    // temporarily store the fiber length along the tendon in cosPennationAngle
+    // and the muscle-tendon speed in fiberVelocity.
+    for (int i = 0; i < n; ++i) {
+        const auto& path = _muscles[i]->getGeometryPath();
+        ki.cosPennationAngle[i] = path.getLength(s) - _tendonSlackLength[i];
+        ki.fiberVelocity[i] = path.getLengtheningSpeed(s);
+    }
+
+    // Each of the following loops computes a single quantity for all of the
+    // muscles, using the same equations as DeGrooteFregly2016Muscle with a
+    // rigid tendon.
+    for (int i = 0; i < n; ++i) {
+        ki.fiberLength[i] = sqrt(square(ki.cosPennationAngle[i]) +
+                                 square(_fiberWidth[i]));
+    }
+    for (int i = 0; i < n; ++i) {
+        ki.normFiberLength[i] = ki.fiberLength[i] / _optimalFiberLength[i];
+        ki.cosPennationAngle[i] /= ki.fiberLength[i];
+        ki.pennationAngle[i] = asin(_fiberWidth[i] / ki.fiberLength[i]);
+    }
+    for (int i = 0; i < n; ++i) {
+        ki.fiberVelocity[i] *= ki.cosPennationAngle[i];
+        ki.normFiberVelocity[i] =
+                ki.fiberVelocity[i] / _maxContractionVelocity[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        const double x =
+                (ki.normFiberLength[i] - 1.0) / _activeForceWidthScale[i] + 1.0;
+        ki.activeForceLengthMultiplier[i] =
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b11, DGF::b21, DGF::b31, DGF::b41) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b12, DGF::b22, DGF::b32, DGF::b42) +
+                DGF::calcGaussianLikeCurve(
+                        x, DGF::b13, DGF::b23, DGF::b33, DGF::b43);
+    }
+    for (int i = 0; i < n; ++i) {
+        ki.passiveForceMultiplier[i] =
+                (exp(DGF::kPE * (ki.normFiberLength[i] - 1.0) /
+                         _passiveFiberStrain[i]) -
+                        _passiveForceOffset[i]) /
+                _passiveForceDenom[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        ki.forceVelocityMultiplier[i] =
+                DGF::calcForceVelocityMultiplier(ki.normFiberVelocity[i]);
+    }
+
+    markCacheVariableValid(s, _kinematicsInfoCV);
+    return ki;
+}
+
+const DeGrooteFregly2016MuscleGroup::DynamicsInfo&
+DeGrooteFregly2016MuscleGroup::getDynamicsInfo(const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _dynamicsInfoCV)) {
+        return getCacheVariableValue(s, _dynamicsInfoCV);
+    }
+    const KinematicsInfo& ki = getKinematicsInfo(s);
+    DynamicsInfo& di = updCacheVariableValue(s, _dynamicsInfoCV);
+    const int n = (int)_muscles.size();
+    di.activation.resize(n);
+    di.activeFiberForce.resize(n);
+    di.passiveFiberForce.resize(n);
+    di.tendonForce.resize(n);
+
+    for (int i = 0; i < n; ++i) {
+        di.activation[i] = _muscles[i]->getActivation(s);
+    }
+    for (int i = 0; i < n; ++i) {
+        di.activeFiberForce[i] = _maxIsometricForce[i] * di.activation[i] *
+                                 ki.activeForceLengthMultiplier[i] *
+                                 ki.forceVelocityMultiplier[i];
+        di.passiveFiberForce[i] =
+                _maxIsometricForce[i] *
+                (ki.passiveForceMultiplier[i] +
+                        _fiberDamping[i] * ki.normFiberVelocity[i]);
+        di.tendonForce[i] = (di.activeFiberForce[i] + di.passiveFiberForce[i]) *
+                            ki.cosPennationAngle[i];
+    }
+
+    markCacheVariableValid(s, _dynamicsInfoCV);
+    return di;
+}
+
+void DeGrooteFregly2016MuscleGroup::computeForce(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& generalizedForces) const {
+    const SimTK::Vector& tendonForce = getTendonForce(s);
+    for (int i = 0; i < (int)_muscles.size(); ++i) {
+        _muscles[i]->getGeometryPath().addInEquivalentForces(
+                s, tendonForce[i], bodyForces, generalizedForces);
+    }
+}
+
+OpenSim::Array<std::string>
+DeGrooteFregly2016MuscleGroup::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (const auto& muscle : _muscles) {
+        labels.append(muscle->getName() + "_tendon_force");
+    }
+    return labels;
+}
+
+OpenSim::Array<double> DeGrooteFregly2016MuscleGroup::getRecordValues(
+        const SimTK::State& s) const {
+    OpenSim::Array<double> values(SimTK::NaN);
+    const SimTK::Vector& tendonForce = getTendonForce(s);
+    for (int i = 0; i < tendonForce.size(); ++i) {
+        values.append(tendonForce[i]);
+    }
+    return values;
+}
+
+int DeGrooteFregly2016MuscleGroup::writeRecordValues(
+        const SimTK::State& s, double* values) const {
+    const SimTK::Vector& tendonForce = getTendonForce(s);
+    for (int i = 0; i < tendonForce.size(); ++i) {
+        values[i] = tendonForce[i];
+    }
+    return tendonForce.size();
+}
+
+int DeGrooteFregly2016MuscleGroup::groupMuscles(
+        Model& model, const std::string& name) {
+    model.finalizeFromProperties();
+    auto group = OpenSim::make_unique<DeGrooteFregly2016MuscleGroup>();
+    group->setName(name);
+    for (auto& muscle : model.updComponentList<DeGrooteFregly2016Muscle>()) {
+        if (!muscle.get_appliesForce() ||
+                !muscle.get_ignore_tendon_compliance()) {
+            continue;
+        }
+        muscle.set_appliesForce(false);
+        group->appendMuscle(muscle.getAbsolutePathString());
+    }
+    const int numMuscles = group->getNumMuscles();
+    if (numMuscles) {
+        model.addForce(group.release());
+        model.finalizeFromProperties();
+    }
+    return numMuscles;
+}
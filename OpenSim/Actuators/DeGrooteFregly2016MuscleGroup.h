@@ -0,0 +1,214 @@
+#ifndef OPENSIM_DEGROOTEFREGLY2016MUSCLEGROUP_H
+#define OPENSIM_DEGROOTEFREGLY2016MUSCLEGROUP_H
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  DeGrooteFregly2016MuscleGroup.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016Muscle.h"
+
+#include <OpenSim/Simulation/Model/Force.h>
+
+namespace OpenSim {
+
+/** A Force that computes the fiber kinematics and forces of many
+DeGrooteFregly2016Muscle%s in a single pass and applies their tendon forces
+along their paths.
+
+Each DeGrooteFregly2016Muscle normally owns its own cache variables and is
+realized separately as the model's component tree is traversed. For models
+with many muscles (e.g., MocoInverse with 80 muscles), this per-muscle
+overhead is a large share of the cost of evaluating the model. This component
+instead stores the parameters of its member muscles in contiguous arrays
+(structure of arrays) and computes each quantity (fiber length, pennation,
+force multipliers, forces) for all members in one loop, which the compiler can
+vectorize since the De Groote-Fregly curves are closed-form.
+
+The member muscles are listed (by path) in the `muscles` property. They must
+have rigid tendons (`ignore_tendon_compliance` is true) and must not apply
+force themselves (`appliesForce` is false); otherwise their forces would be
+applied twice. The member muscles still provide the activation (either their
+control or their activation state), so controls and solvers (e.g., Moco)
+continue to treat them as the model's actuators. Use groupMuscles() (or the
+ModOpGroupDeGrooteFregly2016Muscles model operator) to create a group from
+all eligible muscles in a model.
+
+The results for all members are available as outputs; each output is a
+SimTK::Vector with one entry per member, in the order of the `muscles`
+property. The results match those of the individual muscles with rigid
+tendons. */
+class OSIMACTUATORS_API DeGrooteFregly2016MuscleGroup : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(DeGrooteFregly2016MuscleGroup, Force);
+
+public:
+    OpenSim_DECLARE_LIST_PROPERTY(muscles, std::string,
+            "Paths to the DeGrooteFregly2016Muscles whose forces are computed "
+            "by this group.");
+
+    OpenSim_DECLARE_OUTPUT(fiber_length, SimTK::Vector, getFiberLength,
+            SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(normalized_fiber_length, SimTK::Vector,
+            getNormalizedFiberLength, SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(pennation_angle, SimTK::Vector, getPennationAngle,
+            SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(fiber_velocity, SimTK::Vector, getFiberVelocity,
+            SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(normalized_fiber_velocity, SimTK::Vector,
+            getNormalizedFiberVelocity, SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(active_force_length_multiplier, SimTK::Vector,
+            getActiveForceLengthMultiplier, SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(passive_force_multiplier, SimTK::Vector,
+            getPassiveForceMultiplier, SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(force_velocity_multiplier, SimTK::Vector,
+            getForceVelocityMultiplier, SimTK::Stage::Velocity);
+    OpenSim_DECLARE_OUTPUT(activation, SimTK::Vector, getActivation,
+            SimTK::Stage::Dynamics);
+    OpenSim_DECLARE_OUTPUT(active_fiber_force, SimTK::Vector,
+            getActiveFiberForce, SimTK::Stage::Dynamics);
+    OpenSim_DECLARE_OUTPUT(passive_fiber_force, SimTK::Vector,
+            getPassiveFiberForce, SimTK::Stage::Dynamics);
+    OpenSim_DECLARE_OUTPUT(tendon_force, SimTK::Vector, getTendonForce,
+            SimTK::Stage::Dynamics);
+
+    DeGrooteFregly2016MuscleGroup();
+
+    /** Append a member muscle by its path in the model. */
+    void appendMuscle(const std::string& musclePath)
+    {   append_muscles(musclePath); }
+    /** The number of member muscles. */
+    int getNumMuscles() const { return getProperty_muscles().size(); }
+
+    /// @name Results for all member muscles
+    /// Each vector has one entry per member muscle, in the order of the
+    /// `muscles` property.
+    /// @{
+    const SimTK::Vector& getFiberLength(const SimTK::State& s) const
+    {   return getKinematicsInfo(s).fiberLength; }
+    const SimTK::Vector& getNormalizedFiberLength(const SimTK::State& s) const
+    {   return getKinematicsInfo(s).normFiberLength; }
+    const SimTK::Vector& getPennationAngle(const SimTK::State& s) const
+    {   return getKinematicsInfo(s).pennationAngle; }
+    const SimTK::Vector& getFiberVelocity(const SimTK::State& s) const
+    {   return getKinematicsInfo(s).fiberVelocity; }
+    const SimTK::Vector& getNormalizedFiberVelocity(
+            const SimTK::State& s) const
+    {   return getKinematicsInfo(s).normFiberVelocity; }
+    const SimTK::Vector& getActiveForceLengthMultiplier(
+            const SimTK::State& s) const
+    {   return getKinematicsInfo(s).activeForceLengthMultiplier; }
+    const SimTK::Vector& getPassiveForceMultiplier(
+            const SimTK::State& s) const
+    {   return getKinematicsInfo(s).passiveForceMultiplier; }
+    const SimTK::Vector& getForceVelocityMultiplier(
+            const SimTK::State& s) const
+    {   return getKinematicsInfo(s).forceVelocityMultiplier; }
+    const SimTK::Vector& getActivation(const SimTK::State& s) const
+    {   return getDynamicsInfo(s).activation; }
+    const SimTK::Vector& getActiveFiberForce(const SimTK::State& s) const
+    {   return getDynamicsInfo(s).activeFiberForce; }
+    const SimTK::Vector& getPassiveFiberForce(const SimTK::State& s) const
+    {   return getDynamicsInfo(s).passiveFiberForce; }
+    const SimTK::Vector& getTendonForce(const SimTK::State& s) const
+    {   return getDynamicsInfo(s).tendonForce; }
+    /// @}
+
+    /** Create a group containing all DeGrooteFregly2016Muscle%s in the model
+    that apply force and have rigid tendons, turn off appliesForce for these
+    muscles, and add the group to the model's ForceSet. Nothing is added if
+    there are no such muscles.
+    @returns The number of muscles in the group. */
+    static int groupMuscles(Model& model,
+            const std::string& name = "degrootefregly2016_muscle_group");
+
+    //--------------------------------------------------------------------------
+    // Force interface
+    //--------------------------------------------------------------------------
+    void computeForce(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& s) const override;
+    int writeRecordValues(
+            const SimTK::State& s, double* values) const override;
+
+protected:
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+private:
+    void constructProperties();
+
+    /// Quantities that depend on the muscle-tendon lengths and speeds.
+    struct KinematicsInfo {
+        SimTK::Vector fiberLength;
+        SimTK::Vector normFiberLength;
+        SimTK::Vector cosPennationAngle;
+        SimTK::Vector pennationAngle;
+        SimTK::Vector fiberVelocity;
+        SimTK::Vector normFiberVelocity;
+        SimTK::Vector activeForceLengthMultiplier;
+        SimTK::Vector passiveForceMultiplier;
+        SimTK::Vector forceVelocityMultiplier;
+        friend std::ostream& operator<<(
+                std::ostream& o, const KinematicsInfo&) {
+            o << "DeGrooteFregly2016MuscleGroup::KinematicsInfo";
+            return o;
+        }
+    };
+    /// Quantities that also depend on the activations.
+    struct DynamicsInfo {
+        SimTK::Vector activation;
+        SimTK::Vector activeFiberForce;
+        SimTK::Vector passiveFiberForce;
+        SimTK::Vector tendonForce;
+        friend std::ostream& operator<<(std::ostream& o, const DynamicsInfo&) {
+            o << "DeGrooteFregly2016MuscleGroup::DynamicsInfo";
+            return o;
+        }
+    };
+
+    const KinematicsInfo& getKinematicsInfo(const SimTK::State& s) const;
+    const DynamicsInfo& getDynamicsInfo(const SimTK::State& s) const;
+
+    std::vector<SimTK::ReferencePtr<const DeGrooteFregly2016Muscle>> _muscles;
+
+    // Parameters of the member muscles (structure of arrays), computed in
+    // extendConnectToModel().
+    std::vector<double> _maxIsometricForce;
+    std::vector<double> _optimalFiberLength;
+    std::vector<double> _tendonSlackLength;
+    std::vector<double> _fiberWidth;
+    std::vector<double> _maxContractionVelocity; // m/s
+    std::vector<double> _activeForceWidthScale;
+    std::vector<double> _passiveFiberStrain;
+    // Offset and denominator of the passive force-length curve; the
+    // denominator is infinite if the passive force is ignored.
+    std::vector<double> _passiveForceOffset;
+    std::vector<double> _passiveForceDenom;
+    std::vector<double> _fiberDamping;
+
+    mutable CacheVariable<KinematicsInfo> _kinematicsInfoCV;
+    mutable CacheVariable<DynamicsInfo> _dynamicsInfoCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DEGROOTEFREGLY2016MUSCLEGROUP_H
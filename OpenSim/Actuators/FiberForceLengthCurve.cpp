@@ -94,9 +94,19 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
     m_curve = *f;
     delete f;
 
+    if (m_useLookupTable) m_curve.createLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
+void FiberForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    m_useLookupTable = useLookupTable;
+    if (isObjectUpToDateWithProperties()) {
+        if (!m_useLookupTable) m_curve.clearLookupTable();
+        else if (!m_curve.hasLookupTable()) m_curve.createLookupTable();
+    }
+}
+
 void FiberForceLengthCurve::ensureCurveUpToDate()
 {
     if(isObjectUpToDateWithProperties()) {
@@ -231,6 +241,27 @@ double FiberForceLengthCurve::calcDerivative(double normFiberLength,
     return m_curve.calcDerivative(normFiberLength,order);
 }
 
+void FiberForceLengthCurve::calcValues(
+        const SimTK::Vector& normFiberLengths, SimTK::Vector& values) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberForceLengthCurve: Curve is not up-to-date with its properties");
+    m_curve.calcValues(normFiberLengths, values);
+}
+
+void FiberForceLengthCurve::calcDerivatives(
+        const SimTK::Vector& normFiberLengths, int order,
+        SimTK::Vector& derivatives) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "FiberForceLengthCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "FiberForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(normFiberLengths, order, derivatives);
+}
+
 double FiberForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
@@ -290,6 +290,21 @@ public:
         normalized fiber length.
     */
     double calcDerivative(double normFiberLength, int order) const;
+
+    /** Evaluates the curve at each of the normalized fiber lengths in
+    'normFiberLengths' (e.g., for many muscles that share this curve's
+    properties); this is faster than calling calcValue() for each of them.
+    The curve must be up-to-date with its properties. See
+    SmoothSegmentedFunction::calcValues().
+    @param values Resized to the size of 'normFiberLengths'. */
+    void calcValues(const SimTK::Vector& normFiberLengths,
+                    SimTK::Vector& values) const;
+
+    /** Evaluates the derivative of the given order (0, 1, or 2) of the
+    curve at each of the normalized fiber lengths in 'normFiberLengths'. See
+    calcValues(). */
+    void calcDerivatives(const SimTK::Vector& normFiberLengths, int order,
+                         SimTK::Vector& derivatives) const;
     
 
     /// If possible, use the simpler overload above.
@@ -348,6 +363,15 @@ public:
     void printMuscleCurveToCSVFile(const std::string& path);
 
     void ensureCurveUpToDate();
+
+    /** Evaluate the curve and its first two derivatives with a precomputed
+    lookup table (see SmoothSegmentedFunction::createLookupTable()) rather than
+    by inverting the underlying Bezier curves. The table is rebuilt whenever
+    the curve is rebuilt. This setting is not a property; it is typically set
+    by the muscle that owns the curve (e.g., by the `use_tabulated_curves`
+    property of Millard2012EquilibriumMuscle). */
+    void setUseLookupTable(bool useLookupTable);
+    bool getUseLookupTable() const { return m_useLookupTable; }
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -385,6 +409,7 @@ private:
                                   double area, double relTol);
 
     SmoothSegmentedFunction m_curve;
+    bool m_useLookupTable = false;
     double m_stiffnessAtLowForceInUse;
     double m_stiffnessAtOneNormForceInUse;
     double m_curvinessInUse;
@@ -89,9 +89,19 @@ void ForceVelocityCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    if (m_useLookupTable) m_curve.createLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
+void ForceVelocityCurve::setUseLookupTable(bool useLookupTable)
+{
+    m_useLookupTable = useLookupTable;
+    if (isObjectUpToDateWithProperties()) {
+        if (!m_useLookupTable) m_curve.clearLookupTable();
+        else if (!m_curve.hasLookupTable()) m_curve.createLookupTable();
+    }
+}
+
 void ForceVelocityCurve::ensureCurveUpToDate()
 {
     if(!isObjectUpToDateWithProperties()) {
@@ -188,6 +198,27 @@ double ForceVelocityCurve::calcDerivative(double normFiberVelocity,
     return m_curve.calcDerivative(normFiberVelocity,order);
 }
 
+void ForceVelocityCurve::calcValues(
+        const SimTK::Vector& normFiberVelocities, SimTK::Vector& values) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityCurve: Curve is not up-to-date with its properties");
+    m_curve.calcValues(normFiberVelocities, values);
+}
+
+void ForceVelocityCurve::calcDerivatives(
+        const SimTK::Vector& normFiberVelocities, int order,
+        SimTK::Vector& derivatives) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "ForceVelocityCurve: Curve is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "ForceVelocityCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(normFiberVelocities, order, derivatives);
+}
+
 double ForceVelocityCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
@@ -55,6 +55,7 @@ void Millard2012EquilibriumMuscle::constructProperties()
     constructProperty_ForceVelocityCurve(ForceVelocityCurve());
     constructProperty_FiberForceLengthCurve(FiberForceLengthCurve());
     constructProperty_TendonForceLengthCurve(TendonForceLengthCurve());
+    constructProperty_use_tabulated_curves(false);
 
     setMinControl(get_minimum_activation());
 }
@@ -86,6 +87,11 @@ void Millard2012EquilibriumMuscle::extendFinalizeFromProperties()
     TendonForceLengthCurve& fseCurve = upd_TendonForceLengthCurve();
     fseCurve.setName(namePrefix + "_TendonForceLengthCurve");
 
+    falCurve.setUseLookupTable(get_use_tabulated_curves());
+    fvCurve.setUseLookupTable(get_use_tabulated_curves());
+    fpeCurve.setUseLookupTable(get_use_tabulated_curves());
+    fseCurve.setUseLookupTable(get_use_tabulated_curves());
+
     // Include fiber damping in the model only if the damping coefficient is
     // larger than MIN_NONZERO_DAMPING_COEFFICIENT. This is done to ensure
     // we remain sufficiently far from the numerical singularity at beta=0.
@@ -352,6 +358,8 @@ bool Millard2012EquilibriumMuscle::getUseFiberDamping() const
 {   return use_fiber_damping; }
 double Millard2012EquilibriumMuscle::getFiberDamping() const
 {   return get_fiber_damping(); }
+bool Millard2012EquilibriumMuscle::getUseTabulatedCurves() const
+{   return get_use_tabulated_curves(); }
 double Millard2012EquilibriumMuscle::getDefaultActivation() const
 {   return get_default_activation(); }
 double Millard2012EquilibriumMuscle::getDefaultFiberLength() const
@@ -458,6 +466,10 @@ setMuscleConfiguration(bool ignoreTendonCompliance,
 void Millard2012EquilibriumMuscle::setFiberDamping(double dampingCoefficient)
 {   set_fiber_damping(dampingCoefficient); }
 
+void Millard2012EquilibriumMuscle::
+setUseTabulatedCurves(bool useTabulatedCurves)
+{   set_use_tabulated_curves(useTabulatedCurves); }
+
 void Millard2012EquilibriumMuscle::setDefaultActivation(double activation)
 {   set_default_activation(activation); }
 
@@ -535,6 +547,7 @@ void Millard2012EquilibriumMuscle::
 computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
 {
     if(get_ignore_tendon_compliance()) {                    // rigid tendon
+        m_numEquilibriumIterations = 0;
         return;
     }
 
@@ -553,12 +566,33 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     double pathLength = getLength(s);
     double pathSpeed = solveForVelocity ? getLengtheningSpeed(s) : 0;
     double activation = getActivation(s);
+    // Warm start from the fiber length in the state (e.g., from the previous
+    // time at which the muscle was equilibrated).
+    double fiberLengthGuess =
+            getStateVariableValue(s, STATE_FIBER_LENGTH_NAME);
+    // The equilibrium table, if used, tabulates the static normalized fiber
+    // length and gives a better guess when the pose has changed.
+    const double tableNormFiberLength = lookUpEquilibriumGuess(
+            activation, pathLength, [&](double a, double lmt) {
+                auto grid = estimateMuscleFiberState(
+                        a, lmt, 0, tol, maxIter, true);
+                return grid.first == StatusFromEstimateMuscleFiberState::
+                                             Success_Converged
+                               ? grid.second["fiber_length"] /
+                                         getOptimalFiberLength()
+                               : SimTK::NaN;
+            });
+    if (!SimTK::isNaN(tableNormFiberLength)) {
+        fiberLengthGuess = tableNormFiberLength * getOptimalFiberLength();
+    }
+    m_numEquilibriumIterations = -1;
 
     try {
         std::pair<StatusFromEstimateMuscleFiberState,
                   ValuesFromEstimateMuscleFiberState> result =
             estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
+                tol, maxIter, solveForVelocity, fiberLengthGuess);
+        m_numEquilibriumIterations = (int)result.second["iterations"];
 
         switch(result.first) {
 
@@ -1049,6 +1083,74 @@ calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& mdi) const
     }
 }
 
+//==============================================================================
+// MUSCLE INTERFACE REQUIREMENTS -- PARTIAL DERIVATIVES
+//==============================================================================
+Muscle::ForceJacobian Millard2012EquilibriumMuscle::
+calcForceJacobian(const SimTK::State& s) const
+{
+    const MuscleLengthInfo& mli = getMuscleLengthInfo(s);
+    const FiberVelocityInfo& mvi = getFiberVelocityInfo(s);
+    const bool fiberStateClamped = mvi.userDefinedVelocityExtras[0] > 0.5;
+
+    const double optFiberLen = getOptimalFiberLength();
+    const double fiso        = getMaxIsometricForce();
+    const double vmax        = getMaxContractionVelocity();
+    const double fal         = mli.fiberActiveForceLengthMultiplier;
+    const double fv          = mvi.fiberForceVelocityMultiplier;
+
+    double a = SimTK::NaN;
+    if(!get_ignore_activation_dynamics()) {
+        a = getActivationModel().clampActivation(
+                getStateVariableValue(s, STATE_ACTIVATION_NAME));
+    } else {
+        a = getActivationModel().clampActivation(getControl(s));
+    }
+
+    ForceJacobian jac;
+
+    // Fiber force along the tendon:
+    // fmAT = fiso * (a*fal*fv + fpe + beta*dlceN) * cosPhi
+    if(!fiberStateClamped) {
+        const SimTK::Vec4 fiberForceV = calcFiberForce(fiso, a, fal, fv,
+                mli.fiberPassiveForceLengthMultiplier, mvi.normFiberVelocity);
+        const double dFm_dlce = calcFiberStiffness(fiso, a, fv,
+                mli.normFiberLength, optFiberLen);
+        jac.fiberForceAlongTendon[0] = fiso*fal*fv*mli.cosPennationAngle;
+        jac.fiberForceAlongTendon[1] = optFiberLen *
+            calc_DFiberForceAT_DFiberLength(fiberForceV[0], dFm_dlce,
+                mli.fiberLength, mli.sinPennationAngle, mli.cosPennationAngle);
+        jac.fiberForceAlongTendon[2] = mli.cosPennationAngle *
+            calc_DFiberForce_DNormFiberVelocity(fiso, a, fal,
+                getFiberDamping(), mvi.normFiberVelocity);
+    }
+
+    if(get_ignore_tendon_compliance()) {
+        jac.tendonForce = jac.fiberForceAlongTendon;
+        return jac;
+    }
+
+    // Tendon force: ft = fiso * fse((lmt - lce*cosPhi) / tsl)
+    const double dFt_dtl =
+        get_TendonForceLengthCurve().calcDerivative(mli.normTendonLength,1)
+        *(fiso/getTendonSlackLength());
+    jac.tendonForce[1] = optFiberLen *
+        calc_DTendonForce_DFiberLength(dFt_dtl, mli.fiberLength,
+            mli.sinPennationAngle, mli.cosPennationAngle);
+    jac.tendonForce[3] = dFt_dtl;
+
+    // The fiber velocity satisfies the equilibrium residual
+    // R = fmAT - ft = 0, so d(dlceN)/dx = -(dR/dx) / (dR/d(dlceN)), and
+    // d(lceN)/dt = vmax*dlceN.
+    if(!fiberStateClamped) {
+        const SimTK::Vec4 dR = jac.fiberForceAlongTendon - jac.tendonForce;
+        for(int i : {0, 1, 3}) {
+            jac.normFiberLengthDerivative[i] = -vmax*dR[i]/dR[2];
+        }
+    }
+    return jac;
+}
+
 //==============================================================================
 // MODELCOMPONENT INTERFACE REQUIREMENTS
 //==============================================================================
@@ -1362,7 +1464,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    double initialFiberLength) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1519,6 +1622,25 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
     //Initialize the loop
     int iter = 0;
 
+    // Warm start: use the provided fiber length instead of the default guess
+    // if its static force error is smaller.
+    if (!SimTK::isNaN(initialFiberLength)) {
+        auto staticForceError = [&](double lceGuess) {
+            lce = lceGuess;
+            positionFunc();
+            multipliersFunc();
+            fv = 1.0;
+            dlceN = 0.0;
+            ferrFunc();
+            return abs(ferr);
+        };
+        const double lceDefault = lce;
+        const double lceWarm = clampFiberLength(initialFiberLength);
+        const double ferrWarm = staticForceError(lceWarm);
+        const double ferrDefault = staticForceError(lceDefault);
+        lce = (ferrWarm < ferrDefault) ? lceWarm : lceDefault;
+    }
+
     // Estimate the position level quantities (lengths, angles) of the muscle
     positionFunc();
 
@@ -1547,12 +1669,41 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
     double ferrPrev = ferr;
     double lcePrev = lce;
 
+    // Fiber lengths at which the force error was negative and positive. The
+    // force error does not change between iterations when seeking a static
+    // solution (the force-velocity multiplier is fixed), so these bracket the
+    // solution once both are known.
+    double lceNegative = SimTK::NaN;
+    double lcePositive = SimTK::NaN;
+    auto bracketFunc = [&] {
+        if (!staticSolution) return;
+        if (ferr < 0) lceNegative = lce;
+        else          lcePositive = lce;
+    };
+    bracketFunc();
+
     double h =1.0;
     while( (abs(ferr) > aSolTolerance) && (iter < aMaxIterations)) {
         // Compute the search direction
         dferr_d_lce = dFmAT_dlce - dFt_d_lce;
         h = 1.0;
 
+        if (!SimTK::isNaN(lceNegative) && !SimTK::isNaN(lcePositive)) {
+            // Safeguarded Newton step: bisect the bracket if the Newton step
+            // leaves it (this also catches a zero or non-finite slope).
+            const double lo = min(lceNegative, lcePositive);
+            const double hi = max(lceNegative, lcePositive);
+            lce = lcePrev - ferrPrev / dferr_d_lce;
+            if (!(lce > lo && lce < hi)) {
+                lce = 0.5*(lo + hi);
+            }
+            positionFunc();
+            multipliersFunc();
+            ferrFunc();
+            // Skip the line search below.
+            ferrPrev = SimTK::Infinity;
+        }
+
         while (abs(ferr) >= abs(ferrPrev)) {
             // Compute the Newton step
             delta_lce = -h*ferrPrev / dferr_d_lce;
@@ -1590,6 +1741,7 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
 
         ferrPrev = ferr;
         lcePrev = lce;
+        bracketFunc();
         
         // Update the partial derivative of the force error w.r.t. lce
         partialsFunc();
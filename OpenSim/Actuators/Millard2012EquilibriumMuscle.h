@@ -86,6 +86,15 @@ muscle model to be more physiological (it can have an activation of zero, its
 active-force-length curve can go to zero, and its force-velocity curve can be
 asymptotic).
 
+\li use_tabulated_curves: set to <I>true</I> to evaluate the active-force-length,
+force-velocity, passive-force-length and tendon-force-length curves (and their
+first two derivatives) with precomputed lookup tables rather than by inverting
+the underlying quintic Bezier curves. This makes each curve evaluation a
+constant-time cubic Hermite interpolation; the interpolation error of the
+values and first derivatives is below 1e-9 (see
+SmoothSegmentedFunction::createLookupTable()). The tables are built when the
+properties are finalized.
+
 <B>Elastic Tendon, No Fiber Damping</B>
 
 The most typical configuration used in the literature is to simulate a muscle
@@ -226,6 +235,9 @@ public:
         "Passive-force-length curve.");
     OpenSim_DECLARE_UNNAMED_PROPERTY(TendonForceLengthCurve,
         "Tendon-force-length curve.");
+    OpenSim_DECLARE_PROPERTY(use_tabulated_curves, bool,
+        "Evaluate the muscle curves with precomputed lookup tables, which is "
+        "faster and accurate to about 1e-9 (default: false).");
 
 //==============================================================================
 // OUTPUTS
@@ -270,6 +282,10 @@ public:
     /** @returns The fiber damping coefficient. */
     double getFiberDamping() const;
 
+    /** @returns A boolean indicating whether the muscle curves are evaluated
+    with lookup tables. */
+    bool getUseTabulatedCurves() const;
+
     /** @returns The default activation level that is used as an initial
     condition if none is provided by the user. */
     double getDefaultActivation() const;
@@ -365,6 +381,10 @@ public:
     /** @param dampingCoefficient Define the fiber damping coefficient. */
     void setFiberDamping(double dampingCoefficient);
 
+    /** @param useTabulatedCurves Evaluate the muscle curves with lookup
+    tables. Call finalizeFromProperties() for this to take effect. */
+    void setUseTabulatedCurves(bool useTabulatedCurves);
+
     /** @param activation The default activation level that is used to
     initialize the muscle. */
     void setDefaultActivation(double activation);
@@ -442,6 +462,18 @@ public:
     void computeFiberEquilibrium(SimTK::State& s, 
                                  bool solveForVelocity = false) const;
 
+    /** @returns The number of iterations used by the most recent call to
+    computeFiberEquilibrium() (0 for a rigid tendon). */
+    int getNumEquilibriumIterations() const override
+    {   return m_numEquilibriumIterations; }
+
+    bool hasForceJacobian() const override { return true; }
+    /** Computes the partial derivatives of the tendon force and the fiber
+    dynamics at the current state (see Muscle::ForceJacobian). While the fiber
+    is clamped at its minimum length, the fiber force and the fiber velocity
+    are zero, and so are their partial derivatives. */
+    ForceJacobian calcForceJacobian(const SimTK::State& s) const override;
+
 //==============================================================================
 // DEPRECATED
 //==============================================================================
@@ -563,6 +595,9 @@ private:
     // dampingCoefficient < 0.001).
     bool use_fiber_damping;
 
+    // Iterations used by the most recent equilibrium solve.
+    mutable int m_numEquilibriumIterations = -1;
+
     void setNull();
     void constructProperties();
 
@@ -759,6 +794,14 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param initialFiberLength a guess for the fiber length (e.g., from the
+           previous state); it is used as the starting point if its force
+           error is smaller than that of the default guess. Ignored if NaN.
+
+    For the static solution, the iterates at which the force error is
+    negative and positive are recorded. Once the root is bracketed, Newton
+    steps that leave the bracket are replaced with bisection steps, so the
+    solution cannot diverge.
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +810,8 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 double initialFiberLength=SimTK::NaN) const;
 
 };
 } //end of namespace OpenSim
@@ -19,6 +19,8 @@
 #include "ModelFactory.h"
 
 #include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/Model/FunctionBasedPath.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/WeldJoint.h>
@@ -317,3 +319,163 @@ void ModelFactory::createReserveActuators(Model& model, double optimalForce,
     }
 }
 
+
+void ModelFactory::replaceMusclesWithLumpedCoordinateActuators(
+        Model& model, int numSamples) {
+    OPENSIM_THROW_IF(numSamples < 2, Exception,
+            "Expected at least 2 samples but got {}.", numSamples);
+
+    struct Capacity {
+        std::string coordPath;
+        int numMuscles = 0;
+        double peakPositive = 0;
+        double peakNegative = 0;
+        double minPositive = SimTK::Infinity;
+        double minNegative = SimTK::Infinity;
+    };
+    std::vector<Capacity> capacities;
+    {
+        Model modelCopy(model);
+        SimTK::State state = modelCopy.initSystem();
+        const auto& muscles = modelCopy.getMuscles();
+        for (auto& coord : modelCopy.updComponentList<Coordinate>()) {
+            if (coord.isConstrained(state)) continue;
+            double rangeMin = coord.getRangeMin();
+            double rangeMax = coord.getRangeMax();
+            // Use a small range in the unusual case of an unbounded
+            // coordinate.
+            if (SimTK::isInf(rangeMin)) rangeMin = coord.getDefaultValue() - 1;
+            if (SimTK::isInf(rangeMax)) rangeMax = coord.getDefaultValue() + 1;
+
+            Capacity capacity;
+            capacity.coordPath = coord.getAbsolutePathString();
+            std::vector<bool> spans(muscles.getSize(), false);
+            const SimTK::Vector values =
+                    createVectorLinspace(numSamples, rangeMin, rangeMax);
+            for (int isample = 0; isample < numSamples; ++isample) {
+                coord.setValue(state, values[isample], false);
+                modelCopy.realizePosition(state);
+                double positive = 0;
+                double negative = 0;
+                for (int im = 0; im < muscles.getSize(); ++im) {
+                    const auto& muscle = muscles.get(im);
+                    const double momentArm = muscle.computeMomentArm(
+                            state, coord);
+                    if (std::abs(momentArm) < SimTK::SignificantReal) {
+                        continue;
+                    }
+                    spans[im] = true;
+                    const double torque =
+                            muscle.getMaxIsometricForce() * momentArm;
+                    if (torque > 0) {
+                        positive += torque;
+                    } else {
+                        negative -= torque;
+                    }
+                }
+                capacity.peakPositive = std::max(capacity.peakPositive, positive);
+                capacity.peakNegative = std::max(capacity.peakNegative, negative);
+                capacity.minPositive = std::min(capacity.minPositive, positive);
+                capacity.minNegative = std::min(capacity.minNegative, negative);
+            }
+            coord.setValue(state, coord.getDefaultValue(), false);
+            capacity.numMuscles =
+                    (int)std::count(spans.begin(), spans.end(), true);
+            if (capacity.numMuscles) capacities.push_back(capacity);
+        }
+    }
+
+    removeMuscles(model);
+    for (const auto& capacity : capacities) {
+        const double optimalForce =
+                std::max(capacity.peakPositive, capacity.peakNegative);
+        auto* actu = new CoordinateActuator();
+        actu->setCoordinate(
+                &model.updComponent<Coordinate>(capacity.coordPath));
+        auto path = capacity.coordPath;
+        std::replace(path.begin(), path.end(), '/', '_');
+        actu->setName("lumped" + path);
+        actu->setOptimalForce(optimalForce);
+        actu->setMinControl(-capacity.peakNegative / optimalForce);
+        actu->setMaxControl(capacity.peakPositive / optimalForce);
+        model.addForce(actu);
+    }
+    model.finalizeConnections();
+
+    // The capacity of the muscles at the weakest point in the range, as a
+    // percentage of the (constant) capacity of the lumped actuator.
+    auto percentage = [](double min, double peak) {
+        return peak > 0 ? 100.0 * min / peak : 100.0;
+    };
+    log_info("Replaced the muscles with {} lumped CoordinateActuator(s):",
+            capacities.size());
+    log_info("{:<40} {:>8} {:>12} {:>12} {:>10} {:>10}", "coordinate",
+            "muscles", "peak + (N-m)", "peak - (N-m)", "min + (%)",
+            "min - (%)");
+    for (const auto& capacity : capacities) {
+        log_info("{:<40} {:>8} {:>12.4g} {:>12.4g} {:>10.1f} {:>10.1f}",
+                capacity.coordPath, capacity.numMuscles,
+                capacity.peakPositive, capacity.peakNegative,
+                percentage(capacity.minPositive, capacity.peakPositive),
+                percentage(capacity.minNegative, capacity.peakNegative));
+    }
+}
+
+void ModelFactory::removeWrapObjects(Model& model) {
+    model.finalizeConnections();
+    std::vector<std::pair<std::string, double>> lengthsWithWrapping;
+    {
+        Model modelCopy(model);
+        SimTK::State state = modelCopy.initSystem();
+        modelCopy.realizePosition(state);
+        for (const auto& path : modelCopy.getComponentList<GeometryPath>()) {
+            if (dynamic_cast<const FunctionBasedPath*>(&path)) continue;
+            if (path.getWrapSet().getSize() == 0) continue;
+            lengthsWithWrapping.emplace_back(
+                    path.getAbsolutePathString(), path.getLength(state));
+        }
+    }
+
+    // Collect the frames and paths first; clearing the sets removes
+    // subcomponents and would invalidate the component lists.
+    std::vector<PhysicalFrame*> frames;
+    for (auto& frame : model.updComponentList<PhysicalFrame>()) {
+        frames.push_back(&frame);
+    }
+    std::vector<GeometryPath*> paths;
+    for (auto& path : model.updComponentList<GeometryPath>()) {
+        paths.push_back(&path);
+    }
+    int numWrapObjects = 0;
+    for (auto* frame : frames) {
+        numWrapObjects += frame->getWrapObjectSet().getSize();
+        frame->upd_WrapObjectSet().clearAndDestroy();
+    }
+    for (auto* path : paths) { path->updWrapSet().clearAndDestroy(); }
+    model.finalizeFromProperties();
+    model.finalizeConnections();
+
+    double maxLengthChange = 0;
+    std::string maxLengthChangePath;
+    if (!lengthsWithWrapping.empty()) {
+        SimTK::State state = model.initSystem();
+        model.realizePosition(state);
+        for (const auto& entry : lengthsWithWrapping) {
+            const double change = std::abs(
+                    model.getComponent<GeometryPath>(entry.first)
+                            .getLength(state) -
+                    entry.second);
+            if (change >= maxLengthChange) {
+                maxLengthChange = change;
+                maxLengthChangePath = entry.first;
+            }
+        }
+    }
+    log_info("Removed {} wrap object(s).", numWrapObjects);
+    if (!maxLengthChangePath.empty()) {
+        log_info("Removing wrapping changed the length of {} path(s); the "
+                 "largest change at the default pose is {:.4g} m ({}).",
+                lengthsWithWrapping.size(), maxLengthChange,
+                maxLengthChangePath);
+    }
+}
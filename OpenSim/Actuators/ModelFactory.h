@@ -91,6 +91,30 @@ public:
             double bound = SimTK::NaN,
             bool skipCoordinatesWithExistingActuators = true);
 
+    /// Replace the muscles in the ForceSet with one CoordinateActuator per
+    /// unconstrained coordinate spanned by the muscles, for fast preview
+    /// simulations. The actuators are named "lumped_<coordinate-path>" with
+    /// forward slashes converted to underscores. Each coordinate is swept
+    /// across its range (`numSamples` values; the other coordinates keep
+    /// their default values) and, at each value, the peak torque the muscles
+    /// can produce in each direction is the sum of the maximum isometric
+    /// forces times the positive (or negative) moment arms. The optimal force
+    /// of the actuator is the larger of the two peak torques over the range,
+    /// and the min and max controls are set so that the actuator can produce
+    /// exactly those peak torques. The lumped actuators lose the
+    /// angle dependence of the muscles' capacity, force-length-velocity
+    /// effects, and activation dynamics; a table of the peak torques and of
+    /// how much the muscles' capacity varies over the range (the fidelity
+    /// loss) is logged.
+    static void replaceMusclesWithLumpedCoordinateActuators(
+            Model& model, int numSamples = 20);
+
+    /// Remove all WrapObject%s from the model's frames and all PathWrap%s
+    /// from the model's paths. Paths that are not FunctionBasedPath%s become
+    /// straight lines between their path points, so their lengths change;
+    /// the largest change in length at the default pose is logged.
+    static void removeWrapObjects(Model& model);
+
     /// @}
 };
 
@@ -20,8 +20,10 @@
 
 #include "ModelProcessor.h"
 
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleGroup.h>
 #include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Simulation/Model/ExternalLoads.h>
+#include <OpenSim/Simulation/Model/PolynomialPathFitter.h>
 
 namespace OpenSim {
 
@@ -172,6 +174,128 @@ public:
     }
 };
 
+/** Replace the GeometryPath of each muscle (and of any other component with
+a path) with a FunctionBasedPath fitted by PolynomialPathFitter, which removes
+path wrapping from the simulation or optimization. If coordinates_file is
+provided (e.g., the kinematics of a MocoInverse problem), the paths are
+sampled along that coordinate trajectory, so the fitted lengths and moment
+arms match the original paths wherever the prescribed kinematics go. Paths
+that cannot be fitted keep their GeometryPath; a table of the fit errors is
+logged. */
+class OSIMACTUATORS_API ModOpReplacePathsWithFunctionBasedPaths
+        : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            ModOpReplacePathsWithFunctionBasedPaths, ModelOperator);
+    OpenSim_DECLARE_PROPERTY(coordinates_file, std::string,
+            "Table of coordinate values (e.g., a kinematics or states file) "
+            "at which to sample the paths. If empty (default), the paths are "
+            "sampled at random poses.");
+    OpenSim_DECLARE_PROPERTY(max_polynomial_order, int,
+            "The highest polynomial order to try (default: 6).");
+
+public:
+    ModOpReplacePathsWithFunctionBasedPaths() {
+        constructProperty_coordinates_file("");
+        constructProperty_max_polynomial_order(6);
+    }
+    ModOpReplacePathsWithFunctionBasedPaths(std::string coordinatesFile)
+            : ModOpReplacePathsWithFunctionBasedPaths() {
+        set_coordinates_file(std::move(coordinatesFile));
+    }
+    /// The coordinates file is located relative to `relativeToDirectory`.
+    void operate(Model& model,
+            const std::string& relativeToDirectory) const override {
+        PolynomialPathFitter fitter;
+        fitter.setMaximumPolynomialOrder(get_max_polynomial_order());
+        if (!get_coordinates_file().empty()) {
+            std::string path = get_coordinates_file();
+            if (!relativeToDirectory.empty()) {
+                using SimTK::Pathname;
+                path = Pathname::
+                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                                relativeToDirectory, path);
+            }
+            fitter.setCoordinateTrajectory(TimeSeriesTable(path));
+        }
+        PolynomialPathFitter::printResults(fitter.fit(model));
+    }
+};
+
+/** Create a reduced-order model for fast preview (screening) simulations:
+the muscles are lumped into one CoordinateActuator per coordinate
+(ModelFactory::replaceMusclesWithLumpedCoordinateActuators()), the remaining
+paths (e.g., ligaments) are replaced with FunctionBasedPath%s (as with
+ModOpReplacePathsWithFunctionBasedPaths), and the wrap objects are removed
+(ModelFactory::removeWrapObjects()). Each step can be disabled. The fidelity
+loss of each step (the angle dependence of the lumped torque capacity, the
+path fit errors, and the change in length of paths that lose their wrapping)
+is logged. Use the full model for the final solves. */
+class OSIMACTUATORS_API ModOpReduceModel : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(ModOpReduceModel, ModelOperator);
+    OpenSim_DECLARE_PROPERTY(lump_muscles, bool,
+            "Replace the muscles with lumped CoordinateActuators "
+            "(default: true).");
+    OpenSim_DECLARE_PROPERTY(num_samples, int,
+            "Number of samples across each coordinate's range used to "
+            "compute the capacity of the lumped actuators (default: 20).");
+    OpenSim_DECLARE_PROPERTY(replace_paths, bool,
+            "Replace the remaining paths with FunctionBasedPaths "
+            "(default: true).");
+    OpenSim_DECLARE_PROPERTY(coordinates_file, std::string,
+            "Table of coordinate values at which to sample the paths that "
+            "are replaced. If empty (default), the paths are sampled at "
+            "random poses.");
+    OpenSim_DECLARE_PROPERTY(max_polynomial_order, int,
+            "The highest polynomial order to try for the replaced paths "
+            "(default: 6).");
+    OpenSim_DECLARE_PROPERTY(remove_wrap_objects, bool,
+            "Remove all wrap objects (default: true).");
+
+public:
+    ModOpReduceModel() {
+        constructProperty_lump_muscles(true);
+        constructProperty_num_samples(20);
+        constructProperty_replace_paths(true);
+        constructProperty_coordinates_file("");
+        constructProperty_max_polynomial_order(6);
+        constructProperty_remove_wrap_objects(true);
+    }
+    /// The coordinates file is located relative to `relativeToDirectory`.
+    void operate(Model& model,
+            const std::string& relativeToDirectory) const override {
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+        if (get_lump_muscles()) {
+            ModelFactory::replaceMusclesWithLumpedCoordinateActuators(
+                    model, get_num_samples());
+        }
+        if (get_replace_paths()) {
+            ModOpReplacePathsWithFunctionBasedPaths replacePaths(
+                    get_coordinates_file());
+            replacePaths.set_max_polynomial_order(get_max_polynomial_order());
+            replacePaths.operate(model, relativeToDirectory);
+        }
+        if (get_remove_wrap_objects()) {
+            ModelFactory::removeWrapObjects(model);
+        }
+    }
+};
+
+/// Compute the forces of all DeGrooteFregly2016Muscle%s with rigid tendons
+/// with a single DeGrooteFregly2016MuscleGroup. Apply this after any operators
+/// that change the muscles (e.g., ModOpIgnoreTendonCompliance).
+/// @see DeGrooteFregly2016MuscleGroup::groupMuscles()
+class OSIMACTUATORS_API ModOpGroupDeGrooteFregly2016Muscles
+        : public ModelOperator {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            ModOpGroupDeGrooteFregly2016Muscles, ModelOperator);
+
+public:
+    void operate(Model& model, const std::string&) const override {
+        DeGrooteFregly2016MuscleGroup::groupMuscles(model);
+    }
+};
+
 } // namespace OpenSim
 
 #endif // OPENSIM_MODELOPERATORS_H
@@ -0,0 +1,100 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: ModelProcessor.cpp                                                *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelProcessor.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+
+using namespace OpenSim;
+
+namespace {
+struct ModelCache {
+    ResultCache<Model> models{4};
+    std::atomic<bool> enabled{false};
+};
+// The cache lives in this translation unit (rather than in the header) so
+// that there is a single cache even when the library is used from other
+// libraries.
+ModelCache& getModelCache() {
+    static ModelCache cache;
+    return cache;
+}
+} // namespace
+
+Model ModelProcessor::process(const std::string& relativeToDirectory) const {
+    std::string path;
+    if (get_filepath().empty()) {
+        OPENSIM_THROW_IF_FRMOBJ(
+                getProperty_model().empty(), Exception, "No source model.");
+    } else {
+        OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
+                "Expected either a Model object or a filepath, but "
+                "both were provided.");
+        path = get_filepath();
+        if (!relativeToDirectory.empty()) {
+            using SimTK::Pathname;
+            path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                    relativeToDirectory, path);
+        }
+    }
+
+    auto& cache = getModelCache();
+    std::string key;
+    if (cache.enabled) {
+        const std::string fileHash =
+                path.empty() ? std::string() : createFNV1aHashOfFile(path);
+        // If the file cannot be read, let the Model constructor below report
+        // the error.
+        if (path.empty() || !fileHash.empty()) {
+            key = createFNV1aHash(dump() + "\n" + relativeToDirectory + "\n" +
+                                  path + "\n" + fileHash);
+            Model model;
+            if (cache.models.find(key, model)) return model;
+        }
+    }
+
+    Model model;
+    if (path.empty()) {
+        model = get_model();
+    } else {
+        Model modelFromFile(path);
+        model = std::move(modelFromFile);
+        model.finalizeFromProperties();
+        model.finalizeConnections();
+    }
+
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(model, relativeToDirectory);
+    }
+    if (!key.empty()) cache.models.insert(key, model);
+    return model;
+}
+
+void ModelProcessor::setUseCache(bool tf) {
+    auto& cache = getModelCache();
+    cache.enabled = tf;
+    if (!tf) cache.models.clear();
+}
+
+bool ModelProcessor::getUseCache() { return getModelCache().enabled; }
+
+void ModelProcessor::setCacheCapacity(int capacity) {
+    getModelCache().models.setCapacity(capacity);
+}
+
+int ModelProcessor::getCacheSize() { return getModelCache().models.size(); }
+
+void ModelProcessor::clearCache() { getModelCache().models.clear(); }
@@ -105,36 +105,7 @@ public:
     /** Process and obtain the model. If the base model is specified via the
     filepath property, the filepath will be evaluated relative to
     `relativeToDirectory`, if provided. */
-    Model process(const std::string& relativeToDirectory = {}) const {
-        Model model;
-        if (get_filepath().empty()) {
-            if (!getProperty_model().empty()) {
-                model = get_model();
-            } else {
-                OPENSIM_THROW_FRMOBJ(Exception, "No source model.");
-            }
-        } else {
-            OPENSIM_THROW_IF_FRMOBJ(!getProperty_model().empty(), Exception,
-                    "Expected either a Model object or a filepath, but "
-                    "both were provided.");
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            Model modelFromFile(path);
-            model = std::move(modelFromFile);
-            model.finalizeFromProperties();
-            model.finalizeConnections();
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(model, relativeToDirectory);
-        }
-        return model;
-    }
+    Model process(const std::string& relativeToDirectory = {}) const;
 
     /** Append an operation to the end of the operations in this processor. */
     ModelProcessor& append(const ModelOperator& op) {
@@ -149,6 +120,28 @@ public:
         return append(right);
     }
 
+    /// @name Caching processed models
+    /// When caching is enabled, process() stores a copy of each processed
+    /// model, keyed by a hash of this processor (its base model or filepath,
+    /// and its operators), `relativeToDirectory`, and the content of the model
+    /// file. Processing the same model with the same operators again (e.g.,
+    /// for each trial of a batch) then returns a copy of the stored model.
+    /// Files that operators read (e.g., ModOpAddExternalLoads) are identified
+    /// only by their path. Models are cached in memory only, since the
+    /// geometry files of a model are located relative to the model file. The
+    /// cache is shared by all processors.
+    /// @{
+    /** Enable or disable caching of processed models (default: disabled).
+    Disabling the cache also clears it. */
+    static void setUseCache(bool tf);
+    static bool getUseCache();
+    /** The maximum number of models kept in memory (default: 4). */
+    static void setCacheCapacity(int capacity);
+    /** The number of models currently kept in memory. */
+    static int getCacheSize();
+    static void clearCache();
+    /// @}
+
 private:
     OpenSim_DECLARE_OPTIONAL_PROPERTY(model, Model, "Base model to process.");
 };
@@ -33,6 +33,7 @@
 #include "BodyActuator.h"
 #include "PointToPointActuator.h"
 #include "ClutchedPathSpring.h"
+#include "TaskSpaceController.h"
 
 #include "Thelen2003Muscle.h"
 #include "Thelen2003Muscle_Deprecated.h"
@@ -58,6 +59,7 @@
 #include "Millard2012EquilibriumMuscle.h"
 #include "Millard2012AccelerationMuscle.h"
 #include "DeGrooteFregly2016Muscle.h"
+#include "DeGrooteFregly2016MuscleGroup.h"
 
 #include "ModelOperators.h"
 
@@ -82,20 +84,22 @@ OSIMACTUATORS_API void RegisterTypes_osimActuators()
 {
   try {
 
-    Object::registerType( CoordinateActuator() );
-    Object::registerType( ActivationCoordinateActuator() );
-    Object::registerType( PointActuator() );
-    Object::registerType( TorqueActuator() );
-    Object::registerType( BodyActuator() );
-    Object::registerType( PointToPointActuator() );
-    Object::registerType( ClutchedPathSpring() );
-
-    Object::registerType( Thelen2003Muscle() );
-    Object::registerType( Thelen2003Muscle_Deprecated() );
-    Object::registerType( Schutte1993Muscle_Deprecated() );
-    Object::registerType( Delp1990Muscle_Deprecated() );
-    Object::registerType( SpringGeneralizedForce() );
-    Object::registerType( RigidTendonMuscle() );
+    Object::registerTypeLazily<CoordinateActuator>();
+    Object::registerTypeLazily<ActivationCoordinateActuator>();
+    Object::registerTypeLazily<PointActuator>();
+    Object::registerTypeLazily<TorqueActuator>();
+    Object::registerTypeLazily<BodyActuator>();
+    Object::registerTypeLazily<PointToPointActuator>();
+    Object::registerTypeLazily<ClutchedPathSpring>();
+    Object::registerTypeLazily<TaskSpaceStationTask>();
+    Object::registerTypeLazily<TaskSpaceController>();
+
+    Object::registerTypeLazily<Thelen2003Muscle>();
+    Object::registerTypeLazily<Thelen2003Muscle_Deprecated>();
+    Object::registerTypeLazily<Schutte1993Muscle_Deprecated>();
+    Object::registerTypeLazily<Delp1990Muscle_Deprecated>();
+    Object::registerTypeLazily<SpringGeneralizedForce>();
+    Object::registerTypeLazily<RigidTendonMuscle>();
 
     Object::RegisterType( ActiveForceLengthCurve() );
     Object::RegisterType( ForceVelocityCurve() );
@@ -111,15 +115,19 @@ OSIMACTUATORS_API void RegisterTypes_osimActuators()
     Object::RegisterType(Millard2012EquilibriumMuscle());
     Object::RegisterType(Millard2012AccelerationMuscle());        
     Object::RegisterType(DeGrooteFregly2016Muscle());
-
-    Object::registerType(ModelProcessor());
-    Object::registerType(ModOpIgnoreActivationDynamics());
-    Object::registerType(ModOpIgnoreTendonCompliance());
-    Object::registerType(ModOpScaleMaxIsometricForce());
-    Object::registerType(ModOpRemoveMuscles());
-    Object::registerType(ModOpAddReserves());
-    Object::registerType(ModOpAddExternalLoads());
-    Object::registerType(ModOpReplaceJointsWithWelds());
+    Object::RegisterType(DeGrooteFregly2016MuscleGroup());
+
+    Object::registerTypeLazily<ModelProcessor>();
+    Object::registerTypeLazily<ModOpIgnoreActivationDynamics>();
+    Object::registerTypeLazily<ModOpIgnoreTendonCompliance>();
+    Object::registerTypeLazily<ModOpScaleMaxIsometricForce>();
+    Object::registerTypeLazily<ModOpRemoveMuscles>();
+    Object::registerTypeLazily<ModOpAddReserves>();
+    Object::registerTypeLazily<ModOpAddExternalLoads>();
+    Object::registerTypeLazily<ModOpReplaceJointsWithWelds>();
+    Object::registerTypeLazily<ModOpGroupDeGrooteFregly2016Muscles>();
+    Object::registerTypeLazily<ModOpReplacePathsWithFunctionBasedPaths>();
+    Object::registerTypeLazily<ModOpReduceModel>();
 
     //Object::RegisterType( ConstantMuscleActivation() );
     //Object::RegisterType( ZerothOrderMuscleActivationDynamics() );
@@ -0,0 +1,247 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  TaskSpaceController.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TaskSpaceController.h"
+#include "CoordinateActuator.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+//=============================================================================
+// TASK
+//=============================================================================
+TaskSpaceStationTask::TaskSpaceStationTask() {
+    constructProperties();
+}
+
+TaskSpaceStationTask::TaskSpaceStationTask(const std::string& name,
+        const std::string& framePath, const SimTK::Vec3& location,
+        const SimTK::Vec3& target) : TaskSpaceStationTask() {
+    setName(name);
+    set_frame(framePath);
+    set_location(location);
+    set_target(target);
+}
+
+void TaskSpaceStationTask::constructProperties() {
+    constructProperty_frame("");
+    constructProperty_location(SimTK::Vec3(0));
+    constructProperty_target(SimTK::Vec3(0));
+    constructProperty_position_gain(100.0);
+    constructProperty_velocity_gain(20.0);
+}
+
+//=============================================================================
+// CONTROLLER
+//=============================================================================
+TaskSpaceController::TaskSpaceController() {
+    constructProperties();
+}
+
+void TaskSpaceController::constructProperties() {
+    constructProperty_tasks();
+    constructProperty_compensate_gravity(true);
+    constructProperty_nullspace_damping(0.0);
+}
+
+void TaskSpaceController::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    OPENSIM_THROW_IF_FRMOBJ(get_nullspace_damping() < 0, InvalidPropertyValue,
+            getProperty_nullspace_damping().getName(),
+            "Expected a non-negative value.");
+}
+
+void TaskSpaceController::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    _frames.clear();
+    for (int i = 0; i < getProperty_tasks().size(); ++i) {
+        _frames.emplace_back(
+                &model.getComponent<PhysicalFrame>(get_tasks(i).get_frame()));
+    }
+
+    for (int i = 0; i < getActuatorSet().getSize(); ++i) {
+        const auto& actuator = getActuatorSet().get(i);
+        OPENSIM_THROW_IF_FRMOBJ(
+                !dynamic_cast<const CoordinateActuator*>(&actuator),
+                Exception,
+                "Expected only CoordinateActuators, but actuator '{}' is a "
+                "{}.",
+                actuator.getName(), actuator.getConcreteClassName());
+    }
+}
+
+void TaskSpaceController::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    this->_taskSpaceInertiaCV = addCacheVariable("task_space_inertia",
+            SimTK::Matrix(), SimTK::Stage::Position);
+    this->_generalizedForcesCV = addCacheVariable("generalized_forces",
+            SimTK::Vector(), SimTK::Stage::Velocity);
+}
+
+void TaskSpaceController::extendRealizeTopology(SimTK::State& state) const {
+    Super::extendRealizeTopology(state);
+
+    // Stations are expressed in the body of the mobilizer, which is what the
+    // station Jacobian operators expect.
+    _mobodIndices.clear();
+    _stationsInMobod.clear();
+    for (int i = 0; i < (int)_frames.size(); ++i) {
+        _mobodIndices.push_back(_frames[i]->getMobilizedBodyIndex());
+        _stationsInMobod.push_back(_frames[i]->findTransformInBaseFrame() *
+                                   get_tasks(i).get_location());
+    }
+
+    const auto& matter = getModel().getMatterSubsystem();
+    _actuatorUIndices.clear();
+    for (int i = 0; i < getActuatorSet().getSize(); ++i) {
+        const auto& actuator = static_cast<const CoordinateActuator&>(
+                getActuatorSet().get(i));
+        const auto& coord =
+                getModel().getCoordinateSet().get(actuator.get_coordinate());
+        const auto& mobod = matter.getMobilizedBody(coord.getBodyIndex());
+        _actuatorUIndices.push_back(
+                mobod.getFirstUIndex(state) + coord.getMobilizerQIndex());
+    }
+}
+
+const SimTK::Matrix& TaskSpaceController::getTaskSpaceInertia(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _taskSpaceInertiaCV)) {
+        return getCacheVariableValue(s, _taskSpaceInertiaCV);
+    }
+
+    // Build the inverse task-space inertia J M^-1 J^T one column at a time,
+    // applying the O(n) operators to each unit task force.
+    const auto& matter = getModel().getMatterSubsystem();
+    const int nt = (int)_mobodIndices.size();
+    SimTK::Matrix inverseInertia(3 * nt, 3 * nt);
+    SimTK::Vector_<SimTK::Vec3> taskForces(nt, SimTK::Vec3(0));
+    SimTK::Vector_<SimTK::Vec3> taskAccelerations(nt);
+    SimTK::Vector generalizedForces(s.getNU());
+    SimTK::Vector udot(s.getNU());
+    for (int k = 0; k < 3 * nt; ++k) {
+        taskForces[k / 3][k % 3] = 1;
+        matter.multiplyByStationJacobianTranspose(s, _mobodIndices,
+                _stationsInMobod, taskForces, generalizedForces);
+        matter.multiplyByMInv(s, generalizedForces, udot);
+        matter.multiplyByStationJacobian(s, _mobodIndices, _stationsInMobod,
+                udot, taskAccelerations);
+        for (int i = 0; i < nt; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                inverseInertia(3 * i + j, k) = taskAccelerations[i][j];
+            }
+        }
+        taskForces[k / 3][k % 3] = 0;
+    }
+
+    // QTZ gives the pseudo-inverse near singular configurations (e.g., a
+    // fully extended limb or two tasks on the same station).
+    SimTK::Matrix& inertia = updCacheVariableValue(s, _taskSpaceInertiaCV);
+    SimTK::FactorQTZ(inverseInertia).inverse(inertia);
+    markCacheVariableValid(s, _taskSpaceInertiaCV);
+    return inertia;
+}
+
+const SimTK::Vector& TaskSpaceController::getGeneralizedForces(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _generalizedForcesCV)) {
+        return getCacheVariableValue(s, _generalizedForcesCV);
+    }
+
+    const auto& matter = getModel().getMatterSubsystem();
+    const int nt = (int)_mobodIndices.size();
+    const SimTK::Vector& u = s.getU();
+    const double kd = get_nullspace_damping();
+
+    SimTK::Vector_<SimTK::Vec3> JDotu;
+    matter.calcBiasForStationJacobian(
+            s, _mobodIndices, _stationsInMobod, JDotu);
+    SimTK::Vector_<SimTK::Vec3> JMInvu(nt, SimTK::Vec3(0));
+    if (kd != 0) {
+        // Cancel the effect of the joint damping on the tasks.
+        SimTK::Vector MInvu;
+        matter.multiplyByMInv(s, u, MInvu);
+        matter.multiplyByStationJacobian(
+                s, _mobodIndices, _stationsInMobod, MInvu, JMInvu);
+    }
+
+    SimTK::Vector desired(3 * nt);
+    for (int i = 0; i < nt; ++i) {
+        const TaskSpaceStationTask& task = get_tasks(i);
+        const auto& mobod = matter.getMobilizedBody(_mobodIndices[i]);
+        const SimTK::Vec3 position =
+                mobod.findStationLocationInGround(s, _stationsInMobod[i]);
+        const SimTK::Vec3 velocity =
+                mobod.findStationVelocityInGround(s, _stationsInMobod[i]);
+        const SimTK::Vec3 accel =
+                task.get_position_gain() * (task.get_target() - position) -
+                task.get_velocity_gain() * velocity - JDotu[i] +
+                kd * JMInvu[i];
+        for (int j = 0; j < 3; ++j) { desired[3 * i + j] = accel[j]; }
+    }
+
+    const SimTK::Vector F = getTaskSpaceInertia(s) * desired;
+    SimTK::Vector_<SimTK::Vec3> taskForces(nt);
+    for (int i = 0; i < nt; ++i) {
+        taskForces[i] = SimTK::Vec3(F[3 * i], F[3 * i + 1], F[3 * i + 2]);
+    }
+
+    SimTK::Vector& tau = updCacheVariableValue(s, _generalizedForcesCV);
+    matter.multiplyByStationJacobianTranspose(
+            s, _mobodIndices, _stationsInMobod, taskForces, tau);
+
+    // With zero accelerations, the residual is the Coriolis and centrifugal
+    // forces minus the applied (gravity) forces.
+    SimTK::Vector_<SimTK::SpatialVec> gravityForces(matter.getNumBodies(),
+            SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0)));
+    if (get_compensate_gravity() &&
+            !getModel().getGravityForce().isDisabled(s)) {
+        const SimTK::Vec3 gravity = getModel().getGravity();
+        for (SimTK::MobilizedBodyIndex b(1); b < matter.getNumBodies(); ++b) {
+            const auto& mobod = matter.getMobilizedBody(b);
+            mobod.applyForceToBodyPoint(s, mobod.getBodyMassCenterStation(s),
+                    mobod.getBodyMass(s) * gravity, gravityForces);
+        }
+    }
+    SimTK::Vector residual;
+    matter.calcResidualForceIgnoringConstraints(s, SimTK::Vector(),
+            gravityForces, SimTK::Vector(), residual);
+    tau += residual;
+    if (kd != 0) { tau -= kd * u; }
+
+    markCacheVariableValid(s, _generalizedForcesCV);
+    return tau;
+}
+
+void TaskSpaceController::computeControls(
+        const SimTK::State& s, SimTK::Vector& controls) const {
+    const SimTK::Vector& tau = getGeneralizedForces(s);
+    const auto& indices = getActuatorControlIndices();
+    for (int i = 0; i < getActuatorSet().getSize(); ++i) {
+        const auto& actuator = static_cast<const CoordinateActuator&>(
+                getActuatorSet().get(i));
+        controls[indices[i]] +=
+                tau[_actuatorUIndices[i]] / actuator.getOptimalForce();
+    }
+}
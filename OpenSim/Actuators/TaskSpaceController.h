@@ -0,0 +1,150 @@
+#ifndef OPENSIM_TASK_SPACE_CONTROLLER_H_
+#define OPENSIM_TASK_SPACE_CONTROLLER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  TaskSpaceController.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/osimActuatorsDLL.h>
+#include <OpenSim/Simulation/Control/Controller.h>
+
+namespace OpenSim {
+
+class PhysicalFrame;
+
+/** A task for a TaskSpaceController: drive a station (a point fixed on a
+frame) to a target location in ground with the acceleration
+\f[
+    \ddot{x}^* = k_p (x_{target} - x) - k_v \dot{x}.
+\f] */
+class OSIMACTUATORS_API TaskSpaceStationTask : public Object {
+OpenSim_DECLARE_CONCRETE_OBJECT(TaskSpaceStationTask, Object);
+public:
+    OpenSim_DECLARE_PROPERTY(frame, std::string,
+        "Path to the PhysicalFrame on which the station is fixed.");
+    OpenSim_DECLARE_PROPERTY(location, SimTK::Vec3,
+        "Location of the station in the frame (default: origin).");
+    OpenSim_DECLARE_PROPERTY(target, SimTK::Vec3,
+        "Target location of the station, expressed in ground.");
+    OpenSim_DECLARE_PROPERTY(position_gain, double,
+        "Stiffness of the task, in 1/s^2 (default: 100).");
+    OpenSim_DECLARE_PROPERTY(velocity_gain, double,
+        "Damping of the task, in 1/s (default: 20).");
+
+    TaskSpaceStationTask();
+    TaskSpaceStationTask(const std::string& name,
+            const std::string& framePath, const SimTK::Vec3& location,
+            const SimTK::Vec3& target);
+
+private:
+    void constructProperties();
+};
+
+/** A Controller that computes the generalized forces that give its
+TaskSpaceStationTask%s their desired accelerations, using operational space
+control. The task-space inertia
+\f$ \Lambda = (J M^{-1} J^T)^{-1} \f$ and the task forces
+\f[
+    F = \Lambda (\ddot{x}^* - \dot{J} u + k_d J M^{-1} u)
+\f]
+are mapped to the generalized forces
+\f[
+    \tau = J^T F + c(q, u) - g(q) - k_d u,
+\f]
+where \f$ c \f$ are the Coriolis and centrifugal forces, \f$ g \f$ are the
+generalized gravity forces (omitted if `compensate_gravity` is false) and
+\f$ k_d \f$ is the `nullspace_damping`, which damps the joint motions that do
+not affect the tasks.
+
+The station Jacobian \f$ J \f$ and the mass matrix are never formed: the
+products with \f$ J \f$, \f$ J^T \f$ and \f$ M^{-1} \f$ use Simbody's O(n)
+operators (multiplyByStationJacobian(), multiplyByMInv(), etc.) and
+\f$ \dot{J} u \f$ comes from calcBiasForStationJacobian(). \f$ \Lambda \f$ is
+computed once per configuration (it is cached at the Position stage) and the
+generalized forces once per state (Velocity stage), so evaluating the
+controls repeatedly at the same state is cheap.
+
+The actuators of this controller must be CoordinateActuator%s; the control of
+each is the generalized force for its coordinate divided by its
+`optimal_force`. Generalized forces for coordinates without an actuator are
+dropped, so the tasks are only tracked exactly if every degree of freedom is
+actuated. Kinematic constraints are ignored.
+
+@code
+auto* controller = new TaskSpaceController();
+controller->setActuators(model.updActuators());
+controller->addTask(TaskSpaceStationTask("hand", "/bodyset/forearm",
+        SimTK::Vec3(0, -0.3, 0), SimTK::Vec3(0.2, -0.4, 0)));
+model.addController(controller);
+@endcode */
+class OSIMACTUATORS_API TaskSpaceController : public Controller {
+OpenSim_DECLARE_CONCRETE_OBJECT(TaskSpaceController, Controller);
+public:
+    OpenSim_DECLARE_LIST_PROPERTY(tasks, TaskSpaceStationTask,
+        "The station tasks to track.");
+    OpenSim_DECLARE_PROPERTY(compensate_gravity, bool,
+        "Cancel the generalized gravity forces (default: true).");
+    OpenSim_DECLARE_PROPERTY(nullspace_damping, double,
+        "Damping of the joint motions that do not affect the tasks, in "
+        "N-m-s/rad (default: 0).");
+
+    TaskSpaceController();
+
+    /** Add a task; returns its index in the `tasks` property. */
+    int addTask(const TaskSpaceStationTask& task) {
+        return append_tasks(task);
+    }
+
+    /** The task-space inertia \f$ \Lambda \f$, with 3 rows and columns per
+    task, in the order of the `tasks` property. The state must be realized to
+    Position. */
+    const SimTK::Matrix& getTaskSpaceInertia(const SimTK::State& s) const;
+
+    /** The generalized forces \f$ \tau \f$ that give the tasks their desired
+    accelerations (one per mobility). The state must be realized to
+    Velocity. */
+    const SimTK::Vector& getGeneralizedForces(const SimTK::State& s) const;
+
+    void computeControls(const SimTK::State& s,
+                         SimTK::Vector& controls) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendRealizeTopology(SimTK::State& state) const override;
+
+private:
+    void constructProperties();
+
+    std::vector<SimTK::ReferencePtr<const PhysicalFrame>> _frames;
+
+    // Resolved when the system is created.
+    mutable SimTK::Array_<SimTK::MobilizedBodyIndex> _mobodIndices;
+    mutable SimTK::Array_<SimTK::Vec3> _stationsInMobod;
+    mutable std::vector<int> _actuatorUIndices;
+
+    mutable CacheVariable<SimTK::Matrix> _taskSpaceInertiaCV;
+    mutable CacheVariable<SimTK::Vector> _generalizedForcesCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TASK_SPACE_CONTROLLER_H_
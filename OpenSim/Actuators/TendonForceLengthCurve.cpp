@@ -101,9 +101,19 @@ void TendonForceLengthCurve::buildCurve(bool computeIntegral)
                                      getName());
     m_curve = *f;
     delete f;
+    if (m_useLookupTable) m_curve.createLookupTable();
     setObjectIsUpToDateWithProperties();
 }
 
+void TendonForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    m_useLookupTable = useLookupTable;
+    if (isObjectUpToDateWithProperties()) {
+        if (!m_useLookupTable) m_curve.clearLookupTable();
+        else if (!m_curve.hasLookupTable()) m_curve.createLookupTable();
+    }
+}
+
 void TendonForceLengthCurve::ensureCurveUpToDate()
 {
     if(isObjectUpToDateWithProperties()) {
@@ -235,6 +245,27 @@ double TendonForceLengthCurve::calcDerivative(double aNormLength,
     return m_curve.calcDerivative(aNormLength,order);
 }
 
+void TendonForceLengthCurve::calcValues(
+        const SimTK::Vector& normTendonLengths, SimTK::Vector& values) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
+    m_curve.calcValues(normTendonLengths, values);
+}
+
+void TendonForceLengthCurve::calcDerivatives(
+        const SimTK::Vector& normTendonLengths, int order,
+        SimTK::Vector& derivatives) const
+{
+    SimTK_ASSERT(isObjectUpToDateWithProperties(),
+        "TendonForceLengthCurve: Tendon is not up-to-date with its properties");
+    SimTK_ERRCHK1_ALWAYS(order >= 0 && order <= 2,
+        "TendonForceLengthCurve::calcDerivatives",
+        "order must be 0, 1, or 2, but %i was entered", order);
+
+    m_curve.calcDerivatives(normTendonLengths, order, derivatives);
+}
+
 double TendonForceLengthCurve::
     calcDerivative(const std::vector<int>& derivComponents,
                    const SimTK::Vector& x) const
@@ -274,6 +274,21 @@ public:
         normalized tendon length.
     */
     double calcDerivative(double aNormLength, int order) const;
+
+    /** Evaluates the curve at each of the normalized tendon lengths in
+    'normTendonLengths' (e.g., for many muscles that share this curve's
+    properties); this is faster than calling calcValue() for each of them.
+    The curve must be up-to-date with its properties. See
+    SmoothSegmentedFunction::calcValues().
+    @param values Resized to the size of 'normTendonLengths'. */
+    void calcValues(const SimTK::Vector& normTendonLengths,
+                    SimTK::Vector& values) const;
+
+    /** Evaluates the derivative of the given order (0, 1, or 2) of the
+    curve at each of the normalized tendon lengths in 'normTendonLengths'.
+    See calcValues(). */
+    void calcDerivatives(const SimTK::Vector& normTendonLengths, int order,
+                         SimTK::Vector& derivatives) const;
     
     /// If possible, use the simpler overload above.
     double calcDerivative(const std::vector<int>& derivComponents,
@@ -331,6 +346,15 @@ public:
     void printMuscleCurveToCSVFile(const std::string& path);
 
     void ensureCurveUpToDate();
+
+    /** Evaluate the curve and its first two derivatives with a precomputed
+    lookup table (see SmoothSegmentedFunction::createLookupTable()) rather than
+    by inverting the underlying Bezier curves. The table is rebuilt whenever
+    the curve is rebuilt. This setting is not a property; it is typically set
+    by the muscle that owns the curve (e.g., by the `use_tabulated_curves`
+    property of Millard2012EquilibriumMuscle). */
+    void setUseLookupTable(bool useLookupTable);
+    bool getUseLookupTable() const { return m_useLookupTable; }
 //==============================================================================
 // PRIVATE
 //==============================================================================
@@ -368,6 +392,7 @@ private:
     void buildCurve(bool computeIntegral = false);
 
     SmoothSegmentedFunction m_curve;
+    bool m_useLookupTable = false;
 
     double m_normForceAtToeEndInUse;
     double m_stiffnessAtOneNormForceInUse;
@@ -29,6 +29,7 @@
 //    4. testMcKibbenActuator()
 //    5. testActuatorsCombination()
 //    6. testActivationCoordinateActuator()
+//    7. testTaskSpaceController()
 //
 //     Add tests here as Actuators are added to OpenSim
 //
@@ -57,6 +58,7 @@ void testClutchedPathSpring();
 void testMcKibbenActuator();
 void testActuatorsCombination();
 void testActivationCoordinateActuator();
+void testTaskSpaceController();
 
 
 int main()
@@ -87,6 +89,10 @@ int main()
     catch (const std::exception& e) {
         cout << e.what() << endl; failures.push_back("testActivationCoordinateActuator");
     }
+    try { testTaskSpaceController(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testTaskSpaceController");
+    }
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -967,3 +973,80 @@ void testActivationCoordinateActuator() {
             aca->getStateVariableValue(state, "activation");
     ASSERT_EQUAL(expectedFinalActivation, foundFinalActivation, 1e-4);
 }
+
+// The station of a task must have the commanded acceleration, with gravity,
+// Coriolis forces and joint damping cancelled, and the controller must
+// bring the station to its target.
+void testTaskSpaceController() {
+    using SimTK::Vec3;
+    Model model;
+    model.setGravity(gravity_vec);
+    auto* upper = new Body("upper", 2.0, Vec3(0, -0.25, 0),
+            SimTK::Inertia::cylinderAlongY(0.05, 0.5) * 2.0);
+    auto* lower = new Body("lower", 1.0, Vec3(0, -0.2, 0),
+            SimTK::Inertia::cylinderAlongY(0.04, 0.4));
+    auto* shoulder = new PinJoint("shoulder", model.getGround(), *upper);
+    shoulder->updCoordinate().setName("q0");
+    auto* elbow = new PinJoint("elbow", *upper, Vec3(0, -0.5, 0), Vec3(0),
+            *lower, Vec3(0), Vec3(0));
+    elbow->updCoordinate().setName("q1");
+    model.addBody(upper);
+    model.addBody(lower);
+    model.addJoint(shoulder);
+    model.addJoint(elbow);
+    for (const std::string name : {"q0", "q1"}) {
+        auto* actuator = new CoordinateActuator(name);
+        actuator->setName("tau_" + name);
+        actuator->setOptimalForce(10.0);
+        model.addForce(actuator);
+    }
+
+    const Vec3 station(0, -0.4, 0);
+    const Vec3 target(0.3, -0.6, 0);
+    auto* controller = new TaskSpaceController();
+    controller->setName("task_space");
+    controller->setActuators(model.updActuators());
+    controller->addTask(
+            TaskSpaceStationTask("hand", "/bodyset/lower", station, target));
+    controller->set_nullspace_damping(0.5);
+    model.addController(controller);
+    model.finalizeConnections();
+    model.print("Model_TaskSpaceController.osim");
+
+    Model deserialized("Model_TaskSpaceController.osim");
+    ASSERT(model == deserialized);
+
+    SimTK::State state = deserialized.initSystem();
+    const auto& coords = deserialized.getCoordinateSet();
+    coords.get("q0").setValue(state, 0.3);
+    coords.get("q1").setValue(state, 0.8);
+    coords.get("q0").setSpeedValue(state, 0.5);
+    coords.get("q1").setSpeedValue(state, -0.4);
+    deserialized.realizeAcceleration(state);
+
+    const auto& task = deserialized.getComponent<TaskSpaceController>(
+            "/controllerset/task_space").get_tasks(0);
+    const auto& frame = deserialized.getComponent<PhysicalFrame>(
+            "/bodyset/lower");
+    const Vec3 expected =
+            task.get_position_gain() *
+                    (target - frame.findStationLocationInGround(
+                                      state, station)) -
+            task.get_velocity_gain() *
+                    frame.findStationVelocityInGround(state, station);
+    const Vec3 actual = frame.findStationAccelerationInGround(state, station);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQUAL(expected[i], actual[i], 1e-8, __FILE__, __LINE__,
+                "Station acceleration does not match the task.");
+    }
+
+    Manager manager(deserialized);
+    manager.setIntegratorAccuracy(integ_accuracy);
+    manager.initialize(state);
+    state = manager.integrate(2.0);
+    deserialized.realizePosition(state);
+    const Vec3 error =
+            target - frame.findStationLocationInGround(state, station);
+    ASSERT(error.norm() < 1e-3, __FILE__, __LINE__,
+            "The station did not reach its target.");
+}
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleGroup.h>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
@@ -1060,6 +1061,69 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
             CHECK(residual ==
                     Approx(normTendonForce - normFiberForce).margin(1e-6));
         }
+
+        SECTION("calcForceJacobian()") {
+            // Compare the analytic partial derivatives to finite differences.
+            auto& mutMuscle =
+                    model.updComponent<DeGrooteFregly2016Muscle>("muscle");
+            mutMuscle.set_ignore_tendon_compliance(false);
+            mutMuscle.set_tendon_compliance_dynamics_mode("explicit");
+            mutMuscle.set_pennation_angle_at_optimal(0.1);
+            SimTK::State state = model.initSystem();
+            CHECK(muscle.hasForceJacobian());
+            const double muscleTendonLength =
+                    muscle.get_optimal_fiber_length() +
+                    muscle.get_tendon_slack_length();
+            const double activation = 0.6;
+            const double normTendonForce = 0.5;
+            coord.setValue(state, muscleTendonLength);
+            muscle.setActivation(state, activation);
+            muscle.setNormalizedTendonForce(state, normTendonForce);
+            model.realizeVelocity(state);
+            const auto jac = muscle.calcForceJacobian(state);
+            const double fiso = muscle.get_max_isometric_force();
+
+            // The fiber force along the tendon does not depend on the tendon
+            // force derivative, so we can use the implicit equilibrium
+            // residual (normTendonForce - normFiberForceAlongTendon).
+            const double h = 1e-6;
+            const auto residual = [&](double a) {
+                return muscle.calcEquilibriumResidual(muscleTendonLength, 0,
+                        a, normTendonForce, 0);
+            };
+            CHECK(jac.fiberForceAlongTendon[0] ==
+                    Approx(-fiso * (residual(activation + h) -
+                                           residual(activation - h)) /
+                            (2 * h)).epsilon(1e-5));
+            CHECK(jac.tendonForce[0] == 0);
+            CHECK(jac.tendonForce[3] ==
+                    Approx(muscle.getTendonStiffness(state)));
+            CHECK(jac.normFiberLengthDerivative[2] == 0);
+
+            // In explicit mode, the fiber velocity is computed from the
+            // equilibrium; the fiber length is fixed by the state.
+            const auto normFiberLengthDerivative = [&](double a) {
+                muscle.setActivation(state, a);
+                model.realizeVelocity(state);
+                return muscle.get_max_contraction_velocity() *
+                       muscle.getNormalizedFiberVelocity(state);
+            };
+            const double fdActivation =
+                    (normFiberLengthDerivative(activation + h) -
+                            normFiberLengthDerivative(activation - h)) /
+                    (2 * h);
+            CHECK(jac.normFiberLengthDerivative[0] ==
+                    Approx(fdActivation).epsilon(1e-5));
+
+            // Derivative of the force-velocity multiplier.
+            for (const double vN : {-0.8, -0.2, 0.0, 0.3, 0.9}) {
+                CHECK(muscle.calcForceVelocityMultiplierDerivative(vN) ==
+                        Approx((muscle.calcForceVelocityMultiplier(vN + h) -
+                                       muscle.calcForceVelocityMultiplier(
+                                               vN - h)) /
+                                (2 * h)).epsilon(1e-6));
+            }
+        }
     }
 
     SECTION("Force-velocity curve inverse") {
@@ -1085,3 +1149,88 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+TEST_CASE("DeGrooteFregly2016MuscleGroup") {
+    Model model;
+    model.setName("muscle_group");
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("x");
+    model.addComponent(joint);
+    const std::vector<double> pennation = {0.0, 0.2, 0.4};
+    for (int i = 0; i < 3; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_ignore_tendon_compliance(true);
+        muscle->set_max_isometric_force(100.0 * (i + 1));
+        muscle->set_optimal_fiber_length(0.1 + 0.02 * i);
+        muscle->set_tendon_slack_length(0.2 - 0.03 * i);
+        muscle->set_pennation_angle_at_optimal(pennation[i]);
+        muscle->set_fiber_damping(0.01 * i);
+        muscle->set_active_force_width_scale(1.0 + 0.2 * i);
+        muscle->set_ignore_passive_fiber_force(i == 2);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addComponent(muscle);
+    }
+    // Muscles with compliant tendons are not grouped.
+    auto* compliant = new DeGrooteFregly2016Muscle();
+    compliant->setName("compliant");
+    compliant->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+    compliant->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+    model.addComponent(compliant);
+    model.finalizeConnections();
+
+    Model grouped = model;
+    CHECK(DeGrooteFregly2016MuscleGroup::groupMuscles(grouped) == 3);
+    const auto& group = grouped.getComponent<DeGrooteFregly2016MuscleGroup>(
+            "/forceset/degrootefregly2016_muscle_group");
+    CHECK(group.getNumMuscles() == 3);
+    CHECK(grouped.getComponent<Muscle>("/muscle0").get_appliesForce() == false);
+    CHECK(grouped.getComponent<Muscle>("/compliant").get_appliesForce());
+
+    SimTK::State state = model.initSystem();
+    SimTK::State groupedState = grouped.initSystem();
+    for (auto* s : {&state, &groupedState}) {
+        const Model& m = (s == &state) ? model : grouped;
+        m.getCoordinateSet().get("x").setValue(*s, 0.32);
+        m.getCoordinateSet().get("x").setSpeedValue(*s, -0.7);
+        for (int i = 0; i < 3; ++i) {
+            m.getComponent<DeGrooteFregly2016Muscle>(
+                     "/muscle" + std::to_string(i))
+                    .setActivation(*s, 0.2 + 0.3 * i);
+        }
+        m.realizeAcceleration(*s);
+    }
+
+    const SimTK::Vector& tendonForce = group.getTendonForce(groupedState);
+    for (int i = 0; i < 3; ++i) {
+        const auto& muscle = model.getComponent<DeGrooteFregly2016Muscle>(
+                "/muscle" + std::to_string(i));
+        CAPTURE(i);
+        CHECK(group.getFiberLength(groupedState)[i] ==
+                Approx(muscle.getFiberLength(state)));
+        CHECK(group.getPennationAngle(groupedState)[i] ==
+                Approx(muscle.getPennationAngle(state)));
+        CHECK(group.getNormalizedFiberVelocity(groupedState)[i] ==
+                Approx(muscle.getNormalizedFiberVelocity(state)));
+        CHECK(group.getActiveForceLengthMultiplier(groupedState)[i] ==
+                Approx(muscle.getActiveForceLengthMultiplier(state)));
+        CHECK(group.getPassiveForceMultiplier(groupedState)[i] ==
+                Approx(muscle.getPassiveForceMultiplier(state)));
+        CHECK(group.getForceVelocityMultiplier(groupedState)[i] ==
+                Approx(muscle.getForceVelocityMultiplier(state)));
+        CHECK(tendonForce[i] == Approx(muscle.getTendonForce(state)));
+    }
+    CHECK(groupedState.getUDot()[0] == Approx(state.getUDot()[0]));
+
+    SECTION("Members must have rigid tendons and must not apply force") {
+        Model invalid = grouped;
+        invalid.updComponent<DeGrooteFregly2016MuscleGroup>(
+                       "/forceset/degrootefregly2016_muscle_group")
+                .appendMuscle("/compliant");
+        CHECK_THROWS_AS(invalid.initSystem(), Exception);
+    }
+}
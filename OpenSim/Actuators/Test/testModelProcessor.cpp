@@ -78,6 +78,44 @@ TEST_CASE("ModelProcessor") {
             CHECK(modelDeserialized.getAnalysisSet().getSize() == 1);
         }
     }
+
+    SECTION("Cache") {
+        static int numOperations = 0;
+        class CountingModelOperator : public ModelOperator {
+            OpenSim_DECLARE_CONCRETE_OBJECT(
+                    CountingModelOperator, ModelOperator);
+
+        public:
+            void operate(Model& model, const std::string&) const override {
+                ++numOperations;
+                model.addAnalysis(new MuscleAnalysis());
+            }
+        };
+        model.print("testModelProcessor_cache.osim");
+        ModelProcessor proc = ModelProcessor("testModelProcessor_cache.osim") |
+                              CountingModelOperator();
+        ModelProcessor::setUseCache(true);
+        ModelProcessor::clearCache();
+        CHECK(proc.process().getAnalysisSet().getSize() == 1);
+        CHECK(proc.process().getAnalysisSet().getSize() == 1);
+        CHECK(numOperations == 1);
+        CHECK(ModelProcessor::getCacheSize() == 1);
+
+        // Changing the operators or the model file invalidates the result.
+        ModelProcessor proc2 = proc;
+        proc2.append(MyModelOperator());
+        CHECK(proc2.process().getAnalysisSet().getSize() == 2);
+        CHECK(numOperations == 2);
+        model.setName("changed");
+        model.print("testModelProcessor_cache.osim");
+        CHECK(proc.process().getName() == "changed");
+        CHECK(numOperations == 3);
+
+        ModelProcessor::setUseCache(false);
+        CHECK(ModelProcessor::getCacheSize() == 0);
+        proc.process();
+        CHECK(numOperations == 4);
+    }
 }
 
 TEST_CASE("ModOpRemoveMuscles") {
@@ -108,3 +146,84 @@ TEST_CASE("ModOpRemoveMuscles") {
     CHECK(processedModel.countNumComponents<Millard2012EquilibriumMuscle>() ==
             0);
 }
+
+TEST_CASE("ModOpReduceModel") {
+    Model model;
+    using SimTK::Vec3;
+    using SimTK::Inertia;
+    auto* body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0));
+    auto* joint = new PinJoint("joint",
+            model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1, 0), Vec3(0));
+    auto& coord = joint->updCoordinate();
+    coord.setName("q");
+    coord.setRangeMin(-0.5);
+    coord.setRangeMax(0.5);
+
+    // A flexor and a weaker extensor that wraps over a cylinder.
+    auto* flexor = new
+            Millard2012EquilibriumMuscle("flexor", 200, 0.6, 0.55, 0);
+    flexor->addNewPathPoint("origin", model.getGround(), Vec3(0.1, 0.8, 0));
+    flexor->addNewPathPoint("insertion", *body, Vec3(0.1, 0.7, 0));
+    auto* extensor = new
+            Millard2012EquilibriumMuscle("extensor", 100, 0.6, 0.55, 0);
+    extensor->addNewPathPoint("origin", model.getGround(), Vec3(-0.1, 0.8, 0));
+    extensor->addNewPathPoint("insertion", *body, Vec3(-0.1, 0.7, 0));
+    auto* cylinder = new WrapCylinder();
+    cylinder->setName("cylinder");
+    cylinder->set_radius(0.05);
+    cylinder->set_length(0.2);
+    cylinder->set_translation(Vec3(-0.13, 0.25, 0));
+    model.updGround().addWrapObject(cylinder);
+    extensor->updGeometryPath().addPathWrap(*cylinder);
+
+    model.addBody(body);
+    model.addJoint(joint);
+    model.addForce(flexor);
+    model.addForce(extensor);
+    model.finalizeConnections();
+
+    // Compute the expected peak torques over the same samples.
+    double expectedPositive = 0;
+    double expectedNegative = 0;
+    {
+        Model copy(model);
+        SimTK::State state = copy.initSystem();
+        auto& q = copy.updCoordinateSet().get("q");
+        const SimTK::Vector values = createVectorLinspace(10, -0.5, 0.5);
+        for (int i = 0; i < values.size(); ++i) {
+            q.setValue(state, values[i], false);
+            copy.realizePosition(state);
+            double positive = 0;
+            double negative = 0;
+            for (const auto& muscle : copy.getComponentList<Muscle>()) {
+                const double torque = muscle.getMaxIsometricForce() *
+                                      muscle.computeMomentArm(state, q);
+                if (torque > 0) positive += torque; else negative -= torque;
+            }
+            expectedPositive = std::max(expectedPositive, positive);
+            expectedNegative = std::max(expectedNegative, negative);
+        }
+    }
+    REQUIRE(expectedPositive > 0);
+    REQUIRE(expectedNegative > 0);
+
+    ModOpReduceModel reduce;
+    reduce.set_num_samples(10);
+    ModelProcessor proc = ModelProcessor(model) | reduce;
+    Model reduced = proc.process();
+    reduced.initSystem();
+
+    CHECK(reduced.countNumComponents<Muscle>() == 0);
+    CHECK(reduced.countNumComponents<WrapObject>() == 0);
+    REQUIRE(reduced.countNumComponents<CoordinateActuator>() == 1);
+    const auto& actu = reduced.getComponent<CoordinateActuator>(
+            "/forceset/lumped_jointset_joint_q");
+    CHECK(actu.getCoordinate()->getName() == "q");
+    CHECK(actu.getOptimalForce() ==
+            Approx(std::max(expectedPositive, expectedNegative)));
+    CHECK(actu.getMaxControl() * actu.getOptimalForce() ==
+            Approx(expectedPositive));
+    CHECK(actu.getMinControl() * actu.getOptimalForce() ==
+            Approx(-expectedNegative));
+}
@@ -901,6 +901,150 @@ void testMillard2012EquilibriumMuscle()
         muscle->computeInitialFiberEquilibrium(state);
     }
 
+    // Test the equilibrium diagnostics and the warm start from the fiber
+    // length in the state.
+    {
+        Model model;
+        auto muscle = new Millard2012EquilibriumMuscle("muscle",
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle0);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", model.updGround(),
+                SimTK::Vec3(0, 0, 1.1*(OptimalFiberLength0 +
+                                       TendonSlackLength0)));
+        model.addForce(muscle);
+
+        SimTK::State& state = model.initSystem();
+        muscle->setActivation(state, 0.5);
+        auto results = model.equilibrateMusclesWithDiagnostics(state);
+        ASSERT(results.size() == 1, __FILE__, __LINE__,
+                "Expected a result for one muscle.");
+        ASSERT(results[0].success, __FILE__, __LINE__, results[0].message);
+        ASSERT(results[0].path == muscle->getAbsolutePathString(), __FILE__,
+                __LINE__, "Expected the result to be for the muscle.");
+        const int coldIterations = results[0].iterations;
+        ASSERT(coldIterations >= 0, __FILE__, __LINE__,
+                "Expected the number of iterations to be reported.");
+
+        model.realizeDynamics(state);
+        ASSERT_EQUAL(muscle->getTendonForce(state),
+                muscle->getActiveFiberForceAlongTendon(state) +
+                muscle->getPassiveFiberForceAlongTendon(state),
+                MaxIsometricForce0*SimTK::SqrtEps, __FILE__, __LINE__,
+                "Fiber and tendon forces are not in equilibrium.");
+
+        // The state already holds the solution, so the warm-started solve
+        // should not need more iterations.
+        results = model.equilibrateMusclesWithDiagnostics(state);
+        ASSERT(results[0].success, __FILE__, __LINE__, results[0].message);
+        ASSERT(results[0].iterations <= coldIterations, __FILE__, __LINE__,
+                "Expected the warm start to reduce the number of iterations.");
+    }
+
+    // The equilibrium table gives the same solution, starting from a point
+    // between the grid points of the table.
+    {
+        auto createModel = [&](bool useTable) {
+            Model model;
+            auto muscle = new Millard2012EquilibriumMuscle("muscle",
+                    MaxIsometricForce0, OptimalFiberLength0,
+                    TendonSlackLength0, PennationAngle0);
+            muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+            muscle->addNewPathPoint("p2", model.updGround(),
+                    SimTK::Vec3(0, 0, 1.07*(OptimalFiberLength0 +
+                                            TendonSlackLength0)));
+            muscle->setUseEquilibriumTable(useTable);
+            model.addForce(muscle);
+            return model;
+        };
+        Model model = createModel(false);
+        Model tableModel = createModel(true);
+        SimTK::State& state = model.initSystem();
+        SimTK::State& tableState = tableModel.initSystem();
+        const auto& muscle = model.getMuscles()[0];
+        const auto& tableMuscle = tableModel.getMuscles()[0];
+        ASSERT(tableMuscle.getUseEquilibriumTable(), __FILE__, __LINE__,
+                "Expected the equilibrium table option to be copied.");
+
+        muscle.setActivation(state, 0.37);
+        tableMuscle.setActivation(tableState, 0.37);
+        auto results = model.equilibrateMusclesWithDiagnostics(state);
+        auto tableResults =
+                tableModel.equilibrateMusclesWithDiagnostics(tableState);
+        ASSERT(results[0].success && tableResults[0].success, __FILE__,
+                __LINE__, "Expected the muscles to equilibrate.");
+        model.realizeVelocity(state);
+        tableModel.realizeVelocity(tableState);
+        ASSERT_EQUAL(muscle.getFiberLength(state),
+                tableMuscle.getFiberLength(tableState),
+                OptimalFiberLength0*1e-6, __FILE__, __LINE__,
+                "The equilibrium table changed the solution.");
+        ASSERT(tableResults[0].iterations <= results[0].iterations, __FILE__,
+                __LINE__, "Expected the equilibrium table to reduce the "
+                "number of iterations.");
+    }
+
+    // Compare the analytic partial derivatives of the fiber dynamics to
+    // finite differences with respect to the activation, the fiber length
+    // and the musculotendon length.
+    {
+        Model model;
+        auto body = new OpenSim::Body("body", 1.0, SimTK::Vec3(0),
+                SimTK::Inertia(1.0));
+        auto slider = new SliderJoint("slider", model.getGround(), *body);
+        model.addBody(body);
+        model.addJoint(slider);
+        auto muscle = new Millard2012EquilibriumMuscle("muscle",
+                MaxIsometricForce0, OptimalFiberLength0, TendonSlackLength0,
+                PennationAngle0);
+        muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("p2", *body, SimTK::Vec3(0));
+        model.addForce(muscle);
+
+        SimTK::State& state = model.initSystem();
+        ASSERT(muscle->hasForceJacobian());
+        const Coordinate& coord = slider->getCoordinate();
+        const double muscleLength = 1.05*(OptimalFiberLength0 +
+                                          TendonSlackLength0);
+        coord.setValue(state, muscleLength);
+        muscle->setActivation(state, 0.6);
+        model.equilibrateMuscles(state);
+        const double activation = muscle->getActivation(state);
+        const double fiberLength = muscle->getFiberLength(state);
+        model.realizeVelocity(state);
+        const auto jac = muscle->calcForceJacobian(state);
+
+        ASSERT_EQUAL(jac.tendonForce[3], muscle->getTendonStiffness(state),
+                1e-6*MaxIsometricForce0, __FILE__, __LINE__,
+                "Partial of tendon force w.r.t. length is incorrect.");
+
+        const auto normFiberLengthDerivative = [&]() {
+            model.realizeVelocity(state);
+            return muscle->getFiberVelocity(state)/OptimalFiberLength0;
+        };
+        const double h = 1e-6;
+        SimTK::Vec4 fd(0);
+        muscle->setActivation(state, activation + h);
+        fd[0] = normFiberLengthDerivative();
+        muscle->setActivation(state, activation - h);
+        fd[0] -= normFiberLengthDerivative();
+        muscle->setActivation(state, activation);
+        muscle->setFiberLength(state, fiberLength + h*OptimalFiberLength0);
+        fd[1] = normFiberLengthDerivative();
+        muscle->setFiberLength(state, fiberLength - h*OptimalFiberLength0);
+        fd[1] -= normFiberLengthDerivative();
+        muscle->setFiberLength(state, fiberLength);
+        coord.setValue(state, muscleLength + h);
+        fd[3] = normFiberLengthDerivative();
+        coord.setValue(state, muscleLength - h);
+        fd[3] -= normFiberLengthDerivative();
+        fd /= 2*h;
+
+        ASSERT_EQUAL(jac.normFiberLengthDerivative, fd,
+                1e-4*fd.norm(), __FILE__, __LINE__,
+                "Partials of the fiber dynamics are incorrect.");
+    }
+
     // Test exception handling when invalid properties are propagated to
     // MuscleFixedWidthPennationModel and MuscleFirstOrderActivationDynamicModel
     // subcomponents.
@@ -341,10 +341,25 @@ void Thelen2003Muscle::computeInitialFiberEquilibrium(SimTK::State& s) const
 
     int maxIter = 20;  //Should this be user settable?
 
+    const double pathLength = getLength(s);
+    const double pathSpeed = getLengtheningSpeed(s);
+
     std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState> result;
 
     try {
-         result = initMuscleState(s, activation, tol, maxIter);
+        // The equilibrium table, if used, tabulates the static normalized
+        // fiber length.
+        const double normFiberLengthGuess = lookUpEquilibriumGuess(
+                activation, pathLength, [&](double a, double lmt) {
+                    auto grid = initMuscleState(a, lmt, 0, tol, maxIter);
+                    return grid.first == StatusFromInitMuscleState::
+                                                 Success_Converged
+                                   ? grid.second["fiber_length"] /
+                                             getOptimalFiberLength()
+                                   : SimTK::NaN;
+                });
+        result = initMuscleState(activation, pathLength, pathSpeed, tol,
+                maxIter, normFiberLengthGuess * getOptimalFiberLength());
     }
     catch (const std::exception& x) {
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, x.what());
@@ -718,15 +733,17 @@ double Thelen2003Muscle::calcActivationRate(const SimTK::State& s) const
 //==============================================================================
 std::pair<Thelen2003Muscle::StatusFromInitMuscleState,
           Thelen2003Muscle::ValuesFromInitMuscleState>
-Thelen2003Muscle::initMuscleState(const SimTK::State& s,
-                                  const double aActivation,
+Thelen2003Muscle::initMuscleState(const double aActivation,
+                                  const double pathLength,
+                                  const double pathLengtheningSpeed,
                                   const double aSolTolerance,
-                                  const int aMaxIterations) const
+                                  const int aMaxIterations,
+                                  double initialFiberLength) const
 {
     // Using short variable names to facilitate writing out long equations
     const double ma = aActivation;
-    const double ml = getLength(s);
-    const double dml= getLengtheningSpeed(s);
+    const double ml = pathLength;
+    const double dml= pathLengtheningSpeed;
 
     //Shorter version of the constants
     const double tsl = getTendonSlackLength();
@@ -860,6 +877,24 @@ Thelen2003Muscle::initMuscleState(const SimTK::State& s,
         fv = calcfvInv(ma, fal, dlceN, aSolTolerance, 100);
     };
 
+    // Warm start: use the provided fiber length instead of the default guess
+    // if its static force error is smaller.
+    if (!SimTK::isNaN(initialFiberLength)) {
+        auto staticForceError = [&](double lceGuess) {
+            lce = lceGuess;
+            positionFunc();
+            multipliersFunc();
+            fv = 1.0;
+            ferrFunc();
+            return abs(ferr);
+        };
+        const double lceDefault = lce;
+        const double lceWarm = max(initialFiberLength, getMinimumFiberLength());
+        const double ferrWarm = staticForceError(lceWarm);
+        const double ferrDefault = staticForceError(lceDefault);
+        lce = (ferrWarm < ferrDefault) ? lceWarm : lceDefault;
+    }
+
     //*******************************
     //Initialize the loop
     int iter = 0;
@@ -316,18 +316,23 @@ private:
     /* Calculate the muscle state such that the fiber and tendon are developing
     the same force.
 
-    @param s the system state
     @param aActivation the initial activation of the muscle
+    @param pathLength the length of the muscle-tendon path
+    @param pathLengtheningSpeed the lengthening speed of the path
     @param aSolTolerance the desired relative tolerance of the equilibrium 
            solution
     @param aMaxIterations the maximum number of Newton steps allowed before we
            give up attempting to initialize the model
+    @param initialFiberLength a guess for the fiber length, used if it is
+           closer to equilibrium than the default guess (ignored if NaN)
     */
     std::pair<StatusFromInitMuscleState, ValuesFromInitMuscleState>
-        initMuscleState(const SimTK::State& s,
-                        const double aActivation,
+        initMuscleState(const double aActivation,
+                        const double pathLength,
+                        const double pathLengtheningSpeed,
                         const double aSolTolerance,
-                        const int aMaxIterations) const;
+                        const int aMaxIterations,
+                        double initialFiberLength = SimTK::NaN) const;
 
     double calcFm(double ma, double fal, double fv, 
                  double fpe, double fiso) const;
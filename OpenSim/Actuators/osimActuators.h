@@ -31,6 +31,7 @@
 #include "PointToPointActuator.h"
 #include "SpringGeneralizedForce.h"
 #include "ClutchedPathSpring.h"
+#include "TaskSpaceController.h"
 
 #include "Schutte1993Muscle_Deprecated.h"
 #include "Delp1990Muscle_Deprecated.h"
@@ -40,6 +41,7 @@
 #include "Millard2012EquilibriumMuscle.h"
 #include "Millard2012AccelerationMuscle.h"
 #include "DeGrooteFregly2016Muscle.h"
+#include "DeGrooteFregly2016MuscleGroup.h"
 
 #include "McKibbenActuator.h"
 
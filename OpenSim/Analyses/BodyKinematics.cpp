@@ -125,6 +125,7 @@ operator=(const BodyKinematics &aBodyKinematics)
     Analysis::operator=(aBodyKinematics);
     _bodies = aBodyKinematics._bodies;
     _expressInLocalFrame = aBodyKinematics._expressInLocalFrame;
+    _recordAccelerations = aBodyKinematics._recordAccelerations;
     return(*this);
 }
 
@@ -144,6 +145,7 @@ setNull()
     _bodies.setSize(1);
     _bodies[0] = "all";
     _recordCenterOfMass = true;
+    _recordAccelerations = true;
 
     // OTHER VARIABLES
 
@@ -257,6 +259,11 @@ allocateStorage()
     _pStore = new Storage(1000,"Positions");
     _pStore->setDescription(getDescription());
     _pStore->setColumnLabels(getColumnLabels());
+
+    _storageList.setSize(0);
+    _storageList.append(_aStore);
+    _storageList.append(_vStore);
+    _storageList.append(_pStore);
 }
 
 
@@ -308,12 +315,34 @@ updateBodiesToRecord()
         _bodyIndices.append(index);
     }
     _kin.setSize(6*_bodyIndices.getSize()+(_recordCenterOfMass?3:0));
+    updateSnapshotStations();
 
     if(_kin.getSize()==0) {
         log_warn("BodyKinematics analysis has no bodies to record kinematics "
                  "for");
     }
 }
+//_____________________________________________________________________________
+/**
+ * Add the centers of mass of the recorded bodies (and of all bodies, if the
+ * whole-body center of mass is recorded) to the kinematics snapshot.
+ */
+void BodyKinematics::
+updateSnapshotStations()
+{
+    _snapshot.clear();
+    if(!_model) return;
+    const BodySet& bs = _model->getBodySet();
+    for(int i=0; i<_bodyIndices.getSize(); i++) {
+        const Body& body = bs.get(_bodyIndices[i]);
+        _snapshot.addStation(body, body.get_mass_center());
+    }
+    if(_recordCenterOfMass) {
+        for(int i=0; i<bs.getSize(); i++) {
+            _snapshot.addStation(bs.get(i), bs.get(i).get_mass_center());
+        }
+    }
+}
 
 
 
@@ -438,150 +467,120 @@ int BodyKinematics::
 record(const SimTK::State& s)
 {
 
-    // Realize to Acceleration first since we'll ask for Accelerations 
-    _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
+    // Realize to Acceleration first if we'll ask for Accelerations
+    _model->getMultibodySystem().realize(s, getRequiredStage());
+
+    // Compute the kinematics of all the centers of mass in one pass.
+    if(_snapshot.getNumStations() != _bodyIndices.getSize() +
+            (_recordCenterOfMass ? _model->getBodySet().getSize() : 0)) {
+        updateSnapshotStations();
+    }
+    _snapshot.update(s);
+    const SimTK::Array_<SimTK::Rotation>& R_GB =
+            _snapshot.getRotationsInGround();
+    const SimTK::Vector_<SimTK::Vec3>& p_G = _snapshot.getLocationsInGround();
+    const SimTK::Vector_<SimTK::SpatialVec>& V_G =
+            _snapshot.getVelocitiesInGround();
+    const SimTK::Vector_<SimTK::SpatialVec>& A_G =
+            _snapshot.getAccelerationsInGround();
+
     // VARIABLES
     SimTK::Vec3 vec,angVec;
-    double Mass = 0.0;
+    const BodySet& bs = _model->getBodySet();
+    const int nb = _bodyIndices.getSize();
+    const int I = 6*nb;
 
-    // GROUND BODY
-    const Ground &ground = _model->getGround();
+    // WHOLE BODY MASS (the whole-body center of mass stations follow the
+    // stations of the recorded bodies in the snapshot)
+    double Mass = 0.0;
+    if(_recordCenterOfMass) {
+        for(int i=0;i<bs.getSize();i++) Mass += bs.get(i).get_mass();
+    }
 
     // POSITION
-    BodySet& bs = _model->updBodySet();
-
-    for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
+    for(int i=0;i<nb;i++) {
         // GET POSITIONS AND EULER ANGLES
-        vec = body.findStationLocationInGround(s, com);
-        angVec = body.getTransformInGround(s).R().convertRotationToBodyFixedXYZ();
+        vec = p_G[i];
+        angVec = R_GB[i].convertRotationToBodyFixedXYZ();
 
         // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
+        if(getInDegrees()) angVec *= SimTK_RADIAN_TO_DEGREE;
 
         // FILL KINEMATICS ARRAY
-        int I=6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
+        memcpy(&_kin[6*i],&vec[0],3*sizeof(double));
+        memcpy(&_kin[6*i+3],&angVec[0],3*sizeof(double));
     }
 
     if(_recordCenterOfMass) {
-        double rP[3] = { 0.0, 0.0, 0.0 };
+        SimTK::Vec3 rP(0);
         for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationLocationInGround(s, com);
-            // ADD TO WHOLE BODY MASS
-            Mass += body.get_mass();
-            rP[0] += body.get_mass() * vec[0];
-            rP[1] += body.get_mass() * vec[1];
-            rP[2] += body.get_mass() * vec[2];
+            rP += bs.get(i).get_mass() * p_G[nb+i];
         }
-
         //COMPUTE COM OF WHOLE BODY AND ADD TO ARRAY
-        rP[0] /= Mass;
-        rP[1] /= Mass;
-        rP[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rP,3*sizeof(double));
+        rP /= Mass;
+        memcpy(&_kin[I],&rP[0],3*sizeof(double));
     }
     
     _pStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
     // VELOCITY
-    for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
+    for(int i=0;i<nb;i++) {
         // GET VELOCITIES AND ANGULAR VELOCITIES
-        vec = body.findStationVelocityInGround(s, com);
-        angVec = body.getVelocityInGround(s)[0];
+        vec = V_G[i][1];
+        angVec = V_G[i][0];
         if (_expressInLocalFrame) {
-            vec = ground.expressVectorInAnotherFrame(s, vec, body);
-            angVec = ground.expressVectorInAnotherFrame(s, angVec, body);
+            vec = ~R_GB[i] * vec;
+            angVec = ~R_GB[i] * angVec;
         }
 
         // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
+        if(getInDegrees()) angVec *= SimTK_RADIAN_TO_DEGREE;
 
         // FILL KINEMATICS ARRAY
-        int I = 6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
+        memcpy(&_kin[6*i],&vec[0],3*sizeof(double));
+        memcpy(&_kin[6*i+3],&angVec[0],3*sizeof(double));
     }
 
     if(_recordCenterOfMass) {
-        double rV[3] = { 0.0, 0.0, 0.0 };
+        SimTK::Vec3 rV(0);
         for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationVelocityInGround(s, com);
-            rV[0] += body.get_mass() * vec[0];
-            rV[1] += body.get_mass() * vec[1];
-            rV[2] += body.get_mass() * vec[2];
+            rV += bs.get(i).get_mass() * V_G[nb+i][1];
         }
-
         //COMPUTE VELOCITY OF COM OF WHOLE BODY AND ADD TO ARRAY
-        rV[0] /= Mass;
-        rV[1] /= Mass;
-        rV[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rV,3*sizeof(double));
+        rV /= Mass;
+        memcpy(&_kin[I],&rV[0],3*sizeof(double));
     }
 
     _vStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
 
-    // ACCELERATIONS
-    for(int i=0;i<_bodyIndices.getSize();i++) {
-        Body& body = bs.get(_bodyIndices[i]);
-        const SimTK::Vec3& com = body.get_mass_center();
+    if(!_recordAccelerations) return(0);
 
+    // ACCELERATIONS
+    for(int i=0;i<nb;i++) {
         // GET ACCELERATIONS AND ANGULAR ACCELERATIONS
-        vec = body.findStationAccelerationInGround(s, com);
-        angVec = body.getAccelerationInGround(s)[0];
+        vec = A_G[i][1];
+        angVec = A_G[i][0];
         if(_expressInLocalFrame) {
-            vec = ground.expressVectorInAnotherFrame(s, vec, body);
-            angVec = ground.expressVectorInAnotherFrame(s, angVec, body);
+            vec = ~R_GB[i] * vec;
+            angVec = ~R_GB[i] * angVec;
         }
 
         // CONVERT TO DEGREES?
-        if(getInDegrees()) {
-            angVec[0] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[1] *= SimTK_RADIAN_TO_DEGREE;
-            angVec[2] *= SimTK_RADIAN_TO_DEGREE;
-        }           
+        if(getInDegrees()) angVec *= SimTK_RADIAN_TO_DEGREE;
 
         // FILL KINEMATICS ARRAY
-        int I = 6*i;
-        memcpy(&_kin[I],&vec[0],3*sizeof(double));
-        memcpy(&_kin[I+3],&angVec[0],3*sizeof(double));
+        memcpy(&_kin[6*i],&vec[0],3*sizeof(double));
+        memcpy(&_kin[6*i+3],&angVec[0],3*sizeof(double));
     }
 
     if(_recordCenterOfMass) {
-        double rA[3] = { 0.0, 0.0, 0.0 };
+        SimTK::Vec3 rA(0);
         for(int i=0;i<bs.getSize();i++) {
-            Body& body = bs.get(i);
-            const SimTK::Vec3& com = body.get_mass_center();
-            vec = body.findStationAccelerationInGround(s, com);
-            rA[0] += body.get_mass() * vec[0];
-            rA[1] += body.get_mass() * vec[1];
-            rA[2] += body.get_mass() * vec[2];
+            rA += bs.get(i).get_mass() * A_G[nb+i][1];
         }
-
         //COMPUTE ACCELERATION OF COM OF WHOLE BODY AND ADD TO ARRAY
-        rA[0] /= Mass;
-        rA[1] /= Mass;
-        rA[2] /= Mass;
-        int I = 6*_bodyIndices.getSize();
-        memcpy(&_kin[I],rA,3*sizeof(double));
+        rA /= Mass;
+        memcpy(&_kin[I],&rA[0],3*sizeof(double));
     }
 
     _aStore->append(s.getTime(),_kin.getSize(),&_kin[0]);
@@ -609,6 +608,9 @@ begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    // The system may have been re-created since the stations were resolved.
+    updateSnapshotStations();
+
     // RESET STORAGE
     _pStore->reset(s.getTime());
     _vStore->reset(s.getTime());
@@ -702,7 +704,10 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
     else suffix = "_global";
 
     // ACCELERATIONS
-    Storage::printResult(_aStore,aBaseName+"_"+getName()+"_acc"+suffix,aDir,aDT,aExtension);
+    if(_recordAccelerations) {
+        Storage::printResult(_aStore,aBaseName+"_"+getName()+"_acc"+suffix,
+                aDir,aDT,aExtension);
+    }
 
     // VELOCITIES
     Storage::printResult(_vStore,aBaseName+"_"+getName()+"_vel"+suffix,aDir,aDT,aExtension);
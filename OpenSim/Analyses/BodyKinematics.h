@@ -28,6 +28,7 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
+#include <OpenSim/Simulation/KinematicsSnapshot.h>
 #include <OpenSim/Common/PropertyStrArray.h>
 #include "osimAnalysesDLL.h"
 
@@ -65,7 +66,13 @@ protected:
 
     Array<int> _bodyIndices;
     bool _recordCenterOfMass;
+    /** Flag indicating whether accelerations are recorded; if not, states
+    need only be realized to Stage::Velocity. */
+    bool _recordAccelerations;
     Array<double> _kin;
+    /** Centers of mass of the recorded bodies, followed by those of all
+    bodies if the whole-body center of mass is recorded. */
+    KinematicsSnapshot _snapshot;
 
     Storage *_pStore;
     Storage *_vStore;
@@ -95,6 +102,7 @@ private:
     void allocateStorage();
     void deleteStorage();
     void updateBodiesToRecord();
+    void updateSnapshotStations();
 
 public:
     //--------------------------------------------------------------------------
@@ -107,6 +115,8 @@ public:
     Storage* getPositionStorage();
     void setExpressResultsInLocalFrame(bool aTrueFalse);
     bool getExpressResultsInLocalFrame();
+    void setRecordAccelerations(bool aRecordAccelerations) { _recordAccelerations = aRecordAccelerations; }
+    bool getRecordAccelerations() const { return _recordAccelerations; }
 
     void setRecordCenterOfMass(bool aTrueFalse) {_recordCenterOfMass = aTrueFalse;}
     void setBodiesToRecord(Array<std::string> &listOfBodies) {_bodies = listOfBodies;}
@@ -122,6 +132,10 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    SimTK::Stage getRequiredStage() const override {
+        return _recordAccelerations ? SimTK::Stage::Acceleration
+                                    : SimTK::Stage::Velocity;
+    }
 protected:
     virtual int
         record(const SimTK::State& s );
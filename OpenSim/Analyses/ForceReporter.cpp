@@ -27,6 +27,7 @@
 //=============================================================================
 #include "ForceReporter.h"
 #include <OpenSim/Simulation/Model/Model.h>
+#include <algorithm>
 
 using namespace OpenSim;
 using namespace std;
@@ -150,6 +151,7 @@ void ForceReporter::setModel(Model& aModel)
 {
     // BASE CLASS
     Analysis::setModel(aModel);
+    _recordRow.clear();
 }
 
 //_____________________________________________________________________________
@@ -230,6 +232,26 @@ void ForceReporter::constructColumnLabels(const SimTK::State& s)
         }
         _forceStore.setColumnLabels(columnLabels);
     }
+    allocateRecordRow();
+}
+//_____________________________________________________________________________
+/**
+ * Size the buffer for a row of the force storage so that it can hold the
+ * record values of every force and constraint.
+ */
+void ForceReporter::allocateRecordRow()
+{
+    int size = 0;
+    if (_model) {
+        for (const auto& force : _model->getComponentList<Force>())
+            size += force.getRecordLabels().getSize();
+        if (_includeConstraintForces) {
+            for (const auto& c : _model->getComponentList<Constraint>())
+                size += c.getRecordLabels().getSize();
+        }
+    }
+    // Keep the buffer non-empty so that it is not resized on every record.
+    _recordRow.assign(std::max(size, 1), SimTK::NaN);
 }
 
 
@@ -259,7 +281,11 @@ int ForceReporter::record(const SimTK::State& s)
     // MAKE SURE ALL ForceReporter QUANTITIES ARE VALID
     _model->getMultibodySystem().realize(s, SimTK::Stage::Dynamics );
 
-    StateVector nextRow(s.getTime());
+    // The values are written into a preallocated row, so recording does not
+    // allocate an Array for each force.
+    if(_recordRow.empty()) allocateRecordRow();
+    double* values = _recordRow.data();
+    int n = 0;
 
     // Model Forces
     auto forces = _model->getComponentList<Force>();
@@ -268,8 +294,7 @@ int ForceReporter::record(const SimTK::State& s)
         // If body force we need to record six values for torque+force
         // If muscle we record one scalar
         if(!force.appliesForce(s)) continue;
-        Array<double> values = force.getRecordValues(s);
-        nextRow.getData().append(values);
+        n += force.writeRecordValues(s, values + n);
     }
 
     if(_includeConstraintForces){
@@ -278,11 +303,10 @@ int ForceReporter::record(const SimTK::State& s)
         for (auto& constraint : constraints) {
             if (!constraint.isEnforced(s))
                 continue;
-            Array<double> values = constraint.getRecordValues(s);
-            nextRow.getData().append(values);
+            n += constraint.writeRecordValues(s, values + n);
         }
     }
-    _forceStore.append(nextRow);
+    _forceStore.append(s.getTime(), n, values);
 
     return(0);
 }
@@ -28,6 +28,7 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
+#include <vector>
 #include "osimAnalysesDLL.h"
 
 #ifdef SWIG
@@ -64,6 +65,10 @@ protected:
     /** Force storage. */
     Storage _forceStore;
 
+    /** Buffer for a row of the force storage, with room for the values of
+    all forces and constraints (whether or not they are applied). */
+    std::vector<double> _recordRow;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -81,6 +86,7 @@ private:
     void allocateStorage();
     void deleteStorage();
     void tidyForceNames();
+    void allocateRecordRow();
 
 public:
     //--------------------------------------------------------------------------
@@ -118,6 +124,9 @@ public:
     int begin(const SimTK::State& s ) override;
     int step(const SimTK::State& s, int setNumber ) override;
     int end(const SimTK::State& s ) override;
+    SimTK::Stage getRequiredStage() const override {
+        return SimTK::Stage::Dynamics;
+    }
 
 protected:
     virtual int
@@ -68,7 +68,8 @@ InducedAccelerations::InducedAccelerations(Model *aModel) :
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _reuseFactorization(_reuseFactorizationProp.getValueBool())
 {
     // make sure members point to NULL if not valid. 
     setNull();
@@ -96,7 +97,8 @@ InducedAccelerations::InducedAccelerations(const std::string &aFileName):
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _reuseFactorization(_reuseFactorizationProp.getValueBool())
 {
     setNull();
 
@@ -120,7 +122,8 @@ InducedAccelerations::InducedAccelerations(const InducedAccelerations &aInducedA
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _reuseFactorization(_reuseFactorizationProp.getValueBool())
 {
     setNull();
     // COPY TYPE AND NAME
@@ -152,6 +155,7 @@ operator=(const InducedAccelerations &aInducedAccelerations)
     _forceThreshold = aInducedAccelerations._forceThreshold;
     _computePotentialsOnly = aInducedAccelerations._computePotentialsOnly;
     _reportConstraintReactions = aInducedAccelerations._reportConstraintReactions;
+    _reuseFactorization = aInducedAccelerations._reuseFactorization;
     _includeCOM = aInducedAccelerations._includeCOM;
     return(*this);
 }
@@ -171,6 +175,7 @@ void InducedAccelerations::setNull()
     _bodyNames[0] = CENTER_OF_MASS_NAME;
     _computePotentialsOnly = false;
     _reportConstraintReactions = false;
+    _reuseFactorization = false;
     // Analysis does not own contents of these sets
     _coordSet.setMemoryOwner(false);
     _bodySet.setMemoryOwner(false);
@@ -213,6 +218,12 @@ void InducedAccelerations::setupProperties()
     _reportConstraintReactionsProp.setName("report_constraint_reactions");
     _reportConstraintReactionsProp.setComment("Report individual contributions to constraint reactions in addition to accelerations.");
     _propertySet.append(&_reportConstraintReactionsProp);
+
+    _reuseFactorizationProp.setName("reuse_factorization");
+    _reuseFactorizationProp.setComment("Factorize the constrained equations of motion once per time frame and "
+        "back-solve them for each contributor instead of realizing the system accelerations for every contributor. "
+        "Ignored when report_constraint_reactions is true.");
+    _propertySet.append(&_reuseFactorizationProp);
 }
 
 //=============================================================================
@@ -484,6 +495,35 @@ void InducedAccelerations::setModel(Model &aModel)
 //=============================================================================
 // ANALYSIS
 //=============================================================================
+// Acceleration in ground of a station fixed on a body, given the spatial
+// acceleration of the body; the state must be realized to Velocity.
+static SimTK::Vec3 calcStationAccelerationFromBodyAcceleration(
+        const SimTK::State& s, const SimTK::MobilizedBody& mobod,
+        const SimTK::SpatialVec& A_GB, const SimTK::Vec3& station_B)
+{
+    const SimTK::Vec3 r_G = mobod.getBodyRotation(s)*station_B;
+    const SimTK::Vec3& w_GB = mobod.getBodyAngularVelocity(s);
+    return A_GB[1] + A_GB[0] % r_G + w_GB % (w_GB % r_G);
+}
+
+// Acceleration in ground of the system center of mass, given the spatial
+// accelerations of all bodies.
+static SimTK::Vec3 calcMassCenterAccelerationFromBodyAccelerations(
+        const SimTK::State& s, const SimTK::SimbodyMatterSubsystem& matter,
+        const SimTK::Vector_<SimTK::SpatialVec>& A_GB)
+{
+    double mass = 0;
+    SimTK::Vec3 acc(0);
+    for(SimTK::MobilizedBodyIndex mbx(1); mbx < matter.getNumBodies(); ++mbx){
+        const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        const SimTK::MassProperties& massProps = mobod.getBodyMassProperties(s);
+        acc += massProps.getMass()*calcStationAccelerationFromBodyAcceleration(
+            s, mobod, A_GB[mbx], massProps.getMassCenter());
+        mass += massProps.getMass();
+    }
+    return acc/mass;
+}
+
 //_____________________________________________________________________________
 /**
  * Compute and record the results.
@@ -539,6 +579,15 @@ int InducedAccelerations::record(const SimTK::State& s)
     //Use same conditions on constraints
     s_analysis.setTime(aT);
 
+    // The factorization cannot distinguish the reactions of individual
+    // constraints, so report them by realizing each contributor.
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    const bool reuseFactorization =
+        _reuseFactorization && !_reportConstraintReactions;
+    _factorization.clear();
+    SimTK::Vector udot;
+    SimTK::Vector_<SimTK::SpatialVec> A_GB;
+
     // Cycle through the force contributors to the system acceleration
     for(int c=0; c< _contributors.getSize(); c++){          
         //cout << "Solving for contributor: " << _contributors[c] << endl;
@@ -696,9 +745,24 @@ int InducedAccelerations::record(const SimTK::State& s)
         // cout << "Constraint 0 is of "<< _constraintSet[0].getConcreteClassName() << " and should be " << constraintOn[0] << " and is actually " <<  (_constraintSet[0].isDisabled(s_analysis) ? "off" : "on") << endl;
         // cout << "Constraint 1 is of "<< _constraintSet[1].getConcreteClassName() << " and should be " << constraintOn[1] << " and is actually " <<  (_constraintSet[1].isDisabled(s_analysis) ? "off" : "on") << endl;
 
-        // After setting the state of the model and applying forces
-        // Compute the derivative of the multibody system (speeds and accelerations)
-        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+        if(reuseFactorization){
+            // Only the applied forces differ between contributors, so
+            // back-solve the equations of motion factorized for this frame.
+            const SimTK::MultibodySystem& system = _model->getMultibodySystem();
+            system.realize(s_analysis, SimTK::Stage::Dynamics);
+            if(!_factorization.isFactorizedAt(s_analysis))
+                _factorization.factorize(matter, s_analysis);
+            _factorization.solve(matter, s_analysis,
+                system.getMobilityForces(s_analysis, SimTK::Stage::Dynamics),
+                system.getRigidBodyForces(s_analysis, SimTK::Stage::Dynamics),
+                udot);
+            matter.calcBodyAccelerationFromUDot(s_analysis, udot, A_GB);
+        }
+        else{
+            // After setting the state of the model and applying forces
+            // Compute the derivative of the multibody system (speeds and accelerations)
+            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+        }
 
         // Sanity check that constraints hasn't totally changed the configuration of the model
         // double error = (Q-s_analysis.getQ()).norm();
@@ -718,7 +782,16 @@ int InducedAccelerations::record(const SimTK::State& s)
 
         // Get Accelerations for kinematics of bodies
         for(int i=0;i<_coordSet.getSize();i++) {
-            double acc = _coordSet.get(i).getAccelerationValue(s_analysis);
+            const Coordinate& coord = _coordSet.get(i);
+            double acc = 0;
+            if(reuseFactorization){
+                const SimTK::MobilizedBody& mobod =
+                    matter.getMobilizedBody(coord.getBodyIndex());
+                acc = udot[mobod.getFirstUIndex(s_analysis)
+                           + coord.getMobilizerQIndex()];
+            }
+            else
+                acc = coord.getAccelerationValue(s_analysis);
 
             if(getInDegrees()) 
                 acc *= SimTK_RADIAN_TO_DEGREE;  
@@ -734,8 +807,17 @@ int InducedAccelerations::record(const SimTK::State& s)
             const SimTK::Vec3& com = body.get_mass_center();
             
             // Get the body acceleration
-            vec = body.findStationAccelerationInGround(s_analysis, com);
-            angVec = body.getAccelerationInGround(s_analysis)[0];
+            if(reuseFactorization){
+                const SimTK::MobilizedBody& mobod = body.getMobilizedBody();
+                const SimTK::SpatialVec& A = A_GB[mobod.getMobilizedBodyIndex()];
+                vec = calcStationAccelerationFromBodyAcceleration(
+                    s_analysis, mobod, A, com);
+                angVec = A[0];
+            }
+            else{
+                vec = body.findStationAccelerationInGround(s_analysis, com);
+                angVec = body.getAccelerationInGround(s_analysis)[0];
+            }
 
             // CONVERT TO DEGREES?
             if(getInDegrees()) 
@@ -749,7 +831,11 @@ int InducedAccelerations::record(const SimTK::State& s)
         // Get Accelerations for kinematics of COM
         if(_includeCOM){
             // Get the body acceleration in ground
-            vec = _model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
+            if(reuseFactorization)
+                vec = calcMassCenterAccelerationFromBodyAccelerations(
+                    s_analysis, matter, A_GB);
+            else
+                vec = _model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
 
             // FILL KINEMATICS ARRAY
             _comIndAccs.append(3, &vec[0]);
@@ -32,6 +32,7 @@
 #include <OpenSim/Simulation/Model/Analysis.h>
 // Header to define analysis (DLL) interface
 #include "osimAnalysesDLL.h"
+#include "InducedAccelerationsSolver.h"
 
 namespace OpenSim { 
 
@@ -102,6 +103,13 @@ protected:
     PropertyBool _reportConstraintReactionsProp;
     bool &_reportConstraintReactions;
 
+    /** Flag to factorize the constrained equations of motion once per time
+        frame and back-solve them for the accelerations induced by each
+        contributor, rather than realizing the full system accelerations for
+        every contributor. Ignored when reporting constraint reactions. */
+    PropertyBool _reuseFactorizationProp;
+    bool &_reuseFactorization;
+
     /** Storages for recording induced accelerations for specified coordinates and/or bodies. */
     Array<Storage *> _storeInducedAccelerations;
     Storage* _storeConstraintReactions;
@@ -123,6 +131,9 @@ protected:
     // Hold the actual model gravity since we will be changing it back and forth from 0
     SimTK::Vec3 _gravity;
 
+    // Factorization of the equations of motion at the frame being recorded
+    InducedAccelerationsFactorization _factorization;
+
 
 //=============================================================================
 // METHODS
@@ -186,6 +197,13 @@ public:
     //-------------------------------------------------------------------------
     void setModel(Model &aModel) override;
 
+    /** Factorize the constrained equations of motion once per time frame
+        and reuse the factorization for all contributors (default: false).
+        The results are the same up to round-off; constraint reactions are
+        always computed by realizing the system for each contributor. */
+    void setReuseFactorization(bool reuse) { _reuseFactorization = reuse; }
+    bool getReuseFactorization() const { return _reuseFactorization; }
+
     //-------------------------------------------------------------------------
     // INTEGRATION
     //-------------------------------------------------------------------------
@@ -36,6 +36,72 @@ using namespace std;
 //=============================================================================
 #define CENTER_OF_MASS_NAME string("center_of_mass")
 
+//=============================================================================
+// FACTORIZATION
+//=============================================================================
+void InducedAccelerationsFactorization::factorize(
+        const SimTK::SimbodyMatterSubsystem& matter, const SimTK::State& s)
+{
+    _time = s.getTime();
+    _q = s.getQ();
+    _numMultipliers = s.getNMultipliers();
+    if(_numMultipliers > 0){
+        SimTK::Matrix W;
+        matter.calcProjectedMInv(s, W);
+        _projectedMInv.factor(W);
+    }
+    _isFactorized = true;
+}
+
+bool InducedAccelerationsFactorization::isFactorizedAt(
+        const SimTK::State& s) const
+{
+    if(!_isFactorized || s.getTime() != _time ||
+            s.getNMultipliers() != _numMultipliers ||
+            s.getNQ() != _q.size())
+        return false;
+    for(int i=0; i<_q.size(); ++i){
+        if(s.getQ()[i] != _q[i]) return false;
+    }
+    return true;
+}
+
+void InducedAccelerationsFactorization::solve(
+        const SimTK::SimbodyMatterSubsystem& matter, const SimTK::State& s,
+        const SimTK::Vector& appliedMobilityForces,
+        const SimTK::Vector_<SimTK::SpatialVec>& appliedBodyForces,
+        SimTK::Vector& udot, SimTK::Vector* multipliers) const
+{
+    OPENSIM_THROW_IF(!isFactorizedAt(s), Exception,
+        "InducedAccelerationsFactorization: the state does not match the "
+        "factorized configuration (time = {}).", s.getTime());
+
+    // residual = c(q,u) - f, so the unconstrained accelerations are
+    // udot = [M]^-1*(f - c).
+    SimTK::Vector residual;
+    matter.calcResidualForceIgnoringConstraints(s, appliedMobilityForces,
+        appliedBodyForces, SimTK::Vector(s.getNU(), 0.0), residual);
+    matter.multiplyByMInv(s, -residual, udot);
+
+    if(_numMultipliers == 0){
+        if(multipliers) multipliers->resize(0);
+        return;
+    }
+
+    // Remove the constraint acceleration error, aerr = [C]*udot + bias, with
+    // the multipliers that solve W*lambda = aerr.
+    SimTK::Vector bias, aerr, lambda, constraintForces, deltaUDot;
+    matter.calcBiasForAccelerationConstraints(s, bias);
+    matter.multiplyByG(s, udot, aerr);
+    aerr += bias;
+    _projectedMInv.solve(aerr, lambda);
+    matter.multiplyByGTranspose(s, lambda, constraintForces);
+    matter.multiplyByMInv(s, constraintForces, deltaUDot);
+    udot -= deltaUDot;
+
+    if(multipliers) *multipliers = lambda;
+}
+
 //=============================================================================
 // CONSTRUCTOR
 //=============================================================================
@@ -59,7 +125,32 @@ const SimTK::Vector& InducedAccelerationsSolver::solve(const SimTK::State& s,
         SimTK::Vector_<SimTK::SpatialVec>* constraintReactions)
 {
     SimTK::State& s_solver = _modelCopy.updWorkingState();
-    return s_solver.getUDot();
+    const SimTK::SimbodyMatterSubsystem& matter =
+        _modelCopy.getMatterSubsystem();
+
+    // Keep the constraints enforced by the last solve for a named force.
+    s_solver.setTime(s.getTime());
+    s_solver.updQ() = s.getQ();
+    s_solver.updU() = s.getU();
+    _modelCopy.getMultibodySystem().realize(s_solver, SimTK::Stage::Velocity);
+
+    if(!_factorization.isFactorizedAt(s_solver))
+        _factorization.factorize(matter, s_solver);
+
+    SimTK::Vector multipliers;
+    _factorization.solve(matter, s_solver, appliedMobilityForces,
+        appliedBodyForces, _inducedUDot,
+        constraintReactions ? &multipliers : nullptr);
+
+    if(constraintReactions){
+        // The reactions are the forces applied to the model by the
+        // constraints, which oppose ~C*lambda.
+        SimTK::Vector mobilityReactions;
+        matter.calcConstraintForcesFromMultipliers(s_solver, -multipliers,
+            *constraintReactions, mobilityReactions);
+    }
+
+    return _inducedUDot;
 }
 
 /* Solve for the induced accelerations (udot_f) for a Force in the model 
@@ -83,6 +174,8 @@ const SimTK::Vector& InducedAccelerationsSolver::solve(const SimTK::State& s,
     // Check the external forces and determine if contact constraints should be applied at this time
     // and turn constraint on if it should be.
     Array<bool> constraintOn = applyContactConstraintAccordingToExternalForces(s_solver);
+    // The enforced constraints may have changed
+    _factorization.clear();
 
     // Hang on to a state that has the right flags for contact constraints turned on/off
     _modelCopy.setPropertiesFromState(s_solver);
@@ -29,6 +29,11 @@
 #include <OpenSim/Simulation/Solver.h>
 // Header to define analysis (DLL) interface
 #include "osimAnalysesDLL.h"
+#include <simmath/LinearAlgebra.h>
+
+namespace SimTK {
+class SimbodyMatterSubsystem;
+}
 
 namespace OpenSim { 
 
@@ -36,6 +41,63 @@ class Model;
 class Constraint;
 class Force;
 
+//=============================================================================
+//=============================================================================
+/**
+ A factorization of the constrained equations of motion (Eqn. 2 of
+ InducedAccelerationsSolver) at a single configuration of the model:
+
+  [M]*udot + [~C]*lambda = f - c(q,u)
+  [C]*udot = b(t,q,u)
+
+ Since [M] and [C] depend only on time and the generalized coordinates, the
+ factorization of the projected inverse mass matrix W = [C]*[M]^-1*[~C] can be
+ computed once per frame and reused to
+ back-solve for the induced accelerations of any number of applied forces,
+ rather than realizing the full system dynamics for each force contributor.
+ The velocity-dependent terms c and b are evaluated from the state that is
+ passed to solve(), so contributors with zero speeds and contributors with the
+ actual speeds can share one factorization.
+
+ The enforced constraints and the coordinates of the state passed to solve()
+ must be the same as those of the state that was factorized.
+ */
+class OSIMANALYSES_API InducedAccelerationsFactorization
+{
+public:
+    /** Factorize the constrained equations of motion at the configuration of
+        the given state, which must be realized to at least Stage::Velocity.*/
+    void factorize(const SimTK::SimbodyMatterSubsystem& matter,
+                   const SimTK::State& state);
+
+    /** Whether factorize() has been called for the time, generalized
+        coordinates and number of enforced constraint equations of the given
+        state. */
+    bool isFactorizedAt(const SimTK::State& state) const;
+
+    /** Discard the factorization (e.g., after changing which constraints are
+        enforced). */
+    void clear() { _isFactorized = false; }
+
+    /** Solve for the generalized accelerations (udot) resulting from the
+        supplied applied forces and the velocity-dependent terms of the state,
+        which must be realized to at least Stage::Velocity. The Lagrange
+        multipliers are returned in `multipliers` if it is not null. */
+    void solve(const SimTK::SimbodyMatterSubsystem& matter,
+               const SimTK::State& state,
+               const SimTK::Vector& appliedMobilityForces,
+               const SimTK::Vector_<SimTK::SpatialVec>& appliedBodyForces,
+               SimTK::Vector& udot,
+               SimTK::Vector* multipliers = nullptr) const;
+
+private:
+    bool _isFactorized = false;
+    double _time = SimTK::NaN;
+    int _numMultipliers = 0;
+    SimTK::Vector _q;
+    SimTK::FactorQTZ _projectedMInv;
+};
+
 //=============================================================================
 //=============================================================================
 /**
@@ -125,6 +187,17 @@ public:
     /** Solve for the induced (generalized) accelerations (udot) resulting 
         from the supplied force. An supplied force is expressed as any 
         combination of mobility (generalized) forces and/or body forces.
+        Velocity-dependent (Coriolis and gyroscopic) terms are included
+        according to the speeds of the state, so pass a state with zero
+        speeds to obtain the contribution of the supplied force alone.
+
+        The constrained equations of motion are factorized once for the time
+        and generalized coordinates of the state (with the constraints
+        enforced by the most recent solve() for a named force) and reused
+        by subsequent calls at the same configuration, so the contributions
+        of many forces can be evaluated at the cost of one factorization.
+        The solver state is not realized to Stage::Acceleration, so the
+        convenience access methods below do not apply to this result.
         
         @param[in]  state                   current State of the model
         @param[in]  appliedMobilityForces   Vector of applied mobility forces
@@ -194,6 +267,9 @@ private:
     Set<Constraint> _replacementConstraints; 
     Model _modelCopy;
 
+    InducedAccelerationsFactorization _factorization;
+    SimTK::Vector _inducedUDot;
+
 //=============================================================================
 }; // END of class InducedAccelerationsSolver
 }; //namespace
@@ -169,6 +169,7 @@ setNull()
 
     _storeActuation = NULL;
 
+    _storageList.append(&_storeReactionLoads);
 }
 //_____________________________________________________________________________
 /**
@@ -578,6 +579,9 @@ record(const SimTK::State& s)
 
     _model->realizeAcceleration(s_analysis);
 
+    // Compute the reactions of all joints in a single sweep of the tree
+    _model->calcMobilizerReactionForces(s_analysis, _mobilizerReactions);
+
     /* retrieved desired joint reactions, convert to desired bodies, and convert
     *  to desired reference frames*/
     int numOutputJoints = _reactionList.getSize();
@@ -591,7 +595,8 @@ record(const SimTK::State& s)
         
         // check if the load requested is on the parent or child
         if(!currentKey.isAppliedOnChild){
-            jointReaction = joint.calcReactionOnParentExpressedInGround(s_analysis);
+            jointReaction = joint.calcReactionOnParentExpressedInGround(
+                    s_analysis, _mobilizerReactions);
 
             // find the point of application in immediate parent frame, then
             // transform to the base frame of the parent (expressedInBody)
@@ -600,7 +605,8 @@ record(const SimTK::State& s)
                 ground.findStationLocationInAnotherFrame(s_analysis, parentLocationInGlobal, expressedInBody);
         }
         else{
-            jointReaction = joint.calcReactionOnChildExpressedInGround(s_analysis);
+            jointReaction = joint.calcReactionOnChildExpressedInGround(
+                    s_analysis, _mobilizerReactions);
 
             // find the point of application in immediate child frame, then
             // transform to the base frame of the child (expressedInBody)
@@ -131,6 +131,10 @@ protected:
     *   joints specified in _jointNames*/
     Array<double> _Loads;
 
+    /** Internal work buffer for holding the reactions of all mobilizers,
+    *   computed in one pass for each recorded state*/
+    SimTK::Vector_<SimTK::SpatialVec> _mobilizerReactions;
+
     /** Internal work array for holding the JointReactionKeys to identify the 
     *   desired joints, onBody, and inFrame to be output*/
     Array<JointReactionKey> _reactionList;
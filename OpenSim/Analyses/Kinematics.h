@@ -106,6 +106,10 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    SimTK::Stage getRequiredStage() const override {
+        return _recordAccelerations ? SimTK::Stage::Acceleration
+                                    : SimTK::Stage::Velocity;
+    }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -505,24 +505,35 @@ int MuscleAnalysis::record(const SimTK::State& s)
     // LOOP THROUGH MUSCLES
     int nm = _muscleArray.getSize();
 
-    double nan = SimTK::NaN;
-    // Angles and lengths
-    Array<double> penang(nan,nm);
-    Array<double> len(nan,nm), tlen(nan,nm);
-    Array<double> fiblen(nan,nm), normfiblen(nan,nm);
-
-    // Muscle velocity information
-    Array<double> fibVel(nan,nm), normFibVel(nan,nm);
-    Array<double> penAngVel(nan,nm);
-
-    // Muscle component forces
-    Array<double> force(nan, nm), fibforce(nan, nm);
-    Array<double> actfibforce(nan,nm), passfibforce(nan,nm);
-    Array<double> actfibforcealongten(nan,nm), passfibforcealongten(nan,nm);
-
-    // Muscle and component powers
-    Array<double> fibActivePower(nan,nm), fibPassivePower(nan,nm),
-                  tendonPower(nan,nm), muscPower(nan,nm);
+    // All quantities for all muscles go into one contiguous block.
+    enum Quantity {
+        PennationAngle, Length, TendonLength, FiberLength,
+        NormalizedFiberLength, FiberVelocity, NormFiberVelocity,
+        PennationAngularVelocity, Force, FiberForce, ActiveFiberForce,
+        PassiveFiberForce, ActiveFiberForceAlongTendon,
+        PassiveFiberForceAlongTendon, FiberActivePower, FiberPassivePower,
+        TendonPower, MusclePower, NumQuantities
+    };
+    _recordValues.assign(NumQuantities*nm, SimTK::NaN);
+    auto values = [&](Quantity q) { return _recordValues.data() + q*nm; };
+    double* penang = values(PennationAngle);
+    double* len = values(Length);
+    double* tlen = values(TendonLength);
+    double* fiblen = values(FiberLength);
+    double* normfiblen = values(NormalizedFiberLength);
+    double* fibVel = values(FiberVelocity);
+    double* normFibVel = values(NormFiberVelocity);
+    double* penAngVel = values(PennationAngularVelocity);
+    double* force = values(Force);
+    double* fibforce = values(FiberForce);
+    double* actfibforce = values(ActiveFiberForce);
+    double* passfibforce = values(PassiveFiberForce);
+    double* actfibforcealongten = values(ActiveFiberForceAlongTendon);
+    double* passfibforcealongten = values(PassiveFiberForceAlongTendon);
+    double* fibActivePower = values(FiberActivePower);
+    double* fibPassivePower = values(FiberPassivePower);
+    double* tendonPower = values(TendonPower);
+    double* muscPower = values(MusclePower);
 
     double sysMass = _model->getMatterSubsystem().calcSystemMass(s);
     bool hasMass = sysMass > SimTK::Eps;
@@ -532,13 +543,29 @@ int MuscleAnalysis::record(const SimTK::State& s)
     bool forceWarning = false;
     bool dynamicsWarning = false;
 
+    // Realize once for all muscles. With mass, realizing Dynamics computes
+    // the forces, state derivatives (activation rate and fiber velocity) and
+    // powers of all muscles, which are then read from their caches.
+    // Without mass, the system dynamics cannot be computed, so the forces
+    // are computed muscle by muscle from the positions and velocities.
+    if(hasMass) {
+        _model->getMultibodySystem().realize(s,SimTK::Stage::Dynamics);
+    } else {
+        _model->getMultibodySystem().realize(s,SimTK::Stage::Velocity);
+        log_warn("MuscleAnalysis::record() unable to evaluate muscle "
+                 "dynamics at time {} because model has no mass and system "
+                 "dynamics cannot be computed.", tReal);
+        dynamicsWarning = true;
+    }
+
     for(int i=0; i<nm; ++i) {
+        const Muscle& muscle = *_muscleArray[i];
         try{
-            len[i] = _muscleArray[i]->getLength(s);
-            tlen[i] = _muscleArray[i]->getTendonLength(s);
-            fiblen[i] = _muscleArray[i]->getFiberLength(s);
-            normfiblen[i] = _muscleArray[i]->getNormalizedFiberLength(s);
-            penang[i] = _muscleArray[i]->getPennationAngle(s);
+            len[i] = muscle.getLength(s);
+            tlen[i] = muscle.getTendonLength(s);
+            fiblen[i] = muscle.getFiberLength(s);
+            normfiblen[i] = muscle.getNormalizedFiberLength(s);
+            penang[i] = muscle.getPennationAngle(s);
         }
         catch (const std::exception& e) {
             if(!lengthWarning){
@@ -553,13 +580,13 @@ int MuscleAnalysis::record(const SimTK::State& s)
         try{
             // Compute muscle forces that are dependent on Positions, Velocities
             // so that later quantities are valid and setForce is called
-            _muscleArray[i]->computeActuation(s);
-            force[i] = _muscleArray[i]->getActuation(s);
-            fibforce[i] = _muscleArray[i]->getFiberForce(s);
-            actfibforce[i] = _muscleArray[i]->getActiveFiberForce(s);
-            passfibforce[i] = _muscleArray[i]->getPassiveFiberForce(s);
-            actfibforcealongten[i] = _muscleArray[i]->getActiveFiberForceAlongTendon(s);
-            passfibforcealongten[i] = _muscleArray[i]->getPassiveFiberForceAlongTendon(s);
+            if(!hasMass) muscle.computeActuation(s);
+            force[i] = muscle.getActuation(s);
+            fibforce[i] = muscle.getFiberForce(s);
+            actfibforce[i] = muscle.getActiveFiberForce(s);
+            passfibforce[i] = muscle.getPassiveFiberForce(s);
+            actfibforcealongten[i] = muscle.getActiveFiberForceAlongTendon(s);
+            passfibforcealongten[i] = muscle.getPassiveFiberForceAlongTendon(s);
         }
         catch (const std::exception& e) {
             if(!forceWarning){
@@ -570,94 +597,74 @@ int MuscleAnalysis::record(const SimTK::State& s)
             }
             continue;
         }
-    }
-
-    // Cannot compute system dynamics without mass
-    if(hasMass){
-        // state derivatives (activation rate and fiber velocity) evaluated at dynamics
-        _model->getMultibodySystem().realize(s,SimTK::Stage::Dynamics);
 
-        for(int i=0; i<nm; ++i) {
-            try{
-                //Velocities
-                fibVel[i] = _muscleArray[i]->getFiberVelocity(s);
-                normFibVel[i] =  _muscleArray[i]->getNormalizedFiberVelocity(s);
-                penAngVel[i] =  _muscleArray[i]->getPennationAngularVelocity(s);
-                //Powers
-                fibActivePower[i] = _muscleArray[i]->getFiberActivePower(s);
-                fibPassivePower[i] = _muscleArray[i]->getFiberPassivePower(s);
-                tendonPower[i] = _muscleArray[i]->getTendonPower(s);
-                muscPower[i] = _muscleArray[i]->getMusclePower(s);
-            }
-            catch (const std::exception& e) {
-                if(!dynamicsWarning){
-                    log_warn("MuscleAnalysis::record() unable to evaluate "
-                             "muscle forces at time {} for reason: {}",
-                             s.getTime(), e.what());
-                    dynamicsWarning = true;
-                }
-            continue;
-            }
+        if(!hasMass) continue;
+        try{
+            //Velocities
+            fibVel[i] = muscle.getFiberVelocity(s);
+            normFibVel[i] =  muscle.getNormalizedFiberVelocity(s);
+            penAngVel[i] =  muscle.getPennationAngularVelocity(s);
+            //Powers
+            fibActivePower[i] = muscle.getFiberActivePower(s);
+            fibPassivePower[i] = muscle.getFiberPassivePower(s);
+            tendonPower[i] = muscle.getTendonPower(s);
+            muscPower[i] = muscle.getMusclePower(s);
         }
-    }
-    else {
-        if(!dynamicsWarning){
-            log_warn("MuscleAnalysis::record() unable to evaluate muscle "
-                     "dynamics at time {} because model has no mass and system "
-                     "dynamics cannot be computed.");
-            dynamicsWarning = true;
+        catch (const std::exception& e) {
+            if(!dynamicsWarning){
+                log_warn("MuscleAnalysis::record() unable to evaluate "
+                         "muscle forces at time {} for reason: {}",
+                         s.getTime(), e.what());
+                dynamicsWarning = true;
+            }
         }
     }
 
     // APPEND TO STORAGE
-    _pennationAngleStore->append(tReal,penang.getSize(),&penang[0]);
-    _lengthStore->append(tReal,len.getSize(),&len[0]);
-    _fiberLengthStore->append(tReal,fiblen.getSize(),&fiblen[0]);
-    _normalizedFiberLengthStore
-        ->append(tReal,normfiblen.getSize(),&normfiblen[0]);
-    _tendonLengthStore->append(tReal,tlen.getSize(),&tlen[0]);
-
-    _fiberVelocityStore->append(tReal,fibVel.getSize(),&fibVel[0]);
-    _normFiberVelocityStore->append(tReal,normFibVel.getSize(),&normFibVel[0]);
-    _pennationAngularVelocityStore
-        ->append(tReal,penAngVel.getSize(),&penAngVel[0]);
-
-    _forceStore->append(tReal,force.getSize(),&force[0]);
-    _fiberForceStore->append(tReal,fibforce.getSize(),&fibforce[0]);
-    _activeFiberForceStore->append(tReal,actfibforce.getSize(),&actfibforce[0]);
-    _passiveFiberForceStore
-        ->append(tReal,passfibforce.getSize(),&passfibforce[0]);
-    _activeFiberForceAlongTendonStore
-        ->append(tReal,actfibforcealongten.getSize(),&actfibforcealongten[0]);
-    _passiveFiberForceAlongTendonStore
-        ->append(tReal,passfibforcealongten.getSize(),&passfibforcealongten[0]);
-
-    _fiberActivePowerStore
-        ->append(tReal,fibActivePower.getSize(),&fibActivePower[0]);
-    _fiberPassivePowerStore
-        ->append(tReal,fibPassivePower.getSize(),&fibPassivePower[0]);
-    _tendonPowerStore->append(tReal,tendonPower.getSize(),&tendonPower[0]);
-    _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
+    _pennationAngleStore->append(tReal,nm,penang);
+    _lengthStore->append(tReal,nm,len);
+    _fiberLengthStore->append(tReal,nm,fiblen);
+    _normalizedFiberLengthStore->append(tReal,nm,normfiblen);
+    _tendonLengthStore->append(tReal,nm,tlen);
+
+    _fiberVelocityStore->append(tReal,nm,fibVel);
+    _normFiberVelocityStore->append(tReal,nm,normFibVel);
+    _pennationAngularVelocityStore->append(tReal,nm,penAngVel);
+
+    _forceStore->append(tReal,nm,force);
+    _fiberForceStore->append(tReal,nm,fibforce);
+    _activeFiberForceStore->append(tReal,nm,actfibforce);
+    _passiveFiberForceStore->append(tReal,nm,passfibforce);
+    _activeFiberForceAlongTendonStore->append(tReal,nm,actfibforcealongten);
+    _passiveFiberForceAlongTendonStore->append(tReal,nm,passfibforcealongten);
+
+    _fiberActivePowerStore->append(tReal,nm,fibActivePower);
+    _fiberPassivePowerStore->append(tReal,nm,fibPassivePower);
+    _tendonPowerStore->append(tReal,nm,tendonPower);
+    _musclePowerStore->append(tReal,nm,muscPower);
 
     if (_computeMoments){
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
-        for(int i=0; i<nq; i++) {
+        // Compute the moment arms of all muscles about all coordinates in a
+        // single pass.
+        std::vector<const Coordinate*> coords(nq);
+        for(int i=0; i<nq; i++) coords[i] = _momentArmStorageArray[i]->q;
+        std::vector<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++) paths[j] = &_muscleArray[j]->getGeometryPath();
+        const SimTK::Matrix momentArms =
+                GeometryPath::computeMomentArmMatrix(s, paths, coords);
 
-            q = _momentArmStorageArray[i]->q;
+        for(int i=0; i<nq; i++) {
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = momentArms(j, i);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
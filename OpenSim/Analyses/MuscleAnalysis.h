@@ -31,6 +31,7 @@
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
 #include "osimAnalysesDLL.h"
+#include <vector>
 
 
 #ifdef SWIG
@@ -140,6 +141,9 @@ private:
 #endif
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
+    /** Work array for the values recorded for each muscle at one instant:
+    one contiguous block of values (one per muscle) for each quantity. */
+    std::vector<double> _recordValues;
 
 //=============================================================================
 // METHODS
@@ -518,33 +518,47 @@ setStorageCapacityIncrements(int aIncrement)
 int PointKinematics::
 record(const SimTK::State& s)
 {
+    // Compute the position, velocity and acceleration of the point (and of
+    // the relative-to body) in one pass. The stations are added on each call
+    // because the body and point can be changed at any time.
+    _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
+    _snapshot.clear();
+    _snapshot.addStation(*_body, _point);
+    if(_relativeToBody) _snapshot.addStation(*_relativeToBody);
+    _snapshot.update(s);
+    const SimTK::Vector_<SimTK::Vec3>& p_G = _snapshot.getLocationsInGround();
+    const SimTK::Vector_<SimTK::SpatialVec>& V_G =
+            _snapshot.getVelocitiesInGround();
+    const SimTK::Vector_<SimTK::SpatialVec>& A_G =
+            _snapshot.getAccelerationsInGround();
+
     // VARIABLES
     SimTK::Vec3 vec;
+    SimTK::Rotation R_GR;
+    if(_relativeToBody) R_GR = _snapshot.getRotationsInGround()[1];
 
     const double& time = s.getTime();
-    const Ground& ground = _model->getGround();
 
     // POSITION
-    vec = _body->findStationLocationInGround(s, _point);
+    vec = p_G[0];
     if(_relativeToBody){
-        vec = ground.findStationLocationInAnotherFrame(s, vec, *_relativeToBody);
+        vec = ~R_GR * (vec - p_G[1]);
     }
 
     _pStore->append(time, vec);
 
     // VELOCITY
-    vec = _body->findStationVelocityInGround(s, _point);
+    vec = V_G[0][1];
     if(_relativeToBody){
-        vec = ground.expressVectorInAnotherFrame(s, vec, *_relativeToBody);
+        vec = ~R_GR * vec;
     }
 
     _vStore->append(time, vec);
 
     // ACCELERATIONS
-    _model->getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
-    vec = _body->findStationAccelerationInGround(s, _point);
+    vec = A_G[0][1];
     if(_relativeToBody){
-        vec = ground.expressVectorInAnotherFrame(s, vec, *_relativeToBody);
+        vec = ~R_GR * vec;
     }
 
     _aStore->append(time, vec);
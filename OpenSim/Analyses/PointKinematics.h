@@ -37,6 +37,7 @@
 
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
+#include <OpenSim/Simulation/KinematicsSnapshot.h>
 
 const int PointKinematicsNAME_LENGTH = 256;
 const int PointKinematicsBUFFER_LENGTH = 2048;
@@ -70,6 +71,8 @@ private:
     //char _tmp[PointKinematicsBUFFER_LENGTH];
     const PhysicalFrame *_body;
     const PhysicalFrame *_relativeToBody;
+    /** The point and, if set, the origin of the relative-to body. */
+    KinematicsSnapshot _snapshot;
 protected:
     // Properties
     PropertyStr _bodyNameProp;
@@ -147,6 +150,9 @@ public:
     int begin(const SimTK::State& s) override;
     int step(const SimTK::State& s, int setNumber) override;
     int end(const SimTK::State& s) override;
+    SimTK::Stage getRequiredStage() const override {
+        return SimTK::Stage::Acceleration;
+    }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -146,6 +146,9 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    SimTK::Stage getRequiredStage() const override {
+        return SimTK::Stage::Report;
+    }
 protected:
     virtual int
         record(const SimTK::State& s );
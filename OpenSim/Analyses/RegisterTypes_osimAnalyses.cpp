@@ -42,17 +42,17 @@ OSIMANALYSES_API void RegisterTypes_osimAnalyses()
 {
   try {
 
-    Object::registerType( Kinematics() );
-    Object::registerType( Actuation());
-    Object::registerType( PointKinematics() );
-    Object::registerType( BodyKinematics() );
-    Object::registerType( MuscleAnalysis() );
+    Object::registerTypeLazily<Kinematics>();
+    Object::registerTypeLazily<Actuation>();
+    Object::registerTypeLazily<PointKinematics>();
+    Object::registerTypeLazily<BodyKinematics>();
+    Object::registerTypeLazily<MuscleAnalysis>();
 
-    Object::registerType( JointReaction() );
-    Object::registerType( StaticOptimization() );
-    Object::registerType( ForceReporter() );
-    Object::registerType( StatesReporter() );
-    Object::registerType( InducedAccelerations() );
+    Object::registerTypeLazily<JointReaction>();
+    Object::registerTypeLazily<StaticOptimization>();
+    Object::registerTypeLazily<ForceReporter>();
+    Object::registerTypeLazily<StatesReporter>();
+    Object::registerTypeLazily<InducedAccelerations>();
     Object::RegisterType( ProbeReporter() );
 
     Object::RegisterType( OutputReporter() );
@@ -199,11 +199,11 @@ record(const SimTK::State& s)
     if(_model==NULL) return(-1);
 
     // MAKE SURE ALL StatesReporter QUANTITIES ARE VALID
-    _model->getMultibodySystem().realize(s, SimTK::Stage::Velocity );
+    _model->getMultibodySystem().realize(s, getRequiredStage());
 
-    SimTK::Vector stateValues = _model->getStateVariableValues(s);
-    StateVector nextRow(s.getTime(), stateValues);
-    _statesStore.append(nextRow);
+    _model->getStateVariableValues(s, _stateValues);
+    _statesStore.append(s.getTime(), _stateValues.size(),
+            _stateValues.getContiguousScalarData());
 
     return(0);
 }
@@ -60,6 +60,8 @@ private:
 protected:
     /** States storage. */
     Storage _statesStore;
+    /** Reused buffer for the state variable values. */
+    SimTK::Vector _stateValues;
 
 //=============================================================================
 // METHODS
@@ -104,6 +106,10 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    /** Only the state values are recorded, so no computations are needed. */
+    SimTK::Stage getRequiredStage() const override {
+        return SimTK::Stage::Time;
+    }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -25,6 +25,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -33,6 +34,9 @@
 #include "StaticOptimizationTarget.h"
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
 
+#include <exception>
+#include <thread>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -61,6 +65,8 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useQuadraticProgramSolver(_useQuadraticProgramSolverProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +88,8 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useQuadraticProgramSolver(_useQuadraticProgramSolverProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,6 +122,8 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _useQuadraticProgramSolver=aStaticOptimization._useQuadraticProgramSolver;
+    _numThreads=aStaticOptimization._numThreads;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -138,6 +148,8 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _useQuadraticProgramSolver = false;
+    _numThreads = 1;
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +185,21 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _useQuadraticProgramSolverProp.setComment(
+        "If true and the activation exponent is 2, each time frame is solved as a "
+        "quadratic program with an active-set method (much faster). Frames that "
+        "this method cannot solve are solved with the optimizer.");
+    _useQuadraticProgramSolverProp.setName("use_quadratic_program_solver");
+    _propertySet.append(&_useQuadraticProgramSolverProp);
+
+    _numThreadsProp.setComment(
+        "Number of threads used to solve the time frames (values less than 1 "
+        "use all available cores). With more than one thread, the frames are "
+        "solved in contiguous chunks after all frames have been recorded, and "
+        "the first frame of each chunk is not warm-started.");
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //=============================================================================
@@ -307,62 +334,68 @@ record(const SimTK::State& s)
 {
     if(!_modelWorkingCopy) return -1;
 
+    // IPOPT
+    _numericalDerivativeStepSize = 0.0001;
+    _optimizerAlgorithm = "ipopt";
+    _printLevel = 0;
+    //_optimizationConvergenceTolerance = 1e-004;
+    //_maxIterations = 2000;
+
+    if(_numThreads != 1) {
+        // The frames are solved in parallel in end().
+        if(_frameTimes.empty() || s.getTime() > _frameTimes.back()) {
+            _frameTimes.push_back(s.getTime());
+            _frameQ.push_back(s.getQ());
+            _frameU.push_back(s.getU());
+        }
+        return 0;
+    }
+
+    solveFrame(*_modelWorkingCopy, *_forceReporter, _statesSplineSet,
+            s.getTime(), s.getQ(), s.getU(), _parameters, _activeSet);
+    _activationStorage->append(s.getTime(),
+            _modelWorkingCopy->getActuators().getSize(), &_parameters[0]);
+
+    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * Solve the static optimization problem at one time frame with the given
+ * working model, record the actuator forces with the given ForceReporter and
+ * return the activations in parameters. On entry, activeSet is the warm
+ * start from the previous frame.
+ */
+void StaticOptimization::
+solveFrame(Model& model, ForceReporter& forceReporter,
+        const GCVSplineSet& statesSplineSet, double time,
+        const SimTK::Vector& q, const SimTK::Vector& u,
+        SimTK::Vector& parameters, std::vector<int>& activeSet) const
+{
     // Set model to whatever defaults have been updated to from the last iteration
-    SimTK::State& sWorkingCopy = _modelWorkingCopy->updWorkingState();
-    sWorkingCopy.setTime(s.getTime());
-    _modelWorkingCopy->initStateWithoutRecreatingSystem(sWorkingCopy); 
+    SimTK::State& sWorkingCopy = model.updWorkingState();
+    sWorkingCopy.setTime(time);
+    model.initStateWithoutRecreatingSystem(sWorkingCopy); 
 
     // update Q's and U's
-    sWorkingCopy.setQ(s.getQ());
-    sWorkingCopy.setU(s.getU());
+    sWorkingCopy.setQ(q);
+    sWorkingCopy.setU(u);
 
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
-    //_modelWorkingCopy->equilibrateMuscles(sWorkingCopy);
+    model.getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
+    //model.equilibrateMuscles(sWorkingCopy);
 
-    const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& fs = model.getActuators();
 
     int na = fs.getSize();
     int nacc = _accelerationIndices.getSize();
 
-    // IPOPT
-    _numericalDerivativeStepSize = 0.0001;
-    _optimizerAlgorithm = "ipopt";
-    _printLevel = 0;
-    //_optimizationConvergenceTolerance = 1e-004;
-    //_maxIterations = 2000;
-
     // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+    model.setAllControllersEnabled(false);
+    StaticOptimizationTarget target(sWorkingCopy,&model,na,nacc,_useMusclePhysiology);
     target.setStatesStore(_statesStore);
-    target.setStatesSplineSet(_statesSplineSet);
+    target.setStatesSplineSet(statesSplineSet);
     target.setActivationExponent(_activationExponent);
     target.setDX(_numericalDerivativeStepSize);
 
-    // Pick optimizer algorithm
-    SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
-    //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
-
-    // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
-
-    // Optimizer options
-    //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
-    optimizer->setDiagnosticsLevel(_printLevel);
-    //cout<<"Setting optimizer convergence criterion to "<<_convergenceCriterion<<".\n";
-    optimizer->setConvergenceTolerance(_convergenceCriterion);
-    //cout<<"Setting optimizer maximum iterations to "<<_maximumIterations<<".\n";
-    optimizer->setMaxIterations(_maximumIterations);
-    optimizer->useNumericalGradient(false);
-    optimizer->useNumericalJacobian(false);
-    if(algorithm == SimTK::InteriorPoint) {
-        // Some IPOPT-specific settings
-        optimizer->setLimitedMemoryHistory(500); // works well for our small systems
-        optimizer->setAdvancedBoolOption("warm_start",true);
-        optimizer->setAdvancedRealOption("obj_scaling_factor",1);
-        optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
-    }
-
     // Parameter bounds
     SimTK::Vector lowerBounds(na), upperBounds(na);
     for(int i=0,j=0;i<fs.getSize();i++) {
@@ -376,11 +409,11 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    parameters = 0; // Set initial guess to zeros
 
     // Static optimization
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
-    target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
+    model.getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
+    target.prepareToOptimize(sWorkingCopy, &parameters[0]);
 
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
@@ -389,26 +422,62 @@ record(const SimTK::State& s)
     //QueryPerformanceFrequency(&frequency);
     //QueryPerformanceCounter(&start);
 
+    bool solved = false;
+    if(_useQuadraticProgramSolver && _activationExponent == 2) {
+        solved = target.solveQuadraticProgram(parameters, activeSet);
+        if(!solved) {
+            log_debug("StaticOptimization.record: The quadratic program "
+                      "solver did not converge at time = {}; using the "
+                      "optimizer.", time);
+            parameters = 0;
+            activeSet.clear();
+        }
+    }
+
     try {
-        target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        if(!solved) {
+            // Pick optimizer algorithm
+            SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
+            //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
+
+            // Optimizer
+            std::unique_ptr<SimTK::Optimizer> optimizer(
+                    new SimTK::Optimizer(target, algorithm));
+
+            // Optimizer options
+            optimizer->setDiagnosticsLevel(_printLevel);
+            optimizer->setConvergenceTolerance(_convergenceCriterion);
+            optimizer->setMaxIterations(_maximumIterations);
+            optimizer->useNumericalGradient(false);
+            optimizer->useNumericalJacobian(false);
+            if(algorithm == SimTK::InteriorPoint) {
+                // Some IPOPT-specific settings
+                optimizer->setLimitedMemoryHistory(500); // works well for our small systems
+                optimizer->setAdvancedBoolOption("warm_start",true);
+                optimizer->setAdvancedRealOption("obj_scaling_factor",1);
+                optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
+            }
+
+            target.setCurrentState( &sWorkingCopy );
+            optimizer->optimize(parameters);
+        }
     }
     catch (const SimTK::Exception::Base& ex) {
         log_warn(ex.getMessage());
         log_warn("OPTIMIZATION FAILED...");
         log_warn("StaticOptimization.record: The optimizer could not find a "
                  "solution at time = {}.",
-                s.getTime());
+                time);
 
         double tolBounds = 1e-1;
         bool weakModel = false;
         string msgWeak = "The model appears too weak for static optimization.\nTry increasing the strength and/or range of the following force(s):\n";
         for(int a=0;a<na;a++) {
-            Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(a));
+            Actuator* act = dynamic_cast<Actuator*>(&model.updForceSet().get(a));
             if( act ) {
-                Muscle*  mus = dynamic_cast<Muscle*>(&_forceSet->get(a));
+                Muscle*  mus = dynamic_cast<Muscle*>(&model.updForceSet().get(a));
                 if(mus==NULL) {
-                    if(_parameters(a) < (lowerBounds(a)+tolBounds)) {
+                    if(parameters(a) < (lowerBounds(a)+tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching lower bound of ";
@@ -417,7 +486,7 @@ record(const SimTK::State& s)
                         msgWeak += oLower.str();
                         msgWeak += "\n";
                         weakModel = true;
-                    } else if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    } else if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching upper bound of ";
@@ -428,7 +497,7 @@ record(const SimTK::State& s)
                         weakModel = true;
                     } 
                 } else {
-                    if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += mus->getName();
                         msgWeak += " approaching upper bound of ";
@@ -448,9 +517,9 @@ record(const SimTK::State& s)
             bool incompleteModel = false;
             string msgIncomplete = "The model appears unsuitable for static optimization.\nTry appending the model with additional force(s) or locking joint(s) to reduce the following acceleration constraint violation(s):\n";
             SimTK::Vector constraints;
-            target.constraintFunc(_parameters,true,constraints);
+            target.constraintFunc(parameters,true,constraints);
 
-            auto coordinates = _modelWorkingCopy->getCoordinatesInMultibodyTreeOrder();
+            auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
 
             for(int acc=0;acc<nacc;acc++) {
                 if(fabs(constraints(acc)) > tolConstraints) {
@@ -465,7 +534,7 @@ record(const SimTK::State& s)
                     incompleteModel = true;
                 }
             }
-            _forceReporter->step(sWorkingCopy, 1);
+            forceReporter.step(sWorkingCopy, 1);
             if(incompleteModel) log_warn(msgIncomplete);
         }
     }
@@ -475,27 +544,100 @@ record(const SimTK::State& s)
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
     if (Logger::shouldLog(Logger::Level::Info)) {
-        target.printPerformance(sWorkingCopy, &_parameters[0]);
+        target.printPerformance(sWorkingCopy, &parameters[0]);
     }
 
     //update defaults for use in the next step
 
-    const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& actuators = model.getActuators();
     for(int k=0; k < actuators.getSize(); ++k){
         ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
         if(mus){
-            mus->setDefaultActivation(_parameters[k]);
+            mus->setDefaultActivation(parameters[k]);
         }
     }
 
-    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
-
     SimTK::Vector forces(na);
-    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), _parameters,forces);
+    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), parameters,forces);
+
+    forceReporter.step(sWorkingCopy, 1);
+}
+//_____________________________________________________________________________
+/**
+ * Solve the frames collected by record() in contiguous chunks, one per
+ * thread. Each thread has its own copy of the working model, ForceReporter
+ * and states splines; the first frame of each chunk is cold-started. The
+ * results are appended to the activation and force storages in time order.
+ */
+void StaticOptimization::solveFramesInParallel()
+{
+    const int numFrames = (int)_frameTimes.size();
+    int numThreads = _numThreads > 0 ? _numThreads : getNumAvailableThreads();
+    numThreads = std::max(1, std::min(numThreads, numFrames));
+    const ThreadReservation reservation(numThreads);
+
+    // Copy the model before any thread modifies the working copy.
+    std::vector<std::unique_ptr<Model>> models(numThreads);
+    for(int t=1; t<numThreads; t++) models[t].reset(_modelWorkingCopy->clone());
+    std::vector<std::unique_ptr<ForceReporter>> forceReporters(numThreads);
+    std::vector<SimTK::Vector> activations(numFrames);
+    std::vector<std::exception_ptr> errors(numThreads);
+
+    auto solveChunk = [&](int t) {
+        try {
+            Model* model = _modelWorkingCopy;
+            ForceReporter* forceReporter = _forceReporter.get();
+            if(t > 0) {
+                model = models[t].get();
+                SimTK::State& state = model->initSystem();
+                ForceSet& forceSet = model->updForceSet();
+                for(int i=0; i<forceSet.getSize(); i++) {
+                    ScalarActuator* act = dynamic_cast<ScalarActuator*>(&forceSet.get(i));
+                    if(act) act->overrideActuation(state, true);
+                }
+                forceReporters[t].reset(new ForceReporter(model));
+                forceReporters[t]->begin(state);
+                forceReporters[t]->updForceStorage().reset();
+                forceReporter = forceReporters[t].get();
+            }
+            GCVSplineSet statesSplineSet(_statesSplineSet);
+            SimTK::Vector parameters(_parameters.size(), 0.0);
+            std::vector<int> activeSet;
+            const int first = (int)((long long)numFrames * t / numThreads);
+            const int last = (int)((long long)numFrames * (t + 1) / numThreads);
+            for(int i=first; i<last; i++) {
+                solveFrame(*model, *forceReporter, statesSplineSet,
+                        _frameTimes[i], _frameQ[i], _frameU[i],
+                        parameters, activeSet);
+                activations[i] = parameters;
+            }
+        } catch(...) {
+            errors[t] = std::current_exception();
+        }
+    };
 
-    _forceReporter->step(sWorkingCopy, 1);
+    std::vector<std::thread> threads;
+    for(int t=1; t<numThreads; t++) threads.emplace_back(solveChunk, t);
+    solveChunk(0);
+    for(auto& thread : threads) thread.join();
+    for(const auto& error : errors) if(error) std::rethrow_exception(error);
 
-    return 0;
+    const int na = _modelWorkingCopy->getActuators().getSize();
+    for(int i=0; i<numFrames; i++) {
+        _activationStorage->append(_frameTimes[i], na, &activations[i][0]);
+    }
+    Storage& forceStorage = _forceReporter->updForceStorage();
+    for(int t=1; t<numThreads; t++) {
+        const Storage& chunkForces = forceReporters[t]->getForceStorage();
+        for(int i=0; i<chunkForces.getSize(); i++) {
+            forceStorage.append(*chunkForces.getStateVector(i));
+        }
+    }
+    _parameters = activations.back();
+
+    _frameTimes.clear();
+    _frameQ.clear();
+    _frameU.clear();
 }
 //_____________________________________________________________________________
 /**
@@ -592,8 +734,13 @@ int StaticOptimization::begin(const SimTK::State& s )
 
         _parameters.resize(_modelWorkingCopy->getNumControls());
         _parameters = 0;
+        _activeSet.clear();
     }
 
+    _frameTimes.clear();
+    _frameQ.clear();
+    _frameU.clear();
+
     _statesSplineSet=GCVSplineSet(5,_statesStore);
 
     // DESCRIPTION AND LABELS
@@ -664,6 +811,7 @@ int StaticOptimization::end( const SimTK::State& s )
     if(!proceed()) return(0);
 
     record(s);
+    if(!_frameTimes.empty()) solveFramesInParallel();
 
     return(0);
 }
@@ -29,6 +29,7 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
@@ -76,6 +77,12 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyBool _useQuadraticProgramSolverProp;
+    bool &_useQuadraticProgramSolver;
+
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -83,6 +90,14 @@ protected:
     Array<int> _accelerationIndices;
 
     SimTK::Vector _parameters;
+    /** Active set of the quadratic program solver at the previous time
+    frame (see StaticOptimizationTarget::solveQuadraticProgram()). */
+    std::vector<int> _activeSet;
+
+    /** Frames recorded for solving in parallel in end(). */
+    std::vector<double> _frameTimes;
+    std::vector<SimTK::Vector> _frameQ;
+    std::vector<SimTK::Vector> _frameU;
 
     bool _ownsForceSet;
     ForceSet* _forceSet;
@@ -135,6 +150,19 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** If the activation exponent is 2, solve each time frame as a quadratic
+    program with an active-set method warm-started from the previous frame,
+    which is much faster than the general-purpose optimizer. Frames for which
+    the method fails are solved with the optimizer. */
+    void setUseQuadraticProgramSolver(bool useIt) { _useQuadraticProgramSolver = useIt; }
+    bool getUseQuadraticProgramSolver() const { return _useQuadraticProgramSolver; }
+    /** The number of threads used to solve the time frames (default: 1;
+    values less than 1 use all available cores). With more than one thread,
+    the frames are collected during the analysis and solved in contiguous
+    chunks by end(), each with its own copy of the model; the first frame of
+    each chunk is cold-started. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
@@ -147,6 +175,12 @@ public:
 protected:
     virtual int
         record(const SimTK::State& s );
+private:
+    void solveFrame(Model& model, ForceReporter& forceReporter,
+            const GCVSplineSet& statesSplineSet, double time,
+            const SimTK::Vector& q, const SimTK::Vector& u,
+            SimTK::Vector& parameters, std::vector<int>& activeSet) const;
+    void solveFramesInParallel();
     //--------------------------------------------------------------------------
     // IO
     //--------------------------------------------------------------------------
@@ -31,6 +31,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
 #include "StaticOptimizationTarget.h"
+#include <simmath/LinearAlgebra.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -138,6 +139,121 @@ prepareToOptimize(SimTK::State& s, double *x)
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Minimize the sum of squared parameters subject to the linear acceleration
+ * constraints and the parameter bounds. At each iteration, the parameters in
+ * the active set are fixed at their bounds and the equality-constrained
+ * problem in the free parameters is solved in closed form (minimum-norm
+ * solution). A free parameter that violates a bound is added to the active
+ * set; otherwise a parameter whose Lagrange multiplier has the wrong sign is
+ * released. The solution satisfies the KKT conditions of the (convex) problem
+ * when neither happens.
+ */
+bool StaticOptimizationTarget::
+solveQuadraticProgram(Vector& x, std::vector<int>& activeSet) const
+{
+    if(_activationExponent != 2) return false;
+    const int np = getNumParameters();
+    const int nc = getNumConstraints();
+    if(np <= 0) return false;
+    double *lower, *upper;
+    getParameterLimits(&lower, &upper);
+    for(int p=0; p<np; p++) if(lower[p] > upper[p]) return false;
+
+    x.resize(np);
+    if(nc == 0) {
+        for(int p=0; p<np; p++)
+            x[p] = std::min(std::max(0.0, lower[p]), upper[p]);
+        return true;
+    }
+
+    if((int)activeSet.size() != np) activeSet.assign(np, 0);
+    for(int p=0; p<np; p++) if(lower[p] == upper[p]) activeSet[p] = -1;
+
+    const double feasibilityTol = 1e-10;
+    const double multiplierTol = 1e-10;
+    const int maxIterations = 10 * np + 10;
+    bool resetActiveSet = false;
+
+    std::vector<int> freeIndices;
+    Vector r(nc), xFree, lambda;
+    for(int iter=0; iter<maxIterations; iter++) {
+        // Fixed parameters move to the right-hand side: A_F x_F = -c - A_W b_W.
+        freeIndices.clear();
+        r = -_constraintVector;
+        for(int p=0; p<np; p++) {
+            if(activeSet[p] == 0) {
+                freeIndices.push_back(p);
+            } else {
+                x[p] = activeSet[p] < 0 ? lower[p] : upper[p];
+                r -= _constraintMatrix(p) * x[p];
+            }
+        }
+        const int nf = (int)freeIndices.size();
+
+        bool consistent = nf > 0;
+        if(consistent) {
+            Matrix AFree(nc, nf);
+            for(int j=0; j<nf; j++) AFree(j) = _constraintMatrix(freeIndices[j]);
+            SimTK::FactorQTZ(AFree).solve(r, xFree);
+            consistent = (AFree * xFree - r).normInf() <=
+                    1e-8 * std::max(1.0, r.normInf());
+            if(consistent) {
+                // Multipliers of the acceleration constraints:
+                // 2 x_F + A_F^T lambda = 0.
+                SimTK::FactorQTZ(~AFree).solve(-2.0 * xFree, lambda);
+            }
+        }
+        if(!consistent) {
+            // The fixed parameters leave no solution; start over from an
+            // empty active set once (e.g., the guess from the previous time
+            // frame was poor).
+            if(resetActiveSet) return false;
+            resetActiveSet = true;
+            for(int p=0; p<np; p++)
+                activeSet[p] = lower[p] == upper[p] ? -1 : 0;
+            continue;
+        }
+
+        // Fix the free parameter that violates its bounds the most.
+        int worst = -1;
+        double worstViolation = feasibilityTol;
+        for(int j=0; j<nf; j++) {
+            const int p = freeIndices[j];
+            x[p] = xFree[j];
+            const double violation = std::max(lower[p] - x[p], x[p] - upper[p])
+                    / (1 + std::abs(x[p]));
+            if(violation > worstViolation) {
+                worst = p;
+                worstViolation = violation;
+            }
+        }
+        if(worst >= 0) {
+            activeSet[worst] = x[worst] < lower[worst] ? -1 : 1;
+            continue;
+        }
+
+        // Release the fixed parameter whose multiplier has the wrong sign.
+        worst = -1;
+        double worstMultiplier = multiplierTol;
+        for(int p=0; p<np; p++) {
+            if(activeSet[p] == 0 || lower[p] == upper[p]) continue;
+            // Derivative of the Lagrangian with respect to the parameter; it
+            // must be nonnegative at a lower bound and nonpositive at an upper
+            // bound.
+            const double mu = 2.0 * x[p] + ~_constraintMatrix(p) * lambda;
+            const double wrongSign = activeSet[p] < 0 ? -mu : mu;
+            if(wrongSign > worstMultiplier) {
+                worst = p;
+                worstMultiplier = wrongSign;
+            }
+        }
+        if(worst < 0) return true;
+        activeSet[worst] = 0;
+    }
+    return false;
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -30,6 +30,7 @@
 #include "OpenSim/Common/Array.h"
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <simmath/Optimizer.h>
+#include <vector>
 
 //=============================================================================
 //=============================================================================
@@ -113,6 +114,19 @@ public:
 
     bool prepareToOptimize(SimTK::State& s, double *x);
 
+    /** Solve the problem as a quadratic program with a primal active-set
+    method, which is possible if the activation exponent is 2 (the
+    acceleration constraints are linear in the parameters, and the linear
+    constraint matrix is computed by prepareToOptimize()). `activeSet` holds,
+    for each parameter, -1 if it is fixed at its lower bound, 1 if it is
+    fixed at its upper bound and 0 if it is free; the active set found here
+    can be passed in at the next time frame as the initial guess. Returns
+    false if the method did not converge or the constraints could not be
+    satisfied, in which case the problem should be solved with a
+    SimTK::Optimizer. */
+    bool solveQuadraticProgram(SimTK::Vector& x,
+            std::vector<int>& activeSet) const;
+
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
     //--------------------------------------------------------------------------
@@ -0,0 +1,64 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  benchmarkCommon.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+using namespace OpenSim;
+
+namespace {
+const std::string statesFile = "std_subject01_walk1_states.sto";
+}
+
+TEST_CASE("Parse STO files", "[common]") {
+    BENCHMARK("TimeSeriesTable from " + statesFile) {
+        return TimeSeriesTable(statesFile).getNumRows();
+    };
+    BENCHMARK("Storage from " + statesFile) {
+        return Storage(statesFile).getSize();
+    };
+}
+
+TEST_CASE("Storage lookup", "[common]") {
+    const Storage storage(statesFile);
+    const int numColumns = storage.getColumnLabels().getSize() - 1;
+    const std::string lastLabel =
+            storage.getColumnLabels()[numColumns];
+    Array<double> times;
+    storage.getTimeColumn(times);
+    const double initialTime = times[0];
+    const double duration = times.getLast() - initialTime;
+    SimTK::Vector data(numColumns);
+
+    BENCHMARK("Storage::getStateIndex() of the last column") {
+        return storage.getStateIndex(lastLabel);
+    };
+    // Interpolate at times that are not in the storage (and jump around) so
+    // that each call has to search for the time.
+    int i = 0;
+    BENCHMARK("Storage::getDataAtTime()") {
+        const double time = initialTime + duration * ((37 * i++) % 100) / 100.3;
+        storage.getDataAtTime(time, numColumns, data);
+        return data[0];
+    };
+}
@@ -0,0 +1,112 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  benchmarkMain.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// The main() of the osimBenchmarks executable, which also provides a "json"
+// reporter so that benchmark results can be tracked across builds:
+//
+//     osimBenchmarks --reporter json --out benchmarks.json
+//
+// Each entry of "benchmarks" holds the mean time (and its bootstrapped
+// confidence interval) and the standard deviation of one BENCHMARK, in
+// nanoseconds per run.
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+#include <sstream>
+
+namespace {
+
+std::string escapeJson(const std::string& text) {
+    std::ostringstream escaped;
+    for (const char c : text) {
+        switch (c) {
+        case '"': escaped << "\\\""; break;
+        case '\\': escaped << "\\\\"; break;
+        case '\n': escaped << "\\n"; break;
+        case '\t': escaped << "\\t"; break;
+        default: escaped << c;
+        }
+    }
+    return escaped.str();
+}
+
+class JsonReporter : public Catch::StreamingReporterBase<JsonReporter> {
+public:
+    using StreamingReporterBase::StreamingReporterBase;
+
+    static std::string getDescription() {
+        return "Reports the benchmark statistics as JSON";
+    }
+
+    void assertionStarting(const Catch::AssertionInfo&) override {}
+    bool assertionEnded(const Catch::AssertionStats& stats) override {
+        if (!stats.assertionResult.isOk()) ++m_numFailedAssertions;
+        return true;
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override {
+        const auto& mean = stats.mean;
+        std::ostringstream entry;
+        entry << "    {\n"
+              << "      \"name\": \"" << escapeJson(stats.info.name)
+              << "\",\n"
+              << "      \"test_case\": \""
+              << escapeJson(currentTestCaseInfo->name) << "\",\n"
+              << "      \"samples\": " << stats.samples.size() << ",\n"
+              << "      \"iterations\": " << stats.info.iterations << ",\n"
+              << "      \"mean\": " << mean.point.count() << ",\n"
+              << "      \"mean_lower_bound\": " << mean.lower_bound.count()
+              << ",\n"
+              << "      \"mean_upper_bound\": " << mean.upper_bound.count()
+              << ",\n"
+              << "      \"std_dev\": " << stats.standardDeviation.point.count()
+              << ",\n"
+              << "      \"outlier_variance\": " << stats.outlierVariance
+              << ",\n"
+              << "      \"time_unit\": \"ns\"\n"
+              << "    }";
+        m_entries.push_back(entry.str());
+    }
+
+    void testRunEnded(const Catch::TestRunStats& stats) override {
+        stream << "{\n"
+               << "  \"executable\": \"" << escapeJson(m_config->name())
+               << "\",\n"
+               << "  \"failed_assertions\": " << m_numFailedAssertions
+               << ",\n"
+               << "  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            stream << m_entries[i] << (i + 1 < m_entries.size() ? ",\n" : "\n");
+        }
+        stream << "  ]\n}" << std::endl;
+        StreamingReporterBase::testRunEnded(stats);
+    }
+
+private:
+    std::vector<std::string> m_entries;
+    int m_numFailedAssertions = 0;
+};
+
+} // namespace
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
@@ -0,0 +1,54 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  benchmarkMoco.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/ModelOperators.h>
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Moco/osimMoco.h>
+
+using namespace OpenSim;
+
+TEST_CASE("MocoInverse", "[moco]") {
+    // The problem of testMocoInverse, with one iteration of the optimizer;
+    // a run includes creating the problem (and the CasADi functions).
+    MocoInverse inverse;
+    ModelProcessor modelProcessor =
+            ModelProcessor("subject_walk_armless_18musc.osim") |
+            ModOpReplaceJointsWithWelds(
+                    {"subtalar_r", "subtalar_l", "mtp_r", "mtp_l"}) |
+            ModOpReplaceMusclesWithDeGrooteFregly2016() |
+            ModOpIgnorePassiveFiberForcesDGF() |
+            ModOpTendonComplianceDynamicsModeDGF("implicit") |
+            ModOpAddExternalLoads("subject_walk_armless_external_loads.xml");
+    inverse.setModel(modelProcessor);
+    inverse.setKinematics(
+            TableProcessor("subject_walk_armless_coordinates.mot") |
+            TabOpLowPassFilter(6));
+    inverse.set_initial_time(0.450);
+    inverse.set_final_time(1.0);
+    inverse.set_kinematics_allow_extra_columns(true);
+    inverse.set_mesh_interval(0.025);
+    inverse.set_max_iterations(1);
+
+    BENCHMARK("MocoInverse, 18 muscles, one iteration") {
+        return inverse.solve().getMocoSolution().getNumIterations();
+    };
+}
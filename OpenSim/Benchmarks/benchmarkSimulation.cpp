@@ -0,0 +1,110 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  benchmarkSimulation.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/ActiveForceLengthCurve.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/FiberForceLengthCurve.h>
+#include <OpenSim/Actuators/ForceVelocityCurve.h>
+#include <OpenSim/Actuators/TendonForceLengthCurve.h>
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+
+using namespace OpenSim;
+
+TEST_CASE("GeometryPath with wrapping", "[simulation]") {
+    // TRIlong wraps over the TRIlongglen cylinder, the TRIlonghh ellipsoid
+    // and the TRI cylinder.
+    Model model("arm26.osim");
+    SimTK::State state = model.initSystem();
+    const auto& path =
+            model.getComponent<Muscle>("/forceset/TRIlong").getGeometryPath();
+    const auto& elbow = model.getCoordinateSet().get("r_elbow_flex");
+
+    // Change the pose for every run so that the path is recomputed.
+    int i = 0;
+    BENCHMARK("TRIlong length") {
+        elbow.setValue(state, 0.02 * (i++ % 100), false);
+        return path.getLength(state);
+    };
+    BENCHMARK("TRIlong moment arm about r_elbow_flex") {
+        elbow.setValue(state, 0.02 * (i++ % 100), false);
+        return path.computeMomentArm(state, elbow);
+    };
+}
+
+TEST_CASE("Muscle curve evaluation", "[simulation]") {
+    // Each run evaluates a curve at 100 points across its domain.
+    ActiveForceLengthCurve activeForceLength;
+    BENCHMARK("ActiveForceLengthCurve") {
+        double sum = 0;
+        for (int i = 0; i < 100; ++i) {
+            sum += activeForceLength.calcValue(0.4 + 0.012 * i);
+        }
+        return sum;
+    };
+    FiberForceLengthCurve fiberForceLength;
+    BENCHMARK("FiberForceLengthCurve") {
+        double sum = 0;
+        for (int i = 0; i < 100; ++i) {
+            sum += fiberForceLength.calcValue(0.8 + 0.008 * i);
+        }
+        return sum;
+    };
+    ForceVelocityCurve forceVelocity;
+    BENCHMARK("ForceVelocityCurve") {
+        double sum = 0;
+        for (int i = 0; i < 100; ++i) {
+            sum += forceVelocity.calcValue(-1.0 + 0.02 * i);
+        }
+        return sum;
+    };
+    TendonForceLengthCurve tendonForceLength;
+    BENCHMARK("TendonForceLengthCurve") {
+        double sum = 0;
+        for (int i = 0; i < 100; ++i) {
+            sum += tendonForceLength.calcValue(0.99 + 0.0006 * i);
+        }
+        return sum;
+    };
+    BENCHMARK("DeGrooteFregly2016Muscle force-velocity") {
+        double sum = 0;
+        for (int i = 0; i < 100; ++i) {
+            sum += DeGrooteFregly2016Muscle::calcForceVelocityMultiplier(
+                    -1.0 + 0.02 * i);
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("realizeAcceleration", "[simulation]") {
+    Model model("gait2354_simbody.osim");
+    SimTK::State state = model.initSystem();
+    model.equilibrateMuscles(state);
+    const auto& system = model.getMultibodySystem();
+
+    BENCHMARK("gait2354_simbody.osim") {
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Position);
+        system.realize(state, SimTK::Stage::Acceleration);
+        return state.getUDot()[0];
+    };
+}
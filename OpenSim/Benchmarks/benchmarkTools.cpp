@@ -0,0 +1,82 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  benchmarkTools.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/StatesTrajectory.h>
+
+using namespace OpenSim;
+
+TEST_CASE("Inverse kinematics", "[tools]") {
+    Model model("gait10dof18musc_subject01.osim");
+    SimTK::State state = model.initSystem();
+
+    auto markersRef = std::make_shared<MarkersReference>(
+            "gait10dof18musc_walk_CRLF_line_ending.trc",
+            Set<MarkerWeight>());
+    markersRef->setDefaultWeight(1.0);
+    SimTK::Array_<CoordinateReference> coordinateRefs;
+    InverseKinematicsSolver ikSolver(model, markersRef, coordinateRefs);
+    ikSolver.setAccuracy(1e-5);
+
+    const std::vector<double>& times =
+            markersRef->getMarkerTable().getIndependentColumn();
+    state.updTime() = times[0];
+    ikSolver.assemble(state);
+
+    // Track the frames in order, as InverseKinematicsTool does, starting over
+    // at the end of the trial.
+    std::size_t frame = 0;
+    BENCHMARK("IK track() per frame, gait10dof18musc") {
+        frame = (frame + 1) % times.size();
+        state.updTime() = times[frame];
+        ikSolver.track(state);
+        return state.getQ()[0];
+    };
+}
+
+TEST_CASE("Static optimization", "[tools]") {
+    Model model("gait2354_simbody.osim");
+    model.initSystem();
+    const Storage statesStore("std_subject01_walk1_states.sto");
+    const auto states =
+            StatesTrajectory::createFromStatesStorage(model, statesStore,
+                    false, true);
+
+    StaticOptimization so;
+    so.setModel(model);
+    so.setStatesStore(statesStore);
+    so.setNumThreads(1);
+    so.begin(states[0]);
+
+    // Solve one frame per run, in order, starting over at the end; each
+    // frame is warm-started from the previous one as in AnalyzeTool.
+    std::size_t frame = 0;
+    BENCHMARK("StaticOptimization per frame, gait2354_simbody") {
+        frame = (frame + 1) % states.getSize();
+        return so.record(states[frame]);
+    };
+}
@@ -0,0 +1,340 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  pipelineBenchmark.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Run a complete (if small) analysis pipeline on the Rajagopal2016-based
+// subject_walk_armless_18musc.osim model and its walking data:
+//
+//   Scale -> inverse kinematics -> inverse dynamics -> static optimization
+//         -> MocoInverse (only when built with CasADi)
+//
+// For each stage, report the wall time, the number of heap allocations, the
+// current and peak resident set size (RSS) after the stage and the growth in
+// the current RSS. The report is logged and written to a JSON file (the
+// first argument; default: pipeline_benchmark.json). Growth of the current
+// RSS across stages that should release their memory points to leaks.
+//
+// The model has no markers, so the inverse kinematics stage tracks markers
+// that are added to every body and synthesized from the recorded
+// coordinates; the scale stage applies unit scale factors so that the data
+// still matches the model.
+
+#include <OpenSim/Actuators/ModelOperators.h>
+#include <OpenSim/Actuators/ModelProcessor.h>
+#include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Auxiliary/getRSS.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/InverseDynamicsSolver.h>
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/TableProcessor.h>
+#include <OpenSim/Tools/AnalyzeTool.h>
+#ifdef OPENSIM_WITH_CASADI
+#include <OpenSim/Moco/osimMoco.h>
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <new>
+
+using namespace OpenSim;
+
+// Count heap allocations. This replaces operator new for the libraries as
+// well where the dynamic linker resolves their calls to the executable's
+// definition (e.g., Linux); elsewhere, only the allocations made directly by
+// this file are counted.
+namespace {
+std::atomic<long long> numAllocations(0);
+}
+
+void* operator new(std::size_t size) {
+    ++numAllocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    ++numAllocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+namespace {
+
+const std::string modelFile = "subject_walk_armless_18musc.osim";
+const std::string coordinatesFile = "subject_walk_armless_coordinates.mot";
+const std::string externalLoadsFile =
+        "subject_walk_armless_external_loads.xml";
+const std::string ikFile = "pipelineBenchmark_ik.sto";
+const double initialTime = 0.45;
+const double finalTime = 1.0;
+
+struct StageResult {
+    std::string name;
+    double seconds;
+    long long allocations;
+    std::size_t currentRSS;
+    std::size_t peakRSS;
+    long long currentRSSGrowth;
+};
+
+StageResult runStage(const std::string& name,
+        const std::function<void()>& stage) {
+    log_info("Running stage '{}'...", name);
+    const std::size_t initialRSS = getCurrentRSS();
+    const long long initialAllocations = numAllocations.load();
+    Stopwatch watch;
+    stage();
+    StageResult result;
+    result.name = name;
+    result.seconds = watch.getElapsedTime();
+    result.allocations = numAllocations.load() - initialAllocations;
+    result.currentRSS = getCurrentRSS();
+    result.peakRSS = getPeakRSS();
+    result.currentRSSGrowth =
+            (long long)result.currentRSS - (long long)initialRSS;
+    return result;
+}
+
+Model createModel() {
+    ModelProcessor processor = ModelProcessor(modelFile) |
+                               ModOpAddExternalLoads(externalLoadsFile);
+    return processor.process();
+}
+
+// The coordinate values (in radians) within [initialTime, finalTime].
+TimeSeriesTable loadCoordinates(const Model& model) {
+    TimeSeriesTable table =
+            (TableProcessor(coordinatesFile) | TabOpConvertDegreesToRadians())
+                    .process(&model);
+    table.trim(initialTime, finalTime);
+    return table;
+}
+
+void setCoordinates(const Model& model, const TimeSeriesTable& coordinates,
+        int row, SimTK::State& state) {
+    const auto& labels = coordinates.getColumnLabels();
+    const auto values = coordinates.getRowAtIndex(row);
+    state.setTime(coordinates.getIndependentColumn()[row]);
+    for (int i = 0; i < (int)labels.size(); ++i) {
+        if (!model.getCoordinateSet().contains(labels[i])) continue;
+        model.getCoordinateSet().get(labels[i]).setValue(
+                state, values[i], false);
+    }
+}
+
+// Markers at three offsets on every body, and their trajectories.
+TimeSeriesTable_<SimTK::Vec3> addMarkersAndSynthesizeData(
+        Model& model, const TimeSeriesTable& coordinates) {
+    for (const auto& body : model.getComponentList<Body>()) {
+        int i = 0;
+        for (const auto& offset : {SimTK::Vec3(0.1, 0, 0),
+                     SimTK::Vec3(0, 0.1, 0), SimTK::Vec3(0, 0, 0.1)}) {
+            model.addMarker(new Marker(
+                    body.getName() + "_marker" + std::to_string(i++), body,
+                    offset));
+        }
+    }
+    SimTK::State state = model.initSystem();
+
+    std::vector<std::string> labels;
+    for (const auto& marker : model.getComponentList<Marker>()) {
+        labels.push_back(marker.getName());
+    }
+    TimeSeriesTable_<SimTK::Vec3> markerData;
+    markerData.setColumnLabels(labels);
+    for (int row = 0; row < (int)coordinates.getNumRows(); ++row) {
+        setCoordinates(model, coordinates, row, state);
+        model.realizePosition(state);
+        SimTK::RowVector_<SimTK::Vec3> locations((int)labels.size());
+        int i = 0;
+        for (const auto& marker : model.getComponentList<Marker>()) {
+            locations[i++] = marker.getLocationInGround(state);
+        }
+        markerData.appendRow(state.getTime(), locations);
+    }
+    markerData.addTableMetaData<std::string>("Units", "m");
+    return markerData;
+}
+
+std::string formatBytes(std::size_t bytes) {
+    return fmt::format("{:.1f} MB", (double)bytes / (1024.0 * 1024.0));
+}
+
+void writeReport(const std::vector<StageResult>& results,
+        const std::string& fileName) {
+    log_info("{:<28} {:>10} {:>14} {:>12} {:>12} {:>12}", "stage", "time",
+            "allocations", "RSS", "peak RSS", "RSS growth");
+    for (const auto& result : results) {
+        log_info("{:<28} {:8.3f} s {:>14} {:>12} {:>12} {:>9.1f} MB",
+                result.name, result.seconds, result.allocations,
+                formatBytes(result.currentRSS), formatBytes(result.peakRSS),
+                (double)result.currentRSSGrowth / (1024.0 * 1024.0));
+    }
+
+    std::ofstream json(fileName);
+    json << "{\n  \"stages\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        json << "    {\n"
+             << "      \"name\": \"" << result.name << "\",\n"
+             << "      \"seconds\": " << result.seconds << ",\n"
+             << "      \"allocations\": " << result.allocations << ",\n"
+             << "      \"current_rss_bytes\": " << result.currentRSS << ",\n"
+             << "      \"peak_rss_bytes\": " << result.peakRSS << ",\n"
+             << "      \"current_rss_growth_bytes\": "
+             << result.currentRSSGrowth << "\n"
+             << "    }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}" << std::endl;
+    log_info("Wrote '{}'.", fileName);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const std::string reportFile =
+                argc > 1 ? argv[1] : "pipeline_benchmark.json";
+        std::vector<StageResult> results;
+
+        std::unique_ptr<Model> loaded;
+        results.push_back(runStage("load model", [&]() {
+            loaded.reset(new Model(createModel()));
+            loaded->initSystem();
+        }));
+        Model& model = *loaded;
+
+        results.push_back(runStage("scale", [&]() {
+            SimTK::State& state = model.initSystem();
+            ScaleSet scaleSet;
+            for (const auto& body : model.getComponentList<Body>()) {
+                auto* scale = new Scale();
+                scale->setSegmentName(body.getName());
+                scale->setScaleFactors(SimTK::Vec3(1.0));
+                scale->setApply(true);
+                scaleSet.adoptAndAppend(scale);
+            }
+            OPENSIM_THROW_IF(!model.scale(state, scaleSet, true), Exception,
+                    "Scaling failed.");
+        }));
+
+        const TimeSeriesTable recorded = loadCoordinates(model);
+        Model ikModel(model);
+        const TimeSeriesTable_<SimTK::Vec3> markerData =
+                addMarkersAndSynthesizeData(ikModel, recorded);
+
+        TimeSeriesTable ikCoordinates;
+        results.push_back(runStage("inverse kinematics", [&]() {
+            SimTK::State state = ikModel.initSystem();
+            auto markersRef = std::make_shared<MarkersReference>(
+                    markerData, Set<MarkerWeight>());
+            markersRef->setDefaultWeight(1.0);
+            SimTK::Array_<CoordinateReference> coordinateRefs;
+            InverseKinematicsSolver ikSolver(
+                    ikModel, markersRef, coordinateRefs);
+            ikSolver.setAccuracy(1e-5);
+
+            const auto& coordinates = ikModel.getCoordinateSet();
+            std::vector<std::string> labels;
+            for (int i = 0; i < coordinates.getSize(); ++i) {
+                labels.push_back(coordinates[i].getName());
+            }
+            ikCoordinates = TimeSeriesTable();
+            ikCoordinates.setColumnLabels(labels);
+            const auto& times = markerData.getIndependentColumn();
+            for (int row = 0; row < (int)times.size(); ++row) {
+                state.setTime(times[row]);
+                if (row == 0) {
+                    setCoordinates(ikModel, recorded, 0, state);
+                    ikSolver.assemble(state);
+                } else {
+                    ikSolver.track(state);
+                }
+                SimTK::RowVector values(coordinates.getSize());
+                for (int i = 0; i < coordinates.getSize(); ++i) {
+                    values[i] = coordinates[i].getValue(state);
+                }
+                ikCoordinates.appendRow(times[row], values);
+            }
+            ikCoordinates.addTableMetaData<std::string>("inDegrees", "no");
+            STOFileAdapter::write(ikCoordinates, ikFile);
+        }));
+
+        results.push_back(runStage("inverse dynamics", [&]() {
+            SimTK::State state = model.initSystem();
+            InverseDynamicsSolver idSolver(model);
+            const TimeSeriesTable forces = idSolver.solve(state, ikCoordinates);
+            OPENSIM_THROW_IF(forces.getNumRows() != ikCoordinates.getNumRows(),
+                    Exception, "Inverse dynamics did not solve every frame.");
+        }));
+
+        results.push_back(runStage("static optimization", [&]() {
+            Model soModel(model);
+            soModel.initSystem();
+            auto* so = new StaticOptimization(&soModel);
+            soModel.addAnalysis(so);
+            AnalyzeTool tool(soModel);
+            tool.setName("pipelineBenchmark");
+            tool.setLoadModelAndInput(true);
+            tool.setCoordinatesFileName(ikFile);
+            tool.setLowpassCutoffFrequency(6);
+            tool.setInitialTime(initialTime);
+            tool.setFinalTime(finalTime);
+            tool.setPrintResultFiles(false);
+            OPENSIM_THROW_IF(!tool.run(), Exception,
+                    "Static optimization failed.");
+        }));
+
+#ifdef OPENSIM_WITH_CASADI
+        results.push_back(runStage("MocoInverse", [&]() {
+            MocoInverse inverse;
+            inverse.setModel(ModelProcessor(modelFile) |
+                             ModOpReplaceJointsWithWelds({"subtalar_r",
+                                     "subtalar_l", "mtp_r", "mtp_l"}) |
+                             ModOpReplaceMusclesWithDeGrooteFregly2016() |
+                             ModOpIgnorePassiveFiberForcesDGF() |
+                             ModOpAddExternalLoads(externalLoadsFile));
+            inverse.setKinematics(
+                    TableProcessor(ikFile) | TabOpLowPassFilter(6));
+            inverse.set_initial_time(initialTime);
+            inverse.set_final_time(finalTime);
+            inverse.set_kinematics_allow_extra_columns(true);
+            inverse.set_mesh_interval(0.05);
+            inverse.set_constraint_tolerance(1e-4);
+            inverse.set_convergence_tolerance(1e-4);
+            inverse.solve();
+        }));
+#endif
+
+        writeReport(results, reportFile);
+    } catch (const std::exception& e) {
+        log_error(e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include "FileAdapter.h"
 #include "TimeSeriesTable.h"
 #include "APDMDataReader.h"
+#include "CommonUtilities.h"
+
+#include <algorithm>
 
 namespace OpenSim {
 
@@ -26,6 +29,70 @@ APDMDataReader* APDMDataReader::clone() const {
     return new APDMDataReader{*this};
 }
 
+struct APDMDataReader::FileLayout {
+    std::vector<std::string> labels; // will be written to output tables
+    double dataRate = SimTK::NaN;
+    std::vector<int> accIndex;
+    std::vector<int> gyroIndex;
+    std::vector<int> magIndex;
+    std::vector<int> orientationsIndex;
+};
+
+class APDMDataReader::Stream : public IMUDataStream {
+public:
+    Stream(const APDMDataReader& reader, const std::string& fileName)
+            : _in_stream(fileName) {
+        OPENSIM_THROW_IF(!_in_stream.good(),
+            FileDoesNotExist,
+            fileName);
+        OPENSIM_THROW_IF(_in_stream.peek() == std::ifstream::traits_type::eof(),
+            FileIsEmpty,
+            fileName);
+        reader.readHeader(_in_stream, fileName, _layout);
+        _labels = _layout.labels;
+        _dataRate = _layout.dataRate;
+        _hasLinearAccelerations = !_layout.accIndex.empty();
+        _hasMagneticHeading = !_layout.magIndex.empty();
+        _hasAngularVelocity = !_layout.gyroIndex.empty();
+    }
+
+    bool readNextFrame(IMUDataFrame& frame) override {
+        std::vector<std::string> nextRow =
+                FileAdapter::getNextLine(_in_stream, ",");
+        if (nextRow.empty()) return false;
+        const int n_imus = (int)_labels.size();
+        frame.orientations.resize(n_imus);
+        frame.linearAccelerations.resize(n_imus);
+        frame.magneticHeading.resize(n_imus);
+        frame.angularVelocity.resize(n_imus);
+        for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+            frame.linearAccelerations[imu_index] = SimTK::Vec3(SimTK::NaN);
+            frame.magneticHeading[imu_index] = SimTK::Vec3(SimTK::NaN);
+            frame.angularVelocity[imu_index] = SimTK::Vec3(SimTK::NaN);
+            parseRow(nextRow, _layout, imu_index,
+                    frame.orientations[imu_index],
+                    frame.linearAccelerations[imu_index],
+                    frame.magneticHeading[imu_index],
+                    frame.angularVelocity[imu_index]);
+        }
+        frame.time = _time;
+        _time += 1 / _dataRate;
+        return true;
+    }
+
+private:
+    std::ifstream _in_stream;
+    FileLayout _layout;
+    double _time = 0.0;
+};
+
+std::unique_ptr<IMUDataStream>
+APDMDataReader::openStream(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+        EmptyFileName);
+    return std::unique_ptr<IMUDataStream>(new Stream(*this, fileName));
+}
+
 DataAdapter::OutputTables 
 APDMDataReader::extendRead(const std::string& fileName) const {
 
@@ -41,24 +108,84 @@ APDMDataReader::extendRead(const std::string& fileName) const {
         FileIsEmpty,
         fileName);
 
-    std::vector<std::string> labels; // will be written to output tables
-    
-    double dataRate = SimTK::NaN;
-    std::vector<int> accIndex;
-    std::vector<int>  gyroIndex;
-    std::vector<int>  magIndex;
-    std::vector<int>  orientationsIndex;
+    FileLayout layout;
+    readHeader(in_stream, fileName, layout);
+    const int n_imus = (int)layout.labels.size();
+    // internally keep track of what data was found in input files
+    bool foundLinearAccelerationData = layout.accIndex.size()>0;
+    bool foundMagneticHeadingData = layout.magIndex.size()>0;
+    bool foundAngularVelocityData = layout.gyroIndex.size()>0;
+
+    // Read the lines of data first (reading the file is serial), so that the
+    // matrices can be allocated once and the lines parsed concurrently.
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in_stream, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        // An empty line marks the end of the data.
+        if (line.empty()) break;
+        lines.push_back(std::move(line));
+    }
+    const int rowNumber = (int)lines.size();
+
+    // We could get some indication of time from file or generate time based on rate
+    // Here we use the latter mechanism.
+    std::vector<double> times(rowNumber);
+    double time = 0.0;
+    double timeIncrement = 1 / layout.dataRate;
+    for (int row = 0; row < rowNumber; ++row) {
+        times[row] = time;
+        time += timeIncrement;
+    }
+
+    // Tables could be empty if data is not present in file(s)
+    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ rowNumber, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{
+            foundLinearAccelerationData ? rowNumber : 0, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{
+            foundMagneticHeadingData ? rowNumber : 0, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> angularVelocityData{
+            foundAngularVelocityData ? rowNumber : 0, n_imus };
+
+    const int blockSize = 1024;
+    const int numBlocks = (rowNumber + blockSize - 1) / blockSize;
+    parallelFor(numBlocks, [&](int block) {
+        const int end = std::min(rowNumber, (block + 1) * blockSize);
+        SimTK::Vec3 acc, mag, gyro;
+        for (int row = block * blockSize; row < end; ++row) {
+            const std::vector<std::string> nextRow =
+                    FileAdapter::tokenize(lines[row], ",");
+            // Cycle through the imus collating values
+            for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+                parseRow(nextRow, layout, imu_index,
+                        rotationsData(row, imu_index), acc, mag, gyro);
+                if (foundLinearAccelerationData)
+                    linearAccelerationData(row, imu_index) = acc;
+                if (foundMagneticHeadingData)
+                    magneticHeadingData(row, imu_index) = mag;
+                if (foundAngularVelocityData)
+                    angularVelocityData(row, imu_index) = gyro;
+            }
+        }
+    });
+
+    // Now create the tables from matrices
+    // Create 4 tables for Rotations, LinearAccelerations, AngularVelocity, MagneticHeading
+    DataAdapter::OutputTables tables = createTablesFromMatrices(layout.dataRate,
+        layout.labels, times, rotationsData, linearAccelerationData,
+        magneticHeadingData, angularVelocityData);
+    return tables;
+}
+
+void APDMDataReader::readHeader(std::istream& in_stream,
+        const std::string& fileName, FileLayout& layout) const {
+    std::vector<std::string>& labels = layout.labels;
+    std::vector<int>& accIndex = layout.accIndex;
+    std::vector<int>& gyroIndex = layout.gyroIndex;
+    std::vector<int>& magIndex = layout.magIndex;
+    std::vector<int>& orientationsIndex = layout.orientationsIndex;
 
     int n_imus = _settings.getProperty_ExperimentalSensors().size();
-    int last_size = 1024;
-    // Will read data into pre-allocated Matrices in-memory rather than appendRow
-    // on the fly which copies the whole table on every call.
-    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> angularVelocityData{ last_size, n_imus };
-    std::vector<double> times;
-    times.resize(last_size);
     // We support two formats, they contain similar data but headers are different
     std::string line;
     // Line 1
@@ -67,7 +194,7 @@ APDMDataReader::extendRead(const std::string& fileName) const {
     bool newFormat = false;
     if (tokens[0] == "Format=7") {
         newFormat = true;
-        dataRate = 128; // Will fix after reading computing it from time column
+        layout.dataRate = 128; // Will fix after reading computing it from time column
         // Header Line 1:Format=7, [I1,,,$IMU1,,,,,,,,,,,]*
         // Header Line 2: Time,[Accelerometer,,,Gyroscope,,,Magnetometer,,,Barometer,Orientation,,,]*
         // Header Line 3: ,[X,Y,Z,X,Y,Z,X,Y,Z,,S,X,Y,Z]*
@@ -95,13 +222,11 @@ APDMDataReader::extendRead(const std::string& fileName) const {
         // Header Line 2: Sample Rate:, $Value, Hz,,,,,
         // Labels Line 3: Time {SensorName/Acceleration/X,SensorName/Acceleration/Y,SensorName/Acceleration/Z,....} repeated per sensor
         // Units Line 4: s,{m/s^2,m/s^2,m/s^2....} repeated 
-        int header_lines = 4;
-
         std::string trialName = tokens[1]; // May contain spaces
         // Line 2
         std::getline(in_stream, line);
         tokens = FileAdapter::tokenize(line, ",");
-        dataRate = std::stod(tokens[1]);
+        layout.dataRate = std::stod(tokens[1]);
         // Line 3, find columns for IMUs
         std::getline(in_stream, line);
         tokens = FileAdapter::tokenize(line, ",");
@@ -119,98 +244,36 @@ APDMDataReader::extendRead(const std::string& fileName) const {
             find_start_column(tokens, APDMDataReader::orientation_labels, sensorName, orientationsIndex);
         }
     }
-    // Will create a table to map 
-    // internally keep track of what data was found in input files
-    bool foundLinearAccelerationData = accIndex.size()>0;
-    bool foundMagneticHeadingData = magIndex.size()>0;
-    bool foundAngularVelocityData = gyroIndex.size()>0;
-
     // If no Orientation data is available we'll abort
     OPENSIM_THROW_IF((orientationsIndex.size() == 0),
         TableMissingHeader);
     // Line 4, Units unused
     std::getline(in_stream, line);
+}
 
-    // For all tables, will create row, stitch values from different sensors then append
-    bool done = false;
-    double time = 0.0;
-    double timeIncrement = 1 / dataRate;
-    int rowNumber = 0;
-    while (!done){
-        // Make vectors one per table
-        TimeSeriesTableQuaternion::RowVector
-            orientation_row_vector{ n_imus, SimTK::Quaternion() };
-        TimeSeriesTableVec3::RowVector
-            accel_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        TimeSeriesTableVec3::RowVector
-            magneto_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        TimeSeriesTableVec3::RowVector
-            gyro_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        std::vector<std::string> nextRow = FileAdapter::getNextLine(in_stream, ",");
-        if (nextRow.empty()) {
-            done = true;
-            break;
-        }
-        // Cycle through the imus collating values
-        for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
-            // parse gyro info from in_stream
-           if (foundLinearAccelerationData)
-                accel_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[accIndex[imu_index]]),
-                    std::stod(nextRow[accIndex[imu_index] + 1]), std::stod(nextRow[accIndex[imu_index] + 2]));
-            if (foundMagneticHeadingData)
-                magneto_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[magIndex[imu_index]]),
-                    std::stod(nextRow[magIndex[imu_index] + 1]), std::stod(nextRow[magIndex[imu_index] + 2]));
-            if (foundAngularVelocityData)
-                gyro_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[gyroIndex[imu_index]]),
-                    std::stod(nextRow[gyroIndex[imu_index] + 1]), std::stod(nextRow[gyroIndex[imu_index] + 2]));
-            // Create Quaternion from values in file, assume order in file W, X, Y, Z
-            orientation_row_vector[imu_index] = 
-                SimTK::Quaternion(std::stod(nextRow[orientationsIndex[imu_index]]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 1]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 2]),
-                    std::stod(nextRow[orientationsIndex[imu_index] + 3]));
-        }
-        // append to the tables
-        times[rowNumber] = time;
-        if (foundLinearAccelerationData) 
-            linearAccelerationData[rowNumber] =  accel_row_vector;
-        if (foundMagneticHeadingData) 
-            magneticHeadingData[rowNumber] = magneto_row_vector;
-        if (foundAngularVelocityData) 
-            angularVelocityData[rowNumber] = gyro_row_vector;
-        rotationsData[rowNumber] = orientation_row_vector;
-        // We could get some indication of time from file or generate time based on rate
-        // Here we use the latter mechanism.
-        time += timeIncrement;
-        rowNumber++;
-        if (std::remainder(rowNumber, last_size) == 0) {
-            // resize all Data/Matrices, double the size  while keeping data
-            int newSize = last_size*2;
-            times.resize(newSize);
-            // Repeat for Data matrices in use
-            if (foundLinearAccelerationData) linearAccelerationData.resizeKeep(newSize, n_imus);
-            if (foundMagneticHeadingData) magneticHeadingData.resizeKeep(newSize, n_imus);
-            if (foundAngularVelocityData) angularVelocityData.resizeKeep(newSize, n_imus);
-            rotationsData.resizeKeep(newSize, n_imus);
-            last_size = newSize;
-        }
-    }
-    // Trim Matrices in use to actual data and move into tables
-    times.resize(rowNumber);
-    // Repeat for Data matrices in use and create Tables from them or size 0 for empty
-    linearAccelerationData.resizeKeep(foundLinearAccelerationData? rowNumber : 0,
-        n_imus);
-    magneticHeadingData.resizeKeep(foundMagneticHeadingData? rowNumber : 0,
-            n_imus);
-    angularVelocityData.resizeKeep(foundAngularVelocityData? rowNumber :0,
-        n_imus);
-    rotationsData.resizeKeep(rowNumber, n_imus);
-    // Now create the tables from matrices
-    // Create 4 tables for Rotations, LinearAccelerations, AngularVelocity, MagneticHeading
-    // Tables could be empty if data is not present in file(s)
-    DataAdapter::OutputTables tables = createTablesFromMatrices(dataRate, labels, times,
-        rotationsData, linearAccelerationData, magneticHeadingData, angularVelocityData);
-    return tables;
+void APDMDataReader::parseRow(const std::vector<std::string>& nextRow,
+        const FileLayout& layout, int imu_index,
+        SimTK::Quaternion& orientation, SimTK::Vec3& linearAcceleration,
+        SimTK::Vec3& magneticHeading, SimTK::Vec3& angularVelocity) {
+    const std::vector<int>& accIndex = layout.accIndex;
+    const std::vector<int>& gyroIndex = layout.gyroIndex;
+    const std::vector<int>& magIndex = layout.magIndex;
+    const std::vector<int>& orientationsIndex = layout.orientationsIndex;
+    if (accIndex.size() > 0)
+        linearAcceleration = SimTK::Vec3(std::stod(nextRow[accIndex[imu_index]]),
+            std::stod(nextRow[accIndex[imu_index] + 1]), std::stod(nextRow[accIndex[imu_index] + 2]));
+    if (magIndex.size() > 0)
+        magneticHeading = SimTK::Vec3(std::stod(nextRow[magIndex[imu_index]]),
+            std::stod(nextRow[magIndex[imu_index] + 1]), std::stod(nextRow[magIndex[imu_index] + 2]));
+    if (gyroIndex.size() > 0)
+        angularVelocity = SimTK::Vec3(std::stod(nextRow[gyroIndex[imu_index]]),
+            std::stod(nextRow[gyroIndex[imu_index] + 1]), std::stod(nextRow[gyroIndex[imu_index] + 2]));
+    // Create Quaternion from values in file, assume order in file W, X, Y, Z
+    orientation = 
+        SimTK::Quaternion(std::stod(nextRow[orientationsIndex[imu_index]]),
+            std::stod(nextRow[orientationsIndex[imu_index] + 1]),
+            std::stod(nextRow[orientationsIndex[imu_index] + 2]),
+            std::stod(nextRow[orientationsIndex[imu_index] + 3]));
 }
 
 void APDMDataReader::find_start_column(std::vector<std::string> tokens,
@@ -90,7 +90,22 @@ protected:
     APDMDataReaderSettings& updSettings() {
         return _settings;
     }
+public:
+    /** Open a csv file for reading one frame at a time. */
+    std::unique_ptr<IMUDataStream> openStream(
+            const std::string& fileName) const override;
  private:
+    // Location of the data of each sensor in the columns of the file.
+    struct FileLayout;
+    class Stream;
+    // Read the header lines of the file, up to the first line of data.
+    void readHeader(std::istream& in_stream, const std::string& fileName,
+            FileLayout& layout) const;
+    // Parse the data of sensor imu_index from a line of the file.
+    static void parseRow(const std::vector<std::string>& tokens,
+            const FileLayout& layout, int imu_index,
+            SimTK::Quaternion& orientation, SimTK::Vec3& linearAcceleration,
+            SimTK::Vec3& magneticHeading, SimTK::Vec3& angularVelocity);
     /**
      * This data member encapsulates all the serializable settings for the Reader;
      */
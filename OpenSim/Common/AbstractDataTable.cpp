@@ -35,22 +35,22 @@ size_t AbstractDataTable::getNumColumns() const {
 
 void 
 AbstractDataTable::removeTableMetaDataKey(const std::string& key) {
-    _tableMetaData.removeValueForKey(key);
+    _tableMetaData.upd().removeValueForKey(key);
 }
 
 std::vector<std::string> 
 AbstractDataTable::getTableMetaDataKeys() const {
-    return _tableMetaData.getKeys();
+    return _tableMetaData.get().getKeys();
 }
 
 const AbstractDataTable::TableMetaData& 
 AbstractDataTable::getTableMetaData() const {
-    return _tableMetaData;
+    return _tableMetaData.get();
 }
 
 AbstractDataTable::TableMetaData& 
 AbstractDataTable::updTableMetaData() {
-    return _tableMetaData;
+    return _tableMetaData.updUnshared();
 }
 
 const AbstractDataTable::IndependentMetaData& 
@@ -67,7 +67,7 @@ AbstractDataTable::setIndependentMetaData(const IndependentMetaData&
 
 const AbstractDataTable::DependentsMetaData& 
 AbstractDataTable::getDependentsMetaData() const {
-    return _dependentsMetaData;
+    return _dependentsMetaData.get();
 }
 
 void 
@@ -79,12 +79,12 @@ AbstractDataTable::setDependentsMetaData(const DependentsMetaData&
 
 void
 AbstractDataTable::removeDependentsMetaDataForKey(const std::string& key) {
-    _dependentsMetaData.removeValueForKey(key);
+    _dependentsMetaData.upd().removeValueForKey(key);
 }
 
 bool
 AbstractDataTable::hasColumnLabels() const {
-    return _dependentsMetaData.hasKey("labels");
+    return _dependentsMetaData.get().hasKey("labels");
 }
 
 std::vector<std::string> 
@@ -93,7 +93,7 @@ AbstractDataTable::getColumnLabels() const {
                      NoColumnLabels);
 
     const auto& absArray = 
-        _dependentsMetaData.getValueArrayForKey("labels");
+        _dependentsMetaData.get().getValueArrayForKey("labels");
     std::vector<std::string> labels{};
     for(size_t i = 0; i < absArray.size(); ++i)
         labels.push_back(absArray[i].getValue<std::string>());
@@ -107,7 +107,7 @@ AbstractDataTable::getColumnLabel(const size_t columnIndex) const {
                      NoColumnLabels);
 
     const auto& labels = 
-        _dependentsMetaData.getValueArrayForKey("labels");
+        _dependentsMetaData.get().getValueArrayForKey("labels");
 
     OPENSIM_THROW_IF(columnIndex >= labels.size(),
                      ColumnIndexOutOfRange,
@@ -151,7 +151,7 @@ AbstractDataTable::getColumnIndex(const std::string& columnLabel) const {
                      NoColumnLabels);
 
     const auto& absArray = 
-        _dependentsMetaData.getValueArrayForKey("labels");
+        _dependentsMetaData.get().getValueArrayForKey("labels");
     for(size_t i = 0; i < absArray.size(); ++i)
         if(absArray[i].getValue<std::string>() == columnLabel)
             return i;
@@ -165,7 +165,7 @@ AbstractDataTable::hasColumn(const std::string& columnLabel) const {
                      NoColumnLabels);
 
     const auto& absArray = 
-        _dependentsMetaData.getValueArrayForKey("labels");
+        _dependentsMetaData.get().getValueArrayForKey("labels");
     for(size_t i = 0; i < absArray.size(); ++i)
         if(absArray[i].getValue<std::string>() == columnLabel)
             return true;
@@ -180,7 +180,8 @@ AbstractDataTable::hasColumn(const size_t columnIndex) const {
 
 void
 AbstractDataTable::appendColumnLabel(const std::string& columnLabel) {
-    auto& absArray = _dependentsMetaData.updValueArrayForKey("labels");
+    auto& absArray =
+            _dependentsMetaData.upd().updValueArrayForKey("labels");
     auto& labels = static_cast<ValueArray<std::string>&>(absArray);
     labels.upd().push_back(SimTK::Value<std::string>{columnLabel});
 
@@ -29,6 +29,7 @@ This file defines the AbstractDataTable class, which is used by OpenSim to
 provide an in-memory container for data access and manipulation.              */
 
 // Non-standard headers.
+#include "OpenSim/Common/CopyOnWrite.h"
 #include "OpenSim/Common/Exception.h"
 #include "OpenSim/Common/ValueArrayDictionary.h"
 
@@ -218,14 +219,14 @@ public:
     \throws KeyExists If the key provided already exists in table metadata.   */
     template<typename Value>
     void addTableMetaData(const std::string& key, const Value& value) {
-        OPENSIM_THROW_IF(!_tableMetaData.setValueForKey(key, value),
+        OPENSIM_THROW_IF(!_tableMetaData.upd().setValueForKey(key, value),
                          KeyExists,
                          key);
     }
 
     /** Whether or not table metadata for the given key exists.               */
     bool hasTableMetaDataKey(const std::string& key) const {
-        return _tableMetaData.hasKey(key);
+        return _tableMetaData.get().hasKey(key);
     }
 
     /** Get table metadata for a given key.
@@ -266,7 +267,7 @@ public:
     \throws KeyNotFound If the key provided is not found in table metadata.   */
     template<typename Value>
     Value getTableMetaData(const std::string& key) const {
-        const auto& absValue = _tableMetaData.getValueForKey(key);
+        const auto& absValue = _tableMetaData.get().getValueForKey(key);
         try {
             const auto& value = 
                 dynamic_cast<const SimTK::Value<Value>&>(absValue);
@@ -283,7 +284,7 @@ public:
 
     \throws KeyNotFound If the key provided is not found in table metadata.   */
     std::string getTableMetaDataAsString(const std::string& key) const {
-        return _tableMetaData.getValueAsString(key);
+        return _tableMetaData.get().getValueAsString(key);
     }
 
     /** Remove key-value pair associated with the given key from table 
@@ -383,17 +384,19 @@ public:
     template<typename InputIt>
     void setColumnLabels(InputIt first, InputIt last) {
         std::unique_ptr<AbstractValueArray> oldLabels;
-        if (_dependentsMetaData.hasKey("labels")) {
+        if (_dependentsMetaData.get().hasKey("labels")) {
             oldLabels.reset(
-                _dependentsMetaData.getValueArrayForKey("labels").clone());
+                _dependentsMetaData.get().getValueArrayForKey("labels")
+                        .clone());
         }
 
         ValueArray<std::string> labels{};
         for(auto it = first; it != last; ++it)
             labels.upd().push_back(SimTK::Value<std::string>(*it));
 
-        _dependentsMetaData.removeValueArrayForKey("labels");
-        _dependentsMetaData.setValueArrayForKey("labels", labels);
+        DependentsMetaData& dependentsMetaData = _dependentsMetaData.upd();
+        dependentsMetaData.removeValueArrayForKey("labels");
+        dependentsMetaData.setValueArrayForKey("labels", labels);
         try {
             validateDependentsMetaData();
         }
@@ -401,8 +404,8 @@ public:
             // undo any partial column label changes
             // and restore to previous column labels if there were any
             if (oldLabels) {
-                _dependentsMetaData.removeValueArrayForKey("labels");
-                _dependentsMetaData.setValueArrayForKey("labels", *oldLabels);
+                dependentsMetaData.removeValueArrayForKey("labels");
+                dependentsMetaData.setValueArrayForKey("labels", *oldLabels);
             }
             throw;
         }
@@ -483,8 +486,9 @@ protected:
     classes.                                                                  */
     virtual void validateDependentsMetaData() const  = 0;
 
-    TableMetaData       _tableMetaData;
-    DependentsMetaData  _dependentsMetaData;
+    // Shared between copies of the table until one of them is modified.
+    CopyOnWrite<TableMetaData>      _tableMetaData;
+    CopyOnWrite<DependentsMetaData> _dependentsMetaData;
     IndependentMetaData _independentMetaData;
 }; // AbstractDataTable
 
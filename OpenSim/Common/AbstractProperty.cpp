@@ -27,6 +27,17 @@
 #include "Object.h"
 
 #include <limits>
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+    // A function-local static, since properties are constructed during static
+    // initialization (when types are registered).
+    const std::string& emptyComment() {
+        static const std::string empty;
+        return empty;
+    }
+}
 
 using namespace OpenSim;
 using namespace SimTK;
@@ -53,7 +64,27 @@ AbstractProperty::AbstractProperty(const std::string& name,
 {
     setNull();
     _name       = name;
-    _comment    = comment;
+    setComment(comment);
+}
+
+//_____________________________________________________________________________
+/**
+ * Set the comment, reusing the storage of an identical comment if one has
+ * been set before.
+ */
+void AbstractProperty::setComment(const std::string& aComment)
+{
+    // The set is never destroyed, so that properties of static Objects can
+    // still be used while the program exits. Its elements are never erased,
+    // so the pointers remain valid.
+    if (aComment.empty()) {
+        _comment = &emptyComment();
+        return;
+    }
+    static std::mutex mutex;
+    static auto* comments = new std::unordered_set<std::string>();
+    std::lock_guard<std::mutex> lock(mutex);
+    _comment = &*comments->insert(aComment).first;
 }
 
 
@@ -64,7 +95,7 @@ AbstractProperty::AbstractProperty(const std::string& name,
 void AbstractProperty::setNull()
 {
     _name           = "";
-    _comment        = "";
+    _comment        = &emptyComment();
     _valueIsDefault = false;
     _minListSize    = 0;
     _maxListSize    = std::numeric_limits<int>::max();
@@ -153,7 +153,8 @@ public:
     bool equals(const AbstractProperty& other) const
     {   if (!isSamePropertyClass(other)) return false;       
         if (getName() != other.getName()) return false;
-        if (getComment() != other.getComment()) return false;
+        // Comments are stored once, so equal comments have the same address.
+        if (_comment != other._comment) return false;
         if (getMinListSize() != other.getMinListSize()) return false;
         if (getMaxListSize() != other.getMaxListSize()) return false;
 
@@ -261,7 +262,7 @@ public:
 
     /** %Set a user-friendly comment to be associated with property. This will
     be displayed in XML and in "help" output for %OpenSim Objects. **/
-    void setComment(const std::string& aComment){ _comment = aComment; }
+    void setComment(const std::string& aComment);
 
     /** %Set flag indicating whether the value of this property was simply
     taken from a default object and thus should not be written out when
@@ -271,7 +272,7 @@ public:
     /** Get the property name. **/
     const std::string& getName() const { return _name; }
     /** Get the comment associated with this property. **/
-    const std::string& getComment() const { return _comment; }
+    const std::string& getComment() const { return *_comment; }
     /** Get the flag indicating whether the current value is just the default
     value for this property (in which case it doesn't need to be written
     out). **/
@@ -399,7 +400,11 @@ private:
     void setNull();
 
     std::string _name;
-    std::string _comment;
+    // Comments come from the property declarations and are the same for all
+    // instances of a property, so each distinct comment is stored once (see
+    // setComment()). This saves an allocation for each property of each
+    // Object that is constructed or copied.
+    const std::string* _comment;
     bool        _valueIsDefault;    // current value is just the default
 
     int         _minListSize;       // minimum # values for property
@@ -25,6 +25,7 @@
 #include "TRCFileAdapter.h"
 #include "DelimFileAdapter.h"
 #include "STOFileAdapter.h"
+#include "BinaryFileAdapter.h"
 #include "CSVFileAdapter.h"
 
 #if defined (WITH_EZC3D) || defined (WITH_BTK)
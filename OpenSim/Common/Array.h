@@ -32,6 +32,7 @@
 #include <iostream>
 #include "Logger.h"
 #include <sstream>
+#include <utility>
 
 static const int Array_CAPMIN = 1;
 
@@ -127,6 +128,20 @@ Array(const Array<T> &aArray)
     setNull();
     *this = aArray;
 }
+#ifndef SWIG
+//_____________________________________________________________________________
+/**
+ * Move constructor. The elements of aArray are taken over without copying
+ * them, and aArray is left empty.
+ *
+ * @param aArray Array to be moved.
+ */
+Array(Array<T> &&aArray)
+{
+    setNull();
+    *this = std::move(aArray);
+}
+#endif
 
 private:
 //_____________________________________________________________________________
@@ -207,6 +222,32 @@ Array<T>& operator=(const Array<T> &aArray)
 
     return(*this);
 }
+//_____________________________________________________________________________
+/**
+ * Move a specified array into this array. The elements of aArray are taken
+ * over without copying them, and aArray is left empty (as if it had been
+ * default-constructed with its default value).
+ *
+ * @param aArray Array to be moved.
+ * @return Reference to this array.
+ */
+Array<T>& operator=(Array<T> &&aArray)
+{
+    if(this==&aArray) return(*this);
+
+    if(_array!=NULL) delete[] _array;
+    _size = aArray._size;
+    _capacity = aArray._capacity;
+    _capacityIncrement = aArray._capacityIncrement;
+    _defaultValue = aArray._defaultValue;
+    _array = aArray._array;
+
+    aArray._size = 0;
+    aArray._capacity = 0;
+    aArray._array = NULL;
+
+    return(*this);
+}
 
 //-----------------------------------------------------------------------------
 // EQUALITY (==)
@@ -347,9 +388,11 @@ bool ensureCapacity(int aCapacity)
         return(false);
     }
 
-    // COPY CURRENT ARRAY
+    // MOVE CURRENT ARRAY
+    // Moving avoids deep copies of elements that own memory (e.g., the rows
+    // of a Storage).
     if(_array!=NULL) {
-        for(i=0;i<_size;i++) newArray[i] = _array[i];
+        for(i=0;i<_size;i++) newArray[i] = std::move(_array[i]);
         for(i=_size;i<aCapacity;i++) newArray[i] = _defaultValue;
         delete []_array;  _array=NULL;
     } else {
@@ -30,6 +30,9 @@
 
 #include "osimCommonDLL.h"
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "Exception.h"
 #include "Logger.h"
 
@@ -80,6 +83,20 @@ protected:
     /** Array of pointers to objects of type T. */
     T **_array;
 
+private:
+    /** Arrays with at least this many elements are searched by name with
+    _nameIndex. */
+    static constexpr int _minSizeForNameIndex = 16;
+    /** Index of the first element with each name, for the elements
+    [0, _nameIndexSize). This is built and extended (to elements that have
+    been appended since) by getIndex(const std::string&), and discarded
+    whenever elements are inserted, removed, or replaced. */
+    mutable std::unique_ptr<std::unordered_map<std::string, int>> _nameIndex;
+    mutable int _nameIndexSize;
+    /** getIndex(const std::string&) is const, so it may be called from
+    several threads; this guards _nameIndex. */
+    mutable std::mutex _nameIndexMutex;
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // METHODS
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -149,6 +166,17 @@ void setNull()
     _capacityIncrement = -1;
     _capacity = 0;
     _array = NULL;
+    _nameIndexSize = 0;
+}
+//_____________________________________________________________________________
+/**
+ * Discard the index of the names.  This must be called whenever an element
+ * is removed, is replaced, or changes position.
+ */
+void clearNameIndex()
+{
+    _nameIndex.reset();
+    _nameIndexSize = 0;
 }
 
 public:
@@ -171,6 +199,7 @@ void clearAndDestroy()
     }
 
     _size = 0;
+    clearNameIndex();
 }
 
 
@@ -198,6 +227,7 @@ ArrayPtrs<T>& operator=(const ArrayPtrs<T> &aArray)
 {
     // DELETE OLD ARRAY
     if(_memoryOwner) clearAndDestroy();
+    clearNameIndex();
 
     // COPY MEMBER VARIABLES
     _size = aArray._size;
@@ -529,6 +559,7 @@ bool setSize(int aSize)
             }
         }
         _size = aSize;
+        clearNameIndex();
     }
 
     return(true);
@@ -594,6 +625,9 @@ int getIndex(const std::string &aName,int aStartIndex=0) const
 {
     if(aStartIndex<0) aStartIndex=0;
     if(aStartIndex>=getSize()) aStartIndex=0;
+    if(aStartIndex==0 && _size>=_minSizeForNameIndex) {
+        return getIndexFromNameIndex(aName);
+    }
 
     // SEARCH STARTING FROM aStartIndex
     int i;
@@ -609,6 +643,45 @@ int getIndex(const std::string &aName,int aStartIndex=0) const
     return(-1);
 }
 
+private:
+//_____________________________________________________________________________
+/**
+ * Look up a name in the index of the names, after extending the index to
+ * the elements appended since it was last used.  An element may have been
+ * renamed since it was indexed, so a name that is not found (or whose
+ * element now has a different name) is searched for linearly, and the
+ * index is discarded if that search succeeds.
+ */
+int getIndexFromNameIndex(const std::string &aName) const
+{
+    std::lock_guard<std::mutex> lock(_nameIndexMutex);
+    if(!_nameIndex) {
+        _nameIndex.reset(new std::unordered_map<std::string, int>());
+        _nameIndexSize = 0;
+    }
+    if(_nameIndexSize<_size) {
+        _nameIndex->reserve(_size);
+        for(int i=_nameIndexSize;i<_size;i++) {
+            // Keep the first element with a given name.
+            _nameIndex->emplace(_array[i]->getName(), i);
+        }
+        _nameIndexSize = _size;
+    }
+    const auto it = _nameIndex->find(aName);
+    if(it!=_nameIndex->end() && _array[it->second]->getName()==aName) {
+        return(it->second);
+    }
+    for(int i=0;i<_size;i++) {
+        if(_array[i]->getName() == aName) {
+            _nameIndex.reset();
+            _nameIndexSize = 0;
+            return(i);
+        }
+    }
+    return(-1);
+}
+
+public:
 //-----------------------------------------------------------------------------
 // APPEND
 //-----------------------------------------------------------------------------
@@ -719,6 +792,7 @@ bool insert(int aIndex,T *aObject)
     // SET
     _array[aIndex] = aObject;
     _size++;
+    clearNameIndex();
 
     return(true);
 }
@@ -759,6 +833,7 @@ bool remove(int aIndex)
         _array[i] = _array[i+1];
     }
     _array[_size] = NULL;
+    clearNameIndex();
 
     return(true);
 }
@@ -815,6 +890,7 @@ bool set(int aIndex,T *aObject)
     // SET
     if(getMemoryOwner() && (_array[aIndex]!=NULL)) delete _array[aIndex];
     _array[aIndex] = aObject;
+    clearNameIndex();
 
     return(true);
 }
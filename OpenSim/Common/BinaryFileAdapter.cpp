@@ -0,0 +1,228 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  BinaryFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BinaryFileAdapter.h"
+#include "STOFileAdapter.h"
+
+namespace OpenSim {
+
+namespace {
+    const char magic[8] = {'O', 'S', 'I', 'M', 'B', 'T', 'A', 'B'};
+    const std::uint32_t formatVersion = 1;
+    const std::uint32_t byteOrderMark = 0x01020304;
+
+    template <typename U>
+    void writeValue(std::ostream& stream, const U& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(U));
+    }
+
+    void writeString(std::ostream& stream, const std::string& str) {
+        writeValue(stream, static_cast<std::uint32_t>(str.size()));
+        stream.write(str.data(), str.size());
+    }
+
+    template <typename U>
+    U readValue(std::istream& stream, const std::string& fileName) {
+        U value;
+        stream.read(reinterpret_cast<char*>(&value), sizeof(U));
+        OPENSIM_THROW_IF(!stream, BinaryFileFormatError, fileName,
+                         "the header is truncated.");
+        return value;
+    }
+
+    std::string readString(std::istream& stream,
+                           const std::string& fileName) {
+        const auto size = readValue<std::uint32_t>(stream, fileName);
+        std::string str(size, '\0');
+        stream.read(&str[0], size);
+        OPENSIM_THROW_IF(!stream, BinaryFileFormatError, fileName,
+                         "the header is truncated.");
+        return str;
+    }
+}
+
+BinaryTableFileInfo
+BinaryTableFileInfo::read(const std::string& fileName) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    std::ifstream stream{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!stream.good(),
+                     FileDoesNotExist,
+                     fileName);
+
+    char fileMagic[sizeof(magic)];
+    stream.read(fileMagic, sizeof(magic));
+    OPENSIM_THROW_IF(!stream || std::memcmp(fileMagic, magic, sizeof(magic)),
+                     BinaryFileFormatError, fileName,
+                     "the file does not start with 'OSIMBTAB'.");
+    const auto version = readValue<std::uint32_t>(stream, fileName);
+    OPENSIM_THROW_IF(version > formatVersion, BinaryFileFormatError, fileName,
+                     "format version " + std::to_string(version) +
+                     " is newer than the supported version " +
+                     std::to_string(formatVersion) + ".");
+    OPENSIM_THROW_IF(
+            readValue<std::uint32_t>(stream, fileName) != byteOrderMark,
+            BinaryFileFormatError, fileName,
+            "the file was written on a machine with a different byte order.");
+
+    BinaryTableFileInfo info;
+    info.dataOffset = readValue<std::uint64_t>(stream, fileName);
+    info.numRows = readValue<std::uint64_t>(stream, fileName);
+    info.numColumns = readValue<std::uint64_t>(stream, fileName);
+    info.numComponents = readValue<std::uint32_t>(stream, fileName);
+    readValue<std::uint32_t>(stream, fileName); // reserved
+    info.dataType = readString(stream, fileName);
+
+    const auto numMetadata = readValue<std::uint32_t>(stream, fileName);
+    for (std::uint32_t i = 0; i < numMetadata; ++i) {
+        auto key = readString(stream, fileName);
+        auto value = readString(stream, fileName);
+        info.metadata.emplace_back(std::move(key), std::move(value));
+    }
+    info.columnLabels.reserve(info.numColumns);
+    for (std::uint64_t i = 0; i < info.numColumns; ++i)
+        info.columnLabels.push_back(readString(stream, fileName));
+
+    OPENSIM_THROW_IF(static_cast<std::uint64_t>(stream.tellg()) >
+                             info.dataOffset,
+                     BinaryFileFormatError, fileName,
+                     "the header overlaps the data.");
+    return info;
+}
+
+void BinaryTableFileInfo::write(std::ostream& stream) {
+    OPENSIM_THROW_IF(columnLabels.size() != numColumns, Exception,
+                     "Expected {} column labels but got {}.", numColumns,
+                     columnLabels.size());
+
+    stream.write(magic, sizeof(magic));
+    writeValue(stream, formatVersion);
+    writeValue(stream, byteOrderMark);
+
+    // The data offset is not known until the variable-length part of the
+    // header has been written, so compute it beforehand.
+    std::uint64_t headerSize = 48;
+    headerSize += sizeof(std::uint32_t) + dataType.size();
+    headerSize += sizeof(std::uint32_t);
+    for (const auto& keyValue : metadata) {
+        headerSize += 2 * sizeof(std::uint32_t) + keyValue.first.size() +
+                      keyValue.second.size();
+    }
+    for (const auto& label : columnLabels)
+        headerSize += sizeof(std::uint32_t) + label.size();
+    dataOffset = (headerSize + 7) / 8 * 8;
+
+    writeValue(stream, dataOffset);
+    writeValue(stream, numRows);
+    writeValue(stream, numColumns);
+    writeValue(stream, numComponents);
+    writeValue(stream, std::uint32_t(0)); // reserved
+    writeString(stream, dataType);
+    writeValue(stream, static_cast<std::uint32_t>(metadata.size()));
+    for (const auto& keyValue : metadata) {
+        writeString(stream, keyValue.first);
+        writeString(stream, keyValue.second);
+    }
+    for (const auto& label : columnLabels)
+        writeString(stream, label);
+    for (std::uint64_t i = headerSize; i < dataOffset; ++i)
+        stream.put('\0');
+}
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForReading(const std::string& fileName) {
+    using namespace SimTK;
+
+    const auto value = BinaryTableFileInfo::read(fileName).dataType;
+    if(value == "double")
+        return std::make_shared<BinaryFileAdapter_<double>>();
+    else if(value == "Vec2")
+        return std::make_shared<BinaryFileAdapter_<Vec2>>();
+    else if(value == "Vec3")
+        return std::make_shared<BinaryFileAdapter_<Vec3>>();
+    else if(value == "Vec4")
+        return std::make_shared<BinaryFileAdapter_<Vec4>>();
+    else if(value == "Vec5")
+        return std::make_shared<BinaryFileAdapter_<Vec5>>();
+    else if(value == "Vec6")
+        return std::make_shared<BinaryFileAdapter_<Vec6>>();
+    else if(value == "Vec7")
+        return std::make_shared<BinaryFileAdapter_<Vec7>>();
+    else if(value == "Vec8")
+        return std::make_shared<BinaryFileAdapter_<Vec8>>();
+    else if(value == "Vec9")
+        return std::make_shared<BinaryFileAdapter_<Vec9>>();
+    else if(value == "Vec10")
+        return std::make_shared<BinaryFileAdapter_<Vec<10>>>();
+    else if(value == "Vec11")
+        return std::make_shared<BinaryFileAdapter_<Vec<11>>>();
+    else if(value == "Vec12")
+        return std::make_shared<BinaryFileAdapter_<Vec<12>>>();
+    else if(value == "UnitVec3")
+        return std::make_shared<BinaryFileAdapter_<UnitVec3>>();
+    else if(value == "Quaternion")
+        return std::make_shared<BinaryFileAdapter_<Quaternion>>();
+    else if(value == "SpatialVec")
+        return std::make_shared<BinaryFileAdapter_<SpatialVec>>();
+
+    OPENSIM_THROW(STODataTypeNotSupported,
+                  value);
+}
+
+template <typename T>
+std::shared_ptr<BinaryFileAdapter_<T>>
+makeBinaryAdapter(const AbstractDataTable* absTable) {
+    if (dynamic_cast<const TimeSeriesTable_<T>*>(absTable)) {
+        return std::make_shared<BinaryFileAdapter_<T>>();
+    }
+    return {};
+}
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForWriting(const DataAdapter::InputTables& absTables) {
+    using namespace SimTK;
+
+    auto* absTable = absTables.at("table");
+
+    // Try derived class before base class.
+    if (auto adapter = makeBinaryAdapter<UnitVec3>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Quaternion>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<SpatialVec>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<double>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec2>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec3>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec4>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec5>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec6>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec7>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec8>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec9>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec<10>>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec<11>>(absTable)) return adapter;
+    if (auto adapter = makeBinaryAdapter<Vec<12>>(absTable)) return adapter;
+
+    OPENSIM_THROW(STODataTypeNotSupported,
+                  "<unknown>");
+}
+
+} // namespace OpenSim
@@ -0,0 +1,345 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  BinaryFileAdapter.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_BINARY_FILE_ADAPTER_H_
+#define OPENSIM_BINARY_FILE_ADAPTER_H_
+
+#include "DelimFileAdapter.h"
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace OpenSim {
+
+class BinaryFileFormatError : public IOError {
+public:
+    BinaryFileFormatError(const std::string& file,
+                          size_t line,
+                          const std::string& func,
+                          const std::string& filename,
+                          const std::string& reason) :
+        IOError(file, line, func) {
+        std::string msg = "File '" + filename + "' is not a valid binary "
+                          "table file: " + reason;
+
+        addMessage(msg);
+    }
+};
+
+/** The header of a binary table file, which describes the table without
+containing any of its data. The layout of the file is:
+\code
+offset  size  contents
+0       8     magic string "OSIMBTAB"
+8       4     format version (uint32)
+12      4     byte-order mark 0x01020304 (uint32)
+16      8     offset of the data, in bytes from the start of the file (uint64)
+24      8     number of rows (uint64)
+32      8     number of columns (uint64)
+40      4     number of scalars in each element, e.g., 3 for Vec3 (uint32)
+44      4     reserved (uint32)
+48      ...   data type name (e.g., "Vec3"), the table metadata as key-value
+              pairs, and the column labels; each string is stored as its
+              length (uint32) followed by its characters.
+data    ...   the time column, followed by each of the columns. A column
+              holds numRows elements, each of which is numComponents doubles.
+\endcode
+The data offset is a multiple of 8 bytes. Integers and doubles are stored with
+the byte order of the machine that wrote the file; reading a file written with
+a different byte order throws an exception.                                   */
+struct OSIMCOMMON_API BinaryTableFileInfo {
+    std::string dataType;
+    std::uint32_t numComponents = 0;
+    std::uint64_t numRows = 0;
+    std::uint64_t numColumns = 0;
+    std::uint64_t dataOffset = 0;
+    std::vector<std::string> columnLabels;
+    /** Table metadata; only metadata with string values is stored. */
+    std::vector<std::pair<std::string, std::string>> metadata;
+
+    /** Read the header of the given file. */
+    static BinaryTableFileInfo read(const std::string& fileName);
+    /** Write the header, compute dataOffset, and pad the stream up to
+    dataOffset. */
+    void write(std::ostream& stream);
+
+    /** Offset (in bytes from the start of the file) of the time column. */
+    std::uint64_t getTimeOffset() const { return dataOffset; }
+    /** Offset (in bytes from the start of the file) of the given column. */
+    std::uint64_t getColumnOffset(std::uint64_t column) const {
+        return dataOffset + sizeof(double) * numRows *
+                                    (1 + column * numComponents);
+    }
+    /** The size of the file described by this header, in bytes. */
+    std::uint64_t getFileSize() const { return getColumnOffset(numColumns); }
+};
+
+/** BinaryFileAdapter_ reads and writes TimeSeriesTable_%s in a compact binary
+columnar format (extension `.bsto`; see BinaryTableFileInfo for the layout).
+Numbers are stored with full precision and without any parsing, so reading and
+writing are much faster than for STO files, and each column is stored
+contiguously, so a subset of the columns can be read without touching the
+rest of the file (see readColumns()). By default, files are read by mapping
+them into memory (see MemoryMappedFile).
+
+The element types that are supported are the same as those of
+STOFileAdapter_ (double, Vec2 to Vec12, UnitVec3, Quaternion and SpatialVec).
+As with STO files, the table metadata with string values (including the
+"header") and the column labels are stored.
+
+@code
+TimeSeriesTable states("states.sto");
+STOFileAdapter::write(states, "states.sto");     // text
+BinaryFileAdapter::write(states, "states.bsto"); // binary
+TimeSeriesTable fromBinary("states.bsto");
+auto hip = BinaryFileAdapter::readColumns("states.bsto",
+        {"/jointset/hip_r/hip_flexion_r/value"});
+@endcode                                                                      */
+template<typename T>
+class BinaryFileAdapter_ : public FileAdapter {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Elements must consist of doubles.");
+public:
+    BinaryFileAdapter_()                                     = default;
+    BinaryFileAdapter_(const BinaryFileAdapter_&)            = default;
+    BinaryFileAdapter_(BinaryFileAdapter_&&)                 = default;
+    BinaryFileAdapter_& operator=(const BinaryFileAdapter_&) = default;
+    BinaryFileAdapter_& operator=(BinaryFileAdapter_&&)      = default;
+    ~BinaryFileAdapter_()                                    = default;
+
+    BinaryFileAdapter_* clone() const override;
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string tableString() { return "table"; }
+    /** The number of doubles in each element of type T. */
+    static constexpr unsigned numComponents() {
+        return sizeof(T) / sizeof(double);
+    }
+
+    /** Read the file with memory mapping (default: true). If false, the file
+    is read with file streams.                                                */
+    void setUseMemoryMapping(bool tf) { _useMemoryMapping = tf; }
+    bool getUseMemoryMapping() const { return _useMemoryMapping; }
+
+    /** Write a binary table file.                                            */
+    static
+    void write(const TimeSeriesTable_<T>& table, const std::string& fileName);
+
+    /** Read only the columns with the given labels (in the given order), 
+    without reading the rest of the data in the file. If `columnLabels` is 
+    empty, all columns are read.
+    @throws KeyMissing if a column label is not in the file.                  */
+    TimeSeriesTable_<T> readColumns(const std::string& fileName,
+            const std::vector<std::string>& columnLabels) const;
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    bool _useMemoryMapping = true;
+};
+
+template<typename T>
+BinaryFileAdapter_<T>*
+BinaryFileAdapter_<T>::clone() const {
+    return new BinaryFileAdapter_{*this};
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::write(const TimeSeriesTable_<T>& table,
+                             const std::string& fileName) {
+    DataAdapter::InputTables tables{};
+    tables.emplace(tableString(), &table);
+    BinaryFileAdapter_{}.extendWrite(tables, fileName);
+}
+
+template<typename T>
+typename BinaryFileAdapter_<T>::OutputTables
+BinaryFileAdapter_<T>::extendRead(const std::string& fileName) const {
+    auto table = std::make_shared<TimeSeriesTable_<T>>(
+            readColumns(fileName, {}));
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+    return output_tables;
+}
+
+template<typename T>
+TimeSeriesTable_<T>
+BinaryFileAdapter_<T>::readColumns(const std::string& fileName,
+        const std::vector<std::string>& columnLabels) const {
+    const auto info = BinaryTableFileInfo::read(fileName);
+    const auto dataTypeName = DelimFileAdapter<T>::dataTypeName();
+    OPENSIM_THROW_IF(info.dataType != dataTypeName ||
+                     info.numComponents != numComponents(),
+                     DataTypeMismatch,
+                     dataTypeName,
+                     info.dataType);
+
+    std::vector<std::uint64_t> columns;
+    std::vector<std::string> labels;
+    if (columnLabels.empty()) {
+        for (std::uint64_t col = 0; col < info.numColumns; ++col)
+            columns.push_back(col);
+        labels = info.columnLabels;
+    } else {
+        for (const auto& label : columnLabels) {
+            const auto it = std::find(info.columnLabels.begin(),
+                                      info.columnLabels.end(), label);
+            OPENSIM_THROW_IF(it == info.columnLabels.end(),
+                             KeyMissing,
+                             label);
+            columns.push_back(it - info.columnLabels.begin());
+        }
+        labels = columnLabels;
+    }
+
+    const int nrow = static_cast<int>(info.numRows);
+    const int ncol = static_cast<int>(columns.size());
+    std::vector<double> time(nrow);
+    SimTK::Matrix_<T> matrix(nrow, ncol);
+
+    // The elements of a column are contiguous in the file, but the matrix
+    // may not store them contiguously, so a column is copied element by
+    // element.
+    std::unique_ptr<MemoryMappedFile> mapped;
+    std::ifstream stream;
+    std::vector<char> buffer;
+    if (_useMemoryMapping) {
+        mapped.reset(new MemoryMappedFile(fileName));
+    } else {
+        stream.open(fileName, std::ios::binary);
+        OPENSIM_THROW_IF(!stream.good(), FileDoesNotExist, fileName);
+    }
+    const std::uint64_t fileSize = _useMemoryMapping
+            ? mapped->getSize() : info.getFileSize();
+    OPENSIM_THROW_IF(fileSize < info.getFileSize(),
+                     BinaryFileFormatError,
+                     fileName,
+                     "the file is truncated.");
+    auto readBlock = [&](std::uint64_t offset, std::size_t size) {
+        if (mapped) return mapped->getData() + offset;
+        buffer.resize(size);
+        stream.seekg(static_cast<std::streamoff>(offset));
+        stream.read(buffer.data(), static_cast<std::streamsize>(size));
+        OPENSIM_THROW_IF(!stream, BinaryFileFormatError,
+                         fileName,
+                         "the file is truncated.");
+        return static_cast<const char*>(buffer.data());
+    };
+
+    if (nrow > 0) {
+        const char* block = readBlock(info.getTimeOffset(),
+                                      nrow * sizeof(double));
+        std::memcpy(time.data(), block, nrow * sizeof(double));
+    }
+    for (int j = 0; j < ncol; ++j) {
+        if (nrow == 0) break;
+        const char* block = readBlock(info.getColumnOffset(columns[j]),
+                                      nrow * sizeof(T));
+        for (int i = 0; i < nrow; ++i)
+            std::memcpy(&matrix(i, j), block + i * sizeof(T), sizeof(T));
+    }
+
+    TimeSeriesTable_<T> table(time, matrix, labels);
+    for (const auto& keyValue : info.metadata)
+        table.updTableMetaData().setValueForKey(
+                keyValue.first, keyValue.second);
+    return table;
+}
+
+template<typename T>
+void
+BinaryFileAdapter_<T>::extendWrite(const InputTables& absTables,
+                                   const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(),
+                     NoTableFound);
+
+    const TimeSeriesTable_<T>* table{};
+    try {
+        auto abs_table = absTables.at(tableString());
+        table = dynamic_cast<const TimeSeriesTable_<T>*>(abs_table);
+    } catch(std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing,
+                      tableString());
+    }
+    OPENSIM_THROW_IF(table == nullptr,
+                     IncorrectTableType);
+
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    BinaryTableFileInfo info;
+    info.dataType = DelimFileAdapter<T>::dataTypeName();
+    info.numComponents = numComponents();
+    info.numRows = table->getNumRows();
+    info.numColumns = table->getNumColumns();
+    info.columnLabels = table->getColumnLabels();
+    for (const auto& key : table->getTableMetaDataKeys()) {
+        try {
+            info.metadata.emplace_back(key,
+                    table->template getTableMetaData<std::string>(key));
+        } catch(const InvalidTemplateArgument&) {}
+    }
+
+    std::ofstream out_stream{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!out_stream.good(), IOError,
+                     "Could not open file '{}' for writing.", fileName);
+    info.write(out_stream);
+
+    const auto& times = table->getIndependentColumn();
+    out_stream.write(reinterpret_cast<const char*>(times.data()),
+                     times.size() * sizeof(double));
+
+    const auto& matrix = table->getMatrix();
+    std::vector<T> column(info.numRows);
+    for (int j = 0; j < matrix.ncol(); ++j) {
+        for (int i = 0; i < matrix.nrow(); ++i)
+            column[i] = matrix(i, j);
+        out_stream.write(reinterpret_cast<const char*>(column.data()),
+                         column.size() * sizeof(T));
+    }
+    OPENSIM_THROW_IF(!out_stream, IOError,
+                     "Could not write to file '{}'.", fileName);
+}
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForReading(const std::string& fileName);
+
+std::shared_ptr<DataAdapter>
+createBinaryFileAdapterForWriting(const DataAdapter::InputTables& tables);
+
+typedef BinaryFileAdapter_<double> BinaryFileAdapter;
+typedef BinaryFileAdapter_<SimTK::Vec3> BinaryFileAdapterVec3;
+typedef BinaryFileAdapter_<SimTK::Quaternion> BinaryFileAdapterQuaternion;
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BINARY_FILE_ADAPTER_H_
@@ -9,6 +9,8 @@
 #include "btkGroundReactionWrenchFilter.h"
 #endif
 
+#include <algorithm>
+
 namespace {
 
 #ifdef WITH_EZC3D
@@ -129,34 +131,36 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         int marker_ncol = numMarkers;
 
         std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
+        // Missing markers are NaN; the points are written straight into the
+        // matrix rather than through a temporary row.
+        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol,
+                                                  SimTK::Vec3(SimTK::NaN));
 
         std::vector<std::string> marker_labels{};
-        for (auto label : c3d.parameters().group("POINT")
+        for (const auto& label : c3d.parameters().group("POINT")
                 .parameter("LABELS").valuesAsString()) {
             marker_labels.push_back(SimTK::Value<std::string>(label));
         }
 
         double time_step{1.0 / pointFrequency};
         for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
             // values as blank, instead of 0,  when exporting to .trc
             // See: C3D documention 3D Point Residuals
             // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
+            const auto& points = c3d.data().frame(f).points().points();
+            const int numPoints = std::min(numMarkers,
+                                           static_cast<int>(points.size()));
+            for(int m = 0; m < numPoints; ++m) {
+                const auto& pt = points[m];
                 if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+                    marker_matrix(f, m) = SimTK::Vec3{
+                            static_cast<double>(pt.x()),
+                            static_cast<double>(pt.y()),
+                            static_cast<double>(pt.z()) };
                 }
-                ++m;
             }
-
-            marker_matrix.updRow(f) = row;
             marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
@@ -261,40 +265,43 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
         double time_step{1.0 / analogFrequency};
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3>
-                    row{numPlatform * 3};
-            int col{0};
-            for (size_t i = 0; i < (size_t)numPlatform; ++i){
-                row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
-                                       pf_ref[i].forces()[f](1),
-                                       pf_ref[i].forces()[f](2)};
-                ++col;
-                if (forceLocation == ForceLocation::CenterOfPressure){
-                    row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
-                                           pf_ref[i].CoP()[f](1),
-                                           pf_ref[i].CoP()[f](2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
-                                           pf_ref[i].Tz()[f](1),
-                                           pf_ref[i].Tz()[f](2)};
-                    ++col;
-                } else if (forceLocation == ForceLocation::OriginOfForcePlate){
-                    row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
-                                           pf_ref[i].meanCorners()(1),
-                                           pf_ref[i].meanCorners()(2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
-                                           pf_ref[i].moments()[f](1),
-                                           pf_ref[i].moments()[f](2)};
-                    ++col;
-                } else {
-                    OPENSIM_THROW(Exception,
-                                  "The selected force location is not "
-                                  "implemented for ezc3d files");
+        OPENSIM_THROW_IF(nf > 0 &&
+                         forceLocation != ForceLocation::CenterOfPressure &&
+                         forceLocation != ForceLocation::OriginOfForcePlate,
+                         Exception,
+                         "The selected force location is not "
+                         "implemented for ezc3d files");
+
+        const auto toVec3 = [](const ezc3d::Vector3d& v) {
+            return SimTK::Vec3{v(0), v(1), v(2)};
+        };
+        // The matrix is stored column by column, so fill one column (i.e.,
+        // one quantity of one platform) over all frames at a time; the
+        // platform's data and the force location are looked up once per
+        // column instead of once per frame.
+        for (int i = 0; i < numPlatform; ++i){
+            const auto& platform = pf_ref[i];
+            auto forceCol = force_matrix.updCol(3 * i);
+            auto pointCol = force_matrix.updCol(3 * i + 1);
+            auto momentCol = force_matrix.updCol(3 * i + 2);
+
+            const auto& forces = platform.forces();
+            for (int f = 0; f < nf; ++f) forceCol[f] = toVec3(forces[f]);
+
+            if (forceLocation == ForceLocation::CenterOfPressure){
+                const auto& cop = platform.CoP();
+                const auto& tz = platform.Tz();
+                for (int f = 0; f < nf; ++f) {
+                    pointCol[f] = toVec3(cop[f]);
+                    momentCol[f] = toVec3(tz[f]);
                 }
+            } else {
+                pointCol = toVec3(platform.meanCorners());
+                const auto& moments = platform.moments();
+                for (int f = 0; f < nf; ++f) momentCol[f] = toVec3(moments[f]);
             }
-            force_matrix.updRow(f) = row;
+        }
+        for (int f = 0; f < nf; ++f) {
             force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
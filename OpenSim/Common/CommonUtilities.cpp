@@ -27,13 +27,36 @@
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <memory>
 #include <sstream>
 
 #include <SimTKcommon/internal/Pathname.h>
 
+std::string OpenSim::createFNV1aHash(const std::string& text) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+std::string OpenSim::createFNV1aHashOfFile(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) return "";
+    std::stringstream content;
+    content << stream.rdbuf();
+    if (stream.bad()) return "";
+    return createFNV1aHash(content.str());
+}
+
 std::string OpenSim::getFormattedDateTime(
         bool appendMicroseconds, std::string format) {
     using namespace std::chrono;
@@ -183,3 +206,58 @@ SimTK::Real OpenSim::solveBisection(
     }
     return midpoint;
 }
+
+namespace {
+// 0 until the default is first needed.
+std::atomic<int> maxNumThreads(0);
+// The threads reserved by all ThreadReservations, beyond their callers.
+std::atomic<int> numReservedThreads(0);
+
+int getDefaultMaxNumThreads() {
+    const std::string varName = "OPENSIM_NUM_THREADS";
+    if (SimTK::Pathname::environmentVariableExists(varName)) {
+        const std::string value =
+                SimTK::Pathname::getEnvironmentVariable(varName);
+        const int num = std::atoi(value.c_str());
+        if (num > 0) return num;
+        log_warn("OPENSIM_NUM_THREADS environment variable set to incorrect "
+                 "value '{}'; must be an integer > 0. Ignoring.",
+                value);
+    }
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+} // anonymous namespace
+
+int OpenSim::getMaxNumThreads() {
+    int num = maxNumThreads.load();
+    if (num == 0) {
+        num = getDefaultMaxNumThreads();
+        maxNumThreads.store(num);
+    }
+    return num;
+}
+
+void OpenSim::setMaxNumThreads(int numThreads) {
+    maxNumThreads.store(numThreads > 0 ? numThreads
+                                       : getDefaultMaxNumThreads());
+}
+
+int OpenSim::getNumAvailableThreads() {
+    return std::max(1, getMaxNumThreads() - numReservedThreads.load());
+}
+
+OpenSim::ThreadReservation::ThreadReservation(int numThreads) {
+    const int requested = numThreads - 1;
+    int reserved = numReservedThreads.load();
+    int granted;
+    do {
+        granted = std::max(0,
+                std::min(requested, getMaxNumThreads() - 1 - reserved));
+    } while (granted > 0 && !numReservedThreads.compare_exchange_weak(
+                                    reserved, reserved + granted));
+    m_numExtraThreads = granted;
+}
+
+OpenSim::ThreadReservation::~ThreadReservation() {
+    numReservedThreads -= m_numExtraThreads;
+}
@@ -30,6 +30,13 @@
 #include <mutex>
 #include <stack>
 #include <condition_variable>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <SimTKcommon/internal/BigMatrix.h>
 
@@ -49,6 +56,18 @@ std::unique_ptr<T> make_unique(Args&&... args) {
 /// If you specify "ISO", then we use the ISO 8601 extended datetime format
 /// %Y-%m-%dT%H:%M:%S.
 /// See https://en.cppreference.com/w/cpp/io/manip/put_time.
+/// Compute a 64-bit FNV-1a hash of the text, as 16 hexadecimal digits. The
+/// hash is the same on all platforms, so it can be used to name or validate
+/// files that cache results across runs (e.g., the sparsity cache of
+/// MocoCasADiSolver). It is not a cryptographic hash.
+/// @ingroup commonutil
+OSIMCOMMON_API std::string createFNV1aHash(const std::string& text);
+
+/// Compute createFNV1aHash() of the content of a file. Returns an empty string
+/// if the file cannot be read.
+/// @ingroup commonutil
+OSIMCOMMON_API std::string createFNV1aHashOfFile(const std::string& path);
+
 /// @ingroup commonutil
 OSIMCOMMON_API std::string getFormattedDateTime(
         bool appendMicroseconds = false,
@@ -124,6 +143,122 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+/// The total number of threads that OpenSim's parallel features (e.g.,
+/// parallelFor(), ManagerEnsemble, MocoStudyBatch, MocoCasADiSolver) use at
+/// once, including the calling thread. This defaults to the value of the
+/// environment variable OPENSIM_NUM_THREADS, if it is set to a positive
+/// integer, or else the number of hardware threads. Set it lower on a shared
+/// machine to keep OpenSim from using all of its cores.
+/// @ingroup commonutil
+OSIMCOMMON_API int getMaxNumThreads();
+
+/// Set the value returned by getMaxNumThreads(). A value that is not positive
+/// restores the default. This does not affect work that is already running.
+/// @ingroup commonutil
+OSIMCOMMON_API void setMaxNumThreads(int numThreads);
+
+/// The number of threads (at least 1) that a new parallel region may use
+/// without exceeding getMaxNumThreads(): the threads reserved by the regions
+/// currently running (see ThreadReservation) are not available. This is the
+/// default number of threads for OpenSim's parallel features, so that nested
+/// parallelism (e.g., a parallelFor() inside a MocoStudyBatch job) does not
+/// oversubscribe the cores.
+/// @ingroup commonutil
+OSIMCOMMON_API int getNumAvailableThreads();
+
+/// Reserve threads from the budget given by getMaxNumThreads() for the
+/// lifetime of this object. The calling thread is assumed to be accounted for
+/// already (by the region that started it), so a reservation for
+/// `numThreads` threads takes up to `numThreads - 1` threads from the budget;
+/// getNumThreads() is the number of threads granted, including the calling
+/// thread. A feature that is asked to use a specific number of threads
+/// spawns that many regardless, but still holds a reservation so that other
+/// parallel regions see (as many as the budget allows of) those threads as
+/// busy.
+/// @ingroup commonutil
+class OSIMCOMMON_API ThreadReservation {
+public:
+    explicit ThreadReservation(int numThreads);
+    ~ThreadReservation();
+    ThreadReservation(const ThreadReservation&) = delete;
+    ThreadReservation& operator=(const ThreadReservation&) = delete;
+    int getNumThreads() const { return m_numExtraThreads + 1; }
+private:
+    int m_numExtraThreads = 0;
+};
+
+/// Call `function(i)` for each i in [0, size), using up to `numThreads`
+/// threads (getMaxNumThreads() if `numThreads` is not positive). The threads
+/// are reserved from the OpenSim-wide budget (see ThreadReservation), so a
+/// parallelFor() nested in another parallel region, or run while other
+/// parallel work is in progress, uses only the threads that remain and runs
+/// serially on the calling thread if there are none. The indices are handed
+/// out one at a time, so idle threads take the remaining work. The function
+/// must be safe to call concurrently for different indices. If any call
+/// throws, the exception for the smallest such index is rethrown after all
+/// threads have finished.
+/// @ingroup commonutil
+template <typename F>
+void parallelFor(int size, F function, int numThreads = 0) {
+    if (numThreads <= 0) numThreads = getMaxNumThreads();
+    numThreads = std::max(1, std::min(numThreads, size));
+    const ThreadReservation reservation(numThreads);
+    numThreads = reservation.getNumThreads();
+    if (numThreads == 1) {
+        for (int i = 0; i < size; ++i) function(i);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(size);
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        int i;
+        while ((i = next++) < size) {
+            try {
+                function(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+/// Format `numRows` rows of text and pass the text to `write`, in order. The
+/// text of row i is produced by `appendRow(i, text)`, which appends it
+/// (including the newline) to the std::string `text`. Blocks of rows are
+/// formatted concurrently using up to `numThreads` threads (see
+/// parallelFor()), and `write(text)` is called once per block, so that the
+/// file is written in large pieces. Only a few blocks per thread are kept in
+/// memory at a time, so memory use does not grow with the number of rows.
+/// @ingroup commonutil
+template <typename F, typename W>
+void formatRowsInParallel(int numRows, F appendRow, W write,
+        int numThreads = 0) {
+    if (numThreads <= 0) numThreads = getNumAvailableThreads();
+    const int rowsPerBlock = 512;
+    const int numBlocks = (numRows + rowsPerBlock - 1) / rowsPerBlock;
+    const int blocksPerPass = 4 * numThreads;
+    std::vector<std::string> text(std::min(numBlocks, blocksPerPass));
+    for (int first = 0; first < numBlocks; first += blocksPerPass) {
+        const int count = std::min(blocksPerPass, numBlocks - first);
+        parallelFor(count,
+                [&](int b) {
+                    text[b].clear();
+                    const int begin = (first + b) * rowsPerBlock;
+                    const int end = std::min(numRows, begin + rowsPerBlock);
+                    for (int i = begin; i < end; ++i) appendRow(i, text[b]);
+                },
+                numThreads);
+        for (int b = 0; b < count; ++b) write(text[b]);
+    }
+}
+
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
 /// @ingroup commonutil
@@ -165,6 +300,65 @@ private:
     std::condition_variable m_inventoryMonitor;
 };
 
+/// This class stores copies of computed results of a single type, keyed by a
+/// string that identifies the inputs of the computation (e.g., a hash), so
+/// that repeating the computation can be skipped. Once the capacity is
+/// reached, inserting a result drops the oldest one. All functions are
+/// threadsafe.
+/// @ingroup commonutil
+template <typename T> class ResultCache {
+public:
+    explicit ResultCache(int capacity = 16) : m_capacity(capacity) {}
+    /// If there is a result for the key, copy it into `result` and return
+    /// true.
+    bool find(const std::string& key, T& result) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& entry : m_entries) {
+            if (entry.first == key) {
+                result = entry.second;
+                return true;
+            }
+        }
+        return false;
+    }
+    /// Store a copy of the result for the key, replacing any previous result
+    /// for the key.
+    void insert(const std::string& key, const T& result) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& entry : m_entries) {
+            if (entry.first == key) {
+                entry.second = result;
+                return;
+            }
+        }
+        m_entries.emplace_back(key, result);
+        while ((int)m_entries.size() > m_capacity) m_entries.pop_front();
+    }
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+    /// The number of stored results.
+    int size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (int)m_entries.size();
+    }
+    void setCapacity(int capacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        while ((int)m_entries.size() > m_capacity) m_entries.pop_front();
+    }
+    int getCapacity() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+private:
+    std::deque<std::pair<std::string, T>> m_entries;
+    int m_capacity;
+    mutable std::mutex m_mutex;
+};
+
 } // namespace OpenSim
 
 #endif // OPENSIM_COMMONUTILITIES_H_
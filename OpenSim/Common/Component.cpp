@@ -24,6 +24,9 @@
 
 // INCLUDES
 #include "Component.h"
+#include "ComponentConcurrencyChecker.h"
+#include "ComponentPhaseProfiler.h"
+#include "ComponentRealizeProfiler.h"
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
 #include <unordered_map>
@@ -79,29 +82,65 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeTopology, _Component);
+        _Component.extendRealizeTopology(s); }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeModel, _Component);
+        _Component.extendRealizeModel(s); }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeInstance, _Component);
+        _Component.extendRealizeInstance(s); }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeTime, _Component);
+        ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Use, _Component,
+            "extendRealizeTime");
+        _Component.extendRealizeTime(s); }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizePosition, _Component);
+        ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Use, _Component,
+            "extendRealizePosition");
+        _Component.extendRealizePosition(s); }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeVelocity, _Component);
+        ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Use, _Component,
+            "extendRealizeVelocity");
+        _Component.extendRealizeVelocity(s); }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeDynamics, _Component);
+        ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Use, _Component,
+            "extendRealizeDynamics");
+        _Component.extendRealizeDynamics(s); }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeAcceleration, _Component);
+        ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Use, _Component,
+            "extendRealizeAcceleration");
+        _Component.extendRealizeAcceleration(s); }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {   ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::RealizeReport, _Component);
+        ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Use, _Component,
+            "extendRealizeReport");
+        _Component.extendRealizeReport(s); }
 
 private:
     const Component& _Component;
@@ -149,6 +188,9 @@ void Component::addComponent(Component* subcomponent)
     OPENSIM_THROW_IF(isComponentInOwnershipTree(subcomponent),
                      ComponentAlreadyPartOfOwnershipTree,
                       subcomponent->getName(), getName());
+    ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Modify, *this,
+            "addComponent");
 
     updProperty_components().adoptAndAppendValue(subcomponent);
     finalizeFromProperties();
@@ -160,6 +202,15 @@ void Component::addComponent(Component* subcomponent)
     extendAddComponent(subcomponent);
 }
 
+std::vector<const Component*> Component::getThreadUnsafeComponents() const {
+    std::vector<const Component*> components;
+    if (!isThreadSafe()) components.push_back(this);
+    for (const auto& comp : getComponentList()) {
+        if (!comp.isThreadSafe()) components.push_back(&comp);
+    }
+    return components;
+}
+
 void Component::prependComponentPathToConnecteePath(
         Component& subcomponent) {
     const std::string compPath = subcomponent.getAbsolutePathString();
@@ -177,6 +228,11 @@ void Component::prependComponentPathToConnecteePath(
 
 void Component::finalizeFromProperties()
 {
+    ComponentPhaseProfiler::Scope profilerScope(
+            ComponentPhaseProfiler::Phase::FinalizeFromProperties, *this);
+    ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Modify, *this,
+            "finalizeFromProperties");
     reset();
 
     // last opportunity to modify Object names based on properties
@@ -270,6 +326,15 @@ void Component::finalizeFromProperties()
     }
     // End of duplicate finding and renaming.
 
+    // Components with few subcomponents are searched linearly.
+    static const std::size_t minSubcomponentsToIndex = 8;
+    if (subs.size() >= minSubcomponentsToIndex) {
+        _subcomponentsByName.reserve(subs.size());
+        for (const auto& sub : subs) {
+            _subcomponentsByName[sub->getName()] = sub.get();
+        }
+    }
+
     extendFinalizeFromProperties();
     setObjectIsUpToDateWithProperties();
 }
@@ -295,6 +360,11 @@ void Component::componentsFinalizeFromProperties() const
 // Base class implementation of non-virtual finalizeConnections method.
 void Component::finalizeConnections(Component& root)
 {
+    ComponentPhaseProfiler::Scope profilerScope(
+            ComponentPhaseProfiler::Phase::FinalizeConnections, *this);
+    ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Modify, *this,
+            "finalizeConnections");
     if (!isObjectUpToDateWithProperties()){
         // if edits occur between construction and connect() this is
         // the last chance to finalize before addToSystem.
@@ -388,6 +458,10 @@ void Component::addToSystem(SimTK::MultibodySystem& system) const
     if (hasSystem() && (&getSystem() == &system)) {
         return;
     }
+    ComponentPhaseProfiler::Scope profilerScope(
+            ComponentPhaseProfiler::Phase::AddToSystem, *this);
+    ComponentConcurrencyChecker::Scope checkerScope(
+            ComponentConcurrencyChecker::Access::Modify, *this, "addToSystem");
     baseAddToSystem(system);
     extendAddToSystem(system);
     componentsAddToSystem(system);
@@ -451,6 +525,8 @@ void Component::componentsAddToSystem(SimTK::MultibodySystem& system) const
 
 void Component::initStateFromProperties(SimTK::State& state) const
 {
+    ComponentPhaseProfiler::Scope profilerScope(
+            ComponentPhaseProfiler::Phase::InitStateFromProperties, *this);
     extendInitStateFromProperties(state);
     componentsInitStateFromProperties(state);
 }
@@ -731,20 +807,7 @@ std::string Component::getAbsolutePathString() const
 
 ComponentPath Component::getAbsolutePath() const
 {
-    if (!hasOwner()) return ComponentPath({}, true);
-
-    std::vector<std::string> pathVec;
-    pathVec.push_back(getName());
-
-    const Component* up = this;
-
-    while (up && up->hasOwner()) {
-        up = &up->getOwner();
-        if (up->hasOwner())
-            pathVec.insert(pathVec.begin(), up->getName());
-    }
-
-    return ComponentPath(pathVec, true);
+    return ComponentPath(getAbsolutePathString());
 }
 
 std::string Component::getRelativePathString(const Component& wrt) const
@@ -915,18 +978,11 @@ bool Component::isAllStatesVariablesListValid() const
     return valid;
 }
 
-
-// Get all values of the state variables allocated by this Component. Includes
-// state variables allocated by its subcomponents.
-SimTK::Vector Component::
-    getStateVariableValues(const SimTK::State& state) const
+void Component::updateAllStateVariablesList() const
 {
-    // Must have already called initSystem.
-    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
-
-    int nsv = getNumStateVariables();
     // if the StateVariables are invalid (see above) rebuild the list
     if (!isAllStatesVariablesListValid()) {
+        int nsv = getNumStateVariables();
         _statesAssociatedSystem.reset(&getSystem());
         _allStateVariables.clear();
         _allStateVariables.resize(nsv);
@@ -934,13 +990,84 @@ SimTK::Vector Component::
         for (int i = 0; i < nsv; ++i)
             _allStateVariables[i].reset(traverseToStateVariable(names[i]));
     }
+}
+
+// Get all values of the state variables allocated by this Component. Includes
+// state variables allocated by its subcomponents.
+SimTK::Vector Component::
+    getStateVariableValues(const SimTK::State& state) const
+{
+    Vector stateVariableValues;
+    getStateVariableValues(state, stateVariableValues);
+    return stateVariableValues;
+}
 
-    Vector stateVariableValues(nsv, SimTK::NaN);
+void Component::getStateVariableValues(const SimTK::State& state,
+                                       SimTK::Vector& values) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    updateAllStateVariablesList();
+
+    const int nsv = (int)_allStateVariables.size();
+    if (values.size() != nsv) values.resize(nsv);
     for(int i=0; i<nsv; ++i){
-        stateVariableValues[i]= _allStateVariables[i]->getValue(state);
+        values[i]= _allStateVariables[i]->getValue(state);
     }
+}
 
-    return stateVariableValues;
+std::vector<int> Component::getStateVariableSystemIndices(
+        const std::vector<std::string>& names) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    // The StateVariables do not know their index in Y, so tag each entry of
+    // Y with its index and read the tag back through each StateVariable.
+    SimTK::State state = getSystem().getDefaultState();
+    const int ny = state.getNY();
+    for (int iy = 0; iy < ny; ++iy) state.updY()[iy] = iy;
+
+    std::vector<int> systemIndices;
+    systemIndices.reserve(names.size());
+    for (const auto& name : names) {
+        const StateVariable* sv = traverseToStateVariable(name);
+        OPENSIM_THROW_IF_FRMOBJ(!sv, Exception,
+                "State variable '" + name + "' not found.");
+        const double tag = sv->getValue(state);
+        const int iy = (int)tag;
+        OPENSIM_THROW_IF_FRMOBJ(tag != iy || iy < 0 || iy >= ny, Exception,
+                "State variable '" + name + "' does not correspond to an "
+                "entry of the State's Y vector.");
+        systemIndices.push_back(iy);
+    }
+    return systemIndices;
+}
+
+void Component::getStateVariableValuesAtSystemIndices(
+        const SimTK::State& state, const std::vector<int>& systemIndices,
+        SimTK::Vector& values) const
+{
+    const int n = (int)systemIndices.size();
+    if (values.size() != n) values.resize(n);
+    const SimTK::Vector& y = state.getY();
+    for (int i = 0; i < n; ++i) {
+        values[i] = y[systemIndices[i]];
+    }
+}
+
+void Component::setStateVariableValuesAtSystemIndices(SimTK::State& state,
+        const std::vector<int>& systemIndices,
+        const SimTK::Vector& values) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(values.size() != (int)systemIndices.size(),
+            Exception, fmt::format("Expected {} values but got {}.",
+                    systemIndices.size(), values.size()));
+    SimTK::Vector& y = state.updY();
+    for (int i = 0; i < (int)systemIndices.size(); ++i) {
+        y[systemIndices[i]] = values[i];
+    }
 }
 
 // Set all values of the state variables allocated by this Component. Includes
@@ -958,15 +1085,7 @@ void Component::
         "Component::setStateVariableValues() number values does not match the "
         "number of state variables.");
 
-    // if the StateVariables are invalid (see above) rebuild the list 
-    if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
-    }
+    updateAllStateVariablesList();
 
     for(int i=0; i<nsv; ++i){
         _allStateVariables[i]->setValue(state, values[i]);
@@ -1194,6 +1313,7 @@ void Component::markPropertiesAsSubcomponents()
     // Method can be invoked for either constructing a new Component
     // or the properties have been modified. In the latter case
     // we must make sure that pointers to old properties are cleared
+    clearComponentTraversal();
     _propertySubcomponents.clear();
 
     // Now mark properties that are Components as subcomponents
@@ -1283,9 +1403,29 @@ void Component::adoptSubcomponent(Component* subcomponent)
     }
 
     subcomponent->setOwner(*this);
+    clearComponentTraversal();
     _adoptedSubcomponents.push_back(SimTK::ClonePtr<Component>(subcomponent));
 }
 
+const Component* Component::findImmediateSubcomponent(
+        const std::string& name) const
+{
+    const auto it = _subcomponentsByName.find(name);
+    if (it != _subcomponentsByName.end() && it->second->getName() == name)
+        return it->second;
+
+    for (const auto& comp : _memberSubcomponents) {
+        if (comp->getName() == name) return comp.get();
+    }
+    for (const auto& comp : _propertySubcomponents) {
+        if (comp->getName() == name) return comp.get();
+    }
+    for (const auto& comp : _adoptedSubcomponents) {
+        if (comp->getName() == name) return comp.get();
+    }
+    return nullptr;
+}
+
 std::vector<SimTK::ReferencePtr<const Component>> 
     Component::getImmediateSubcomponents() const
 {
@@ -1727,9 +1867,10 @@ void Component::printOutputInfo(const bool includeDescendants) const {
     }
 }
 
-void Component::initComponentTreeTraversal(const Component &root) const {
-    // Going down the tree, this node is followed by all its children.
-    // The last child's successor (next) is the parent's successor.
+void Component::initComponentTreeTraversal(const Component &root,
+        std::vector<const Component*>& traversal) const {
+    // Going down the tree, this node is followed by all its children
+    // (member, then property, then adopted subcomponents), recursively.
 
     const size_t nmsc = _memberSubcomponents.size();
     const size_t npsc = _propertySubcomponents.size();
@@ -1751,59 +1892,41 @@ void Component::initComponentTreeTraversal(const Component &root) const {
         }
     }
 
-    const Component* last = nullptr;
-    for (unsigned int i = 0; i < nmsc; i++) {
-        if (i == nmsc - 1) {
-            _memberSubcomponents[i]->_nextComponent = _nextComponent.get();
-            last = _memberSubcomponents[i].get();
-        }
-        else {
-            _memberSubcomponents[i]->_nextComponent =
-                _memberSubcomponents[i + 1].get();
-            last = _memberSubcomponents[i + 1].get();
-        }
-    }
-    if (npsc) {
-        if (last)
-            last->_nextComponent = _propertySubcomponents[0].get();
-
-        for (unsigned int i = 0; i < npsc; i++) {
-            if (i == npsc - 1) {
-                _propertySubcomponents[i]->_nextComponent =
-                    _nextComponent.get();
-                last = _propertySubcomponents[i].get();
-            }
-            else {
-                _propertySubcomponents[i]->_nextComponent =
-                    _propertySubcomponents[i + 1].get();
-                last = _propertySubcomponents[i + 1].get();
-            }
-        }
-    }
-    if (nasc) {
-        if (last)
-            last->_nextComponent = _adoptedSubcomponents[0].get();
-
-        for (unsigned int i = 0; i <nasc; i++) {
-            if (i == nasc - 1) {
-                _adoptedSubcomponents[i]->_nextComponent = _nextComponent.get();
-            }
-            else {
-                _adoptedSubcomponents[i]->_nextComponent
-                    = _adoptedSubcomponents[i + 1].get();
-            }
-        }
-    }
-
-    // recurse to handle children of subcomponents
     for (unsigned int i = 0; i < nmsc; ++i) {
-        _memberSubcomponents[i]->initComponentTreeTraversal(root);
+        traversal.push_back(_memberSubcomponents[i].get());
+        _memberSubcomponents[i]->initComponentTreeTraversal(root, traversal);
     }
     for (unsigned int i = 0; i < npsc; ++i) {
-        _propertySubcomponents[i]->initComponentTreeTraversal(root);
+        traversal.push_back(_propertySubcomponents[i].get());
+        _propertySubcomponents[i]->initComponentTreeTraversal(root, traversal);
     }
     for (unsigned int i = 0; i < nasc; ++i) {
-        _adoptedSubcomponents[i]->initComponentTreeTraversal(root);
+        traversal.push_back(_adoptedSubcomponents[i].get());
+        _adoptedSubcomponents[i]->initComponentTreeTraversal(root, traversal);
+    }
+}
+
+Component::ComponentTraversalPtr Component::getComponentTraversal() const {
+    // ResetOnCopy<T> derives from T (here, a shared_ptr).
+    ComponentTraversalPtr* cached = &_componentTraversal;
+    ComponentTraversalPtr traversal = std::atomic_load(cached);
+    if (traversal) return traversal;
+    // Concurrent callers may each build the (identical) traversal; the last
+    // one to finish is kept.
+    auto newTraversal = std::make_shared<std::vector<const Component*>>();
+    initComponentTreeTraversal(*this, *newTraversal);
+    traversal = std::move(newTraversal);
+    std::atomic_store(cached, traversal);
+    return traversal;
+}
+
+void Component::clearComponentTraversal() const {
+    // The traversal of every ancestor includes this component's subtree.
+    const Component* comp = this;
+    while (comp) {
+        ComponentTraversalPtr* cached = &comp->_componentTraversal;
+        std::atomic_store(cached, ComponentTraversalPtr());
+        comp = comp->hasOwner() ? &comp->getOwner() : nullptr;
     }
 }
 
@@ -1822,8 +1945,10 @@ void Component::reset()
     _simTKcomponentIndex.invalidate();
     clearStateAllocations();
 
+    clearComponentTraversal();
     _propertySubcomponents.clear();
     _adoptedSubcomponents.clear();
+    _subcomponentsByName.clear();
     resetSubcomponentOrder();
 }
 
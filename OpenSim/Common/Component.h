@@ -50,6 +50,7 @@
 #include "OpenSim/Common/ComponentSocket.h"
 #include "OpenSim/Common/Object.h"
 #include "simbody/internal/MultibodySystem.h"
+#include <memory>
 #include <unordered_map>
 
 #include <OpenSim/Common/osimCommonDLL.h>
@@ -476,6 +477,24 @@ public:
     // End of Component Structural Interface (public non-virtual).
     ///@}
 
+    /** Whether the const methods of this %Component (e.g., its realize
+    methods, its outputs and, for a Force, computeForce()) may be invoked from
+    multiple threads at the same time, each thread with its own State, on the
+    same (uncopied) %Component. The default is true, since a component
+    typically only reads its properties and the State, and only writes to
+    its own cache variables. Override this method to return false if these
+    methods modify data members, share scratch storage, or call code that is
+    not thread-safe. Engines that could share a model among threads (e.g.,
+    InverseDynamicsSolver::solve() with multiple threads) check
+    getThreadUnsafeComponents() and do not share a model that contains such a
+    component. See also ComponentConcurrencyChecker. */
+    virtual bool isThreadSafe() const { return true; }
+
+    /** The components in the tree rooted at this %Component (including this
+    %Component) whose isThreadSafe() returns false. The component must have
+    been finalized (e.g., with finalizeFromProperties()). */
+    std::vector<const Component*> getThreadUnsafeComponents() const;
+
     /** Optional method for generating arbitrary display geometry that reflects
     this %Component at the specified \a state. This will be called once to
     obtain ground- and body-fixed geometry (with \a fixed=\c true), and then
@@ -622,7 +641,6 @@ public:
     ComponentList<const T> getComponentList() const {
         static_assert(std::is_base_of<Component, T>::value,
                 "Template argument must be Component or a derived class.");
-        initComponentTreeTraversal(*this);
         return ComponentList<const T>(*this);
     }
 
@@ -645,7 +663,6 @@ public:
     ComponentList<T> updComponentList() {
         static_assert(std::is_base_of<Component, T>::value,
                 "Template argument must be Component or a derived class.");
-        initComponentTreeTraversal(*this);
         clearObjectIsUpToDateWithProperties();
         return ComponentList<T>(*this);
     }
@@ -1338,6 +1355,62 @@ public:
     void setStateVariableValues(SimTK::State& state,
                                 const SimTK::Vector& values) const;
 
+    /**
+     * Same as getStateVariableValues(const SimTK::State&), but the values are
+     * written into a Vector provided by the caller. The Vector is resized (to
+     * getNumStateVariables()) only if it has the wrong size, so reusing the
+     * same Vector avoids an allocation when getting the values repeatedly.
+     *
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    void getStateVariableValues(const SimTK::State& state,
+                                SimTK::Vector& values) const;
+
+    /**
+     * Resolve state variables, by name (or path relative to this Component,
+     * as accepted by getStateVariableValue()), to their indices in the
+     * State's vector of continuous state variables, Y. Resolving the names
+     * once and then accessing the values by index with
+     * getStateVariableValuesAtSystemIndices() and
+     * setStateVariableValuesAtSystemIndices() avoids looking up each name
+     * whenever the values are accessed. The indices are valid until the
+     * System is rebuilt (e.g., by Model::initSystem()).
+     *
+     * @code
+     * const auto indices = model.getStateVariableSystemIndices(
+     *         {"/jointset/r_shoulder/r_shoulder_elev/value",
+     *          "/forceset/BIClong/activation"});
+     * SimTK::Vector values;
+     * model.getStateVariableValuesAtSystemIndices(state, indices, values);
+     * @endcode
+     *
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if a state variable is not found
+     */
+    std::vector<int> getStateVariableSystemIndices(
+            const std::vector<std::string>& names) const;
+
+    /**
+     * Get the values of the state variables with the given indices in Y (see
+     * getStateVariableSystemIndices()). The values are written into the
+     * Vector provided by the caller, which is resized only if its size does
+     * not match the number of indices.
+     */
+    void getStateVariableValuesAtSystemIndices(const SimTK::State& state,
+            const std::vector<int>& systemIndices,
+            SimTK::Vector& values) const;
+
+    /**
+     * %Set the values of the state variables with the given indices in Y (see
+     * getStateVariableSystemIndices()). As with setStateVariableValues(),
+     * this method simply sets the values on the State.
+     */
+    void setStateVariableValuesAtSystemIndices(SimTK::State& state,
+            const std::vector<int>& systemIndices,
+            const SimTK::Vector& values) const;
+
     /**
      * Get the value of a state variable derivative computed by this Component.
      *
@@ -1953,6 +2026,7 @@ protected:
         C* component = new C();
         component->setName(name);
         component->setOwner(*this);
+        clearComponentTraversal();
         _memberSubcomponents.push_back(SimTK::ClonePtr<Component>(component));
         return MemberSubcomponentIndex(_memberSubcomponents.size()-1);
     }
@@ -2097,16 +2171,29 @@ protected:
     virtual void extendFinalizeConnections(Component& root) {};
 
     /** Build the tree of Components from this component through its descendants.
-    This method is invoked whenever a ComponentList<C> is requested. Note that
+    This method is invoked whenever a ComponentList<C> is requested and the
+    tree has changed since the last request. Note that
     all components must have been added to the model (or its subcomponents),
     otherwise it will not be included in the tree and will not be found for
-    iteration or for connection. The implementation populates the _nextComponent
-    ReferencePtr with a pointer to the next Component in tree pre-order traversal.
+    iteration or for connection. The implementation appends the descendants
+    of this Component to `traversal`, in tree pre-order.
 
     @throws ComponentIsRootWithNoSubcomponents if the Component is the root and
             yet has no subcomponents.
     */
-    void initComponentTreeTraversal(const Component &root) const;
+    void initComponentTreeTraversal(const Component &root,
+            std::vector<const Component*>& traversal) const;
+
+    typedef std::shared_ptr<const std::vector<const Component*>>
+            ComponentTraversalPtr;
+    /** The descendants of this Component in tree pre-order, used by
+    ComponentList. The list is built on first use and shared until
+    subcomponents are added to or removed from this Component or any of its
+    descendants (see clearComponentTraversal()). */
+    ComponentTraversalPtr getComponentTraversal() const;
+    /** Discard the cached traversals of this Component and its ancestors,
+    since their subtrees are about to change. */
+    void clearComponentTraversal() const;
 
     ///@cond
     /** Opportunity to remove connection-related information.
@@ -2560,43 +2647,28 @@ public:
 protected:
 
     template<class C>
-    const C* traversePathToComponent(ComponentPath path) const
+    const C* traversePathToComponent(const ComponentPath& path) const
     {
-        // Get rid of all the ".."'s that are not at the front of the path.
-        path.trimDotAndDotDotElements();
-
-        // Move up either to the root component or just enough to resolve all
-        // the ".."'s.
-        size_t iPathEltStart = 0u;
+        // The path is normalized, so any ".." elements are at its front.
         const Component* current = this;
         if (path.isAbsolute()) {
             current = &current->getRoot();
-        } else {
-            while (iPathEltStart < path.getNumPathLevels() &&
-                    path.getSubcomponentNameAtLevel(iPathEltStart) == "..") {
-                // The path sends us up farther than the root.
+        }
+
+        std::string element;
+        size_t pos = 0;
+        while (path.nextPathElement(pos, element)) {
+            if (element == "..") {
+                // Move up just enough to resolve all the ".."'s; the path
+                // may send us up farther than the root.
                 if (!current->hasOwner()) return nullptr;
                 current = &current->getOwner();
-                ++iPathEltStart;
+                continue;
             }
-        }
-
-        using RefComp = SimTK::ReferencePtr<const Component>;
-
-        // Skip over the root component name.
-        for (size_t i = iPathEltStart; i < path.getNumPathLevels(); ++i) {
             // At this depth in the tree, is there a component whose name
             // matches the corresponding path element?
-            const auto& currentPathElement =
-                path.getSubcomponentNameAtLevel(i);
-            const auto& currentSubs = current->getImmediateSubcomponents();
-            const auto it = std::find_if(currentSubs.begin(), currentSubs.end(),
-                    [currentPathElement](const RefComp& sub)
-                    { return sub->getName() == currentPathElement; });
-            if (it != currentSubs.end())
-                current = it->get();
-            else
-                return nullptr;
+            current = current->findImmediateSubcomponent(element);
+            if (!current) return nullptr;
         }
         if (const C* comp = dynamic_cast<const C*>(current))
             return comp;
@@ -2848,6 +2920,9 @@ private:
     /// Invoke finalizeFromProperties() on the (sub)components of this Component.
     void componentsFinalizeFromProperties() const;
 
+    // Return the immediate subcomponent with the given name, or nullptr.
+    const Component* findImmediateSubcomponent(const std::string& name) const;
+
     /// Invoke connect() on the (sub)components of this Component.
     void componentsFinalizeConnections(Component& root);
 
@@ -3019,8 +3094,10 @@ private:
     // one.
     SimTK::ReferencePtr<const Component> _owner;
 
-    // Reference pointer to the successor of the current Component in Pre-order traversal
-    mutable SimTK::ReferencePtr<const Component> _nextComponent;
+    // Descendants of this Component in pre-order traversal, with this
+    // Component as the root; see getComponentTraversal(). Accessed atomically,
+    // since ComponentLists may be requested concurrently.
+    mutable SimTK::ResetOnCopy<ComponentTraversalPtr> _componentTraversal;
 
     // Reference pointer to the system that this component belongs to.
     SimTK::ReferencePtr<SimTK::MultibodySystem> _system;
@@ -3048,8 +3125,17 @@ private:
         _propertySubcomponents;
     // Keep fixed list of data member Components upon construction
     SimTK::Array_<SimTK::ClonePtr<Component> > _memberSubcomponents;
-    // Hold onto adopted components
-    SimTK::Array_<SimTK::ClonePtr<Component> > _adoptedSubcomponents;
+    // Hold onto adopted components. These are adopted while finalizing the
+    // (copied) component and cleared by reset(), so they are not copied.
+    SimTK::ResetOnCopy<SimTK::Array_<SimTK::ClonePtr<Component>>>
+        _adoptedSubcomponents;
+    // The immediate subcomponents by name, so that resolving a path through a
+    // component with many subcomponents (e.g., a Set) does not compare the
+    // name of each subcomponent. This is rebuilt by finalizeFromProperties()
+    // and cleared by reset(). Subcomponents that were added or renamed since
+    // are found by the linear search in findImmediateSubcomponent().
+    SimTK::ResetOnCopy<std::unordered_map<std::string, const Component*>>
+        _subcomponentsByName;
 
     // A flat list of subcomponents (immediate and otherwise) under this
     // Component. This list must be populated prior to addToSystem(), and is
@@ -3187,21 +3273,28 @@ private:
     // why it is const!
     // The setting of the variable indices is not in the public interface and is
     // not polymorphic.
+    // Like the cache variables, these are allocated again when the copy is
+    // added to a System, so they are not copied.
 
 
-    mutable std::map<std::string, ModelingOptionInfo> _namedModelingOptionInfo;
+    mutable SimTK::ResetOnCopy<std::map<std::string, ModelingOptionInfo>>
+        _namedModelingOptionInfo;
     // Map names of continuous state variables of the Component to their
     // underlying SimTK indices.
-    mutable std::map<std::string, StateVariableInfo> _namedStateVariableInfo;
+    mutable SimTK::ResetOnCopy<std::map<std::string, StateVariableInfo>>
+        _namedStateVariableInfo;
     // Map names of discrete variables of the Component to their underlying
     // SimTK indices.
-    mutable std::map<std::string, DiscreteVariableInfo> _namedDiscreteVariableInfo;
+    mutable SimTK::ResetOnCopy<std::map<std::string, DiscreteVariableInfo>>
+        _namedDiscreteVariableInfo;
     // Map names of cache entries of the Component to their individual
     // cache information.
     mutable SimTK::ResetOnCopy<std::unordered_map<std::string, StoredCacheVariable>> _namedCacheVariables;
 
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
+    // Rebuild the list of _allStateVariables if it is not valid.
+    void updateAllStateVariablesList() const;
 
     // Array of all state variables for fast access during simulation
     mutable SimTK::Array_<SimTK::ReferencePtr<const StateVariable> >
@@ -3214,6 +3307,19 @@ private:
 //==============================================================================
 //==============================================================================
 
+// Implement methods for ComponentList
+template <typename T>
+ComponentList<T>::ComponentList(const Component& root,
+        const ComponentFilter& f) :
+    _root(root), _traversal(root.getComponentTraversal()), _filter(f) {
+}
+
+template <typename T>
+ComponentList<T>::ComponentList(const Component& root) :
+    _root(root), _traversal(root.getComponentTraversal()) {
+    setDefaultFilter();
+}
+
 // Implement methods for ComponentListIterator
 /// ComponentListIterator<T> pre-increment operator, advances the iterator to
 /// the next valid entry.
@@ -3221,23 +3327,9 @@ template <typename T>
 ComponentListIterator<T>& ComponentListIterator<T>::operator++() {
     if (_node==nullptr)
         return *this;
-    // If _node has children then successor is first child
-    // move _node to point to it
-    if (_node->_memberSubcomponents.size() > 0) {
-        _node = _node->_memberSubcomponents[0].get();
-    }
-    else if (_node->_propertySubcomponents.size() > 0) {
-        _node = _node->_propertySubcomponents[0].get();
-    }
-    else if (_node->_adoptedSubcomponents.size() > 0) {
-        _node = _node->_adoptedSubcomponents[0].get();
-    }
-    // If processing a subtree under _root we stop when our successor is the same
-    // as the successor of _root as this indicates we're leaving the _root's subtree.
-    else if (_node->_nextComponent.get() == _root->_nextComponent.get())
-        _node = nullptr;
-    else // move on to the next component we computed earlier for the full tree
-        _node = _node->_nextComponent.get();
+    // The traversal is a flat pre-order list of the root's descendants.
+    ++_index;
+    _node = _index < _traversal->size() ? (*_traversal)[_index] : nullptr;
     advanceToNextValidComponent(); // make sure we have a _node of type T after advancing
     return *this;
 }
@@ -3248,26 +3340,10 @@ void ComponentListIterator<T>::advanceToNextValidComponent() {
     // Advance _node to next valid (of type T) if needed
     // Similar logic to operator++ but applies _filter->isMatch()
     while (_node != nullptr && (dynamic_cast<const T*>(_node) == nullptr ||
-                                !_filter.isMatch(*_node) ||
-                                (_node == _root))){
-        if (_node->_memberSubcomponents.size() > 0) {
-            _node = _node->_memberSubcomponents[0].get();
-        }
-        else if (_node->_propertySubcomponents.size() > 0) {
-            _node = _node->_propertySubcomponents[0].get();
-        }
-        else if (_node->_adoptedSubcomponents.size() > 0) {
-            _node = _node->_adoptedSubcomponents[0].get();
-        }
-        else {
-            if (_node->_nextComponent.get() == _root->_nextComponent.get()){ // end of subtree under _root
-                _node = nullptr;
-                continue;
-            }
-            _node = _node->_nextComponent.get();
-        }
+                                !_filter.isMatch(*_node))) {
+        ++_index;
+        _node = _index < _traversal->size() ? (*_traversal)[_index] : nullptr;
     }
-    return;
 }
 
 
@@ -0,0 +1,125 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  ComponentConcurrencyChecker.cpp                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentConcurrencyChecker.h"
+#include "Component.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+using namespace OpenSim;
+
+namespace {
+    bool getEnabledFromEnvironment() {
+        const char* var = std::getenv("OPENSIM_CHECK_CONCURRENCY");
+        return var && std::string(var) == "1";
+    }
+    std::atomic<bool> checkerEnabled(getEnabledFromEnvironment());
+
+    // The accesses in progress to one tree.
+    struct TreeAccess {
+        // Number of uses in progress, by thread.
+        std::unordered_map<std::thread::id, int> users;
+        std::thread::id modifier;
+        int numModifications = 0;
+        const char* modification = nullptr;
+    };
+    std::mutex accessMutex;
+    std::unordered_map<const Component*, TreeAccess>& getAccesses() {
+        static std::unordered_map<const Component*, TreeAccess> accesses;
+        return accesses;
+    }
+
+    bool isUsedByOtherThread(const TreeAccess& access, std::thread::id self) {
+        for (const auto& user : access.users) {
+            if (user.first != self && user.second > 0) return true;
+        }
+        return false;
+    }
+}
+
+void ComponentConcurrencyChecker::setEnabled(bool enabled) {
+    checkerEnabled = enabled;
+}
+
+bool ComponentConcurrencyChecker::isEnabled() {
+    return checkerEnabled;
+}
+
+ComponentConcurrencyChecker::Scope::Scope(Access access,
+        const Component& component, const char* operation)
+        : m_access(access) {
+    if (!checkerEnabled.load(std::memory_order_relaxed)) return;
+    const Component& root = component.getRoot();
+    const auto self = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(accessMutex);
+    TreeAccess& tree = getAccesses()[&root];
+    const bool modifiedByOtherThread =
+            tree.numModifications > 0 && tree.modifier != self;
+    if (access == Access::Use) {
+        OPENSIM_THROW_IF(modifiedByOtherThread, ConcurrentComponentAccess,
+                fmt::format("Component '{}' calls {}() while another thread "
+                            "modifies its tree (root '{}') in {}().",
+                        component.getAbsolutePathString(), operation,
+                        root.getName(), tree.modification));
+        ++tree.users[self];
+    } else {
+        OPENSIM_THROW_IF(modifiedByOtherThread, ConcurrentComponentAccess,
+                fmt::format("Component '{}' is modified in {}() while another "
+                            "thread modifies its tree (root '{}') in {}().",
+                        component.getAbsolutePathString(), operation,
+                        root.getName(), tree.modification));
+        OPENSIM_THROW_IF(isUsedByOtherThread(tree, self),
+                ConcurrentComponentAccess,
+                fmt::format("Component '{}' is modified in {}() while another "
+                            "thread uses its tree (root '{}').",
+                        component.getAbsolutePathString(), operation,
+                        root.getName()));
+        if (tree.numModifications++ == 0) {
+            tree.modifier = self;
+            tree.modification = operation;
+        }
+    }
+    m_root = &root;
+}
+
+ComponentConcurrencyChecker::Scope::~Scope() {
+    if (!m_root) return;
+    std::lock_guard<std::mutex> lock(accessMutex);
+    auto& accesses = getAccesses();
+    auto it = accesses.find(m_root);
+    if (it == accesses.end()) return;
+    TreeAccess& tree = it->second;
+    if (m_access == Access::Use) {
+        auto user = tree.users.find(std::this_thread::get_id());
+        if (user != tree.users.end() && --user->second == 0) {
+            tree.users.erase(user);
+        }
+    } else if (tree.numModifications > 0) {
+        --tree.numModifications;
+    }
+    if (tree.users.empty() && tree.numModifications == 0) {
+        accesses.erase(it);
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef OPENSIM_COMPONENT_CONCURRENCY_CHECKER_H_
+#define OPENSIM_COMPONENT_CONCURRENCY_CHECKER_H_
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  ComponentConcurrencyChecker.h                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Exception.h"
+#include "osimCommonDLL.h"
+#include <string>
+
+namespace OpenSim {
+
+class Component;
+
+/** Thrown by ComponentConcurrencyChecker when a component tree is modified by
+one thread while another thread is using or modifying it. */
+class ConcurrentComponentAccess : public Exception {
+public:
+    ConcurrentComponentAccess(const std::string& file, size_t line,
+            const std::string& func, const std::string& message)
+            : Exception(file, line, func) {
+        addMessage(message);
+    }
+};
+
+/** A debugging aid that detects when a component tree (e.g., a Model) that is
+shared by multiple threads is modified by one thread while another thread is
+using or modifying it. Such races corrupt the tree or produce wrong results
+without any other indication; a typical cause is calling initSystem() or
+editing a model while the same model is being simulated on another thread.
+Engines that use multiple threads either give each thread its own copy of the
+model (e.g., MocoCasADiSolver, ManagerEnsemble, the parallel AnalyzeTool) or
+share the model only if it is thread-safe (see Component::isThreadSafe()).
+
+The checker tracks the following:
+- uses: the realize methods of each component, from extendRealizeTime() to
+  extendRealizeReport();
+- modifications: Component::finalizeFromProperties(),
+  Component::finalizeConnections(), Component::addToSystem() (and therefore
+  Model::initSystem()), and Component::addComponent().
+
+When a modification starts while another thread uses or modifies the same
+tree (or a use starts while another thread modifies it), a
+ConcurrentComponentAccess exception is thrown in the thread that detects the
+conflict. Detection is not guaranteed, since both accesses must overlap in
+time, but any detected conflict is a genuine race.
+
+The checker is disabled by default, in which case the overhead is one atomic
+load per tracked call. Enable it with setEnabled(), or by setting the
+environment variable OPENSIM_CHECK_CONCURRENCY to 1. While enabled, every
+tracked call locks a global mutex, so only use it for debugging. */
+class OSIMCOMMON_API ComponentConcurrencyChecker {
+public:
+    ComponentConcurrencyChecker() = delete;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    enum class Access { Use, Modify };
+
+    /** Record an access to the tree that contains `component` for the
+    lifetime of this object. `operation` (e.g., "finalizeFromProperties") is
+    used in error messages and must outlive this object. */
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(Access access, const Component& component,
+                const char* operation);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Access m_access;
+        const Component* m_root = nullptr;
+    };
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_CONCURRENCY_CHECKER_H_
@@ -26,8 +26,10 @@
 
 // INCLUDES
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 #include "SimTKcommon/basics.h"
 
 namespace OpenSim {
@@ -103,10 +105,11 @@ iterator pointing to the first entry in the list then increment the iterator
 until end(). 
 The linked list is formed by tree pre-order traversal where each component is 
 visited followed by all its immediate subcomponents (recursively).
-@internal The traversal order is wired via
-    Component::initComponentTreeTraversal(), which is called just before
-    getting a ComponentList from a Component, either via
-    Component::getComponentList() or Component::updComponentList().
+@internal The traversal is a flat list of the root's descendants, built by
+    Component::initComponentTreeTraversal() the first time a ComponentList is
+    created for the root and shared by all later lists until the tree of
+    components under the root changes. Iterating is then a linear scan of
+    that list.
 */
 template <typename T>
 class ComponentList {
@@ -136,16 +139,12 @@ public:
     using the setFilter() method. The filter is cloned on
     construction and can only be changed using setFilter().
     */
-    ComponentList(const Component& root, const ComponentFilter& f) : 
-        _root(root), _filter(f) {
-    }
+    ComponentList(const Component& root, const ComponentFilter& f);
     /** Constructor that takes only a Component to iterate over (itself and its
     descendants). ComponentFilterMatchAll is used internally. You can
     change the filter using setFilter() method. 
     */
-    ComponentList(const Component& root) : _root(root) {
-        setDefaultFilter();
-    }
+    ComponentList(const Component& root);
     /// Destructor of ComponentList.
     virtual ~ComponentList() {}
     /** Return an iterator pointing to the first component in the tree 
@@ -153,17 +152,17 @@ public:
     to the ComponentList constructor. If T is non-const, then this iterator
     allows you to modify the elements of this list. */
     iterator begin() {
-        return iterator(&_root, _filter.getRef());
+        return iterator(_traversal.get(), _filter.getRef());
     }
     /** Same as cbegin(). */
     const_iterator begin() const {
-        return const_iterator(&_root, _filter.getRef());
+        return const_iterator(_traversal.get(), _filter.getRef());
     }
     /** Similar to begin(), except it does not permit
     modifying the elements of the list, even if T is non-const (e.g., 
     ComponentList<Body>). */
     const_iterator cbegin() const {
-        return const_iterator(&_root, _filter.getRef());
+        return const_iterator(_traversal.get(), _filter.getRef());
     }
     /** Use this method to check if you have reached the end of the list.
     This points past the end of the list, *not* to the last item in the
@@ -186,6 +185,9 @@ public:
     }
 private:
     const Component& _root; // root of subtree to be iterated over
+    // descendants of _root, shared with _root (see
+    // Component::getComponentTraversal())
+    std::shared_ptr<const std::vector<const Component*>> _traversal;
     SimTK::ClonePtr<ComponentFilter> _filter; // filter to choose components 
     // Internal method to setFilter to ComponentFilterMatchAll if no user specified
     // filter is provided.
@@ -330,7 +332,8 @@ public:
     ComponentListIterator(const ComponentListIterator<FromT>& source,
         typename std::enable_if<std::is_convertible<FromT*, T*>::value>::type* = 0) :
         _node(source._node),
-        _root(source._root),
+        _traversal(source._traversal),
+        _index(source._index),
         _filter(source._filter)
     {/*No need to advanceToNextValid; was done when source was constructed.*/}
     
@@ -351,20 +354,21 @@ private:
     // advanceToNextValidComponent(), etc. So instead, we cast away the const
     // just before giving the node to the user (operator*() and operator->()).
     const Component* _node;
-    // Root of subtree of Components that we're iterating over.
-    const Component* _root = nullptr;
-    /** Optional filter to further select Components under _root, defaults to
-    Filter by type. */
+    // Pre-order list of the Components that we're iterating over (owned by
+    // the ComponentList), and the position of _node in that list.
+    const std::vector<const Component*>* _traversal;
+    size_t _index = 0;
+    /** Optional filter to further select Components under the root, defaults
+    to Filter by type. */
     const ComponentFilter& _filter;
     
-    /** Constructor that takes a Component and ComponentFilter.
-     The iterator contains a const ref to filter and doesn't take ownership
-     of it. A pointer is used since iterator at end() doesn't have a valid
-     Component underneath it. */
-    ComponentListIterator(const Component* node,
+    /** Constructor that takes the list of Components to iterate over and a
+     ComponentFilter. The iterator contains a const ref to filter and doesn't
+     take ownership of it. A null list gives the iterator at end(). */
+    ComponentListIterator(const std::vector<const Component*>* traversal,
                           const ComponentFilter& filter) :
-        _node(node),
-        _root(node),
+        _node(traversal && !traversal->empty() ? (*traversal)[0] : nullptr),
+        _traversal(traversal),
         _filter(filter) {
         advanceToNextValidComponent(); // in case node is not a match.
     }
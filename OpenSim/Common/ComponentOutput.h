@@ -36,6 +36,7 @@
 
 #include <functional>
 #include <map>
+#include <vector>
 
 #include <SimTKcommon/internal/Stage.h>
 #include <SimTKcommon/internal/State.h>
@@ -145,6 +146,17 @@ public:
     void         setNumberOfSignificantDigits(unsigned int numSigFigs) 
     { _numSigFigs = numSigFigs; }
 
+    /** For an Output whose value is a vector (e.g., SimTK::Vector), a label
+     * for each element of the vector, such as the names of the muscles for a
+     * vector of muscle forces. Reporters that consume the whole vector in one
+     * call (e.g., TableReporterVector) use these labels to name the columns.
+     * The owning Component should set the labels in
+     * extendFinalizeFromProperties() or extendConnectToModel(). */
+    const std::vector<std::string>& getElementLabels() const
+    {   return _elementLabels; }
+    void setElementLabels(std::vector<std::string> labels)
+    {   _elementLabels = std::move(labels); }
+
 protected:
 
     // Set the component that contains this Output.
@@ -159,6 +171,7 @@ private:
     SimTK::Stage dependsOnStage;
     unsigned int _numSigFigs = 8;
     bool _isList = false;
+    std::vector<std::string> _elementLabels;
 
     // For calling setOwner().
     friend Component;
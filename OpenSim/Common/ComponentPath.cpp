@@ -270,6 +270,10 @@ ComponentPath::ComponentPath(std::string path) :
     _path{normalize(std::move(path))} {
 }
 
+ComponentPath::ComponentPath(std::string normalizedPath, AlreadyNormalized) :
+    _path{std::move(normalizedPath)} {
+}
+
 ComponentPath::ComponentPath(const std::vector<std::string>& pathVec,
                              bool isAbsolute) :
     _path{normalize(stringifyPath(pathVec, isAbsolute))} {
@@ -336,20 +340,26 @@ ComponentPath ComponentPath::formRelativePath(const ComponentPath& otherPath) co
     // handle edge cases: see test suite for example inputs
     ComponentPath rv;
 
+    // note: p1 and p2 are normalized, so each result below (leading step
+    //       ups followed by a tail of p2) is normalized once a trailing
+    //       separator left by the step ups is removed
     if (p1[mismatch] == nul && p2[mismatch] == nul) {
         // p1 == p2
-        rv = ComponentPath{""};
+        rv = ComponentPath{};
     } else if (p1.size() == 1 && p1[0] == separator) {
         // p1 is just "/", p2 is defined to be a direct subpath beginning after
         // the "/"
-        rv = ComponentPath{p2.substr(1)};
+        rv = ComponentPath{p2.substr(1), AlreadyNormalized{}};
     } else if (p1[mismatch] == nul && p2[mismatch] == separator) {
         // p2 is a direct subpath of p1, so only step down
-        rv = ComponentPath{p2.substr(mismatch + 1)};
+        rv = ComponentPath{p2.substr(mismatch + 1), AlreadyNormalized{}};
     } else if (p1[mismatch] == separator && p2[mismatch] == nul) {
         // p1 is a direct subpath of p2, so only step up
         size_t stepUps = std::count(p1.begin() + mismatch, p1.end(), separator);
-        rv = ComponentPath{generateStepUps(stepUps)};
+        std::string path = generateStepUps(stepUps);
+        path.pop_back();  // trailing separator
+
+        rv = ComponentPath{std::move(path), AlreadyNormalized{}};
     } else {
         // There is a divergence between the two paths. Step up to the
         // divergence point (dir) then step down to the target
@@ -358,16 +368,20 @@ ComponentPath ComponentPath::formRelativePath(const ComponentPath& otherPath) co
         // step up in p1 and then step down in p2
         size_t stepUps = std::count(p1.begin() + divergencePoint, p1.end(), separator);
         std::string path = generateStepUps(stepUps);
-        path += p2.substr(divergencePoint + 1);
+        path.append(p2, divergencePoint + 1, std::string::npos);
+        if (path.back() == separator) {
+            path.pop_back();  // p2 is "/"
+        }
 
-        rv = ComponentPath{std::move(path)};
+        rv = ComponentPath{std::move(path), AlreadyNormalized{}};
     }
 
     return rv;
 }
 
 OpenSim::ComponentPath OpenSim::ComponentPath::getParentPath() const {
-    return ComponentPath{getParentPathString()};
+    // the parent of a normalized path is normalized
+    return ComponentPath{getParentPathString(), AlreadyNormalized{}};
 }
 
 std::string ComponentPath::getParentPathString() const {
@@ -409,6 +423,25 @@ std::string ComponentPath::getSubcomponentNameAtLevel(size_t index) const {
     return std::string{firstComponent, componentEnd};
 }
 
+bool ComponentPath::nextPathElement(size_t& pos, std::string& element) const {
+    if (pos == 0 && isAbsolute()) {
+        pos = 1;
+    }
+
+    if (pos >= _path.size()) {
+        return false;
+    }
+
+    size_t end = _path.find(separator, pos);
+    if (end == std::string::npos) {
+        end = _path.size();
+    }
+
+    element.assign(_path, pos, end - pos);
+    pos = end + 1;  // skip past the found separator (if any)
+    return true;
+}
+
 std::string ComponentPath::getComponentName() const {
     if (firstComponentIn(_path) == _path.end()) {
         return {};
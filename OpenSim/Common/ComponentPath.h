@@ -25,6 +25,7 @@
 
 #include "osimCommonDLL.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,11 @@ class OSIMCOMMON_API ComponentPath {
 private:
     std::string _path;
 
+    // Wraps a string that is already normalized (e.g., a sub-path of a
+    // normalized path), skipping normalization.
+    struct AlreadyNormalized {};
+    ComponentPath(std::string normalizedPath, AlreadyNormalized);
+
 public:
     /**
      * Default constructor that constructs an empty path ("").
@@ -118,6 +124,22 @@ public:
      */
     std::string getSubcomponentNameAtLevel(size_t index) const;
 
+    /**
+     * Visits the path elements in order. `pos` is the position in the path
+     * string at which to continue; start with `pos = 0`. If there is another
+     * element, this assigns it to `element`, advances `pos` past it and
+     * returns true; otherwise, it returns false.
+     *
+     * Unlike getSubcomponentNameAtLevel(), which scans from the start of the
+     * path and returns a new string, this visits each element once and
+     * reuses the storage of `element`:
+     *
+     *     std::string element;
+     *     size_t pos = 0;
+     *     while (path.nextPathElement(pos, element)) { ... }
+     */
+    bool nextPathElement(size_t& pos, std::string& element) const;
+
     /**
      * Returns the name of the Component in the path (effectively, the last
      * element in the path).
@@ -153,6 +175,12 @@ public:
      */
     bool isLegalPathElement(const std::string& pathElement) const;
 
+    /**
+     * Returns a hash of the path. Equal paths have equal hashes, so a
+     * ComponentPath can be used as the key of a std::unordered_map.
+     */
+    size_t getHash() const { return std::hash<std::string>()(_path); }
+
     /**
      * Resolves '.' and ".." elements in the path if possible. Leading ".."
      * elements are allowed only in relative paths (throws if found at the
@@ -166,4 +194,13 @@ public:
     }
 };
 } // end of namespace OpenSim
+
+namespace std {
+template <>
+struct hash<OpenSim::ComponentPath> {
+    size_t operator()(const OpenSim::ComponentPath& path) const {
+        return path.getHash();
+    }
+};
+} // end of namespace std
 #endif // OPENSIM_COMPONENT_PATH_H_
@@ -0,0 +1,133 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  ComponentPhaseProfiler.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentPhaseProfiler.h"
+#include "Component.h"
+#include "Exception.h"
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+    // A thread-local variable cannot be a member of an exported class.
+    thread_local ComponentPhaseProfiler* activeProfiler = nullptr;
+}
+
+std::string ComponentPhaseProfiler::getPhaseName(Phase phase) {
+    switch (phase) {
+    case Phase::FinalizeFromProperties: return "finalizeFromProperties";
+    case Phase::FinalizeConnections: return "finalizeConnections";
+    case Phase::AddToSystem: return "addToSystem";
+    case Phase::InitStateFromProperties: return "initStateFromProperties";
+    }
+    return "unknown";
+}
+
+ComponentPhaseProfiler::~ComponentPhaseProfiler() {
+    if (isActive()) stop();
+}
+
+void ComponentPhaseProfiler::start() {
+    OPENSIM_THROW_IF(activeProfiler && activeProfiler != this, Exception,
+            "Another ComponentPhaseProfiler is already active on this "
+            "thread.");
+    activeProfiler = this;
+    m_nestedTimes.clear();
+}
+
+void ComponentPhaseProfiler::stop() {
+    if (activeProfiler == this) activeProfiler = nullptr;
+}
+
+bool ComponentPhaseProfiler::isActive() const {
+    return activeProfiler == this;
+}
+
+std::vector<ComponentPhaseProfiler::Entry>
+        ComponentPhaseProfiler::getEntries() const {
+    std::vector<Entry> entries;
+    for (const auto& entry : m_entries) entries.push_back(entry.second);
+    std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+                return a.seconds > b.seconds;
+            });
+    return entries;
+}
+
+double ComponentPhaseProfiler::getTotalSeconds(Phase phase) const {
+    double total = 0;
+    for (const auto& entry : m_entries) {
+        if (entry.first.first == phase) total += entry.second.seconds;
+    }
+    return total;
+}
+
+void ComponentPhaseProfiler::printResults(int maxRows) const {
+    for (Phase phase : {Phase::FinalizeFromProperties,
+                 Phase::FinalizeConnections, Phase::AddToSystem,
+                 Phase::InitStateFromProperties}) {
+        log_info("{:<24} {:10.3f} ms", getPhaseName(phase),
+                1000.0 * getTotalSeconds(phase));
+    }
+    const auto entries = getEntries();
+    if (entries.empty()) return;
+    std::size_t width = 5;
+    for (const auto& entry : entries) {
+        width = std::max(width, entry.className.size());
+    }
+    log_info("{:<24} {:<{}} {:>7} {:>13}", "phase", "class", width, "count",
+            "time");
+    const int numRows = std::min((int)entries.size(), maxRows);
+    for (int i = 0; i < numRows; ++i) {
+        const Entry& entry = entries[i];
+        log_info("{:<24} {:<{}} {:>7} {:10.3f} ms", getPhaseName(entry.phase),
+                entry.className, width, entry.count, 1000.0 * entry.seconds);
+    }
+}
+
+ComponentPhaseProfiler::Scope::Scope(Phase phase, const Component& component)
+        : m_profiler(activeProfiler), m_phase(phase),
+          m_component(&component) {
+    if (!m_profiler) return;
+    m_profiler->m_nestedTimes.push_back(0);
+    m_startTime = SimTK::realTimeInNs();
+}
+
+ComponentPhaseProfiler::Scope::~Scope() {
+    // The profiler may have been stopped (or destroyed) within this scope.
+    if (!m_profiler || m_profiler != activeProfiler) return;
+    const long long elapsed = SimTK::realTimeInNs() - m_startTime;
+    auto& nestedTimes = m_profiler->m_nestedTimes;
+    if (nestedTimes.empty()) return;
+    const long long nested = nestedTimes.back();
+    nestedTimes.pop_back();
+    if (!nestedTimes.empty()) nestedTimes.back() += elapsed;
+
+    const std::string& className = m_component->getConcreteClassName();
+    Entry& entry = m_profiler->m_entries[Key(m_phase, className)];
+    if (entry.count == 0) {
+        entry.phase = m_phase;
+        entry.className = className;
+    }
+    ++entry.count;
+    entry.seconds += SimTK::nsToSec(elapsed - nested);
+}
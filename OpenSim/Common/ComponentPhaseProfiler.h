@@ -0,0 +1,123 @@
+#ifndef OPENSIM_COMPONENT_PHASE_PROFILER_H_
+#define OPENSIM_COMPONENT_PHASE_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  ComponentPhaseProfiler.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+/** Measure the time that a model spends in each phase of initializing its
+System (finalizeFromProperties(), finalizeConnections(), addToSystem(), and
+initStateFromProperties()), per concrete Component class. The time recorded
+for a component excludes the time spent in the same or other phases of its
+subcomponents, so the times of all classes add up to the time of the phase.
+
+Only the phases invoked on the thread that called start() are recorded, and
+only one profiler can be active on a thread at a time.
+
+@code
+ComponentPhaseProfiler profiler;
+profiler.start();
+model.initSystem();
+profiler.stop();
+profiler.printResults();
+@endcode
+
+Model::setProfileInitSystem() does this for every call to
+Model::initSystem(). */
+class OSIMCOMMON_API ComponentPhaseProfiler {
+public:
+    enum class Phase {
+        FinalizeFromProperties,
+        FinalizeConnections,
+        AddToSystem,
+        InitStateFromProperties
+    };
+    static std::string getPhaseName(Phase phase);
+
+    /** The time spent by all components of one class in one phase. */
+    struct Entry {
+        Phase phase;
+        std::string className;
+        /// The number of times the phase was invoked on a component of this
+        /// class.
+        int count = 0;
+        double seconds = 0;
+    };
+
+    ComponentPhaseProfiler() = default;
+    ComponentPhaseProfiler(const ComponentPhaseProfiler&) = delete;
+    ComponentPhaseProfiler& operator=(const ComponentPhaseProfiler&) = delete;
+    /** Stops the profiler if it is still active. */
+    ~ComponentPhaseProfiler();
+
+    /** Start recording on this thread. Results from previous recordings are
+    kept; see clear(). */
+    void start();
+    /** Stop recording. */
+    void stop();
+    bool isActive() const;
+    void clear() { m_entries.clear(); }
+
+    /** The recorded entries, ordered from the longest to the shortest
+    time. */
+    std::vector<Entry> getEntries() const;
+    /** The total time spent in a phase by all components. */
+    double getTotalSeconds(Phase phase) const;
+
+    /** Log (at the info level) the total time of each phase, followed by
+    the `maxRows` entries with the longest times. */
+    void printResults(int maxRows = 20) const;
+
+    /** Time the enclosing scope as a phase of the given component if a
+    profiler is active on this thread; otherwise, this does nothing. This is
+    used by Component. */
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(Phase phase, const Component& component);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        ComponentPhaseProfiler* m_profiler;
+        Phase m_phase;
+        const Component* m_component;
+        long long m_startTime = 0;
+    };
+
+private:
+    using Key = std::pair<Phase, std::string>;
+    std::map<Key, Entry> m_entries;
+    // Time spent in the scopes nested in each of the currently open scopes.
+    std::vector<long long> m_nestedTimes;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_PHASE_PROFILER_H_
@@ -0,0 +1,243 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  ComponentRealizeProfiler.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentRealizeProfiler.h"
+#include "Component.h"
+#include "Exception.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+using namespace OpenSim;
+
+namespace {
+    // Profilers that are attached, by root component. The mutex also guards
+    // the entries of all profilers.
+    std::atomic<int> numProfilers(0);
+    std::mutex profilerMutex;
+    std::unordered_map<const Component*, ComponentRealizeProfiler*>&
+            getProfilers() {
+        static std::unordered_map<const Component*, ComponentRealizeProfiler*>
+                profilers;
+        return profilers;
+    }
+
+    const std::vector<ComponentRealizeProfiler::Section>& getSections() {
+        using Section = ComponentRealizeProfiler::Section;
+        static const std::vector<Section> sections{Section::RealizeTopology,
+                Section::RealizeModel, Section::RealizeInstance,
+                Section::RealizeTime, Section::RealizePosition,
+                Section::RealizeVelocity, Section::RealizeDynamics,
+                Section::RealizeAcceleration, Section::RealizeReport,
+                Section::ComputeForce, Section::ComputeControls};
+        return sections;
+    }
+
+    void sortByTime(std::vector<ComponentRealizeProfiler::Entry>& entries) {
+        std::stable_sort(entries.begin(), entries.end(),
+                [](const ComponentRealizeProfiler::Entry& a,
+                        const ComponentRealizeProfiler::Entry& b) {
+                    return a.seconds > b.seconds;
+                });
+    }
+}
+
+std::string ComponentRealizeProfiler::getSectionName(Section section) {
+    switch (section) {
+    case Section::RealizeTopology: return "realizeTopology";
+    case Section::RealizeModel: return "realizeModel";
+    case Section::RealizeInstance: return "realizeInstance";
+    case Section::RealizeTime: return "realizeTime";
+    case Section::RealizePosition: return "realizePosition";
+    case Section::RealizeVelocity: return "realizeVelocity";
+    case Section::RealizeDynamics: return "realizeDynamics";
+    case Section::RealizeAcceleration: return "realizeAcceleration";
+    case Section::RealizeReport: return "realizeReport";
+    case Section::ComputeForce: return "computeForce";
+    case Section::ComputeControls: return "computeControls";
+    }
+    return "unknown";
+}
+
+ComponentRealizeProfiler::ComponentRealizeProfiler(const Component& root)
+        : m_root(&root) {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    auto& profilers = getProfilers();
+    OPENSIM_THROW_IF(profilers.count(m_root), Exception,
+            "Component '{}' already has a ComponentRealizeProfiler.",
+            root.getName());
+    profilers[m_root] = this;
+    ++numProfilers;
+}
+
+ComponentRealizeProfiler::~ComponentRealizeProfiler() {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    getProfilers().erase(m_root);
+    --numProfilers;
+}
+
+void ComponentRealizeProfiler::clear() {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    m_entries.clear();
+}
+
+void ComponentRealizeProfiler::record(
+        Section section, const Component& component, long long ns) {
+    Entry& entry = m_entries[Key(&component, (int)section)];
+    if (entry.count == 0) {
+        entry.section = section;
+        entry.path = component.getAbsolutePathString();
+        entry.className = component.getConcreteClassName();
+    }
+    ++entry.count;
+    entry.seconds += SimTK::nsToSec(ns);
+}
+
+std::vector<ComponentRealizeProfiler::Entry>
+        ComponentRealizeProfiler::getEntriesUnlocked() const {
+    std::vector<Entry> entries;
+    entries.reserve(m_entries.size());
+    for (const auto& entry : m_entries) entries.push_back(entry.second);
+    // Break ties (and make the order reproducible) by path and section.
+    std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+                if (a.path != b.path) return a.path < b.path;
+                return a.section < b.section;
+            });
+    sortByTime(entries);
+    return entries;
+}
+
+std::vector<ComponentRealizeProfiler::Entry>
+        ComponentRealizeProfiler::getEntries() const {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    return getEntriesUnlocked();
+}
+
+std::vector<ComponentRealizeProfiler::Entry>
+        ComponentRealizeProfiler::getEntriesByClass() const {
+    std::map<std::pair<std::string, int>, Entry> byClass;
+    for (const auto& entry : getEntries()) {
+        Entry& sum = byClass[{entry.className, (int)entry.section}];
+        if (sum.count == 0) {
+            sum.section = entry.section;
+            sum.className = entry.className;
+        }
+        sum.count += entry.count;
+        sum.seconds += entry.seconds;
+    }
+    std::vector<Entry> entries;
+    for (const auto& entry : byClass) entries.push_back(entry.second);
+    sortByTime(entries);
+    return entries;
+}
+
+double ComponentRealizeProfiler::getTotalSeconds(Section section) const {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    double total = 0;
+    for (const auto& entry : m_entries) {
+        if (entry.second.section == section) total += entry.second.seconds;
+    }
+    return total;
+}
+
+TimeSeriesTable ComponentRealizeProfiler::getAsTable() const {
+    const auto entries = getEntries();
+    std::vector<std::string> labels;
+    SimTK::Matrix values(2, (int)entries.size());
+    for (int i = 0; i < (int)entries.size(); ++i) {
+        labels.push_back(
+                entries[i].path + ":" + getSectionName(entries[i].section));
+        values(0, i) = (double)entries[i].count;
+        values(1, i) = entries[i].seconds;
+    }
+    TimeSeriesTable table(std::vector<double>{0, 1}, values, labels);
+    table.addTableMetaData<std::string>("rows", "count,seconds");
+    return table;
+}
+
+std::string ComponentRealizeProfiler::getFoldedStacks() const {
+    std::ostringstream stacks;
+    for (const auto& entry : getEntries()) {
+        // The root's absolute path is "/"; name it after the root instead.
+        stacks << m_root->getName();
+        std::istringstream path(entry.path);
+        std::string element;
+        while (std::getline(path, element, '/')) {
+            if (!element.empty()) stacks << ";" << element;
+        }
+        stacks << ";" << getSectionName(entry.section) << " "
+               << (long long)std::round(1e6 * entry.seconds) << "\n";
+    }
+    return stacks.str();
+}
+
+void ComponentRealizeProfiler::printResults(int maxRows) const {
+    for (Section section : getSections()) {
+        log_info("{:<20} {:10.3f} ms", getSectionName(section),
+                1000.0 * getTotalSeconds(section));
+    }
+    const auto byClass = getEntriesByClass();
+    const auto entries = getEntries();
+    if (entries.empty()) return;
+    std::size_t width = 9;
+    for (const auto& entry : entries) {
+        width = std::max(width, entry.path.size());
+    }
+    log_info("{:<20} {:<{}} {:>10} {:>13}", "section", "class", width,
+            "count", "time");
+    for (int i = 0; i < std::min((int)byClass.size(), maxRows); ++i) {
+        const Entry& entry = byClass[i];
+        log_info("{:<20} {:<{}} {:>10} {:10.3f} ms",
+                getSectionName(entry.section), entry.className, width,
+                entry.count, 1000.0 * entry.seconds);
+    }
+    log_info("{:<20} {:<{}} {:>10} {:>13}", "section", "component", width,
+            "count", "time");
+    for (int i = 0; i < std::min((int)entries.size(), maxRows); ++i) {
+        const Entry& entry = entries[i];
+        log_info("{:<20} {:<{}} {:>10} {:10.3f} ms",
+                getSectionName(entry.section), entry.path, width,
+                entry.count, 1000.0 * entry.seconds);
+    }
+}
+
+ComponentRealizeProfiler::Scope::Scope(
+        Section section, const Component& component)
+        : m_section(section), m_component(&component) {
+    if (numProfilers.load(std::memory_order_relaxed) == 0) return;
+    m_startTime = SimTK::realTimeInNs();
+}
+
+ComponentRealizeProfiler::Scope::~Scope() {
+    if (m_startTime == 0) return;
+    const long long elapsed = SimTK::realTimeInNs() - m_startTime;
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    const auto& profilers = getProfilers();
+    const auto it = profilers.find(&m_component->getRoot());
+    if (it != profilers.end()) {
+        it->second->record(m_section, *m_component, elapsed);
+    }
+}
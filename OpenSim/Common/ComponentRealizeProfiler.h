@@ -0,0 +1,154 @@
+#ifndef OPENSIM_COMPONENT_REALIZE_PROFILER_H_
+#define OPENSIM_COMPONENT_REALIZE_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  ComponentRealizeProfiler.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "TimeSeriesTable.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+
+/** Measure the number of calls and the wall time spent in the realize()
+methods (extendRealizeTopology(), ..., extendRealizeReport()) of every
+component in a tree, as well as in Force::computeForce() and
+Controller::computeControls(). The times are inclusive: the time of a
+computeControls() call that happens within a computeForce() (e.g., a muscle
+getting its excitation) is counted in both. Computations performed directly
+by Simbody (e.g., the multibody dynamics) are not attributed to any
+component.
+
+Calls are recorded for the root component (usually a Model) passed to
+the constructor, and for all of its descendants, on any thread, until the
+profiler is destroyed. Copies of the root are not profiled. While no
+profiler exists, the overhead is a single atomic load per call.
+
+@code
+ComponentRealizeProfiler profiler(model);
+manager.integrate(1.0);
+profiler.printResults();
+std::ofstream("profile.folded") << profiler.getFoldedStacks();
+@endcode
+
+Model::setProfileRealize() creates a profiler for a Model. */
+class OSIMCOMMON_API ComponentRealizeProfiler {
+public:
+    enum class Section {
+        RealizeTopology,
+        RealizeModel,
+        RealizeInstance,
+        RealizeTime,
+        RealizePosition,
+        RealizeVelocity,
+        RealizeDynamics,
+        RealizeAcceleration,
+        RealizeReport,
+        ComputeForce,
+        ComputeControls
+    };
+    static std::string getSectionName(Section section);
+
+    /** The calls to one section of one component or, from
+    getEntriesByClass(), of all components of one class (`path` is then
+    empty). */
+    struct Entry {
+        Section section;
+        std::string path;
+        std::string className;
+        long long count = 0;
+        double seconds = 0;
+    };
+
+    /** Start recording the calls of `root` and its descendants. Only one
+    profiler can be attached to a component at a time. */
+    explicit ComponentRealizeProfiler(const Component& root);
+    ComponentRealizeProfiler(const ComponentRealizeProfiler&) = delete;
+    ComponentRealizeProfiler& operator=(
+            const ComponentRealizeProfiler&) = delete;
+    /** Stop recording. */
+    ~ComponentRealizeProfiler();
+
+    /** Discard the calls recorded so far. */
+    void clear();
+
+    /** One entry per component and section, ordered from the longest to the
+    shortest time. */
+    std::vector<Entry> getEntries() const;
+    /** One entry per concrete class and section, ordered from the longest to
+    the shortest time. */
+    std::vector<Entry> getEntriesByClass() const;
+    /** The total time spent in a section by all components. */
+    double getTotalSeconds(Section section) const;
+
+    /** The entries as a table with one column per entry, labeled
+    "<path>:<section>". The first row (time 0) holds the number of calls and
+    the second row (time 1) holds the time in seconds. */
+    TimeSeriesTable getAsTable() const;
+    /** The entries in the "folded stacks" format read by flame graph tools
+    (e.g., flamegraph.pl or speedscope): one line per entry with the path
+    elements and the section separated by semicolons, followed by the time in
+    microseconds. */
+    std::string getFoldedStacks() const;
+
+    /** Log (at the info level) the total time of each section, followed by
+    the `maxRows` entries (per class and per component) with the longest
+    times. */
+    void printResults(int maxRows = 20) const;
+
+    /** Time the enclosing scope as a section of the given component if a
+    profiler is attached to the component's root; otherwise, this does
+    nothing. This is used by Component, Force and Model. */
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(Section section, const Component& component);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Section m_section;
+        const Component* m_component;
+        long long m_startTime = 0;
+    };
+
+private:
+    void record(Section section, const Component& component, long long ns);
+    std::vector<Entry> getEntriesUnlocked() const;
+
+    const Component* m_root;
+    using Key = std::pair<const Component*, int>;
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<const Component*>()(key.first) * 31 +
+                   (std::size_t)key.second;
+        }
+    };
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_REALIZE_PROFILER_H_
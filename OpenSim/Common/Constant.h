@@ -89,6 +89,14 @@ public:
     {
         return _value;
     }
+    double calcValueAt(double, int* = nullptr) const override
+    {
+        return _value;
+    }
+    double calcDerivativeAt(double, int, int* = nullptr) const override
+    {
+        return 0;
+    }
     double getValue() const { return _value; }
     SimTK::Function* createSimTKFunction() const override;
 //=============================================================================
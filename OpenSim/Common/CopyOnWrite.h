@@ -0,0 +1,116 @@
+#ifndef OPENSIM_COPY_ON_WRITE_H_
+#define OPENSIM_COPY_ON_WRITE_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  CopyOnWrite.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <memory>
+#include <utility>
+
+namespace OpenSim {
+
+/** A value of type T that is shared between copies until one of them is
+modified. Copying a CopyOnWrite is O(1); the value is copied by upd() only if
+it is shared at that time. This is used by DataTable_ so that read-only copies
+of large tables (e.g., returned by value) do not duplicate the data.
+
+References returned by get() remain valid while this object is unchanged.
+Once a reference that allows modification must be handed out (e.g.,
+DataTable_::updMatrix()), use updUnshared(): the value is then copied
+whenever this object is copied, since the modifications made through that
+reference must not affect the copies.
+
+This class is not thread-safe: as with any other value, an object must not be
+copied on one thread while it is modified on another. Distinct copies that
+share a value may be used on different threads.
+
+@note This class is internal to OpenSim and is not wrapped. */
+template <typename T>
+class CopyOnWrite {
+public:
+    CopyOnWrite() = default;
+    explicit CopyOnWrite(T value)
+            : _value(std::make_shared<T>(std::move(value))) {}
+
+    CopyOnWrite(const CopyOnWrite& other)
+            : _value(other._shareable || !other._value
+                             ? other._value
+                             : std::make_shared<T>(*other._value)) {}
+    CopyOnWrite(CopyOnWrite&& other) noexcept
+            : _value(std::move(other._value)), _shareable(other._shareable) {
+        other._shareable = true;
+    }
+    CopyOnWrite& operator=(const CopyOnWrite& other) {
+        if (this != &other) *this = CopyOnWrite(other);
+        return *this;
+    }
+    CopyOnWrite& operator=(CopyOnWrite&& other) noexcept {
+        _value = std::move(other._value);
+        _shareable = other._shareable;
+        other._shareable = true;
+        return *this;
+    }
+    CopyOnWrite& operator=(T value) {
+        _value = std::make_shared<T>(std::move(value));
+        _shareable = true;
+        return *this;
+    }
+
+    /** The value (a default-constructed T if none has been set). */
+    const T& get() const {
+        if (!_value) {
+            static const T empty{};
+            return empty;
+        }
+        return *_value;
+    }
+
+    /** The value for modification, after copying it if it is shared. The
+    reference must not outlive the next copy of this object. */
+    T& upd() {
+        if (!_value) {
+            _value = std::make_shared<T>();
+        } else if (_value.use_count() > 1) {
+            _value = std::make_shared<T>(*_value);
+        }
+        return *_value;
+    }
+
+    /** Same as upd(), but the value is no longer shared with future copies,
+    so the reference remains valid (and does not affect the copies) for as
+    long as this object is not modified otherwise. */
+    T& updUnshared() {
+        T& value = upd();
+        _shareable = false;
+        return value;
+    }
+
+    /** Whether the value is currently shared with another copy. */
+    bool isShared() const { return _value && _value.use_count() > 1; }
+
+private:
+    std::shared_ptr<T> _value;
+    bool _shareable = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COPY_ON_WRITE_H_
@@ -1,7 +1,39 @@
 #include "Adapters.h"
 
+#include <algorithm>
+#include <regex>
+
 namespace OpenSim {
 
+std::vector<size_t>
+TableReadFilter::findColumns(const std::vector<std::string>& labels,
+                             const std::string& sourceName) const {
+    std::vector<size_t> indices;
+    if(keepsAllColumns()) {
+        for(size_t i = 0; i < labels.size(); ++i)
+            indices.push_back(i);
+        return indices;
+    }
+    for(const auto& label : columnLabels) {
+        OPENSIM_THROW_IF(
+                std::find(labels.begin(), labels.end(), label) == labels.end(),
+                Exception,
+                "Column '{}' (requested by the read filter) not found in "
+                "'{}'.", label, sourceName);
+    }
+    std::regex regex;
+    if(!columnLabelRegex.empty())
+        regex = std::regex(columnLabelRegex);
+    for(size_t i = 0; i < labels.size(); ++i) {
+        if(std::find(columnLabels.begin(), columnLabels.end(), labels[i]) !=
+                        columnLabels.end() ||
+                (!columnLabelRegex.empty() &&
+                        std::regex_match(labels[i], regex)))
+            indices.push_back(i);
+    }
+    return indices;
+}
+
 DataAdapter::RegisteredDataAdapters 
 DataAdapter::_registeredDataAdapters{};
 
@@ -27,11 +27,14 @@
 #include "osimCommonDLL.h"
 #include "Exception.h"
 #include "AbstractDataTable.h"
+#include "TraceRecorder.h"
 
 // Standard headers.
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 
 namespace OpenSim {
@@ -71,6 +74,45 @@ public:
         addMessage(msg);
     }
 };
+/** Restrict the columns and rows that DataAdapter::read() keeps. A column is
+kept if its label is listed in `columnLabels` or matches `columnLabelRegex`
+(ECMAScript syntax); if neither is set, all columns are kept. A row is kept
+if its independent (time) value is in [initialTime, finalTime].
+\code
+TableReadFilter filter;
+filter.columnLabelRegex = "ground_force_.*";
+filter.initialTime = 0.5;
+filter.finalTime = 1.5;
+TimeSeriesTable table("external_loads.mot", filter);
+\endcode                                                                     */
+struct OSIMCOMMON_API TableReadFilter {
+    /** Labels of the columns to keep.                                        */
+    std::vector<std::string> columnLabels;
+    /** Keep the columns whose label matches this regular expression.         */
+    std::string columnLabelRegex;
+    double initialTime = -std::numeric_limits<double>::infinity();
+    double finalTime = std::numeric_limits<double>::infinity();
+
+    /** Whether this filter keeps every column.                               */
+    bool keepsAllColumns() const {
+        return columnLabels.empty() && columnLabelRegex.empty();
+    }
+    /** Whether this filter keeps every row.                                  */
+    bool keepsAllRows() const {
+        return initialTime == -std::numeric_limits<double>::infinity() &&
+               finalTime == std::numeric_limits<double>::infinity();
+    }
+    bool keepsTime(double time) const {
+        return initialTime <= time && time <= finalTime;
+    }
+    /** Indices (in increasing order) of the given labels that this filter
+    keeps. `sourceName` is used in the error message.
+
+    \throws Exception If a label in `columnLabels` is not in `labels`.      */
+    std::vector<size_t> findColumns(const std::vector<std::string>& labels,
+                                    const std::string& sourceName) const;
+};
+
 /** DataAdapter is an abstract class defining an interface for reading/writing
 in/out the contents of a DataTable. It enables access to/from various data
 sources/sinks such as: streams, files, databases and devices. The DataTable
@@ -120,9 +162,24 @@ public:
 
     /** Public interface to read data from a dataSourceSpecification, typically a file or folder */
     DataAdapter::OutputTables read(const std::string& dataSourceSpecification) const {
+        OPENSIM_TRACE_SCOPE_DYNAMIC(
+                "read " + dataSourceSpecification, "io");
         return extendRead(dataSourceSpecification);
     }
 
+    /** Read only the columns and rows of the data source that the filter
+    keeps. Adapters that support filtering (the delimited text adapters, such
+    as for .sto, .mot and .csv files) do not parse or store the rest of the
+    data; the other adapters read all the data, and the filter must be applied
+    to the returned tables (the TimeSeriesTable_ constructor that takes a
+    filter does this).                                                        */
+    DataAdapter::OutputTables read(const std::string& dataSourceSpecification,
+                                   const TableReadFilter& filter) const {
+        OPENSIM_TRACE_SCOPE_DYNAMIC(
+                "read " + dataSourceSpecification, "io");
+        return extendReadFiltered(dataSourceSpecification, filter);
+    }
+
     /** Generic interface to retrieve a specific table by name from read result */
     const std::shared_ptr<AbstractDataTable> getDataTable(const OutputTables& tables, const std::string tableName) {
         if (tables.find(tableName) == tables.end()) {
@@ -142,6 +199,13 @@ protected:
     /** Implements reading functionality.                                    */
     virtual OutputTables extendRead(const std::string& sourceName) const = 0;
 
+    /** Implements reading with a filter. The default ignores the filter and
+    calls extendRead().                                                       */
+    virtual OutputTables extendReadFiltered(const std::string& sourceName,
+                                            const TableReadFilter&) const {
+        return extendRead(sourceName);
+    }
+
     /** Implements writing functionality.                                     */
     virtual void extendWrite(const InputTables& tables, 
                              const std::string& sinkName) const = 0;
@@ -22,10 +22,14 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <atomic>
 #include <queue>
 #include <condition_variable>
+#include <thread>
+#include <vector>
 #include <SimTKcommon.h>
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <OpenSim/Common/Exception.h>
 
 namespace OpenSim {
 
@@ -54,11 +58,12 @@ public:
     virtual ~DataQueueEntry_(){};
 
     double getTimeStamp() const { return _timeStamp; };
-    SimTK::RowVectorView_<U> getData() const { return _data; };
+    const SimTK::RowVector_<U>& getData() const { return _data; };
 
 private:
     double _timeStamp;
-    SimTK::RowVectorView_<U> _data;
+    // The entry owns a copy of the data.
+    SimTK::RowVector_<U> _data;
 };
 /**
  * DataQueue is a wrapper around the std::queue customized to handle data 
@@ -98,9 +103,8 @@ public:
     //--------------------------------------------------------------------------
     // push data and associated timestamp to the end of the queue
     void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
         std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
+        m_data_queue.push(DataQueueEntry_<T>(time, data));
         mlock.unlock();     // unlock before notificiation to minimize mutex con
         m_cond.notify_one(); 
     }
@@ -108,7 +112,7 @@ public:
     void pop_front(double& time, SimTK::RowVector_<T>& data) { 
         std::unique_lock<std::mutex> mlock(m_mutex);
         while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
+        DataQueueEntry_<T> frontEntry = m_data_queue.front();
         m_data_queue.pop();
         mlock.unlock(); 
         time = frontEntry.getTimeStamp();
@@ -131,6 +135,172 @@ private:
     //=============================================================================
 };  // END of class templatized DataQueue_<T>
 //=============================================================================
+
+/**
+ * A fixed-capacity, lock-free queue of timestamped rows for passing streamed
+ * data (e.g., IMU orientations) from a single producer thread to a single
+ * consumer thread. Unlike DataQueue_, the rows are stored in a ring buffer
+ * that is allocated once (when the buffer is constructed with a row width, or
+ * on the first push otherwise), so pushing and popping rows never allocates
+ * memory, takes a lock, or notifies a condition variable. All rows must have
+ * the same number of elements.
+ *
+ * push() may only be called from one thread and tryPop()/pop() from one
+ * (other) thread at a time. The remaining methods can be called from either
+ * thread; copying the buffer is not thread-safe.
+ *
+ * When the buffer is full, push() follows the OverflowPolicy of the buffer.
+ * Overwriting the oldest row is not offered because that requires the
+ * producer to modify the position of the consumer.
+ *
+ * @code
+ * DataRingBuffer_<SimTK::Rotation> buffer(256, numSensors);
+ * // Producer thread:
+ * buffer.push(time, orientations);
+ * // Consumer thread:
+ * double time;
+ * SimTK::RowVector_<SimTK::Rotation> row;
+ * if (buffer.tryPop(time, row)) { ... }
+ * @endcode
+ */
+template<class T> class DataRingBuffer_ {
+public:
+    /** What push() does when the buffer is full. */
+    enum class OverflowPolicy {
+        /// Discard the new row and return false (see getNumDropped()).
+        DropNewest,
+        /// Wait (yielding the thread) until the consumer pops a row.
+        Wait,
+        /// Throw an Exception.
+        Throw
+    };
+
+    /** @param capacity Maximum number of rows in the buffer.
+        @param rowWidth Number of elements in each row; if 0, the width is
+            set (and the memory allocated) by the first push().
+        @param policy What push() does when the buffer is full. */
+    explicit DataRingBuffer_(int capacity = 1024, int rowWidth = 0,
+            OverflowPolicy policy = OverflowPolicy::DropNewest)
+            : _capacity(capacity), _policy(policy) {
+        OPENSIM_THROW_IF(capacity <= 0, Exception,
+                "Expected a positive capacity, but got {}.", capacity);
+        OPENSIM_THROW_IF(rowWidth < 0, Exception,
+                "Expected a nonnegative row width, but got {}.", rowWidth);
+        _times.resize(capacity);
+        if (rowWidth > 0) allocateRows(rowWidth);
+    }
+    DataRingBuffer_(const DataRingBuffer_& other) { copyFrom(other); }
+    DataRingBuffer_& operator=(const DataRingBuffer_& other) {
+        if (this != &other) copyFrom(other);
+        return *this;
+    }
+
+    /** (Producer) Append a row. Returns false if the row was dropped because
+    the buffer is full and the policy is OverflowPolicy::DropNewest. */
+    template <typename Row>
+    bool push(double time, const Row& row) {
+        const int width = (int)row.size();
+        if (_width == 0) {
+            // Nothing has been pushed, so the consumer does not access the
+            // rows until the first row is published below.
+            allocateRows(width);
+        }
+        OPENSIM_THROW_IF(width != _width, Exception,
+                "Expected a row with {} elements, but got {}.", _width, width);
+
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        while (tail - _head.load(std::memory_order_acquire) >=
+                (size_t)_capacity) {
+            if (_policy == OverflowPolicy::DropNewest) {
+                _numDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            OPENSIM_THROW_IF(_policy == OverflowPolicy::Throw, Exception,
+                    "The buffer is full (capacity of {} rows).", _capacity);
+            std::this_thread::yield();
+        }
+
+        const size_t slot = tail % _capacity;
+        _times[slot] = time;
+        T* dest = &_rows[slot * _width];
+        for (int i = 0; i < width; ++i) dest[i] = row[i];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** (Consumer) Remove the oldest row, if there is one, and return whether
+    a row was removed. The output row is resized to the row width (which
+    only allocates if its size differs); any container with resize() and
+    operator[] (e.g., SimTK::RowVector_<T> or SimTK::Array_<T>) can be
+    used. */
+    template <typename Row>
+    bool tryPop(double& time, Row& row) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) return false;
+
+        const size_t slot = head % _capacity;
+        time = _times[slot];
+        if ((int)row.size() != _width) row.resize(_width);
+        const T* src = &_rows[slot * _width];
+        for (int i = 0; i < _width; ++i) row[i] = src[i];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** (Consumer) Same as tryPop() but waits (yielding the thread) until a
+    row is available. */
+    template <typename Row>
+    void pop(double& time, Row& row) {
+        while (!tryPop(time, row)) std::this_thread::yield();
+    }
+
+    /** The number of rows in the buffer. */
+    int size() const {
+        const size_t head = _head.load(std::memory_order_acquire);
+        return (int)(_tail.load(std::memory_order_acquire) - head);
+    }
+    bool isEmpty() const { return size() == 0; }
+    int getCapacity() const { return _capacity; }
+    /** The number of elements in each row (0 if not yet known). */
+    int getRowWidth() const { return _width; }
+    OverflowPolicy getOverflowPolicy() const { return _policy; }
+    /** The number of rows discarded by push() because the buffer was
+    full. */
+    int getNumDropped() const {
+        return (int)_numDropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    void allocateRows(int width) {
+        _width = width;
+        _rows.resize((size_t)_capacity * width);
+    }
+    void copyFrom(const DataRingBuffer_& other) {
+        _capacity = other._capacity;
+        _policy = other._policy;
+        _width = other._width;
+        _times = other._times;
+        _rows = other._rows;
+        _head.store(other._head.load());
+        _tail.store(other._tail.load());
+        _numDropped.store(other._numDropped.load());
+    }
+
+    int _capacity;
+    OverflowPolicy _policy;
+    int _width = 0;
+    std::vector<double> _times;
+    std::vector<T> _rows;
+    // The producer only writes _tail and the consumer only writes _head; the
+    // padding keeps them on separate cache lines.
+    std::atomic<size_t> _head{0};
+    char _padding[64];
+    std::atomic<size_t> _tail{0};
+    std::atomic<size_t> _numDropped{0};
+
+    //=============================================================================
+};  // END of class templatized DataRingBuffer_<T>
+//=============================================================================
 }
 
 #endif // OPENSIM_DATA_QUEUE_H_
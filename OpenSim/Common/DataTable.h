@@ -29,6 +29,7 @@ This file defines the  DataTable_ class, which is used by OpenSim to provide an
 in-memory container for data access and manipulation.                         */
 
 #include "AbstractDataTable.h"
+#include "CopyOnWrite.h"
 #include "FileAdapter.h"
 #include "SimTKcommon/internal/BigMatrix.h"
 #include "SimTKcommon/internal/Quaternion.h"
@@ -188,17 +189,18 @@ public:
         // std::string type, drop the metadata because type information is
         // required to interpret them.
         // Column-labels will be handled separately as they need suffixing.
-        for(const auto& key : _dependentsMetaData.getKeys()) {
+        for(const auto& key : _dependentsMetaData.get().getKeys()) {
             if(key == "labels")
                 continue;
 
-            auto absValueArray = &_dependentsMetaData.updValueArrayForKey(key);
+            auto absValueArray =
+                    &_dependentsMetaData.upd().updValueArrayForKey(key);
             ValueArray<std::string>* valueArray{};
             try {
                 valueArray =
                     dynamic_cast<ValueArray<std::string>*>(absValueArray);
             } catch (const std::bad_cast&) {
-                _dependentsMetaData.removeValueArrayForKey(key);
+                _dependentsMetaData.upd().removeValueArrayForKey(key);
                 continue;
             }
             auto& values = valueArray->upd();
@@ -225,14 +227,15 @@ public:
         setColumnLabels(thisLabels);
 
         // Construct matrix for this table from that table.
-        _depData.resize((int)that.getNumRows(), 
+        Matrix& depData = _depData.upd();
+        depData.resize((int)that.getNumRows(), 
             (int)that.getNumColumns() * that.numComponentsPerElement());
         for(unsigned r = 0; r < that.getNumRows(); ++r) {
             const auto& thatRow = that.getRowAtIndex(r);
             for (unsigned c = 0; c < that.getNumColumns(); ++c) {
-                splitAndAssignElement(_depData.updRow(r).begin() +
+                splitAndAssignElement(depData.updRow(r).begin() +
                                         c*that.numComponentsPerElement(), 
-                                      _depData.updRow(r).end(),
+                                      depData.updRow(r).end(),
                                       thatRow[c]);
             }
         }
@@ -382,12 +385,13 @@ public:
         setColumnLabels(thisLabels);
 
         // Construct matrix for this table from that table.
-        _depData.resize((int)that.getNumRows(), 
+        Matrix& depData = _depData.upd();
+        depData.resize((int)that.getNumRows(), 
             (int)that.getNumColumns() / numComponentsPerElement());
         for(unsigned r = 0; r < that.getNumRows(); ++r) {
             auto thatRow = that.getRowAtIndex(r).getAsRowVector();
             for(unsigned c = 0; c < this->getNumColumns(); ++c) {
-                _depData.updElt(r,c) = makeElement(
+                depData.updElt(r,c) = makeElement(
                     thatRow.begin() + c*numComponentsPerElement(), 
                     thatRow.end());
             }
@@ -652,9 +656,9 @@ public:
     void appendRow(const ETX& indRow, const RowVectorView& depRow) {
         validateRow(_indData.size(), indRow, depRow);
 
-        if (_dependentsMetaData.hasKey("labels")) {
+        if (_dependentsMetaData.get().hasKey("labels")) {
             auto& labels =
-                    _dependentsMetaData.getValueArrayForKey("labels");
+                    _dependentsMetaData.get().getValueArrayForKey("labels");
             OPENSIM_THROW_IF(static_cast<unsigned>(depRow.ncol()) !=
                              labels.size(),
                              IncorrectNumColumns,
@@ -662,15 +666,54 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        const int numRows = (int)_indData.size();
         _indData.push_back(indRow);
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+        // Grow the capacity geometrically so that appending rows one at a
+        // time costs amortized constant time.
+        Matrix& depData = _depData.upd();
+        if(numRows == 0 && depData.ncol() != depRow.ncol()) {
+            depData.resize(std::max(depData.nrow(), 1), depRow.ncol());
+        }
+        else if(numRows == depData.nrow())
+            depData.resizeKeep(std::max(2 * numRows, 1), depData.ncol());
+
+        depData.updRow(numRows) = depRow;
+    }
+
+    /** Reserve storage for at least `numRows` rows, so that appending rows
+    up to that number does not reallocate the underlying matrix. The number
+    of columns is taken from the column labels, if they have been set, or
+    from the existing rows. Does nothing if the capacity is already large
+    enough.                                                                   */
+    void reserveRows(size_t numRows) {
+        if((int)numRows <= _depData.get().nrow()) return;
+        int numColumns = _depData.get().ncol();
+        if(numColumns == 0 && _dependentsMetaData.get().hasKey("labels"))
+            numColumns = (int)_dependentsMetaData.get().
+                    getValueArrayForKey("labels").size();
+        _depData.upd().resizeKeep((int)numRows, numColumns);
+    }
+
+    /** The number of rows that the table can hold before appendRow() must
+    reallocate the underlying matrix.                                         */
+    size_t getRowCapacity() const {
+        return static_cast<size_t>(_depData.get().nrow());
+    }
+
+    /** Release the storage reserved for rows beyond getNumRows(). This is
+    done automatically by getMatrix() and updMatrix(), which provide the
+    whole underlying matrix.                                                  */
+    void shrinkToFit() const {
+        const Matrix& depData = _depData.get();
+        if(depData.nrow() == (int)_indData.size()) return;
+        if(_depData.isShared()) {
+            // Views of the shared matrix may be held by the other copies.
+            _depData = Matrix(depData.block(0, 0, (int)_indData.size(),
+                                            depData.ncol()));
+        } else {
+            _depData.upd().resizeKeep((int)_indData.size(), depData.ncol());
         }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
     }
 
     /** Get row at index.                                                     
@@ -681,7 +724,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
-        return _depData.row(static_cast<int>(index));
+        return _depData.get().row(static_cast<int>(index));
     }
 
     /** Get row corresponding to the given entry in the independent column. This
@@ -697,7 +740,7 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.row((int)std::distance(_indData.cbegin(), iter));
+        return _depData.get().row((int)std::distance(_indData.cbegin(), iter));
     }
 
     /** Update row at index.                                                  
@@ -708,7 +751,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
-        return _depData.updRow((int)index);
+        return _depData.updUnshared().updRow((int)index);
     }
 
     /** Update row corresponding to the given entry in the independent column.
@@ -724,7 +767,8 @@ public:
         OPENSIM_THROW_IF(iter == _indData.cend(),
                          KeyNotFound, std::to_string(ind));
 
-        return _depData.updRow((int)std::distance(_indData.cbegin(), iter));
+        return _depData.updUnshared().updRow(
+                (int)std::distance(_indData.cbegin(), iter));
     }
 
     /** Set row at index. Equivalent to
@@ -734,7 +778,13 @@ public:
 
     \throws RowIndexOutOfRange If the index is out of range.                  */
     void setRowAtIndex(size_t index, const RowVectorView& depRow) {
-        updRowAtIndex(index) = depRow;
+        OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
+                         RowIndexOutOfRange, 
+                         index, 0, static_cast<unsigned>(_indData.size() - 1));
+
+        // Unlike updRowAtIndex(), no view is handed out, so the matrix can
+        // still be shared with later copies of this table.
+        _depData.upd().updRow((int)index) = depRow;
     }
 
     /** Set row at index. Equivalent to
@@ -744,7 +794,11 @@ public:
 
     \throws RowIndexOutOfRange If the index is out of range.                  */
     void setRowAtIndex(size_t index, const RowVector& depRow) {
-        updRowAtIndex(index) = depRow;
+        OPENSIM_THROW_IF(isRowIndexOutOfRange(index),
+                         RowIndexOutOfRange, 
+                         index, 0, static_cast<unsigned>(_indData.size() - 1));
+
+        _depData.upd().updRow((int)index) = depRow;
     }
 
     /** Set row corresponding to the given entry in the independent column.
@@ -759,7 +813,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     void setRow(const ETX& ind, const RowVectorView& depRow) {
-        updRow(ind) = depRow;
+        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+
+        OPENSIM_THROW_IF(iter == _indData.cend(),
+                         KeyNotFound, std::to_string(ind));
+
+        setRowAtIndex((size_t)std::distance(_indData.cbegin(), iter), depRow);
     }
 
     /** Set row corresponding to the given entry in the independent column.
@@ -774,7 +833,12 @@ public:
     \throws KeyNotFound If the independent column has no entry with given
                         value.                                                */
     void setRow(const ETX& ind, const RowVector& depRow) {
-        updRow(ind) = depRow;
+        auto iter = std::find(_indData.cbegin(), _indData.cend(), ind);
+
+        OPENSIM_THROW_IF(iter == _indData.cend(),
+                         KeyNotFound, std::to_string(ind));
+
+        setRowAtIndex((size_t)std::distance(_indData.cbegin(), iter), depRow);
     }
 
     /** Remove row at index.
@@ -785,11 +849,12 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
+        Matrix& depData = _depData.upd();
         if(index < getNumRows() - 1)
             for(size_t r = index; r < getNumRows() - 1; ++r)
-                _depData.updRow((int)r) = _depData.row((int)(r + 1));
+                depData.updRow((int)r) = depData.row((int)(r + 1));
         
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
+        // The last row becomes spare capacity.
         _indData.erase(_indData.begin() + index);
     }
 
@@ -943,8 +1008,9 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
-        _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
-        _depData.updCol(_depData.ncol() - 1) = depCol;
+        Matrix& depData = _depData.upd();
+        depData.resizeKeep(depData.nrow(), depData.ncol() + 1);
+        depData.updCol(depData.ncol() - 1)(0, (int)getNumRows()) = depCol;
         appendColumnLabel(columnLabel);
     }
 
@@ -954,21 +1020,22 @@ public:
         void removeColumnAtIndex(size_t index) {
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
             ColumnIndexOutOfRange,
-            index, 0, static_cast<unsigned>(_depData.ncol() - 1));
+            index, 0, static_cast<unsigned>(_depData.get().ncol() - 1));
 
         // get copy of labels
         auto labels = getColumnLabels();
 
-        assert(labels.size() == _depData.ncol());
+        assert(labels.size() == _depData.get().ncol());
 
         // shift columns unless we're already at the last column
+        Matrix& depData = _depData.upd();
         for (size_t c = index; c < getNumColumns()-1; ++c) {
-            _depData.updCol((int)c) = _depData.col((int)(c + 1));
+            depData.updCol((int)c) = depData.col((int)(c + 1));
             labels[c] = labels[c + 1];
         }
 
-        _depData.resizeKeep(_depData.nrow(), _depData.ncol()-1);
-        labels.resize(_depData.ncol());
+        depData.resizeKeep(depData.nrow(), depData.ncol()-1);
+        labels.resize(depData.ncol());
         setColumnLabels(labels);
     }
 
@@ -996,9 +1063,10 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(_depData.get().ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return _depData.get().col(static_cast<int>(index))(
+                0, (int)getNumRows());
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1006,7 +1074,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        const int index = static_cast<int>(getColumnIndex(columnLabel));
+        return _depData.get().col(index)(0, (int)getNumRows());
     }
 
     /** Update dependent column at index.
@@ -1018,9 +1087,10 @@ public:
         OPENSIM_THROW_IF(isEmpty(), EmptyTable);
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(index),
                          ColumnIndexOutOfRange, index, 0,
-                         static_cast<size_t>(_depData.ncol() - 1));
+                         static_cast<size_t>(_depData.get().ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return _depData.updUnshared().updCol(static_cast<int>(index))(
+                0, (int)getNumRows());
     }
 
     /** Update dependent Column which has the given column label.
@@ -1028,7 +1098,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        const int index = static_cast<int>(getColumnIndex(columnLabel));
+        return _depData.updUnshared().updCol(index)(0, (int)getNumRows());
     }
 
     /** %Set value of the independent column at index.
@@ -1044,7 +1115,7 @@ public:
                          rowIndex, 0, 
                          static_cast<unsigned>(_indData.size() - 1));
 
-        validateRow(rowIndex, value, _depData.row((int)rowIndex));
+        validateRow(rowIndex, value, _depData.get().row((int)rowIndex));
         _indData[rowIndex] = value;
     }
 
@@ -1057,7 +1128,8 @@ public:
 
     /** Get a read-only view to the underlying matrix.                        */
     const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+        shrinkToFit();
+        return _depData.get().getAsMatrixView();
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1079,29 +1151,30 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData.get().ncol() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart + numColumns - 1),
                          ColumnIndexOutOfRange,
                          columnStart + numColumns - 1, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData.get().ncol() - 1));
 
-        return _depData.block(static_cast<int>(rowStart),
-                              static_cast<int>(columnStart),
-                              static_cast<int>(numRows),
-                              static_cast<int>(numColumns));
+        return _depData.get().block(static_cast<int>(rowStart),
+                                    static_cast<int>(columnStart),
+                                    static_cast<int>(numRows),
+                                    static_cast<int>(numColumns));
     }
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
-        return _depData.updAsMatrixView();
+        shrinkToFit();
+        return _depData.updUnshared().updAsMatrixView();
     }
 
     /** Get a writable view of a block of the underlying matrix.
@@ -1123,24 +1196,24 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(_indData.size() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData.get().ncol() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart + numColumns - 1),
                          ColumnIndexOutOfRange,
                          columnStart + numColumns - 1, 0, 
-                         static_cast<unsigned>(_depData.ncol() - 1));
+                         static_cast<unsigned>(_depData.get().ncol() - 1));
 
-        return _depData.updBlock(static_cast<int>(rowStart),
-                                 static_cast<int>(columnStart),
-                                 static_cast<int>(numRows),
-                                 static_cast<int>(numColumns));
+        return _depData.updUnshared().updBlock(static_cast<int>(rowStart),
+                                               static_cast<int>(columnStart),
+                                               static_cast<int>(numRows),
+                                               static_cast<int>(numColumns));
     }
 
     /// @}
@@ -1232,7 +1305,7 @@ protected:
 
         setColumnLabels(labels);
         _indData = indVec;
-        _depData = depData;
+        _depData = Matrix(depData);
     }
 
     /** Construct a table with only the independent column and 0
@@ -1241,7 +1314,7 @@ protected:
     DataTable_(const std::vector<ETX>& indVec) {
         setColumnLabels({});
         _indData = indVec;
-        _depData.resize((int)indVec.size(), 0);
+        _depData.upd().resize((int)indVec.size(), 0);
     }
 
     // Implement toString.
@@ -1552,17 +1625,17 @@ protected:
 
     /** Check if column index is out of range.                                */
     bool isColumnIndexOutOfRange(size_t index) const {
-        return index >= static_cast<size_t>(_depData.ncol());
+        return index >= static_cast<size_t>(_depData.get().ncol());
     }
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _indData.size();
     }
 
     /** Get number of columns.                                                */
     size_t implementGetNumColumns() const override {
-        return _depData.ncol();
+        return _depData.get().ncol();
     }
 
     /** Validate metadata for independent column.                             
@@ -1592,7 +1665,7 @@ protected:
     void validateDependentsMetaData() const override {
         size_t numCols{};
 
-        if (!_dependentsMetaData.hasKey("labels")) {
+        if (!_dependentsMetaData.get().hasKey("labels")) {
             OPENSIM_THROW(MissingMetaData, "labels");
         }
 
@@ -1617,16 +1690,19 @@ protected:
                 "Leading/trailing spaces are not permitted in column labels.");
         }
 
-        OPENSIM_THROW_IF(_depData.ncol() != 0 && 
-                         numCols != static_cast<unsigned>(_depData.ncol()),
+        const int numMatrixCols = _depData.get().ncol();
+        OPENSIM_THROW_IF(numMatrixCols != 0 && 
+                         numCols != static_cast<unsigned>(numMatrixCols),
                          IncorrectMetaDataLength, "labels", 
-                         static_cast<size_t>(_depData.ncol()), numCols);
+                         static_cast<size_t>(numMatrixCols), numCols);
 
-        for(const std::string& key : _dependentsMetaData.getKeys()) {
+        const DependentsMetaData& dependentsMetaData =
+                _dependentsMetaData.get();
+        for(const std::string& key : dependentsMetaData.getKeys()) {
             OPENSIM_THROW_IF(numCols != 
-                        _dependentsMetaData.getValueArrayForKey(key).size(),
+                        dependentsMetaData.getValueArrayForKey(key).size(),
                         IncorrectMetaDataLength, key, numCols,
-                        _dependentsMetaData.getValueArrayForKey(key).size());
+                        dependentsMetaData.getValueArrayForKey(key).size());
         }
     }
 
@@ -1662,7 +1738,12 @@ protected:
     }
 
     std::vector<ETX>    _indData;
-    SimTK::Matrix_<ETY> _depData;
+    // May have more rows than _indData (spare capacity for appendRow());
+    // only the first getNumRows() rows hold data. Mutable so that
+    // getMatrix() can release the spare capacity. Shared between copies of
+    // the table until one of them is modified, so that copying a table does
+    // not copy the matrix.
+    mutable CopyOnWrite<Matrix> _depData;
 };  // DataTable_
 
 
@@ -26,11 +26,18 @@
 
 #include "About.h"
 #include "FileAdapter.h"
+#include "MemoryMappedFile.h"
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
+#include "OpenSim/Common/CommonUtilities.h"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <fstream>
+#include <iterator>
+#include <limits>
+#include <spdlog/fmt/fmt.h>
 #include <regex>
 
 namespace OpenSim {
@@ -78,7 +85,12 @@ set the delimiters appropriately for the files they parse. The read/write
 functions return/accept a specific type of DataTable referred to as Table in 
 this class.                                                                   
 Header in the file is assumed to end with string "endheader" occupying a full
-line.                                                                         */
+line.                                                                         
+The data rows (everything after the column labels) are read from a
+memory-mapped view of the file. The rows are tokenized in place and the
+numbers are converted with FileAdapter::parseDouble(), so no memory is
+allocated per token, and the table is allocated once for the number of lines
+in the file.                                                                  */
 template<typename T>
 class DelimFileAdapter : public FileAdapter {
     static_assert(std::is_same<T, double           >::value ||
@@ -120,6 +132,12 @@ protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
 
+    /** Implementation of the read functionality that only parses the columns
+    and rows kept by the filter. Rows after the filter's final time are not
+    read at all, since the time column is increasing.                         */
+    OutputTables extendReadFiltered(const std::string& filename,
+            const TableReadFilter& filter) const override;
+
     /** Implementation of the write functionality.                            */
     void extendWrite(const InputTables& tables,
                      const std::string& filename) const override;
@@ -129,11 +147,40 @@ protected:
     inline SimTK::RowVector_<T> 
     readElems(const std::vector<std::string>& tokens) const;
 
-    /** Write an element of type T (template parameter) to stream with the
-    specified precision.                                                      */
-    inline void writeElem(std::ostream& stream, 
-                          const T& elem,
-                          const unsigned& prec) const;
+    /** Append the text of an element of type T (template parameter) to
+    `text`, using the write precision.                                        */
+    inline void appendElem(std::string& text, const T& elem) const;
+
+    /** Write the first part of the header: the "header" metadata followed by
+    the rest of the metadata (with std::string values) as key=value pairs.    */
+    void writeMetaData(std::ostream& stream,
+                       const ValueArrayDictionary& metadata) const;
+
+    /** Write the last part of the header (data type, version numbers and the
+    end of the header) followed by the line containing the column labels.    */
+    void writeEndOfHeader(std::ostream& stream,
+                          const std::vector<std::string>& labels) const;
+
+    /** Write a row of data, starting with the time.                          */
+    void writeRow(std::ostream& stream,
+                  double time,
+                  const SimTK::RowVectorBase<T>& row) const;
+
+    /** Append the text of a row of data, starting with the time and ending
+    with a newline, to `text`.                                                */
+    void appendRow(std::string& text,
+                   double time,
+                   const SimTK::RowVectorBase<T>& row) const;
+
+public:
+    /** Set the number of significant digits used to write numbers. If the
+    value is not positive, each number is written with the fewest digits that
+    read back to the same double (the shortest round-trip form). The default
+    (digits10 + 1 = 16) matches the files written by earlier versions.        */
+    void setWritePrecision(int precision) { _writePrecision = precision; }
+    int getWritePrecision() const { return _writePrecision; }
+
+protected:
 
 private:
     /** Following overloads implement dataTypeName().                         */
@@ -162,17 +209,35 @@ private:
     readElems_impl(const std::vector<std::string>& tokens,
                    SimTK::Vec<M>) const;
 
-    /** Following overloads implement writeElem().                            */
-    inline void writeElem_impl(std::ostream& stream,
-                               const double& elem,
-                               const unsigned& prec) const;
-    inline void writeElem_impl(std::ostream& stream,
-                               const SimTK::SpatialVec& elem,
-                               const unsigned& prec) const;
+    /** Following overloads read a single element of type T (template
+    parameter) from the characters [begin, end) of a data row.                */
+    inline void parseElem_impl(const char* begin, const char* end,
+                               double& elem) const;
+    inline void parseElem_impl(const char* begin, const char* end,
+                               SimTK::UnitVec3& elem) const;
+    inline void parseElem_impl(const char* begin, const char* end,
+                               SimTK::Quaternion& elem) const;
+    inline void parseElem_impl(const char* begin, const char* end,
+                               SimTK::SpatialVec& elem) const;
+    template<int M>
+    inline void parseElem_impl(const char* begin, const char* end,
+                               SimTK::Vec<M>& elem) const;
+
+    /** Read `numComps` components, separated by the component delimiter,
+    from the characters [begin, end).                                         */
+    inline void parseComponents(const char* begin, const char* end,
+                                int numComps, double* comps) const;
+
+    /** Following overloads implement appendElem().                           */
+    inline void appendElem_impl(std::string& text, const double& elem) const;
+    inline void appendElem_impl(std::string& text,
+                                const SimTK::SpatialVec& elem) const;
     template<int M>
-    inline void writeElem_impl(std::ostream& stream,
-                               const SimTK::Vec<M>& elem,
-                               const unsigned& prec) const;
+    inline void appendElem_impl(std::string& text,
+                                const SimTK::Vec<M>& elem) const;
+
+    /** Append a number to `text` with the write precision.                   */
+    inline void appendDouble(std::string& text, double value) const;
       
     /** Trim string -- remove specified leading and trailing characters from 
     string. Trims out whitespace by default.                                  */
@@ -198,6 +263,8 @@ private:
     static const std::string _opensimVersionString;
     /** File version number.                                                  */
     static const std::string _versionNumber;
+    /** Number of significant digits used for writing.                        */
+    int _writePrecision = std::numeric_limits<double>::digits10 + 1;
 };
 
 
@@ -307,10 +374,19 @@ DelimFileAdapter<T>::clone() const {
 template<typename T>
 typename DelimFileAdapter<T>::OutputTables
 DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
+    return extendReadFiltered(fileName, TableReadFilter{});
+}
+
+template<typename T>
+typename DelimFileAdapter<T>::OutputTables
+DelimFileAdapter<T>::extendReadFiltered(const std::string& fileName,
+        const TableReadFilter& filter) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
+    // Binary mode, so that the position after the column labels is a byte
+    // offset into the file. The \r of CRLF line endings is removed below.
+    std::ifstream in_stream{fileName, std::ios::in | std::ios::binary};
     OPENSIM_THROW_IF(!in_stream.good(),
                      FileDoesNotExist,
                      fileName);
@@ -401,55 +477,100 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
+    // Map each column of the file to its column in the table (-1 if the
+    // filter drops it).
+    const int numFileColumns = static_cast<int>(column_labels.size());
+    std::vector<int> tableColumn(numFileColumns, -1);
+    if(!filter.keepsAllColumns()) {
+        std::vector<std::string> kept_labels{};
+        for(const auto index : filter.findColumns(column_labels, fileName)) {
+            tableColumn[index] = static_cast<int>(kept_labels.size());
+            kept_labels.push_back(column_labels[index]);
+        }
+        column_labels = std::move(kept_labels);
+    } else {
+        for(int i = 0; i < numFileColumns; ++i)
+            tableColumn[i] = i;
+    }
+
+    // The data rows are read from a memory-mapped view of the file, starting
+    // right after the line with the column labels. If the stream reached the
+    // end of the file, there are no data rows.
+    const auto dataStart = in_stream.tellg();
+    in_stream.close();
+    MemoryMappedFile file{fileName};
+    const char* const fileEnd = file.getData() + file.getSize();
+    const char* cur = dataStart == std::streampos(-1) ? fileEnd :
+            file.getData() + static_cast<std::streamoff>(dataStart);
+
+    // Allocate the containers once, for the number of remaining lines.
+    const int ncol = static_cast<int>(column_labels.size());
+    int numLines = static_cast<int>(std::count(cur, fileEnd, '\n'));
+    if(cur < fileEnd && *(fileEnd - 1) != '\n')
+        ++numLines;
     std::vector<double> timeVec;
-    int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
-    timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
-    // Initialize current row and capacity
-    int curCapacity = initCapacity;
-    int curRow = 0;
+    timeVec.reserve(numLines);
+    SimTK::Matrix_<T> matrix(numLines, ncol);
 
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
+    int curRow = 0;
+    while(cur < fileEnd) {
+        const char* lineEnd = static_cast<const char*>(
+                std::memchr(cur, '\n', fileEnd - cur));
+        if(!lineEnd)
+            lineEnd = fileEnd;
+        const char* const nextLineBegin =
+                lineEnd == fileEnd ? fileEnd : lineEnd + 1;
+        // Get rid of the extra \r if parsing a file with CRLF line endings.
+        if(lineEnd > cur && *(lineEnd - 1) == '\r')
+            --lineEnd;
+        // As with getNextLine(), an empty line ends the data.
+        if(lineEnd == cur)
+            break;
         ++line_num;
-        
-        // Double capacity if we reach the end of the containers.
-        // This is necessary until Simbody issue #401 is addressed.
-        if (curRow+1 > curCapacity) {
-            curCapacity *= 2;
-            timeVec.reserve(curCapacity);
-            matrix.resizeKeep(curCapacity, ncol);
-        }
 
-        // Time is column 0.
-        timeVec.push_back(std::stod(row.front()));
-        row.erase(row.begin());
-
-        auto row_vector = readElems(row);
+        // Split the line into tokens the same way as tokenize(); the
+        // characters after the last delimiter form a token only if there are
+        // any. Time is token 0; the remaining tokens are the elements of the
+        // row.
+        const char* tokenBegin = cur;
+        const char* tokenEnd =
+                findDelimiter(tokenBegin, lineEnd, _delimitersRead);
+        const double time = parseDouble(tokenBegin, tokenEnd);
+        if(!filter.keepsTime(time)) {
+            if(time > filter.finalTime)
+                break;
+            cur = nextLineBegin;
+            continue;
+        }
+        timeVec.push_back(time);
+        int numTokens = 1;
+        while(tokenEnd != lineEnd) {
+            tokenBegin = tokenEnd + 1;
+            if(tokenBegin == lineEnd)
+                break;
+            tokenEnd = findDelimiter(tokenBegin, lineEnd, _delimitersRead);
+            if(numTokens <= numFileColumns &&
+                    tableColumn[numTokens - 1] >= 0)
+                parseElem_impl(tokenBegin, tokenEnd,
+                               matrix(curRow, tableColumn[numTokens - 1]));
+            ++numTokens;
+        }
 
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
+        OPENSIM_THROW_IF(numTokens - 1 != numFileColumns,
             RowLengthMismatch,
             fileName,
             line_num,
-            column_labels.size(),
-            static_cast<size_t>(row_vector.size()));
-        
-        matrix.updRow(curRow) = std::move(row_vector);
+            static_cast<size_t>(numFileColumns),
+            static_cast<size_t>(numTokens - 1));
 
-        row = nextLine();
+        cur = nextLineBegin;
         ++curRow;
     }
 
-    // Resize the matrix down to the correct number of rows.
-    // This is necessary until Simbody issue #401 is addressed.
-    matrix.resizeKeep(curRow, ncol);
+    // Resize the matrix down to the correct number of rows if the data ended
+    // early (e.g., with an empty line).
+    if(curRow != numLines)
+        matrix.resizeKeep(curRow, ncol);
 
     // Create the table and update other metadata from above
     auto table = 
@@ -558,6 +679,87 @@ DelimFileAdapter<T>::readElems_impl(const std::vector<std::string>& tokens,
     return elems;
 }
   
+template<typename T>
+void
+DelimFileAdapter<T>::parseComponents(const char* begin,
+                                     const char* end,
+                                     int numComps,
+                                     double* comps) const {
+    // Trim the element and split it the same way as tokenize().
+    const auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+    while(begin < end && isSpace(*begin)) ++begin;
+    while(end > begin && isSpace(*(end - 1))) --end;
+    int numTokens = 0;
+    const char* tokenBegin = begin;
+    while(tokenBegin != end) {
+        const char* tokenEnd = findDelimiter(tokenBegin, end, _compDelimRead);
+        if(numTokens < numComps)
+            comps[numTokens] = parseDouble(tokenBegin, tokenEnd);
+        ++numTokens;
+        if(tokenEnd == end)
+            break;
+        tokenBegin = tokenEnd + 1;
+    }
+    OPENSIM_THROW_IF(numTokens != numComps,
+                     IncorrectNumTokens,
+                     "Expected " + std::to_string(numComps) +
+                     "x (multiple of " + std::to_string(numComps) +
+                     ") number of tokens.");
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const char* begin,
+                                    const char* end,
+                                    double& elem) const {
+    elem = parseDouble(begin, end);
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const char* begin,
+                                    const char* end,
+                                    SimTK::UnitVec3& elem) const {
+    double comps[3];
+    parseComponents(begin, end, 3, comps);
+    elem = SimTK::UnitVec3{comps[0], comps[1], comps[2]};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const char* begin,
+                                    const char* end,
+                                    SimTK::Quaternion& elem) const {
+    double comps[4];
+    parseComponents(begin, end, 4, comps);
+    elem = SimTK::Quaternion{comps[0], comps[1], comps[2], comps[3]};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const char* begin,
+                                    const char* end,
+                                    SimTK::SpatialVec& elem) const {
+    double comps[6];
+    parseComponents(begin, end, 6, comps);
+    elem = SimTK::SpatialVec{{comps[0], comps[1], comps[2]},
+                             {comps[3], comps[4], comps[5]}};
+}
+
+template<typename T>
+template<int M>
+void
+DelimFileAdapter<T>::parseElem_impl(const char* begin,
+                                    const char* end,
+                                    SimTK::Vec<M>& elem) const {
+    double comps[M];
+    parseComponents(begin, end, M, comps);
+    for(int j = 0; j < M; ++j)
+        elem[j] = comps[j];
+}
+
 template<typename T>
 void
 DelimFileAdapter<T>::extendWrite(const InputTables& absTables, 
@@ -581,23 +783,52 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
 
     std::ofstream out_stream{fileName};
 
+    writeMetaData(out_stream, table->getTableMetaData());
+    writeEndOfHeader(out_stream, table->hasColumnLabels() ?
+                                 table->getColumnLabels() :
+                                 std::vector<std::string>{});
+
+    // Data rows. Blocks of rows are formatted concurrently and written to the
+    // file in large pieces.
+    const auto& times = table->getIndependentColumn();
+    const auto& matrix = table->getMatrix();
+    formatRowsInParallel(static_cast<int>(table->getNumRows()),
+            [&](int row, std::string& text) {
+                appendRow(text, times[row], matrix.row(row));
+            },
+            [&](const std::string& text) {
+                out_stream.write(text.data(),
+                                 static_cast<std::streamsize>(text.size()));
+            });
+    OPENSIM_THROW_IF(!out_stream.good(), Exception,
+                     "Could not write to file '{}'.", fileName);
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::writeMetaData(std::ostream& out_stream,
+                                   const ValueArrayDictionary& metadata) const {
     // First line of the stream is the header.
-    if (table->getTableMetaData().hasKey("header")) {
-        out_stream << table->
-                      getTableMetaData().
+    if (metadata.hasKey("header")) {
+        out_stream << metadata.
                       getValueForKey("header").
                       template getValue<std::string>() << "\n";
     }
-    // Write rest of the key-value pairs and end the header.
-    for(const auto& key : table->getTableMetaDataKeys()) {
-        try {
-            if(key != "header")
-                out_stream << key << "=" 
-                           << table->
-                              template getTableMetaData<std::string>(key) 
-                           << "\n";
-        } catch(const InvalidTemplateArgument&) {}
+    // Write rest of the key-value pairs.
+    for(const auto& key : metadata.getKeys()) {
+        if(key == "header")
+            continue;
+        const auto* value = dynamic_cast<const SimTK::Value<std::string>*>(
+                &metadata.getValueForKey(key));
+        if(value)
+            out_stream << key << "=" << value->get() << "\n";
     }
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::writeEndOfHeader(std::ostream& out_stream,
+                              const std::vector<std::string>& labels) const {
     // Write name of the data-type -- vec3, vec6, etc.
     out_stream << _dataTypeString << "=" << dataTypeName() << "\n";
     // Write version number.
@@ -607,67 +838,82 @@ DelimFileAdapter<T>::extendWrite(const InputTables& absTables,
 
     // Line containing column labels.
     out_stream << _timeColumnLabel;
-    for(unsigned col = 0; col < table->getNumColumns(); ++col)
-        out_stream << _delimiterWrite
-                   << table->
-                      getDependentsMetaData().
-                      getValueArrayForKey("labels")[col].
-                      template getValue<std::string>();
+    for(const auto& label : labels)
+        out_stream << _delimiterWrite << label;
     out_stream << "\n";
+}
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << std::setprecision(prec)
-                   << table->getIndependentColumn()[row];
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << _delimiterWrite;
-            writeElem(out_stream, elt, prec);
-        }
-        out_stream << "\n";
+template<typename T>
+void
+DelimFileAdapter<T>::writeRow(std::ostream& out_stream,
+                              double time,
+                              const SimTK::RowVectorBase<T>& row) const {
+    std::string text;
+    appendRow(text, time, row);
+    out_stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::appendRow(std::string& text,
+                               double time,
+                               const SimTK::RowVectorBase<T>& row) const {
+    appendDouble(text, time);
+    for(int col = 0; col < row.ncol(); ++col) {
+        text += _delimiterWrite;
+        appendElem(text, row[col]);
     }
+    text += '\n';
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem(std::ostream& stream,
-                               const T& elem,
-                               const unsigned& prec) const {
-    writeElem_impl(stream, elem, prec);
+DelimFileAdapter<T>::appendElem(std::string& text, const T& elem) const {
+    appendElem_impl(text, elem);
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const double& elem,
-                                    const unsigned& prec) const {
-    stream << std::setprecision(prec) << elem;
+DelimFileAdapter<T>::appendDouble(std::string& text, double value) const {
+    // With a precision, this is the same text as std::ostream with
+    // std::setprecision() (i.e., %g).
+    if(_writePrecision > 0)
+        fmt::format_to(std::back_inserter(text), "{:.{}g}", value,
+                       _writePrecision);
+    else
+        fmt::format_to(std::back_inserter(text), "{}", value);
 }
 
 template<typename T>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const SimTK::SpatialVec& elem,
-                                    const unsigned& prec) const {
-    stream                    << std::setprecision(prec) << elem[0][0]
-           << _compDelimWrite << std::setprecision(prec) << elem[0][1]
-           << _compDelimWrite << std::setprecision(prec) << elem[0][2]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][0]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][1]
-           << _compDelimWrite << std::setprecision(prec) << elem[1][2];
+DelimFileAdapter<T>::appendElem_impl(std::string& text,
+                                     const double& elem) const {
+    appendDouble(text, elem);
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::appendElem_impl(std::string& text,
+                                     const SimTK::SpatialVec& elem) const {
+    for(int i = 0; i < 2; ++i) {
+        for(int j = 0; j < 3; ++j) {
+            if(i + j > 0)
+                text += _compDelimWrite;
+            appendDouble(text, elem[i][j]);
+        }
+    }
 }
 
 template<typename T>
 template<int M>
 void
-DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
-                                    const SimTK::Vec<M>& elem,
-                                    const unsigned& prec) const {
-    stream << std::setprecision(prec) << elem[0];
-    for(auto i = 1u; i < M; ++i)
-        stream << _compDelimWrite << std::setprecision(prec) << elem[i];
+DelimFileAdapter<T>::appendElem_impl(std::string& text,
+                                     const SimTK::Vec<M>& elem) const {
+    appendDouble(text, elem[0]);
+    for(auto i = 1u; i < M; ++i) {
+        text += _compDelimWrite;
+        appendDouble(text, elem[i]);
+    }
 }
 
 } // namespace OpenSim
@@ -1,6 +1,14 @@
 #include "FileAdapter.h"
+#include "CommonUtilities.h"
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
+#include "BinaryFileAdapter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
 
 namespace OpenSim {
 
@@ -13,16 +21,54 @@ createSTOFileAdapterForWriting(const DataAdapter::InputTables&);
 void 
 FileAdapter::writeFile(const InputTables& tables, 
                        const std::string& fileName) {
+    OPENSIM_TRACE_SCOPE_DYNAMIC("write " + fileName, "io");
     auto extension = findExtension(fileName);
     std::shared_ptr<DataAdapter> dataAdapter{};
     if(extension == "sto")
         dataAdapter = createSTOFileAdapterForWriting(tables);
+    else if(extension == "bsto")
+        dataAdapter = createBinaryFileAdapterForWriting(tables);
     else
         dataAdapter = createAdapter(extension);
     auto& fileAdapter = static_cast<FileAdapter&>(*dataAdapter);
     fileAdapter.extendWrite(tables, fileName);
 }
 
+std::vector<DataAdapter::OutputTables>
+FileAdapter::readFiles(const std::vector<std::string>& fileNames,
+                       int numThreads) const {
+    const int numFiles = static_cast<int>(fileNames.size());
+    if(numThreads <= 0)
+        numThreads = getNumAvailableThreads();
+    numThreads = std::max(1, std::min(numThreads, numFiles));
+    const ThreadReservation reservation(numThreads);
+
+    std::vector<OutputTables> tables(numFiles);
+    std::vector<std::exception_ptr> errors(numFiles);
+    std::atomic<int> nextFile(0);
+    auto worker = [&]() {
+        int index;
+        while((index = nextFile++) < numFiles) {
+            try {
+                tables[index] = read(fileNames[index]);
+            } catch(...) {
+                errors[index] = std::current_exception();
+            }
+        }
+    };
+
+    if(numThreads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        for(int i = 0; i < numThreads; ++i) threads.emplace_back(worker);
+        for(auto& thread : threads) thread.join();
+    }
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+    return tables;
+}
+
 std::string 
 FileAdapter::findExtension(const std::string& filename) {
     std::size_t found = filename.find_last_of('.');
@@ -64,6 +110,82 @@ FileAdapter::tokenize(const std::string& str,
     return tokens;
 }
 
+const char*
+FileAdapter::findDelimiter(const char* begin, const char* end,
+                           const std::string& delims) {
+    if(delims.size() == 1)
+        return std::find(begin, end, delims[0]);
+    return std::find_first_of(begin, end, delims.begin(), delims.end());
+}
+
+double
+FileAdapter::parseDouble(const char* begin, const char* end) {
+    // Trim the same characters as IO::TrimWhitespace().
+    const auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    };
+    while(begin < end && isSpace(*begin)) ++begin;
+    while(end > begin && isSpace(*(end - 1))) --end;
+
+    const auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    const char* p = begin;
+    const bool negative = p < end && *p == '-';
+    if(p < end && (*p == '-' || *p == '+')) ++p;
+
+    // Accumulate the significant digits (at most 19 fit in 64 bits) and the
+    // decimal exponent.
+    std::uint64_t mantissa{0};
+    int numSignificant{0};
+    int exponent{0};
+    bool hasDigits{false};
+    for(; p < end && isDigit(*p); ++p) {
+        hasDigits = true;
+        if(mantissa == 0 && *p == '0') continue;
+        if(++numSignificant <= 19) mantissa = 10 * mantissa + (*p - '0');
+    }
+    if(p < end && *p == '.') {
+        for(++p; p < end && isDigit(*p); ++p) {
+            hasDigits = true;
+            --exponent;
+            if(mantissa == 0 && *p == '0') continue;
+            if(++numSignificant <= 19) mantissa = 10 * mantissa + (*p - '0');
+        }
+    }
+    if(hasDigits && p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        const bool negativeExp = q < end && *q == '-';
+        if(q < end && (*q == '-' || *q == '+')) ++q;
+        if(q < end && isDigit(*q)) {
+            int exp{0};
+            for(; q < end && isDigit(*q); ++q)
+                if(exp < 10000) exp = 10 * exp + (*q - '0');
+            exponent += negativeExp ? -exp : exp;
+            p = q;
+        }
+    }
+
+    // If the mantissa and the power of ten are both exactly representable
+    // as doubles, a single multiplication or division gives the correctly
+    // rounded result (Clinger's fast path), so the result is identical to
+    // that of std::stod().
+    static const double powersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                        1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                        1e18, 1e19, 1e20, 1e21, 1e22};
+    if(hasDigits && p == end && numSignificant <= 19 &&
+            mantissa <= (std::uint64_t(1) << 53) &&
+            exponent >= -22 && exponent <= 22) {
+        double value = static_cast<double>(mantissa);
+        if(exponent < 0)
+            value /= powersOf10[-exponent];
+        else
+            value *= powersOf10[exponent];
+        return negative ? -value : value;
+    }
+
+    return std::stod(std::string(begin, end));
+}
+
 std::vector<std::string>
 FileAdapter::getNextLine(std::istream& stream,
                          const std::string& delims) {
@@ -86,6 +208,8 @@ FileAdapter::createAdapterFromExtension(const std::string& fileName) {
     std::shared_ptr<DataAdapter> dataAdapter{};
     if (extension == "sto")
         dataAdapter = createSTOFileAdapterForReading(fileName);
+    else if (extension == "bsto")
+        dataAdapter = createBinaryFileAdapterForReading(fileName);
     else
         dataAdapter = createAdapter(extension);
     return dataAdapter;
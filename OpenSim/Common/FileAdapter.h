@@ -198,6 +198,23 @@ public:
     static void writeFile(const InputTables& tables, 
                           const std::string& fileName);
 
+    /** Read several files with this adapter, using up to `numThreads`
+    threads (by default, or if `numThreads` is not positive, the number of
+    hardware threads). Each file is read independently with read(), so the
+    result is the same as reading the files one after another; the tables of
+    fileNames[i] are in element i of the returned vector. This is useful for
+    converting many trials (e.g., C3D or TRC files) at once. If any file
+    cannot be read, the first such exception (in the order of `fileNames`) is
+    rethrown after all threads have finished.
+    @code{.cpp}
+    C3DFileAdapter c3dFileAdapter;
+    auto allTables = c3dFileAdapter.readFiles({"trial1.c3d", "trial2.c3d"});
+    auto markers = c3dFileAdapter.getMarkersTable(allTables[1]);
+    @endcode                                                                  */
+    std::vector<OutputTables> readFiles(
+            const std::vector<std::string>& fileNames,
+            int numThreads = 0) const;
+
     /** Find the extension from a filename.                                   */
     static
     std::string findExtension(const std::string& filename);
@@ -213,6 +230,24 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+    /** Find the first character in [begin, end) that is one of the given
+    delimiters (see tokenize()), or `end` if there is none. Together with
+    parseDouble(), this allows tokenizing a buffer in place, without creating
+    a string for each token.                                                  */
+    static const char* findDelimiter(const char* begin, const char* end,
+                                     const std::string& delims);
+
+    /** Convert the characters [begin, end), ignoring leading and trailing
+    whitespace, to a double. This gives the same result as std::stod() on the
+    trimmed characters but is much faster for the numbers typically found in
+    data files: numbers of the form [-+]ddd.ddd[eE][-+]ddd whose significant
+    digits fit in 53 bits (about 15 digits) and whose decimal exponent is
+    between -22 and 22 are converted exactly, without allocating memory and
+    without consulting the locale. All other input (e.g., "nan", "inf", numbers with
+    more digits, or invalid numbers) is forwarded to std::stod(), so the
+    result and the exceptions thrown are identical.                           */
+    static double parseDouble(const char* begin, const char* end);
     /** Create a concerte FileAdapter based on the extension of the passed in file and return it.
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
@@ -49,8 +49,7 @@ using SimTK::Vector;
  */
 Function::~Function()
 {
-    if (_function != NULL)
-        delete _function;
+    delete _function.load();
 }
 //_____________________________________________________________________________
 /**
@@ -161,35 +160,52 @@ evaluateTotalSecondDerivative(double aX,double aDxdt,double aD2xdt2)
 */
 double Function::calcValue(const Vector& x) const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->calcValue(x);
+    return getSimTKFunction().calcValue(x);
+}
+
+double Function::calcValueAt(double x, int* /*interval*/) const
+{
+    return calcValue(SimTK::Vector(1, x));
+}
+
+double Function::calcDerivativeAt(double x, int order,
+        int* /*interval*/) const
+{
+    return calcDerivative(std::vector<int>(order, 0), SimTK::Vector(1, x));
 }
 
 double Function::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->calcDerivative(derivComponents, x);
+    return getSimTKFunction().calcDerivative(derivComponents, x);
 }
 
 int Function::getArgumentSize() const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->getArgumentSize();
+    return getSimTKFunction().getArgumentSize();
 }
 
 int Function::getMaxDerivativeOrder() const
 {
-    if (_function == NULL)
-        _function = createSimTKFunction();
-    return _function->getMaxDerivativeOrder();
+    return getSimTKFunction().getMaxDerivativeOrder();
 }
 
 void Function::resetFunction()
 {
-    if (_function != NULL)
-        delete _function;
-    _function = NULL;
+    delete _function.exchange(nullptr);
+}
+
+const SimTK::Function& Function::getSimTKFunction() const
+{
+    SimTK::Function* function = _function.load();
+    if (function == nullptr) {
+        // If several threads create the function at the same time, only the
+        // first one to finish is kept.
+        SimTK::Function* created = createSimTKFunction();
+        if (_function.compare_exchange_strong(function, created)) {
+            function = created;
+        } else {
+            delete created;
+        }
+    }
+    return *function;
 }
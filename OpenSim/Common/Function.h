@@ -31,6 +31,7 @@
 // INCLUDES
 #include "Object.h"
 #include "SimTKmath.h"
+#include <atomic>
 
 
 //=============================================================================
@@ -58,8 +59,9 @@ OpenSim_DECLARE_ABSTRACT_OBJECT(Function, Object);
 // DATA
 //=============================================================================
 protected:
-    // The SimTK::Function object implementing this function.
-    mutable SimTK::Function* _function;
+    // The SimTK::Function object implementing this function. It is created
+    // when first needed, possibly by several threads at once.
+    mutable std::atomic<SimTK::Function*> _function;
 
 //=============================================================================
 // METHODS
@@ -102,6 +104,20 @@ public:
      *          its size must equal the value returned by getArgumentSize().
      */
     virtual double calcValue(const SimTK::Vector& x) const;
+    /**
+     * Calculate the value of a function of a single argument (e.g., time)
+     * without allocating an argument Vector. The default implementation
+     * forwards to calcValue(const SimTK::Vector&).
+     *
+     * @param x        the argument.
+     * @param interval (optional) the index of the interval (e.g., the knot
+     *                 interval of a spline) that contained the previous
+     *                 argument; start with 0. Functions that search for an
+     *                 interval start the search at this index and update it,
+     *                 so a caller that keeps one index per function evaluates
+     *                 nondecreasing arguments without a full search.
+     */
+    virtual double calcValueAt(double x, int* interval = nullptr) const;
     /**
      * Calculate a partial derivative of this function at a particular point.  Which derivative to take is specified
      * by listing the input components with which to take it.  For example, if derivComponents=={0}, that indicates
@@ -114,6 +130,18 @@ public:
      * @param x                the Vector of input arguments.  Its size must equal the value returned by getArgumentSize().
      */
     virtual double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
+    /**
+     * Calculate a derivative of a function of a single argument without
+     * allocating an argument Vector or derivative components. The default
+     * implementation forwards to calcDerivative(const std::vector<int>&,
+     * const SimTK::Vector&).
+     *
+     * @param x        the argument.
+     * @param order    the order of the derivative (1 or greater).
+     * @param interval (optional) see calcValueAt().
+     */
+    virtual double calcDerivativeAt(double x, int order,
+            int* interval = nullptr) const;
     /**
      * Get the number of components expected in the input vector.
      */
@@ -135,6 +163,13 @@ protected:
      */
     void resetFunction();
 
+    /**
+     * The SimTK::Function that implements this function, which is created
+     * (once, even if several threads call this at the same time) with
+     * createSimTKFunction() when first needed.
+     */
+    const SimTK::Function& getSimTKFunction() const;
+
 //=============================================================================
 };  // END class Function
 
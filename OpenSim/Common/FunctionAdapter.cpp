@@ -44,18 +44,39 @@ FunctionAdapter::FunctionAdapter(const OpenSim::Function& aFunction) : _function
 //=============================================================================
 // SimTK::Function METHODS
 //=============================================================================
+// Functions of a single argument are evaluated with calcValueAt() and
+// calcDerivativeAt(), which neither allocate nor (for splines) search all
+// knot intervals. The interval is only a hint, so it is fine if threads that
+// share this adapter overwrite each other's interval.
 double FunctionAdapter::calcValue(const Vector& x) const {
+    if (x.size() == 1) {
+        int interval = _interval.load(std::memory_order_relaxed);
+        const double value = _function.calcValueAt(x[0], &interval);
+        _interval.store(interval, std::memory_order_relaxed);
+        return value;
+    }
     return _function.calcValue(x);
 }
 double FunctionAdapter::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const {
+    if (x.size() == 1 && !derivComponents.empty())
+        return calcDerivativeAt(x[0], (int)derivComponents.size());
     return _function.calcDerivative(derivComponents, x);
 }
 
 double FunctionAdapter::calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const{
+    if (x.size() == 1 && !derivComponents.empty())
+        return calcDerivativeAt(x[0], (int)derivComponents.size());
     std::vector<int> dcs(derivComponents.begin(), derivComponents.end());
     return _function.calcDerivative(dcs, x);
 }
 
+double FunctionAdapter::calcDerivativeAt(double x, int order) const {
+    int interval = _interval.load(std::memory_order_relaxed);
+    const double value = _function.calcDerivativeAt(x, order, &interval);
+    _interval.store(interval, std::memory_order_relaxed);
+    return value;
+}
+
 int FunctionAdapter::getArgumentSize() const {
     return _function.getArgumentSize();
 }
@@ -27,6 +27,8 @@
 // INCLUDES
 #include "Function.h"
 
+#include <atomic>
+
 
 //=============================================================================
 //=============================================================================
@@ -48,6 +50,9 @@ protected:
     // REFERENCES
     /** The OpenSim::Function used to evaluate this function. */
     const OpenSim::Function& _function;
+    /** The knot interval of the previous evaluation (see
+    Function::calcValueAt()). */
+    mutable std::atomic<int> _interval{0};
 
 //=============================================================================
 // METHODS
@@ -60,6 +65,7 @@ public:
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
 private:
+    double calcDerivativeAt(double x, int order) const;
     FunctionAdapter();
     FunctionAdapter& operator=(FunctionAdapter& function);
 
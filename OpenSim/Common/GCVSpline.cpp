@@ -580,6 +580,80 @@ addPoint(double aX, double aY)
     return i;
 }
 
+void GCVSpline::calcValuesAndDerivatives(const SimTK::Vector& times,
+        SimTK::Vector& values, SimTK::Vector& firstDerivatives,
+        SimTK::Vector& secondDerivatives) const
+{
+    // The coefficients are (re)computed when the SimTK::Spline is created.
+    if(_function == NULL) _function = createSimTKFunction();
+
+    const int nt = times.size();
+    values.resize(nt);
+    firstDerivatives.resize(nt);
+    secondDerivatives.resize(nt);
+
+    const int m = _halfOrder;
+    const int n = _x.getSize();
+    if(nt == 0 || n == 0) {
+        values = SimTK::NaN;
+        firstDerivatives = SimTK::NaN;
+        secondDerivatives = SimTK::NaN;
+        return;
+    }
+    // splder() does not modify the knots or the coefficients.
+    double* x = const_cast<double*>(&_x[0]);
+    double* c = const_cast<double*>(&_coefficients[0]);
+    std::vector<double> work(2*m);
+    int l = 1;
+    for(int i = 0; i < nt; ++i) {
+        const double t = times[i];
+        values[i] = splder(0, m, n, t, x, c, &l, work.data());
+        firstDerivatives[i] = splder(1, m, n, t, x, c, &l, work.data());
+        secondDerivatives[i] = splder(2, m, n, t, x, c, &l, work.data());
+    }
+}
+
+double GCVSpline::calcValueAt(double t, int* interval) const
+{
+    // The coefficients are (re)computed when the SimTK::Spline is created.
+    if(_function == NULL) _function = createSimTKFunction();
+
+    const int m = _halfOrder;
+    const int n = _x.getSize();
+    if(n == 0) return SimTK::NaN;
+    if(m > 4) return Function::calcValueAt(t, interval);
+    // splder() does not modify the knots or the coefficients. Its interval
+    // index is 1-based.
+    double* x = const_cast<double*>(&_x[0]);
+    double* c = const_cast<double*>(&_coefficients[0]);
+    double work[8];
+    int l = (interval && *interval >= 1) ? *interval : 1;
+    const double value = splder(0, m, n, t, x, c, &l, work);
+    if(interval) *interval = l;
+    return value;
+}
+
+double GCVSpline::calcDerivativeAt(double t, int order, int* interval) const
+{
+    // The coefficients are (re)computed when the SimTK::Spline is created.
+    if(_function == NULL) _function = createSimTKFunction();
+
+    const int m = _halfOrder;
+    const int n = _x.getSize();
+    if(n == 0) return SimTK::NaN;
+    if(m > 4 || order < 1 || order >= 2*m)
+        return Function::calcDerivativeAt(t, order, interval);
+    // splder() does not modify the knots or the coefficients. Its interval
+    // index is 1-based.
+    double* x = const_cast<double*>(&_x[0]);
+    double* c = const_cast<double*>(&_coefficients[0]);
+    double work[8];
+    int l = (interval && *interval >= 1) ? *interval : 1;
+    const double value = splder(order, m, n, t, x, c, &l, work);
+    if(interval) *interval = l;
+    return value;
+}
+
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
     Vector x(_x.getSize());
@@ -233,6 +233,29 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Evaluate the spline and its first and second derivatives at each of
+     * the given times. This gives the same values as calcValue() and
+     * calcDerivative(), but the knot interval containing each time is used
+     * as the starting point of the search for the next time, and no memory
+     * is allocated per time. Evaluating nondecreasing times (e.g., all the
+     * frames of a trajectory) therefore takes constant time per time.
+     *
+     * @param times Times at which to evaluate the spline.
+     * @param values Values of the spline (resized to times.size()).
+     * @param firstDerivatives First derivatives (resized to times.size()).
+     * @param secondDerivatives Second derivatives (resized to times.size()).
+     */
+    void calcValuesAndDerivatives(const SimTK::Vector& times,
+            SimTK::Vector& values, SimTK::Vector& firstDerivatives,
+            SimTK::Vector& secondDerivatives) const;
+    /** Evaluate the spline directly from its coefficients, starting the
+    search for the knot interval at `interval` (if provided). */
+    double calcValueAt(double x, int* interval = nullptr) const override;
+    /** Evaluate a derivative of the spline directly from its coefficients,
+    starting the search for the knot interval at `interval` (if provided). */
+    double calcDerivativeAt(double x, int order,
+            int* interval = nullptr) const override;
 
 //=============================================================================
 };  // END class GCVSpline
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "GCVSplineSet.h"
+#include "CommonUtilities.h"
 #include "GCVSpline.h"
 #include "Storage.h"
 
@@ -68,12 +69,36 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines();
+}
+
+GCVSplineSet::GCVSplineSet(const FlattenedTableView& table,
+                           const std::vector<std::string>& labels,
+                           int degree,
+                           double errorVariance) {
+    const auto& time = table.getIndependentColumn();
+    const auto& labelsToUse = labels.empty() ? table.getColumnLabels() : labels;
+    for (const auto& label : labelsToUse) {
+        // GCVSpline requires contiguous values; only one column is copied
+        // at a time.
+        const SimTK::Vector column(table.getDependentColumn(label));
+        adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
+                                     &column[0], label, errorVariance));
+    }
+    fitSplines();
 }
 
 void GCVSplineSet::setNull() {
     // No operation.
 }
 
+void GCVSplineSet::fitSplines() {
+    // The columns are independent, so the splines are fitted in parallel.
+    // getArgumentSize() creates (and caches) the underlying SimTK::Spline,
+    // which is where the fit happens and the coefficients are computed.
+    parallelFor(getSize(), [this](int i) { get(i).getArgumentSize(); });
+}
+
 void GCVSplineSet::construct(int aDegree,
                              const Storage *aStore,
                              double aErrorVariance) {
@@ -115,11 +140,9 @@ void GCVSplineSet::construct(int aDegree,
             name = tmp;
         }
 
-        // CONSTRUCT SPLINE
+        // CONSTRUCT SPLINE (it is fitted below)
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -129,6 +152,8 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    fitSplines();
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
@@ -215,6 +240,36 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     return(store);
 }
 
+void GCVSplineSet::evaluate(const SimTK::Vector& times,
+        SimTK::Matrix& values, SimTK::Matrix& firstDerivatives,
+        SimTK::Matrix& secondDerivatives) const {
+    const int nt = times.size();
+    const int nf = getSize();
+    values.resize(nt, nf);
+    firstDerivatives.resize(nt, nf);
+    secondDerivatives.resize(nt, nf);
+
+    SimTK::Vector value(nt), first(nt), second(nt);
+    const std::vector<int> d1{0}, d2{0, 0};
+    for (int j = 0; j < nf; ++j) {
+        // getGCVSpline() does not check the type of the function.
+        if (const auto* spline = dynamic_cast<const GCVSpline*>(&get(j))) {
+            spline->calcValuesAndDerivatives(times, value, first, second);
+        } else {
+            const Function& function = get(j);
+            for (int i = 0; i < nt; ++i) {
+                const SimTK::Vector t(1, times[i]);
+                value[i] = function.calcValue(t);
+                first[i] = function.calcDerivative(d1, t);
+                second[i] = function.calcDerivative(d2, t);
+            }
+        }
+        values(j) = value;
+        firstDerivatives(j) = first;
+        secondDerivatives(j) = second;
+    }
+}
+
 double GCVSplineSet::getMinX() const
 {
     double min = SimTK::Infinity;
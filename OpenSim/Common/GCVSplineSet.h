@@ -31,6 +31,7 @@
 #include "osimCommonDLL.h"
 #include "Object.h"
 #include "FunctionSet.h"
+#include "TableViews.h"
 #include "TimeSeriesTable.h"
 
 
@@ -107,6 +108,17 @@ public:
                  const std::vector<std::string>& labels = {},
                  int degree                             = 5,
                  double errorVariance                   = 0.0);
+#ifndef SWIG
+    /**
+     * Same as above, for a flattened view of a table (e.g., of the Vec3
+     * columns of a marker table), which avoids flattening the table first.
+     * @see FlattenedTableView
+     */
+    GCVSplineSet(const FlattenedTableView& table,
+                 const std::vector<std::string>& labels = {},
+                 int degree                             = 5,
+                 double errorVariance                   = 0.0);
+#endif
     virtual ~GCVSplineSet();
 
 private:
@@ -125,6 +137,11 @@ private:
      */
     void construct(int aDegree,const Storage *aStore,double aErrorVariance);
 
+    /**
+     * Fit all splines in the set (in parallel, since they are independent).
+     */
+    void fitSplines();
+
 public:
     /**
      * Get the function at a specified index.
@@ -134,6 +151,19 @@ public:
      *         returned.
      */
     GCVSpline* getGCVSpline(int aIndex) const;
+
+    /**
+     * Evaluate all functions in the set, and their first and second
+     * derivatives, at each of the given times. Element (i, j) of each matrix
+     * is for times[i] and the function at index j. GCVSpline%s are evaluated
+     * with GCVSpline::calcValuesAndDerivatives(), which is fastest when the
+     * times are nondecreasing; other functions (e.g., a Constant inserted in
+     * the set) are evaluated one time at a time.
+     */
+    void evaluate(const SimTK::Vector& times, SimTK::Matrix& values,
+            SimTK::Matrix& firstDerivatives,
+            SimTK::Matrix& secondDerivatives) const;
+
     double getMinX() const;
     double getMaxX() const;
 
@@ -25,6 +25,8 @@
 #include "TimeSeriesTable.h"
 #include "DataAdapter.h"
 
+#include <memory>
+
 /** @file
 * This file defines common base class for various IMU DataReader
 * classes that support different IMU providers
@@ -32,6 +34,48 @@
 
 namespace OpenSim {
 
+/** A single time frame of IMU data, with one entry per sensor (in the order
+of the sensors in the reader's settings). Entries for data that are not
+present in the file(s) are NaN. */
+struct IMUDataFrame {
+    double time = SimTK::NaN;
+    SimTK::RowVector_<SimTK::Quaternion> orientations;
+    SimTK::RowVector_<SimTK::Vec3> linearAccelerations;
+    SimTK::RowVector_<SimTK::Vec3> magneticHeading;
+    SimTK::RowVector_<SimTK::Vec3> angularVelocity;
+};
+
+/** Reads a trial one frame at a time, so that trials that do not fit in memory
+can be processed. Streams are created by IMUDataReader::openStream():
+@code
+XsensDataReader reader(settings);
+auto stream = reader.openStream(folder);
+IMUDataFrame frame;
+while (stream->readNextFrame(frame)) {
+    // Use frame.time, frame.orientations, ...
+}
+@endcode */
+class OSIMCOMMON_API IMUDataStream {
+public:
+    virtual ~IMUDataStream() = default;
+    /** Names of the sensors in the model (one per column). */
+    const std::vector<std::string>& getLabels() const { return _labels; }
+    double getDataRate() const { return _dataRate; }
+    bool hasLinearAccelerations() const { return _hasLinearAccelerations; }
+    bool hasMagneticHeading() const { return _hasMagneticHeading; }
+    bool hasAngularVelocity() const { return _hasAngularVelocity; }
+    /** Read the next frame into `frame`, resizing its vectors as necessary.
+    Returns false (and leaves `frame` unchanged) once the end of the data has
+    been reached. */
+    virtual bool readNextFrame(IMUDataFrame& frame) = 0;
+protected:
+    std::vector<std::string> _labels;
+    double _dataRate = SimTK::NaN;
+    bool _hasLinearAccelerations = false;
+    bool _hasMagneticHeading = false;
+    bool _hasAngularVelocity = false;
+};
+
 
 class OSIMCOMMON_API IMUDataReader : public DataAdapter {
 
@@ -67,6 +111,11 @@ public:
     static const TimeSeriesTableVec3& getAngularVelocityTable(const DataAdapter::OutputTables& tables) {
         return dynamic_cast<const TimeSeriesTableVec3&>(*tables.at(AngularVelocity));
     }
+    /** Open a trial for reading one frame at a time rather than reading the
+    whole trial into tables with read(). The argument is interpreted as in
+    read(). */
+    virtual std::unique_ptr<IMUDataStream> openStream(
+            const std::string& sourceName) const = 0;
 protected:
     /** create a map of names to TimeSeriesTables. MetaData contains dataRate.
      * The result can be passed to accessors above to get individual TimeSeriesTable(s)
@@ -102,6 +102,21 @@ public:
     // EVALUATION
     //--------------------------------------------------------------------------
     SimTK::Function* createSimTKFunction() const override;
+    /** For a function of a single argument, evaluate slope*x + intercept
+    without creating the SimTK::Function. */
+    double calcValueAt(double x, int* interval = nullptr) const override
+    {
+        if (_coefficients.getSize() != 2)
+            return Function::calcValueAt(x, interval);
+        return _coefficients[0] * x + _coefficients[1];
+    }
+    double calcDerivativeAt(double x, int order,
+            int* interval = nullptr) const override
+    {
+        if (_coefficients.getSize() != 2)
+            return Function::calcDerivativeAt(x, order, interval);
+        return order == 1 ? _coefficients[0] : 0.0;
+    }
 
 //=============================================================================
 };  // END class LinearFunction
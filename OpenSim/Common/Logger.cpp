@@ -26,6 +26,7 @@
 #include "IO.h"
 #include "LogSink.h"
 
+#include "spdlog/async.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 using namespace OpenSim;
@@ -90,9 +91,18 @@ return true;
 #endif
 }
 
+// the background thread (and its queue) used by the asynchronous loggers; null
+// when logging synchronously
+static std::shared_ptr<spdlog::details::thread_pool> asyncThreadPool = nullptr;
+
+// loggers of the innermost Logger::ScopedThreadLog of this thread, if any
+static thread_local spdlog::logger* threadDefaultLogger = nullptr;
+static thread_local spdlog::logger* threadCoutLogger = nullptr;
+
 // this function is only called when the caller is about to log something, so
 // it should perform lazy initialization of the file sink
 spdlog::logger& Logger::getCoutLogger() {
+    if (threadCoutLogger) return *threadCoutLogger;
     initFileLoggingAsNeeded();
     return *coutLogger;
 }
@@ -100,6 +110,7 @@ spdlog::logger& Logger::getCoutLogger() {
 // this function is only called when the caller is about to log something, so
 // it should perform lazy initialization of the file sink
 spdlog::logger& Logger::getDefaultLogger() {
+    if (threadDefaultLogger) return *threadDefaultLogger;
     initFileLoggingAsNeeded();
     return *defaultLogger;
 }
@@ -273,4 +284,98 @@ void Logger::removeSink(const std::shared_ptr<LogSink> sink) {
     removeSinkInternal(std::static_pointer_cast<spdlog::sinks::sink>(sink));
 }
 
+// create a logger with the same name, sinks and levels as `original`, that
+// writes to its sinks on the asyncThreadPool if the pool exists
+static std::shared_ptr<spdlog::logger> copyLogger(
+        const spdlog::logger& original, spdlog::async_overflow_policy policy) {
+    const auto& sinks = original.sinks();
+    std::shared_ptr<spdlog::logger> copy;
+    if (asyncThreadPool) {
+        copy = std::make_shared<spdlog::async_logger>(original.name(),
+                sinks.begin(), sinks.end(), asyncThreadPool, policy);
+    } else {
+        copy = std::make_shared<spdlog::logger>(
+                original.name(), sinks.begin(), sinks.end());
+    }
+    // the sinks keep their formatters, so the pattern is not set here
+    copy->set_level(original.level());
+    copy->flush_on(original.flush_level());
+    return copy;
+}
+
+static void replaceLoggers(spdlog::async_overflow_policy policy) {
+    auto newCoutLogger = copyLogger(*coutLogger, policy);
+    auto newDefaultLogger = copyLogger(*defaultLogger, policy);
+    spdlog::drop(coutLogger->name());
+    spdlog::register_logger(newCoutLogger);
+    spdlog::set_default_logger(newDefaultLogger);
+    coutLogger = newCoutLogger;
+    defaultLogger = newDefaultLogger;
+}
+
+void Logger::setAsync(bool async, int queueSize, OverflowPolicy policy) {
+    OPENSIM_THROW_IF(queueSize < 1, Exception,
+            "Expected queueSize to be positive, but got {}.", queueSize);
+    const auto spdlogPolicy = policy == OverflowPolicy::DiscardOldest
+                                      ? spdlog::async_overflow_policy::overrun_oldest
+                                      : spdlog::async_overflow_policy::block;
+    if (async) {
+        // replace an existing pool so that the new queue size is used
+        auto previousPool = asyncThreadPool;
+        asyncThreadPool = std::make_shared<spdlog::details::thread_pool>(
+                (size_t)queueSize, 1);
+        replaceLoggers(spdlogPolicy);
+        // destroying the previous pool writes the messages in its queue
+        previousPool.reset();
+    } else if (asyncThreadPool) {
+        auto previousPool = asyncThreadPool;
+        asyncThreadPool.reset();
+        replaceLoggers(spdlogPolicy);
+        previousPool.reset();
+    }
+}
+
+bool Logger::isAsync() {
+    return asyncThreadPool != nullptr;
+}
+
+void Logger::flush() {
+    getCoutLogger().flush();
+    getDefaultLogger().flush();
+}
+
+Logger::ScopedThreadLog::ScopedThreadLog(const std::string& filepath) {
+    // only this thread writes to the sink, so it does not need a mutex
+    activate(std::make_shared<spdlog::sinks::basic_file_sink_st>(
+            filepath, true));
+}
+
+Logger::ScopedThreadLog::ScopedThreadLog(std::shared_ptr<LogSink> sink) {
+    OPENSIM_THROW_IF(!sink, Exception, "Expected a sink, but got null.");
+    activate(std::static_pointer_cast<spdlog::sinks::sink>(sink));
+}
+
+void Logger::ScopedThreadLog::activate(spdlog::sink_ptr sink) {
+    // these loggers are not registered with spdlog, so they are not affected
+    // by changes to the global level after they are created; they defer to
+    // Logger::shouldLog() instead
+    m_defaultLogger = std::make_shared<spdlog::logger>("", sink);
+    m_defaultLogger->set_level(spdlog::level::trace);
+    m_defaultLogger->flush_on(defaultLogger->flush_level());
+    m_coutLogger = std::make_shared<spdlog::logger>("cout", sink);
+    m_coutLogger->set_level(spdlog::level::trace);
+    m_coutLogger->flush_on(coutLogger->flush_level());
+
+    m_previousDefaultLogger = threadDefaultLogger;
+    m_previousCoutLogger = threadCoutLogger;
+    threadDefaultLogger = m_defaultLogger.get();
+    threadCoutLogger = m_coutLogger.get();
+}
+
+Logger::ScopedThreadLog::~ScopedThreadLog() {
+    m_defaultLogger->flush();
+    threadDefaultLogger = m_previousDefaultLogger;
+    threadCoutLogger = m_previousCoutLogger;
+}
+
 
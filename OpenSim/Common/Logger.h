@@ -182,6 +182,70 @@ public:
     /// @note This function is not thread-safe. Do not invoke this function
     /// concurrently, or concurrently with addLogFile() or addSink().
     static void removeSink(const std::shared_ptr<LogSink> sink);
+
+    /// @name Asynchronous logging
+    /// @{
+
+    /// What to do when a message is logged while the queue of the
+    /// asynchronous logger is full.
+    enum class OverflowPolicy {
+        /// The logging thread waits until there is room in the queue.
+        Block,
+        /// The oldest message in the queue is discarded.
+        DiscardOldest
+    };
+
+    /// Write messages to the sinks (console, file, and any sinks added with
+    /// addSink()) on a background thread. Logging a message then only
+    /// formats it into a queue of at most `queueSize` messages, so threads
+    /// that log (e.g., parallel solves) are not slowed down by slow sinks or
+    /// file systems, and do not wait on each other while the sinks write.
+    /// Calling setAsync(false) writes all queued messages and stops the
+    /// background thread.
+    /// @note This function is not thread-safe. Do not invoke this function
+    /// while other threads are logging messages, or concurrently with
+    /// addFileSink(), addSink() or removeSink().
+    static void setAsync(bool async, int queueSize = 8192,
+            OverflowPolicy policy = OverflowPolicy::Block);
+    static bool isAsync();
+
+    /// Flush all sinks. When logging asynchronously, the flush is queued
+    /// behind the messages that have already been logged.
+    static void flush();
+
+    /// While an object of this class exists, all messages logged from the
+    /// thread that created it (including those from log_cout()) go only to
+    /// the sinks of this object instead of to the global sinks. This allows
+    /// batch runs to give each job (e.g., each thread of a thread pool) its
+    /// own log without contending on the global sinks. The messages are
+    /// filtered with the global level (setLevel()). Objects may be nested;
+    /// the previous sinks of the thread are restored when an object is
+    /// destroyed. The object must be destroyed on the thread that created it.
+    /// @code
+    /// {
+    ///     Logger::ScopedThreadLog log("job3.log");
+    ///     study.solve(); // Messages go to job3.log.
+    /// }
+    /// @endcode
+    class OSIMCOMMON_API ScopedThreadLog {
+    public:
+        /// Log messages from this thread to the file `filepath` (which is
+        /// overwritten).
+        explicit ScopedThreadLog(const std::string& filepath);
+        /// Log messages from this thread to the provided sink.
+        explicit ScopedThreadLog(std::shared_ptr<LogSink> sink);
+        ScopedThreadLog(const ScopedThreadLog&) = delete;
+        ScopedThreadLog& operator=(const ScopedThreadLog&) = delete;
+        ~ScopedThreadLog();
+    private:
+        void activate(spdlog::sink_ptr sink);
+        std::shared_ptr<spdlog::logger> m_defaultLogger;
+        std::shared_ptr<spdlog::logger> m_coutLogger;
+        spdlog::logger* m_previousDefaultLogger = nullptr;
+        spdlog::logger* m_previousCoutLogger = nullptr;
+    };
+
+    /// @}
 private:
     static spdlog::logger& getCoutLogger();
     static spdlog::logger& getDefaultLogger();
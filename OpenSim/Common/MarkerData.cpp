@@ -73,48 +73,60 @@ inline void addNumRowsNumColumns(const std::string& filenameOld,
  * Default constructor.
  */
 MarkerData::MarkerData() :
-    _numFrames(0),
-    _numMarkers(0),
+    _firstFrameNumber(1),
+    _dataRate(0),
+    _cameraRate(0),
+    _originalDataRate(0),
+    _originalStartFrame(1),
+    _originalNumFrames(0),
     _markerNames("")
 {
 }
 
 //_____________________________________________________________________________
 /**
- * Constructor from a TRB/TRC file.
+ * Constructor from a TRC, C3D or STO file.
  */
-MarkerData::MarkerData(const string& aFileName) :
-    _numFrames(0),
-    _numMarkers(0),
-    _markerNames("")
+MarkerData::MarkerData(const string& aFileName) : MarkerData()
 {
+    readFile(aFileName, TableReadFilter{});
 
-#if 0
-   if (!aFileName)
-        return;
+    log_info("Loaded marker file {} ({} markers, {} frames)",
+            _fileName, getNumMarkers(), getNumFrames());
+}
 
-   if (!lookForFile(aFileName, gWorkingDir.c_str(), actualFilename))
-   {
-      return smFileError;
-   }
-#endif
+//_____________________________________________________________________________
+/**
+ * Constructor from the frames of a TRC, C3D or STO file in a time range.
+ */
+MarkerData::MarkerData(const string& aFileName, double aStartTime,
+        double aEndTime) : MarkerData()
+{
+    if (aStartTime > aEndTime)
+        throw Exception("MarkerData: start time is past end time.");
+
+    TableReadFilter filter;
+    filter.initialTime = aStartTime;
+    filter.finalTime = aEndTime;
+    readFile(aFileName, filter);
+    // The range lies between two frames (or outside of the data).
+    if (getNumFrames() == 0)
+        readFile(aFileName, TableReadFilter{});
+
+    log_info("Loaded marker file {} ({} markers, {} frames from time {} to {})",
+            _fileName, getNumMarkers(), getNumFrames(), getStartFrameTime(),
+            getLastFrameTime());
+}
 
-   /* Check if the suffix is TRC or TRB. Will read TRC by default */
-    string suffix;
-   int dot = (int)aFileName.find_last_of(".");
-   suffix.assign(aFileName, dot+1, 3);
-   SimTK::String sExtension(suffix);
-   if (sExtension.toLower() == "trc") 
-      readTRCFile(aFileName, *this);
-   else if (sExtension.toLower() == "sto")
-       readStoFile(aFileName);
-   else
-       throw Exception("MarkerData: ERROR- Marker file type is unsupported",__FILE__,__LINE__);
-
-   _fileName = aFileName;
-
-   log_info("Loaded marker file {} ({} markers, {} frames)",
-           _fileName, _numMarkers, _numFrames);
+//_____________________________________________________________________________
+/**
+ * Constructor from a table of marker locations.
+ */
+MarkerData::MarkerData(const TimeSeriesTable_<Vec3>& aTable,
+        const string& aFileName) : MarkerData()
+{
+    setTable(aTable);
+    _fileName = aFileName;
 }
 
 //_____________________________________________________________________________
@@ -130,371 +142,65 @@ MarkerData::~MarkerData()
 //=============================================================================
 //_____________________________________________________________________________
 /**
- * Read TRC file.
+ * Read a marker file. The type of the file is determined by its suffix; TRC
+ * files are read by default.
  *
- * @param aFilename name of TRC file.
- * @param aSMD MarkerData object to hold the file contents
+ * @param aFileName name of the marker file.
+ * @param aFilter the frames (and markers) to read.
  */
-void MarkerData::readTRCFile(const string& aFileName, MarkerData& aSMD)
+void MarkerData::readFile(const string& aFileName,
+        const TableReadFilter& aFilter)
 {
-   ifstream in;
-   string line, buffer;
-   int frameNum, coordsRead;
-   double time;
-    SimTK::Vec3 coords;
-
     if (aFileName.empty())
-        throw Exception("MarkerData.readTRCFile: ERROR- Marker file name is empty",__FILE__,__LINE__);
-
-   in.open(aFileName.c_str());
-
-    if (!in.good())
-    {
-        string errorMessage;
-        errorMessage = "Unable to open marker file " + aFileName;
-        throw Exception(errorMessage);
-    }
-
-   readTRCFileHeader(in, aFileName, aSMD);
-
-   /* read frame data */
-   while (getline(in, line))
-   {
-      /* skip over any blank lines */
-      if (findFirstNonWhiteSpace(line) == -1)
-         continue;
+        throw Exception("MarkerData: ERROR- Marker file name is empty",__FILE__,__LINE__);
 
-        if (aSMD._frames.getSize() == aSMD._numFrames)
-        {
-#if 0
-            if (gUseGlobalMessages)
-            {
-                gErrorBuffer += "Extra data found at end of tracked marker file. ";
-                gErrorBuffer += "Header declared only " + intToString(trc->header.numFrames) + " frames.\n";
-            }
-            rc = smFileWarning;
-#endif
-            break;
-        }
-
-      if (!readIntegerFromString(line, &frameNum))
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += "Could not read frame number in tracked marker file.\n";
-         rc = smFileError;
-         goto cleanup;
-#endif
-      }
-
-      if (!readDoubleFromString(line, &time))
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += "Could not read time in tracked marker file.\n";
-         rc = smFileError;
-         goto cleanup;
-#endif
-      }
-
-        MarkerFrame *frame = new MarkerFrame(aSMD._numMarkers, frameNum, time, aSMD._units);
-
-      /* keep reading sets of coordinates until the end of the line is
-       * reached. If more coordinates were read than there are markers,
-       * return an error.
-       */
-      coordsRead = 0;
-      bool allowNaNs = true;
-      while (readCoordinatesFromString(line, &coords[0], allowNaNs))
-      {
-         if (coordsRead >= aSMD._numMarkers)
-         {
-            break;
-
-#if 0  // Don't return an error because many TRC files have extra data at the ends of rows
-            if (gUseGlobalMessages)
-               gErrorBuffer += "Extra data found in frame number " + intToString(frameNum) +
-                               " in tracked marker file.\n";
-            rc = smFileError;
-            // delete the current markerCoordList because framesRead has not been incremented yet.
-            delete [] f->markerCoordList;
-            goto cleanup;
-#endif
-         }
-         if (coordsRead < aSMD._numMarkers)
-                frame->addMarker(coords);
-         coordsRead++;
-      }
-
-      if (coordsRead < aSMD._numMarkers)
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += " Missing data in frame number " + intToString(frameNum) +
-                            " in tracked marker file.\n";
-         rc = smFileError;
-         // delete the current markerCoordList because framesRead has not been incremented yet.
-         delete [] f->markerCoordList;
-         goto cleanup;
-#endif
-      }
-        aSMD._frames.append(frame);
-   }
-
-   if (aSMD._frames.getSize() < aSMD._numFrames)
-   {
-#if 0
-      if (gUseGlobalMessages)
-         gErrorBuffer += "Missing data in tracked marker file. Only " + intToString(framesRead) + " of " +
-                         intToString(trc->header.numFrames) + " frames found.\n";
-      rc = smFileError;
-      goto cleanup;
-#endif
-        aSMD._numFrames = aSMD._frames.getSize();
-   }
-
-   /* If the user-defined frame numbers are not contiguous from the first frame to the
-    * last, reset them to a contiguous array. This is necessary because the user-defined
-    * numbers are used to index the array of frames.
-    */
-    if (aSMD._frames[aSMD._numFrames-1]->getFrameNumber() - aSMD._frames[0]->getFrameNumber() !=
-         aSMD._numFrames - 1)
-   {
-        int firstIndex = aSMD._frames[0]->getFrameNumber();
-      for (int i = 1; i < aSMD._numFrames; i++)
-            aSMD._frames[i]->setFrameNumber(firstIndex + i);
-   }
-
-#if 0
-   if (gUseGlobalMessages)
-   {
-      gMessage += "TRC file " + actualFileName + "\n\t" + intToString(trc->header.numFrames)
-                  + " frames\n\t" + intToString(trc->header.numMarkers) + " markers/frame\n";
-      gMessage += "Read " + intToString(framesRead) + " frames.\n";
-   }
-#endif
-
-//cleanup:
-   in.close();
-}
+    string suffix;
+    int dot = (int)aFileName.find_last_of(".");
+    suffix.assign(aFileName, dot+1, 3);
+    SimTK::String sExtension(suffix);
+    if (sExtension.toLower() == "trc")
+        setTable(TimeSeriesTable_<Vec3>(aFileName, aFilter));
+    else if (sExtension.toLower() == "c3d")
+        setTable(TimeSeriesTable_<Vec3>(aFileName, aFilter, "markers"));
+    else if (sExtension.toLower() == "sto")
+        readStoFile(aFileName, aFilter);
+    else
+        throw Exception("MarkerData: ERROR- Marker file type is unsupported",__FILE__,__LINE__);
 
-//_____________________________________________________________________________
-/**
- * Read TRC header.
- *
- * @param aStream stream to read from.
- * @param aFileName name of file that stream is from.
- * @param aSMD MarkerData object to hold the file contents
- */
-void MarkerData::readTRCFileHeader(ifstream &aStream, const string& aFileName, MarkerData& aSMD)
-{
-   string line, buffer;
-   int pathFileType, markersRead;
-   bool ok = true;
-
-   /* read first line in TRC header */
-   getline(aStream, line);
-
-   /* read "PathFileType" and path file type */
-   readStringFromString(line, buffer);
-   readIntegerFromString(line, &pathFileType);
-   if (buffer != "PathFileType" || (pathFileType != 3 && pathFileType != 4))
-   {
-        throw Exception("MarkerData: ERR- File "+aFileName+" does not appear to be a valid TRC file",__FILE__,__LINE__);
-#if 0
-      if (gUseGlobalMessages)
-         gErrorBuffer += "Unknown file type " + intToString(pathFileType) + " in TRC file" + actualFileName;
-      return smFileError;
-#endif
-   }
-
-   /* read line 2 - header info column names */
-   getline(aStream, line);
-
-   /* read line 3 - header info */
-   getline(aStream, line);
-   
-   /* read first 5 parameters from file */
-   ok = readDoubleFromString(line, &aSMD._dataRate);
-   ok = ok && readDoubleFromString(line, &aSMD._cameraRate);
-   ok = ok && readIntegerFromString(line, &aSMD._numFrames);
-   ok = ok && readIntegerFromString(line, &aSMD._numMarkers);
-   ok = ok && readStringFromString(line, buffer);
-
-   if (pathFileType == 3)
-   {
-      if (!ok)
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += "Could not read line 3 in TRC file " + actualFileName + ".\n";
-         return smFormatError;
-#endif
-      }
-      aSMD._originalDataRate = aSMD._dataRate;
-      aSMD._originalStartFrame = 1;
-      aSMD._originalNumFrames = aSMD._numFrames;
-   }
-   else if (pathFileType == 4)
-   {
-      ok = ok && readDoubleFromString(line, &aSMD._originalDataRate);
-      ok = ok && readIntegerFromString(line, &aSMD._originalStartFrame);
-      ok = ok && readIntegerFromString(line, &aSMD._originalNumFrames);
-      if (!ok)
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gErrorBuffer += "Could not read line3 in TRC file " + actualFileName + ".\n";
-         return smFormatError;
-#endif
-      }
-   }
-
-   aSMD._units = Units(buffer);
-
-   /* read line 4 - trc data column names */
-   getline(aStream, line);
-
-   /* read Frame# and Time */
-   readStringFromString(line, buffer);
-   readStringFromString(line, buffer);
-
-   /* read the marker names */
-   markersRead = 0;
-   while (!line.empty())
-   {
-      if (!readTabDelimitedStringFromString(line, buffer))
-         break;
-      if (markersRead >= aSMD._numMarkers)
-      {
-#if 0
-         if (gUseGlobalMessages)
-            gMessage += "More marker names in TRC file than in model. Ignoring extra marker names.\n";
-         break;
-#endif
-      }
-        aSMD._markerNames.append(buffer);
-      markersRead++;
-   }
-
-    /* If we don't read the header, we'll throw meaningful exception and abort rather than crash the machine!! */
-  if (markersRead < aSMD._numMarkers)
-   {
-        string errorMessage;
-        errorMessage = "Could not read all marker names in TRC file " + aFileName + 
-            ". Make sure there's exactly one tab per column & that Marker names are tab separated in header.\n";
-        throw Exception(errorMessage);
-
-   }
-
-   /* Store the position of the pointer into the file just before reading the
-    * coordinate labels. This is done because the first frame is read incorrectly
-    * in certain cases.
-     */
-   /////long pos = aStream.tellg();
-   /* read line 5 - coordinate labels (X1 Y1 Z1 X2 Y2 Z2 ...) */
-   getline(aStream, line);
-
-   /* The following code supports 0 or 1 blank lines before the first
-    * frame of data.  Read the line of code - if there is a blank line of code,
-    * read the next line which will contain the data.
-    */
-   /////getline(aStream, line);
-   /////if (line.empty())
-      /////getline(aStream, line);
-
-   /////if (!readIntegerFromString(line, &aSMD._firstFrameNumber))
-      aSMD._firstFrameNumber = 1;
-
-   /* reposition the pointer into the file so it points to before the coordinate
-    * labels */
-   /////aStream.seekg(pos, ios::beg);
-
-   /* reread the coordinate labels so pointer into file points to data */
-   /////getline(aStream, line);
-   /////if (line.empty())
-      /////getline(aStream, line);
+    _fileName = aFileName;
 }
 
 //_____________________________________________________________________________
 /**
- * Read TRB file.
- *
- * @param aFileName name of file to read.
- * @param aSMD MarkerData object to hold the file contents
+ * Store a table of marker locations and get the header information (rates
+ * and units) from its metadata.
  */
-void MarkerData::readTRBFile(const string& aFileName, MarkerData& aSMD)
+void MarkerData::setTable(TimeSeriesTable_<Vec3> aTable)
 {
-#if 0
-   int i, j, index, headerSize, numMarkersThisFrame;
-   unsigned short header[6];
-   long data[100];
-   FILE* file;
-
-   trc->filename = new char [actualFileName.size() + 1];
-   strcpy(trc->filename, actualFileName.c_str());
-
-   readTRBFileHeader(actualFileName, &trc->header, headerSize);
-
-   file = fopen(actualFileName.c_str(), "rb");
-
-   trc->frameList = new smTRCFrame [trc->header.numFrames];
-
-   fseek(file, headerSize, SEEK_SET);
-
-   for (i = 0; i < trc->header.numFrames; i++)
-   {
-      trc->frameList[i].frameNum = i;
-      trc->frameList[i].time = (double) i / trc->header.dataRate;
-      trc->frameList[i].units = trc->header.units;
-
-      trc->frameList[i].numMarkers = trc->header.numMarkers;
-      trc->frameList[i].markerCoordList = new smPoint3 [trc->frameList[i].numMarkers];
-
-      // initialize all the markers to UNDEFINED
-      for (j = 0; j < trc->frameList[i].numMarkers; j++)
-      {
-         trc->frameList[i].markerCoordList[j][0] = UNDEFINED_DOUBLE;
-         trc->frameList[i].markerCoordList[j][1] = UNDEFINED_DOUBLE;
-         trc->frameList[i].markerCoordList[j][2] = UNDEFINED_DOUBLE;
-      }
-
-      // now read the header to see how many markers are present
-      for (j = 0; j < 6; j++)
-         header[j] = _read_binary_unsigned_short(file);
-
-      numMarkersThisFrame = (header[4] - 3) / 6;
-
-      for (j = 0; j < numMarkersThisFrame; j++)
-      {
-         fread(data, 6*4, 1, file);
-
-         // the index of this marker is stored in the first data element
-         index = data[0] - 1;
-
-         // if the index is good, copy the marker coordinates
-         if (index >= 0 && index < trc->frameList[i].numMarkers)
-         {
-            trc->frameList[i].markerCoordList[index][0] = *(float *)(&data[1]);
-            trc->frameList[i].markerCoordList[index][1] = *(float *)(&data[2]);
-            trc->frameList[i].markerCoordList[index][2] = *(float *)(&data[3]);
-         }
-      }
-   }
-
-   goto finish;
-
-//invalid:
-   if (gUseGlobalMessages)
-      gErrorBuffer += "Cannot read " + actualFileName + ". File format is invalid.";
-   return smFormatError;
-
-   smFreeTRCStruct(trc);
+    _table = std::move(aTable);
+    _frames.clear();
+
+    const auto getNumber = [&](const string& aKey, double aDefault) {
+        if (!_table.hasTableMetaDataKey(aKey))
+            return aDefault;
+        try {
+            return std::stod(_table.getTableMetaDataAsString(aKey));
+        } catch (const std::exception&) {
+            return aDefault;
+        }
+    };
+    _dataRate = getNumber("DataRate", 0);
+    _cameraRate = getNumber("CameraRate", _dataRate);
+    _originalDataRate = getNumber("OrigDataRate", _dataRate);
+    _originalStartFrame = (int)getNumber("OrigDataStartFrame", 1);
+    _originalNumFrames = (int)getNumber("OrigNumFrames", getNumFrames());
+    _firstFrameNumber = 1;
+    if (_table.hasTableMetaDataKey("Units"))
+        _units = Units(_table.getTableMetaDataAsString("Units"));
 
-finish:
-   fclose(file);
-   return smNoError;
-#endif
+    _markerNames.setSize(0);
+    for (const auto& label : _table.getColumnLabels())
+        _markerNames.append(label);
 }
 
 //_____________________________________________________________________________
@@ -502,8 +208,10 @@ finish:
  * Read sto file.
  *
  * @param aFilename name of sto file.
+ * @param aFilter the frames to read.
  */
-void MarkerData::readStoFile(const string& aFileName)
+void MarkerData::readStoFile(const string& aFileName,
+        const TableReadFilter& aFilter)
 {
     if (aFileName.empty())
         throw Exception("MarkerData.readStoFile: ERROR- Marker file name is empty",__FILE__,__LINE__);
@@ -527,40 +235,40 @@ void MarkerData::readStoFile(const string& aFileName)
     }
     std::map<int, std::string>::iterator iter;
 
+    std::vector<std::string> markerNames;
     for (iter = markerIndices.begin(); iter != markerIndices.end(); iter++) {
         SimTK::String markerNameWithSuffix = iter->second;
         size_t dotIndex =
             SimTK::String::toLower(markerNameWithSuffix).find_last_of(".x");
         SimTK::String candidateMarkerName = markerNameWithSuffix.substr(0, dotIndex-1);
-        _markerNames.append(candidateMarkerName);
+        markerNames.push_back(candidateMarkerName);
     }
-    // use map to populate data for MarkerData header
-    _numMarkers = (int) markerIndices.size();
-    _numFrames = store.getSize();
-    _firstFrameNumber = 1;
-    _dataRate = 250;
-    _cameraRate = 250;
-    _originalDataRate = 250;
-    _originalStartFrame = 1;
-    _originalNumFrames = _numFrames;
-    _fileName = aFileName;
-    _units = Units(Units::Meters);
 
-    double time;
+    // Cycle through map and add Marker coordinates to the rows. Same order
+    // as header.
+    std::vector<double> times;
     int sz = store.getSize();
-    for (int i=0; i < sz; i++){
+    for (int i=0; i < sz; i++)
+        if (aFilter.keepsTime(store.getStateVector(i)->getTime()))
+            times.push_back(store.getStateVector(i)->getTime());
+    SimTK::Matrix_<Vec3> data((int)times.size(), (int)markerIndices.size());
+    for (int i=0, row=0; i < sz; i++){
         StateVector* nextRow = store.getStateVector(i);
-        time = nextRow->getTime();
-        int frameNum = i+1;
-        MarkerFrame *frame = new MarkerFrame(_numMarkers, frameNum, time, _units);
+        if (!aFilter.keepsTime(nextRow->getTime()))
+            continue;
         const Array<double>& rowData = nextRow->getData();
-        // Cycle through map and add Marker coordinates to the frame. Same order as header.
+        int col = 0;
         for (iter = markerIndices.begin(); iter != markerIndices.end(); iter++) {
             int startIndex = iter->first; // startIndex includes time but data doesn't!
-            frame->addMarker(SimTK::Vec3(rowData[startIndex-1], rowData[startIndex], rowData[startIndex+1]));
+            data(row, col++) = Vec3(rowData[startIndex-1], rowData[startIndex], rowData[startIndex+1]);
         }
-        _frames.append(frame);
-   }
+        row++;
+    }
+
+    TimeSeriesTable_<Vec3> table(times, data, markerNames);
+    table.addTableMetaData<std::string>("DataRate", "250");
+    table.addTableMetaData<std::string>("Units", Units(Units::Meters).getAbbreviation());
+    setTable(std::move(table));
 }
 /**
  * Helper function to check column labels of passed in Storage for possibly being a MarkerName, and if true
@@ -604,27 +312,29 @@ void MarkerData::buildMarkerMap(const Storage& storageToReadFrom, std::map<int,
 void MarkerData::findFrameRange(double aStartTime, double aEndTime, int& rStartFrame, int& rEndFrame) const
 {
     int i;
+    const int numFrames = getNumFrames();
+    const auto& times = _table.getIndependentColumn();
 
     rStartFrame = 0;
-    rEndFrame = _numFrames - 1;
+    rEndFrame = numFrames - 1;
 
     if (aStartTime > aEndTime)
     {
         throw Exception("MarkerData: findFrameRange start time is past end time.");
     }
 
-    for (i = _numFrames - 1; i >= 0 ; i--)
+    for (i = numFrames - 1; i >= 0 ; i--)
     {
-        if (_frames[i]->getFrameTime() <= aStartTime)
+        if (times[i] <= aStartTime)
         {
             rStartFrame = i;
             break;
         }
     }
 
-    for (i = rStartFrame; i < _numFrames; i++)
+    for (i = rStartFrame; i < numFrames; i++)
     {
-        if (_frames[i]->getFrameTime() >= aEndTime - SimTK::Zero)
+        if (times[i] >= aEndTime - SimTK::Zero)
         {
             rEndFrame = i;
             break;
@@ -640,10 +350,10 @@ void MarkerData::findFrameRange(double aStartTime, double aEndTime, int& rStartF
 
 double MarkerData::getStartFrameTime() const
 {
-    if (_numFrames<=0)
+    if (getNumFrames()<=0)
         return SimTK::NaN;
 
-    return(_frames[0]->getFrameTime());
+    return _table.getIndependentColumn().front();
 
 }
 /**
@@ -653,10 +363,10 @@ double MarkerData::getStartFrameTime() const
  */
 double MarkerData::getLastFrameTime() const
 {
-    if (_numFrames<=0)
+    if (getNumFrames()<=0)
         return SimTK::NaN;
 
-    return(_frames[_numFrames-1]->getFrameTime());
+    return _table.getIndependentColumn().back();
 }
 
 //_____________________________________________________________________________
@@ -670,133 +380,96 @@ double MarkerData::getLastFrameTime() const
  * the averaged frames. aThreshold is specified by the user,
  * and is assumed to be in the units of the marker data.
  *
+ * The frames are visited once, in place; only the averaged frame is
+ * allocated.
+ *
  * @param aThreshold amount of marker movement that is allowed for averaging.
  * @param aStartTime start time of frame range to average.
  * @param aEndTime end time of frame range to average.
  */
 void MarkerData::averageFrames(double aThreshold, double aStartTime, double aEndTime)
 {
-    if (_numFrames < 2)
+    if (getNumFrames() < 2)
         return;
 
+    const int numMarkers = getNumMarkers();
     int startIndex = 0, endIndex = 1;
-    double *minX = NULL, *minY = NULL, *minZ = NULL, *maxX = NULL, *maxY = NULL, *maxZ = NULL;
-
     findFrameRange(aStartTime, aEndTime, startIndex, endIndex);
-    MarkerFrame *averagedFrame = new MarkerFrame(*_frames[startIndex]);
 
-    /* If aThreshold is greater than zero, then calculate
-     * the movement of each marker so you can check if it
-     * is greater than aThreshold.
-     */
-    if (aThreshold > 0.0)
-    {
-        minX = new double [_numMarkers];
-        minY = new double [_numMarkers];
-        minZ = new double [_numMarkers];
-        maxX = new double [_numMarkers];
-        maxY = new double [_numMarkers];
-        maxZ = new double [_numMarkers];
-        for (int i = 0; i < _numMarkers; i++)
-        {
-            minX[i] = minY[i] = minZ[i] =  SimTK::Infinity;
-            maxX[i] = maxY[i] = maxZ[i] = -SimTK::Infinity;
-        }
-    }
-
-    /* Initialize all the averaged marker locations to 0,0,0. Then
-     * loop through the frames to be averaged, adding each marker location
-     * to averagedFrame. Keep track of the min/max XYZ for each marker
+    /* Loop through the frames to be averaged, adding each marker location
+     * to the averaged row. Keep track of the min/max XYZ for each marker
      * so you can compare it to aThreshold when you're done.
      */
-    for (int i = 0; i < _numMarkers; i++)
+    const SimTK::Matrix_<Vec3>& data = _table.getMatrix();
+    TimeSeriesTable_<Vec3>::RowVector averaged(numMarkers, Vec3(0));
+    std::vector<int> numAveraged(numMarkers, 0);
+    std::vector<Vec3> minPt(numMarkers, Vec3(SimTK::Infinity));
+    std::vector<Vec3> maxPt(numMarkers, Vec3(-SimTK::Infinity));
+    for (int j = startIndex; j <= endIndex; j++)
     {
-        int numFrames = 0;
-        Vec3& avePt = averagedFrame->updMarker(i);
-        avePt = Vec3(0);
-
-        for (int j = startIndex; j <= endIndex; j++)
+        for (int i = 0; i < numMarkers; i++)
         {
-            Vec3& pt = _frames[j]->updMarker(i);
-            if (!pt.isNaN())
+            const Vec3& pt = data(j, i);
+            if (pt.isNaN())
+                continue;
+            averaged[i] += pt;
+            numAveraged[i]++;
+            for (int k = 0; k < 3; k++)
             {
-                Vec3& coords = pt; //.get();
-                avePt += coords;
-                numFrames++;
-                if (aThreshold > 0.0)
-                {
-                    if (coords[0] < minX[i])
-                        minX[i] = coords[0];
-                    if (coords[0] > maxX[i])
-                        maxX[i] = coords[0];
-                    if (coords[1] < minY[i])
-                        minY[i] = coords[1];
-                    if (coords[1] > maxY[i])
-                        maxY[i] = coords[1];
-                    if (coords[2] < minZ[i])
-                        minZ[i] = coords[2];
-                    if (coords[2] > maxZ[i])
-                        maxZ[i] = coords[2];
-                }
+                minPt[i][k] = std::min(minPt[i][k], pt[k]);
+                maxPt[i][k] = std::max(maxPt[i][k], pt[k]);
             }
         }
+    }
 
-        /* Now divide by the number of frames to get the average. */
-        if (numFrames > 0)
-            avePt /= (double)numFrames;
+    /* Now divide by the number of frames to get the average. */
+    for (int i = 0; i < numMarkers; i++)
+    {
+        if (numAveraged[i] > 0)
+            averaged[i] /= (double)numAveraged[i];
         else
-            avePt = Vec3(SimTK::NaN) ;//(SimTK::NaN, SimTK::NaN, SimTK::NaN);
+            averaged[i] = Vec3(SimTK::NaN);
     }
 
     /* Store the indices from the file of the first frame and
      * last frame that were averaged, so you can report them later.
      */
-    int startUserIndex = _frames[startIndex]->getFrameNumber();
-    int endUserIndex = _frames[endIndex]->getFrameNumber();
-
-    /* Now delete all the existing frames and insert the averaged one. */
-    _frames.clearAndDestroy();
-    _frames.append(averagedFrame);
-    _numFrames = 1;
-    _firstFrameNumber = _frames[0]->getFrameNumber();
+    int startUserIndex = _firstFrameNumber + startIndex;
+    int endUserIndex = _firstFrameNumber + endIndex;
+
+    /* Now replace all the existing frames with the averaged one. */
+    TimeSeriesTable_<Vec3> averagedTable;
+    averagedTable.setColumnLabels(_table.getColumnLabels());
+    averagedTable.updTableMetaData() = _table.getTableMetaData();
+    averagedTable.appendRow(_table.getIndependentColumn()[startIndex],
+            averaged);
+    _table = std::move(averagedTable);
+    _frames.clear();
+    _firstFrameNumber = startUserIndex;
 
     if (aThreshold > 0.0)
     {
-        for (int i = 0; i < _numMarkers; i++)
+        for (int i = 0; i < numMarkers; i++)
         {
-            Vec3& pt = _frames[0]->updMarker(i);
-
-            if (pt.isNaN())
+            if (averaged[i].isNaN())
             {
                 log_warn("Marker {} is missing in frames {} to {}. Coordinate "
                          "will be set to NAN.", _markerNames[i], startUserIndex,
                         endUserIndex);
             }
-            else if (maxX[i] - minX[i] > aThreshold ||
-                      maxY[i] - minY[i] > aThreshold ||
-                      maxZ[i] - minZ[i] > aThreshold)
+            else
             {
-                double maxDim = maxX[i] - minX[i];
-                maxDim = MAX(maxDim, (maxY[i] - minY[i]));
-                maxDim = MAX(maxDim, (maxZ[i] - minZ[i]));
-                log_warn("Movement of marker {} in {} is {} (threshold = {})",
-                        _markerNames[i], _fileName, maxDim, aThreshold);
+                const Vec3 range = maxPt[i] - minPt[i];
+                const double maxDim = MAX(MAX(range[0], range[1]), range[2]);
+                if (maxDim > aThreshold)
+                    log_warn("Movement of marker {} in {} is {} (threshold = {})",
+                            _markerNames[i], _fileName, maxDim, aThreshold);
             }
         }
     }
 
     log_info("Averaged frames from time {} to {} in {} (frames {} to {})",
             aStartTime, aEndTime, _fileName, startUserIndex, endUserIndex);
-
-    if (aThreshold > 0.0)
-    {
-        delete [] minX;
-        delete [] minY;
-        delete [] minZ;
-        delete [] maxX;
-        delete [] maxY;
-        delete [] maxZ;
-    }
 }
 
 //_____________________________________________________________________________
@@ -811,10 +484,12 @@ void MarkerData::makeRdStorage(Storage& rStorage)
     /* First clear any existing frames. */
     rStorage.reset(0);
 
+    const int numMarkers = getNumMarkers();
+
     /* Make the column labels. */
     Array<string> columnLabels;
     columnLabels.append("time");
-    for (int i = 0; i < _numMarkers; i++)
+    for (int i = 0; i < numMarkers; i++)
     {
         columnLabels.append(_markerNames[i] + "_tx");
         columnLabels.append(_markerNames[i] + "_ty");
@@ -825,21 +500,21 @@ void MarkerData::makeRdStorage(Storage& rStorage)
     /* Store the marker coordinates in an array of doubles
      * and add it to the Storage.
      */
-    int numColumns = _numMarkers * 3;
-    double* row = new double [numColumns];
+    int numColumns = numMarkers * 3;
+    std::vector<double> row(numColumns);
+    const SimTK::Matrix_<Vec3>& data = _table.getMatrix();
+    const auto& times = _table.getIndependentColumn();
 
-    for (int i = 0; i < _numFrames; i++)
+    for (int i = 0; i < getNumFrames(); i++)
     {
-        for (int j = 0, index = 0; j < _numMarkers; j++)
+        for (int j = 0, index = 0; j < numMarkers; j++)
         {
-            SimTK::Vec3& marker = _frames[i]->updMarker(j);
+            const Vec3& marker = data(i, j);
             for (int k = 0; k < 3; k++)
                 row[index++] = marker[k];
         }
-        rStorage.append(_frames[i]->getFrameTime(), numColumns, row);
+        rStorage.append(times[i], numColumns, row.data());
     }
-
-    delete [] row;
 }
 
 //_____________________________________________________________________________
@@ -857,11 +532,14 @@ void MarkerData::convertToUnits(const Units& aUnits)
     if (!SimTK::isNaN(scaleFactor))
     {
         /* Scale all marker locations by the conversion factor. */
-        for (int i = 0; i < _frames.getSize(); i++)
-            _frames[i]->scale(scaleFactor);
+        _table.updMatrix() *= scaleFactor;
+        _frames.clear();
 
         /* Change the units for this object to the new ones. */
         _units = aUnits;
+        if (_table.hasTableMetaDataKey("Units"))
+            _table.removeTableMetaDataKey("Units");
+        _table.addTableMetaData("Units", _units.getAbbreviation());
     }
     else
         throw Exception("MarkerData.convertToUnits: ERROR- Model has unspecified units",__FILE__,__LINE__);
@@ -872,16 +550,30 @@ void MarkerData::convertToUnits(const Units& aUnits)
 //=============================================================================
 //_____________________________________________________________________________
 /**
- * Get a frame of marker data.
+ * Get a frame of marker data. The frame is created from the data table the
+ * first time it is requested.
  *
  * @param aIndex index of the row to get.
  * @return Pointer to the frame of data.
  */
 const MarkerFrame& MarkerData::getFrame(int aIndex) const
 {
-    if (aIndex < 0 || aIndex >= _numFrames)
+    if (aIndex < 0 || aIndex >= getNumFrames())
         throw Exception("MarkerData::getFrame() invalid frame index.");
 
+    if ((int)_frames.size() != getNumFrames())
+        _frames.assign(getNumFrames(), nullptr);
+    if (!_frames[aIndex]) {
+        const int numMarkers = getNumMarkers();
+        Units units = _units;
+        auto frame = std::make_shared<MarkerFrame>(numMarkers,
+                _firstFrameNumber + aIndex,
+                _table.getIndependentColumn()[aIndex], units);
+        const auto row = _table.getRowAtIndex(aIndex);
+        for (int i = 0; i < numMarkers; i++)
+            frame->addMarker(row[i]);
+        _frames[aIndex] = frame;
+    }
     return *_frames[aIndex];
 }
 
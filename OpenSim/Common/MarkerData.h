@@ -26,11 +26,14 @@
 
 // INCLUDE
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 #include "Array.h"
 #include "ArrayPtrs.h"
 #include "MarkerFrame.h"
 #include "Object.h"
+#include "TimeSeriesTable.h"
 #include "Units.h"
 
 namespace OpenSim {
@@ -40,7 +43,17 @@ class Storage;
 //=============================================================================
 //=============================================================================
 /**
- * A class implementing a sequence of marker frames from a TRC/TRB file.
+ * A class implementing a sequence of marker frames from a TRC, C3D or STO
+ * file.
+ *
+ * The marker locations are stored contiguously in a TimeSeriesTable_<Vec3>
+ * (see getDataTable()). TRC and C3D files are read with TRCFileAdapter and
+ * C3DFileAdapter. MarkerFrame objects are created only when getFrame() asks
+ * for them.
+ *
+ * To average a time window of a long capture (e.g., a static trial), use the
+ * constructor that takes a time range: only the frames in that range are
+ * parsed and stored.
  *
  * @author Peter Loan
  * @version 1.0
@@ -52,8 +65,6 @@ OpenSim_DECLARE_CONCRETE_OBJECT(MarkerData, Object);
 // DATA
 //=============================================================================
 private:
-    int _numFrames;
-    int _numMarkers;
     int _firstFrameNumber;
     double _dataRate;
     double _cameraRate;
@@ -63,7 +74,9 @@ private:
     std::string _fileName;
     Units _units;
     Array<std::string> _markerNames;
-    ArrayPtrs<MarkerFrame> _frames;
+    TimeSeriesTable_<SimTK::Vec3> _table;
+    // Frames that getFrame() has created, by frame index.
+    mutable std::vector<std::shared_ptr<const MarkerFrame>> _frames;
 
 //=============================================================================
 // METHODS
@@ -74,6 +87,17 @@ private:
 public:
     MarkerData();
     explicit MarkerData(const std::string& aFileName) SWIG_DECLARE_EXCEPTION;
+    /** Read only the frames between aStartTime and aEndTime (inclusive). If
+    there are no frames in that range, all frames are read, so that
+    averageFrames() can use the frames closest to the range. */
+    MarkerData(const std::string& aFileName, double aStartTime,
+            double aEndTime) SWIG_DECLARE_EXCEPTION;
+    /** Use the markers in a table (e.g., from TRCFileAdapter). The data rate
+    and units are taken from the table's "DataRate" and "Units" metadata,
+    if present. The table's data is shared, not copied. The file name is
+    only used in messages. */
+    explicit MarkerData(const TimeSeriesTable_<SimTK::Vec3>& aTable,
+            const std::string& aFileName = "");
     virtual ~MarkerData();
 
     void findFrameRange(double aStartTime, double aEndTime, int& rStartFrame, int& rEndFrame) const;
@@ -81,22 +105,23 @@ public:
     const std::string& getFileName() const { return _fileName; }
     void makeRdStorage(Storage& rStorage);
     const MarkerFrame& getFrame(int aIndex) const;
+    /** The marker locations, one row per frame and one column per marker. */
+    const TimeSeriesTable_<SimTK::Vec3>& getDataTable() const { return _table; }
     int getMarkerIndex(const std::string& aName) const;
     const Units& getUnits() const { return _units; }
     void convertToUnits(const Units& aUnits);
     const Array<std::string>& getMarkerNames() const { return _markerNames; }
-    int getNumMarkers() const { return _numMarkers; }
-    int getNumFrames() const { return _numFrames; }
+    int getNumMarkers() const { return _markerNames.getSize(); }
+    int getNumFrames() const { return (int)_table.getNumRows(); }
     double getStartFrameTime() const;
     double getLastFrameTime() const;
     double getDataRate() const { return _dataRate; }
     double getCameraRate() const { return _cameraRate; }
 
 private:
-    void readTRCFile(const std::string& aFileName, MarkerData& aSMD);
-    void readTRCFileHeader(std::ifstream &in, const std::string& aFileName, MarkerData& aSMD);
-    void readTRBFile(const std::string& aFileName, MarkerData& aSMD);
-    void readStoFile(const std::string& aFileName);
+    void readFile(const std::string& aFileName, const TableReadFilter& aFilter);
+    void readStoFile(const std::string& aFileName, const TableReadFilter& aFilter);
+    void setTable(TimeSeriesTable_<SimTK::Vec3> aTable);
     void buildMarkerMap(const Storage& storageToReadFrom, std::map<int, std::string>& markerNames);
 
 //=============================================================================
@@ -107,5 +132,3 @@ private:
 } // end of namespace OpenSim
 
 #endif // OPENSIM_MARKER_DATA_H_
-
-
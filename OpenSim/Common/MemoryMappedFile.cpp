@@ -0,0 +1,163 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  MemoryMappedFile.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MemoryMappedFile.h"
+
+#include "FileAdapter.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <utility>
+
+using namespace OpenSim;
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName)
+        : m_fileName(fileName) {
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ,
+            FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+    OPENSIM_THROW_IF(file == INVALID_HANDLE_VALUE, FileDoesNotExist,
+            fileName);
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        release();
+        OPENSIM_THROW(IOError, "Could not determine the size of file '{}'.",
+                fileName);
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0) return;
+
+    HANDLE mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        release();
+        OPENSIM_THROW(IOError, "Could not map file '{}' into memory.",
+                fileName);
+    }
+    m_mapping = mapping;
+
+    m_data = static_cast<const char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr) {
+        release();
+        OPENSIM_THROW(IOError, "Could not map file '{}' into memory.",
+                fileName);
+    }
+}
+
+void MemoryMappedFile::release() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName)
+        : m_fileName(fileName) {
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    OPENSIM_THROW_IF(fd == -1, FileDoesNotExist, fileName);
+
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        OPENSIM_THROW(IOError, "Could not determine the size of file '{}'.",
+                fileName);
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size == 0) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping remains valid after the file descriptor is closed.
+    close(fd);
+    if (data == MAP_FAILED) {
+        m_size = 0;
+        OPENSIM_THROW(IOError, "Could not map file '{}' into memory.",
+                fileName);
+    }
+    m_data = static_cast<const char*>(data);
+#ifdef MADV_SEQUENTIAL
+    madvise(data, m_size, MADV_SEQUENTIAL);
+#endif
+}
+
+void MemoryMappedFile::release() {
+    if (m_data) munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+MemoryMappedFile::~MemoryMappedFile() { release(); }
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+        : m_fileName(std::move(other.m_fileName)), m_data(other.m_data),
+          m_size(other.m_size) {
+#ifdef _WIN32
+    m_file = other.m_file;
+    m_mapping = other.m_mapping;
+    other.m_file = nullptr;
+    other.m_mapping = nullptr;
+#endif
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(
+        MemoryMappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_fileName = std::move(other.m_fileName);
+        m_data = other.m_data;
+        m_size = other.m_size;
+#ifdef _WIN32
+        m_file = other.m_file;
+        m_mapping = other.m_mapping;
+        other.m_file = nullptr;
+        other.m_mapping = nullptr;
+#endif
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
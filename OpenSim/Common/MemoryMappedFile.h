@@ -0,0 +1,79 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  MemoryMappedFile.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_MEMORY_MAPPED_FILE_H_
+#define OPENSIM_MEMORY_MAPPED_FILE_H_
+
+#include "osimCommonDLL.h"
+
+#include <cstddef>
+#include <string>
+
+namespace OpenSim {
+
+/** A read-only view of the contents of a file, obtained by mapping the file
+into memory. The operating system pages in the parts of the file that are
+accessed, which avoids reading (and copying) parts of the file that are not
+needed, and avoids the overhead of stream-based reading for large files.
+The mapping is released when this object is destroyed.
+
+@code
+MemoryMappedFile file("states.sto");
+const char* begin = file.getData();
+const char* end = begin + file.getSize();
+@endcode
+
+An empty file has a size of 0 and a null data pointer. */
+class OSIMCOMMON_API MemoryMappedFile {
+public:
+    /** Map the file into memory.
+    @throws FileDoesNotExist if the file cannot be opened.
+    @throws IOError if the file cannot be mapped. */
+    explicit MemoryMappedFile(const std::string& fileName);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    /** The first byte of the file. */
+    const char* getData() const { return m_data; }
+    /** The size of the file in bytes. */
+    std::size_t getSize() const { return m_size; }
+    const std::string& getFileName() const { return m_fileName; }
+
+private:
+    void release();
+
+    std::string m_fileName;
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MEMORY_MAPPED_FILE_H_
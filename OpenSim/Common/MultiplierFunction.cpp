@@ -26,10 +26,40 @@
 #include "MultiplierFunction.h"
 #include "FunctionAdapter.h"
 
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 using SimTK::Vector;
 
+namespace {
+/* Scales the native SimTK::Function of the wrapped function, so that, e.g., a
+ * MultiplierFunction of a SimmSpline in a CustomJoint is evaluated without
+ * going through the OpenSim::Function interface. */
+class ScaledFunction : public SimTK::Function {
+public:
+    ScaledFunction(SimTK::Function* function, double scale)
+            : _function(function), _scale(scale) {}
+    double calcValue(const Vector& x) const override {
+        return _function->calcValue(x) * _scale;
+    }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const Vector& x) const override {
+        return _function->calcDerivative(derivComponents, x) * _scale;
+    }
+    int getArgumentSize() const override {
+        return _function->getArgumentSize();
+    }
+    int getMaxDerivativeOrder() const override {
+        return _function->getMaxDerivativeOrder();
+    }
+
+private:
+    std::unique_ptr<SimTK::Function> _function;
+    double _scale;
+};
+} // anonymous namespace
+
 
 //=============================================================================
 // STATICS
@@ -203,6 +233,9 @@ int MultiplierFunction::getMaxDerivativeOrder() const
 }
 
 SimTK::Function* MultiplierFunction::createSimTKFunction() const {
+    if (_osFunction) {
+        return new ScaledFunction(_osFunction->createSimTKFunction(), _scale);
+    }
     return new FunctionAdapter(*this);
 }
 
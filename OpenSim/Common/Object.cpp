@@ -38,7 +38,10 @@
 #include "PropertyTransform.h"
 #include "Property_Deprecated.h"
 #include "XMLDocument.h"
+#include <algorithm>
 #include <fstream>
+#include <memory>
+#include <mutex>
 
 using namespace OpenSim;
 using namespace std;
@@ -49,12 +52,47 @@ using SimTK::Transform;
 // STATICS
 //=============================================================================
 ArrayPtrs<Object>           Object::_registeredTypes;
-std::map<string,Object*>    Object::_mapTypesToDefaultObjects;
-std::map<string,string>     Object::_renamedTypesMap;
+std::unordered_map<string,Object*> Object::_mapTypesToDefaultObjects;
+std::unordered_map<string,string>  Object::_renamedTypesMap;
 
 bool                        Object::_serializeAllDefaults=false;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
 
+namespace {
+// A function that creates default-constructed objects of a registered type,
+// which may be used by newInstanceOfType() instead of cloning the default
+// object if a default-constructed object turns out to be equal to it.
+struct DefaultFactory {
+    enum State { Unchecked, Equal, NotEqual };
+    Object* (*create)() = nullptr;
+    int state = Unchecked;
+};
+// Keyed by the registered default object.
+std::unordered_map<const Object*, std::unique_ptr<DefaultFactory>>&
+getDefaultFactories() {
+    static std::unordered_map<const Object*, std::unique_ptr<DefaultFactory>>
+            factories;
+    return factories;
+}
+// Types registered with registerTypeLazily() whose default objects have not
+// been created yet, in the order they were registered.
+struct LazyTypes {
+    std::unordered_map<std::string, Object* (*)()> factories;
+    std::vector<std::string> order;
+};
+LazyTypes& getLazyTypes() {
+    static LazyTypes lazyTypes;
+    return lazyTypes;
+}
+// Guards the registry, since default objects of lazily registered types may
+// be created while files are read on multiple threads. The mutex is
+// recursive because constructing a default object may look up other types.
+std::recursive_mutex& getRegistryMutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+} // namespace
+
 //=============================================================================
 // CONSTRUCTOR(S)
 //=============================================================================
@@ -156,13 +194,20 @@ Object::Object(const string &aFileName, bool aUpdateFromXMLNode)
  * @see generateXMLDocument()
  */
 Object::Object(const Object &aObject)
+    :   _name(aObject._name),
+        _description(aObject._description),
+        _authors(aObject._authors),
+        _references(aObject._references),
+        _propertyTable(aObject._propertyTable),
+        _objectIsUpToDate(false),
+        _document(NULL),
+        _inlined(true)
 {
-    setNull();
-
-    // Use copy assignment operator to copy simple data members and the
-    // property table; XML document is not copied and the new object is
-    // marked "inlined", meaning it is not associated with an XML document.
-    *this = aObject;
+    // Copy the simple data members and the property table directly, as the
+    // copy assignment operator would (but without first clearing them); the
+    // old-style _propertySet is populated by the derived class. The XML
+    // document is not copied and the new object is marked "inlined", meaning
+    // it is not associated with an XML document.
 }
 
 Object::Object(SimTK::Xml::Element& aNode)
@@ -496,6 +541,12 @@ updPropertyByName(const std::string& name) {
  */
 /*static*/ void Object::
 registerType(const Object& aObject)
+{
+    registerTypeWithFactory(aObject, nullptr);
+}
+
+/*static*/ void Object::
+registerTypeWithFactory(const Object& aObject, Object* (*factory)())
 {
     // GET TYPE
     const string& type = aObject.getConcreteClassName();
@@ -505,38 +556,93 @@ registerType(const Object& aObject)
     }
     log_debug("Object.registerType: {}.", type);
 
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+    getLazyTypes().factories.erase(type);
+
+    Object* defaultObj = aObject.clone();
+    defaultObj->setName(DEFAULT_NAME);
+
+    auto& factories = getDefaultFactories();
+    // Objects with deprecated properties are not compared by operator==().
+    if (factory && aObject.getPropertySet().getSize() == 0) {
+        std::unique_ptr<DefaultFactory> entry(new DefaultFactory());
+        entry->create = factory;
+        factories[defaultObj] = std::move(entry);
+    }
+
     // REPLACE IF A MATCHING TYPE IS ALREADY REGISTERED
-    for(int i=0; i <_registeredTypes.size(); ++i) {
-        Object *object = _registeredTypes.get(i);
-        if(object->getConcreteClassName() == type) {
-            log_debug("Object.registerType: replacing registered object of "
-                      "type {} with a new default object of the same type.",
-                      type);
-            Object* defaultObj = aObject.clone();
-            defaultObj->setName(DEFAULT_NAME);
-            _registeredTypes.set(i,defaultObj);
-            _mapTypesToDefaultObjects[type]= defaultObj;
-            return;
-        } 
+    auto p = _mapTypesToDefaultObjects.find(type);
+    if(p != _mapTypesToDefaultObjects.end()) {
+        log_debug("Object.registerType: replacing registered object of "
+                  "type {} with a new default object of the same type.",
+                  type);
+        factories.erase(p->second);
+        for(int i=0; i <_registeredTypes.size(); ++i) {
+            if(_registeredTypes.get(i) == p->second) {
+                _registeredTypes.set(i,defaultObj);
+                break;
+            }
+        }
+        p->second = defaultObj;
+        return;
     }
 
     // REGISTERING FOR THE FIRST TIME -- APPEND
-    Object* defaultObj = aObject.clone();
-    defaultObj->setName(DEFAULT_NAME);
     _registeredTypes.append(defaultObj);
     _mapTypesToDefaultObjects[type]= defaultObj;
 }
 
+/*static*/ void Object::
+registerTypeLazily(const std::string& type, Object* (*factory)())
+{
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+    // Replacing a registered type takes effect immediately.
+    if (_mapTypesToDefaultObjects.count(type)) {
+        std::unique_ptr<Object> defaultObj(factory());
+        registerTypeWithFactory(*defaultObj, factory);
+        return;
+    }
+    auto& lazyTypes = getLazyTypes();
+    if (!lazyTypes.factories.count(type)) lazyTypes.order.push_back(type);
+    lazyTypes.factories[type] = factory;
+}
+
+/*static*/ const Object* Object::
+createLazilyRegisteredDefaultObject(const std::string& type)
+{
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+    auto& lazyTypes = getLazyTypes();
+    auto f = lazyTypes.factories.find(type);
+    if (f == lazyTypes.factories.end()) return nullptr;
+    Object* (*factory)() = f->second;
+    log_debug("Object: creating the default object of lazily registered "
+              "type {}.", type);
+    std::unique_ptr<Object> defaultObj(factory());
+    // This also removes the type from the lazily registered types.
+    registerTypeWithFactory(*defaultObj, factory);
+    return _mapTypesToDefaultObjects.at(type);
+}
+
+/*static*/ void Object::
+registerLazilyRegisteredTypes()
+{
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+    const std::vector<std::string> order = std::move(getLazyTypes().order);
+    getLazyTypes().order.clear();
+    for (const auto& type : order) createLazilyRegisteredDefaultObject(type);
+}
+
 /*static*/ void Object::
 renameType(const std::string& oldTypeName, const std::string& newTypeName)
 {
     if(oldTypeName == newTypeName)
         return; 
 
-    std::map<std::string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.find(newTypeName);
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+    auto p = _mapTypesToDefaultObjects.find(newTypeName);
 
-    if (p == _mapTypesToDefaultObjects.end())
+    if (p == _mapTypesToDefaultObjects.end() &&
+            !getLazyTypes().factories.count(newTypeName))
         throw OpenSim::Exception(
             "Object::renameType(): illegal attempt to rename object type "
             + oldTypeName + " to " + newTypeName + " which is unregistered.",
@@ -550,14 +656,15 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
     std::string actualName = objectTypeTag;
     bool wasRenamed = false; // for a better error message
 
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+
     // First apply renames if any.
 
     // Avoid an infinite loop if there is a cycle in the rename table.
     const int MaxRenames = (int)_renamedTypesMap.size();
     int renameCount = 0;
     while(true) {
-        std::map<std::string,std::string>::const_iterator newNamep =
-            _renamedTypesMap.find(actualName);
+        auto newNamep = _renamedTypesMap.find(actualName);
         if (newNamep == _renamedTypesMap.end())
             break; // actualName has not been renamed
 
@@ -572,10 +679,12 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
     }
 
     // Look up the "actualName" default object and return it.
-    std::map<std::string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.find(actualName);
+    auto p = _mapTypesToDefaultObjects.find(actualName);
     if (p != _mapTypesToDefaultObjects.end())
         return p->second;
+    if (const Object* defaultObj =
+                createLazilyRegisteredDefaultObject(actualName))
+        return defaultObj;
 
     // The requested object was not registered. That's OK normally but is
     // a bug if we went through the rename table since you are only allowed
@@ -600,8 +709,34 @@ getDefaultInstanceOfType(const std::string& objectTypeTag) {
 newInstanceOfType(const std::string& objectTypeTag)
 {
     const Object* defaultObj = getDefaultInstanceOfType(objectTypeTag);
-    if (defaultObj)
+    if (defaultObj) {
+        // Default-construct the object if that gives the same object as
+        // cloning the default object; this is checked the first time.
+        Object* (*create)() = nullptr;
+        {
+            std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+            const auto& factories = getDefaultFactories();
+            const auto f = factories.find(defaultObj);
+            if (f != factories.end()) {
+                DefaultFactory& factory = *f->second;
+                if (factory.state == DefaultFactory::Unchecked) {
+                    std::unique_ptr<Object> object(factory.create());
+                    object->setName(DEFAULT_NAME);
+                    factory.state = *object == *defaultObj
+                                            ? DefaultFactory::Equal
+                                            : DefaultFactory::NotEqual;
+                }
+                if (factory.state == DefaultFactory::Equal)
+                    create = factory.create;
+            }
+        }
+        if (create) {
+            Object* object = create();
+            object->setName(DEFAULT_NAME);
+            return object;
+        }
         return defaultObj->clone();
+    }
     log_error("Object::newInstanceOfType(): object type '{}' is not a registered "
             "Object! It will be ignored.",
             objectTypeTag);
@@ -622,10 +757,17 @@ newInstanceOfType(const std::string& objectTypeTag)
 /*static*/ void Object::
 getRegisteredTypenames(Array<std::string>& rTypeNames)
 {
-    std::map<string,Object*>::const_iterator p = 
-        _mapTypesToDefaultObjects.begin();
-    for (; p != _mapTypesToDefaultObjects.end(); ++p)
-        rTypeNames.append(p->first);
+    // Sorted, as they were when the registry was an ordered map.
+    std::lock_guard<std::recursive_mutex> lock(getRegistryMutex());
+    std::vector<std::string> names;
+    names.reserve(_mapTypesToDefaultObjects.size());
+    for (const auto& p : _mapTypesToDefaultObjects)
+        names.push_back(p.first);
+    for (const auto& p : getLazyTypes().factories)
+        names.push_back(p.first);
+    std::sort(names.begin(), names.end());
+    for (const auto& name : names)
+        rTypeNames.append(name);
     // Renamed type names don't appear in the registeredTypes map, unless
     // they were separately registered.
 }
@@ -1373,6 +1515,9 @@ print(const string &aFileName) const
     }
 
     _document->print(aFileName);
+    // The DOM is only an intermediate for writing the file; don't keep a
+    // second copy of a large model's serialization alive on this Object.
+    _document->clearRootElement();
     return true;
 }
 
@@ -1412,6 +1557,7 @@ PrintPropertyInfo(ostream &aOStream,
 
     if(aClassName=="") {
         // NO CLASS
+        registerLazilyRegisteredTypes();
         int size = _registeredTypes.getSize();
         ss<<"REGISTERED CLASSES ("<<size<<")\n";
         Object *obj;
@@ -42,6 +42,9 @@
 
 #include <cstring>
 #include <cassert>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 
 // DISABLES MULTIPLE INSTANTIATION WARNINGS
 
@@ -82,6 +85,22 @@ const char ObjectDEFAULT_NAME[] = "default";
 
 class XMLDocument;
 
+#ifndef SWIG
+// Used by Object::registerType() to obtain a function that creates a
+// default-constructed object of type T, or null if T cannot be default
+// constructed or if the default object is of a type derived from T.
+template <class T, bool = std::is_default_constructible<T>::value>
+struct Object_DefaultFactory {
+    static Object* create() { return new T(); }
+    static Object* (*get(const T& defaultObject))() {
+        return typeid(defaultObject) == typeid(T) ? &create : nullptr;
+    }
+};
+template <class T> struct Object_DefaultFactory<T, false> {
+    static Object* (*get(const T&))() { return nullptr; }
+};
+#endif
+
 //==============================================================================
 //                                 OBJECT
 //==============================================================================
@@ -410,6 +429,34 @@ public:
     XML file). **/
     static void registerType(const Object& defaultObject);
 
+    #ifndef SWIG
+    /** Same as above. Since the concrete type of the default object is known
+    here, newInstanceOfType() can create new objects of this type with the
+    default constructor instead of copying the default object, which is
+    faster when reading large files. This is used only if a
+    default-constructed object is equal to the default object (e.g., not for
+    default objects with modified properties, or from the "defaults" section
+    of a file). **/
+    template <class T>
+    static void registerType(const T& defaultObject) {
+        registerTypeWithFactory(defaultObject,
+                Object_DefaultFactory<T>::get(defaultObject));
+    }
+
+    /** Register the default-constructible type T without creating its
+    default object yet. The default object is created the first time the type
+    is looked up (e.g., by getDefaultInstanceOfType() or when reading a file
+    that contains an object of this type), so that libraries with many types
+    can be loaded quickly. Otherwise, this is the same as
+    registerType(T()). **/
+    template <class T>
+    static void registerTypeLazily() {
+        static_assert(std::is_default_constructible<T>::value,
+                "Only default-constructible types can be registered lazily.");
+        registerTypeLazily(T::getClassName(), &Object_DefaultFactory<T>::create);
+    }
+    #endif
+
     /** Support versioning by associating the current %Object type with an 
     old name. This is only allowed if \a newTypeName has already been 
     registered with registerType(). Renaming is applied first prior to lookup
@@ -470,6 +517,7 @@ public:
     all Joints, Constraints, ModelComponents, Analyses, etc. **/
     template<class T> static void 
     getRegisteredObjectsOfGivenType(ArrayPtrs<T>& rArray) {
+        registerLazilyRegisteredTypes();
         rArray.setSize(0);
         rArray.setMemoryOwner(false);
         for(int i=0; i<_registeredTypes.getSize(); i++) {
@@ -867,7 +915,7 @@ private:
     // type kept in the above array of registered types. Renamed types are *not* 
     // normally entered here; the names are mapped separately using the map 
     // below.
-    static std::map<std::string,Object*>        _mapTypesToDefaultObjects;
+    static std::unordered_map<std::string,Object*> _mapTypesToDefaultObjects;
 
     // Map types that have been renamed to their new names, which can
     // then be used to find them in the default object map. This lets us 
@@ -876,7 +924,23 @@ private:
     // to map one registered type to a different one programmatically, because
     // we'll look up the name in the rename table first prior to searching
     // the registered types list.
-    static std::map<std::string,std::string>    _renamedTypesMap;
+    static std::unordered_map<std::string,std::string> _renamedTypesMap;
+
+    #ifndef SWIG
+    // Implementation of registerType(). If not null, `factory` creates a
+    // default-constructed object of the same type as `defaultObject`.
+    static void registerTypeWithFactory(const Object& defaultObject,
+            Object* (*factory)());
+    // Implementation of registerTypeLazily().
+    static void registerTypeLazily(const std::string& type,
+            Object* (*factory)());
+    // If the type was registered lazily and its default object has not been
+    // created yet, create and register it; otherwise, return null.
+    static const Object* createLazilyRegisteredDefaultObject(
+            const std::string& type);
+    #endif
+    // Create the default objects of all lazily registered types.
+    static void registerLazilyRegisteredTypes();
 
     // Global flag to indicate if all registered objects are to be written in 
     // a "defaults" section.
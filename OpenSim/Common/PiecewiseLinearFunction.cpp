@@ -29,6 +29,8 @@
 #include "SimmMacros.h"
 #include "XYFunctionInterface.h"
 
+#include <algorithm>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -428,9 +430,13 @@ void PiecewiseLinearFunction::calcCoefficients()
 }
 
 double PiecewiseLinearFunction::calcValue(const Vector& x) const
+{
+    return calcValueAt(x[0]);
+}
+
+double PiecewiseLinearFunction::calcValueAt(double aX, int* interval) const
 {
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0])
         return _y[0] + (aX - _x[0]) * _b[0];
@@ -446,6 +452,18 @@ double PiecewiseLinearFunction::calcValue(const Vector& x) const
     else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
         return _y[n-1];
 
+    // Try the interval that contained the previous abscissa and the one
+    // after it before searching.
+    if (interval) {
+        const int hint = std::min(std::max(*interval, 0), n-2);
+        for (int k = hint; k <= std::min(hint+1, n-2); ++k) {
+            if (aX >= _x[k] && aX <= _x[k+1]) {
+                *interval = k;
+                return _y[k] + (aX - _x[k]) * _b[k];
+            }
+        }
+    }
+
     // Do a binary search to find which two points the abscissa is between.
     int k, i = 0;
     int j = n;
@@ -459,6 +477,7 @@ double PiecewiseLinearFunction::calcValue(const Vector& x) const
         else
             break;
     }
+    if (interval) *interval = k;
 
     return _y[k] + (aX - _x[k]) * _b[k];
 }
@@ -467,11 +486,18 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
 {
     if (derivComponents.size() == 0)
         return SimTK::NaN;
-    if (derivComponents.size() > 1)
+    return calcDerivativeAt(x[0], (int)derivComponents.size());
+}
+
+double PiecewiseLinearFunction::calcDerivativeAt(double aX, int order,
+        int* interval) const
+{
+    if (order < 1)
+        return SimTK::NaN;
+    if (order > 1)
         return 0.0;
 
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0]) {
         return _b[0];
@@ -489,6 +515,18 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         return _b[n-1];
     }
 
+    // Try the interval that contained the previous abscissa and the one
+    // after it before searching.
+    if (interval) {
+        const int hint = std::min(std::max(*interval, 0), n-2);
+        for (int k = hint; k <= std::min(hint+1, n-2); ++k) {
+            if (aX >= _x[k] && aX <= _x[k+1]) {
+                *interval = k;
+                return _b[k];
+            }
+        }
+    }
+
     // Do a binary search to find which two points the abscissa is between.
     int k, i = 0;
     int j = n;
@@ -502,6 +540,7 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         else
             break;
     }
+    if (interval) *interval = k;
 
     return _b[k];
 }
@@ -100,6 +100,28 @@ public:
         return new SimTK::Function::Polynomial(get_coefficients());
     }
 
+    /** Evaluate the polynomial with Horner's method, without creating the
+    SimTK::Function. */
+    double calcValueAt(double x, int* = nullptr) const override
+    {
+        return calcDerivativeAt(x, 0);
+    }
+    /** Evaluate a derivative of the polynomial with Horner's method, without
+    creating the SimTK::Function. An order of 0 gives the value. */
+    double calcDerivativeAt(double x, int order, int* = nullptr) const override
+    {
+        const SimTK::Vector& coefficients = get_coefficients();
+        const int n = coefficients.size() - 1;
+        double result = 0;
+        for (int i = 0; i <= n - order; ++i) {
+            // Coefficient of x^(n-i-order) in the derivative.
+            double factor = coefficients[i];
+            for (int j = 0; j < order; ++j) factor *= n - i - j;
+            result = result * x + factor;
+        }
+        return result;
+    }
+
 private:
     /**
     * Construct the serializable property member variables and
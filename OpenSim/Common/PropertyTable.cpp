@@ -36,8 +36,11 @@ using namespace std;
 //_____________________________________________________________________________
 // Copy constructor has to clone the source properties.
 PropertyTable::PropertyTable(const PropertyTable& source)
+    :   propertyIndex(source.propertyIndex)
 {
-    replaceProperties(source.properties);
+    properties.reserve(source.properties.size());
+    for (unsigned i=0; i < source.properties.size(); ++i)
+        properties.push_back(source.properties[i]->clone());
 }
 
 //_____________________________________________________________________________
@@ -53,7 +56,7 @@ PropertyTable::~PropertyTable()
 PropertyTable& PropertyTable::operator=(const PropertyTable& source)
 {
     if (&source != this)
-        replaceProperties(source.properties);
+        replaceProperties(source);
     return *this;
 }
 
@@ -89,7 +92,13 @@ int PropertyTable::adoptProperty(AbstractProperty* prop)
             ("PropertyTable::adoptProperty(): Property " 
             + name + " already in table.");
 
-    propertyIndex[name] = nxtIndex;
+    if (!propertyIndex) {
+        propertyIndex = std::make_shared<std::unordered_map<std::string, int>>();
+    } else if (propertyIndex.use_count() > 1) {
+        propertyIndex = std::make_shared<std::unordered_map<std::string, int>>(
+                *propertyIndex);
+    }
+    (*propertyIndex)[name] = nxtIndex;
     properties.push_back(prop);
     return nxtIndex;
 }
@@ -145,20 +154,19 @@ updAbstractPropertyByName(const std::string& name) {
 // This method is reused in the implementation of any method that
 // takes a property by name.
 int PropertyTable::findPropertyIndex(const std::string& name) const {
-    const std::map<std::string, int>::const_iterator 
-        it = propertyIndex.find(name);
-    return it == propertyIndex.end() ? -1 : it->second;
+    if (!propertyIndex) return -1;
+    const auto it = propertyIndex->find(name);
+    return it == propertyIndex->end() ? -1 : it->second;
 }
 
 // Private method to replace the existing properties with a deep copy of 
-// the source, and update the index map to match.
-void PropertyTable::replaceProperties
-   (const SimTK::Array_<AbstractProperty*>& source) {
+// the source, and share the source's index map.
+void PropertyTable::replaceProperties(const PropertyTable& source) {
     deleteProperties();
-    for (unsigned i=0; i < source.size(); ++i) {
-        properties.push_back(source[i]->clone());
-        propertyIndex[source[i]->getName()] = i;
-    }
+    properties.reserve(source.properties.size());
+    for (unsigned i=0; i < source.properties.size(); ++i)
+        properties.push_back(source.properties[i]->clone());
+    propertyIndex = source.propertyIndex;
 }
 
 // Private method to delete all the properties and clear the index.
@@ -166,6 +174,6 @@ void PropertyTable::deleteProperties() {
     for (unsigned i=0; i < properties.size(); ++i)
         delete properties[i];
     properties.clear();
-    propertyIndex.clear();
+    propertyIndex.reset();
 }
 
@@ -28,6 +28,8 @@
 #include "Property.h"
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 namespace OpenSim {
 
@@ -164,16 +166,20 @@ public:
 // DATA
 //==============================================================================
 private:
-    // Make this properties array a deep copy of the source. Any existing
-    // properties are deleted first. The index map is updated appropriately.
-    void replaceProperties(const SimTK::Array_<AbstractProperty*>& source);
+    // Make this properties array a deep copy of the source's. Any existing
+    // properties are deleted first. The index map is shared with the source.
+    void replaceProperties(const PropertyTable& source);
     // Delete all properties and clear the index map.
     void deleteProperties();
 
     // The properties, in the order they were added.
     SimTK::Array_<AbstractProperty*>    properties;
     // A mapping from property name to its index in the properties array.
-    std::map<std::string, int>          propertyIndex;
+    // Copies of a table have the same property names at the same indices, so
+    // copies (e.g., of an Object's default instance) share the map rather
+    // than rebuilding it. A shared map is never modified; adoptProperty()
+    // makes a private copy first.
+    std::shared_ptr<std::unordered_map<std::string, int>> propertyIndex;
 
 //==============================================================================
 };  // END of class PropertyTable
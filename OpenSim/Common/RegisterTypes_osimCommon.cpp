@@ -71,39 +71,41 @@ OSIMCOMMON_API void RegisterTypes_osimCommon()
   try {
 
     //SimTK::Xml::setXmlCondenseWhiteSpace(false);
-    Object::registerType( FunctionSet() );
-    Object::registerType( GCVSplineSet() );
-    Object::registerType( ScaleSet() );
-
-    Object::registerType( GCVSpline() );
-
-    Object::registerType( Scale() );
-    Object::registerType( SimmSpline() );
-    Object::registerType( Constant() );
-    Object::registerType( Sine() );
-    Object::registerType( StepFunction() );
-    Object::registerType( LinearFunction() );
-    Object::registerType( PiecewiseLinearFunction() );
-    Object::registerType( PiecewiseConstantFunction() );
-    Object::registerType( MultiplierFunction() );
-    Object::registerType( PolynomialFunction() );
-    Object::registerType( MultivariatePolynomialFunction() );
-
-    Object::registerType( SignalGenerator() );
-
-    Object::registerType( ObjectGroup() );
+    Object::registerTypeLazily<FunctionSet>();
+    Object::registerTypeLazily<GCVSplineSet>();
+    Object::registerTypeLazily<ScaleSet>();
+
+    Object::registerTypeLazily<GCVSpline>();
+
+    Object::registerTypeLazily<Scale>();
+    Object::registerTypeLazily<SimmSpline>();
+    Object::registerTypeLazily<Constant>();
+    Object::registerTypeLazily<Sine>();
+    Object::registerTypeLazily<StepFunction>();
+    Object::registerTypeLazily<LinearFunction>();
+    Object::registerTypeLazily<PiecewiseLinearFunction>();
+    Object::registerTypeLazily<PiecewiseConstantFunction>();
+    Object::registerTypeLazily<MultiplierFunction>();
+    Object::registerTypeLazily<PolynomialFunction>();
+    Object::registerTypeLazily<MultivariatePolynomialFunction>();
+
+    Object::registerTypeLazily<SignalGenerator>();
+
+    Object::registerTypeLazily<ObjectGroup>();
     
-    Object::registerType( TableSource() );
-    Object::registerType( TableSourceVec3() );
-    Object::registerType( TableReporter() );
-    Object::registerType( TableReporterVec3() );
-    Object::registerType( TableReporterVector() );
-    Object::registerType( ConsoleReporter() );
-    Object::registerType( ConsoleReporterVec3() );
-
-    Object::registerType(ModelDisplayHints());
-    Object::registerType(ExperimentalSensor());
-    Object::registerType(XsensDataReaderSettings());
+    Object::registerTypeLazily<TableSource>();
+    Object::registerTypeLazily<TableSourceVec3>();
+    Object::registerTypeLazily<TableReporter>();
+    Object::registerTypeLazily<TableReporterVec3>();
+    Object::registerTypeLazily<TableReporterVector>();
+    Object::registerTypeLazily<STOFileReporter>();
+    Object::registerTypeLazily<STOFileReporterVec3>();
+    Object::registerTypeLazily<ConsoleReporter>();
+    Object::registerTypeLazily<ConsoleReporterVec3>();
+
+    Object::registerTypeLazily<ModelDisplayHints>();
+    Object::registerTypeLazily<ExperimentalSensor>();
+    Object::registerTypeLazily<XsensDataReaderSettings>();
 
     // TODO: temporarily map old NaturalCubicSpline (which wasn't a
     // natural cubic spline) to renamed SimmSpline class. Later we
@@ -25,6 +25,7 @@
 // INCLUDE
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Common/STOFileAdapter.h>
 
 namespace OpenSim {
 
@@ -156,6 +157,22 @@ protected:
     called from a derived class constructor. **/
     Reporter() = default;
     virtual ~Reporter() = default;
+
+    /** The "inputs" Input. This is resolved when connecting so that
+    implementReport() does not look up the Input by name every time it is
+    invoked. */
+    const Input<InputT>& getReportInput() const {
+        if (_reportInput) return *_reportInput;
+        return this->template getInput<InputT>("inputs");
+    }
+
+    void extendFinalizeConnections(Component& root) override {
+        Super::extendFinalizeConnections(root);
+        _reportInput.reset(&this->template getInput<InputT>("inputs"));
+    }
+
+private:
+    SimTK::ReferencePtr<const Input<InputT>> _reportInput;
     //=============================================================================
 };  // END of class Reporter<InputT>
     //=============================================================================
@@ -184,6 +201,7 @@ public:
 
     /** Retrieve the report as a TimeSeriesTable.                             */
     const TimeSeriesTable_<ValueT>& getTable() const {
+        appendBufferedRows();
         return _outputTable;
     }
 
@@ -200,35 +218,28 @@ public:
         if (!columnLabels.empty()) {
             _outputTable.setColumnLabels(columnLabels);
         }
+        _bufferedTimes.clear();
     }
 
 protected:
     void implementReport(const SimTK::State& state) const override {
-        const auto& input = this->template getInput<InputT>("inputs");
-        SimTK::RowVector_<ValueT> result;
-        result.resize(int(input.getNumConnectees()));
-
-        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
-              const auto& chan = input.getChannel(idx);
-              const auto& value = chan.getValue(state);
-              result[idx] = value;
-        }
-        try {
-            const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(),
-                                                            result);
-        } catch(const InvalidTimestamp& exception) {
-            OPENSIM_THROW(Exception,
-                          "Attempting to update reporter with rows having "
-                          "invalid timestamps. Hint: If running simulation in "
-                          "a loop, use clearTable() to clear table at the end "
-                          "of each loop.\n\n" + std::string{exception.what()});
+        const auto& input = this->getReportInput();
+        const int numColumns = int(input.getNumConnectees());
+        checkReportTime(state.getTime());
+
+        // Write the values directly into the next row of the buffer.
+        auto bufferedRow = updNextBufferedRow(numColumns);
+        for (int idx = 0; idx < numColumns; ++idx) {
+            bufferedRow[idx] = input.getChannel(idx).getValue(state);
         }
+        _bufferedTimes.push_back(state.getTime());
     }
 
     void extendFinalizeConnections(Component& root) override {
         Super::extendFinalizeConnections(root);
+        appendBufferedRows();
 
-        const auto& input = this->template getInput<InputT>("inputs");
+        const auto& input = this->getReportInput();
 
         std::vector<std::string> labels;
         for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
@@ -241,16 +252,203 @@ protected:
                       << this->getName() << "' of type "
                       << getConcreteClassName() << ". You can connect outputs "
                       "by calling addToReport()." << std::endl;
-
         }
     }
 
 private:
+    // Rows must be reported in order of increasing time.
+    void checkReportTime(double time) const {
+        const size_t rowIndex =
+                _outputTable.getNumRows() + _bufferedTimes.size();
+        if (rowIndex > 0) {
+            const double previousTime = _bufferedTimes.empty()
+                    ? _outputTable.getIndependentColumn().back()
+                    : _bufferedTimes.back();
+            if (previousTime >= time) {
+                OPENSIM_THROW(Exception,
+                          "Attempting to update reporter with rows having "
+                          "invalid timestamps. Hint: If running simulation in "
+                          "a loop, use clearTable() to clear table at the end "
+                          "of each loop.\n\n" +
+                          std::string{TimestampLessThanEqualToPrevious(
+                                  __FILE__, __LINE__, __func__, rowIndex,
+                                  time, previousTime).what()});
+            }
+        }
+    }
+
+    // The next (uninitialized) row of the buffer; the caller fills the row
+    // and then appends the time to _bufferedTimes.
+    SimTK::RowVectorView_<ValueT> updNextBufferedRow(int numColumns) const {
+        if (_bufferedRows.ncol() != numColumns) {
+            appendBufferedRows();
+            _bufferedRows.resize(0, numColumns);
+        }
+        const int row = int(_bufferedTimes.size());
+        if (row == _bufferedRows.nrow()) {
+            _bufferedRows.resizeKeep(std::max(64, 2 * row), numColumns);
+        }
+        return _bufferedRows.updRow(row);
+    }
+
+    // Append the buffered rows to the table, in one step, since appending
+    // the rows one at a time would reallocate the table's matrix each time.
+    void appendBufferedRows() const {
+        if (_bufferedTimes.empty()) return;
+        const int numOldRows = int(_outputTable.getNumRows());
+        const int numNewRows = int(_bufferedTimes.size());
+        const int numColumns = _bufferedRows.ncol();
+        OPENSIM_THROW_IF(numOldRows > 0 &&
+                int(_outputTable.getNumColumns()) != numColumns, Exception,
+                fmt::format("Expected rows with {} columns, but got {}. Hint: "
+                        "use clearTable() after changing the outputs "
+                        "connected to the reporter.",
+                        _outputTable.getNumColumns(), numColumns));
+
+        auto& table = const_cast<Self*>(this)->_outputTable;
+        std::vector<std::string> labels;
+        if (_outputTable.hasColumnLabels()) {
+            labels = _outputTable.getColumnLabels();
+        }
+        if (int(labels.size()) != numColumns) {
+            // The table cannot be constructed without a label for each
+            // column; append the rows individually instead.
+            for (int irow = 0; irow < numNewRows; ++irow) {
+                table.appendRow(_bufferedTimes[irow], _bufferedRows.row(irow));
+            }
+            _bufferedTimes.clear();
+            return;
+        }
+
+        std::vector<double> times = _outputTable.getIndependentColumn();
+        times.insert(times.end(), _bufferedTimes.begin(),
+                _bufferedTimes.end());
+        SimTK::Matrix_<ValueT> data(numOldRows + numNewRows, numColumns);
+        if (numOldRows > 0) {
+            data.updBlock(0, 0, numOldRows, numColumns) =
+                    _outputTable.getMatrix();
+        }
+        data.updBlock(numOldRows, 0, numNewRows, numColumns) =
+                _bufferedRows.block(0, 0, numNewRows, numColumns);
+        table = TimeSeriesTable_<ValueT>(times, data, labels);
+        _bufferedTimes.clear();
+    }
 
     // Hold the output values in a table with values as columns and time rows
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+    // Rows that have been reported but not yet appended to _outputTable; the
+    // capacity of the buffer grows geometrically. See appendBufferedRows().
+    mutable std::vector<double> _bufferedTimes;
+    mutable SimTK::Matrix_<ValueT> _bufferedRows;
+};
+
+/**
+* This concrete Reporter writes the values of Output<T>s to a STO file while the
+* simulation runs, instead of keeping them in memory as TableReporter_ does.
+* Use this reporter for long simulations with many outputs, for which the
+* table of a TableReporter_ would become too large. The rows are buffered (see
+* the buffer_size property) and written to the file in batches with a
+* STOFileStreamWriter_. The column labels come from the names of the outputs
+* connected to this reporter.
+*
+* The file is created when the first row is reported and is completed when
+* closeFile() is called or the reporter is destroyed; the file can then be read
+* like any other STO file (e.g., with TimeSeriesTable_). Reporting after
+* closeFile() (e.g., when simulating in a loop) creates the file anew.
+*
+* @code
+* auto* reporter = new STOFileReporter();
+* reporter->set_file_name("activations.sto");
+* reporter->addToReport(muscle.getOutput("activation"));
+* model.addComponent(reporter);
+* // ... simulate ...
+* reporter->closeFile();
+* @endcode
+*
+* @ingroup reporters
+*
+* @tparam T The type for the Reporter's Input (i.e., Reporter<T>); one of the
+*           types supported by STOFileAdapter_.
+*/
+template<typename T = SimTK::Real>
+class STOFileReporter_ : public Reporter<T> {
+OpenSim_DECLARE_CONCRETE_OBJECT_T(STOFileReporter_, T, Reporter<T>);
+public:
+    OpenSim_DECLARE_PROPERTY(file_name, std::string,
+        "Name of the STO file to which the reported values are written.");
+    OpenSim_DECLARE_PROPERTY(buffer_size, int,
+        "Number of rows held in memory before they are written to the file "
+        "(default: 256).");
+
+    STOFileReporter_() { constructProperties(); }
+    virtual ~STOFileReporter_() = default;
+
+    /** Write the buffered rows to the file and complete the file. This has no
+    effect if no rows have been reported since the file was last closed.      */
+    void closeFile() {
+        if (_writer.get()) {
+            _writer->close();
+            _writer.reset();
+        }
+    }
+
+    /** The number of rows reported to the current file.                      */
+    int getNumRowsReported() const {
+        return _writer.get() ? _writer->getNumRows() : 0;
+    }
+
+protected:
+    void implementReport(const SimTK::State& state) const override {
+        const auto& input = this->getReportInput();
+        if (!_writer.get()) {
+            std::vector<std::string> labels;
+            for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
+                labels.push_back(input.getLabel(idx));
+            }
+            _writer.reset(new STOFileStreamWriter_<T>(get_file_name(), labels,
+                    ValueArrayDictionary{}, get_buffer_size()));
+        }
+
+        _row.resize(int(input.getNumConnectees()));
+        for (auto idx = 0u; idx < input.getNumConnectees(); ++idx) {
+            _row[idx] = input.getChannel(idx).getValue(state);
+        }
+        try {
+            _writer->appendRow(state.getTime(), _row);
+        } catch (const InvalidTimestamp& exception) {
+            OPENSIM_THROW_FRMOBJ(Exception,
+                    "Attempting to report rows having invalid timestamps. "
+                    "Hint: If running simulation in a loop, use closeFile() "
+                    "at the end of each loop.\n\n" +
+                    std::string{exception.what()});
+        }
+    }
+
+    void extendFinalizeFromProperties() override {
+        Super::extendFinalizeFromProperties();
+        OPENSIM_THROW_IF_FRMOBJ(get_file_name().empty(), InvalidPropertyValue,
+                getProperty_file_name().getName(),
+                "A file name must be provided.");
+        OPENSIM_THROW_IF_FRMOBJ(get_buffer_size() < 1, InvalidPropertyValue,
+                getProperty_buffer_size().getName(),
+                "Expected a positive number of rows.");
+    }
+
+private:
+    void constructProperties() {
+        constructProperty_file_name("");
+        constructProperty_buffer_size(
+                STOFileStreamWriter_<T>::DefaultBufferSize);
+    }
+
+    // The file is written in const methods, but only because we ensure those
+    // const methods are never called with trial integrator states.
+    mutable SimTK::ResetOnCopy<std::unique_ptr<STOFileStreamWriter_<T>>>
+            _writer;
+    // Reused for each row to avoid an allocation per report.
+    mutable SimTK::RowVector_<T> _row;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -270,7 +468,7 @@ public:
 private:
     void implementReport(const SimTK::State& state) const override {
         // Output::getNumberOfSignificantDigits().
-        const auto& input = this->template getInput<T>("inputs");
+        const auto& input = this->getReportInput();
 
         if (state.getTime() <= SimTK::Eps) {
             // reset print count if we reset the simulation
@@ -342,25 +540,54 @@ private:
     int _width = 14;
 };
 
-// specialization where InputT is Vector_<T> and ValueT is Real
+// specialization where InputT is Vector_<T> and ValueT is Real: each
+// connected vector occupies a contiguous block of columns, and its value is
+// obtained with a single call to the Output. The columns are labeled
+// <label>:<element label> if the Output has element labels
+// (AbstractOutput::setElementLabels()) and <label>[<index>] otherwise.
 template<>
 inline void TableReporter_<SimTK::Vector, SimTK::Real>::
     implementReport(const SimTK::State& state) const
 {
-    const auto& input = getInput<SimTK::Vector>("inputs");
-    const SimTK::Vector& result = input.getValue(state, 0);
-    
-    if (_outputTable.getNumRows() == 0) {
+    const auto& input = getReportInput();
+    const int numConnectees = int(input.getNumConnectees());
+    checkReportTime(state.getTime());
+
+    std::vector<const SimTK::Vector*> values(numConnectees);
+    int numColumns = 0;
+    for (int idx = 0; idx < numConnectees; ++idx) {
+        values[idx] = &input.getChannel(idx).getValue(state);
+        numColumns += values[idx]->size();
+    }
+
+    if (_outputTable.getNumRows() == 0 && _bufferedTimes.empty()) {
         std::vector<std::string> labels;
-        const std::string& base = input.getLabel(0);
-        for (int ix = 0; ix < result.size(); ++ix) {
-            labels.push_back(base + "[" + std::to_string(ix)+"]");
+        labels.reserve(numColumns);
+        for (int idx = 0; idx < numConnectees; ++idx) {
+            const std::string base = input.getLabel(idx);
+            const auto& elementLabels =
+                    input.getChannel(idx).getOutput().getElementLabels();
+            const int size = values[idx]->size();
+            for (int ix = 0; ix < size; ++ix) {
+                if (int(elementLabels.size()) == size) {
+                    labels.push_back(base + ":" + elementLabels[ix]);
+                } else {
+                    labels.push_back(base + "[" + std::to_string(ix) + "]");
+                }
+            }
         }
         const_cast<Self*>(this)->_outputTable.setColumnLabels(labels);
     }
 
-    const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(), 
-                                                    (~result).getAsRowVector());
+    auto bufferedRow = updNextBufferedRow(numColumns);
+    int column = 0;
+    for (int idx = 0; idx < numConnectees; ++idx) {
+        const SimTK::Vector& value = *values[idx];
+        for (int ix = 0; ix < value.size(); ++ix) {
+            bufferedRow[column++] = value[ix];
+        }
+    }
+    _bufferedTimes.push_back(state.getTime());
 }
 
 /** @name Commonly used concrete TableReporters */
@@ -386,6 +613,21 @@ vector control signals, or all the generalized coordinates in one vector.
 typedef TableReporter_<SimTK::Vector, SimTK::Real> TableReporterVector;
 /// @}
 
+/** @name Commonly used concrete STOFileReporters */
+/// @{
+/** This reporter writes doubles (e.g., muscle activations or coordinate
+values) to a STO file.
+@relates STOFileReporter_
+@ingroup reporters
+*/
+typedef STOFileReporter_<SimTK::Real> STOFileReporter;
+/** This reporter writes SimTK::Vec3%s (e.g., positions) to a STO file.
+@relates STOFileReporter_
+@ingroup reporters
+*/
+typedef STOFileReporter_<SimTK::Vec3> STOFileReporterVec3;
+/// @}
+
 /** @name Commonly used concrete ConsoleReporters */
 /// @{
 /** This table can report doubles; you can use this reporter to report muscle
@@ -28,7 +28,7 @@
 
 // INCLUDES
 #include <float.h>
-#include <math.h>
+#include <cmath>
 #include "RootSolver.h"
 
 
@@ -86,47 +86,68 @@ setNull()
 Array<double> RootSolver::
 solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol)
+{
+    int N = _function->getNX();
+    Array<double> fa(0.0,N),fb(0.0,N);
+    _function->evaluate(s,ax,fa);
+    _function->evaluate(s,bx,fb);
+    return solve(s,ax,bx,fa,fb,tol);
+}
+//_____________________________________________________________________________
+/**
+ * Solve for the roots, given the function values at the ends of the
+ * brackets.
+ */
+Array<double> RootSolver::
+solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,
+        const Array<double> &tol)
 {
     int i;
     int N = _function->getNX();
+    const bool useNewton = _function->hasDerivative();
 
     Array<double> a(0.0,N),b(0.0,N),c(0.0,N);
     Array<double> fa(0.0,N),fb(0.0,N),fc(0.0,N);
+    // Derivatives at a, b and c (NaN where unknown).
+    Array<double> dfa(SimTK::NaN,N),dfb(SimTK::NaN,N),dfc(SimTK::NaN,N);
     Array<double> prev_step(0.0,N);
     Array<double> tol_act(0.0,N);
     Array<double> p(0.0,N);
     Array<double> q(0.0,N);
     Array<double> new_step(0.0,N);
 
-    bool finished = false;
-    Array<int>   converged(0,N);
+    // Equations that have not converged.
+    Array<bool> active(true,N);
+    int numActive = N;
 
 
     // INITIALIZATIONS
     a = ax;
     b = bx;
-    _function->evaluate(s,a,fa);
-    _function->evaluate(s,b,fb);
+    fa = fax;
+    fb = fbx;
     c = a;
     fc = fa;
 
 
     // ITERATION LOOP
     int iter;
-    for(iter=0;!finished;iter++) {
+    for(iter=0;numActive>0;iter++) {
 
         // ABSCISSAE MANIPULATION LOOP
         for(i=0;i<N;i++) {
 
             // Continue?
             // If a function is already converged no need to do any manipulation.
-            if(converged[i]) continue;
+            if(!active[i]) continue;
    
             // Make c on opposite side of b.
             // (was down at very bottom)
              if( (fb[i]>0.0 && fc[i]>0.0) || (fb[i]<0.0 && fc[i]<0.0) ) {
                 c[i] = a[i];
                 fc[i] = fa[i];
+                dfc[i] = dfa[i];
              }
 
             // Record previous step
@@ -136,6 +157,7 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
             if( fabs(fc[i]) < fabs(fb[i]) ) {
                 a[i] = b[i];  b[i] = c[i];  c[i] = a[i];
                 fa[i]= fb[i]; fb[i]= fc[i]; fc[i]= fa[i];
+                dfa[i]= dfb[i]; dfb[i]= dfc[i]; dfc[i]= dfa[i];
             }
             tol_act[i] = 2.0*DBL_EPSILON*fabs(b[i]) + 0.5*tol[i];
             new_step[i] = 0.5 * (c[i]-b[i]);
@@ -143,14 +165,27 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
             // Converged?
             // Original convergence test:
             if(fabs(new_step[i])<=tol_act[i] || fb[i]==(double)0.0 ) {
-                converged[i] = iter;
+                active[i] = false;
+                --numActive;
                 continue;
             }
 
+            double cb = c[i]-b[i];
+            bool newtonStep = false;
+            // Newton step, if it remains within the bracket between b and c
+            // and is less than half of the previous step.
+            if(useNewton && std::isfinite(dfb[i]) && dfb[i]!=0.0) {
+                double newton = -fb[i]/dfb[i];
+                if( newton*cb>0.0 && fabs(newton)<fabs(cb) &&
+                        fabs(newton)<fabs(0.5*prev_step[i]) ) {
+                    new_step[i] = newton;
+                    newtonStep = true;
+                }
+            }
+
             // Interpolate if prev_step was large enough and in true direction
-            if( fabs(prev_step[i])>=tol_act[i] && fabs(fa[i])>fabs(fb[i]) ) {
-                double t1,cb,t2;
-                cb = c[i]-b[i];
+            if( !newtonStep && fabs(prev_step[i])>=tol_act[i] && fabs(fa[i])>fabs(fb[i]) ) {
+                double t1,t2;
 
                 // Only two distinct roots, must use linear interpolation.
                 if(a[i]==c[i]) {
@@ -188,26 +223,21 @@ solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
             }
 
             // Save previous approximation.
-            a[i] = b[i];  fa[i] = fb[i];
+            a[i] = b[i];  fa[i] = fb[i];  dfa[i] = dfb[i];
 
 
             b[i] += new_step[i];
              
         } // END ABSCISSAE LOOP
-     
-
-        // NEW FUNCTION EVALUATION
-        _function->evaluate(s, b,fb);
-
 
         // FINISHED?
-        for(i=0;i<N;i++) {
-            finished = true;
-            if(!converged[i]) {
-                finished = false;
-                break;
-            }
-        }
+        // Skip the evaluation if every equation has converged.
+        if(numActive==0) break;
+
+        // NEW FUNCTION EVALUATION
+        // Only the equations that have not converged.
+        _function->evaluateActive(s, b,fb, active);
+        if(useNewton) _function->evaluateDerivativeActive(s, b,dfb, active);
     }
 
     // PRINT
@@ -58,6 +58,14 @@ namespace OpenSim {
  * To construct an instance of this class, the user must provide an
  * instance of a VectorFunctionUncoupledNxN.
  *
+ * Each equation is solved with Brent's method and is dropped from the
+ * iterations as soon as it has converged: the function is evaluated (with
+ * VectorFunctionUncoupledNxN::evaluateActive()) only for the equations that
+ * have not converged, and not at all once every equation has converged. If
+ * the function provides derivatives (VectorFunctionUncoupledNxN::
+ * hasDerivative()), a Newton step is used in place of the interpolation
+ * whenever it stays within the bracket and shrinks it quickly enough.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -89,6 +97,12 @@ private:
 public:
     Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol);
+    /** Same as above, but with the function values at the ends of the
+    brackets, fax and fbx, already known (e.g., from computing the range of
+    the function), which saves two evaluations of the function. */
+    Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,
+        const Array<double> &tol);
 
 //=============================================================================
 };  // END class RootSolver
@@ -23,7 +23,9 @@
 #define OPENSIM_STO_FILE_ADAPTER_H_
 
 #include "DelimFileAdapter.h"
+#include "Logger.h"
 
+#include <memory>
 
 namespace OpenSim {
 
@@ -40,6 +42,8 @@ public:
     }
 };
 
+template<typename T> class STOFileStreamWriter_;
+
 /** STOFileAdapter is a DelimFileAdapter that presets the delimiters 
 appropriately for STO files. The format of the file is as follows:
 \code
@@ -115,9 +119,15 @@ public:
 
     STOFileAdapter_* clone() const override;
 
-    /** Write a STO file.                                                     */
+    /** Write a STO file. Numbers are written with `precision` significant
+    digits, or in the shortest form that reads back to the same value if
+    `precision` is not positive (see setWritePrecision()).                    */
     static
-    void write(const TimeSeriesTable_<T>& table, const std::string& fileName);
+    void write(const TimeSeriesTable_<T>& table, const std::string& fileName,
+               int precision = std::numeric_limits<double>::digits10 + 1);
+
+private:
+    friend class STOFileStreamWriter_<T>;
 };
 
 template<typename T>
@@ -137,10 +147,173 @@ STOFileAdapter_<T>::clone() const {
 template<typename T>
 void 
 STOFileAdapter_<T>::write(const TimeSeriesTable_<T>& table, 
-                         const std::string& fileName) {
+                         const std::string& fileName,
+                         int precision) {
     DataAdapter::InputTables tables{};
     tables.emplace(DelimFileAdapter<T>::tableString(), &table);
-    STOFileAdapter_{}.extendWrite(tables, fileName);
+    STOFileAdapter_ adapter{};
+    adapter.setWritePrecision(precision);
+    adapter.extendWrite(tables, fileName);
+}
+
+/** Write the rows of a TimeSeriesTable_ to a STO file one at a time, while
+they are being generated (e.g., during a simulation), instead of collecting
+the entire table in memory first. The rows are kept in a buffer of fixed size
+and written to the file whenever the buffer is full, so the memory used does
+not grow with the number of rows.
+
+The header (metadata and column labels) is written when the writer is
+created. Because the number of rows is not known until the end, the header
+contains an "nRows" entry that is filled in by close(); the file can then be
+read with STOFileAdapter (or Storage) like any other STO file. The destructor
+calls close() if it has not been called yet.
+
+@code
+STOFileStreamWriter writer("states.sto", {"q0", "q1"});
+writer.appendRow(0.0, row0);
+writer.appendRow(0.1, row1);
+writer.close();
+@endcode */
+template<typename T>
+class STOFileStreamWriter_ {
+public:
+    /** Value of getBufferSize() if none is provided.                         */
+    static constexpr int DefaultBufferSize = 256;
+
+    /** Create the file and write the header.
+    @param fileName Name of the STO file.
+    @param labels Column labels (excluding time).
+    @param metadata Metadata to write to the header (e.g., "inDegrees").
+    Entries for "nRows" and "nColumns" are ignored, as they are written by
+    this class.
+    @param bufferSize Maximum number of rows held in memory before they are
+    written to the file.                                                      */
+    STOFileStreamWriter_(const std::string& fileName,
+                         const std::vector<std::string>& labels,
+                         const ValueArrayDictionary& metadata = {},
+                         int bufferSize = DefaultBufferSize);
+
+    STOFileStreamWriter_(const STOFileStreamWriter_&)            = delete;
+    STOFileStreamWriter_& operator=(const STOFileStreamWriter_&) = delete;
+
+    ~STOFileStreamWriter_();
+
+    /** Append a row. The time must be greater than the time of the previous
+    row, and the row must have one element per column label.
+    @throws TimestampLessThanEqualToPrevious If time is not strictly
+    increasing.
+    @throws IncorrectNumColumns If row has the wrong number of elements.      */
+    void appendRow(double time, const SimTK::RowVectorBase<T>& row);
+
+    /** Write the buffered rows to the file.                                  */
+    void flush();
+
+    /** Write the buffered rows, fill in the number of rows in the header and
+    close the file. Subsequent calls have no effect.                          */
+    void close();
+
+    bool isOpen() const { return _stream.is_open(); }
+    const std::string& getFileName() const { return _fileName; }
+    /** The number of rows appended so far (written or buffered).             */
+    int getNumRows() const { return _numRows; }
+    int getBufferSize() const { return _buffer.nrow(); }
+
+private:
+    /** Width reserved for the value of "nRows" in the header.                */
+    static constexpr int NumRowsWidth = 20;
+
+    STOFileAdapter_<T> _adapter;
+    std::string _fileName;
+    std::ofstream _stream;
+    std::streampos _numRowsPos;
+    SimTK::Matrix_<T> _buffer;
+    std::vector<double> _bufferTimes;
+    double _lastTime{SimTK::NaN};
+    int _numRows{0};
+};
+
+template<typename T>
+STOFileStreamWriter_<T>::STOFileStreamWriter_(const std::string& fileName,
+        const std::vector<std::string>& labels,
+        const ValueArrayDictionary& metadata,
+        int bufferSize) :
+    _fileName(fileName),
+    _buffer(std::max(bufferSize, 1), static_cast<int>(labels.size())) {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    // Binary mode makes the position of the nRows entry a byte offset.
+    _stream.open(fileName, std::ios::out | std::ios::binary);
+    OPENSIM_THROW_IF(!_stream.good(), Exception,
+                     "Could not open file '{}' for writing.", fileName);
+    _bufferTimes.reserve(_buffer.nrow());
+
+    ValueArrayDictionary headerMetaData = metadata;
+    for(const std::string key : {"nRows", "nColumns"})
+        if(headerMetaData.hasKey(key))
+            headerMetaData.removeValueArrayForKey(key);
+    _adapter.writeMetaData(_stream, headerMetaData);
+    _stream << "nRows=";
+    _numRowsPos = _stream.tellp();
+    _stream << std::string(NumRowsWidth, ' ') << "\n";
+    _stream << "nColumns=" << labels.size() + 1 << "\n";
+    _adapter.writeEndOfHeader(_stream, labels);
+}
+
+template<typename T>
+STOFileStreamWriter_<T>::~STOFileStreamWriter_() {
+    try {
+        close();
+    } catch(const std::exception& e) {
+        log_error("STOFileStreamWriter: could not finalize '{}': {}",
+                  _fileName, e.what());
+    }
+}
+
+template<typename T>
+void
+STOFileStreamWriter_<T>::appendRow(double time,
+                                   const SimTK::RowVectorBase<T>& row) {
+    OPENSIM_THROW_IF(!isOpen(), Exception,
+                     "File '{}' has already been closed.", _fileName);
+    OPENSIM_THROW_IF(row.ncol() != _buffer.ncol(), IncorrectNumColumns,
+                     static_cast<size_t>(_buffer.ncol()),
+                     static_cast<size_t>(row.ncol()));
+    OPENSIM_THROW_IF(_numRows > 0 && time <= _lastTime,
+                     TimestampLessThanEqualToPrevious,
+                     static_cast<size_t>(_numRows), time, _lastTime);
+    if(static_cast<int>(_bufferTimes.size()) == _buffer.nrow())
+        flush();
+    _buffer.updRow(static_cast<int>(_bufferTimes.size())) = row;
+    _bufferTimes.push_back(time);
+    _lastTime = time;
+    ++_numRows;
+}
+
+template<typename T>
+void
+STOFileStreamWriter_<T>::flush() {
+    if(!isOpen())
+        return;
+    for(int i = 0; i < static_cast<int>(_bufferTimes.size()); ++i)
+        _adapter.writeRow(_stream, _bufferTimes[i], _buffer.row(i));
+    _bufferTimes.clear();
+    _stream.flush();
+    OPENSIM_THROW_IF(!_stream.good(), Exception,
+                     "Could not write to file '{}'.", _fileName);
+}
+
+template<typename T>
+void
+STOFileStreamWriter_<T>::close() {
+    if(!isOpen())
+        return;
+    flush();
+    // Now that the number of rows is known, complete the header. The value
+    // is padded with spaces, which are trimmed by the readers.
+    const std::string numRows = std::to_string(_numRows);
+    _stream.seekp(_numRowsPos);
+    _stream << numRows;
+    _stream.close();
 }
 
 std::shared_ptr<DataAdapter> 
@@ -152,6 +325,9 @@ createSTOFileAdapterForWriting(const AbstractDataTable& table);
 typedef STOFileAdapter_<double> STOFileAdapter;
 typedef STOFileAdapter_<SimTK::Vec3> STOFileAdapterVec3;
 typedef STOFileAdapter_<SimTK::Quaternion> STOFileAdapterQuaternion;
+
+typedef STOFileStreamWriter_<double> STOFileStreamWriter;
+typedef STOFileStreamWriter_<SimTK::Vec3> STOFileStreamWriterVec3;
 }
 
 #endif // OPENSIM_STO_FILE_ADAPTER_H_
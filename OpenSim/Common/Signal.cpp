@@ -28,6 +28,7 @@
 
 // INCLUDES
 #include <math.h>
+#include <algorithm>
 #include "Signal.h"
 #include "Array.h"
 #include "SimTKcommon/Constants.h"
@@ -142,37 +143,14 @@ SmoothSpline(int degree,double T,double fc,int N,double *times,double *sig,doubl
 //-----------------------------------------------------------------------------
 // IIR
 //-----------------------------------------------------------------------------
-//_____________________________________________________________________________
-/**
- * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER
- *
- * It is assumed that enough memory is allocated at sigf.
- * Note also that the first and last three data points are not filtered.
- *
- *  @param T Sample interval in seconds.
- *  @param fc Cutoff frequency in Hz.
- *  @param N Number of data points in the signal.
- *  @param sig The sampled signal.
- *  @param sigf The filtered signal.
- *
- * @return 0 on success, and -1 on failure.
- */
-int Signal::
-LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
+namespace {
+/// Compute the coefficients of the 3rd order lowpass Butterworth filter used
+/// by LowpassIIR(). The cutoff frequency is reduced if it is not below half
+/// the sample frequency.
+void computeLowpassIIRCoefficients(double T,double fc,double a[4],double b[4])
 {
-int i,j;
-double fs/*,ws*/,wc,wa,wa2,wa3;
-double a[4],b[4],denom;
-double *sigr;
-
-    // ERROR CHECK
-    if(T==0) return(-1);
-    if(N==0) return(-1);
-    if(sig==NULL) return(-1);
-    if(sigf==NULL) return(-1);
-
     // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
-    fs = 1 / T;
+    const double fs = 1 / T;
     if (fc >= 0.5 * fs) {
         fc = 0.49 * fs;
         log_warn("Cutoff frequency should be less than half sample frequency. "
@@ -180,63 +158,151 @@ double *sigr;
                  "cutoff = {}", fc);
     }
 
-    // INITIALIZE SOME VARIABLES
-    //ws = 2*SimTK_PI*fs;
-    wc = 2*SimTK_PI*fc;
-
     // CALCULATE THE FREQUENCY WARPING
-    wa = tan(wc*T/2.0);
-    wa2 = wa*wa;
-    wa3 = wa*wa*wa;
+    const double wc = 2*SimTK_PI*fc;
+    const double wa = tan(wc*T/2.0);
+    const double wa2 = wa*wa;
+    const double wa3 = wa*wa*wa;
 
     // GET COEFFICIENTS FOR THE FILTER
-    denom = (wa+1) * (wa*wa + wa + 1.0);
+    const double denom = (wa+1) * (wa*wa + wa + 1.0);
     a[0] = wa3 / denom;
     a[1] = 3*wa3 / denom;
     a[2] = 3*wa3 / denom;
     a[3] = wa3 / denom;
     b[0] = 1;
-    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
-    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
+    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom;
+    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom;
     b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+}
 
-    // ALLOCATE MEMORY FOR sigr[]
-    sigr = new double[N];
-    if(sigr==NULL) {
-        log_error("Signal.lowpassIIR: Not enough memory.");
-        return(-1);
-    }
-
-    // FILTER THE DATA
-    // FILL THE 1ST THREE TERMS OF sigf
-    for (i=0;i<=3;i++) sigf[i] = sig[i];
+/// Filter L signals of N points forward and then backward, in place. The
+/// last three inputs and outputs of each pass are kept in local arrays, so
+/// neither a reversed copy nor a workspace is needed. The signals are
+/// independent lanes of the same recursion; interleaving them hides the
+/// latency of the recursion and lets the compiler keep the lanes in vector
+/// registers. The first three points of each pass are not filtered.
+template <int L>
+void filtfiltLanes(const double a[4],const double b[4],int N,double* const y[L])
+{
+    double x1[L],x2[L],x3[L],y1[L],y2[L],y3[L];
 
-    // IMPLEMENT THE FORMULA
-    for (i=3;i<N;i++) {
-        sigf[i] = a[0]*sig[i] + a[1]*sig[i-1] +  a[2]*sig[i-2] +  a[3]*sig[i-3]
-                            - b[1]*sigf[i-1] - b[2]*sigf[i-2] - b[3]*sigf[i-3];
+    // FORWARD PASS
+    for (int l=0;l<L;l++) {
+        x1[l] = y1[l] = y[l][2];
+        x2[l] = y2[l] = y[l][1];
+        x3[l] = y3[l] = y[l][0];
     }
-
-    // REVERSE THE FILTERED ARRAY
-    for (i=0,j=N-1;i<N;i++,j--)  sigr[i] = sigf[j]; 
-
-    // FILL THE 1ST THREE TERMS OF sigf
-    for (i=0;i<=3;i++) sigf[i] = sigr[i];
-
-    // IMPLEMENT THE FORMULA AGAIN
-    for (i=3;i<N;i++) {
-        sigf[i] = a[0]*sigr[i] + a[1]*sigr[i-1] +  a[2]*sigr[i-2] +  a[3]*sigr[i-3]
-                             - b[1]*sigf[i-1] - b[2]*sigf[i-2] - b[3]*sigf[i-3];
+    for (int i=3;i<N;i++) {
+        for (int l=0;l<L;l++) {
+            const double xi = y[l][i];
+            const double yi = a[0]*xi + a[1]*x1[l] + a[2]*x2[l] + a[3]*x3[l]
+                              - b[1]*y1[l] - b[2]*y2[l] - b[3]*y3[l];
+            x3[l] = x2[l]; x2[l] = x1[l]; x1[l] = xi;
+            y3[l] = y2[l]; y2[l] = y1[l]; y1[l] = yi;
+            y[l][i] = yi;
+        }
     }
 
-    // REVERSE THE FILTERED ARRAY AGAIN
-    for (i=0,j=N-1;i<N;i++,j--)  sigr[i] = sigf[j]; 
-
-    // ASSIGN sigf TO sigr
-    for (i=0;i<N;i++)  sigf[i] = sigr[i];
+    // BACKWARD PASS
+    for (int l=0;l<L;l++) {
+        x1[l] = y1[l] = y[l][N-3];
+        x2[l] = y2[l] = y[l][N-2];
+        x3[l] = y3[l] = y[l][N-1];
+    }
+    for (int i=N-4;i>=0;i--) {
+        for (int l=0;l<L;l++) {
+            const double xi = y[l][i];
+            const double yi = a[0]*xi + a[1]*x1[l] + a[2]*x2[l] + a[3]*x3[l]
+                              - b[1]*y1[l] - b[2]*y2[l] - b[3]*y3[l];
+            x3[l] = x2[l]; x2[l] = x1[l]; x1[l] = xi;
+            y3[l] = y2[l]; y2[l] = y1[l]; y1[l] = yi;
+            y[l][i] = yi;
+        }
+    }
+}
+} // anonymous namespace
 
-    // CLEANUP
-    if(sigr!=NULL)  delete[] sigr;
+//_____________________________________________________________________________
+/**
+ * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER
+ *
+ * The signal is filtered forward and backward, so the filtered signal has no
+ * phase lag. It is permissible for sig and sigf to be the same array.
+ * Note also that the first and last three data points are not filtered.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in the signal.
+ *  @param sig The sampled signal.
+ *  @param sigf The filtered signal.
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
+{
+    if(sig==NULL) return(-1);
+    if(sigf==NULL) return(-1);
+    if(N<=0) return(-1);
+    if(sigf!=sig) std::copy(sig,sig+N,sigf);
+    return LowpassIIR(T,fc,N,1,N,sigf);
+}
+//_____________________________________________________________________________
+/**
+ * Same as LowpassIIR() above. The workspace is no longer needed, since the
+ * signal is filtered in place in sigf; this overload is kept for existing
+ * callers.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,const double *sig,double *sigf,
+        double *sigr)
+{
+    if(sigr==NULL) return(-1);
+    return LowpassIIR(T,fc,N,sig,sigf);
+}
+//_____________________________________________________________________________
+/**
+ * Filter several signals of the same length in place with the filter of
+ * LowpassIIR(). The signals are filtered four at a time as independent lanes
+ * of the same recursion, and no memory is allocated.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in each signal.
+ *  @param numSignals Number of signals.
+ *  @param stride Distance between the first points of consecutive signals
+ *  (e.g., the number of rows of a column-major matrix).
+ *  @param sigs The first point of the first signal; the signals are
+ *  overwritten with the filtered signals.
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,int numSignals,int stride,double *sigs)
+{
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+    if(numSignals<0) return(-1);
+    if(numSignals>1 && stride<N) return(-1);
+    if(sigs==NULL) return(-1);
+
+    double a[4],b[4];
+    computeLowpassIIRCoefficients(T,fc,a,b);
+
+    const int numLanes = 4;
+    int i = 0;
+    for (;i+numLanes<=numSignals;i+=numLanes) {
+        double* const lanes[numLanes] = {sigs+(size_t)i*stride,
+                sigs+(size_t)(i+1)*stride, sigs+(size_t)(i+2)*stride,
+                sigs+(size_t)(i+3)*stride};
+        filtfiltLanes<numLanes>(a,b,N,lanes);
+    }
+    for (;i<numSignals;i++) {
+        double* const lane[1] = {sigs+(size_t)i*stride};
+        filtfiltLanes<1>(a,b,N,lane);
+    }
 
   return(0);
 }
@@ -280,18 +346,30 @@ LowpassFIR(int M,double T,double f,int N,double *sig,double *sigf)
     // CALCULATE THE ANGULAR CUTOFF FREQUENCY
     w = 2.0*SimTK_PI*f;
 
+    // COMPUTE THE COEFFICIENTS ONCE; THEY ARE THE SAME FOR EVERY DATA POINT
+    std::vector<double> coef(M+M+1);
+    double sum_coef = 0.0;
+    for(k=-M;k<=M;k++) {
+        x = (double)k*w*T; // k*T = time (seconds) and w scales sinc input argument using filter cutoff
+        coef[M+k] = (sinc(x)*T*w/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
+        sum_coef = sum_coef + coef[M+k];
+    }
+
     // FILTER THE DATA
-    double sum_coef,coef;
-    for(n=0;n<N;n++) {
-        sum_coef = 0.0;
-        sigf[n] = 0.0;
-        for(k=-M;k<=M;k++) {   
-            x = (double)k*w*T; // k*T = time (seconds) and w scales sinc input argument using filter cutoff
-            coef = (sinc(x)*T*w/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
-            sigf[n] = sigf[n] + coef*s[M+n-k]; 
-            sum_coef = sum_coef + coef;
+    // The convolution is computed for blocks of consecutive data points, with
+    // the loop over the block innermost, so that the inner loop reads the
+    // padded signal contiguously and can be vectorized.
+    const int blockSize = 64;
+    double sum[blockSize];
+    for(int n0=0;n0<N;n0+=blockSize) {
+        const int nb = std::min(blockSize,N-n0);
+        for(n=0;n<nb;n++) sum[n] = 0.0;
+        for(k=-M;k<=M;k++) {
+            const double c = coef[M+k];
+            const double* sk = &s[M+n0-k];
+            for(n=0;n<nb;n++) sum[n] = sum[n] + c*sk[n];
         }
-        sigf[n] = sigf[n] / sum_coef; // normalize for unity gain at DC
+        for(n=0;n<nb;n++) sigf[n0+n] = sum[n] / sum_coef; // normalize for unity gain at DC
     }
 
     // Filter check derived from http://www.dspguide.com/CH16.PDF
@@ -402,16 +480,23 @@ Pad(int aPad,int aN,const double aSignal[])
             "Expected aPad to be non-negative, but got {}.",
             aPad);
 
-    // COMPUTE FINAL SIZE
-    int size = aN + 2*aPad;
+    // ALLOCATE
+    std::vector<double> s(aN + 2*aPad);
+    Pad(aPad, aN, aSignal, s.data());
+    return s;
+}
+
+void Signal::
+Pad(int aPad,int aN,const double aSignal[],double s[])
+{
+    OPENSIM_THROW_IF(aPad < 0, Exception,
+            "Expected aPad to be non-negative, but got {}.",
+            aPad);
     OPENSIM_THROW_IF(aPad > aN, Exception,
             "Signal.Pad: requested pad size ({}) is greater than the "
             "number of points ({}).",
             aPad, aN);
 
-    // ALLOCATE
-    std::vector<double> s(size);
-
     // PREPEND
     int i,j;
     for(i=0,j=aPad;i<aPad;i++,j--)  s[i] = aSignal[j];
@@ -423,8 +508,6 @@ Pad(int aPad,int aN,const double aSignal[])
     // APPEND
     for(i=aPad+aN,j=aN-2;i<aPad+aPad+aN;i++,j--)  s[i] = aSignal[j];
     for(i=aPad+aN;i<aPad+aPad+aN;i++)  s[i] = 2.0*aSignal[aN-1] - s[i];
- 
-    return s;
 }
 //_____________________________________________________________________________
 /**
@@ -64,6 +64,21 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,const double *aSignal,double *rFilteredSignal);
+    /** Same as above. The signal is now filtered in place in
+    rFilteredSignal, so the workspace is not used; this overload is kept for
+    existing callers. */
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,const double *aSignal,double *rFilteredSignal,double *rWork);
+    /** Filter aNumSignals signals of aN points each in place, with the same
+    zero-phase filter as above and without allocating memory. Consecutive
+    signals start aStride doubles apart (e.g., the columns of a column-major
+    matrix with aStride rows). The signals are processed several at a time
+    as independent lanes, which is much faster than filtering them one at a
+    time. */
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        int aN,int aNumSignals,int aStride,double *rSignals);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
@@ -86,6 +101,10 @@ public:
     /// @param aSignal Signal to be padded.
     /// @return Padded signal. The size is aN + 2*aPad.
     static std::vector<double> Pad(int aPad, int aN, const double aSignal[]);
+    /// Same as above, but the padded signal is written into rPadded, which
+    /// must have room for aN + 2*aPad values, so that no memory is allocated.
+    static void Pad(int aPad, int aN, const double aSignal[],
+            double rPadded[]);
     static void Pad(int aPad, OpenSim::Array<double>& aSignal);
 
     //--------------------------------------------------------------------------
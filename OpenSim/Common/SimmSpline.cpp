@@ -27,11 +27,172 @@
 #include "Constant.h"
 #include "SimmMacros.h"
 #include "XYFunctionInterface.h"
-#include "FunctionAdapter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 
 using namespace OpenSim;
 using namespace std;
+
+namespace {
+/* Evaluate the value (aDerivOrder = 0) or the first or second derivative of a
+ * SimmSpline with n knots x and coefficients y, b, c, d at aX. If interval is
+ * provided, the knot interval it contains is tried first and it is updated
+ * with the interval that contains aX. */
+double evaluateSimmSpline(int n, const double* x, const double* y,
+        const double* b, const double* c, const double* d, double aX,
+        int aDerivOrder, int* interval)
+{
+   /* Check if the abscissa is out of range of the function. If it is,
+    * then use the slope of the function at the appropriate end point to
+    * extrapolate. You do this rather than printing an error because the
+    * assumption is that this will only occur in relatively harmless
+    * situations (like a motion file that contains an out-of-range coordinate
+    * value). The rest of the SIMM code has many checks to clamp a coordinate
+    * value within its range of motion, so if you make it to this function
+    * and the coordinate is still out of range, deal with it quietly.
+    */
+   if (aX < x[0])
+   {
+      if (aDerivOrder == 0)
+         return y[0] + (aX - x[0])*b[0];
+      else if (aDerivOrder == 1)
+         return b[0];
+      else
+         return 0;
+   }
+   else if (aX > x[n-1])
+   {
+      if (aDerivOrder == 0)
+         return y[n-1] + (aX - x[n-1])*b[n-1];
+      else if (aDerivOrder == 1)
+         return b[n-1];
+      else
+         return 0;
+   }
+
+   /* Check to see if the abscissa is close to one of the end points
+    * (the binary search method doesn't work well if you are at one of the
+    * end points.
+    */
+   if (EQUAL_WITHIN_ERROR(aX,x[0]))
+   {
+      if (aDerivOrder == 0)
+         return y[0];
+      else if (aDerivOrder == 1)
+         return b[0];
+      else
+         return 2.0*c[0];
+   }
+   else if (EQUAL_WITHIN_ERROR(aX,x[n-1]))
+   {
+      if (aDerivOrder == 0)
+         return y[n-1];
+      else if (aDerivOrder == 1)
+         return b[n-1];
+      else
+         return 2.0*c[n-1];
+   }
+
+    int k = -1;
+    if (n < 3)
+    {
+        /* If there are only 2 function points, then set k to zero
+         * (you've already checked to see if the abscissa is out of
+         * range or equal to one of the endpoints).
+         */
+        k = 0;
+    }
+    else
+    {
+        // Try the interval that contained the previous abscissa and the one
+        // after it before searching.
+        if (interval) {
+            const int hint = std::min(std::max(*interval, 0), n-2);
+            for (int h = hint; h <= std::min(hint+1, n-2); ++h) {
+                if (aX >= x[h] && aX <= x[h+1]) {
+                    k = h;
+                    break;
+                }
+            }
+        }
+        if (k == -1) {
+            /* Do a binary search to find which two points the abscissa is between. */
+            int i = 0;
+            int j = n;
+            while (1)
+            {
+                k = (i+j)/2;
+                if (aX < x[k])
+                    j = k;
+                else if (aX > x[k+1])
+                    i = k;
+                else
+                    break;
+            }
+        }
+    }
+    if (interval) *interval = k;
+
+   const double dx = aX - x[k];
+   if (aDerivOrder == 0)
+      return y[k] + dx*(b[k] + dx*(c[k] + dx*d[k]));
+   else if (aDerivOrder == 1)
+      return (b[k] + dx*(2.0*c[k] + 3.0*dx*d[k]));
+   else
+      return (2.0*c[k] + 6.0*dx*d[k]);
+}
+
+/* A SimTK::Function with a copy of the knots and coefficients of a SimmSpline
+ * in contiguous arrays. Unlike a FunctionAdapter, it is evaluated without
+ * going through the virtual OpenSim::Function interface or allocating the
+ * derivative components, and it remembers the knot interval of the previous
+ * evaluation so that nearby arguments (e.g., the coordinate values of
+ * successive realizations of a CustomJoint) do not need a full search. The
+ * remembered interval is only a hint, so sharing it among threads is safe. */
+class SimmSplineFunction : public SimTK::Function {
+public:
+    SimmSplineFunction(const Array<double>& x, const Array<double>& y,
+            const Array<double>& b, const Array<double>& c,
+            const Array<double>& d) {
+        if (y.getSize() && b.getSize() && c.getSize() && d.getSize()) {
+            _x.assign(&x[0], &x[0] + x.getSize());
+            _y.assign(&y[0], &y[0] + y.getSize());
+            _b.assign(&b[0], &b[0] + b.getSize());
+            _c.assign(&c[0], &c[0] + c.getSize());
+            _d.assign(&d[0], &d[0] + d.getSize());
+        }
+    }
+    double calcValue(const SimTK::Vector& x) const override {
+        return evaluate(x[0], 0);
+    }
+    double calcDerivative(const SimTK::Array_<int>& derivComponents,
+            const SimTK::Vector& x) const override {
+        const int order = (int)derivComponents.size();
+        if (order < 1 || order > 2)
+            throw Exception("SimmSpline::calcDerivative(): derivative order "
+                            "must be 1 or 2.");
+        return evaluate(x[0], order);
+    }
+    int getArgumentSize() const override { return 1; }
+    int getMaxDerivativeOrder() const override { return 2; }
+
+private:
+    double evaluate(double x, int order) const {
+        if (_x.empty()) return SimTK::NaN;
+        int interval = _interval.load(std::memory_order_relaxed);
+        const double value = evaluateSimmSpline((int)_x.size(), _x.data(),
+                _y.data(), _b.data(), _c.data(), _d.data(), x, order,
+                &interval);
+        _interval.store(interval, std::memory_order_relaxed);
+        return value;
+    }
+    std::vector<double> _x, _y, _b, _c, _d;
+    mutable std::atomic<int> _interval{0};
+};
+} // anonymous namespace
 using SimTK::Vector;
 
 
@@ -413,6 +574,8 @@ void SimmSpline::calcCoefficients()
    _c[nm1] *= 3.0;
    _d[nm1] = _d[nm2];
 
+   // The SimTK::Function created from the old coefficients is stale.
+   resetFunction();
 }
 
 double SimmSpline::getX(int aIndex) const
@@ -516,63 +679,20 @@ double SimmSpline::calcValue(const Vector& x) const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
-    double dx;
-
-    int n = _x.getSize();
-    double aX = x[0];
-
-   /* Check if the abscissa is out of range of the function. If it is,
-    * then use the slope of the function at the appropriate end point to
-    * extrapolate. You do this rather than printing an error because the
-    * assumption is that this will only occur in relatively harmless
-    * situations (like a motion file that contains an out-of-range coordinate
-    * value). The rest of the SIMM code has many checks to clamp a coordinate
-    * value within its range of motion, so if you make it to this function
-    * and the coordinate is still out of range, deal with it quietly.
-    */
-
-   if (aX < _x[0])
-       return _y[0] + (aX - _x[0])*_b[0];
-   else if (aX > _x[n-1])
-       return _y[n-1] + (aX - _x[n-1])*_b[n-1];
-
-   /* Check to see if the abscissa is close to one of the end points
-    * (the binary search method doesn't work well if you are at one of the
-    * end points.
-    */
-   if (EQUAL_WITHIN_ERROR(aX,_x[0]))
-       return _y[0];
-   else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
-       return _y[n-1];
+    return evaluateSimmSpline(_x.getSize(), &_x[0], &_y[0], &_b[0], &_c[0],
+            &_d[0], x[0], 0, nullptr);
+}
 
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
+double SimmSpline::calcValueAt(double x, int* interval) const
+{
+    // NOT A NUMBER
+    if(!_y.getSize()) return(SimTK::NaN);
+    if(!_b.getSize()) return(SimTK::NaN);
+    if(!_c.getSize()) return(SimTK::NaN);
+    if(!_d.getSize()) return(SimTK::NaN);
 
-   dx = aX - _x[k];
-   return _y[k] + dx*(_b[k] + dx*(_c[k] + dx*_d[k]));
+    return evaluateSimmSpline(_x.getSize(), &_x[0], &_y[0], &_b[0], &_c[0],
+            &_d[0], x, 0, interval);
 }
 
 double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
@@ -583,91 +703,27 @@ double SimmSpline::calcDerivative(const std::vector<int>& derivComponents, const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
-    double dx;
-
-    int n = _x.getSize();
-    double aX = x[0];
     int aDerivOrder = (int)derivComponents.size();
     if (aDerivOrder < 1 || aDerivOrder > 2)
         throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
 
-   /* Check if the abscissa is out of range of the function. If it is,
-    * then use the slope of the function at the appropriate end point to
-    * extrapolate. You do this rather than printing an error because the
-    * assumption is that this will only occur in relatively harmless
-    * situations (like a motion file that contains an out-of-range coordinate
-    * value). The rest of the SIMM code has many checks to clamp a coordinate
-    * value within its range of motion, so if you make it to this function
-    * and the coordinate is still out of range, deal with it quietly.
-    */
-
-   if (aX < _x[0])
-   {
-      if (aDerivOrder == 1)
-         return _b[0];
-      else
-         return 0;
-   }
-   else if (aX > _x[n-1])
-   {
-      if (aDerivOrder == 1)
-         return _b[n-1];
-      else
-         return 0;
-   }
-
-   /* Check to see if the abscissa is close to one of the end points
-    * (the binary search method doesn't work well if you are at one of the
-    * end points.
-    */
-   if (EQUAL_WITHIN_ERROR(aX,_x[0]))
-   {
-      if (aDerivOrder == 1)
-         return _b[0];
-      else
-         return 2.0*_c[0];
-   }
-   else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
-   {
-      if (aDerivOrder == 1)
-         return _b[n-1];
-      else
-         return 2.0*_c[n-1];
-   }
-
-    if (n < 3)
-    {
-        /* If there are only 2 function points, then set k to zero
-         * (you've already checked to see if the abscissa is out of
-         * range or equal to one of the endpoints).
-         */
-        k = 0;
-    }
-    else
-    {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
-    }
+    return evaluateSimmSpline(_x.getSize(), &_x[0], &_y[0], &_b[0], &_c[0],
+            &_d[0], x[0], aDerivOrder, nullptr);
+}
 
-   dx = aX - _x[k];
+double SimmSpline::calcDerivativeAt(double x, int order, int* interval) const
+{
+    // NOT A NUMBER
+    if(!_y.getSize()) return(SimTK::NaN);
+    if(!_b.getSize()) return(SimTK::NaN);
+    if(!_c.getSize()) return(SimTK::NaN);
+    if(!_d.getSize()) return(SimTK::NaN);
 
-   if (aDerivOrder == 1)
-      return (_b[k] + dx*(2.0*_c[k] + 3.0*dx*_d[k]));
+    if (order < 1 || order > 2)
+        throw Exception("SimmSpline::calcDerivative(): derivative order must be 1 or 2.");
 
-   else
-      return (2.0*_c[k] + 6.0*dx*_d[k]);
+    return evaluateSimmSpline(_x.getSize(), &_x[0], &_y[0], &_b[0], &_c[0],
+            &_d[0], x, order, interval);
 }
 
 int SimmSpline::getArgumentSize() const
@@ -681,5 +737,5 @@ int SimmSpline::getMaxDerivativeOrder() const
 }
 
 SimTK::Function* SimmSpline::createSimTKFunction() const {
-    return new FunctionAdapter(*this);
+    return new SimmSplineFunction(_x, _y, _b, _c, _d);
 }
@@ -119,9 +119,16 @@ public:
     // EVALUATION
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
+    double calcValueAt(double x, int* interval = nullptr) const override;
+    double calcDerivativeAt(double x, int order,
+            int* interval = nullptr) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
+    /** The returned function holds a copy of the knots and coefficients and
+    remembers the knot interval of its previous evaluation, so it is cheap to
+    evaluate at nearby arguments (e.g., by a CustomJoint). Create a new
+    function after modifying the spline. */
     SimTK::Function* createSimTKFunction() const override;
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
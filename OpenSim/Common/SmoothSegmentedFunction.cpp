@@ -24,6 +24,8 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -95,7 +97,8 @@ SmoothSegmentedFunction::
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name):
 _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
-     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name)
+     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name),
+     _lookupTableMaxError(SimTK::NaN)
 {
     
 
@@ -166,7 +169,8 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
  SmoothSegmentedFunction::SmoothSegmentedFunction():
  _x0(SimTK::NaN),_x1(SimTK::NaN),_y0(SimTK::NaN)
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
-     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
+     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET"),
+     _lookupTableMaxError(SimTK::NaN)
  {
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
@@ -203,6 +207,10 @@ double SmoothSegmentedFunction::calcValue(double x) const
     if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
+        if(!_lookupTables.empty()){
+            return interpolateLookupTable(_lookupTables[idx],_mXVec[idx](0),
+                                          _lookupTableSteps[idx],x,0);
+        }
         double u = SegmentedQuinticBezierToolkit::
                  calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
         yVal = SegmentedQuinticBezierToolkit::
@@ -271,6 +279,10 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     }else{
             if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
+                if(order <= 2 && !_lookupTables.empty()){
+                    return interpolateLookupTable(_lookupTables[idx],
+                                _mXVec[idx](0),_lookupTableSteps[idx],x,order);
+                }
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
                                 UTOL,MAXITER);
@@ -296,6 +308,52 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
 
 
+void SmoothSegmentedFunction::calcValues(const SimTK::Vector& x,
+                                         SimTK::Vector& y) const
+{
+    calcDerivatives(x,0,y);
+}
+
+void SmoothSegmentedFunction::calcDerivatives(const SimTK::Vector& x,
+                                              int order,
+                                              SimTK::Vector& y) const
+{
+    SimTK_ERRCHK2_ALWAYS(order >= 0 && order <= getMaxDerivativeOrder(),
+        "SmoothSegmentedFunction::calcDerivatives",
+        "%s: order must be between 0 and 6, but %i was entered",
+        _name.c_str(),order);
+
+    const int n = x.size();
+    y.resize(n);
+
+    if(order > 2 || _lookupTables.empty()){
+        for(int i=0; i < n; i++){
+            y[i] = calcDerivative(x[i],order);
+        }
+        return;
+    }
+
+    //The value and slope of the linear extrapolation regions, so that the
+    //loop below does not need to branch on the order.
+    const double c0 = (order == 0) ? _y0 : (order == 1 ? _dydx0 : 0);
+    const double m0 = (order == 0) ? _dydx0 : 0;
+    const double c1 = (order == 0) ? _y1 : (order == 1 ? _dydx1 : 0);
+    const double m1 = (order == 0) ? _dydx1 : 0;
+
+    for(int i=0; i < n; i++){
+        const double xi = x[i];
+        if(xi < _x0){
+            y[i] = c0 + m0*(xi-_x0);
+        }else if(xi > _x1){
+            y[i] = c1 + m1*(xi-_x1);
+        }else{
+            int idx = SegmentedQuinticBezierToolkit::calcIndex(xi,_mXVec);
+            y[i] = interpolateLookupTable(_lookupTables[idx],_mXVec[idx](0),
+                                          _lookupTableSteps[idx],xi,order);
+        }
+    }
+}
+
 double SmoothSegmentedFunction::
     calcDerivative(const SimTK::Array_<int>& derivComponents,
                  const SimTK::Vector& ax) const
@@ -431,6 +489,132 @@ SimTK::Vec2 SmoothSegmentedFunction::getCurveDomain() const
     return xrange;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Lookup table
+///////////////////////////////////////////////////////////////////////////////
+
+double SmoothSegmentedFunction::interpolateLookupTable(
+    const SimTK::Matrix& table, double x0, double step, double x, int order)
+{
+    const int numIntervals = table.nrow()-1;
+    int i = (int)((x-x0)/step);
+    if(i < 0) i = 0;
+    if(i > numIntervals-1) i = numIntervals-1;
+
+    //Cubic Hermite basis functions
+    double t  = (x-x0)/step - i;
+    double t2 = t*t;
+    double t3 = t2*t;
+    double h00 =  2*t3 - 3*t2 + 1;
+    double h10 =    t3 - 2*t2 + t;
+    double h01 = -2*t3 + 3*t2;
+    double h11 =    t3 -   t2;
+
+    return h00*table(i,order)   + h10*step*table(i,order+1)
+         + h01*table(i+1,order) + h11*step*table(i+1,order+1);
+}
+
+void SmoothSegmentedFunction::createLookupTable(double tolerance,
+                                                int maxNumIntervals)
+{
+    SimTK_ERRCHK1_ALWAYS(tolerance > 0,
+        "SmoothSegmentedFunction::createLookupTable",
+        "%s: The tolerance must be positive.",_name.c_str());
+    SimTK_ERRCHK1_ALWAYS(!_mXVec.empty(),
+        "SmoothSegmentedFunction::createLookupTable",
+        "%s: The curve has not been constructed.",_name.c_str());
+
+    //Exact evaluations are needed below.
+    clearLookupTable();
+
+    SimTK::Array_<SimTK::Matrix> tables(_numBezierSections);
+    SimTK::Array_<double> steps(_numBezierSections);
+    SimTK::Vec3 maxError(0);
+
+    for(int s=0; s < _numBezierSections; s++){
+        double xs0 = _mXVec[s](0);
+        double xs1 = _mXVec[s](_mXVec[s].size()-1);
+        SimTK::Matrix& table = tables[s];
+        int numIntervals = 16;
+        while(true){
+            double step = (xs1-xs0)/numIntervals;
+            table.resize(numIntervals+1,4);
+            for(int i=0; i <= numIntervals; i++){
+                //Evaluate the ends exactly so that neighboring sections agree.
+                double x = (i == numIntervals) ? xs1 : xs0 + i*step;
+                double u = SegmentedQuinticBezierToolkit::
+                        calcU(x,_mXVec[s],_arraySplineUX[s],UTOL,MAXITER);
+                table(i,0) = SegmentedQuinticBezierToolkit::
+                        calcQuinticBezierCurveVal(u,_mYVec[s]);
+                for(int order=1; order <= 3; order++){
+                    table(i,order) = SegmentedQuinticBezierToolkit::
+                        calcQuinticBezierCurveDerivDYDX(u,_mXVec[s],
+                                                        _mYVec[s],order);
+                }
+            }
+
+            SimTK::Vec3 error(0);
+            for(int i=0; i < numIntervals; i++){
+                double x = xs0 + (i+0.5)*step;
+                double u = SegmentedQuinticBezierToolkit::
+                        calcU(x,_mXVec[s],_arraySplineUX[s],UTOL,MAXITER);
+                for(int order=0; order <= 2; order++){
+                    double exact = (order == 0)
+                        ? SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveVal(u,_mYVec[s])
+                        : SegmentedQuinticBezierToolkit::
+                            calcQuinticBezierCurveDerivDYDX(u,_mXVec[s],
+                                                            _mYVec[s],order);
+                    double approx =
+                        interpolateLookupTable(table,xs0,step,x,order);
+                    error[order] = std::max(error[order],
+                                            std::abs(exact-approx));
+                }
+            }
+
+            steps[s] = step;
+            if((error[0] <= tolerance && error[1] <= tolerance)
+                || 2*numIntervals > maxNumIntervals){
+                for(int order=0; order <= 2; order++){
+                    maxError[order] = std::max(maxError[order],error[order]);
+                }
+                break;
+            }
+            numIntervals *= 2;
+        }
+    }
+
+    _lookupTables = tables;
+    _lookupTableSteps = steps;
+    _lookupTableMaxError = maxError;
+}
+
+void SmoothSegmentedFunction::clearLookupTable()
+{
+    _lookupTables.clear();
+    _lookupTableSteps.clear();
+    _lookupTableMaxError = SimTK::Vec3(SimTK::NaN);
+}
+
+bool SmoothSegmentedFunction::hasLookupTable() const
+{
+    return !_lookupTables.empty();
+}
+
+int SmoothSegmentedFunction::getLookupTableNumIntervals() const
+{
+    int numIntervals = 0;
+    for(unsigned int s=0; s < _lookupTables.size(); s++){
+        numIntervals += _lookupTables[s].nrow()-1;
+    }
+    return numIntervals;
+}
+
+SimTK::Vec3 SmoothSegmentedFunction::getLookupTableMaxError() const
+{
+    return _lookupTableMaxError;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Utility functions
 ///////////////////////////////////////////////////////////////////////////////
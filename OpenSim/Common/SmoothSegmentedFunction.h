@@ -122,6 +122,28 @@ namespace OpenSim {
        */
        double calcDerivative(double x, int order) const;       
 
+       /**Evaluates the curve at each of the domain points in x. This is
+       equivalent to calling calcValue(double) for each element but avoids the
+       per-call overhead, so it is the preferred way to evaluate many points
+       (e.g., the same curve shared by many muscles). The loop is fastest when
+       a lookup table has been created (see createLookupTable()), as each
+       point is then evaluated without iteration.
+
+       @param x The domain points of interest
+       @param y The values of the curve; resized to the size of x
+       */
+       void calcValues(const SimTK::Vector& x, SimTK::Vector& y) const;
+
+       /**Evaluates the derivative of the given order of the curve at each of
+       the domain points in x. See calcValues() and calcDerivative(double,int).
+
+       @param x     The domain points of interest
+       @param order The order of the derivative (0 to 6)
+       @param y     The derivatives of the curve; resized to the size of x
+       */
+       void calcDerivatives(const SimTK::Vector& x, int order,
+                            SimTK::Vector& y) const;
+
 #ifndef SWIG
        /// Allow the more general calcDerivative from the base class to be used.
        // This helps avoid the -Woverloaded-virtual warning with Clang.
@@ -197,6 +219,65 @@ namespace OpenSim {
                   derivative) linear extrapolation*/
        SimTK::Vec2 getCurveDomain() const;
 
+       /**Precompute tables of the curve's value and its first three
+       derivatives within the curve domain so that calcValue() and
+       calcDerivative() (orders 1 and 2) can be evaluated in constant time,
+       without inverting x(u) with Newton's method. Each Bezier section has
+       its own uniformly spaced table: the sections are joined with only C2
+       continuity, so a single table spanning the joints would converge much
+       more slowly.
+
+       Within each interval of a table, the derivative of order k (k = 0, 1,
+       2) is interpolated with a cubic Hermite polynomial that matches the
+       tabulated derivatives of order k and k+1 at both ends of the interval.
+       The interpolation error of such a polynomial is bounded by
+
+       \verbatim
+            |e_k| <= h^4/384 * max|d^(k+4)y/dx^(k+4)|
+       \endverbatim
+
+       where h is the spacing of the table. For each section, the number of
+       intervals starts at 16 and is doubled until the largest errors of the
+       value and of the first derivative, measured at the midpoints of the
+       intervals (where the Hermite error peaks), are below the tolerance, or
+       until maxNumIntervals is reached. Use getLookupTableMaxError() to
+       obtain the errors that were measured; the error of the second
+       derivative is reported but is not used to size the tables. The linear
+       extrapolation outside of the curve domain and derivatives of order 3
+       and higher are unaffected by the tables.
+
+       @param tolerance The largest error of the value and first derivative
+                        that is acceptable (default: 1e-9).
+       @param maxNumIntervals The largest number of intervals in the table of
+                        a single Bezier section (default: 65536).
+
+       <B>Computational Costs</B>
+       \verbatim
+            Creating the table : ~8 * numIntervals exact evaluations
+            x in curve domain  : ~3*m+25 flops, where m is the number of
+                                 Bezier sections
+       \endverbatim
+       */
+       void createLookupTable(double tolerance = 1e-9,
+                              int maxNumIntervals = 65536);
+
+       /**Remove the lookup tables created with createLookupTable() so that the
+       curve is evaluated exactly.*/
+       void clearLookupTable();
+
+       /**@returns true if createLookupTable() has been called (and
+       clearLookupTable() has not been called since).*/
+       bool hasLookupTable() const;
+
+       /**@returns The total number of intervals in the lookup tables of all
+       Bezier sections (0 if there are no tables).*/
+       int getLookupTableNumIntervals() const;
+
+       /**@returns The largest absolute errors of the value, first and second
+       derivatives of the lookup tables, measured at the midpoints of the
+       intervals when the tables were created (NaN if there are no tables).*/
+       SimTK::Vec3 getLookupTableMaxError() const;
+
        /**This function will generate a csv file (of 'name_curveName.csv', where 
        name is the one used in the constructor) of the muscle curve, and 
        'curveName' corresponds to the function that was called from
@@ -344,6 +425,21 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**For each Bezier section, samples of y, dy/dx, d2y/dx2 and d3y/dx3
+        (columns) at uniformly spaced points (rows) spanning the section.
+        Empty if there are no lookup tables.*/
+        SimTK::Array_<SimTK::Matrix> _lookupTables;
+        /**The spacing of the samples in each of _lookupTables*/
+        SimTK::Array_<double> _lookupTableSteps;
+        /**The errors measured when creating the lookup tables*/
+        SimTK::Vec3 _lookupTableMaxError;
+
+        /**Evaluate the cubic Hermite interpolant of the derivative of the
+        given order (0 to 2) from a table with the layout of _lookupTables,
+        whose first row is at x0.*/
+        static double interpolateLookupTable(const SimTK::Matrix& table,
+            double x0, double step, double x, int order);
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
@@ -71,6 +71,9 @@ private:
 public:
     StateVector()                   = default;
     StateVector(const StateVector&) = default;
+#ifndef SWIG
+    StateVector(StateVector&&)      = default;
+#endif
     virtual ~StateVector();
 
     StateVector(double aT);
@@ -85,6 +88,7 @@ private:
 public:
 #ifndef SWIG
     StateVector& operator=(const StateVector &aStateVector);
+    StateVector& operator=(StateVector&&) = default;
     bool operator==(const StateVector &aStateVector) const;
     bool operator<(const StateVector &aStateVector) const;
     friend std::ostream& operator<<(std::ostream &aOut,
@@ -41,7 +41,11 @@
 #include "StateVector.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include "TraceRecorder.h"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <spdlog/fmt/fmt.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -175,6 +179,7 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
     StorageInterface(fileName),
     _storage(StateVector())
 {
+    OPENSIM_TRACE_SCOPE_DYNAMIC("read " + fileName, "io");
     // SET NULL STATES
     setNull();
 
@@ -380,6 +385,7 @@ Storage(const Storage &aStorage,int aStateIndex,int aN,
     // COPY THE FIRST COLUMN AND COLUMNS aStateIndex+1 through aStateIndex+aN (corresponding to states aStateIndex - aStateIndex+aN-1)
     int originalNumCol = aStorage.getColumnLabels().getSize();
     _columnLabels.setSize(0);
+    _columnLabelIndices.clear();
     if(originalNumCol) {
         _columnLabels.append(aStorage.getColumnLabels()[0]);
         for(int i=0;i<aN && aStateIndex+1+i<originalNumCol;i++)
@@ -524,8 +530,12 @@ getHeaderToken() const
 int Storage::
 getStateIndex(const std::string &aColumnName, int startIndex) const
 {
-    int thisColumnIndex =
-            TableUtilities::findStateLabelIndex(_columnLabels, aColumnName);
+    if (_columnLabelIndices.empty() && _columnLabels.getSize()) {
+        _columnLabelIndices =
+                TableUtilities::createLabelIndexMap(_columnLabels);
+    }
+    int thisColumnIndex = TableUtilities::findStateLabelIndex(
+            _columnLabelIndices, aColumnName);
     if (thisColumnIndex == -1) {
         return -1;
     }
@@ -557,6 +567,7 @@ void Storage::
 parseColumnLabels(const char *aLabels)
 {
     _columnLabels.setSize(0);
+    _columnLabelIndices.clear();
 
     // HANDLE NULL POINTER
     if(aLabels==NULL) return;
@@ -597,6 +608,7 @@ void Storage::
 setColumnLabels(const Array<std::string> &aColumnLabels)
 {
     _columnLabels = aColumnLabels;
+    _columnLabelIndices.clear();
 }
 
 //_____________________________________________________________________________
@@ -1044,9 +1056,40 @@ getData(int aTimeIndex,int aN,SimTK::Vector& v) const
 int Storage::
 getDataAtTime(double aT,int aN,double **rData) const
 {
-
     // FIND THE CORRECT INTERVAL FOR aT
-    int i = findIndex(_lastI,aT);
+    return interpolate(findIndex(_lastI,aT),aT,aN,rData);
+}
+//_____________________________________________________________________________
+/**
+ * Get the first aN states at a specified time, starting the search for the
+ * time interval at a caller-owned index.
+ *
+ * @param aT Time at which to get the states.
+ * @param aN Number of states to get.
+ * @param rData Array where the returned data will be set.  The
+ * size of rData is assumed to be at least aN.
+ * @param rIndexHint Index at which to start the search; on return, the index
+ * of the row at or preceding aT.
+ * @return Number of states that were set.
+ */
+int Storage::
+getDataAtTime(double aT,int aN,double *rData,int &rIndexHint) const
+{
+    if(rData==NULL) return(0);
+    int i = findIndexFrom(rIndexHint,aT);
+    if(i>=0) rIndexHint = i;
+    return interpolate(i,aT,aN,&rData);
+}
+//_____________________________________________________________________________
+/**
+ * Linearly interpolate the first aN states at time aT between row aI and the
+ * row that follows it (or the row preceding it at the end of the data).
+ * If *rData is NULL, memory is allocated.
+ */
+int Storage::
+interpolate(int aI,double aT,int aN,double **rData) const
+{
+    int i = aI;
     if((i<0)||(_storage.getSize()<=0)) {
         *rData = NULL;
         return(0);
@@ -1206,11 +1249,70 @@ getDataColumn(const std::string& columnName, Array<double>& rData, double aStart
 
     int startIndex = findIndex(aStartTime);
     int colIndex = getStateIndex(columnName);
-    double *dataVec=0;
-    getDataColumn(colIndex, dataVec);
-    for(int i=startIndex; i<_storage.getSize(); i++)
-        rData.append(dataVec[i]);
-    delete[] dataVec;
+    const Array<double>* data;
+    for(int i=startIndex; i<_storage.getSize(); i++) {
+        data = &_storage[i].getData();
+        if(colIndex>=0 && colIndex<data->getSize())
+            rData.append((*data)[colIndex]);
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Get a view of a data column that does not copy the data.
+ */
+Storage::ColumnView Storage::
+getDataColumnView(int aStateIndex) const
+{
+    OPENSIM_THROW_IF(aStateIndex < 0, Exception,
+            "Expected a non-negative state index, but got {}.", aStateIndex);
+    return ColumnView(*this, aStateIndex);
+}
+
+Storage::ColumnView Storage::
+getDataColumnView(const std::string& columnName) const
+{
+    const int stateIndex = getStateIndex(columnName);
+    OPENSIM_THROW_IF(stateIndex < 0, Exception,
+            "Storage '{}' has no column '{}'.", getName(), columnName);
+    return ColumnView(*this, stateIndex);
+}
+
+//_____________________________________________________________________________
+/**
+ * Get all the data as a matrix whose columns are contiguous in memory. Each
+ * row of the storage is read only once.
+ */
+void Storage::
+getDataMatrix(SimTK::Matrix& rData) const
+{
+    const int nr = _storage.getSize();
+    const int nc = (nr>0) ? getSmallestNumberOfStates() : 0;
+    rData.resize(nr,nc);
+    for(int i=0;i<nr;i++) {
+        const double *y = _storage[i].getData().get();
+        for(int j=0;j<nc;j++) rData(i,j) = y[j];
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Set the data from a matrix with one row per stored time. Each row of the
+ * storage is written only once.
+ */
+void Storage::
+setDataMatrix(const SimTK::Matrix& aData)
+{
+    const int nr = _storage.getSize();
+    if(aData.nrow()!=nr) {
+        log_error("Storage.setDataMatrix: expected {} rows but got {}.",
+                nr, aData.nrow());
+        return;
+    }
+    for(int i=0;i<nr;i++) {
+        Array<double> &y = _storage[i].getData();
+        const int nc = std::min(aData.ncol(), y.getSize());
+        for(int j=0;j<nc;j++) y[j] = aData(i,j);
+    }
 }
 
 //_____________________________________________________________________________
@@ -1486,9 +1588,25 @@ append(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
     if(aN<0) return(_storage.getSize());
 
     // APPEND
-    StateVector vec(aT, SimTK::Vector_<double>(aN, aY));
-    append(vec,aCheckForDuplicateTime);
+    // The values are copied straight into the last row (a new one, unless the
+    // time is a duplicate) instead of through temporary vectors. The storage
+    // itself grows geometrically (capacity increment of -1 by default).
     // TODO: use some tolerance when checking for duplicate time?
+    if(!(aCheckForDuplicateTime && _storage.getSize() &&
+            _storage.getLast().getTime()==aT)) {
+        _storage.append(StateVector(aT));
+    }
+    StateVector& vec = _storage.updLast();
+    vec.setTime(aT);
+    Array<double>& data = vec.getData();
+    data.setSize(0);
+    data.ensureCapacity(aN);
+    data.append(aN,aY);
+
+    if (_fp!=0){
+        vec.print(_fp);
+        fflush(_fp);
+    }
     /*
     if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==vec.getTime())
         _storage.getLast() = vec;
@@ -1862,6 +1980,27 @@ multiplyColumn(int aIndex, double aValue)
     }
 }
 
+//_____________________________________________________________________________
+/**
+ * Multiply entries at several columns by a value, in a single pass over the
+ * state vectors.
+ *
+ * @param indices are the indices of the columns to multiply
+ * @param aValue Value by which to multiply the columns.
+ */
+void Storage::
+multiplyColumns(const std::vector<int>& indices, double aValue)
+{
+    if(indices.empty()) return;
+    for(int i=0;i<_storage.getSize();i++) {
+        Array<double>& data = _storage[i].getData();
+        const int size = data.getSize();
+        for(const int index : indices) {
+            if(index>=0 && index<size) data[index] *= aValue;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // DIVIDE
 //-----------------------------------------------------------------------------
@@ -2330,26 +2469,27 @@ pad(int aPadSize)
     int newSize = paddedTime.getSize();
 
     // PAD EACH COLUMN
-    int nc = getSmallestNumberOfStates();
-    Array<double> paddedSignal(0.0,size);
-    StateVector *vecs = new StateVector[newSize];
-    for(int j=0;j<newSize;j++) {
-        vecs[j].getData().setSize(nc);
-        vecs[j].setTime(paddedTime[j]);
-    }
+    SimTK::Matrix data;
+    getDataMatrix(data);
+    const int nc = data.ncol();
+    SimTK::Matrix padded(newSize,nc);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,paddedSignal);
-        Signal::Pad(aPadSize,paddedSignal);
-        for(int j=0;j<newSize;j++)
-            vecs[j].setDataValue(i,paddedSignal[j]);
+        const std::vector<double> paddedSignal =
+                Signal::Pad(aPadSize,size,&data(0,i));
+        std::copy(paddedSignal.begin(),paddedSignal.end(),&padded(0,i));
     }
 
-    // APPEND THE STATEVECTORS
-    _storage.setSize(0);
-    for(int i=0;i<newSize;i++) _storage.append(vecs[i]);
-
-    // CLEANUP
-    delete[] vecs;
+    // REPLACE THE STATEVECTORS
+    Array<StateVector> vecs(StateVector(),newSize);
+    for(int j=0;j<newSize;j++) {
+        vecs[j].setTime(paddedTime[j]);
+        Array<double> &y = vecs[j].getData();
+        y.setSize(nc);
+        for(int i=0;i<nc;i++) y[i] = padded(j,i);
+    }
+    const int capacityIncrement = _storage.getCapacityIncrement();
+    _storage = std::move(vecs);
+    _storage.setCapacityIncrement(capacityIncrement);
 }
 
 void Storage::
@@ -2377,19 +2517,18 @@ smoothSpline(int aOrder,double aCutoffFrequency)
 
     // LOOP OVER COLUMNS
     double *times=NULL;
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
+    SimTK::Matrix data;
+    getDataMatrix(data);
     Array<double> filt(0.0,size);
     getTimeColumn(times,0);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
+    for(int i=0;i<data.ncol();i++) {
+        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,&data(0,i),&filt[0]);
+        std::copy(&filt[0],&filt[0]+size,&data(0,i));
     }
+    setDataMatrix(data);
 
     // CLEANUP
     delete[] times;
-    delete[] signal;
 }
 
 void Storage::
@@ -2415,18 +2554,22 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    // FILTER THE COLUMNS IN PLACE (the columns are independent, so each
+    // thread filters a contiguous range of columns, several at a time)
+    SimTK::Matrix data;
+    getDataMatrix(data);
+    const int nc = data.ncol();
+    const int numThreads = std::max(1,
+            std::min(getMaxNumThreads(), nc));
+    parallelFor(numThreads, [&](int ithread) {
+        const int begin = ithread*nc/numThreads;
+        const int end = (ithread+1)*nc/numThreads;
+        if(end>begin) {
+            Signal::LowpassIIR(dtmin,aCutoffFrequency,size,end-begin,size,
+                    &data(0,begin));
+        }
+    }, numThreads);
+    setDataMatrix(data);
 }
 
 void Storage::
@@ -2452,18 +2595,17 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    // LOOP OVER COLUMNS (the columns are independent, so they are filtered
+    // in parallel)
+    SimTK::Matrix data;
+    getDataMatrix(data);
+    parallelFor(data.ncol(), [&](int i) {
+        std::vector<double> filt(size);
+        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,&data(0,i),
+                filt.data());
+        std::copy(filt.begin(),filt.end(),&data(0,i));
+    });
+    setDataMatrix(data);
 }
 
 
@@ -2475,10 +2617,10 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  * Find the index of the storage element that occurred immediately before
  * or at time aT ( aT <= getTime(index) ).
  *
- * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occurred later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * This method takes constant time if aT is in the interval at or right
+ * after aI (e.g., when aI is the result of the previous lookup and the time
+ * advances monotonically). Otherwise, a binary search is performed in the
+ * rows before or after aI.
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2487,29 +2629,57 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  */
 int Storage::
 findIndex(int aI,double aT) const
+{
+    int i = findIndexFrom(aI,aT);
+    if(i>=0) _lastI = i;
+    return(i);
+}
+//_____________________________________________________________________________
+/**
+ * Find the index of the storage element that occurred immediately before
+ * or at a specified time, starting at index aI, without updating _lastI.
+ *
+ * Lookups at monotonically advancing times usually land in the interval at or
+ * right after aI, which is checked first, so that they take constant time. If
+ * not, the bounding rows are found with a binary search.
+ */
+int Storage::
+findIndexFrom(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    const int size = _storage.getSize();
+    if(size<=0) return(-1);
+    if((aI>=size)||(aI<0)) aI=0;
+
+    // FIND THE RANGE [lo,hi) CONTAINING THE FIRST ROW AFTER aT
+    int lo,hi;
+    if(_storage[aI].getTime()>aT) {
+        lo = 0;
+        hi = aI;
+    } else {
+        if((aI+1>=size) || (aT<_storage[aI+1].getTime())) return(aI);
+        if((aI+2>=size) || (aT<_storage[aI+2].getTime())) return(aI+1);
+        lo = aI+3;
+        hi = size;
+    }
 
-    // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
-    int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    // BINARY SEARCH
+    while(lo<hi) {
+        int mid = lo + (hi-lo)/2;
+        if(aT<_storage[mid].getTime()) hi = mid;
+        else lo = mid+1;
     }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    int i = lo-1;
+    if(i<0) i=0;
+    return(i);
 }
 //_____________________________________________________________________________
 /**
  * Find the index of the storage element that occurred immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * The rows are located with a binary search, so the times must be
+ * nondecreasing.
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2519,13 +2689,7 @@ int Storage::
 findIndex(double aT) const
 {
     if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
-    return(_lastI);
+    return findIndex(_storage.getSize()-1,aT);
 }
 //_____________________________________________________________________________
 /**
@@ -2602,30 +2766,56 @@ resampleLinear(double aDT)
         aDT = newDT;
     }
 
-    Array<std::string> saveLabels = getColumnLabels();
-
     // HOW MANY TIME STEPS?
     double ti = getFirstTime();
     double tf = getLastTime();
     int nr = IO::ComputeNumberOfSteps(ti,tf,aDT);
 
-    Storage *newStorage = new Storage(nr);
-
-    // LOOP THROUGH THE DATA
-    int ny=0;
-    double *y=NULL;
-    StateVector vec;
+    // INTERPOLATE DIRECTLY FROM THE ORIGINAL ROWS INTO THE NEW ROWS
+    // The resampled times increase monotonically, so the interval is found by
+    // advancing a cursor rather than searching from the start for each time.
+    // The interpolation (including the handling of the end points) is the
+    // same as in getDataAtTime().
+    Array<StateVector> vecs(StateVector(),nr);
+    int ny = -1;
+    int i1 = 0;
     for(int i=0; i<nr; i++) {
         double t = ti+aDT*(double)i;
-        // INTERPOLATE THE STATES
-        ny = getDataAtTime(t,ny,&y);
-        newStorage->append(t,ny,y);
-    }
+        while((i1+1<numDataRows) && !(t<_storage[i1+1].getTime())) i1++;
 
-    copyData(*newStorage);
+        // CHECK FOR i AT END POINTS
+        int j1=i1,j2=i1+1;
+        if(j2==numDataRows) {
+            j1--;  if(j1<0) j1=0;
+            j2--;  if(j2<0) j2=0;
+        }
+        const StateVector &v1 = _storage[j1];
+        const StateVector &v2 = _storage[j2];
+
+        // GET THE SMALLEST N TO PREVENT MEMORY OVER-RUNS
+        int ns = std::min(v1.getSize(),v2.getSize());
+        if(ny>=0 && ny<ns) ns = ny;
+        ny = ns;
+
+        double pct = 0.0;
+        double den = v2.getTime()-v1.getTime();
+        if(den>=SimTK::Eps) pct = (t-v1.getTime())/den;
+
+        const double *y1 = v1.getData().get();
+        const double *y2 = v2.getData().get();
+        vecs[i].getData().setSize(ns);
+        double *y = vecs[i].getData().get();
+        for(int j=0;j<ns;j++) {
+            y[j] = (pct==0.0) ? y1[j] : y1[j] + pct*(y2[j]-y1[j]);
+        }
+        vecs[i].setTime(t);
+    }
 
-    delete newStorage;
-    delete[] y;
+    // REPLACE THE ROWS (units, labels and inDegrees are unchanged)
+    int capacityIncrement = _storage.getCapacityIncrement();
+    _storage = std::move(vecs);
+    _storage.setCapacityIncrement(capacityIncrement);
+    _lastI = 0;
 
     return aDT;
 }
@@ -2666,6 +2856,47 @@ void Storage::interpolateAt(const Array<double> &targetTimes)
 //=============================================================================
 // IO
 //=============================================================================
+namespace {
+/// Formats doubles with fmt to the same text as IO::GetDoubleOutputFormat()
+/// gives with printf.
+class DoubleFormatter {
+public:
+    DoubleFormatter() : _g(IO::GetGFormatForDoubleOutput()),
+            _scientific(IO::GetScientific()), _pad(IO::GetDigitsPad()),
+            _precision(IO::GetPrecision()) {}
+    void append(std::string& text, double value) const {
+        auto out = std::back_inserter(text);
+        if (_g) {
+            fmt::format_to(out, "{:g}", value);
+        } else if (_scientific) {
+            if (_pad < 0) fmt::format_to(out, "{:.{}e}", value, _precision);
+            else fmt::format_to(out, "{:>{}.{}e}", value, _pad + _precision,
+                    _precision);
+        } else {
+            if (_pad < 0) fmt::format_to(out, "{:.{}f}", value, _precision);
+            else fmt::format_to(out, "{:>{}.{}f}", value, _pad + _precision,
+                    _precision);
+        }
+    }
+    /// Append the time and the data of a StateVector as a line of a
+    /// storage file.
+    void append(std::string& text, const StateVector& vec) const {
+        append(text, vec.getTime());
+        const Array<double>& data = vec.getData();
+        for (int i = 0; i < data.getSize(); ++i) {
+            text += '\t';
+            append(text, data[i]);
+        }
+        text += '\n';
+    }
+private:
+    bool _g;
+    bool _scientific;
+    int _pad;
+    int _precision;
+};
+} // namespace
+
 //_____________________________________________________________________________
 /**
  * Set name of output file to be written into.
@@ -2707,6 +2938,7 @@ setOutputFileName(const std::string& aFileName)
 bool Storage::
 print(const string &aFileName,const string &aMode, const string& aComment) const
 {
+    OPENSIM_TRACE_SCOPE_DYNAMIC("write " + aFileName, "io");
     // OPEN THE FILE
     FILE *fp = IO::OpenFile(aFileName,aMode);
     if(fp==NULL) return(false);
@@ -2750,13 +2982,23 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
 //std::cout << aFileName << endl;
 
     // VECTORS
-    for(int i=0;i<_storage.getSize();i++) {
-        n = getStateVector(i)->print(fp);
-        if(n<0) {
-            log_error("Storage.print: error printing to {}.", aFileName);
-            return(false);
-        }
-        nTotal += n;
+    // Blocks of rows are formatted concurrently and written to the file in
+    // large pieces.
+    const DoubleFormatter formatter;
+    bool failed = false;
+    formatRowsInParallel(_storage.getSize(),
+            [&](int i, std::string& text) {
+                formatter.append(text, *getStateVector(i));
+            },
+            [&](const std::string& text) {
+                if (fwrite(text.data(), 1, text.size(), fp) != text.size())
+                    failed = true;
+                nTotal += (int)text.size();
+            });
+    if(failed) {
+        log_error("Storage.print: error printing to {}.", aFileName);
+        fclose(fp);
+        return(false);
     }
 
     // CLOSE
@@ -3210,6 +3452,7 @@ exchangeTimeColumnWith(int aColumnIndex)
     string swap = _columnLabels.get(0);
     _columnLabels.set(aColumnIndex+1, swap);
     _columnLabels.set(0, "time");
+    _columnLabelIndices.clear();
 
 }
 //_____________________________________________________________________________
@@ -3249,6 +3492,7 @@ void Storage::postProcessSIMMMotion()
                         StateVector vec = _storage.get(0);
                         vec.getData().append(0.0);
                         _columnLabels.append("time");
+                        _columnLabelIndices.clear();
                         exchangeTimeColumnWith(_columnLabels.findIndex("time"));
                     }
                     else
@@ -3257,6 +3501,7 @@ void Storage::postProcessSIMMMotion()
                 else {  // time  column from range, size
                     double timeStep = (end - start)/(_storage.getSize()-1);
                     _columnLabels.append("time");
+                    _columnLabelIndices.clear();
                     for(int i=0; i<_storage.getSize(); i++){
                         Array<double>& data=_storage.updElt(i).getData();
                         data.append(i*timeStep);
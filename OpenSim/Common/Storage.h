@@ -31,6 +31,7 @@
 #include "Units.h"
 #include "StorageInterface.h"
 #include "TimeSeriesTable.h"
+#include <unordered_map>
 
 const int Storage_DEFAULT_CAPACITY = 256;
 //=============================================================================
@@ -82,6 +83,9 @@ protected:
     std::string _headerToken;
     /** Column labels. */
     Array<std::string> _columnLabels;
+    /** Map from each column label to its index, built by getStateIndex()
+    when needed. Code that modifies _columnLabels must clear this. */
+    mutable std::unordered_map<std::string, int> _columnLabelIndices;
     /** Step interval at which states in a simulation are stored. See
     store(). */
     int _stepInterval;
@@ -198,6 +202,16 @@ public:
     int getDataAtTime(double aTime,int aN,double *rData) const;
     int getDataAtTime(double aTime,int aN,Array<double> &rData) const override;
     int getDataAtTime(double aTime,int aN,SimTK::Vector& v) const;
+#ifndef SWIG
+    /** Same as getDataAtTime(double,int,double*) but the search for the
+    time interval starts from (and updates) a caller-owned index rather than
+    the index of the previous lookup on this Storage. Callers that look up
+    monotonically advancing times (e.g., once per integrator step) should
+    keep one hint each, initialized to 0, so that each lookup costs O(1)
+    regardless of the number of rows, even when several callers share the
+    same Storage. The lookup does not modify the Storage. */
+    int getDataAtTime(double aTime,int aN,double *rData,int &rIndexHint) const;
+#endif
     int getDataColumn(int aStateIndex,double *&rData) const;
     int getDataColumn(int aStateIndex,Array<double> &rData) const;
     // Set entries in a column of the storage to a fixed value, 
@@ -205,6 +219,48 @@ public:
     void setDataColumn(int aStateIndex,const Array<double> &aData);
     int getDataColumn(const std::string& columnName,double *&rData) const;
     void getDataColumn(const std::string& columnName, Array<double>& data, double startTime=0.0) override;
+#ifndef SWIG
+    /** A read-only view of one state (column) of a Storage that refers to
+    the values in the rows instead of copying them. The view is invalidated
+    if rows are added to or removed from the Storage. */
+    class OSIMCOMMON_API ColumnView {
+    public:
+        /** The number of rows. */
+        int size() const { return _storage->getSize(); }
+        /** The value in row i, or NaN if row i has fewer states than the
+        index of this column. */
+        double operator[](int i) const {
+            const Array<double>& data = _storage->getStateVector(i)->getData();
+            return _stateIndex < data.getSize() ? data[_stateIndex]
+                                                : SimTK::NaN;
+        }
+        double getTime(int i) const {
+            return _storage->getStateVector(i)->getTime();
+        }
+        int getStateIndex() const { return _stateIndex; }
+    private:
+        friend class Storage;
+        ColumnView(const Storage& storage, int stateIndex)
+                : _storage(&storage), _stateIndex(stateIndex) {}
+        const Storage* _storage;
+        int _stateIndex;
+    };
+    /** Access a state (column) without copying it, e.g., to process many
+    columns in a loop. The column may be given by its state index or by its
+    label (see getStateIndex()).
+    @throws Exception if there is no such column. */
+    ColumnView getDataColumnView(int aStateIndex) const;
+    ColumnView getDataColumnView(const std::string& columnName) const;
+#endif
+    /** Get the data as a matrix with one row per time and one column per
+    state (only the first getSmallestNumberOfStates() states are included).
+    The matrix is filled in a single pass over the rows and its columns are
+    contiguous in memory, so processing all columns this way is much faster
+    than calling getDataColumn() for each of them. */
+    void getDataMatrix(SimTK::Matrix& rData) const;
+    /** %Set the first aData.ncol() states of each row from a matrix with
+    getSize() rows (e.g., obtained with getDataMatrix()). */
+    void setDataMatrix(const SimTK::Matrix& aData);
 
     /** Convert to a TimeSeriesTable. This may be useful if you need to use
     parts of the API that require a TimeSeriesTable instead of a Storage. */
@@ -245,6 +301,10 @@ public:
      * `<coord-name>/speed` and it is not found, then this function looks for
      * `<coord-name>_u`.
      *
+     * The labels are hashed the first time this is called after they
+     * change, so each lookup does not scan the labels; call this freely in
+     * loops over columns.
+     *
      * @return State index of column or -1.  Note that the returned index is
      * equivalent to the state index.  For example, for the first column in a
      * storage (usually time) -1 would be returned.  For the second column in a
@@ -288,6 +348,7 @@ public:
     void subtract(Storage *aStorage);
     void multiply(double aValue);
     void multiplyColumn(int aIndex, double aValue);
+    void multiplyColumns(const std::vector<int>& indices, double aValue);
     void multiply(const SimTK::Vector_<double>& values);
     void multiply(StateVector *aStateVector);
     void multiply(Storage *aStorage);
@@ -335,7 +396,13 @@ public:
     //--------------------------------------------------------------------------
     // UTILITY
     //--------------------------------------------------------------------------
+    /** Find the index of the last row whose time is less than or equal to
+    aT (0 if aT precedes the first row) with a binary search; the times must
+    be nondecreasing. */
     int findIndex(double aT) const override;
+    /** Same as findIndex(double) but the search starts at index aI: if aT is
+    in the interval at or right after aI the lookup takes constant time, and
+    otherwise a binary search is used. */
     int findIndex(int aI,double aT) const override;
     void findFrameRange(double aStartTime, double aEndTime, int& oStartFrame, int& oEndFrame) const;
     double resample(double aDT, int aDegree);
@@ -374,6 +441,8 @@ private:
     int writeColumnLabels(FILE *rFP) const;
     int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
     int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
+    int findIndexFrom(int aI,double aT) const;
+    int interpolate(int aI,double aT,int aN,double **rData) const;
 
 //=============================================================================
 };  // END of class Storage
@@ -0,0 +1,325 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  StreamingStorage.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingStorage.h"
+#include "FileAdapter.h"
+#include "IO.h"
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace OpenSim;
+
+namespace {
+    const std::string delimiters{" \t"};
+
+    bool isBlank(const char* begin, const char* end) {
+        for (; begin != end; ++begin)
+            if (*begin != ' ' && *begin != '\t') return false;
+        return true;
+    }
+}
+
+//=============================================================================
+// CONSTRUCTOR(S)
+//=============================================================================
+StreamingStorage::StreamingStorage(const std::string& fileName) :
+        StorageInterface(fileName) {
+    try {
+        _file = std::make_shared<const MemoryMappedFile>(fileName);
+    } catch (const std::exception& x) {
+        OPENSIM_THROW(Exception, "StreamingStorage: Failed to open file '" +
+                fileName + "'. " + x.what());
+    }
+    setName(fileName);
+    indexFile();
+    log_info("StreamingStorage: indexed data file = {} (nr={} nc={})",
+            fileName, getSize(), _columnLabels.getSize());
+}
+
+StreamingStorage::~StreamingStorage() = default;
+
+void StreamingStorage::indexFile() {
+    const char* const data = _file->getData();
+    const char* const end = data + _file->getSize();
+    const std::string& fileName = _file->getFileName();
+
+    // Lines are [begin, lineEnd); next is the start of the following line.
+    const char* begin = data;
+    auto nextLine = [&](const char*& lineEnd) {
+        const char* newline = static_cast<const char*>(
+                std::memchr(begin, '\n', end - begin));
+        lineEnd = newline ? newline : end;
+        const char* next = newline ? newline + 1 : end;
+        if (lineEnd != begin && *(lineEnd - 1) == '\r') --lineEnd;
+        return next;
+    };
+
+    // HEADER
+    bool foundEndHeader = false;
+    while (begin != end) {
+        const char* lineEnd;
+        const char* next = nextLine(lineEnd);
+        std::string line(begin, lineEnd);
+        begin = next;
+        IO::TrimLeadingWhitespace(line);
+        IO::TrimTrailingWhitespace(line);
+        if (line == "endheader") {
+            foundEndHeader = true;
+            break;
+        }
+        const std::size_t delim = line.find_first_of(" \t=");
+        const std::string key = line.substr(0, delim);
+        const std::size_t restidx = line.find_first_not_of(" \t=", delim);
+        const std::string rest =
+                (restidx == std::string::npos) ? "" : line.substr(restidx);
+        if (key == "inDegrees") {
+            const std::string lower = IO::Lowercase(rest);
+            _inDegrees = (lower == "yes" || lower == "y");
+        } else if (line == "Angles are in degrees.") {
+            _inDegrees = true;
+        }
+    }
+    OPENSIM_THROW_IF(!foundEndHeader, Exception,
+            "StreamingStorage: no 'endheader' line found in file '{}'.",
+            fileName);
+
+    // COLUMN LABELS (after any blank lines)
+    const char* lineEnd = begin;
+    while (begin != end) {
+        const char* next = nextLine(lineEnd);
+        if (!isBlank(begin, lineEnd)) break;
+        begin = next;
+    }
+    OPENSIM_THROW_IF(begin == end, Exception,
+            "StreamingStorage: no column labels found in file '{}'.",
+            fileName);
+    for (const auto& label :
+            FileAdapter::tokenize(std::string(begin, lineEnd), delimiters)) {
+        if (!label.empty()) _columnLabels.append(label);
+    }
+    OPENSIM_THROW_IF(_columnLabels.getSize() == 0 ||
+                    IO::Lowercase(_columnLabels[0]) != "time",
+            Exception,
+            "StreamingStorage: expected the first column of file '{}' to be "
+            "'time'.",
+            fileName);
+    begin = nextLine(lineEnd);
+
+    // ROWS
+    while (begin != end) {
+        const char* next = nextLine(lineEnd);
+        if (!isBlank(begin, lineEnd)) _rowOffsets.push_back(begin - data);
+        begin = next;
+    }
+
+    _y1.ensureCapacity(_columnLabels.getSize() - 1);
+    _y2.ensureCapacity(_columnLabels.getSize() - 1);
+}
+
+//=============================================================================
+// PARSING
+//=============================================================================
+void StreamingStorage::getRowExtent(
+        int i, const char*& begin, const char*& end) const {
+    const char* const data = _file->getData();
+    const char* const fileEnd = data + _file->getSize();
+    begin = data + _rowOffsets[i];
+    end = static_cast<const char*>(std::memchr(begin, '\n', fileEnd - begin));
+    if (!end) end = fileEnd;
+    if (end != begin && *(end - 1) == '\r') --end;
+}
+
+double StreamingStorage::parseTime(int i) const {
+    const char* begin;
+    const char* end;
+    getRowExtent(i, begin, end);
+    while (begin != end && (*begin == ' ' || *begin == '\t')) ++begin;
+    return FileAdapter::parseDouble(
+            begin, FileAdapter::findDelimiter(begin, end, delimiters));
+}
+
+double StreamingStorage::parseRow(int i, Array<double>& rData) const {
+    const char* begin;
+    const char* end;
+    getRowExtent(i, begin, end);
+    rData.setSize(0);
+    double time = SimTK::NaN;
+    bool first = true;
+    while (begin != end) {
+        const char* tokenEnd =
+                FileAdapter::findDelimiter(begin, end, delimiters);
+        if (tokenEnd != begin) {
+            const double value = FileAdapter::parseDouble(begin, tokenEnd);
+            if (first) time = value;
+            else rData.append(value);
+            first = false;
+        }
+        begin = (tokenEnd == end) ? end : tokenEnd + 1;
+    }
+    return time;
+}
+
+//=============================================================================
+// GET
+//=============================================================================
+StateVector* StreamingStorage::getStateVector(int aTimeIndex) const {
+    if (aTimeIndex < 0 || aTimeIndex >= getSize()) return nullptr;
+    if (aTimeIndex != _rowIndex) {
+        _row.setTime(parseRow(aTimeIndex, _row.getData()));
+        _rowIndex = aTimeIndex;
+    }
+    return &_row;
+}
+
+StateVector* StreamingStorage::getLastStateVector() const {
+    return getStateVector(getSize() - 1);
+}
+
+double StreamingStorage::getFirstTime() const {
+    if (getSize() <= 0) return SimTK::NaN;
+    return parseTime(0);
+}
+
+double StreamingStorage::getLastTime() const {
+    if (getSize() <= 0) return SimTK::NaN;
+    return parseTime(getSize() - 1);
+}
+
+int StreamingStorage::getTimeColumn(
+        Array<double>& rTimes, int aStateIndex) const {
+    rTimes.setSize(0);
+    if (getSize() <= 0) return 0;
+    if (aStateIndex < 0) {
+        rTimes.ensureCapacity(getSize());
+        for (int i = 0; i < getSize(); ++i) rTimes.append(parseTime(i));
+    } else {
+        // Only rows that have a value for the given state.
+        for (int i = 0; i < getSize(); ++i) {
+            const double time = parseRow(i, _y1);
+            if (aStateIndex < _y1.getSize()) rTimes.append(time);
+        }
+    }
+    return rTimes.getSize();
+}
+
+void StreamingStorage::getTimeColumnWithStartTime(
+        Array<double>& rTimes, double startTime) const {
+    if (getSize() <= 0) return;
+    for (int i = findIndex(startTime); i < getSize(); ++i)
+        rTimes.append(parseTime(i));
+}
+
+int StreamingStorage::getDataAtTime(
+        double aTime, int aN, Array<double>& rData) const {
+    const int i = findIndex(_lastI, aTime);
+    if (i < 0) return 0;
+
+    // CHECK FOR i AT END POINTS
+    int i1 = i, i2 = i + 1;
+    if (i2 == getSize()) {
+        i1--; if (i1 < 0) i1 = 0;
+        i2--; if (i2 < 0) i2 = 0;
+    }
+    const double t1 = parseRow(i1, _y1);
+    const double t2 = parseRow(i2, _y2);
+
+    int ns = std::min(_y1.getSize(), _y2.getSize());
+    if (aN < ns) ns = aN;
+    const double den = t2 - t1;
+    const double pct = (den < SimTK::Eps) ? 0.0 : (aTime - t1) / den;
+    for (int k = 0; k < ns; ++k) {
+        rData[k] = (pct == 0.0) ? _y1[k] : _y1[k] + pct * (_y2[k] - _y1[k]);
+    }
+    return ns;
+}
+
+void StreamingStorage::getDataColumn(const std::string& columnName,
+        Array<double>& data, double startTime) {
+    if (getSize() <= 0) return;
+    // The time column is not a state.
+    const int stateIndex = _columnLabels.findIndex(columnName) - 1;
+    if (stateIndex < 0) return;
+    for (int i = findIndex(startTime); i < getSize(); ++i) {
+        parseRow(i, _y1);
+        data.append(stateIndex < _y1.getSize() ? _y1[stateIndex]
+                                               : SimTK::NaN);
+    }
+}
+
+//=============================================================================
+// UTILITY
+//=============================================================================
+int StreamingStorage::findIndex(double aT) const {
+    if (getSize() <= 0) return -1;
+    return findIndex(getSize() - 1, aT);
+}
+
+int StreamingStorage::findIndex(int aI, double aT) const {
+    // Same as Storage::findIndex(): the interval at or right after aI is
+    // checked first; otherwise, the bounding rows are found with a binary
+    // search.
+    const int size = getSize();
+    if (size <= 0) return -1;
+    if (aI >= size || aI < 0) aI = 0;
+
+    int lo, hi;
+    if (parseTime(aI) > aT) {
+        lo = 0;
+        hi = aI;
+    } else {
+        if (aI + 1 >= size || aT < parseTime(aI + 1)) return _lastI = aI;
+        if (aI + 2 >= size || aT < parseTime(aI + 2)) return _lastI = aI + 1;
+        lo = aI + 3;
+        hi = size;
+    }
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (aT < parseTime(mid)) hi = mid;
+        else lo = mid + 1;
+    }
+    _lastI = std::max(lo - 1, 0);
+    return _lastI;
+}
+
+//=============================================================================
+// READ-ONLY
+//=============================================================================
+void StreamingStorage::throwReadOnly() const {
+    OPENSIM_THROW_FRMOBJ(Exception, "StreamingStorage is read-only.");
+}
+
+int StreamingStorage::append(const StateVector&, bool) { throwReadOnly(); }
+int StreamingStorage::append(const Array<StateVector>&) { throwReadOnly(); }
+int StreamingStorage::append(double, int, const double*, bool) {
+    throwReadOnly();
+}
+int StreamingStorage::append(double, const SimTK::Vector&, bool) {
+    throwReadOnly();
+}
+int StreamingStorage::store(int, double, int, const double*) {
+    throwReadOnly();
+}
+void StreamingStorage::setOutputFileName(const std::string&) {
+    throwReadOnly();
+}
@@ -0,0 +1,143 @@
+#ifndef OPENSIM_STREAMING_STORAGE_H_
+#define OPENSIM_STREAMING_STORAGE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  StreamingStorage.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StorageInterface.h"
+#include "StateVector.h"
+
+#include <memory>
+#include <vector>
+
+namespace OpenSim {
+
+class MemoryMappedFile;
+
+/** A read-only StorageInterface for large .sto and .mot files (in the
+format written by Storage) whose rows are parsed on demand.
+
+The file is mapped into memory (see MemoryMappedFile) and the header and
+column labels are parsed when the object is constructed. Constructing the
+object also records where each row begins in the file, but the rows
+themselves are only parsed when they are accessed. As a result, the memory
+used by a StreamingStorage does not depend on the number of columns, and a
+sequential pass through the file (e.g., stepping through a states file in
+time order) reads each row about once.
+
+Unlike Storage, rows are not kept: the StateVector returned by
+getStateVector() is owned by this object and is overwritten by the next call
+to getStateVector() or getLastStateVector(). Copy the StateVector if it must
+outlive the next access. Methods that would modify the data (append(),
+store(), setOutputFileName()) throw an Exception.
+
+The first column must be the time column. SIMM motion files without a time
+column are not supported; read them with Storage.
+
+@code
+StreamingStorage states("large_states.sto");
+Array<double> y(0.0, states.getColumnLabels().getSize() - 1);
+for (int i = 0; i < states.getSize(); ++i) {
+    const StateVector& row = *states.getStateVector(i);
+    // ... use row.getTime() and row.getData() ...
+}
+states.getDataAtTime(0.5, y.getSize(), y); // linearly interpolated
+@endcode */
+class OSIMCOMMON_API StreamingStorage : public StorageInterface {
+OpenSim_DECLARE_CONCRETE_OBJECT(StreamingStorage, StorageInterface);
+
+public:
+    /** Map the file and index its rows.
+    @throws Exception if the file cannot be opened, has no header, or its
+    first column is not time. */
+    explicit StreamingStorage(const std::string& fileName);
+
+    StreamingStorage(const StreamingStorage&) = default;
+    StreamingStorage& operator=(const StreamingStorage&) = default;
+    ~StreamingStorage() override;
+
+    /** The column labels, including the time column. */
+    const Array<std::string>& getColumnLabels() const { return _columnLabels; }
+    /** Whether the header specifies that rotations are in degrees. */
+    bool isInDegrees() const { return _inDegrees; }
+
+    // StorageInterface.
+    int getSize() const override { return (int)_rowOffsets.size(); }
+    /** The returned StateVector is overwritten by the next call. */
+    StateVector* getStateVector(int aTimeIndex) const override;
+    StateVector* getLastStateVector() const override;
+    double getFirstTime() const override;
+    double getLastTime() const override;
+    int getTimeColumn(Array<double>& rTimes,
+            int aStateIndex = -1) const override;
+    void getTimeColumnWithStartTime(Array<double>& rTimes,
+            double startTime = 0.0) const override;
+    /** Linearly interpolate the first aN states at time aT (as
+    Storage::getDataAtTime() does). The search for aT starts at the row found
+    by the previous lookup, so lookups at increasing times take constant
+    time. */
+    int getDataAtTime(double aTime, int aN,
+            Array<double>& rData) const override;
+    void getDataColumn(const std::string& columnName, Array<double>& data,
+            double startTime = 0.0) override;
+
+    int append(const StateVector& aVec,
+            bool aCheckForDuplicateTime = true) override;
+    int append(const Array<StateVector>& aArray) override;
+    int append(double aT, int aN, const double* aY,
+            bool aCheckForDuplicateTime = true) override;
+    int append(double aT, const SimTK::Vector& aY,
+            bool aCheckForDuplicateTime = true) override;
+    int store(int aStep, double aT, int aN, const double* aY) override;
+
+    int findIndex(double aT) const override;
+    int findIndex(int aI, double aT) const override;
+
+    void setOutputFileName(const std::string& aFileName) override;
+
+private:
+    /** Parse the header and the column labels, and record the offset of each
+    row. */
+    void indexFile();
+    /** The characters of row i, without the line ending. */
+    void getRowExtent(int i, const char*& begin, const char*& end) const;
+    double parseTime(int i) const;
+    /** Parse the states (all columns except time) of row i into rData. */
+    double parseRow(int i, Array<double>& rData) const;
+    [[noreturn]] void throwReadOnly() const;
+
+    std::shared_ptr<const MemoryMappedFile> _file;
+    Array<std::string> _columnLabels;
+    bool _inDegrees = false;
+    std::vector<std::size_t> _rowOffsets;
+
+    // Scratch space for the row returned by getStateVector() and the rows
+    // used for interpolation.
+    mutable StateVector _row;
+    mutable int _rowIndex = -1;
+    mutable Array<double> _y1;
+    mutable Array<double> _y2;
+    mutable int _lastI = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STREAMING_STORAGE_H_
@@ -1,7 +1,10 @@
 #include "TRCFileAdapter.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <fstream>
 #include <iomanip>
+#include <iterator>
+#include <spdlog/fmt/fmt.h>
 
 namespace OpenSim {
 
@@ -37,6 +40,12 @@ TRCFileAdapter::write(const TimeSeriesTableVec3& table,
 
 TRCFileAdapter::OutputTables
 TRCFileAdapter::extendRead(const std::string& fileName) const {
+    return extendReadFiltered(fileName, TableReadFilter{});
+}
+
+TRCFileAdapter::OutputTables
+TRCFileAdapter::extendReadFiltered(const std::string& fileName,
+        const TableReadFilter& filter) const {
 
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
@@ -167,11 +176,14 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     }
     
     const size_t expected{ column_labels.size() * 3 + 2 };
+    // Only the markers kept by the filter are parsed and stored.
+    const auto kept_markers = filter.findColumns(column_labels, fileName);
+    const int num_markers_kept = static_cast<int>(kept_markers.size());
     // Will first store data in a SimTK::Matrix to avoid expensive calls 
     // to the table's appendRow() which reallocates and copies the whole table.
     int rowNumber = 0;
     int last_size = 1024; 
-    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, static_cast<int>(num_markers_expected)};
+    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, num_markers_kept};
     std::vector<double> times;
     times.resize(last_size);
 
@@ -184,12 +196,21 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
                          expected,
                          row.size());
 
+        // Column 1 is time. Frames outside of the filter's time range are
+        // skipped without parsing the marker coordinates.
+        const double time = std::stod(row.at(1));
+        if (time > filter.finalTime) break;
+        if (!filter.keepsTime(time)) {
+            row = nextLine();
+            ++line_num;
+            continue;
+        }
+
         // Columns 2 till the end are data.
         TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected), 
-                       SimTK::Vec3(SimTK::NaN)};
-        int ind{0};
-        for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
+            row_vector{num_markers_kept, SimTK::Vec3(SimTK::NaN)};
+        for (int ind = 0; ind < num_markers_kept; ++ind) {
+            const std::size_t c = 2 + 3 * kept_markers[ind];
             //only if each component is specified read process as a Vec3
             if ( !(row.at(c).empty() || row.at(c + 1).empty() 
                                      || row.at(c + 2).empty()) ) {
@@ -197,18 +218,16 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
                                                std::stod(row.at(c + 1)),
                                                std::stod(row.at(c + 2)) };
             } // otherwise the value will remain NaN (default)
-            ++ind;
         }
         markerData[rowNumber] = row_vector;
-        // Column 1 is time.
-        times[rowNumber] = std::stod(row.at(1));
+        times[rowNumber] = time;
         rowNumber++;
         if (rowNumber== last_size) {
             // resize all Data/Matrices, double the size  while keeping data
             int newSize = last_size * 2;
             times.resize(newSize);
             // Repeat for Data matrices in use
-            markerData.resizeKeep(newSize, (int)num_markers_expected);
+            markerData.resizeKeep(newSize, num_markers_kept);
             last_size = newSize;
         }
         row = nextLine();
@@ -216,12 +235,12 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     }
     // Trim Matrices in use to actual data and move into tables
     times.resize(rowNumber);
-    markerData.resizeKeep(rowNumber, (int)num_markers_expected);
+    markerData.resizeKeep(rowNumber, num_markers_kept);
 
     // Set the column labels of the table.
     std::vector<std::string> labels{};
-    for(const auto& cl : column_labels)
-            labels.push_back(SimTK::Value<std::string>{cl});
+    for(const auto& c : kept_markers)
+            labels.push_back(SimTK::Value<std::string>{column_labels[c]});
     auto table = std::make_shared<TimeSeriesTableVec3>(
             times, markerData, labels);
     table->updTableMetaData() = metaData;
@@ -357,22 +376,32 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     // Empty line.
     out_stream << "\n";
 
-    // Data rows.
-    for(unsigned row = 0; row < table->getNumRows(); ++row) {
-        constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
-        out_stream << row + 1                           << _delimiterWrite
-                   << std::setprecision(prec) 
-                   << table->getIndependentColumn()[row] << _delimiterWrite;
-        const auto& row_r = table->getRowAtIndex(row);
-        for(unsigned col = 0; col < table->getNumColumns(); ++col) {
-            const auto& elt = row_r[col];
-            out_stream << std::setprecision(prec) 
-                       << elt[0] << _delimiterWrite
-                       << elt[1] << _delimiterWrite
-                       << elt[2] << _delimiterWrite;
-        }
-        out_stream << "\n";
-    }
+    // Data rows. Blocks of rows are formatted concurrently and written to the
+    // file in large pieces. The numbers have the same text as std::ostream
+    // with std::setprecision(prec).
+    constexpr auto prec = std::numeric_limits<double>::digits10 + 1;
+    const auto& times = table->getIndependentColumn();
+    const auto& matrix = table->getMatrix();
+    const int numCols = matrix.ncol();
+    formatRowsInParallel(matrix.nrow(),
+            [&](int row, std::string& text) {
+                auto out = std::back_inserter(text);
+                fmt::format_to(out, "{}{}{:.{}g}{}", row + 1, _delimiterWrite,
+                        times[row], prec, _delimiterWrite);
+                for(int col = 0; col < numCols; ++col) {
+                    const auto& elt = matrix(row, col);
+                    for(int i = 0; i < 3; ++i)
+                        fmt::format_to(out, "{:.{}g}{}", elt[i], prec,
+                                _delimiterWrite);
+                }
+                text += '\n';
+            },
+            [&](const std::string& text) {
+                out_stream.write(text.data(),
+                                 static_cast<std::streamsize>(text.size()));
+            });
+    OPENSIM_THROW_IF(!out_stream.good(), Exception,
+                     "Could not write to file '{}'.", fileName);
 }
 
 }
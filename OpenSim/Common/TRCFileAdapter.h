@@ -158,6 +158,12 @@ protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
 
+    /** Read only the markers and frames that the filter keeps. The marker
+    coordinates of the other frames are not parsed, and reading stops at the
+    first frame after the filter's final time.                                */
+    OutputTables extendReadFiltered(const std::string& filename,
+            const TableReadFilter& filter) const override;
+
     /** Implementation of the write functionality.                            */
     void extendWrite(const InputTables& tables, 
                      const std::string& filename) const override;
@@ -29,6 +29,8 @@
 #include "PiecewiseLinearFunction.h"
 #include "Signal.h"
 #include "Storage.h"
+#include <algorithm>
+#include <cmath>
 
 using namespace OpenSim;
 
@@ -51,23 +53,12 @@ bool TableUtilities::isInDegrees(const TimeSeriesTable& table) {
     return inDegrees == "yes";
 }
 
-int TableUtilities::findStateLabelIndex(
-        const Array<std::string>& labels, const std::string& desired) {
-    return findStateLabelIndexInternal(
-            labels.get(), labels.get() + labels.getSize(), desired);
-}
-
-int TableUtilities::findStateLabelIndex(
-        const std::vector<std::string>& labels, const std::string& desired) {
-    return findStateLabelIndexInternal(
-            labels.data(), labels.data() + labels.size(), desired);
-}
-
-int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
-        const std::string* end, const std::string& desired) {
+template <typename FindFunction>
+int TableUtilities::findStateLabelIndexInternal(
+        const std::string& desired, FindFunction find) {
 
-    auto found = std::find(begin, end, desired);
-    if (found != end) return (int)std::distance(begin, found);
+    int found = find(desired);
+    if (found != -1) return found;
 
     // 4.0 and its beta versions differ slightly in the absolute path but
     // the <joint>/<coordinate>/value (or speed) will be common to both.
@@ -75,12 +66,12 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
     // must be common to the state variable (path) name and column label.
     std::string shortPath = desired;
     std::string::size_type front = shortPath.find('/');
-    while (found == end && front < std::string::npos) {
+    while (found == -1 && front < std::string::npos) {
         shortPath = shortPath.substr(front + 1, desired.length());
-        found = std::find(begin, end, shortPath);
+        found = find(shortPath);
         front = shortPath.find('/');
     }
-    if (found != end) return (int)std::distance(begin, found);
+    if (found != -1) return found;
 
     // Assume column labels follow pre-v4.0 state variable labeling.
     // Redo search with what the pre-v4.0 label might have been.
@@ -89,8 +80,8 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
     std::string::size_type back = desired.rfind('/');
     std::string prefix = desired.substr(0, back);
     std::string shortName = desired.substr(back + 1, desired.length() - back);
-    found = std::find(begin, end, shortName);
-    if (found != end) return (int)std::distance(begin, found);
+    found = find(shortName);
+    if (found != -1) return found;
 
     // If that didn't work, specifically check for coordinate state names
     // (<coord_name>/value and <coord_name>/speed) and muscle state names
@@ -99,26 +90,67 @@ int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
         // pre-v4.0 did not have "/value" so remove it if here
         back = prefix.rfind('/');
         shortName = prefix.substr(back + 1, prefix.length());
-        found = std::find(begin, end, shortName);
+        found = find(shortName);
     } else if (shortName == "speed") {
         // replace "/speed" (the v4.0 labeling for speeds) with "_u"
         back = prefix.rfind('/');
         shortName = prefix.substr(back + 1, prefix.length() - back) + "_u";
-        found = std::find(begin, end, shortName);
+        found = find(shortName);
     } else if (back < desired.length()) {
         // try replacing the '/' with '.' in the last segment
         shortName = desired;
         shortName.replace(back, 1, ".");
         back = shortName.rfind('/');
         shortName = shortName.substr(back + 1, shortName.length() - back);
-        found = std::find(begin, end, shortName);
+        found = find(shortName);
     }
-    if (found != end) return (int)std::distance(begin, found);
+    if (found != -1) return found;
 
     // If all of the above checks failed, return -1.
     return -1;
 }
 
+int TableUtilities::findStateLabelIndex(
+        const Array<std::string>& labels, const std::string& desired) {
+    return findStateLabelIndexInternal(
+            labels.get(), labels.get() + labels.getSize(), desired);
+}
+
+int TableUtilities::findStateLabelIndex(
+        const std::vector<std::string>& labels, const std::string& desired) {
+    return findStateLabelIndexInternal(
+            labels.data(), labels.data() + labels.size(), desired);
+}
+
+TableUtilities::LabelIndexMap TableUtilities::createLabelIndexMap(
+        const Array<std::string>& labels) {
+    LabelIndexMap labelIndices;
+    labelIndices.reserve(labels.getSize());
+    // emplace() keeps the first occurrence, as std::find() would find.
+    for (int i = 0; i < labels.getSize(); ++i) {
+        labelIndices.emplace(labels[i], i);
+    }
+    return labelIndices;
+}
+
+int TableUtilities::findStateLabelIndex(
+        const LabelIndexMap& labelIndices, const std::string& desired) {
+    return findStateLabelIndexInternal(desired,
+            [&labelIndices](const std::string& label) {
+                const auto it = labelIndices.find(label);
+                return it == labelIndices.end() ? -1 : it->second;
+            });
+}
+
+int TableUtilities::findStateLabelIndexInternal(const std::string* begin,
+        const std::string* end, const std::string& desired) {
+    return findStateLabelIndexInternal(
+            desired, [begin, end](const std::string& label) {
+                const auto found = std::find(begin, end, label);
+                return found == end ? -1 : (int)std::distance(begin, found);
+            });
+}
+
 void TableUtilities::filterLowpass(
         TimeSeriesTable& table, double cutoffFreq, bool padData) {
     OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
@@ -146,15 +178,26 @@ void TableUtilities::filterLowpass(
     if (dtAvg - dtMin > SimTK::Eps) {
         table = resampleWithInterval(table, dtMin);
     }
-
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
-    }
+    const int numFilteredRows = (int)table.getNumRows();
+
+    // The columns are filtered in place and in parallel. The matrix is
+    // column-major, so each thread filters a contiguous range of columns,
+    // several columns at a time, without allocating memory.
+    const int numColumns = (int)table.getNumColumns();
+    if (numColumns == 0) return;
+    SimTK::Matrix& matrix = table.updMatrix();
+    double* data = matrix.updCol(0).updContiguousScalarData();
+    const int numThreads = std::max(1,
+            std::min(getMaxNumThreads(), numColumns));
+    parallelFor(numThreads, [&](int ithread) {
+        const int begin = ithread * numColumns / numThreads;
+        const int end = (ithread + 1) * numColumns / numThreads;
+        if (end > begin) {
+            Signal::LowpassIIR(dtMin, cutoffFreq, numFilteredRows,
+                    end - begin, numFilteredRows,
+                    data + (size_t)begin * numFilteredRows);
+        }
+    }, numThreads);
 }
 
 void TableUtilities::pad(
@@ -166,22 +209,141 @@ void TableUtilities::pad(
             "got {}.",
             numRowsToPrependAndAppend);
 
-    table._indData = Signal::Pad(numRowsToPrependAndAppend,
+    std::vector<double> newIndData = Signal::Pad(numRowsToPrependAndAppend,
             (int)table._indData.size(), table._indData.data());
 
-    size_t numColumns = table.getNumColumns();
-
-    // _indData.size() is now the number of rows after padding.
-    SimTK::Matrix newMatrix((int)table._indData.size(), (int)numColumns);
-    for (size_t icol = 0; icol < numColumns; ++icol) {
-        SimTK::Vector column = table.getDependentColumnAtIndex(icol);
-        const std::vector<double> newColumn =
-                Signal::Pad(numRowsToPrependAndAppend, column.size(),
-                        column.getContiguousScalarData());
-        newMatrix.updCol((int)icol) =
-                SimTK::Vector((int)newColumn.size(), newColumn.data(), true);
-    }
+    const int numColumns = (int)table.getNumColumns();
+    const int numRows = (int)table.getNumRows();
+
+    // Each column is padded straight into the new matrix (whose columns are
+    // contiguous), in parallel.
+    SimTK::Matrix newMatrix((int)newIndData.size(), numColumns);
+    const SimTK::Matrix& matrix = table.getMatrix();
+    parallelFor(numColumns, [&](int icol) {
+        Signal::Pad(numRowsToPrependAndAppend, numRows,
+                matrix.col(icol).getContiguousScalarData(),
+                newMatrix.updCol(icol).updContiguousScalarData());
+    });
     table.updMatrix() = newMatrix;
+    table._indData = std::move(newIndData);
+}
+
+namespace {
+// Differentiate y(t) in place; see TableUtilities::differentiate().
+void differentiateInPlace(int n, const double* t, double* y) {
+    // y[i - 1] has already been overwritten when y[i] is computed, so keep
+    // its original value.
+    double previous = y[0];
+    y[0] = (y[1] - y[0]) / (t[1] - t[0]);
+    for (int i = 1; i < n - 1; ++i) {
+        const double h1 = t[i] - t[i - 1];
+        const double h2 = t[i + 1] - t[i];
+        const double current = y[i];
+        y[i] = -h2 / (h1 * (h1 + h2)) * previous +
+               (h2 - h1) / (h1 * h2) * current +
+               h1 / (h2 * (h1 + h2)) * y[i + 1];
+        previous = current;
+    }
+    y[n - 1] = (y[n - 1] - previous) / (t[n - 1] - t[n - 2]);
+}
+} // namespace
+
+TableUtilities::ColumnStatistics TableUtilities::computeColumnStatistics(
+        const TimeSeriesTable& table) {
+    const int numColumns = (int)table.getNumColumns();
+    const int numRows = (int)table.getNumRows();
+    const auto& time = table.getIndependentColumn();
+    const SimTK::Matrix& matrix = table.getMatrix();
+
+    ColumnStatistics stats;
+    for (auto* v : {&stats.mean, &stats.rms, &stats.min, &stats.max,
+                 &stats.peak, &stats.area}) {
+        v->assign(numColumns, SimTK::NaN);
+    }
+    parallelFor(numColumns, [&](int icol) {
+        const double* y = matrix.col(icol).getContiguousScalarData();
+        int count = 0;
+        double sum = 0, sumSquares = 0, area = 0;
+        double min = SimTK::Infinity, max = -SimTK::Infinity;
+        for (int i = 0; i < numRows; ++i) {
+            if (SimTK::isNaN(y[i])) continue;
+            ++count;
+            sum += y[i];
+            sumSquares += y[i] * y[i];
+            min = std::min(min, y[i]);
+            max = std::max(max, y[i]);
+            if (i > 0 && !SimTK::isNaN(y[i - 1])) {
+                area += 0.5 * (y[i] + y[i - 1]) * (time[i] - time[i - 1]);
+            }
+        }
+        if (count == 0) return;
+        stats.mean[icol] = sum / count;
+        stats.rms[icol] = std::sqrt(sumSquares / count);
+        stats.min[icol] = min;
+        stats.max[icol] = max;
+        stats.peak[icol] = std::max(std::abs(min), std::abs(max));
+        stats.area[icol] = area;
+    });
+    return stats;
+}
+
+void TableUtilities::differentiate(TimeSeriesTable& table) {
+    const int numRows = (int)table.getNumRows();
+    OPENSIM_THROW_IF(numRows < 2, Exception,
+            "Expected at least 2 rows to differentiate, but got {} rows.",
+            numRows);
+    const double* time = table.getIndependentColumn().data();
+    SimTK::Matrix& matrix = table.updMatrix();
+    parallelFor((int)table.getNumColumns(), [&](int icol) {
+        differentiateInPlace(
+                numRows, time, matrix.updCol(icol).updContiguousScalarData());
+    });
+}
+
+void TableUtilities::filterLowpassAndDifferentiate(TimeSeriesTable& table,
+        double cutoffFreq, int derivativeOrder, bool padData) {
+    OPENSIM_THROW_IF(cutoffFreq < 0, Exception,
+            "Cutoff frequency must be non-negative; got {}.", cutoffFreq);
+    OPENSIM_THROW_IF(derivativeOrder < 0 || derivativeOrder > 2, Exception,
+            "Expected a derivative order of 0, 1 or 2, but got {}.",
+            derivativeOrder);
+    const int numRows = (int)table.getNumRows();
+    OPENSIM_THROW_IF(numRows < 4, Exception,
+            "Expected at least 4 rows to filter, but got {} rows.", numRows);
+
+    const auto& time = table.getIndependentColumn();
+    double dtMin = SimTK::Infinity;
+    for (int irow = 1; irow < numRows; ++irow) {
+        dtMin = std::min(dtMin, time[irow] - time[irow - 1]);
+    }
+    const double dtAvg = (time.back() - time.front()) / (numRows - 1);
+    OPENSIM_THROW_IF(dtMin < SimTK::Eps || dtAvg - dtMin > SimTK::Eps,
+            Exception, "Expected a uniform sampling interval.");
+
+    const int numPad = padData ? numRows / 2 : 0;
+    const int numPadded = numRows + 2 * numPad;
+    const std::vector<double> paddedTime =
+            Signal::Pad(numPad, numRows, time.data());
+
+    SimTK::Matrix& matrix = table.updMatrix();
+    const int numColumns = (int)table.getNumColumns();
+    const int numThreads = std::max(1,
+            std::min(getMaxNumThreads(), numColumns));
+    // Each thread reuses its own workspace for every numThreads-th column.
+    parallelFor(numThreads, [&](int ithread) {
+        std::vector<double> padded(numPadded);
+        for (int icol = ithread; icol < numColumns; icol += numThreads) {
+            double* column = matrix.updCol(icol).updContiguousScalarData();
+            Signal::Pad(numPad, numRows, column, padded.data());
+            Signal::LowpassIIR(
+                    dtMin, cutoffFreq, numPadded, 1, numPadded, padded.data());
+            for (int order = 0; order < derivativeOrder; ++order) {
+                differentiateInPlace(
+                        numPadded, paddedTime.data(), padded.data());
+            }
+            std::copy_n(padded.data() + numPad, numRows, column);
+        }
+    }, numThreads);
 }
 
 namespace {
@@ -240,24 +402,207 @@ TimeSeriesTable TableUtilities::resample(
                 itime, itime - 1, newTime[itime], newTime[itime - 1]);
     }
 
+    // Fill the new data one column at a time.
+    const int numTimes = (int)newTime.size();
+    std::unique_ptr<FunctionSet> functions =
+            createFunctionSet<FunctionType>(in);
+    SimTK::Matrix data(numTimes, functions->getSize());
+    SimTK::Vector curTime(1);
+    for (int icol = 0; icol < functions->getSize(); ++icol) {
+        const Function& function = functions->get(icol);
+        for (int itime = 0; itime < numTimes; ++itime) {
+            curTime[0] = newTime[itime];
+            data(itime, icol) = function.calcValue(curTime);
+        }
+    }
+
     // Copy over metadata.
     TimeSeriesTable out = in;
-    for (int irow = (int)out.getNumRows() - 1; irow >= 0; --irow) {
-        out.removeRowAtIndex(irow);
+    out.updMatrix() = data;
+    out._indData.resize(numTimes);
+    for (int itime = 0; itime < numTimes; ++itime) {
+        out._indData[itime] = newTime[itime];
     }
+    return out;
+}
 
-    std::unique_ptr<FunctionSet> functions =
-            createFunctionSet<FunctionType>(in);
-    SimTK::Vector curTime(1);
-    SimTK::RowVector row(functions->getSize());
-    for (int itime = 0; itime < (int)newTime.size(); ++itime) {
-        curTime[0] = newTime[itime];
-        for (int icol = 0; icol < functions->getSize(); ++icol) {
-            row(icol) = functions->get(icol).calcValue(curTime);
+namespace {
+/// The rows of the original table, and their weights, that are combined to
+/// obtain one row of a table resampled with resampleTable().
+struct InterpolationWeights {
+    int numRows = 0;
+    int rows[4];
+    double weights[4];
+    void add(int row, double weight) {
+        if (weight == 0) return;
+        for (int k = 0; k < numRows; ++k) {
+            if (rows[k] == row) {
+                weights[k] += weight;
+                return;
+            }
         }
-        // Not efficient!
-        out.appendRow(curTime[0], row);
+        rows[numRows] = row;
+        weights[numRows++] = weight;
     }
+};
+
+/// The new times must be nondecreasing, so the interval containing each new
+/// time is found by advancing from the previous interval.
+std::vector<InterpolationWeights> computeInterpolationWeights(
+        const std::vector<double>& time, const std::vector<double>& newTime,
+        TableUtilities::InterpolationMethod method) {
+    const int n = (int)time.size();
+    std::vector<InterpolationWeights> all(newTime.size());
+    int i = 0;
+    for (int k = 0; k < (int)newTime.size(); ++k) {
+        const double t = newTime[k];
+        while (i < n - 2 && time[i + 1] <= t) ++i;
+        InterpolationWeights& w = all[k];
+        const double h = time[i + 1] - time[i];
+        if (h <= 0) {
+            w.add(i, 1.0);
+            continue;
+        }
+        const double s = (t - time[i]) / h;
+        if (method == TableUtilities::InterpolationMethod::Linear) {
+            w.add(i, 1.0 - s);
+            w.add(i + 1, s);
+            continue;
+        }
+        // Cubic Hermite basis functions.
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        w.add(i, 2 * s3 - 3 * s2 + 1);
+        w.add(i + 1, -2 * s3 + 3 * s2);
+        // The slope at row r is (y[b] - y[a]) / (time[b] - time[a]).
+        auto addSlope = [&](int r, double basis) {
+            const int a = std::max(r - 1, 0);
+            const int b = std::min(r + 1, n - 1);
+            const double dt = time[b] - time[a];
+            if (dt <= 0) return;
+            w.add(b, basis * h / dt);
+            w.add(a, -basis * h / dt);
+        };
+        addSlope(i, s3 - 2 * s2 + s);
+        addSlope(i + 1, s3 - s2);
+    }
+    return all;
+}
+
+template <typename T>
+void applyInterpolationWeights(const SimTK::Matrix_<T>& in,
+        const std::vector<InterpolationWeights>& weights,
+        TableUtilities::InterpolationMethod, SimTK::Matrix_<T>& out) {
+    const int numTimes = (int)weights.size();
+    out.resize(numTimes, in.ncol());
+    for (int icol = 0; icol < in.ncol(); ++icol) {
+        const auto inCol = in.col(icol);
+        auto outCol = out.updCol(icol);
+        for (int k = 0; k < numTimes; ++k) {
+            const InterpolationWeights& w = weights[k];
+            T value = w.weights[0] * inCol[w.rows[0]];
+            for (int r = 1; r < w.numRows; ++r) {
+                value += w.weights[r] * inCol[w.rows[r]];
+            }
+            outCol[k] = value;
+        }
+    }
+}
+
+SimTK::Quaternion slerp(const SimTK::Quaternion& qa,
+        const SimTK::Quaternion& qb, double s) {
+    const SimTK::Vec4& a = qa;
+    SimTK::Vec4 b = qb;
+    double cosTheta = ~a * b;
+    // q and -q are the same rotation; take the shorter arc.
+    if (cosTheta < 0) {
+        b = -b;
+        cosTheta = -cosTheta;
+    }
+    if (cosTheta > 1 - SimTK::SqrtEps) {
+        return SimTK::Quaternion((1 - s) * a + s * b);
+    }
+    const double theta = std::acos(cosTheta);
+    const double sinTheta = std::sin(theta);
+    return SimTK::Quaternion(std::sin((1 - s) * theta) / sinTheta * a +
+                             std::sin(s * theta) / sinTheta * b);
+}
+
+void applyInterpolationWeights(const SimTK::Matrix_<SimTK::Quaternion>& in,
+        const std::vector<InterpolationWeights>& weights,
+        TableUtilities::InterpolationMethod method,
+        SimTK::Matrix_<SimTK::Quaternion>& out) {
+    OPENSIM_THROW_IF(method != TableUtilities::InterpolationMethod::Linear,
+            Exception, "Only linear interpolation (slerp) is supported for "
+                       "tables of quaternions.");
+    const int numTimes = (int)weights.size();
+    out.resize(numTimes, in.ncol());
+    for (int icol = 0; icol < in.ncol(); ++icol) {
+        const auto inCol = in.col(icol);
+        auto outCol = out.updCol(icol);
+        for (int k = 0; k < numTimes; ++k) {
+            // Linear weights are (1 - s) for the first row and s for the
+            // second.
+            const InterpolationWeights& w = weights[k];
+            if (w.numRows == 1) {
+                outCol[k] = inCol[w.rows[0]];
+            } else {
+                outCol[k] = slerp(inCol[w.rows[0]], inCol[w.rows[1]],
+                        w.weights[1]);
+            }
+        }
+    }
+}
+
+TimeSeriesTable resampleWithGCVSpline(
+        const TimeSeriesTable& in, const std::vector<double>& newTime) {
+    return TableUtilities::resample<std::vector<double>, GCVSpline>(
+            in, newTime);
+}
+
+template <typename T>
+TimeSeriesTable_<T> resampleWithGCVSpline(
+        const TimeSeriesTable_<T>&, const std::vector<double>&) {
+    OPENSIM_THROW(Exception, "GCVSpline interpolation is only supported for "
+                             "tables of doubles; flatten() the table first.");
+}
+} // namespace
+
+template <typename T>
+TimeSeriesTable_<T> TableUtilities::resampleTable(const TimeSeriesTable_<T>& in,
+        const std::vector<double>& newTime, InterpolationMethod method) {
+    if (method == InterpolationMethod::GCVSpline) {
+        return resampleWithGCVSpline(in, newTime);
+    }
+
+    const auto& time = in.getIndependentColumn();
+    OPENSIM_THROW_IF(time.size() < 2, Exception,
+            "Cannot resample if number of times is 0 or 1.");
+    if (!newTime.empty()) {
+        OPENSIM_THROW_IF(newTime.front() < time.front(), Exception,
+                "New initial time ({}) cannot be less than existing initial "
+                "time ({})",
+                newTime.front(), time.front());
+        OPENSIM_THROW_IF(newTime.back() > time.back(), Exception,
+                "New final time ({}) cannot be greater than existing final "
+                "time ({})",
+                newTime.back(), time.back());
+    }
+    for (int itime = 1; itime < (int)newTime.size(); ++itime) {
+        OPENSIM_THROW_IF(newTime[itime] < newTime[itime - 1], Exception,
+                "New times must be non-decreasing, but "
+                "time[{}] < time[{}] ({} < {}).",
+                itime, itime - 1, newTime[itime], newTime[itime - 1]);
+    }
+
+    const auto weights = computeInterpolationWeights(time, newTime, method);
+    SimTK::Matrix_<T> data;
+    applyInterpolationWeights(in.getMatrix(), weights, method, data);
+
+    // Copy over metadata.
+    TimeSeriesTable_<T> out = in;
+    out.updMatrix() = data;
+    out._indData = newTime;
     return out;
 }
 
@@ -313,6 +658,17 @@ TimeSeriesTable_<SimTK::Vec3> TableUtilities::convertRotationsToEulerAngles(
 }
 // Explicit template instantiations.
 namespace OpenSim {
+template OSIMCOMMON_API TimeSeriesTable TableUtilities::resampleTable<double>(
+        const TimeSeriesTable&, const std::vector<double>&,
+        InterpolationMethod);
+template OSIMCOMMON_API TimeSeriesTable_<SimTK::Vec3>
+TableUtilities::resampleTable<SimTK::Vec3>(const TimeSeriesTable_<SimTK::Vec3>&,
+        const std::vector<double>&, InterpolationMethod);
+template OSIMCOMMON_API TimeSeriesTable_<SimTK::Quaternion>
+TableUtilities::resampleTable<SimTK::Quaternion>(
+        const TimeSeriesTable_<SimTK::Quaternion>&, const std::vector<double>&,
+        InterpolationMethod);
+
 template OSIMCOMMON_API TimeSeriesTable TableUtilities::resample<SimTK::Vector, GCVSpline>(
         const TimeSeriesTable&, const SimTK::Vector&);
 template OSIMCOMMON_API TimeSeriesTable
@@ -28,11 +28,26 @@
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
 #include "osimCommonDLL.h"
+#include <unordered_map>
 
 namespace OpenSim {
 
 class OSIMCOMMON_API TableUtilities {
 public:
+    /// The interpolant used by resampleTable().
+    enum class InterpolationMethod {
+        /// Piecewise linear (spherical linear interpolation, i.e., slerp,
+        /// for quaternions).
+        Linear,
+        /// Piecewise cubic Hermite, with the slope at each original time
+        /// estimated by a central difference (a one-sided difference at
+        /// the first and last times).
+        CubicHermite,
+        /// A GCVSpline for each column, as in resample(); only for tables of
+        /// doubles.
+        GCVSpline
+    };
+
     /// Throws an exception if the same label appears more than once in the list
     /// of labels.
     /// @throws NonUniqueLabels
@@ -60,6 +75,20 @@ public:
     static int findStateLabelIndex(
             const std::vector<std::string>& labels, const std::string& desired);
 
+#ifndef SWIG
+    /// Map each label to the index of its first occurrence, for use with
+    /// findStateLabelIndex(const LabelIndexMap&, const std::string&).
+    using LabelIndexMap = std::unordered_map<std::string, int>;
+    static LabelIndexMap createLabelIndexMap(const Array<std::string>& labels);
+
+    /// The same as findStateLabelIndex(), but each of the label variants is
+    /// looked up in a map created with createLabelIndexMap() instead of by
+    /// scanning the labels. Use this to look up many labels in the same list;
+    /// the result is the same as that of findStateLabelIndex() for the list.
+    static int findStateLabelIndex(
+            const LabelIndexMap& labelIndices, const std::string& desired);
+#endif
+
     /// Lowpass filter the data in a TimeSeriesTable at a provided cutoff
     /// frequency. If padData is true, then the data is first padded with pad()
     /// using numRowsToPrependAndAppend = table.getNumRows() / 2.
@@ -73,6 +102,48 @@ public:
     /// numRowsToPrependAndAppend.
     static void pad(TimeSeriesTable& table, int numRowsToPrependAndAppend);
 
+    /// Summary statistics of the columns of a table (see
+    /// computeColumnStatistics()). Element i of each vector is for column i.
+    struct ColumnStatistics {
+        std::vector<double> mean;
+        /// Root mean square.
+        std::vector<double> rms;
+        std::vector<double> min;
+        std::vector<double> max;
+        /// Largest absolute value.
+        std::vector<double> peak;
+        /// Integral over time with the trapezoidal rule (as in
+        /// Storage::computeArea()).
+        std::vector<double> area;
+    };
+
+    /// Compute the statistics of every column in one pass over the data,
+    /// in parallel over the columns. NaN values are ignored (for the area,
+    /// so are the intervals that end at a NaN); the statistics of a column
+    /// without any finite values are NaN.
+    static ColumnStatistics computeColumnStatistics(
+            const TimeSeriesTable& table);
+
+    /// Replace each column with its derivative with respect to time, in
+    /// place and in parallel over the columns. The interior rows use a
+    /// second-order central difference (which accounts for non-uniform
+    /// sampling), and the first and last rows use one-sided differences.
+    /// @throws Exception if the table has fewer than 2 rows.
+    static void differentiate(TimeSeriesTable& table);
+
+    /// Lowpass filter and differentiate every column in a single pass, in
+    /// place and in parallel over the columns. Each column is padded (as
+    /// with pad(), using table.getNumRows() / 2 rows) into a workspace if
+    /// padData is true, filtered with Signal::LowpassIIR(), and then
+    /// differentiated derivativeOrder times (0, 1 or 2) as with
+    /// differentiate(). Unlike filterLowpass(), the padded rows are then
+    /// dropped, so the table keeps its times; with padding, the first and
+    /// last rows also get central differences.
+    /// @throws Exception if the sampling interval is not uniform (resample
+    /// the table first) or if the table has fewer than 4 rows.
+    static void filterLowpassAndDifferentiate(TimeSeriesTable& table,
+            double cutoffFreq, int derivativeOrder = 1, bool padData = true);
+
     /// Resample (interpolate) the table at the provided times. In general, a
     /// 5th-order GCVSpline is used as the interpolant; a lower order is used if
     /// the table has too few points for a 5th-order spline. Alternatively, you
@@ -85,6 +156,21 @@ public:
     static TimeSeriesTable resample(
             const TimeSeriesTable& in, const TimeVector& newTime);
 
+    /// Resample (interpolate) a table at the provided times. For each new
+    /// time, the interval of original times that contains it and the
+    /// interpolation weights are computed once, and then applied to all
+    /// columns, so the cost per element is a handful of multiply-adds. Tables
+    /// of double, SimTK::Vec3 and SimTK::Quaternion are supported; quaternions
+    /// are interpolated with slerp (InterpolationMethod::Linear only).
+    /// A NaN in the original data only affects the new times that use it.
+    /// The table metadata is copied.
+    /// @throws Exception for the same reasons as resample(), or if the method
+    /// does not support the element type.
+    template <typename T>
+    static TimeSeriesTable_<T> resampleTable(const TimeSeriesTable_<T>& in,
+            const std::vector<double>& newTime,
+            InterpolationMethod method = InterpolationMethod::Linear);
+
     /// Resample the table using the given time interval (using resample()).
     /// The new final time is not guaranteed to match the original final
     /// time.
@@ -107,6 +193,10 @@ public:
 private:
     static int findStateLabelIndexInternal(const std::string* begin,
             const std::string* end, const std::string& desired);
+    /// `find` returns the index of a label or -1.
+    template <typename FindFunction>
+    static int findStateLabelIndexInternal(
+            const std::string& desired, FindFunction find);
 };
 
 } // namespace OpenSim
@@ -0,0 +1,281 @@
+#ifndef OPENSIM_TABLE_VIEWS_H_
+#define OPENSIM_TABLE_VIEWS_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  TableViews.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** \file
+This file defines read-only views that expose a DataTable_ of SimTK::Vec3,
+SimTK::SpatialVec, etc. as a table of doubles (FlattenedTableView), and a
+DataTable_ of doubles as a table of SimTK::Vec3, etc. (PackedTableView_),
+without copying the data.                                                     */
+
+#include "DataTable.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace OpenSim {
+
+namespace internal {
+// The components of a Mat are flattened row by row but stored column by
+// column, so a Mat cannot be viewed in flattened order.
+template <typename T> struct IsMat : std::false_type {};
+template <int M, int N, typename E, int CS, int RS>
+struct IsMat<SimTK::Mat<M, N, E, CS, RS>> : std::true_type {};
+} // namespace internal
+
+/** A read-only view of a DataTable_<double, ETY> as if it had been
+flattened with DataTable_::flatten(), without copying the data. ETY can be
+double, SimTK::Vec3, SimTK::Vec6, SimTK::SpatialVec, SimTK::UnitVec3 or
+SimTK::Quaternion (but not a SimTK::Mat). Since the components of each
+element are stored contiguously, each column of the view is a strided view
+into the matrix of the table.
+
+The view refers to the table's data: the table must outlive the view and
+must not be modified (or copied and then modified; see DataTable_) while
+the view is used. Use flatten() if a separate table is needed.
+
+@code
+const TimeSeriesTableVec3& markers = markersReference.getMarkerTable();
+FlattenedTableView flat(markers);
+for (size_t i = 0; i < flat.getNumColumns(); ++i) {
+    const auto column = flat.getDependentColumnAtIndex(i);
+    // ...
+}
+@endcode */
+class FlattenedTableView {
+public:
+    /** The column labels are those of the table, suffixed with "_1", "_2",
+    etc., or with the given `suffixes` (one per component), as for
+    DataTable_::flatten().
+
+    \throws InvalidArgument If 'suffixes' does not contain one element per
+                            component of ETY.                                */
+    template <typename ETY>
+    explicit FlattenedTableView(const DataTable_<double, ETY>& table,
+            const std::vector<std::string>& suffixes = {})
+            : _indData(&table.getIndependentColumn()) {
+        static_assert(!internal::IsMat<ETY>::value,
+                "A table of Mat cannot be viewed as a flattened table.");
+        static_assert(sizeof(ETY) % sizeof(double) == 0,
+                "The element type must consist of doubles.");
+        const int numComponents = (int)(sizeof(ETY) / sizeof(double));
+        OPENSIM_THROW_IF(!suffixes.empty() &&
+                         (int)suffixes.size() != numComponents,
+                         InvalidArgument,
+                         fmt::format("Expected {} suffixes, but got {}.",
+                                 numComponents, suffixes.size()));
+
+        const auto& matrix = table.getMatrix();
+        const int numRows = matrix.nrow();
+        // Scalars between the same component of consecutive rows.
+        _stride = numRows > 1
+                ? (int)(reinterpret_cast<const double*>(&matrix(1, 0)) -
+                        reinterpret_cast<const double*>(&matrix(0, 0)))
+                : numComponents;
+
+        const std::vector<std::string> labels = table.hasColumnLabels()
+                ? table.getColumnLabels()
+                : std::vector<std::string>(table.getNumColumns());
+        _labels.reserve(numComponents * labels.size());
+        _columnData.reserve(numComponents * labels.size());
+        for (int j = 0; j < matrix.ncol(); ++j) {
+            const double* element = numRows > 0
+                    ? reinterpret_cast<const double*>(&matrix(0, j))
+                    : nullptr;
+            for (int k = 0; k < numComponents; ++k) {
+                if (std::is_same<ETY, double>::value) {
+                    _labels.push_back(labels[j]);
+                } else if (suffixes.empty()) {
+                    _labels.push_back(
+                            labels[j] + "_" + std::to_string(k + 1));
+                } else {
+                    _labels.push_back(labels[j] + suffixes[k]);
+                }
+                _columnData.push_back(element ? element + k : nullptr);
+            }
+        }
+    }
+
+    size_t getNumRows() const { return _indData->size(); }
+    size_t getNumColumns() const { return _columnData.size(); }
+
+    /** The independent column of the table.                                 */
+    const std::vector<double>& getIndependentColumn() const {
+        return *_indData;
+    }
+    const std::vector<std::string>& getColumnLabels() const {
+        return _labels;
+    }
+    const std::string& getColumnLabel(size_t index) const {
+        checkColumnIndex(index);
+        return _labels[index];
+    }
+    /** \throws KeyNotFound If no column has this label.                     */
+    size_t getColumnIndex(const std::string& columnLabel) const {
+        const auto it =
+                std::find(_labels.cbegin(), _labels.cend(), columnLabel);
+        OPENSIM_THROW_IF(it == _labels.cend(), KeyNotFound, columnLabel);
+        return (size_t)std::distance(_labels.cbegin(), it);
+    }
+    bool hasColumn(const std::string& columnLabel) const {
+        return std::find(_labels.cbegin(), _labels.cend(), columnLabel) !=
+               _labels.cend();
+    }
+
+    /** A strided view of a column of the flattened table. Copy it into a
+    SimTK::Vector if the values must be contiguous.
+
+    \throws ColumnIndexOutOfRange If index is out of range.                 */
+    SimTK::VectorView getDependentColumnAtIndex(size_t index) const {
+        checkColumnIndex(index);
+        const int numRows = (int)getNumRows();
+        // A Vector that borrows the table's data; the returned view refers
+        // to the data, not to this temporary.
+        const SimTK::Vector borrowed(
+                numRows, _stride, _columnData[index], true);
+        return borrowed(0, numRows);
+    }
+    /** \throws KeyNotFound If no column has this label.                     */
+    SimTK::VectorView getDependentColumn(
+            const std::string& columnLabel) const {
+        return getDependentColumnAtIndex(getColumnIndex(columnLabel));
+    }
+
+    /** The value in the given row and column of the flattened table.      */
+    double getValueAtIndex(size_t row, size_t column) const {
+        checkColumnIndex(column);
+        OPENSIM_THROW_IF(row >= getNumRows(), RowIndexOutOfRange, row, 0,
+                         getNumRows() - 1);
+        return _columnData[column][row * _stride];
+    }
+
+private:
+    void checkColumnIndex(size_t index) const {
+        OPENSIM_THROW_IF(index >= getNumColumns(), ColumnIndexOutOfRange,
+                         index, 0, getNumColumns() - 1);
+    }
+
+    const std::vector<double>* _indData;
+    std::vector<std::string> _labels;
+    // The first value of each column of the flattened table.
+    std::vector<const double*> _columnData;
+    int _stride = 1;
+};
+
+/** A read-only view of a DataTable_<double, double> as if its columns had
+been packed into elements of type ETY with DataTable_::pack(), without
+copying the data. ETY can be, for example, SimTK::Vec3 or SimTK::SpatialVec
+(but not a SimTK::Mat). The elements are assembled from the 
+consecutive columns when they are accessed.
+
+The view refers to the table's data: the table must outlive the view and
+must not be modified while the view is used.
+
+@code
+PackedTableView_<SimTK::Vec3> markers(flatMarkers, {"_tx", "_ty", "_tz"});
+const SimTK::Vec3 location = markers.getValueAtIndex(0, 2);
+@endcode */
+template <typename ETY>
+class PackedTableView_ {
+    static_assert(!internal::IsMat<ETY>::value,
+            "A table cannot be viewed as a table of Mat.");
+    static_assert(!std::is_same<ETY, double>::value,
+            "Use the table of doubles directly.");
+    static constexpr int NumComponents = (int)(sizeof(ETY) / sizeof(double));
+
+public:
+    /** The column labels are those of the table without the suffixes, which
+    are guessed if not provided, as for DataTable_::pack().
+
+    \throws InvalidArgument In the same cases as DataTable_::pack().       */
+    explicit PackedTableView_(const DataTable_<double, double>& table,
+            const std::vector<std::string>& suffixes = {})
+            : _indData(&table.getIndependentColumn()) {
+        // Guess the labels by packing only the first row.
+        DataTable_<double, double> firstRow;
+        firstRow.setColumnLabels(table.getColumnLabels());
+        if (table.getNumRows() > 0) {
+            firstRow.appendRow(table.getIndependentColumn()[0],
+                               table.getRowAtIndex(0));
+        }
+        _labels = DataTable_<double, ETY>(firstRow, suffixes)
+                          .getColumnLabels();
+
+        const auto& matrix = table.getMatrix();
+        for (int j = 0; j < (int)_labels.size(); ++j) {
+            for (int k = 0; k < NumComponents; ++k) {
+                _columnData.push_back(
+                        &matrix.col(NumComponents * j + k)[0]);
+            }
+        }
+    }
+
+    size_t getNumRows() const { return _indData->size(); }
+    size_t getNumColumns() const { return _labels.size(); }
+    const std::vector<double>& getIndependentColumn() const {
+        return *_indData;
+    }
+    const std::vector<std::string>& getColumnLabels() const {
+        return _labels;
+    }
+    /** \throws KeyNotFound If no column has this label.                     */
+    size_t getColumnIndex(const std::string& columnLabel) const {
+        const auto it =
+                std::find(_labels.cbegin(), _labels.cend(), columnLabel);
+        OPENSIM_THROW_IF(it == _labels.cend(), KeyNotFound, columnLabel);
+        return (size_t)std::distance(_labels.cbegin(), it);
+    }
+
+    /** The element in the given row and column of the packed table.        */
+    ETY getValueAtIndex(size_t row, size_t column) const {
+        OPENSIM_THROW_IF(column >= getNumColumns(), ColumnIndexOutOfRange,
+                         column, 0, getNumColumns() - 1);
+        OPENSIM_THROW_IF(row >= getNumRows(), RowIndexOutOfRange, row, 0,
+                         getNumRows() - 1);
+        ETY element;
+        double* components = reinterpret_cast<double*>(&element);
+        for (int k = 0; k < NumComponents; ++k) {
+            components[k] = _columnData[NumComponents * column + k][row];
+        }
+        return element;
+    }
+
+    /** The packed elements of a row (this allocates the row).              */
+    SimTK::RowVector_<ETY> getRowAtIndex(size_t row) const {
+        SimTK::RowVector_<ETY> result((int)getNumColumns());
+        for (size_t j = 0; j < getNumColumns(); ++j) {
+            result[(int)j] = getValueAtIndex(row, j);
+        }
+        return result;
+    }
+
+private:
+    const std::vector<double>* _indData;
+    std::vector<std::string> _labels;
+    // The (contiguous) columns of the table of doubles.
+    std::vector<const double*> _columnData;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TABLE_VIEWS_H_
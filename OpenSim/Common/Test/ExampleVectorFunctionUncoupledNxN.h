@@ -56,7 +56,10 @@ class ExampleVectorFunctionUncoupledNxN : public VectorFunctionUncoupledNxN {
     // DATA
     //==========================================================================
 protected:
-
+    // Use the analytic derivative in RootSolver.
+    bool _useDerivative;
+    // The number of equations evaluated by evaluateActive().
+    int _numEquationEvaluations;
 
 
     //==========================================================================
@@ -87,8 +90,13 @@ public:
     virtual ~ExampleVectorFunctionUncoupledNxN() {}
 
 private:
-    void setNull(){}
-    void setEqual(const ExampleVectorFunctionUncoupledNxN &aVectorFunction){}
+    void setNull(){
+        _useDerivative = false;
+        _numEquationEvaluations = 0;
+    }
+    void setEqual(const ExampleVectorFunctionUncoupledNxN &aVectorFunction){
+        _useDerivative = aVectorFunction._useDerivative;
+    }
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -110,6 +118,9 @@ public:
     // SET AND GET
     //--------------------------------------------------------------------------
 public:
+    void setUseDerivative(bool aTrueFalse) { _useDerivative = aTrueFalse; }
+    int getNumEquationEvaluations() const { return _numEquationEvaluations; }
+    void resetNumEquationEvaluations() { _numEquationEvaluations = 0; }
 
     //--------------------------------------------------------------------------
     // EVALUATE
@@ -144,6 +155,36 @@ public:
         const Array<int> &aDerivWRT) override {
             std::cout<<"\nExampleVectorFunctionUncoupledNxN.evalute(x,y,derivWRT): not implemented.\n";
     }
+    void evaluate(const SimTK::State& s, const double *aX, double *rF)
+            override {
+        calcValue(aX, rF, getNX());
+    }
+    void evaluate(const SimTK::State& s, const Array<double> &aX,
+            Array<double> &rF) override {
+        calcValue(aX, rF);
+    }
+    void evaluateActive(const SimTK::State& s, const Array<double> &aX,
+            Array<double> &rF, const Array<bool> &aActive) override {
+        Array<double> y(0.0, getNX());
+        calcValue(aX, y);
+        for(int i=0;i<getNX();i++) {
+            if(!aActive[i]) continue;
+            rF[i] = y[i];
+            ++_numEquationEvaluations;
+        }
+    }
+    bool hasDerivative() const override { return _useDerivative; }
+    void evaluateDerivativeActive(const SimTK::State& s,
+            const Array<double> &aX, Array<double> &rDFdX,
+            const Array<bool> &aActive) override {
+        int N = getNX();
+        double sum = 0.0, scale = 0.01;
+        for(int i=0;i<N;i++) sum += (double)i;
+        sum *= scale;
+        for(int i=0;i<N;i++) {
+            if(aActive[i]) rDFdX[i] = sum * cos(aX[i] - scale * (double)i);
+        }
+    }
 
     //=============================================================================
 };
@@ -94,6 +94,22 @@ int main() {
         quatFromTable = quatTableTyped.getRowAtIndex(numRows - 1)[0];
         quatFromFile = SimTK::Quaternion(0.979175344,0.00110321,-0.005109196,-0.202949069);
         ASSERT_EQUAL(quatFromTable, quatFromFile, tolerance);
+        // Reading one frame at a time gives the same data as the tables.
+        auto stream = reader.openStream("imuData01.csv");
+        ASSERT(stream->getLabels() == quatTableTyped.getColumnLabels());
+        ASSERT(stream->hasLinearAccelerations());
+        IMUDataFrame frame;
+        size_t numFrames = 0;
+        while (stream->readNextFrame(frame)) {
+            ASSERT_EQUAL(accelTableTyped.getIndependentColumn()[numFrames],
+                    frame.time, 1e-12);
+            ASSERT_EQUAL(accelTableTyped.getRowAtIndex(numFrames)[2],
+                    frame.linearAccelerations[2], tolerance);
+            ASSERT_EQUAL(quatTableTyped.getRowAtIndex(numFrames)[1],
+                    frame.orientations[1], tolerance);
+            ++numFrames;
+        }
+        ASSERT(numFrames == numRows);
         // Now test new Fromat=7
         testAPDMFormat7();
         
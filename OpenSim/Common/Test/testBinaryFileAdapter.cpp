@@ -0,0 +1,170 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testBinaryFileAdapter.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/CommonUtilities.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+template <typename T>
+TimeSeriesTable_<T> createTable(int numRows, int numColumns) {
+    SimTK::Matrix_<T> matrix(numRows, numColumns);
+    std::vector<double> time(numRows);
+    std::vector<std::string> labels;
+    for (int j = 0; j < numColumns; ++j)
+        labels.push_back("column" + std::to_string(j));
+    for (int i = 0; i < numRows; ++i) {
+        time[i] = 0.01 * i + 1e-13;
+        for (int j = 0; j < numColumns; ++j) {
+            double* elem = reinterpret_cast<double*>(&matrix(i, j));
+            for (unsigned k = 0;
+                    k < BinaryFileAdapter_<T>::numComponents(); ++k)
+                elem[k] = std::sin(0.1 * i + j + 0.3 * k) / 3.0;
+        }
+    }
+    TimeSeriesTable_<T> table(time, matrix, labels);
+    table.addTableMetaData("inDegrees", std::string("no"));
+    table.addTableMetaData("header", std::string("binary test"));
+    return table;
+}
+
+template <typename T>
+void testRoundTrip() {
+    const std::string fileName = "testBinaryFileAdapter.bsto";
+    FileRemover fileRemover(fileName);
+    const auto table = createTable<T>(53, 7);
+    BinaryFileAdapter_<T>::write(table, fileName);
+
+    for (bool useMemoryMapping : {true, false}) {
+        BinaryFileAdapter_<T> adapter;
+        adapter.setUseMemoryMapping(useMemoryMapping);
+        const auto read = adapter.readColumns(fileName, {});
+        CHECK(read.getColumnLabels() == table.getColumnLabels());
+        CHECK(read.getIndependentColumn() == table.getIndependentColumn());
+        CHECK(read.getTableMetaDataAsString("inDegrees") == "no");
+        CHECK(read.getTableMetaDataAsString("header") == "binary test");
+        // The data must be reproduced bit for bit.
+        for (int i = 0; i < (int)table.getNumRows(); ++i) {
+            for (int j = 0; j < (int)table.getNumColumns(); ++j) {
+                CHECK(std::memcmp(&read.getMatrix()(i, j),
+                              &table.getMatrix()(i, j), sizeof(T)) == 0);
+            }
+        }
+    }
+
+    // Reading through the generic interface picks the right adapter.
+    const TimeSeriesTable_<T> fromFile(fileName);
+    CHECK(fromFile.getNumRows() == table.getNumRows());
+    CHECK(fromFile.getNumColumns() == table.getNumColumns());
+}
+} // anonymous namespace
+
+TEST_CASE("BinaryFileAdapter round trip") {
+    testRoundTrip<double>();
+    testRoundTrip<SimTK::Vec2>();
+    testRoundTrip<SimTK::Vec3>();
+    testRoundTrip<SimTK::Vec6>();
+    testRoundTrip<SimTK::Vec<12>>();
+    testRoundTrip<SimTK::UnitVec3>();
+    testRoundTrip<SimTK::Quaternion>();
+    testRoundTrip<SimTK::SpatialVec>();
+}
+
+TEST_CASE("BinaryFileAdapter matches STOFileAdapter") {
+    const std::string fileName = "testBinaryFileAdapter_ik.bsto";
+    FileRemover fileRemover(fileName);
+    TimeSeriesTable sto("std_subject01_walk1_ik.mot");
+    DataAdapter::InputTables tables{};
+    tables.emplace(std::string{"table"}, &sto);
+    FileAdapter::writeFile(tables, fileName);
+
+    TimeSeriesTable binary(fileName);
+    CHECK(binary.getColumnLabels() == sto.getColumnLabels());
+    CHECK(binary.getIndependentColumn() == sto.getIndependentColumn());
+    for (int i = 0; i < (int)sto.getNumRows(); ++i) {
+        for (int j = 0; j < (int)sto.getNumColumns(); ++j)
+            CHECK(binary.getMatrix()(i, j) == sto.getMatrix()(i, j));
+    }
+    for (const auto& key : sto.getTableMetaDataKeys()) {
+        CHECK(binary.getTableMetaDataAsString(key) ==
+                sto.getTableMetaDataAsString(key));
+    }
+}
+
+TEST_CASE("BinaryFileAdapter reads a subset of columns") {
+    const std::string fileName = "testBinaryFileAdapter_subset.bsto";
+    FileRemover fileRemover(fileName);
+    const auto table = createTable<SimTK::Vec3>(20, 10);
+    BinaryFileAdapterVec3::write(table, fileName);
+
+    const auto subset = BinaryFileAdapterVec3{}.readColumns(
+            fileName, {"column7", "column2"});
+    REQUIRE(subset.getNumColumns() == 2);
+    CHECK(subset.getColumnLabel(0) == "column7");
+    CHECK(subset.getColumnLabel(1) == "column2");
+    for (int i = 0; i < 20; ++i) {
+        CHECK(subset.getMatrix()(i, 0) == table.getMatrix()(i, 7));
+        CHECK(subset.getMatrix()(i, 1) == table.getMatrix()(i, 2));
+    }
+
+    CHECK_THROWS_AS(
+            BinaryFileAdapterVec3{}.readColumns(fileName, {"missing"}),
+            KeyMissing);
+    // The data type must match.
+    CHECK_THROWS_AS(BinaryFileAdapter{}.readColumns(fileName, {}),
+            DataTypeMismatch);
+}
+
+TEST_CASE("BinaryFileAdapter rejects invalid files") {
+    const std::string fileName = "testBinaryFileAdapter_invalid.bsto";
+    FileRemover fileRemover(fileName);
+    {
+        std::ofstream file(fileName);
+        file << "time\tq\n0\t1\n";
+    }
+    CHECK_THROWS_AS(BinaryTableFileInfo::read(fileName),
+            BinaryFileFormatError);
+
+    const auto table = createTable<double>(10, 3);
+    BinaryFileAdapter::write(table, fileName);
+    // Truncate the file so that part of the last column is missing.
+    std::string contents;
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file.write(contents.data(), contents.size() - 8);
+    }
+    CHECK_THROWS_AS(BinaryFileAdapter{}.readColumns(fileName, {}),
+            BinaryFileFormatError);
+}
@@ -194,9 +194,38 @@ void test(const std::string filename) {
     cout << "\tcop_" << forces_file << " is equivalent to its standard."<< endl;
 }
 
+void testReadFiles() {
+    using namespace OpenSim;
+
+    // Reading several files concurrently gives the same tables as reading
+    // them one at a time.
+    const std::vector<std::string> filenames{"walking2.c3d", "walking5.c3d",
+                                             "walking2.c3d"};
+    C3DFileAdapter c3dFileAdapter{};
+    c3dFileAdapter.setLocationForForceExpression(
+            C3DFileAdapter::ForceLocation::CenterOfPressure);
+    auto allTables = c3dFileAdapter.readFiles(filenames, 2);
+    ASSERT(allTables.size() == filenames.size());
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        auto tables = c3dFileAdapter.read(filenames[i]);
+        compare_tables<SimTK::Vec3>(
+                *c3dFileAdapter.getMarkersTable(allTables[i]),
+                *c3dFileAdapter.getMarkersTable(tables));
+        compare_tables<SimTK::Vec3>(
+                *c3dFileAdapter.getForcesTable(allTables[i]),
+                *c3dFileAdapter.getForcesTable(tables));
+    }
+
+    // An error in one of the files is rethrown.
+    const std::vector<std::string> withMissing{"walking2.c3d",
+                                               "doesNotExist.c3d"};
+    ASSERT_THROW(std::exception, c3dFileAdapter.readFiles(withMissing));
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST(testReadFiles);
     SimTK_END_TEST();
 }
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/ComponentConcurrencyChecker.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/TableSource.h>
 #include <OpenSim/Common/STOFileAdapter.h>
@@ -31,7 +32,9 @@
 #include <simbody/internal/Force.h>
 #include <simbody/internal/MobilizedBody_Pin.h>
 #include <simbody/internal/MobilizedBody_Ground.h>
+#include <future>
 #include <random>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -1850,6 +1853,149 @@ void testTableReporter() {
     }
 }
 
+// A component with vector outputs, one of which has labeled elements.
+class VectorSource : public Component {
+    OpenSim_DECLARE_CONCRETE_OBJECT(VectorSource, Component);
+public:
+    OpenSim_DECLARE_OUTPUT(labeled, Vector, getLabeled, SimTK::Stage::Time);
+    OpenSim_DECLARE_OUTPUT(unlabeled, Vector, getUnlabeled,
+            SimTK::Stage::Time);
+
+    Vector getLabeled(const SimTK::State& s) const {
+        ++numCalls;
+        const double t = s.getTime();
+        return Vector(Vec3(t, 2 * t, 3 * t));
+    }
+    Vector getUnlabeled(const SimTK::State& s) const {
+        return Vector(2, -s.getTime());
+    }
+
+    mutable int numCalls = 0;
+
+protected:
+    void extendFinalizeFromProperties() override {
+        Super::extendFinalizeFromProperties();
+        updOutput("labeled").setElementLabels({"a", "b", "c"});
+    }
+};
+
+void testTableReporterVector() {
+    auto* source = new VectorSource();
+    source->setName("source");
+    auto* reporter = new TableReporterVector();
+    reporter->addToReport(source->getOutput("labeled"));
+    reporter->addToReport(source->getOutput("unlabeled"));
+
+    MultibodySystem system;
+    TheWorld theWorld;
+    theWorld.setName("World");
+    theWorld.add(source);
+    theWorld.add(reporter);
+    theWorld.finalizeFromProperties();
+    theWorld.connect();
+    theWorld.buildUpSystem(system);
+
+    State s = system.realizeTopology();
+    for (int i = 0; i < 2; ++i) {
+        reporter->clearTable();
+        source->numCalls = 0;
+        const int numRows = 100;
+        for (int j = 0; j < numRows; ++j) {
+            s.setTime(0.01 * j);
+            reporter->report(s);
+        }
+        // The vector is obtained with one call per report.
+        SimTK_TEST(source->numCalls == numRows);
+
+        const auto& table = reporter->getTable();
+        const std::string labeled = source->getOutput("labeled").getPathName();
+        const std::string unlabeled =
+                source->getOutput("unlabeled").getPathName();
+        const std::vector<std::string> expectedLabels{labeled + ":a",
+                labeled + ":b", labeled + ":c", unlabeled + "[0]",
+                unlabeled + "[1]"};
+        SimTK_TEST(table.getColumnLabels() == expectedLabels);
+        SimTK_TEST(table.getNumRows() == numRows);
+        for (int j = 0; j < numRows; ++j) {
+            const double t = 0.01 * j;
+            SimTK_TEST_EQ(table.getIndependentColumn()[j], t);
+            const auto row = table.getRowAtIndex(j);
+            SimTK_TEST_EQ(row[0], t);
+            SimTK_TEST_EQ(row[1], 2 * t);
+            SimTK_TEST_EQ(row[2], 3 * t);
+            SimTK_TEST_EQ(row[3], -t);
+            SimTK_TEST_EQ(row[4], -t);
+        }
+    }
+}
+
+void testSTOFileReporter() {
+    TimeSeriesTable table{};
+    table.setColumnLabels({"0", "1", "2", "3"});
+    SimTK::RowVector_<double> row{4, double{0}};
+    for(unsigned i = 0; i < 4; ++i)
+        table.appendRow(0.00 + 0.25 * i, row + i);
+
+    auto tableSource = new TableSource{table};
+    auto tableReporter = new TableReporter();
+    auto fileReporter = new STOFileReporter();
+    const std::string fileName = "testComponentInterface_STOFileReporter.sto";
+    fileReporter->set_file_name(fileName);
+    // Smaller than the number of rows, so that the rows are written in
+    // several batches.
+    fileReporter->set_buffer_size(3);
+
+    MultibodySystem system;
+    TheWorld theWorld;
+    theWorld.setName("World");
+    theWorld.add(tableSource);
+    theWorld.add(tableReporter);
+    theWorld.add(fileReporter);
+    tableReporter->addToReport(tableSource->getOutput("column"));
+    fileReporter->addToReport(tableSource->getOutput("column"));
+    theWorld.finalizeFromProperties();
+    theWorld.connect();
+    theWorld.buildUpSystem(system);
+
+    State s = system.realizeTopology();
+    for (int i = 0; i < 2; ++i) {
+        // Simulating again after closing the file starts a new file.
+        tableReporter->clearTable();
+        for (int j = 0; j <= 15; ++j) {
+            s.setTime(0.05 * j);
+            tableReporter->report(s);
+            fileReporter->report(s);
+        }
+        SimTK_TEST(fileReporter->getNumRowsReported() == 16);
+        fileReporter->closeFile();
+        SimTK_TEST(fileReporter->getNumRowsReported() == 0);
+
+        const TimeSeriesTable fromFile(fileName);
+        const auto& expected = tableReporter->getTable();
+        SimTK_TEST(fromFile.getColumnLabels() == expected.getColumnLabels());
+        SimTK_TEST(fromFile.getNumRows() == expected.getNumRows());
+        SimTK_TEST(fromFile.getTableMetaData<std::string>("nRows") == "16");
+        for (size_t irow = 0; irow < expected.getNumRows(); ++irow) {
+            SimTK_TEST_EQ(fromFile.getIndependentColumn()[irow],
+                          expected.getIndependentColumn()[irow]);
+            assertEqual(fromFile.getRowAtIndex(irow),
+                        expected.getRowAtIndex(irow));
+        }
+    }
+
+    // Reporting rows out of order throws.
+    s.setTime(0.5);
+    fileReporter->report(s);
+    s.setTime(0.25);
+    SimTK_TEST_MUST_THROW_EXC(fileReporter->report(s), Exception);
+    fileReporter->closeFile();
+
+    // A file name is required.
+    STOFileReporter noFileName;
+    SimTK_TEST_MUST_THROW_EXC(noFileName.finalizeFromProperties(),
+                              InvalidPropertyValue);
+}
+
 const std::string dataFileNameForInputConnecteeSerialization =
         "testComponentInterface_testInputConnecteeSerialization_data.sto";
 
@@ -2260,6 +2406,117 @@ void testGetAbsolutePathStringSpeed() {
     cout << "getName avgTime = " << avgTime / numTrials << "s" << endl;
 }
 
+void testCopyAfterAddToSystem() {
+    TheWorld top;
+    top.setName("top");
+    for (int i = 0; i < 50; ++i) {
+        Sub* sub = new Sub();
+        sub->setName("sub" + std::to_string(i));
+        top.add(sub);
+    }
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+    SimTK_TEST(top.getNumStateVariables() == 51);
+
+    // The state allocations are not copied; they are recreated when the copy
+    // is added to its own System.
+    TheWorld copy = top;
+    SimTK_TEST_MUST_THROW_EXC(copy.getNumStateVariables(),
+            ComponentHasNoSystem);
+    MultibodySystem copySystem;
+    copy.buildUpSystem(copySystem);
+    State copyState = copySystem.realizeTopology();
+    SimTK_TEST(copy.getNumStateVariables() == 51);
+    copyState.updY()[1] = 5;
+    SimTK_TEST(copy.getStateVariableValue(copyState, "sub0/subState") == 5);
+
+    // Benchmark copying (and finalizing) a component that has already been
+    // added to a System.
+    const int numCopies = 200;
+    std::clock_t startTime = std::clock();
+    for (int i = 0; i < numCopies; ++i) {
+        std::unique_ptr<TheWorld> clone(top.clone());
+    }
+    const double copyTime = double(std::clock() - startTime) / CLOCKS_PER_SEC;
+    startTime = std::clock();
+    for (int i = 0; i < numCopies; ++i) {
+        std::unique_ptr<TheWorld> clone(top.clone());
+        clone->finalizeFromProperties();
+    }
+    const double finalizeTime =
+            double(std::clock() - startTime) / CLOCKS_PER_SEC;
+    cout << "clone avgTime = " << copyTime / numCopies << "s; "
+         << "clone and finalizeFromProperties avgTime = "
+         << finalizeTime / numCopies << "s" << endl;
+}
+
+void testThreadSafety() {
+    class NotThreadSafe : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(NotThreadSafe, Component);
+    public:
+        bool isThreadSafe() const override { return false; }
+    };
+
+    TheWorld top;
+    top.setName("top");
+    Sub* sub = new Sub();
+    sub->setName("sub");
+    top.add(sub);
+    top.finalizeFromProperties();
+    SimTK_TEST(top.getThreadUnsafeComponents().empty());
+
+    NotThreadSafe* unsafe = new NotThreadSafe();
+    unsafe->setName("unsafe");
+    top.add(unsafe);
+    top.finalizeFromProperties();
+    const auto unsafeComponents = top.getThreadUnsafeComponents();
+    SimTK_TEST(unsafeComponents.size() == 1);
+    SimTK_TEST(unsafeComponents[0] == unsafe);
+
+    // Modifying the tree while another thread uses it is detected.
+    using Checker = ComponentConcurrencyChecker;
+    Checker::setEnabled(true);
+    std::promise<void> inUse;
+    std::promise<void> finished;
+    std::thread user([&]() {
+        Checker::Scope scope(Checker::Access::Use, *sub, "testThreadSafety");
+        inUse.set_value();
+        finished.get_future().wait();
+    });
+    inUse.get_future().wait();
+    SimTK_TEST_MUST_THROW_EXC(
+            top.finalizeFromProperties(), ConcurrentComponentAccess);
+    // Using the tree from multiple threads is fine.
+    {
+        Checker::Scope scope(Checker::Access::Use, top, "testThreadSafety");
+    }
+    finished.set_value();
+    user.join();
+    top.finalizeFromProperties();
+    Checker::setEnabled(false);
+}
+
+void testPropertyCommentsAreShared() {
+    Foo foo1;
+    Foo foo2;
+    std::unique_ptr<Foo> fooCopy(foo1.clone());
+    const auto& comment = foo1.getProperty_mass().getComment();
+    SimTK_TEST(comment == "mass (kg)");
+    // Each distinct comment is stored once.
+    SimTK_TEST(&comment == &foo2.getProperty_mass().getComment());
+    SimTK_TEST(&comment == &fooCopy->getProperty_mass().getComment());
+    SimTK_TEST(foo1.getProperty_mass() == foo2.getProperty_mass());
+
+    fooCopy->updProperty_mass().setComment("mass of the copy (kg)");
+    SimTK_TEST(fooCopy->getProperty_mass().getComment() ==
+               "mass of the copy (kg)");
+    SimTK_TEST(foo1.getProperty_mass().getComment() == "mass (kg)");
+    SimTK_TEST(!(foo1.getProperty_mass() == fooCopy->getProperty_mass()));
+    fooCopy->updProperty_mass().setComment("");
+    SimTK_TEST(fooCopy->getProperty_mass().getComment().empty());
+}
+
 void testFormattedDateTime() {
     std::string withMicroseconds = getFormattedDateTime(true, "%Y");
     std::string withoutMicroseconds = getFormattedDateTime(false, "%Y");
@@ -2527,6 +2784,8 @@ int main() {
         SimTK_SUBTEST(testExceptionsOutputNameExistsAlready);
         SimTK_SUBTEST(testTableSource);
         SimTK_SUBTEST(testTableReporter);
+        SimTK_SUBTEST(testTableReporterVector);
+        SimTK_SUBTEST(testSTOFileReporter);
         SimTK_SUBTEST(testAliasesAndLabels);
     
         writeTimeSeriesTableForInputConnecteeSerialization();
@@ -2540,6 +2799,9 @@ int main() {
 
         SimTK_SUBTEST(testFormattedDateTime);
         SimTK_SUBTEST(testCacheVariableInterface);
+        SimTK_SUBTEST(testCopyAfterAddToSystem);
+        SimTK_SUBTEST(testPropertyCommentsAreShared);
+        SimTK_SUBTEST(testThreadSafety);
 
     SimTK_END_TEST();
 }
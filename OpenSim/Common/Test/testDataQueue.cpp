@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  testDataQueue.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/DataQueue.h>
+#include <thread>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+TEST_CASE("DataQueue_ owns a copy of the data") {
+    DataQueue_<double> queue;
+    {
+        SimTK::RowVector_<double> row(3, 1.5);
+        queue.push_back(0.1, row);
+        row = 0;
+    }
+    CHECK(!queue.isEmpty());
+    double time;
+    SimTK::RowVector_<double> row;
+    queue.pop_front(time, row);
+    CHECK(time == 0.1);
+    CHECK(row.size() == 3);
+    CHECK(row[2] == 1.5);
+    CHECK(queue.isEmpty());
+}
+
+TEST_CASE("DataRingBuffer_") {
+    using Buffer = DataRingBuffer_<double>;
+
+    SECTION("Rows are popped in order") {
+        Buffer buffer(4);
+        CHECK(buffer.getRowWidth() == 0);
+        double time;
+        SimTK::RowVector_<double> row;
+        CHECK(!buffer.tryPop(time, row));
+        for (int i = 0; i < 3; ++i) {
+            CHECK(buffer.push(i, SimTK::RowVector_<double>(2, 10.0 * i)));
+        }
+        CHECK(buffer.getRowWidth() == 2);
+        CHECK(buffer.size() == 3);
+        // Wrap around the end of the ring.
+        for (int k = 0; k < 10; ++k) {
+            REQUIRE(buffer.tryPop(time, row));
+            CHECK(time == k);
+            CHECK(row.size() == 2);
+            CHECK(row[1] == 10.0 * k);
+            buffer.push(k + 3, SimTK::RowVector_<double>(2, 10.0 * (k + 3)));
+        }
+        CHECK(buffer.size() == 3);
+
+        // Any container with resize() and operator[] can be used.
+        SimTK::Array_<double> values;
+        buffer.pop(time, values);
+        CHECK(time == 10);
+        CHECK(values.size() == 2);
+        CHECK(values[0] == 100.0);
+
+        CHECK_THROWS_AS(buffer.push(13, SimTK::RowVector_<double>(3, 0.0)),
+                Exception);
+        CHECK_THROWS_AS(Buffer(0), Exception);
+    }
+
+    SECTION("Overflow policies") {
+        Buffer dropping(2, 1);
+        const SimTK::RowVector_<double> row(1, 0.0);
+        CHECK(dropping.push(0, row));
+        CHECK(dropping.push(1, row));
+        CHECK(!dropping.push(2, row));
+        CHECK(dropping.getNumDropped() == 1);
+        CHECK(dropping.size() == 2);
+
+        Buffer throwing(2, 1, Buffer::OverflowPolicy::Throw);
+        throwing.push(0, row);
+        throwing.push(1, row);
+        CHECK_THROWS_AS(throwing.push(2, row), Exception);
+        CHECK(throwing.size() == 2);
+    }
+
+    SECTION("Copies have the same rows") {
+        Buffer buffer(3, 1);
+        buffer.push(0.5, SimTK::RowVector_<double>(1, 2.0));
+        Buffer copy(buffer);
+        double time;
+        SimTK::RowVector_<double> row;
+        REQUIRE(copy.tryPop(time, row));
+        CHECK(time == 0.5);
+        CHECK(row[0] == 2.0);
+        CHECK(copy.isEmpty());
+        CHECK(buffer.size() == 1);
+    }
+
+    SECTION("Producer and consumer threads") {
+        const int numRows = 100000;
+        const int width = 12;
+        Buffer buffer(64, width, Buffer::OverflowPolicy::Wait);
+        std::thread producer([&]() {
+            SimTK::RowVector_<double> row(width);
+            for (int i = 0; i < numRows; ++i) {
+                for (int j = 0; j < width; ++j) row[j] = i + 0.001 * j;
+                buffer.push(i, row);
+            }
+        });
+        bool inOrder = true;
+        double time;
+        SimTK::RowVector_<double> row(width);
+        for (int i = 0; i < numRows; ++i) {
+            buffer.pop(time, row);
+            inOrder = inOrder && time == i && row[width - 1] ==
+                    i + 0.001 * (width - 1);
+        }
+        producer.join();
+        CHECK(inOrder);
+        CHECK(buffer.isEmpty());
+        CHECK(buffer.getNumDropped() == 0);
+    }
+}
@@ -26,8 +26,13 @@
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
+#include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/TableUtilities.h>
+#include <OpenSim/Common/TableViews.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
@@ -861,6 +866,172 @@ TEST_CASE("TableUtilities::filterLowpass") {
     }
 }
 
+TEST_CASE("Filtering and fitting many columns in parallel") {
+    // The columns are processed in parallel; the results must match
+    // processing each column on its own.
+    const int numRows = 200;
+    const int numColumns = 37;
+    // The time step is exact in binary, so that the data are not resampled.
+    std::vector<double> times(numRows);
+    for (int i = 0; i < numRows; ++i) times[i] = i / 128.0;
+    std::vector<std::string> labels;
+    for (int icol = 0; icol < numColumns; ++icol) {
+        labels.push_back("c" + std::to_string(icol));
+    }
+    STOFileAdapter::write(TimeSeriesTable(times,
+                                  SimTK::Test::randMatrix(numRows, numColumns),
+                                  labels),
+            "testParallelColumns.sto");
+    // Use the values as written to the file, so that the Storage (which can
+    // only be created from a file) has the same data as the table.
+    const TimeSeriesTable original("testParallelColumns.sto");
+    const std::vector<double>& time = original.getIndependentColumn();
+    const SimTK::Matrix data = original.getMatrix();
+    const double dt = time[1] - time[0];
+
+    SECTION("TableUtilities::filterLowpass") {
+        TimeSeriesTable table(original);
+        TableUtilities::filterLowpass(table, 6.0);
+        std::vector<double> expected(numRows);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            const SimTK::Vector column = data.col(icol);
+            Signal::LowpassIIR(dt, 6.0, numRows,
+                    column.getContiguousScalarData(), expected.data());
+            const auto& filtered = table.getDependentColumnAtIndex(icol);
+            for (int i = 0; i < numRows; ++i) {
+                CHECK(filtered[i] == expected[i]);
+            }
+        }
+    }
+
+    SECTION("Storage::lowpassIIR and Storage::lowpassFIR") {
+        Storage iir("testParallelColumns.sto");
+        Storage fir("testParallelColumns.sto");
+        iir.lowpassIIR(6.0);
+        fir.lowpassFIR(10, 6.0);
+        SimTK::Matrix iirData, firData;
+        iir.getDataMatrix(iirData);
+        fir.getDataMatrix(firData);
+        std::vector<double> expected(numRows);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            SimTK::Vector column = data.col(icol);
+            Signal::LowpassIIR(dt, 6.0, numRows,
+                    column.getContiguousScalarData(), expected.data());
+            for (int i = 0; i < numRows; ++i) {
+                CHECK(iirData(i, icol) == Approx(expected[i]));
+            }
+            Signal::LowpassFIR(10, dt, 6.0, numRows,
+                    column.updContiguousScalarData(), expected.data());
+            for (int i = 0; i < numRows; ++i) {
+                CHECK(firData(i, icol) == Approx(expected[i]));
+            }
+        }
+    }
+
+    SECTION("GCVSplineSet") {
+        const Storage sto("testParallelColumns.sto");
+        const GCVSplineSet fromStorage(5, &sto);
+        const GCVSplineSet fromTable(original);
+        REQUIRE(fromStorage.getSize() == numColumns);
+        REQUIRE(fromTable.getSize() == numColumns);
+        SimTK::Vector x(1);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            const SimTK::Vector column = data.col(icol);
+            GCVSpline expected(5, numRows, time.data(),
+                    column.getContiguousScalarData());
+            CHECK(fromStorage.get(icol).getName() == labels[icol]);
+            for (double t : {0.0, 0.1234, 0.5, 0.9}) {
+                x[0] = t;
+                CHECK(fromStorage.get(icol).calcValue(x) ==
+                        Approx(expected.calcValue(x)));
+                CHECK(fromTable.get(icol).calcValue(x) ==
+                        Approx(expected.calcValue(x)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Signal::LowpassIIR and Signal::LowpassFIR") {
+    const int numRows = 300;
+    const int numSignals = 7; // Not a multiple of the number of lanes.
+    const double dt = 1.0 / 256.0;
+    const double cutoff = 10.0;
+    const SimTK::Matrix data = SimTK::Test::randMatrix(numRows, numSignals);
+
+    // Reference: the forward and backward passes written out with explicit
+    // reversed copies of the signal.
+    const auto reference = [&](const double* sig, std::vector<double>& out) {
+        const double wa = std::tan(2 * SimTK::Pi * cutoff * dt / 2.0);
+        const double wa2 = wa * wa, wa3 = wa * wa * wa;
+        const double denom = (wa + 1) * (wa * wa + wa + 1.0);
+        const double a[4] = {wa3 / denom, 3 * wa3 / denom, 3 * wa3 / denom,
+                wa3 / denom};
+        const double b[4] = {1, (3 * wa3 + 2 * wa2 - 2 * wa - 3) / denom,
+                (3 * wa3 - 2 * wa2 - 2 * wa + 3) / denom,
+                (wa - 1) * (wa2 - wa + 1) / denom};
+        std::vector<double> x(sig, sig + numRows);
+        for (int pass = 0; pass < 2; ++pass) {
+            std::vector<double> y(x);
+            for (int i = 3; i < numRows; ++i) {
+                y[i] = a[0] * x[i] + a[1] * x[i - 1] + a[2] * x[i - 2] +
+                       a[3] * x[i - 3] - b[1] * y[i - 1] - b[2] * y[i - 2] -
+                       b[3] * y[i - 3];
+            }
+            x.assign(y.rbegin(), y.rend());
+        }
+        out = x;
+    };
+
+    SECTION("Many signals in place") {
+        SimTK::Matrix filtered = data;
+        REQUIRE(Signal::LowpassIIR(dt, cutoff, numRows, numSignals, numRows,
+                        &filtered(0, 0)) == 0);
+        std::vector<double> expected;
+        for (int icol = 0; icol < numSignals; ++icol) {
+            reference(&data(0, icol), expected);
+            for (int i = 0; i < numRows; ++i) {
+                CHECK(filtered(i, icol) == Approx(expected[i]));
+            }
+        }
+    }
+
+    SECTION("One signal, in place and into another array") {
+        std::vector<double> expected, filtered(numRows);
+        reference(&data(0, 0), expected);
+        REQUIRE(Signal::LowpassIIR(dt, cutoff, numRows, &data(0, 0),
+                        filtered.data()) == 0);
+        std::vector<double> inPlace(&data(0, 0), &data(0, 0) + numRows);
+        REQUIRE(Signal::LowpassIIR(dt, cutoff, numRows, inPlace.data(),
+                        inPlace.data()) == 0);
+        for (int i = 0; i < numRows; ++i) {
+            CHECK(filtered[i] == Approx(expected[i]));
+            CHECK(inPlace[i] == filtered[i]);
+        }
+        CHECK(Signal::LowpassIIR(dt, cutoff, 3, 1, 3, inPlace.data()) == -1);
+    }
+
+    SECTION("FIR") {
+        const int order = 20;
+        std::vector<double> sig(&data(0, 1), &data(0, 1) + numRows);
+        std::vector<double> filtered(numRows);
+        REQUIRE(Signal::LowpassFIR(order, dt, cutoff, numRows, sig.data(),
+                        filtered.data()) == 0);
+        const std::vector<double> padded =
+                Signal::Pad(order, numRows, sig.data());
+        const double w = 2 * SimTK::Pi * cutoff;
+        for (int n = 0; n < numRows; ++n) {
+            double sum = 0, sumCoef = 0;
+            for (int k = -order; k <= order; ++k) {
+                const double coef = Signal::sinc(k * w * dt) * dt * w /
+                                    SimTK::Pi * Signal::hamming(k, order);
+                sum += coef * padded[order + n - k];
+                sumCoef += coef;
+            }
+            CHECK(filtered[n] == Approx(sum / sumCoef));
+        }
+    }
+}
+
 TEST_CASE("TableUtilities::pad") {
     Storage sto("test.sto");
     TimeSeriesTable paddedTable = sto.exportToTable();
@@ -916,3 +1087,418 @@ TEST_CASE("TableUtilities::resample") {
         CHECK(column[5] == Approx(0.0).margin(1e-10));
     }
 }
+
+TEST_CASE("TableUtilities::resampleTable") {
+    using Method = TableUtilities::InterpolationMethod;
+    std::vector<double> time{0.0, 1, 2, 3, 4};
+    TimeSeriesTable table(time);
+    std::vector<double> quadratic;
+    for (const auto& t : time) quadratic.push_back(t * t);
+    table.appendColumn("a", {1.0, 0.5, 0.0, 0.5, 1.0});
+    table.appendColumn("b", quadratic);
+    table.appendColumn("c", {0.0, 1.0, SimTK::NaN, 3.0, 4.0});
+    table.addTableMetaData<std::string>("inDegrees", "no");
+
+    SECTION("Linear") {
+        const std::vector<double> newTime{0.0, 0.25, 1.0, 1.5, 3.0, 3.5, 4.0};
+        const auto out = TableUtilities::resampleTable(table, newTime);
+        REQUIRE(out.getNumRows() == newTime.size());
+        CHECK(out.getIndependentColumn() == newTime);
+        CHECK(out.getColumnLabels() == table.getColumnLabels());
+        CHECK(out.getTableMetaDataAsString("inDegrees") == "no");
+        const auto a = out.getDependentColumn("a");
+        CHECK(a[1] == Approx(0.875));
+        CHECK(a[3] == Approx(0.25));
+        CHECK(a[5] == Approx(0.75));
+        // A NaN only affects the new times that depend on it.
+        const auto c = out.getDependentColumn("c");
+        CHECK(c[2] == Approx(1.0));
+        CHECK(SimTK::isNaN(c[3]));
+        CHECK(c[4] == Approx(3.0));
+        CHECK(c[5] == Approx(3.5));
+    }
+    SECTION("Cubic Hermite") {
+        // Finite-difference slopes are exact for a quadratic, so interior
+        // intervals are reproduced exactly.
+        const std::vector<double> newTime{1.0, 1.3, 1.75, 2.0, 2.6};
+        const auto out = TableUtilities::resampleTable(
+                table, newTime, Method::CubicHermite);
+        const auto b = out.getDependentColumn("b");
+        for (int i = 0; i < (int)newTime.size(); ++i) {
+            CHECK(b[i] == Approx(newTime[i] * newTime[i]));
+        }
+    }
+    SECTION("GCVSpline matches resample()") {
+        const std::vector<double> newTime{0.5, 1.5, 2.5};
+        TimeSeriesTable nonNaN(time);
+        nonNaN.appendColumn("b", quadratic);
+        const auto out = TableUtilities::resampleTable(
+                nonNaN, newTime, Method::GCVSpline);
+        const auto expected = TableUtilities::resample(nonNaN, newTime);
+        for (int i = 0; i < (int)newTime.size(); ++i) {
+            CHECK(out.getDependentColumnAtIndex(0)[i] ==
+                    Approx(expected.getDependentColumnAtIndex(0)[i]));
+        }
+    }
+    SECTION("Vec3") {
+        TimeSeriesTable_<Vec3> markers(std::vector<double>{0.0, 1.0});
+        markers.appendColumn("m", {Vec3(0, 1, 2), Vec3(2, 3, 4)});
+        const auto out = TableUtilities::resampleTable(
+                markers, std::vector<double>{0.5});
+        const Vec3& m = out.getDependentColumnAtIndex(0)[0];
+        CHECK(m[0] == Approx(1));
+        CHECK(m[1] == Approx(2));
+        CHECK(m[2] == Approx(3));
+    }
+    SECTION("Quaternion") {
+        const Quaternion q0 =
+                Rotation(0.0, UnitVec3(0, 0, 1)).convertRotationToQuaternion();
+        const Quaternion q1 =
+                Rotation(1.0, UnitVec3(0, 0, 1)).convertRotationToQuaternion();
+        TimeSeriesTable_<Quaternion> orientations(
+                std::vector<double>{0.0, 1.0});
+        orientations.appendColumn("imu", {q0, q1});
+        const auto out = TableUtilities::resampleTable(
+                orientations, std::vector<double>{0.0, 0.25, 1.0});
+        const auto column = out.getDependentColumnAtIndex(0);
+        CHECK(column[0].norm() == Approx(1.0));
+        CHECK(column[1].norm() == Approx(1.0));
+        const Quaternion expected =
+                Rotation(0.25, UnitVec3(0, 0, 1)).convertRotationToQuaternion();
+        for (int i = 0; i < 4; ++i) {
+            CHECK(column[1][i] == Approx(expected[i]).margin(1e-10));
+            CHECK(column[2][i] == Approx(q1[i]).margin(1e-10));
+        }
+        CHECK_THROWS_AS(TableUtilities::resampleTable(orientations,
+                                std::vector<double>{0.5},
+                                Method::CubicHermite),
+                Exception);
+    }
+    SECTION("Invalid times") {
+        CHECK_THROWS_AS(TableUtilities::resampleTable(
+                                table, std::vector<double>{-1.0}),
+                Exception);
+        CHECK_THROWS_AS(TableUtilities::resampleTable(
+                                table, std::vector<double>{2.0, 1.0}),
+                Exception);
+    }
+}
+
+TEST_CASE("DataTable row capacity") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    table.reserveRows(4);
+    CHECK(table.getNumRows() == 0);
+    CHECK(table.getRowCapacity() == 4);
+    CHECK(table.isEmpty());
+
+    // Appending rows grows the capacity geometrically.
+    const int numRows = 1000;
+    for (int i = 0; i < numRows; ++i) {
+        table.appendRow(0.01 * i, {1.0 * i, -1.0 * i});
+    }
+    REQUIRE(table.getNumRows() == numRows);
+    CHECK(table.getRowCapacity() >= (size_t)numRows);
+    CHECK(table.getRowCapacity() < (size_t)(2 * numRows));
+    CHECK(table.getRowAtIndex(numRows - 1)[1] == -(numRows - 1));
+
+    // Columns only contain the rows that hold data.
+    const auto column = table.getDependentColumn("a");
+    REQUIRE(column.size() == numRows);
+    CHECK(column[numRows - 1] == numRows - 1);
+    table.updDependentColumnAtIndex(1) = 2.0;
+    CHECK(table.getRowAtIndex(3)[1] == 2.0);
+
+    // Removing the last row keeps the capacity.
+    const size_t capacity = table.getRowCapacity();
+    table.removeRowAtIndex(numRows - 1);
+    CHECK(table.getNumRows() == numRows - 1);
+    CHECK(table.getRowCapacity() == capacity);
+
+    // The matrix has exactly one row per entry in the independent column.
+    CHECK(table.getMatrix().nrow() == numRows - 1);
+    CHECK(table.getRowCapacity() == (size_t)(numRows - 1));
+    table.appendRow(10.0, {1.0, 2.0});
+    table.shrinkToFit();
+    CHECK(table.getRowCapacity() == table.getNumRows());
+    CHECK(table.getIndependentColumn().back() == 10.0);
+    CHECK(table.getRowAtIndex(numRows - 1)[0] == 1.0);
+
+    // A copy and a file round trip only contain the rows that hold data.
+    table.appendRow(11.0, {3.0, 4.0});
+    TimeSeriesTable copy(table);
+    CHECK(copy.getNumRows() == table.getNumRows());
+    CHECK(copy.getMatrix().nrow() == (int)table.getNumRows());
+    STOFileAdapter::write(table, "testDataTable_capacity.sto");
+    TimeSeriesTable fromFile("testDataTable_capacity.sto");
+    CHECK(fromFile.getNumRows() == table.getNumRows());
+    CHECK(fromFile.getRowAtIndex(numRows)[1] == 4.0);
+}
+
+TEST_CASE("TimeSeriesTable nearest row with a hint") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a"});
+    const std::vector<double> times{0.0, 0.1, 0.2, 0.35, 0.5, 0.8, 1.0};
+    for (const auto& time : times) table.appendRow(time, {time});
+
+    // The result matches the binary search for any hint, including times
+    // exactly on a row, halfway between rows, and outside the range.
+    for (double time = -0.1; time <= 1.1; time += 0.0125) {
+        const size_t expected = table.getNearestRowIndexForTime(time, false);
+        for (size_t hint = 0; hint < times.size() + 2; ++hint) {
+            CHECK(table.getNearestRowIndexForTime(time, false, hint) ==
+                    expected);
+        }
+    }
+    for (size_t i = 0; i + 1 < times.size(); ++i) {
+        const double halfway = 0.5 * (times[i] + times[i + 1]);
+        CHECK(table.getNearestRowIndexForTime(halfway, true, i) ==
+                table.getNearestRowIndexForTime(halfway));
+        CHECK(table.getNearestRowIndexForTime(times[i + 1], true, i) ==
+                i + 1);
+    }
+    CHECK_THROWS_AS(table.getNearestRowIndexForTime(1.5, true, 5),
+            TimeOutOfRange);
+}
+
+TEST_CASE("TableUtilities statistics and derivatives") {
+    // y0 = sin(2 pi t) and y1 = t^2 on a uniform grid (the time step is
+    // exact in binary, so that the data are not resampled).
+    const int numRows = 257;
+    TimeSeriesTable table;
+    table.setColumnLabels({"sin", "square"});
+    for (int i = 0; i < numRows; ++i) {
+        const double t = i / 256.0;
+        table.appendRow(t, {std::sin(2 * SimTK::Pi * t), t * t});
+    }
+
+    SECTION("computeColumnStatistics") {
+        TimeSeriesTable gappy(table);
+        gappy.updDependentColumnAtIndex(1)[128] = SimTK::NaN;
+        const auto stats = TableUtilities::computeColumnStatistics(gappy);
+        REQUIRE(stats.mean.size() == 2);
+        CHECK(stats.mean[0] == Approx(0).margin(1e-12));
+        CHECK(stats.rms[0] == Approx(std::sqrt(0.5)).epsilon(1e-2));
+        CHECK(stats.peak[0] == Approx(1.0).epsilon(1e-4));
+        CHECK(stats.min[0] == Approx(-1.0).epsilon(1e-4));
+        CHECK(stats.area[0] == Approx(0).margin(1e-12));
+        CHECK(stats.min[1] == 0);
+        CHECK(stats.max[1] == 1);
+        CHECK(!SimTK::isNaN(stats.mean[1]));
+        // The two intervals around the gap are skipped.
+        CHECK(stats.area[1] == Approx(1.0 / 3 - 2.0 / 256 * 0.25)
+                                       .epsilon(1e-3));
+
+        // The results match the Storage computation.
+        const auto all = TableUtilities::computeColumnStatistics(table);
+        STOFileAdapter::write(table, "testTableStatistics.sto");
+        Storage storage("testTableStatistics.sto");
+        double area[2];
+        storage.computeArea(2, area);
+        CHECK(all.area[0] == Approx(area[0]).margin(1e-12));
+        CHECK(all.area[1] == Approx(area[1]));
+    }
+
+    SECTION("differentiate") {
+        // The central difference is exact for a quadratic, even with
+        // non-uniform sampling.
+        TimeSeriesTable quadratic;
+        quadratic.setColumnLabels({"y"});
+        const std::vector<double> times{0, 0.1, 0.25, 0.3, 0.5, 0.9};
+        for (const auto& t : times) quadratic.appendRow(t, {3 * t * t - t});
+        TableUtilities::differentiate(quadratic);
+        const auto& dy = quadratic.getDependentColumnAtIndex(0);
+        for (int i = 1; i < (int)times.size() - 1; ++i) {
+            CHECK(dy[i] == Approx(6 * times[i] - 1));
+        }
+        // One-sided differences at the ends.
+        CHECK(dy[0] == Approx(3 * 0.1 - 1));
+        CHECK(dy[5] == Approx(3 * (0.9 + 0.5) - 1));
+
+        TimeSeriesTable one;
+        one.setColumnLabels({"y"});
+        one.appendRow(0.0, {1.0});
+        CHECK_THROWS_AS(TableUtilities::differentiate(one), Exception);
+    }
+
+    SECTION("filterLowpassAndDifferentiate") {
+        // Without differentiating, the fused version matches padding,
+        // filtering, and removing the padding.
+        TimeSeriesTable filtered(table);
+        TableUtilities::filterLowpassAndDifferentiate(filtered, 10.0, 0);
+        TimeSeriesTable expected(table);
+        TableUtilities::filterLowpass(expected, 10.0, true);
+        const int numPad = numRows / 2;
+        REQUIRE(filtered.getNumRows() == (size_t)numRows);
+        for (int i = 0; i < numRows; ++i) {
+            CHECK(filtered.getIndependentColumn()[i] ==
+                    table.getIndependentColumn()[i]);
+            CHECK(filtered.getMatrix()(i, 0) ==
+                    Approx(expected.getMatrix()(i + numPad, 0)));
+        }
+
+        // The derivatives of the smooth signals are recovered, including the
+        // velocities at the ends (the padding preserves the slope but not
+        // the curvature at the ends).
+        TimeSeriesTable velocity(table);
+        TableUtilities::filterLowpassAndDifferentiate(velocity, 10.0, 1);
+        TimeSeriesTable acceleration(table);
+        TableUtilities::filterLowpassAndDifferentiate(acceleration, 10.0, 2);
+        for (int i = 0; i < numRows; i += 10) {
+            const double t = table.getIndependentColumn()[i];
+            CHECK(velocity.getMatrix()(i, 0) ==
+                    Approx(2 * SimTK::Pi * std::cos(2 * SimTK::Pi * t))
+                            .margin(0.05));
+            CHECK(velocity.getMatrix()(i, 1) == Approx(2 * t).margin(0.02));
+            if (i >= 50 && i < numRows - 50) {
+                CHECK(acceleration.getMatrix()(i, 1) ==
+                        Approx(2).margin(0.2));
+            }
+        }
+
+        TimeSeriesTable nonuniform(table);
+        nonuniform.appendRow(2.0, {0.0, 0.0});
+        CHECK_THROWS_AS(TableUtilities::filterLowpassAndDifferentiate(
+                                nonuniform, 10.0),
+                Exception);
+    }
+}
+
+TEST_CASE("DataTable copies share data until modified") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    table.addTableMetaData<std::string>("inDegrees", "no");
+    for (int i = 0; i < 10; ++i) table.appendRow(0.1 * i, {1.0 * i, -1.0 * i});
+    const double* data = &table.getMatrix()(0, 0);
+
+    SECTION("Read-only copies do not copy the matrix") {
+        const TimeSeriesTable copy(table);
+        CHECK(&copy.getMatrix()(0, 0) == data);
+        CHECK(&table.getMatrix()(0, 0) == data);
+        CHECK(copy.getColumnLabels() == table.getColumnLabels());
+        CHECK(copy.getTableMetaDataAsString("inDegrees") == "no");
+    }
+
+    SECTION("Modifying a copy leaves the original unchanged") {
+        TimeSeriesTable copy(table);
+        copy.setRowAtIndex(2, RowVector(2, 5.0));
+        copy.appendRow(1.0, {10.0, -10.0});
+        copy.setColumnLabel(0, "c");
+        copy.removeTableMetaDataKey("inDegrees");
+        CHECK(&table.getMatrix()(0, 0) == data);
+        CHECK(table.getMatrix()(2, 0) == 2.0);
+        CHECK(table.getNumRows() == 10);
+        CHECK(table.getColumnLabel(0) == "a");
+        CHECK(table.hasTableMetaDataKey("inDegrees"));
+        CHECK(copy.getMatrix()(2, 0) == 5.0);
+        CHECK(copy.getNumRows() == 11);
+        CHECK(copy.getColumnLabel(0) == "c");
+
+        // The original is no longer shared, so it is modified in place.
+        table.setRowAtIndex(0, RowVector(2, 3.0));
+        CHECK(&table.getMatrix()(0, 0) == data);
+        CHECK(copy.getMatrix()(0, 0) == 0.0);
+    }
+
+    SECTION("Writable views are not shared with later copies") {
+        auto& view = table.updMatrix();
+        const TimeSeriesTable copy(table);
+        view(1, 1) = 42.0;
+        CHECK(table.getMatrix()(1, 1) == 42.0);
+        CHECK(copy.getMatrix()(1, 1) == -1.0);
+
+        TimeSeriesTable::TableMetaData& metadata = table.updTableMetaData();
+        const TimeSeriesTable copy2(table);
+        metadata.removeValueForKey("inDegrees");
+        CHECK_FALSE(table.hasTableMetaDataKey("inDegrees"));
+        CHECK(copy2.hasTableMetaDataKey("inDegrees"));
+    }
+
+    SECTION("Flattening and packing keep the source tables") {
+        TimeSeriesTableVec3 vec3({0.0, 0.1},
+                SimTK::Matrix_<SimTK::Vec3>(2, 1, SimTK::Vec3(1, 2, 3)),
+                {"marker"});
+        const TimeSeriesTableVec3 vec3Copy(vec3);
+        const TimeSeriesTable flat = vec3.flatten();
+        CHECK(flat.getNumColumns() == 3);
+        const TimeSeriesTableVec3 packed = flat.pack<SimTK::Vec3>();
+        CHECK(packed.getMatrix()(1, 0) == SimTK::Vec3(1, 2, 3));
+        CHECK(&vec3Copy.getMatrix()(0, 0) == &vec3.getMatrix()(0, 0));
+    }
+}
+
+TEST_CASE("Flattened and packed table views") {
+    TimeSeriesTableVec3 vec3;
+    vec3.setColumnLabels({"m0", "m1"});
+    for (int i = 0; i < 5; ++i) {
+        vec3.appendRow(0.1 * i, {SimTK::Vec3(i, 10 + i, 20 + i),
+                                 SimTK::Vec3(-i, -10 - i, -20 - i)});
+    }
+    const TimeSeriesTable flat = vec3.flatten();
+
+    SECTION("FlattenedTableView matches flatten()") {
+        const FlattenedTableView view(vec3);
+        REQUIRE(view.getNumRows() == flat.getNumRows());
+        REQUIRE(view.getNumColumns() == flat.getNumColumns());
+        CHECK(view.getColumnLabels() == flat.getColumnLabels());
+        CHECK(&view.getIndependentColumn() == &vec3.getIndependentColumn());
+        for (size_t j = 0; j < view.getNumColumns(); ++j) {
+            const auto column = view.getDependentColumnAtIndex(j);
+            const auto expected = flat.getDependentColumnAtIndex(j);
+            for (size_t i = 0; i < view.getNumRows(); ++i) {
+                CHECK(column[(int)i] == expected[(int)i]);
+                CHECK(view.getValueAtIndex(i, j) == expected[(int)i]);
+            }
+        }
+        // The view refers to the data of the table.
+        CHECK(&view.getDependentColumn("m1_2")[0] ==
+                &vec3.getMatrix()(0, 1)[1]);
+        CHECK_THROWS_AS(view.getColumnIndex("m2_1"), KeyNotFound);
+        CHECK_THROWS_AS(view.getValueAtIndex(5, 0), RowIndexOutOfRange);
+
+        const FlattenedTableView suffixed(vec3, {"_x", "_y", "_z"});
+        CHECK(suffixed.getColumnLabel(4) == "m1_y");
+        CHECK_THROWS_AS(FlattenedTableView(vec3, {"_x"}), InvalidArgument);
+
+        // Splines from the view match the splines from the flattened table.
+        const GCVSplineSet fromView(view);
+        const GCVSplineSet fromTable(flat);
+        REQUIRE(fromView.getSize() == fromTable.getSize());
+        SimTK::Vector t(1, 0.25);
+        for (int j = 0; j < fromView.getSize(); ++j) {
+            CHECK(fromView.get(j).getName() == fromTable.get(j).getName());
+            CHECK(fromView.get(j).calcValue(t) ==
+                    fromTable.get(j).calcValue(t));
+        }
+    }
+
+    SECTION("FlattenedTableView of SpatialVec") {
+        TimeSeriesTable_<SimTK::SpatialVec> spatial;
+        spatial.setColumnLabels({"f"});
+        spatial.appendRow(0, {SimTK::SpatialVec(SimTK::Vec3(1, 2, 3),
+                                                SimTK::Vec3(4, 5, 6))});
+        spatial.appendRow(1, {SimTK::SpatialVec(SimTK::Vec3(7, 8, 9),
+                                                SimTK::Vec3(10, 11, 12))});
+        const FlattenedTableView view(spatial);
+        REQUIRE(view.getNumColumns() == 6);
+        CHECK(view.getColumnLabel(5) == "f_6");
+        CHECK(view.getValueAtIndex(1, 3) == 10);
+        CHECK(view.getDependentColumnAtIndex(2)[1] == 9);
+    }
+
+    SECTION("PackedTableView_ matches pack()") {
+        const PackedTableView_<SimTK::Vec3> view(flat);
+        const TimeSeriesTableVec3 packed = flat.pack<SimTK::Vec3>();
+        CHECK(view.getColumnLabels() == packed.getColumnLabels());
+        REQUIRE(view.getNumRows() == packed.getNumRows());
+        for (size_t i = 0; i < view.getNumRows(); ++i) {
+            for (size_t j = 0; j < view.getNumColumns(); ++j) {
+                CHECK(view.getValueAtIndex(i, j) ==
+                        packed.getMatrix()((int)i, (int)j));
+            }
+        }
+        CHECK(view.getRowAtIndex(3)[1] == SimTK::Vec3(-3, -13, -23));
+        CHECK(view.getColumnIndex("m1") == 1);
+        CHECK_THROWS_AS(view.getValueAtIndex(0, 2), ColumnIndexOutOfRange);
+    }
+}
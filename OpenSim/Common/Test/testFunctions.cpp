@@ -24,11 +24,20 @@
 #include "ComponentsForTesting.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/FunctionAdapter.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Common/MultiplierFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/SignalGenerator.h>
 #include <OpenSim/Common/Sine.h>
 
+#include <algorithm>
+
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/PolynomialFunction.h>
@@ -92,6 +101,133 @@ TEST_CASE("Interpolate using PiecewiseLinearFunction") {
     SimTK_TEST(SimTK::isNaN(newY[3]));
 }
 
+TEST_CASE("calcValueAt() matches calcValue()") {
+    const int n = 50;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.02 * i + 0.001 * (i % 3);
+        y[i] = std::sin(3 * x[i]) + 0.1 * x[i] * x[i];
+    }
+    PiecewiseLinearFunction linear(n, x.data(), y.data());
+    GCVSpline spline(5, n, x.data(), y.data());
+    Sine sine(1.5, 2.0, 0.1);
+    Constant constant(0.3);
+    std::vector<const Function*> functions{
+            &linear, &spline, &sine, &constant};
+
+    for (const Function* function : functions) {
+        CAPTURE(function->getConcreteClassName());
+        // Increasing times (including the knots), then jumps backwards and
+        // forwards.
+        std::vector<double> times(x);
+        for (int i = 0; i < 115; ++i) times.push_back(0.0085 * i);
+        std::sort(times.begin(), times.end());
+        times.push_back(0.5 * x[10]);
+        times.push_back(x[n - 2]);
+        times.push_back(x[7]);
+        int interval = 0;
+        for (double t : times) {
+            const double expected = function->calcValue(SimTK::Vector(1, t));
+            CHECK(function->calcValueAt(t, &interval) ==
+                    Approx(expected).margin(1e-12));
+            CHECK(function->calcValueAt(t) == Approx(expected).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE("Scalar evaluation matches Vector evaluation") {
+    const int n = 30;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.05 * i + 0.002 * (i % 3);
+        y[i] = std::sin(3 * x[i]) + 0.1 * x[i] * x[i];
+    }
+    SimmSpline simmSpline(n, x.data(), y.data());
+    GCVSpline gcvSpline(5, n, x.data(), y.data());
+    PiecewiseLinearFunction linearInterp(n, x.data(), y.data());
+    PolynomialFunction polynomial(createVector({0.5, -1.2, 0.3, 2.0}));
+    LinearFunction linear(1.7, -0.4);
+    Constant constant(0.3);
+    std::vector<const Function*> functions{&simmSpline, &gcvSpline,
+            &linearInterp, &polynomial, &linear, &constant};
+
+    for (const Function* function : functions) {
+        CAPTURE(function->getConcreteClassName());
+        const int maxOrder = std::min(function->getMaxDerivativeOrder(), 3);
+        // SimTK::Spline and SimTK::Function::Polynomial are the reference
+        // for GCVSpline and PolynomialFunction.
+        std::unique_ptr<SimTK::Function> reference(
+                function->createSimTKFunction());
+        FunctionAdapter adapter(*function);
+        std::vector<double> args{-0.2, x[0], x[n - 1], 1.7};
+        for (int i = 0; i < 40; ++i) args.push_back(0.012 + 0.037 * i);
+        // Not at interior knots, where PiecewiseLinearFunction has no
+        // derivative.
+        args.insert(args.end(), {x[4] + 1e-4, 0.5 * (x[20] + x[21]), x[2] - 1e-4});
+        int interval = 0;
+        for (double arg : args) {
+            CAPTURE(arg);
+            const SimTK::Vector v(1, arg);
+            const double value = reference->calcValue(v);
+            CHECK(function->calcValueAt(arg, &interval) ==
+                    Approx(value).margin(1e-10));
+            CHECK(adapter.calcValue(v) == Approx(value).margin(1e-10));
+            for (int order = 1; order <= maxOrder; ++order) {
+                CAPTURE(order);
+                const SimTK::Array_<int> components(order, 0);
+                const double derivative =
+                        reference->calcDerivative(components, v);
+                CHECK(function->calcDerivativeAt(arg, order, &interval) ==
+                        Approx(derivative).margin(1e-8));
+                CHECK(function->calcDerivativeAt(arg, order) ==
+                        Approx(derivative).margin(1e-8));
+                CHECK(adapter.calcDerivative(components, v) ==
+                        Approx(derivative).margin(1e-8));
+            }
+        }
+    }
+}
+
+TEST_CASE("SimmSpline and MultiplierFunction SimTK functions") {
+    const int n = 12;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = -1.5 + 0.25 * i + 0.01 * (i % 2);
+        y[i] = std::cos(2 * x[i]) + 0.2 * x[i];
+    }
+    SimmSpline spline(n, x.data(), y.data());
+    MultiplierFunction multiplier(spline.clone(), -0.7);
+    std::vector<const Function*> functions{&spline, &multiplier};
+    for (const Function* function : functions) {
+        CAPTURE(function->getConcreteClassName());
+        std::unique_ptr<SimTK::Function> simtk(function->createSimTKFunction());
+        REQUIRE(simtk->getArgumentSize() == 1);
+        REQUIRE(simtk->getMaxDerivativeOrder() == 2);
+        // Out of range, at the knots, and between the knots, sweeping forward
+        // then jumping around so that the remembered interval is wrong.
+        std::vector<double> args{-2.0, x[0], x[n - 1], 1.8};
+        for (int i = 0; i < 60; ++i) args.push_back(-1.6 + 0.05 * i);
+        args.insert(args.end(), {x[3], 0.5 * (x[8] + x[9]), x[1] + 0.01,
+                                        x[n - 2] - 0.01, x[5]});
+        int interval = 0;
+        for (double arg : args) {
+            CAPTURE(arg);
+            const SimTK::Vector v(1, arg);
+            CHECK(simtk->calcValue(v) ==
+                    Approx(function->calcValue(v)).margin(1e-12));
+            CHECK(simtk->calcDerivative(SimTK::Array_<int>(1, 0), v) ==
+                    Approx(function->calcDerivative({0}, v)).margin(1e-12));
+            CHECK(simtk->calcDerivative(SimTK::Array_<int>(2, 0), v) ==
+                    Approx(function->calcDerivative({0, 0}, v))
+                            .margin(1e-10));
+            CHECK(function->calcValueAt(arg, &interval) ==
+                    Approx(function->calcValue(v)).margin(1e-12));
+        }
+        CHECK_THROWS(simtk->calcDerivative(
+                SimTK::Array_<int>(3, 0), SimTK::Vector(1, 0.0)));
+    }
+}
+
 TEST_CASE("MultivariatePolynomialFunction") {
     SECTION("Input errors") {
         {
@@ -20,6 +20,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -82,6 +83,55 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // Batch evaluation gives the same values as calcValue() and
+        // calcDerivative(), for increasing times and for times that jump
+        // around.
+        SimTK::Vector times(3 * size - 1);
+        for (int i = 0; i < 2 * size - 1; ++i) times[i] = dt / 2 * i;
+        for (int i = 2 * size - 1; i < 3 * size - 1; ++i)
+            times[i] = T * ((37 * i) % size) / (size - 1);
+        const std::vector<int> secondDerivComponents(2, 0);
+        for (int degree : {1, 3, 5, 7}) {
+            GCVSpline splineOfDegree(degree, size, x, y);
+            SimTK::Vector values, firstDerivs, secondDerivs;
+            splineOfDegree.calcValuesAndDerivatives(
+                    times, values, firstDerivs, secondDerivs);
+            ASSERT(values.size() == times.size());
+            for (int i = 0; i < times.size(); ++i) {
+                t[0] = times[i];
+                ASSERT_EQUAL(splineOfDegree.calcValue(t), values[i],
+                    SimTK::SignificantReal, __FILE__, __LINE__,
+                    "Batch evaluation of the GCVSpline value failed.");
+                ASSERT_EQUAL(
+                    splineOfDegree.calcDerivative(derivComponents, t),
+                    firstDerivs[i], 1e-10, __FILE__, __LINE__,
+                    "Batch evaluation of the first derivative failed.");
+                ASSERT_EQUAL(
+                    splineOfDegree.calcDerivative(secondDerivComponents, t),
+                    secondDerivs[i], 1e-8, __FILE__, __LINE__,
+                    "Batch evaluation of the second derivative failed.");
+            }
+        }
+        cout << "GCVSpline batch evaluation matches calcValue()." << endl;
+
+        // A set with a function that is not a GCVSpline.
+        GCVSplineSet set;
+        set.cloneAndAppend(spline);
+        set.adoptAndAppend(new Constant(3.0));
+        SimTK::Matrix setValues, setFirstDerivs, setSecondDerivs;
+        set.evaluate(times, setValues, setFirstDerivs, setSecondDerivs);
+        ASSERT(setValues.nrow() == times.size() && setValues.ncol() == 2);
+        for (int i = 0; i < times.size(); ++i) {
+            t[0] = times[i];
+            ASSERT_EQUAL(spline.calcValue(t), setValues(i, 0),
+                SimTK::SignificantReal, __FILE__, __LINE__,
+                "GCVSplineSet::evaluate() failed for a GCVSpline.");
+            ASSERT_EQUAL(3.0, setValues(i, 1), 0.0, __FILE__, __LINE__,
+                "GCVSplineSet::evaluate() failed for a Constant.");
+            ASSERT_EQUAL(0.0, setFirstDerivs(i, 1), 0.0, __FILE__, __LINE__,
+                "GCVSplineSet::evaluate() failed for a Constant.");
+        }
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -0,0 +1,153 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testLogger.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/LogSink.h>
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/TraceRecorder.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace OpenSim;
+
+void testAsyncLogging() {
+    auto sink = std::make_shared<StringLogSink>();
+    Logger::addSink(sink);
+    Logger::setAsync(true, 16, Logger::OverflowPolicy::Block);
+    if (!Logger::isAsync()) {
+        throw std::runtime_error("Expected asynchronous logging.");
+    }
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([i]() {
+            for (int j = 0; j < 25; ++j) log_info("thread {} message {}", i, j);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    // Stopping the background thread writes the queued messages.
+    Logger::setAsync(false);
+    Logger::removeSink(sink);
+
+    const std::string& str = sink->getString();
+    if (str.find("thread 3 message 24") == std::string::npos ||
+            std::count(str.begin(), str.end(), '\n') != 100) {
+        throw std::runtime_error("Expected all 100 messages to be logged.");
+    }
+}
+
+void testScopedThreadLog() {
+    auto globalSink = std::make_shared<StringLogSink>();
+    Logger::addSink(globalSink);
+    auto jobSinks = std::vector<std::shared_ptr<StringLogSink>>(
+            {std::make_shared<StringLogSink>(),
+                    std::make_shared<StringLogSink>()});
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([i, &jobSinks]() {
+            Logger::ScopedThreadLog scope(jobSinks[i]);
+            log_info("job {}", i);
+            log_cout("job {} cout", i);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    log_info("main thread");
+    Logger::removeSink(globalSink);
+
+    if (jobSinks[0]->getString() != "job 0\njob 0 cout\n" ||
+            jobSinks[1]->getString() != "job 1\njob 1 cout\n") {
+        throw std::runtime_error("Expected each job to log to its own sink.");
+    }
+    if (globalSink->getString() != "main thread\n") {
+        throw std::runtime_error(
+                "Expected only the main thread to log to the global sinks.");
+    }
+
+    {
+        Logger::ScopedThreadLog scope("testLogger_job.log");
+        log_info("to file");
+    }
+    std::ifstream file("testLogger_job.log");
+    std::stringstream contents;
+    contents << file.rdbuf();
+    if (contents.str().find("to file") == std::string::npos) {
+        throw std::runtime_error("Expected the message in the log file.");
+    }
+}
+
+void testTraceRecorder() {
+    TraceRecorder::stop();
+    TraceRecorder::clear();
+    { OPENSIM_TRACE_SCOPE("not recorded"); }
+    if (TraceRecorder::getNumRegions() != 0) {
+        throw std::runtime_error("Expected no regions before start().");
+    }
+
+    TraceRecorder::start();
+    {
+        OPENSIM_TRACE_SCOPE_CATEGORY("outer", "test");
+        { OPENSIM_TRACE_SCOPE_DYNAMIC(std::string("inner \"quoted\""),
+                "test"); }
+        std::thread thread([]() { OPENSIM_TRACE_SCOPE("other thread"); });
+        thread.join();
+    }
+    TraceRecorder::stop();
+    { OPENSIM_TRACE_SCOPE("not recorded"); }
+    if (TraceRecorder::getNumRegions() != 3) {
+        throw std::runtime_error("Expected 3 recorded regions.");
+    }
+
+    TraceRecorder::write("testLogger_trace.json");
+    std::ifstream file("testLogger_trace.json");
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string json = ss.str();
+    for (const std::string expected : {"\"traceEvents\"", "\"outer\"",
+                 "\"inner \\\"quoted\\\"\"", "\"other thread\"",
+                 "\"ph\":\"X\""}) {
+        if (json.find(expected) == std::string::npos) {
+            throw std::runtime_error("Expected " + expected + " in trace.");
+        }
+    }
+    if (json.find("not recorded") != std::string::npos) {
+        throw std::runtime_error("Expected inactive regions to be skipped.");
+    }
+    TraceRecorder::clear();
+}
+
+int main() {
+    try {
+        testAsyncLogging();
+        std::cout << "testAsyncLogging PASSED" << std::endl;
+        testScopedThreadLog();
+        std::cout << "testScopedThreadLog PASSED" << std::endl;
+        testTraceRecorder();
+        std::cout << "testTraceRecorder PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Done" << std::endl;
+    return 0;
+}
@@ -56,6 +56,51 @@ void testSTOFileAdapterWithMarkerData() {
     std::remove(filename.c_str());
 }
 
+// Reading only a time window gives the same average as reading all frames.
+void testAverageOfTimeWindow() {
+    const std::string filename{"dataWithNaNsOfDifferentCases.trc"};
+    MarkerData window(filename, 0.004, 0.012);
+    ASSERT(window.getNumFrames() == 3, __FILE__, __LINE__);
+    ASSERT(window.getNumMarkers() == 14, __FILE__, __LINE__);
+    ASSERT(window.getStartFrameTime() == 0.004, __FILE__, __LINE__);
+    ASSERT(window.getLastFrameTime() == 0.012, __FILE__, __LINE__);
+    ASSERT(window.getDataRate() == 250., __FILE__, __LINE__);
+
+    MarkerData all(filename);
+    all.averageFrames(-1.0, 0.004, 0.012);
+    window.averageFrames(-1.0, 0.004, 0.012);
+    ASSERT(all.getNumFrames() == 1 && window.getNumFrames() == 1,
+            __FILE__, __LINE__);
+    ASSERT(window.getStartFrameTime() == 0.004, __FILE__, __LINE__);
+    for (int i = 0; i < all.getNumMarkers(); ++i) {
+        const SimTK::Vec3 diff = all.getFrame(0).getMarker(i) -
+                                 window.getDataTable().getRowAtIndex(0)[i];
+        ASSERT(diff.norm() < 1e-12, __FILE__, __LINE__);
+    }
+
+    // Without frames in the range, all frames are read.
+    MarkerData between(filename, 0.005, 0.006);
+    ASSERT(between.getNumFrames() == 5, __FILE__, __LINE__);
+
+    // A MarkerData made from a table has the table's markers and rate.
+    TimeSeriesTableVec3 table(filename);
+    MarkerData fromTable(table, filename);
+    ASSERT(fromTable.getNumFrames() == 5, __FILE__, __LINE__);
+    ASSERT(fromTable.getMarkerIndex("lASIS") == 13, __FILE__, __LINE__);
+    ASSERT(fromTable.getUnits().getType() == Units::Millimeters,
+            __FILE__, __LINE__);
+
+    // The TRC adapter parses only the markers and frames of a filter.
+    TableReadFilter filter;
+    filter.columnLabels = {"heel"};
+    filter.initialTime = 0.008;
+    TimeSeriesTableVec3 heel(filename, filter);
+    ASSERT(heel.getNumColumns() == 1 && heel.getNumRows() == 3,
+            __FILE__, __LINE__);
+    ASSERT((heel.getRowAtIndex(0)[0] - table.getRowAtIndex(2)[2]).norm() ==
+                    0, __FILE__, __LINE__);
+}
+
 int main() {
     // Create a storage from a std file "std_storage.sto"
     try {
@@ -110,6 +155,7 @@ int main() {
         ASSERT(diff.norm() < 1e-7, __FILE__, __LINE__);
 
         testSTOFileAdapterWithMarkerData();
+        testAverageOfTimeWindow();
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -106,6 +106,9 @@ void testComponentPath() {
             { "/", "/", "" },
             { "/a", "/a", "" },
             { "/a/b", "/a/b", "" },
+            // paths to the root only step up
+            { "/a", "/", ".." },
+            { "/a/b", "/", "../.." },
         };
 
         for (const TestCase& tc : testCases) {
@@ -146,6 +149,27 @@ void testComponentPath() {
     ASSERT_THROW(Exception, CP{"/a+b+c/"});
     ASSERT_THROW(Exception, CP{"/abc*/def/g/"});
 
+    /* Test nextPathElement() and hashing */
+    {
+        auto elementsOf = [](const CP& path) {
+            std::vector<std::string> elements;
+            std::string element;
+            size_t pos = 0;
+            while (path.nextPathElement(pos, element)) {
+                elements.push_back(element);
+            }
+            return elements;
+        };
+        using Elements = std::vector<std::string>;
+        ASSERT(elementsOf(CP{"/a/bc/d"}) == (Elements{"a", "bc", "d"}));
+        ASSERT(elementsOf(CP{"../../c"}) == (Elements{"..", "..", "c"}));
+        ASSERT(elementsOf(CP{"a"}) == Elements{"a"});
+        ASSERT(elementsOf(CP{"/"}).empty());
+        ASSERT(elementsOf(CP{""}).empty());
+
+        ASSERT(std::hash<CP>()(CP{"/a/./b/"}) == std::hash<CP>()(CP{"/a/b"}));
+    }
+
     /* Test the pushBack() function */
     {
         ComponentPath path1{"/a/b"};
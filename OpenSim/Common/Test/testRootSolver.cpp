@@ -59,16 +59,35 @@ int main()
         cout << "y:\n" << y << endl;
 
         // ROOT SOLVE
+        // The example function does not depend on the state.
+        SimTK::State s;
         Array<double> a(-1.0,N), b(1.0,N), tol(1.0e-6,N);
         Array<double> roots(0.0,N);
         RootSolver solver(&function);
-        //roots = solver.solve(a,b,tol);  NOTE: JACKM need to pass in state or change CMC 
+        roots = solver.solve(s,a,b,tol);
         cout<<endl<<endl<<"-------------"<<endl;
         cout<<"roots:\n";
         cout<<roots<<endl<<endl;
         for (int i=0; i <= 100; i++){
-            //ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
+            ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
         }
+        const int numWithoutDerivative = function.getNumEquationEvaluations();
+
+        // ROOT SOLVE WITH NEWTON STEPS
+        function.setUseDerivative(true);
+        function.resetNumEquationEvaluations();
+        roots = solver.solve(s,a,b,tol);
+        for (int i=0; i <= 100; i++){
+            ASSERT_EQUAL(i*0.01, roots[i], 1e-6);
+        }
+        const int numWithDerivative = function.getNumEquationEvaluations();
+        cout << "Equations evaluated: " << numWithoutDerivative
+             << " without and " << numWithDerivative
+             << " with derivatives." << endl;
+        // Near the roots, the Newton steps converge faster than the
+        // interpolation.
+        ASSERT(numWithDerivative <= numWithoutDerivative, __FILE__, __LINE__,
+                "Expected Newton steps to need no more evaluations.");
     }
     catch (const Exception& e) {
         e.print(cerr);
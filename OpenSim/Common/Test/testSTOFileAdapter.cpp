@@ -22,8 +22,12 @@
 
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
+#include "OpenSim/Common/Storage.h"
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 #include <unordered_set>
 
 #define CATCH_CONFIG_MAIN
@@ -353,3 +357,279 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+TEST_CASE("FileAdapter::parseDouble() gives the same result as std::stod()") {
+    std::vector<std::string> strings{"0", "-0", "+1", "1.", ".5", "-.5",
+            "  3.25\t", "1e5", "1E-5", "-2.5e+3", "123456789012345",
+            "1234567890123456789", "12345678901234567890123",
+            "0.1", "0.30000000000000004", "2.2250738585072014e-308",
+            "1.7976931348623157e308", "1e-22", "1e22", "1e23", "9007199254740993",
+            "nan", "NaN", "-nan", "inf", "-Inf", "0x1p3", "1.5abc", "1e",
+            "0.000000000000000000000000000000001"};
+    // Numbers as they are written by the file adapters.
+    SimTK::Random::Uniform random(-1000, 1000);
+    random.setSeed(0);
+    for(int i = 0; i < 2000; ++i) {
+        const double value = random.getValue() * std::pow(10., i % 17 - 8);
+        std::ostringstream stream;
+        stream.precision(1 + i % 18);
+        if(i % 3 == 0) stream << std::scientific;
+        stream << value;
+        strings.push_back(stream.str());
+    }
+    for(const auto& str : strings) {
+        INFO(str);
+        const double expected = std::stod(str);
+        const double actual =
+                FileAdapter::parseDouble(str.data(), str.data() + str.size());
+        if(std::isnan(expected)) {
+            CHECK(std::isnan(actual));
+        } else {
+            CHECK(std::memcmp(&expected, &actual, sizeof(double)) == 0);
+        }
+    }
+    for(const std::string str : {"", "  ", "-", ".", "e5", "abc"}) {
+        CHECK_THROWS_AS(
+                FileAdapter::parseDouble(str.data(), str.data() + str.size()),
+                std::invalid_argument);
+    }
+}
+
+TEST_CASE("Reading data rows with CRLF line endings and padded tokens") {
+    const std::string filename = "testing_crlf_rows.sto";
+    FileRemover fileRemover(filename);
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "version=1\r\nnRows=3\r\nnColumns=3\r\ninDegrees=no\r\n"
+             << "endheader\r\n"
+             << "time\ta\tb\r\n"
+             << "0\t1.5\t -2e-3 \r\n"
+             << " 0.01 \tnan\t12345678901234567890\t\r\n"
+             << "0.02\t\t7\r\n"
+             << "\r\n"
+             << "0.03\t1\t2\r\n";
+    }
+    // The empty cell in the last row cannot be converted.
+    CHECK_THROWS_AS(TimeSeriesTable(filename), std::invalid_argument);
+
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "version=1\r\nnRows=3\r\nnColumns=3\r\ninDegrees=no\r\n"
+             << "endheader\r\n"
+             << "time\ta\tb\r\n"
+             << "0\t1.5\t -2e-3 \r\n"
+             << " 0.01 \tnan\t12345678901234567890\t\r\n"
+             << "0.02\t1e300\t7\r\n"
+             << "\r\n"
+             << "0.03\t1\t2\r\n";
+    }
+    TimeSeriesTable table(filename);
+    // Reading stops at the empty line.
+    REQUIRE(table.getNumRows() == 3);
+    REQUIRE(table.getNumColumns() == 2);
+    CHECK(table.getIndependentColumn()[1] == 0.01);
+    CHECK(table.getMatrix()(0, 0) == 1.5);
+    CHECK(table.getMatrix()(0, 1) == -2e-3);
+    CHECK(std::isnan(table.getMatrix()(1, 0)));
+    CHECK(table.getMatrix()(1, 1) == 12345678901234567890.);
+    CHECK(table.getMatrix()(2, 0) == 1e300);
+    CHECK(table.getMatrix()(2, 1) == 7);
+
+    {
+        std::ofstream file(filename);
+        file << "version=1\nnRows=1\nnColumns=3\ninDegrees=no\nendheader\n"
+             << "time\ta\tb\n"
+             << "0\t1\t2\t3\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTable(filename), RowLengthMismatch);
+
+    {
+        std::ofstream file(filename);
+        file << "version=1\nnRows=2\nnColumns=2\ninDegrees=no\n"
+             << "DataType=Vec3\nendheader\n"
+             << "time\tp\n"
+             << "0\t1,2,3\n"
+             << "1\t 4, 5 ,6, ";
+    }
+    TimeSeriesTableVec3 tableVec3(filename);
+    REQUIRE(tableVec3.getNumRows() == 2);
+    CHECK(tableVec3.getMatrix()(0, 0) == SimTK::Vec3(1, 2, 3));
+    CHECK(tableVec3.getMatrix()(1, 0) == SimTK::Vec3(4, 5, 6));
+
+    {
+        std::ofstream file(filename);
+        file << "version=1\nnRows=1\nnColumns=2\ninDegrees=no\n"
+             << "DataType=Vec3\nendheader\n"
+             << "time\tp\n"
+             << "0\t1,2\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTableVec3(filename), IncorrectNumTokens);
+}
+
+TEST_CASE("Reading a subset of the columns and rows with a TableReadFilter") {
+    const std::string filename = "std_walking2_grfs.sto";
+    const TimeSeriesTable full(filename);
+
+    TableReadFilter filter;
+    filter.columnLabels = {"p1_1", "f1_2"};
+    filter.columnLabelRegex = "m1_.*";
+    filter.initialTime = 0.1;
+    filter.finalTime = 0.3;
+    const TimeSeriesTable table(filename, filter);
+
+    // Columns keep the order of the file.
+    const std::vector<std::string> expectedLabels{
+            "f1_2", "p1_1", "m1_1", "m1_2", "m1_3"};
+    REQUIRE(table.getColumnLabels() == expectedLabels);
+    const size_t firstRow = full.getNearestRowIndexForTime(0.1);
+    const size_t lastRow = full.getNearestRowIndexForTime(0.3);
+    REQUIRE(table.getNumRows() == lastRow - firstRow + 1);
+    for (size_t r = 0; r < table.getNumRows(); ++r) {
+        CHECK(table.getIndependentColumn()[r] ==
+                full.getIndependentColumn()[firstRow + r]);
+        for (size_t c = 0; c < expectedLabels.size(); ++c) {
+            CHECK(table.getRowAtIndex(r)[(int)c] ==
+                    full.getDependentColumn(expectedLabels[c])[
+                            (int)(firstRow + r)]);
+        }
+    }
+
+    // An empty filter keeps everything.
+    const TimeSeriesTable unfiltered(filename, TableReadFilter{});
+    CHECK(unfiltered.getColumnLabels() == full.getColumnLabels());
+    CHECK(unfiltered.getNumRows() == full.getNumRows());
+
+    // A time range outside the data gives an empty table.
+    TableReadFilter late;
+    late.initialTime = 100;
+    CHECK(TimeSeriesTable(filename, late).getNumRows() == 0);
+
+    TableReadFilter missing;
+    missing.columnLabels = {"f1_2", "not_a_column"};
+    CHECK_THROWS_AS(TimeSeriesTable(filename, missing), Exception);
+
+    // Adapters that do not filter while reading (here, TRC) are filtered by
+    // the TimeSeriesTable_ constructor.
+    TableReadFilter markerFilter;
+    markerFilter.columnLabels = {"RFHD"};
+    markerFilter.finalTime = 0.5;
+    const TimeSeriesTableVec3 fullMarkers("std_walking2_markers.trc");
+    const TimeSeriesTableVec3 markers("std_walking2_markers.trc", markerFilter);
+    REQUIRE(markers.getNumColumns() == 1);
+    REQUIRE(markers.getNumRows() > 0);
+    CHECK(markers.getIndependentColumn().back() <= 0.5);
+    CHECK(markers.getRowAtIndex(0)[0] ==
+            fullMarkers.getDependentColumn("RFHD")[0]);
+}
+
+TEST_CASE("STOFileStreamWriter") {
+    const std::string filename = "testing_stream_writer.sto";
+    FileRemover fileRemover(filename);
+
+    TimeSeriesTableVec3 expected;
+    expected.setColumnLabels({"a", "b"});
+    ValueArrayDictionary metadata;
+    metadata.setValueForKey("inDegrees", std::string("no"));
+    // Ignored; the writer provides the number of rows.
+    metadata.setValueForKey("nRows", std::string("5"));
+    {
+        STOFileStreamWriterVec3 writer(filename, {"a", "b"}, metadata, 4);
+        CHECK(writer.getBufferSize() == 4);
+        for(int i = 0; i < 11; ++i) {
+            SimTK::RowVector_<SimTK::Vec3> row(2);
+            row[0] = SimTK::Vec3(i, 0.1 * i, -1.0 / (i + 1));
+            row[1] = SimTK::Vec3(std::sqrt(i + 2.0), i / 3.0, 1e-8 * i);
+            writer.appendRow(0.01 * i, row);
+            expected.appendRow(0.01 * i, row);
+        }
+        CHECK(writer.getNumRows() == 11);
+
+        SimTK::RowVector_<SimTK::Vec3> row(2, SimTK::Vec3(0));
+        CHECK_THROWS_AS(writer.appendRow(0.1, row),
+                          TimestampLessThanEqualToPrevious);
+        SimTK::RowVector_<SimTK::Vec3> shortRow(1, SimTK::Vec3(0));
+        CHECK_THROWS_AS(writer.appendRow(1.0, shortRow), IncorrectNumColumns);
+        // The destructor finalizes the file.
+    }
+
+    TimeSeriesTableVec3 table(filename);
+    CHECK(table.getTableMetaData<std::string>("nRows") == "11");
+    CHECK(table.getTableMetaData<std::string>("nColumns") == "3");
+    CHECK(table.getTableMetaData<std::string>("inDegrees") == "no");
+    REQUIRE(table.getNumRows() == expected.getNumRows());
+    CHECK(table.getColumnLabels() == expected.getColumnLabels());
+    for(size_t i = 0; i < table.getNumRows(); ++i) {
+        CHECK(table.getIndependentColumn()[i] ==
+              Approx(expected.getIndependentColumn()[i]));
+        for(int j = 0; j < 2; ++j) {
+            for(int k = 0; k < 3; ++k) {
+                CHECK(table.getRowAtIndex(i)[j][k] ==
+                      Approx(expected.getRowAtIndex(i)[j][k]));
+            }
+        }
+    }
+
+    // Closing explicitly; further rows are rejected.
+    STOFileStreamWriter writer(filename, {"x"});
+    writer.appendRow(0, SimTK::RowVector(1, 1.0));
+    writer.close();
+    CHECK(!writer.isOpen());
+    writer.close();
+    CHECK_THROWS_AS(writer.appendRow(1, SimTK::RowVector(1, 1.0)), Exception);
+    TimeSeriesTable tableDouble(filename);
+    CHECK(tableDouble.getNumRows() == 1);
+    CHECK(tableDouble.getTableMetaData<std::string>("nRows") == "1");
+
+    // The file can also be read with Storage.
+    Storage storage(filename);
+    CHECK(storage.getSize() == 1);
+}
+
+TEST_CASE("Writing numbers with a precision or in shortest round-trip form") {
+    const std::string filename = "testing_write_precision.sto";
+    FileRemover fileRemover(filename);
+
+    // Enough rows to span several of the blocks that are formatted
+    // concurrently.
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    for(int i = 0; i < 2000; ++i) {
+        const double t = 0.001 * i;
+        table.appendRow(t, {std::sin(t) / 3.0, i % 7 == 0 ? SimTK::NaN
+                                                          : 1e-9 * i * i});
+    }
+
+    // The default text is that of an std::ostream with 16 digits.
+    STOFileAdapter::write(table, filename);
+    {
+        std::ifstream file(filename);
+        std::string line;
+        while(std::getline(file, line) && line != "endheader") {}
+        std::getline(file, line);
+        CHECK(line == "time\ta\tb");
+        for(int i = 0; i < (int)table.getNumRows(); ++i) {
+            REQUIRE(std::getline(file, line));
+            std::ostringstream expected;
+            expected.precision(16);
+            expected << table.getIndependentColumn()[i] << "\t"
+                     << table.getMatrix()(i, 0) << "\t"
+                     << table.getMatrix()(i, 1);
+            CHECK(line == expected.str());
+        }
+        CHECK(!std::getline(file, line));
+    }
+
+    // The shortest round-trip form reads back to the same values.
+    STOFileAdapter::write(table, filename, 0);
+    TimeSeriesTable roundTrip(filename);
+    REQUIRE(roundTrip.getNumRows() == table.getNumRows());
+    for(int i = 0; i < (int)table.getNumRows(); ++i) {
+        CHECK(roundTrip.getIndependentColumn()[i] ==
+              table.getIndependentColumn()[i]);
+        CHECK(roundTrip.getMatrix()(i, 0) == table.getMatrix()(i, 0));
+        if(SimTK::isNaN(table.getMatrix()(i, 1)))
+            CHECK(SimTK::isNaN(roundTrip.getMatrix()(i, 1)));
+        else
+            CHECK(roundTrip.getMatrix()(i, 1) == table.getMatrix()(i, 1));
+    }
+}
@@ -37,6 +37,7 @@
 #include "SimTKcommon.h"
 
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "SerializableObject.h"
@@ -169,6 +170,177 @@ static void testPropertyOutputHelper(const SimTK::Transform& val)
     cout << propertyTransform->toString() << endl;
 }
 
+// Sets with many objects look up names with an index, which must remain
+// consistent with the objects as they are added, removed, and renamed.
+static void testSetNameLookup() {
+    ObjSet objSet;
+    for (int i = 0; i < 40; ++i) {
+        SerializableObject obj;
+        obj.setName("obj" + std::to_string(i));
+        objSet.cloneAndAppend(obj);
+    }
+    ASSERT(objSet.getIndex("obj0") == 0);
+    ASSERT(objSet.getIndex("obj39") == 39);
+    ASSERT(objSet.getIndex("obj40") == -1);
+    ASSERT(objSet.contains("obj17"));
+    ASSERT(&objSet.get("obj17") == &objSet.get(17));
+    // A start index is still honored.
+    ASSERT(objSet.getIndex("obj3", 10) == 3);
+
+    // Appended objects are found, and the first of two objects with the same
+    // name is returned.
+    SerializableObject extra;
+    extra.setName("obj5");
+    objSet.cloneAndAppend(extra);
+    extra.setName("obj40");
+    objSet.cloneAndAppend(extra);
+    ASSERT(objSet.getIndex("obj5") == 5);
+    ASSERT(objSet.getIndex("obj40") == 41);
+
+    // Renamed objects are found by their new names only.
+    objSet.get(8).setName("renamed");
+    ASSERT(objSet.getIndex("renamed") == 8);
+    ASSERT(objSet.getIndex("obj8") == -1);
+    ASSERT(objSet.getIndex("obj9") == 9);
+
+    // Removing and inserting objects shifts the indices.
+    objSet.remove(0);
+    ASSERT(objSet.getIndex("obj1") == 0);
+    ASSERT(objSet.getIndex("obj0") == -1);
+    extra.setName("first");
+    objSet.insert(0, extra.clone());
+    ASSERT(objSet.getIndex("first") == 0);
+    ASSERT(objSet.getIndex("obj39") == 39);
+    objSet.setSize(20);
+    ASSERT(objSet.getIndex("obj39") == -1);
+    ASSERT(objSet.getIndex("obj19") == 19);
+
+    // The index is not shared with copies.
+    ObjSet copy(objSet);
+    copy.get("obj19").setName("copy19");
+    ASSERT(copy.getIndex("copy19") == 19);
+    ASSERT(objSet.getIndex("obj19") == 19);
+}
+
+// Copies of a PropertyTable share its name-to-index map until one of them
+// adopts another property.
+static void testPropertyTableLookup() {
+    PropertyTable table;
+    table.adoptProperty(Property<double>::TypeHelper::create("a", true));
+    table.adoptProperty(Property<int>::TypeHelper::create("b", false));
+    ASSERT(table.findPropertyIndex("a") == 0);
+    ASSERT(table.findPropertyIndex("b") == 1);
+    ASSERT(table.findPropertyIndex("c") == -1);
+
+    PropertyTable copy(table);
+    ASSERT(copy.findPropertyIndex("b") == 1);
+    ASSERT(&copy.getAbstractPropertyByName("b") !=
+           &table.getAbstractPropertyByName("b"));
+    copy.adoptProperty(Property<std::string>::TypeHelper::create("c", true));
+    ASSERT(copy.findPropertyIndex("c") == 2);
+    ASSERT(table.findPropertyIndex("c") == -1);
+
+    PropertyTable assigned;
+    assigned = copy;
+    ASSERT(assigned.findPropertyIndex("c") == 2);
+    assigned.clear();
+    ASSERT(assigned.findPropertyIndex("a") == -1);
+    ASSERT(copy.findPropertyIndex("a") == 0);
+
+    // Objects copied from a default instance find their properties by name.
+    SerializableObject obj;
+    SerializableObject objCopy(obj);
+    ASSERT(objCopy.hasProperty("Test_Obj_2"));
+    ASSERT(objCopy.getPropertyByName("Test_Obj_2").getName() == "Test_Obj_2");
+}
+
+class CountedObject : public Object {
+    OpenSim_DECLARE_CONCRETE_OBJECT(CountedObject, Object);
+public:
+    OpenSim_DECLARE_PROPERTY(value, double, "A value.");
+    static int numDefaultConstructed;
+    CountedObject() {
+        ++numDefaultConstructed;
+        constructProperty_value(1.0);
+    }
+};
+int CountedObject::numDefaultConstructed = 0;
+
+// newInstanceOfType() default-constructs objects when that gives the same
+// object as copying the registered default object.
+static void testNewInstanceOfType() {
+    Object::registerType(CountedObject());
+    std::unique_ptr<Object> first(Object::newInstanceOfType("CountedObject"));
+    const int numConstructed = CountedObject::numDefaultConstructed;
+    std::unique_ptr<Object> second(Object::newInstanceOfType("CountedObject"));
+    ASSERT(CountedObject::numDefaultConstructed == numConstructed + 1);
+    ASSERT(second->getName() == Object::DEFAULT_NAME);
+    ASSERT(*first == *second);
+    ASSERT(*second == *Object::getDefaultInstanceOfType("CountedObject"));
+
+    // A default object with a modified property is copied instead.
+    CountedObject modified;
+    modified.set_value(2.0);
+    Object::registerType(modified);
+    std::unique_ptr<Object> third(Object::newInstanceOfType("CountedObject"));
+    ASSERT(dynamic_cast<CountedObject&>(*third).get_value() == 2.0);
+
+    // Without a known concrete type, the default object is always copied.
+    const Object& base = modified;
+    Object::registerType(base);
+    const int numConstructedBase = CountedObject::numDefaultConstructed;
+    std::unique_ptr<Object> fourth(Object::newInstanceOfType("CountedObject"));
+    ASSERT(CountedObject::numDefaultConstructed == numConstructedBase);
+    ASSERT(dynamic_cast<CountedObject&>(*fourth).get_value() == 2.0);
+
+    // Registered type names are sorted.
+    Array<std::string> names;
+    Object::getRegisteredTypenames(names);
+    for (int i = 1; i < names.getSize(); ++i) ASSERT(names[i - 1] < names[i]);
+}
+
+class LazyObject : public Object {
+    OpenSim_DECLARE_CONCRETE_OBJECT(LazyObject, Object);
+public:
+    OpenSim_DECLARE_PROPERTY(value, double, "A value.");
+    static int numDefaultConstructed;
+    LazyObject() {
+        ++numDefaultConstructed;
+        constructProperty_value(3.0);
+    }
+};
+int LazyObject::numDefaultConstructed = 0;
+
+// The default object of a lazily registered type is created on first lookup.
+static void testRegisterTypeLazily() {
+    Object::registerTypeLazily<LazyObject>();
+    ASSERT(LazyObject::numDefaultConstructed == 0);
+    Object::renameType("OldLazyObject", "LazyObject");
+    Array<std::string> names;
+    Object::getRegisteredTypenames(names);
+    ASSERT(names.findIndex("LazyObject") != -1);
+    ASSERT(LazyObject::numDefaultConstructed == 0);
+
+    const Object* defaultObj = Object::getDefaultInstanceOfType("OldLazyObject");
+    ASSERT(defaultObj != nullptr);
+    ASSERT(defaultObj->getConcreteClassName() == "LazyObject");
+    ASSERT(defaultObj->getName() == Object::DEFAULT_NAME);
+    ASSERT(Object::getDefaultInstanceOfType("LazyObject") == defaultObj);
+    std::unique_ptr<Object> obj(Object::newInstanceOfType("LazyObject"));
+    ASSERT(dynamic_cast<LazyObject&>(*obj).get_value() == 3.0);
+
+    // Lazily registered types are listed with the other registered types.
+    Object::registerTypeLazily<CountedObject>();
+    ArrayPtrs<Object> objects;
+    Object::getRegisteredObjectsOfGivenType(objects);
+    int numLazyObjects = 0;
+    for (int i = 0; i < objects.getSize(); ++i) {
+        if (objects[i]->getConcreteClassName() == "LazyObject")
+            ++numLazyObjects;
+    }
+    ASSERT(numLazyObjects == 1);
+}
+
 int main()
 {
     // Test simple stringstream functionality with SimTK::writeUnformatted
@@ -266,6 +438,11 @@ int main()
         Object::registerType(SerializableObject2());
         Object::registerType(SerializableObject3());
 
+        testSetNameLookup();
+        testPropertyTableLookup();
+        testNewInstanceOfType();
+        testRegisterTypeLazily();
+
         ObjSet objSet;
         const Set<SerializableObject>& baseSet = objSet;
 
@@ -1132,6 +1132,82 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/*
+ 5. The lookup table of a curve reproduces the exact curve, its first and
+    second derivatives to within the errors that it reports.
+*/
+void testLookupTable(SmoothSegmentedFunction mcf)
+{
+    cout << "   TEST: Lookup table " << endl;
+    SmoothSegmentedFunction exact = mcf;
+    double tol = 1e-9;
+    mcf.createLookupTable(tol);
+    SimTK_TEST(mcf.hasLookupTable());
+    SimTK_TEST(!exact.hasLookupTable());
+    int numIntervals = mcf.getLookupTableNumIntervals();
+    SimTK_TEST(numIntervals < 65536);
+    SimTK::Vec3 maxError = mcf.getLookupTableMaxError();
+    SimTK_TEST(maxError[0] <= tol && maxError[1] <= tol);
+
+    //Sample off of the table's points, including the linear extrapolation
+    //regions.
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double width = domain(1)-domain(0);
+    int n = 997;
+    for(int i=0; i <= n; i++){
+        double x = domain(0) - 0.1*width + 1.2*width*i/n;
+        SimTK_TEST_EQ_TOL(mcf.calcValue(x), exact.calcValue(x), 10*tol);
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x,1),
+                          exact.calcDerivative(x,1), 10*tol);
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x,2),
+                          exact.calcDerivative(x,2), 10*maxError[2]+tol);
+        SimTK_TEST_EQ(mcf.calcDerivative(x,3), exact.calcDerivative(x,3));
+    }
+
+    mcf.clearLookupTable();
+    SimTK_TEST(!mcf.hasLookupTable());
+    double x = domain(0) + 0.37*width;
+    SimTK_TEST_EQ(mcf.calcValue(x), exact.calcValue(x));
+    printf("   passed: %i intervals, max errors %e, %e, %e",
+           numIntervals,
+           maxError[0], maxError[1], maxError[2]);
+    cout << endl;
+}
+
+/*
+ 6. Evaluating a batch of points gives the same results as evaluating each
+    point on its own, with and without a lookup table.
+*/
+void testBatchEvaluation(SmoothSegmentedFunction mcf)
+{
+    cout << "   TEST: Batch evaluation " << endl;
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double width = domain(1)-domain(0);
+    int n = 501;
+    SimTK::Vector x(n);
+    for(int i=0; i < n; i++){
+        x[i] = domain(0) - 0.1*width + 1.2*width*i/(n-1);
+    }
+
+    for(int pass=0; pass < 2; pass++){
+        if(pass == 1) mcf.createLookupTable();
+        SimTK::Vector y;
+        mcf.calcValues(x,y);
+        SimTK_TEST(y.size() == n);
+        for(int i=0; i < n; i++){
+            SimTK_TEST(y[i] == mcf.calcValue(x[i]));
+        }
+        for(int order=1; order <= 3; order++){
+            mcf.calcDerivatives(x,order,y);
+            for(int i=0; i < n; i++){
+                SimTK_TEST(y[i] == mcf.calcDerivative(x[i],order));
+            }
+        }
+    }
+    SimTK_TEST_MUST_THROW(mcf.calcDerivatives(x,7,x));
+    cout << "   passed" << endl;
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1907,6 +1983,22 @@ int main(int argc, char* argv[])
                 fiberfalCurve.printMuscleCurveToCSVFile("C:/aBadPath",0,2.0));
             //fiberfalCurve.printMuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
             cout << "    passed"<<endl;
+
+        ///////////////////////////////////////
+        //LOOKUP TABLES
+        ///////////////////////////////////////
+            cout <<"**************************************************"<<endl;
+            cout <<"LOOKUP TABLE TESTING                              "<<endl;
+            testLookupTable(tendonCurve);
+            testLookupTable(fiberFLCurve);
+            testLookupTable(fiberFVCurve);
+            testLookupTable(fiberfalCurve);
+
+            cout <<"**************************************************"<<endl;
+            cout <<"BATCH EVALUATION TESTING                          "<<endl;
+            testBatchEvaluation(tendonCurve);
+            testBatchEvaluation(fiberFVCurve);
+            testBatchEvaluation(fiberfalCurve);
         SimTK_END_TEST();
 
     }
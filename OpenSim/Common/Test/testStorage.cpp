@@ -20,8 +20,16 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
+#include <random>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/StreamingStorage.h>
+#include <OpenSim/Common/TableUtilities.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 
@@ -170,6 +178,295 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageColumnLabelIndex() {
+    Storage sto;
+    Array<std::string> labels("", 0);
+    for (const std::string& label : {"time", "a", "hip_flexion", "a",
+                 "soleus.activation", "knee_u"}) {
+        labels.append(label);
+    }
+    sto.setColumnLabels(labels);
+    for (int i = 0; i < 3; ++i) {
+        sto.append(0.1 * i, SimTK::Vector(5, 10.0 * i));
+    }
+
+    // The hashed lookup agrees with scanning the labels, including for
+    // duplicate labels and the pre-4.0 variants.
+    const auto labelIndices = TableUtilities::createLabelIndexMap(labels);
+    for (const std::string& desired : {"a", "time", "none",
+                 "/jointset/hip/hip_flexion/value", "/forceset/soleus/activation",
+                 "/jointset/knee/knee/speed", "/a", "value"}) {
+        SimTK_TEST(TableUtilities::findStateLabelIndex(labelIndices, desired) ==
+                   TableUtilities::findStateLabelIndex(labels, desired));
+    }
+    SimTK_TEST(sto.getStateIndex("a") == 0);
+    SimTK_TEST(sto.getStateIndex("/jointset/knee/knee/speed") == 4);
+
+    // The index follows changes to the labels.
+    labels.set(1, "b");
+    sto.setColumnLabels(labels);
+    SimTK_TEST(sto.getStateIndex("a") == 2);
+    SimTK_TEST(sto.getStateIndex("b") == 0);
+    Storage copy(sto);
+    SimTK_TEST(copy.getStateIndex("b") == 0);
+
+    // Column views refer to the data without copying it.
+    const Storage::ColumnView view = sto.getDataColumnView("hip_flexion");
+    SimTK_TEST(view.size() == 3);
+    SimTK_TEST(view.getStateIndex() == 1);
+    SimTK_TEST_EQ(view[2], 20.0);
+    SimTK_TEST_EQ(view.getTime(1), 0.1);
+    sto.getStateVector(2)->setDataValue(1, 5.0);
+    SimTK_TEST_EQ(view[2], 5.0);
+    SimTK_TEST(SimTK::isNaN(sto.getDataColumnView(7)[0]));
+    SimTK_TEST_MUST_THROW(sto.getDataColumnView("none"));
+    SimTK_TEST_MUST_THROW(sto.getDataColumnView(-1));
+
+    Array<double> column;
+    sto.getDataColumn("/forceset/soleus/activation", column, 0.1);
+    SimTK_TEST(column.getSize() == 2);
+    SimTK_TEST_EQ(column[1], 20.0);
+}
+
+void testStorageDataMatrixAndResampling() {
+    Storage sto;
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    labels.append("b");
+    sto.setColumnLabels(labels);
+    sto.setInDegrees(true);
+    const int nr = 25;
+    // Non-uniform sampling.
+    for (int i = 0; i < nr; ++i) {
+        const double t = 0.1 * i + 0.01 * (i % 3);
+        SimTK::Vector row(2);
+        row[0] = sin(t);
+        row[1] = 3.0 * t * t;
+        sto.append(t, row);
+    }
+
+    // The matrix has the same values as each of the columns.
+    SimTK::Matrix data;
+    sto.getDataMatrix(data);
+    SimTK_TEST(data.nrow() == nr);
+    SimTK_TEST(data.ncol() == 2);
+    for (int j = 0; j < 2; ++j) {
+        Array<double> column;
+        sto.getDataColumn(j, column);
+        for (int i = 0; i < nr; ++i) SimTK_TEST(data(i, j) == column[i]);
+    }
+
+    // Round trip through setDataMatrix().
+    Storage copy(sto);
+    SimTK::Matrix scaled = 2.0 * data;
+    copy.setDataMatrix(scaled);
+    SimTK::Matrix roundTrip;
+    copy.getDataMatrix(roundTrip);
+    SimTK_TEST_EQ(roundTrip, scaled);
+
+    // Linear resampling gives the same values as interpolating the original
+    // data and keeps the column labels and inDegrees.
+    Storage resampled(sto);
+    const double dt = 0.037;
+    resampled.resampleLinear(dt);
+    SimTK_TEST(resampled.isInDegrees());
+    SimTK_TEST(resampled.getColumnLabels() == labels);
+    SimTK_TEST(resampled.getSize() ==
+               IO::ComputeNumberOfSteps(
+                       sto.getFirstTime(), sto.getLastTime(), dt));
+    for (int i = 0; i < resampled.getSize(); ++i) {
+        const StateVector* vec = resampled.getStateVector(i);
+        SimTK_TEST_EQ(vec->getTime(), sto.getFirstTime() + dt * i);
+        SimTK::Vector expected(2);
+        sto.getDataAtTime(vec->getTime(), 2, expected);
+        SimTK_TEST(vec->getSize() == 2);
+        for (int j = 0; j < 2; ++j) {
+            SimTK_TEST_EQ(vec->getData()[j], expected[j]);
+        }
+    }
+
+    // Padding keeps the original values in the middle of the data.
+    Storage padded(sto);
+    const int padSize = 4;
+    padded.pad(padSize);
+    SimTK_TEST(padded.getSize() == nr + 2 * padSize);
+    for (int i = 0; i < nr; ++i) {
+        const StateVector* vec = padded.getStateVector(i + padSize);
+        SimTK_TEST_EQ(vec->getTime(), sto.getStateVector(i)->getTime());
+        SimTK_TEST_EQ(vec->getData()[1], sto.getStateVector(i)->getData()[1]);
+    }
+
+    // Moving an Array leaves the source empty.
+    Array<double> source(0.0, 10);
+    Array<double> destination(std::move(source));
+    SimTK_TEST(destination.getSize() == 10);
+    SimTK_TEST(source.getSize() == 0);
+}
+
+Storage createStorageWithRows(int numRows) {
+    Storage sto(numRows);
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    sto.setColumnLabels(labels);
+    for (int i = 0; i < numRows; ++i) {
+        const double t = 0.01 * i;
+        sto.append(t, 1, &t);
+    }
+    return sto;
+}
+
+void testStorageTimeLookup() {
+    // Compare against a linear search, including times before, at, between
+    // and after the rows, and repeated times.
+    Storage sto = createStorageWithRows(500);
+    sto.append(sto.getLastTime(), SimTK::Vector(1, 1.0), false);
+    const int size = sto.getSize();
+    auto linearSearch = [&](double t) {
+        int i = 0;
+        while (i < size && !(t < sto.getStateVector(i)->getTime())) ++i;
+        return std::max(i - 1, 0);
+    };
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<double> dist(-1.0, 6.0);
+    int hint = 0;
+    for (int k = 0; k < 5000; ++k) {
+        double t = dist(engine);
+        if (k % 3 == 0) t = sto.getStateVector(k % size)->getTime();
+        const int expected = linearSearch(t);
+        SimTK_TEST(sto.findIndex(t) == expected);
+        SimTK_TEST(sto.findIndex(k % size, t) == expected);
+
+        double withHint = SimTK::NaN;
+        double withoutHint = SimTK::NaN;
+        SimTK_TEST(sto.getDataAtTime(t, 1, &withHint, hint) == 1);
+        SimTK_TEST(hint == expected);
+        sto.getDataAtTime(t, 1, &withoutHint);
+        SimTK_TEST(withHint == withoutHint);
+    }
+
+    // Benchmark: the cost of a lookup should not grow with the number of
+    // rows, whether the times advance (as during a simulation) or jump.
+    const int numLookups = 200000;
+    for (int numRows : {1000, 10000, 100000}) {
+        Storage big = createStorageWithRows(numRows);
+        const double duration = big.getLastTime();
+        double sum = 0;
+
+        int cursor = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k < numLookups; ++k) {
+            double value;
+            big.getDataAtTime(duration * k / numLookups, 1, &value, cursor);
+            sum += value;
+        }
+        const double advancing = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start).count() / numLookups;
+
+        std::uniform_real_distribution<double> times(0, duration);
+        start = std::chrono::steady_clock::now();
+        for (int k = 0; k < numLookups; ++k) {
+            sum += big.findIndex(times(engine));
+        }
+        const double random = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start).count() / numLookups;
+
+        cout << "Storage with " << numRows << " rows: " << advancing
+             << " ns per advancing lookup, " << random
+             << " ns per random lookup (checksum " << sum << ")." << endl;
+    }
+}
+
+void testStreamingStorage() {
+    Storage sto(100);
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    labels.append("b");
+    sto.setColumnLabels(labels);
+    sto.setInDegrees(true);
+    for (int i = 0; i < 100; ++i) {
+        const double t = 0.01 * i;
+        const double y[] = {std::sin(t), 1.0 + t * t};
+        sto.append(t, 2, y);
+    }
+    sto.print("testStreamingStorage.sto");
+    // Compare with the values as they were written to the file.
+    Storage expected("testStreamingStorage.sto");
+    StreamingStorage streaming("testStreamingStorage.sto");
+
+    SimTK_TEST(streaming.getSize() == expected.getSize());
+    SimTK_TEST(streaming.getColumnLabels() == expected.getColumnLabels());
+    SimTK_TEST(streaming.isInDegrees());
+    SimTK_TEST(streaming.getFirstTime() == expected.getFirstTime());
+    SimTK_TEST(streaming.getLastTime() == expected.getLastTime());
+    for (int i = 0; i < expected.getSize(); ++i) {
+        const StateVector& row = *streaming.getStateVector(i);
+        SimTK_TEST(row.getTime() == expected.getStateVector(i)->getTime());
+        SimTK_TEST(row.getData() == expected.getStateVector(i)->getData());
+    }
+    SimTK_TEST(streaming.getStateVector(expected.getSize()) == nullptr);
+
+    Array<double> streamingTimes, expectedTimes;
+    streaming.getTimeColumn(streamingTimes);
+    expected.getTimeColumn(expectedTimes);
+    SimTK_TEST(streamingTimes == expectedTimes);
+
+    Array<double> streamingColumn, expectedColumn;
+    streaming.getDataColumn("b", streamingColumn, 0.5);
+    expected.getDataColumn("b", expectedColumn, 0.5);
+    SimTK_TEST(streamingColumn == expectedColumn);
+
+    // Interpolation, at increasing (as when stepping through a states file)
+    // and decreasing times.
+    Array<double> streamingData(0.0, 2), expectedData(0.0, 2);
+    for (double t : {-0.1, 0.0, 0.123, 0.5, 0.777, 0.99, 1.5, 0.3, 0.001}) {
+        SimTK_TEST(streaming.findIndex(t) == expected.findIndex(t));
+        SimTK_TEST(streaming.getDataAtTime(t, 2, streamingData) == 2);
+        expected.getDataAtTime(t, 2, expectedData);
+        SimTK_TEST_EQ(streamingData[0], expectedData[0]);
+        SimTK_TEST_EQ(streamingData[1], expectedData[1]);
+    }
+
+    SimTK_TEST_MUST_THROW_EXC(streaming.append(1.0, SimTK::Vector(2, 0.0)),
+            OpenSim::Exception);
+}
+
+void testStoragePrintFormat() {
+    // Storage::print() formats blocks of rows concurrently; the text must be
+    // the same as for printf with IO::GetDoubleOutputFormat().
+    Storage sto;
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    labels.append("b");
+    sto.setColumnLabels(labels);
+    for (int i = 0; i < 1500; ++i) {
+        const double t = 0.01 * i;
+        const double y[] = {std::sin(t) * 1e3, -1.0 / (i + 1)};
+        sto.append(t, 2, y);
+    }
+    const std::string fileName = "testStoragePrintFormat.sto";
+    SimTK_TEST(sto.print(fileName));
+
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line) && line != "endheader") {}
+    std::getline(file, line); // Column labels.
+    const std::string format = IO::GetDoubleOutputFormat();
+    const std::string rowFormat = format + "\t" + format + "\t" + format;
+    for (int i = 0; i < sto.getSize(); ++i) {
+        SimTK_TEST(bool(std::getline(file, line)));
+        const StateVector& vec = *sto.getStateVector(i);
+        char expected[256];
+        snprintf(expected, sizeof(expected), rowFormat.c_str(), vec.getTime(),
+                vec.getData()[0], vec.getData()[1]);
+        SimTK_TEST(line == expected);
+    }
+    SimTK_TEST(!std::getline(file, line));
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +491,16 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testStorageColumnLabelIndex);
+
+        SimTK_SUBTEST(testStorageDataMatrixAndResampling);
+
+        SimTK_SUBTEST(testStorageTimeLookup);
+
+        SimTK_SUBTEST(testStreamingStorage);
+
+        SimTK_SUBTEST(testStoragePrintFormat);
     SimTK_END_TEST();
 }
 
@@ -134,6 +134,26 @@ int main() {
         auto accelTable4 = tables4.at(XsensDataReader::LinearAccelerations);
         ASSERT(accelTable4->getNumRows() == 4);
 
+        // Reading one frame at a time gives the same data as the tables.
+        auto stream = reconstructFromXML.openStream("./");
+        ASSERT(stream->getLabels() == accelTableTyped.getColumnLabels());
+        IMUDataFrame frame;
+        size_t numFrames = 0;
+        while (stream->readNextFrame(frame)) {
+            ASSERT_EQUAL(accelTableTyped.getIndependentColumn()[numFrames],
+                    frame.time, 1e-12);
+            for (int imu = 0; imu < (int)imu_names.size(); ++imu) {
+                ASSERT_EQUAL(accelTableTyped.getRowAtIndex(numFrames)[imu],
+                        frame.linearAccelerations[imu], SimTK::Eps);
+                ASSERT_EQUAL(gyroTableTyped.getRowAtIndex(numFrames)[imu],
+                        frame.angularVelocity[imu], SimTK::Eps);
+                ASSERT_EQUAL(quatTableTyped.getRowAtIndex(numFrames)[imu],
+                        frame.orientations[imu], SimTK::Eps);
+            }
+            ++numFrames;
+        }
+        ASSERT(numFrames == numRows);
+
     }
     catch (const std::exception& ex) {
         std::cout << "testXsensDataReader FAILED: " << ex.what() << std::endl;
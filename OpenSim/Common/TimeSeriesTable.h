@@ -164,7 +164,7 @@ public:
         catch (std::exception&) {
             // wipe out the data loaded if any
             this->_indData.clear();
-            this->_depData.clear();
+            this->_depData.upd().clear();
             this->removeDependentsMetaDataForKey("labels");
             throw;
         }
@@ -182,13 +182,14 @@ public:
             // because base classes cannot properly invoke virtual functions.
             this->validateDependentsMetaData();
             for (size_t i = 0; i < indVec.size(); ++i) {
-                this->validateRow(i, indVec[i], this->_depData.row(int(i)));
+                this->validateRow(i, indVec[i],
+                                  this->_depData.get().row(int(i)));
             }
         }
         catch (std::exception&) {
             // wipe out the data loaded if any
             this->_indData.clear();
-            this->_depData.clear(); // should be empty
+            this->_depData.upd().clear(); // should be empty
             this->removeDependentsMetaDataForKey("labels"); // should be empty
             throw;
         }
@@ -276,6 +277,69 @@ public:
         *this = std::move(*table);
     }
 
+    /** Construct TimeSeriesTable_ from only the columns and the time range of
+    a file selected by the filter (see TableReadFilter). For delimited text
+    files (e.g., .sto, .mot, .csv), the rest of the file is not parsed;
+    for other formats, the whole file is read and then filtered.
+
+    \param filename Name of the file.
+    \param filter Columns and time range to keep.
+    \param tablename Name of the table in the file to construct this
+                     TimeSeriesTable_ from (see above).
+
+    \throws Exception If a column listed in the filter is not in the file. */
+    TimeSeriesTable_(const std::string& filename,
+                     const TableReadFilter& filter,
+                     const std::string& tablename = "") {
+        auto absTables = FileAdapter::createAdapterFromExtension(filename)->
+                read(filename, filter);
+
+        OPENSIM_THROW_IF(absTables.size() > 1 && tablename.empty(),
+                         InvalidArgument,
+                         "File '" + filename + 
+                         "' contains more than one table and tablename not "
+                         "specified.");
+
+        AbstractDataTable* absTable{};
+        if(tablename.empty()) {
+            absTable = (absTables.cbegin()->second).get();
+        } else {
+            try {
+                absTable = absTables.at(tablename).get();
+            } catch (const std::out_of_range&) {
+                OPENSIM_THROW(InvalidArgument,
+                              "File '" + filename + "' contains no table named "
+                              "'"+ tablename + "'.");
+            }
+        }
+        auto table = dynamic_cast<TimeSeriesTable_*>(absTable);
+        OPENSIM_THROW_IF(table == nullptr,
+                         InvalidArgument,
+                         "DataTable cannot be created from file '" + filename +
+                         "'. Type mismatch.");
+
+        *this = std::move(*table);
+
+        // Apply the filter here in case the adapter did not.
+        const auto columns =
+                filter.findColumns(this->getColumnLabels(), filename);
+        for(size_t c = this->getNumColumns(); c-- > 0; ) {
+            if(!std::binary_search(columns.begin(), columns.end(), c))
+                this->removeColumnAtIndex(c);
+        }
+        const auto& times = this->getIndependentColumn();
+        size_t first = 0;
+        size_t last = times.size();
+        while(first < last && !filter.keepsTime(times[first])) ++first;
+        while(last > first && !filter.keepsTime(times[last - 1])) --last;
+        if(first == last) {
+            while(this->getNumRows())
+                this->removeRowAtIndex(this->getNumRows() - 1);
+        } else if(first > 0 || last < times.size()) {
+            trimToIndices(first, last - 1);
+        }
+    }
+
     /** Get index of row whose time is nearest/closest to the given value.
 
     \param time Value to search for.
@@ -315,6 +379,31 @@ public:
         else
             return std::distance(timeCol.begin(), std::prev(iter));
     }
+    /** Same as getNearestRowIndexForTime(time, restrictToTimeRange), but
+    the given time is first compared with the times of the rows at
+    `hint`, `hint + 1` and `hint + 2`. When stepping through the table with
+    advancing times, pass the index returned for the previous time to
+    find the row in constant time instead of with a binary search. The
+    result does not depend on the hint.                                      */
+    size_t getNearestRowIndexForTime(const double time,
+                                     const bool restrictToTimeRange,
+                                     const size_t hint) const {
+        using DT = DataTable_<double, ETY>;
+        const auto& timeCol = DT::getIndependentColumn();
+        const size_t nrow = timeCol.size();
+        const size_t end = nrow > 0 ? std::min(hint + 2, nrow - 1) : 0;
+        for (size_t i = hint; i < end; ++i) {
+            // Same tie-breaking as the binary search: when the time is
+            // halfway between two rows, the later row is nearest.
+            if (timeCol[i] == time) return i;
+            if (timeCol[i] < time && time <= timeCol[i + 1]) {
+                if ((timeCol[i + 1] - time) <= (time - timeCol[i]))
+                    return i + 1;
+                return i;
+            }
+        }
+        return getNearestRowIndexForTime(time, restrictToTimeRange);
+    }
     /** Get index of row whose time is first to be higher than the given value.
 
      \param time Value to search for.
@@ -0,0 +1,167 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  TraceRecorder.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TraceRecorder.h"
+#include "Exception.h"
+#include "Logger.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+#include <SimTKcommon/internal/Pathname.h>
+#include <SimTKcommon/internal/Timing.h>
+
+using namespace OpenSim;
+
+namespace {
+struct Region {
+    std::string name;
+    const char* category;
+    int threadId;
+    long long startTime;
+    long long duration;
+};
+
+std::atomic<bool> traceActive(false);
+std::mutex regionsMutex;
+std::vector<Region> regions;
+long long traceStartTime = 0;
+
+// Small, stable thread ids make the timeline easier to read than the ids of
+// std::thread.
+std::atomic<int> nextThreadId(1);
+int getTraceThreadId() {
+    thread_local int id = nextThreadId++;
+    return id;
+}
+
+void writeJSONString(std::ostream& stream, const std::string& text) {
+    stream << '"';
+    for (const unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            stream << '\\' << c;
+        } else if (c < 0x20) {
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << (int)c << std::dec << std::setfill(' ');
+        } else {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+// Returns the number of regions written.
+int writeRegions(const std::string& fileName) {
+    std::ofstream stream(fileName);
+    OPENSIM_THROW_IF(!stream.is_open(), Exception,
+            "Could not open '{}' for writing.", fileName);
+    std::lock_guard<std::mutex> lock(regionsMutex);
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (int i = 0; i < (int)regions.size(); ++i) {
+        const Region& region = regions[i];
+        stream << (i ? ",\n" : "\n") << "{\"name\":";
+        writeJSONString(stream, region.name);
+        stream << ",\"cat\":";
+        writeJSONString(stream, region.category);
+        stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << region.threadId
+               << ",\"ts\":" << 1e-3 * (region.startTime - traceStartTime)
+               << ",\"dur\":" << 1e-3 * region.duration << "}";
+    }
+    stream << "\n]}\n";
+    return (int)regions.size();
+}
+
+// Records the whole run of a program if OPENSIM_TRACE_FILE is set. This is
+// defined after the regions so that it is destroyed before them.
+struct EnvironmentTrace {
+    std::string fileName;
+    EnvironmentTrace() {
+        const std::string varName = "OPENSIM_TRACE_FILE";
+        if (SimTK::Pathname::environmentVariableExists(varName)) {
+            fileName = SimTK::Pathname::getEnvironmentVariable(varName);
+            if (!fileName.empty()) TraceRecorder::start();
+        }
+    }
+    ~EnvironmentTrace() {
+        if (fileName.empty()) return;
+        try {
+            // The logger may already be destroyed, so write quietly.
+            TraceRecorder::stop();
+            writeRegions(fileName);
+        } catch (...) {}
+    }
+};
+EnvironmentTrace environmentTrace;
+} // anonymous namespace
+
+void TraceRecorder::start() {
+    std::lock_guard<std::mutex> lock(regionsMutex);
+    if (regions.empty()) traceStartTime = SimTK::realTimeInNs();
+    traceActive = true;
+}
+
+void TraceRecorder::stop() { traceActive = false; }
+
+bool TraceRecorder::isActive() {
+    return traceActive.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(regionsMutex);
+    regions.clear();
+    traceStartTime = SimTK::realTimeInNs();
+}
+
+int TraceRecorder::getNumRegions() {
+    std::lock_guard<std::mutex> lock(regionsMutex);
+    return (int)regions.size();
+}
+
+void TraceRecorder::write(const std::string& fileName) {
+    const int numRegions = writeRegions(fileName);
+    log_info("Wrote {} trace regions to '{}'.", numRegions, fileName);
+}
+
+TraceRecorder::Scope::Scope(const char* name, const char* category)
+        : m_literalName(name), m_category(category) {
+    if (isActive()) m_startTime = SimTK::realTimeInNs();
+}
+
+TraceRecorder::Scope::Scope(std::string name, const char* category)
+        : m_literalName(nullptr), m_name(std::move(name)),
+          m_category(category) {
+    if (isActive()) m_startTime = SimTK::realTimeInNs();
+}
+
+TraceRecorder::Scope::~Scope() {
+    if (m_startTime < 0 || !isActive()) return;
+    const long long endTime = SimTK::realTimeInNs();
+    Region region{m_literalName ? std::string(m_literalName) : m_name,
+            m_category, getTraceThreadId(), m_startTime,
+            endTime - m_startTime};
+    std::lock_guard<std::mutex> lock(regionsMutex);
+    regions.push_back(std::move(region));
+}
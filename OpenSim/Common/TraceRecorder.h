@@ -0,0 +1,115 @@
+#ifndef OPENSIM_TRACE_RECORDER_H_
+#define OPENSIM_TRACE_RECORDER_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  TraceRecorder.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include <string>
+
+namespace OpenSim {
+
+/** Record timed regions of code, on all threads, and write them as a
+Chrome trace (JSON) file, which can be viewed as a timeline in Perfetto
+(https://ui.perfetto.dev) or chrome://tracing. Regions are marked with the
+OPENSIM_TRACE_SCOPE() macros; nested regions appear nested on the timeline
+of the thread that ran them. OpenSim marks, among others, Model::initSystem()
+and its phases, the run() of the tools, the frames solved by the
+InverseKinematicsTool, MocoStudy::solve(), the evaluations of the functions
+of MocoCasADiSolver's problem, and reading and writing of data files.
+
+When no recording is active, a region costs one check of an atomic flag.
+
+@code
+TraceRecorder::start();
+{
+    OPENSIM_TRACE_SCOPE("my pipeline");
+    model.initSystem();
+    ikTool.run();
+}
+TraceRecorder::stop();
+TraceRecorder::write("pipeline.trace.json");
+@endcode
+
+If the environment variable OPENSIM_TRACE_FILE is set, recording starts when
+the osimCommon library is loaded and the trace is written to that file when
+the program exits. */
+class OSIMCOMMON_API TraceRecorder {
+public:
+    /** Start recording regions on all threads. Regions recorded earlier are
+    kept; see clear(). */
+    static void start();
+    /** Stop recording. Regions that are still open are not recorded. */
+    static void stop();
+    static bool isActive();
+    /** Discard all recorded regions. */
+    static void clear();
+    /** The number of regions recorded so far. */
+    static int getNumRegions();
+    /** Write the recorded regions to a file in the Chrome trace event format
+    (a JSON object with a "traceEvents" array of complete events, with times
+    in microseconds since the recording started). */
+    static void write(const std::string& fileName);
+
+    /** Record the enclosing scope as a region if a recording is active when
+    the scope is entered (and still active when it is left). Use the
+    OPENSIM_TRACE_SCOPE() macros rather than this class directly. The
+    `category` must be a string literal. */
+    class OSIMCOMMON_API Scope {
+    public:
+        Scope(const char* name, const char* category);
+        Scope(std::string name, const char* category);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* m_literalName;
+        std::string m_name;
+        const char* m_category;
+        long long m_startTime = -1;
+    };
+};
+
+} // namespace OpenSim
+
+#define OPENSIM_TRACE_CONCATENATE_IMPL(a, b) a##b
+#define OPENSIM_TRACE_CONCATENATE(a, b) OPENSIM_TRACE_CONCATENATE_IMPL(a, b)
+
+/** Record the enclosing scope as a region with the given name (a string
+literal) in the "opensim" category. See TraceRecorder. */
+#define OPENSIM_TRACE_SCOPE(name)                                             \
+    OPENSIM_TRACE_SCOPE_CATEGORY(name, "opensim")
+/** Record the enclosing scope with a name (a string literal) and category
+(e.g., "model", "tool", "moco", "io"). */
+#define OPENSIM_TRACE_SCOPE_CATEGORY(name, category)                          \
+    const OpenSim::TraceRecorder::Scope OPENSIM_TRACE_CONCATENATE(            \
+            opensimTraceScope, __LINE__)(name, category)
+/** Record the enclosing scope with a name computed by an expression that
+yields a std::string (e.g., a file name). The expression is only evaluated
+while a recording is active. */
+#define OPENSIM_TRACE_SCOPE_DYNAMIC(nameExpression, category)                 \
+    const OpenSim::TraceRecorder::Scope OPENSIM_TRACE_CONCATENATE(            \
+            opensimTraceScope, __LINE__)(                                     \
+            OpenSim::TraceRecorder::isActive() ? std::string(nameExpression)  \
+                                               : std::string(),               \
+            category)
+
+#endif // OPENSIM_TRACE_RECORDER_H_
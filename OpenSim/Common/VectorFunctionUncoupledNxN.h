@@ -109,6 +109,27 @@ public:
                      "const SimTK::State&, const Array<double>&a, "
                      "Array<double>&, const Array<int>&)");
     }
+    /** Evaluate only the equations i for which aActive[i] is true; because
+    the equations are uncoupled, the other entries of rF can be left as they
+    are. RootSolver calls this with the equations that have not converged,
+    so a function can skip the work for the equations that have. The default
+    evaluates all of the equations. */
+    virtual void evaluateActive(const SimTK::State& s,
+            const Array<double> &aX, Array<double> &rF,
+            const Array<bool> &aActive) {
+        evaluate(s, aX, rF);
+    }
+    /** Whether evaluateDerivativeActive() is implemented, in which case
+    RootSolver takes (safeguarded) Newton steps. */
+    virtual bool hasDerivative() const { return false; }
+    /** Evaluate the derivative of each active equation with respect to its
+    own variable, dF_i/dx_i. */
+    virtual void evaluateDerivativeActive(const SimTK::State& s,
+            const Array<double> &aX, Array<double> &rDFdX,
+            const Array<bool> &aActive) {
+        log_error("VectorFunctionUncoupledNxN UNIMPLEMENTED: "
+                  "evaluateDerivativeActive()");
+    }
 
 //=============================================================================
 };  // END class VectorFunctionUncoupledNxN
@@ -191,6 +191,17 @@ print(const string &aFileName)
     return true;
 }
 //_____________________________________________________________________________
+/**
+ * Remove all nodes below the root element. The root's attributes (e.g., the
+ * document version) and the default objects are kept.
+ */
+void XMLDocument::
+clearRootElement()
+{
+    SimTK::Xml::Element root = getRootElement();
+    while(root.node_begin() != root.node_end())
+        root.eraseNode(root.node_begin());
+}
 
 //-----------------------------------------------------------------------------
 // FORMATTER
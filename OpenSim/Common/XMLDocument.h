@@ -166,6 +166,10 @@ public:
     //--------------------------------------------------------------------------
     /// If the filename is empty, the file is printed to cout.
     bool print(const std::string& aFileName = {});
+    /** Remove all nodes below the root element, keeping its attributes and
+    the default objects. Object::print() uses this to release the serialized
+    object tree once it has been written. */
+    void clearRootElement();
 
 //=============================================================================
 };  // END CLASS XMLDocument
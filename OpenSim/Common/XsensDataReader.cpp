@@ -4,6 +4,10 @@
 #include "FileAdapter.h"
 #include "TimeSeriesTable.h"
 #include "XsensDataReader.h"
+#include "CommonUtilities.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace OpenSim {
 
@@ -11,186 +15,273 @@ XsensDataReader* XsensDataReader::clone() const {
     return new XsensDataReader{*this};
 }
 
-DataAdapter::OutputTables 
-XsensDataReader::extendRead(const std::string& folderName) const {
-
-    std::vector<std::ifstream*> imuStreams;
-    std::vector<std::string> labels;
-    // files specified by prefix + file name exist
+struct XsensDataReader::FileLayout {
     double dataRate = SimTK::NaN;
     int packetCounterIndex = -1;
     int accIndex = -1;
     int gyroIndex = -1;
     int magIndex = -1;
     int rotationsIndex = -1;
+};
+
+namespace {
+    // The data of one sensor (file), in the order it appears in the file.
+    struct XsensFileData {
+        std::vector<SimTK::Quaternion> orientations;
+        std::vector<SimTK::Vec3> linearAccelerations;
+        std::vector<SimTK::Vec3> magneticHeading;
+        std::vector<SimTK::Vec3> angularVelocity;
+    };
+}
+
+class XsensDataReader::Stream : public IMUDataStream {
+public:
+    Stream(const std::vector<std::string>& fileNames,
+            const std::vector<std::string>& labels) {
+        _labels = labels;
+        for (const auto& fileName : fileNames) {
+            std::unique_ptr<std::ifstream> stream{new std::ifstream{fileName}};
+            OPENSIM_THROW_IF(!stream->good(), FileDoesNotExist, fileName);
+            FileLayout layout;
+            readHeader(*stream, layout);
+            OPENSIM_THROW_IF(layout.rotationsIndex == -1, TableMissingHeader);
+            if (SimTK::isNaN(_dataRate)) _dataRate = layout.dataRate;
+            _layouts.push_back(layout);
+            _streams.push_back(std::move(stream));
+        }
+        OPENSIM_THROW_IF(_layouts.empty() || SimTK::isNaN(_dataRate),
+            TableMissingHeader);
+        _hasLinearAccelerations = _layouts[0].accIndex != -1;
+        _hasMagneticHeading = _layouts[0].magIndex != -1;
+        _hasAngularVelocity = _layouts[0].gyroIndex != -1;
+    }
+
+    bool readNextFrame(IMUDataFrame& frame) override {
+        const int n_imus = (int)_streams.size();
+        frame.orientations.resize(n_imus);
+        frame.linearAccelerations.resize(n_imus);
+        frame.magneticHeading.resize(n_imus);
+        frame.angularVelocity.resize(n_imus);
+        for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+            std::vector<std::string> nextRow =
+                    FileAdapter::getNextLine(*_streams[imu_index], "\t\r");
+            if (nextRow.empty()) return false;
+            frame.linearAccelerations[imu_index] = SimTK::Vec3(SimTK::NaN);
+            frame.magneticHeading[imu_index] = SimTK::Vec3(SimTK::NaN);
+            frame.angularVelocity[imu_index] = SimTK::Vec3(SimTK::NaN);
+            parseRow(nextRow, _layouts[imu_index],
+                    frame.orientations[imu_index],
+                    frame.linearAccelerations[imu_index],
+                    frame.magneticHeading[imu_index],
+                    frame.angularVelocity[imu_index]);
+        }
+        frame.time = _time;
+        _time += 1 / _dataRate;
+        return true;
+    }
+
+private:
+    std::vector<std::unique_ptr<std::ifstream>> _streams;
+    std::vector<FileLayout> _layouts;
+    double _time = 0.0;
+};
+
+std::vector<std::string>
+XsensDataReader::getFileNames(const std::string& folderName) const {
+    // files specified by prefix + file name exist
+    std::vector<std::string> fileNames;
+    const std::string prefix = _settings.get_trial_prefix();
+    for (int index = 0; index < _settings.getProperty_ExperimentalSensors().size();
+            ++index) {
+        const ExperimentalSensor& nextItem =
+                _settings.get_ExperimentalSensors(index);
+        fileNames.push_back(folderName + prefix + nextItem.getName() + ".txt");
+    }
+    return fileNames;
+}
+
+std::vector<std::string> XsensDataReader::getLabels() const {
+    std::vector<std::string> labels;
+    for (int index = 0; index < _settings.getProperty_ExperimentalSensors().size();
+            ++index) {
+        labels.push_back(_settings.get_ExperimentalSensors(index).get_name_in_model());
+    }
+    return labels;
+}
+
+std::unique_ptr<IMUDataStream>
+XsensDataReader::openStream(const std::string& folderName) const {
+    return std::unique_ptr<IMUDataStream>(
+            new Stream(getFileNames(folderName), getLabels()));
+}
+
+DataAdapter::OutputTables 
+XsensDataReader::extendRead(const std::string& folderName) const {
 
-    int n_imus = _settings.getProperty_ExperimentalSensors().size();
-    int last_size = 1024;
-    // Will read data into pre-allocated Matrices in-memory rather than appendRow
-    // on the fly to avoid the overhead of 
-    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{ last_size, n_imus };
-    SimTK::Matrix_<SimTK::Vec3> angularVelocityData{ last_size, n_imus };
-    std::vector<double> times;
-    times.resize(last_size);
-    
-    std::string prefix = _settings.get_trial_prefix();
-    for (int index = 0; index < n_imus; ++index) {
-        std::string prefix = _settings.get_trial_prefix();
-        const ExperimentalSensor& nextItem = _settings.get_ExperimentalSensors(index);
-        auto fileName = folderName + prefix + nextItem.getName() +".txt";
-        auto* nextStream = new std::ifstream{ fileName };
-        OPENSIM_THROW_IF(!nextStream->good(),
+    const std::vector<std::string> fileNames = getFileNames(folderName);
+    const std::vector<std::string> labels = getLabels();
+    const int n_imus = (int)fileNames.size();
+
+    // Each file holds the data of one sensor, so the files are parsed
+    // concurrently and stitched together afterwards.
+    std::vector<FileLayout> layouts(n_imus);
+    std::vector<XsensFileData> fileData(n_imus);
+    parallelFor(n_imus, [&](int imu_index) {
+        const std::string& fileName = fileNames[imu_index];
+        std::ifstream stream{ fileName };
+        OPENSIM_THROW_IF(!stream.good(),
             FileDoesNotExist,
             fileName);
-        // Add imu name to labels
-        labels.push_back(nextItem.get_name_in_model());
-        // Add corresponding stream to imuStreams
-        imuStreams.push_back(nextStream);
-
-        // Skip lines to get to data
-        std::string line;
-        packetCounterIndex = -1; // Force moving file pointer to beginning of data for each stream
-        for (int j = 0; packetCounterIndex == -1; j++) {
-            std::getline(*nextStream, line);
-            if (j == 1 && SimTK::isNaN(dataRate)) { // Extract Data rate from line 1
-                std::vector<std::string> tokens = FileAdapter::tokenize(line, ", ");
-                // find Update Rate: and parse into dataRate
-                if (tokens.size() < 4) continue;
-                if (tokens[1] == "Update" && tokens[2] == "Rate:") {
-                    dataRate = std::stod(tokens[3]);
-                }
-            }
-            // Find indices for PacketCounter, Acc_{X,Y,Z}, Gyr_{X,Y,Z}, Mag_{X,Y,Z} on line 5
-            std::vector<std::string> tokens = FileAdapter::tokenize(line, "\t ");
-            // Search for Firmware Version
-            int firmwareIndex = find_index(tokens, "Firmware");
-            if (firmwareIndex != -1) {
-                auto versionString = tokens[firmwareIndex + 2];
-                // TODO Make this more general and based on documentation from Xsens which has 
-                // been hard to find. We can stretch or shrink time downstream as of now.
-                // -Ayman 12/20
-                if (versionString == "4.3.5") { 
-                    dataRate = 40;
-                }
-            }
-            packetCounterIndex = find_index(tokens, "PacketCounter");
-            if (packetCounterIndex == -1) {
-                // Could be comment, skip over
-                continue;
-            }
-            else {
-                if (accIndex == -1) accIndex = find_index(tokens, "Acc_X");
-                if (gyroIndex == -1) gyroIndex = find_index(tokens, "Gyr_X");
-                if (magIndex == -1) magIndex = find_index(tokens, "Mag_X");
-                if (rotationsIndex == -1) rotationsIndex = find_index(tokens, "Mat[1][1]");
-            } 
+        const FileLayout& layout = layouts[imu_index];
+        readHeader(stream, layouts[imu_index]);
+        OPENSIM_THROW_IF(layout.rotationsIndex == -1, TableMissingHeader);
+        XsensFileData& data = fileData[imu_index];
+        while (true) {
+            std::vector<std::string> nextRow =
+                    FileAdapter::getNextLine(stream, "\t\r");
+            if (nextRow.empty()) break;
+            SimTK::Quaternion orientation;
+            SimTK::Vec3 acc(SimTK::NaN), mag(SimTK::NaN), gyro(SimTK::NaN);
+            parseRow(nextRow, layout, orientation, acc, mag, gyro);
+            data.orientations.push_back(orientation);
+            if (layout.accIndex != -1) data.linearAccelerations.push_back(acc);
+            if (layout.magIndex != -1) data.magneticHeading.push_back(mag);
+            if (layout.gyroIndex != -1) data.angularVelocity.push_back(gyro);
         }
-    }
-    // internally keep track of what data was found in input files
-    bool foundLinearAccelerationData = (accIndex != -1);
-    bool foundMagneticHeadingData = (magIndex != -1);
-    bool foundAngularVelocityData = (gyroIndex != -1);
+    });
 
+    // The data rate is taken from the first file that specifies it.
+    double dataRate = SimTK::NaN;
+    for (const auto& layout : layouts) {
+        if (SimTK::isNaN(dataRate)) dataRate = layout.dataRate;
+    }
     // If no Orientation data is available or dataRate can't be deduced we'll abort completely
-    OPENSIM_THROW_IF((rotationsIndex == -1 || SimTK::isNaN(dataRate)),
+    OPENSIM_THROW_IF((n_imus == 0 || SimTK::isNaN(dataRate)),
         TableMissingHeader);
-    
-    // For all tables, will create row, stitch values from different files then append,time and timestep
-    // are based on the first file
-    bool done = false;
+    // internally keep track of what data was found in input files
+    bool foundLinearAccelerationData = (layouts[0].accIndex != -1);
+    bool foundMagneticHeadingData = (layouts[0].magIndex != -1);
+    bool foundAngularVelocityData = (layouts[0].gyroIndex != -1);
+
+    // The trial ends with the shortest file; time and timestep are based on
+    // the first file.
+    int rowNumber = std::numeric_limits<int>::max();
+    for (const auto& data : fileData) {
+        rowNumber = std::min(rowNumber, (int)data.orientations.size());
+    }
+    std::vector<double> times(rowNumber);
     double time = 0.0;
     double timeIncrement = 1 / dataRate;
-    int rowNumber = 0;
-    while (!done){
-        // Make vectors one per table
-        TimeSeriesTableQuaternion::RowVector
-            orientation_row_vector{ n_imus, SimTK::Quaternion() };
-        TimeSeriesTableVec3::RowVector
-            accel_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        TimeSeriesTableVec3::RowVector
-            magneto_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        TimeSeriesTableVec3::RowVector
-            gyro_row_vector{ n_imus, SimTK::Vec3(SimTK::NaN) };
-        // Cycle through the filles collating values
-        int imu_index = 0;
-        for (std::vector<std::ifstream*>::iterator it = imuStreams.begin();
-            it != imuStreams.end();
-            ++it, ++imu_index) {
-            std::ifstream* nextStream = *it;
-            // parse gyro info from imuStream
-            std::vector<std::string> nextRow = FileAdapter::getNextLine(*nextStream, "\t\r");
-            if (nextRow.empty()) {
-                done = true;
-                break;
-            }
-            if (foundLinearAccelerationData)
-                accel_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[accIndex]),
-                    std::stod(nextRow[accIndex + 1]), std::stod(nextRow[accIndex + 2]));
-            if (foundMagneticHeadingData)
-                magneto_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[magIndex]),
-                    std::stod(nextRow[magIndex + 1]), std::stod(nextRow[magIndex + 2]));
-            if (foundAngularVelocityData)
-                gyro_row_vector[imu_index] = SimTK::Vec3(std::stod(nextRow[gyroIndex]),
-                    std::stod(nextRow[gyroIndex + 1]), std::stod(nextRow[gyroIndex + 2]));
-            // Create Mat33 then convert into Quaternion
-            SimTK::Mat33 imu_matrix{ SimTK::NaN };
-            int matrix_entry_index = 0;
-            for (int mcol = 0; mcol < 3; mcol++) {
-                for (int mrow = 0; mrow < 3; mrow++) {
-                    imu_matrix[mrow][mcol] = std::stod(nextRow[rotationsIndex + matrix_entry_index]);
-                    matrix_entry_index++;
-                }
-            }
-            // Convert imu_matrix to Quaternion
-            SimTK::Rotation imu_rotation{ imu_matrix };
-            orientation_row_vector[imu_index] = imu_rotation.convertRotationToQuaternion();
-        }
-        if (done) 
-            break;
-        // append to the tables
-        times[rowNumber] = time;
-        if (foundLinearAccelerationData) 
-            linearAccelerationData[rowNumber] =  accel_row_vector;
-        if (foundMagneticHeadingData) 
-            magneticHeadingData[rowNumber] = magneto_row_vector;
-        if (foundAngularVelocityData) 
-            angularVelocityData[rowNumber] = gyro_row_vector;
-        rotationsData[rowNumber] = orientation_row_vector;
+    for (int row = 0; row < rowNumber; ++row) {
+        times[row] = time;
         time += timeIncrement;
-        rowNumber++;
-        if (std::remainder(rowNumber, last_size) == 0) {
-            // resize all Data/Matrices, double the size  while keeping data
-            int newSize = last_size*2;
-            times.resize(newSize);
-            // Repeat for Data matrices in use
-            if (foundLinearAccelerationData) linearAccelerationData.resizeKeep(newSize, n_imus);
-            if (foundMagneticHeadingData) magneticHeadingData.resizeKeep(newSize, n_imus);
-            if (foundAngularVelocityData) angularVelocityData.resizeKeep(newSize, n_imus);
-            rotationsData.resizeKeep(newSize, n_imus);
-            last_size = newSize;
+    }
+
+    // Tables could be empty if data is not present in file(s)
+    SimTK::Matrix_<SimTK::Quaternion> rotationsData{ rowNumber, n_imus };
+    SimTK::Matrix_<SimTK::Vec3> linearAccelerationData{
+            foundLinearAccelerationData ? rowNumber : 0, n_imus,
+            SimTK::Vec3(SimTK::NaN) };
+    SimTK::Matrix_<SimTK::Vec3> magneticHeadingData{
+            foundMagneticHeadingData ? rowNumber : 0, n_imus,
+            SimTK::Vec3(SimTK::NaN) };
+    SimTK::Matrix_<SimTK::Vec3> angularVelocityData{
+            foundAngularVelocityData ? rowNumber : 0, n_imus,
+            SimTK::Vec3(SimTK::NaN) };
+    for (int imu_index = 0; imu_index < n_imus; ++imu_index) {
+        const XsensFileData& data = fileData[imu_index];
+        for (int row = 0; row < rowNumber; ++row) {
+            rotationsData(row, imu_index) = data.orientations[row];
+        }
+        if (foundLinearAccelerationData && !data.linearAccelerations.empty()) {
+            for (int row = 0; row < rowNumber; ++row)
+                linearAccelerationData(row, imu_index) = data.linearAccelerations[row];
+        }
+        if (foundMagneticHeadingData && !data.magneticHeading.empty()) {
+            for (int row = 0; row < rowNumber; ++row)
+                magneticHeadingData(row, imu_index) = data.magneticHeading[row];
+        }
+        if (foundAngularVelocityData && !data.angularVelocity.empty()) {
+            for (int row = 0; row < rowNumber; ++row)
+                angularVelocityData(row, imu_index) = data.angularVelocity[row];
         }
     }
-    // Trim Matrices in use to actual data and move into tables
-    times.resize(rowNumber);
-    // Repeat for Data matrices in use and create Tables from them or size 0 for empty
-    linearAccelerationData.resizeKeep(foundLinearAccelerationData? rowNumber : 0,
-        n_imus);
-    magneticHeadingData.resizeKeep(foundMagneticHeadingData? rowNumber : 0,
-            n_imus);
-    angularVelocityData.resizeKeep(foundAngularVelocityData? rowNumber :0,
-        n_imus);
-    rotationsData.resizeKeep(rowNumber, n_imus);
 
     // Now create the tables from matrices
     // Create 4 tables for Rotations, LinearAccelerations, AngularVelocity, MagneticHeading
-    // Tables could be empty if data is not present in file(s)
     DataAdapter::OutputTables tables = createTablesFromMatrices(dataRate, labels, times,
         rotationsData, linearAccelerationData, magneticHeadingData, angularVelocityData);
     return tables;
 }
 
+void XsensDataReader::readHeader(std::istream& stream, FileLayout& layout) {
+    // Skip lines to get to data
+    std::string line;
+    for (int j = 0; std::getline(stream, line); j++) {
+        if (j == 1 && SimTK::isNaN(layout.dataRate)) { // Extract Data rate from line 1
+            std::vector<std::string> tokens = FileAdapter::tokenize(line, ", ");
+            // find Update Rate: and parse into dataRate
+            if (tokens.size() < 4) continue;
+            if (tokens[1] == "Update" && tokens[2] == "Rate:") {
+                layout.dataRate = std::stod(tokens[3]);
+            }
+        }
+        // Find indices for PacketCounter, Acc_{X,Y,Z}, Gyr_{X,Y,Z}, Mag_{X,Y,Z} on line 5
+        std::vector<std::string> tokens = FileAdapter::tokenize(line, "\t ");
+        // Search for Firmware Version
+        int firmwareIndex = find_index(tokens, "Firmware");
+        if (firmwareIndex != -1) {
+            auto versionString = tokens[firmwareIndex + 2];
+            // TODO Make this more general and based on documentation from Xsens which has 
+            // been hard to find. We can stretch or shrink time downstream as of now.
+            // -Ayman 12/20
+            if (versionString == "4.3.5") { 
+                layout.dataRate = 40;
+            }
+        }
+        layout.packetCounterIndex = find_index(tokens, "PacketCounter");
+        if (layout.packetCounterIndex != -1) {
+            layout.accIndex = find_index(tokens, "Acc_X");
+            layout.gyroIndex = find_index(tokens, "Gyr_X");
+            layout.magIndex = find_index(tokens, "Mag_X");
+            layout.rotationsIndex = find_index(tokens, "Mat[1][1]");
+            break;
+        }
+        // Could be comment, skip over
+    }
+}
+
+void XsensDataReader::parseRow(const std::vector<std::string>& nextRow,
+        const FileLayout& layout, SimTK::Quaternion& orientation,
+        SimTK::Vec3& linearAcceleration, SimTK::Vec3& magneticHeading,
+        SimTK::Vec3& angularVelocity) {
+    const int accIndex = layout.accIndex;
+    const int magIndex = layout.magIndex;
+    const int gyroIndex = layout.gyroIndex;
+    if (accIndex != -1)
+        linearAcceleration = SimTK::Vec3(std::stod(nextRow[accIndex]),
+            std::stod(nextRow[accIndex + 1]), std::stod(nextRow[accIndex + 2]));
+    if (magIndex != -1)
+        magneticHeading = SimTK::Vec3(std::stod(nextRow[magIndex]),
+            std::stod(nextRow[magIndex + 1]), std::stod(nextRow[magIndex + 2]));
+    if (gyroIndex != -1)
+        angularVelocity = SimTK::Vec3(std::stod(nextRow[gyroIndex]),
+            std::stod(nextRow[gyroIndex + 1]), std::stod(nextRow[gyroIndex + 2]));
+    // Create Mat33 then convert into Quaternion
+    SimTK::Mat33 imu_matrix{ SimTK::NaN };
+    int matrix_entry_index = 0;
+    for (int mcol = 0; mcol < 3; mcol++) {
+        for (int mrow = 0; mrow < 3; mrow++) {
+            imu_matrix[mrow][mcol] = std::stod(
+                    nextRow[layout.rotationsIndex + matrix_entry_index]);
+            matrix_entry_index++;
+        }
+    }
+    // Convert imu_matrix to Quaternion
+    SimTK::Rotation imu_rotation{ imu_matrix };
+    orientation = imu_rotation.convertRotationToQuaternion();
+}
+
 int XsensDataReader::find_index(std::vector<std::string>& tokens, const std::string& keyToMatch) {
     int returnIndex = -1;
     std::vector<std::string>::iterator it = std::find(tokens.begin(), tokens.end(), keyToMatch);
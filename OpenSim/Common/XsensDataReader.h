@@ -86,7 +86,29 @@ public:
     XsensDataReaderSettings& updSettings() {
         return _settings;
     }
+    /** Open the files of a trial (see extendRead()) for reading one frame at
+    a time. */
+    std::unique_ptr<IMUDataStream> openStream(
+            const std::string& folderName) const override;
  private:
+    // Location of the data in the columns of a single file.
+    struct FileLayout;
+    class Stream;
+    /**
+     * Read the header of a file up to (and including) the line with the
+     * column labels.
+     */
+    static void readHeader(std::istream& stream, FileLayout& layout);
+    /**
+     * Parse the data of one sensor from a line of its file. Data that is not
+     * in the file is left untouched.
+     */
+    static void parseRow(const std::vector<std::string>& tokens,
+            const FileLayout& layout, SimTK::Quaternion& orientation,
+            SimTK::Vec3& linearAcceleration, SimTK::Vec3& magneticHeading,
+            SimTK::Vec3& angularVelocity);
+    std::vector<std::string> getFileNames(const std::string& folderName) const;
+    std::vector<std::string> getLabels() const;
     /**
      * Find index of searchString in tokens
      */
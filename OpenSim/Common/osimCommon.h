@@ -26,6 +26,9 @@
 #include "About.h"
 #include "Adapters.h"
 #include "CommonUtilities.h"
+#include "ComponentPhaseProfiler.h"
+#include "ComponentRealizeProfiler.h"
+#include "ComponentConcurrencyChecker.h"
 #include "Constant.h"
 #include "DataTable.h"
 #include "FunctionSet.h"
@@ -54,8 +57,10 @@
 #include "StepFunction.h"
 #include "Stopwatch.h"
 #include "StorageInterface.h"
+#include "StreamingStorage.h"
 #include "TableSource.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include "TraceRecorder.h"
 
 #endif // OPENSIM_OSIMCOMMON_H_
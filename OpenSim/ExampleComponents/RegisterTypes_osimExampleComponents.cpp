@@ -44,9 +44,9 @@ OSIMEXAMPLECOMPONENTS_API void RegisterTypes_osimExampleComponents()
 {
   try {
 
-      Object::registerType( ToyReflexController() );
-      Object::registerType( ToyPropMyoController() );
-      Object::registerType( HopperDevice() );
+      Object::registerTypeLazily<ToyReflexController>();
+      Object::registerTypeLazily<ToyPropMyoController>();
+      Object::registerTypeLazily<HopperDevice>();
     
   } catch (const std::exception& e) {
     std::cerr 
@@ -39,8 +39,8 @@ static dllPluginObjectInstantiator dInstantiator;
  */
 OSIMEXPPLUGIN_API void RegisterTypes_osimPlugin()
 {
-    //Object::registerType( MyAnalysis() );
-    Object::registerType( SymbolicExpressionReporter() );
+    //Object::registerTypeLazily<MyAnalysis>();
+    Object::registerTypeLazily<SymbolicExpressionReporter>();
 }
 
 dllPluginObjectInstantiator::dllPluginObjectInstantiator() 
@@ -80,7 +80,12 @@ const SimTK::Vector& AccelerationMotion::getUDot(
 
 void AccelerationMotion::setEnabled(
         SimTK::State& state, bool enabled) const {
+    // Enabling or disabling a Motion invalidates Stage::Instance, even if the
+    // Motion is already in the requested state. Solvers call this for every
+    // evaluation of the dynamics, so we avoid discarding the realized
+    // kinematics when nothing changes.
     for (auto& motion : m_motions) {
+        if (motion.isDisabled(state) != enabled) { continue; }
         if (enabled) {
             motion.enable(state);
         } else {
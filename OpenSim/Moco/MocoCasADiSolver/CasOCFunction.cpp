@@ -18,7 +18,15 @@
 
 #include "CasOCFunction.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <thread>
+
 #include "CasOCProblem.h"
+#include <OpenSim/Common/TraceRecorder.h>
 
 using namespace CasOC;
 
@@ -73,10 +81,92 @@ casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
     return combinedSparsity;
 }
 
+bool SparsityCache::read(const std::string& fileName) {
+    std::ifstream stream(fileName);
+    if (!stream.good()) return false;
+    std::string header, keyLine;
+    std::getline(stream, header);
+    std::getline(stream, keyLine);
+    if (header != "CasOC sparsity cache" || keyLine != "key=" + m_key) {
+        return false;
+    }
+    std::map<std::string, casadi::Sparsity> patterns;
+    std::string word, name;
+    casadi_int numRows, numCols, nnz;
+    while (stream >> word >> name >> numRows >> numCols >> nnz) {
+        OPENSIM_THROW_IF(word != "function", OpenSim::Exception,
+                "Unexpected entry '{}' in sparsity cache '{}'.", word,
+                fileName);
+        std::vector<casadi_int> rows(nnz), cols(nnz);
+        for (casadi_int k = 0; k < nnz; ++k) stream >> rows[k] >> cols[k];
+        OPENSIM_THROW_IF(!stream, OpenSim::Exception,
+                "The pattern for '{}' in sparsity cache '{}' is incomplete.",
+                name, fileName);
+        patterns[name] = casadi::Sparsity::triplet(numRows, numCols, rows, cols);
+    }
+    m_patterns = std::move(patterns);
+    m_modified = false;
+    return true;
+}
+
+void SparsityCache::write(const std::string& fileName) const {
+    const std::string tempFileName =
+            fileName + "." +
+            std::to_string(std::hash<std::thread::id>()(
+                    std::this_thread::get_id())) +
+            ".tmp";
+    {
+        std::ofstream stream(tempFileName);
+        OPENSIM_THROW_IF(!stream.good(), OpenSim::Exception,
+                "Could not open '{}' for writing the sparsity cache.",
+                tempFileName);
+        stream << "CasOC sparsity cache\n"
+               << "key=" << m_key << "\n";
+        for (const auto& entry : m_patterns) {
+            const casadi::Sparsity& sparsity = entry.second;
+            std::vector<casadi_int> rows, cols;
+            sparsity.get_triplet(rows, cols);
+            stream << "function " << entry.first << " " << sparsity.size1()
+                   << " " << sparsity.size2() << " " << rows.size() << "\n";
+            for (std::size_t k = 0; k < rows.size(); ++k) {
+                stream << rows[k] << " " << cols[k] << "\n";
+            }
+        }
+    }
+    std::remove(fileName.c_str());
+    OPENSIM_THROW_IF(std::rename(tempFileName.c_str(), fileName.c_str()) != 0,
+            OpenSim::Exception, "Could not write the sparsity cache '{}'.",
+            fileName);
+}
+
+bool SparsityCache::find(const std::string& name, casadi_int numRows,
+        casadi_int numCols, casadi::Sparsity& sparsity) const {
+    const auto it = m_patterns.find(name);
+    if (it == m_patterns.end() || it->second.size1() != numRows ||
+            it->second.size2() != numCols) {
+        return false;
+    }
+    sparsity = it->second;
+    return true;
+}
+
+void SparsityCache::insert(
+        const std::string& name, const casadi::Sparsity& sparsity) {
+    m_patterns[name] = sparsity;
+    m_modified = true;
+}
+
 casadi::Sparsity Function::get_jacobian_sparsity() const {
     using casadi::DM;
     using casadi::Slice;
 
+    SparsityCache* cache = m_casProblem->getSparsityCache();
+    casadi::Sparsity cached;
+    if (cache &&
+            cache->find(name(), nnz_out(), nnz_in(), cached)) {
+        return cached;
+    }
+
     auto function = [this](const casadi::DM& x, casadi::DM& y) {
         // Split input into separate DMs.
         std::vector<casadi::DM> in(this->n_in());
@@ -100,8 +190,10 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
 
     const VectorDM x0s = getSubsetPointsForSparsityDetection();
 
-    return calcJacobianSparsityWithPerturbation(
+    const casadi::Sparsity sparsity = calcJacobianSparsityWithPerturbation(
             x0s, (int)this->nnz_out(), function);
+    if (cache) cache->insert(name(), sparsity);
+    return sparsity;
 }
 
 void Function::constructFunction(const Problem* casProblem,
@@ -111,11 +203,138 @@ void Function::constructFunction(const Problem* casProblem,
     m_casProblem = casProblem;
     m_finite_difference_scheme = finiteDiffScheme;
     m_fullPointsForSparsityDetection = pointsForSparsityDetection;
+    {
+        std::lock_guard<std::mutex> lock(m_profileMutex);
+        m_numCalls = 0;
+        m_totalTime = 0;
+        m_threadIds.clear();
+    }
     casadi::Dict opts;
     setCommonOptions(opts);
     this->construct(name, opts);
 }
 
+VectorDM Function::eval(const VectorDM& args) const {
+    OPENSIM_TRACE_SCOPE_DYNAMIC(name(), "moco");
+    const auto start = std::chrono::steady_clock::now();
+    VectorDM out = evalImpl(args);
+    const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lock(m_profileMutex);
+    ++m_numCalls;
+    m_totalTime += elapsed.count();
+    m_threadIds.insert(std::this_thread::get_id());
+    return out;
+}
+
+FunctionProfile Function::getProfile() const {
+    std::lock_guard<std::mutex> lock(m_profileMutex);
+    FunctionProfile profile;
+    profile.name = name();
+    profile.numCalls = m_numCalls;
+    profile.totalTime = m_totalTime;
+    profile.numThreads = (int)m_threadIds.size();
+    return profile;
+}
+
+VectorDM Function::evalBatchImpl(const VectorDM& args, int numThreads) const {
+    using casadi::Slice;
+    const int numPoints = (int)args.at(0).size2();
+    std::vector<VectorDM> pointOutputs(numPoints);
+    auto evalPoints = [&](int begin, int end) {
+        VectorDM pointArgs(args.size());
+        for (int ipoint = begin; ipoint < end; ++ipoint) {
+            for (int iin = 0; iin < (int)args.size(); ++iin) {
+                pointArgs[iin] = args[iin](Slice(), ipoint);
+            }
+            pointOutputs[ipoint] = eval(pointArgs);
+        }
+    };
+
+    numThreads = std::max(1, std::min(numThreads, numPoints));
+    if (numThreads == 1) {
+        evalPoints(0, numPoints);
+    } else {
+        // Each thread evaluates a contiguous block of points.
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> exceptions(numThreads);
+        for (int ithread = 0; ithread < numThreads; ++ithread) {
+            const int begin = ithread * numPoints / numThreads;
+            const int end = (ithread + 1) * numPoints / numThreads;
+            threads.emplace_back([&, ithread, begin, end] {
+                try {
+                    evalPoints(begin, end);
+                } catch (...) {
+                    exceptions[ithread] = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (const auto& exception : exceptions) {
+            if (exception) std::rethrow_exception(exception);
+        }
+    }
+
+    VectorDM out(n_out());
+    for (int iout = 0; iout < (int)out.size(); ++iout) {
+        out[iout] = casadi::DM(size1_out(iout), numPoints);
+        for (int ipoint = 0; ipoint < numPoints; ++ipoint) {
+            out[iout](Slice(), ipoint) = pointOutputs[ipoint][iout];
+        }
+    }
+    return out;
+}
+
+void BatchFunction::constructFunction(const Function* pointFunction,
+        int numPoints, int numThreads, const std::string& finiteDiffScheme) {
+    for (casadi_int iin = 0; iin < pointFunction->n_in(); ++iin) {
+        OPENSIM_THROW_IF(pointFunction->size2_in(iin) != 1 ||
+                                 !pointFunction->sparsity_in(iin).is_dense(),
+                OpenSim::Exception, "Internal error.");
+    }
+    for (casadi_int iout = 0; iout < pointFunction->n_out(); ++iout) {
+        OPENSIM_THROW_IF(pointFunction->size2_out(iout) != 1 ||
+                                 !pointFunction->sparsity_out(iout).is_dense(),
+                OpenSim::Exception, "Internal error.");
+    }
+    m_pointFunction = pointFunction;
+    m_numPoints = numPoints;
+    m_numThreads = numThreads;
+    casadi::Dict opts;
+    opts["enable_fd"] = true;
+    opts["fd_method"] = finiteDiffScheme;
+    this->construct(pointFunction->name() + "_batch", opts);
+}
+
+casadi::Sparsity BatchFunction::get_jacobian_sparsity() const {
+    // The inputs (outputs) are stacked, and the columns of each input
+    // (output) are stacked. The entries for point k are offset by k times
+    // the size of the input (output).
+    std::vector<casadi_int> rows, cols;
+    casadi_int outputOffset = 0;
+    for (casadi_int iout = 0; iout < m_pointFunction->n_out(); ++iout) {
+        const casadi_int numRows = m_pointFunction->size1_out(iout);
+        casadi_int inputOffset = 0;
+        for (casadi_int iin = 0; iin < m_pointFunction->n_in(); ++iin) {
+            const casadi_int numCols = m_pointFunction->size1_in(iin);
+            std::vector<casadi_int> blockRows, blockCols;
+            m_pointFunction->sparsity_jac(iin, iout).get_triplet(
+                    blockRows, blockCols);
+            for (casadi_int ipoint = 0; ipoint < m_numPoints; ++ipoint) {
+                for (size_t inz = 0; inz < blockRows.size(); ++inz) {
+                    rows.push_back(outputOffset + ipoint * numRows +
+                                   blockRows[inz]);
+                    cols.push_back(inputOffset + ipoint * numCols +
+                                   blockCols[inz]);
+                }
+            }
+            inputOffset += numCols * m_numPoints;
+        }
+        outputOffset += numRows * m_numPoints;
+    }
+    return casadi::Sparsity::triplet(outputOffset, nnz_in(), rows, cols);
+}
+
 casadi::Sparsity Function::get_sparsity_in(casadi_int i) {
     if (i == 0) {
         return casadi::Sparsity::dense(1, 1);
@@ -134,7 +353,7 @@ casadi::Sparsity Function::get_sparsity_in(casadi_int i) {
     }
 }
 
-VectorDM PathConstraint::eval(const VectorDM& args) const {
+VectorDM PathConstraint::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(sparsity_out(0))};
@@ -142,7 +361,7 @@ VectorDM PathConstraint::eval(const VectorDM& args) const {
     return out;
 }
 
-VectorDM CostIntegrand::eval(const VectorDM& args) const {
+VectorDM CostIntegrand::evalImpl(const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -150,7 +369,8 @@ VectorDM CostIntegrand::eval(const VectorDM& args) const {
     return out;
 }
 
-VectorDM EndpointConstraintIntegrand::eval(const VectorDM& args) const {
+VectorDM EndpointConstraintIntegrand::evalImpl(
+        const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
                                    args.at(3), args.at(4), args.at(5)};
     VectorDM out{casadi::DM(casadi::Sparsity::scalar())};
@@ -188,7 +408,7 @@ casadi::Sparsity Endpoint::get_sparsity_in(casadi_int i) {
         return casadi::Sparsity(0, 0);
     }
 }
-VectorDM Cost::eval(const VectorDM& args) const {
+VectorDM Cost::evalImpl(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -196,7 +416,7 @@ VectorDM Cost::eval(const VectorDM& args) const {
     m_casProblem->calcCost(m_index, input, out.at(0));
     return out;
 }
-VectorDM EndpointConstraint::eval(const VectorDM& args) const {
+VectorDM EndpointConstraint::evalImpl(const VectorDM& args) const {
     Problem::CostInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5).scalar(), args.at(6), args.at(7),
             args.at(8), args.at(9), args.at(10), args.at(11).scalar()};
@@ -230,7 +450,7 @@ casadi::Sparsity MultibodySystemExplicit<CalcKCErrors>::get_sparsity_out(
 }
 
 template <bool CalcKCErrors>
-VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
+VectorDM MultibodySystemExplicit<CalcKCErrors>::evalImpl(
         const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
@@ -283,7 +503,7 @@ casadi::DM VelocityCorrection::getSubsetPoint(
             fullPoint.at(slacks)(Slice(), itime), fullPoint.at(parameters)});
 }
 
-VectorDM VelocityCorrection::eval(const VectorDM& args) const {
+VectorDM VelocityCorrection::evalImpl(const VectorDM& args) const {
     VectorDM out{casadi::DM(sparsity_out(0))};
     m_casProblem->calcVelocityCorrection(
             args.at(0).scalar(), args.at(1), args.at(2), args.at(3), out[0]);
@@ -315,7 +535,7 @@ casadi::Sparsity MultibodySystemImplicit<CalcKCErrors>::get_sparsity_out(
 }
 
 template <bool CalcKCErrors>
-VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
+VectorDM MultibodySystemImplicit<CalcKCErrors>::evalImpl(
         const VectorDM& args) const {
     Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
             args.at(3), args.at(4), args.at(5)};
@@ -20,6 +20,12 @@
 
 #include "CasOCIterate.h"
 
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
 #include <OpenSim/Common/Exception.h>
 
 namespace CasOC {
@@ -28,6 +34,48 @@ class Problem;
 
 using VectorDM = std::vector<casadi::DM>;
 
+/// Jacobian sparsity patterns of CasOC::Function%s, by function name, that
+/// can be saved to and loaded from a file so that later solves of the same
+/// problem do not need to detect them again. The file contains a key (e.g., a
+/// hash of the model and problem); patterns are only loaded from a file with
+/// the same key.
+class SparsityCache {
+public:
+    explicit SparsityCache(std::string key) : m_key(std::move(key)) {}
+    /// Load the patterns from the file. Returns false (and loads nothing) if
+    /// the file does not exist or was written with a different key.
+    bool read(const std::string& fileName);
+    /// Write the patterns to the file, replacing it. The file is first written
+    /// under a temporary name and then renamed so that concurrent solves
+    /// never read a partially-written file.
+    void write(const std::string& fileName) const;
+    /// Obtain the pattern for a function with the given size of its
+    /// Jacobian, if there is one.
+    bool find(const std::string& name, casadi_int numRows, casadi_int numCols,
+            casadi::Sparsity& sparsity) const;
+    void insert(const std::string& name, const casadi::Sparsity& sparsity);
+    int getNumPatterns() const { return (int)m_patterns.size(); }
+    /// Were patterns inserted since the patterns were read?
+    bool isModified() const { return m_modified; }
+
+private:
+    std::string m_key;
+    std::map<std::string, casadi::Sparsity> m_patterns;
+    bool m_modified = false;
+};
+
+/// The number of evaluations of a CasOC::Function and the wall-clock time
+/// spent in them. This includes the evaluations for finite-difference
+/// derivatives and for sparsity detection.
+struct FunctionProfile {
+    std::string name;
+    int numCalls = 0;
+    /// In seconds, summed over all threads.
+    double totalTime = 0;
+    /// The number of distinct threads that evaluated the function.
+    int numThreads = 0;
+};
+
 class Function : public casadi::Callback {
 public:
     virtual ~Function() = default;
@@ -41,6 +89,14 @@ public:
         opts["fd_method"] = getFiniteDifferenceScheme();
         // Using "forward", iterations are 10x faster but problems are less
         // likely to converge.
+        // CasADi perturbs the Jacobian columns in the order of the inputs,
+        // and the states are ordered as coordinates, speeds, and auxiliary
+        // states. Therefore, the perturbations of the same kind of variable
+        // are consecutive, and the perturbations of auxiliary states,
+        // controls, multipliers, and derivatives all use the same
+        // coordinates and speeds. MocoCasOCProblem relies on this to avoid
+        // realizing the position and velocity stages for those
+        // perturbations.
     }
     std::string getFiniteDifferenceScheme() {
         return m_finite_difference_scheme;
@@ -63,7 +119,27 @@ public:
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
 
+    /// This records the number of calls and the time spent in evalImpl().
+    VectorDM eval(const VectorDM& args) const override final;
+    /// The profile is reset when the function is constructed.
+    FunctionProfile getProfile() const;
+
+    /// Evaluate the function at many points at once; each column of the
+    /// inputs and outputs belongs to one point. This is used by
+    /// BatchFunction, and uses evalBatchImpl().
+    VectorDM evalBatch(const VectorDM& args, int numThreads) const {
+        return evalBatchImpl(args, numThreads);
+    }
+
 protected:
+    virtual VectorDM evalImpl(const VectorDM& args) const = 0;
+    /// The default implementation evaluates the points one at a time with
+    /// eval() (so they are included in the profile), splitting the points
+    /// among `numThreads` threads. Override this to evaluate all points
+    /// together (e.g., with a vectorized implementation of the model).
+    virtual VectorDM evalBatchImpl(
+            const VectorDM& args, int numThreads) const;
+
     const Problem* m_casProblem;
 
 private:
@@ -91,6 +167,54 @@ private:
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
+
+    // CasADi may evaluate the function from multiple threads.
+    mutable std::mutex m_profileMutex;
+    mutable int m_numCalls = 0;
+    mutable double m_totalTime = 0;
+    mutable std::set<std::thread::id> m_threadIds;
+};
+
+/// A function that evaluates a Function at all points of a trajectory in a
+/// single call. Each input and output has one column per point. The
+/// transcription evaluates functions with this instead of with
+/// casadi::Function::map() if Solver::getBatchEvaluation() is true. When
+/// CasADi computes derivatives of this function with finite differences,
+/// each perturbation is applied to all points at once (the points do not
+/// depend on each other, so the Jacobian is block diagonal), so each
+/// evaluation of this function is an evaluation of a whole batch of points.
+class BatchFunction : public casadi::Callback {
+public:
+    void constructFunction(const Function* pointFunction, int numPoints,
+            int numThreads, const std::string& finiteDiffScheme);
+    casadi_int get_n_in() override { return m_pointFunction->n_in(); }
+    casadi_int get_n_out() override { return m_pointFunction->n_out(); }
+    std::string get_name_in(casadi_int i) override {
+        return m_pointFunction->name_in(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_pointFunction->name_out(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        return casadi::Sparsity::dense(
+                m_pointFunction->size1_in(i), m_numPoints);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int i) override {
+        return casadi::Sparsity::dense(
+                m_pointFunction->size1_out(i), m_numPoints);
+    }
+    bool has_jacobian_sparsity() const override { return true; }
+    /// The pattern is assembled from the pattern of the point function
+    /// (copied for each point).
+    casadi::Sparsity get_jacobian_sparsity() const override;
+    VectorDM eval(const VectorDM& args) const override {
+        return m_pointFunction->evalBatch(args, m_numThreads);
+    }
+
+private:
+    const Function* m_pointFunction = nullptr;
+    int m_numPoints = 0;
+    int m_numThreads = 1;
 };
 
 class PathConstraint : public Function {
@@ -117,7 +241,7 @@ public:
         } else
             return casadi::Sparsity(0, 0);
     }
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 
 protected:
     int m_index = -1;
@@ -154,12 +278,12 @@ protected:
 
 class CostIntegrand : public Integrand {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 class EndpointConstraintIntegrand : public Integrand {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This function takes initial states/controls, final states/controls, and an
@@ -241,13 +365,13 @@ protected:
 /// This invokes CasOC::Problem::calcCost().
 class Cost : public Endpoint {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This invokes CasOC::Problem::calcEndpointConstraint().
 class EndpointConstraint : public Endpoint {
 public:
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 
 };
 
@@ -267,7 +391,7 @@ public:
         }
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -293,7 +417,7 @@ public:
     }
     casadi::Sparsity get_sparsity_in(casadi_int i) override final;
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
     casadi::DM getSubsetPoint(const VariablesDM& fullPoint) const override;
 };
 
@@ -310,7 +434,7 @@ class MultibodySystemImplicit : public Function {
         }
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
-    VectorDM eval(const VectorDM& args) const override;
+    VectorDM evalImpl(const VectorDM& args) const override;
 };
 
 } // namespace CasOC
@@ -0,0 +1,124 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: CasOCLegendreGaussRadau.cpp                                  *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "CasOCLegendreGaussRadau.h"
+
+using casadi::DM;
+using casadi::MX;
+using casadi::Slice;
+
+namespace CasOC {
+
+LegendreGaussRadau::LegendreGaussRadau(
+        const Solver& solver, const Problem& problem, int degree)
+        : Transcription(solver, problem), m_degree(degree) {
+    OPENSIM_THROW_IF(degree < 1 || degree > 9, OpenSim::Exception,
+            "Expected the Legendre-Gauss-Radau degree to be between 1 and 9, "
+            "but got {}.",
+            degree);
+
+    // CasADi's "radau" points are the LGR points on (0, 1], including 1.
+    m_points.push_back(0);
+    for (const auto& point : casadi::collocation_points(degree, "radau")) {
+        m_points.push_back(point);
+    }
+    const int numPoints = degree + 1;
+
+    // Derivatives of the Lagrange basis polynomials, using the barycentric
+    // weights of the points.
+    std::vector<double> weights(numPoints, 1.0);
+    for (int k = 0; k < numPoints; ++k) {
+        for (int m = 0; m < numPoints; ++m) {
+            if (m != k) { weights[k] /= m_points[k] - m_points[m]; }
+        }
+    }
+    m_differentiationMatrix = DM::zeros(degree, numPoints);
+    for (int j = 1; j < numPoints; ++j) {
+        double diagonal = 0;
+        for (int k = 0; k < numPoints; ++k) {
+            if (k == j) continue;
+            const double value = weights[k] / weights[j] /
+                                 (m_points[j] - m_points[k]);
+            m_differentiationMatrix(j - 1, k) = value;
+            diagonal -= value;
+        }
+        m_differentiationMatrix(j - 1, j) = diagonal;
+    }
+
+    // The quadrature weights integrate polynomials of degree up to
+    // 'degree - 1' (in fact, up to 2 * degree - 2) exactly.
+    DM vandermonde(degree, degree);
+    DM moments(degree, 1);
+    for (int m = 0; m < degree; ++m) {
+        for (int j = 0; j < degree; ++j) {
+            vandermonde(m, j) = std::pow(m_points[j + 1], m);
+        }
+        moments(m) = 1.0 / (m + 1);
+    }
+    m_quadratureWeights = DM::solve(vandermonde, moments);
+
+    const auto& mesh = m_solver.getMesh();
+    const int numMeshIntervals = (int)mesh.size() - 1;
+    casadi::DM grid = casadi::DM::zeros(1, numMeshIntervals * degree + 1);
+    for (int imesh = 0; imesh < numMeshIntervals; ++imesh) {
+        const double h = mesh[imesh + 1] - mesh[imesh];
+        for (int j = 0; j < degree; ++j) {
+            grid(imesh * degree + j) = mesh[imesh] + m_points[j] * h;
+        }
+    }
+    grid(numMeshIntervals * degree) = mesh.back();
+    createVariablesAndSetBounds(grid, degree * m_problem.getNumStates());
+}
+
+DM LegendreGaussRadau::createQuadratureCoefficientsImpl() const {
+    const auto& mesh = m_solver.getMesh();
+    DM quadCoeffs(m_numGridPoints, 1);
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const double h = mesh[imesh + 1] - mesh[imesh];
+        // The point at the start of the interval is not a quadrature point.
+        for (int j = 0; j < m_degree; ++j) {
+            quadCoeffs(imesh * m_degree + j + 1) +=
+                    h * m_quadratureWeights(j).scalar();
+        }
+    }
+    return quadCoeffs;
+}
+
+DM LegendreGaussRadau::createMeshIndicesImpl() const {
+    DM indices = DM::zeros(1, m_numGridPoints);
+    for (int i = 0; i < m_numGridPoints; i += m_degree) { indices(i) = 1; }
+    return indices;
+}
+
+void LegendreGaussRadau::calcDefectsImpl(const casadi::MX& x,
+        const casadi::MX& xdot, casadi::MX& defects) const {
+    const int NS = m_problem.getNumStates();
+    const int numPoints = m_degree + 1;
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        const int igrid = imesh * m_degree;
+        const auto h = m_times(igrid + m_degree) - m_times(igrid);
+        const auto x_interval = x(Slice(), Slice(igrid, igrid + numPoints));
+        // The derivative of the interpolating polynomial at each LGR point,
+        // with respect to normalized time.
+        const auto xdot_poly =
+                MX::mtimes(x_interval, MX(m_differentiationMatrix.T()));
+        const auto xdot_interval =
+                xdot(Slice(), Slice(igrid + 1, igrid + numPoints));
+        defects(Slice(), imesh) =
+                MX::reshape(xdot_poly - h * xdot_interval, NS * m_degree, 1);
+    }
+}
+
+} // namespace CasOC
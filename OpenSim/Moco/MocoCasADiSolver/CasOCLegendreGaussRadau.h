@@ -0,0 +1,75 @@
+#ifndef OPENSIM_CASOCLEGENDREGAUSSRADAU_H
+#define OPENSIM_CASOCLEGENDREGAUSSRADAU_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCLegendreGaussRadau.h                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CasOCTranscription.h"
+
+namespace CasOC {
+
+/// Enforce the differential equations in the problem using a
+/// Legendre-Gauss-Radau (LGR) pseudospectral approximation of the given degree
+/// (the number of collocation points) in each mesh interval. The integral in
+/// the objective function is approximated by Gauss-Radau quadrature.
+///
+/// Grid points.
+/// ------------
+/// Each mesh interval contains the mesh point at its start and the
+/// `degree` LGR points (the roots of
+/// \f$ P_{d-1}(\tau) - P_d(\tau) \f$ mapped to (0, 1], where \f$ P_d \f$ is
+/// the Legendre polynomial of degree `d`). The last LGR point of an interval
+/// is the mesh point at the start of the next interval. With degree 1, this
+/// is the backward Euler method; with degree 2, it is the 2-stage Radau IIA
+/// method (third order).
+///
+/// Defect constraints.
+/// -------------------
+/// In each mesh interval, the states are approximated by the Lagrange
+/// polynomial through the `degree + 1` grid points of the interval. For each
+/// state variable, there is one defect constraint per LGR point, which
+/// requires the derivative of the polynomial to equal the state derivative
+/// from the dynamics at that point.
+///
+/// Kinematic constraints and path constraints.
+/// -------------------------------------------
+/// Path constraint errors are enforced only at the mesh points. Kinematic
+/// constraints are not supported.
+class LegendreGaussRadau : public Transcription {
+public:
+    LegendreGaussRadau(
+            const Solver& solver, const Problem& problem, int degree);
+
+private:
+    casadi::DM createQuadratureCoefficientsImpl() const override;
+    casadi::DM createMeshIndicesImpl() const override;
+    void calcDefectsImpl(const casadi::MX& x, const casadi::MX& xdot,
+            casadi::MX& defects) const override;
+
+    int m_degree;
+    /// The points of a mesh interval, normalized to [0, 1]: 0 followed by the
+    /// LGR points.
+    std::vector<double> m_points;
+    /// Element (j, k) is the derivative of the k-th Lagrange basis polynomial
+    /// (with respect to normalized time) at the (j + 1)-th point, for the LGR
+    /// points j = 0, ..., degree - 1.
+    casadi::DM m_differentiationMatrix;
+    /// Quadrature weights for the LGR points in a normalized mesh interval.
+    casadi::DM m_quadratureWeights;
+};
+
+} // namespace CasOC
+
+#endif // OPENSIM_CASOCLEGENDREGAUSSRADAU_H
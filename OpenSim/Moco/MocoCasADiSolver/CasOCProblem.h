@@ -21,6 +21,7 @@
 #include <OpenSim/Moco/MocoUtilities.h>
 #include "CasOCFunction.h"
 #include <casadi/casadi.hpp>
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -80,6 +81,11 @@ struct ParameterInfo {
     Bounds bounds;
 };
 
+/// Creates a symbolic expression for an integrand from symbolic time, states,
+/// controls, multipliers, derivatives, and parameters (in that order).
+using SymbolicIntegrand =
+        std::function<casadi::SX(const std::vector<casadi::SX>&)>;
+
 struct EndpointInfo {
     EndpointInfo(std::string name, int num_outputs,
             std::unique_ptr<Integrand> ifunc, std::unique_ptr<Endpoint> efunc)
@@ -90,6 +96,18 @@ struct EndpointInfo {
     int num_outputs;
     std::unique_ptr<Integrand> integrand_function;
     std::unique_ptr<Endpoint> endpoint_function;
+    /// If provided, the integrand is evaluated with a casadi::Function built
+    /// from this expression instead of with integrand_function.
+    SymbolicIntegrand symbolic_integrand;
+    casadi::Function symbolic_integrand_function;
+    /// The function to evaluate on the trajectory for the integral.
+    /// @precondition integrand_function is not null.
+    const casadi::Function& getIntegrandFunction() const {
+        if (!symbolic_integrand_function.is_null()) {
+            return symbolic_integrand_function;
+        }
+        return *integrand_function;
+    }
 };
 
 struct CostInfo : EndpointInfo {
@@ -256,6 +274,21 @@ protected:
                 std::move(integrand_function),
                 OpenSim::make_unique<Cost>());
     }
+    /// Add a cost whose integrand is given by a symbolic expression rather
+    /// than by calcCostIntegrand(). This gives exact derivatives for the
+    /// integrand; calcCost() is still used for the endpoint term.
+    void addCost(std::string name, int numOutputs,
+            SymbolicIntegrand symbolicIntegrand) {
+        OPENSIM_THROW_IF(!symbolicIntegrand, OpenSim::Exception,
+                "Expected a symbolic integrand.");
+        addCost(std::move(name), 1, numOutputs);
+        m_costInfos.back().symbolic_integrand = std::move(symbolicIntegrand);
+    }
+    /// Options for the casadi::Function%s created for symbolic integrands
+    /// (e.g., {"jit", true} to generate and compile C code for them).
+    void setSymbolicFunctionOptions(casadi::Dict options) {
+        m_symbolicFunctionOptions = std::move(options);
+    }
     /// Add an endpoint constraint to the problem.
     void addEndpointConstraint(
             std::string name, int numIntegrals, std::vector<Bounds> bounds) {
@@ -379,19 +412,29 @@ public:
         return it;
     }
 
+    /// If a sparsity cache is provided, the Jacobian sparsity patterns of the
+    /// functions are taken from the cache if available, and the patterns that
+    /// are detected are added to the cache.
     void initialize(const std::string& finiteDiffScheme,
             std::shared_ptr<const std::vector<VariablesDM>>
-                    pointsForSparsityDetection) const {
+                    pointsForSparsityDetection,
+            std::shared_ptr<SparsityCache> sparsityCache = nullptr) const {
         auto* mutThis = const_cast<Problem*>(this);
+        mutThis->m_sparsityCache = std::move(sparsityCache);
 
         {
             int index = 0;
-            for (const auto& costInfo : mutThis->m_costInfos) {
+            for (auto& costInfo : mutThis->m_costInfos) {
                 costInfo.endpoint_function->constructFunction(this,
                         "cost_" + costInfo.name + "_endpoint", index,
                         costInfo.num_outputs, finiteDiffScheme,
                         pointsForSparsityDetection);
-                if (costInfo.integrand_function) {
+                if (costInfo.symbolic_integrand) {
+                    costInfo.symbolic_integrand_function =
+                            createSymbolicIntegrandFunction(
+                                    "cost_" + costInfo.name + "_integrand",
+                                    costInfo.symbolic_integrand);
+                } else if (costInfo.integrand_function) {
                     costInfo.integrand_function->constructFunction(this,
                             "cost_" + costInfo.name + "_integrand", index,
                             finiteDiffScheme, pointsForSparsityDetection);
@@ -465,6 +508,37 @@ public:
         }
     }
 
+    /// The profiles of all CasOC::Function%s (callbacks) of the problem.
+    /// Symbolic integrands are not included.
+    /// @precondition initialize() has been invoked.
+    std::vector<FunctionProfile> getFunctionProfiles() const {
+        std::vector<FunctionProfile> profiles;
+        for (const auto& info : m_costInfos) {
+            if (info.integrand_function && !info.symbolic_integrand) {
+                profiles.push_back(info.integrand_function->getProfile());
+            }
+            profiles.push_back(info.endpoint_function->getProfile());
+        }
+        for (const auto& info : m_endpointConstraintInfos) {
+            if (info.integrand_function) {
+                profiles.push_back(info.integrand_function->getProfile());
+            }
+            profiles.push_back(info.endpoint_function->getProfile());
+        }
+        for (const auto& info : m_pathInfos) {
+            profiles.push_back(info.function->getProfile());
+        }
+        const std::vector<const Function*> multibodyFunctions{
+                m_multibodyFunc.get(), m_multibodyFuncIgnoringConstraints.get(),
+                m_implicitMultibodyFunc.get(),
+                m_implicitMultibodyFuncIgnoringConstraints.get(),
+                m_velocityCorrectionFunc.get()};
+        for (const auto* function : multibodyFunctions) {
+            if (function) profiles.push_back(function->getProfile());
+        }
+        return profiles;
+    }
+
     /// @name Interface for CasOC::Transcription.
     /// @{
     int getNumStates() const { return (int)m_stateInfos.size(); }
@@ -472,6 +546,8 @@ public:
     int getNumParameters() const { return (int)m_paramInfos.size(); }
     int getNumMultipliers() const { return (int)m_multiplierInfos.size(); }
     std::string getDynamicsMode() const { return m_dynamicsMode; }
+    /// Used by CasOC::Function%s; nullptr if there is no cache.
+    SparsityCache* getSparsityCache() const { return m_sparsityCache.get(); }
     bool isDynamicsModeImplicit() const { return m_isDynamicsModeImplicit; }
     int getNumDerivatives() const {
         return getNumAccelerations() + getNumAuxiliaryResidualEquations();
@@ -569,28 +645,27 @@ public:
     }
     /// Get a function to the full multibody system (i.e. including kinematic
     /// constraints errors).
-    const casadi::Function& getMultibodySystem() const {
+    const Function& getMultibodySystem() const {
         return *m_multibodyFunc;
     }
     /// Get a function to the multibody system that does *not* compute kinematic
     /// constraint errors (if they exist). This may be necessary for computing
     /// state derivatives at grid points where we do not want to enforce
     /// kinematic constraint errors.
-    const casadi::Function& getMultibodySystemIgnoringConstraints() const {
+    const Function& getMultibodySystemIgnoringConstraints() const {
         return *m_multibodyFuncIgnoringConstraints;
     }
     /// Get a function to compute the velocity correction to qdot when enforcing
     /// kinematic constraints and their derivatives. We require a separate
     /// function for this since we don't actually compute qdot within the
     /// multibody system.
-    const casadi::Function& getVelocityCorrection() const {
+    const Function& getVelocityCorrection() const {
         return *m_velocityCorrectionFunc;
     }
-    const casadi::Function& getImplicitMultibodySystem() const {
+    const Function& getImplicitMultibodySystem() const {
         return *m_implicitMultibodyFunc;
     }
-    const casadi::Function&
-    getImplicitMultibodySystemIgnoringConstraints() const {
+    const Function& getImplicitMultibodySystemIgnoringConstraints() const {
         return *m_implicitMultibodyFuncIgnoringConstraints;
     }
     /// @}
@@ -601,6 +676,26 @@ private:
         endpoint.lower = std::max(b.lower, endpoint.lower);
         endpoint.upper = std::min(b.upper, endpoint.upper);
     }
+    /// The inputs match those of CasOC::Integrand, so the resulting function
+    /// can be used wherever the callback is used.
+    casadi::Function createSymbolicIntegrandFunction(const std::string& name,
+            const SymbolicIntegrand& symbolicIntegrand) const {
+        using casadi::SX;
+        const std::vector<SX> inputs{SX::sym("time"),
+                SX::sym("states", getNumStates()),
+                SX::sym("controls", getNumControls()),
+                SX::sym("multipliers", getNumMultipliers()),
+                SX::sym("derivatives", getNumDerivatives()),
+                SX::sym("parameters", getNumParameters())};
+        const SX integrand = symbolicIntegrand(inputs);
+        OPENSIM_THROW_IF(!integrand.is_scalar(), OpenSim::Exception,
+                "Expected the symbolic integrand for '{}' to be a scalar.",
+                name);
+        return casadi::Function(name, inputs, {integrand},
+                {"time", "states", "controls", "multipliers", "derivatives",
+                        "parameters"},
+                {"integrand"}, m_symbolicFunctionOptions);
+    }
 
     Bounds m_timeInitialBounds;
     Bounds m_timeFinalBounds;
@@ -633,6 +728,8 @@ private:
     std::unique_ptr<MultibodySystemImplicit<false>>
             m_implicitMultibodyFuncIgnoringConstraints;
     std::unique_ptr<VelocityCorrection> m_velocityCorrectionFunc;
+    std::shared_ptr<SparsityCache> m_sparsityCache;
+    casadi::Dict m_symbolicFunctionOptions;
 };
 
 } // namespace CasOC
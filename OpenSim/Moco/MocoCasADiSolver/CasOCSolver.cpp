@@ -16,10 +16,13 @@
  * -------------------------------------------------------------------------- */
 
 #include "CasOCHermiteSimpson.h"
+#include "CasOCLegendreGaussRadau.h"
 #include "CasOCProblem.h"
 #include "CasOCTranscription.h"
 #include "CasOCTrapezoidal.h"
 
+#include <cctype>
+#include <chrono>
 #include <OpenSim/Moco/MocoUtilities.h>
 
 using OpenSim::Exception;
@@ -32,6 +35,15 @@ std::unique_ptr<Transcription> Solver::createTranscription() const {
         transcription = OpenSim::make_unique<Trapezoidal>(*this, m_problem);
     } else if (m_transcriptionScheme == "hermite-simpson") {
         transcription = OpenSim::make_unique<HermiteSimpson>(*this, m_problem);
+    } else if (m_transcriptionScheme.find("legendre-gauss-radau-") == 0) {
+        // The scheme name ends with the degree (e.g.,
+        // "legendre-gauss-radau-3").
+        const auto degreeStr = m_transcriptionScheme.substr(21);
+        OPENSIM_THROW_IF(degreeStr.size() != 1 || !std::isdigit(degreeStr[0]),
+                Exception, "Unknown transcription scheme '{}'.",
+                m_transcriptionScheme);
+        transcription = OpenSim::make_unique<LegendreGaussRadau>(
+                *this, m_problem, std::stoi(degreeStr));
     } else {
         OPENSIM_THROW(Exception, "Unknown transcription scheme '{}'.",
                 m_transcriptionScheme);
@@ -68,6 +80,49 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
     m_numThreads = numThreads;
 }
 
+std::vector<double> Solver::timeParallelism(const Iterate& guess,
+        const std::vector<int>& numThreads, int numEvaluations) const {
+    OPENSIM_THROW_IF(numEvaluations < 1, OpenSim::Exception,
+            "Expected numEvaluations >= 1 but got {}.", numEvaluations);
+    auto transcription = createTranscription();
+    const auto times = transcription->createTimes(
+            guess.variables.at(initial_time), guess.variables.at(final_time));
+    const Iterate resampled = guess.resample(times);
+    m_problem.initialize(m_finite_difference_scheme,
+            std::make_shared<const std::vector<VariablesDM>>());
+    const Function& function = m_problem.isDynamicsModeImplicit()
+                                       ? m_problem.getImplicitMultibodySystem()
+                                       : m_problem.getMultibodySystem();
+
+    // Each input has one column per grid point.
+    const int numPoints = (int)times.numel();
+    const auto& vars = resampled.variables;
+    const auto getInput = [&](Var var) -> casadi::DM {
+        const casadi::DM& value = vars.at(var);
+        if (!value.size1()) return casadi::DM(0, numPoints);
+        return value;
+    };
+    const VectorDM args{casadi::DM::reshape(times, 1, numPoints),
+            getInput(states), getInput(controls), getInput(multipliers),
+            getInput(derivatives),
+            casadi::DM::repmat(vars.at(parameters), 1, numPoints)};
+
+    std::vector<double> meanTimes;
+    for (const int n : numThreads) {
+        OPENSIM_THROW_IF(n < 1, OpenSim::Exception,
+                "Expected numThreads >= 1 but got {}.", n);
+        function.evalBatch(args, n);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < numEvaluations; ++i) {
+            function.evalBatch(args, n);
+        }
+        const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+        meanTimes.push_back(elapsed.count() / numEvaluations);
+    }
+    return meanTimes;
+}
+
 Solution Solver::solve(const Iterate& guess) const {
     auto transcription = createTranscription();
     auto pointsForSparsityDetection =
@@ -91,10 +146,31 @@ Solution Solver::solve(const Iterate& guess) const {
                             .variables);
         }
     }
+    std::shared_ptr<SparsityCache> sparsityCache;
+    if (m_sparsity_detection != "none" && !m_sparsity_cache_file.empty()) {
+        sparsityCache = std::make_shared<SparsityCache>(m_sparsity_cache_key);
+        if (sparsityCache->read(m_sparsity_cache_file)) {
+            OpenSim::log_info("Using {} sparsity patterns from '{}'.",
+                    sparsityCache->getNumPatterns(), m_sparsity_cache_file);
+        }
+    }
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
-                    pointsForSparsityDetection));
-    return transcription->solve(guess);
+                    pointsForSparsityDetection),
+            sparsityCache);
+    Solution solution = transcription->solve(guess);
+    if (sparsityCache && sparsityCache->isModified()) {
+        sparsityCache->write(m_sparsity_cache_file);
+        OpenSim::log_info("Wrote {} sparsity patterns to '{}'.",
+                sparsityCache->getNumPatterns(), m_sparsity_cache_file);
+    }
+    return solution;
+}
+
+std::vector<double> Solver::calcMeshIntervalErrors(
+        const Iterate& iterate) const {
+    auto transcription = createTranscription();
+    return transcription->calcMeshIntervalErrors(iterate).nonzeros();
 }
 
 } // namespace CasOC
@@ -144,6 +144,39 @@ public:
     }
     std::string getWriteSparsity() const { return m_write_sparsity; }
 
+    /// If true, IPOPT uses a Hessian of the Lagrangian that contains only the
+    /// exact Hessian of the objective terms that are symbolic expressions
+    /// (costs with a symbolic integrand and the implicit-dynamics and
+    /// multiplier penalties). The curvature of the callbacks (dynamics, path
+    /// constraints, and the other costs) is ignored, as in a Gauss-Newton
+    /// method. The IPOPT option hessian_approximation must be "exact".
+    void setHessianOfSymbolicGoalsOnly(bool tf) {
+        m_hessianOfSymbolicGoalsOnly = tf;
+    }
+    bool getHessianOfSymbolicGoalsOnly() const {
+        return m_hessianOfSymbolicGoalsOnly;
+    }
+
+    /// If true, the optimization solver sees each variable divided by a
+    /// characteristic magnitude: the largest finite bound of that variable
+    /// across the grid, or the largest magnitude in the initial guess if the
+    /// variable is unbounded on either side. The defect constraints of each
+    /// state are divided by the magnitude of that state. The problem and the
+    /// solution are unaffected, but a well-scaled NLP usually converges in
+    /// fewer iterations.
+    void setAutomaticScaling(bool tf) { m_automaticScaling = tf; }
+    bool getAutomaticScaling() const { return m_automaticScaling; }
+
+    /// If `fileName` is not empty and sparsity detection is not "none", the
+    /// detected sparsity patterns are saved to this file, and the patterns
+    /// are loaded from the file (instead of being detected) if the file was
+    /// written with the same key. The key should identify the problem (e.g.,
+    /// a hash of the model and the problem).
+    void setSparsityCache(std::string fileName, std::string key) {
+        m_sparsity_cache_file = std::move(fileName);
+        m_sparsity_cache_key = std::move(key);
+    }
+
     /// Use this to tell CasADi to evaluate differential-algebraic equations,
     /// path constraints, integrands, etc. in parallel across grid points.
     /// "parallelism" is passed on directly to
@@ -153,6 +186,23 @@ public:
     std::pair<std::string, int> getParallelism() const {
         return std::make_pair(m_parallelism, m_numThreads);
     }
+    /// Time the evaluation of the multibody system at all grid points of the
+    /// guess (resampled to the current mesh) with each of the given numbers
+    /// of threads, to choose the argument of setParallelism(). Each entry of
+    /// the result is the mean wall-clock time (in seconds) of
+    /// `numEvaluations` evaluations, after one evaluation to warm up. The
+    /// problem must support evaluating from the largest number of threads.
+    /// This initializes the problem's functions (without sparsity
+    /// detection); solve() initializes them again.
+    std::vector<double> timeParallelism(const Iterate& guess,
+            const std::vector<int>& numThreads, int numEvaluations) const;
+    /// Evaluate the CasOC::Function%s on a trajectory with a BatchFunction
+    /// (all points in one call, and finite difference perturbations applied
+    /// to all points at once) instead of with casadi::Function::map(). If
+    /// the parallelism is not "serial", the batch is split among the number
+    /// of threads given to setParallelism().
+    void setBatchEvaluation(bool tf) { m_batchEvaluation = tf; }
+    bool getBatchEvaluation() const { return m_batchEvaluation; }
 
     void setPluginOptions(casadi::Dict opts) {
         m_pluginOptions = std::move(opts);
@@ -171,6 +221,12 @@ public:
 
     Solution solve(const Iterate& guess) const;
 
+    /// Estimate the discretization error in each interval of the current
+    /// mesh for an iterate (e.g., a solution found on a coarser mesh). See
+    /// Transcription::calcMeshIntervalErrors(). The problem must have been
+    /// initialized by a previous call to solve().
+    std::vector<double> calcMeshIntervalErrors(const Iterate& iterate) const;
+
 private:
     std::unique_ptr<Transcription> createTranscription() const;
 
@@ -189,10 +245,15 @@ private:
     std::string m_finite_difference_scheme = "central";
     std::string m_sparsity_detection = "none";
     std::string m_write_sparsity;
+    bool m_hessianOfSymbolicGoalsOnly = false;
+    bool m_automaticScaling = false;
+    std::string m_sparsity_cache_file;
+    std::string m_sparsity_cache_key;
     int m_callbackInterval = 0;
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
     int m_numThreads = 1;
+    bool m_batchEvaluation = false;
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
     std::string m_optimSolver;
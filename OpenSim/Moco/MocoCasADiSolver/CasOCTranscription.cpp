@@ -59,7 +59,8 @@ public:
     std::vector<DM> eval(const std::vector<DM>& args) const override {
         if (m_callbackInterval > 0 && evalCount % m_callbackInterval == 0) {
             Iterate iterate = m_problem.createIterate<Iterate>();
-            iterate.variables = m_transcription.expandVariables(args.at(0));
+            iterate.variables = m_transcription.expandVariables(
+                    m_transcription.unscaleVariables(args.at(0)));
             iterate.times =
                     m_transcription.createTimes(iterate.variables[initial_time],
                             iterate.variables[final_time]);
@@ -474,6 +475,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         m_objectiveTermNames.push_back("auxiliary_derivatives");
     }
     m_objectiveTerms = MX::zeros((int)m_objectiveTermNames.size(), 1);
+    m_symbolicObjectiveTerms.clear();
 
     int iterm = 0;
     for (int ic = 0; ic < m_problem.getNumCosts(); ++ic) {
@@ -486,9 +488,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
             // cost. We are *not* numerically evaluating the integral cost
             // integrand here--that occurs when the function by casadi::nlpsol()
             // is evaluated.
-            MX integrandTraj = evalOnTrajectory(*info.integrand_function,
-                    {states, controls, multipliers, derivatives}, m_gridIndices)
-                    .at(0);
+            MX integrandTraj = evalIntegrandOnTrajectory(info);
 
             integral = m_duration * dot(quadCoeffs.T(), integrandTraj);
         } else {
@@ -508,6 +508,30 @@ void Transcription::setObjectiveAndEndpointConstraints() {
                  integral},
                 costOut);
         m_objectiveTerms(iterm++) = casadi::MX::sum1(costOut.at(0));
+
+        if (info.symbolic_integrand &&
+                m_solver.getHessianOfSymbolicGoalsOnly()) {
+            // The endpoint function is a callback; we use its derivative with
+            // respect to the integral (it is usually the weight), but not its
+            // curvature.
+            MX integralSym = MX::sym("integral");
+            MXVector costOutSym;
+            info.endpoint_function->call(
+                    {m_vars[initial_time], m_vars[states](Slice(), 0),
+                     m_vars[controls](Slice(), 0),
+                     m_vars[multipliers](Slice(), 0),
+                     m_vars[derivatives](Slice(), 0), m_vars[final_time],
+                     m_vars[states](Slice(), -1),
+                     m_vars[controls](Slice(), -1),
+                     m_vars[multipliers](Slice(), -1),
+                     m_vars[derivatives](Slice(), -1), m_vars[parameters],
+                     integralSym},
+                    costOutSym);
+            const MX scale = MX::substitute(
+                    MX::jacobian(MX::sum1(costOutSym.at(0)), integralSym),
+                    integralSym, integral);
+            m_symbolicObjectiveTerms.emplace_back(scale, integral);
+        }
     }
 
     // Minimize Lagrange multipliers if specified by the solver.
@@ -516,8 +540,10 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         const double multiplierWeight = m_solver.getLagrangeMultiplierWeight();
         // Sum across constraints of each multiplier element squared.
         MX integrandTraj = MX::sum1(MX::sq(mults));
-        m_objectiveTerms(iterm++) = multiplierWeight * m_duration *
-                       dot(quadCoeffs.T(), integrandTraj);
+        const MX term = multiplierWeight * m_duration *
+                         dot(quadCoeffs.T(), integrandTraj);
+        m_objectiveTerms(iterm++) = term;
+        m_symbolicObjectiveTerms.emplace_back(1, term);
     }
 
     // Minimize generalized accelerations.
@@ -527,8 +553,10 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         const double accelWeight =
                 m_solver.getImplicitMultibodyAccelerationsWeight();
         MX integrandTraj = MX::sum1(MX::sq(accels));
-        m_objectiveTerms(iterm++) = accelWeight * m_duration *
-                       dot(quadCoeffs.T(), integrandTraj);
+        const MX term =
+                accelWeight * m_duration * dot(quadCoeffs.T(), integrandTraj);
+        m_objectiveTerms(iterm++) = term;
+        m_symbolicObjectiveTerms.emplace_back(1, term);
     }
 
     // Minimize auxiliary derivatives.
@@ -540,8 +568,10 @@ void Transcription::setObjectiveAndEndpointConstraints() {
         const double auxDerivWeight =
                 m_solver.getImplicitAuxiliaryDerivativesWeight();
         MX integrandTraj = MX::sum1(MX::sq(auxDerivs));
-        m_objectiveTerms(iterm++) = auxDerivWeight * m_duration *
-                       dot(quadCoeffs.T(), integrandTraj);
+        const MX term = auxDerivWeight * m_duration *
+                         dot(quadCoeffs.T(), integrandTraj);
+        m_objectiveTerms(iterm++) = term;
+        m_symbolicObjectiveTerms.emplace_back(1, term);
     }
 
 
@@ -557,9 +587,7 @@ void Transcription::setObjectiveAndEndpointConstraints() {
 
         MX integral;
         if (info.integrand_function) {
-            MX integrandTraj = evalOnTrajectory(*info.integrand_function,
-                    {states, controls, multipliers, derivatives}, m_gridIndices)
-                                       .at(0);
+            MX integrandTraj = evalIntegrandOnTrajectory(info);
 
             integral = m_duration * dot(quadCoeffs.T(), integrandTraj);
         } else {
@@ -592,40 +620,7 @@ Solution Transcription::solve(const Iterate& guessOrig) {
 
     // Resample the guess.
     // -------------------
-    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
-            guessOrig.variables.at(final_time));
-    auto guess = guessOrig.resample(guessTimes);
-
-    // Adjust guesses for the slack variables to ensure they are the correct
-    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
-    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
-        auto& slacks = guess.variables.at(Var::slacks);
-
-        // If slack variables provided in the guess are equal to the grid
-        // length, remove the elements on the mesh points where the slack
-        // variables are not defined.
-        if (slacks.size2() == m_numGridPoints) {
-            casadi::DM meshIndices = createMeshIndices();
-            std::vector<casadi_int> slackColumnsToRemove;
-            for (int itime = 0; itime < m_numGridPoints; ++itime) {
-                if (meshIndices(itime).__nonzero__()) {
-                    slackColumnsToRemove.push_back(itime);
-                }
-            }
-            // The first argument is an empty vector since we don't want to
-            // remove an entire row.
-            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
-        }
-
-        // Check that either that the slack variables provided in the guess
-        // are the correct length, or that the correct number of columns
-        // were removed.
-        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
-                OpenSim::Exception,
-                "Expected slack variables to be length {}, but they are length "
-                "{}.",
-                m_numMeshInteriorPoints, slacks.size2());
-    }
+    const auto guess = resampleToGrid(guessOrig);
 
     // Create the CasADi NLP function.
     // -------------------------------
@@ -643,21 +638,56 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     auto g = flattenConstraints(m_constraints);
     casadi_int numConstraints = g.numel();
 
-    NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
-            m_solver.getCallbackInterval());
-    options["iteration_callback"] = callback;
-
-    // The inputs to nlpsol() are symbolic (casadi::MX).
-    casadi::MXDict nlp;
-    nlp.emplace(std::make_pair("x", x));
     // The objective symbolic variable holds an expression graph including
     // all the calculations performed on the variables x.
     casadi::MX objective = MX::sum1(m_objectiveTerms);
     if (m_objectiveTerms.numel() == 0) {
         objective = 0;
     }
-    nlp.emplace(std::make_pair("f", objective));
-    nlp.emplace(std::make_pair("g", g));
+
+    DM x0 = flattenVariables(guess.variables);
+    DM lbx = flattenVariables(m_lowerBounds);
+    DM ubx = flattenVariables(m_upperBounds);
+    DM lbg = flattenConstraints(m_constraintsLowerBounds);
+    DM ubg = flattenConstraints(m_constraintsUpperBounds);
+
+    // The NLP is posed in terms of the scaled variables x / xScale and the
+    // scaled constraints g / gScale; the problem functions still receive the
+    // variables in physical units.
+    MX nlpX = x;
+    MX nlpF = objective;
+    MX nlpG = g;
+    m_variableScaling = DM();
+    if (m_solver.getAutomaticScaling()) {
+        const auto variableScaling = calcVariableScaling(guess);
+        const DM xScale = flattenVariables(variableScaling);
+        const DM gScale =
+                flattenConstraints(calcConstraintScaling(variableScaling));
+        nlpX = MX::sym("x_scaled", numVariables);
+        casadi::Function unscaledNLP("nlp_unscaled", {x}, {objective, g});
+        const MXVector out = unscaledNLP(MXVector{xScale * nlpX});
+        nlpF = out.at(0);
+        nlpG = out.at(1) / gScale;
+        x0 /= xScale;
+        lbx /= xScale;
+        ubx /= xScale;
+        lbg /= gScale;
+        ubg /= gScale;
+        m_variableScaling = xScale;
+    }
+
+    NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
+            m_solver.getCallbackInterval());
+    options["iteration_callback"] = callback;
+    if (m_solver.getHessianOfSymbolicGoalsOnly()) {
+        options["hess_lag"] = createSymbolicGoalsHessianFunction(x, g);
+    }
+
+    // The inputs to nlpsol() are symbolic (casadi::MX).
+    casadi::MXDict nlp;
+    nlp.emplace(std::make_pair("x", nlpX));
+    nlp.emplace(std::make_pair("f", nlpF));
+    nlp.emplace(std::make_pair("g", nlpG));
     if (!m_solver.getWriteSparsity().empty()) {
         const auto prefix = m_solver.getWriteSparsity();
         auto gradient = casadi::MX::gradient(nlp["f"], nlp["x"]);
@@ -681,17 +711,13 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     // Run the optimization (evaluate the CasADi NLP function).
     // --------------------------------------------------------
     // The inputs and outputs of nlpFunc are numeric (casadi::DM).
-    const casadi::DMDict nlpResult =
-            nlpFunc(casadi::DMDict{{"x0", flattenVariables(guess.variables)},
-                    {"lbx", flattenVariables(m_lowerBounds)},
-                    {"ubx", flattenVariables(m_upperBounds)},
-                    {"lbg", flattenConstraints(m_constraintsLowerBounds)},
-                    {"ubg", flattenConstraints(m_constraintsUpperBounds)}});
+    const casadi::DMDict nlpResult = nlpFunc(casadi::DMDict{{"x0", x0},
+            {"lbx", lbx}, {"ubx", ubx}, {"lbg", lbg}, {"ubg", ubg}});
 
     // Create a CasOC::Solution.
     // -------------------------
     Solution solution = m_problem.createIterate<Solution>();
-    const auto finalVariables = nlpResult.at("x");
+    const auto finalVariables = unscaleVariables(nlpResult.at("x"));
     solution.variables = expandVariables(finalVariables);
     solution.objective = nlpResult.at("f").scalar();
 
@@ -720,6 +746,169 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     return solution;
 }
 
+casadi::DM Transcription::calcMeshIntervalErrors(const Iterate& iterate) {
+    transcribe();
+    const auto resampled = resampleToGrid(iterate);
+
+    casadi::Function defectsFunc("defects", {flattenVariables(m_vars)},
+            {m_constraints.defects});
+    casadi::DMVector defectsOut;
+    defectsFunc.call(
+            casadi::DMVector{flattenVariables(resampled.variables)},
+            defectsOut);
+    const casadi::DM& defects = defectsOut[0];
+
+    // Scale the defects of each state by the magnitude of the state, so that
+    // the errors are comparable across states with different units.
+    const auto& statesTraj = resampled.variables.at(states);
+    const int NS = m_problem.getNumStates();
+    std::vector<double> scales(NS);
+    for (int is = 0; is < NS; ++is) {
+        scales[is] = 1.0 + casadi::DM::mmax(casadi::DM::fabs(
+                                   statesTraj(is, Slice()))).scalar();
+    }
+    casadi::DM errors = casadi::DM::zeros(1, m_numMeshIntervals);
+    for (int imesh = 0; imesh < m_numMeshIntervals; ++imesh) {
+        double maxError = 0;
+        for (int irow = 0; irow < defects.rows(); ++irow) {
+            maxError = std::max(maxError,
+                    std::abs(defects(irow, imesh).scalar()) /
+                            scales[irow % NS]);
+        }
+        errors(imesh) = maxError;
+    }
+    return errors;
+}
+
+casadi::Function Transcription::createSymbolicGoalsHessianFunction(
+        const casadi::MX& x, const casadi::MX& g) const {
+    // The signature matches the function that casadi::nlpsol() would
+    // otherwise create for IPOPT.
+    MX p = MX::sym("p", 0, 1);
+    MX lam_f = MX::sym("lam_f");
+    MX lam_g = MX::sym("lam_g", g.numel());
+    MX hessian(x.numel(), x.numel());
+    for (const auto& term : m_symbolicObjectiveTerms) {
+        hessian += term.first * MX::hessian(term.second, x);
+    }
+    MX xIn = x;
+    if (!m_variableScaling.is_empty()) {
+        // The Hessian with respect to the scaled variables is
+        // D * H(D * x_scaled) * D, with D = diag(scaling).
+        casadi::Function hessianFunc("symbolic_goals_hessian", {x}, {hessian});
+        xIn = MX::sym("x_scaled", x.numel());
+        const MX D = MX(DM::diag(m_variableScaling));
+        hessian = MX::mtimes(
+                MX::mtimes(D,
+                        hessianFunc(MXVector{m_variableScaling * xIn}).at(0)),
+                D);
+    }
+    return casadi::Function("nlp_hess_l", {xIn, p, lam_f, lam_g},
+            {MX::triu(lam_f * hessian)}, {"x", "p", "lam_f", "lam_g"},
+            {"hess_gamma_x_x"});
+}
+
+VariablesDM Transcription::calcVariableScaling(const Iterate& guess) const {
+    VariablesDM scaling;
+    for (const auto& kv : m_lowerBounds) {
+        const DM& lower = kv.second;
+        const DM& upper = m_upperBounds.at(kv.first);
+        const auto itGuess = guess.variables.find(kv.first);
+        const bool hasGuess = itGuess != guess.variables.end() &&
+                              itGuess->second.size() == lower.size();
+        DM& scale = scaling[kv.first];
+        scale = DM::ones(lower.rows(), lower.columns());
+        for (int irow = 0; irow < lower.rows(); ++irow) {
+            double magnitude = 0;
+            for (int icol = 0; icol < lower.columns(); ++icol) {
+                const double L = lower(irow, icol).scalar();
+                const double U = upper(irow, icol).scalar();
+                if (!std::isinf(L)) magnitude = std::max(magnitude, std::abs(L));
+                if (!std::isinf(U)) magnitude = std::max(magnitude, std::abs(U));
+                if ((std::isinf(L) || std::isinf(U)) && hasGuess) {
+                    const double value = itGuess->second(irow, icol).scalar();
+                    if (!std::isnan(value)) {
+                        magnitude = std::max(magnitude, std::abs(value));
+                    }
+                }
+            }
+            // Variables that are fixed at zero or unbounded with a zero guess
+            // are not scaled.
+            if (magnitude > 0 && !std::isinf(magnitude)) {
+                scale(irow, Slice()) = magnitude;
+            }
+        }
+    }
+    return scaling;
+}
+
+Transcription::Constraints<DM> Transcription::calcConstraintScaling(
+        const VariablesDM& variableScaling) const {
+    auto ones = [](const DM& m) { return DM::ones(m.rows(), m.columns()); };
+    Constraints<DM> scaling;
+    scaling.defects = ones(m_constraintsLowerBounds.defects);
+    scaling.multibody_residuals =
+            ones(m_constraintsLowerBounds.multibody_residuals);
+    scaling.auxiliary_residuals =
+            ones(m_constraintsLowerBounds.auxiliary_residuals);
+    scaling.kinematic = ones(m_constraintsLowerBounds.kinematic);
+    for (const auto& endpoint : m_constraintsLowerBounds.endpoint) {
+        scaling.endpoint.push_back(ones(endpoint));
+    }
+    for (const auto& path : m_constraintsLowerBounds.path) {
+        scaling.path.push_back(ones(path));
+    }
+    scaling.interp_controls = ones(m_constraintsLowerBounds.interp_controls);
+
+    // The defects of every transcription scheme have the units of the
+    // states, and the rows cycle through the states (as in
+    // calcMeshIntervalErrors()).
+    const DM& stateScaling = variableScaling.at(states);
+    const int NS = m_problem.getNumStates();
+    for (int irow = 0; irow < scaling.defects.rows(); ++irow) {
+        scaling.defects(irow, Slice()) = stateScaling(irow % NS, 0);
+    }
+    return scaling;
+}
+
+Iterate Transcription::resampleToGrid(const Iterate& guessOrig) const {
+    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
+            guessOrig.variables.at(final_time));
+    auto guess = guessOrig.resample(guessTimes);
+
+    // Adjust guesses for the slack variables to ensure they are the correct
+    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
+    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
+        auto& slacks = guess.variables.at(Var::slacks);
+
+        // If slack variables provided in the guess are equal to the grid
+        // length, remove the elements on the mesh points where the slack
+        // variables are not defined.
+        if (slacks.size2() == m_numGridPoints) {
+            casadi::DM meshIndices = createMeshIndices();
+            std::vector<casadi_int> slackColumnsToRemove;
+            for (int itime = 0; itime < m_numGridPoints; ++itime) {
+                if (meshIndices(itime).__nonzero__()) {
+                    slackColumnsToRemove.push_back(itime);
+                }
+            }
+            // The first argument is an empty vector since we don't want to
+            // remove an entire row.
+            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
+        }
+
+        // Check that either that the slack variables provided in the guess
+        // are the correct length, or that the correct number of columns
+        // were removed.
+        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
+                OpenSim::Exception,
+                "Expected slack variables to be length {}, but they are length "
+                "{}.",
+                m_numMeshInteriorPoints, slacks.size2());
+    }
+    return guess;
+}
+
 void Transcription::printConstraintValues(const Iterate& it,
         const Constraints<casadi::DM>& constraints,
         std::ostream& stream) const {
@@ -1176,13 +1365,74 @@ Iterate Transcription::createRandomIterateWithinBounds(
     return casIterate;
 }
 
+casadi::MXVector Transcription::evalOnTrajectory(
+        const Function& pointFunction, const std::vector<Var>& inputs,
+        const casadi::Matrix<casadi_int>& timeIndices) const {
+    if (!m_solver.getBatchEvaluation()) {
+        return evalOnTrajectory(static_cast<const casadi::Function&>(
+                                        pointFunction),
+                inputs, timeIndices);
+    }
+    const auto parallelism = m_solver.getParallelism();
+    const int numThreads =
+            parallelism.first == "serial" ? 1 : parallelism.second;
+    const int numPoints = (int)timeIndices.size2();
+    m_batchFunctions.emplace_back(new BatchFunction());
+    auto& batchFunc = *m_batchFunctions.back();
+    batchFunc.constructFunction(&pointFunction, numPoints, numThreads,
+            m_solver.getFiniteDifferenceScheme());
+
+    MXVector mxIn = assembleTrajectoryInputs(inputs, timeIndices);
+    // Inputs that are the same for all points (one column) are repeated.
+    for (auto& in : mxIn) {
+        if (in.size2() == 1 && numPoints > 1) {
+            in = MX::repmat(in, 1, numPoints);
+        }
+    }
+    MXVector mxOut;
+    batchFunc.call(mxIn, mxOut);
+    return mxOut;
+}
+
+casadi::MX Transcription::evalIntegrandOnTrajectory(
+        const EndpointInfo& info) const {
+    const std::vector<Var> inputs{states, controls, multipliers, derivatives};
+    // Symbolic integrands are not callbacks, so they are always mapped.
+    if (!info.symbolic_integrand_function.is_null()) {
+        return evalOnTrajectory(
+                info.symbolic_integrand_function, inputs, m_gridIndices)
+                .at(0);
+    }
+    return evalOnTrajectory(*info.integrand_function, inputs, m_gridIndices)
+            .at(0);
+}
+
 casadi::MXVector Transcription::evalOnTrajectory(
         const casadi::Function& pointFunction, const std::vector<Var>& inputs,
         const casadi::Matrix<casadi_int>& timeIndices) const {
     auto parallelism = m_solver.getParallelism();
     const auto trajFunc = pointFunction.map(
             timeIndices.size2(), parallelism.first, parallelism.second);
+    MXVector mxIn = assembleTrajectoryInputs(inputs, timeIndices);
+    MXVector mxOut;
+    trajFunc.call(mxIn, mxOut);
+    return mxOut;
+    // TODO: Avoid the overhead of map() if not running in parallel.
+    /* } else {
+    casadi::MXVector out(pointFunction.n_out());
+    for (int iout = 0; iout < (int)out.size(); ++iout) {
+    out[iout] = casadi::MX(pointFunction.sparsity_out(iout).rows(),
+    timeIndices.size2());
+    }
+    for (int itime = 0; itime < timeIndices.size2(); ++itime) {
 
+    }
+    }*/
+}
+
+casadi::MXVector Transcription::assembleTrajectoryInputs(
+        const std::vector<Var>& inputs,
+        const casadi::Matrix<casadi_int>& timeIndices) const {
     // Assemble input.
     // Add 1 for time input and 1 for parameters input.
     MXVector mxIn(inputs.size() + 2);
@@ -1207,20 +1457,7 @@ casadi::MXVector Transcription::evalOnTrajectory(
     } else {
         OPENSIM_THROW(OpenSim::Exception, "Internal error.");
     }
-    MXVector mxOut;
-    trajFunc.call(mxIn, mxOut);
-    return mxOut;
-    // TODO: Avoid the overhead of map() if not running in parallel.
-    /* } else {
-    casadi::MXVector out(pointFunction.n_out());
-    for (int iout = 0; iout < (int)out.size(); ++iout) {
-    out[iout] = casadi::MX(pointFunction.sparsity_out(iout).rows(),
-    timeIndices.size2());
-    }
-    for (int itime = 0; itime < timeIndices.size2(); ++itime) {
-
-    }
-    }*/
+    return mxIn;
 }
 
 } // namespace CasOC
@@ -63,6 +63,13 @@ public:
     }
 
     Solution solve(const Iterate& guessOrig);
+    /// Evaluate the defect constraints at the provided iterate (resampled
+    /// onto this transcription's grid) and return a row vector with the
+    /// largest defect in each mesh interval. The defects of each state are
+    /// divided by 1 plus the largest magnitude of the state. Evaluating the
+    /// defects of a solution on a finer mesh than the one on which it was
+    /// found gives an estimate of the discretization error of the solution.
+    casadi::DM calcMeshIntervalErrors(const Iterate& iterate);
 
 protected:
     /// This must be called in the constructor of derived classes so that
@@ -80,6 +87,16 @@ protected:
     casadi::MXVector evalOnTrajectory(const casadi::Function& pointFunction,
             const std::vector<Var>& inputs,
             const casadi::Matrix<casadi_int>& timeIndices) const;
+    /// This overload evaluates the function with a BatchFunction if
+    /// Solver::getBatchEvaluation() is true.
+    casadi::MXVector evalOnTrajectory(const Function& pointFunction,
+            const std::vector<Var>& inputs,
+            const casadi::Matrix<casadi_int>& timeIndices) const;
+    /// Evaluate the integrand of a cost or endpoint constraint on the grid.
+    casadi::MX evalIntegrandOnTrajectory(const EndpointInfo& info) const;
+    /// Time, the requested variables at the time indices, and parameters.
+    casadi::MXVector assembleTrajectoryInputs(const std::vector<Var>& inputs,
+            const casadi::Matrix<casadi_int>& timeIndices) const;
 
     template <typename TRow, typename TColumn>
     void setVariableBounds(Var var, const TRow& rowIndices,
@@ -143,8 +160,19 @@ private:
 
     casadi::MX m_xdot; // State derivatives.
 
+    /// The functions used by evalOnTrajectory() for batch evaluation; these
+    /// must exist for as long as the NLP.
+    mutable std::vector<std::unique_ptr<BatchFunction>> m_batchFunctions;
+
     casadi::MX m_objectiveTerms;
     std::vector<std::string> m_objectiveTermNames;
+    /// The objective terms whose Hessian is computed exactly when using
+    /// Solver::getHessianOfSymbolicGoalsOnly(): pairs of a scale factor
+    /// (which is not differentiated) and an expression.
+    std::vector<std::pair<casadi::MX, casadi::MX>> m_symbolicObjectiveTerms;
+
+    /// Flattened variable magnitudes; empty if the variables are not scaled.
+    casadi::DM m_variableScaling;
 
     Constraints<casadi::MX> m_constraints;
     Constraints<casadi::DM> m_constraintsLowerBounds;
@@ -172,6 +200,30 @@ private:
 
     void transcribe();
     void setObjectiveAndEndpointConstraints();
+    /// Resample the iterate onto the grid, and remove the slack variables at
+    /// mesh points.
+    Iterate resampleToGrid(const Iterate& guessOrig) const;
+    /// Create the function IPOPT uses for the Hessian of the Lagrangian when
+    /// using Solver::getHessianOfSymbolicGoalsOnly(), from the flattened
+    /// variables and constraints of the NLP.
+    /// If the variables are scaled, the returned function takes the scaled
+    /// variables as input.
+    casadi::Function createSymbolicGoalsHessianFunction(
+            const casadi::MX& x, const casadi::MX& g) const;
+    /// Characteristic magnitude of each variable, used when
+    /// Solver::getAutomaticScaling() is true. Every time point of a
+    /// continuous variable has the same magnitude.
+    VariablesDM calcVariableScaling(const Iterate& guess) const;
+    /// The defects of each state are scaled by the magnitude of the state;
+    /// all other constraints are not scaled.
+    Constraints<casadi::DM> calcConstraintScaling(
+            const VariablesDM& variableScaling) const;
+    /// Convert variables seen by the optimization solver back to physical
+    /// units.
+    casadi::DM unscaleVariables(const casadi::DM& x) const {
+        if (m_variableScaling.is_empty()) return x;
+        return x * m_variableScaling;
+    }
     void calcDefects() {
         calcDefectsImpl(m_vars.at(states), m_xdot, m_constraints.defects);
     }
@@ -25,7 +25,11 @@
     #include "MocoCasOCProblem.h"
     #include <casadi/casadi.hpp>
 
+    #include <algorithm>
+    #include <fstream>
+    #include <map>
     #include <OpenSim/Common/Stopwatch.h>
+    #include <OpenSim/Common/TraceRecorder.h>
 
     using casadi::Callback;
     using casadi::Dict;
@@ -43,14 +47,22 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_parameters_require_initsystem(true);
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
+    constructProperty_optim_sparsity_cache("");
+    constructProperty_optim_symbolic_integrands("none");
     constructProperty_optim_finite_difference_scheme("central");
     constructProperty_parallel();
+    constructProperty_batch_evaluation(false);
     constructProperty_output_interval(0);
+    constructProperty_output_interval_format("sto");
+    constructProperty_profile("none");
+    constructProperty_profile_file("");
 
     constructProperty_minimize_implicit_multibody_accelerations(false);
     constructProperty_implicit_multibody_accelerations_weight(1.0);
     constructProperty_minimize_implicit_auxiliary_derivatives(false);
     constructProperty_implicit_auxiliary_derivatives_weight(1.0);
+    constructProperty_mesh_refinement_max_iterations(0);
+    constructProperty_mesh_refinement_tolerance(1e-3);
 }
 
 bool MocoCasADiSolver::isAvailable() {
@@ -144,18 +156,16 @@ const MocoTrajectory& MocoCasADiSolver::getGuess() const {
 std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
 #ifdef OPENSIM_WITH_CASADI
     const auto& problemRep = getProblemRep();
-    int parallel = 1;
-    int parallelEV = getMocoParallelEnvironmentVariable();
-    if (getProperty_parallel().size()) {
-        parallel = get_parallel();
-    } else if (parallelEV != -1) {
-        parallel = parallelEV;
-    }
+    const int parallel = getParallelSetting();
+    OPENSIM_THROW_IF_FRMOBJ(parallel < -1, Exception,
+            "Expected the parallel property to be -1 or greater, but got {}.",
+            parallel);
     int numThreads;
     if (parallel == 0) {
         numThreads = 1;
-    } else if (parallel == 1) {
-        numThreads = std::thread::hardware_concurrency();
+    } else if (parallel == 1 || parallel == -1) {
+        // With -1, the number of threads used is chosen from up to this many.
+        numThreads = getNumAvailableThreads();
     } else {
         numThreads = parallel;
     }
@@ -172,6 +182,12 @@ std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
     OPENSIM_THROW_IF(!model.getMatterSubsystem().getUseEulerAngles(
                              model.getWorkingState()),
             Exception, "Quaternions are not supported.");
+    checkPropertyValueIsInSet(getProperty_optim_symbolic_integrands(),
+            {"none", "symbolic", "jit"});
+    checkPropertyValueIsInSet(
+            getProperty_profile(), {"none", "summary", "detailed"});
+    checkPropertyValueIsInSet(
+            getProperty_output_interval_format(), {"sto", "binary"});
     return OpenSim::make_unique<MocoCasOCProblem>(*this, problemRep,
             createProblemRepJar(numThreads), get_multibody_dynamics_mode());
 #else
@@ -179,6 +195,23 @@ std::unique_ptr<MocoCasOCProblem> MocoCasADiSolver::createCasOCProblem() const {
 #endif
 }
 
+int MocoCasADiSolver::getParallelSetting() const {
+    if (getProperty_parallel().size()) { return get_parallel(); }
+    const int parallelEV = getMocoParallelEnvironmentVariable();
+    return parallelEV != -1 ? parallelEV : 1;
+}
+
+std::string MocoCasADiSolver::createSparsityCacheKey() const {
+    const std::string description =
+            getProblem().dump() + getProblemRep().getModelBase().dump() +
+            get_multibody_dynamics_mode() + get_optim_sparsity_detection() +
+            (!getProperty_enforce_constraint_derivatives().empty() &&
+                                    get_enforce_constraint_derivatives()
+                            ? "1"
+                            : "0");
+    return createFNV1aHash(description);
+}
+
 std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
         const MocoCasOCProblem& casProblem) const {
 #ifdef OPENSIM_WITH_CASADI
@@ -188,13 +221,21 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     // -------------------
     Dict solverOptions;
     checkPropertyValueIsInSet(getProperty_optim_solver(), {"ipopt", "snopt"});
-    checkPropertyValueIsInSet(getProperty_transcription_scheme(),
-            {"trapezoidal", "hermite-simpson"});
+    const std::string& scheme = get_transcription_scheme();
+    const bool isLegendreGaussRadau =
+            scheme.size() == 22 &&
+            scheme.compare(0, 21, "legendre-gauss-radau-") == 0 &&
+            scheme[21] >= '1' && scheme[21] <= '9';
+    if (!isLegendreGaussRadau) {
+        checkPropertyValueIsInSet(getProperty_transcription_scheme(),
+                {"trapezoidal", "hermite-simpson"});
+    }
     OPENSIM_THROW_IF(casProblem.getNumKinematicConstraintEquations() != 0 &&
-                             get_transcription_scheme() == "trapezoidal",
+                             scheme != "hermite-simpson",
             OpenSim::Exception,
             "Kinematic constraints not supported with "
-            "trapezoidal transcription.");
+            "{} transcription.",
+            scheme);
     // Enforcing constraint derivatives is only supported when Hermite-Simpson
     // is set as the transcription scheme.
     if (casProblem.getNumKinematicConstraintEquations() != 0) {
@@ -244,8 +285,19 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
         } else if (get_optim_ipopt_print_level() != -1) {
             solverOptions["print_level"] = get_optim_ipopt_print_level();
         }
-        solverOptions["hessian_approximation"] =
-                get_optim_hessian_approximation();
+        checkPropertyValueIsInSet(getProperty_optim_hessian_approximation(),
+                {"limited-memory", "exact", "exact-goals"});
+        if (get_optim_hessian_approximation() == "exact-goals") {
+            OPENSIM_THROW_IF(get_optim_symbolic_integrands() == "none",
+                    Exception,
+                    "The 'exact-goals' Hessian approximation requires that "
+                    "'optim_symbolic_integrands' is 'symbolic' or 'jit'.");
+            solverOptions["hessian_approximation"] = "exact";
+            casSolver->setHessianOfSymbolicGoalsOnly(true);
+        } else {
+            solverOptions["hessian_approximation"] =
+                    get_optim_hessian_approximation();
+        }
 
         if (get_optim_max_iterations() != -1)
             solverOptions["max_iter"] = get_optim_max_iterations();
@@ -273,6 +325,10 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     casSolver->setSparsityDetectionRandomCount(3);
 
     casSolver->setWriteSparsity(get_optim_write_sparsity());
+    if (!get_optim_sparsity_cache().empty()) {
+        casSolver->setSparsityCache(
+                get_optim_sparsity_cache(), createSparsityCacheKey());
+    }
 
     checkPropertyValueIsInSet(getProperty_optim_finite_difference_scheme(),
             {"central", "forward", "backward"});
@@ -321,11 +377,13 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
             get_implicit_auxiliary_derivatives_weight());
 
     casSolver->setOptimSolver(get_optim_solver());
+    casSolver->setAutomaticScaling(get_optim_automatic_scaling());
     casSolver->setInterpolateControlMidpoints(
             get_interpolate_control_midpoints());
     if (casProblem.getJarSize() > 1) {
         casSolver->setParallelism("thread", casProblem.getJarSize());
     }
+    casSolver->setBatchEvaluation(get_batch_evaluation());
     casSolver->setPluginOptions(pluginOptions);
     casSolver->setSolverOptions(solverOptions);
     return casSolver;
@@ -334,6 +392,117 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
 #endif
 }
 
+#ifdef OPENSIM_WITH_CASADI
+namespace {
+/// Estimate the error in each interval of the solver's mesh by evaluating the
+/// defects of the solution on a mesh in which every interval is bisected.
+/// Returns the mesh with the intervals whose error exceeds the tolerance
+/// bisected, or an empty mesh if no interval exceeds the tolerance.
+std::vector<double> refineMesh(CasOC::Solver& casSolver,
+        const CasOC::Iterate& solution, double tolerance, double& maxError,
+        int& numRefinedIntervals) {
+    const std::vector<double> mesh = casSolver.getMesh();
+    std::vector<double> fineMesh;
+    for (int i = 0; i < (int)mesh.size(); ++i) {
+        fineMesh.push_back(mesh[i]);
+        if (i + 1 < (int)mesh.size()) {
+            fineMesh.push_back(0.5 * (mesh[i] + mesh[i + 1]));
+        }
+    }
+    casSolver.setMesh(fineMesh);
+    const std::vector<double> fineErrors =
+            casSolver.calcMeshIntervalErrors(solution);
+    casSolver.setMesh(mesh);
+
+    std::vector<double> refinedMesh;
+    maxError = 0;
+    numRefinedIntervals = 0;
+    for (int i = 0; i + 1 < (int)mesh.size(); ++i) {
+        refinedMesh.push_back(mesh[i]);
+        const double error =
+                std::max(fineErrors[2 * i], fineErrors[2 * i + 1]);
+        maxError = std::max(maxError, error);
+        if (error > tolerance) {
+            refinedMesh.push_back(fineMesh[2 * i + 1]);
+            ++numRefinedIntervals;
+        }
+    }
+    refinedMesh.push_back(mesh.back());
+    if (!numRefinedIntervals) { refinedMesh.clear(); }
+    return refinedMesh;
+}
+
+/// Add the profiles of the problem's functions from a solve to the profiles of
+/// previous solves (e.g., before mesh refinement). With 'summary', functions
+/// are grouped by their kind.
+void accumulateProfiles(const std::vector<CasOC::FunctionProfile>& profiles,
+        bool summary, std::map<std::string, CasOC::FunctionProfile>& totals) {
+    const auto getGroup = [](const std::string& name) -> std::string {
+        for (const std::string& prefix :
+                {"cost_", "endpoint_constraint_", "path_constraint_"}) {
+            if (name.compare(0, prefix.size(), prefix) == 0) {
+                if (prefix == "cost_") return "goals";
+                return prefix.substr(0, prefix.size() - 1) + "s";
+            }
+        }
+        if (name == "velocity_correction") return name;
+        return "multibody_system";
+    };
+    for (const auto& profile : profiles) {
+        const std::string name = summary ? getGroup(profile.name) : profile.name;
+        auto& total = totals[name];
+        total.name = name;
+        total.numCalls += profile.numCalls;
+        total.totalTime += profile.totalTime;
+        total.numThreads = std::max(total.numThreads, profile.numThreads);
+    }
+}
+
+/// Log the profile, and also write it to a CSV file if fileName is not empty.
+void reportProfiles(const std::map<std::string, CasOC::FunctionProfile>& totals,
+        double solveTime, bool verbose, const std::string& fileName) {
+    double callbackTime = 0;
+    for (const auto& entry : totals) { callbackTime += entry.second.totalTime; }
+    if (verbose) {
+        log_info("Function evaluations (including finite differences):");
+        log_info("  {:<48} {:>10} {:>11} {:>11} {:>7}", "function", "calls",
+                "total (s)", "mean (ms)", "threads");
+        for (const auto& entry : totals) {
+            const auto& profile = entry.second;
+            log_info("  {:<48} {:>10} {:>11.3f} {:>11.4f} {:>7}", profile.name,
+                    profile.numCalls, profile.totalTime,
+                    profile.numCalls ? 1000.0 * profile.totalTime /
+                                               profile.numCalls
+                                     : 0.0,
+                    profile.numThreads);
+        }
+        // The time in the callbacks can exceed the wall time of the solve
+        // if the callbacks are evaluated in parallel.
+        log_info("Solve wall time: {:.3f} s; time in callbacks: {:.3f} s "
+                 "(mean concurrency {:.2f}).",
+                solveTime, callbackTime,
+                solveTime > 0 ? callbackTime / solveTime : 0.0);
+    }
+    if (!fileName.empty()) {
+        std::ofstream file(fileName);
+        OPENSIM_THROW_IF(!file.good(), Exception,
+                "Could not open profile file '{}'.", fileName);
+        file << "function,calls,total_time,mean_time,threads\n";
+        for (const auto& entry : totals) {
+            const auto& profile = entry.second;
+            file << profile.name << "," << profile.numCalls << ","
+                 << profile.totalTime << ","
+                 << (profile.numCalls ? profile.totalTime / profile.numCalls
+                                      : 0.0)
+                 << "," << profile.numThreads << "\n";
+        }
+        file << "solve_wall_time,1," << solveTime << "," << solveTime
+             << ",\n";
+    }
+}
+} // anonymous namespace
+#endif
+
 MocoSolution MocoCasADiSolver::solveImpl() const {
 #ifdef OPENSIM_WITH_CASADI
     const Stopwatch stopwatch;
@@ -362,14 +531,97 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     // Temporarily disable printing of negative muscle force warnings so the
     // log isn't flooded while computing finite differences.
     Logger::Level origLoggerLevel = Logger::getLevel();
+
+    int numSolverThreads = casProblem->getJarSize();
+    if (getParallelSetting() == -1 && casProblem->getJarSize() > 1) {
+        // Candidate numbers of threads: powers of 2, and all cores.
+        std::vector<int> candidates;
+        for (int n = 1; n < casProblem->getJarSize(); n *= 2) {
+            candidates.push_back(n);
+        }
+        candidates.push_back(casProblem->getJarSize());
+        Logger::setLevel(Logger::Level::Warn);
+        std::vector<double> times;
+        try {
+            times = casSolver->timeParallelism(casGuess, candidates, 3);
+        } catch (...) {
+            OpenSim::Logger::setLevel(origLoggerLevel);
+            throw;
+        }
+        OpenSim::Logger::setLevel(origLoggerLevel);
+        const int ibest = (int)(std::min_element(times.begin(), times.end()) -
+                                times.begin());
+        const int numThreads = candidates[ibest];
+        numSolverThreads = numThreads;
+        if (numThreads == 1) {
+            casSolver->setParallelism("serial", 1);
+        } else {
+            casSolver->setParallelism("thread", numThreads);
+        }
+        if (get_verbosity()) {
+            for (int i = 0; i < (int)candidates.size(); ++i) {
+                log_info("Multibody system evaluation with {:>3} thread(s): "
+                         "{:.3f} ms.",
+                        candidates[i], 1000.0 * times[i]);
+            }
+            log_info("Using {} of {} threads.", numThreads,
+                    casProblem->getJarSize());
+        }
+    }
+
+    // Other parallel work in this process should not use the solver's threads.
+    const ThreadReservation reservation(numSolverThreads);
+
     Logger::setLevel(Logger::Level::Warn);
     CasOC::Solution casSolution;
+    int numIterations = 0;
+    const bool profile = get_profile() != "none";
+    std::map<std::string, CasOC::FunctionProfile> profiles;
+    double solveTime = 0;
+    const auto solve = [&](const CasOC::Iterate& guess) {
+        OPENSIM_TRACE_SCOPE_CATEGORY("CasOC::Solver::solve", "moco");
+        const Stopwatch solveStopwatch;
+        casSolution = casSolver->solve(guess);
+        solveTime += solveStopwatch.getElapsedTime();
+        if (profile) {
+            accumulateProfiles(casProblem->getFunctionProfiles(),
+                    get_profile() == "summary", profiles);
+        }
+    };
     try {
-        casSolution = casSolver->solve(casGuess);
+        solve(casGuess);
+        numIterations = casSolution.stats.at("iter_count");
+
+        // Refine the mesh where the solution is inaccurate, and solve again
+        // using the previous solution as the guess.
+        for (int irefine = 0; irefine < get_mesh_refinement_max_iterations() &&
+                              casSolution.stats.at("success");
+                ++irefine) {
+            double maxError;
+            int numRefined;
+            std::vector<double> refinedMesh = refineMesh(*casSolver,
+                    casSolution, get_mesh_refinement_tolerance(), maxError,
+                    numRefined);
+            if (get_verbosity()) {
+                log_info("Mesh refinement iteration {}: maximum error {:.3g} "
+                         "(tolerance {:.3g}); refining {} of {} mesh "
+                         "intervals.",
+                        irefine + 1, maxError, get_mesh_refinement_tolerance(),
+                        numRefined, casSolver->getMesh().size() - 1);
+            }
+            if (refinedMesh.empty()) { break; }
+            casSolver->setMesh(std::move(refinedMesh));
+            solve(casSolution);
+            numIterations += (int)casSolution.stats.at("iter_count");
+        }
     } catch (...) {
         OpenSim::Logger::setLevel(origLoggerLevel);
     }
     OpenSim::Logger::setLevel(origLoggerLevel);
+    if (profile) {
+        reportProfiles(profiles, solveTime, get_verbosity(),
+                get_profile_file());
+    }
 
     MocoSolution mocoSolution =
             convertToMocoTrajectory<MocoSolution>(casSolution);
@@ -422,7 +674,7 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     const long long elapsed = stopwatch.getElapsedTimeInNs();
     setSolutionStats(mocoSolution, casSolution.stats.at("success"),
             casSolution.objective, casSolution.stats.at("return_status"),
-            casSolution.stats.at("iter_count"), SimTK::nsToSec(elapsed),
+            numIterations, SimTK::nsToSec(elapsed),
             casSolution.objective_breakdown);
 
     if (get_verbosity()) {
@@ -65,6 +65,64 @@ the same, ensuring that the sparsity pattern is deterministic.
 To explore the sparsity pattern for your problem, set optim_write_sparsity
 and run the resulting files with the plot_casadi_sparsity.py Python script.
 
+Detecting the sparsity can take a long time for large models. If you solve the
+same problem repeatedly, set optim_sparsity_cache to a file name: the detected
+patterns are saved to that file, and later solves load them from the file
+instead of detecting them again. The file is keyed by a hash of the model, the
+problem, and the solver settings that affect the patterns; if any of these
+change, the patterns are detected again and the file is replaced. With
+'initial-guess', the cached patterns are reused even if the guess changes.
+
+Symbolic integrands
+===================
+All functions that invoke OpenSim are CasADi callbacks whose derivatives are
+computed with finite differences. The integrands of some goals, however, do not
+depend on the model: MocoControlGoal's integrand is a weighted sum of powers of
+the controls. With optim_symbolic_integrands set to 'symbolic', such integrands
+are built as CasADi expressions, so that their derivatives (and sparsity) are
+exact and cheap. With 'jit', CasADi also generates C code for these expressions
+and compiles it with the system's C compiler at the start of the solve; this
+requires a compiler to be available at runtime. The multibody dynamics, the
+muscles, and all other goals and constraints are still evaluated through
+OpenSim.
+
+With symbolic integrands, optim_hessian_approximation may also be set to
+'exact-goals'. IPOPT then uses the exact Hessian of the symbolic objective
+terms (the symbolic integrands, and the penalties on Lagrange multipliers and
+implicit derivatives) and ignores the curvature of the callbacks, in the spirit
+of a Gauss-Newton method. The exact Hessian of callbacks would require finite
+differences of finite differences, and IPOPT cannot combine an exact Hessian
+with a limited-memory approximation. This works best for problems dominated by
+quadratic effort terms; otherwise, 'limited-memory' is more robust.
+
+Mesh refinement
+===============
+The mesh from num_mesh_intervals (or the mesh property) must be fine enough
+for the fastest events in the motion (e.g., heel strike), which makes the
+mesh unnecessarily fine elsewhere. With mesh_refinement_max_iterations greater
+than 0, the problem is first solved on the provided (coarse) mesh. Then, the
+discretization error of each mesh interval is estimated by evaluating the
+defect constraints of the solution on a mesh in which every interval is
+bisected; the intervals whose error exceeds mesh_refinement_tolerance are
+bisected, and the problem is solved again using the previous solution as the
+guess. This repeats until no interval exceeds the tolerance or the maximum
+number of refinements is reached. The errors of the states are relative to 1
+plus the largest magnitude of each state. The number of iterations in the
+solution is the total over all solves.
+
+Profiling
+=========
+To find out where the time of a slow solve goes, set the profile property to
+'summary' or 'detailed'. After solving, the number of evaluations of each
+callback function (the multibody system, each goal and each constraint), the
+total and mean time per evaluation, and the number of threads that evaluated
+it are logged, and written to profile_file as CSV if it is set. The counts
+include the evaluations for finite differences and sparsity detection. The
+time in the callbacks is summed over threads; dividing it by the wall time of
+the solve gives the mean number of threads that were busy. For a serial solve,
+the remaining wall time is spent in the optimizer (e.g., IPOPT's linear
+algebra) and in CasADi.
+
 Finite difference scheme
 ========================
 The "central" finite difference is more accurate but can be 2 times
@@ -78,6 +136,9 @@ differential-algebraic equations in parallel.
 This should work fine for almost all models, but if you have custom model
 components, ensure they are threadsafe. Make sure that threads do not
 access shared resources like files or global variables at the same time.
+Each thread uses its own copy of the model, so components whose
+Component::isThreadSafe() is false are supported, but components that
+share data among copies (e.g., through static variables) are not.
 
 You can turn off or change the number of parallel jobs used for individual
 problems via either the OPENSIM_MOCO_PARALLEL environment variable (see
@@ -86,11 +147,28 @@ class. For example, if you plan to solve two problems at the same time on
 a machine with 4 processor cores, you could set OPENSIM_MOCO_PARALLEL to 2 to
 use all 4 cores.
 
+Unless a number of jobs is given, the number of jobs is the number of threads
+still available from the OpenSim-wide thread budget (see getMaxNumThreads()
+and the OPENSIM_NUM_THREADS environment variable), and the jobs are reserved
+from that budget while solving. Problems solved at the same time in one
+process (e.g., by MocoStudyBatch) therefore share the cores instead of each
+using all of them.
+
 Note that there is overhead in the parallelization; if you plan to solve
 many problems, it is better to turn off parallelization here and parallelize
 the solving of your multiple problems using your system (e.g., invoke Moco in
 multiple Terminals or Command Prompts).
 
+The best number of parallel jobs depends on the size of the model and of the
+mesh; for small problems, evaluating in series can be faster than using all
+cores. Setting the `parallel` property to -1 chooses the number of jobs
+automatically: before solving, the multibody system is evaluated on the
+initial guess at all grid points a few times with 1, 2, 4, ... jobs (up to the
+number of cores), and the fastest setting is used for the solve (and logged).
+The timings include the evaluation of the model only, not the overhead of
+CasADi, so the choice is a good estimate rather than guaranteed to be the
+fastest.
+
 Note that the `parallel` property overrides the environment variable,
 allowing more granular control over parallelization. However, the
 parallelization setting does not logically belong as a property, as it does
@@ -98,6 +176,14 @@ not affect the solution. We encourage you to use the environment variable
 instead, as this allows different users to solve the same problem with the
 parallelization they prefer.
 
+With the `batch_evaluation` property, the multibody system, path constraints
+and integrands are evaluated for all grid points in a single call, whose
+points are split among the parallel jobs. When CasADi computes derivatives
+with finite differences, each perturbation is then applied to all grid points
+at once, so there are fewer, larger calls. This is the place to plug in an
+implementation that evaluates many points together (see
+CasOC::Function::evalBatchImpl()).
+
 Parameter variables
 ===================
 By default, MocoCasADiSolver is much slower than MocoTroperSolver at
@@ -112,6 +198,12 @@ will end up with incorrect results if your parameter does indeed require
 Model::initSystem(). To protect against this, ensure that you obtain the
 same results whether this setting is true or false.
 
+Moco recognizes some parameters that never require Model::initSystem()
+(see MocoParameter::getRequiresInitSystem()), such as the maximum isometric
+force of a DeGrooteFregly2016Muscle. If all parameters in the problem are of
+this kind, Model::initSystem() is not invoked even if
+parameters_require_initsystem is true.
+
 @note The software license of CasADi (LGPL) is more restrictive than that of
 the rest of Moco (Apache 2.0).
 @note This solver currently only supports systems for which \f$ \dot{q} = u
@@ -124,8 +216,9 @@ public:
     OpenSim_DECLARE_PROPERTY(parameters_require_initsystem, bool,
             "Do some MocoParameters in the problem require invoking "
             "initSystem() to take effect properly? "
-            "This substantially slows down problems with parameter variables "
-            "(default: true).");
+            "This substantially slows down problems with parameter variables. "
+            "initSystem() is not invoked, regardless of this setting, if no "
+            "parameter requires it (default: true).");
     OpenSim_DECLARE_PROPERTY(optim_sparsity_detection, std::string,
             "Detect the sparsity pattern of derivatives; 'none' "
             "(for safe block sparsity; default), 'random', or "
@@ -134,6 +227,17 @@ public:
             "Write files for the sparsity pattern of the gradient, Jacobian, "
             "and Hessian to the working directory using this as a prefix; "
             "empty (default) to not write such files.");
+    OpenSim_DECLARE_PROPERTY(optim_sparsity_cache, std::string,
+            "File in which to save the sparsity patterns detected with "
+            "'random' or 'initial-guess' optim_sparsity_detection. If the file "
+            "contains the patterns of the same model and problem, they are "
+            "used instead of detecting them again. Empty (default) to not use "
+            "a cache.");
+    OpenSim_DECLARE_PROPERTY(optim_symbolic_integrands, std::string,
+            "Build the integrands of goals that are weighted sums of powers "
+            "of the controls (e.g., MocoControlGoal) as CasADi expressions "
+            "with exact derivatives; 'none' (default), 'symbolic', or 'jit' "
+            "(also generate C code for them and compile it when solving).");
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
@@ -141,14 +245,34 @@ public:
     OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
             "Evaluate integral costs and the differential-algebraic "
             "equations in parallel across grid points? "
-            "0: not parallel; 1: use all cores (default); greater than 1: use"
-            "this number of parallel jobs. This overrides the OPENSIM_MOCO_PARALLEL "
-            "environment variable.");
+            "0: not parallel; 1: use all cores (default); greater than 1: use "
+            "this number of parallel jobs; -1: choose the number of jobs by "
+            "timing evaluations of the multibody system before solving. This "
+            "overrides the OPENSIM_MOCO_PARALLEL environment variable.");
+    OpenSim_DECLARE_PROPERTY(batch_evaluation, bool,
+            "Evaluate the multibody system, path constraints, and integrands "
+            "for all grid points in a single call (split among the parallel "
+            "jobs) instead of one call per grid point. Each finite difference "
+            "perturbation is then applied to all grid points at once "
+            "(default: false).");
     OpenSim_DECLARE_PROPERTY(output_interval, int,
             "Write intermediate trajectories to file. 0, the default, "
             "indicates no intermediate trajectories are saved, 1 indicates "
             "each iteration is saved, 5 indicates every fifth iteration is "
             "saved, etc.");
+    OpenSim_DECLARE_PROPERTY(output_interval_format, std::string,
+            "Format of the intermediate trajectory files: 'sto' (default) or "
+            "'binary' (faster to write and to read). The "
+            "files are written on a background thread; if writing a file "
+            "takes longer than the interval, some iterates are skipped.");
+    OpenSim_DECLARE_PROPERTY(profile, std::string,
+            "Report the number of calls and the time spent in each callback "
+            "function: 'none' (default), 'summary' (grouped into goals, path "
+            "constraints, endpoint constraints, and the multibody system), or "
+            "'detailed' (each goal and constraint separately).");
+    OpenSim_DECLARE_PROPERTY(profile_file, std::string,
+            "If profile is not 'none', also write the profile to this CSV "
+            "file. Empty (default) to only log the profile.");
 
     OpenSim_DECLARE_PROPERTY(minimize_implicit_multibody_accelerations, bool,
             "Minimize the integral of the squared acceleration continuous "
@@ -166,6 +290,14 @@ public:
             "The weight on the cost term added if "
             "'minimize_implicit_auxiliary_derivatives' is enabled."
             "Default: 1.0.");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_max_iterations, int,
+            "The maximum number of times the mesh is refined (the problem is "
+            "solved again) where the estimated discretization error exceeds "
+            "mesh_refinement_tolerance. Default: 0 (no mesh refinement).");
+    OpenSim_DECLARE_PROPERTY(mesh_refinement_tolerance, double,
+            "The largest acceptable estimated discretization error in a mesh "
+            "interval, relative to 1 plus the magnitude of the states. "
+            "Default: 1e-3.");
 
     MocoCasADiSolver();
 
@@ -229,6 +361,13 @@ protected:
 
 private:
     void constructProperties();
+    /// A hash of the model, the problem, and the settings that affect the
+    /// sparsity patterns, used to check that a sparsity cache file belongs to
+    /// this problem.
+    std::string createSparsityCacheKey() const;
+    /// The `parallel` property if set, otherwise the OPENSIM_MOCO_PARALLEL
+    /// environment variable if set, otherwise 1.
+    int getParallelSetting() const;
 
     // When a copy of the solver is made, we want to keep any guess specified
     // by the API, but want to discard anything we've cached by loading a file.
@@ -0,0 +1,123 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: MocoCasOCIterateWriter.cpp                                   *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoCasOCIterateWriter.h"
+
+#include <cstdint>
+#include <fstream>
+
+using namespace OpenSim;
+
+namespace {
+template <typename T>
+void writeLittleEndian(std::ofstream& stream, const T& value) {
+    // All platforms we support are little-endian.
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+} // anonymous namespace
+
+MocoCasOCIterateWriter::MocoCasOCIterateWriter(std::string prefix, bool binary)
+        : m_prefix(std::move(prefix)), m_binary(binary) {
+    m_thread = std::thread(&MocoCasOCIterateWriter::run, this);
+}
+
+MocoCasOCIterateWriter::~MocoCasOCIterateWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+    if (m_numSkipped) {
+        log_info("MocoCasADiSolver did not write {} intermediate iterate(s) "
+                 "because writing the previous iterate had not finished.",
+                m_numSkipped);
+    }
+}
+
+void MocoCasOCIterateWriter::submit(
+        int iteration, std::unique_ptr<MocoTrajectory> trajectory) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_hasPending) ++m_numSkipped;
+        // Swap so that the old pending buffer is freed outside of the lock.
+        std::swap(m_pending, trajectory);
+        m_pendingIteration = iteration;
+        m_hasPending = true;
+    }
+    m_condition.notify_one();
+}
+
+int MocoCasOCIterateWriter::getNumSkipped() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numSkipped;
+}
+
+void MocoCasOCIterateWriter::run() {
+    std::unique_ptr<MocoTrajectory> writing;
+    while (true) {
+        int iteration;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_hasPending || m_stop; });
+            if (!m_hasPending) return;
+            std::swap(writing, m_pending);
+            iteration = m_pendingIteration;
+            m_hasPending = false;
+        }
+        try {
+            write(iteration, *writing);
+        } catch (const std::exception& e) {
+            // Failing to write an iterate should not stop the optimization.
+            log_warn("Could not write intermediate iterate {}: {}", iteration,
+                    e.what());
+        }
+    }
+}
+
+void MocoCasOCIterateWriter::write(
+        int iteration, const MocoTrajectory& trajectory) const {
+    const std::string filename = fmt::format(
+            "{}{:06d}.{}", m_prefix, iteration, m_binary ? "bin" : "sto");
+    if (!m_binary) {
+        trajectory.write(filename);
+        return;
+    }
+
+    const TimeSeriesTable table = trajectory.convertToTable();
+    std::ofstream stream(filename, std::ios::binary);
+    OPENSIM_THROW_IF(!stream.good(), Exception,
+            "Could not open file '{}'.", filename);
+    const int32_t numRows = (int32_t)table.getNumRows();
+    const int32_t numColumns = (int32_t)table.getNumColumns();
+    stream.write("OSIMITR1", 8);
+    writeLittleEndian(stream, (int32_t)iteration);
+    writeLittleEndian(stream, numRows);
+    writeLittleEndian(stream, numColumns);
+    for (const auto& label : table.getColumnLabels()) {
+        writeLittleEndian(stream, (int32_t)label.size());
+        stream.write(label.data(), label.size());
+    }
+    for (const auto& time : table.getIndependentColumn()) {
+        writeLittleEndian(stream, time);
+    }
+    const auto& matrix = table.getMatrix();
+    for (int irow = 0; irow < numRows; ++irow) {
+        for (int icol = 0; icol < numColumns; ++icol) {
+            writeLittleEndian(stream, matrix.getElt(irow, icol));
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef OPENSIM_MOCOCASOCITERATEWRITER_H
+#define OPENSIM_MOCOCASOCITERATEWRITER_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: MocoCasOCIterateWriter.h                                     *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "../MocoTrajectory.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace OpenSim {
+
+/// This class writes intermediate iterates of MocoCasADiSolver to files on a
+/// background thread so that the optimizer does not wait for the file
+/// system. The solver thread only copies the iterate into a pending buffer
+/// (submit()); the writer thread swaps the pending buffer with its own buffer
+/// and writes it. The buffers are held by pointer because MocoTrajectory is
+/// not movable. If the writer is still busy when a new iterate is
+/// submitted, the pending (unwritten) iterate is replaced by the new one;
+/// getNumSkipped() reports how many iterates were not written for this
+/// reason. The destructor writes the last pending iterate before returning.
+///
+/// If `binary` is true, iterates are written as
+/// `<prefix><iteration>.bin` with the following little-endian layout
+/// (see MocoTrajectory::convertToTable() for the column labels):
+///   - 8 bytes: "OSIMITR1"
+///   - int32: iteration, int32: number of rows, int32: number of columns
+///   - for each column: int32 label length, followed by the label
+///   - number of rows doubles: times
+///   - number of rows * number of columns doubles: data, row-major.
+/// Otherwise, iterates are written as `<prefix><iteration>.sto` with
+/// MocoTrajectory::write().
+class OSIMMOCO_API MocoCasOCIterateWriter {
+public:
+    MocoCasOCIterateWriter(std::string prefix, bool binary);
+    ~MocoCasOCIterateWriter();
+    MocoCasOCIterateWriter(const MocoCasOCIterateWriter&) = delete;
+    MocoCasOCIterateWriter& operator=(const MocoCasOCIterateWriter&) = delete;
+
+    /// Queue the trajectory for iteration `iteration` to be written. This
+    /// does not wait for any file to be written.
+    void submit(int iteration, std::unique_ptr<MocoTrajectory> trajectory);
+
+    /// The number of submitted iterates that were replaced by a later iterate
+    /// before they could be written.
+    int getNumSkipped() const;
+
+private:
+    void run();
+    void write(int iteration, const MocoTrajectory& trajectory) const;
+
+    std::string m_prefix;
+    bool m_binary;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::unique_ptr<MocoTrajectory> m_pending;
+    int m_pendingIteration = -1;
+    bool m_hasPending = false;
+    bool m_stop = false;
+    int m_numSkipped = 0;
+
+    std::thread m_thread;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOCASOCITERATEWRITER_H
@@ -24,23 +24,119 @@
 
 using namespace OpenSim;
 
-thread_local SimTK::Vector_<SimTK::SpatialVec>
-        MocoCasOCProblem::m_constraintBodyForces;
-thread_local SimTK::Vector MocoCasOCProblem::m_constraintMobilityForces;
-thread_local SimTK::Vector MocoCasOCProblem::m_pvaerr;
+namespace {
+/// A worker kept by a thread until the thread exits, at which point the
+/// worker is returned to its jar (if the problem still exists).
+template <typename Worker> struct PinnedWorker {
+    using Jar = ThreadsafeJar<Worker>;
+    PinnedWorker(const std::shared_ptr<Jar>& jar, std::unique_ptr<Worker> w)
+            : jar(jar), worker(std::move(w)) {}
+    PinnedWorker(PinnedWorker&&) = default;
+    PinnedWorker& operator=(PinnedWorker&&) = default;
+    ~PinnedWorker() {
+        if (!worker) return;
+        if (auto owner = jar.lock()) owner->leave(std::move(worker));
+    }
+    std::weak_ptr<Jar> jar;
+    std::unique_ptr<Worker> worker;
+};
+} // namespace
+
+MocoCasOCProblem::WorkerLease::WorkerLease(const MocoCasOCProblem& problem) {
+    if (std::this_thread::get_id() == problem.m_creationThreadId) {
+        m_jar = problem.m_workers.get();
+        m_borrowed = m_jar->take();
+        m_worker = m_borrowed.get();
+        return;
+    }
+    // A thread usually evaluates only one problem, but keep one worker per
+    // problem in case it evaluates several.
+    static thread_local std::vector<PinnedWorker<Worker>> pinned;
+    for (auto it = pinned.begin(); it != pinned.end();) {
+        if (it->jar.expired()) {
+            it = pinned.erase(it);
+        } else if (it->jar.lock() == problem.m_workers) {
+            m_worker = it->worker.get();
+            return;
+        } else {
+            ++it;
+        }
+    }
+    pinned.emplace_back(problem.m_workers, problem.m_workers->take());
+    m_worker = pinned.back().worker.get();
+}
+
+MocoCasOCProblem::WorkerLease::~WorkerLease() {
+    if (m_borrowed) m_jar->leave(std::move(m_borrowed));
+}
+
+bool MocoCasOCProblem::updConstraintJacobian(const Model& modelBase,
+        const SimTK::State& stateBase, Worker& worker) const {
+    if (getNumParameters()) return false;
+
+    auto& jac = worker.constraintJacobian;
+    if (jac.time != stateBase.getTime() ||
+            jac.q.size() != stateBase.getNQ() ||
+            differs(stateBase.getQ(), jac.q.getContiguousScalarData(),
+                    jac.q.size())) {
+        // First evaluation at these coordinates.
+        jac.time = stateBase.getTime();
+        jac.q = stateBase.getQ();
+        jac.computed = false;
+        jac.udotErrBias.clear();
+        return false;
+    }
+
+    if (!jac.computed) {
+        const auto& matter = modelBase.getMatterSubsystem();
+        matter.calcG(stateBase, jac.G);
+        const int numMultipliers = jac.G.nrow();
+        jac.bodyForces.resize(numMultipliers);
+        jac.mobilityForces.resize(stateBase.getNU(), numMultipliers);
+        SimTK::Vector unitMultiplier(numMultipliers, 0.0);
+        SimTK::Vector mobilityForces;
+        for (int i = 0; i < numMultipliers; ++i) {
+            unitMultiplier[i] = 1;
+            matter.calcConstraintForcesFromMultipliers(stateBase,
+                    unitMultiplier, jac.bodyForces[i], mobilityForces);
+            jac.mobilityForces(i) = mobilityForces;
+            unitMultiplier[i] = 0;
+        }
+        jac.computed = true;
+    }
+    return true;
+}
 
 MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         const MocoProblemRep& problemRep,
         std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> jar,
         std::string dynamicsMode)
-        : m_jar(std::move(jar)),
+        : m_workers(std::make_shared<ThreadsafeJar<Worker>>()),
+          m_creationThreadId(std::this_thread::get_id()),
           m_paramsRequireInitSystem(
-                  mocoCasADiSolver.get_parameters_require_initsystem()),
+                  mocoCasADiSolver.get_parameters_require_initsystem() &&
+                  problemRep.getParametersRequireInitSystem()),
           m_formattedTimeString(getFormattedDateTime(true)) {
 
     setDynamicsMode(dynamicsMode);
     const auto& model = problemRep.getModelBase();
 
+    // Allocate the scratch memory of each worker up front so that problem
+    // functions do not allocate it on their first evaluation.
+    const auto& matter = model.getMatterSubsystem();
+    const int numBodies = matter.getNumBodies();
+    const int numSpeeds = model.getWorkingState().getNU();
+    const int numUDotErr = model.getWorkingState().getNUDotErr();
+    m_numWorkers = jar->size();
+    for (int i = 0; i < m_numWorkers; ++i) {
+        auto worker = OpenSim::make_unique<Worker>();
+        worker->problemRep = jar->take();
+        worker->constraintBodyForces.resize(numBodies);
+        worker->constraintMobilityForces.resize(numSpeeds);
+        worker->pvaerr.resize(numUDotErr);
+        m_workers->leave(std::move(worker));
+    }
+
     // Ensure the model does not have user-provided controllers.
     int numControllers = 0;
     for (const auto& controller : model.getComponentList<Controller>()) {
@@ -222,10 +318,50 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         addParameter(paramName, convertBounds(param.getBounds()));
     }
 
+    const std::string symbolicIntegrands =
+            mocoCasADiSolver.get_optim_symbolic_integrands();
+    if (symbolicIntegrands == "jit") {
+        setSymbolicFunctionOptions({{"jit", true}, {"compiler", "shell"}});
+    }
+    // Map from the index of a control in the system to its index in CasOC.
+    std::unordered_map<int, int> casControlIndices;
+    for (int ic = 0; ic < (int)m_modelControlIndices.size(); ++ic) {
+        casControlIndices[m_modelControlIndices[ic]] = ic;
+    }
+
     const auto costNames = problemRep.createCostNames();
     for (const auto& name : costNames) {
         const auto& cost = problemRep.getCost(name);
-        addCost(name, cost.getNumIntegrals(), cost.getNumOutputs());
+        std::vector<int> controlIndices;
+        std::vector<double> weights;
+        int exponent;
+        if (symbolicIntegrands != "none" &&
+                cost.getControlPowerIntegrand(
+                        controlIndices, weights, exponent)) {
+            std::vector<int> casIndices;
+            for (const auto& index : controlIndices) {
+                casIndices.push_back(casControlIndices.at(index));
+            }
+            addCost(name, cost.getNumOutputs(),
+                    [casIndices, weights, exponent](
+                            const std::vector<casadi::SX>& inputs) {
+                        const casadi::SX& controls = inputs.at(2);
+                        casadi::SX integrand = 0;
+                        for (int i = 0; i < (int)casIndices.size(); ++i) {
+                            const casadi::SX control = controls(casIndices[i]);
+                            // Match MocoControlGoal, which uses x * x for an
+                            // exponent of 2.
+                            const casadi::SX power =
+                                    exponent == 2 ? control * control
+                                                  : pow(fabs(control),
+                                                            casadi::SX(exponent));
+                            integrand += weights[i] * power;
+                        }
+                        return integrand;
+                    });
+        } else {
+            addCost(name, cost.getNumIntegrals(), cost.getNumOutputs());
+        }
     }
 
     const auto endpointConNames =
@@ -252,4 +388,11 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
     m_fileDeletionThrower = OpenSim::make_unique<FileDeletionThrower>(
             fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
                     problemRep.getName(), m_formattedTimeString));
+
+    if (mocoCasADiSolver.get_output_interval() > 0) {
+        m_iterateWriter = OpenSim::make_unique<MocoCasOCIterateWriter>(
+                fmt::format("MocoCasADiSolver_{}_trajectory",
+                        m_formattedTimeString),
+                mocoCasADiSolver.get_output_interval_format() == "binary");
+    }
 }
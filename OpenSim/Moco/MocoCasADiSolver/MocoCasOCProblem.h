@@ -20,12 +20,15 @@
 
 #include "CasOCProblem.h"
 #include "MocoCasADiSolver.h"
+#include "MocoCasOCIterateWriter.h"
 
 #include <OpenSim/Moco/Components/AccelerationMotion.h>
 #include <OpenSim/Moco/Components/DiscreteController.h>
 #include <OpenSim/Moco/Components/DiscreteForces.h>
 #include <OpenSim/Moco/MocoBounds.h>
 #include <OpenSim/Moco/MocoProblemRep.h>
+#include <memory>
+#include <thread>
 
 namespace OpenSim {
 
@@ -198,26 +201,87 @@ public:
             std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> jar,
             std::string dynamicsMode);
 
-    int getJarSize() const { return (int)m_jar->size(); }
+    /// The number of copies of the MocoProblemRep, which is the number of
+    /// threads that can evaluate problem functions at the same time.
+    int getJarSize() const { return m_numWorkers; }
 
 private:
+    /// A copy of the MocoProblemRep together with the memory needed to
+    /// evaluate problem functions with it. Only one thread at a time uses a
+    /// worker.
+    struct Worker {
+        std::unique_ptr<const MocoProblemRep> problemRep;
+        // Local memory to hold constraint forces.
+        SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces;
+        SimTK::Vector constraintMobilityForces;
+        // This is the output argument of
+        // SimbodyMatterSubsystem::calcConstraintAccelerationErrors(), and
+        // includes the acceleration-level holonomic, non-holonomic constraint
+        // errors and the acceleration-only constraint errors.
+        SimTK::Vector pvaerr;
+        /// The constraint Jacobian G of the base model at one time and set of
+        /// coordinates, together with the constraint forces of each unit
+        /// multiplier (the columns of the linear map from multipliers to
+        /// constraint forces). These are shared by the kinematic constraint
+        /// forces, the acceleration-level constraint errors and the velocity
+        /// correction of all evaluations at the same time and coordinates.
+        /// See updConstraintJacobian().
+        struct ConstraintJacobian {
+            double time = SimTK::NaN;
+            SimTK::Vector q;
+            // Whether the entries below are valid for (time, q).
+            bool computed = false;
+            SimTK::Matrix G;
+            SimTK::Array_<SimTK::Vector_<SimTK::SpatialVec>> bodyForces;
+            SimTK::Matrix mobilityForces;
+            // The acceleration-level constraint errors are affine in udot:
+            // pvaerr = G udot + udotErrBias, where the bias depends on the
+            // speeds u. The bias is empty if not yet known.
+            SimTK::Vector u;
+            SimTK::Vector udotErrBias;
+        } constraintJacobian;
+    };
+    /// Gives the calling thread a worker for the scope of a problem function.
+    /// On the thread that created the problem, the worker is taken from the
+    /// jar and returned when the lease ends, as before. Any other thread is a
+    /// CasADi worker thread that evaluates many points in a row; such a thread
+    /// takes a worker on its first evaluation and keeps it (in thread-local
+    /// storage) until the thread exits, so that later evaluations do not lock
+    /// the jar and the worker's states stay warm. The creating thread never
+    /// keeps a worker, so the worker threads can always get one.
+    class WorkerLease {
+    public:
+        explicit WorkerLease(const MocoCasOCProblem& problem);
+        ~WorkerLease();
+        WorkerLease(const WorkerLease&) = delete;
+        WorkerLease& operator=(const WorkerLease&) = delete;
+        Worker& operator*() const { return *m_worker; }
+        Worker* operator->() const { return m_worker; }
+
+    private:
+        ThreadsafeJar<Worker>* m_jar = nullptr;
+        std::unique_ptr<Worker> m_borrowed;
+        Worker* m_worker = nullptr;
+    };
+
     void calcMultibodySystemExplicit(const ContinuousInput& input,
             bool calcKCErrors,
             MultibodySystemExplicitOutput& output) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         const auto& modelBase = mocoProblemRep->getModelBase();
         auto& simtkStateBase = mocoProblemRep->updStateBase();
 
+        applyInput(SimTK::Stage::Acceleration, input.time, input.states,
+                input.controls, input.multipliers, input.derivatives,
+                input.parameters, *worker);
+
         const auto& modelDisabledConstraints =
                 mocoProblemRep->getModelDisabledConstraints();
         auto& simtkStateDisabledConstraints =
                 mocoProblemRep->updStateDisabledConstraints();
 
-        applyInput(SimTK::Stage::Acceleration, input.time, input.states,
-                input.controls, input.multipliers, input.derivatives,
-                input.parameters, mocoProblemRep);
-
         // Compute the accelerations.
         modelDisabledConstraints.realizeAcceleration(
                 simtkStateDisabledConstraints);
@@ -226,7 +290,7 @@ private:
         if (getNumMultipliers() && calcKCErrors) {
             calcKinematicConstraintErrors(modelBase, simtkStateBase,
                     simtkStateDisabledConstraints,
-                    output.kinematic_constraint_errors);
+                    output.kinematic_constraint_errors, *worker);
         }
 
         // Copy state derivative values to output.
@@ -241,29 +305,30 @@ private:
         copyImplicitResidualsToOutput(*mocoProblemRep,
                 simtkStateDisabledConstraints, output.auxiliary_residuals);
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
     void calcMultibodySystemImplicit(const ContinuousInput& input,
             bool calcKCErrors,
             MultibodySystemImplicitOutput& output) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         // Original model and its associated state. These are used to calculate
         // kinematic constraint forces and errors.
         const auto& modelBase = mocoProblemRep->getModelBase();
         auto& simtkStateBase = mocoProblemRep->updStateBase();
 
+        applyInput(SimTK::Stage::Acceleration, input.time, input.states,
+                input.controls, input.multipliers, input.derivatives,
+                input.parameters, *worker);
+
         // Model with disabled constriants and its associated state. These are
-        // used to compute the accelerations.
+        // used to compute the accelerations. The state is obtained after
+        // applyInput(), which may select a state dedicated to this time.
         const auto& modelDisabledConstraints =
                 mocoProblemRep->getModelDisabledConstraints();
         auto& simtkStateDisabledConstraints =
                 mocoProblemRep->updStateDisabledConstraints();
 
-        applyInput(SimTK::Stage::Acceleration, input.time, input.states,
-                input.controls, input.multipliers, input.derivatives,
-                input.parameters, mocoProblemRep);
-
         modelDisabledConstraints.realizeAcceleration(
                 simtkStateDisabledConstraints);
 
@@ -275,7 +340,7 @@ private:
         if (getNumMultipliers() && calcKCErrors) {
             calcKinematicConstraintErrors(modelBase, simtkStateBase,
                     simtkStateDisabledConstraints,
-                    output.kinematic_constraint_errors);
+                    output.kinematic_constraint_errors, *worker);
         }
 
         const SimTK::SimbodyMatterSubsystem& matterDisabledConstraints =
@@ -294,14 +359,14 @@ private:
         copyImplicitResidualsToOutput(*mocoProblemRep,
                 simtkStateDisabledConstraints, output.auxiliary_residuals);
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
     void calcVelocityCorrection(const double& time,
             const casadi::DM& multibody_states, const casadi::DM& slacks,
             const casadi::DM& parameters,
             casadi::DM& velocity_correction) const override {
         if (isPrescribedKinematics()) return;
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         const auto& modelBase = mocoProblemRep->getModelBase();
         auto& simtkStateBase = mocoProblemRep->updStateBase();
@@ -327,20 +392,31 @@ private:
         SimTK::Vector gamma(getNumSlacks(), slacks.ptr(), true);
         SimTK::Vector qdotCorr((int)velocity_correction.rows(),
                 velocity_correction.ptr(), true);
-        matterBase.multiplyByGTranspose(simtkStateBase, gamma, qdotCorr);
+        if (updConstraintJacobian(modelBase, simtkStateBase, *worker)) {
+            const auto& G = worker->constraintJacobian.G;
+            for (int j = 0; j < qdotCorr.size(); ++j) {
+                double sum = 0;
+                for (int i = 0; i < gamma.size(); ++i) {
+                    sum += G(i, j) * gamma[i];
+                }
+                qdotCorr[j] = sum;
+            }
+        } else {
+            matterBase.multiplyByGTranspose(simtkStateBase, gamma, qdotCorr);
+        }
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
     void calcCostIntegrand(int index, const ContinuousInput& input,
             double& integrand) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         const auto& mocoCost = mocoProblemRep->getCostByIndex(index);
         const auto stageDep = mocoCost.getStageDependency();
 
         applyInput(stageDep, input.time, input.states, input.controls,
                 input.multipliers, input.derivatives, input.parameters,
-                mocoProblemRep);
+                *worker);
 
         auto& simtkStateDisabledConstraints =
                 mocoProblemRep->updStateDisabledConstraints();
@@ -353,25 +429,25 @@ private:
         integrand = mocoCost.calcIntegrand(
                 {input.time, simtkStateDisabledConstraints, rawControls});
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
     void calcCost(int index, const CostInput& input,
             casadi::DM& cost) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         const auto& mocoCost = mocoProblemRep->getCostByIndex(index);
         const auto stageDep = mocoCost.getStageDependency();
 
         applyInput(stageDep, input.initial_time, input.initial_states,
                 input.initial_controls, input.initial_multipliers,
-                input.initial_derivatives, input.parameters, mocoProblemRep, 0);
+                input.initial_derivatives, input.parameters, *worker, 0);
 
         auto& simtkStateDisabledConstraintsInitial =
                 mocoProblemRep->updStateDisabledConstraints(0);
 
         applyInput(stageDep, input.final_time, input.final_states,
                 input.final_controls, input.final_multipliers,
-                input.final_derivatives, input.parameters, mocoProblemRep, 1);
+                input.final_derivatives, input.parameters, *worker, 1);
 
         auto& simtkStateDisabledConstraintsFinal =
                 mocoProblemRep->updStateDisabledConstraints(1);
@@ -392,12 +468,12 @@ private:
                         input.integral},
                 simtkCost);
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
 
     void calcEndpointConstraintIntegrand(int index,
             const ContinuousInput& input, double& integrand) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         const auto& mocoEC =
                 mocoProblemRep->getEndpointConstraintByIndex(index);
@@ -405,7 +481,7 @@ private:
 
         applyInput(stageDep, input.time, input.states, input.controls,
                 input.multipliers, input.derivatives, input.parameters,
-                mocoProblemRep);
+                *worker);
 
         auto& simtkStateDisabledConstraints =
                 mocoProblemRep->updStateDisabledConstraints();
@@ -418,11 +494,11 @@ private:
         integrand = mocoEC.calcIntegrand(
                 {input.time, simtkStateDisabledConstraints, rawControls});
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
     void calcEndpointConstraint(int index, const CostInput& input,
             casadi::DM& values) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
 
         const auto& mocoEC =
                 mocoProblemRep->getEndpointConstraintByIndex(index);
@@ -430,14 +506,14 @@ private:
 
         applyInput(stageDep, input.initial_time, input.initial_states,
                 input.initial_controls, input.initial_multipliers,
-                input.initial_derivatives, input.parameters, mocoProblemRep, 0);
+                input.initial_derivatives, input.parameters, *worker, 0);
 
         auto& simtkStateDisabledConstraintsInitial =
                 mocoProblemRep->updStateDisabledConstraints(0);
 
         applyInput(stageDep, input.final_time, input.final_states,
                 input.final_controls, input.final_multipliers,
-                input.final_derivatives, input.parameters, mocoProblemRep, 1);
+                input.final_derivatives, input.parameters, *worker, 1);
 
         auto& simtkStateDisabledConstraintsFinal =
                 mocoProblemRep->updStateDisabledConstraints(1);
@@ -458,18 +534,18 @@ private:
                         input.integral},
                 simtkValues);
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
 
     void calcPathConstraint(int constraintIndex, const ContinuousInput& input,
             casadi::DM& path_constraint) const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
         // Not all path constraints require realizing to Acceleration. We could
         // add a stage dependency for path constraints, but we have yet to
         // conduct profiling to indicate that such an optimization is necessary.
         applyInput(SimTK::Stage::Acceleration,
                 input.time, input.states, input.controls, input.multipliers,
-                input.derivatives, input.parameters, mocoProblemRep);
+                input.derivatives, input.parameters, *worker);
         auto& simtkStateDisabledConstraints =
                 mocoProblemRep->updStateDisabledConstraints();
 
@@ -481,14 +557,13 @@ private:
         mocoPathCon.calcPathConstraintErrors(
                 simtkStateDisabledConstraints, errors);
 
-        m_jar->leave(std::move(mocoProblemRep));
     }
     std::vector<std::string>
     createKinematicConstraintEquationNamesImpl() const override {
-        auto mocoProblemRep = m_jar->take();
+        WorkerLease worker(*this);
+        const auto& mocoProblemRep = worker->problemRep;
         const auto names = mocoProblemRep->getKinematicConstraintEquationNames(
                 getEnforceConstraintDerivatives());
-        m_jar->leave(std::move(mocoProblemRep));
         return names;
     }
     void intermediateCallbackImpl() const override {
@@ -496,10 +571,13 @@ private:
     }
     void intermediateCallbackWithIterateImpl(
             const CasOC::Iterate& iterate) const override {
-        std::string filename =
-                fmt::format("MocoCasADiSolver_{}_trajectory{:06i}.sto",
-                        m_formattedTimeString, iterate.iteration);
-        convertToMocoTrajectory(iterate).write(filename);
+        // Only the conversion happens on the solver thread; the file is
+        // written in the background.
+        if (m_iterateWriter) {
+            m_iterateWriter->submit(iterate.iteration,
+                    OpenSim::make_unique<MocoTrajectory>(
+                            convertToMocoTrajectory(iterate)));
+        }
     }
 
 private:
@@ -519,29 +597,87 @@ private:
     /// slots in Simbody's Y vector.
     /// It's fine for the size of `states` to be less than the size of Y; only
     /// the first states.size1() values are copied.
+    ///
+    /// The states from the jar are reused from one function evaluation to the
+    /// next, so we only write the groups of values (time, q, u, z) that
+    /// changed. Simbody then keeps the realized cache entries that are still
+    /// valid. This matters for finite differences, which perturb one input at
+    /// a time: when only the controls, multipliers, derivatives, or auxiliary
+    /// states are perturbed, the (expensive) position and velocity stages are
+    /// not realized again. Parameters may change the model without Simbody
+    /// knowing, so we always write all values if there are parameters.
     void convertStatesToSimTKState(SimTK::Stage stageDep, const double& time,
             const casadi::DM& states, const Model& model,
             SimTK::State& simtkState, bool copyAuxStates) const {
         if (stageDep >= SimTK::Stage::Time) {
-            simtkState.setTime(time);
+            const bool writeAll = getNumParameters() > 0;
+            const double* values = states.ptr();
+            bool timeOrQChanged = false;
+            if (writeAll || simtkState.getTime() != time) {
+                simtkState.setTime(time);
+                timeOrQChanged = true;
+            }
             // Assign the generalized coordinates. We know we have NU
             // generalized speeds because we do not yet support quaternions.
-            for (int isv = 0; isv < getNumCoordinates(); ++isv) {
-                simtkState.updQ()[m_yIndexMap.at(isv)] = *(states.ptr() + isv);
+            const int NQ = getNumCoordinates();
+            if (writeAll ||
+                    differs(simtkState.getQ(), values, NQ, &m_yIndexMap)) {
+                SimTK::Vector& q = simtkState.updQ();
+                for (int isv = 0; isv < NQ; ++isv) {
+                    q[m_yIndexMap.at(isv)] = values[isv];
+                }
+                timeOrQChanged = true;
             }
-            std::copy_n(states.ptr() + getNumCoordinates(), getNumSpeeds(),
-                    simtkState.updY().updContiguousScalarData() +
-                            simtkState.getNQ());
-            if (copyAuxStates) {
-                std::copy_n(states.ptr() + getNumCoordinates() + getNumSpeeds(),
-                        getNumAuxiliaryStates(),
+            const int NU = getNumSpeeds();
+            if (writeAll || differs(simtkState.getU(), values + NQ, NU)) {
+                std::copy_n(values + NQ, NU,
                         simtkState.updY().updContiguousScalarData() +
-                                simtkState.getNQ() + simtkState.getNU());
+                                simtkState.getNQ());
+            }
+            const int NZ = getNumAuxiliaryStates();
+            if (copyAuxStates &&
+                    (writeAll ||
+                            differs(simtkState.getZ(), values + NQ + NU, NZ))) {
+                SimTK::Vector& z = simtkState.updZ();
+                for (int iz = 0; iz < NZ; ++iz) { z[iz] = values[NQ + NU + iz]; }
             }
-            // Prescribing motion requires that time is updated.
-            model.getSystem().prescribe(simtkState);
+            // Prescribing motion requires that time is updated. Prescribed
+            // motion depends only on time and q.
+            if (timeOrQChanged) { model.getSystem().prescribe(simtkState); }
         }
     }
+    /// Is any of the first `size` elements of `simtkValues` (indexed through
+    /// `indexMap`, if provided) different from the corresponding element of
+    /// `values`?
+    static bool differs(const SimTK::Vector& simtkValues, const double* values,
+            int size, const std::unordered_map<int, int>* indexMap = nullptr) {
+        for (int i = 0; i < size; ++i) {
+            const int index = indexMap ? indexMap->at(i) : i;
+            if (simtkValues[index] != values[i]) { return true; }
+        }
+        return false;
+    }
+
+    /// Make the worker's constraint Jacobian correspond to the time and
+    /// coordinates of `stateBase` (realized to Stage::Position), and return
+    /// whether it can be used. Building it costs one Simbody operator call per
+    /// multiplier, so it is built only when a second evaluation at the same
+    /// time and coordinates occurs (e.g., when finite differences perturb the
+    /// speeds, controls, multipliers or derivatives); evaluations at new
+    /// coordinates use Simbody's operators directly. It is never used with
+    /// parameters, which may change G without changing the coordinates.
+    /// Each call counts as one evaluation.
+    bool updConstraintJacobian(const Model& modelBase,
+            const SimTK::State& stateBase, Worker& worker) const;
+    /// Can the worker's constraint Jacobian be used for `stateBase`? Unlike
+    /// updConstraintJacobian(), this does not count as an evaluation.
+    static bool hasConstraintJacobian(
+            const SimTK::State& stateBase, const Worker& worker) {
+        const auto& jac = worker.constraintJacobian;
+        return jac.computed && jac.time == stateBase.getTime() &&
+               !differs(stateBase.getQ(), jac.q.getContiguousScalarData(),
+                       jac.q.size());
+    }
 
     /// Invoke convertStatesToSimTKState() and also
     /// copy values from `controls` into the discrete state variable managed
@@ -571,16 +707,19 @@ private:
     void applyInput(SimTK::Stage stageDep, const double& time,
             const casadi::DM& states, const casadi::DM& controls,
             const casadi::DM& multipliers, const casadi::DM& derivatives,
-            const casadi::DM& parameters,
-            const std::unique_ptr<const MocoProblemRep>& mocoProblemRep,
+            const casadi::DM& parameters, Worker& worker,
             int stateDisConIndex = 0) const {
+        const auto& mocoProblemRep = worker.problemRep;
+
         // Original model and its associated state. These are used to calculate
         // kinematic constraint forces and errors.
         const auto& modelBase = mocoProblemRep->getModelBase();
         auto& simtkStateBase = mocoProblemRep->updStateBase();
 
         // Model with disabled constraints and its associated state. These are
-        // used to compute the accelerations.
+        // used to compute the accelerations. With prescribed kinematics, each
+        // time has its own state, so kinematics are realized once per time.
+        mocoProblemRep->selectStateDisabledConstraints(time, stateDisConIndex);
         const auto& modelDisabledConstraints =
                 mocoProblemRep->getModelDisabledConstraints();
         auto& simtkStateDisabledConstraints =
@@ -637,14 +776,14 @@ private:
                     stageDep, time, states, modelBase, simtkStateBase, false);
             calcKinematicConstraintForces(multipliers, simtkStateBase,
                     modelBase, mocoProblemRep->getConstraintForces(),
-                    simtkStateDisabledConstraints);
+                    simtkStateDisabledConstraints, worker);
         }
     }
 
     void calcKinematicConstraintForces(const casadi::DM& multipliers,
             const SimTK::State& stateBase, const Model& modelBase,
             const DiscreteForces& constraintForces,
-            SimTK::State& stateDisabledConstraints) const {
+            SimTK::State& stateDisabledConstraints, Worker& worker) const {
         // Calculate the constraint forces using the original model and the
         // solver-provided Lagrange multipliers.
         modelBase.realizeVelocity(stateBase);
@@ -653,19 +792,37 @@ private:
                 (int)multipliers.size1(), multipliers.ptr(), true);
         // Multipliers are negated so constraint forces can be used like
         // applied forces.
-        matterBase.calcConstraintForcesFromMultipliers(stateBase,
-                -simtkMultipliers, m_constraintBodyForces,
-                m_constraintMobilityForces);
+        if (updConstraintJacobian(modelBase, stateBase, worker)) {
+            const auto& jac = worker.constraintJacobian;
+            auto& bodyForces = worker.constraintBodyForces;
+            auto& mobilityForces = worker.constraintMobilityForces;
+            bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+            mobilityForces = 0;
+            for (int i = 0; i < simtkMultipliers.size(); ++i) {
+                const double lambda = -simtkMultipliers[i];
+                if (lambda == 0) continue;
+                for (int b = 0; b < bodyForces.size(); ++b) {
+                    bodyForces[b] += lambda * jac.bodyForces[i][b];
+                }
+                for (int j = 0; j < mobilityForces.size(); ++j) {
+                    mobilityForces[j] += lambda * jac.mobilityForces(j, i);
+                }
+            }
+        } else {
+            matterBase.calcConstraintForcesFromMultipliers(stateBase,
+                    -simtkMultipliers, worker.constraintBodyForces,
+                    worker.constraintMobilityForces);
+        }
 
         // Apply the constraint forces on the model with disabled constraints.
         constraintForces.setAllForces(stateDisabledConstraints,
-                m_constraintMobilityForces, m_constraintBodyForces);
+                worker.constraintMobilityForces, worker.constraintBodyForces);
     }
 
     void calcKinematicConstraintErrors(const Model& modelBase,
             const SimTK::State& stateBase,
             const SimTK::State& simtkStateDisabledConstraints,
-            casadi::DM& kinematic_constraint_errors) const {
+            casadi::DM& kinematic_constraint_errors, Worker& worker) const {
 
         // If all kinematics are prescribed, we assume that the prescribed
         // kinematics obey any kinematic constraints. Therefore, the kinematic
@@ -690,16 +847,35 @@ private:
             // since we cannot use (nor do we have available) udot computed
             // from the original model.
             const auto& matter = modelBase.getMatterSubsystem();
-            matter.calcConstraintAccelerationErrors(stateBase,
-                    simtkStateDisabledConstraints.getUDot(), m_pvaerr);
+            const auto& udot = simtkStateDisabledConstraints.getUDot();
+            auto& jac = worker.constraintJacobian;
+            if (hasConstraintJacobian(stateBase, worker) &&
+                    jac.udotErrBias.size() &&
+                    !differs(stateBase.getU(), jac.u.getContiguousScalarData(),
+                            jac.u.size())) {
+                for (int i = 0; i < worker.pvaerr.size(); ++i) {
+                    double sum = jac.udotErrBias[i];
+                    for (int j = 0; j < udot.size(); ++j) {
+                        sum += jac.G(i, j) * udot[j];
+                    }
+                    worker.pvaerr[i] = sum;
+                }
+            } else {
+                matter.calcConstraintAccelerationErrors(
+                        stateBase, udot, worker.pvaerr);
+                if (hasConstraintJacobian(stateBase, worker)) {
+                    jac.u = stateBase.getU();
+                    jac.udotErrBias = worker.pvaerr - jac.G * udot;
+                }
+            }
         } else {
-            m_pvaerr = SimTK::NaN;
+            worker.pvaerr = SimTK::NaN;
         }
 
         const auto& uerr = stateBase.getUErr();
         int uerrOffset;
         int uerrSize;
-        const auto& udoterr = m_pvaerr;
+        const auto& udoterr = worker.pvaerr;
         int udoterrOffset;
         int udoterrSize;
         // TODO These offsets and sizes could be computed once.
@@ -746,21 +922,21 @@ private:
         }
     }
 
-    std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> m_jar;
+    /// Every worker is in this jar unless a thread is using it. Threads
+    /// other than the one that created this problem (that is, the threads
+    /// CasADi uses to evaluate functions in parallel) keep the worker they
+    /// take until the thread exits; see WorkerLease. The jar is shared so
+    /// that a thread that outlives this problem does not return its worker to
+    /// a destroyed jar.
+    std::shared_ptr<ThreadsafeJar<Worker>> m_workers;
+    int m_numWorkers = 0;
+    std::thread::id m_creationThreadId;
     bool m_paramsRequireInitSystem = true;
     std::string m_formattedTimeString;
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
     std::unique_ptr<FileDeletionThrower> m_fileDeletionThrower;
-    // Local memory to hold constraint forces.
-    static thread_local SimTK::Vector_<SimTK::SpatialVec>
-            m_constraintBodyForces;
-    static thread_local SimTK::Vector m_constraintMobilityForces;
-    // This is the output argument of
-    // SimbodyMatterSubsystem::calcConstraintAccelerationErrors(), and includes
-    // the acceleration-level holonomic, non-holonomic constraint errors and the
-    // acceleration-only constraint errors.
-    static thread_local SimTK::Vector m_pvaerr;
+    std::unique_ptr<MocoCasOCIterateWriter> m_iterateWriter;
 };
 
 } // namespace OpenSim
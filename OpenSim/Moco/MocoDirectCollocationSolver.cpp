@@ -34,6 +34,7 @@ void MocoDirectCollocationSolver::constructProperties() {
     constructProperty_optim_constraint_tolerance(-1);
     constructProperty_optim_hessian_approximation("limited-memory");
     constructProperty_optim_ipopt_print_level(-1);
+    constructProperty_optim_automatic_scaling(false);
     constructProperty_guess_file("");
     constructProperty_velocity_correction_bounds({-0.1, 0.1});
     constructProperty_implicit_multibody_acceleration_bounds({-1000, 1000});
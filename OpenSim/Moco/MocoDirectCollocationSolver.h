@@ -48,6 +48,14 @@ endpoint values (default and recommended setting). If solving problems
 including model kinematic constraints, the 'hermite-simpson' option is
 required (see Kinematic constraints section below).
 
+MocoCasADiSolver also supports Legendre-Gauss-Radau pseudospectral
+transcription, with schemes 'legendre-gauss-radau-1' through
+'legendre-gauss-radau-9'; the number is the degree of the polynomial (the
+number of collocation points) in each mesh interval. Higher degrees give more
+accurate solutions for smooth problems with fewer mesh intervals. Path
+constraints are enforced only at the mesh points, and kinematic constraints are
+not supported with these schemes.
+
 Path constraints on controls with Hermite-Simpson transcription
 ---------------------------------------------------------------
 For Hermite-Simpson transcription, the direct collocation solvers enforce
@@ -97,8 +105,10 @@ public:
             "0 for silent. 1 for only Moco's own output. "
             "2 for output from CasADi and the underlying solver (default: 2).");
     OpenSim_DECLARE_PROPERTY(transcription_scheme, std::string,
-            "'trapezoidal' for trapezoidal transcription, or 'hermite-simpson' "
-            "(default) for separated Hermite-Simpson transcription.");
+            "'trapezoidal' for trapezoidal transcription, 'hermite-simpson' "
+            "(default) for separated Hermite-Simpson transcription, or "
+            "'legendre-gauss-radau-<degree>' (degree 1-9; MocoCasADiSolver "
+            "only) for Legendre-Gauss-Radau pseudospectral transcription.");
     OpenSim_DECLARE_PROPERTY(interpolate_control_midpoints, bool,
             "If the transcription scheme is set to 'hermite-simpson', then "
             "enable this property to constrain the control values at mesh "
@@ -119,11 +129,18 @@ public:
             "Tolerance used to determine if the constraints are satisfied "
             "(-1 for solver's default)");
     OpenSim_DECLARE_PROPERTY(optim_hessian_approximation, std::string,
-            "When using IPOPT, 'limited-memory' (default) for quasi-Newton, or "
-            "'exact' for full "
-            "Newton.");
+            "When using IPOPT, 'limited-memory' (default) for quasi-Newton, "
+            "'exact' for full Newton, or 'exact-goals' (MocoCasADiSolver only) "
+            "for the exact Hessian of the symbolic goal terms alone.");
     OpenSim_DECLARE_PROPERTY(optim_ipopt_print_level, int,
             "IPOPT's verbosity (see IPOPT documentation).");
+    OpenSim_DECLARE_PROPERTY(optim_automatic_scaling, bool,
+            "Scale each variable of the optimization problem by its largest "
+            "finite bound (or by the largest magnitude in the initial guess "
+            "if it is unbounded on either side), and scale the defect "
+            "constraints of each state by the scale of that state. This often "
+            "reduces the number of iterations when variables with very "
+            "different magnitudes are mixed (default: false).");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(enforce_constraint_derivatives, bool,
             "'true' (default) or 'false', whether or not derivatives of "
             "kinematic constraints are enforced as path constraints in the "
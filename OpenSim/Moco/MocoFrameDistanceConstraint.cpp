@@ -60,16 +60,30 @@ void MocoFrameDistanceConstraint::initializeOnModelImpl(
     // TODO: setConstraintInfo() is not really intended for use here.
     MocoConstraintInfo info;
     std::vector<MocoBounds> bounds;
+    m_frames.clear();
+    m_frame_pairs.clear();
+    const auto resolveFrame = [&](const std::string& path) {
+        OPENSIM_THROW_IF(!model.hasComponent<Frame>(path), Exception,
+                "Could not find frame '{}'.", path);
+        const auto& frame = model.getComponent<Frame>(path);
+        for (int i = 0; i < (int)m_frames.size(); ++i) {
+            if (m_frames[i].frame.get() == &frame) return i;
+        }
+        ResolvedFrame resolved;
+        resolved.frame.reset(&frame);
+        const auto& baseFrame = frame.findBaseFrame();
+        if (const auto* physicalBase =
+                        dynamic_cast<const PhysicalFrame*>(&baseFrame)) {
+            resolved.mobodIndex = physicalBase->getMobilizedBodyIndex();
+        }
+        resolved.isBaseFrame = &baseFrame == &frame;
+        m_frames.push_back(resolved);
+        return (int)m_frames.size() - 1;
+    };
     for (int i = 0; i < nFramePairs; ++i) {
-        const auto frame1_path = get_frame_pairs(i).get_frame1_path();
-        OPENSIM_THROW_IF(!model.hasComponent<Frame>(frame1_path), Exception,
-                "Could not find frame '{}'.", frame1_path);
-        auto& frame1 = model.getComponent<Frame>(frame1_path);
-        const auto frame2_path = get_frame_pairs(i).get_frame2_path();
-        OPENSIM_THROW_IF(!model.hasComponent<Frame>(frame2_path), Exception,
-                "Could not find frame '{}'.", frame2_path);
-        auto& frame2 = model.getComponent<Frame>(frame2_path);
-        m_frame_pairs.emplace_back(&frame1, &frame2);
+        const int frame1 = resolveFrame(get_frame_pairs(i).get_frame1_path());
+        const int frame2 = resolveFrame(get_frame_pairs(i).get_frame2_path());
+        m_frame_pairs.emplace_back(frame1, frame2);
 
         const double& minimum = get_frame_pairs(i).get_minimum_distance();
         const double& maximum = get_frame_pairs(i).get_maximum_distance();
@@ -114,12 +128,32 @@ void MocoFrameDistanceConstraint::initializeOnModelImpl(
 void MocoFrameDistanceConstraint::calcPathConstraintErrorsImpl(
         const SimTK::State& state, SimTK::Vector& errors) const {
     getModel().realizePosition(state);
+    const auto& matter = getModel().getMatterSubsystem();
+    m_positionsInGround.resize(m_frames.size());
+    for (int i = 0; i < (int)m_frames.size(); ++i) {
+        const auto& resolved = m_frames[i];
+        if (!resolved.mobodIndex.isValid()) {
+            m_positionsInGround[i] = resolved.frame->getPositionInGround(state);
+            continue;
+        }
+        const SimTK::Transform& X_GB =
+                matter.getMobilizedBody(resolved.mobodIndex)
+                        .getBodyTransform(state);
+        if (resolved.isBaseFrame) {
+            m_positionsInGround[i] = X_GB.p();
+        } else {
+            // The offset is read from the frame each time, since parameters
+            // may change it.
+            m_positionsInGround[i] =
+                    X_GB * resolved.frame->findTransformInBaseFrame().p();
+        }
+    }
+
     int iconstr = 0;
     SimTK::Vec3 relative_position;
     for (const auto& frame_pair : m_frame_pairs) {
-        const auto& frame1_pos = frame_pair.first->getPositionInGround(state);
-        const auto& frame2_pos = frame_pair.second->getPositionInGround(state);
-        relative_position = frame2_pos - frame1_pos;
+        relative_position = m_positionsInGround[frame_pair.second] -
+                            m_positionsInGround[frame_pair.first];
         SimTK::Vec3 projected;
         if (m_projectionType == ProjectionType::None) {
             projected = relative_position;
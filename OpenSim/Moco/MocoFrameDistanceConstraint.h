@@ -145,8 +145,22 @@ private:
     mutable ProjectionType m_projectionType = ProjectionType::None;
     mutable SimTK::UnitVec3 m_projectionVector;
 
-    mutable std::vector<std::pair<SimTK::ReferencePtr<const Frame>,
-            SimTK::ReferencePtr<const Frame>>> m_frame_pairs;
+    // The distinct frames in the frame pairs. The position of a frame whose
+    // base frame is a body (or ground) is computed from the transform of the
+    // body's mobilized body, so all frames come from one pass over the
+    // realized body transforms, and a frame shared by several pairs is
+    // computed once.
+    struct ResolvedFrame {
+        SimTK::ReferencePtr<const Frame> frame;
+        // Invalid if the base frame is not a PhysicalFrame.
+        SimTK::MobilizedBodyIndex mobodIndex;
+        // Whether the frame is its own base frame (e.g., a Body).
+        bool isBaseFrame = false;
+    };
+    mutable std::vector<ResolvedFrame> m_frames;
+    // Indices into m_frames.
+    mutable std::vector<std::pair<int, int>> m_frame_pairs;
+    mutable std::vector<SimTK::Vec3> m_positionsInGround;
 };
 
 } // namespace OpenSim
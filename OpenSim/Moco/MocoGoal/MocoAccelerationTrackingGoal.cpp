@@ -90,6 +90,8 @@ void MocoAccelerationTrackingGoal::initializeOnModelImpl(
     m_ref_splines = GCVSplineSet(accelerationTable.flatten(
         {"/acceleration_x", "/acceleration_y", "/acceleration_z"}));
 
+    m_ref_cache.clear();
+
     setRequirements(1, 1);
 }
 
@@ -98,7 +100,8 @@ void MocoAccelerationTrackingGoal::calcIntegrandImpl(
     const auto& state = input.state;
     const auto& time = state.getTime();
     getModel().realizeAcceleration(state);
-    SimTK::Vector timeVec(1, time);
+    const SimTK::Vector& refValues =
+            m_ref_cache.getValues(m_ref_splines, time);
 
     integrand = 0;
     Vec3 acceleration_ref(0.0);
@@ -109,7 +112,7 @@ void MocoAccelerationTrackingGoal::calcIntegrandImpl(
         // Compute acceleration error.
         for (int ia = 0; ia < acceleration_ref.size(); ++ia) {
             acceleration_ref[ia] =
-                    m_ref_splines[3*iframe + ia].calcValue(timeVec);
+                    refValues[3*iframe + ia];
         }
         Vec3 error = acceleration_model - acceleration_ref;
 
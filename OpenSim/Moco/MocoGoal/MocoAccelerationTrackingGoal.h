@@ -20,6 +20,7 @@
 
 #include <OpenSim/Moco/MocoWeightSet.h>
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 #include "OpenSim/Simulation/TableProcessor.h"
 
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -137,6 +138,7 @@ private:
 
     TimeSeriesTableVec3 m_acceleration_table;
     mutable GCVSplineSet m_ref_splines;
+    mutable MocoReferenceCache m_ref_cache;
     mutable std::vector<std::string> m_frame_paths;
     mutable std::vector<SimTK::ReferencePtr<const Frame>> m_model_frames;
     mutable std::vector<double> m_acceleration_weights;
@@ -244,7 +244,6 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
     const auto& state = input.state;
     const auto& time = state.getTime();
     getModel().realizeVelocity(state);
-    SimTK::Vector timeVec(1, time);
 
     integrand = 0;
     SimTK::Vec3 force_ref;
@@ -261,8 +260,10 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
         }
 
         // Reference force.
+        const SimTK::Vector& refValues =
+                group.refCache.getValues(group.refSplines, time);
         for (int ir = 0; ir < force_ref.size(); ++ir) {
-            force_ref[ir] = group.refSplines[ir].calcValue(timeVec);
+            force_ref[ir] = refValues[ir];
         }
 
         // Re-express the reference force.
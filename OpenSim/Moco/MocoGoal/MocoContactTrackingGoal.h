@@ -19,6 +19,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 #include <OpenSim/Simulation/Model/ExternalLoads.h>
 
 namespace OpenSim {
@@ -267,6 +268,7 @@ private:
     struct GroupInfo {
         std::vector<std::pair<const SmoothSphereHalfSpaceForce*, int>> contacts;
         GCVSplineSet refSplines;
+        mutable MocoReferenceCache refCache;
         const PhysicalFrame* refExpressedInFrame = nullptr;
     };
     mutable std::vector<GroupInfo> m_groups;
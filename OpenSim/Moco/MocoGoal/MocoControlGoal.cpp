@@ -129,6 +129,15 @@ void MocoControlGoal::calcIntegrandImpl(
     }
 }
 
+bool MocoControlGoal::getControlPowerIntegrandImpl(
+        std::vector<int>& controlIndices, std::vector<double>& weights,
+        int& exponent) const {
+    controlIndices = m_controlIndices;
+    weights = m_weights;
+    exponent = get_exponent();
+    return true;
+}
+
 void MocoControlGoal::calcGoalImpl(
         const GoalInput& input, SimTK::Vector& cost) const {
     cost[0] = input.integral;
@@ -200,6 +200,20 @@ public:
         return integrand;
     }
 
+    /// If the integrand is a weighted sum of powers of the controls,
+    /// \f$ \sum_i w_i |x_i(t)|^p \f$, get the indices of the controls (in
+    /// the order of the system's controls), the weights \f$ w_i \f$, and the
+    /// exponent \f$ p \f$, and return true. Solvers can use this to build an
+    /// exact symbolic expression for the integrand instead of evaluating
+    /// calcIntegrand() (e.g., MocoCasADiSolver's optim_symbolic_integrands
+    /// setting). Returns false for all other integrands.
+    /// @precondition initializeOnModel() has been invoked.
+    bool getControlPowerIntegrand(std::vector<int>& controlIndices,
+            std::vector<double>& weights, int& exponent) const {
+        if (!get_enabled() || getNumIntegrals() == 0) { return false; }
+        return getControlPowerIntegrandImpl(controlIndices, weights, exponent);
+    }
+
     /// @see IntegrandInput.
     struct GoalInput {
         const SimTK::Real& initial_time;
@@ -338,6 +352,13 @@ protected:
     /// The Lagrange multipliers for kinematic constraints are not available.
     virtual void calcIntegrandImpl(
             const IntegrandInput& input, SimTK::Real& integrand) const;
+    /// Override this function only if calcIntegrandImpl() computes
+    /// \f$ \sum_i w_i |x_i(t)|^p \f$ (and nothing else).
+    /// @see getControlPowerIntegrand().
+    virtual bool getControlPowerIntegrandImpl(std::vector<int>&,
+            std::vector<double>&, int&) const {
+        return false;
+    }
     /// You may need to realize the state to the stage required for your
     /// calculations.
     /// Do NOT realize to a stage higher than the goal's stage dependency;
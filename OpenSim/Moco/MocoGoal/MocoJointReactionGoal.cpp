@@ -120,13 +120,18 @@ void MocoJointReactionGoal::calcIntegrandImpl(
     getModel().realizeAcceleration(input.state);
     const auto& ground = getModel().getGround();
 
-    // Compute the reaction loads on the parent or child frame.
+    // Compute the reaction loads on the parent or child frame. The reactions
+    // of all mobilizers are computed in one pass and cached in the state, so
+    // that all joint reaction goals share them.
+    const auto& mobilizerReactions =
+            getModel().getMobilizerReactionForces(input.state);
     SimTK::SpatialVec reactionInGround;
     if (m_isParentFrame) {
-        reactionInGround =
-                m_joint->calcReactionOnParentExpressedInGround(input.state);
+        reactionInGround = m_joint->calcReactionOnParentExpressedInGround(
+                input.state, mobilizerReactions);
     } else {
-        reactionInGround = m_joint->calcReactionOnChildExpressedInGround(input.state);
+        reactionInGround = m_joint->calcReactionOnChildExpressedInGround(
+                input.state, mobilizerReactions);
     }
 
     // Re-express the reactions into the proper frame and repackage into a new
@@ -73,11 +73,20 @@ void MocoMarkerTrackingGoal::initializeOnModelImpl(const Model& model) const {
     get_markers_reference().getWeights(s, m_marker_weights);
     m_marker_names = get_markers_reference().getNames();
 
-    // Get and flatten TimeSeriesTableVec3 to doubles and create a set of
-    // reference splines, one for each component of the coordinate
-    // trajectories.
-    m_refsplines =
-            GCVSplineSet(get_markers_reference().getMarkerTable().flatten());
+    // Create a set of reference splines, one for each component of the
+    // marker trajectories, from a flattened view of the TimeSeriesTableVec3
+    // (the table itself is not flattened).
+    m_refsplines = GCVSplineSet(FlattenedTableView(
+            get_markers_reference().getMarkerTable()));
+
+    m_ref_cache.clear();
+
+    // Compute the locations of all the tracked markers in one pass.
+    m_marker_snapshot.clear();
+    for (const auto& marker : m_model_markers) {
+        m_marker_snapshot.addStation(
+                marker->getParentFrame(), marker->get_location());
+    }
 
     setRequirements(1, 1, SimTK::Stage::Position);
 }
@@ -86,19 +95,23 @@ void MocoMarkerTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
      const auto& time = input.state.getTime();
      getModel().realizePosition(input.state);
-     SimTK::Vector timeVec(1, time);
+     const SimTK::Vector& refValues =
+            m_ref_cache.getValues(m_refsplines, time);
+
+    m_marker_snapshot.update(input.state);
+    const SimTK::Vector_<SimTK::Vec3>& modelValues =
+            m_marker_snapshot.getLocationsInGround();
 
     for (int i = 0; i < (int)m_model_markers.size(); ++i) {
-         const auto& modelValue =
-                 m_model_markers[i]->getLocationInGround(input.state);
+         const auto& modelValue = modelValues[i];
          SimTK::Vec3 refValue;
 
         // Get the markers reference index corresponding to the current
         // model marker and get the reference value.
         int refidx = m_refindices[i];
-        refValue[0] = m_refsplines[3 * refidx].calcValue(timeVec);
-        refValue[1] = m_refsplines[3 * refidx + 1].calcValue(timeVec);
-        refValue[2] = m_refsplines[3 * refidx + 2].calcValue(timeVec);
+        refValue[0] = refValues[3 * refidx];
+        refValue[1] = refValues[3 * refidx + 1];
+        refValue[2] = refValues[3 * refidx + 2];
 
         double distance = (modelValue - refValue).normSqr();
 
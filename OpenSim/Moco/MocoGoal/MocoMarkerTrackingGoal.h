@@ -19,9 +19,11 @@
  * -------------------------------------------------------------------------- */
 
 #include "MocoGoal.h"
+#include "MocoReferenceCache.h"
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/KinematicsSnapshot.h>
 #include <OpenSim/Simulation/MarkersReference.h>
 
 namespace OpenSim {
@@ -89,8 +91,10 @@ protected:
             "not in the model (such data would be ignored). Default: false.");
 
     mutable GCVSplineSet m_refsplines;
+    mutable MocoReferenceCache m_ref_cache;
     mutable std::vector<SimTK::ReferencePtr<const Marker>> m_model_markers;
     mutable std::vector<int> m_refindices;
+    mutable KinematicsSnapshot m_marker_snapshot;
     mutable SimTK::Array_<double> m_marker_weights;
     mutable SimTK::Array_<std::string> m_marker_names;
 
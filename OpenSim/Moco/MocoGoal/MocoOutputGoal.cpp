@@ -37,14 +37,30 @@ void MocoOutputGoal::initializeOnModelImpl(const Model& output) const {
             get_output_path(), componentPath, outputName, channelName, alias);
     const auto& component = getModel().getComponent(componentPath);
     const auto& abstractOutput = component.getOutput(outputName);
-    m_output.reset(&dynamic_cast<const Output<double>&>(abstractOutput));
-    setRequirements(1, 1, m_output->getDependsOnStage());
+    OPENSIM_THROW_IF_FRMOBJ(abstractOutput.getTypeName() != "double",
+            Exception,
+            "Expected the output '{}' to be of type double, but it is of type "
+            "{}.",
+            get_output_path(), abstractOutput.getTypeName());
+    OPENSIM_THROW_IF_FRMOBJ(
+            abstractOutput.isListOutput() && channelName.empty(), Exception,
+            "The output '{}' is a list output; a channel must be specified "
+            "with '{}:<channel_name>'.",
+            get_output_path(), get_output_path());
+
+    // Bind to the channel directly, so that evaluating the integrand does not
+    // need to check the type, the list status or the stage of the output.
+    const auto& channel = abstractOutput.getChannel(
+            channelName.empty() ? outputName : channelName);
+    m_channel.reset(&dynamic_cast<const Output<double>::Channel&>(channel));
+    m_dependsOnStage = abstractOutput.getDependsOnStage();
+    setRequirements(1, 1, m_dependsOnStage);
 }
 
 void MocoOutputGoal::calcIntegrandImpl(
         const IntegrandInput& input, double& integrand) const {
-    getModel().getSystem().realize(input.state, m_output->getDependsOnStage());
-    integrand = m_output->getValue(input.state);
+    getModel().getSystem().realize(input.state, m_dependsOnStage);
+    integrand = m_channel->getValue(input.state);
 }
 
 void MocoOutputGoal::calcGoalImpl(
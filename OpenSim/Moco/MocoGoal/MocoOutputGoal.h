@@ -23,7 +23,9 @@
 namespace OpenSim {
 
 /** This goal allows you to use any (double, or scalar) Output in the model
-as the integrand of a goal.
+as the integrand of a goal. The output path may name a channel of a list
+output ("/path/to/component|output_name:channel_name"). The output is
+resolved once, when the goal is initialized.
 @ingroup mocogoal */
 class OSIMMOCO_API MocoOutputGoal : public MocoGoal {
     OpenSim_DECLARE_CONCRETE_OBJECT(MocoOutputGoal, MocoGoal);
@@ -74,7 +76,8 @@ private:
             "Divide by the model's total mass (default: false)");
     void constructProperties();
 
-    mutable SimTK::ReferencePtr<const Output<double>> m_output;
+    mutable SimTK::ReferencePtr<const Output<double>::Channel> m_channel;
+    mutable SimTK::Stage m_dependsOnStage = SimTK::Stage::Acceleration;
 };
 
 } // namespace OpenSim
@@ -0,0 +1,37 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoReferenceCache.cpp                                            *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoReferenceCache.h"
+
+#include <OpenSim/Common/FunctionSet.h>
+
+using namespace OpenSim;
+
+const SimTK::Vector& MocoReferenceCache::getValues(
+        const FunctionSet& functions, double time) {
+    auto it = m_values.find(time);
+    if (it != m_values.end()) return it->second;
+
+    if ((int)m_values.size() >= m_maxNumTimes) m_values.clear();
+    const int numFunctions = functions.getSize();
+    const SimTK::Vector timeVec(1, time);
+    SimTK::Vector& values = m_values[time];
+    values.resize(numFunctions);
+    for (int i = 0; i < numFunctions; ++i) {
+        values[i] = functions[i].calcValue(timeVec);
+    }
+    return values;
+}
@@ -0,0 +1,60 @@
+#ifndef OPENSIM_MOCOREFERENCECACHE_H
+#define OPENSIM_MOCOREFERENCECACHE_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoReferenceCache.h                                              *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Moco/osimMocoDLL.h>
+
+#include <unordered_map>
+
+#include <SimTKcommon.h>
+
+namespace OpenSim {
+
+class FunctionSet;
+
+/** Values of a set of reference functions (e.g., the splined reference data
+of a tracking goal), cached for each time at which they were requested.
+Direct collocation solvers evaluate goals at the same mesh and collocation
+times over and over (for example, for finite differences), so each function
+is evaluated only once per time. If the cache grows beyond a maximum number of
+times (which happens when the initial or final time is a variable), it is
+cleared.
+
+A goal holds one cache for each set of functions, and clears it whenever it
+recreates the functions (in initializeOnModelImpl()). The cache is not
+thread-safe; like the rest of a goal, each thread must use its own copy. */
+class OSIMMOCO_API MocoReferenceCache {
+public:
+    explicit MocoReferenceCache(int maxNumTimes = 20000)
+            : m_maxNumTimes(maxNumTimes) {}
+    /** Remove all cached values. */
+    void clear() { m_values.clear(); }
+    /** The values of all functions in `functions` at `time` (one per
+    function). The reference is valid until the next call to getValues() or
+    clear(). */
+    const SimTK::Vector& getValues(const FunctionSet& functions, double time);
+    /** The number of times for which values have been cached. */
+    int getNumTimes() const { return (int)m_values.size(); }
+
+private:
+    int m_maxNumTimes;
+    std::unordered_map<double, SimTK::Vector> m_values;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOREFERENCECACHE_H
@@ -114,6 +114,7 @@ std::pair<MocoStudy, TimeSeriesTable> MocoInverse::initializeInternal() const {
     if (!getProperty_max_iterations().empty()) {
         solver.set_optim_max_iterations(get_max_iterations());
     }
+    applyCachedGuess(solver);
     return std::make_pair(
             study, posmotPtr->exportToTable(kinematics.getIndependentColumn()));
 }
@@ -123,6 +124,7 @@ MocoInverseSolution MocoInverse::solve() const {
     const auto& study = init.first;
 
     MocoSolution mocoSolution = study.solve().unseal();
+    addSolutionToGuessCache(mocoSolution);
 
     const auto& statesTrajTable = init.second;
     mocoSolution.insertStatesTrajectory(statesTrajTable);
@@ -0,0 +1,185 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoMappedTrajectory.cpp                                          *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "MocoMappedTrajectory.h"
+
+using namespace OpenSim;
+
+MocoMappedTrajectory::MocoMappedTrajectory(const std::string& filepath)
+        : m_file(filepath), m_info(BinaryTableFileInfo::read(filepath)) {
+    OPENSIM_THROW_IF(m_info.dataType != "double" ||
+                             m_info.numComponents != 1,
+            Exception,
+            "Expected a binary table of doubles in '{}', but the data type is "
+            "'{}'.",
+            filepath, m_info.dataType);
+    OPENSIM_THROW_IF(m_file.getSize() < m_info.getFileSize(), Exception,
+            "Expected '{}' to contain {} bytes, but it contains {}.", filepath,
+            m_info.getFileSize(), m_file.getSize());
+    OPENSIM_THROW_IF(m_info.numRows < 1, Exception,
+            "Expected '{}' to contain at least one time point.", filepath);
+
+    static const char* keys[NumBlocks] = {"num_states", "num_controls",
+            "num_multipliers", "num_derivatives", "num_slacks",
+            "num_parameters"};
+    int offset = 0;
+    for (int block = 0; block < NumBlocks; ++block) {
+        const auto it = std::find_if(m_info.metadata.begin(),
+                m_info.metadata.end(),
+                [&](const std::pair<std::string, std::string>& kv) {
+                    return kv.first == keys[block];
+                });
+        OPENSIM_THROW_IF(it == m_info.metadata.end(), Exception,
+                "Expected '{}' to contain the metadata key '{}'; was it "
+                "written with MocoTrajectory::write()?",
+                filepath, keys[block]);
+        int num;
+        SimTK::convertStringTo(it->second, num);
+        OPENSIM_THROW_IF(num < 0 || offset + num > (int)m_info.numColumns,
+                Exception, "Invalid {} in '{}'.", keys[block], filepath);
+        m_offsets[block] = offset;
+        m_names[block].assign(m_info.columnLabels.begin() + offset,
+                m_info.columnLabels.begin() + offset + num);
+        offset += num;
+    }
+    OPENSIM_THROW_IF(offset != (int)m_info.numColumns, Exception,
+            "Expected the number of columns in '{}' ({}) to match the "
+            "metadata ({}).",
+            filepath, m_info.numColumns, offset);
+}
+
+const double* MocoMappedTrajectory::getColumnData(
+        int block, int column) const {
+    return reinterpret_cast<const double*>(m_file.getData() +
+            m_info.getColumnOffset(m_offsets[block] + column));
+}
+
+double MocoMappedTrajectory::getInitialTime() const {
+    return reinterpret_cast<const double*>(
+            m_file.getData() + m_info.getTimeOffset())[0];
+}
+
+double MocoMappedTrajectory::getFinalTime() const {
+    return reinterpret_cast<const double*>(m_file.getData() +
+            m_info.getTimeOffset())[getNumTimes() - 1];
+}
+
+SimTK::Vector MocoMappedTrajectory::getTime() const {
+    return SimTK::Vector(getNumTimes(), reinterpret_cast<const double*>(
+            m_file.getData() + m_info.getTimeOffset()));
+}
+
+SimTK::Vector MocoMappedTrajectory::getColumn(int block,
+        const std::string& kind, const std::string& name) const {
+    const auto& names = m_names[block];
+    const auto it = std::find(names.begin(), names.end(), name);
+    OPENSIM_THROW_IF(it == names.end(), Exception,
+            "Cannot find {} named {}.", kind, name);
+    return SimTK::Vector(getNumTimes(),
+            getColumnData(block, int(it - names.begin())));
+}
+
+SimTK::Vector MocoMappedTrajectory::getState(const std::string& name) const {
+    return getColumn(States, "state", name);
+}
+SimTK::Vector MocoMappedTrajectory::getControl(
+        const std::string& name) const {
+    return getColumn(Controls, "control", name);
+}
+SimTK::Vector MocoMappedTrajectory::getMultiplier(
+        const std::string& name) const {
+    return getColumn(Multipliers, "multiplier", name);
+}
+SimTK::Vector MocoMappedTrajectory::getDerivative(
+        const std::string& name) const {
+    return getColumn(Derivatives, "derivative", name);
+}
+SimTK::Vector MocoMappedTrajectory::getSlack(const std::string& name) const {
+    return getColumn(Slacks, "slack", name);
+}
+double MocoMappedTrajectory::getParameter(const std::string& name) const {
+    // Parameters are stored in the first row.
+    return getColumn(Parameters, "parameter", name)[0];
+}
+
+MocoTrajectory MocoMappedTrajectory::read(int startIndex, int numTimes) const {
+    OPENSIM_THROW_IF(startIndex < 0 || numTimes < 0 ||
+                             startIndex + numTimes > getNumTimes(),
+            Exception,
+            "Expected the time points [{}, {}) to be within [0, {}).",
+            startIndex, startIndex + numTimes, getNumTimes());
+    MocoTrajectory traj;
+    traj.m_time = SimTK::Vector(numTimes,
+            reinterpret_cast<const double*>(
+                    m_file.getData() + m_info.getTimeOffset()) +
+                    startIndex);
+    const auto readBlock = [&](int block) {
+        SimTK::Matrix matrix(numTimes, (int)m_names[block].size());
+        for (int icol = 0; icol < matrix.ncol(); ++icol) {
+            const double* data = getColumnData(block, icol) + startIndex;
+            for (int itime = 0; itime < numTimes; ++itime) {
+                matrix(itime, icol) = data[itime];
+            }
+        }
+        return matrix;
+    };
+    traj.m_state_names = m_names[States];
+    traj.m_control_names = m_names[Controls];
+    traj.m_multiplier_names = m_names[Multipliers];
+    traj.m_derivative_names = m_names[Derivatives];
+    traj.m_slack_names = m_names[Slacks];
+    traj.m_parameter_names = m_names[Parameters];
+    traj.m_states = readBlock(States);
+    traj.m_controls = readBlock(Controls);
+    traj.m_multipliers = readBlock(Multipliers);
+    traj.m_derivatives = readBlock(Derivatives);
+    traj.m_slacks = readBlock(Slacks);
+    traj.m_parameters.resize((int)m_names[Parameters].size());
+    for (int i = 0; i < traj.m_parameters.size(); ++i) {
+        traj.m_parameters[i] = getColumnData(Parameters, i)[0];
+    }
+    traj.indexNames();
+    return traj;
+}
+
+MocoTrajectory::ContinuousVariables
+MocoMappedTrajectory::getContinuousVariables() const {
+    MocoTrajectory::ContinuousVariables vars;
+    vars.time = getTime();
+    vars.names = {m_names[States], m_names[Controls], m_names[Multipliers],
+            m_names[Derivatives]};
+    // The continuous blocks are the first four blocks of the file.
+    vars.getColumn = [this](int block, int column) {
+        return SimTK::Vector(getNumTimes(), getColumnData(block, column));
+    };
+    return vars;
+}
+
+double MocoMappedTrajectory::compareContinuousVariablesRMS(
+        const MocoMappedTrajectory& other,
+        std::map<std::string, std::vector<std::string>> columnsToUse) const {
+    return MocoTrajectory::compareContinuousVariablesRMSInternal(
+            getContinuousVariables(), other.getContinuousVariables(),
+            columnsToUse);
+}
+
+double MocoMappedTrajectory::compareContinuousVariablesRMS(
+        const MocoTrajectory& other,
+        std::map<std::string, std::vector<std::string>> columnsToUse) const {
+    other.ensureUnsealed();
+    return MocoTrajectory::compareContinuousVariablesRMSInternal(
+            getContinuousVariables(), other.getContinuousVariables(),
+            columnsToUse);
+}
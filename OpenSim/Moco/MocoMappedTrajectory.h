@@ -0,0 +1,114 @@
+#ifndef OPENSIM_MOCOMAPPEDTRAJECTORY_H
+#define OPENSIM_MOCOMAPPEDTRAJECTORY_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoMappedTrajectory.h                                            *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "MocoTrajectory.h"
+#include "osimMocoDLL.h"
+
+#include <OpenSim/Common/BinaryFileAdapter.h>
+#include <OpenSim/Common/MemoryMappedFile.h>
+
+namespace OpenSim {
+
+/// A read-only MocoTrajectory that stays on disk. The trajectory must have
+/// been written in the binary format (MocoTrajectory::write() with the
+/// ".bsto" extension). The file is mapped into memory, so only the columns
+/// and time ranges that are accessed are read, and the trajectory never has
+/// to fit in memory at once. This is useful for post-processing long
+/// predictive simulations (e.g., multiple strides with many mesh points).
+///
+/// Single columns are copied out with getState(), getControl(), etc., and
+/// a time range is read into a regular MocoTrajectory with read(). The
+/// analyses stream over the file in chunks of time points:
+/// @code
+/// solution.write("running_solution.bsto");
+/// MocoMappedTrajectory mapped("running_solution.bsto");
+/// auto forces = analyzeMocoTrajectory<double>(model, mapped,
+///         {".*tendon_force"});
+/// double rms = mapped.compareContinuousVariablesRMS(
+///         MocoMappedTrajectory("reference.bsto"));
+/// @endcode
+class OSIMMOCO_API MocoMappedTrajectory {
+public:
+    /// @throws Exception if the file is not a binary MocoTrajectory file.
+    explicit MocoMappedTrajectory(const std::string& filepath);
+
+    const std::string& getFilePath() const { return m_file.getFileName(); }
+
+    int getNumTimes() const { return (int)m_info.numRows; }
+    double getInitialTime() const;
+    double getFinalTime() const;
+    SimTK::Vector getTime() const;
+
+    const std::vector<std::string>& getStateNames() const
+    {   return m_names[States]; }
+    const std::vector<std::string>& getControlNames() const
+    {   return m_names[Controls]; }
+    const std::vector<std::string>& getMultiplierNames() const
+    {   return m_names[Multipliers]; }
+    const std::vector<std::string>& getDerivativeNames() const
+    {   return m_names[Derivatives]; }
+    const std::vector<std::string>& getSlackNames() const
+    {   return m_names[Slacks]; }
+    const std::vector<std::string>& getParameterNames() const
+    {   return m_names[Parameters]; }
+
+    /// @name Access single columns
+    /// These copy the column out of the file.
+    /// @throws Exception if there is no column with the given name.
+    /// @{
+    SimTK::Vector getState(const std::string& name) const;
+    SimTK::Vector getControl(const std::string& name) const;
+    SimTK::Vector getMultiplier(const std::string& name) const;
+    SimTK::Vector getDerivative(const std::string& name) const;
+    SimTK::Vector getSlack(const std::string& name) const;
+    double getParameter(const std::string& name) const;
+    /// @}
+
+    /// Read the time points [startIndex, startIndex + numTimes) into a
+    /// MocoTrajectory. The parameters are included in every chunk.
+    MocoTrajectory read(int startIndex, int numTimes) const;
+    /// Read the whole trajectory into memory.
+    MocoTrajectory read() const { return read(0, getNumTimes()); }
+
+    /// The same as MocoTrajectory::compareContinuousVariablesRMS(), except
+    /// that only a chunk of the columns is held in memory at a time.
+    double compareContinuousVariablesRMS(const MocoMappedTrajectory& other,
+            std::map<std::string, std::vector<std::string>> columnsToUse = {})
+            const;
+    double compareContinuousVariablesRMS(const MocoTrajectory& other,
+            std::map<std::string, std::vector<std::string>> columnsToUse = {})
+            const;
+
+private:
+    /// Column blocks, in the order in which they are stored in the file.
+    enum Block { States, Controls, Multipliers, Derivatives, Slacks,
+            Parameters, NumBlocks };
+    /// The values of the given column of the block, for all time points.
+    const double* getColumnData(int block, int column) const;
+    SimTK::Vector getColumn(int block, const std::string& kind,
+            const std::string& name) const;
+    MocoTrajectory::ContinuousVariables getContinuousVariables() const;
+
+    MemoryMappedFile m_file;
+    BinaryTableFileInfo m_info;
+    std::vector<std::string> m_names[NumBlocks];
+    int m_offsets[NumBlocks];
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOMAPPEDTRAJECTORY_H
@@ -18,6 +18,8 @@
 
 #include "MocoParameter.h"
 #include "MocoUtilities.h"
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
 using namespace OpenSim;
@@ -73,6 +75,29 @@ void MocoParameter::constructProperties() {
     constructProperty_property_element();
 }
 
+namespace {
+// Properties that the component reads whenever they are used, rather than
+// copying them into the System or into member variables when the model is
+// initialized. Keep this list in sync with the documentation of
+// MocoParameter::getRequiresInitSystem().
+bool isPropertyReadWhenUsed(const Component& component,
+        const std::string& propertyName) {
+    if (propertyName == "optimal_force") {
+        if (dynamic_cast<const CoordinateActuator*>(&component)) return true;
+        if (dynamic_cast<const PathActuator*>(&component) &&
+                !dynamic_cast<const Muscle*>(&component)) {
+            return true;
+        }
+    }
+    if (dynamic_cast<const DeGrooteFregly2016Muscle*>(&component)) {
+        return propertyName == "max_isometric_force" ||
+               propertyName == "tendon_slack_length" ||
+               propertyName == "fiber_damping";
+    }
+    return false;
+}
+} // anonymous namespace
+
 void MocoParameter::initializeOnModel(Model& model) const {
     
     OPENSIM_THROW_IF_FRMOBJ(getProperty_component_paths().empty(), Exception,
@@ -126,6 +151,9 @@ void MocoParameter::initializeOnModel(Model& model) const {
         }
 
         m_property_refs.emplace_back(ap);
+        if (!isPropertyReadWhenUsed(component, get_property_name())) {
+            m_requires_initsystem = true;
+        }
     }
 }
 
@@ -155,6 +155,21 @@ public:
     properties from multiple models. */
     void applyParameterToModelProperties(const double& value) const;
 
+    /** Whether Model::initSystem() must be called for a change in the value
+    of this parameter to take effect. This is available after
+    initializeOnModel(). Most properties are copied into the SimTK::System or
+    into the component when the model is initialized (e.g., masses, frame
+    offsets, and optimal fiber lengths), so this is true unless every
+    component property of this parameter is known to be read whenever it is
+    used. Those properties are:
+     - the `optimal_force` of a CoordinateActuator or of a PathActuator that
+       is not a Muscle,
+     - the `max_isometric_force`, `tendon_slack_length`, and `fiber_damping`
+       of a DeGrooteFregly2016Muscle.
+    For these parameters, it is enough to invalidate the realization
+    cache of the states. */
+    bool getRequiresInitSystem() const { return m_requires_initsystem; }
+
     /** Print the name, property name, component paths, property element (if it
     exists), and bounds for this parameter. */
     void printDescription() const;
@@ -177,6 +192,7 @@ private:
         Type_Vec6
     };
     mutable DataType m_data_type;
+    mutable bool m_requires_initsystem = false;
     void constructProperties();
     
 };
@@ -160,6 +160,7 @@ void MocoProblemRep::initialize() {
 
     // Grab a writable state from the copied model -- we'll use this to disable
     // its constraints below.
+    clearStatesDisabledConstraintsByTime();
     m_state_disabled_constraints[0] = m_model_disabled_constraints.initSystem();
     m_state_disabled_constraints[1] = m_state_disabled_constraints[0];
 
@@ -731,6 +732,34 @@ const std::vector<MocoVariableInfo>& MocoProblemRep::getMultiplierInfos(
     }
 }
 
+void MocoProblemRep::selectStateDisabledConstraints(
+        double time, int index) const {
+    assert(index <= 1);
+    auto& current = m_current_state_disabled_constraints;
+    current[index] = &m_state_disabled_constraints[index];
+    if (!m_prescribedKinematics || !m_parameters.empty()) return;
+
+    // Limits the memory used when times are not repeated.
+    static const int maxNumTimes = 256;
+    auto& statesByTime = m_state_disabled_constraints_by_time;
+    auto it = statesByTime.find(time);
+    if (it == statesByTime.end()) {
+        if ((int)statesByTime.size() >= maxNumTimes) return;
+        it = statesByTime.emplace(time, m_state_disabled_constraints[index])
+                     .first;
+    }
+    // The two state objects in use must remain distinct, even if they are
+    // at the same time.
+    if (current[1 - index] == &it->second) return;
+    current[index] = &it->second;
+}
+
+void MocoProblemRep::clearStatesDisabledConstraintsByTime() const {
+    m_current_state_disabled_constraints = {{&m_state_disabled_constraints[0],
+            &m_state_disabled_constraints[1]}};
+    m_state_disabled_constraints_by_time.clear();
+}
+
 void MocoProblemRep::applyParametersToModelProperties(
         const SimTK::Vector& parameterValues,
         bool initSystemAndDisableConstraints) const {
@@ -742,6 +771,14 @@ void MocoProblemRep::applyParametersToModelProperties(
     for (int i = 0; i < (int)m_parameters.size(); ++i) {
         m_parameters[i]->applyParameterToModelProperties(parameterValues(i));
     }
+    if (!initSystemAndDisableConstraints) {
+        // The properties are read whenever they are used, but the states may
+        // hold results computed with the previous values.
+        m_state_base.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        for (const auto& stateDisCon : m_state_disabled_constraints) {
+            stateDisCon.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        }
+    }
     if (initSystemAndDisableConstraints) {
         // TODO: Avoid these const_casts.
 
@@ -762,6 +799,7 @@ void MocoProblemRep::applyParametersToModelProperties(
         Model& m_model_disabled_constraints_const_cast =
                 const_cast<Model&>(m_model_disabled_constraints);
 
+        clearStatesDisabledConstraintsByTime();
         m_state_disabled_constraints[0] =
                 m_model_disabled_constraints_const_cast.initSystem();
         m_state_disabled_constraints[1] = m_state_disabled_constraints[0];
@@ -112,8 +112,18 @@ public:
     /// at once; you can supply an index of 1 to get a second state object.
     SimTK::State& updStateDisabledConstraints(int index = 0) const {
         assert(index <= 1);
-        return m_state_disabled_constraints[index];
+        return *m_current_state_disabled_constraints[index];
     }
+    /// With prescribed kinematics, q, u, and everything realized from them
+    /// (e.g., path lengths, speeds and wrapping) depend only on time, and
+    /// solvers evaluate the problem at the same (mesh) times over and over.
+    /// This function makes updStateDisabledConstraints(index) return a state
+    /// object dedicated to the given time, so that realizing it again at that
+    /// time recomputes only the stages that depend on the auxiliary states and
+    /// controls. Without prescribed kinematics, with parameters (which may
+    /// change the model), or once states for many distinct times exist (e.g.,
+    /// with a variable final time), this selects the default state object.
+    void selectStateDisabledConstraints(double time, int index = 0) const;
     /// This is a component inside ModelDisabledConstraints that you can use to
     /// set the value of control signals.
     const DiscreteController& getDiscreteControllerDisabledConstraints() const {
@@ -300,9 +310,22 @@ public:
     /// model. You can pass `true` to have initSystem() called for you, and to
     /// also re-disable any constraints re-enabled by the initSystem() call
     /// (see getModelDisabledConstraints()).
+    /// If `initSystemAndDisableConstraints` is false, the realization cache
+    /// of getStateBase() and of the states for the model with disabled
+    /// constraints is invalidated instead, which suffices for parameters that
+    /// do not require initSystem() (see getParametersRequireInitSystem()).
     void applyParametersToModelProperties(const SimTK::Vector& parameterValues,
             bool initSystemAndDisableConstraints = false) const;
 
+    /// Does any parameter require initSystem() to take effect? See
+    /// MocoParameter::getRequiresInitSystem().
+    bool getParametersRequireInitSystem() const {
+        for (const auto& param : m_parameters) {
+            if (param->getRequiresInitSystem()) return true;
+        }
+        return false;
+    }
+
     /// Get a vector of reference pointers to model outputs that return residual
     /// values for any components with dynamics in implicit forms. The 
     /// references returned are from the model returned by 
@@ -327,6 +350,7 @@ private:
     friend MocoProblem;
 
     void initialize();
+    void clearStatesDisabledConstraintsByTime() const;
 
     /// Get a list of reference pointers to all outputs whose names (not paths)
     /// match a substring defined by a provided regex string pattern. The regex
@@ -384,6 +408,13 @@ private:
 
     Model m_model_disabled_constraints;
     mutable std::array<SimTK::State, 2> m_state_disabled_constraints;
+    // The states returned by updStateDisabledConstraints(); see
+    // selectStateDisabledConstraints().
+    mutable std::array<SimTK::State*, 2> m_current_state_disabled_constraints{
+            {&m_state_disabled_constraints[0],
+                    &m_state_disabled_constraints[1]}};
+    mutable std::unordered_map<double, SimTK::State>
+            m_state_disabled_constraints_by_time;
     SimTK::ReferencePtr<const DiscreteController>
             m_discrete_controller_disabled_constraints;
     SimTK::ReferencePtr<const PositionMotion>
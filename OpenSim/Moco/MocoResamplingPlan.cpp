@@ -0,0 +1,134 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoResamplingPlan.cpp                                            *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoResamplingPlan.h"
+
+#include <algorithm>
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/GCVSpline.h>
+
+using namespace OpenSim;
+
+MocoResamplingPlan::MocoResamplingPlan(const SimTK::Vector& sourceTime,
+        const SimTK::Vector& targetTime, Method method)
+        : m_sourceTime(sourceTime), m_targetTime(targetTime),
+          m_method(method) {
+    OPENSIM_THROW_IF(m_sourceTime.size() == 0, Exception,
+            "Expected at least one source time.");
+    for (int i = 1; i < m_sourceTime.size(); ++i) {
+        OPENSIM_THROW_IF(m_sourceTime[i] < m_sourceTime[i - 1], Exception,
+                "Source times must be non-decreasing, but time[{}] < "
+                "time[{}] ({} < {}).",
+                i, i - 1, m_sourceTime[i], m_sourceTime[i - 1]);
+    }
+    m_rowStart.reserve(m_targetTime.size() + 1);
+    m_rowStart.push_back(0);
+    if (m_sourceTime[m_sourceTime.size() - 1] == m_sourceTime[0]) {
+        // If, for example, all times are 0.0, then we cannot interpolate, and
+        // every target takes the first value.
+        for (int i = 0; i < m_targetTime.size(); ++i) {
+            m_sourceIndex.push_back(0);
+            m_weights.push_back(1.0);
+            m_rowStart.push_back((int)m_weights.size());
+        }
+    } else if (m_method == Method::Spline) {
+        createSpline();
+    } else {
+        createLinear();
+    }
+}
+
+void MocoResamplingPlan::createSpline() {
+    const int numSource = m_sourceTime.size();
+    const int numTarget = m_targetTime.size();
+    OPENSIM_THROW_IF(numSource < 2, Exception,
+            "Cannot create a spline with fewer than 2 source times.");
+    const int degree = std::min(numSource - 1, 5);
+
+    // The interpolating spline is linear in the data, so column j of the
+    // interpolation matrix is the spline of the j-th unit vector, evaluated
+    // at the target times. The columns are independent.
+    SimTK::Matrix dense(numTarget, numSource);
+    parallelFor(numSource, [&](int j) {
+        SimTK::Vector unit(numSource, 0.0);
+        unit[j] = 1.0;
+        const GCVSpline spline(
+                degree, numSource, &m_sourceTime[0], &unit[0]);
+        SimTK::Vector curTime(1);
+        for (int i = 0; i < numTarget; ++i) {
+            curTime[0] = m_targetTime[i];
+            dense(i, j) = spline.calcValue(curTime);
+        }
+    });
+
+    for (int i = 0; i < numTarget; ++i) {
+        for (int j = 0; j < numSource; ++j) {
+            if (dense(i, j) != 0) {
+                m_sourceIndex.push_back(j);
+                m_weights.push_back(dense(i, j));
+            }
+        }
+        m_rowStart.push_back((int)m_weights.size());
+    }
+}
+
+void MocoResamplingPlan::createLinear() {
+    const int numSource = m_sourceTime.size();
+    const double* begin = &m_sourceTime[0];
+    const double* end = begin + numSource;
+    for (int i = 0; i < m_targetTime.size(); ++i) {
+        const double time = m_targetTime[i];
+        // The first source time greater than the target time.
+        const int upper = (int)(std::upper_bound(begin, end, time) - begin);
+        if (upper == 0 || upper == numSource) {
+            m_sourceIndex.push_back(upper == 0 ? 0 : numSource - 1);
+            m_weights.push_back(1.0);
+        } else {
+            const int lower = upper - 1;
+            const double interval = m_sourceTime[upper] - m_sourceTime[lower];
+            const double fraction = (time - m_sourceTime[lower]) / interval;
+            m_sourceIndex.push_back(lower);
+            m_weights.push_back(1.0 - fraction);
+            if (fraction != 0) {
+                m_sourceIndex.push_back(upper);
+                m_weights.push_back(fraction);
+            }
+        }
+        m_rowStart.push_back((int)m_weights.size());
+    }
+}
+
+SimTK::Matrix MocoResamplingPlan::apply(const SimTK::Matrix& source) const {
+    OPENSIM_THROW_IF(source.nrow() != m_sourceTime.size(), Exception,
+            "Expected {} rows (one per source time), but got {}.",
+            m_sourceTime.size(), source.nrow());
+    const int numTarget = m_targetTime.size();
+    SimTK::Matrix result(numTarget, source.ncol());
+    for (int icol = 0; icol < source.ncol(); ++icol) {
+        const auto column = source.col(icol);
+        auto resultColumn = result.updCol(icol);
+        for (int i = 0; i < numTarget; ++i) {
+            double value = 0;
+            for (int k = m_rowStart[i]; k < m_rowStart[i + 1]; ++k) {
+                value += m_weights[k] * column[m_sourceIndex[k]];
+            }
+            resultColumn[i] = value;
+        }
+    }
+    return result;
+}
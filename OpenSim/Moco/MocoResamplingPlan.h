@@ -0,0 +1,79 @@
+#ifndef OPENSIM_MOCORESAMPLINGPLAN_H
+#define OPENSIM_MOCORESAMPLINGPLAN_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoResamplingPlan.h                                              *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+#include "osimMocoDLL.h"
+
+#include <vector>
+
+#include <SimTKcommon.h>
+
+namespace OpenSim {
+
+/** A precomputed mapping from values at one set of (source) times to values
+at another set of (target) times. Both interpolation methods are linear in the
+data, so the mapping is a sparse matrix W with one row per target time and one
+column per source time, and resampling a column y is W * y. The plan depends
+only on the times, so it can be created once and applied to every column of
+every block of a MocoTrajectory, and to every trajectory that has the same
+source times (e.g., all guesses resampled onto the same mesh).
+
+- Method::Spline: the 5-th degree interpolating GCV spline that
+  MocoTrajectory::resample() has always used (the degree is reduced if there
+  are fewer than 6 source times). The weights are obtained by splining each
+  unit vector, so creating the plan costs one spline fit per source time.
+- Method::Linear: piecewise-linear interpolation; cheap to create and to apply,
+  for guesses that do not need spline fidelity.
+
+Target times outside of the source times take the value at the nearest source
+time (for Linear) or are extrapolated by the spline (for Spline). */
+class OSIMMOCO_API MocoResamplingPlan {
+public:
+    enum class Method { Spline, Linear };
+
+    MocoResamplingPlan() = default;
+    /// The source times must be non-decreasing, and strictly increasing for
+    /// Method::Spline unless all source times are equal.
+    MocoResamplingPlan(const SimTK::Vector& sourceTime,
+            const SimTK::Vector& targetTime, Method method = Method::Spline);
+
+    const SimTK::Vector& getSourceTime() const { return m_sourceTime; }
+    const SimTK::Vector& getTargetTime() const { return m_targetTime; }
+    Method getMethod() const { return m_method; }
+    /// The number of nonzero weights in the interpolation matrix.
+    int getNumWeights() const { return (int)m_weights.size(); }
+
+    /// Resample each column of `source`, which must have one row per source
+    /// time. The result has one row per target time.
+    SimTK::Matrix apply(const SimTK::Matrix& source) const;
+
+private:
+    void createSpline();
+    void createLinear();
+
+    SimTK::Vector m_sourceTime;
+    SimTK::Vector m_targetTime;
+    Method m_method = Method::Spline;
+    // Compressed rows of the interpolation matrix: the weights of target row
+    // i are in [m_rowStart[i], m_rowStart[i + 1]).
+    std::vector<int> m_rowStart;
+    std::vector<int> m_sourceIndex;
+    std::vector<double> m_weights;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCORESAMPLINGPLAN_H
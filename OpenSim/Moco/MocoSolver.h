@@ -92,6 +92,8 @@ protected:
     const MocoProblemRep& getProblemRep() const {
         return m_problemRep;
     }
+    /// The problem from which the MocoProblemRep was created.
+    const MocoProblem& getProblem() const { return *m_problem; }
 
     /// Create a library of MocoProblemRep%s for use in parallelized code.
     // TODO SWIG ignore.
@@ -26,6 +26,7 @@
 
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Simulation/StatesTrajectory.h>
 #include <OpenSim/Simulation/VisualizerUtilities.h>
 
@@ -80,7 +81,11 @@ MocoCasADiSolver& MocoStudy::initCasADiSolver() {
 MocoSolver& MocoStudy::updSolver() { return updSolver<MocoSolver>(); }
 
 MocoSolution MocoStudy::solve() const {
-    initSolverInternal();
+    OPENSIM_TRACE_SCOPE_CATEGORY("MocoStudy::solve", "moco");
+    {
+        OPENSIM_TRACE_SCOPE_CATEGORY("MocoStudy::initSolver", "moco");
+        initSolverInternal();
+    }
 
     MocoSolution solution = get_solver().solve();
 
@@ -0,0 +1,140 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoStudyBatch.cpp                                                 *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoStudyBatch.h"
+
+#include "MocoCasADiSolver/MocoCasADiSolver.h"
+#include "MocoProblem.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+
+using namespace OpenSim;
+
+std::vector<MocoStudyBatch::JobResult> MocoStudyBatch::solve() const {
+    std::set<std::string> names;
+    for (const auto& job : m_jobs) {
+        OPENSIM_THROW_IF(job.name.empty(), Exception,
+                "Expected all jobs to have a name.");
+        OPENSIM_THROW_IF(!names.insert(job.name).second, Exception,
+                "Expected unique job names, but '{}' is used more than once.",
+                job.name);
+    }
+
+    const int numJobs = getNumJobs();
+    int numThreads = m_numThreads;
+    if (numThreads <= 0) {
+        numThreads = getNumAvailableThreads();
+    }
+    numThreads = std::max(1, std::min(numThreads, numJobs));
+    const ThreadReservation reservation(numThreads);
+    if (m_writeSolutions) OpenSim::IO::makeDir(m_resultsDirectory);
+
+    log_info("MocoStudyBatch: solving {} jobs with {} threads.", numJobs,
+            numThreads);
+
+    std::vector<JobResult> results(numJobs);
+    std::atomic<int> nextJob(0);
+    std::atomic<int> numFinished(0);
+    auto worker = [&]() {
+        int index;
+        while ((index = nextJob++) < numJobs) {
+            results[index] = solveJob(m_jobs[index], numThreads > 1);
+            log_info("MocoStudyBatch: finished job '{}' ({}/{}).",
+                    results[index].name, ++numFinished, numJobs);
+        }
+    };
+
+    if (numThreads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; ++i) threads.emplace_back(worker);
+        for (auto& thread : threads) thread.join();
+    }
+    return results;
+}
+
+MocoStudyBatch::JobResult MocoStudyBatch::solveJob(
+        const Job& job, bool disableSolverParallelism) const {
+    JobResult result;
+    result.name = job.name;
+    try {
+        // Copying the base study concurrently from several threads is not
+        // known to be safe (e.g., the model may cache data), so copies are
+        // made one at a time.
+        static std::mutex copyMutex;
+        std::unique_ptr<MocoStudy> study;
+        {
+            std::lock_guard<std::mutex> lock(copyMutex);
+            study.reset(m_baseStudy.clone());
+        }
+        study->setName(job.name);
+        study->set_write_solution(m_writeSolutions);
+        study->set_results_directory(m_resultsDirectory);
+
+        MocoProblem& problem = study->updProblem();
+        for (const auto& goalWeight : job.goalWeights) {
+            problem.updGoal(goalWeight.first).setWeight(goalWeight.second);
+        }
+        if (job.modifier) job.modifier(*study);
+
+        if (disableSolverParallelism) {
+            if (auto* casadi =
+                            dynamic_cast<MocoCasADiSolver*>(&study->updSolver())) {
+                casadi->set_parallel(0);
+            }
+        }
+
+        MocoSolution solution = study->solve();
+        result.success = solution.success();
+        result.status = solution.getStatus();
+        solution.unseal();
+        result.objective = solution.getObjective();
+        result.numIterations = solution.getNumIterations();
+        result.solverDuration = solution.getSolverDuration();
+        if (m_writeSolutions) {
+            result.solutionFile = m_resultsDirectory +
+                                  SimTK::Pathname::getPathSeparator() +
+                                  job.name + "_solution.sto";
+        }
+    } catch (const std::exception& e) {
+        result.errorMessage = e.what();
+        log_error("MocoStudyBatch: job '{}' failed: {}", job.name, e.what());
+    }
+    return result;
+}
+
+void MocoStudyBatch::printResults(const std::vector<JobResult>& results) {
+    std::size_t width = 4;
+    for (const auto& result : results) {
+        width = std::max(width, result.name.size());
+    }
+    log_cout("{:<{}}  {:>7}  {:>14}  {:>10}  {}", "name", width, "success",
+            "objective", "iterations", "status");
+    for (const auto& result : results) {
+        log_cout("{:<{}}  {:>7}  {:>14.6g}  {:>10}  {}", result.name, width,
+                result.success ? "yes" : "no", result.objective,
+                result.numIterations,
+                result.errorMessage.empty() ? result.status
+                                            : result.errorMessage);
+    }
+}
@@ -0,0 +1,123 @@
+#ifndef OPENSIM_MOCOSTUDYBATCH_H
+#define OPENSIM_MOCOSTUDYBATCH_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoStudyBatch.h                                                   *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MocoStudy.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+/// Solve many variations of a MocoStudy (e.g., one per subject, walking speed,
+/// or set of goal weights) on a pool of threads. Each job solves a copy of the
+/// base study after changing the weights of its goals and applying an optional
+/// function that can make any other change to the study (e.g., replace the
+/// model or change bounds). The solution of each job is written to
+/// `<results directory>/<job name>_solution.sto`.
+///
+/// @code
+/// MocoStudyBatch batch(study);
+/// for (double w : {0.1, 1.0, 10.0}) {
+///     MocoStudyBatch::Job job;
+///     job.name = "effort_weight_" + std::to_string(w);
+///     job.goalWeights.emplace_back("effort", w);
+///     batch.addJob(job);
+/// }
+/// batch.setResultsDirectory("sweep");
+/// auto results = batch.solve();
+/// MocoStudyBatch::printResults(results);
+/// @endcode
+///
+/// Solving independent problems in parallel uses the cores more efficiently
+/// than parallelizing within each problem, so if more than one thread is used,
+/// the `parallel` property of a MocoCasADiSolver is set to 0 for each job.
+/// Each job creates its own MocoProblemRep, since the problems differ.
+class OSIMMOCO_API MocoStudyBatch {
+public:
+    /// A variation of the base study.
+    struct Job {
+        /// Used for the name of the study and the solution file; must be
+        /// unique within the batch.
+        std::string name;
+        /// Pairs of goal name and weight (goals of the first phase).
+        std::vector<std::pair<std::string, double>> goalWeights;
+        /// Applied to the copy of the base study after the goal weights.
+        std::function<void(MocoStudy&)> modifier;
+    };
+    /// The outcome of a job. If the job threw an exception (e.g., a goal does
+    /// not exist), `errorMessage` contains the message of the exception.
+    struct JobResult {
+        std::string name;
+        bool success = false;
+        std::string status;
+        double objective = SimTK::NaN;
+        int numIterations = -1;
+        double solverDuration = SimTK::NaN;
+        /// Empty if the solution was not written.
+        std::string solutionFile;
+        std::string errorMessage;
+    };
+
+    MocoStudyBatch() = default;
+    explicit MocoStudyBatch(const MocoStudy& baseStudy)
+            : m_baseStudy(baseStudy) {}
+
+    void setBaseStudy(const MocoStudy& study) { m_baseStudy = study; }
+    const MocoStudy& getBaseStudy() const { return m_baseStudy; }
+
+    void addJob(Job job) { m_jobs.push_back(std::move(job)); }
+    int getNumJobs() const { return (int)m_jobs.size(); }
+    const Job& getJob(int index) const { return m_jobs.at(index); }
+
+    /// The number of jobs to solve at the same time (default: 0, which uses
+    /// the number of cores).
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+    int getNumThreads() const { return m_numThreads; }
+    /// The directory to which solutions are written (default: "./").
+    void setResultsDirectory(std::string dir) {
+        m_resultsDirectory = std::move(dir);
+    }
+    const std::string& getResultsDirectory() const {
+        return m_resultsDirectory;
+    }
+    /// Write the solution of each job to a file (default: true).
+    void setWriteSolutions(bool tf) { m_writeSolutions = tf; }
+    bool getWriteSolutions() const { return m_writeSolutions; }
+
+    /// Solve all jobs and return their results, in the order in which the
+    /// jobs were added. A job that fails does not stop the other jobs.
+    std::vector<JobResult> solve() const;
+
+    /// Log a table with the status and objective of each job.
+    static void printResults(const std::vector<JobResult>& results);
+
+private:
+    JobResult solveJob(const Job& job, bool disableSolverParallelism) const;
+
+    MocoStudy m_baseStudy;
+    std::vector<Job> m_jobs;
+    int m_numThreads = 0;
+    std::string m_resultsDirectory = "./";
+    bool m_writeSolutions = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOSTUDYBATCH_H
@@ -17,8 +17,12 @@
  * -------------------------------------------------------------------------- */
 #include "MocoTool.h"
 
+#include "MocoCasADiSolver/MocoCasADiSolver.h"
+#include "MocoTrajectory.h"
 #include "MocoUtilities.h"
 
+#include <OpenSim/Common/IO.h>
+
 using namespace OpenSim;
 
 void MocoTool::constructProperties() {
@@ -27,6 +31,7 @@ void MocoTool::constructProperties() {
     constructProperty_mesh_interval(0.02);
     constructProperty_clip_time_range(false);
     constructProperty_model(ModelProcessor());
+    constructProperty_guess_cache("");
 }
 
 void MocoTool::updateTimeInfo(const std::string& dataLabel,
@@ -91,3 +96,84 @@ std::string MocoTool::getDocumentDirectory() const {
     }
     return setupDir;
 }
+
+std::string MocoTool::createGuessCacheKey(
+        const MocoTrajectory& trajectory) const {
+    std::string description = getConcreteClassName() + get_model().dump();
+    const auto append = [&](const std::vector<std::string>& names) {
+        for (const auto& name : names) { description += name + ","; }
+        description += ";";
+    };
+    append(trajectory.getStateNames());
+    append(trajectory.getControlNames());
+    append(trajectory.getMultiplierNames());
+    append(trajectory.getDerivativeNames());
+    append(trajectory.getParameterNames());
+    append(trajectory.getSlackNames());
+    return createFNV1aHash(description);
+}
+
+std::string MocoTool::getGuessCacheFile(
+        const std::string& key, int index) const {
+    return getFilePath(get_guess_cache()) + "/" + key + "_" +
+           std::to_string(index) + ".sto";
+}
+
+bool MocoTool::applyCachedGuess(MocoCasADiSolver& solver) const {
+    if (get_guess_cache().empty()) return false;
+
+    MocoTrajectory guess = solver.getGuess();
+    const auto& time = guess.getTime();
+    const double initial = time[0];
+    const double final = time[time.size() - 1];
+    const std::string key = createGuessCacheKey(guess);
+
+    // Find the cached solution whose duration is closest to the duration of
+    // this problem. Later solutions win ties.
+    std::unique_ptr<MocoTrajectory> nearest;
+    double nearestDistance = SimTK::Infinity;
+    for (int index = 0; IO::FileExists(getGuessCacheFile(key, index));
+            ++index) {
+        auto cached = OpenSim::make_unique<MocoTrajectory>(
+                getGuessCacheFile(key, index));
+        const double distance =
+                std::abs((cached->getFinalTime() - cached->getInitialTime()) -
+                         (final - initial));
+        if (cached->getNumTimes() >= 2 && distance <= nearestDistance) {
+            nearestDistance = distance;
+            nearest = std::move(cached);
+        }
+    }
+    if (!nearest) return false;
+
+    // Map the cached solution onto the time range of this problem, and
+    // resample it onto the times of the guess.
+    SimTK::Vector cachedTime = nearest->getTime();
+    const int numCachedTimes = cachedTime.size();
+    const double cachedInitial = cachedTime[0];
+    const double scale = (final - initial) /
+                         (cachedTime[numCachedTimes - 1] - cachedInitial);
+    for (int itime = 0; itime < numCachedTimes; ++itime) {
+        cachedTime[itime] =
+                initial + scale * (cachedTime[itime] - cachedInitial);
+    }
+    cachedTime[numCachedTimes - 1] = final;
+    nearest->setTime(cachedTime);
+    nearest->resample(time);
+
+    log_info("Using a solution from the guess cache '{}' as the initial "
+             "guess.",
+            get_guess_cache());
+    solver.setGuess(std::move(*nearest));
+    return true;
+}
+
+void MocoTool::addSolutionToGuessCache(const MocoSolution& solution) const {
+    if (get_guess_cache().empty() || !solution.success()) return;
+
+    const std::string key = createGuessCacheKey(solution);
+    IO::makeDir(getFilePath(get_guess_cache()));
+    int index = 0;
+    while (IO::FileExists(getGuessCacheFile(key, index))) { ++index; }
+    solution.write(getGuessCacheFile(key, index));
+}
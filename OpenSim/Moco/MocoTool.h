@@ -24,6 +24,10 @@
 
 namespace OpenSim {
 
+class MocoCasADiSolver;
+class MocoSolution;
+class MocoTrajectory;
+
 /** This is a base class for solving problems that depend on an observed motion
 using Moco's optimal control methods.
 
@@ -46,7 +50,19 @@ muscles alone. There are multiple possible causes for this:
     deactivation time constants allow,
   - the filtering of the data causes unrealistic desired net joint moments.
 You may want to add "reserve" actuators to your model.
-This can be done with the ModOpAddReserves model operator. */
+This can be done with the ModOpAddReserves model operator.
+
+Guess cache
+-----------
+When solving many similar problems (e.g., consecutive trials of the same
+subject), set `guess_cache` to a directory. Each successful solution is stored
+in this directory, and the solution of a previous problem with the same model
+(the `model` property) and the same variables is used as the initial guess.
+Among the stored solutions, the one whose duration is closest to that of the
+new problem is used; it is scaled to the new time range and resampled onto the
+new mesh. The stored solutions contain the Lagrange multipliers, so they are
+also part of the guess. A guess file provided to the tool takes precedence
+over the guess cache. */
 class MocoTool : public Object {
     OpenSim_DECLARE_ABSTRACT_OBJECT(MocoTool, Object);
 
@@ -72,6 +88,12 @@ public:
     OpenSim_DECLARE_PROPERTY(
             model, ModelProcessor, "The musculoskeletal model to use.");
 
+    OpenSim_DECLARE_PROPERTY(guess_cache, std::string,
+            "Directory in which solutions are stored and reused as the "
+            "initial guess for later problems with the same model and "
+            "variables. The directory is created if it does not exist. "
+            "(default: empty, no caching)");
+
     MocoTool() { constructProperties(); }
 
     void setModel(ModelProcessor model) { set_model(std::move(model)); }
@@ -104,9 +126,28 @@ protected:
     /// returns an empty string.
     std::string getDocumentDirectory() const;
 
+    /// If the guess_cache property is set and the cache contains a solution
+    /// of a problem with the same model and variables, set the solver's guess
+    /// to that solution, scaled to the time range and resampled onto the times
+    /// of the solver's current guess. Returns true if a cached solution was
+    /// used.
+    bool applyCachedGuess(MocoCasADiSolver& solver) const;
+
+    /// If the guess_cache property is set and the solution was successful,
+    /// add the solution to the cache. Call this before adding any variables to
+    /// the solution (e.g., with MocoTrajectory::insertStatesTrajectory()), so
+    /// that the solution has the same variables as the guess.
+    void addSolutionToGuessCache(const MocoSolution& solution) const;
+
 #endif
 private:
     void constructProperties();
+#ifndef SWIG
+    /// A hash of the tool type, the model property, and the names of the
+    /// variables in the trajectory.
+    std::string createGuessCacheKey(const MocoTrajectory& trajectory) const;
+    std::string getGuessCacheFile(const std::string& key, int index) const;
+#endif
 };
 
 } // namespace OpenSim
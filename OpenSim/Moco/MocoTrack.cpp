@@ -113,10 +113,12 @@ MocoStudy MocoTrack::initialize() {
     // Set the problem guess.
     // ----------------------
     // If the user provided a guess file, use that guess in the solver.
+    // Otherwise, use a cached solution of a similar problem, if available.
     if (!get_guess_file().empty()) {
         solver.setGuessFile(getFilePath(get_guess_file()));
     } else {
         solver.setGuess("bounds");
+        applyCachedGuess(solver);
     }
 
     // Apply states from the reference data the to solver guess if specified by
@@ -137,6 +139,7 @@ MocoSolution MocoTrack::solveInternal(bool visualize) {
     // Solve!
     // ------
     MocoSolution solution = study.solve();
+    addSolutionToGuessCache(solution);
     if (visualize) { study.visualize(solution); }
 
     return solution;
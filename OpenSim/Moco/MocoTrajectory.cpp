@@ -20,7 +20,9 @@
 #include "MocoProblem.h"
 #include "MocoUtilities.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/BinaryFileAdapter.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
@@ -29,6 +31,36 @@ using namespace OpenSim;
 const std::vector<std::string> MocoTrajectory::m_allowedKeys =
         {"states", "controls", "multipliers", "derivatives"};
 
+int MocoTrajectory::findIndex(const std::vector<std::string>& names,
+        const NameIndex& index, const std::string& name) {
+    const auto found = index.find(name);
+    if (found != index.end() && found->second < (int)names.size() &&
+            names[found->second] == name) {
+        return found->second;
+    }
+    const auto it = find(names, name);
+    if (it == names.cend()) return -1;
+    return (int)std::distance(names.cbegin(), it);
+}
+
+void MocoTrajectory::indexNames() {
+    const auto build = [](const std::vector<std::string>& names,
+                               NameIndex& index) {
+        index.clear();
+        index.reserve(names.size());
+        // Keep the first occurrence, as a linear search would.
+        for (int i = 0; i < (int)names.size(); ++i) {
+            index.emplace(names[i], i);
+        }
+    };
+    build(m_state_names, m_state_index);
+    build(m_control_names, m_control_index);
+    build(m_multiplier_names, m_multiplier_index);
+    build(m_derivative_names, m_derivative_index);
+    build(m_slack_names, m_slack_index);
+    build(m_parameter_names, m_parameter_index);
+}
+
 MocoTrajectory::MocoTrajectory(
         std::vector<std::string> state_names,
         std::vector<std::string> control_names,
@@ -37,7 +69,9 @@ MocoTrajectory::MocoTrajectory(
         : m_state_names(std::move(state_names)),
           m_control_names(std::move(control_names)),
           m_multiplier_names(std::move(multiplier_names)),
-          m_parameter_names(std::move(parameter_names)) {}
+          m_parameter_names(std::move(parameter_names)) {
+    indexNames();
+}
 
 MocoTrajectory::MocoTrajectory(
         std::vector<std::string> state_names,
@@ -49,7 +83,9 @@ MocoTrajectory::MocoTrajectory(
           m_control_names(std::move(control_names)),
           m_multiplier_names(std::move(multiplier_names)),
           m_derivative_names(std::move(derivative_names)),
-          m_parameter_names(std::move(parameter_names)) {}
+          m_parameter_names(std::move(parameter_names)) {
+    indexNames();
+}
 
 MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
         std::vector<std::string> state_names,
@@ -96,6 +132,7 @@ MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
     m_derivatives.resize(m_time.size(), 0);
     OPENSIM_THROW_IF((int)m_parameter_names.size() != m_parameters.nelt(),
             Exception, "Inconsistent number of parameters.");
+    indexNames();
 }
 
 MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
@@ -113,6 +150,7 @@ MocoTrajectory::MocoTrajectory(const SimTK::Vector& time,
                   parameter_names, statesTrajectory, controlsTrajectory,
                   multipliersTrajectory, parameters) {
     m_derivative_names = derivative_names;
+    indexNames();
     m_derivatives = derivativesTrajectory;
     OPENSIM_THROW_IF((int)m_derivative_names.size() != m_derivatives.ncol(),
             Exception, "Inconsistent number of derivatives.");
@@ -163,10 +201,9 @@ void MocoTrajectory::setState(
             "For state {}, expected {} elements but got {}.", name,
             m_states.nrow(), trajectory.size());
 
-    auto it = std::find(m_state_names.cbegin(), m_state_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_state_names.cend(), Exception,
+    const int index = findIndex(m_state_names, m_state_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find state named {}.", name);
-    int index = (int)std::distance(m_state_names.cbegin(), it);
     m_states.updCol(index) = trajectory;
 }
 
@@ -177,10 +214,9 @@ void MocoTrajectory::setControl(
             "For control {}, expected {} elements but got {}.", name,
             m_controls.nrow(), trajectory.size());
 
-    auto it = std::find(m_control_names.cbegin(), m_control_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_control_names.cend(), Exception,
+    const int index = findIndex(m_control_names, m_control_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find control named {}.", name);
-    int index = (int)std::distance(m_control_names.cbegin(), it);
     m_controls.updCol(index) = trajectory;
 }
 
@@ -191,11 +227,9 @@ void MocoTrajectory::setMultiplier(
             "For multiplier {}, expected {} elements but got {}.", name,
             m_multipliers.nrow(), trajectory.size());
 
-    auto it = std::find(
-            m_multiplier_names.cbegin(), m_multiplier_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_multiplier_names.cend(), Exception,
+    const int index = findIndex(m_multiplier_names, m_multiplier_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find multiplier named {}.", name);
-    int index = (int)std::distance(m_multiplier_names.cbegin(), it);
     m_multipliers.updCol(index) = trajectory;
 }
 
@@ -206,11 +240,9 @@ void MocoTrajectory::setDerivative(
             "For derivative {}, expected {} elements but got {}.", name,
             m_derivatives.nrow(), trajectory.size());
 
-    auto it = std::find(
-            m_derivative_names.cbegin(), m_derivative_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_derivative_names.cend(), Exception,
+    const int index = findIndex(m_derivative_names, m_derivative_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find derivative named {}.", name);
-    int index = (int)std::distance(m_derivative_names.cbegin(), it);
     m_derivatives.updCol(index) = trajectory;
 
 }
@@ -223,10 +255,9 @@ void MocoTrajectory::setSlack(
             "For slack {}, expected {} elements but got {}.", name,
             m_slacks.nrow(), trajectory.size());
 
-    auto it = std::find(m_slack_names.cbegin(), m_slack_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_slack_names.cend(), Exception,
+    const int index = findIndex(m_slack_names, m_slack_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find slack named {}.", name);
-    int index = (int)std::distance(m_slack_names.cbegin(), it);
     m_slacks.updCol(index) = trajectory;
 }
 
@@ -242,6 +273,7 @@ void MocoTrajectory::appendSlack(
             name, trajectory.size(), m_time.nrow());
 
     m_slack_names.push_back(name);
+    indexNames();
     m_slacks.resizeKeep(m_time.nrow(), m_slacks.ncol() + 1);
     m_slacks.updCol(m_slacks.ncol() - 1) = trajectory;
 }
@@ -250,11 +282,9 @@ void MocoTrajectory::setParameter(
         const std::string& name, const SimTK::Real& value) {
     ensureUnsealed();
 
-    auto it = std::find(
-            m_parameter_names.cbegin(), m_parameter_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_parameter_names.cend(), Exception,
+    const int index = findIndex(m_parameter_names, m_parameter_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find parameter named {}.", name);
-    int index = (int)std::distance(m_parameter_names.cbegin(), it);
     m_parameters.updElt(0, index) = value;
 }
 
@@ -315,6 +345,7 @@ void MocoTrajectory::insertStatesTrajectory(
         auto it = find(m_state_names, label);
         if (it == m_state_names.cend()) { m_state_names.push_back(label); }
     }
+    indexNames();
 
     m_states.resizeKeep(getNumTimes(), (int)m_state_names.size());
 
@@ -344,6 +375,7 @@ void MocoTrajectory::insertControlsTrajectory(
         auto it = find(m_control_names, label);
         if (it == m_control_names.cend()) { m_control_names.push_back(label); }
     }
+    indexNames();
 
     m_controls.resizeKeep(getNumTimes(), (int)m_control_names.size());
 
@@ -447,6 +479,7 @@ void MocoTrajectory::generateAccelerationsFromValues() {
     }
     // Assign acceleration names.
     m_derivative_names = accelNames;
+    indexNames();
 }
 
 void MocoTrajectory::generateAccelerationsFromSpeeds() {
@@ -486,6 +519,7 @@ void MocoTrajectory::generateAccelerationsFromSpeeds() {
     }
     // Assign acceleration names.
     m_derivative_names = accelNames;
+    indexNames();
 }
 
 double MocoTrajectory::getInitialTime() const {
@@ -502,53 +536,44 @@ double MocoTrajectory::getFinalTime() const {
 
 SimTK::VectorView MocoTrajectory::getState(const std::string& name) const {
     ensureUnsealed();
-    auto it = std::find(m_state_names.cbegin(), m_state_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_state_names.cend(), Exception,
+    const int index = findIndex(m_state_names, m_state_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find state named {}.", name);
-    int index = (int)std::distance(m_state_names.cbegin(), it);
     return m_states.col(index);
 }
 SimTK::VectorView MocoTrajectory::getControl(const std::string& name) const {
     ensureUnsealed();
-    auto it = std::find(m_control_names.cbegin(), m_control_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_control_names.cend(), Exception,
+    const int index = findIndex(m_control_names, m_control_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find control named {}.", name);
-    int index = (int)std::distance(m_control_names.cbegin(), it);
     return m_controls.col(index);
 }
 SimTK::VectorView MocoTrajectory::getMultiplier(const std::string& name) const {
     ensureUnsealed();
-    auto it = std::find(
-            m_multiplier_names.cbegin(), m_multiplier_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_multiplier_names.cend(), Exception,
+    const int index = findIndex(m_multiplier_names, m_multiplier_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find multiplier named {}.", name);
-    int index = (int)std::distance(m_multiplier_names.cbegin(), it);
     return m_multipliers.col(index);
 }
 SimTK::VectorView MocoTrajectory::getDerivative(const std::string& name) const {
     ensureUnsealed();
-    auto it = std::find(
-            m_derivative_names.cbegin(), m_derivative_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_derivative_names.cend(), Exception,
+    const int index = findIndex(m_derivative_names, m_derivative_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find derivative named {}.", name);
-    int index = (int)std::distance(m_derivative_names.cbegin(), it);
     return m_derivatives.col(index);
 }
 SimTK::VectorView MocoTrajectory::getSlack(const std::string& name) const {
     ensureUnsealed();
-    auto it = std::find(m_slack_names.cbegin(), m_slack_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_slack_names.cend(), Exception,
+    const int index = findIndex(m_slack_names, m_slack_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find slack named {}.", name);
-    int index = (int)std::distance(m_slack_names.cbegin(), it);
     return m_slacks.col(index);
 }
 const SimTK::Real& MocoTrajectory::getParameter(const std::string& name) const {
     ensureUnsealed();
-    auto it = std::find(
-            m_parameter_names.cbegin(), m_parameter_names.cend(), name);
-    OPENSIM_THROW_IF(it == m_parameter_names.cend(), Exception,
+    const int index = findIndex(m_parameter_names, m_parameter_index, name);
+    OPENSIM_THROW_IF(index == -1, Exception,
             "Cannot find parameter named {}.", name);
-    int index = (int)std::distance(m_parameter_names.cbegin(), it);
     return m_parameters.getElt(0, index);
 }
 
@@ -578,7 +603,8 @@ double MocoTrajectory::resampleWithFrequency(double desiredFrequency) {
     resampleWithNumTimes(actualNumTimes);
     return (double)actualNumTimes / duration;
 }
-void MocoTrajectory::resample(SimTK::Vector time) {
+void MocoTrajectory::resample(
+        SimTK::Vector time, MocoResamplingPlan::Method method) {
     ensureUnsealed();
     OPENSIM_THROW_IF(m_time.size() < 2, Exception,
             "Cannot resample if number of times is 0 or 1.");
@@ -597,11 +623,21 @@ void MocoTrajectory::resample(SimTK::Vector time) {
                 itime, itime - 1, time[itime], time[itime - 1]);
     }
 
-    int numStates = (int)m_state_names.size();
-    int numControls = (int)m_control_names.size();
-    int numMultipliers = (int)m_multiplier_names.size();
-    int numDerivatives = (int)m_derivative_names.size();
-    int numSlacks = (int)m_slack_names.size();
+    resample(MocoResamplingPlan(m_time, time, method));
+}
+
+void MocoTrajectory::resample(const MocoResamplingPlan& plan) {
+    ensureUnsealed();
+    const SimTK::Vector& sourceTime = plan.getSourceTime();
+    bool timesMatch = sourceTime.size() == m_time.size();
+    for (int itime = 0; timesMatch && itime < m_time.size(); ++itime) {
+        timesMatch = sourceTime[itime] == m_time[itime];
+    }
+    OPENSIM_THROW_IF(!timesMatch, Exception,
+            "The source times of the resampling plan must match the times of "
+            "the trajectory.");
+    OPENSIM_THROW_IF(m_time.size() < 2, Exception,
+            "Cannot resample if number of times is 0 or 1.");
 
     // This interpolate step removes any NaN values in the slack variables. It
     // does not resize the slacks trajectory.
@@ -610,53 +646,13 @@ void MocoTrajectory::resample(SimTK::Vector time) {
                 interpolate(m_time, m_slacks.col(icol), m_time, true);
     }
 
-    const TimeSeriesTable table = convertToTable();
-    const GCVSplineSet splines(table, {}, std::min(m_time.size() - 1, 5));
-
-    m_time = std::move(time);
-    const int numTimes = m_time.size();
-    m_states.resize(numTimes, numStates);
-    m_controls.resize(numTimes, numControls);
-    m_multipliers.resize(numTimes, numMultipliers);
-    m_derivatives.resize(numTimes, numDerivatives);
-    m_slacks.resize(numTimes, numSlacks);
-    if (m_time[numTimes - 1] == m_time[0]) {
-        // If, for example, all times are 0.0, then we cannot use the spline,
-        // which requires strictly increasing time.
-        int icol;
-        for (icol = 0; icol < numStates; ++icol)
-            m_states.updCol(icol).setTo(
-                    table.getDependentColumnAtIndex(icol).getElt(0, 0));
-        for (int icontr = 0; icontr < numControls; ++icontr, ++icol)
-            m_controls.updCol(icontr).setTo(
-                    table.getDependentColumnAtIndex(icol).getElt(0, 0));
-        for (int imult = 0; imult < numMultipliers; ++imult, ++icol)
-            m_multipliers.updCol(imult).setTo(
-                    table.getDependentColumnAtIndex(icol).getElt(0, 0));
-        for (int ideriv = 0; ideriv < numDerivatives; ++ideriv, ++icol)
-            m_derivatives.updCol(ideriv).setTo(
-                    table.getDependentColumnAtIndex(icol).getElt(0, 0));
-        for (int islack = 0; islack < numSlacks; ++islack, ++icol)
-            m_slacks.updCol(islack).setTo(
-                    table.getDependentColumnAtIndex(icol).getElt(0, 0));
-
-    } else {
-        SimTK::Vector curTime(1);
-        for (int itime = 0; itime < m_time.size(); ++itime) {
-            curTime[0] = m_time[itime];
-            int icol;
-            for (icol = 0; icol < numStates; ++icol)
-                m_states(itime, icol) = splines[icol].calcValue(curTime);
-            for (int icontr = 0; icontr < numControls; ++icontr, ++icol)
-                m_controls(itime, icontr) = splines[icol].calcValue(curTime);
-            for (int imult = 0; imult < numMultipliers; ++imult, ++icol)
-                m_multipliers(itime, imult) = splines[icol].calcValue(curTime);
-            for (int ideriv = 0; ideriv < numDerivatives; ++ideriv, ++icol)
-                m_derivatives(itime, ideriv) = splines[icol].calcValue(curTime);
-            for (int islack = 0; islack < numSlacks; ++islack, ++icol)
-                m_slacks(itime, islack) = splines[icol].calcValue(curTime);
-        }
-    }
+    // The same interpolation weights apply to every column of every block.
+    m_time = plan.getTargetTime();
+    m_states = plan.apply(m_states);
+    m_controls = plan.apply(m_controls);
+    m_multipliers = plan.apply(m_multipliers);
+    m_derivatives = plan.apply(m_derivatives);
+    m_slacks = plan.apply(m_slacks);
 }
 
 MocoTrajectory::MocoTrajectory(const std::string& filepath) {
@@ -720,6 +716,7 @@ MocoTrajectory::MocoTrajectory(const std::string& filepath) {
     offset += numSlacks;
     m_parameter_names.insert(
             m_parameter_names.end(), labels.begin() + offset, labels.end());
+    indexNames();
 
     OPENSIM_THROW_IF(numStates + numControls + numMultipliers + numDerivatives +
                                      numSlacks + numParameters !=
@@ -779,7 +776,12 @@ MocoTrajectory::MocoTrajectory(const std::string& filepath) {
 
 void MocoTrajectory::write(const std::string& filepath) const {
     ensureUnsealed();
-    STOFileAdapter::write(convertToTable(), filepath);
+    if (filepath.size() > 5 &&
+            filepath.compare(filepath.size() - 5, 5, ".bsto") == 0) {
+        BinaryFileAdapter::write(convertToTable(), filepath);
+    } else {
+        STOFileAdapter::write(convertToTable(), filepath);
+    }
 }
 
 TimeSeriesTable MocoTrajectory::convertToTable() const {
@@ -1128,111 +1130,156 @@ void checkContains(std::string type, VecStr a, VecStr b, VecStr c) {
 
 } // anonymous namespace
 
+MocoTrajectory::ContinuousVariables
+MocoTrajectory::getContinuousVariables() const {
+    ContinuousVariables vars;
+    vars.time = m_time;
+    vars.names = {m_state_names, m_control_names, m_multiplier_names,
+            m_derivative_names};
+    vars.getColumn = [this](int block, int column) -> SimTK::Vector {
+        const SimTK::Matrix* blocks[] = {
+                &m_states, &m_controls, &m_multipliers, &m_derivatives};
+        return blocks[block]->col(column);
+    };
+    return vars;
+}
+
 double MocoTrajectory::compareContinuousVariablesRMSInternal(
-        const MocoTrajectory& other, std::vector<std::string> stateNames,
+        const ContinuousVariables& self, const ContinuousVariables& other,
+        std::vector<std::string> stateNames,
         std::vector<std::string> controlNames,
         std::vector<std::string> multiplierNames,
-        std::vector<std::string> derivativeNames) const {
-    ensureUnsealed();
+        std::vector<std::string> derivativeNames) {
 
     // Process state, control, multiplier, and derivative names.
     // ---------------------------------------------------------
+    const VecStr& selfStateNames = self.names[0];
+    const VecStr& selfControlNames = self.names[1];
+    const VecStr& selfMultiplierNames = self.names[2];
+    const VecStr& selfDerivativeNames = self.names[3];
+    const VecStr& otherStateNames = other.names[0];
+    const VecStr& otherControlNames = other.names[1];
+    const VecStr& otherMultiplierNames = other.names[2];
+    const VecStr& otherDerivativeNames = other.names[3];
     if (stateNames.empty()) {
-        OPENSIM_THROW_IF(!sameContents(m_state_names, other.m_state_names),
+        OPENSIM_THROW_IF(!sameContents(selfStateNames, otherStateNames),
                 Exception,
                 "Expected both trajectories to have the same state names; consider "
                 "specifying the states to compare.");
-        stateNames = m_state_names;
+        stateNames = selfStateNames;
     } else if (stateNames.size() == 1 && stateNames[0] == "none") {
         stateNames.clear();
     } else {
-        checkContains("state", stateNames, m_state_names, other.m_state_names);
+        checkContains("state", stateNames, selfStateNames, otherStateNames);
     }
     if (controlNames.empty()) {
-        OPENSIM_THROW_IF(!sameContents(m_control_names, other.m_control_names),
+        OPENSIM_THROW_IF(!sameContents(selfControlNames, otherControlNames),
                 Exception,
                 "Expected both trajectories to have the same control names; "
                 "consider specifying the controls to compare.");
-        controlNames = m_control_names;
+        controlNames = selfControlNames;
     } else if (controlNames.size() == 1 && controlNames[0] == "none") {
         controlNames.clear();
     } else {
         std::sort(controlNames.begin(), controlNames.end());
-        checkContains("control", controlNames, m_control_names,
-                other.m_control_names);
+        checkContains("control", controlNames, selfControlNames,
+                otherControlNames);
     }
     if (multiplierNames.empty()) {
         OPENSIM_THROW_IF(
-                !sameContents(m_multiplier_names, other.m_multiplier_names),
+                !sameContents(selfMultiplierNames, otherMultiplierNames),
                 Exception,
                 "Expected both trajectories to have the same multiplier names; "
                 "consider specifying the multipliers to compare.");
-        multiplierNames = m_multiplier_names;
+        multiplierNames = selfMultiplierNames;
     } else if (multiplierNames.size() == 1 && multiplierNames[0] == "none") {
         multiplierNames.clear();
     } else {
-        checkContains("multiplier", multiplierNames, m_multiplier_names,
-                other.m_multiplier_names);
+        checkContains("multiplier", multiplierNames, selfMultiplierNames,
+                otherMultiplierNames);
     }
     if (derivativeNames.empty()) {
         OPENSIM_THROW_IF(
-                !sameContents(m_derivative_names, other.m_derivative_names),
+                !sameContents(selfDerivativeNames, otherDerivativeNames),
                 Exception,
                 "Expected both trajectories to have the same derivative names; "
                 "consider specifying the derivatives to compare.");
-        derivativeNames = m_derivative_names;
+        derivativeNames = selfDerivativeNames;
     } else if (derivativeNames.size() == 1 && derivativeNames[0] == "none") {
         derivativeNames.clear();
     } else {
-        checkContains("derivative", derivativeNames, m_derivative_names,
-                other.m_derivative_names);
+        checkContains("derivative", derivativeNames, selfDerivativeNames,
+                otherDerivativeNames);
     }
     const int numColumns = int(stateNames.size() + controlNames.size() +
                                multiplierNames.size() + derivativeNames.size());
     if (numColumns == 0) return 0;
 
-    std::vector<double> selfTime =
-            std::vector<double>(&m_time[0], &m_time[0] + m_time.size());
-    std::vector<double> otherTime = std::vector<double>(
-            &other.m_time[0], &other.m_time[0] + other.m_time.size());
+    const SimTK::Vector& selfTime = self.time;
+    const SimTK::Vector& otherTime = other.time;
 
-    const auto initialTime = std::min(selfTime.front(), otherTime.front());
-    const auto finalTime = std::max(selfTime.back(), otherTime.back());
-    const auto numTimes = std::max(getNumTimes(), other.getNumTimes());
+    const auto initialTime = std::min(selfTime[0], otherTime[0]);
+    const auto finalTime = std::max(
+            selfTime[selfTime.size() - 1], otherTime[otherTime.size() - 1]);
+    const auto numTimes = std::max(selfTime.size(), otherTime.size());
     // Times to use for integrating over time.
     auto integTime = createVectorLinspace(numTimes, initialTime, finalTime);
     const auto timeInterval = integTime[1] - integTime[0];
 
-    auto integralSumSquaredError =
-            [&selfTime, &otherTime, &numTimes, &integTime, &timeInterval](
-                    const VecStr& namesToUse, const SimTK::Matrix& selfData,
-                    const VecStr& selfNames, const SimTK::Matrix& otherData,
-                    const VecStr& otherNames) -> double {
+    // The splines are fitted to a chunk of columns at a time, so that the
+    // memory used does not grow with the number of columns. The errors are
+    // accumulated column by column, in the same order as the names.
+    const int chunkSize = 32;
+    auto integralSumSquaredError = [&](const VecStr& namesToUse, int block)
+            -> double {
         if (namesToUse.empty()) return 0;
 
-        TimeSeriesTable selfTable(selfTime, selfData, selfNames);
-        TimeSeriesTable otherTable(otherTime, otherData, otherNames);
-
-        GCVSplineSet self(selfTable, namesToUse,
-                std::min((int)selfTable.getNumRows() - 1, 5));
-        GCVSplineSet other(otherTable, namesToUse,
-                std::min((int)otherTable.getNumRows() - 1, 5));
-
         SimTK::Vector sumSquaredError(numTimes, 0.0);
-        for (int itime = 0; itime < numTimes; ++itime) {
-            const auto& curTime = integTime[itime];
-            SimTK::Vector curTimeVec(1, curTime);
-            bool selfInRange =
-                    self.getMinX() <= curTime && curTime <= self.getMaxX();
-            bool otherInRange =
-                    other.getMinX() <= curTime && curTime <= other.getMaxX();
-            for (int iname = 0; iname < (int)namesToUse.size(); ++iname) {
-                double selfValue =
-                        selfInRange ? self.get(iname).calcValue(curTimeVec) : 0;
-                double otherValue =
-                        otherInRange ? other.get(iname).calcValue(curTimeVec)
-                                     : 0;
-                sumSquaredError[itime] += SimTK::square(selfValue - otherValue);
+        for (int start = 0; start < (int)namesToUse.size();
+                start += chunkSize) {
+            const int end = std::min(start + chunkSize,
+                    (int)namesToUse.size());
+            std::vector<std::unique_ptr<GCVSpline>> selfSplines;
+            std::vector<std::unique_ptr<GCVSpline>> otherSplines;
+            for (int iname = start; iname < end; ++iname) {
+                const auto& name = namesToUse[iname];
+                const auto fit = [&name, block](const ContinuousVariables& vars) {
+                    const auto& names = vars.names[block];
+                    const int column = int(
+                            std::find(names.begin(), names.end(), name) -
+                            names.begin());
+                    const SimTK::Vector data = vars.getColumn(block, column);
+                    return std::unique_ptr<GCVSpline>(new GCVSpline(
+                            std::min(vars.time.size() - 1, 5),
+                            vars.time.size(), &vars.time[0], &data[0], name,
+                            0.0));
+                };
+                selfSplines.push_back(fit(self));
+                otherSplines.push_back(fit(other));
+            }
+            // As in GCVSplineSet, fit the splines of the chunk in parallel.
+            // getArgumentSize() creates (and caches) the underlying spline.
+            const int numSplines = end - start;
+            parallelFor(2 * numSplines, [&](int i) {
+                (i < numSplines ? selfSplines[i]
+                                : otherSplines[i - numSplines])
+                        ->getArgumentSize();
+            });
+            for (int itime = 0; itime < numTimes; ++itime) {
+                const auto& curTime = integTime[itime];
+                SimTK::Vector curTimeVec(1, curTime);
+                bool selfInRange = selfTime[0] <= curTime &&
+                                   curTime <= selfTime[selfTime.size() - 1];
+                bool otherInRange = otherTime[0] <= curTime &&
+                                    curTime <= otherTime[otherTime.size() - 1];
+                for (int i = 0; i < end - start; ++i) {
+                    double selfValue = selfInRange
+                            ? selfSplines[i]->calcValue(curTimeVec) : 0;
+                    double otherValue = otherInRange
+                            ? otherSplines[i]->calcValue(curTimeVec) : 0;
+                    sumSquaredError[itime] +=
+                            SimTK::square(selfValue - otherValue);
+                }
             }
         }
         // Trapezoidal rule for uniform grid:
@@ -1242,16 +1289,10 @@ double MocoTrajectory::compareContinuousVariablesRMSInternal(
                (sumSquaredError.sum() + sumSquaredError(1, numTimes - 2).sum());
     };
 
-    const auto stateISS = integralSumSquaredError(stateNames, m_states,
-            m_state_names, other.m_states, other.m_state_names);
-    const auto controlISS = integralSumSquaredError(controlNames, m_controls,
-            m_control_names, other.m_controls, other.m_control_names);
-    const auto multiplierISS = integralSumSquaredError(multiplierNames,
-            m_multipliers, m_multiplier_names, other.m_multipliers,
-            other.m_multiplier_names);
-    const auto derivativeISS = integralSumSquaredError(derivativeNames,
-            m_derivatives, m_derivative_names, other.m_derivatives,
-            other.m_derivative_names);
+    const auto stateISS = integralSumSquaredError(stateNames, 0);
+    const auto controlISS = integralSumSquaredError(controlNames, 1);
+    const auto multiplierISS = integralSumSquaredError(multiplierNames, 2);
+    const auto derivativeISS = integralSumSquaredError(derivativeNames, 3);
 
     // sqrt(1/(T*N) * integral_t (sum_is error_is^2 + sum_ic error_ic^2
     //                                          + sum_im error_im^2)
@@ -1261,25 +1302,32 @@ double MocoTrajectory::compareContinuousVariablesRMSInternal(
     return sqrt(ISS / (finalTime - initialTime) / numColumns);
 }
 
-double MocoTrajectory::compareContinuousVariablesRMS(
-        const MocoTrajectory& other,
-        std::map<std::string, std::vector<std::string>> cols) const {
-    ensureUnsealed();
+double MocoTrajectory::compareContinuousVariablesRMSInternal(
+        const ContinuousVariables& self, const ContinuousVariables& other,
+        const std::map<std::string, std::vector<std::string>>& cols) {
     for (auto kv : cols) {
         OPENSIM_THROW_IF(find(m_allowedKeys, kv.first) == m_allowedKeys.cend(),
                 Exception, "Key '{}' is not allowed.", kv.first);
     }
     if (cols.size() == 0) {
-        return compareContinuousVariablesRMSInternal(other);
+        return compareContinuousVariablesRMSInternal(self, other);
     }
     static const std::vector<std::string> none{"none"};
-    return compareContinuousVariablesRMSInternal(other,
+    return compareContinuousVariablesRMSInternal(self, other,
             cols.count("states") ? cols.at("states") : none,
             cols.count("controls") ? cols.at("controls") : none,
             cols.count("multipliers") ? cols.at("multipliers") : none,
             cols.count("derivatives") ? cols.at("derivatives") : none);
 }
 
+double MocoTrajectory::compareContinuousVariablesRMS(
+        const MocoTrajectory& other,
+        std::map<std::string, std::vector<std::string>> cols) const {
+    ensureUnsealed();
+    return compareContinuousVariablesRMSInternal(
+            getContinuousVariables(), other.getContinuousVariables(), cols);
+}
+
 double MocoTrajectory::compareContinuousVariablesRMSPattern(
         const MocoTrajectory& other, std::string columnType,
         std::string pattern) const {
@@ -18,15 +18,19 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "MocoResamplingPlan.h"
 #include "osimMocoDLL.h"
 
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/StatesTrajectory.h>
+#include <functional>
+#include <unordered_map>
 
 namespace OpenSim {
 
 class MocoProblem;
 class MocoProblemRep;
+class MocoMappedTrajectory;
 
 /// This exception is thrown if you try to invoke most methods on MocoTrajectory
 /// while the trajectory is sealed.
@@ -239,7 +243,16 @@ public:
     /// each variable for all time is its previous value at the initial time.
     /// @throws Exception if new times are not within existing initial and final
     /// times, if the new times are decreasing, or if getNumTimes() < 2.
-    void resample(SimTK::Vector newTime);
+    /// Use MocoResamplingPlan::Method::Linear for piecewise-linear instead of
+    /// spline interpolation.
+    void resample(SimTK::Vector newTime, MocoResamplingPlan::Method method =
+                                                 MocoResamplingPlan::Method::Spline);
+    /// Resample (interpolate) the data in this trajectory at the target times
+    /// of the plan. Create the plan once (with getTime() as the source times)
+    /// to resample many trajectories with the same times onto the same new
+    /// times without recomputing the interpolation weights.
+    /// @throws Exception if the plan's source times are not getTime().
+    void resample(const MocoResamplingPlan& plan);
     /// @}
 
     /// @name Set the data
@@ -599,6 +612,10 @@ public:
     /// @{
 
     /// Save the trajectory to a STO file. Use the ."sto" file extension.
+    /// With the ".bsto" extension, the trajectory is saved in the binary
+    /// format of BinaryFileAdapter instead, which is faster to read and write
+    /// and can be accessed without reading it into memory with
+    /// MocoMappedTrajectory.
     void write(const std::string& filepath) const;
 
     /// This table can be saved as a Storage file that can be used in the
@@ -696,17 +713,41 @@ protected:
     void ensureUnsealed() const;
 
 private:
+    friend class MocoMappedTrajectory;
     TimeSeriesTable convertToTable() const;
     virtual void convertToTableImpl(TimeSeriesTable&) const {}
-    double compareContinuousVariablesRMSInternal(const MocoTrajectory& other,
+    /// The time and the states, controls, multipliers, and derivatives of a
+    /// trajectory. The columns are provided one at a time (block 0: states,
+    /// 1: controls, 2: multipliers, 3: derivatives), so that comparing
+    /// trajectories does not copy whole blocks, and so that a
+    /// MocoMappedTrajectory can be compared without reading it into memory.
+    struct ContinuousVariables {
+        SimTK::Vector time;
+        std::vector<std::vector<std::string>> names;
+        std::function<SimTK::Vector(int block, int column)> getColumn;
+    };
+    ContinuousVariables getContinuousVariables() const;
+    static double compareContinuousVariablesRMSInternal(
+            const ContinuousVariables& self, const ContinuousVariables& other,
+            const std::map<std::string, std::vector<std::string>>& cols);
+    static double compareContinuousVariablesRMSInternal(
+            const ContinuousVariables& self, const ContinuousVariables& other,
             std::vector<std::string> stateNames = {},
             std::vector<std::string> controlNames = {},
             std::vector<std::string> multiplierNames = {},
-            std::vector<std::string> derivativeNames = {}) const;
+            std::vector<std::string> derivativeNames = {});
     static std::vector<std::string>::const_iterator find(
             const std::vector<std::string>& v, const std::string& elem) {
         return std::find(v.cbegin(), v.cend(), elem);
     }
+    using NameIndex = std::unordered_map<std::string, int>;
+    /// The column of `name` in `names`, or -1 if there is no such name. The
+    /// hash index is used if its entry is up to date; otherwise, this falls
+    /// back to a linear search (so a stale index is never wrong).
+    static int findIndex(const std::vector<std::string>& names,
+            const NameIndex& index, const std::string& name);
+    /// Rebuild the name-to-column indices. Call this after changing names.
+    void indexNames();
     void randomize(bool add, const SimTK::Random& randGen);
     SimTK::Vector m_time;
     std::vector<std::string> m_state_names;
@@ -715,6 +756,12 @@ private:
     std::vector<std::string> m_derivative_names;
     std::vector<std::string> m_slack_names;
     std::vector<std::string> m_parameter_names;
+    NameIndex m_state_index;
+    NameIndex m_control_index;
+    NameIndex m_multiplier_index;
+    NameIndex m_derivative_index;
+    NameIndex m_slack_index;
+    NameIndex m_parameter_index;
     // Dimensions: time x states
     SimTK::Matrix m_states;
     // Dimensions: time x controls
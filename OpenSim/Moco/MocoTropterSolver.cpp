@@ -109,6 +109,8 @@ MocoTropterSolver::createTropterSolver(
             Exception, "MocoTropterSolver does not support problems "
                        "with implicit auxiliary dynamics.");
 
+    checkPropertyValueIsInSet(getProperty_optim_hessian_approximation(),
+            {"limited-memory", "exact"});
     // Block sparsity detected is only in effect when using an exact Hessian
     // approximation.
     OPENSIM_THROW_IF(
@@ -183,6 +185,7 @@ MocoTropterSolver::createTropterSolver(
 
     optsolver.set_jacobian_approximation(get_optim_jacobian_approximation());
     optsolver.set_hessian_approximation(get_optim_hessian_approximation());
+    optsolver.set_automatic_scaling(get_optim_automatic_scaling());
 
     if (get_optim_solver() == "ipopt") {
         // Check that IPOPT print level is valid.
@@ -20,7 +20,11 @@
 
 #include "MocoProblem.h"
 #include "MocoTrajectory.h"
+#include "MocoGoal/MocoPeriodicityGoal.h"
+#include <cstdint>
+#include <iomanip>
 #include <regex>
+#include <sstream>
 
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Common/GCVSpline.h>
@@ -147,6 +151,23 @@ MocoTrajectory OpenSim::simulateTrajectoryWithTimeStepping(
     return forwardSolution;
 }
 
+namespace {
+std::vector<std::regex> compileRegexes(
+        const std::vector<std::string>& patterns) {
+    std::vector<std::regex> regexes;
+    for (const auto& pattern : patterns) regexes.emplace_back(pattern);
+    return regexes;
+}
+std::vector<std::pair<std::regex, std::string>> compileSymmetryRegexes(
+        const std::vector<std::pair<std::string, std::string>>& patterns) {
+    std::vector<std::pair<std::regex, std::string>> regexes;
+    for (const auto& pattern : patterns) {
+        regexes.emplace_back(std::regex(pattern.first), pattern.second);
+    }
+    return regexes;
+}
+} // anonymous namespace
+
 MocoTrajectory OpenSim::createPeriodicTrajectory(
         const MocoTrajectory& in, std::vector<std::string> addPatterns,
         std::vector<std::string> negatePatterns,
@@ -166,6 +187,12 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
         return std::find(v.begin(), v.end(), e);
     };
 
+    // Compile the patterns once, rather than once per column.
+    const auto addRegexes = compileRegexes(addPatterns);
+    const auto negateRegexes = compileRegexes(negatePatterns);
+    const auto negateAndShiftRegexes = compileRegexes(negateAndShiftPatterns);
+    const auto symmetryRegexes = compileSymmetryRegexes(symmetryPatterns);
+
     auto process = [&](std::string vartype,
                            const std::vector<std::string> names,
                            const SimTK::Matrix& oldTraj) -> SimTK::Matrix {
@@ -174,8 +201,7 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
             std::string name = names[i];
             newTraj.updBlock(0, i, oldN, 1) = oldTraj.col(i);
             bool matched = false;
-            for (const auto& pattern : addPatterns) {
-                const auto regex = std::regex(pattern);
+            for (const auto& regex : addRegexes) {
                 // regex_match() only returns true if the regex matches the
                 // entire name.
                 if (std::regex_match(name, regex)) {
@@ -190,8 +216,7 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
                 }
             }
 
-            for (const auto& pattern : negatePatterns) {
-                const auto regex = std::regex(pattern);
+            for (const auto& regex : negateRegexes) {
                 if (std::regex_match(name, regex)) {
                     matched = true;
                     const double& oldFinal = oldTraj.getElt(oldN - 1, i);
@@ -201,8 +226,7 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
                 }
             }
 
-            for (const auto& pattern : negateAndShiftPatterns) {
-                const auto regex = std::regex(pattern);
+            for (const auto& regex : negateAndShiftRegexes) {
                 if (std::regex_match(name, regex)) {
                     matched = true;
                     const double& oldFinal = oldTraj.getElt(oldN - 1, i);
@@ -214,8 +238,8 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
                 }
             }
 
-            for (const auto& pattern : symmetryPatterns) {
-                const auto regex = std::regex(pattern.first);
+            for (const auto& pattern : symmetryRegexes) {
+                const auto& regex = pattern.first;
                 // regex_search() returns true if the regex matches any portion
                 // of the name.
                 if (std::regex_search(name, regex)) {
@@ -257,6 +281,64 @@ MocoTrajectory OpenSim::createPeriodicTrajectory(
                     {"derivatives", {in.getDerivativeNames(), derivatives}}});
 }
 
+void OpenSim::addHalfPeriodSymmetryPairs(MocoPeriodicityGoal& goal,
+        const Model& model, std::vector<std::string> addPatterns,
+        std::vector<std::string> negatePatterns,
+        std::vector<std::string> negateAndShiftPatterns,
+        std::vector<std::pair<std::string, std::string>> symmetryPatterns) {
+
+    const auto addRegexes = compileRegexes(addPatterns);
+    const auto negateRegexes = compileRegexes(negatePatterns);
+    const auto negateAndShiftRegexes = compileRegexes(negateAndShiftPatterns);
+    const auto symmetryRegexes = compileSymmetryRegexes(symmetryPatterns);
+    const auto matchesAny = [](const std::string& name,
+                                    const std::vector<std::regex>& regexes) {
+        for (const auto& regex : regexes) {
+            if (std::regex_match(name, regex)) return true;
+        }
+        return false;
+    };
+
+    // The pairs are chosen such that the trajectory from
+    // createPeriodicTrajectory() is periodic.
+    const auto addPairs = [&](const std::string& vartype,
+                                  const std::vector<std::string>& names,
+                                  bool isState) {
+        for (const auto& name : names) {
+            if (matchesAny(name, addRegexes)) continue;
+            MocoPeriodicityGoalPair pair(name, name);
+            if (matchesAny(name, negateRegexes)) {
+                // The full period ends at the negated half-period value.
+                pair.set_negate(true);
+            } else if (!matchesAny(name, negateAndShiftRegexes)) {
+                // (A negated and shifted column ends the full period at its
+                // half-period value, like a column without a pattern.)
+                for (const auto& pattern : symmetryRegexes) {
+                    if (std::regex_search(name, pattern.first)) {
+                        const auto opposite = std::regex_replace(
+                                name, pattern.first, pattern.second);
+                        OPENSIM_THROW_IF(std::find(names.begin(), names.end(),
+                                                 opposite) == names.end(),
+                                Exception,
+                                "Could not find {} {}, which is supposed to "
+                                "be opposite of {}.",
+                                vartype, opposite, name);
+                        pair.set_final_variable(opposite);
+                        break;
+                    }
+                }
+            }
+            if (isState) goal.addStatePair(pair);
+            else goal.addControlPair(pair);
+        }
+    };
+
+    const auto stateNames = model.getStateVariableNames();
+    addPairs("state",
+            std::vector<std::string>(stateNames.begin(), stateNames.end()),
+            true);
+    addPairs("control", createControlNamesFromModel(model), false);
+}
 
 int OpenSim::getMocoParallelEnvironmentVariable() {
     const std::string varName = "OPENSIM_MOCO_PARALLEL";
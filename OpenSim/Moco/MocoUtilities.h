@@ -18,6 +18,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include "MocoMappedTrajectory.h"
 #include "MocoTrajectory.h"
 #include "osimMocoDLL.h"
 #include <condition_variable>
@@ -38,6 +39,7 @@ class StatesTrajectory;
 class Model;
 class MocoTrajectory;
 class MocoProblem;
+class MocoPeriodicityGoal;
 
 /// Calculate the requested outputs using the model in the problem and the
 /// provided StatesTrajectory and controls table.
@@ -59,17 +61,52 @@ class MocoProblem;
 /// CoordinateCouplerConstraint, the length of a muscle that crosses the patella
 /// will be incorrect.
 ///
+/// The time points can be analyzed in parallel with `numThreads`; see
+/// OpenSim::analyze().
+///
 /// @note Parameters and Lagrange multipliers in the MocoTrajectory are **not**
 ///       applied to the model.
 /// @ingroup mocoutil
 template <typename T>
 TimeSeriesTable_<T> analyzeMocoTrajectory(
         Model model, const MocoTrajectory& trajectory,
-        const std::vector<std::string>& outputPaths) {
+        const std::vector<std::string>& outputPaths, int numThreads = 1) {
     const TimeSeriesTable statesTable = trajectory.exportToStatesTable();
     const TimeSeriesTable controlsTable = trajectory.exportToControlsTable();
-    return analyze<T>(
-            std::move(model), statesTable, controlsTable, outputPaths);
+    return analyze<T>(std::move(model), statesTable, controlsTable,
+            outputPaths, numThreads);
+}
+
+/// The same as analyzeMocoTrajectory() for a MocoTrajectory, but the
+/// trajectory is read from the file and analyzed `chunkSize` time points at
+/// a time, so that the states and controls of the whole trajectory are never
+/// held in memory at once (only the report is).
+/// The model is initialized once for each chunk.
+/// @ingroup mocoutil
+template <typename T>
+TimeSeriesTable_<T> analyzeMocoTrajectory(const Model& model,
+        const MocoMappedTrajectory& trajectory,
+        const std::vector<std::string>& outputPaths, int numThreads = 1,
+        int chunkSize = 1000) {
+    OPENSIM_THROW_IF(chunkSize < 1, Exception,
+            "Expected a positive chunk size, but got {}.", chunkSize);
+    TimeSeriesTable_<T> report;
+    for (int start = 0; start < trajectory.getNumTimes(); start += chunkSize) {
+        const int numTimes =
+                std::min(chunkSize, trajectory.getNumTimes() - start);
+        const MocoTrajectory chunk = trajectory.read(start, numTimes);
+        const TimeSeriesTable_<T> chunkReport = analyzeMocoTrajectory<T>(
+                model, chunk, outputPaths, numThreads);
+        if (start == 0) {
+            report = chunkReport;
+            continue;
+        }
+        for (int irow = 0; irow < (int)chunkReport.getNumRows(); ++irow) {
+            report.appendRow(chunkReport.getIndependentColumn()[irow],
+                    chunkReport.getRowAtIndex(irow));
+        }
+    }
+    return report;
 }
 
 /// Given a MocoTrajectory and the associated OpenSim model, return the model
@@ -154,10 +191,52 @@ OSIMMOCO_API MocoTrajectory createPeriodicTrajectory(
         std::vector<std::pair<std::string, std::string>> symmetryPatterns =
                 {{R"(_r(\/|_|$))", "_l$1"}, {R"(_l(\/|_|$))", "_r$1"}});
 
+/// Add the state and control pairs to a MocoPeriodicityGoal that make a
+/// simulation over half the period of a symmetric motion (e.g., half a gait
+/// cycle) consistent with the full period, so that only half the period
+/// needs to be solved (with half the number of variables). The patterns have
+/// the same meaning (and defaults) as for createPeriodicTrajectory(), and the
+/// pairs are chosen such that the full-period trajectory that
+/// createPeriodicTrajectory() creates from the half-period solution is
+/// periodic:
+/// - columns that match an addPattern (e.g., pelvis_tx/value) get no pair;
+/// - columns that match a negatePattern get a negated pair with themselves;
+/// - columns that match a symmetryPattern are paired with the opposite column
+///   (e.g., the initial value of hip_flexion_r equals the final value of
+///   hip_flexion_l);
+/// - all other columns (including those that match a negateAndShiftPattern)
+///   are paired with themselves.
+///
+/// All state variables of the model and the controls of its actuators are
+/// paired, so the model must have a system (e.g., call initSystem() first).
+/// @code
+/// auto* symmetry = problem.addGoal<MocoPeriodicityGoal>("symmetry");
+/// addHalfPeriodSymmetryPairs(*symmetry, model);
+/// MocoSolution halfCycle = study.solve();
+/// MocoTrajectory fullCycle = createPeriodicTrajectory(halfCycle);
+/// @endcode
+/// @ingroup mocoutil
+OSIMMOCO_API void addHalfPeriodSymmetryPairs(MocoPeriodicityGoal& goal,
+        const Model& model,
+        std::vector<std::string> addPatterns = {".*pelvis_tx/value"},
+        std::vector<std::string> negatePatterns = {
+                                            ".*pelvis_list(?!/value).*",
+                                            ".*pelvis_rotation.*",
+                                            ".*pelvis_tz(?!/value).*",
+                                            ".*lumbar_bending(?!/value).*",
+                                            ".*lumbar_rotation.*"},
+        std::vector<std::string> negateAndShiftPatterns = {
+                                                   ".*pelvis_list/value",
+                                                   ".*pelvis_tz/value",
+                                                   ".*lumbar_bending/value"},
+        std::vector<std::pair<std::string, std::string>> symmetryPatterns =
+                {{R"(_r(\/|_|$))", "_l$1"}, {R"(_l(\/|_|$))", "_r$1"}});
+
 /// This obtains the value of the OPENSIM_MOCO_PARALLEL environment variable.
 /// The value has the following meanings:
 /// - 0: run in series (not parallel).
-/// - 1: run in parallel using all cores.
+/// - 1: run in parallel using the threads available from the OpenSim-wide
+///   budget (see getNumAvailableThreads() and OPENSIM_NUM_THREADS).
 /// - greater than 1: run in parallel with this number of parallel jobs.
 /// If the environment variable is not set, this function returns -1.
 ///
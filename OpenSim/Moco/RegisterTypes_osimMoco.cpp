@@ -60,59 +60,59 @@ static osimMocoInstantiator instantiator;
 
 OSIMMOCO_API void RegisterTypes_osimMoco() {
     try {
-        Object::registerType(MocoFinalTimeGoal());
-        Object::registerType(MocoAverageSpeedGoal());
-        Object::registerType(MocoWeight());
-        Object::registerType(MocoWeightSet());
-        Object::registerType(MocoStateTrackingGoal());
-        Object::registerType(MocoMarkerTrackingGoal());
-        Object::registerType(MocoMarkerFinalGoal());
-        Object::registerType(MocoContactTrackingGoal());
-        Object::registerType(MocoControlGoal());
-        Object::registerType(MocoSumSquaredStateGoal());
-        Object::registerType(MocoControlTrackingGoal());
-        Object::registerType(MocoInitialActivationGoal());
-        Object::registerType(MocoInitialVelocityEquilibriumDGFGoal());
-        Object::registerType(MocoInitialForceEquilibriumDGFGoal());
-        Object::registerType(MocoJointReactionGoal());
-        Object::registerType(MocoOrientationTrackingGoal());
-        Object::registerType(MocoTranslationTrackingGoal());
-        Object::registerType(MocoAngularVelocityTrackingGoal());
-        Object::registerType(MocoAccelerationTrackingGoal());
-        Object::registerType(MocoPeriodicityGoalPair());
-        Object::registerType(MocoPeriodicityGoal());
-        Object::registerType(MocoOutputGoal());
-        Object::registerType(MocoBounds());
-        Object::registerType(MocoInitialBounds());
-        Object::registerType(MocoFinalBounds());
-        Object::registerType(MocoVariableInfo());
-        Object::registerType(MocoParameter());
-        Object::registerType(MocoPhase());
-        Object::registerType(MocoProblem());
-        Object::registerType(MocoStudy());
+        Object::registerTypeLazily<MocoFinalTimeGoal>();
+        Object::registerTypeLazily<MocoAverageSpeedGoal>();
+        Object::registerTypeLazily<MocoWeight>();
+        Object::registerTypeLazily<MocoWeightSet>();
+        Object::registerTypeLazily<MocoStateTrackingGoal>();
+        Object::registerTypeLazily<MocoMarkerTrackingGoal>();
+        Object::registerTypeLazily<MocoMarkerFinalGoal>();
+        Object::registerTypeLazily<MocoContactTrackingGoal>();
+        Object::registerTypeLazily<MocoControlGoal>();
+        Object::registerTypeLazily<MocoSumSquaredStateGoal>();
+        Object::registerTypeLazily<MocoControlTrackingGoal>();
+        Object::registerTypeLazily<MocoInitialActivationGoal>();
+        Object::registerTypeLazily<MocoInitialVelocityEquilibriumDGFGoal>();
+        Object::registerTypeLazily<MocoInitialForceEquilibriumDGFGoal>();
+        Object::registerTypeLazily<MocoJointReactionGoal>();
+        Object::registerTypeLazily<MocoOrientationTrackingGoal>();
+        Object::registerTypeLazily<MocoTranslationTrackingGoal>();
+        Object::registerTypeLazily<MocoAngularVelocityTrackingGoal>();
+        Object::registerTypeLazily<MocoAccelerationTrackingGoal>();
+        Object::registerTypeLazily<MocoPeriodicityGoalPair>();
+        Object::registerTypeLazily<MocoPeriodicityGoal>();
+        Object::registerTypeLazily<MocoOutputGoal>();
+        Object::registerTypeLazily<MocoBounds>();
+        Object::registerTypeLazily<MocoInitialBounds>();
+        Object::registerTypeLazily<MocoFinalBounds>();
+        Object::registerTypeLazily<MocoVariableInfo>();
+        Object::registerTypeLazily<MocoParameter>();
+        Object::registerTypeLazily<MocoPhase>();
+        Object::registerTypeLazily<MocoProblem>();
+        Object::registerTypeLazily<MocoStudy>();
 
-        Object::registerType(MocoInverse());
-        Object::registerType(MocoTrack());
+        Object::registerTypeLazily<MocoInverse>();
+        Object::registerTypeLazily<MocoTrack>();
 
-        Object::registerType(MocoTropterSolver());
+        Object::registerTypeLazily<MocoTropterSolver>();
 
-        Object::registerType(MocoControlBoundConstraint());
-        Object::registerType(MocoFrameDistanceConstraint());
+        Object::registerTypeLazily<MocoControlBoundConstraint>();
+        Object::registerTypeLazily<MocoFrameDistanceConstraint>();
 
-        Object::registerType(MocoCasADiSolver());
+        Object::registerTypeLazily<MocoCasADiSolver>();
 
-        Object::registerType(ModOpReplaceMusclesWithDeGrooteFregly2016());
-        Object::registerType(ModOpTendonComplianceDynamicsModeDGF());
-        Object::registerType(ModOpIgnorePassiveFiberForcesDGF());
-        Object::registerType(ModOpScaleActiveFiberForceCurveWidthDGF());
+        Object::registerTypeLazily<ModOpReplaceMusclesWithDeGrooteFregly2016>();
+        Object::registerTypeLazily<ModOpTendonComplianceDynamicsModeDGF>();
+        Object::registerTypeLazily<ModOpIgnorePassiveFiberForcesDGF>();
+        Object::registerTypeLazily<ModOpScaleActiveFiberForceCurveWidthDGF>();
 
-        Object::registerType(AckermannVanDenBogert2010Force());
-        Object::registerType(MeyerFregly2016Force());
-        Object::registerType(EspositoMiller2018Force());
-        Object::registerType(PositionMotion());
+        Object::registerTypeLazily<AckermannVanDenBogert2010Force>();
+        Object::registerTypeLazily<MeyerFregly2016Force>();
+        Object::registerTypeLazily<EspositoMiller2018Force>();
+        Object::registerTypeLazily<PositionMotion>();
 
-        Object::registerType(DiscreteForces());
-        Object::registerType(AccelerationMotion());
+        Object::registerTypeLazily<DiscreteForces>();
+        Object::registerTypeLazily<AccelerationMotion>();
 
     } catch (const std::exception& e) {
         std::cerr << "ERROR during osimMoco Object registration:\n"
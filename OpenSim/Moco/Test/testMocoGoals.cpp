@@ -22,6 +22,7 @@
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Actuators/PointActuator.h>
+#include <OpenSim/Moco/MocoGoal/MocoReferenceCache.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
@@ -718,6 +719,21 @@ TEMPLATE_TEST_CASE("MocoOutputGoal", "", MocoCasADiSolver,
     CHECK(solutionControl.isNumericallyEqual(solutionOutput, 1e-5));
 }
 
+TEST_CASE("MocoOutputGoal requires a double output") {
+    auto model = createSlidingMassModel();
+    SimTK::State state = model->initSystem();
+    MocoOutputGoal goal;
+    goal.setOutputPath("/body|position");
+    CHECK_THROWS_WITH(goal.initializeOnModel(*model),
+            Catch::Contains("to be of type double"));
+
+    goal.setOutputPath("/slider/position|value");
+    goal.initializeOnModel(*model);
+    model->getCoordinateSet().get("position").setValue(state, 0.3);
+    CHECK(goal.calcIntegrand({0, state, SimTK::Vector()}) ==
+            Approx(0.3).margin(1e-12));
+}
+
 /// This goal violates the rule that calcIntegrandImpl() and calcGoalImpl()
 /// cannot realize the state's stage beyond the stage dependency.
 class MocoStageTestingGoal : public MocoGoal {
@@ -769,3 +785,60 @@ TEST_CASE("MocoGoal stage dependency") {
     CHECK_THROWS_WITH(goal.calcGoal(input, goalValue),
             Catch::Contains("calcGoal()") && Catch::Contains("final_state"));
 }
+
+TEST_CASE("MocoReferenceCache") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b"});
+    for (int i = 0; i < 11; ++i) {
+        const double time = 0.1 * i;
+        table.appendRow(time, {std::sin(time), std::cos(3 * time)});
+    }
+    GCVSplineSet splines(table);
+
+    MocoReferenceCache cache(5);
+    const SimTK::Vector times = createVectorLinspace(5, 0.05, 0.85);
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int i = 0; i < times.size(); ++i) {
+            const SimTK::Vector& values = cache.getValues(splines, times[i]);
+            REQUIRE(values.size() == 2);
+            const SimTK::Vector timeVec(1, times[i]);
+            CHECK(values[0] == splines[0].calcValue(timeVec));
+            CHECK(values[1] == splines[1].calcValue(timeVec));
+        }
+        // Times that were seen before are not added again.
+        CHECK(cache.getNumTimes() == 5);
+    }
+
+    // Exceeding the maximum number of times clears the cache.
+    cache.getValues(splines, 0.5);
+    CHECK(cache.getNumTimes() == 1);
+    cache.clear();
+    CHECK(cache.getNumTimes() == 0);
+}
+
+TEST_CASE("Model caches mobilizer reactions") {
+    auto model = ModelFactory::createDoublePendulum();
+    SimTK::State state = model.initSystem();
+    model.getCoordinateSet().get("q0").setValue(state, 0.3);
+    model.getCoordinateSet().get("q1").setSpeedValue(state, -1.2);
+    model.realizeAcceleration(state);
+
+    SimTK::Vector_<SimTK::SpatialVec> expected;
+    model.calcMobilizerReactionForces(state, expected);
+    const auto& cached = model.getMobilizerReactionForces(state);
+    REQUIRE(cached.size() == expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        CHECK(cached[i][0] == expected[i][0]);
+        CHECK(cached[i][1] == expected[i][1]);
+    }
+    // Subsequent calls at the same state return the same cache entry.
+    CHECK(&model.getMobilizerReactionForces(state) == &cached);
+
+    // Changing the state invalidates the cache.
+    model.getCoordinateSet().get("q0").setValue(state, -0.4);
+    model.calcMobilizerReactionForces(state, expected);
+    const auto& updated = model.getMobilizerReactionForces(state);
+    for (int i = 0; i < expected.size(); ++i) {
+        CHECK(updated[i][1] == expected[i][1]);
+    }
+}
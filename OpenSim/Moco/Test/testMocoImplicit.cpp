@@ -329,6 +329,10 @@ TEST_CASE("AccelerationMotion") {
     model.realizeAcceleration(state);
     CHECK(state.getUDot()[0] == Approx(udot[0]).margin(1e-10));
 
+    // Enabling again does not invalidate the realized stages.
+    accel->setEnabled(state, true);
+    CHECK(state.getSystemStage() == SimTK::Stage::Acceleration);
+
     // Disable.
     accel->setEnabled(state, false);
     model.realizeAcceleration(state);
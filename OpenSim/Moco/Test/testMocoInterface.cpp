@@ -18,12 +18,16 @@
 
 #define CATCH_CONFIG_MAIN
 #include "Testing.h"
+#include <chrono>
 #include <fstream>
+#include <sstream>
 
 #include <OpenSim/Actuators/BodyActuator.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Moco/MocoCasADiSolver/MocoCasOCIterateWriter.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
@@ -1606,6 +1610,149 @@ TEST_CASE("MocoTrajectory randomize") {
     }
 }
 
+TEST_CASE("MocoTrajectory name lookup") {
+    const SimTK::Vector time = createVectorLinspace(4, 0, 0.3);
+    const SimTK::Matrix states = SimTK::Test::randMatrix(4, 2);
+    const SimTK::Matrix controls = SimTK::Test::randMatrix(4, 3);
+    MocoTrajectory traj(time, {"a", "b"}, {"g", "h", "i"}, {}, {"p"}, states,
+            controls, SimTK::Matrix(), SimTK::RowVector(1, 0.5));
+    SimTK_TEST_EQ(traj.getState("b"), states.col(1));
+    SimTK_TEST_EQ(traj.getControl("i"), controls.col(2));
+    CHECK(traj.getParameter("p") == 0.5);
+
+    // Lookups remain correct after names are added and after copying.
+    TimeSeriesTable newStates(std::vector<double>{0, 0.1, 0.2, 0.3},
+            SimTK::Matrix(4, 1, 3.0), {"c"});
+    traj.insertStatesTrajectory(newStates);
+    MocoTrajectory copy = traj;
+    CHECK(copy.getState("c")[2] == Approx(3.0));
+    SimTK_TEST_EQ(copy.getState("a"), states.col(0));
+    traj.appendSlack("s", SimTK::Vector(4, 1.5));
+    CHECK(traj.getSlack("s")[0] == 1.5);
+    CHECK_THROWS_AS(traj.getState("none"), Exception);
+    CHECK_THROWS_AS(copy.getSlack("s"), Exception);
+
+    // Resampling keeps every block consistent with its names.
+    traj.resampleWithNumTimes(7);
+    CHECK(traj.getNumTimes() == 7);
+    CHECK(traj.getState("c")[5] == Approx(3.0));
+    CHECK(traj.getSlack("s")[6] == Approx(1.5));
+}
+
+TEST_CASE("MocoMappedTrajectory") {
+    const SimTK::Vector time = createVectorLinspace(9, 0, 0.8);
+    const SimTK::Matrix states = SimTK::Test::randMatrix(9, 2);
+    const SimTK::Matrix controls = SimTK::Test::randMatrix(9, 3);
+    const SimTK::Matrix multipliers = SimTK::Test::randMatrix(9, 1);
+    MocoTrajectory traj(time, {"a", "b"}, {"g", "h", "i"}, {"m"}, {"p"},
+            states, controls, multipliers, SimTK::RowVector(1, 0.5));
+    traj.appendSlack("s", SimTK::Vector(9, 1.5));
+    traj.write("testMocoInterface_MocoMappedTrajectory.bsto");
+
+    MocoMappedTrajectory mapped("testMocoInterface_MocoMappedTrajectory.bsto");
+    CHECK(mapped.getNumTimes() == 9);
+    CHECK(mapped.getInitialTime() == 0);
+    CHECK(mapped.getFinalTime() == Approx(0.8));
+    CHECK(mapped.getStateNames() == traj.getStateNames());
+    CHECK(mapped.getControlNames() == traj.getControlNames());
+    CHECK(mapped.getMultiplierNames() == traj.getMultiplierNames());
+    CHECK(mapped.getSlackNames() == traj.getSlackNames());
+    CHECK(mapped.getParameterNames() == traj.getParameterNames());
+    SimTK_TEST_EQ(mapped.getTime(), time);
+    SimTK_TEST_EQ(mapped.getState("b"), states.col(1));
+    SimTK_TEST_EQ(mapped.getControl("i"), controls.col(2));
+    SimTK_TEST_EQ(mapped.getMultiplier("m"), multipliers.col(0));
+    CHECK(mapped.getSlack("s")[4] == 1.5);
+    CHECK(mapped.getParameter("p") == 0.5);
+    CHECK_THROWS_AS(mapped.getState("none"), Exception);
+
+    // Reading the whole file reproduces the original trajectory.
+    CHECK(mapped.read().isNumericallyEqual(traj));
+
+    // Reading a range of time points.
+    const MocoTrajectory chunk = mapped.read(3, 4);
+    CHECK(chunk.getNumTimes() == 4);
+    CHECK(chunk.getInitialTime() == Approx(time[3]));
+    SimTK_TEST_EQ(chunk.getState("a"), states.col(0)(3, 4));
+    SimTK_TEST_EQ(chunk.getControl("g"), controls.col(0)(3, 4));
+    CHECK(chunk.getParameter("p") == 0.5);
+    CHECK_THROWS_AS(mapped.read(6, 4), Exception);
+
+    // Comparisons match those of the in-memory trajectories.
+    MocoTrajectory randomized = traj;
+    randomized.randomizeAdd(SimTK::Random::Uniform(-0.01, 0.01));
+    const double expected = traj.compareContinuousVariablesRMS(randomized);
+    CHECK(mapped.compareContinuousVariablesRMS(randomized) ==
+            Approx(expected));
+    randomized.write("testMocoInterface_MocoMappedTrajectory_random.bsto");
+    CHECK(mapped.compareContinuousVariablesRMS(MocoMappedTrajectory(
+                  "testMocoInterface_MocoMappedTrajectory_random.bsto")) ==
+            Approx(expected));
+    CHECK(mapped.compareContinuousVariablesRMS(
+                  traj, {{"states", {"b"}}, {"controls", {}}}) ==
+            Approx(0).margin(1e-12));
+
+    // A text file cannot be mapped.
+    traj.write("testMocoInterface_MocoMappedTrajectory.sto");
+    CHECK_THROWS_AS(
+            MocoMappedTrajectory("testMocoInterface_MocoMappedTrajectory.sto"),
+            Exception);
+}
+
+TEST_CASE("MocoResamplingPlan") {
+    const SimTK::Vector source = createVectorLinspace(9, 0, 1);
+    const SimTK::Vector target = createVector({0, 0.05, 0.3, 0.71, 1});
+    SimTK::Matrix data(9, 2);
+    for (int i = 0; i < 9; ++i) {
+        data(i, 0) = 2 * source[i] - 1;
+        data(i, 1) = std::sin(3 * source[i]);
+    }
+
+    SECTION("Spline matches GCVSpline") {
+        MocoResamplingPlan plan(source, target);
+        const SimTK::Matrix result = plan.apply(data);
+        const SimTK::Vector column = data.col(1);
+        const GCVSpline spline(5, 9, &source[0], &column[0]);
+        for (int i = 0; i < target.size(); ++i) {
+            CHECK(result(i, 0) == Approx(2 * target[i] - 1).margin(1e-10));
+            CHECK(result(i, 1) ==
+                    Approx(spline.calcValue(SimTK::Vector(1, target[i])))
+                            .margin(1e-10));
+        }
+    }
+
+    SECTION("Linear") {
+        MocoResamplingPlan plan(
+                source, target, MocoResamplingPlan::Method::Linear);
+        // At most two weights per target time.
+        CHECK(plan.getNumWeights() <= 2 * target.size());
+        const SimTK::Matrix result = plan.apply(data);
+        CHECK(result(0, 1) == data(0, 1));
+        CHECK(result(1, 1) == Approx(0.6 * data(0, 1) + 0.4 * data(1, 1)));
+        CHECK(result(4, 1) == data(8, 1));
+        CHECK_THROWS_AS(plan.apply(SimTK::Matrix(3, 1)), Exception);
+    }
+
+    SECTION("Reuse a plan for many trajectories") {
+        const SimTK::Matrix states = data.block(0, 0, 9, 1);
+        const SimTK::Matrix controls = data.block(0, 1, 9, 1);
+        MocoTrajectory traj0(source, {"a"}, {"b"}, {}, {}, states, controls,
+                SimTK::Matrix(), SimTK::RowVector());
+        MocoTrajectory traj1 = traj0;
+        MocoTrajectory traj2 = traj0;
+        traj1.resample(target);
+        MocoResamplingPlan plan(traj2.getTime(), target);
+        traj2.resample(plan);
+        SimTK_TEST_EQ(traj1.getTime(), traj2.getTime());
+        SimTK_TEST_EQ_TOL(traj1.getStatesTrajectory(),
+                traj2.getStatesTrajectory(), 1e-12);
+        SimTK_TEST_EQ_TOL(traj1.getControlsTrajectory(),
+                traj2.getControlsTrajectory(), 1e-12);
+        // The plan's source times must match the trajectory.
+        CHECK_THROWS_AS(traj2.resample(plan), Exception);
+    }
+}
+
 TEST_CASE("createPeriodicTrajectory") {
     const std::string hip_r = "hip_r/hip_flexion_r/value";
     const std::string hip_l = "hip_l/hip_flexion_l/value";
@@ -1672,6 +1819,84 @@ TEST_CASE("createPeriodicTrajectory") {
             fullTraj.getControl("soleus_r").block(1, 0, N - 1, 1));
 }
 
+TEST_CASE("addHalfPeriodSymmetryPairs") {
+    Model model;
+    const auto addSlider = [&](const std::string& side,
+                                   const std::string& coordName) {
+        auto* body = new Body("body" + side, 1, SimTK::Vec3(0),
+                SimTK::Inertia(1));
+        model.addBody(body);
+        auto* joint = new SliderJoint(
+                "joint" + side, model.getGround(), *body);
+        joint->updCoordinate().setName(coordName);
+        model.addJoint(joint);
+        auto* actu = new CoordinateActuator(coordName);
+        actu->setName("actu" + side);
+        model.addForce(actu);
+    };
+    addSlider("_r", "knee_r");
+    addSlider("_l", "knee_l");
+    addSlider("_pelvis", "pelvis_tx");
+    addSlider("_list", "pelvis_list");
+    model.initSystem();
+
+    MocoPeriodicityGoal goal;
+    addHalfPeriodSymmetryPairs(goal, model);
+
+    const auto getPairs = [&](const std::string& propertyName) {
+        std::map<std::string, std::pair<std::string, bool>> pairs;
+        const auto& prop = goal.getPropertyByName(propertyName);
+        for (int i = 0; i < prop.size(); ++i) {
+            const auto& pair = dynamic_cast<const MocoPeriodicityGoalPair&>(
+                    prop.getValueAsObject(i));
+            pairs[pair.get_initial_variable()] = {
+                    pair.get_final_variable(), pair.get_negate()};
+        }
+        return pairs;
+    };
+    const auto statePairs = getPairs("state_pairs");
+    // pelvis_tx/value increases over the period, so it has no pair.
+    CHECK(statePairs.size() == 7);
+    CHECK(statePairs.count("/jointset/joint_pelvis/pelvis_tx/value") == 0);
+    CHECK(statePairs.at("/jointset/joint_pelvis/pelvis_tx/speed") ==
+            std::make_pair(
+                    std::string("/jointset/joint_pelvis/pelvis_tx/speed"),
+                    false));
+    CHECK(statePairs.at("/jointset/joint_r/knee_r/value") ==
+            std::make_pair(std::string("/jointset/joint_l/knee_l/value"),
+                    false));
+    CHECK(statePairs.at("/jointset/joint_l/knee_l/speed") ==
+            std::make_pair(std::string("/jointset/joint_r/knee_r/speed"),
+                    false));
+    CHECK(statePairs.at("/jointset/joint_list/pelvis_list/value") ==
+            std::make_pair(
+                    std::string("/jointset/joint_list/pelvis_list/value"),
+                    false));
+    CHECK(statePairs.at("/jointset/joint_list/pelvis_list/speed") ==
+            std::make_pair(
+                    std::string("/jointset/joint_list/pelvis_list/speed"),
+                    true));
+
+    const auto controlPairs = getPairs("control_pairs");
+    CHECK(controlPairs.size() == 4);
+    CHECK(controlPairs.at("/forceset/actu_r") ==
+            std::make_pair(std::string("/forceset/actu_l"), false));
+    CHECK(controlPairs.at("/forceset/actu_pelvis") ==
+            std::make_pair(std::string("/forceset/actu_pelvis"), false));
+
+    // A symmetric column without its opposite is an error.
+    Model oneSided;
+    auto* body = new Body("body", 1, SimTK::Vec3(0), SimTK::Inertia(1));
+    oneSided.addBody(body);
+    auto* joint = new SliderJoint("joint", oneSided.getGround(), *body);
+    joint->updCoordinate().setName("knee_r");
+    oneSided.addJoint(joint);
+    oneSided.initSystem();
+    MocoPeriodicityGoal oneSidedGoal;
+    CHECK_THROWS_WITH(addHalfPeriodSymmetryPairs(oneSidedGoal, oneSided),
+            Catch::Contains("which is supposed to be opposite of"));
+}
+
 TEST_CASE("Interpolate", "") {
     SimTK::Vector x(2);
     x[0] = 0;
@@ -1990,6 +2215,46 @@ TEST_CASE("solveBisection()") {
     }
 }
 
+TEST_CASE("Thread budget") {
+    setMaxNumThreads(4);
+    CHECK(getMaxNumThreads() == 4);
+    CHECK(getNumAvailableThreads() == 4);
+    {
+        ThreadReservation first(3);
+        CHECK(first.getNumThreads() == 3);
+        CHECK(getNumAvailableThreads() == 2);
+        // Only one more thread is left in the budget.
+        ThreadReservation second(4);
+        CHECK(second.getNumThreads() == 2);
+        ThreadReservation third(2);
+        CHECK(third.getNumThreads() == 1);
+        CHECK(getNumAvailableThreads() == 1);
+    }
+    CHECK(getNumAvailableThreads() == 4);
+
+    // Nested loops share the budget instead of multiplying the threads.
+    std::atomic<int> numActive(0);
+    std::atomic<int> maxActive(0);
+    std::vector<int> counts(4 * 8, 0);
+    parallelFor(4, [&](int i) {
+        parallelFor(8, [&](int j) {
+            const int active = ++numActive;
+            int observed = maxActive.load();
+            while (active > observed &&
+                    !maxActive.compare_exchange_weak(observed, active)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++counts[8 * i + j];
+            --numActive;
+        }, 8);
+    });
+    CHECK(maxActive.load() <= 4);
+    for (const auto& count : counts) CHECK(count == 1);
+    CHECK(getNumAvailableThreads() == 4);
+
+    setMaxNumThreads(0);
+    CHECK(getMaxNumThreads() >= 1);
+}
+
 TEST_CASE("Objective breakdown", "[casadi]") {
     class MocoConstantGoal : public MocoGoal {
         OpenSim_DECLARE_CONCRETE_OBJECT(MocoConstantGoal, MocoGoal);
@@ -2023,6 +2288,308 @@ TEST_CASE("Objective breakdown", "[casadi]") {
     CHECK(solution.getObjectiveTerm("goal_b") == Approx(0.01 * 7.3));
 }
 
+TEST_CASE("Sparsity cache", "[casadi]") {
+    const std::string cacheFile = "testMocoInterface_sparsity_cache.txt";
+    std::remove(cacheFile.c_str());
+    auto readFile = [&]() {
+        std::ifstream stream(cacheFile);
+        std::stringstream ss;
+        ss << stream.rdbuf();
+        return ss.str();
+    };
+
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_optim_sparsity_detection("random");
+    solver.set_optim_sparsity_cache(cacheFile);
+    MocoSolution detected = study.solve();
+    const std::string contents = readFile();
+    REQUIRE(contents.find("CasOC sparsity cache") == 0);
+    CHECK(contents.find("function explicit_multibody_system ") !=
+            std::string::npos);
+
+    // The mesh does not affect the patterns, so the cache is used and the
+    // file is not rewritten.
+    solver.set_num_mesh_intervals(15);
+    MocoSolution cached = study.solve();
+    CHECK(cached.success());
+    CHECK(readFile() == contents);
+    solver.set_num_mesh_intervals(19);
+    cached = study.solve();
+    CHECK(cached.compareContinuousVariablesRMS(detected) < 1e-10);
+
+    // Changing the problem changes the key, so the patterns are detected
+    // again and the file is replaced.
+    study.updProblem().addGoal<MocoControlGoal>("effort", 0.1);
+    study.solve();
+    const std::string newContents = readFile();
+    CHECK(newContents != contents);
+    CHECK(newContents.find("function cost_effort_integrand ") !=
+            std::string::npos);
+    std::remove(cacheFile.c_str());
+}
+
+TEST_CASE("MocoCasOCIterateWriter") {
+    MocoTrajectory traj(createVectorLinspace(4, 0, 1),
+            {{"states", {{"/s0", "/s1"}, SimTK::Matrix(4, 2)}},
+                    {"controls", {{"/c"}, SimTK::Matrix(4, 1)}}});
+    traj.randomizeReplace();
+    const std::string prefix = "testMocoInterface_iterate";
+    {
+        MocoCasOCIterateWriter stoWriter(prefix, false);
+        MocoCasOCIterateWriter binaryWriter(prefix, true);
+        stoWriter.submit(7, OpenSim::make_unique<MocoTrajectory>(traj));
+        binaryWriter.submit(8, OpenSim::make_unique<MocoTrajectory>(traj));
+        // The destructors wait for the files to be written.
+    }
+    MocoTrajectory fromSto(prefix + "000007.sto");
+    CHECK(fromSto.isNumericallyEqual(traj));
+
+    std::ifstream stream(prefix + "000008.bin", std::ios::binary);
+    REQUIRE(stream.good());
+    auto readInt = [&]() {
+        int32_t value;
+        stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    };
+    char magic[8];
+    stream.read(magic, 8);
+    CHECK(std::string(magic, 8) == "OSIMITR1");
+    CHECK(readInt() == 8);
+    const TimeSeriesTable table = traj.convertToTable();
+    REQUIRE(readInt() == (int)table.getNumRows());
+    REQUIRE(readInt() == (int)table.getNumColumns());
+    for (const auto& label : table.getColumnLabels()) {
+        std::string read(readInt(), ' ');
+        stream.read(&read[0], read.size());
+        CHECK(read == label);
+    }
+    std::vector<double> times(table.getNumRows());
+    stream.read(reinterpret_cast<char*>(times.data()),
+            times.size() * sizeof(double));
+    CHECK(times == table.getIndependentColumn());
+    const auto& matrix = table.getMatrix();
+    for (int irow = 0; irow < matrix.nrow(); ++irow) {
+        for (int icol = 0; icol < matrix.ncol(); ++icol) {
+            double value;
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+            CHECK(value == matrix.getElt(irow, icol));
+        }
+    }
+    CHECK(stream.good());
+}
+
+TEST_CASE("Mesh refinement", "[casadi]") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_transcription_scheme(transcriptionScheme);
+    solver.set_num_mesh_intervals(6);
+    MocoSolution coarse = study.solve();
+
+    solver.set_mesh_refinement_max_iterations(4);
+    solver.set_mesh_refinement_tolerance(1e-4);
+    MocoSolution refined = study.solve();
+    REQUIRE(refined.success());
+    // The mesh is refined, but not uniformly (4 uniform refinements would
+    // give 96 mesh intervals).
+    const int pointsPerInterval =
+            transcriptionScheme == "trapezoidal" ? 1 : 2;
+    CHECK(refined.getNumTimes() > coarse.getNumTimes());
+    CHECK(refined.getNumTimes() < pointsPerInterval * 96 + 1);
+    CHECK(refined.getNumIterations() > coarse.getNumIterations());
+    // The minimum time is 2 seconds (bang-bang control).
+    CHECK(refined.getFinalTime() == Approx(2.0).epsilon(1e-2));
+}
+
+TEST_CASE("Legendre-Gauss-Radau transcription", "[casadi]") {
+    auto solveWith = [](const std::string& transcriptionScheme) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        study.updProblem().addGoal<MocoControlGoal>("effort", 0.1);
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_transcription_scheme(transcriptionScheme);
+        solver.set_num_mesh_intervals(10);
+        return study.solve();
+    };
+    MocoSolution hermiteSimpson = solveWith("hermite-simpson");
+    for (int degree : {1, 2, 3}) {
+        CAPTURE(degree);
+        MocoSolution radau =
+                solveWith("legendre-gauss-radau-" + std::to_string(degree));
+        REQUIRE(radau.success());
+        // The start of each mesh interval, the collocation points, and the
+        // final time.
+        CHECK(radau.getNumTimes() == 10 * degree + 1);
+        CHECK(radau.getObjective() ==
+                Approx(hermiteSimpson.getObjective()).epsilon(1e-2));
+        CHECK(radau.getFinalTime() ==
+                Approx(hermiteSimpson.getFinalTime()).epsilon(1e-2));
+    }
+    CHECK_THROWS_WITH(solveWith("legendre-gauss-radau-0"),
+            Catch::Contains("transcription_scheme"));
+    CHECK_THROWS_WITH(solveWith("legendre-gauss-radau"),
+            Catch::Contains("transcription_scheme"));
+}
+
+TEST_CASE("Symbolic integrands", "[casadi]") {
+    auto solveWith = [](const std::string& symbolicIntegrands,
+                             int exponent) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        auto* effort =
+                study.updProblem().addGoal<MocoControlGoal>("effort", 0.1);
+        effort->setExponent(exponent);
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_optim_symbolic_integrands(symbolicIntegrands);
+        return study.solve();
+    };
+    for (int exponent : {2, 3}) {
+        CAPTURE(exponent);
+        MocoSolution callback = solveWith("none", exponent);
+        MocoSolution symbolic = solveWith("symbolic", exponent);
+        REQUIRE(symbolic.success());
+        CHECK(symbolic.getObjective() ==
+                Approx(callback.getObjective()).epsilon(1e-6));
+        CHECK(symbolic.compareContinuousVariablesRMS(callback) < 1e-4);
+    }
+
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    study.updSolver<MocoCasADiSolver>().set_optim_symbolic_integrands(
+            "compiled");
+    CHECK_THROWS_WITH(study.solve(),
+            Catch::Contains("optim_symbolic_integrands"));
+}
+
+TEST_CASE("Profiling callbacks", "[casadi]") {
+    // Read the profile file as a map from function name to the number of
+    // calls.
+    auto readProfile = [](const std::string& fileName) {
+        std::ifstream file(fileName);
+        std::string line;
+        std::getline(file, line);
+        CHECK(line == "function,calls,total_time,mean_time,threads");
+        std::map<std::string, int> numCalls;
+        while (std::getline(file, line)) {
+            std::stringstream ss(line);
+            std::string name;
+            std::string calls;
+            std::getline(ss, name, ',');
+            std::getline(ss, calls, ',');
+            numCalls[name] = std::stoi(calls);
+        }
+        return numCalls;
+    };
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_profile("detailed");
+    solver.set_profile_file("testMocoInterface_profile_detailed.csv");
+    MocoSolution solution = study.solve();
+    REQUIRE(solution.success());
+    auto detailed = readProfile("testMocoInterface_profile_detailed.csv");
+    CHECK(detailed.at("explicit_multibody_system") > 0);
+    CHECK(detailed.count("cost_goal_endpoint") == 1);
+    CHECK(detailed.count("solve_wall_time") == 1);
+
+    solver.set_profile("summary");
+    solver.set_profile_file("testMocoInterface_profile_summary.csv");
+    study.solve();
+    auto summary = readProfile("testMocoInterface_profile_summary.csv");
+    CHECK(summary.at("goals") > 0);
+    CHECK(summary.at("multibody_system") >=
+            detailed.at("explicit_multibody_system"));
+    CHECK(summary.count("explicit_multibody_system") == 0);
+
+    solver.set_profile("full");
+    CHECK_THROWS_WITH(study.solve(), Catch::Contains("profile"));
+}
+
+TEST_CASE("Exact Hessian of symbolic goals", "[casadi]") {
+    // With a fixed final time, the dynamics of the sliding mass are linear,
+    // so ignoring the curvature of the callbacks loses nothing.
+    auto solveWith = [](const std::string& hessianApproximation) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        auto& problem = study.updProblem();
+        problem.setTimeBounds(0, 3);
+        problem.addGoal<MocoControlGoal>("effort");
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_optim_symbolic_integrands("symbolic");
+        solver.set_optim_hessian_approximation(hessianApproximation);
+        return study.solve();
+    };
+    MocoSolution limitedMemory = solveWith("limited-memory");
+    MocoSolution exactGoals = solveWith("exact-goals");
+    REQUIRE(exactGoals.success());
+    CHECK(exactGoals.getObjective() ==
+            Approx(limitedMemory.getObjective()).epsilon(1e-4));
+    CHECK(exactGoals.getNumIterations() < limitedMemory.getNumIterations());
+
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    study.updSolver<MocoCasADiSolver>().set_optim_hessian_approximation(
+            "exact-goals");
+    CHECK_THROWS_WITH(study.solve(),
+            Catch::Contains("optim_symbolic_integrands"));
+}
+
+TEMPLATE_TEST_CASE("Automatic scaling", "", MocoCasADiSolver,
+        MocoTropterSolver) {
+    // Scaling changes only the problem seen by IPOPT; the solution, in
+    // physical units, is the same.
+    auto solveWith = [](bool scaling) {
+        MocoStudy study = createSlidingMassMocoStudy<TestType>();
+        study.updSolver<TestType>().set_optim_automatic_scaling(scaling);
+        return study.solve();
+    };
+    MocoSolution unscaled = solveWith(false);
+    MocoSolution scaled = solveWith(true);
+    REQUIRE(scaled.success());
+    CHECK(scaled.getFinalTime() ==
+            Approx(unscaled.getFinalTime()).epsilon(1e-4));
+    OpenSim_CHECK_MATRIX_ABSTOL(scaled.getStatesTrajectory(),
+            unscaled.getStatesTrajectory(), 1e-3);
+    OpenSim_CHECK_MATRIX_ABSTOL(scaled.getControlsTrajectory(),
+            unscaled.getControlsTrajectory(), 1e-2);
+}
+
+TEST_CASE("Batch evaluation", "[casadi]") {
+    // The batched evaluation computes the same NLP functions and derivatives.
+    auto solveWith = [](bool batch, int parallel) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_batch_evaluation(batch);
+        solver.set_parallel(parallel);
+        return study.solve();
+    };
+    MocoSolution mapped = solveWith(false, 0);
+    for (int parallel : {0, 2}) {
+        CAPTURE(parallel);
+        MocoSolution batched = solveWith(true, parallel);
+        REQUIRE(batched.success());
+        CHECK(batched.getFinalTime() ==
+                Approx(mapped.getFinalTime()).epsilon(1e-6));
+        OpenSim_CHECK_MATRIX_ABSTOL(batched.getStatesTrajectory(),
+                mapped.getStatesTrajectory(), 1e-6);
+        OpenSim_CHECK_MATRIX_ABSTOL(batched.getControlsTrajectory(),
+                mapped.getControlsTrajectory(), 1e-6);
+    }
+}
+
+TEST_CASE("Automatic parallelism", "[casadi]") {
+    // Choosing the number of threads does not change the solution.
+    auto solveWith = [](int parallel) {
+        MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+        auto& solver = study.updSolver<MocoCasADiSolver>();
+        solver.set_parallel(parallel);
+        return study.solve();
+    };
+    MocoSolution serial = solveWith(0);
+    MocoSolution tuned = solveWith(-1);
+    REQUIRE(tuned.success());
+    CHECK(tuned.getFinalTime() == Approx(serial.getFinalTime()).epsilon(1e-6));
+    OpenSim_CHECK_MATRIX_ABSTOL(tuned.getStatesTrajectory(),
+            serial.getStatesTrajectory(), 1e-6);
+    CHECK_THROWS_WITH(solveWith(-2), Catch::Contains("parallel"));
+}
+
 TEST_CASE("Solver isAvailable()") {
 #ifdef OPENSIM_WITH_CASADI
     CHECK(MocoCasADiSolver::isAvailable());
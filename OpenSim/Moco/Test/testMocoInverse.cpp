@@ -64,6 +64,34 @@ TEST_CASE("PrescribedKinematics prescribe() and realize()") {
     CHECK(ydot[1] == Approx(2 * c2));
 }
 
+TEST_CASE("PrescribedKinematics uses a state for each time") {
+    Model model = ModelFactory::createPendulum();
+    auto* motion = new PositionMotion();
+    motion->setPositionForCoordinate(model.getCoordinateSet().get(0),
+            PolynomialFunction(createVector({1.3, 0.17, 0.81})));
+    model.addModelComponent(motion);
+
+    MocoProblem problem;
+    problem.setModelAsCopy(model);
+    problem.setTimeBounds(0, 1);
+    const auto rep = problem.createRep();
+    REQUIRE(rep.isPrescribedKinematics());
+
+    rep.selectStateDisabledConstraints(0.2);
+    SimTK::State* state02 = &rep.updStateDisabledConstraints();
+    state02->setTime(0.2);
+    rep.selectStateDisabledConstraints(0.4);
+    SimTK::State* state04 = &rep.updStateDisabledConstraints();
+    CHECK(state02 != state04);
+    // Returning to a time gives back the same (already realized) state.
+    rep.selectStateDisabledConstraints(0.2);
+    CHECK(&rep.updStateDisabledConstraints() == state02);
+    CHECK(rep.updStateDisabledConstraints().getTime() == 0.2);
+    // The two state objects are distinct even at the same time.
+    rep.selectStateDisabledConstraints(0.2, 1);
+    CHECK(&rep.updStateDisabledConstraints(1) != state02);
+}
+
 TEST_CASE("PrescribedKinematics direct collocation auxiliary dynamics",
         "[casadi]") {
 
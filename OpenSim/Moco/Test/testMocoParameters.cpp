@@ -19,6 +19,7 @@
 #define CATCH_CONFIG_MAIN
 #include "Testing.h"
 
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/SpringGeneralizedForce.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
@@ -257,3 +258,46 @@ TEMPLATE_TEST_CASE("See-saw center of mass", "",
 
     CHECK(sol_xCOM == Approx(xCOM).epsilon(0.003));
 }
+
+TEST_CASE("Parameters that do not require initSystem()") {
+    auto model = createOscillatorModel();
+    auto* actu = new CoordinateActuator("position");
+    actu->setName("actuator");
+    actu->setOptimalForce(1.0);
+    model->addComponent(actu);
+    model->finalizeConnections();
+
+    SECTION("Body mass requires initSystem()") {
+        MocoProblem problem;
+        problem.setModelCopy(*model);
+        problem.addParameter("mass", "body", "mass", MocoBounds(0, 10));
+        problem.addParameter("optimal_force", "actuator", "optimal_force",
+                MocoBounds(0, 10));
+        const auto rep = problem.createRep();
+        CHECK(!rep.getParameter("optimal_force").getRequiresInitSystem());
+        CHECK(rep.getParameter("mass").getRequiresInitSystem());
+        CHECK(rep.getParametersRequireInitSystem());
+    }
+
+    SECTION("Optimal force is read when used") {
+        MocoProblem problem;
+        problem.setModelCopy(*model);
+        problem.addParameter("optimal_force", "actuator", "optimal_force",
+                MocoBounds(0, 10));
+        const auto rep = problem.createRep();
+        CHECK(!rep.getParametersRequireInitSystem());
+
+        const auto& modelBase = rep.getModelBase();
+        const auto& actuBase =
+                modelBase.getComponent<CoordinateActuator>("/actuator");
+        SimTK::State& state = rep.updStateBase();
+        modelBase.realizeVelocity(state);
+        modelBase.setControls(state, SimTK::Vector(1, 0.5));
+        rep.applyParametersToModelProperties(SimTK::Vector(1, 3.0), false);
+        CHECK(actuBase.getOptimalForce() == 3.0);
+        // The state is still usable without calling initSystem().
+        CHECK(state.getSystemStage() < SimTK::Stage::Instance);
+        modelBase.realizeVelocity(state);
+        CHECK(actuBase.computeActuation(state) == Approx(1.5));
+    }
+}
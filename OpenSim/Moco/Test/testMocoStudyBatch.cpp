@@ -0,0 +1,119 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim Moco: testMocoStudyBatch.cpp                                       *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include "Testing.h"
+
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Moco/osimMoco.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+
+using namespace OpenSim;
+
+// Reshaper is a JetBrains add-on to Visual Studio that allows running tests
+// individually, but sometimes needs this dummy test case to make template
+// test cases discoverable.
+TEST_CASE("(Dummy test to support discovery in Resharper)") { REQUIRE(true); }
+
+std::unique_ptr<Model> createSlidingMassModel(double mass) {
+    auto model = make_unique<Model>();
+    model->setName("sliding_mass");
+    model->set_gravity(SimTK::Vec3(0, 0, 0));
+    auto* body = new Body("body", mass, SimTK::Vec3(0), SimTK::Inertia(0));
+    model->addComponent(body);
+
+    auto* joint = new SliderJoint("slider", model->getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("position");
+    model->addComponent(joint);
+
+    auto* actu = new CoordinateActuator();
+    actu->setCoordinate(&coord);
+    actu->setName("actuator");
+    actu->setOptimalForce(1);
+    actu->setMinControl(-100);
+    actu->setMaxControl(100);
+    model->addComponent(actu);
+
+    return model;
+}
+
+TEMPLATE_TEST_CASE("MocoStudyBatch", "", MocoCasADiSolver,
+        MocoTropterSolver) {
+    MocoStudy study;
+    study.setName("sliding_mass");
+    MocoProblem& problem = study.updProblem();
+    problem.setModel(createSlidingMassModel(1.0));
+    problem.setTimeBounds(0, 1);
+    problem.setStateInfo("/slider/position/value", {0, 1}, 0, 1);
+    problem.setStateInfo("/slider/position/speed", {-100, 100}, 0, 0);
+    problem.addGoal<MocoControlGoal>("effort");
+    auto& solver = study.initSolver<TestType>();
+    solver.set_num_mesh_intervals(20);
+
+    const MocoSolution reference = study.solve();
+    REQUIRE(reference.success());
+
+    MocoStudyBatch batch(study);
+    const std::vector<double> weights{0.5, 1.0, 4.0};
+    for (double weight : weights) {
+        MocoStudyBatch::Job job;
+        job.name = "weight_" + std::to_string((int)(10 * weight));
+        job.goalWeights.emplace_back("effort", weight);
+        batch.addJob(job);
+    }
+    // A heavier mass requires more effort.
+    MocoStudyBatch::Job heavy;
+    heavy.name = "heavy";
+    heavy.modifier = [](MocoStudy& s) {
+        s.updProblem().setModel(createSlidingMassModel(2.0));
+    };
+    batch.addJob(heavy);
+    // A job with an error does not stop the others.
+    MocoStudyBatch::Job missingGoal;
+    missingGoal.name = "missing_goal";
+    missingGoal.goalWeights.emplace_back("nonexistent", 1.0);
+    batch.addJob(missingGoal);
+
+    batch.setNumThreads(2);
+    batch.setResultsDirectory("testMocoStudyBatch_results");
+    const auto results = batch.solve();
+    MocoStudyBatch::printResults(results);
+    REQUIRE(results.size() == 5);
+
+    for (int i = 0; i < (int)weights.size(); ++i) {
+        CHECK(results[i].name == batch.getJob(i).name);
+        CHECK(results[i].success);
+        CHECK(results[i].objective ==
+                Approx(weights[i] * reference.getObjective()).epsilon(1e-4));
+        // The optimal trajectory does not depend on the weight.
+        MocoTrajectory trajectory(results[i].solutionFile);
+        CHECK(trajectory.compareContinuousVariablesRMS(reference) < 1e-4);
+    }
+    CHECK(results[3].success);
+    CHECK(results[3].objective ==
+            Approx(4.0 * reference.getObjective()).epsilon(1e-4));
+    CHECK(!results[4].success);
+    CHECK(results[4].solutionFile.empty());
+    CHECK(results[4].errorMessage.find("nonexistent") != std::string::npos);
+
+    MocoStudyBatch duplicate(study);
+    MocoStudyBatch::Job job;
+    job.name = "same";
+    duplicate.addJob(job);
+    duplicate.addJob(job);
+    CHECK_THROWS_AS(duplicate.solve(), Exception);
+}
@@ -16,6 +16,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Actuators/ModelOperators.h>
 #include <OpenSim/Moco/osimMoco.h>
 
@@ -44,6 +45,50 @@ TEST_CASE("MocoTrack interface") {
     }
 }
 
+TEST_CASE("MocoTrack guess cache", "[casadi]") {
+    // Two similar "trials" of a sliding mass.
+    auto createTrack = [](double amplitude, double duration) {
+        TimeSeriesTable states;
+        states.setColumnLabels({"/jointset/slider/position/value"});
+        const int numRows = 51;
+        for (int i = 0; i < numRows; ++i) {
+            const double time = duration * i / (numRows - 1);
+            states.appendRow(time,
+                    SimTK::RowVector(1, amplitude * std::sin(SimTK::Pi *
+                                                             time / duration)));
+        }
+        MocoTrack track;
+        track.setModel(ModelProcessor(ModelFactory::createSlidingPointMass()));
+        track.setStatesReference(TableProcessor(states));
+        track.set_mesh_interval(0.05);
+        return track;
+    };
+
+    MocoTrack first = createTrack(0.5, 1.0);
+    first.set_guess_cache("testMocoTrack_guess_cache");
+    MocoSolution firstSolution = first.solve();
+    REQUIRE(firstSolution.success());
+
+    MocoTrack uncached = createTrack(0.55, 1.1);
+    MocoSolution uncachedSolution = uncached.solve();
+
+    MocoTrack cached = createTrack(0.55, 1.1);
+    cached.set_guess_cache("testMocoTrack_guess_cache");
+    MocoStudy study = cached.initialize();
+    const auto& guess = study.updSolver<MocoCasADiSolver>().getGuess();
+    // The guess is the first solution, stretched to the new time range.
+    CHECK(guess.getFinalTime() == Approx(1.1));
+    CHECK(guess.getState("/jointset/slider/position/value")[guess.getNumTimes()
+            / 2] == Approx(0.5).epsilon(0.05));
+
+    MocoSolution cachedSolution = cached.solve();
+    REQUIRE(cachedSolution.success());
+    CHECK(cachedSolution.getNumIterations() <
+            uncachedSolution.getNumIterations());
+    CHECK(cachedSolution.getObjective() ==
+            Approx(uncachedSolution.getObjective()).epsilon(1e-3));
+}
+
 TEST_CASE("MocoTrack gait10dof18musc", "[casadi]") {
 
     MocoTrack track;
@@ -49,9 +49,12 @@
 #include "MocoProblem.h"
 #include "MocoSolver.h"
 #include "MocoStudy.h"
+#include "MocoStudyBatch.h"
 #include "MocoStudyFactory.h"
 #include "MocoTrack.h"
+#include "MocoResamplingPlan.h"
 #include "MocoTrajectory.h"
+#include "MocoMappedTrajectory.h"
 #include "MocoTropterSolver.h"
 #include "MocoUtilities.h"
 #include "MocoWeightSet.h"
@@ -466,7 +466,8 @@ protected:
             SimTK::Vector mocoParams(
                     (int)parameters.size(), parameters.data(), true);
 
-            m_mocoProbRep.applyParametersToModelProperties(mocoParams, true);
+            m_mocoProbRep.applyParametersToModelProperties(mocoParams,
+                    m_mocoProbRep.getParametersRequireInitSystem());
         }
     }
 
@@ -24,7 +24,9 @@
 #include "AssemblySolver.h"
 #include "OpenSim/Simulation/Model/Model.h"
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include "simbody/internal/AssemblyCondition_QValue.h"
+#include <algorithm>
 
 using namespace std;
 using namespace SimTK;
@@ -191,6 +193,7 @@ void AssemblySolver::assemble(SimTK::State &state)
     
     // Make sure goals are up-to-date.
     setupGoals(s);
+    resetTrackingStatistics();
 
     // Let assembler perform some internal setup
     _assembler->initialize(s);
@@ -267,10 +270,19 @@ void AssemblySolver::track(SimTK::State &s)
 
     try{
         // Now do the assembly and return the updated state.
+        Stopwatch watch;
         _assembler->track(s.getTime());
 
         // update the state from the result of the assembler 
         _assembler->updateFromInternalState(s);
+
+        const double elapsed = watch.getElapsedTime();
+        _trackingTimes.push_back(elapsed);
+        if (elapsed > _trackingTimeBudget) {
+            log_debug("AssemblySolver::track() at t= {} took {} s, which "
+                      "exceeds the time budget of {} s.",
+                    s.getTime(), elapsed, _trackingTimeBudget);
+        }
         
         // TODO: Useful to include through debug message/log in the future
         log_debug("Tracking: t= {} (acc={} tol={} normerr={}, maxerr={}, cost={})", 
@@ -286,6 +298,32 @@ void AssemblySolver::track(SimTK::State &s)
     }
 }
 
+AssemblySolver::TrackingStatistics
+AssemblySolver::getTrackingStatistics() const
+{
+    TrackingStatistics stats;
+    stats.numFrames = (int)_trackingTimes.size();
+    if (_trackingTimes.empty()) return stats;
+
+    std::vector<double> sorted(_trackingTimes);
+    std::sort(sorted.begin(), sorted.end());
+    // Nearest-rank percentile.
+    const auto percentile = [&sorted](double p) {
+        const int rank = (int)std::ceil(p * sorted.size());
+        return sorted[std::max(rank, 1) - 1];
+    };
+    double sum = 0;
+    for (double time : sorted) {
+        sum += time;
+        if (time > _trackingTimeBudget) ++stats.numOverBudget;
+    }
+    stats.meanTime = sum / sorted.size();
+    stats.medianTime = percentile(0.5);
+    stats.p99Time = percentile(0.99);
+    stats.maxTime = sorted.back();
+    return stats;
+}
+
 const SimTK::Assembler& AssemblySolver::getAssembler() const
 {
     OPENSIM_THROW_IF(!_assembler, Exception,
@@ -26,6 +26,7 @@
 #include "Solver.h"
 #include "OpenSim/Simulation/CoordinateReference.h"
 #include "simbody/internal/Assembler.h"
+#include <vector>
 
 namespace SimTK { 
 class QValue;
@@ -118,6 +119,39 @@ public:
     /** Read access to the underlying SimTK::Assembler. */
     const SimTK::Assembler& getAssembler() const;
 
+#ifndef SWIG
+    /** Wall-clock solve times of the track() calls since the last assemble()
+        (or resetTrackingStatistics()), in seconds. Use these to verify that
+        tracking keeps up with streamed data (e.g., 200 Hz). */
+    struct TrackingStatistics {
+        /// Number of track() calls.
+        int numFrames = 0;
+        /// Number of track() calls that took longer than the time budget.
+        int numOverBudget = 0;
+        double meanTime = SimTK::NaN;
+        /// Median (50th percentile) solve time.
+        double medianTime = SimTK::NaN;
+        /// 99th percentile solve time.
+        double p99Time = SimTK::NaN;
+        double maxTime = SimTK::NaN;
+    };
+#endif
+
+    /** %Set the wall-clock time, in seconds, that a single track() call
+        should not exceed (default: Infinity). track() is not interrupted; a
+        call that exceeds the budget is counted in
+        TrackingStatistics::numOverBudget and logged at the debug level. */
+    void setTrackingTimeBudget(double seconds) { _trackingTimeBudget = seconds; }
+    double getTrackingTimeBudget() const { return _trackingTimeBudget; }
+
+#ifndef SWIG
+    /** Compute the statistics of the track() solve times recorded since the
+        last assemble() or resetTrackingStatistics(). */
+    TrackingStatistics getTrackingStatistics() const;
+#endif
+    /** Forget the recorded track() solve times. */
+    void resetTrackingStatistics() { _trackingTimes.clear(); }
+
 protected:
     /** Internal method to convert the CoordinateReferences into goals of the 
         assembly solver. Subclasses, can add and override to include other goals  
@@ -147,6 +181,10 @@ private:
     SimTK::ResetOnCopy< std::unique_ptr<SimTK::Assembler>> _assembler;
 
     SimTK::Array_<SimTK::QValue*> _coordinateAssemblyConditions;
+
+    // Time budget and recorded wall-clock times (seconds) of track() calls.
+    double _trackingTimeBudget = SimTK::Infinity;
+    std::vector<double> _trackingTimes;
 //=============================================================================
 };  // END of class AssemblySolver
 //=============================================================================
@@ -41,34 +41,22 @@ void BufferedOrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
     auto& times = _orientationData.getIndependentColumn();
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
 
     if (time >= times.front() && time <= times.back()) {
-        nextRow = _orientationData.getRow(time);
+        OrientationsReference::getValuesAtTime(time, values);
     } else {
-        _orientationDataQueue.pop_front(time, nextRow);
-    }
-    int n = nextRow.size();
-    values.resize(n);
-
-    for (int i = 0; i < n; ++i) { 
-        values[i] = nextRow[i];
+        _orientationDataQueue.pop(time, values);
     }
 }
 
 void BufferedOrientationsReference::getNextValuesAndTime(
         double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) {
 
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(time, nextRow);
-    int n = nextRow.size();
-    values.resize(n);
-
-    for (int i = 0; i < n; ++i) { values[i] = nextRow[i]; }
+    _orientationDataQueue.pop(time, values);
 }
 
 void BufferedOrientationsReference::putValues(
         double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow) {
-    _orientationDataQueue.push_back(time, dataRow);
+    _orientationDataQueue.push(time, dataRow);
 }
 } // end of namespace OpenSim
\ No newline at end of file
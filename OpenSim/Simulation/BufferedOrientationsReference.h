@@ -37,6 +37,12 @@ namespace OpenSim {
  * draw data from for solving.
  * Ideally this would be templatized, allowing for all Reference classes to leverage it.
  *
+ * The queued rows are kept in a preallocated DataRingBuffer_, so one thread
+ * (e.g., the one receiving the sensor data) can call putValues() while another
+ * thread solves without allocating memory or taking locks. By default, the
+ * buffer holds 1024 rows and putValues() waits for the solver to consume a
+ * row when the buffer is full; see setBufferCapacity().
+ *
  * @author Ayman Habib
  */
 
@@ -89,9 +95,30 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+#ifndef SWIG
+    typedef DataRingBuffer_<SimTK::Rotation>::OverflowPolicy OverflowPolicy;
+    /** Set the maximum number of rows that can be queued with putValues()
+    and what putValues() does when that many rows are queued. This discards
+    any queued rows, so it must not be called while another thread calls
+    putValues(). */
+    void setBufferCapacity(int capacity,
+            OverflowPolicy policy = OverflowPolicy::Wait) {
+        _orientationDataQueue =
+                DataRingBuffer_<SimTK::Rotation>(capacity, 0, policy);
+    }
+    /** The number of rows discarded by putValues() because the buffer was
+    full (only with OverflowPolicy::DropNewest). */
+    int getNumDroppedValues() const {
+        return _orientationDataQueue.getNumDropped();
+    }
+#endif
 private:
+#ifndef SWIG
     // Use a specialized data structure for holding the orientation data
-    mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    mutable DataRingBuffer_<SimTK::Rotation> _orientationDataQueue{
+            1024, 0, OverflowPolicy::Wait};
+#endif
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
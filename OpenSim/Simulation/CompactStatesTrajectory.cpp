@@ -0,0 +1,298 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompactStatesTrajectory.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompactStatesTrajectory.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+double CompactStatesTrajectory::getTime(size_t index) const {
+    checkIndex(index);
+    return m_times[index];
+}
+
+SimTK::VectorView CompactStatesTrajectory::getY(size_t index) const {
+    checkIndex(index);
+    return m_data.col((int)index)(0, m_numY);
+}
+
+const SimTK::State& CompactStatesTrajectory::getTemplateState() const {
+    OPENSIM_THROW_IF(!m_templateState, Exception,
+            "The trajectory is empty, so it has no template state.");
+    return *m_templateState;
+}
+
+SimTK::State CompactStatesTrajectory::getState(size_t index) const {
+    SimTK::State state;
+    copyToState(index, state);
+    return state;
+}
+
+void CompactStatesTrajectory::copyToState(
+        size_t index, SimTK::State& state) const {
+    checkIndex(index);
+    if (!isConsistentWithTemplate(state)) state = *m_templateState;
+
+    const auto column = m_data.col((int)index);
+    state.setTime(m_times[index]);
+    state.updY() = column(0, m_numY);
+    // Only update the discrete variables whose values differ, since updating
+    // a discrete variable invalidates the stages that depend on it.
+    for (const auto& entry : m_discreteEntries) {
+        const SimTK::AbstractValue& value =
+                state.getDiscreteVariable(entry.subsystem, entry.index);
+        switch (entry.type) {
+        case DiscreteType::Double: {
+            const double stored = column[entry.offset];
+            if (SimTK::Value<double>::downcast(value).get() != stored) {
+                SimTK::Value<double>::updDowncast(state.updDiscreteVariable(
+                        entry.subsystem, entry.index)) = stored;
+            }
+            break;
+        }
+        case DiscreteType::Int: {
+            const int stored = (int)column[entry.offset];
+            if (SimTK::Value<int>::downcast(value).get() != stored) {
+                SimTK::Value<int>::updDowncast(state.updDiscreteVariable(
+                        entry.subsystem, entry.index)) = stored;
+            }
+            break;
+        }
+        case DiscreteType::Bool: {
+            const bool stored = column[entry.offset] != 0;
+            if (SimTK::Value<bool>::downcast(value).get() != stored) {
+                SimTK::Value<bool>::updDowncast(state.updDiscreteVariable(
+                        entry.subsystem, entry.index)) = stored;
+            }
+            break;
+        }
+        case DiscreteType::Vector: {
+            const auto stored = column(entry.offset, entry.size);
+            const auto& current = SimTK::Value<SimTK::Vector>::downcast(
+                    value).get();
+            bool differs = false;
+            for (int i = 0; i < entry.size && !differs; ++i) {
+                differs = current[i] != stored[i];
+            }
+            if (differs) {
+                SimTK::Value<SimTK::Vector>::updDowncast(
+                        state.updDiscreteVariable(entry.subsystem,
+                                entry.index)).upd() = stored;
+            }
+            break;
+        }
+        }
+    }
+}
+
+void CompactStatesTrajectory::clear() {
+    m_templateState.reset();
+    m_discreteEntries.clear();
+    m_numY = 0;
+    m_numStoredValues = 0;
+    m_times.clear();
+    m_data.clear();
+}
+
+void CompactStatesTrajectory::reserve(size_t size) {
+    m_times.reserve(size);
+    if (m_templateState && (int)size > m_data.ncol()) {
+        m_data.resizeKeep(m_numStoredValues, (int)size);
+    }
+}
+
+void CompactStatesTrajectory::append(const SimTK::State& state) {
+    if (!m_templateState) {
+        setTemplateState(state);
+    } else {
+        SimTK_APIARGCHECK2_ALWAYS(m_times.back() <= state.getTime(),
+                "CompactStatesTrajectory", "append",
+                "New state's time (%f) must be equal to or greater than the "
+                "time for the last state in the trajectory (%f).",
+                state.getTime(), m_times.back());
+        OPENSIM_THROW_IF(!isConsistentWithTemplate(state),
+                StatesTrajectory::InconsistentState, state.getTime());
+    }
+
+    const int icol = (int)m_times.size();
+    if (icol == m_data.ncol()) {
+        m_data.resizeKeep(m_numStoredValues, std::max(16, 2 * icol));
+    }
+    auto column = m_data.updCol(icol);
+    column(0, m_numY) = state.getY();
+    for (const auto& entry : m_discreteEntries) {
+        const SimTK::AbstractValue& value =
+                state.getDiscreteVariable(entry.subsystem, entry.index);
+        switch (entry.type) {
+        case DiscreteType::Double:
+            column[entry.offset] = SimTK::Value<double>::downcast(value).get();
+            break;
+        case DiscreteType::Int:
+            column[entry.offset] = SimTK::Value<int>::downcast(value).get();
+            break;
+        case DiscreteType::Bool:
+            column[entry.offset] = SimTK::Value<bool>::downcast(value).get();
+            break;
+        case DiscreteType::Vector: {
+            const auto& vec = SimTK::Value<SimTK::Vector>::downcast(value).get();
+            OPENSIM_THROW_IF(vec.size() != entry.size,
+                    StatesTrajectory::InconsistentState, state.getTime());
+            column(entry.offset, entry.size) = vec;
+            break;
+        }
+        }
+    }
+    m_times.push_back(state.getTime());
+}
+
+void CompactStatesTrajectory::setTemplateState(const SimTK::State& state) {
+    OPENSIM_THROW_IF(state.getSystemStage() < SimTK::Stage::Model, Exception,
+            "Expected the state to be realized to at least Stage::Model.");
+    m_templateState = std::make_shared<const SimTK::State>(state);
+    m_numY = state.getNY();
+    m_discreteEntries.clear();
+    int offset = m_numY;
+    for (SimTK::SubsystemIndex sx(0); sx < state.getNumSubsystems(); ++sx) {
+        for (SimTK::DiscreteVariableIndex dx(0);
+                dx < state.getNumDiscreteVariables(sx); ++dx) {
+            const SimTK::AbstractValue& value =
+                    state.getDiscreteVariable(sx, dx);
+            DiscreteEntry entry{sx, dx, DiscreteType::Double, offset, 1};
+            if (SimTK::Value<double>::isA(value)) {
+                entry.type = DiscreteType::Double;
+            } else if (SimTK::Value<int>::isA(value)) {
+                entry.type = DiscreteType::Int;
+            } else if (SimTK::Value<bool>::isA(value)) {
+                entry.type = DiscreteType::Bool;
+            } else if (SimTK::Value<SimTK::Vector>::isA(value)) {
+                entry.type = DiscreteType::Vector;
+                entry.size =
+                        SimTK::Value<SimTK::Vector>::downcast(value).get().size();
+            } else {
+                // Other types keep the value from the template state.
+                continue;
+            }
+            m_discreteEntries.push_back(entry);
+            offset += entry.size;
+        }
+    }
+    m_numStoredValues = offset;
+    m_data.resize(m_numStoredValues, (int)m_times.capacity());
+}
+
+bool CompactStatesTrajectory::isConsistentWithTemplate(
+        const SimTK::State& state) const {
+    if (!m_templateState) return false;
+    if (state.getNumSubsystems() != m_templateState->getNumSubsystems() ||
+            state.getSystemStage() < SimTK::Stage::Model) {
+        return false;
+    }
+    // Check the discrete variables before their values are accessed.
+    for (SimTK::SubsystemIndex sx(0); sx < state.getNumSubsystems(); ++sx) {
+        if (state.getNumDiscreteVariables(sx) !=
+                m_templateState->getNumDiscreteVariables(sx)) {
+            return false;
+        }
+    }
+    for (const auto& entry : m_discreteEntries) {
+        const SimTK::AbstractValue& value =
+                state.getDiscreteVariable(entry.subsystem, entry.index);
+        const SimTK::AbstractValue& templateValue =
+                m_templateState->getDiscreteVariable(
+                        entry.subsystem, entry.index);
+        if (typeid(value) != typeid(templateValue)) return false;
+    }
+    return m_templateState->isConsistent(state);
+}
+
+void CompactStatesTrajectory::checkIndex(size_t index) const {
+    OPENSIM_THROW_IF(index >= m_times.size(), IndexOutOfRange, index, 0,
+            static_cast<unsigned>(m_times.size() - 1));
+}
+
+StatesTrajectory CompactStatesTrajectory::exportToStatesTrajectory() const {
+    StatesTrajectory states;
+    states.m_states.reserve(getSize());
+    SimTK::State state;
+    for (size_t itime = 0; itime < getSize(); ++itime) {
+        copyToState(itime, state);
+        states.append(state);
+    }
+    return states;
+}
+
+TimeSeriesTable CompactStatesTrajectory::exportToTable(const Model& model,
+        const std::vector<std::string>& requestedStateVars) const {
+
+    // We only check the number of speeds; see
+    // StatesTrajectory::isCompatibleWith().
+    OPENSIM_THROW_IF(m_templateState &&
+                    model.getNumSpeeds() != m_templateState->getNU(),
+            StatesTrajectory::IncompatibleModel, model);
+
+    std::vector<std::string> stateVars = requestedStateVars;
+    if (stateVars.empty()) {
+        const auto names = model.getStateVariableNames();
+        for (int i = 0; i < names.getSize(); ++i) {
+            stateVars.push_back(names[i]);
+        }
+    }
+    const auto systemIndices = model.getStateVariableSystemIndices(stateVars);
+
+    const int numRows = (int)getSize();
+    const int numColumns = (int)stateVars.size();
+    SimTK::Matrix data(numRows, numColumns);
+    for (int irow = 0; irow < numRows; ++irow) {
+        const auto column = m_data.col(irow);
+        for (int icol = 0; icol < numColumns; ++icol) {
+            data(irow, icol) = column[systemIndices[icol]];
+        }
+    }
+    return TimeSeriesTable(m_times, data, stateVars);
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+    CompactStatesTrajectory states;
+    states.reserve(table.getNumRows());
+    StatesTrajectory::forEachStateInStatesTable(model, table,
+            allowMissingColumns, allowExtraColumns, assemble,
+            [&states](const SimTK::State& state) { states.append(state); });
+    return states;
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromStatesTrajectory(
+        const StatesTrajectory& statesTraj) {
+    CompactStatesTrajectory states;
+    states.reserve(statesTraj.getSize());
+    for (const auto& state : statesTraj) {
+        states.append(state);
+    }
+    return states;
+}
@@ -0,0 +1,150 @@
+#ifndef OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+#define OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  CompactStatesTrajectory.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StatesTrajectory.h"
+
+#include <SimTKcommon/internal/State.h>
+
+#include <memory>
+
+namespace OpenSim {
+
+/** A sequence of states that, unlike StatesTrajectory, does not store a full
+SimTK::State (with its cache) for each time point. Each time point is stored
+as one column of a single matrix, containing the time, the continuous state
+variables (Y) and the values of the discrete variables. A SimTK::State for a
+time point is created on access by copying a template state (the first state
+appended to the trajectory) and then setting the stored values. For long
+trajectories of large models, this uses a small fraction of the memory of a
+StatesTrajectory.
+
+Discrete variables whose values are of type double, int, bool or
+SimTK::Vector are stored for each time point. Discrete variables of other
+types keep the value they have in the template state.
+
+@code
+CompactStatesTrajectory states =
+        CompactStatesTrajectory::createFromStatesTable(model, table);
+SimTK::State state;
+for (size_t i = 0; i < states.getSize(); ++i) {
+    states.copyToState(i, state); // Reuses the memory of `state`.
+    model.realizeDynamics(state);
+}
+@endcode
+
+As with StatesTrajectory, the states are nondecreasing in time and
+consistent with each other. */
+class OSIMSIMULATION_API CompactStatesTrajectory {
+public:
+    /** Create an empty trajectory; the first state appended is used as the
+    template state. */
+    CompactStatesTrajectory() = default;
+
+    /** The number of time points in the trajectory. */
+    size_t getSize() const { return m_times.size(); }
+
+    /// @name Accessing the time points
+    /// @{
+    /** The time of the state at the given index. */
+    double getTime(size_t index) const;
+    /** The continuous state variables (SimTK::State::getY()) of the state at
+    the given index. This does not create a SimTK::State. */
+    SimTK::VectorView getY(size_t index) const;
+    /** Create the SimTK::State at the given index. */
+    SimTK::State getState(size_t index) const;
+    /** Set `state` to the state at the given index. If `state` is already
+    consistent with this trajectory (e.g., it was set by a previous call to
+    this function), only the stored values are copied into it. Otherwise,
+    `state` is first set to a copy of the template state. */
+    void copyToState(size_t index, SimTK::State& state) const;
+    /** The state that is copied to create each state of the trajectory. This
+    throws an exception if the trajectory is empty. */
+    const SimTK::State& getTemplateState() const;
+    /// @}
+
+    /// @name Modify the contents of the trajectory
+    /// @{
+    /** Remove all states, including the template state. */
+    void clear();
+    /** Reserve memory for the given number of time points. */
+    void reserve(size_t size);
+    /** Append a SimTK::State to this trajectory. Only the time, Y and the
+    values of the discrete variables are stored. The first state appended
+    becomes the template state.
+    @throws StatesTrajectory::InconsistentState if the state is not
+        consistent with the template state.*/
+    void append(const SimTK::State& state);
+    /// @}
+
+    /** Create a StatesTrajectory that contains a full SimTK::State for each
+    time point. */
+    StatesTrajectory exportToStatesTrajectory() const;
+
+    /** Same as StatesTrajectory::exportToTable(). The values are read from
+    the stored Y vectors without creating SimTK::State%s. */
+    TimeSeriesTable exportToTable(const Model& model,
+            const std::vector<std::string>& stateVars = {}) const;
+
+    /** Same as StatesTrajectory::createFromStatesTable(), but without storing
+    a full SimTK::State for each row of the table. */
+    static CompactStatesTrajectory createFromStatesTable(const Model& model,
+            const TimeSeriesTable& table,
+            bool allowMissingColumns = false,
+            bool allowExtraColumns = false,
+            bool assemble = false);
+
+    /** Store the states of an existing StatesTrajectory. */
+    static CompactStatesTrajectory createFromStatesTrajectory(
+            const StatesTrajectory& states);
+
+private:
+    enum class DiscreteType { Double, Int, Bool, Vector };
+    // Where a discrete variable is stored in each column of m_data.
+    struct DiscreteEntry {
+        SimTK::SubsystemIndex subsystem;
+        SimTK::DiscreteVariableIndex index;
+        DiscreteType type;
+        int offset;
+        int size;
+    };
+
+    void setTemplateState(const SimTK::State& state);
+    bool isConsistentWithTemplate(const SimTK::State& state) const;
+    void checkIndex(size_t index) const;
+
+    // Shared by copies of the trajectory.
+    std::shared_ptr<const SimTK::State> m_templateState;
+    std::vector<DiscreteEntry> m_discreteEntries;
+    int m_numY = 0;
+    // The number of rows of m_data: NY plus the sizes of the discrete entries.
+    int m_numStoredValues = 0;
+    std::vector<double> m_times;
+    // One column per time point. The number of columns is the capacity of the
+    // trajectory, which grows geometrically.
+    SimTK::Matrix m_data;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPACT_STATES_TRAJECTORY_H_
@@ -176,8 +176,8 @@ void ControlSetController::computeControls(const SimTK::State& s, SimTK::Vector&
         }
 
         if(index >= 0){
-            SimTK::Vector actControls(1, _controlSet->get(index).getControlValue(s.getTime()));
-            getActuatorSet()[i].addInControls(actControls, controls);
+            controls[getActuatorControlIndices()[i]] +=
+                    _controlSet->get(index).getControlValue(s.getTime());
         }
     }
 }
@@ -127,6 +127,7 @@ void Controller::extendConnectToModel(Model& model)
     // make sure controller does not take ownership
     _actuatorSet.setMemoryOwner(false);
     _actuatorSet.setSize(0);
+    _actuatorControlIndices.clear();
 
     int nac = getProperty_actuator_list().size();
     if (nac == 0)
@@ -166,6 +167,31 @@ void Controller::extendAddToSystem(SimTK::MultibodySystem& system) const
     Super::extendAddToSystem(system);
 }
 
+void Controller::extendRealizeTopology(SimTK::State& state) const
+{
+    Super::extendRealizeTopology(state);
+
+    // All actuators have claimed their slots in the model controls by now.
+    resolveActuatorControlIndices();
+}
+
+void Controller::resolveActuatorControlIndices() const
+{
+    _actuatorControlIndices.resize(_actuatorSet.getSize());
+    for (int i = 0; i < _actuatorSet.getSize(); ++i) {
+        _actuatorControlIndices[i] = _actuatorSet[i].getControlIndex();
+    }
+}
+
+const std::vector<int>& Controller::getActuatorControlIndices() const
+{
+    // The actuators may have been changed since the system was created.
+    if ((int)_actuatorControlIndices.size() != _actuatorSet.getSize()) {
+        resolveActuatorControlIndices();
+    }
+    return _actuatorControlIndices;
+}
+
 // makes a request for which actuators a controller will control
 void Controller::setActuators(const Set<Actuator>& actuators)
 {
@@ -175,6 +201,7 @@ void Controller::setActuators(const Set<Actuator>& actuators)
     _actuatorSet.setMemoryOwner(false);
     //Rebuild consistent set of actuator lists
     _actuatorSet.setSize(0);
+    _actuatorControlIndices.clear();
     updProperty_actuator_list().clear();
     for (int i = 0; i< actuators.getSize(); i++){
         addActuator(actuators[i]);
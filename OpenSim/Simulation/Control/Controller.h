@@ -130,6 +130,22 @@ protected:
         measures, etc... required by the controller. */
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
+    /** Resolves the indices returned by getActuatorControlIndices(). Subclasses
+        that override this method must call Super::extendRealizeTopology(). */
+    void extendRealizeTopology(SimTK::State& state) const override;
+
+    /** The index in the model controls of the first control of each actuator
+        in getActuatorSet() (see Actuator::getControlIndex()), resolved once
+        when the system is created. computeControls() can use these to write
+        into the model controls directly, without creating a Vector for each
+        actuator and calling Actuator::addInControls():
+        @code
+        const auto& indices = getActuatorControlIndices();
+        for (int i = 0; i < getActuatorSet().getSize(); ++i)
+            controls[indices[i]] += computeExcitation(s, i);
+        @endcode */
+    const std::vector<int>& getActuatorControlIndices() const;
+
     /** Only a Controller can set its number of controls based on its actuators */
     void setNumControls(int numControls) {_numControls = numControls; }
 
@@ -143,6 +159,10 @@ private:
     // the (sub)set of Model actuators that this controller controls */ 
     Set<const Actuator> _actuatorSet;
 
+    // index of the first control of each actuator in the model controls
+    mutable std::vector<int> _actuatorControlIndices;
+    void resolveActuatorControlIndices() const;
+
     // construct and initialize properties
     void constructProperties();
 
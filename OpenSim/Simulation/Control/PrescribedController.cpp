@@ -161,15 +161,27 @@ void PrescribedController::extendConnectToModel(Model& model)
 }
 
 
+void PrescribedController::extendAddToSystem(
+        SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    _intervalsCV = addCacheVariable("function_intervals",
+            std::vector<int>(get_ControlFunctions().getSize(), 0),
+            SimTK::Stage::Time);
+}
+
 // compute the control value for an actuator
 void PrescribedController::computeControls(const SimTK::State& s, SimTK::Vector& controls) const
 {
-    SimTK::Vector actControls(1, 0.0);
-    SimTK::Vector time(1, s.getTime());
-
-    for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = get_ControlFunctions()[i].calcValue(time);
-        getActuatorSet()[i].addInControls(actControls, controls);
+    const double time = s.getTime();
+    std::vector<int>& intervals = updCacheVariableValue(s, _intervalsCV);
+    const int n = getActuatorSet().getSize();
+    if ((int)intervals.size() < n) intervals.resize(n, 0);
+
+    const std::vector<int>& controlIndices = getActuatorControlIndices();
+    for(int i=0; i<n; i++){
+        controls[controlIndices[i]] +=
+                get_ControlFunctions()[i].calcValueAt(time, &intervals[i]);
     }  
 }
 
@@ -119,6 +119,7 @@ public:
 protected:
     /** Model component interface */
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 private:
     // construct and initialize properties
     void constructProperties();
@@ -130,6 +131,12 @@ private:
     // This method sets all member variables to default (e.g., NULL) values.
     void setNull();
 
+    // The knot interval that contained the previous time, for each control
+    // function. This is kept in the State so that evaluating controls in
+    // different States is thread-safe; it is only a search hint, so it is
+    // never marked valid.
+    mutable CacheVariable<std::vector<int>> _intervalsCV;
+
 //=============================================================================
 };  // END of class PrescribedController
 
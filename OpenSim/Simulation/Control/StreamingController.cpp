@@ -0,0 +1,216 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  StreamingController.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingController.h"
+#include <OpenSim/Simulation/Model/Actuator.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+using namespace OpenSim;
+
+//=============================================================================
+// CHANNEL
+//=============================================================================
+// A bounded single-producer, single-consumer ring buffer. The producer owns
+// m_head and the consumer owns m_tail; one slot is always left empty to
+// distinguish a full buffer from an empty one. The consumer moves the
+// samples into m_history, which only the consumer accesses.
+class StreamingController::Channel {
+public:
+    struct Sample {
+        double time;
+        SimTK::Vector values;
+    };
+
+    Channel(int bufferSize, int numControls)
+            : m_capacity(bufferSize + 1), m_numControls(numControls),
+              m_maxHistory(bufferSize), m_times(m_capacity),
+              m_values(m_capacity * numControls) {}
+
+    int getNumControls() const { return m_numControls; }
+    int getNumDropped() const { return m_numDropped.load(); }
+
+    bool push(double time, const SimTK::Vector& controls) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t next = (head + 1) % m_capacity;
+        if (next == m_tail.load(std::memory_order_acquire)) {
+            ++m_numDropped;
+            return false;
+        }
+        m_times[head] = time;
+        for (int i = 0; i < m_numControls; ++i) {
+            m_values[head * m_numControls + i] = controls[i];
+        }
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    const std::deque<Sample>& consume() {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        while (tail != head) {
+            Sample sample{m_times[tail], SimTK::Vector(m_numControls)};
+            for (int i = 0; i < m_numControls; ++i) {
+                sample.values[i] = m_values[tail * m_numControls + i];
+            }
+            m_latest = sample.values;
+            // Keep the history sorted by time.
+            auto pos = std::upper_bound(m_history.begin(), m_history.end(),
+                    sample.time, [](double t, const Sample& other) {
+                        return t < other.time;
+                    });
+            m_history.insert(pos, std::move(sample));
+            if ((int)m_history.size() > m_maxHistory) m_history.pop_front();
+            tail = (tail + 1) % m_capacity;
+        }
+        m_tail.store(tail, std::memory_order_release);
+        return m_history;
+    }
+
+    const SimTK::Vector& getLatest() const { return m_latest; }
+
+    void clear() {
+        m_tail.store(m_head.load());
+        m_history.clear();
+        m_latest.clear();
+    }
+
+private:
+    const std::size_t m_capacity;
+    const int m_numControls;
+    const int m_maxHistory;
+    std::vector<double> m_times;
+    std::vector<double> m_values;
+    std::atomic<std::size_t> m_head{0};
+    std::atomic<std::size_t> m_tail{0};
+    std::atomic<int> m_numDropped{0};
+    std::deque<Sample> m_history;
+    SimTK::Vector m_latest;
+};
+
+//=============================================================================
+// CONSTRUCTOR(S)
+//=============================================================================
+StreamingController::StreamingController() : Controller() {
+    constructProperties();
+}
+
+void StreamingController::constructProperties() {
+    constructProperty_interpolation("hold");
+    constructProperty_buffer_size(1024);
+}
+
+//=============================================================================
+// COMPONENT INTERFACE
+//=============================================================================
+void StreamingController::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    const std::string& interp = get_interpolation();
+    OPENSIM_THROW_IF_FRMOBJ(
+            interp != "hold" && interp != "linear" && interp != "latest",
+            InvalidPropertyValue, getProperty_interpolation().getName(),
+            fmt::format("Expected 'hold', 'linear', or 'latest', but got "
+                        "'{}'.", interp));
+    OPENSIM_THROW_IF_FRMOBJ(get_buffer_size() < 1, InvalidPropertyValue,
+            getProperty_buffer_size().getName(),
+            fmt::format("Expected a positive buffer size, but got {}.",
+                    get_buffer_size()));
+}
+
+void StreamingController::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+    int numControls = 0;
+    const auto& actuators = getActuatorSet();
+    for (int i = 0; i < actuators.getSize(); ++i) {
+        numControls += actuators[i].numControls();
+    }
+    _channel = std::make_shared<Channel>(get_buffer_size(), numControls);
+}
+
+//=============================================================================
+// CONTROL
+//=============================================================================
+bool StreamingController::pushControls(
+        double time, const SimTK::Vector& controls) const {
+    OPENSIM_THROW_IF_FRMOBJ(!_channel.get(), Exception,
+            "Controls cannot be pushed before the controller is connected to "
+            "a model (e.g., by Model::initSystem()).");
+    OPENSIM_THROW_IF_FRMOBJ(controls.size() != _channel->getNumControls(),
+            Exception, "Expected {} controls, but got {}.",
+            _channel->getNumControls(), controls.size());
+    return _channel->push(time, controls);
+}
+
+int StreamingController::getNumDroppedSamples() const {
+    return _channel.get() ? _channel->getNumDropped() : 0;
+}
+
+void StreamingController::clearSamples() const {
+    if (_channel.get()) _channel->clear();
+}
+
+void StreamingController::computeControls(
+        const SimTK::State& s, SimTK::Vector& controls) const {
+    if (!_channel.get()) return;
+    const auto& history = _channel->consume();
+    if (history.empty()) return;
+
+    SimTK::Vector values;
+    const std::string& interp = get_interpolation();
+    if (interp == "latest") {
+        values = _channel->getLatest();
+    } else {
+        const double time = s.getTime();
+        // The first sample whose time is after the current time.
+        auto next = std::upper_bound(history.begin(), history.end(), time,
+                [](double t, const Channel::Sample& sample) {
+                    return t < sample.time;
+                });
+        if (next == history.begin()) {
+            values = next->values;
+        } else if (next == history.end()) {
+            values = history.back().values;
+        } else {
+            const auto& prev = *(next - 1);
+            if (interp == "linear" && next->time > prev.time) {
+                const double w =
+                        (time - prev.time) / (next->time - prev.time);
+                values = (1 - w) * prev.values + w * next->values;
+            } else {
+                values = prev.values;
+            }
+        }
+    }
+
+    int offset = 0;
+    const auto& actuators = getActuatorSet();
+    const std::vector<int>& controlIndices = getActuatorControlIndices();
+    for (int i = 0; i < actuators.getSize(); ++i) {
+        const int nc = actuators[i].numControls();
+        controls(controlIndices[i], nc) += values(offset, nc);
+        offset += nc;
+    }
+}
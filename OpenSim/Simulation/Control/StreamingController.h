@@ -0,0 +1,130 @@
+#ifndef OPENSIM_STREAMING_CONTROLLER_H_
+#define OPENSIM_STREAMING_CONTROLLER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  StreamingController.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Controller.h"
+#include <memory>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * StreamingController is a concrete Controller whose controls are streamed in
+ * from another thread (e.g., from hardware in the loop) while the model is
+ * being simulated. The producing thread calls pushControls() with a
+ * timestamped vector of controls; the samples are passed to the integrating
+ * thread through a lock-free single-producer, single-consumer queue, so the
+ * producer never waits for the simulation (and vice versa).
+ *
+ * The controls at a given time are obtained from the received samples
+ * according to the `interpolation` property:
+ * - "hold": the latest sample whose time is not after the current time
+ *   (the earliest sample is used before it);
+ * - "linear": linear interpolation between the samples surrounding the
+ *   current time, holding the first and last samples outside of them;
+ * - "latest": the most recently received sample, ignoring its time.
+ *
+ * Until the first sample is received, the controller adds nothing to the
+ * controls of its actuators. The controls vector has one entry per control
+ * of each of the controller's actuators, in the order of getActuatorSet().
+ *
+ * Samples are dropped (and counted; see getNumDroppedSamples()) if
+ * `buffer_size` samples are waiting to be consumed. The controller keeps at
+ * most `buffer_size` consumed samples for interpolation. The queue is
+ * created when the controller is connected to the model (e.g., by
+ * initSystem()), so samples must be pushed after that.
+ *
+ * @code
+ * auto* controller = new StreamingController();
+ * controller->addActuator(model.getComponent<Actuator>("/forceset/tau"));
+ * model.addController(controller);
+ * SimTK::State state = model.initSystem();
+ * std::thread producer([&]() {
+ *     // ... read the hardware ...
+ *     controller->pushControls(time, SimTK::Vector(1, torque));
+ * });
+ * Manager manager(model);
+ * manager.setRealTimeFactor(1.0);
+ * manager.initialize(state);
+ * manager.integrate(10.0);
+ * @endcode
+ *
+ * Since consumed samples are stored in the controller, a model with a
+ * %StreamingController is not thread-safe (see Component::isThreadSafe()).
+ */
+//=============================================================================
+class OSIMSIMULATION_API StreamingController : public Controller {
+OpenSim_DECLARE_CONCRETE_OBJECT(StreamingController, Controller);
+
+public:
+//=============================================================================
+// PROPERTIES
+//=============================================================================
+    OpenSim_DECLARE_PROPERTY(interpolation, std::string,
+        "How controls are obtained from the streamed samples: 'hold' "
+        "(default), 'linear', or 'latest'.");
+    OpenSim_DECLARE_PROPERTY(buffer_size, int,
+        "The maximum number of samples waiting to be consumed, and the "
+        "number of consumed samples kept for interpolation (default: 1024).");
+
+//=============================================================================
+// METHODS
+//=============================================================================
+    StreamingController();
+
+    /** Send controls for the given time to the controller. This may be
+    called from one thread (the producer) while another thread integrates the
+    model. Samples are normally pushed in order of increasing time. Returns
+    false, dropping the sample, if the queue is full. */
+    bool pushControls(double time, const SimTK::Vector& controls) const;
+
+    /** The number of samples dropped because the queue was full. */
+    int getNumDroppedSamples() const;
+
+    /** Forget all received samples. This must not be called while another
+    thread pushes controls or integrates the model. */
+    void clearSamples() const;
+
+    void computeControls(const SimTK::State& s,
+                         SimTK::Vector& controls) const override;
+
+    /** Consumed samples are stored in the controller. */
+    bool isThreadSafe() const override { return false; }
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+
+private:
+    void constructProperties();
+
+    class Channel;
+    SimTK::ResetOnCopy<std::shared_ptr<Channel>> _channel;
+
+//=============================================================================
+};  // END of class StreamingController
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STREAMING_CONTROLLER_H_
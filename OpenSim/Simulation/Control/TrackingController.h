@@ -89,6 +89,10 @@ public:
     virtual void setDesiredStatesStorage(const Storage* aYDesStore);
     virtual const Storage& getDesiredStatesStorage() const; 
 
+    /** Looking up the desired states updates a search hint in the Storage,
+    so a model with a tracking controller is not shared among threads. */
+    bool isThreadSafe() const override { return false; }
+
     // ON/OFF
 
     //--------------------------------------------------------------------------
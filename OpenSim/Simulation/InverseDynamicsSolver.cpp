@@ -23,7 +23,16 @@
 
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/TableUtilities.h>
+
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 using namespace std;
 using namespace SimTK;
@@ -141,4 +150,139 @@ void InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, const
     }
 }
 
+TimeSeriesTable InverseDynamicsSolver::solve(const SimTK::State& s,
+        const FunctionSet& Qs, const std::vector<double>& times,
+        int numThreads)
+{
+    const int nq = getModel().getNumCoordinates();
+    const int nt = (int)times.size();
+
+    OPENSIM_THROW_IF(Qs.getSize() != nq, Exception,
+            "InverseDynamicsSolver::solve: Expected {} coordinate functions, "
+            "but got {}.", nq, Qs.getSize());
+    OPENSIM_THROW_IF(nq != getModel().getNumSpeeds(), Exception,
+            "InverseDynamicsSolver::solve using FunctionSet, nq != nu not "
+            "supported.");
+
+    auto coords = getModel().getCoordinatesInMultibodyTreeOrder();
+    std::vector<std::string> labels(nq);
+    for (int i = 0; i < nq; ++i) {
+        labels[i] = coords[i]->getName() +
+                (coords[i]->getMotionType() == Coordinate::Rotational ?
+                        "_moment" : "_force");
+    }
+    SimTK::Matrix genForces(nt, nq);
+
+    if (numThreads <= 0) {
+        numThreads = getNumAvailableThreads();
+    }
+    numThreads = std::max(1, std::min(numThreads, nt));
+    if (numThreads > 1) {
+        // The threads share the model.
+        const auto unsafe = getModel().getThreadUnsafeComponents();
+        if (!unsafe.empty()) {
+            log_info("InverseDynamicsSolver: component '{}' is not "
+                     "thread-safe; solving the frames serially.",
+                    unsafe[0]->getAbsolutePathString());
+            numThreads = 1;
+        }
+    }
+    const ThreadReservation reservation(numThreads);
+
+    // Solve a chunk of frames with a copy of the state. The q's, u's and
+    // udot's of all frames in the chunk are evaluated one coordinate at a
+    // time before any frame is solved; splines are evaluated for all frames
+    // of the chunk at once.
+    auto solveChunk = [&](int first, int last) {
+        const int n = last - first;
+        SimTK::Matrix q(nq, n), u(nq, n), udot(nq, n);
+        SimTK::Vector chunkTimes(n, &times[first]);
+        SimTK::Vector value(n), speed(n), accel(n);
+        for (int j = 0; j < nq; ++j) {
+            const Function& function = Qs.get(j);
+            if (const auto* spline =
+                        dynamic_cast<const GCVSpline*>(&function)) {
+                spline->calcValuesAndDerivatives(
+                        chunkTimes, value, speed, accel);
+                q[j] = ~value;
+                u[j] = ~speed;
+                udot[j] = ~accel;
+                continue;
+            }
+            for (int i = 0; i < n; ++i) {
+                const SimTK::Vector time(1, times[first + i]);
+                q(j, i) = function.calcValue(time);
+                u(j, i) = function.calcDerivative({0}, time);
+                udot(j, i) = function.calcDerivative({0, 0}, time);
+            }
+        }
+        SimTK::State state(s);
+        for (int i = 0; i < n; ++i) {
+            state.updTime() = times[first + i];
+            state.updQ() = q(i);
+            state.updU() = u(i);
+            genForces[first + i] = ~solve(state, SimTK::Vector(udot(i)));
+        }
+    };
+
+    // The first frame is solved before starting any threads, so that
+    // components can initialize any data they create lazily.
+    if (nt > 0) solveChunk(0, 1);
+
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto runChunk = [&](int t) {
+        try {
+            const int first = 1 + (int)((long long)(nt - 1) * t / numThreads);
+            const int last =
+                    1 + (int)((long long)(nt - 1) * (t + 1) / numThreads);
+            if (first < last) solveChunk(first, last);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) threads.emplace_back(runChunk, t);
+    runChunk(0);
+    for (auto& thread : threads) thread.join();
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    return TimeSeriesTable(times, genForces, labels);
+}
+
+TimeSeriesTable InverseDynamicsSolver::solve(const SimTK::State& s,
+        const TimeSeriesTable& coordinateValues, int numThreads)
+{
+    TimeSeriesTable table(coordinateValues);
+    if (TableUtilities::isInDegrees(table)) {
+        getModel().getSimbodyEngine().convertDegreesToRadians(table);
+    }
+    GCVSplineSet splines(table);
+
+    // Functions must correspond to model coordinates and their order.
+    FunctionSet Qs;
+    for (const Coordinate* coord :
+            getModel().getCoordinatesInMultibodyTreeOrder()) {
+        const std::string path = coord->getAbsolutePathString();
+        const Function* function = nullptr;
+        for (const auto& label :
+                {coord->getName(), path, path + "/value"}) {
+            if (splines.contains(label)) {
+                function = &splines.get(label);
+                break;
+            }
+        }
+        if (function) {
+            Qs.cloneAndAppend(*function);
+        } else {
+            Qs.adoptAndAppend(new Constant(coord->getDefaultValue()));
+            log_info("InverseDynamicsSolver: coordinate values do not "
+                     "contain coordinate '{}'. Assuming default value.",
+                    coord->getName());
+        }
+    }
+    return solve(s, Qs, table.getIndependentColumn(), numThreads);
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
@@ -25,6 +25,7 @@
 
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
 
 namespace OpenSim {
 
@@ -99,6 +100,31 @@ public:
                  const SimTK::Array_<double>&  times,
                  SimTK::Array_<SimTK::Vector>& genForceTrajectory);
 #endif
+
+    /** Solve for the generalized forces at each of the given times, with q,
+        u and udot supplied by the coordinate functions (in the order of the
+        model's coordinates in multibody tree order, as above). The frames
+        are split into contiguous chunks that are solved on `numThreads`
+        threads (values less than 1 use all available cores), each with its
+        own copy of the state `s`; the model is shared, so its components
+        must keep all per-state data in the State, as the components in
+        OpenSim do. Unlike the Array_ version above, the model's analyses are
+        not stepped.
+        @returns a table with a row per time and a column per coordinate,
+        labeled with the coordinate's name followed by "_moment" or "_force"
+        (as written by the InverseDynamicsTool). */
+    TimeSeriesTable solve(const SimTK::State& s, const FunctionSet& Qs,
+            const std::vector<double>& times, int numThreads = 1);
+
+    /** Same as above, but the coordinate functions are quintic GCV splines
+        fit to `coordinateValues`, and the generalized forces are solved at
+        the times of the table. The column labels of the table are coordinate
+        names, coordinate paths or paths to the coordinate values (e.g.,
+        "/jointset/knee/knee_angle/value"); coordinates missing from the table
+        are held at their default values. Rotational coordinates are converted
+        from degrees if the table's "inDegrees" metadata is "yes". */
+    TimeSeriesTable solve(const SimTK::State& s,
+            const TimeSeriesTable& coordinateValues, int numThreads = 1);
 //=============================================================================
 };  // END of class InverseDynamicsSolver
 //=============================================================================
@@ -143,7 +143,13 @@ void InverseKinematicsSolver::updateMarkerWeight(int markerIndex, double value)
     if(markerIndex >=0 && markerIndex < _markersReference->getMarkerWeightSet().getSize()){
         // update the solver's copy of the reference
         _markersReference->updMarkerWeightSet()[markerIndex].setWeight(value);
-        _markerAssemblyCondition->changeMarkerWeight(SimTK::Markers::MarkerIx(markerIndex), value);
+        // Changing a weight to or from zero uninitializes the Assembler, so
+        // mask the marker instead and keep its weight in the condition.
+        setMarkerMasked(markerIndex, value == 0);
+        if (value != 0) {
+            _markerAssemblyCondition->changeMarkerWeight(
+                    SimTK::Markers::MarkerIx(markerIndex), value);
+        }
     }
     else
         throw Exception("InverseKinematicsSolver::updateMarkerWeight: invalid markerIndex.");
@@ -155,15 +161,47 @@ void InverseKinematicsSolver::updateMarkerWeights(const SimTK::Array_<double> &w
 {
     if(static_cast<unsigned>(_markersReference->getMarkerWeightSet().getSize()) 
        == weights.size()){
-        for(unsigned int i=0; i<weights.size(); i++){
-            _markersReference->updMarkerWeightSet()[i].setWeight(weights[i]);
-            _markerAssemblyCondition->changeMarkerWeight(SimTK::Markers::MarkerIx(i), weights[i]);
-        }
+        for(unsigned int i=0; i<weights.size(); i++)
+            updateMarkerWeight((int)i, weights[i]);
     }
     else
         throw Exception("InverseKinematicsSolver::updateMarkerWeights: invalid size of weights.");
 }
 
+void InverseKinematicsSolver::setMarkerMasked(int markerIndex, bool masked)
+{
+    OPENSIM_THROW_IF(markerIndex < 0 ||
+                     markerIndex >= (int)_markersReference->getNames().size(),
+            Exception, "Invalid marker index {}.", markerIndex);
+    if (_markerMasked.size() != _markersReference->getNames().size())
+        _markerMasked.resize(_markersReference->getNames().size(), false);
+    _markerMasked[markerIndex] = masked;
+    _anyMarkerMasked = std::find(_markerMasked.begin(), _markerMasked.end(),
+                                 true) != _markerMasked.end();
+}
+
+void InverseKinematicsSolver::setMarkerMasked(
+        const std::string& markerName, bool masked)
+{
+    const Array_<std::string>& names = _markersReference->getNames();
+    auto p = std::find(names.begin(), names.end(), markerName);
+    OPENSIM_THROW_IF(p == names.end(), Exception,
+            "Marker '{}' is not in the MarkersReference.", markerName);
+    setMarkerMasked((int)std::distance(names.begin(), p), masked);
+}
+
+bool InverseKinematicsSolver::isMarkerMasked(int markerIndex) const
+{
+    return markerIndex >= 0 && markerIndex < (int)_markerMasked.size() &&
+           _markerMasked[markerIndex];
+}
+
+void InverseKinematicsSolver::clearMarkerMasks()
+{
+    _markerMasked.fill(false);
+    _anyMarkerMasked = false;
+}
+
 int InverseKinematicsSolver::getNumOrientationSensorsInUse() const
 {
     return _orientationAssemblyCondition->getNumOSensors();
@@ -289,6 +327,33 @@ void InverseKinematicsSolver::
                     findCurrentMarkerErrorSquared(SimTK::Markers::MarkerIx(i));
 }
 
+/* Compute the locations of all markers and their squared errors, locating
+   each marker only once. */
+void InverseKinematicsSolver::computeCurrentMarkerLocationsAndSquaredErrors(
+        SimTK::Array_<SimTK::Vec3>& markerLocations,
+        SimTK::Array_<double>& squaredMarkerErrors)
+{
+    const SimTK::Markers& markers = *_markerAssemblyCondition;
+    const int nm = markers.getNumMarkers();
+    markerLocations.resize(nm);
+    squaredMarkerErrors.resize(nm);
+    for (int i = 0; i < nm; ++i) {
+        const SimTK::Markers::MarkerIx mx(i);
+        markerLocations[i] = markers.findCurrentMarkerLocation(mx);
+        // Same as SimTK::Markers::findCurrentMarkerErrorSquared().
+        const SimTK::Markers::ObservationIx ox =
+                markers.getObservationIxForMarker(mx);
+        double error = 0;
+        if (ox.isValid()) {
+            const SimTK::Vec3& observation = markers.getObservation(ox);
+            if (observation.isFinite()) {
+                error = (markerLocations[i] - observation).normSqr();
+            }
+        }
+        squaredMarkerErrors[i] = error;
+    }
+}
+
 /* Marker errors are reported in order different from tasks file or model, find name corresponding to passed in index  */
 std::string InverseKinematicsSolver::getMarkerNameForIndex(int markerIndex) const
 {
@@ -481,12 +546,11 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
         double nextTime = NaN;
         if (_orientationsReference &&
                 _orientationsReference->getNumRefs() > 0) {
-            SimTK::Array_<SimTK::Rotation> orientationValues;
             _orientationsReference->getNextValuesAndTime(
-                    nextTime, orientationValues);
+                    nextTime, _orientationValues);
             s.setTime(nextTime);
             _orientationAssemblyCondition->moveAllObservations(
-                    orientationValues);
+                    _orientationValues);
         }
         // update coordinates if any based on new time
         AssemblySolver::updateGoals(s);
@@ -498,16 +562,19 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     double nextTime = s.getTime();
     // specify the marker observations to be matched
     if (_markersReference && _markersReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Vec3> markerValues;
-        _markersReference->getValuesAtTime(nextTime, markerValues);
-        _markerAssemblyCondition->moveAllObservations(markerValues);
+        _markersReference->getValuesAtTime(nextTime, _markerValues);
+        // Masked markers are treated like gaps in the marker data.
+        if (_anyMarkerMasked) {
+            for (unsigned i = 0; i < _markerMasked.size(); ++i)
+                if (_markerMasked[i]) _markerValues[i].setToNaN();
+        }
+        _markerAssemblyCondition->moveAllObservations(_markerValues);
     }
 
     // specify the orientation observations to be matched
     if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Rotation> orientationValues;
-        _orientationsReference->getValuesAtTime(nextTime, orientationValues);
-        _orientationAssemblyCondition->moveAllObservations(orientationValues);
+        _orientationsReference->getValuesAtTime(nextTime, _orientationValues);
+        _orientationAssemblyCondition->moveAllObservations(_orientationValues);
     }
 }
 
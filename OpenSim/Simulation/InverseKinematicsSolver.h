@@ -139,7 +139,11 @@ public:
     int getNumOrientationSensorsInUse() const;
 
     /** Change the weighting of a marker, given the marker's name. Takes effect
-        when assemble() or track() is called next. */
+        when assemble() or track() is called next. Setting a weight to zero
+        (e.g., for a marker that drops out) masks the marker (see
+        setMarkerMasked()) instead of removing it from the assembly
+        condition, so that track() can continue without reinitializing the
+        assembler. */
     void updateMarkerWeight(const std::string &markerName, double value);
     /** Change the weighting of a marker, given the marker's index. Takes effect
         when assemble() or track() is called next. */
@@ -150,6 +154,20 @@ public:
         solver was constructed. */
     void updateMarkerWeights(const SimTK::Array_<double> &weights);
 
+    /** Skip a marker, given its index in the MarkersReference, in the frames
+        that follow (until it is unmasked). A masked marker's observation is
+        treated as missing, as for a gap (NaN) in the marker data: it does
+        not contribute to the goal and its error is not reported. Unlike
+        changing a marker's weight to or from zero, masking does not change
+        the assembly condition, so it can be toggled between calls to
+        track(). Masks persist across calls to assemble(). */
+    void setMarkerMasked(int markerIndex, bool masked);
+    /** Same as above, given the marker's name. */
+    void setMarkerMasked(const std::string& markerName, bool masked);
+    bool isMarkerMasked(int markerIndex) const;
+    /** Unmask all markers. */
+    void clearMarkerMasks();
+
     /** Change the weighting of an orientation sensor, given its name. Takes
     effect when assemble() or track() is called next. */
     void updateOrientationWeight(const std::string& orientationName, double value);
@@ -195,6 +213,17 @@ public:
         returned by computeCurrentMarkerErrors(). */
     void computeCurrentSquaredMarkerErrors(SimTK::Array_<double> &markerErrors);
 
+    /** Compute the spatial locations of all markers, expressed in the ground
+        frame, and the squared-distance errors to their observations in a
+        single pass. Each marker is located once, so this is cheaper than
+        calling both computeCurrentMarkerLocations() and
+        computeCurrentSquaredMarkerErrors(). Markers without a (finite)
+        observation have an error of 0. The arrays are resized only if
+        necessary. */
+    void computeCurrentMarkerLocationsAndSquaredErrors(
+            SimTK::Array_<SimTK::Vec3>& markerLocations,
+            SimTK::Array_<double>& squaredMarkerErrors);
+
     /** Marker locations and errors may be computed in an order that is different
         from tasks file or listed in the model. Return the corresponding marker
         name for an index in the list of marker locations/errors returned by the
@@ -263,6 +292,15 @@ private:
     // the SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::OrientationSensors> _orientationAssemblyCondition;
 
+    // Markers (in the order of the MarkersReference) whose observations are
+    // replaced with NaN in updateGoals().
+    SimTK::Array_<bool> _markerMasked;
+    bool _anyMarkerMasked{false};
+
+    // Observation values for the current frame, reused from frame to frame.
+    SimTK::Array_<SimTK::Vec3> _markerValues;
+    SimTK::Array_<SimTK::Rotation> _orientationValues;
+
     // internal flag indicating whether time is advanced based on live data or
     // controlled by the driver porgram (typically based on pre-recorded data).
     bool _advanceTimeFromReference{false};
@@ -0,0 +1,91 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  KinematicsSnapshot.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "KinematicsSnapshot.h"
+#include "Model/Model.h"
+#include "Model/PhysicalFrame.h"
+
+using namespace OpenSim;
+
+int KinematicsSnapshot::addStation(
+        const PhysicalFrame& frame, const SimTK::Vec3& location) {
+    m_stations.push_back({&frame, location, SimTK::MobilizedBodyIndex(),
+            SimTK::Rotation(), SimTK::Vec3(0)});
+    m_resolved = false;
+    return (int)m_stations.size() - 1;
+}
+
+void KinematicsSnapshot::clear() {
+    m_stations.clear();
+    m_resolved = false;
+}
+
+void KinematicsSnapshot::resolveStations() {
+    for (auto& station : m_stations) {
+        // The frame may be an offset frame on a body.
+        const SimTK::Transform X_BF = station.frame->findTransformInBaseFrame();
+        station.mobodIndex = station.frame->getMobilizedBodyIndex();
+        station.R_BF = X_BF.R();
+        station.locationInBody = X_BF * station.locationInFrame;
+    }
+    const int n = (int)m_stations.size();
+    m_rotations.resize(n);
+    m_locations.resize(n);
+    m_velocities.resize(n);
+    m_accelerations.resize(n);
+    m_resolved = true;
+}
+
+void KinematicsSnapshot::update(const SimTK::State& s) {
+    if (!m_resolved) resolveStations();
+    if (m_stations.empty()) return;
+
+    const SimTK::SimbodyMatterSubsystem& matter =
+            m_stations[0].frame->getModel().getMatterSubsystem();
+    const SimTK::Stage stage = s.getSystemStage();
+    const bool hasVelocity = stage >= SimTK::Stage::Velocity;
+    const bool hasAcceleration = stage >= SimTK::Stage::Acceleration;
+    if (!hasVelocity) m_velocities.setToNaN();
+    if (!hasAcceleration) m_accelerations.setToNaN();
+
+    for (int i = 0; i < (int)m_stations.size(); ++i) {
+        const Station& station = m_stations[i];
+        const SimTK::MobilizedBody& mobod =
+                matter.getMobilizedBody(station.mobodIndex);
+        const SimTK::Transform& X_GB = mobod.getBodyTransform(s);
+        m_rotations[i] = X_GB.R() * station.R_BF;
+        // The station relative to the body origin, expressed in Ground.
+        const SimTK::Vec3 r = X_GB.R() * station.locationInBody;
+        m_locations[i] = X_GB.p() + r;
+        if (!hasVelocity) continue;
+
+        const SimTK::SpatialVec& V_GB = mobod.getBodyVelocity(s);
+        const SimTK::Vec3& w = V_GB[0];
+        const SimTK::Vec3 wxr = w % r;
+        m_velocities[i] = SimTK::SpatialVec(w, V_GB[1] + wxr);
+        if (!hasAcceleration) continue;
+
+        const SimTK::SpatialVec& A_GB = mobod.getBodyAcceleration(s);
+        m_accelerations[i] = SimTK::SpatialVec(
+                A_GB[0], A_GB[1] + A_GB[0] % r + w % wxr);
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef OPENSIM_KINEMATICS_SNAPSHOT_H_
+#define OPENSIM_KINEMATICS_SNAPSHOT_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  KinematicsSnapshot.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <SimTKcommon.h>
+#include <vector>
+
+namespace OpenSim {
+
+class PhysicalFrame;
+
+/** The kinematics, expressed in Ground, of a list of stations (points fixed
+on PhysicalFrame%s), extracted for all stations in one pass over a realized
+state into contiguous arrays. Each station is resolved once to its
+mobilized body and its location in that body, so that update() reads each
+body's pose, velocity and acceleration directly from the multibody system
+instead of going through the Frame and Point interfaces for each quantity.
+Analyses such as BodyKinematics (body centers of mass) and PointKinematics
+use this, and so can goals or reporters that need the locations of many
+points (e.g., markers).
+
+@code
+KinematicsSnapshot snapshot;
+for (const auto& marker : model.getComponentList<Marker>()) {
+    snapshot.addStation(marker.getParentFrame(), marker.get_location());
+}
+model.realizePosition(state);
+snapshot.update(state);
+const SimTK::Vector_<SimTK::Vec3>& locations = snapshot.getLocationsInGround();
+@endcode
+
+The frames must belong to a model whose system has been created
+(Model::initSystem()); call clear() and add the stations again if the
+system is re-created. */
+class OSIMSIMULATION_API KinematicsSnapshot {
+public:
+    KinematicsSnapshot() = default;
+
+    /** Add a station fixed at `location` (expressed in `frame`) and return
+    its index in the arrays. */
+    int addStation(const PhysicalFrame& frame,
+            const SimTK::Vec3& location = SimTK::Vec3(0));
+    /** Remove all of the stations. */
+    void clear();
+    int getNumStations() const { return (int)m_stations.size(); }
+
+    /** Compute the kinematics of all stations from the state. The rotations
+    and locations require the state to be realized to Stage::Position; the
+    velocities and accelerations are computed only if the state is realized
+    to Stage::Velocity and Stage::Acceleration, respectively (otherwise they
+    are NaN). */
+    void update(const SimTK::State& s);
+
+    /** The orientation in Ground of the frame of each station. */
+    const SimTK::Array_<SimTK::Rotation>& getRotationsInGround() const {
+        return m_rotations;
+    }
+    const SimTK::Vector_<SimTK::Vec3>& getLocationsInGround() const {
+        return m_locations;
+    }
+    /** The angular velocity of each station's frame and the linear velocity
+    of the station, both in Ground. */
+    const SimTK::Vector_<SimTK::SpatialVec>& getVelocitiesInGround() const {
+        return m_velocities;
+    }
+    /** The angular acceleration of each station's frame and the linear
+    acceleration of the station, both in Ground. */
+    const SimTK::Vector_<SimTK::SpatialVec>& getAccelerationsInGround() const {
+        return m_accelerations;
+    }
+
+private:
+    void resolveStations();
+
+    struct Station {
+        const PhysicalFrame* frame;
+        SimTK::Vec3 locationInFrame;
+        // Resolved on the first update.
+        SimTK::MobilizedBodyIndex mobodIndex;
+        SimTK::Rotation R_BF;
+        SimTK::Vec3 locationInBody;
+    };
+    std::vector<Station> m_stations;
+    bool m_resolved = false;
+
+    SimTK::Array_<SimTK::Rotation> m_rotations;
+    SimTK::Vector_<SimTK::Vec3> m_locations;
+    SimTK::Vector_<SimTK::SpatialVec> m_velocities;
+    SimTK::Vector_<SimTK::SpatialVec> m_accelerations;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_KINEMATICS_SNAPSHOT_H_
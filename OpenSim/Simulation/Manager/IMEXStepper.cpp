@@ -0,0 +1,231 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  IMEXStepper.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "IMEXStepper.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace OpenSim;
+
+IMEXStepper::IMEXStepper(const Model& model) : m_model(model) {
+    OPENSIM_THROW_IF(!model.isValidSystem(), Exception,
+            "IMEXStepper: the model must be initialized (e.g., with "
+            "initSystem()) first.");
+}
+
+void IMEXStepper::setStepSize(double h) {
+    OPENSIM_THROW_IF(!(h > 0), Exception,
+            "Expected a positive step size, but got {}.", h);
+    m_stepSize = h;
+}
+
+void IMEXStepper::setNewtonTolerance(double tol) {
+    OPENSIM_THROW_IF(!(tol > 0), Exception,
+            "Expected a positive Newton tolerance, but got {}.", tol);
+    m_newtonTolerance = tol;
+}
+
+void IMEXStepper::setMaxNewtonIterations(int maxIterations) {
+    OPENSIM_THROW_IF(maxIterations < 1, Exception,
+            "Expected at least one Newton iteration, but got {}.",
+            maxIterations);
+    m_maxNewtonIterations = maxIterations;
+}
+
+void IMEXStepper::setConstraintTolerance(double tol) {
+    OPENSIM_THROW_IF(!(tol > 0), Exception,
+            "Expected a positive constraint tolerance, but got {}.", tol);
+    m_constraintTolerance = tol;
+}
+
+void IMEXStepper::initialize(const SimTK::State& state) {
+    m_state = state;
+    m_initialized = true;
+    m_statistics = Statistics();
+    m_states = StatesTrajectory();
+    if (m_recordStates) m_states.append(m_state);
+
+    // Group the auxiliary states by the component that owns them. Auxiliary
+    // states that are not OpenSim state variables (e.g., of Simbody
+    // Measures) get a block of their own.
+    const int nq = m_state.getNQ();
+    const int nu = m_state.getNU();
+    const int nz = m_state.getNZ();
+    const auto names = m_model.getStateVariableNames();
+    std::vector<std::string> nameVec;
+    for (int i = 0; i < names.getSize(); ++i) nameVec.push_back(names[i]);
+    const auto indices = m_model.getStateVariableSystemIndices(nameVec);
+
+    std::map<std::string, int> blockOfOwner;
+    std::vector<bool> assigned(nz, false);
+    m_blocks.clear();
+    for (int i = 0; i < (int)nameVec.size(); ++i) {
+        const int iz = indices[i] - nq - nu;
+        if (iz < 0 || iz >= nz) continue;
+        const std::string owner =
+                nameVec[i].substr(0, nameVec[i].rfind('/'));
+        auto it = blockOfOwner.find(owner);
+        if (it == blockOfOwner.end()) {
+            it = blockOfOwner.emplace(owner, (int)m_blocks.size()).first;
+            m_blocks.emplace_back();
+        }
+        m_blocks[it->second].push_back(iz);
+        assigned[iz] = true;
+    }
+    for (int iz = 0; iz < nz; ++iz) {
+        if (!assigned[iz]) m_blocks.push_back({iz});
+    }
+
+    m_numColors = 0;
+    m_jacobians.clear();
+    for (const auto& block : m_blocks) {
+        m_numColors = std::max(m_numColors, (int)block.size());
+        m_jacobians.emplace_back((int)block.size(), (int)block.size());
+    }
+    m_factors.assign(m_blocks.size(), SimTK::FactorLU());
+    m_z0.resize(nz);
+    m_zdot.resize(nz);
+    m_zdotPerturbed.resize(nz);
+    m_residual.resize(nz);
+}
+
+const SimTK::State& IMEXStepper::step() {
+    OPENSIM_THROW_IF(!m_initialized, Exception,
+            "IMEXStepper: call initialize() before taking steps.");
+    takeStep(m_stepSize);
+    return m_state;
+}
+
+const SimTK::State& IMEXStepper::integrate(double finalTime) {
+    OPENSIM_THROW_IF(!m_initialized, Exception,
+            "IMEXStepper: call initialize() before taking steps.");
+    // Avoid a final step that is shorter than roundoff.
+    const double eps = SimTK::SignificantReal * std::max(1.0, finalTime);
+    while (m_state.getTime() < finalTime - eps) {
+        takeStep(std::min(m_stepSize, finalTime - m_state.getTime()));
+    }
+    return m_state;
+}
+
+void IMEXStepper::factorJacobian(double h) {
+    const auto& system = m_model.getMultibodySystem();
+    SimTK::State& s = m_state;
+    // m_zdot has been evaluated at the current z.
+    const SimTK::Vector z = s.getZ();
+    for (int color = 0; color < m_numColors; ++color) {
+        // Perturb the color-th state variable of every component.
+        SimTK::Vector& zPerturbed = s.updZ();
+        zPerturbed = z;
+        for (const auto& block : m_blocks) {
+            if (color >= (int)block.size()) continue;
+            const int iz = block[color];
+            zPerturbed[iz] += SimTK::SqrtEps * std::max(1.0, std::abs(z[iz]));
+        }
+        system.realize(s, SimTK::Stage::Acceleration);
+        m_zdotPerturbed = s.getZDot();
+        ++m_statistics.numJacobianEvaluations;
+        for (int b = 0; b < (int)m_blocks.size(); ++b) {
+            const auto& block = m_blocks[b];
+            if (color >= (int)block.size()) continue;
+            const int jz = block[color];
+            const double dz = s.getZ()[jz] - z[jz];
+            for (int i = 0; i < (int)block.size(); ++i) {
+                m_jacobians[b](i, color) =
+                        (m_zdotPerturbed[block[i]] - m_zdot[block[i]]) / dz;
+            }
+        }
+    }
+    s.updZ() = z;
+
+    // Factor I - h * J for each block.
+    for (int b = 0; b < (int)m_blocks.size(); ++b) {
+        SimTK::Matrix newton = -h * m_jacobians[b];
+        newton.updDiag() += 1;
+        m_factors[b].factor(newton);
+    }
+}
+
+void IMEXStepper::takeStep(double h) {
+    const auto& system = m_model.getMultibodySystem();
+    SimTK::State& s = m_state;
+    const double t0 = s.getTime();
+
+    // Semi-implicit Euler for the multibody states.
+    system.realize(s, SimTK::Stage::Acceleration);
+    m_z0 = s.getZ();
+    m_zdot = s.getZDot();
+    s.updU() += h * s.getUDot();
+    system.realize(s, SimTK::Stage::Velocity);
+    s.updQ() += h * s.getQDot();
+    s.setTime(t0 + h);
+    system.prescribe(s);
+    system.project(s, m_constraintTolerance);
+
+    // Backward Euler for the auxiliary states, starting from a forward Euler
+    // prediction.
+    if (s.getNZ() > 0) {
+        s.updZ() = m_z0 + h * m_zdot;
+        bool converged = false;
+        for (int iter = 0; iter < m_maxNewtonIterations; ++iter) {
+            system.realize(s, SimTK::Stage::Acceleration);
+            m_zdot = s.getZDot();
+            ++m_statistics.numNewtonIterations;
+            // The Jacobian is evaluated once per step.
+            if (iter == 0) factorJacobian(h);
+            m_residual = s.getZ() - m_z0 - h * m_zdot;
+
+            double maxChange = 0;
+            SimTK::Vector& z = s.updZ();
+            for (int b = 0; b < (int)m_blocks.size(); ++b) {
+                const auto& block = m_blocks[b];
+                const int n = (int)block.size();
+                SimTK::Vector rhs(n), dz(n);
+                for (int i = 0; i < n; ++i) rhs[i] = m_residual[block[i]];
+                m_factors[b].solve(rhs, dz);
+                for (int i = 0; i < n; ++i) {
+                    const int iz = block[i];
+                    maxChange = std::max(maxChange,
+                            std::abs(dz[i]) / std::max(1.0, std::abs(z[iz])));
+                    z[iz] -= dz[i];
+                }
+            }
+            if (maxChange < m_newtonTolerance) {
+                converged = true;
+                break;
+            }
+        }
+        if (!converged) {
+            if (m_statistics.numNonconvergedSteps == 0) {
+                log_warn("IMEXStepper: the Newton iterations for the "
+                         "auxiliary states did not converge at time {}; "
+                         "consider a smaller step size.", s.getTime());
+            }
+            ++m_statistics.numNonconvergedSteps;
+        }
+    }
+
+    system.realize(s, SimTK::Stage::Velocity);
+    ++m_statistics.numSteps;
+    if (m_recordStates) m_states.append(s);
+}
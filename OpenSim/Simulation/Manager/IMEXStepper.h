@@ -0,0 +1,150 @@
+#ifndef OPENSIM_IMEX_STEPPER_H_
+#define OPENSIM_IMEX_STEPPER_H_
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  IMEXStepper.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <OpenSim/Simulation/StatesTrajectory.h>
+#include <SimTKcommon.h>
+#include <SimTKmath.h>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** Fixed-step implicit-explicit (IMEX) integration for models with stiff
+auxiliary states, such as muscle activations and fiber lengths.
+
+Each step of size h has two parts:
+1. The multibody states are advanced with semi-implicit (symplectic) Euler:
+   the speeds are updated with the accelerations at the beginning of the step,
+   and the coordinates with the updated speeds. The coordinates and speeds are
+   then made to satisfy prescribed motion and constraints (see
+   SimTK::System::prescribe() and SimTK::System::project()).
+2. The auxiliary states z are advanced with backward Euler, holding the new
+   coordinates and speeds fixed: z1 = z0 + h * zdot(t + h, q1, u1, z1). The
+   nonlinear equations are solved with a simplified Newton method.
+
+The Jacobian of zdot with respect to z is assumed to be block diagonal, with
+one block for the state variables of each component (e.g., the activation and
+fiber length of a muscle). It is computed with colored finite differences:
+the i-th state variable of every component is perturbed at the same time, so
+the number of evaluations of zdot is the largest number of state variables
+in a component rather than the number of auxiliary states. Coupling between
+components (e.g., a controller that reads another component's states) is
+ignored in the Jacobian but not in the residual, so it only slows the
+convergence of the Newton iterations.
+
+Because the auxiliary states are treated implicitly, the step size is limited
+by the multibody dynamics rather than by the time constants of the muscles.
+Stiff forces that act on the multibody (e.g., contact) are still explicit.
+Events are not handled, and analyses and reporters are not invoked; use
+getStatesTrajectory() to obtain the states at each step.
+
+@code
+Model model("subject.osim");
+SimTK::State state = model.initSystem();
+IMEXStepper stepper(model);
+stepper.setStepSize(0.002);
+stepper.initialize(state);
+stepper.integrate(1.0);
+stepper.getStatesTrajectory().exportToTable(model).getNumRows();
+@endcode */
+class OSIMSIMULATION_API IMEXStepper {
+public:
+    struct Statistics {
+        int numSteps = 0;
+        int numNewtonIterations = 0;
+        /** Steps after which the Newton iterations had not converged. */
+        int numNonconvergedSteps = 0;
+        /** Evaluations of zdot for the finite-difference Jacobians. */
+        int numJacobianEvaluations = 0;
+    };
+
+    /** The model must have been initialized (e.g., with initSystem()) and
+    must outlive the stepper. */
+    explicit IMEXStepper(const Model& model);
+
+    /** The fixed time step (default: 1e-3 s). */
+    void setStepSize(double h);
+    double getStepSize() const { return m_stepSize; }
+    /** The Newton iterations stop once the largest change in an auxiliary
+    state, relative to max(1, |z|), is below this tolerance (default: 1e-8).
+    */
+    void setNewtonTolerance(double tol);
+    double getNewtonTolerance() const { return m_newtonTolerance; }
+    /** The maximum number of Newton iterations per step (default: 10). */
+    void setMaxNewtonIterations(int maxIterations);
+    int getMaxNewtonIterations() const { return m_maxNewtonIterations; }
+    /** The accuracy to which constraints are satisfied after each step
+    (default: 1e-8). */
+    void setConstraintTolerance(double tol);
+    double getConstraintTolerance() const { return m_constraintTolerance; }
+    /** Append the state after each step to getStatesTrajectory() (default:
+    true). */
+    void setRecordStates(bool tf) { m_recordStates = tf; }
+    bool getRecordStates() const { return m_recordStates; }
+
+    /** Start from a copy of the given state, and clear the recorded states
+    and statistics. */
+    void initialize(const SimTK::State& state);
+    /** Take one step and return the new state. */
+    const SimTK::State& step();
+    /** Take steps until the final time is reached; the last step is
+    shortened if necessary. */
+    const SimTK::State& integrate(double finalTime);
+
+    const SimTK::State& getState() const { return m_state; }
+    /** The initial state and the state after each step, if recording. */
+    const StatesTrajectory& getStatesTrajectory() const { return m_states; }
+    const Statistics& getStatistics() const { return m_statistics; }
+
+private:
+    void takeStep(double h);
+    void factorJacobian(double h);
+
+    const Model& m_model;
+    double m_stepSize = 1e-3;
+    double m_newtonTolerance = 1e-8;
+    int m_maxNewtonIterations = 10;
+    double m_constraintTolerance = 1e-8;
+    bool m_recordStates = true;
+
+    SimTK::State m_state;
+    bool m_initialized = false;
+    StatesTrajectory m_states;
+    Statistics m_statistics;
+
+    // The indices (into z) of the auxiliary states of each component, and
+    // the LU factorization of each block of the Newton matrix I - h dzdot/dz.
+    std::vector<std::vector<int>> m_blocks;
+    int m_numColors = 0;
+    std::vector<SimTK::FactorLU> m_factors;
+    // Work space.
+    SimTK::Vector m_z0, m_zdot, m_zdotPerturbed, m_residual;
+    std::vector<SimTK::Matrix> m_jacobians;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_IMEX_STEPPER_H_
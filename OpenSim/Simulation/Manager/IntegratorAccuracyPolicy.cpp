@@ -0,0 +1,116 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  IntegratorAccuracyPolicy.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "IntegratorAccuracyPolicy.h"
+
+#include <OpenSim/Common/Exception.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+    void checkSettings(const std::string& caller, double accuracy,
+            double maximumStepSize) {
+        OPENSIM_THROW_IF(!(accuracy > 0), Exception,
+                "{}: Expected a positive accuracy, but got {}.", caller,
+                accuracy);
+        OPENSIM_THROW_IF(!(maximumStepSize > 0), Exception,
+                "{}: Expected a positive maximum step size, but got {}.",
+                caller, maximumStepSize);
+    }
+}
+
+IntegratorAccuracyPolicy::IntegratorAccuracyPolicy(
+        double accuracy, double maximumStepSize)
+        : m_accuracy(accuracy), m_maximumStepSize(maximumStepSize) {
+    checkSettings("IntegratorAccuracyPolicy", accuracy, maximumStepSize);
+}
+
+void IntegratorAccuracyPolicy::addPhase(const std::string& name,
+        Predicate predicate, double accuracy, double maximumStepSize) {
+    OPENSIM_THROW_IF(!predicate, Exception,
+            "IntegratorAccuracyPolicy::addPhase(): Expected a predicate for "
+            "phase '{}'.", name);
+    checkSettings("IntegratorAccuracyPolicy::addPhase()", accuracy,
+            maximumStepSize);
+    m_phases.push_back({name, std::move(predicate), accuracy,
+            maximumStepSize});
+}
+
+IntegratorAccuracyPolicy::Predicate
+IntegratorAccuracyPolicy::isTimeInInterval(double start, double end) {
+    return [start, end](const SimTK::State& s) {
+        return s.getTime() >= start && s.getTime() < end;
+    };
+}
+
+const IntegratorAccuracyPolicy::Phase& IntegratorAccuracyPolicy::getPhase(
+        int phase) const {
+    OPENSIM_THROW_IF(phase < 0 || phase >= getNumPhases(), IndexOutOfRange,
+            (size_t)phase, 0, (size_t)std::max(getNumPhases() - 1, 0));
+    return m_phases[phase];
+}
+
+const std::string& IntegratorAccuracyPolicy::getPhaseName(int phase) const {
+    return getPhase(phase).name;
+}
+
+double IntegratorAccuracyPolicy::getAccuracy(int phase) const {
+    return getPhase(phase).accuracy;
+}
+
+double IntegratorAccuracyPolicy::getMaximumStepSize(int phase) const {
+    return getPhase(phase).maximumStepSize;
+}
+
+int IntegratorAccuracyPolicy::findActivePhase(const SimTK::State& s) const {
+    for (int i = 0; i < getNumPhases(); ++i) {
+        if (m_phases[i].predicate(s)) return i;
+    }
+    return -1;
+}
+
+double IntegratorAccuracyPolicy::getTightestAccuracy() const {
+    double accuracy = m_accuracy;
+    for (const auto& phase : m_phases) {
+        accuracy = std::min(accuracy, phase.accuracy);
+    }
+    return accuracy;
+}
+
+double IntegratorAccuracyPolicy::getTightestMaximumStepSize() const {
+    double maximumStepSize = m_maximumStepSize;
+    for (const auto& phase : m_phases) {
+        maximumStepSize = std::min(maximumStepSize, phase.maximumStepSize);
+    }
+    return maximumStepSize;
+}
+
+IntegratorAccuracyPolicy::Statistics
+IntegratorAccuracyPolicy::createStatistics() const {
+    Statistics stats;
+    stats.phaseNames.push_back("default");
+    for (const auto& phase : m_phases) stats.phaseNames.push_back(phase.name);
+    stats.numStepsPerPhase.assign(stats.phaseNames.size(), 0);
+    return stats;
+}
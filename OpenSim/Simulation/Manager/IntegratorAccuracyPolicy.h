@@ -0,0 +1,149 @@
+#ifndef OPENSIM_INTEGRATOR_ACCURACY_POLICY_H_
+#define OPENSIM_INTEGRATOR_ACCURACY_POLICY_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  IntegratorAccuracyPolicy.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** Integrator settings that change with the phase of a simulation. For
+example, the swing phase of a gait simulation tolerates a looser accuracy
+than the transients at foot contact. A policy has default settings and a list
+of phases, each with a predicate on the state (e.g., a contact force above a
+threshold) and its own accuracy and maximum step size. Phases are checked in
+the order in which they were added, and the first phase whose predicate is
+true is active; if none is, the default settings are used.
+
+Attach the policy to a Manager with Manager::setIntegratorAccuracyPolicy().
+The Manager checks the predicates each time the integrator returns during
+integrate() (after every step, or at each recording time with the
+FixedInterval recording policy) and before the first step, with the state
+realized to Stage::Dynamics. When the active phase changes, the integrator is
+reinitialized with the settings of the new phase. To switch phases on
+user-defined events, have the event handler set a discrete variable and test
+that variable in the predicate, or use isTimeInInterval() for known times.
+
+@code
+IntegratorAccuracyPolicy policy(1e-3, 0.01);
+const auto& contact = model.getComponent<SmoothSphereHalfSpaceForce>(
+        "/forceset/heel_contact");
+policy.addPhase("contact", [&](const SimTK::State& s) {
+            return contact.calcContactForceOnSphere(s)[1].norm() > 10.0;
+        }, 1e-5, 0.001);
+policy.setCompareWithFixedAccuracy(true);
+manager.setIntegratorAccuracyPolicy(policy);
+manager.initialize(state);
+manager.integrate(1.0);
+const auto& stats = manager.getIntegratorAccuracyPolicyStatistics();
+log_info("Steps saved: {}", stats.getNumStepsSaved());
+@endcode */
+class OSIMSIMULATION_API IntegratorAccuracyPolicy {
+public:
+    using Predicate = std::function<bool(const SimTK::State&)>;
+
+    /** The number of integrator steps taken with each phase of the policy.
+    Index 0 is the default settings; index i > 0 is phase i - 1. */
+    struct Statistics {
+        std::vector<std::string> phaseNames;
+        std::vector<int> numStepsPerPhase;
+        /** Number of times the active phase changed. */
+        int numPhaseChanges = 0;
+        int numSteps = 0;
+        /** Steps taken over the same intervals with the tightest settings of
+        the policy, or -1 if the comparison was not requested (see
+        setCompareWithFixedAccuracy()). */
+        int numStepsFixedAccuracy = -1;
+        /** numStepsFixedAccuracy - numSteps, or 0 if there was no
+        comparison. */
+        int getNumStepsSaved() const {
+            return numStepsFixedAccuracy < 0 ? 0
+                                             : numStepsFixedAccuracy - numSteps;
+        }
+    };
+
+    /** The default settings, used when no phase is active.
+    @throws Exception if the accuracy or maximum step size is not positive. */
+    explicit IntegratorAccuracyPolicy(double accuracy,
+            double maximumStepSize = SimTK::Infinity);
+
+    /** Add a phase whose settings are used while `predicate` is true (and
+    the predicates of the phases added before it are false).
+    @throws Exception if the accuracy or maximum step size is not positive. */
+    void addPhase(const std::string& name, Predicate predicate,
+            double accuracy, double maximumStepSize = SimTK::Infinity);
+
+    /** A predicate that is true for times in [start, end). */
+    static Predicate isTimeInInterval(double start, double end);
+
+    int getNumPhases() const { return (int)m_phases.size(); }
+    const std::string& getPhaseName(int phase) const;
+    double getAccuracy(int phase) const;
+    double getMaximumStepSize(int phase) const;
+    double getDefaultAccuracy() const { return m_accuracy; }
+    double getDefaultMaximumStepSize() const { return m_maximumStepSize; }
+
+    /** The index of the active phase at the state `s`, or -1 if the default
+    settings apply. */
+    int findActivePhase(const SimTK::State& s) const;
+
+    /** The smallest accuracy and maximum step size over the default settings
+    and all phases. These are the settings with which a fixed-accuracy
+    simulation would resolve every phase. */
+    double getTightestAccuracy() const;
+    double getTightestMaximumStepSize() const;
+
+    /** If true, Manager::integrate() first integrates the same interval
+    with the tightest settings of the policy to report the number of steps
+    saved (Statistics::numStepsFixedAccuracy). This doubles the cost of the
+    simulation and is meant for tuning a policy. The comparison does not
+    record states or run analyses, but event handlers and reporters in the
+    system are also invoked during the comparison (default: false). */
+    void setCompareWithFixedAccuracy(bool tf) { m_compare = tf; }
+    bool getCompareWithFixedAccuracy() const { return m_compare; }
+
+    /** Empty statistics with the names of the phases filled in. */
+    Statistics createStatistics() const;
+
+private:
+    struct Phase {
+        std::string name;
+        Predicate predicate;
+        double accuracy;
+        double maximumStepSize;
+    };
+    const Phase& getPhase(int phase) const;
+
+    double m_accuracy;
+    double m_maximumStepSize;
+    std::vector<Phase> m_phases;
+    bool m_compare = false;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_INTEGRATOR_ACCURACY_POLICY_H_
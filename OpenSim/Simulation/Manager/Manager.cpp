@@ -29,8 +29,16 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
+#include "SimulationCheckpoint.h"
 #include <OpenSim/Common/Array.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -51,6 +59,7 @@ std::string Manager::_displayName = "Simulator";
 Manager::Manager(Model& model) : Manager(model, true)
 {
     _integ.reset(new SimTK::RungeKuttaMersonIntegrator(_model->getMultibodySystem()));
+    _integMethod = static_cast<int>(IntegratorMethod::RungeKuttaMerson);
 }
 
 Manager::Manager(Model& model, const SimTK::State& state)
@@ -97,6 +106,24 @@ setNull()
     _dt = 1.0e-4;
     _performAnalyses=true;
     _writeToStorage=true;
+    _recordingPolicy = static_cast<int>(RecordingPolicy::EveryStep);
+    _recordingInterval = SimTK::NaN;
+    _recordingStateChangeThreshold = SimTK::NaN;
+    _checkpointFile = "";
+    _checkpointInterval = SimTK::NaN;
+    _realTimeFactor = 0;
+    _realTimeTolerance = 0.005;
+    _numRealTimeOverruns = 0;
+    _maxRealTimeLag = 0;
+    _maxSubsteps = 0;
+    _stepStatistics = StepStatistics();
+    _integrationCountersAtInitialize = IntegrationStatistics();
+    _integrationWallTime = 0;
+    _recordingWallTime = 0;
+    _integMethod = static_cast<int>(IntegratorMethod::RungeKuttaMerson);
+    _accuracyPolicy.reset();
+    _activeAccuracyPhase = -1;
+    _accuracyPolicyStatistics = IntegratorAccuracyPolicy::Statistics();
     _tArray.setSize(0);
     _dtArray.setSize(0);
 }
@@ -509,43 +536,40 @@ void Manager::setIntegratorMethod(IntegratorMethod integMethod)
         OPENSIM_THROW(Exception, msg);
     }
 
-    auto& sys = _model->getMultibodySystem();
+    _integ.reset(createIntegrator(integMethod, _model->getMultibodySystem()));
+    _integMethod = static_cast<int>(integMethod);
+}
+
+SimTK::Integrator* Manager::createIntegrator(IntegratorMethod integMethod,
+        const SimTK::System& sys)
+{
     switch (integMethod) {
         //case IntegratorMethod::CPodes:
-        //    _integ.reset(new SimTK::CPodesIntegrator(sys));
-        //    break;
+        //    return new SimTK::CPodesIntegrator(sys);
 
         case IntegratorMethod::ExplicitEuler:
-            _integ.reset(new SimTK::ExplicitEulerIntegrator(sys));
-            break;
+            return new SimTK::ExplicitEulerIntegrator(sys);
 
         case IntegratorMethod::RungeKutta2:
-            _integ.reset(new SimTK::RungeKutta2Integrator(sys));
-            break;
+            return new SimTK::RungeKutta2Integrator(sys);
 
         case IntegratorMethod::RungeKutta3:
-            _integ.reset(new SimTK::RungeKutta3Integrator(sys));
-            break;
+            return new SimTK::RungeKutta3Integrator(sys);
 
         case IntegratorMethod::RungeKuttaFeldberg:
-            _integ.reset(new SimTK::RungeKuttaFeldbergIntegrator(sys));
-            break;
+            return new SimTK::RungeKuttaFeldbergIntegrator(sys);
 
         case IntegratorMethod::RungeKuttaMerson:
-            _integ.reset(new SimTK::RungeKuttaMersonIntegrator(sys));
-            break;
+            return new SimTK::RungeKuttaMersonIntegrator(sys);
 
         //case Integrator::SemiExplicitEuler:
-        //    _integ.reset(SimTK::SemiExplicitEulerIntegrator(sys, stepSize));
-        //    break;
+        //    return new SimTK::SemiExplicitEulerIntegrator(sys, stepSize);
 
         case IntegratorMethod::SemiExplicitEuler2:
-            _integ.reset(new SimTK::SemiExplicitEuler2Integrator(sys));
-            break;
+            return new SimTK::SemiExplicitEuler2Integrator(sys);
 
         case IntegratorMethod::Verlet:
-            _integ.reset(new SimTK::VerletIntegrator(sys));
-            break;
+            return new SimTK::VerletIntegrator(sys);
 
         default:
             std::string msg = "Integrator method not recognized.";
@@ -597,6 +621,63 @@ void Manager::setIntegratorInternalStepLimit(int nSteps)
     _integ->setInternalStepLimit(nSteps);
 }
 
+void Manager::setIntegratorAccuracyPolicy(
+        const IntegratorAccuracyPolicy& policy)
+{
+    OPENSIM_THROW_IF(!_integ->methodHasErrorControl(), Exception,
+            "Manager::setIntegratorAccuracyPolicy(): Integrator method {} "
+            "does not support error control.", _integ->getMethodName());
+    _accuracyPolicy.reset(new IntegratorAccuracyPolicy(policy));
+    _activeAccuracyPhase = -1;
+    _accuracyPolicyStatistics = policy.createStatistics();
+    _integ->setAccuracy(policy.getDefaultAccuracy());
+    _integ->setMaximumStepSize(policy.getDefaultMaximumStepSize());
+}
+
+void Manager::updateAccuracyPhase()
+{
+    const SimTK::State& s = _integ->getState();
+    _model->realizeDynamics(s);
+    const int phase = _accuracyPolicy->findActivePhase(s);
+    if (phase == _activeAccuracyPhase) return;
+
+    if (phase < 0) {
+        _integ->setAccuracy(_accuracyPolicy->getDefaultAccuracy());
+        _integ->setMaximumStepSize(
+                _accuracyPolicy->getDefaultMaximumStepSize());
+    } else {
+        _integ->setAccuracy(_accuracyPolicy->getAccuracy(phase));
+        _integ->setMaximumStepSize(_accuracyPolicy->getMaximumStepSize(phase));
+    }
+    // The integrator reads its settings when it is (re)initialized. The
+    // state itself has not changed, so this is the mildest reinitialization.
+    _integ->reinitialize(SimTK::Stage::Acceleration, false);
+    _activeAccuracyPhase = phase;
+    ++_accuracyPolicyStatistics.numPhaseChanges;
+}
+
+int Manager::countStepsWithFixedAccuracy(double finalTime) const
+{
+    const auto& sys = _model->getMultibodySystem();
+    std::unique_ptr<SimTK::Integrator> integ(createIntegrator(
+            static_cast<IntegratorMethod>(_integMethod), sys));
+    integ->setAccuracy(_accuracyPolicy->getTightestAccuracy());
+    integ->setMaximumStepSize(_accuracyPolicy->getTightestMaximumStepSize());
+    integ->setConstraintTolerance(_integ->getConstraintToleranceInUse());
+    integ->setFinalTime(finalTime);
+    SimTK::TimeStepper timeStepper(sys, *integ);
+    timeStepper.initialize(_integ->getState());
+    timeStepper.stepTo(finalTime);
+    OPENSIM_THROW_IF(integ->isSimulationOver() &&
+                    integ->getTerminationReason() !=
+                            SimTK::Integrator::ReachedFinalTime,
+            Exception,
+            "Manager::integrate(): The fixed-accuracy comparison for the "
+            "accuracy policy failed: {}.",
+            integ->getTerminationReasonString(integ->getTerminationReason()));
+    return integ->getNumStepsTaken();
+}
+
 //=============================================================================
 // EXECUTION
 //=============================================================================
@@ -690,15 +771,49 @@ const SimTK::State& Manager::integrate(double finalTime)
     bool fixedStep = false;
     if (_constantDT || _specifiedDT) fixedStep = true;
 
+    const auto policy = getRecordingPolicy();
+    OPENSIM_THROW_IF(fixedStep && policy != RecordingPolicy::EveryStep,
+            Exception,
+            "Manager::integrate(): The FixedInterval and StateChange "
+            "recording policies cannot be used with specified or constant "
+            "time steps.");
+    OPENSIM_THROW_IF(policy == RecordingPolicy::FixedInterval &&
+            !(_recordingInterval > 0), Exception,
+            "Manager::integrate(): Expected a positive recording interval "
+            "for the FixedInterval recording policy, but got {}.",
+            _recordingInterval);
+    OPENSIM_THROW_IF(policy == RecordingPolicy::StateChange &&
+            !(_recordingStateChangeThreshold >= 0), Exception,
+            "Manager::integrate(): Expected a nonnegative threshold for the "
+            "StateChange recording policy, but got {}.",
+            _recordingStateChangeThreshold);
+
     auto status = SimTK::Integrator::InvalidSuccessfulStepStatus;
 
     if (!fixedStep) {
-        _integ->setReturnEveryInternalStep(true);
+        // With the FixedInterval policy, the TimeStepper returns at each
+        // recording time (and at events) instead of after every step.
+        _integ->setReturnEveryInternalStep(
+                policy != RecordingPolicy::FixedInterval);
     }
 
+    OPENSIM_THROW_IF(fixedStep && _accuracyPolicy, Exception,
+            "Manager::integrate(): An integrator accuracy policy cannot be "
+            "used with specified or constant time steps.");
+
     _model->realizeVelocity(s);
     initializeStorageAndAnalyses(s);
 
+    if (_accuracyPolicy && initialTime < finalTime) {
+        if (_accuracyPolicy->getCompareWithFixedAccuracy()) {
+            const int numSteps = countStepsWithFixedAccuracy(finalTime);
+            auto& stats = _accuracyPolicyStatistics;
+            stats.numStepsFixedAccuracy =
+                    std::max(stats.numStepsFixedAccuracy, 0) + numSteps;
+        }
+        updateAccuracyPhase();
+    }
+
     if (fixedStep) {
         _model->realizeAcceleration(s);
         record(s, step);
@@ -706,12 +821,26 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     double time = initialTime;
     double stepToTime = finalTime;
+    int recordingIndex = 1;
+
+    const bool writeCheckpoints =
+            !_checkpointFile.empty() && _checkpointInterval > 0;
+    double nextCheckpointTime = SimTK::Infinity;
+    if (writeCheckpoints) {
+        nextCheckpointTime = _checkpointInterval *
+                (std::floor(initialTime / _checkpointInterval) + 1);
+    }
 
     if (time >= stepToTime) {
         // No integration can be performed.
         return getState();
     }
 
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point wallStart = Clock::now();
+    _numRealTimeOverruns = 0;
+    _maxRealTimeLag = 0;
+
     // This should use: status != SimTK::Integrator::EndOfSimulation
     // but if we do that then repeated calls to integrate (and thus stepTo)
     // fail to continue on integrating. This seems to be a bug in TimeStepper
@@ -723,15 +852,45 @@ const SimTK::State& Manager::integrate(double finalTime)
             if (fixedStepSize + time >= finalTime)  fixedStepSize = finalTime - time;
             _integ->setFixedStepSize(fixedStepSize);
             stepToTime = time + fixedStepSize;
+        } else if (policy == RecordingPolicy::FixedInterval) {
+            double nextRecordingTime =
+                    initialTime + recordingIndex * _recordingInterval;
+            while (nextRecordingTime <= time) {
+                nextRecordingTime =
+                        initialTime + ++recordingIndex * _recordingInterval;
+            }
+            // Do not record a state that differs from the final state only
+            // by roundoff.
+            if (finalTime - nextRecordingTime <= SimTK::SignificantReal *
+                    std::max(1.0, std::abs(finalTime))) {
+                nextRecordingTime = finalTime;
+            }
+            stepToTime = std::min(nextRecordingTime, finalTime);
         }
 
+        const int numStepsBefore = _integ->getNumStepsTaken();
+        const Clock::time_point stepStart = Clock::now();
         status = _timeStepper->stepTo(stepToTime);
+        _integrationWallTime += std::chrono::duration<double>(
+                Clock::now() - stepStart).count();
+
+        if (_accuracyPolicy) {
+            const int numSteps = _integ->getNumStepsTaken() - numStepsBefore;
+            _accuracyPolicyStatistics.numSteps += numSteps;
+            _accuracyPolicyStatistics
+                    .numStepsPerPhase[_activeAccuracyPhase + 1] += numSteps;
+            updateAccuracyPhase();
+        }
 
-        if ( (status == SimTK::Integrator::TimeHasAdvanced) ||
-             (status == SimTK::Integrator::ReachedScheduledEvent) ) {
+        if (shouldRecord(_integ->getState(), status, finalTime)) {
             const SimTK::State& s = _integ->getState();
             record(s, step);
             step++;
+            if (s.getTime() >= nextCheckpointTime) {
+                writeCheckpoint(_checkpointFile);
+                nextCheckpointTime = _checkpointInterval *
+                        (std::floor(s.getTime() / _checkpointInterval) + 1);
+            }
         }
         // Check if simulation has terminated for some reason
         else if (_integ->isSimulationOver() &&
@@ -743,6 +902,30 @@ const SimTK::State& Manager::integrate(double finalTime)
         }
 
         time = _integ->getState().getTime();
+
+        if (_realTimeFactor > 0) {
+            const Clock::time_point target = wallStart +
+                    std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(
+                                    (time - initialTime) / _realTimeFactor));
+            const Clock::time_point now = Clock::now();
+            if (now < target) {
+                std::this_thread::sleep_until(target);
+            } else {
+                const double lag =
+                        std::chrono::duration<double>(now - target).count();
+                _maxRealTimeLag = std::max(_maxRealTimeLag, lag);
+                if (lag > _realTimeTolerance) {
+                    if (_numRealTimeOverruns == 0) {
+                        log_warn("Manager::integrate(): the simulation fell "
+                                 "behind real time by {} s at time {}.",
+                                lag, time);
+                    }
+                    ++_numRealTimeOverruns;
+                }
+            }
+        }
+
         // CHECK FOR INTERRUPT
         if (checkHalt()) break;
     }
@@ -752,14 +935,174 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     record(_integ->getState(), -1);
 
+    if (_numRealTimeOverruns > 0) {
+        log_warn("Manager::integrate(): {} steps fell behind real time by "
+                 "more than {} s (at most {} s).",
+                _numRealTimeOverruns, _realTimeTolerance, _maxRealTimeLag);
+    }
+
     return getState();
 }
 
+const SimTK::State& Manager::step(double dt, int numSubsteps)
+{
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+            "Manager::step(): Manager has not been initialized. Call "
+            "Manager::initialize() first.");
+    OPENSIM_THROW_IF(!(dt > 0), Exception,
+            "Manager::step(): Expected a positive time step, but got {}.", dt);
+    OPENSIM_THROW_IF(numSubsteps < 1, Exception,
+            "Manager::step(): Expected at least one substep, but got {}.",
+            numSubsteps);
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    // integrate() may have changed these settings.
+    const double initialTime = _integ->getState().getTime();
+    const double finalTime = initialTime + dt;
+    _integ->setFinalTime(SimTK::Infinity);
+    _integ->setReturnEveryInternalStep(false);
+    _integ->setFixedStepSize(dt / numSubsteps);
+    if (_maxSubsteps > 0) _integ->setInternalStepLimit(_maxSubsteps);
+
+    // The TimeStepper returns early at significant events.
+    bool complete = true;
+    while (_integ->getState().getTime() < finalTime) {
+        const auto status = _timeStepper->stepTo(finalTime);
+        if (status == SimTK::Integrator::ReachedStepLimit) {
+            complete = _integ->getState().getTime() >= finalTime;
+            break;
+        }
+        if (_integ->isSimulationOver()) {
+            OPENSIM_THROW(Exception, "Manager::step(): Integration failed: "
+                    "{}.", _integ->getTerminationReasonString(
+                            _integ->getTerminationReason()));
+        }
+    }
+
+    const double wallTime =
+            std::chrono::duration<double>(Clock::now() - start).count();
+    StepStatistics& stats = _stepStatistics;
+    ++stats.numSteps;
+    if (!complete) ++stats.numIncompleteSteps;
+    stats.lastWallTime = wallTime;
+    stats.meanWallTime += (wallTime - stats.meanWallTime) / stats.numSteps;
+    stats.maxWallTime = std::max(stats.maxWallTime, wallTime);
+    _integrationWallTime += wallTime;
+
+    return getState();
+}
+
+void Manager::setMaximumSubsteps(int maxSubsteps) {
+    OPENSIM_THROW_IF(maxSubsteps < 0, Exception,
+            "Expected a nonnegative number of substeps, but got {}.",
+            maxSubsteps);
+    _maxSubsteps = maxSubsteps;
+}
+
+void Manager::setRealTimeFactor(double factor) {
+    OPENSIM_THROW_IF(!(factor >= 0), Exception,
+            "Expected a nonnegative real-time factor, but got {}.", factor);
+    _realTimeFactor = factor;
+}
+
+void Manager::setRealTimeTolerance(double tolerance) {
+    OPENSIM_THROW_IF(!(tolerance >= 0), Exception,
+            "Expected a nonnegative real-time tolerance, but got {}.",
+            tolerance);
+    _realTimeTolerance = tolerance;
+}
+
 const SimTK::State& Manager::getState() const
 {
     return _timeStepper->getState();
 }
 
+Manager::IntegrationStatistics Manager::countIntegration(
+        const SimTK::Integrator& integ, const SimTK::System& system)
+{
+    IntegrationStatistics counts;
+    counts.numStepsAttempted = integ.getNumStepsAttempted();
+    counts.numStepsTaken = integ.getNumStepsTaken();
+    counts.numRealizations = integ.getNumRealizations();
+    counts.numErrorTestFailures = integ.getNumErrorTestFailures();
+    counts.numConvergenceTestFailures = integ.getNumConvergenceTestFailures();
+    counts.numRealizationFailures = integ.getNumRealizationFailures();
+    counts.numProjections = integ.getNumProjections();
+    counts.numProjectionFailures = integ.getNumProjectionFailures();
+    for (int level = SimTK::Stage::LowestValid;
+            level <= SimTK::Stage::HighestValid; ++level) {
+        counts.numRealizationsOfStage[level] =
+                system.getNumRealizationsOfThisStage(SimTK::Stage(level));
+    }
+    counts.numHandleEventCalls = system.getNumHandleEventCalls();
+    counts.numReportEventCalls = system.getNumReportEventCalls();
+    return counts;
+}
+
+Manager::IntegrationStatistics Manager::getIntegrationStatistics() const
+{
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+            "Manager::getIntegrationStatistics(): Manager has not been "
+            "initialized. Call Manager::initialize() first.");
+    // The integrator and the System count from their construction, so
+    // report the work done since initialize().
+    IntegrationStatistics stats =
+            countIntegration(*_integ, _model->getMultibodySystem());
+    const IntegrationStatistics& base = _integrationCountersAtInitialize;
+    stats.numStepsAttempted -= base.numStepsAttempted;
+    stats.numStepsTaken -= base.numStepsTaken;
+    stats.numRealizations -= base.numRealizations;
+    stats.numErrorTestFailures -= base.numErrorTestFailures;
+    stats.numConvergenceTestFailures -= base.numConvergenceTestFailures;
+    stats.numRealizationFailures -= base.numRealizationFailures;
+    stats.numProjections -= base.numProjections;
+    stats.numProjectionFailures -= base.numProjectionFailures;
+    for (int i = 0; i < (int)stats.numRealizationsOfStage.size(); ++i) {
+        stats.numRealizationsOfStage[i] -= base.numRealizationsOfStage[i];
+    }
+    stats.numHandleEventCalls -= base.numHandleEventCalls;
+    stats.numReportEventCalls -= base.numReportEventCalls;
+    stats.integrationWallTime = _integrationWallTime;
+    stats.recordingWallTime = _recordingWallTime;
+    return stats;
+}
+
+void Manager::writeIntegrationStatistics(const std::string& fileName) const
+{
+    const IntegrationStatistics stats = getIntegrationStatistics();
+    std::ofstream file(fileName);
+    OPENSIM_THROW_IF(!file, Exception,
+            "Manager::writeIntegrationStatistics(): Could not open '{}'.",
+            fileName);
+    file << "integrator: " << getIntegrator().getMethodName() << "\n";
+    file << "num_steps_attempted: " << stats.numStepsAttempted << "\n";
+    file << "num_steps_taken: " << stats.numStepsTaken << "\n";
+    file << "num_realizations: " << stats.numRealizations << "\n";
+    file << "num_error_test_failures: " << stats.numErrorTestFailures
+         << "\n";
+    file << "num_convergence_test_failures: "
+         << stats.numConvergenceTestFailures << "\n";
+    file << "num_realization_failures: " << stats.numRealizationFailures
+         << "\n";
+    file << "num_projections: " << stats.numProjections << "\n";
+    file << "num_projection_failures: " << stats.numProjectionFailures
+         << "\n";
+    for (int level = SimTK::Stage::Topology; level <= SimTK::Stage::Report;
+            ++level) {
+        std::string stage = SimTK::Stage(level).getName();
+        std::transform(stage.begin(), stage.end(), stage.begin(),
+                [](unsigned char c) { return (char)std::tolower(c); });
+        file << "num_realizations_" << stage << ": "
+             << stats.numRealizationsOfStage[level] << "\n";
+    }
+    file << "num_handle_event_calls: " << stats.numHandleEventCalls << "\n";
+    file << "num_report_event_calls: " << stats.numReportEventCalls << "\n";
+    file << "integration_wall_time: " << stats.integrationWallTime << "\n";
+    file << "recording_wall_time: " << stats.recordingWallTime << "\n";
+}
+
 //_____________________________________________________________________________
 /**
  * return the step size when the integrator is taking fixed
@@ -820,6 +1163,10 @@ void Manager::initialize(const SimTK::State& s)
             new SimTK::TimeStepper(_model->getMultibodySystem(), *_integ));
         _timeStepper->initialize(s);
         _timeStepper->setReportAllSignificantStates(true);
+        _integrationCountersAtInitialize = countIntegration(
+                *_integ, _model->getMultibodySystem());
+        _integrationWallTime = 0;
+        _recordingWallTime = 0;
     }
 
     // Here we call the constructStorage because it is possible that
@@ -831,8 +1178,73 @@ void Manager::initialize(const SimTK::State& s)
         _controllerSet->constructStorage();
 }
 
+void Manager::writeCheckpoint(const std::string& fileName) const
+{
+    OPENSIM_THROW_IF(_timeStepper == nullptr, Exception,
+            "Manager::writeCheckpoint(): Manager has not been initialized. "
+            "Call Manager::initialize() first.");
+    const double stepSize = _integ->getNumStepsTaken() > 0
+            ? _integ->getPredictedNextStepSize() : SimTK::NaN;
+    SimulationCheckpoint checkpoint(getState(), stepSize);
+    if (hasStateStorage()) checkpoint.setStatesStorage(getStateStorage());
+    checkpoint.write(fileName);
+}
+
+void Manager::initializeFromCheckpoint(const std::string& fileName,
+        SimTK::State& state)
+{
+    const SimulationCheckpoint checkpoint =
+            SimulationCheckpoint::read(fileName);
+    checkpoint.applyTo(state);
+    if (_integ && SimTK::isFinite(checkpoint.getStepSize())) {
+        _integ->setInitialStepSize(checkpoint.getStepSize());
+    }
+    initialize(state);
+    // integrate() records the initial state again; Storage replaces the row
+    // with the same time.
+    if (_writeToStorage && hasStateStorage()) {
+        checkpoint.appendStatesStorageTo(getStateStorage());
+    }
+}
+
+bool Manager::shouldRecord(const SimTK::State& s, int status,
+        double finalTime)
+{
+    // States at which events were handled are always recorded.
+    if (status == SimTK::Integrator::ReachedScheduledEvent ||
+            status == SimTK::Integrator::ReachedEventTrigger) {
+        return true;
+    }
+    switch (getRecordingPolicy()) {
+    case RecordingPolicy::EveryStep:
+        return status == SimTK::Integrator::TimeHasAdvanced;
+    case RecordingPolicy::FixedInterval:
+        // The final state is recorded at the end of integrate().
+        return status == SimTK::Integrator::ReachedReportTime &&
+               s.getTime() < finalTime;
+    case RecordingPolicy::StateChange: {
+        if (status != SimTK::Integrator::TimeHasAdvanced) return false;
+        _model->getStateVariableValues(s, _stateValues);
+        if (_lastRecordedValues.size() != _stateValues.size()) return true;
+        for (int i = 0; i < _stateValues.size(); ++i) {
+            if (std::abs(_stateValues[i] - _lastRecordedValues[i]) >
+                    _recordingStateChangeThreshold) {
+                return true;
+            }
+        }
+        return false;
+    }
+    }
+    return true;
+}
+
 void Manager::record(const SimTK::State& s, const int& step)
 {
+    const auto start = std::chrono::steady_clock::now();
+    if (getRecordingPolicy() == RecordingPolicy::StateChange) {
+        _model->getStateVariableValues(s, _lastRecordedValues);
+    }
+
     // ANALYSES
     if (_performAnalyses) {
         AnalysisSet& analysisSet = _model->updAnalysisSet();
@@ -844,14 +1256,16 @@ void Manager::record(const SimTK::State& s, const int& step)
             analysisSet.step(s, step);
     }
     if (_writeToStorage) {
-        SimTK::Vector stateValues = _model->getStateVariableValues(s);
+        _model->getStateVariableValues(s, _stateValues);
         StateVector vec;
-        vec.setStates(s.getTime(), stateValues);
+        vec.setStates(s.getTime(), _stateValues);
         getStateStorage().append(vec);
         if (_model->isControlled())
             _controllerSet->storeControls(s,
                 (step < 0) ? getStateStorage().getSize() : step);
     }
+    _recordingWallTime += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
 }
 
 //=============================================================================
@@ -32,6 +32,7 @@
 #include <OpenSim/Common/Array.h>
 #include "OpenSim/Common/TimeSeriesTable.h"
 #include <OpenSim/Simulation/osimSimulationDLL.h>
+#include "IntegratorAccuracyPolicy.h"
 #include <SimTKcommon/internal/ReferencePtr.h>
 
 namespace SimTK {
@@ -68,6 +69,49 @@ class ControllerSet;
  */
 class OSIMSIMULATION_API Manager
 {
+public:
+    /** Wall-clock timing of the calls to step() since initialize() (or
+    resetStepStatistics()), in seconds. */
+    struct StepStatistics {
+        int numSteps = 0;
+        /** Calls to step() that ended before the requested time because the
+        limit on the number of internal steps was reached. */
+        int numIncompleteSteps = 0;
+        double lastWallTime = 0;
+        double meanWallTime = 0;
+        double maxWallTime = 0;
+    };
+
+    /** Work done by the integrator and the System since initialize(), for
+    any IntegratorMethod, and where the wall-clock time went; see
+    getIntegrationStatistics(). */
+    struct IntegrationStatistics {
+        /** Integrator counters (see SimTK::Integrator). Projection counts
+        include both q and u projections. */
+        int numStepsAttempted = 0;
+        int numStepsTaken = 0;
+        int numRealizations = 0;
+        int numErrorTestFailures = 0;
+        int numConvergenceTestFailures = 0;
+        int numRealizationFailures = 0;
+        int numProjections = 0;
+        int numProjectionFailures = 0;
+        /** Realizations of each stage of the System, indexed by the stage
+        level (e.g., `numRealizationsOfStage[SimTK::Stage::Dynamics]`). These
+        include the realizations requested by analyses and controllers. */
+        std::vector<int> numRealizationsOfStage =
+                std::vector<int>(SimTK::Stage::NValid, 0);
+        /** Calls to handle triggered or scheduled events, and to report
+        events. */
+        int numHandleEventCalls = 0;
+        int numReportEventCalls = 0;
+        /** Wall-clock time, in seconds, spent in the integrator (during
+        integrate() and step()) and spent recording states and running
+        analyses. */
+        double integrationWallTime = 0;
+        double recordingWallTime = 0;
+    };
+
 
 //=============================================================================
 // DATA
@@ -115,6 +159,52 @@ private:
     /** flag indicating if manager should write to storage  each step */
     bool _writeToStorage;
 
+    /** Which integration steps are written to storage; see
+    setRecordingPolicy(). */
+    int _recordingPolicy;
+    double _recordingInterval;
+    double _recordingStateChangeThreshold;
+    /** State variable values of the last state written to storage, and a
+    buffer for the values of the current state. */
+    SimTK::Vector _lastRecordedValues;
+    SimTK::Vector _stateValues;
+
+    /** File to which checkpoints are written during integrate(), and the
+    simulated time between checkpoints (NaN: no checkpoints). */
+    std::string _checkpointFile;
+    double _checkpointInterval;
+
+    /** Ratio of simulated time to wall-clock time that integrate() is paced
+    to (0: not paced), the wall-clock time by which the simulation may lag
+    before a step counts as an overrun, and the number of overruns during
+    the last call to integrate(). */
+    double _realTimeFactor;
+    double _realTimeTolerance;
+    int _numRealTimeOverruns;
+    double _maxRealTimeLag;
+
+    /** Limit on the internal steps taken by step() (0: none), and the timing
+    of the calls to step(). */
+    int _maxSubsteps;
+    StepStatistics _stepStatistics;
+
+    /** Integrator and System counters when the Manager was initialized, and
+    the wall-clock time spent integrating and recording since then. */
+    IntegrationStatistics _integrationCountersAtInitialize;
+    double _integrationWallTime;
+    double _recordingWallTime;
+    static IntegrationStatistics countIntegration(
+            const SimTK::Integrator& integ, const SimTK::System& system);
+
+    /** The integrator method (an IntegratorMethod), so that the comparison
+    run of the accuracy policy uses the same method. */
+    int _integMethod;
+    /** Phase-dependent integrator settings (none by default), the index of
+    the active phase (-1: default settings), and step counts per phase. */
+    std::unique_ptr<IntegratorAccuracyPolicy> _accuracyPolicy;
+    int _activeAccuracyPhase;
+    IntegratorAccuracyPolicy::Statistics _accuracyPolicyStatistics;
+
     /** controllerSet used for the integration */
     SimTK::ReferencePtr<ControllerSet> _controllerSet;
 
@@ -163,6 +253,137 @@ public:
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
 
+    /** @name Configure which states are recorded
+      * These settings determine which states are written to the states
+      * Storage (and, if the model is controlled, for which states the
+      * controls are stored) and are passed to the model's analyses. The
+      * initial and final states of each call to integrate() are always
+      * recorded.
+      * @{ */
+
+    /** Supported recording policies. For MATLAB, int's must be used rather
+        than enum's. */
+    enum class RecordingPolicy {
+        /// 0 : Record the state after every integration step (default).
+        EveryStep     = 0,
+        /// 1 : Record states at times separated by the recording interval
+        /// (see setRecordingInterval()). The integrator takes steps as usual
+        /// and provides the state at each recording time by interpolating
+        /// within its step, so many fewer states are recorded for stiff
+        /// simulations (e.g., with contact) that take small steps.
+        FixedInterval = 1,
+        /// 2 : Record a state only if a state variable has changed by more
+        /// than the threshold (see setRecordingStateChangeThreshold()) since
+        /// the previous recorded state.
+        StateChange   = 2
+    };
+
+    /** %Set the recording policy. Regardless of the policy, the states at
+    which an event was handled (e.g., by a SimTK::EventHandler) are recorded.
+    The FixedInterval and StateChange policies cannot be used with
+    setUseSpecifiedDT() or setUseConstantDT(). */
+    void setRecordingPolicy(RecordingPolicy policy)
+    {   _recordingPolicy = static_cast<int>(policy); }
+    RecordingPolicy getRecordingPolicy() const
+    {   return static_cast<RecordingPolicy>(_recordingPolicy); }
+    /** The time between recorded states for the FixedInterval policy. */
+    void setRecordingInterval(double interval)
+    {   _recordingInterval = interval; }
+    double getRecordingInterval() const { return _recordingInterval; }
+    /** The change in any state variable, since the last recorded state, that
+    causes a state to be recorded for the StateChange policy. The threshold
+    applies to each state variable in its own units (e.g., radians or meters).
+    */
+    void setRecordingStateChangeThreshold(double threshold)
+    {   _recordingStateChangeThreshold = threshold; }
+    double getRecordingStateChangeThreshold() const
+    {   return _recordingStateChangeThreshold; }
+    /** @} */
+
+    /** @name Checkpoints
+      * A long simulation can write checkpoints (see SimulationCheckpoint)
+      * to a file while it runs, so that it can be resumed if the process is
+      * terminated:
+      * @code
+      * Manager manager(model);
+      * manager.setCheckpointFile("walking.ckpt");
+      * manager.setCheckpointInterval(0.5);
+      * if (std::ifstream("walking.ckpt")) {
+      *     manager.initializeFromCheckpoint("walking.ckpt", state);
+      * } else {
+      *     manager.initialize(state);
+      * }
+      * state = manager.integrate(20.0);
+      * @endcode
+      * The controls stored by the model's controllers and the results of
+      * analyses are not part of a checkpoint.
+      * @{ */
+
+    /** The file to which integrate() writes checkpoints, overwriting the
+    previous checkpoint each time. */
+    void setCheckpointFile(const std::string& fileName)
+    {   _checkpointFile = fileName; }
+    const std::string& getCheckpointFile() const { return _checkpointFile; }
+    /** The simulated time between checkpoints. A checkpoint is written after
+    the first integration step that reaches each multiple of the interval.
+    Checkpoints are written only if both the file and a positive interval
+    are set (by default, no checkpoints are written). */
+    void setCheckpointInterval(double interval)
+    {   _checkpointInterval = interval; }
+    double getCheckpointInterval() const { return _checkpointInterval; }
+
+    /** Write a checkpoint of the current state, the integrator's step size,
+    and the states recorded so far. You must call initialize() before calling
+    this function. */
+    void writeCheckpoint(const std::string& fileName) const;
+
+    /** Initialize the Manager to resume the simulation from a checkpoint.
+    The time and state variables of `state` are set from the checkpoint, the
+    states recorded before the checkpoint was written are restored to the
+    states Storage, and the integrator resumes with the step size it would
+    have taken next. Call this function instead of initialize(); `state`
+    must belong to the same model (e.g., from Model::initSystem()). */
+    void initializeFromCheckpoint(const std::string& fileName,
+            SimTK::State& state);
+    /** @} */
+
+    /** @name Real-time pacing
+      * For hardware-in-the-loop simulations, integrate() can be paced so
+      * that simulated time advances no faster than wall-clock time (scaled by
+      * the real-time factor). After each integration step, integrate() sleeps
+      * until the wall-clock time for the step's simulated time has been
+      * reached. If integration falls behind by more than the tolerance, the
+      * step counts as an overrun; the simulation is not slowed down further
+      * to catch up. Pacing is only as fine as the integration steps, so
+      * consider limiting the maximum step size (setIntegratorMaximumStepSize()).
+      * Controls can be streamed into a paced simulation from another thread
+      * with a StreamingController.
+      * @code
+      * Manager manager(model);
+      * manager.setRealTimeFactor(1.0);
+      * manager.setIntegratorMaximumStepSize(0.005);
+      * manager.initialize(state);
+      * manager.integrate(10.0);
+      * if (manager.getNumRealTimeOverruns()) { ... }
+      * @endcode
+      * @{ */
+
+    /** The ratio of simulated time to wall-clock time (e.g., 0.5 runs the
+    simulation at half speed). A value of 0 (the default) disables pacing. */
+    void setRealTimeFactor(double factor);
+    double getRealTimeFactor() const { return _realTimeFactor; }
+    /** The wall-clock time, in seconds, by which the simulation may lag
+    behind before a step counts as an overrun (default: 0.005 s). */
+    void setRealTimeTolerance(double tolerance);
+    double getRealTimeTolerance() const { return _realTimeTolerance; }
+    /** The number of integration steps during the last call to integrate()
+    that finished later than the tolerance allows. */
+    int getNumRealTimeOverruns() const { return _numRealTimeOverruns; }
+    /** The largest wall-clock time, in seconds, by which the simulation
+    lagged behind during the last call to integrate(). */
+    double getMaxRealTimeLag() const { return _maxRealTimeLag; }
+    /** @} */
+
     /** @name Configure the Integrator
       * @note Call these functions before calling `Manager::initialize()`.
       * @{ */
@@ -225,6 +446,23 @@ public:
     * For more details, see `SimTK::Integrator::setMaximumStepSize(SimTK::Real)`. */
     void setIntegratorMaximumStepSize(double hmax);
 
+    /** Change the accuracy and maximum step size of the integrator during
+      * integrate() according to the phase of the simulation; see
+      * IntegratorAccuracyPolicy. The policy replaces the settings from
+      * setIntegratorAccuracy() and setIntegratorMaximumStepSize(), and it is
+      * not applied with specified or constant time steps, or by step().
+      * Setting a policy resets getIntegratorAccuracyPolicyStatistics().
+      * @throws Exception if the integrator method does not support error
+      * control. */
+    void setIntegratorAccuracyPolicy(const IntegratorAccuracyPolicy& policy);
+    bool hasIntegratorAccuracyPolicy() const
+    {   return _accuracyPolicy != nullptr; }
+    /** The number of steps taken by integrate() in each phase of the
+      * accuracy policy since the policy was set. */
+    const IntegratorAccuracyPolicy::Statistics&
+    getIntegratorAccuracyPolicyStatistics() const
+    {   return _accuracyPolicyStatistics; }
+
     /** Sets the limit of steps the integrator can take per call of `stepTo()`.
       * Note that Manager::integrate() calls `stepTo()` for each interval when a fixed
       * step size is used.
@@ -330,6 +568,58 @@ public:
     */
     const SimTK::State& integrate(double finalTime);
 
+    /** Advance the simulation by `dt` using `numSubsteps` fixed internal
+    integrator steps of size `dt / numSubsteps`, and return the new state.
+    This is meant for co-simulation and real-time control loops (e.g.,
+    calling step(0.001) at 1 kHz): unlike integrate(), it does not record
+    states or run analyses, so after the first call it performs no memory
+    allocation of its own. The integrator's error control is not used (the
+    steps have a fixed size); Events are still handled, so a step may take
+    additional internal steps to localize them, up to the limit set with
+    setMaximumSubsteps(). Call initialize() before calling this function.
+    Since step() configures the integrator for fixed steps, do not mix calls
+    to step() and integrate() with the same Manager.
+    @code
+    Manager manager(model);
+    manager.setIntegratorMethod(Manager::IntegratorMethod::RungeKutta2);
+    manager.initialize(state);
+    while (running) {
+        // ... set the controls from the hardware ...
+        const SimTK::State& s = manager.step(0.001);
+    }
+    log_info("mean step: {} s", manager.getStepStatistics().meanWallTime);
+    @endcode */
+    const SimTK::State& step(double dt, int numSubsteps = 1);
+
+    /** Limit the number of internal integrator steps that a single call to
+    step() may take (default: 0, no limit). If the limit is reached, step()
+    returns early and the step is counted in
+    StepStatistics::numIncompleteSteps. This replaces the limit set with
+    setIntegratorInternalStepLimit(). */
+    void setMaximumSubsteps(int maxSubsteps);
+    int getMaximumSubsteps() const { return _maxSubsteps; }
+
+    const StepStatistics& getStepStatistics() const
+    {   return _stepStatistics; }
+    void resetStepStatistics() { _stepStatistics = StepStatistics(); }
+
+    /** Statistics of the integration since initialize(), regardless of the
+    IntegratorMethod: the steps attempted and taken, the error-test and
+    projection failures, the realizations of each stage, the events handled,
+    and the wall-clock time spent integrating versus recording.
+    @code
+    manager.initialize(state);
+    manager.integrate(1.0);
+    const auto stats = manager.getIntegrationStatistics();
+    log_info("{} steps, {} s recording", stats.numStepsTaken,
+            stats.recordingWallTime);
+    @endcode */
+    IntegrationStatistics getIntegrationStatistics() const;
+
+    /** Write getIntegrationStatistics() to a text file, one `name: value`
+    entry per line. */
+    void writeIntegrationStatistics(const std::string& fileName) const;
+
     /** Get the current State from the Integrator associated with this 
       * Manager. */
     const SimTK::State& getState() const;
@@ -363,6 +653,21 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // Whether the state returned by the TimeStepper with the given status
+    // should be recorded, according to the recording policy.
+    bool shouldRecord(const SimTK::State& s, int status, double finalTime);
+
+    static SimTK::Integrator* createIntegrator(IntegratorMethod integMethod,
+            const SimTK::System& sys);
+
+    // Apply the settings of the accuracy policy's phase that is active at the
+    // integrator's current state.
+    void updateAccuracyPhase();
+
+    // Number of steps taken when integrating from the integrator's current
+    // state to finalTime with the tightest settings of the accuracy policy.
+    int countStepsWithFixedAccuracy(double finalTime) const;
+
 //=============================================================================
 };  // END of class Manager
 
@@ -0,0 +1,196 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ManagerEnsemble.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ManagerEnsemble.h"
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Common/CommonUtilities.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "simmath/Integrator.h"
+
+using namespace OpenSim;
+
+ManagerEnsemble::ManagerEnsemble(const Model& model) : m_model(model) {}
+
+ManagerEnsemble::Run& ManagerEnsemble::addRun(
+        const SimTK::State& initialState, double finalTime) {
+    Run run;
+    run.initialState = initialState;
+    run.finalTime = finalTime;
+    m_runs.push_back(std::move(run));
+    return m_runs.back();
+}
+
+std::vector<ManagerEnsemble::RunResult> ManagerEnsemble::integrate() const {
+    for (int i = 0; i < getNumRuns(); ++i) {
+        const Run& run = m_runs[i];
+        OPENSIM_THROW_IF(SimTK::isNaN(run.finalTime) ||
+                                 run.finalTime < run.initialState.getTime(),
+                Exception,
+                "Expected the final time of run {} to be at or after its "
+                "initial time ({}), but got {}.",
+                i, run.initialState.getTime(), run.finalTime);
+        OPENSIM_THROW_IF(run.haltCondition && !(m_reportInterval > 0),
+                Exception,
+                "Run {} has a halt condition, which requires a positive "
+                "report interval.",
+                i);
+    }
+
+    const int numRuns = getNumRuns();
+    int numThreads = m_numThreads;
+    if (numThreads <= 0) {
+        numThreads = getNumAvailableThreads();
+    }
+    numThreads = std::max(1, std::min(numThreads, numRuns));
+    const ThreadReservation reservation(numThreads);
+
+    log_info("ManagerEnsemble: integrating {} runs with {} threads.", numRuns,
+            numThreads);
+
+    std::vector<RunResult> results(numRuns);
+    std::atomic<int> nextRun(0);
+    auto worker = [&]() {
+        // Copying the model concurrently from several threads is not known to
+        // be safe (the model may cache data), so copies are made one at a
+        // time. Each worker reuses its copy for all runs without a
+        // modelModifier.
+        static std::mutex copyMutex;
+        auto copyModel = [this]() {
+            std::lock_guard<std::mutex> lock(copyMutex);
+            return std::unique_ptr<Model>(m_model.clone());
+        };
+        std::unique_ptr<Model> model;
+        SimTK::State defaultState;
+
+        int index;
+        while ((index = nextRun++) < numRuns) {
+            const Run& run = m_runs[index];
+            RunResult& result = results[index];
+            try {
+                if (run.modelModifier) {
+                    std::unique_ptr<Model> runModel = copyModel();
+                    run.modelModifier(*runModel);
+                    const SimTK::State& runState = runModel->initSystem();
+                    integrateRun(run, *runModel, runState, result);
+                } else {
+                    if (!model) {
+                        model = copyModel();
+                        defaultState = model->initSystemFrom(m_model);
+                    }
+                    integrateRun(run, *model, defaultState, result);
+                }
+            } catch (const std::exception& e) {
+                result.success = false;
+                result.errorMessage = e.what();
+                log_error("ManagerEnsemble: run {} failed: {}", index,
+                        e.what());
+            }
+        }
+    };
+
+    if (numThreads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; ++i) threads.emplace_back(worker);
+        for (auto& thread : threads) thread.join();
+    }
+    return results;
+}
+
+void ManagerEnsemble::integrateRun(const Run& run, Model& model,
+        const SimTK::State& defaultState, RunResult& result) const {
+    const SimTK::State& initial = run.initialState;
+    OPENSIM_THROW_IF(initial.getNQ() != defaultState.getNQ() ||
+                             initial.getNU() != defaultState.getNU() ||
+                             initial.getNZ() != defaultState.getNZ(),
+            Exception,
+            "Expected the initial state to have {} q's, {} u's and {} z's "
+            "(as the model does), but it has {}, {} and {}.",
+            defaultState.getNQ(), defaultState.getNU(), defaultState.getNZ(),
+            initial.getNQ(), initial.getNU(), initial.getNZ());
+
+    SimTK::State state = defaultState;
+    state.setTime(initial.getTime());
+    state.setY(initial.getY());
+
+    Manager manager(model);
+    manager.setWriteToStorage(false);
+    manager.setPerformAnalyses(false);
+    manager.setIntegratorMethod(m_integratorMethod);
+    if (!SimTK::isNaN(m_integratorAccuracy)) {
+        manager.setIntegratorAccuracy(m_integratorAccuracy);
+    }
+    if (!SimTK::isNaN(m_integratorMaximumStepSize)) {
+        manager.setIntegratorMaximumStepSize(m_integratorMaximumStepSize);
+    }
+    manager.initialize(state);
+
+    if (m_recordTrajectories) {
+        result.trajectory.append(createResultState(run, state));
+    }
+
+    const double initialTime = initial.getTime();
+    const SimTK::Integrator& integ = manager.getIntegrator();
+    int interval = 0;
+    while (true) {
+        double stepToTime = run.finalTime;
+        if (m_reportInterval > 0) {
+            ++interval;
+            stepToTime = std::min(
+                    initialTime + interval * m_reportInterval, run.finalTime);
+        }
+        const SimTK::State& current = manager.integrate(stepToTime);
+        const double time = current.getTime();
+
+        result.finalState = createResultState(run, current);
+        if (m_recordTrajectories && time > result.trajectory.back().getTime()) {
+            result.trajectory.append(result.finalState);
+        }
+
+        if (integ.isSimulationOver() &&
+                integ.getTerminationReason() !=
+                        SimTK::Integrator::ReachedFinalTime) {
+            result.errorMessage = fmt::format(
+                    "Integration failed at time {}: {}", time,
+                    SimTK::Integrator::getTerminationReasonString(
+                            integ.getTerminationReason()));
+            return;
+        }
+        if (run.haltCondition && run.haltCondition(result.finalState)) {
+            result.halted = true;
+            break;
+        }
+        if (stepToTime >= run.finalTime) break;
+    }
+    result.success = true;
+}
+
+SimTK::State ManagerEnsemble::createResultState(
+        const Run& run, const SimTK::State& state) const {
+    SimTK::State resultState = run.initialState;
+    resultState.setTime(state.getTime());
+    resultState.setY(state.getY());
+    return resultState;
+}
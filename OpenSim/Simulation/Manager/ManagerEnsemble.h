@@ -0,0 +1,171 @@
+#ifndef OPENSIM_MANAGER_ENSEMBLE_H_
+#define OPENSIM_MANAGER_ENSEMBLE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ManagerEnsemble.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+#include <OpenSim/Simulation/StatesTrajectory.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** Integrate many forward simulations of the same model (e.g., a Monte Carlo
+study over perturbed initial states or controller gains) on a pool of threads.
+
+Each worker thread clones and initializes the model once (see
+Model::initSystemFrom()) and then uses its copy for all of the runs it is
+assigned. A run whose model must be changed
+(e.g., a different controller gain) can provide a `modelModifier`; such runs
+are integrated with a copy of the model that is made, modified, and
+initialized for that run alone.
+
+The initial states must be consistent with the model given to the
+constructor (e.g., obtained from `model.initSystem()` and then edited). Only
+the time and the continuous state variables (q, u, and z) of the initial
+states are used; the remaining (discrete) variables come from the default
+state of the copy of the model. Likewise, the states in the results are
+copies of the run's initial state whose time and continuous variables have
+been updated, so they can be used with the original model.
+
+@code
+Model model("pendulum.osim");
+SimTK::State state = model.initSystem();
+ManagerEnsemble ensemble(model);
+ensemble.setReportInterval(0.01);
+for (int i = 0; i < 1000; ++i) {
+    model.getCoordinateSet()[0].setValue(state, 0.001 * i);
+    auto& run = ensemble.addRun(state, 1.0);
+    // Stop once the pendulum passes the vertical.
+    run.haltCondition = [&model](const SimTK::State& s) {
+        return model.getCoordinateSet()[0].getValue(s) < 0;
+    };
+}
+auto results = ensemble.integrate();
+@endcode
+
+@note Halt conditions are evaluated concurrently by the worker threads. The
+state passed to the condition is consistent with the original model, but it
+has not been realized; read state variables from it (as above) rather than
+realizing the original model, whose system is shared by all threads. */
+class OSIMSIMULATION_API ManagerEnsemble {
+public:
+    /** A single simulation of the ensemble. */
+    struct Run {
+        /// The simulation starts at the time of this state.
+        SimTK::State initialState;
+        double finalTime = SimTK::NaN;
+        /// (Optional) Change a copy of the model for this run only. The
+        /// model is initialized after the function is invoked.
+        std::function<void(Model&)> modelModifier;
+        /// (Optional) Stop the run early once this function returns true.
+        /// The condition is checked after each report interval; see
+        /// setReportInterval().
+        std::function<bool(const SimTK::State&)> haltCondition;
+    };
+
+    /** The outcome of a run. A run that threw an exception or whose
+    integration failed has `success` set to false and a nonempty
+    `errorMessage`; the states up to the point of failure are retained. */
+    struct RunResult {
+        bool success = false;
+        /// Whether the run was stopped by its halt condition.
+        bool halted = false;
+        std::string errorMessage;
+        SimTK::State finalState;
+        /// The initial state, the state at the end of each report interval,
+        /// and the final state. Empty unless trajectories are recorded; see
+        /// setRecordTrajectories().
+        StatesTrajectory trajectory;
+    };
+
+    /** The model is copied when integrate() is called, not here; it must
+    outlive this object and must not be edited while integrate() runs. */
+    explicit ManagerEnsemble(const Model& model);
+
+    /** Add a run and return it so it can be customized further. */
+    Run& addRun(const SimTK::State& initialState, double finalTime);
+    void addRun(Run run) { m_runs.push_back(std::move(run)); }
+    int getNumRuns() const { return (int)m_runs.size(); }
+    Run& updRun(int index) { return m_runs.at(index); }
+    void clearRuns() { m_runs.clear(); }
+
+    /** The number of threads used to integrate the runs. The default (0)
+    uses the number of hardware threads. At most one thread per run is
+    used. */
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+    int getNumThreads() const { return m_numThreads; }
+
+    /** The interval at which states are recorded and halt conditions are
+    checked. With the default (0), each run is integrated to its final time
+    in a single call to Manager::integrate(), and only the initial and final
+    states are recorded. A positive interval is required if any run has a
+    halt condition. */
+    void setReportInterval(double interval) { m_reportInterval = interval; }
+    double getReportInterval() const { return m_reportInterval; }
+
+    /** Whether the results contain the trajectory of each run, or only the
+    final state (default: true). */
+    void setRecordTrajectories(bool tf) { m_recordTrajectories = tf; }
+    bool getRecordTrajectories() const { return m_recordTrajectories; }
+
+    /** @name Configure the integrators
+    These settings are applied to the Manager of every run.
+    @{ */
+    void setIntegratorMethod(Manager::IntegratorMethod method) {
+        m_integratorMethod = method;
+    }
+    void setIntegratorAccuracy(double accuracy) {
+        m_integratorAccuracy = accuracy;
+    }
+    void setIntegratorMaximumStepSize(double hmax) {
+        m_integratorMaximumStepSize = hmax;
+    }
+    /** @} */
+
+    /** Integrate all runs and return their results, in the order in which
+    the runs were added. Failures of individual runs are reported in the
+    results rather than thrown. */
+    std::vector<RunResult> integrate() const;
+
+private:
+    void integrateRun(const Run& run, Model& model,
+            const SimTK::State& defaultState, RunResult& result) const;
+    SimTK::State createResultState(
+            const Run& run, const SimTK::State& state) const;
+
+    const Model& m_model;
+    std::vector<Run> m_runs;
+    int m_numThreads = 0;
+    double m_reportInterval = 0;
+    bool m_recordTrajectories = true;
+    Manager::IntegratorMethod m_integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double m_integratorAccuracy = SimTK::NaN;
+    double m_integratorMaximumStepSize = SimTK::NaN;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MANAGER_ENSEMBLE_H_
@@ -0,0 +1,190 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  ModelBatch.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelBatch.h"
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace OpenSim;
+
+namespace {
+// out = a + c * b, over the contiguous storage of the matrices.
+void addScaled(const SimTK::Matrix& a, double c, const SimTK::Matrix& b,
+        SimTK::Matrix& out) {
+    const int n = a.nrow() * a.ncol();
+    const double* pa = &a(0, 0);
+    const double* pb = &b(0, 0);
+    double* pout = &out(0, 0);
+    for (int i = 0; i < n; ++i) pout[i] = pa[i] + c * pb[i];
+}
+} // anonymous namespace
+
+ModelBatch::ModelBatch(const Model& model, int numInstances, int numThreads)
+        : m_numInstances(numInstances) {
+    OPENSIM_THROW_IF(!model.isValidSystem(), Exception,
+            "ModelBatch: the model must be initialized (e.g., with "
+            "initSystem()) first.");
+    OPENSIM_THROW_IF(numInstances < 1, Exception,
+            "ModelBatch: expected at least one instance, but got {}.",
+            numInstances);
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    m_numThreads = std::min(numThreads, numInstances);
+    m_numControls = model.getNumControls();
+
+    // Copying the model concurrently is not known to be safe, so the copies
+    // are made here.
+    for (int t = 0; t < m_numThreads; ++t) {
+        m_models.emplace_back(model.clone());
+        m_states.push_back(m_models.back()->initSystemFrom(model));
+    }
+    m_template = model.getWorkingState();
+    setStates(m_template);
+
+    const int ny = m_template.getNY();
+    for (SimTK::Matrix* m : {&m_k1, &m_k2, &m_k3, &m_k4, &m_Ytmp}) {
+        m->resize(numInstances, ny);
+    }
+}
+
+ModelBatch::~ModelBatch() = default;
+
+void ModelBatch::setStates(const SimTK::State& state) {
+    m_template = state;
+    m_time = state.getTime();
+    m_Y.resize(m_numInstances, state.getNY());
+    for (int i = 0; i < m_numInstances; ++i) m_Y[i] = ~state.getY();
+    // Copy the discrete variables into each thread's state.
+    for (auto& s : m_states) {
+        for (SimTK::SubsystemIndex sx(0); sx < s.getNumSubsystems(); ++sx) {
+            for (SimTK::DiscreteVariableIndex dx(0);
+                    dx < s.getNumDiscreteVariables(sx); ++dx) {
+                s.updDiscreteVariable(sx, dx) =
+                        state.getDiscreteVariable(sx, dx);
+            }
+        }
+    }
+}
+
+void ModelBatch::setState(int instance, const SimTK::State& state) {
+    OPENSIM_THROW_IF(instance < 0 || instance >= m_numInstances,
+            IndexOutOfRange, (size_t)instance, 0,
+            (size_t)m_numInstances - 1);
+    OPENSIM_THROW_IF(state.getNY() != m_Y.ncol(), Exception,
+            "ModelBatch: expected a state with {} continuous variables, but "
+            "got {}.", m_Y.ncol(), state.getNY());
+    m_Y[instance] = ~state.getY();
+}
+
+SimTK::State ModelBatch::getState(int instance) const {
+    OPENSIM_THROW_IF(instance < 0 || instance >= m_numInstances,
+            IndexOutOfRange, (size_t)instance, 0,
+            (size_t)m_numInstances - 1);
+    SimTK::State state = m_template;
+    state.setTime(m_time);
+    state.updY() = ~m_Y[instance];
+    return state;
+}
+
+void ModelBatch::setControls(const SimTK::Matrix& controls) {
+    OPENSIM_THROW_IF(controls.nrow() != 0 &&
+                    (controls.nrow() != m_numInstances ||
+                            controls.ncol() != m_numControls),
+            Exception,
+            "ModelBatch: expected a {} x {} matrix of controls, but got "
+            "{} x {}.",
+            m_numInstances, m_numControls, controls.nrow(), controls.ncol());
+    m_controls = controls;
+}
+
+void ModelBatch::calcDerivatives(
+        double time, const SimTK::Matrix& Y, SimTK::Matrix& Ydot) {
+    const bool hasControls = m_controls.nrow() > 0;
+    parallelFor(m_numThreads, [&](int t) {
+        const Model& model = *m_models[t];
+        const auto& system = model.getSystem();
+        SimTK::State& s = m_states[t];
+        SimTK::Vector controls(m_numControls);
+        const int first = (int)((long long)m_numInstances * t / m_numThreads);
+        const int last =
+                (int)((long long)m_numInstances * (t + 1) / m_numThreads);
+        for (int i = first; i < last; ++i) {
+            s.setTime(time);
+            s.updY() = ~Y[i];
+            if (hasControls) {
+                system.realize(s, SimTK::Stage::Velocity);
+                controls = ~m_controls[i];
+                model.setControls(s, controls);
+            }
+            system.realize(s, SimTK::Stage::Acceleration);
+            Ydot[i] = ~s.getYDot();
+        }
+    }, m_numThreads);
+}
+
+void ModelBatch::enforceConstraints() {
+    parallelFor(m_numThreads, [&](int t) {
+        const auto& system = m_models[t]->getSystem();
+        SimTK::State& s = m_states[t];
+        const int first = (int)((long long)m_numInstances * t / m_numThreads);
+        const int last =
+                (int)((long long)m_numInstances * (t + 1) / m_numThreads);
+        for (int i = first; i < last; ++i) {
+            s.setTime(m_time);
+            s.updY() = ~m_Y[i];
+            system.prescribe(s);
+            system.project(s, m_constraintTolerance);
+            m_Y[i] = ~s.getY();
+        }
+    }, m_numThreads);
+}
+
+void ModelBatch::step(double h) {
+    OPENSIM_THROW_IF(!(h > 0), Exception,
+            "ModelBatch: expected a positive step size, but got {}.", h);
+    const double t = m_time;
+    calcDerivatives(t, m_Y, m_k1);
+    addScaled(m_Y, 0.5 * h, m_k1, m_Ytmp);
+    calcDerivatives(t + 0.5 * h, m_Ytmp, m_k2);
+    addScaled(m_Y, 0.5 * h, m_k2, m_Ytmp);
+    calcDerivatives(t + 0.5 * h, m_Ytmp, m_k3);
+    addScaled(m_Y, h, m_k3, m_Ytmp);
+    calcDerivatives(t + h, m_Ytmp, m_k4);
+
+    // Y += h/6 (k1 + 2 k2 + 2 k3 + k4).
+    const int n = m_Y.nrow() * m_Y.ncol();
+    double* y = &m_Y(0, 0);
+    const double* k1 = &m_k1(0, 0);
+    const double* k2 = &m_k2(0, 0);
+    const double* k3 = &m_k3(0, 0);
+    const double* k4 = &m_k4(0, 0);
+    const double c = h / 6;
+    for (int i = 0; i < n; ++i) {
+        y[i] += c * (k1[i] + 2 * (k2[i] + k3[i]) + k4[i]);
+    }
+    m_time = t + h;
+    enforceConstraints();
+}
@@ -0,0 +1,124 @@
+#ifndef OPENSIM_MODEL_BATCH_H_
+#define OPENSIM_MODEL_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  ModelBatch.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon.h>
+#include <memory>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** Advance many instances of the same model in lockstep (e.g., the
+environments of a reinforcement-learning agent or the samples of a Monte Carlo
+study).
+
+The continuous state variables of all instances are stored in a single
+structure-of-arrays matrix (see getY()): row i holds the y vector of instance
+i, and, since SimTK matrices are stored by column, the values of each state
+variable for all instances are contiguous in memory. The instances share the
+time and are advanced together with the classical fixed-step 4th-order
+Runge-Kutta method; the stage updates of the Runge-Kutta method operate on
+the whole matrix at once, in loops that the compiler can vectorize. The
+derivatives of the instances are evaluated in parallel, each thread using its
+own copy of the model for a contiguous range of instances. After each step,
+prescribed motion and constraints are enforced for each instance.
+
+Optionally, the controls of each instance (e.g., an agent's actions) can be
+given with setControls(); they replace the controls computed by the model's
+controllers and are held constant during a step.
+
+@code
+Model model("pendulum.osim");
+SimTK::State state = model.initSystem();
+ModelBatch batch(model, 64);
+batch.setStates(state);
+for (int i = 0; i < 64; ++i) batch.updY()(i, 0) = 0.01 * i;
+for (int k = 0; k < 1000; ++k) {
+    batch.setControls(computeActions(batch.getY()));
+    batch.step(0.001);
+}
+@endcode
+
+Only the time and continuous state variables (q, u, and z) differ between
+instances; the discrete variables of all instances are those of the state
+given to setStates(). */
+class OSIMSIMULATION_API ModelBatch {
+public:
+    /** The model must have been initialized (e.g., with initSystem()). It is
+    copied, so it need not outlive the batch. If `numThreads` is not
+    positive, the number of hardware threads is used. */
+    ModelBatch(const Model& model, int numInstances, int numThreads = 0);
+    ~ModelBatch();
+
+    int getNumInstances() const { return m_numInstances; }
+    int getNumStateVariables() const { return (int)m_Y.ncol(); }
+    int getNumControls() const { return m_numControls; }
+    double getTime() const { return m_time; }
+
+    /** Set the time, discrete variables, and continuous state variables of
+    all instances from the given state. */
+    void setStates(const SimTK::State& state);
+    /** Set the continuous state variables of one instance. The time and the
+    discrete variables of the state are ignored. */
+    void setState(int instance, const SimTK::State& state);
+    /** A state with the time and continuous state variables of an instance,
+    for use with the model given to the constructor. */
+    SimTK::State getState(int instance) const;
+
+    /** The continuous state variables (one row per instance, in the order of
+    SimTK::State::getY()). */
+    const SimTK::Matrix& getY() const { return m_Y; }
+    SimTK::Matrix& updY() { return m_Y; }
+
+    /** Controls for each instance (one row per instance, in the order of
+    Model::getControls()). Pass an empty matrix to use the model's
+    controllers again. */
+    void setControls(const SimTK::Matrix& controls);
+
+    /** Advance all instances by h. */
+    void step(double h);
+
+private:
+    void calcDerivatives(double time, const SimTK::Matrix& Y,
+            SimTK::Matrix& Ydot);
+    void enforceConstraints();
+
+    int m_numInstances;
+    int m_numThreads;
+    int m_numControls;
+    double m_time = 0;
+    double m_constraintTolerance = 1e-8;
+    std::vector<std::unique_ptr<Model>> m_models;
+    std::vector<SimTK::State> m_states;
+    SimTK::State m_template;
+    SimTK::Matrix m_Y, m_controls;
+    // Runge-Kutta stages and work space.
+    SimTK::Matrix m_k1, m_k2, m_k3, m_k4, m_Ytmp;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MODEL_BATCH_H_
@@ -0,0 +1,277 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  SimulationCheckpoint.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimulationCheckpoint.h"
+
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/Storage.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace OpenSim;
+
+namespace {
+    const char checkpointMagic[8] = {'O', 'S', 'I', 'M', 'C', 'K', 'P', 'T'};
+    const int checkpointVersion = 1;
+
+    enum DiscreteType { Double = 0, Int = 1, Bool = 2, Vector = 3 };
+
+    template <typename T>
+    void writeValue(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void writeDoubles(std::ostream& out, const double* data, size_t size) {
+        writeValue(out, (int)size);
+        out.write(reinterpret_cast<const char*>(data), size * sizeof(double));
+    }
+    void writeString(std::ostream& out, const std::string& str) {
+        writeValue(out, (int)str.size());
+        out.write(str.data(), str.size());
+    }
+
+    template <typename T>
+    T readValue(std::istream& in) {
+        T value;
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        OPENSIM_THROW_IF(!in, Exception,
+                "Unexpected end of the checkpoint file.");
+        return value;
+    }
+    int readSize(std::istream& in) {
+        const int size = readValue<int>(in);
+        OPENSIM_THROW_IF(size < 0, Exception,
+                "The checkpoint file is corrupt.");
+        return size;
+    }
+    std::vector<double> readDoubles(std::istream& in) {
+        std::vector<double> values(readSize(in));
+        in.read(reinterpret_cast<char*>(values.data()),
+                values.size() * sizeof(double));
+        OPENSIM_THROW_IF(!in, Exception,
+                "Unexpected end of the checkpoint file.");
+        return values;
+    }
+    std::string readString(std::istream& in) {
+        std::string str(readSize(in), '\0');
+        in.read(&str[0], str.size());
+        OPENSIM_THROW_IF(!in, Exception,
+                "Unexpected end of the checkpoint file.");
+        return str;
+    }
+}
+
+SimulationCheckpoint::SimulationCheckpoint(
+        const SimTK::State& state, double stepSize)
+        : m_time(state.getTime()), m_stepSize(stepSize), m_y(state.getY()) {
+    for (SimTK::SubsystemIndex sx(0); sx < state.getNumSubsystems(); ++sx) {
+        for (SimTK::DiscreteVariableIndex dx(0);
+                dx < state.getNumDiscreteVariables(sx); ++dx) {
+            const SimTK::AbstractValue& value =
+                    state.getDiscreteVariable(sx, dx);
+            DiscreteValue dv{(int)sx, (int)dx, Double, {}};
+            if (SimTK::Value<double>::isA(value)) {
+                dv.values.push_back(
+                        SimTK::Value<double>::downcast(value).get());
+            } else if (SimTK::Value<int>::isA(value)) {
+                dv.type = Int;
+                dv.values.push_back(SimTK::Value<int>::downcast(value).get());
+            } else if (SimTK::Value<bool>::isA(value)) {
+                dv.type = Bool;
+                dv.values.push_back(SimTK::Value<bool>::downcast(value).get());
+            } else if (SimTK::Value<SimTK::Vector>::isA(value)) {
+                dv.type = Vector;
+                const auto& vec =
+                        SimTK::Value<SimTK::Vector>::downcast(value).get();
+                dv.values.assign(vec.begin(), vec.end());
+            } else {
+                continue;
+            }
+            m_discreteValues.push_back(std::move(dv));
+        }
+    }
+}
+
+void SimulationCheckpoint::applyTo(SimTK::State& state) const {
+    OPENSIM_THROW_IF(state.getNY() != m_y.size(), Exception,
+            "Expected the state to have {} continuous state variables, but it "
+            "has {}.", m_y.size(), state.getNY());
+    state.setTime(m_time);
+    state.updY() = m_y;
+    for (const auto& dv : m_discreteValues) {
+        const SimTK::SubsystemIndex sx(dv.subsystem);
+        const SimTK::DiscreteVariableIndex dx(dv.index);
+        OPENSIM_THROW_IF(dv.subsystem >= state.getNumSubsystems() ||
+                dv.index >= state.getNumDiscreteVariables(sx), Exception,
+                "The checkpoint contains a discrete variable that is not in "
+                "the state.");
+        SimTK::AbstractValue& value = state.updDiscreteVariable(sx, dx);
+        switch (dv.type) {
+        case Double:
+            OPENSIM_THROW_IF(!SimTK::Value<double>::isA(value), Exception,
+                    "Discrete variable types of the checkpoint and the state "
+                    "differ.");
+            SimTK::Value<double>::updDowncast(value) = dv.values[0];
+            break;
+        case Int:
+            OPENSIM_THROW_IF(!SimTK::Value<int>::isA(value), Exception,
+                    "Discrete variable types of the checkpoint and the state "
+                    "differ.");
+            SimTK::Value<int>::updDowncast(value) = (int)dv.values[0];
+            break;
+        case Bool:
+            OPENSIM_THROW_IF(!SimTK::Value<bool>::isA(value), Exception,
+                    "Discrete variable types of the checkpoint and the state "
+                    "differ.");
+            SimTK::Value<bool>::updDowncast(value) = dv.values[0] != 0;
+            break;
+        case Vector: {
+            OPENSIM_THROW_IF(!SimTK::Value<SimTK::Vector>::isA(value),
+                    Exception,
+                    "Discrete variable types of the checkpoint and the state "
+                    "differ.");
+            auto& vec = SimTK::Value<SimTK::Vector>::updDowncast(value).upd();
+            vec.resize((int)dv.values.size());
+            for (int i = 0; i < vec.size(); ++i) vec[i] = dv.values[i];
+            break;
+        }
+        }
+    }
+}
+
+void SimulationCheckpoint::setStatesStorage(const Storage& storage) {
+    const auto& labels = storage.getColumnLabels();
+    m_storageLabels.clear();
+    for (int i = 0; i < labels.getSize(); ++i) {
+        m_storageLabels.push_back(labels[i]);
+    }
+    m_storageTimes.clear();
+    m_storageData.clear();
+    // The first label is "time".
+    const int numColumns = (int)m_storageLabels.size() - 1;
+    for (int irow = 0; irow < storage.getSize(); ++irow) {
+        const StateVector* row = storage.getStateVector(irow);
+        m_storageTimes.push_back(row->getTime());
+        const auto& data = row->getData();
+        for (int icol = 0; icol < numColumns; ++icol) {
+            m_storageData.push_back(
+                    icol < data.getSize() ? data[icol] : SimTK::NaN);
+        }
+    }
+}
+
+void SimulationCheckpoint::appendStatesStorageTo(Storage& storage) const {
+    if (!hasStatesStorage()) return;
+    const int numColumns = (int)m_storageLabels.size() - 1;
+    OPENSIM_THROW_IF(storage.getColumnLabels().getSize() !=
+                    (int)m_storageLabels.size(), Exception,
+            "Expected a Storage with {} columns, but it has {}.",
+            m_storageLabels.size(), storage.getColumnLabels().getSize());
+    SimTK::Vector row(numColumns);
+    for (size_t irow = 0; irow < m_storageTimes.size(); ++irow) {
+        for (int icol = 0; icol < numColumns; ++icol) {
+            row[icol] = m_storageData[irow * numColumns + icol];
+        }
+        storage.append(StateVector(m_storageTimes[irow], row));
+    }
+}
+
+void SimulationCheckpoint::write(const std::string& fileName) const {
+    const std::string tempFileName = fileName + ".tmp";
+    {
+        std::ofstream out(tempFileName, std::ios::binary | std::ios::trunc);
+        OPENSIM_THROW_IF(!out, Exception,
+                "Could not open checkpoint file '{}' for writing.",
+                tempFileName);
+        out.write(checkpointMagic, sizeof(checkpointMagic));
+        writeValue(out, checkpointVersion);
+        writeValue(out, m_time);
+        writeValue(out, m_stepSize);
+        writeDoubles(out, &m_y[0], m_y.size());
+        writeValue(out, (int)m_discreteValues.size());
+        for (const auto& dv : m_discreteValues) {
+            writeValue(out, dv.subsystem);
+            writeValue(out, dv.index);
+            writeValue(out, dv.type);
+            writeDoubles(out, dv.values.data(), dv.values.size());
+        }
+        writeValue(out, (int)m_storageLabels.size());
+        for (const auto& label : m_storageLabels) writeString(out, label);
+        writeDoubles(out, m_storageTimes.data(), m_storageTimes.size());
+        writeDoubles(out, m_storageData.data(), m_storageData.size());
+        out.close();
+        OPENSIM_THROW_IF(!out, Exception,
+                "Could not write checkpoint file '{}'.", tempFileName);
+    }
+    // std::rename() does not replace an existing file on all platforms.
+    std::remove(fileName.c_str());
+    OPENSIM_THROW_IF(std::rename(tempFileName.c_str(), fileName.c_str()) != 0,
+            Exception, "Could not rename checkpoint file '{}' to '{}'.",
+            tempFileName, fileName);
+}
+
+SimulationCheckpoint SimulationCheckpoint::read(const std::string& fileName) {
+    std::ifstream in(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in, Exception, "Could not open checkpoint file '{}'.",
+            fileName);
+    char magic[sizeof(checkpointMagic)];
+    in.read(magic, sizeof(magic));
+    OPENSIM_THROW_IF(!in || !std::equal(magic, magic + sizeof(magic),
+                                    checkpointMagic),
+            Exception, "'{}' is not a checkpoint file.", fileName);
+    const int version = readValue<int>(in);
+    OPENSIM_THROW_IF(version != checkpointVersion, Exception,
+            "Checkpoint file '{}' has unsupported version {}.", fileName,
+            version);
+
+    SimulationCheckpoint checkpoint;
+    checkpoint.m_time = readValue<double>(in);
+    checkpoint.m_stepSize = readValue<double>(in);
+    const auto y = readDoubles(in);
+    checkpoint.m_y.resize((int)y.size());
+    for (int i = 0; i < (int)y.size(); ++i) checkpoint.m_y[i] = y[i];
+    const int numDiscrete = readSize(in);
+    for (int i = 0; i < numDiscrete; ++i) {
+        DiscreteValue dv;
+        dv.subsystem = readValue<int>(in);
+        dv.index = readValue<int>(in);
+        dv.type = readValue<int>(in);
+        dv.values = readDoubles(in);
+        OPENSIM_THROW_IF(dv.type < Double || dv.type > Vector ||
+                (dv.type != Vector && dv.values.size() != 1), Exception,
+                "Checkpoint file '{}' is corrupt.", fileName);
+        checkpoint.m_discreteValues.push_back(std::move(dv));
+    }
+    const int numLabels = readSize(in);
+    for (int i = 0; i < numLabels; ++i) {
+        checkpoint.m_storageLabels.push_back(readString(in));
+    }
+    checkpoint.m_storageTimes = readDoubles(in);
+    checkpoint.m_storageData = readDoubles(in);
+    const size_t numColumns =
+            numLabels > 0 ? (size_t)(numLabels - 1) : 0;
+    OPENSIM_THROW_IF(checkpoint.m_storageData.size() !=
+                    checkpoint.m_storageTimes.size() * numColumns,
+            Exception, "Checkpoint file '{}' is corrupt.", fileName);
+    return checkpoint;
+}
@@ -0,0 +1,101 @@
+#ifndef OPENSIM_SIMULATION_CHECKPOINT_H_
+#define OPENSIM_SIMULATION_CHECKPOINT_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  SimulationCheckpoint.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <SimTKcommon.h>
+
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Storage;
+
+/** A snapshot of a simulation, from which the simulation can be resumed
+(e.g., after the process running a long simulation was terminated). The
+checkpoint contains the time, the continuous state variables (Y), the values
+of the discrete variables, the step size the integrator would take next, and,
+optionally, the states recorded so far. Checkpoints are written to and read
+from a compact binary file. The file uses the byte order of the machine that
+wrote it.
+
+Discrete variables whose values are of type double, int, bool or
+SimTK::Vector are saved; discrete variables of other types keep the values
+they have in the state to which the checkpoint is applied.
+
+A Manager writes checkpoints periodically during integrate() (see
+Manager::setCheckpointFile()) and resumes from them with
+Manager::initializeFromCheckpoint(). */
+class OSIMSIMULATION_API SimulationCheckpoint {
+public:
+    SimulationCheckpoint() = default;
+    /** Capture the given state. `stepSize` is the step size with which to
+    resume the integration (NaN to let the integrator choose). */
+    explicit SimulationCheckpoint(const SimTK::State& state,
+            double stepSize = SimTK::NaN);
+
+    double getTime() const { return m_time; }
+    double getStepSize() const { return m_stepSize; }
+    const SimTK::Vector& getY() const { return m_y; }
+
+    /** %Set the time, Y and discrete variables of `state`, which must have
+    been created by the same model as the state that was captured.
+    @throws Exception if the checkpoint does not fit the state. */
+    void applyTo(SimTK::State& state) const;
+
+    /** Save the rows of a states Storage with the checkpoint. */
+    void setStatesStorage(const Storage& storage);
+    /** Append the states saved with setStatesStorage() to `storage`, which
+    should have the same columns. */
+    void appendStatesStorageTo(Storage& storage) const;
+    bool hasStatesStorage() const { return !m_storageLabels.empty(); }
+
+    /** Write the checkpoint to a file. The file is first written under a
+    temporary name and then renamed, so that an interrupted write does not
+    corrupt an existing checkpoint. */
+    void write(const std::string& fileName) const;
+    /** Read a checkpoint written with write(). */
+    static SimulationCheckpoint read(const std::string& fileName);
+
+private:
+    struct DiscreteValue {
+        int subsystem;
+        int index;
+        int type;
+        std::vector<double> values;
+    };
+
+    double m_time = SimTK::NaN;
+    double m_stepSize = SimTK::NaN;
+    SimTK::Vector m_y;
+    std::vector<DiscreteValue> m_discreteValues;
+    std::vector<std::string> m_storageLabels;
+    std::vector<double> m_storageTimes;
+    // Row-major data of the states Storage.
+    std::vector<double> m_storageData;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_SIMULATION_CHECKPOINT_H_
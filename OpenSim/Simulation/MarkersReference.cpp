@@ -156,10 +156,13 @@ const SimTK::Array_<std::string>& MarkersReference::getNames() const {
 
 void MarkersReference::getValuesAtTime(double time,
                                   SimTK::Array_<Vec3>& values) const {
-    const auto rowView = _markerTable.getNearestRow(time);
-    values.clear();
+    _rowHint = _markerTable.getNearestRowIndexForTime(time, true, _rowHint);
+    // Copy straight from a view of the row; resizing does not reallocate if
+    // the caller reuses the same Array.
+    const auto rowView = _markerTable.getRowAtIndex(_rowHint);
+    values.resize(rowView.ncol());
     for(int i = 0; i < rowView.ncol(); ++i)
-        values.push_back(rowView[i]);
+        values[i] = rowView[i];
 }
 
 // void
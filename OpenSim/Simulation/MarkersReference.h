@@ -190,6 +190,10 @@ private:
     SimTK::Array_<std::string> _markerNames;
     // List of weights guaranteed to be in the same order as marker names.
     mutable SimTK::Array_<double> _weights;
+    // Row returned by the last call to getValuesAtTime(), used as a starting
+    // point for the next lookup since the times usually advance frame by
+    // frame.
+    mutable size_t _rowHint = 0;
 //=============================================================================
 };  // END of class MarkersReference
 //=============================================================================
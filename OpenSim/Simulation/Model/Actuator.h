@@ -103,6 +103,10 @@ public:
     virtual void setControls(const SimTK::Vector& actuatorControls, SimTK::Vector& modelControls) const;
     /** add actuator controls to the values already occupying the slot in the system-wide model controls */
     virtual void addInControls(const SimTK::Vector& actuatorControls, SimTK::Vector& modelControls) const;
+    /** The index of this actuator's first control in the system-wide model
+        controls; the actuator's numControls() controls are contiguous. This is
+        valid once the actuator has been added to the system (-1 before). */
+    int getControlIndex() const { return _controlIndex; }
 
     //--------------------------------------------------------------------------
     // COMPUTATIONS
@@ -245,6 +249,11 @@ protected:
         values.append(getActuation(state));
         return values;
     }
+    int writeRecordValues(const SimTK::State& state,
+            double* values) const override {
+        values[0] = getActuation(state);
+        return 1;
+    }
 
 private:
     void constructProperties();
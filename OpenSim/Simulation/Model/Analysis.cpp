@@ -522,3 +522,14 @@ int Analysis::end(const SimTK::State& s )
     //printf("Analysis.end: %s.\n",getName());
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Get the stage to which states passed to begin(), step() and end() must be
+ * realized for this analysis to record them.
+ *
+ * Override this method in derived classes.
+ */
+SimTK::Stage Analysis::getRequiredStage() const
+{
+    return SimTK::Stage::Velocity;
+}
@@ -147,6 +147,16 @@ public:
     virtual int step( const SimTK::State& s, int stepNumber);
     virtual int end( const SimTK::State& s);
 
+    /**
+     * The stage to which a state must be realized for this analysis to
+     * record it. Tools that replay stored states (e.g., AnalyzeTool) realize
+     * each state only to the highest stage required by the analyses that are
+     * on, so an analysis that records only kinematics should not require
+     * Stage::Dynamics. The default, Stage::Velocity, is what tools have
+     * always provided; override this method if an analysis needs more or
+     * less.
+     */
+    virtual SimTK::Stage getRequiredStage() const;
 
     //--------------------------------------------------------------------------
     // GET AND SET
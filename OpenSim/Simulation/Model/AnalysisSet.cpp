@@ -237,6 +237,21 @@ void AnalysisSet:: end(const SimTK::State& s)
         if (analysis.getOn()) analysis.end(s);
     }
 }
+//_____________________________________________________________________________
+/**
+ * Get the highest stage to which a state must be realized for all of the
+ * analyses that are on to record it.
+ */
+SimTK::Stage AnalysisSet::getRequiredStage() const
+{
+    SimTK::Stage stage = SimTK::Stage::Position;
+    for(int i=0;i<getSize();i++) {
+        const Analysis& analysis = get(i);
+        if (analysis.getOn() && analysis.getRequiredStage() > stage)
+            stage = analysis.getRequiredStage();
+    }
+    return stage;
+}
 
 
 
@@ -99,6 +99,10 @@ public:
     void begin(const SimTK::State& s );
     void step(const SimTK::State& s, int stepNumber );
     void end(const SimTK::State& s );
+    /** The highest stage required by the analyses that are on
+    (Stage::Position, which any assembled state reaches, if there are none).
+    @see Analysis::getRequiredStage() */
+    SimTK::Stage getRequiredStage() const;
 
     //--------------------------------------------------------------------------
     // RESULTS
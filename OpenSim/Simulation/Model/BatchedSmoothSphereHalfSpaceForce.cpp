@@ -0,0 +1,252 @@
+/* -------------------------------------------------------------------------- *
+ *              OpenSim:  BatchedSmoothSphereHalfSpaceForce.cpp               *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BatchedSmoothSphereHalfSpaceForce.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OpenSim;
+
+//=============================================================================
+//  BATCHED SMOOTH SPHERE HALF SPACE FORCE
+//=============================================================================
+BatchedSmoothSphereHalfSpaceForce::BatchedSmoothSphereHalfSpaceForce() {
+    constructProperties();
+}
+
+BatchedSmoothSphereHalfSpaceForce::BatchedSmoothSphereHalfSpaceForce(
+        const std::string& name, const ContactHalfSpace& contactHalfSpace) {
+    setName(name);
+    connectSocket_half_space(contactHalfSpace);
+
+    constructProperties();
+}
+
+void BatchedSmoothSphereHalfSpaceForce::constructProperties() {
+    constructProperty_contact_spheres();
+    constructProperty_stiffness(1.0);
+    constructProperty_dissipation(0.0);
+    constructProperty_static_friction(0.0);
+    constructProperty_dynamic_friction(0.0);
+    constructProperty_viscous_friction(0.0);
+    constructProperty_transition_velocity(0.01);
+    constructProperty_constant_contact_force(1e-5);
+    constructProperty_hertz_smoothing(300.0);
+    constructProperty_hunt_crossley_smoothing(50.0);
+}
+
+void BatchedSmoothSphereHalfSpaceForce::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+    OPENSIM_THROW_IF_FRMOBJ(get_transition_velocity() <= 0,
+            InvalidPropertyValue, getProperty_transition_velocity().getName(),
+            "Expected a positive value.");
+}
+
+void BatchedSmoothSphereHalfSpaceForce::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    _spheres.clear();
+    for (int i = 0; i < getProperty_contact_spheres().size(); ++i) {
+        _spheres.emplace_back(
+                &model.getComponent<ContactSphere>(get_contact_spheres(i)));
+    }
+}
+
+void BatchedSmoothSphereHalfSpaceForce::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    // The default ForceAdapter calls computeForce().
+    Super::extendAddToSystem(system);
+
+    const int numSpheres = (int)_spheres.size();
+    _sphereBodies.resize(numSpheres);
+    _sphereStations.resize(numSpheres);
+    _sphereRadii.resize(numSpheres);
+    for (int i = 0; i < numSpheres; ++i) {
+        const ContactSphere& sphere = *_spheres[i];
+        _sphereBodies[i] = sphere.getFrame().getMobilizedBodyIndex();
+        _sphereStations[i] = sphere.getFrame().findTransformInBaseFrame() *
+                             sphere.get_location();
+        _sphereRadii[i] = sphere.getRadius();
+    }
+
+    const auto& halfSpace = getConnectee<ContactHalfSpace>("half_space");
+    _halfSpaceBody = halfSpace.getFrame().getMobilizedBodyIndex();
+    _halfSpaceFrameInBody = halfSpace.getFrame().findTransformInBaseFrame() *
+                            halfSpace.getTransform();
+}
+
+//=============================================================================
+//  COMPUTATIONS
+//=============================================================================
+void BatchedSmoothSphereHalfSpaceForce::calcContactForces(
+        const SimTK::State& state, SimTK::Vector_<SimTK::Vec3>& forces,
+        SimTK::Vector_<SimTK::Vec3>& points) const {
+    const auto& matter = getModel().getMatterSubsystem();
+    const int numSpheres = (int)_sphereBodies.size();
+    forces.resize(numSpheres);
+    points.resize(numSpheres);
+    if (numSpheres == 0) return;
+
+    // The half space occupies x > 0 in its own frame, so its outward normal
+    // is -x.
+    const auto& halfSpaceBody = matter.getMobilizedBody(_halfSpaceBody);
+    const SimTK::Transform& X_GH = halfSpaceBody.getBodyTransform(state);
+    const SimTK::SpatialVec& V_GH = halfSpaceBody.getBodyVelocity(state);
+    const SimTK::Transform X_GP = X_GH * _halfSpaceFrameInBody;
+    const SimTK::Vec3 normal = X_GP.R() * SimTK::Vec3(-1, 0, 0);
+
+    // Gather the kinematics of every contact into contiguous arrays: the
+    // indentation, and the velocity of the contact point on the sphere
+    // relative to the half space, split into normal and tangential parts.
+    std::vector<double> depth(numSpheres);
+    std::vector<double> normalVel(numSpheres);
+    std::vector<double> tanVelX(numSpheres);
+    std::vector<double> tanVelY(numSpheres);
+    std::vector<double> tanVelZ(numSpheres);
+    for (int i = 0; i < numSpheres; ++i) {
+        const auto& body = matter.getMobilizedBody(_sphereBodies[i]);
+        const SimTK::Transform& X_GB = body.getBodyTransform(state);
+        const SimTK::SpatialVec& V_GB = body.getBodyVelocity(state);
+        const SimTK::Vec3 center = X_GB * _sphereStations[i];
+        const double radius = _sphereRadii[i];
+        const SimTK::Vec3 point = center - radius * normal;
+        depth[i] = radius - ~normal * (center - X_GP.p());
+        points[i] = point;
+
+        const SimTK::Vec3 velocity =
+                (V_GB[1] + V_GB[0] % (point - X_GB.p())) -
+                (V_GH[1] + V_GH[0] % (point - X_GH.p()));
+        const double vn = ~velocity * normal;
+        normalVel[i] = vn;
+        tanVelX[i] = velocity[0] - vn * normal[0];
+        tanVelY[i] = velocity[1] - vn * normal[1];
+        tanVelZ[i] = velocity[2] - vn * normal[2];
+    }
+
+    // Evaluate the contact model for all spheres. The loop body only touches
+    // the arrays above, with no branches other than std::min().
+    const double k = 0.5 * std::pow(get_stiffness(), 2.0 / 3.0);
+    const double c = get_dissipation();
+    const double us = get_static_friction();
+    const double ud = get_dynamic_friction();
+    const double uv = get_viscous_friction();
+    const double vt = get_transition_velocity();
+    const double cf = get_constant_contact_force();
+    const double bd = get_hertz_smoothing();
+    const double bv = get_hunt_crossley_smoothing();
+    const double eps = 1e-16;
+    std::vector<double> normalForce(numSpheres);
+    std::vector<double> frictionPerSpeed(numSpheres);
+    for (int i = 0; i < numSpheres; ++i) {
+        const double x = depth[i];
+        // Rate of indentation.
+        const double xdot = -normalVel[i];
+        const double fH = (4.0 / 3.0) * k * std::sqrt(_sphereRadii[i] * k) *
+                          std::pow(std::sqrt(x * x + cf), 1.5);
+        const double fHs = fH * (0.5 + 0.5 * std::tanh(bd * x));
+        const double fHC = fHs * (1.0 + 1.5 * c * xdot);
+        const double fHCs = fHC *
+                (0.5 + 0.5 * std::tanh(bv * (xdot + 2.0 / (3.0 * c))));
+        const double vslip = std::sqrt(tanVelX[i] * tanVelX[i] +
+                                       tanVelY[i] * tanVelY[i] +
+                                       tanVelZ[i] * tanVelZ[i] + eps);
+        const double vrel = vslip / vt;
+        const double ffriction = fHCs *
+                (std::min(vrel, 1.0) * (ud + 2 * (us - ud) / (1 + vrel * vrel))
+                        + uv * vslip);
+        normalForce[i] = fHCs;
+        frictionPerSpeed[i] = ffriction / vslip;
+    }
+
+    for (int i = 0; i < numSpheres; ++i) {
+        forces[i] = normalForce[i] * normal -
+                    frictionPerSpeed[i] *
+                            SimTK::Vec3(tanVelX[i], tanVelY[i], tanVelZ[i]);
+    }
+}
+
+void BatchedSmoothSphereHalfSpaceForce::computeForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& /*generalizedForces*/) const {
+    SimTK::Vector_<SimTK::Vec3> forces;
+    SimTK::Vector_<SimTK::Vec3> points;
+    calcContactForces(state, forces, points);
+
+    const auto& matter = getModel().getMatterSubsystem();
+    const SimTK::Vec3& halfSpaceOrigin =
+            matter.getMobilizedBody(_halfSpaceBody).getBodyOriginLocation(
+                    state);
+    SimTK::SpatialVec halfSpaceForce(SimTK::Vec3(0), SimTK::Vec3(0));
+    for (int i = 0; i < forces.size(); ++i) {
+        const SimTK::Vec3& origin =
+                matter.getMobilizedBody(_sphereBodies[i])
+                        .getBodyOriginLocation(state);
+        bodyForces[_sphereBodies[i]] += SimTK::SpatialVec(
+                (points[i] - origin) % forces[i], forces[i]);
+        halfSpaceForce -= SimTK::SpatialVec(
+                (points[i] - halfSpaceOrigin) % forces[i], forces[i]);
+    }
+    bodyForces[_halfSpaceBody] += halfSpaceForce;
+}
+
+//=============================================================================
+//  REPORTING
+//=============================================================================
+OpenSim::Array<std::string>
+BatchedSmoothSphereHalfSpaceForce::getRecordLabels() const {
+    OpenSim::Array<std::string> labels("");
+    for (int i = 0; i < getProperty_contact_spheres().size(); ++i) {
+        const std::string prefix = getName() + "." +
+                ComponentPath(get_contact_spheres(i)).getComponentName();
+        labels.append(prefix + ".force.X");
+        labels.append(prefix + ".force.Y");
+        labels.append(prefix + ".force.Z");
+        labels.append(prefix + ".torque.X");
+        labels.append(prefix + ".torque.Y");
+        labels.append(prefix + ".torque.Z");
+    }
+    return labels;
+}
+
+OpenSim::Array<double> BatchedSmoothSphereHalfSpaceForce::getRecordValues(
+        const SimTK::State& state) const {
+    OpenSim::Array<double> values(1);
+
+    SimTK::Vector_<SimTK::Vec3> forces;
+    SimTK::Vector_<SimTK::Vec3> points;
+    calcContactForces(state, forces, points);
+
+    const auto& matter = getModel().getMatterSubsystem();
+    for (int i = 0; i < forces.size(); ++i) {
+        const SimTK::Vec3& origin =
+                matter.getMobilizedBody(_sphereBodies[i])
+                        .getBodyOriginLocation(state);
+        SimTK::Vec3 force = forces[i];
+        SimTK::Vec3 torque = (points[i] - origin) % forces[i];
+        values.append(3, &force[0]);
+        values.append(3, &torque[0]);
+    }
+    return values;
+}
@@ -0,0 +1,153 @@
+#ifndef OPENSIM_BATCHED_SMOOTH_SPHERE_HALF_SPACE_FORCE_H_
+#define OPENSIM_BATCHED_SMOOTH_SPHERE_HALF_SPACE_FORCE_H_
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  BatchedSmoothSphereHalfSpaceForce.h                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Force.h"
+#include "ContactHalfSpace.h"
+#include "ContactSphere.h"
+
+namespace OpenSim {
+
+/** Smooth contact between many spheres and a single half space, evaluated in
+one pass. The contact model is the same as that of SmoothSphereHalfSpaceForce
+(smoothed Hertz and Hunt-Crossley normal forces with a constant contact force,
+and smoothed Stribeck friction), and all spheres share the contact parameters
+of this component. Foot models typically use a dozen or more
+SmoothSphereHalfSpaceForce%s per foot, each of which is a separate Simbody
+force element that looks up its own body kinematics. This component instead
+gathers the positions and velocities of all sphere centers into contiguous
+arrays, computes every contact force in a single loop over those arrays (which
+the compiler can vectorize) and then adds all of the body forces at once.
+
+Use one BatchedSmoothSphereHalfSpaceForce per half space and set of contact
+parameters; spheres with different parameters (e.g., stiffness) need separate
+components. Because it is a regular Force, it is used by the Manager and by
+Moco like any other force element.
+
+@code
+auto* contact = new BatchedSmoothSphereHalfSpaceForce("foot_contact",
+        model.getComponent<ContactHalfSpace>("/contactgeometryset/floor"));
+contact->set_stiffness(1e6);
+contact->set_dissipation(2.0);
+contact->addContactSphere("/contactgeometryset/heel_r");
+contact->addContactSphere("/contactgeometryset/toe_r");
+model.addForce(contact);
+@endcode
+
+@see SmoothSphereHalfSpaceForce */
+class OSIMSIMULATION_API BatchedSmoothSphereHalfSpaceForce : public Force {
+    OpenSim_DECLARE_CONCRETE_OBJECT(BatchedSmoothSphereHalfSpaceForce, Force);
+
+public:
+    //=========================================================================
+    // PROPERTIES
+    //=========================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(contact_spheres, std::string,
+            "Paths to the ContactSphere%s that contact the half space.");
+    OpenSim_DECLARE_PROPERTY(stiffness, double,
+            "The stiffness constant (i.e., plain strain modulus), "
+            "default is 1 (N/m^2)");
+    OpenSim_DECLARE_PROPERTY(dissipation, double,
+            "The dissipation coefficient, default is 0 (s/m).");
+    OpenSim_DECLARE_PROPERTY(static_friction, double,
+            "The coefficient of static friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(dynamic_friction, double,
+            "The coefficient of dynamic friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(viscous_friction, double,
+            "The coefficient of viscous friction, default is 0.");
+    OpenSim_DECLARE_PROPERTY(transition_velocity, double,
+            "The transition velocity, default is 0.01 (m/s).");
+    OpenSim_DECLARE_PROPERTY(constant_contact_force, double,
+            "The constant that enforces non-null derivatives, "
+            "default is 1e-5 (N).");
+    OpenSim_DECLARE_PROPERTY(hertz_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hertz force, default is 300.");
+    OpenSim_DECLARE_PROPERTY(hunt_crossley_smoothing, double,
+            "The parameter that determines the smoothness of the transition "
+            "of the tanh used to smooth the Hunt-Crossley force, "
+            "default is 50.");
+
+    //=========================================================================
+    // SOCKETS
+    //=========================================================================
+    OpenSim_DECLARE_SOCKET(half_space, ContactHalfSpace,
+            "The half-space that all of the spheres contact.");
+
+    //=========================================================================
+    // PUBLIC METHODS
+    //=========================================================================
+    BatchedSmoothSphereHalfSpaceForce();
+
+    BatchedSmoothSphereHalfSpaceForce(const std::string& name,
+            const ContactHalfSpace& contactHalfSpace);
+
+    /// Add a sphere, given the path to a ContactSphere in the model.
+    void addContactSphere(const std::string& spherePath)
+    {   append_contact_spheres(spherePath); }
+
+    /// Compute the contact force on each sphere (in the same order as the
+    /// contact_spheres property) and the point at which it is applied. Both
+    /// are expressed in ground. The force on the half space is the negation
+    /// of the force on the sphere, applied at the same point. The state must
+    /// be realized to Stage::Velocity.
+    void calcContactForces(const SimTK::State& state,
+            SimTK::Vector_<SimTK::Vec3>& forces,
+            SimTK::Vector_<SimTK::Vec3>& points) const;
+
+    //=========================================================================
+    // REPORTING
+    //=========================================================================
+    /// For each sphere, the three forces (XYZ) and three torques (XYZ) applied
+    /// on the sphere's body, expressed in ground.
+    OpenSim::Array<std::string> getRecordLabels() const override;
+    OpenSim::Array<double> getRecordValues(
+            const SimTK::State& state) const override;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void computeForce(const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& generalizedForces) const override;
+
+private:
+    void constructProperties();
+
+    std::vector<SimTK::ReferencePtr<const ContactSphere>> _spheres;
+
+    // Sphere data in structure-of-arrays layout, set in extendAddToSystem().
+    mutable std::vector<SimTK::MobilizedBodyIndex> _sphereBodies;
+    mutable std::vector<SimTK::Vec3> _sphereStations;
+    mutable std::vector<double> _sphereRadii;
+    mutable SimTK::MobilizedBodyIndex _halfSpaceBody;
+    mutable SimTK::Transform _halfSpaceFrameInBody;
+
+//=============================================================================
+}; // END of class BatchedSmoothSphereHalfSpaceForce
+//=============================================================================
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BATCHED_SMOOTH_SPHERE_HALF_SPACE_FORCE_H_
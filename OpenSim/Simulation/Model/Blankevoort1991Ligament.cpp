@@ -315,9 +315,12 @@ double Blankevoort1991Ligament::calcDampingForce(const SimTK::State& s) const {
     }
 
     //Phase-out damping as strain goes to zero with smooth-step function
-    SimTK::Function::Step step(0, 1, 0, 0.01);
-    SimTK::Vector in_vec(1, strain);
-    force_damping = force_damping * step.calcValue(in_vec);
+    //(equivalent to SimTK::Function::Step(0, 1, 0, 0.01), without creating a
+    //Function and an argument Vector for every evaluation).
+    const double step_length = 0.01;
+    if (strain < step_length) {
+        force_damping *= SimTK::stepUp(strain / step_length);
+    }
     
     return force_damping;
 }
@@ -159,11 +159,37 @@ void ConditionalPathPoint::setRangeMax(double maxVal)
  */
 bool ConditionalPathPoint::isActive(const SimTK::State& s) const
 {
-    if (getSocket<Coordinate>("coordinate").isConnected()) {
-        double value = getConnectee<Coordinate>("coordinate").getValue(s);
+    // A Position-stage cache entry can only be filled once the state has been
+    // realized to Stage::Time.
+    if (s.getSystemStage() < SimTK::Stage::Time) return calcIsActive(s);
+    if (!isCacheVariableValid(s, _isActiveCV)) {
+        setCacheVariableValue(s, _isActiveCV, calcIsActive(s));
+    }
+    return getCacheVariableValue(s, _isActiveCV);
+}
+
+bool ConditionalPathPoint::calcIsActive(const SimTK::State& s) const
+{
+    if (!_coordinate.empty()) {
+        double value = _coordinate->getValue(s);
         if (value >= get_range(0) - 1e-5 &&
              value <= get_range(1) + 1e-5)
             return true;
     }
     return false;
 }
+
+void ConditionalPathPoint::extendConnectToModel(Model& model)
+{
+    Super::extendConnectToModel(model);
+    _coordinate.reset();
+    if (hasCoordinate()) _coordinate = &getCoordinate();
+}
+
+void ConditionalPathPoint::extendAddToSystem(
+        SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    this->_isActiveCV =
+            addCacheVariable("is_active", false, SimTK::Stage::Position);
+}
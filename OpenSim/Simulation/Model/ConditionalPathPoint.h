@@ -73,11 +73,21 @@ public:
     const Coordinate& getCoordinate() const;
 
     // Override PathPoint methods.
+    /** Whether the coordinate is within the range; this is evaluated once
+        per State and cached (at the Position stage). */
     bool isActive(const SimTK::State& s) const override;
 
 private:
     void constructProperties();
     void updateFromXMLNode(SimTK::Xml::Element& node, int versionNumber) override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+    bool calcIsActive(const SimTK::State& s) const;
+
+    // Avoid looking up the socket each time isActive() is called.
+    SimTK::ReferencePtr<const Coordinate> _coordinate;
+    mutable CacheVariable<bool> _isActiveCV;
 //=============================================================================
 };  // END of class ConditionalPathPoint
 //=============================================================================
@@ -0,0 +1,202 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  ContactEventHandler.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ContactEventHandler.h"
+#include "ContactGeometry.h"
+#include "PhysicalFrame.h"
+
+#include <OpenSim/Common/Exception.h>
+#include <OpenSim/Common/Logger.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+    // Signed distance from a sphere (center in ground, radius) to the shape.
+    // The half space occupies x > 0 of its frame.
+    SimTK::Real calcSphereGap(const SimTK::Vec3& center, double radius,
+            const SimTK::ContactGeometry& other, const SimTK::Transform& X_GO) {
+        const SimTK::Vec3 p_O = X_GO.shiftBaseStationToFrame(center);
+        if (SimTK::ContactGeometry::HalfSpace::isInstance(other)) {
+            return -p_O[0] - radius;
+        }
+        if (SimTK::ContactGeometry::Sphere::isInstance(other)) {
+            return p_O.norm() - radius -
+                   SimTK::ContactGeometry::Sphere::getAs(other).getRadius();
+        }
+        // Triangle mesh: distance to the closest vertex.
+        const auto& mesh = SimTK::ContactGeometry::TriangleMesh::getAs(other);
+        SimTK::Real gap = SimTK::Infinity;
+        for (int i = 0; i < mesh.getNumVertices(); ++i) {
+            gap = std::min(gap, (mesh.getVertexPosition(i) - p_O).norm());
+        }
+        return gap - radius;
+    }
+}
+
+ContactEventHandler::ContactEventHandler(const Component& owner,
+        const OpenSim::ContactGeometry& geometry1,
+        const OpenSim::ContactGeometry& geometry2,
+        ContactEventStatistics& statistics)
+        : ContactEventHandler(owner, createShape(geometry1),
+                  createShape(geometry2), statistics) {}
+
+ContactEventHandler::ContactEventHandler(const Component& owner,
+        Shape shape1, Shape shape2, ContactEventStatistics& statistics)
+        : SimTK::TriggeredEventHandler(SimTK::Stage::Position),
+          m_owner(&owner), m_shape1(shape1), m_shape2(shape2),
+          m_statistics(&statistics) {
+    OPENSIM_THROW_IF(!isSupported(m_shape1.geometry, m_shape2.geometry),
+            Exception,
+            "ContactEventHandler: Contact events between these geometries "
+            "are not supported.");
+    // A sphere is always the first shape.
+    if (SimTK::ContactGeometry::Sphere::isInstance(m_shape2.geometry)) {
+        std::swap(m_shape1, m_shape2);
+    }
+    getTriggerInfo().setTriggerOnRisingSignTransition(true);
+    getTriggerInfo().setTriggerOnFallingSignTransition(true);
+}
+
+ContactEventHandler::Shape ContactEventHandler::createShape(
+        const OpenSim::ContactGeometry& geometry) {
+    Shape shape;
+    shape.frame = &geometry.getFrame();
+    shape.X_FP = geometry.getTransform();
+    shape.geometry = geometry.createSimTKContactGeometry();
+    return shape;
+}
+
+bool ContactEventHandler::isSupported(
+        const OpenSim::ContactGeometry& geometry1,
+        const OpenSim::ContactGeometry& geometry2) {
+    return isSupported(geometry1.createSimTKContactGeometry(),
+            geometry2.createSimTKContactGeometry());
+}
+
+bool ContactEventHandler::isSupported(const SimTK::ContactGeometry& g1,
+        const SimTK::ContactGeometry& g2) {
+    const auto isKnown = [](const SimTK::ContactGeometry& g) {
+        return SimTK::ContactGeometry::Sphere::isInstance(g) ||
+               SimTK::ContactGeometry::HalfSpace::isInstance(g) ||
+               SimTK::ContactGeometry::TriangleMesh::isInstance(g);
+    };
+    if (!isKnown(g1) || !isKnown(g2)) return false;
+    // At least one of the shapes must be a sphere, unless a mesh meets a
+    // half space.
+    if (SimTK::ContactGeometry::Sphere::isInstance(g1) ||
+            SimTK::ContactGeometry::Sphere::isInstance(g2)) {
+        return true;
+    }
+    return (SimTK::ContactGeometry::TriangleMesh::isInstance(g1) &&
+                   SimTK::ContactGeometry::HalfSpace::isInstance(g2)) ||
+           (SimTK::ContactGeometry::HalfSpace::isInstance(g1) &&
+                   SimTK::ContactGeometry::TriangleMesh::isInstance(g2));
+}
+
+SimTK::Real ContactEventHandler::calcGap(const SimTK::State& s) const {
+    const SimTK::Transform X_G1 =
+            m_shape1.frame->getTransformInGround(s) * m_shape1.X_FP;
+    const SimTK::Transform X_G2 =
+            m_shape2.frame->getTransformInGround(s) * m_shape2.X_FP;
+    if (SimTK::ContactGeometry::Sphere::isInstance(m_shape1.geometry)) {
+        return calcSphereGap(X_G1.p(),
+                SimTK::ContactGeometry::Sphere::getAs(m_shape1.geometry)
+                        .getRadius(),
+                m_shape2.geometry, X_G2);
+    }
+    // A mesh and a half space (in either order).
+    const bool meshFirst =
+            SimTK::ContactGeometry::TriangleMesh::isInstance(m_shape1.geometry);
+    const auto& mesh = SimTK::ContactGeometry::TriangleMesh::getAs(
+            meshFirst ? m_shape1.geometry : m_shape2.geometry);
+    const SimTK::Transform& X_GM = meshFirst ? X_G1 : X_G2;
+    const SimTK::Transform& X_GH = meshFirst ? X_G2 : X_G1;
+    const SimTK::Transform X_HM = ~X_GH * X_GM;
+    SimTK::Real gap = SimTK::Infinity;
+    for (int i = 0; i < mesh.getNumVertices(); ++i) {
+        gap = std::min(gap, -(X_HM * mesh.getVertexPosition(i))[0]);
+    }
+    return gap;
+}
+
+void ContactEventHandler::handleEvent(SimTK::State& s, SimTK::Real,
+        bool& shouldTerminate) const {
+    shouldTerminate = false;
+    if (calcGap(s) <= 0) {
+        ++m_statistics->numOnsets;
+        m_statistics->lastOnsetTime = s.getTime();
+        m_owner->setDiscreteVariableValue(
+                s, getOnsetTimeVariableName(), s.getTime());
+    } else {
+        ++m_statistics->numReleases;
+    }
+}
+
+const std::string& ContactEventHandler::getOnsetTimeVariableName() {
+    static const std::string name = "last_contact_onset_time";
+    return name;
+}
+
+int ContactEventHandler::addHandlersToSystem(const Component& owner,
+        const std::vector<const OpenSim::ContactGeometry*>& geometries,
+        SimTK::MultibodySystem& system,
+        std::vector<ContactEventStatistics>& statistics) {
+    // Meshes are read from file when their SimTK geometry is created, so
+    // create each shape only once.
+    std::vector<Shape> shapes;
+    for (const auto* geometry : geometries) {
+        shapes.push_back(createShape(*geometry));
+    }
+    // The handlers keep pointers into `statistics`, so fill it completely
+    // before creating them.
+    std::vector<std::pair<int, int>> pairs;
+    statistics.clear();
+    for (int i = 0; i < (int)geometries.size(); ++i) {
+        for (int j = i + 1; j < (int)geometries.size(); ++j) {
+            const auto& g1 = *geometries[i];
+            const auto& g2 = *geometries[j];
+            if (g1.getFrame().getMobilizedBodyIndex() ==
+                    g2.getFrame().getMobilizedBodyIndex()) {
+                continue;
+            }
+            if (!isSupported(shapes[i].geometry, shapes[j].geometry)) {
+                log_debug("{}: Contact events between '{}' and '{}' are not "
+                          "localized.",
+                        owner.getName(), g1.getName(), g2.getName());
+                continue;
+            }
+            pairs.emplace_back(i, j);
+            ContactEventStatistics stats;
+            stats.geometry1 = g1.getName();
+            stats.geometry2 = g2.getName();
+            statistics.push_back(stats);
+        }
+    }
+    for (int k = 0; k < (int)pairs.size(); ++k) {
+        system.updDefaultSubsystem().addEventHandler(
+                new ContactEventHandler(owner, shapes[pairs[k].first],
+                        shapes[pairs[k].second], statistics[k]));
+    }
+    return (int)pairs.size();
+}
@@ -0,0 +1,122 @@
+#ifndef OPENSIM_CONTACT_EVENT_HANDLER_H_
+#define OPENSIM_CONTACT_EVENT_HANDLER_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ContactEventHandler.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <Simbody.h>
+
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+class ContactGeometry;
+class PhysicalFrame;
+
+/** Onset and release events of contact between two ContactGeometry objects,
+as localized by a ContactEventHandler. */
+struct ContactEventStatistics {
+    std::string geometry1;
+    std::string geometry2;
+    int numOnsets = 0;
+    int numReleases = 0;
+    /** Time of the most recent onset (NaN if there has been none). */
+    double lastOnsetTime = SimTK::NaN;
+};
+
+/** A SimTK::TriggeredEventHandler that localizes the onset and release of
+contact between two contact geometries. Its witness function is the signed
+gap between the geometries (negative while they overlap), so the
+SimTK::TimeStepper stops the integrator at the instant of impact instead of
+letting the error control discover the stiffness discontinuity through
+rejected steps. This is used by the contact forces (e.g., HuntCrossleyForce)
+when their localize_contact_events property is true.
+
+The gap is exact for pairs of spheres and for a sphere and a half space.
+For a ContactMesh paired with a sphere or a half space, the gap is computed
+from the mesh vertices, which is exact for onset against a half space and
+conservative against a sphere; evaluating it costs one distance per vertex.
+Other pairs (e.g., two meshes or two half spaces) are not supported; see
+isSupported().
+
+On each onset, the handler records the time in the discrete variable named
+`last_contact_onset_time` of the owning component, and updates the
+statistics for its pair. */
+class OSIMSIMULATION_API ContactEventHandler
+        : public SimTK::TriggeredEventHandler {
+public:
+    /** The statistics are updated in place, so `statistics` must outlive
+    the handler (it is usually a member of the owning force). */
+    ContactEventHandler(const Component& owner,
+            const ContactGeometry& geometry1,
+            const ContactGeometry& geometry2,
+            ContactEventStatistics& statistics);
+
+    /** Whether the gap between these geometries can be computed. The
+    geometries must also be attached to different bodies. */
+    static bool isSupported(const ContactGeometry& geometry1,
+            const ContactGeometry& geometry2);
+
+    /** The signed distance between the geometries at the state `s`
+    (realized to Stage::Position). */
+    SimTK::Real calcGap(const SimTK::State& s) const;
+
+    SimTK::Real getValue(const SimTK::State& s) const override {
+        return calcGap(s);
+    }
+    void handleEvent(SimTK::State& s, SimTK::Real accuracy,
+            bool& shouldTerminate) const override;
+
+    /** Add a handler to `system` for every supported pair of `geometries`
+    and fill `statistics` with one entry per pair. Returns the number of
+    handlers added. */
+    static int addHandlersToSystem(const Component& owner,
+            const std::vector<const ContactGeometry*>& geometries,
+            SimTK::MultibodySystem& system,
+            std::vector<ContactEventStatistics>& statistics);
+
+    /** The name of the discrete variable that holds the onset time. */
+    static const std::string& getOnsetTimeVariableName();
+
+private:
+    struct Shape {
+        const PhysicalFrame* frame;
+        SimTK::Transform X_FP;
+        SimTK::ContactGeometry geometry;
+    };
+    static Shape createShape(const ContactGeometry& geometry);
+    static bool isSupported(const SimTK::ContactGeometry& geometry1,
+            const SimTK::ContactGeometry& geometry2);
+    ContactEventHandler(const Component& owner, Shape shape1, Shape shape2,
+            ContactEventStatistics& statistics);
+
+    const Component* m_owner;
+    Shape m_shape1;
+    Shape m_shape2;
+    ContactEventStatistics* m_statistics;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_CONTACT_EVENT_HANDLER_H_
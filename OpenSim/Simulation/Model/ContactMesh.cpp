@@ -22,10 +22,61 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <OpenSim/Common/IO.h>
 #include "ContactMesh.h"
 #include "Model.h"
 
+namespace {
+// Meshes are parsed once per process and shared (PolygonalMesh copies are
+// shallow), since every call to finalizeFromProperties() discards the
+// contact geometry and large meshes are slow to parse. The contact geometry
+// is cached as well: constructing a TriangleMesh builds its bounding-volume
+// (OBB) tree, whereas copying one copies the existing tree, so the tree of a
+// given file is built only once. An entry is reused only if the contents of
+// the file have not changed.
+struct CachedMesh {
+    std::size_t contentHash;
+    SimTK::PolygonalMesh mesh;
+    std::shared_ptr<const SimTK::ContactGeometry::TriangleMesh> contactMesh;
+};
+
+CachedMesh loadCachedMesh(const std::string& filename) {
+    static std::mutex mutex;
+    static std::map<std::string, CachedMesh> cache;
+
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::size_t contentHash = std::hash<std::string>()(buffer.str());
+    const bool isAbsolute =
+            (!filename.empty() && (filename[0] == '/' || filename[0] == '\\')) ||
+            (filename.size() > 1 && filename[1] == ':');
+    const std::string key =
+            isAbsolute ? filename : OpenSim::IO::getCwd() + "/" + filename;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it != cache.end() && it->second.contentHash == contentHash) {
+            return it->second;
+        }
+    }
+    CachedMesh entry;
+    entry.contentHash = contentHash;
+    entry.mesh.loadFile(filename);
+    entry.contactMesh = std::make_shared<SimTK::ContactGeometry::TriangleMesh>(
+            entry.mesh);
+    std::lock_guard<std::mutex> lock(mutex);
+    cache[key] = entry;
+    return entry;
+}
+} // namespace
+
 namespace OpenSim {
 
 ContactMesh::ContactMesh() 
@@ -49,10 +100,10 @@ ContactMesh::ContactMesh(const std::string& filename,
         if (file.fail())
             throw Exception("Error loading mesh file: "+filename+". The file should exist in same folder with model.\n Model loading is aborted.");
         file.close();
-        SimTK::PolygonalMesh mesh;
-        mesh.loadFile(filename);
-        _geometry.reset(new SimTK::ContactGeometry::TriangleMesh(mesh));
-        _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
+        const CachedMesh cached = loadCachedMesh(filename);
+        _geometry.reset(
+                new SimTK::ContactGeometry::TriangleMesh(*cached.contactMesh));
+        _decorativeGeometry.reset(new SimTK::DecorativeMesh(cached.mesh));
     }
 }
 
@@ -96,7 +147,6 @@ void ContactMesh::setFilename(const std::string& filename)
 SimTK::ContactGeometry::TriangleMesh* ContactMesh::
     loadMesh(const std::string& filename) const
 {
-    SimTK::PolygonalMesh mesh;
     std::ifstream file;
     assert (_model);
 
@@ -113,9 +163,9 @@ SimTK::ContactGeometry::TriangleMesh* ContactMesh::
                 "Loading is aborted.");
     }
     file.close();
-    mesh.loadFile(filename);
-    _decorativeGeometry.reset(new SimTK::DecorativeMesh(mesh));
-    return new SimTK::ContactGeometry::TriangleMesh(mesh);
+    const CachedMesh cached = loadCachedMesh(filename);
+    _decorativeGeometry.reset(new SimTK::DecorativeMesh(cached.mesh));
+    return new SimTK::ContactGeometry::TriangleMesh(*cached.contactMesh);
 }
 
 SimTK::ContactGeometry ContactMesh::createSimTKContactGeometry() const
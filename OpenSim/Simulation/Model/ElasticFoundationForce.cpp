@@ -57,6 +57,7 @@ void ElasticFoundationForce::extendAddToSystem(SimTK::MultibodySystem& system) c
 
     SimTK::GeneralContactSubsystem& contacts = system.updContactSubsystem();
     SimTK::ContactSetIndex set = contacts.createContactSet();
+    std::vector<const ContactGeometry*> geometries;
     SimTK::ElasticFoundationForce force(_model->updForceSubsystem(), contacts, set);
     force.setTransitionVelocity(transitionVelocity);
     for (int i = 0; i < contactParametersSet.getSize(); ++i)
@@ -74,6 +75,7 @@ void ElasticFoundationForce::extendAddToSystem(SimTK::MultibodySystem& system) c
                     "./contactgeometryset/" + params.getGeometry()[j]);
 
             const ContactGeometry& geom = *contactGeom;
+            geometries.push_back(contactGeom);
             // B: base Frame (Body or Ground)
             // F: PhysicalFrame that this ContactGeometry is connected to
             // P: the frame defined (relative to F) by the location and
@@ -94,15 +96,62 @@ void ElasticFoundationForce::extendAddToSystem(SimTK::MultibodySystem& system) c
         }
     }
 
+    if (get_localize_contact_events()) {
+        addDiscreteVariable(ContactEventHandler::getOnsetTimeVariableName(),
+                SimTK::Stage::Dynamics);
+        const int numPairs = ContactEventHandler::addHandlersToSystem(
+                *this, geometries, system, _contactEventStatistics);
+        if (numPairs == 0) {
+            log_warn("{} '{}': None of the pairs of contact geometries "
+                     "support contact events.", getConcreteClassName(),
+                    getName());
+        }
+    } else {
+        _contactEventStatistics.clear();
+    }
+
     // Beyond the const Component get the index so we can access the SimTK::Force later
     ElasticFoundationForce* mutableThis = const_cast<ElasticFoundationForce *>(this);
     mutableThis->_index = force.getForceIndex();
 }
 
+void ElasticFoundationForce::extendInitStateFromProperties(SimTK::State& state) const
+{
+    Super::extendInitStateFromProperties(state);
+    if (get_localize_contact_events()) {
+        setDiscreteVariableValue(state,
+                ContactEventHandler::getOnsetTimeVariableName(),
+                -SimTK::Infinity);
+    }
+}
+
 void ElasticFoundationForce::constructProperties()
 {
     constructProperty_contact_parameters(ContactParametersSet());
     constructProperty_transition_velocity(0.01);
+    constructProperty_localize_contact_events(false);
+    constructProperty_impact_window(0.01);
+}
+
+void ElasticFoundationForce::resetContactEventStatistics()
+{
+    for (auto& stats : _contactEventStatistics) {
+        stats.numOnsets = 0;
+        stats.numReleases = 0;
+        stats.lastOnsetTime = SimTK::NaN;
+    }
+}
+
+double ElasticFoundationForce::getLastContactOnsetTime(const SimTK::State& s) const
+{
+    if (!get_localize_contact_events()) return -SimTK::Infinity;
+    return getDiscreteVariableValue(s,
+            ContactEventHandler::getOnsetTimeVariableName());
+}
+
+bool ElasticFoundationForce::isInImpactWindow(const SimTK::State& s) const
+{
+    return s.getTime() - getLastContactOnsetTime(s) < get_impact_window();
 }
 
 
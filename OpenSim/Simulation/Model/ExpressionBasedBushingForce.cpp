@@ -221,7 +221,7 @@ void ExpressionBasedBushingForce::setMxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(0, expression);
 }
 
 /** Set the expression for the My function and create it's lepton program */
@@ -231,7 +231,7 @@ void ExpressionBasedBushingForce::setMyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(1, expression);
 }
 
 /** Set the expression for the Mz function and create it's lepton program */
@@ -240,7 +240,7 @@ void ExpressionBasedBushingForce::setMzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(2, expression);
 }
 
 /** Set the expression for the Fx function and create it's lepton program */
@@ -249,7 +249,7 @@ void ExpressionBasedBushingForce::setFxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(3, expression);
 }
 
 /** Set the expression for the Fy function and create it's lepton program */
@@ -258,7 +258,7 @@ void ExpressionBasedBushingForce::setFyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(4, expression);
 }
 
 /** Set the expression for the Fz function and create it's lepton program */
@@ -267,8 +267,33 @@ void ExpressionBasedBushingForce::setFzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    compileStiffnessExpression(5, expression);
 }
+
+void ExpressionBasedBushingForce::compileStiffnessExpression(
+        int index, const std::string& expression)
+{
+    static const std::string deflectionNames[6] = {"theta_x", "theta_y",
+            "theta_z", "delta_x", "delta_y", "delta_z"};
+
+    Lepton::CompiledExpression& compiled = _stiffnessExpressions[index];
+    compiled = Lepton::Parser::parse(expression).optimize()
+            .createCompiledExpression();
+    for (const auto& var : compiled.getVariables()) {
+        OPENSIM_THROW_IF_FRMOBJ(std::find(deflectionNames,
+                                        deflectionNames + 6, var) ==
+                                        deflectionNames + 6,
+                Exception, "Unknown variable '" + var + "' in expression '" +
+                        expression + "'; only theta_x, theta_y, theta_z, "
+                        "delta_x, delta_y and delta_z are allowed.");
+    }
+    for (int j = 0; j < 6; ++j) {
+        _deflectionVars[index][j] =
+                compiled.getVariables().count(deflectionNames[j]) ?
+                &compiled.getVariableReference(deflectionNames[j]) : nullptr;
+    }
+}
+
 //=============================================================================
 // COMPUTATION
 //=============================================================================
@@ -282,21 +307,12 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            if (!_deflectionVars[i][j].empty()) *_deflectionVars[i][j] = dq[j];
+        }
+        fk[i] = _stiffnessExpressions[i].evaluate();
+    }
 
     return -fk;
 }
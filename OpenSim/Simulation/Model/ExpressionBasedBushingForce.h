@@ -27,6 +27,7 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include <lepton/CompiledExpression.h>
 
 namespace OpenSim {
 
@@ -241,6 +242,12 @@ public:
     */
     virtual OpenSim::Array<double> getRecordValues(const SimTK::State& state) const override;
 
+    /** The compiled expressions keep their variables in shared storage, so
+    this force is computed serially when forces are computed in parallel,
+    and models containing it are not shared among threads. */
+    bool isComputeForceThreadSafe() const override { return false; }
+    bool isThreadSafe() const override { return false; }
+
 protected:
     /** Compute the bushing force contribution to the system and add in to 
         appropriate bodyForces and/or system generalizedForces */
@@ -269,11 +276,17 @@ private:
 
     void setNull();
     void constructProperties();
+    // Compile the expression for the index-th component (Mx, My, Mz, Fx, Fy,
+    // Fz) of the stiffness force and bind its deflection variables.
+    void compileStiffnessExpression(int index, const std::string& expression);
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions for Mx, My, Mz, Fx, Fy, Fz, and the storage for
+    // their variables theta_x, theta_y, theta_z, delta_x, delta_y, delta_z
+    // (null if an expression does not use the variable)
+    Lepton::CompiledExpression _stiffnessExpressions[6];
+    SimTK::ReferencePtr<double> _deflectionVars[6][6];
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
@@ -97,7 +97,17 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = Lepton::Parser::parse(expression).optimize()
+            .createCompiledExpression();
+    for (const auto& var : _forceExpr.getVariables()) {
+        OPENSIM_THROW_IF_FRMOBJ(var != "q" && var != "qdot", Exception,
+                "Unknown variable '" + var + "' in expression '" + expression
+                + "'; only 'q' and 'qdot' are allowed.");
+    }
+    _qVar = _forceExpr.getVariables().count("q") ?
+            &_forceExpr.getVariableReference("q") : nullptr;
+    _qdotVar = _forceExpr.getVariables().count("qdot") ?
+            &_forceExpr.getVariableReference("qdot") : nullptr;
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -135,12 +145,9 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    if (!_qVar.empty()) *_qVar = _coord->getValue(s);
+    if (!_qdotVar.empty()) *_qdotVar = _coord->getSpeedValue(s);
+    double forceMag = _forceExpr.evaluate();
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include <lepton/CompiledExpression.h>
 
 namespace OpenSim {
 
@@ -100,6 +100,12 @@ public:
     /** Force calculation operator. **/
     double calcExpressionForce( const SimTK::State& s) const;
 
+    /** The compiled expression keeps its variables in shared storage, so
+    this force is computed serially when forces are computed in parallel,
+    and models containing it are not shared among threads. */
+    bool isComputeForceThreadSafe() const override { return false; }
+    bool isThreadSafe() const override { return false; }
+
 //==============================================================================
 // Reporting
 //==============================================================================
@@ -126,8 +132,11 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression and the storage for its variables (null if the
+    // expression does not use the variable)
+    Lepton::CompiledExpression _forceExpr;
+    SimTK::ReferencePtr<double> _qVar;
+    SimTK::ReferencePtr<double> _qdotVar;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
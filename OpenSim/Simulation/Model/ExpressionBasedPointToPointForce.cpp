@@ -137,7 +137,17 @@ void ExpressionBasedPointToPointForce::extendConnectToModel(Model& model)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpr = Lepton::Parser::parse(expression).optimize()
+            .createCompiledExpression();
+    for (const auto& var : _forceExpr.getVariables()) {
+        OPENSIM_THROW_IF_FRMOBJ(var != "d" && var != "ddot", Exception,
+                "Unknown variable '" + var + "' in expression '" + expression
+                + "'; only 'd' and 'ddot' are allowed.");
+    }
+    _dVar = _forceExpr.getVariables().count("d") ?
+            &_forceExpr.getVariableReference("d") : nullptr;
+    _ddotVar = _forceExpr.getVariables().count("ddot") ?
+            &_forceExpr.getVariableReference("ddot") : nullptr;
 }
 
 //=============================================================================
@@ -187,11 +197,10 @@ void ExpressionBasedPointToPointForce::computeForce(const SimTK::State& s,
     //speed along the line connecting the two bodies
     const double ddot = dot(vRel, r_G)/d;
 
-    std::map<std::string, double> forceVars;
-    forceVars["d"] = d;
-    forceVars["ddot"] = ddot;
+    if (!_dVar.empty()) *_dVar = d;
+    if (!_ddotVar.empty()) *_ddotVar = ddot;
 
-    double forceMag = _forceProg.evaluate(forceVars);
+    double forceMag = _forceExpr.evaluate();
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
 
     const Vec3 f1_G = (forceMag/d) * r_G;
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include <lepton/CompiledExpression.h>
 
 namespace SimTK {
 class MobilizedBody;
@@ -144,6 +144,12 @@ public:
                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                               SimTK::Vector& generalizedForces) const override;
 
+    /** The compiled expression keeps its variables in shared storage, so
+    this force is computed serially when forces are computed in parallel,
+    and models containing it are not shared among threads. */
+    bool isComputeForceThreadSafe() const override { return false; }
+    bool isThreadSafe() const override { return false; }
+
 
     //-----------------------------------------------------------------------------
     // Reporting
@@ -169,8 +175,11 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression and the storage for its variables (null if the
+    // expression does not use the variable)
+    Lepton::CompiledExpression _forceExpr;
+    SimTK::ReferencePtr<double> _dVar;
+    SimTK::ReferencePtr<double> _ddotVar;
 
     // Temporary solution until implemented with Sockets
     SimTK::ReferencePtr<const PhysicalFrame> _body1;
@@ -33,6 +33,8 @@
 
 #include "ExternalForce.h"
 
+#include <algorithm>
+
 //==============================================================================
 // USING
 //==============================================================================
@@ -40,6 +42,22 @@ using namespace OpenSim;
 using SimTK::Vec3;
 using namespace std;
 
+namespace {
+// Evaluate the X, Y and Z functions of a force, point or torque (zero if they
+// have not been created); intervals (if not null) holds a search hint for
+// each of the three functions.
+Vec3 calcFunctionsAtTime(const ArrayPtrs<Function>& functions, double time,
+        int* intervals = nullptr) {
+    if (functions.size() != 3) return Vec3(0);
+    Vec3 value;
+    for (int i = 0; i < 3; ++i) {
+        value[i] = functions[i]->calcValueAt(time,
+                intervals ? intervals + i : nullptr);
+    }
+    return value;
+}
+} // anonymous namespace
+
 //==============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //==============================================================================
@@ -69,6 +87,7 @@ ExternalForce::ExternalForce
     setNull();
     constructProperties();
     _dataSource = &dataSource;
+    clearPresampledTimes();
 
     set_applied_to_body(appliedToBodyName);
     set_force_expressed_in_body(forceExpressedInBodyName);
@@ -327,6 +346,67 @@ void ExternalForce::extendConnectToModel(Model& model)
 //-----------------------------------------------------------------------------
 //_____________________________________________________________________________
 
+void ExternalForce::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    // Force, point and torque: 3 functions each.
+    _intervalsCV = addCacheVariable("function_intervals",
+            std::vector<int>(9, 0), SimTK::Stage::Time);
+    _sampleIndexCV = addCacheVariable("sample_index", 0, SimTK::Stage::Time);
+}
+
+void ExternalForce::presampleAtTimes(const std::vector<double>& times)
+{
+    OPENSIM_THROW_IF_FRMOBJ(
+            !std::is_sorted(times.begin(), times.end()), Exception,
+            "Expected the times to be nondecreasing.");
+    clearPresampledTimes();
+    const int nt = (int)times.size();
+    _sampledForces.reserve(nt);
+    _sampledPoints.reserve(nt);
+    _sampledTorques.reserve(nt);
+    std::vector<int> intervals(9, 0);
+    for (int i = 0; i < nt; ++i) {
+        _sampledForces.push_back(calcFunctionsAtTime(
+                _forceFunctions, times[i], &intervals[0]));
+        _sampledPoints.push_back(calcFunctionsAtTime(
+                _pointFunctions, times[i], &intervals[3]));
+        _sampledTorques.push_back(calcFunctionsAtTime(
+                _torqueFunctions, times[i], &intervals[6]));
+    }
+    _sampleTimes = times;
+}
+
+void ExternalForce::clearPresampledTimes()
+{
+    _sampleTimes.clear();
+    _sampledForces.clear();
+    _sampledPoints.clear();
+    _sampledTorques.clear();
+}
+
+int ExternalForce::findSampleIndex(const SimTK::State& state) const
+{
+    if (_sampleTimes.empty()) return -1;
+    const double time = state.getTime();
+    const auto matches = [&](int i) {
+        return std::abs(_sampleTimes[i] - time) <=
+               SimTK::SignificantReal * (1 + std::abs(time));
+    };
+    // Times are usually visited in order, so try the previous sample and
+    // the one after it first.
+    const int n = (int)_sampleTimes.size();
+    int& hint = updCacheVariableValue(state, _sampleIndexCV);
+    for (int i = std::max(hint, 0); i < std::min(hint + 2, n); ++i) {
+        if (matches(i)) { hint = i; return i; }
+    }
+    const int i = (int)(std::lower_bound(_sampleTimes.begin(),
+            _sampleTimes.end(), time - SimTK::SignificantReal * (1 +
+            std::abs(time))) - _sampleTimes.begin());
+    if (i < n && matches(i)) { hint = i; return i; }
+    return -1;
+}
+
 void ExternalForce::computeForce(const SimTK::State& state, 
                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                               SimTK::Vector& generalizedForces) const
@@ -335,12 +415,19 @@ void ExternalForce::computeForce(const SimTK::State& state,
 
     assert(_appliedToBody!=nullptr);
 
+    // The time is the same for all of the functions, and each function
+    // starts its search from the interval it used in the previous call.
+    std::vector<int>& intervals = updCacheVariableValue(state, _intervalsCV);
+    const int sample = findSampleIndex(state);
+
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
+        Vec3 force = sample >= 0 ? _sampledForces[sample] :
+                calcFunctionsAtTime(_forceFunctions, time, &intervals[0]);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
         Vec3 point(0); // Default is body origin.
         if (_specifiesPoint) {
-            point = getPointAtTime(time);
+            point = sample >= 0 ? _sampledPoints[sample] :
+                    calcFunctionsAtTime(_pointFunctions, time, &intervals[3]);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
         }
@@ -348,7 +435,8 @@ void ExternalForce::computeForce(const SimTK::State& state,
     }
 
     if (_appliesTorque) {
-        Vec3 torque = getTorqueAtTime(time);
+        Vec3 torque = sample >= 0 ? _sampledTorques[sample] :
+                calcFunctionsAtTime(_torqueFunctions, time, &intervals[6]);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         applyTorque(state, *_appliedToBody, torque, bodyForces);
     }
@@ -359,47 +447,17 @@ void ExternalForce::computeForce(const SimTK::State& state,
  */
 Vec3 ExternalForce::getForceAtTime(double aTime) const  
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* forceX=NULL;
-    const Function* forceY=NULL;
-    const Function* forceZ=NULL;
-    if (_forceFunctions.size()==3){
-        forceX=_forceFunctions[0];  forceY=_forceFunctions[1];  forceZ=_forceFunctions[2];
-    }
-    Vec3 force(forceX?forceX->calcValue(timeAsVector):0.0, 
-        forceY?forceY->calcValue(timeAsVector):0.0, 
-        forceZ?forceZ->calcValue(timeAsVector):0.0);
-    return force;
+    return calcFunctionsAtTime(_forceFunctions, aTime);
 }
 
 Vec3 ExternalForce::getPointAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* pointX=NULL;
-    const Function* pointY=NULL;
-    const Function* pointZ=NULL;
-    if (_pointFunctions.size()==3){
-        pointX=_pointFunctions[0];  pointY=_pointFunctions[1];  pointZ=_pointFunctions[2];
-    }
-    Vec3 point(pointX?pointX->calcValue(timeAsVector):0.0, 
-        pointY?pointY->calcValue(timeAsVector):0.0, 
-        pointZ?pointZ->calcValue(timeAsVector):0.0);
-    return point;
+    return calcFunctionsAtTime(_pointFunctions, aTime);
 }
 
 Vec3 ExternalForce::getTorqueAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* torqueX=NULL;
-    const Function* torqueY=NULL;
-    const Function* torqueZ=NULL;
-    if (_torqueFunctions.size()==3){
-        torqueX=_torqueFunctions[0];    torqueY=_torqueFunctions[1];    torqueZ=_torqueFunctions[2];
-    }
-    Vec3 torque(torqueX?torqueX->calcValue(timeAsVector):0.0, 
-        torqueY?torqueY->calcValue(timeAsVector):0.0, 
-        torqueZ?torqueZ->calcValue(timeAsVector):0.0);
-    return torque;
+    return calcFunctionsAtTime(_torqueFunctions, aTime);
 }
 
 
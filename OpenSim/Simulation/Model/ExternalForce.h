@@ -174,6 +174,24 @@ public:
     SimTK::Vec3 getPointAtTime(double aTime) const;
     SimTK::Vec3 getTorqueAtTime(double aTime) const;
 
+    /**
+     * Evaluate the force, point and torque at each of the given
+     * (nondecreasing) times once, and use those values in computeForce()
+     * whenever the time of the state is one of these times; other times are
+     * interpolated from the data as usual. Use this when the evaluation times
+     * are known in advance (e.g., the frames of an inverse dynamics
+     * analysis). Call this after the model has been initialized: the data
+     * functions are created when the model is connected, and the samples are
+     * discarded by setDataSource(), which ExternalLoads calls whenever it is
+     * connected to a model.
+     */
+    void presampleAtTimes(const std::vector<double>& times);
+    /** Discard the values stored by presampleAtTimes(). */
+    void clearPresampledTimes();
+    /** The number of times at which values were stored by
+    presampleAtTimes(). */
+    int getNumPresampledTimes() const { return (int)_sampleTimes.size(); }
+
     /**
      * Methods used for reporting.
      * First identify the labels for individual components
@@ -218,6 +236,7 @@ protected:
 
     /**  ModelComponent interface */ 
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
     /**
      * Compute the force.
@@ -259,6 +278,23 @@ private:
     ArrayPtrs<Function> _torqueFunctions;
     ArrayPtrs<Function> _pointFunctions;
 
+    /** The interval that contained the previous time for each of the force,
+        point and torque functions, used as a search hint by computeForce(). */
+    mutable CacheVariable<std::vector<int>> _intervalsCV;
+
+    /** Values stored by presampleAtTimes(), each expressed in the frame
+        given by the corresponding property, and the index of the sample
+        used in the previous call to computeForce(). */
+    std::vector<double> _sampleTimes;
+    std::vector<SimTK::Vec3> _sampledForces;
+    std::vector<SimTK::Vec3> _sampledPoints;
+    std::vector<SimTK::Vec3> _sampledTorques;
+    mutable CacheVariable<int> _sampleIndexCV;
+
+    /** Find the sample whose time matches the time of the state; returns -1
+        if there is none. */
+    int findSampleIndex(const SimTK::State& state) const;
+
     friend class ExternalLoads;
 //==============================================================================
 };  // END of class ExternalForce
@@ -29,7 +29,9 @@
 #include "Model.h"
 #include "BodySet.h"
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
+#include <algorithm>
 
 using namespace std;
 using namespace OpenSim;
@@ -199,6 +201,12 @@ void ExternalLoads::extendConnectToModel(Model& aModel)
     }
 }
 
+void ExternalLoads::presampleAtTimes(const std::vector<double>& times)
+{
+    for (int i = 0; i < getSize(); ++i)
+        get(i).presampleAtTimes(times);
+}
+
 //-----------------------------------------------------------------------------
 // RE-EXPRESS POINT DATA 
 //-----------------------------------------------------------------------------
@@ -220,11 +228,11 @@ void ExternalLoads::extendConnectToModel(Model& aModel)
 void ExternalLoads::transformPointsExpressedInGroundToAppliedBodies(
     const Storage &kinematics, double startTime, double endTime)
 {
-    std::vector<ExternalForce*> transformedForces;
-    for(int i=0; i<getSize(); ++i){
-        ExternalForce *transformedExf = transformPointExpressedInGroundToAppliedBody(get(i), kinematics, startTime, endTime);
-        transformedForces.push_back(transformedExf);
-    }
+    std::vector<const ExternalForce*> forces;
+    for(int i=0; i<getSize(); ++i) forces.push_back(&get(i));
+    std::vector<ExternalForce*> transformedForces =
+        transformPointsExpressedInGroundToAppliedBodies(
+            forces, kinematics, startTime, endTime);
     // Once we've transformed the forces (done with computation),
     // then replace them in the Set
     for (int i = 0; i < (int)transformedForces.size(); ++i) {
@@ -241,28 +249,46 @@ void ExternalLoads::transformPointsExpressedInGroundToAppliedBodies(
 ExternalForce* ExternalLoads::transformPointExpressedInGroundToAppliedBody(
     const ExternalForce &exForce, const Storage &kinematics,
     double startTime, double endTime)
+{
+    return transformPointsExpressedInGroundToAppliedBodies(
+        {&exForce}, kinematics, startTime, endTime)[0];
+}
+
+std::vector<ExternalForce*>
+ExternalLoads::transformPointsExpressedInGroundToAppliedBodies(
+    const std::vector<const ExternalForce*>& exForces,
+    const Storage &kinematics, double startTime, double endTime)
 {
     if(!hasModel() || !getModel().isValidSystem()) // no model and no system underneath, cannot proceed
         throw Exception("ExternalLoads::transformPointExpressedInGroundToAppliedBody() requires a model with a valid system."); 
 
-    if(!exForce._specifiesPoint){ // The external force does not apply a force to a point
-        log_warn("ExternalLoads: ExternalForce '{}' does not specify a point of application.",
-            exForce.getName());
-        return NULL;
-    }
+    std::vector<ExternalForce*> transformed(exForces.size(), nullptr);
 
-    if (exForce.getPointExpressedInBodyName() != getModel().getGround().getName()){
-        log_warn("ExternalLoads: ExternalForce '{}' is not expressed in ground "
-                 "and will not be transformed.",
+    // The forces whose points are transformed.
+    std::vector<int> toTransform;
+    for (int k = 0; k < (int)exForces.size(); ++k) {
+        const ExternalForce& exForce = *exForces[k];
+        if(!exForce._specifiesPoint){ // The external force does not apply a force to a point
+            log_warn("ExternalLoads: ExternalForce '{}' does not specify a point of application.",
                 exForce.getName());
-        return NULL;
-    }
+            continue;
+        }
+
+        if (exForce.getPointExpressedInBodyName() != getModel().getGround().getName()){
+            log_warn("ExternalLoads: ExternalForce '{}' is not expressed in ground "
+                     "and will not be transformed.",
+                    exForce.getName());
+            continue;
+        }
 
-    if (exForce.getAppliedToBodyName() == getModel().getGround().getName()){
-        log_warn("ExternalLoads: ExternalForce '{}' is applied to a point on ground and will not be transformed.",
-            exForce.getName());
-        return NULL;
+        if (exForce.getAppliedToBodyName() == getModel().getGround().getName()){
+            log_warn("ExternalLoads: ExternalForce '{}' is applied to a point on ground and will not be transformed.",
+                exForce.getName());
+            continue;
+        }
+        toTransform.push_back(k);
     }
+    if (toTransform.empty()) return transformed;
 
     int nq = getModel().getNumCoordinates();
     int nt = kinematics.getSize();
@@ -288,109 +314,132 @@ ExternalForce* ExternalLoads::transformPointExpressedInGroundToAppliedBody(
         log_warn("ExternalLoads: Specified load kinematics contains no "
                  "coordinate values. "
                  "Point of force application cannot be transformed.");
-        return NULL;
+        return transformed;
     }
 
     nt = lastIndex-startIndex+1;
 
-    // Construct a new storage to contain the re-expressed point data for the 
-    // new external force.
-    Storage *newDataSource = new Storage(nt);
-    Array<string> labels;
-    labels.append("time");
-
-    const string &forceIdentifier = exForce.getForceIdentifier();
-    const string &pointIdentifier = exForce.getPointIdentifier();
-    const string &torqueIdentifier = exForce.getTorqueIdentifier();
-
-    labels.append(forceIdentifier + ".x");
-    labels.append(forceIdentifier + ".y");
-    labels.append(forceIdentifier + ".z");
-    labels.append(pointIdentifier + ".x");
-    labels.append(pointIdentifier + ".y");
-    labels.append(pointIdentifier + ".z");
-    if(exForce._appliesTorque){
-        labels.append(torqueIdentifier + ".x");
-        labels.append(torqueIdentifier + ".y");
-        labels.append(torqueIdentifier + ".z");
+    // Read the kinematics once for all forces; column i of Q holds the
+    // coordinate values at times[i].
+    SimTK::Vector times(nt);
+    SimTK::Matrix Q(nq, nt);
+    Array<double> q(0.0,nq);
+    for(int i=0; i<nt; ++i) {
+        kinematics.getTime(startIndex+i, times[i]);
+        kinematics.getData(startIndex+i, nq, &q[0]);
+        for (int j = 0; j < nq; j++) Q(j, i) = q[j];
     }
 
-    newDataSource->setColumnLabels(labels);
-    int ncols = labels.getSize()-1; // time treated separately when appended to storage
-
-    SimTK::Vector datarow(ncols, SimTK::NaN);
-
-    double time = 0;
-    Array<double> Q(0.0,nq);
-
-    Vec3 pGround(SimTK::NaN);
-    Vec3 pAppliedBody(SimTK::NaN);
-    Vec3 force(SimTK::NaN); 
-    Vec3 torque(SimTK::NaN);
-    
-    // Checked that we had a model with a valid system, so get its working state
-    SimTK::State& s = updModel().updWorkingState();
-
-    // get from (ground) and to (applied) bodies 
+    // Evaluate the force data of each ExternalForce at all times; the
+    // columns are the force, the point, and the torque (if any). The points
+    // are re-expressed in place below.
     const Ground& ground = getModel().getGround();
-    const Body& appliedToBody = getModel().getBodySet().get(exForce.getAppliedToBodyName());
-
-    /*std::map<int, int>      coordinatesToColumns;
-    // create a map entry for each coordinate 0 to nq-1, the contents of which would be -1 if not found in the file otherwise Q index
-    for (int qi=0; qi < nq; qi++) coordinatesToColumns[qi] = -1;
-    const Array<string>& kinLabels = kinematics.getColumnLabels();
-
-    for (int qj = 0; qj < nq; qj++) {
-        Coordinate& coord = _model->getCoordinateSet().get(qj);
-        int idx = kinLabels.findIndex(coord.getName());
-        if (idx!= -1) coordinatesToColumns[qj] = idx-1; // Since time is not accounted for
-    }*/
-    for(int i=startIndex; i<=lastIndex; ++i) {
-        // transform data on an instant-by-instant basis
-        kinematics.getTime(i, time);
-        kinematics.getData(i, nq, &Q[0]);
-
-        // Set the coordinates values in the state in order to position the model according to specified kinematics
-        for (int j = 0; j < nq; j++) {
-            Coordinate& coord = getModel().getCoordinateSet().get(j);
-            coord.setValue(s, Q[j], j==nq-1);
-            /*if (coordinatesToColumns[j]!=-1)
-                coord.setValue(s, Q[coordinatesToColumns[j]], j==nq-1);*/
+    std::vector<SimTK::Matrix> data(toTransform.size());
+    std::vector<const Body*> appliedToBodies(toTransform.size());
+    for (int k = 0; k < (int)toTransform.size(); ++k) {
+        const ExternalForce& exForce = *exForces[toTransform[k]];
+        appliedToBodies[k] =
+            &getModel().getBodySet().get(exForce.getAppliedToBodyName());
+        data[k].resize(nt, exForce._appliesTorque ? 9 : 6);
+        for (int i = 0; i < nt; ++i) {
+            const Vec3 force = exForce.getForceAtTime(times[i]);
+            // The untransformed point is expressed in ground (checked above).
+            const Vec3 pGround = exForce.getPointAtTime(times[i]);
+            const Vec3 torque = exForce._appliesTorque
+                ? exForce.getTorqueAtTime(times[i]) : Vec3(SimTK::NaN);
+            for (int j = 0; j < 3; ++j) {
+                data[k](i, j) = force[j];
+                data[k](i, j + 3) = pGround[j];
+                if (exForce._appliesTorque) data[k](i, j + 6) = torque[j];
+            }
         }
+    }
 
-        // get force data
-        force = exForce.getForceAtTime(time);
-        if(exForce._appliesTorque)
-            torque = exForce.getTorqueAtTime(time);
-        
-        // get the untransformed point expressed in ground in the ExternalForce specified in  ground (check made above)
-        pGround = exForce.getPointAtTime(time);
-        pAppliedBody = ground.findStationLocationInAnotherFrame(s, pGround, appliedToBody);
-
-        // populate the force data for this instant in time
-        for(int j =0; j<3; ++j){
-            datarow[j] = force[j];
-            datarow[j+3] = pAppliedBody[j];
-            if(exForce._appliesTorque)
-                datarow[j+6] = torque[j];
+    // Pose the model at each time and re-express the points of all forces
+    // in their applied-to bodies.
+    const CoordinateSet& coordinates = getModel().getCoordinateSet();
+    auto transformTime = [&](SimTK::State& s, int i) {
+        // Set the coordinates values in the state in order to position the
+        // model according to specified kinematics
+        for (int j = 0; j < nq; j++) {
+            coordinates.get(j).setValue(s, Q(j, i), j==nq-1);
         }
+        for (int k = 0; k < (int)toTransform.size(); ++k) {
+            const Vec3 pGround(data[k](i, 3), data[k](i, 4), data[k](i, 5));
+            const Vec3 pAppliedBody = ground.findStationLocationInAnotherFrame(
+                    s, pGround, *appliedToBodies[k]);
+            for (int j = 0; j < 3; ++j) data[k](i, j + 3) = pAppliedBody[j];
+        }
+    };
 
-        newDataSource->append(time, datarow); 
+    // Assembling the model to satisfy constraints uses the model's assembly
+    // solver and starts from the previous pose, so it must be done in order.
+    // Otherwise, setting the coordinates only realizes the given state, and
+    // the times are split among threads, each with its own state.
+    SimTK::State& workingState = updModel().updWorkingState();
+    bool mustAssemble = getModel().getConstraintSet().getSize() > 0;
+    for (int j = 0; j < nq && !mustAssemble; j++) {
+        mustAssemble = coordinates.get(j).isConstrained(workingState);
     }
+    if (mustAssemble) {
+        for (int i = 0; i < nt; ++i) transformTime(workingState, i);
+    } else {
+        const int timesPerBlock = 64;
+        const int numBlocks = (nt + timesPerBlock - 1) / timesPerBlock;
+        parallelFor(numBlocks, [&](int b) {
+            SimTK::State s = workingState;
+            const int end = std::min(nt, (b + 1) * timesPerBlock);
+            for (int i = b * timesPerBlock; i < end; ++i) transformTime(s, i);
+        });
+    }
+
+    for (int k = 0; k < (int)toTransform.size(); ++k) {
+        const ExternalForce& exForce = *exForces[toTransform[k]];
+
+        // Construct a new storage to contain the re-expressed point data for
+        // the new external force.
+        Storage *newDataSource = new Storage(nt);
+        Array<string> labels;
+        labels.append("time");
+
+        const string &forceIdentifier = exForce.getForceIdentifier();
+        const string &pointIdentifier = exForce.getPointIdentifier();
+        const string &torqueIdentifier = exForce.getTorqueIdentifier();
+
+        labels.append(forceIdentifier + ".x");
+        labels.append(forceIdentifier + ".y");
+        labels.append(forceIdentifier + ".z");
+        labels.append(pointIdentifier + ".x");
+        labels.append(pointIdentifier + ".y");
+        labels.append(pointIdentifier + ".z");
+        if(exForce._appliesTorque){
+            labels.append(torqueIdentifier + ".x");
+            labels.append(torqueIdentifier + ".y");
+            labels.append(torqueIdentifier + ".z");
+        }
+
+        newDataSource->setColumnLabels(labels);
+        SimTK::Vector datarow(data[k].ncol());
+        for (int i = 0; i < nt; ++i) {
+            for (int j = 0; j < datarow.size(); ++j) datarow[j] = data[k](i, j);
+            newDataSource->append(times[i], datarow);
+        }
 
-    // assign a name to the new data source
-    newDataSource->setName(exForce.getDataSourceName() + "_transformedP");
+        // assign a name to the new data source
+        newDataSource->setName(exForce.getDataSourceName() + "_transformedP");
 
-    ExternalForce *exF_transformedPoint = exForce.clone();
-    exF_transformedPoint->setName(exForce.getName()+"_transformedP");
-    exF_transformedPoint->setPointExpressedInBodyName(exForce.getAppliedToBodyName());
-    exF_transformedPoint->setDataSource(*newDataSource);
+        ExternalForce *exF_transformedPoint = exForce.clone();
+        exF_transformedPoint->setName(exForce.getName()+"_transformedP");
+        exF_transformedPoint->setPointExpressedInBodyName(exForce.getAppliedToBodyName());
+        exF_transformedPoint->setDataSource(*newDataSource);
 
-    _storages.push_back(shared_ptr<Storage>(newDataSource));
+        _storages.push_back(shared_ptr<Storage>(newDataSource));
 
-    newDataSource->print(exForce.getName()+"_NewDataSource_TransformedP.sto");
+        newDataSource->print(exForce.getName()+"_NewDataSource_TransformedP.sto");
 
-    return exF_transformedPoint;
+        transformed[toTransform[k]] = exF_transformedPoint;
+    }
+    return transformed;
 }
 
 //-----------------------------------------------------------------------------
@@ -114,6 +114,9 @@ public:
     void transformPointsExpressedInGroundToAppliedBodies(const Storage &kinematics, double startTime = -SimTK::Infinity, double endTime = SimTK::Infinity);
     ExternalForce* transformPointExpressedInGroundToAppliedBody(const ExternalForce &exForce, const Storage &kinematics, double startTime, double endTime);
 
+    /// Call ExternalForce::presampleAtTimes() on each ExternalForce.
+    void presampleAtTimes(const std::vector<double>& times);
+
     /// ExternalLoads remembers the file it was loaded from, even after being
     /// copied. This file path is used to find the datafile relative to the
     /// location of the ExternalLoads file itself. This function can clear
@@ -125,6 +128,12 @@ private:
     void setNull();
     void setupSerializedMembers();
     std::string createIdentifier(OpenSim::Array<std::string>&oldFunctionNames, const Array<std::string>& labels);
+    /** Transform the points of all the given forces with a single pass over
+    the kinematics. An entry of the result is null if that force was not
+    transformed. */
+    std::vector<ExternalForce*> transformPointsExpressedInGroundToAppliedBodies(
+            const std::vector<const ExternalForce*>& exForces,
+            const Storage &kinematics, double startTime, double endTime);
 
     //--------------------------------------------------------------------------
     // OPERATORS
@@ -92,6 +92,15 @@ void Force::extendAddToSystem(SimTK::MultibodySystem& system) const
     ForceAdapter* adapter = new ForceAdapter(*this);
     SimTK::Force::Custom force(_model->updForceSubsystem(), adapter);
 
+    // The model computes thread-safe forces together on a pool of threads;
+    // the adapter is still used for the potential energy and to enable or
+    // disable the force.
+    ParallelForceAdapter* parallelForces = _model->updParallelForceAdapter();
+    if (parallelForces && isComputeForceThreadSafe() && isThreadSafe()) {
+        adapter->setComputedInParallel(true);
+        parallelForces->addForce(*this);
+    }
+
      // Beyond the const Component get the index so we can access the SimTK::Force later
     Force* mutableThis = const_cast<Force *>(this);
     mutableThis->_index = force.getForceIndex();
@@ -77,6 +77,22 @@ public:
         return false;
     }
 
+    /**
+    * Whether computeForce() may be called concurrently with the computeForce()
+    * of other Forces on the same State. This is used only if the Model's
+    * `use_parallel_forces` property is true. The default is true, since a
+    * Force typically only reads the State and writes to its own cache
+    * variables. Override this method to return false if computeForce()
+    * modifies data members, lazily computes quantities owned by other
+    * components (e.g., the path of another Force), or calls code that is not
+    * thread-safe; such Forces are computed on the calling thread, before or
+    * after the Forces that are computed in parallel.
+    */
+    virtual bool isComputeForceThreadSafe() const
+    {
+        return true;
+    }
+
     /** Return if the Force is applied (or enabled) or not.                   */
     bool appliesForce(const SimTK::State& s) const;
     /** %Set whether or not the Force is applied.                             */
@@ -99,6 +115,22 @@ public:
     getRecordValues(const SimTK::State& state) const {
         return OpenSim::Array<double>();
     };
+    /**
+     * Same as getRecordValues(), but the values are written into `values`,
+     * which must have room for getRecordLabels().getSize() values. Returns
+     * the number of values written. The default implementation copies the
+     * Array returned by getRecordValues(); subclasses override it to avoid
+     * allocating an Array every time a reporter (e.g., ForceReporter)
+     * records the force. If you override getRecordValues() in a subclass of
+     * a Force that overrides this method, override this method as well.
+     */
+    virtual int writeRecordValues(const SimTK::State& state,
+            double* values) const {
+        const OpenSim::Array<double> recordValues = getRecordValues(state);
+        for (int i = 0; i < recordValues.getSize(); ++i)
+            values[i] = recordValues[i];
+        return recordValues.getSize();
+    }
 
 
     /** Return a flag indicating whether the Force is applied along a Path. If
@@ -229,6 +261,7 @@ private:
     void constructProperties();
 
     friend class ForceAdapter;
+    friend class ParallelForceAdapter;
 
 //=============================================================================
 };  // END of class Force
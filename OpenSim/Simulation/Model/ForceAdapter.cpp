@@ -25,6 +25,10 @@
 // INCLUDES
 //=============================================================================
 #include "ForceAdapter.h"
+#include "Model.h"
+#include <OpenSim/Common/ComponentRealizeProfiler.h>
+
+#include <algorithm>
 
 //=============================================================================
 // STATICS
@@ -46,6 +50,9 @@ void ForceAdapter::calcForce(const SimTK::State& state,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
     SimTK::Vector& mobilityForces) const
 {
+    if (_computedInParallel) return;
+    ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::ComputeForce, *_force);
     _force->computeForce(state, bodyForces, mobilityForces);
 }
 
@@ -56,4 +63,164 @@ SimTK::Real ForceAdapter::calcPotentialEnergy(const SimTK::State& state) const
 
 bool ForceAdapter::shouldBeParallelized() const {
     return _force->shouldBeParallelized(); 
-}
\ No newline at end of file
+}
+//=============================================================================
+// PARALLEL FORCE ADAPTER
+//=============================================================================
+class ParallelForceAdapter::ComputeForceTask
+        : public SimTK::ParallelExecutor::Task {
+public:
+    ComputeForceTask(const SimTK::State& state,
+            const std::vector<const Force*>& forces,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces)
+            : _state(state), _forces(forces), _bodyForces(bodyForces),
+              _mobilityForces(mobilityForces) {}
+
+    void initialize() override {
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces =
+                _threadBodyForces.upd();
+        bodyForces.resize(_bodyForces.size());
+        bodyForces.setToZero();
+        SimTK::Vector& mobilityForces = _threadMobilityForces.upd();
+        mobilityForces.resize(_mobilityForces.size());
+        mobilityForces.setToZero();
+    }
+
+    void execute(int index) override {
+        try {
+            ParallelForceAdapter::computeForce(*_forces[index], _state,
+                    _threadBodyForces.upd(), _threadMobilityForces.upd());
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_exception) _exception = std::current_exception();
+        }
+    }
+
+    void finish() override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _bodyForces += _threadBodyForces.get();
+        _mobilityForces += _threadMobilityForces.get();
+    }
+
+    void rethrowIfFailed() const {
+        if (_exception) std::rethrow_exception(_exception);
+    }
+
+private:
+    const SimTK::State& _state;
+    const std::vector<const Force*>& _forces;
+    SimTK::Vector_<SimTK::SpatialVec>& _bodyForces;
+    SimTK::Vector& _mobilityForces;
+    SimTK::ThreadLocal<SimTK::Vector_<SimTK::SpatialVec>> _threadBodyForces;
+    SimTK::ThreadLocal<SimTK::Vector> _threadMobilityForces;
+    std::mutex _mutex;
+    std::exception_ptr _exception;
+};
+
+// Computes blocks of consecutive forces, each into its own force vectors, so
+// that the sums do not depend on which thread computes which block.
+class ParallelForceAdapter::ComputeForceBlockTask
+        : public SimTK::ParallelExecutor::Task {
+public:
+    ComputeForceBlockTask(const SimTK::State& state,
+            const std::vector<const Force*>& forces,
+            std::vector<SimTK::Vector_<SimTK::SpatialVec>>& blockBodyForces,
+            std::vector<SimTK::Vector>& blockMobilityForces)
+            : _state(state), _forces(forces),
+              _blockBodyForces(blockBodyForces),
+              _blockMobilityForces(blockMobilityForces) {}
+
+    void execute(int index) override {
+        const int begin = index * DeterministicBlockSize;
+        const int end = std::min(begin + DeterministicBlockSize,
+                (int)_forces.size());
+        try {
+            for (int i = begin; i < end; ++i) {
+                ParallelForceAdapter::computeForce(*_forces[i], _state,
+                        _blockBodyForces[index], _blockMobilityForces[index]);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_exception) _exception = std::current_exception();
+        }
+    }
+
+    void rethrowIfFailed() const {
+        if (_exception) std::rethrow_exception(_exception);
+    }
+
+private:
+    const SimTK::State& _state;
+    const std::vector<const Force*>& _forces;
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>>& _blockBodyForces;
+    std::vector<SimTK::Vector>& _blockMobilityForces;
+    std::mutex _mutex;
+    std::exception_ptr _exception;
+};
+
+std::atomic<bool> ParallelForceAdapter::_deterministic(false);
+constexpr int ParallelForceAdapter::DeterministicBlockSize;
+
+ParallelForceAdapter::ParallelForceAdapter(const Model& model, int numThreads)
+        : _model(&model),
+          _executor(new SimTK::ParallelExecutor(std::max(1, numThreads))) {}
+
+void ParallelForceAdapter::addForce(const Force& force) {
+    _forces.push_back(&force);
+}
+
+void ParallelForceAdapter::computeForce(const Force& force,
+        const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector& mobilityForces) {
+    ComponentRealizeProfiler::Scope scope(
+            ComponentRealizeProfiler::Section::ComputeForce, force);
+    force.computeForce(state, bodyForces, mobilityForces);
+}
+
+void ParallelForceAdapter::calcForce(const SimTK::State& state,
+    SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+    SimTK::Vector_<SimTK::Vec3>& particleForces,
+    SimTK::Vector& mobilityForces) const
+{
+    std::vector<const Force*> forces;
+    forces.reserve(_forces.size());
+    for (const Force* force : _forces) {
+        if (force->appliesForce(state)) forces.push_back(force);
+    }
+    if (forces.empty()) return;
+
+    // The model's controls are computed lazily by the first Actuator that
+    // asks for them, so compute them here, before the threads start.
+    if (_model->getNumControls() > 0) _model->getControls(state);
+
+    if (!_deterministic) {
+        ComputeForceTask task(state, forces, bodyForces, mobilityForces);
+        _executor->execute(task, (int)forces.size());
+        task.rethrowIfFailed();
+        return;
+    }
+
+    const int numBlocks = ((int)forces.size() + DeterministicBlockSize - 1) /
+                          DeterministicBlockSize;
+    std::vector<SimTK::Vector_<SimTK::SpatialVec>> blockBodyForces(numBlocks,
+            SimTK::Vector_<SimTK::SpatialVec>(bodyForces.size(),
+                    SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0))));
+    std::vector<SimTK::Vector> blockMobilityForces(numBlocks,
+            SimTK::Vector(mobilityForces.size(), 0.0));
+    ComputeForceBlockTask task(state, forces, blockBodyForces,
+            blockMobilityForces);
+    _executor->execute(task, numBlocks);
+    task.rethrowIfFailed();
+
+    // Pairwise tree: ((b0 + b1) + (b2 + b3)) + ...
+    for (int stride = 1; stride < numBlocks; stride *= 2) {
+        for (int i = 0; i + stride < numBlocks; i += 2 * stride) {
+            blockBodyForces[i] += blockBodyForces[i + stride];
+            blockMobilityForces[i] += blockMobilityForces[i + stride];
+        }
+    }
+    bodyForces += blockBodyForces[0];
+    mobilityForces += blockMobilityForces[0];
+}
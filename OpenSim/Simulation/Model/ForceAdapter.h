@@ -30,8 +30,16 @@
 
 #include <SimTKsimbody.h>
 
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace OpenSim {
 
+class Model;
+
 //=============================================================================
 //=============================================================================
 /**
@@ -46,6 +54,7 @@ class OSIMSIMULATION_API ForceAdapter : public SimTK::Force::Custom::Implementat
 //=============================================================================
 private:
     const Force* _force;
+    bool _computedInParallel = false;
 
 //=============================================================================
 // METHODS
@@ -65,10 +74,86 @@ public:
     // SIMBODY PARALLELISM FLAG 
     bool shouldBeParallelized() const;
 
+    /** If true, calcForce() does nothing because the force is computed by
+    the model's ParallelForceAdapter instead. */
+    void setComputedInParallel(bool tf) { _computedInParallel = tf; }
+
     // No need to override realize() methods; we don't provide that service
     // to OpenSim Force elements.
 };
 
+//=============================================================================
+//=============================================================================
+/**
+ * A single SimTK::Force that computes a group of OpenSim Forces concurrently
+ * on a pool of threads. The Model creates one when its `use_parallel_forces`
+ * property is true, and each Force whose isComputeForceThreadSafe() returns
+ * true is added to it. The threads take the next Force from the group as
+ * they finish the previous one, and each thread accumulates its forces into
+ * its own body and mobility force vectors; these are added to the system's
+ * vectors once all the forces have been computed, so the Forces never write
+ * to shared memory.
+ *
+ * Forces that are not applied (see Force::appliesForce()) are skipped. If a
+ * Force throws an exception, the remaining forces are still computed and the
+ * first exception is rethrown on the calling thread.
+ *
+ * The order in which the threads' forces are summed depends on how the
+ * threads are scheduled, so the results can differ in the last bits from one
+ * evaluation to the next. With setDeterministic(true), the forces are split
+ * into fixed blocks of consecutive forces, each block is summed in order,
+ * and the blocks are summed in a fixed pairwise tree. The results then do
+ * not depend on scheduling or on the number of threads, at the cost of one
+ * pair of force vectors per block instead of per thread.
+ */
+class OSIMSIMULATION_API ParallelForceAdapter
+        : public SimTK::Force::Custom::Implementation {
+public:
+    /** Use `numThreads` threads (including the calling thread); the
+    default is the number of processors. */
+    explicit ParallelForceAdapter(const Model& model, int numThreads =
+            SimTK::ParallelExecutor::getNumProcessors());
+
+    /** Add a Force to the group computed in parallel. */
+    void addForce(const Force& force);
+    int getNumForces() const { return (int)_forces.size(); }
+
+    /** Sum the forces in a fixed order so that parallel force evaluation is
+    bitwise reproducible (see above). This applies to all models in the
+    process and takes effect at the next evaluation. The default is false.
+    */
+    static void setDeterministic(bool deterministic)
+    {   _deterministic = deterministic; }
+    static bool getDeterministic() { return _deterministic; }
+
+    /** The number of consecutive forces summed in order by one block when
+    getDeterministic() is true. */
+    static constexpr int DeterministicBlockSize = 4;
+
+    // CALC FORCES (Called by Simbody)
+    void calcForce(const SimTK::State& state,
+        SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+        SimTK::Vector_<SimTK::Vec3>& particleForces,
+        SimTK::Vector& mobilityForces) const override;
+
+    // The potential energy of each Force is computed by its own ForceAdapter.
+    SimTK::Real calcPotentialEnergy(const SimTK::State& state) const override
+    {   return 0; }
+
+private:
+    class ComputeForceTask;
+    class ComputeForceBlockTask;
+    static void computeForce(const Force& force, const SimTK::State& state,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces);
+
+    const Model* _model;
+    std::vector<const Force*> _forces;
+    std::unique_ptr<SimTK::ParallelExecutor> _executor;
+
+    static std::atomic<bool> _deterministic;
+};
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_FORCE_ADAPTER_H_
@@ -229,6 +229,18 @@ SimTK::Vec3 Frame::findStationLocationInGround(const SimTK::State& state,
     return getTransformInGround(state)*station_F;
 }
 
+void Frame::findStationLocationsInGround(const SimTK::State& state,
+        const SimTK::Vector_<SimTK::Vec3>& stations_F,
+        SimTK::Vector_<SimTK::Vec3>& locations_G) const
+{
+    const SimTK::Transform& X_GF = getTransformInGround(state);
+    const int numStations = stations_F.size();
+    locations_G.resize(numStations);
+    for (int i = 0; i < numStations; ++i) {
+        locations_G[i] = X_GF*stations_F[i];
+    }
+}
+
 SimTK::Vec3 Frame::findStationVelocityInGround(const SimTK::State& state,
     const SimTK::Vec3& station_F) const
 {
@@ -259,6 +259,22 @@ public:
     SimTK::Vec3 findStationLocationInGround(const SimTK::State& state,
                     const SimTK::Vec3& station_F) const;
 
+    /**
+    Take many stations located and expressed in this frame (F) and determine
+    their locations relative to and expressed in Ground (G). The transform of
+    this frame in Ground is obtained once for all of the stations, which makes
+    this cheaper than calling findStationLocationInGround() for each station
+    (e.g., for the markers attached to a body).
+
+    @param state       The state of the model.
+    @param stations_F  The position Vec3s from frame F's origin to the stations.
+    @param[out] locations_G  The locations of the stations in Ground; resized
+                       to the number of stations.
+    */
+    void findStationLocationsInGround(const SimTK::State& state,
+                    const SimTK::Vector_<SimTK::Vec3>& stations_F,
+                    SimTK::Vector_<SimTK::Vec3>& locations_G) const;
+
     /**
     Take a station located and expressed in this frame (F) and determine
     its velocity relative to and expressed in Ground (G).
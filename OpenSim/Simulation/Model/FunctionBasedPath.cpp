@@ -0,0 +1,172 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  FunctionBasedPath.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include "FunctionBasedPath.h"
+#include "Model.h"
+
+using namespace OpenSim;
+
+//=============================================================================
+// CONSTRUCTOR(S)
+//=============================================================================
+FunctionBasedPath::FunctionBasedPath() : GeometryPath() {
+    constructProperties();
+}
+
+FunctionBasedPath::FunctionBasedPath(const GeometryPath& geometryPath)
+        : FunctionBasedPath() {
+    setName(geometryPath.getName());
+    updPathPointSet() = geometryPath.getPathPointSet();
+    updWrapSet() = geometryPath.getWrapSet();
+    set_Appearance(geometryPath.get_Appearance());
+}
+
+void FunctionBasedPath::constructProperties() {
+    constructProperty_coordinates();
+    constructProperty_length_function();
+}
+
+const Function& FunctionBasedPath::getLengthFunction() const {
+    OPENSIM_THROW_IF_FRMOBJ(getProperty_length_function().empty(), Exception,
+            "No length_function has been provided.");
+    return get_length_function();
+}
+
+//=============================================================================
+// COMPONENT INTERFACE
+//=============================================================================
+void FunctionBasedPath::extendFinalizeFromProperties() {
+    Super::extendFinalizeFromProperties();
+
+    OPENSIM_THROW_IF_FRMOBJ(getProperty_length_function().empty(),
+            InvalidPropertyValue, getProperty_length_function().getName(),
+            "A length function must be provided.");
+
+    const int numArgs = get_length_function().getArgumentSize();
+    OPENSIM_THROW_IF_FRMOBJ(numArgs != getProperty_coordinates().size(),
+            InvalidPropertyValue, getProperty_coordinates().getName(),
+            fmt::format("Expected {} coordinates (the number of arguments of "
+                        "the length function) but got {}.",
+                    numArgs, getProperty_coordinates().size()));
+}
+
+void FunctionBasedPath::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    _coordinates.clear();
+    for (int i = 0; i < getProperty_coordinates().size(); ++i) {
+        _coordinates.emplace_back(
+                &model.getComponent<Coordinate>(get_coordinates(i)));
+    }
+}
+
+void FunctionBasedPath::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+
+    // The length and its gradient depend only on the q's; the speed also
+    // depends on the u's.
+    this->_functionLengthCV = addCacheVariable(
+            "function_length", 0.0, SimTK::Stage::Position);
+    this->_lengthGradientCV = addCacheVariable("length_gradient",
+            SimTK::Vector((int)_coordinates.size(), 0.0),
+            SimTK::Stage::Position);
+    this->_functionSpeedCV = addCacheVariable(
+            "function_speed", 0.0, SimTK::Stage::Velocity);
+}
+
+//=============================================================================
+// PATH COMPUTATIONS
+//=============================================================================
+void FunctionBasedPath::computeLengthAndGradient(
+        const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _functionLengthCV)) { return; }
+
+    const int nc = (int)_coordinates.size();
+    SimTK::Vector q(nc);
+    for (int i = 0; i < nc; ++i) { q[i] = _coordinates[i]->getValue(s); }
+
+    const Function& function = get_length_function();
+    SimTK::Vector& gradient = updCacheVariableValue(s, _lengthGradientCV);
+    gradient.resize(nc);
+    std::vector<int> derivComponents(1);
+    for (int i = 0; i < nc; ++i) {
+        derivComponents[0] = i;
+        gradient[i] = function.calcDerivative(derivComponents, q);
+    }
+    markCacheVariableValid(s, _lengthGradientCV);
+
+    setCacheVariableValue(s, _functionLengthCV, function.calcValue(q));
+}
+
+double FunctionBasedPath::getLength(const SimTK::State& s) const {
+    computeLengthAndGradient(s);
+    return getCacheVariableValue(s, _functionLengthCV);
+}
+
+const SimTK::Vector& FunctionBasedPath::getLengthGradient(
+        const SimTK::State& s) const {
+    computeLengthAndGradient(s);
+    return getCacheVariableValue(s, _lengthGradientCV);
+}
+
+double FunctionBasedPath::getLengtheningSpeed(const SimTK::State& s) const {
+    if (isCacheVariableValid(s, _functionSpeedCV)) {
+        return getCacheVariableValue(s, _functionSpeedCV);
+    }
+    const SimTK::Vector& gradient = getLengthGradient(s);
+    double speed = 0;
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        speed += gradient[i] * _coordinates[i]->getSpeedValue(s);
+    }
+    setCacheVariableValue(s, _functionSpeedCV, speed);
+    return speed;
+}
+
+double FunctionBasedPath::computeMomentArm(
+        const SimTK::State& s, const Coordinate& aCoord) const {
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        if (_coordinates[i].get() == &aCoord) {
+            return -getLengthGradient(s)[i];
+        }
+    }
+    return 0.0;
+}
+
+void FunctionBasedPath::addInEquivalentForces(const SimTK::State& s,
+        const double& tension, SimTK::Vector_<SimTK::SpatialVec>&,
+        SimTK::Vector& mobilityForces) const {
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    const SimTK::Vector& gradient = getLengthGradient(s);
+    for (int i = 0; i < (int)_coordinates.size(); ++i) {
+        const Coordinate& coord = *_coordinates[i];
+        // A tension shortens the path, so the generalized force is
+        // tau = r * T = -dl/dq * T.
+        matter.getMobilizedBody(coord.getBodyIndex())
+                .applyOneMobilityForce(s, coord.getMobilizerQIndex(),
+                        -gradient[i] * tension, mobilityForces);
+    }
+}
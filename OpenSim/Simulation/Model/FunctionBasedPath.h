@@ -0,0 +1,140 @@
+#ifndef OPENSIM_FUNCTION_BASED_PATH_H_
+#define OPENSIM_FUNCTION_BASED_PATH_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  FunctionBasedPath.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "GeometryPath.h"
+#include <OpenSim/Common/Function.h>
+
+#ifdef SWIG
+    #ifdef OSIMSIMULATION_API
+        #undef OSIMSIMULATION_API
+        #define OSIMSIMULATION_API
+    #endif
+#endif
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * A path whose length is given by a function of a set of coordinates (e.g., a
+ * MultivariatePolynomialFunction fitted to the original wrapped path with
+ * PolynomialPathFitter). The lengthening speed and the moment arms are
+ * obtained analytically from the derivatives of the length function:
+ *
+ * \f[
+ *      l = f(q), \qquad \dot{l} = \sum_i \frac{\partial f}{\partial q_i}
+ *      \dot{q}_i, \qquad r_i = -\frac{\partial f}{\partial q_i}
+ * \f]
+ *
+ * so that neither the wrapping nor the MomentArmSolver are invoked when
+ * computing forces. The tension along the path is applied to the model as a
+ * generalized force \f$ \tau_i = r_i T \f$ on each of the coordinates.
+ *
+ * The path points and wrap objects inherited from GeometryPath are only used
+ * for visualization (and as the reference when refitting the path); they do
+ * not affect the length, speed, moment arms or forces of this path. Moment
+ * arms about coordinates that are not listed in the `coordinates` property
+ * are zero.
+ *
+ * This class derives from GeometryPath (rather than from a common abstract
+ * path) so that it can be used in place of the GeometryPath of any
+ * PathActuator (e.g., a Muscle), PathSpring or Ligament.
+ */
+class OSIMSIMULATION_API FunctionBasedPath : public GeometryPath {
+OpenSim_DECLARE_CONCRETE_OBJECT(FunctionBasedPath, GeometryPath);
+
+public:
+//=============================================================================
+// PROPERTIES
+//=============================================================================
+    OpenSim_DECLARE_LIST_PROPERTY(coordinates, std::string,
+        "Paths to the coordinates (e.g., /jointset/knee/knee_angle_r) on "
+        "which the length function depends, in the order of the arguments "
+        "of the length function.");
+
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(length_function, Function,
+        "Function of the coordinates that gives the length of the path. Its "
+        "first derivatives are used for the lengthening speed and the moment "
+        "arms.");
+
+//=============================================================================
+// METHODS
+//=============================================================================
+    FunctionBasedPath();
+    /** Create a FunctionBasedPath that uses the path points, wrap objects and
+    appearance of the provided GeometryPath for visualization. */
+    explicit FunctionBasedPath(const GeometryPath& geometryPath);
+
+    /** Append a coordinate (by its path in the model) on which the length
+    function depends. */
+    void appendCoordinate(const std::string& coordinatePath)
+    {   append_coordinates(coordinatePath); }
+    void setLengthFunction(const Function& function)
+    {   set_length_function(function); }
+    const Function& getLengthFunction() const;
+
+    //--------------------------------------------------------------------------
+    // GeometryPath interface
+    //--------------------------------------------------------------------------
+    double getLength(const SimTK::State& s) const override;
+    double getLengtheningSpeed(const SimTK::State& s) const override;
+    /** The moment arm is computed analytically from the length function; it
+    is zero for coordinates on which the path does not depend. */
+    double computeMomentArm(const SimTK::State& s,
+            const Coordinate& aCoord) const override;
+    /** Apply the tension as generalized forces on the coordinates of the
+    path. The body forces are not affected. */
+    void addInEquivalentForces(const SimTK::State& state,
+            const double& tension,
+            SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
+            SimTK::Vector& mobilityForces) const override;
+
+    /** Get the derivatives of the length function with respect to each of
+    the coordinates (in the order of the `coordinates` property). The
+    moment arms are the negation of these values. */
+    const SimTK::Vector& getLengthGradient(const SimTK::State& s) const;
+
+protected:
+    void extendFinalizeFromProperties() override;
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+private:
+    void constructProperties();
+    void computeLengthAndGradient(const SimTK::State& s) const;
+
+    std::vector<SimTK::ReferencePtr<const Coordinate>> _coordinates;
+
+    mutable CacheVariable<double> _functionLengthCV;
+    mutable CacheVariable<SimTK::Vector> _lengthGradientCV;
+    mutable CacheVariable<double> _functionSpeedCV;
+
+//=============================================================================
+};  // END of class FunctionBasedPath
+//=============================================================================
+//=============================================================================
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_FUNCTION_BASED_PATH_H_
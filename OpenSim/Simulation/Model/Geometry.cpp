@@ -299,21 +299,26 @@ void Mesh::extendFinalizeFromProperties() {
 
 void Mesh::implementCreateDecorativeGeometry(SimTK::Array_<SimTK::DecorativeGeometry>& decoGeoms) const
 {
-    if (cachedMesh.get() != nullptr) {
-        try {
-            // Force the loading of the mesh to see if it has bad contents
-            // (e.g., binary vtp).
-            // We do not want to do this in extendFinalizeFromProperties b/c
-            // it's expensive to repeatedly load meshes.
-            cachedMesh->getMesh();
-        } catch (const std::exception& e) {
-            log_warn("Visualizer couldn't open {} because: {}",
-                get_mesh_file(), e.what());
-            // No longer try to visualize this mesh.
-            cachedMesh.reset();
-            return;
-        }
+    if (loadMeshFile()) {
         cachedMesh->setScaleFactors(get_scale_factors());
         decoGeoms.push_back(*cachedMesh);
     }
 }
+
+bool Mesh::loadMeshFile() const {
+    if (cachedMesh.get() == nullptr) return false;
+    try {
+        // Force the loading of the mesh to see if it has bad contents
+        // (e.g., binary vtp). The mesh is loaded only once.
+        // We do not want to do this in extendFinalizeFromProperties b/c
+        // it's expensive to repeatedly load meshes.
+        cachedMesh->getMesh();
+    } catch (const std::exception& e) {
+        log_warn("Visualizer couldn't open {} because: {}",
+            get_mesh_file(), e.what());
+        // No longer try to visualize this mesh.
+        cachedMesh.reset();
+        return false;
+    }
+    return true;
+}
@@ -580,6 +580,11 @@ public:
     {
         return get_mesh_file();
     };
+    /// Parse the mesh file now rather than the first time the mesh is drawn.
+    /// Returns false if there is no mesh to draw (e.g., the file could not be
+    /// found or read). ModelVisualizer calls this concurrently for all meshes
+    /// in the model; distinct Mesh%es may be loaded from different threads.
+    bool loadMeshFile() const;
 protected:
     // ModelComponent interface.
     void extendFinalizeFromProperties() override;
@@ -107,6 +107,9 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
     this->_colorCV = addCacheVariable("color", get_Appearance().get_color(), SimTK::Stage::Topology);
+
+    this->_snapshotCV = addCacheVariable("path_snapshot", PathSnapshot{},
+            SimTK::Stage::Instance);
 }
 
  void GeometryPath::extendInitStateFromProperties(SimTK::State& s) const
@@ -137,12 +140,14 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
 
     assert(pathPoints.size() > 1);
 
+    const Vec3 color = getColor(state);
+
     const AbstractPathPoint* lastPoint = pathPoints[0];
     MobilizedBodyIndex mbix(0);
 
     Vec3 lastPos = lastPoint->getLocationInGround(state);
     if (hints.get_show_path_points())
-        DefaultGeometry::drawPathPoint(mbix, lastPos, getColor(state), appendToThis);
+        DefaultGeometry::drawPathPoint(mbix, lastPos, color, appendToThis);
 
     Vec3 pos;
 
@@ -162,24 +167,24 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
                 // transform the surface point into the Ground reference frame
                 pos = X_BG*surfacePoints[j];
                 if (hints.get_show_path_points())
-                    DefaultGeometry::drawPathPoint(mbix, pos, getColor(state),
+                    DefaultGeometry::drawPathPoint(mbix, pos, color,
                         appendToThis);
                 // Line segments will be in ground frame
                 appendToThis.push_back(DecorativeLine(lastPos, pos)
                     .setLineThickness(4)
-                    .setColor(getColor(state)).setBodyId(0).setIndexOnBody(j));
+                    .setColor(color).setBodyId(0).setIndexOnBody(j));
                 lastPos = pos;
             }
         } 
         else { // otherwise a regular PathPoint so just draw its location
             pos = point->getLocationInGround(state);
             if (hints.get_show_path_points())
-                DefaultGeometry::drawPathPoint(mbix, pos, getColor(state),
+                DefaultGeometry::drawPathPoint(mbix, pos, color,
                     appendToThis);
             // Line segments will be in ground frame
             appendToThis.push_back(DecorativeLine(lastPos, pos)
                 .setLineThickness(4)
-                .setColor(getColor(state)).setBodyId(0).setIndexOnBody(i));
+                .setColor(color).setBodyId(0).setIndexOnBody(i));
             lastPos = pos;
         }
     }
@@ -817,6 +822,11 @@ void GeometryPath::computePath(const SimTK::State& s) const
         return;
     }
 
+    if (reusePreviousPath(s)) {
+        markCacheVariableValid(s, _currentPathCV);
+        return;
+    }
+
     // Clear the current path.
     Array<AbstractPathPoint*>& currentPath = updCacheVariableValue(s, _currentPathCV);
     currentPath.setSize(0);
@@ -833,6 +843,123 @@ void GeometryPath::computePath(const SimTK::State& s) const
     calcLengthAfterPathComputation(s, currentPath);
 
     markCacheVariableValid(s, _currentPathCV);
+    savePathSnapshot(s);
+}
+
+std::vector<SimTK::QIndex> GeometryPath::findDependentQIndices(
+        const SimTK::State& s) const
+{
+    const SimTK::SimbodyMatterSubsystem& matter =
+            getModel().getMatterSubsystem();
+    std::vector<bool> visited(matter.getNumBodies(), false);
+    std::vector<SimTK::QIndex> qIndices;
+
+    // Add the q's of a mobilized body and all of its ancestors.
+    auto addBranch = [&](SimTK::MobilizedBodyIndex index) {
+        while (index.isValid() && index != SimTK::GroundIndex &&
+                !visited[index]) {
+            visited[index] = true;
+            const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(index);
+            for (int iq = 0; iq < mobod.getNumQ(s); ++iq) {
+                qIndices.push_back(SimTK::QIndex(mobod.getFirstQIndex(s) + iq));
+            }
+            index = mobod.getParentMobilizedBody().getMobilizedBodyIndex();
+        }
+    };
+    auto addCoordinate = [&](const Coordinate& coord) {
+        addBranch(coord.getBodyIndex());
+    };
+
+    for (int i = 0; i < get_PathPointSet().getSize(); ++i) {
+        const AbstractPathPoint& point = get_PathPointSet()[i];
+        addBranch(point.getParentFrame().getMobilizedBodyIndex());
+        if (const auto* mpp = dynamic_cast<const MovingPathPoint*>(&point)) {
+            if (mpp->hasXCoordinate()) addCoordinate(mpp->getXCoordinate());
+            if (mpp->hasYCoordinate()) addCoordinate(mpp->getYCoordinate());
+            if (mpp->hasZCoordinate()) addCoordinate(mpp->getZCoordinate());
+        } else if (const auto* cpp =
+                dynamic_cast<const ConditionalPathPoint*>(&point)) {
+            addCoordinate(cpp->getCoordinate());
+        }
+    }
+    for (int i = 0; i < get_PathWrapSet().getSize(); ++i) {
+        const WrapObject* wo = get_PathWrapSet()[i].getWrapObject();
+        if (wo) addBranch(wo->getFrame().getMobilizedBodyIndex());
+    }
+    return qIndices;
+}
+
+/*
+ * If none of the q's on which the path depends have changed since the path
+ * was last computed with this state, restore the previous length and wrapping
+ * results instead of recomputing the path. The current path (the cached array
+ * of path points) still holds its previous value.
+ */
+bool GeometryPath::reusePreviousPath(const SimTK::State& s) const
+{
+    PathSnapshot& snapshot = updCacheVariableValue(s, _snapshotCV);
+    if (!isCacheVariableValid(s, _snapshotCV) || !snapshot.initialized) {
+        // The instance has changed (or this is the first computation), so
+        // the snapshot cannot be trusted.
+        snapshot.qIndices = findDependentQIndices(s);
+        snapshot.q.clear();
+        snapshot.hasPath = false;
+        snapshot.initialized = true;
+        markCacheVariableValid(s, _snapshotCV);
+        return false;
+    }
+    if (!snapshot.hasPath) return false;
+
+    const SimTK::Vector& q = s.getQ();
+    for (int i = 0; i < (int)snapshot.qIndices.size(); ++i) {
+        if (q[snapshot.qIndices[i]] != snapshot.q[i]) return false;
+    }
+
+    const int numWraps = get_PathWrapSet().getSize();
+    if ((int)snapshot.wrapPoints.size() != 2 * numWraps) return false;
+    for (int i = 0; i < numWraps; ++i) {
+        PathWrap& ws = get_PathWrapSet().get(i);
+        for (int j = 0; j < 2; ++j) {
+            const PathSnapshot::WrapPointData& data =
+                    snapshot.wrapPoints[2 * i + j];
+            PathWrapPoint& point =
+                    j == 0 ? ws.updWrapPoint1() : ws.updWrapPoint2();
+            point.setLocation(data.location);
+            point.getWrapPath() = data.wrapPath;
+            point.setWrapLength(data.wrapLength);
+        }
+    }
+    setLength(s, snapshot.length);
+    return true;
+}
+
+void GeometryPath::savePathSnapshot(const SimTK::State& s) const
+{
+    if (!isCacheVariableValid(s, _snapshotCV)) return;
+    PathSnapshot& snapshot = updCacheVariableValue(s, _snapshotCV);
+
+    const SimTK::Vector& q = s.getQ();
+    snapshot.q.resize(snapshot.qIndices.size());
+    for (int i = 0; i < (int)snapshot.qIndices.size(); ++i) {
+        snapshot.q[i] = q[snapshot.qIndices[i]];
+    }
+
+    const int numWraps = get_PathWrapSet().getSize();
+    snapshot.wrapPoints.resize(2 * numWraps);
+    for (int i = 0; i < numWraps; ++i) {
+        PathWrap& ws = get_PathWrapSet().get(i);
+        for (int j = 0; j < 2; ++j) {
+            PathSnapshot::WrapPointData& data = snapshot.wrapPoints[2 * i + j];
+            PathWrapPoint& point =
+                    j == 0 ? ws.updWrapPoint1() : ws.updWrapPoint2();
+            data.location = point.getLocation(s);
+            data.wrapPath = point.getWrapPath();
+            data.wrapLength = point.getWrapLength();
+        }
+    }
+    snapshot.length = getCacheVariableValue(s, _lengthCV);
+    snapshot.hasPath = true;
+    markCacheVariableValid(s, _snapshotCV);
 }
 
 //_____________________________________________________________________________
@@ -987,7 +1114,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                             best_wrap = wr;
                             // Store the best wrap in the pathWrap for possible 
                             // use next time.
-                            ws.setPreviousWrap(wr);
+                            ws.setPreviousWrap(s, wr);
                             break;
                         }  else if (result[i] == WrapObject::wrapped) {
                             // "wrapped" means the path segment was wrapped over
@@ -1001,7 +1128,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                                 best_wrap = wr;
                                 // Store the best wrap in the pathWrap for 
                                 // possible use next time
-                                ws.setPreviousWrap(wr);
+                                ws.setPreviousWrap(s, wr);
                                 min_length_change = path_length_change;
                             } else {
                                 // The wrap was not shorter than the current 
@@ -1019,7 +1146,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                 ws.updWrapPoint2().getWrapPath().setSize(0);
 
                 if (best_wrap.wrap_pts.getSize() == 0) {
-                    ws.resetPreviousWrap();
+                    ws.resetPreviousWrap(s);
                     ws.updWrapPoint2().getWrapPath().setSize(0);
                 } else {
                     // If wrapping did occur, copy wrap info into the PathStruct.
@@ -1146,11 +1273,34 @@ calcLengthAfterPathComputation(const SimTK::State& s,
  */   
 double GeometryPath::
 computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
+{
+    return getMomentArmSolver().solve(s, aCoord,  *this);
+}
+
+SimTK::Vector GeometryPath::
+computeMomentArms(const SimTK::State& s,
+                  const std::vector<const Coordinate*>& coordinates) const
+{
+    return ~getMomentArmSolver().solve(s, coordinates, {this})[0];
+}
+
+SimTK::Matrix GeometryPath::
+computeMomentArmMatrix(const SimTK::State& s,
+                       const std::vector<const GeometryPath*>& paths,
+                       const std::vector<const Coordinate*>& coordinates)
+{
+    if (paths.empty())
+        return SimTK::Matrix(0, (int)coordinates.size());
+
+    return paths[0]->getMomentArmSolver().solve(s, coordinates, paths);
+}
+
+const MomentArmSolver& GeometryPath::getMomentArmSolver() const
 {
     if (!_maSolver)
         const_cast<Self*>(this)->_maSolver.reset(new MomentArmSolver(*_model));
 
-    return _maSolver->solve(s, aCoord,  *this);
+    return *_maSolver;
 }
 
 //_____________________________________________________________________________
@@ -91,6 +91,34 @@ private:
     mutable CacheVariable<double> _speedCV;
     mutable CacheVariable<Array<AbstractPathPoint*>> _currentPathCV;
     mutable CacheVariable<SimTK::Vec3> _colorCV;
+
+    // The generalized coordinates (q's) on which the path depends, their
+    // values when the path was last computed, and the resulting length and
+    // wrapping results. If none of these q's have changed since then, the
+    // path is reused rather than recomputed (see computePath()).
+    struct PathSnapshot {
+        std::vector<SimTK::QIndex> qIndices;
+        std::vector<double> q;
+        bool initialized = false;
+        bool hasPath = false;
+        double length = 0;
+        struct WrapPointData {
+            SimTK::Vec3 location;
+            Array<SimTK::Vec3> wrapPath;
+            double wrapLength = 0;
+        };
+        // Two entries (wrap point 1 and 2) per PathWrap.
+        std::vector<WrapPointData> wrapPoints;
+        friend std::ostream& operator<<(std::ostream& o,
+                const PathSnapshot& snapshot) {
+            o << "GeometryPath::PathSnapshot (" << snapshot.qIndices.size()
+              << " q's)" << std::endl;
+            return o;
+        }
+    };
+    // Depends on the Instance stage (not Position) so that it survives
+    // changes to the q's.
+    mutable CacheVariable<PathSnapshot> _snapshotCV;
     
 //=============================================================================
 // METHODS
@@ -155,13 +183,13 @@ public:
     @see setDefaultColor() **/
     SimTK::Vec3 getColor(const SimTK::State& s) const;
 
-    double getLength( const SimTK::State& s) const;
+    virtual double getLength( const SimTK::State& s) const;
     void setLength( const SimTK::State& s, double length) const;
     double getPreScaleLength( const SimTK::State& s) const;
     void setPreScaleLength( const SimTK::State& s, double preScaleLength);
     const Array<AbstractPathPoint*>& getCurrentPath( const SimTK::State& s) const;
 
-    double getLengtheningSpeed(const SimTK::State& s) const;
+    virtual double getLengtheningSpeed(const SimTK::State& s) const;
     void setLengtheningSpeed( const SimTK::State& s, double speed ) const;
 
     /** get the path as PointForceDirections directions, which can be used
@@ -176,7 +204,7 @@ public:
     @param[in,out] bodyForces   Vector of SpatialVec's (torque, force) on bodies
     @param[in,out] mobilityForces  Vector of generalized forces, one per mobility   
     */
-    void addInEquivalentForces(const SimTK::State& state,
+    virtual void addInEquivalentForces(const SimTK::State& state,
                                const double& tension, 
                                SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
                                SimTK::Vector& mobilityForces) const;
@@ -187,6 +215,24 @@ public:
     //--------------------------------------------------------------------------
     virtual double computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const;
 
+    /** Compute the moment arms of this path about each of the provided 
+    coordinates. This is equivalent to calling computeMomentArm() for each 
+    coordinate but the generalized forces due to the path are only computed 
+    once. */
+    SimTK::Vector computeMomentArms(const SimTK::State& s,
+            const std::vector<const Coordinate*>& coordinates) const;
+
+    /** Compute the moment arms of several paths (rows) about several 
+    coordinates (columns) of the same model in a single pass. The coupling
+    between coordinates due to constraints is computed once per coordinate 
+    and the generalized forces once per path, which is much cheaper than
+    calling computeMomentArm() for every path and coordinate (e.g., in 
+    MuscleAnalysis). 
+    @see MomentArmSolver */
+    static SimTK::Matrix computeMomentArmMatrix(const SimTK::State& s,
+            const std::vector<const GeometryPath*>& paths,
+            const std::vector<const Coordinate*>& coordinates);
+
     //--------------------------------------------------------------------------
     // SCALING
     //--------------------------------------------------------------------------
@@ -225,7 +271,16 @@ protected:
 
 private:
 
+    const MomentArmSolver& getMomentArmSolver() const;
     void computePath(const SimTK::State& s ) const;
+    // Find the q's that the path depends on: those of the mobilizers between
+    // ground and every frame to which a path point or wrap object is
+    // attached, and of the coordinates of MovingPathPoints and
+    // ConditionalPathPoints.
+    std::vector<SimTK::QIndex> findDependentQIndices(
+            const SimTK::State& s) const;
+    bool reusePreviousPath(const SimTK::State& s) const;
+    void savePathSnapshot(const SimTK::State& s) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
     void applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path ) const;
     double calcPathLengthChange(const SimTK::State& s, const WrapObject& wo, 
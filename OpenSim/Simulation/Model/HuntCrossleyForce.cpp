@@ -59,6 +59,7 @@ void HuntCrossleyForce::extendAddToSystem(SimTK::MultibodySystem& system) const
 
     SimTK::GeneralContactSubsystem& contacts = system.updContactSubsystem();
     SimTK::ContactSetIndex set = contacts.createContactSet();
+    std::vector<const ContactGeometry*> geometries;
     SimTK::HuntCrossleyForce force(_model->updForceSubsystem(), contacts, set);
     force.setTransitionVelocity(transitionVelocity);
     for (int i = 0; i < contactParametersSet.getSize(); ++i)
@@ -76,6 +77,7 @@ void HuntCrossleyForce::extendAddToSystem(SimTK::MultibodySystem& system) const
                     "./contactgeometryset/" + params.getGeometry()[j]);
 
             const ContactGeometry& geom = *contactGeom;
+            geometries.push_back(contactGeom);
             // B: base Frame (Body or Ground)
             // F: PhysicalFrame that this ContactGeometry is connected to
             // P: the frame defined (relative to F) by the location and
@@ -93,16 +95,63 @@ void HuntCrossleyForce::extendAddToSystem(SimTK::MultibodySystem& system) const
         }
     }
 
+    if (get_localize_contact_events()) {
+        addDiscreteVariable(ContactEventHandler::getOnsetTimeVariableName(),
+                SimTK::Stage::Dynamics);
+        const int numPairs = ContactEventHandler::addHandlersToSystem(
+                *this, geometries, system, _contactEventStatistics);
+        if (numPairs == 0) {
+            log_warn("{} '{}': None of the pairs of contact geometries "
+                     "support contact events.", getConcreteClassName(),
+                    getName());
+        }
+    } else {
+        _contactEventStatistics.clear();
+    }
+
     // Beyond the const Component get the index so we can access the
     // SimTK::Force later.
     HuntCrossleyForce* mutableThis = const_cast<HuntCrossleyForce *>(this);
     mutableThis->_index = force.getForceIndex();
 }
 
+void HuntCrossleyForce::extendInitStateFromProperties(SimTK::State& state) const
+{
+    Super::extendInitStateFromProperties(state);
+    if (get_localize_contact_events()) {
+        setDiscreteVariableValue(state,
+                ContactEventHandler::getOnsetTimeVariableName(),
+                -SimTK::Infinity);
+    }
+}
+
 void HuntCrossleyForce::constructProperties()
 {
     constructProperty_contact_parameters(ContactParametersSet());
     constructProperty_transition_velocity(0.01);
+    constructProperty_localize_contact_events(false);
+    constructProperty_impact_window(0.01);
+}
+
+void HuntCrossleyForce::resetContactEventStatistics()
+{
+    for (auto& stats : _contactEventStatistics) {
+        stats.numOnsets = 0;
+        stats.numReleases = 0;
+        stats.lastOnsetTime = SimTK::NaN;
+    }
+}
+
+double HuntCrossleyForce::getLastContactOnsetTime(const SimTK::State& s) const
+{
+    if (!get_localize_contact_events()) return -SimTK::Infinity;
+    return getDiscreteVariableValue(s,
+            ContactEventHandler::getOnsetTimeVariableName());
+}
+
+bool HuntCrossleyForce::isInImpactWindow(const SimTK::State& s) const
+{
+    return s.getTime() - getLastContactOnsetTime(s) < get_impact_window();
 }
 
 HuntCrossleyForce::ContactParametersSet& HuntCrossleyForce::
@@ -25,6 +25,7 @@
 // INCLUDE
 #include "Force.h"
 #include "OpenSim/Common/Set.h"
+#include "ContactEventHandler.h"
 
 namespace OpenSim {
 
@@ -50,6 +51,12 @@ public:
         "Material properties.");
     OpenSim_DECLARE_PROPERTY(transition_velocity, double,
         "Slip velocity (creep) at which peak static friction occurs.");
+    OpenSim_DECLARE_PROPERTY(localize_contact_events, bool,
+        "Use event triggers to localize the onset and release of contact "
+        "between the geometries (default: false).");
+    OpenSim_DECLARE_PROPERTY(impact_window, double,
+        "Duration after a contact onset during which isInImpactWindow() is "
+        "true (default: 0.01 s).");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -88,6 +95,37 @@ public:
     void setViscousFriction(double friction);
     void addGeometry(const std::string& name);
 
+    /** @name Contact events
+    If localize_contact_events is true, a ContactEventHandler is added for
+    every pair of geometries whose gap it can compute (pairs of ContactMesh%es
+    are skipped), so that the integrator stops exactly at contact onset and
+    release instead of rejecting steps as it runs into the stiffness
+    discontinuity. Combine isInImpactWindow() with an
+    IntegratorAccuracyPolicy to use a tighter accuracy and smaller steps only
+    right after impacts:
+    @code
+    force->set_localize_contact_events(true);
+    // ... initSystem() ...
+    IntegratorAccuracyPolicy policy(1e-3);
+    policy.addPhase("impact", [force](const SimTK::State& s) {
+                return force->isInImpactWindow(s);
+            }, 1e-6, 1e-4);
+    manager.setIntegratorAccuracyPolicy(policy);
+    @endcode */
+    /// @{
+    /** Onset and release counts for each monitored pair of geometries,
+    accumulated over all simulations since the system was created. */
+    const std::vector<ContactEventStatistics>&
+    getContactEventStatistics() const { return _contactEventStatistics; }
+    void resetContactEventStatistics();
+    /** The time of the most recent contact onset (-Infinity if there has
+    been none, or if contact events are not localized). */
+    double getLastContactOnsetTime(const SimTK::State& s) const;
+    /** Whether less than impact_window has passed since the most recent
+    contact onset. */
+    bool isInImpactWindow(const SimTK::State& s) const;
+    /// @}
+
 
     //-----------------------------------------------------------------------------
     // Reporting
@@ -107,12 +145,15 @@ protected:
      * Create a SimTK::Force which implements this Force.
      */
     void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+    void extendInitStateFromProperties(SimTK::State& state) const override;
 
 
 private:
     // INITIALIZATION
     void constructProperties();
 
+    mutable std::vector<ContactEventStatistics> _contactEventStatistics;
+
 //==============================================================================
 };  // END of class HuntCrossleyForce
 //==============================================================================
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "MarkerSet.h"
+#include "Model.h"
 
 using namespace std;
 using namespace OpenSim;
@@ -53,3 +54,67 @@ void MarkerSet::addNamePrefix(const string& prefix)
         get(i).setName(prefix + get(i).getName());
 }
 
+
+//=============================================================================
+// KINEMATICS
+//=============================================================================
+namespace {
+// The mobilized body of each marker and the marker's location in that body.
+void findMarkerStationsInBodies(const MarkerSet& markerSet,
+        SimTK::Array_<SimTK::MobilizedBodyIndex>& bodies,
+        SimTK::Array_<SimTK::Vec3>& stations) {
+    const int numMarkers = markerSet.getSize();
+    bodies.resize(numMarkers);
+    stations.resize(numMarkers);
+    for (int i = 0; i < numMarkers; ++i) {
+        const Marker& marker = markerSet.get(i);
+        const PhysicalFrame& frame = marker.getParentFrame();
+        bodies[i] = frame.getMobilizedBodyIndex();
+        stations[i] = frame.findTransformInBaseFrame() * marker.get_location();
+    }
+}
+
+void locateStations(const SimTK::SimbodyMatterSubsystem& matter,
+        const SimTK::State& s,
+        const SimTK::Array_<SimTK::MobilizedBodyIndex>& bodies,
+        const SimTK::Array_<SimTK::Vec3>& stations,
+        SimTK::Vector_<SimTK::Vec3>& locations) {
+    const int numStations = (int)stations.size();
+    locations.resize(numStations);
+    for (int i = 0; i < numStations; ++i) {
+        locations[i] = matter.getMobilizedBody(bodies[i])
+                .getBodyTransform(s) * stations[i];
+    }
+}
+}
+
+void MarkerSet::calcMarkerLocationsInGround(const SimTK::State& s,
+        SimTK::Vector_<SimTK::Vec3>& locations) const
+{
+    if (getSize() == 0) {
+        locations.resize(0);
+        return;
+    }
+    SimTK::Array_<SimTK::MobilizedBodyIndex> bodies;
+    SimTK::Array_<SimTK::Vec3> stations;
+    findMarkerStationsInBodies(*this, bodies, stations);
+    locateStations(get(0).getModel().getMatterSubsystem(), s, bodies,
+            stations, locations);
+}
+
+void MarkerSet::calcMarkerLocationsInGround(const SimTK::State& s,
+        SimTK::Vector_<SimTK::Vec3>& locations, SimTK::Matrix& jacobian) const
+{
+    if (getSize() == 0) {
+        locations.resize(0);
+        jacobian.resize(0, s.getNU());
+        return;
+    }
+    SimTK::Array_<SimTK::MobilizedBodyIndex> bodies;
+    SimTK::Array_<SimTK::Vec3> stations;
+    findMarkerStationsInBodies(*this, bodies, stations);
+    const SimTK::SimbodyMatterSubsystem& matter =
+            get(0).getModel().getMatterSubsystem();
+    locateStations(matter, s, bodies, stations, locations);
+    matter.calcStationJacobian(s, bodies, stations, jacobian);
+}
@@ -49,6 +49,25 @@ public:
     void getMarkerNames(Array<std::string>& aMarkerNamesArray) const;
     /** Add a prefix to marker names for all markers in the set**/
     void addNamePrefix(const std::string& prefix);
+
+    //--------------------------------------------------------------------------
+    // KINEMATICS
+    //--------------------------------------------------------------------------
+    /** Compute the locations in Ground of all markers in the set, in the
+    order of the set, for a state realized to at least Stage::Position. Each
+    marker is located directly from the pose of its mobilized body, which is
+    cheaper than calling Marker::getLocationInGround() for each marker. The
+    set must belong to a Model whose system has been created. */
+    void calcMarkerLocationsInGround(const SimTK::State& s,
+            SimTK::Vector_<SimTK::Vec3>& locations) const;
+    /** Same as above, and also compute the stacked station Jacobian of the
+    markers: a 3M x nu Matrix (for M markers) whose rows 3i to 3i+2 map the
+    generalized speeds to the linear velocity in Ground of marker i. The
+    Jacobians of all markers are formed with a single call to
+    SimTK::SimbodyMatterSubsystem::calcStationJacobian(). */
+    void calcMarkerLocationsInGround(const SimTK::State& s,
+            SimTK::Vector_<SimTK::Vec3>& locations,
+            SimTK::Matrix& jacobian) const;
 //=============================================================================
 };  // END of class MarkerSet
 //=============================================================================
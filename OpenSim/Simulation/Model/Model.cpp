@@ -35,6 +35,7 @@
 #include "ContactGeometrySet.h"
 #include "ControllerSet.h"
 #include "CoordinateSet.h"
+#include "ForceAdapter.h"
 #include "ForceSet.h"
 #include "Ligament.h"
 #include "MarkerSet.h"
@@ -43,11 +44,15 @@
 #include <iostream>
 #include <string>
 
+#include <OpenSim/Common/ComponentPhaseProfiler.h>
+#include <OpenSim/Common/ComponentRealizeProfiler.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Logger.h>
 #include <OpenSim/Common/ScaleSet.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Simulation/AssemblySolver.h>
 #include <OpenSim/Simulation/CoordinateReference.h>
@@ -79,6 +84,7 @@ Model::Model() : ModelComponent(),
     _coordinateSet(CoordinateSet()),
     _workingState(),
     _useVisualizer(false),
+    _profileInitSystem(false),
     _allControllersEnabled(true)
 {
     constructProperties();
@@ -96,6 +102,7 @@ Model::Model(const string &aFileName) :
     _coordinateSet(CoordinateSet()),
     _workingState(),
     _useVisualizer(false),
+    _profileInitSystem(false),
     _allControllersEnabled(true)
 {   
     constructProperties();
@@ -317,6 +324,7 @@ void Model::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 void Model::setNull()
 {
     _useVisualizer = false;
+    _profileInitSystem = false;
     _allControllersEnabled = true;
 
     _validationLog="";
@@ -381,6 +389,8 @@ void Model::constructProperties()
     ModelVisualPreferences mvps;
     mvps.setName(IO::Lowercase(mvps.getConcreteClassName()));
     constructProperty_ModelVisualPreferences(mvps);
+
+    constructProperty_use_parallel_forces(false);
 }
 
 // Append to the Model's validation log
@@ -394,11 +404,18 @@ void Model::appendToValidationLog(const std::string& note) {
 // Perform some final checks on the Model, wire up all its components, and then
 // build a computational System for it.
 void Model::buildSystem() {
+    OPENSIM_TRACE_SCOPE_CATEGORY("Model::buildSystem", "model");
     // Finish connecting up the Model.
-    setup();
+    {
+        OPENSIM_TRACE_SCOPE_CATEGORY("Model::setup", "model");
+        setup();
+    }
 
     // Create the computational System representing this Model.
-    createMultibodySystem();
+    {
+        OPENSIM_TRACE_SCOPE_CATEGORY("Model::createMultibodySystem", "model");
+        createMultibodySystem();
+    }
 
     // Create a Visualizer for this Model if one has been requested. This adds
     // necessary elements to the System. Doesn't initialize geometry yet.
@@ -407,17 +424,71 @@ void Model::buildSystem() {
 }
 
 
+//------------------------------------------------------------------------------
+//                          REALIZE PROFILING
+//------------------------------------------------------------------------------
+void Model::setProfileRealize(bool profile) {
+    if (!profile) {
+        _realizeProfiler.reset();
+    } else if (!_realizeProfiler) {
+        _realizeProfiler.reset(new ComponentRealizeProfiler(*this));
+    }
+}
+
+const ComponentRealizeProfiler& Model::getRealizeProfiler() const {
+    OPENSIM_THROW_IF_FRMOBJ(!_realizeProfiler, Exception,
+            "Realize profiling is off; call setProfileRealize(true) first.");
+    return *_realizeProfiler;
+}
+
+ComponentRealizeProfiler& Model::updRealizeProfiler() {
+    OPENSIM_THROW_IF_FRMOBJ(!_realizeProfiler, Exception,
+            "Realize profiling is off; call setProfileRealize(true) first.");
+    return *_realizeProfiler;
+}
+
+//------------------------------------------------------------------------------
+//                              INIT SYSTEM
+//------------------------------------------------------------------------------
+SimTK::State& Model::initSystem() {
+    OPENSIM_TRACE_SCOPE_CATEGORY("Model::initSystem", "model");
+    if (!_profileInitSystem) {
+        buildSystem();
+        return initializeState();
+    }
+
+    ComponentPhaseProfiler profiler;
+    profiler.start();
+    Stopwatch watch;
+    buildSystem();
+    const double buildTime = watch.getElapsedTime();
+    watch.reset();
+    SimTK::State& state = initializeState();
+    const double initializeTime = watch.getElapsedTime();
+    profiler.stop();
+
+    log_info("Model '{}': buildSystem() took {:.3f} ms and "
+             "initializeState() took {:.3f} ms.",
+            getName(), 1000.0 * buildTime, 1000.0 * initializeTime);
+    profiler.printResults();
+    return state;
+}
+
 //------------------------------------------------------------------------------
 //                            INITIALIZE STATE
 //------------------------------------------------------------------------------
 // Requires that buildSystem() has already been called.
 SimTK::State& Model::initializeState() {
+    OPENSIM_TRACE_SCOPE_CATEGORY("Model::initializeState", "model");
     if (!hasSystem()) 
         throw Exception("Model::initializeState(): call buildSystem() first.");
 
     // This tells Simbody to finalize the System.
-    getMultibodySystem().invalidateSystemTopologyCache();
-    getMultibodySystem().realizeTopology();
+    {
+        OPENSIM_TRACE_SCOPE_CATEGORY("Model::realizeTopology", "model");
+        getMultibodySystem().invalidateSystemTopologyCache();
+        getMultibodySystem().realizeTopology();
+    }
 
     // Set the model's operating state (internal member variable) to the 
     // default state that is stored inside the System.
@@ -447,8 +518,11 @@ SimTK::State& Model::initializeState() {
         getProbeSet().get(i).reset(_workingState);
 
     // Do the assembly
-    createAssemblySolver(_workingState);
-    assemble(_workingState);
+    {
+        OPENSIM_TRACE_SCOPE_CATEGORY("Model::assemble", "model");
+        createAssemblySolver(_workingState);
+        assemble(_workingState);
+    }
     // We can now collect up all the fixed geometry, which needs full configuration.
     if (getUseVisualizer())
         _modelViz->collectFixedGeometry(_workingState);
@@ -457,6 +531,68 @@ SimTK::State& Model::initializeState() {
 }
 
 
+SimTK::State& Model::initSystemFrom(const Model& source)
+{
+    buildSystem();
+    if (!source.isValidSystem()) return initializeState();
+
+    const SimTK::State& sourceState = source.getWorkingState();
+
+    // Proceed as in initializeState() up to realizing the Model stage, which
+    // allocates the remaining (Instance and later) state variables.
+    getMultibodySystem().invalidateSystemTopologyCache();
+    getMultibodySystem().realizeTopology();
+    _workingState = getMultibodySystem().getDefaultState();
+    _matter->setUseEulerAngles(_workingState, true);
+    getMultibodySystem().realizeModel(_workingState);
+
+    // The states of the two Systems are laid out identically if this model
+    // is an unedited copy of source, but they cannot be assigned to each
+    // other directly, so the variables are copied one subsystem at a time.
+    OPENSIM_THROW_IF_FRMOBJ(
+            _workingState.getNumSubsystems() != sourceState.getNumSubsystems(),
+            Exception,
+            "Expected the source model to have the same System as this model, "
+            "but the number of subsystems differs.");
+    for (SimTK::SubsystemIndex sx(0); sx < _workingState.getNumSubsystems();
+            ++sx) {
+        const int numDVs = _workingState.getNumDiscreteVariables(sx);
+        OPENSIM_THROW_IF_FRMOBJ(
+                numDVs != sourceState.getNumDiscreteVariables(sx), Exception,
+                "Expected the source model to have the same System as this "
+                "model, but the number of discrete variables differs.");
+        for (SimTK::DiscreteVariableIndex dx(0); dx < numDVs; ++dx) {
+            _workingState.updDiscreteVariable(sx, dx) =
+                    sourceState.getDiscreteVariable(sx, dx);
+        }
+    }
+    // Modeling options may have been among the discrete variables.
+    getMultibodySystem().realizeModel(_workingState);
+
+    OPENSIM_THROW_IF_FRMOBJ(_workingState.getNY() != sourceState.getNY(),
+            Exception,
+            "Expected the source model to have the same System as this model, "
+            "but the number of continuous state variables differs.");
+    _workingState.setTime(sourceState.getTime());
+    _workingState.setY(sourceState.getY());
+    getMultibodySystem().realize(_workingState, Stage::Position);
+
+    // The source state has already been assembled, but the solver is needed
+    // to assemble later changes to the coordinates.
+    createAssemblySolver(_workingState);
+    if (getUseVisualizer())
+        _modelViz->collectFixedGeometry(_workingState);
+
+    return _workingState;
+}
+
+Model* Model::cloneWithSystem() const
+{
+    std::unique_ptr<Model> copy(clone());
+    copy->initSystemFrom(*this);
+    return copy.release();
+}
+
 SimTK::State& Model::updWorkingState()
 {
     if (!isValidSystem())
@@ -589,6 +725,14 @@ void Model::createMultibodySystem()
     _gravityForce.reset(new SimTK::Force::Gravity(*_forceSubsystem, *_matter,
                 direction, magnitude));
 
+    // Forces are added to this group in Force::extendAddToSystem().
+    _parallelForceAdapter = nullptr;
+    if (get_use_parallel_forces()) {
+        auto* parallelForces = new ParallelForceAdapter(*this);
+        SimTK::Force::Custom force(*_forceSubsystem, parallelForces);
+        _parallelForceAdapter = parallelForces;
+    }
+
     addToSystem(*_system);
 }
 
@@ -1010,6 +1154,9 @@ void Model::extendAddToSystem(SimTK::MultibodySystem& system) const
         Stage::Velocity, Stage::Acceleration);
 
     mutableThis->_modelControlsIndex = modelControls.getSubsystemMeasureIndex();
+
+    _mobilizerReactionsCV = addCacheVariable("mobilizer_reactions",
+            SimTK::Vector_<SimTK::SpatialVec>(), Stage::Acceleration);
 }
 
 
@@ -1179,34 +1326,40 @@ void Model::generateDecorations
 
 void Model::equilibrateMuscles(SimTK::State& state)
 {
-    getMultibodySystem().realize(state, Stage::Velocity);
-
-    bool failed = false;
-    string errorMsg = "";
+    // Just because one muscle failed to equilibrate doesn't mean it isn't still
+    // useful to have remaining muscles equilibrate; in an analysis, for
+    // example, we might not be reporting about all muscles. So all muscles
+    // are equilibrated, and the first failure is reported afterwards.
+    const auto results = equilibrateMusclesWithDiagnostics(state);
+    for (const auto& result : results) {
+        if (!result.success) { // Notify the caller of the failure to equilibrate
+            throw Exception("Model::equilibrateMuscles() " + result.message,
+                    __FILE__, __LINE__);
+        }
+    }
+}
 
-    auto muscles = getComponentList<Muscle>();
+std::vector<Model::MuscleEquilibriumResult>
+Model::equilibrateMusclesWithDiagnostics(SimTK::State& state)
+{
+    getMultibodySystem().realize(state, Stage::Velocity);
 
-    for (auto& muscle : muscles) {
-        if (muscle.appliesForce(state)){
-            try{
-                muscle.computeEquilibrium(state);
-            }
-            catch (const std::exception& e) {
-                if(!failed){ // haven't failed to equilibrate other muscles yet
-                    errorMsg = e.what();
-                    failed = true;
-                }
-                // just because one muscle failed to equilibrate doesn't mean 
-                // it isn't still useful to have remaining muscles equilibrate
-                // in an analysis, for example, we might not be reporting about
-                // all muscles, so continue with the rest.
-                continue;
-            }
+    std::vector<MuscleEquilibriumResult> results;
+    for (const auto& muscle : getComponentList<Muscle>()) {
+        if (!muscle.appliesForce(state)) continue;
+        MuscleEquilibriumResult result;
+        result.path = muscle.getAbsolutePathString();
+        try {
+            muscle.computeEquilibrium(state);
+            result.success = true;
+        }
+        catch (const std::exception& e) {
+            result.message = e.what();
         }
+        result.iterations = muscle.getNumEquilibriumIterations();
+        results.push_back(result);
     }
-
-    if(failed) // Notify the caller of the failure to equilibrate 
-        throw Exception("Model::equilibrateMuscles() "+errorMsg, __FILE__, __LINE__);
+    return results;
 }
 
 //=============================================================================
@@ -1514,34 +1667,38 @@ bool Model::scale(SimTK::State& s, const ScaleSet& scaleSet,
     for (Body& body : updComponentList<Body>())
         body.scaleInertialProperties(scaleSet, !preserveMassDist);
 
-    // When bodies are scaled, the properties of the model are changed. The
-    // general rule is that you MUST recreate and initialize the system when
-    // properties of the model change. We must do that here or we will be
-    // querying a stale system (e.g., wrong body properties!).
-    s = initSystem();
-
     // Now that the masses of the individual bodies have been scaled (if
     // preserveMassDist == false), get the total mass and compare it to
     // finalMass in order to determine how much to scale the body masses again,
-    // so that the total model mass comes out to finalMass.
+    // so that the total model mass comes out to finalMass. The total mass is
+    // the sum of the bodies' masses, so this is done before the system is
+    // recreated below (rather than recreating it once more for the masses).
+    double totalMass = 0.0;
     if (finalMass > 0.0)
     {
-        const double mass = getTotalMass(s);
-        if (mass > 0.0)
+        for (const Body& body : getComponentList<Body>())
+            totalMass += body.getMass();
+        if (totalMass > 0.0)
         {
-            const double factor = finalMass / mass;
+            const double factor = finalMass / totalMass;
             for (Body& body : updComponentList<Body>())
                 body.scaleMass(factor);
+        }
+    }
 
-            // Recreate the system and update the state after updating masses.
-            s = initSystem();
+    // When bodies are scaled, the properties of the model are changed. The
+    // general rule is that you MUST recreate and initialize the system when
+    // properties of the model change. We must do that here or we will be
+    // querying a stale system (e.g., wrong body properties!).
+    s = initSystem();
 
-            // Ensure the final model mass is correct.
-            const double newMass = getTotalMass(s);
-            const double normDiffMass = abs(finalMass - newMass) / finalMass;
-            if (normDiffMass > SimTK::SignificantReal) {
-                throw Exception("Model::scale() scaled model mass does not match specified subject mass.");
-            }
+    // Ensure the final model mass is correct.
+    if (finalMass > 0.0 && totalMass > 0.0)
+    {
+        const double newMass = getTotalMass(s);
+        const double normDiffMass = abs(finalMass - newMass) / finalMass;
+        if (normDiffMass > SimTK::SignificantReal) {
+            throw Exception("Model::scale() scaled model mass does not match specified subject mass.");
         }
     }
 
@@ -1930,6 +2087,9 @@ void Model::computeControls(const SimTK::State& s, SimTK::Vector &controls) cons
     }
 
     for (const Controller& controller : this->_enabledControllers) {
+        ComponentRealizeProfiler::Scope scope(
+                ComponentRealizeProfiler::Section::ComputeControls,
+                controller);
         controller.computeControls(s, controls);
     }
 }
@@ -2199,6 +2359,32 @@ SimTK::Vec3 Model::calcMassCenterAcceleration(const SimTK::State &s) const
     return getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s);    
 }
 
+void Model::calcMobilizerReactionForces(const SimTK::State& s,
+        SimTK::Vector_<SimTK::SpatialVec>& reactions) const
+{
+    getMultibodySystem().realize(s, Stage::Acceleration);
+    const SimTK::SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    if (reactions.size() != matter.getNumBodies())
+        reactions.resize(matter.getNumBodies());
+    matter.calcMobilizerReactionForces(s, reactions);
+}
+
+const SimTK::Vector_<SimTK::SpatialVec>& Model::getMobilizerReactionForces(
+        const SimTK::State& s) const
+{
+    if (isCacheVariableValid(s, _mobilizerReactionsCV)) {
+        return getCacheVariableValue(s, _mobilizerReactionsCV);
+    }
+    // Realize before obtaining the cache entry, since realizing could
+    // invalidate it.
+    getMultibodySystem().realize(s, Stage::Acceleration);
+    SimTK::Vector_<SimTK::SpatialVec>& reactions =
+            updCacheVariableValue(s, _mobilizerReactionsCV);
+    calcMobilizerReactionForces(s, reactions);
+    markCacheVariableValid(s, _mobilizerReactionsCV);
+    return reactions;
+}
+
 /**
 * Construct outputs
 *
@@ -27,6 +27,7 @@
 #include <string>
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <OpenSim/Common/Units.h>
+#include <OpenSim/Common/ComponentRealizeProfiler.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <OpenSim/Simulation/AssemblySolver.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
@@ -62,6 +63,7 @@ class CoordinateSet;
 class Force;
 class Frame;
 class Muscle;
+class ParallelForceAdapter;
 class Storage;
 class ScaleSet;
 
@@ -221,6 +223,13 @@ public:
     OpenSim_DECLARE_UNNAMED_PROPERTY(ModelVisualPreferences,
         "Visual preferences for this model.");
 
+    OpenSim_DECLARE_PROPERTY(use_parallel_forces, bool,
+        "Compute the Forces in parallel on a pool of threads while realizing "
+        "to Dynamics (default: false). Forces that declare that their "
+        "computeForce() is not thread-safe are still computed serially. This "
+        "can reduce simulation time for models with many expensive Forces "
+        "(e.g., muscles or ligaments with wrapping).");
+
 //==============================================================================
 // OUTPUTS
 //==============================================================================
@@ -333,6 +342,28 @@ public:
     take effect at the next call to initSystem() on this %Model. **/
     bool getUseVisualizer() const {return _useVisualizer;}
 
+    /** Log (at the info level) the time spent in each phase of
+    initSystem(), in total and for each class of component, whenever
+    initSystem() is called on this %Model. The default is false.
+    @see ComponentPhaseProfiler **/
+    void setProfileInitSystem(bool profile) {_profileInitSystem=profile;}
+    bool getProfileInitSystem() const {return _profileInitSystem;}
+
+    /** Record the number of calls and the wall time of the realize(),
+    computeForce() and computeControls() methods of every component of this
+    %Model, until profiling is turned off again (which discards the recorded
+    calls). Copies of this %Model are not profiled. The default is false.
+    @see ComponentRealizeProfiler **/
+    void setProfileRealize(bool profile);
+    bool getProfileRealize() const {return _realizeProfiler != nullptr;}
+    /** The calls recorded since setProfileRealize(true); use
+    ComponentRealizeProfiler::getAsTable() or
+    ComponentRealizeProfiler::getFoldedStacks() to export them. This throws
+    an exception if profiling is off. **/
+    const ComponentRealizeProfiler& getRealizeProfiler() const;
+    /** Use this to clear() the recorded calls. **/
+    ComponentRealizeProfiler& updRealizeProfiler();
+
     /** Test whether a ModelVisualizer has been created for this Model. Even
     if visualization has been requested there will be no visualizer present
     until initSystem() has been successfully invoked. Use this method prior
@@ -390,10 +421,29 @@ public:
     initializeState(). This returns a reference to the writable internally-
     maintained model State. Note that this does not affect the 
     system's default state (which is part of the model and hence read-only). **/
-    SimTK::State& initSystem() SWIG_DECLARE_EXCEPTION {
-        buildSystem();
-        return initializeState();
-    }
+    SimTK::State& initSystem() SWIG_DECLARE_EXCEPTION;
+
+    /** Build the System of this model, which must be a copy (e.g., from
+    clone()) of `source`, and set the working state to a copy of the working
+    state of `source`. This is cheaper than initSystem() because the
+    initStateFromProperties() methods of the components and the assembly are
+    skipped; the state variables (including discrete variables such as
+    locked coordinates and disabled constraints) are taken from `source`
+    instead. If `source` does not have a valid System, this is equivalent to
+    initSystem(). The properties of this model must not have been edited
+    since it was copied.
+
+    @code
+    State& state = model.initSystem();
+    // ... on each worker thread:
+    std::unique_ptr<Model> copy(model.clone());
+    State& copyState = copy->initSystemFrom(model);
+    @endcode */
+    SimTK::State& initSystemFrom(const Model& source) SWIG_DECLARE_EXCEPTION;
+
+    /** Convenience method that clones this model and invokes initSystemFrom()
+    on the copy. The caller takes ownership of the copy. */
+    Model* cloneWithSystem() const SWIG_DECLARE_EXCEPTION;
 
 
     /** Convenience method that returns a reference to the model's 'working'
@@ -456,6 +506,29 @@ public:
      */
     void equilibrateMuscles(SimTK::State& state);
 
+    /** The outcome of equilibrating a single muscle; see
+    equilibrateMusclesWithDiagnostics(). */
+    struct MuscleEquilibriumResult {
+        /// Absolute path of the muscle.
+        std::string path;
+        bool success = false;
+        /// Solver iterations, or -1 if the muscle does not report them.
+        int iterations = -1;
+        /// The error message if the muscle could not be equilibrated.
+        std::string message;
+    };
+
+    /**
+     * Update the state of all Muscles (that apply force) so they are in
+     * equilibrium, as with equilibrateMuscles(), but without throwing if some
+     * of the muscles cannot be equilibrated. The state is realized to
+     * Velocity only once for all muscles. The result for each muscle includes
+     * the number of iterations its solver needed, which helps to find the
+     * muscles that make initializing a large model slow.
+     */
+    std::vector<MuscleEquilibriumResult> equilibrateMusclesWithDiagnostics(
+            SimTK::State& state);
+
     //--------------------------------------------------------------------------
     /**@name       Access to the Simbody System and components
 
@@ -841,6 +914,24 @@ public:
     double calcPotentialEnergy(const SimTK::State &s) const {
         return getMultibodySystem().calcPotentialEnergy(s);
     }
+    /** Compute the reaction forces of all mobilizers (joints) in a single
+    sweep of the multibody tree; the state is realized to Acceleration if
+    necessary. On return, `reactions` holds one SpatialVec (moment, force)
+    per MobilizedBodyIndex: the reaction of the mobilizer on its child body,
+    applied at the origin of the mobilizer's child (M) frame and expressed
+    in Ground. The buffer is resized only if its size differs from the number
+    of bodies, so it can be reused across calls. Pass the buffer to
+    Joint::calcReactionOnChildExpressedInGround() or
+    Joint::calcReactionOnParentExpressedInGround() to extract the reaction of
+    a Joint; this avoids a tree sweep for every joint. */
+    void calcMobilizerReactionForces(const SimTK::State& s,
+            SimTK::Vector_<SimTK::SpatialVec>& reactions) const;
+    /** Same as calcMobilizerReactionForces(), but the reactions are cached in
+    the state and computed only once per Stage::Acceleration realization.
+    Use this when several components (e.g., multiple joint reaction goals in
+    Moco) need the reactions at the same state. */
+    const SimTK::Vector_<SimTK::SpatialVec>& getMobilizerReactionForces(
+            const SimTK::State& s) const;
 
     int getNumMuscleStates() const;
     int getNumProbeStates() const;
@@ -1096,6 +1187,12 @@ private:
     // To provide access to private _modelComponents member.
     friend class Component; 
 
+    // Forces add themselves to the group of forces computed in parallel; this
+    // is null if use_parallel_forces is false.
+    ParallelForceAdapter* updParallelForceAdapter()
+    {   return _parallelForceAdapter.get(); }
+    friend class Force;
+
 //==============================================================================
 // DATA MEMBERS
 //==============================================================================
@@ -1162,6 +1259,9 @@ private:
     // a ModelVisualizer for display.
     bool _useVisualizer;
 
+    // If this flag is set, initSystem() logs the time spent in each phase.
+    bool _profileInitSystem;
+
     // Global flag used to disable all Controllers.
     bool _allControllersEnabled;
 
@@ -1182,6 +1282,8 @@ private:
         _forceSubsystem;
     SimTK::ResetOnCopy<std::unique_ptr<SimTK::GeneralContactSubsystem>>
         _contactSubsystem;
+    // Owned by the force subsystem.
+    SimTK::ReferencePtr<ParallelForceAdapter> _parallelForceAdapter;
 
     // We place this after the subsystems so that during copy construction and
     // copy assignment, the subsystem handles are copied first. If the system
@@ -1200,6 +1302,10 @@ private:
     // Default values pooled from Actuators upon system creation.
     mutable SimTK::Vector _defaultControls;
 
+    // Reactions of all mobilizers, shared by all users at a given state.
+    mutable CacheVariable<SimTK::Vector_<SimTK::SpatialVec>>
+        _mobilizerReactionsCV;
+
 
     //                          VISUALIZATION
     // Anyone generating display geometry from this Model should consult this
@@ -1212,6 +1318,11 @@ private:
     // copied.
     SimTK::ResetOnCopy<std::unique_ptr<ModelVisualizer>> _modelViz;
 
+    // Created by setProfileRealize(true); copies of the Model are not
+    // profiled.
+    SimTK::ResetOnCopy<std::unique_ptr<ComponentRealizeProfiler>>
+            _realizeProfiler;
+
 //==============================================================================
 };  // END of class Model
 //==============================================================================
@@ -0,0 +1,105 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  ModelCache.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelCache.h"
+
+#include "Model.h"
+#include <OpenSim/Common/FileAdapter.h>
+#include <OpenSim/Common/IO.h>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+using namespace OpenSim;
+
+namespace {
+struct CacheEntry {
+    std::size_t contentHash;
+    std::size_t contentSize;
+    std::unique_ptr<Model> prototype;
+};
+
+std::mutex& getCacheMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, CacheEntry>& getCache() {
+    static std::map<std::string, CacheEntry> cache;
+    return cache;
+}
+
+std::string getAbsolutePath(const std::string& fileName) {
+    const bool isAbsolute =
+            (!fileName.empty() && (fileName[0] == '/' || fileName[0] == '\\')) ||
+            (fileName.size() > 1 && fileName[1] == ':');
+    if (isAbsolute) return fileName;
+    return IO::getCwd() + "/" + fileName;
+}
+} // namespace
+
+std::unique_ptr<Model> ModelCache::load(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!file.good(), FileDoesNotExist, fileName);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string contents = buffer.str();
+    const std::size_t contentHash = std::hash<std::string>()(contents);
+    const std::string key = getAbsolutePath(fileName);
+
+    {
+        std::lock_guard<std::mutex> lock(getCacheMutex());
+        auto it = getCache().find(key);
+        if (it != getCache().end() &&
+                it->second.contentHash == contentHash &&
+                it->second.contentSize == contents.size()) {
+            std::unique_ptr<Model> model(it->second.prototype->clone());
+            model->finalizeFromProperties();
+            return model;
+        }
+    }
+
+    // Parse the file without holding the lock so that other files can be
+    // loaded at the same time.
+    std::unique_ptr<Model> prototype(new Model(fileName));
+    std::unique_ptr<Model> model(prototype->clone());
+    model->finalizeFromProperties();
+
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    CacheEntry& entry = getCache()[key];
+    entry.contentHash = contentHash;
+    entry.contentSize = contents.size();
+    entry.prototype = std::move(prototype);
+    return model;
+}
+
+void ModelCache::clear() {
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    getCache().clear();
+}
+
+int ModelCache::getSize() {
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    return (int)getCache().size();
+}
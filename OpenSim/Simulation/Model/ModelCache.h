@@ -0,0 +1,66 @@
+#ifndef OPENSIM_MODEL_CACHE_H_
+#define OPENSIM_MODEL_CACHE_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  ModelCache.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <memory>
+#include <string>
+
+namespace OpenSim {
+
+class Model;
+
+/** A process-wide cache of models loaded from .osim files. The first call to
+load() for a file parses the XML and deserializes the model as
+Model(const std::string&) does, and keeps the result as a prototype. Later
+calls for the same file return a copy of the prototype, which copies the
+property tree directly and avoids parsing XML and looking up properties by
+name.
+
+Each entry is keyed by the absolute path of the file and stores a hash and the
+size of the file's contents. If the file has changed since it was cached, the
+stale entry is replaced by loading the file again. Files referenced by the
+model (e.g., external property files or geometry) are not checked.
+
+The returned models are independent copies: modifying one does not affect
+the cache or other copies. The cache may be used from multiple threads.
+
+@code
+auto model = ModelCache::load("gait2354.osim");
+model->initSystem();
+@endcode */
+class OSIMSIMULATION_API ModelCache {
+public:
+    /** Return a copy of the model in the given file, loading the file only if
+    it is not in the cache or has changed. The returned model has been
+    finalized from its properties (but initSystem() has not been called). */
+    static std::unique_ptr<Model> load(const std::string& fileName);
+    /** Remove all models from the cache. */
+    static void clear();
+    /** The number of files in the cache. */
+    static int getSize();
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MODEL_CACHE_H_
@@ -23,7 +23,9 @@
 
 #include "ModelVisualizer.h"
 #include "Model.h"
+#include "Geometry.h"
 #include <OpenSim/version.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <simbody/internal/Visualizer_InputListener.h>
 #include <simbody/internal/Visualizer_Reporter.h>
@@ -122,9 +124,23 @@ void DefaultGeometry::generateDecorations
    (const State&                         state, 
     Array_<SimTK::DecorativeGeometry>&   geometry) 
 {
-    // Ask all the ModelComponents to generate dynamic geometry.
-    _model.generateDecorations(false, _model.getDisplayHints(),
-                               state, geometry);
+    if (!_cacheValid) {
+        // Geometry is only regenerated per frame if its transform is supplied
+        // through its Input; otherwise, it was part of the fixed geometry.
+        _dynamicComponents.clear();
+        for (const auto& comp : _model.getComponentList()) {
+            const auto* geom = dynamic_cast<const OpenSim::Geometry*>(&comp);
+            if (geom && !geom->getInput("transform").isConnected()) continue;
+            _dynamicComponents.push_back(&comp);
+        }
+        _cacheValid = true;
+    }
+
+    // Ask the ModelComponents to generate dynamic geometry.
+    const ModelDisplayHints& hints = _model.getDisplayHints();
+    for (const auto* comp : _dynamicComponents) {
+        comp->generateDecorations(false, hints, state, geometry);
+    }
 }
 
 //==============================================================================
@@ -275,6 +291,15 @@ void ModelVisualizer::createVisualizer() {
                                         ToggleDefaultGeometry));
     _viz->addMenu("Show", ShowMenuId, selections);
 
+    // Parse the model's mesh files concurrently now, rather than one at a
+    // time while generating the first frame.
+    std::vector<const Mesh*> meshes;
+    for (const auto& mesh : _model.getComponentList<Mesh>()) {
+        meshes.push_back(&mesh);
+    }
+    parallelFor((int)meshes.size(),
+            [&](int i) { meshes[i]->loadMeshFile(); });
+
     // Add a DecorationGenerator to dispatch runtime generateDecorations()
     // calls.
     _decoGen = new DefaultGeometry(_model);
@@ -296,6 +321,9 @@ void ModelVisualizer::createVisualizer() {
 // We also rummage through the model to find fixed geometry that should be part
 // of every frame. The supplied State must be realized through Instance stage.
 void ModelVisualizer::collectFixedGeometry(const State& state) const {
+    // The model's components may have changed since the last frame.
+    _decoGen->invalidateCache();
+
     // Collect any fixed geometry from the ModelComponents.
     Array_<DecorativeGeometry> fixedGeometry;
     _model.generateDecorations
@@ -30,8 +30,10 @@ that uses the OpenSim API. **/
 
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <simbody/internal/Visualizer.h>
+#include <vector>
 
 namespace OpenSim {
+class Component;
 class Model;
 }
 
@@ -44,6 +46,12 @@ namespace SimTK {
 // This class implements a SimTK DecorationGenerator. We'll add one to the
 // Visualizer so it can invoke the generateDecorations() dispatcher to pick up 
 // per-frame geometry.
+//
+// Geometry attached to a frame is fixed: it is sent to the Visualizer once (by
+// ModelVisualizer::collectFixedGeometry()) and only the body transforms are
+// updated for each frame. To avoid walking the entire component tree on every
+// frame, the components that may generate per-frame geometry are cached the
+// first time decorations are generated after invalidateCache().
 class DefaultGeometry : public DecorationGenerator {
 public:
     DefaultGeometry(OpenSim::Model& model) : _model(model) {
@@ -56,6 +64,10 @@ public:
     }
     void generateDecorations(const SimTK::State& state, 
                              SimTK::Array_<SimTK::DecorativeGeometry>& geometry) override;
+    // Find the components that generate per-frame geometry again the next
+    // time decorations are generated. This must be called whenever the
+    // model's components or their connections change.
+    void invalidateCache() {_cacheValid = false;}
     double getDispMarkerRadius() {return _dispMarkerRadius;}
     void   setDispMarkerRadius(double a) {_dispMarkerRadius=a;}
     double getDispMarkerOpacity() {return _dispMarkerOpacity;}
@@ -79,6 +91,10 @@ static void drawPathPoint(const SimTK::MobilizedBodyIndex&             body,
 private:
     OpenSim::Model&  _model;
 
+    // Components that may generate per-frame geometry.
+    std::vector<const OpenSim::Component*> _dynamicComponents;
+    bool _cacheValid = false;
+
     // Displayer internal variables
     double _dispMarkerRadius;
     double _dispMarkerOpacity;
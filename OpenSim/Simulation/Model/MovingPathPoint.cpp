@@ -28,6 +28,7 @@
 #include <OpenSim/Common/Function.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/MultiplierFunction.h>
+#include <OpenSim/Simulation/Model/ConditionalPathPoint.h>
 #include <OpenSim/Simulation/Model/PhysicalFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
 #include <OpenSim/Common/ScaleSet.h>
@@ -213,35 +214,56 @@ void MovingPathPoint::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionN
     Super::updateFromXMLNode(aNode, versionNumber);
 }
 
+void MovingPathPoint::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    // The location depends only on the coordinate values.
+    this->_locationInFrameCV = addCacheVariable("location_in_frame",
+            SimTK::Vec3(0), SimTK::Stage::Position);
+    this->_dPointdQCV = addCacheVariable("dpoint_dq", SimTK::Vec3(0),
+            SimTK::Stage::Position);
+}
+
 SimTK::Vec3 MovingPathPoint::getLocation(const SimTK::State& s) const
+{
+    // A Position-stage cache entry can only be filled once the state has been
+    // realized to Stage::Time.
+    if (s.getSystemStage() < SimTK::Stage::Time) return calcLocation(s);
+    if (!isCacheVariableValid(s, _locationInFrameCV)) {
+        setCacheVariableValue(s, _locationInFrameCV, calcLocation(s));
+    }
+    return getCacheVariableValue(s, _locationInFrameCV);
+}
+
+SimTK::Vec3 MovingPathPoint::calcLocation(const SimTK::State& s) const
 {
     SimTK::Vec3 pInF(0);
     if (!_xCoordinate.empty()) {
         const double xval = SimTK::clamp(_xCoordinate->getRangeMin(),
             _xCoordinate->getValue(s),
             _xCoordinate->getRangeMax());
-        pInF[0] = get_x_location().calcValue(SimTK::Vector(1, xval));
+        pInF[0] = get_x_location().calcValueAt(xval);
     }
     else // assume a Constant
-        pInF[0] = get_x_location().calcValue(SimTK::Vector(1, 0.0));
+        pInF[0] = get_x_location().calcValueAt(0.0);
 
     if (!_yCoordinate.empty()) {
         const double yval = SimTK::clamp(_yCoordinate->getRangeMin(),
             _yCoordinate->getValue(s),
             _yCoordinate->getRangeMax());
-        pInF[1] = get_y_location().calcValue(SimTK::Vector(1, yval));
+        pInF[1] = get_y_location().calcValueAt(yval);
     }
     else // type == Constant
-        pInF[1] = get_y_location().calcValue(SimTK::Vector(1, 0.0));
+        pInF[1] = get_y_location().calcValueAt(0.0);
 
     if (!_zCoordinate.empty()) {
         const double zval = SimTK::clamp(_zCoordinate->getRangeMin(),
             _zCoordinate->getValue(s),
             _zCoordinate->getRangeMax());
-        pInF[2] = get_z_location().calcValue(SimTK::Vector(1, zval));
+        pInF[2] = get_z_location().calcValueAt(zval);
     }
     else // type == Constant
-        pInF[2] = get_z_location().calcValue(SimTK::Vector(1, 0.0));
+        pInF[2] = get_z_location().calcValueAt(0.0);
 
     return pInF;
 }
@@ -249,38 +271,16 @@ SimTK::Vec3 MovingPathPoint::getLocation(const SimTK::State& s) const
 
 SimTK::Vec3 MovingPathPoint::getVelocity(const SimTK::State& s) const
 {
-    std::vector<int> derivComponents;
-    derivComponents.push_back(0);
-
+    // Multiply the partial (derivative of point coordinate w.r.t. gencoord)
+    // by genspeed.
+    const SimTK::Vec3 dPdq = getdPointdQ(s);
     SimTK::Vec3 vInF(0);
-
-    if (!_xCoordinate.empty()){
-        //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        vInF[0] = get_x_location().calcDerivative(
-            derivComponents, SimTK::Vector(1, _xCoordinate->getValue(s)))*
-                _xCoordinate->getSpeedValue(s);
-    }
-    else
-        vInF[0] = 0.0;
-
-    if (!_yCoordinate.empty()){
-        //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        vInF[1] = get_y_location().calcDerivative(
-            derivComponents, SimTK::Vector(1, _yCoordinate->getValue(s)))*
-                _yCoordinate->getSpeedValue(s);
-    }
-    else
-        vInF[1] = 0.0;
-
-    if (!_zCoordinate.empty()){
-        //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        vInF[2] = get_z_location().calcDerivative(
-            derivComponents, SimTK::Vector(1, _zCoordinate->getValue(s)))*
-                _zCoordinate->getSpeedValue(s);
-    }
-    else
-        vInF[2] = 0.0;
-
+    if (!_xCoordinate.empty())
+        vInF[0] = dPdq[0] * _xCoordinate->getSpeedValue(s);
+    if (!_yCoordinate.empty())
+        vInF[1] = dPdq[1] * _yCoordinate->getSpeedValue(s);
+    if (!_zCoordinate.empty())
+        vInF[2] = dPdq[2] * _zCoordinate->getSpeedValue(s);
     return vInF;
 }
 
@@ -290,30 +290,50 @@ SimTK::Vec3 MovingPathPoint::getVelocity(const SimTK::State& s) const
  */
 SimTK::Vec3 MovingPathPoint::getdPointdQ(const SimTK::State& s) const
 {
-    SimTK::Vec3 dPdq_B(0);
+    if (s.getSystemStage() < SimTK::Stage::Time) return calcdPointdQ(s);
+    if (!isCacheVariableValid(s, _dPointdQCV)) {
+        setCacheVariableValue(s, _dPointdQCV, calcdPointdQ(s));
+    }
+    return getCacheVariableValue(s, _dPointdQCV);
+}
 
-    std::vector<int> derivComponents;
-    derivComponents.push_back(0);
+SimTK::Vec3 MovingPathPoint::calcdPointdQ(const SimTK::State& s) const
+{
+    SimTK::Vec3 dPdq_B(0);
 
     if (!_xCoordinate.empty()){
         //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        dPdq_B[0] = get_x_location().calcDerivative(derivComponents, 
-            SimTK::Vector(1, _xCoordinate->getValue(s)));
+        dPdq_B[0] = get_x_location().calcDerivativeAt(
+            _xCoordinate->getValue(s), 1);
     }
     if (!_yCoordinate.empty()){
         //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        dPdq_B[1] = get_y_location().calcDerivative(derivComponents,
-            SimTK::Vector(1, _yCoordinate->getValue(s)));
+        dPdq_B[1] = get_y_location().calcDerivativeAt(
+            _yCoordinate->getValue(s), 1);
     }
     if (!_zCoordinate.empty()){
         //Multiply the partial (derivative of point coordinate w.r.t. gencoord) by genspeed
-        dPdq_B[2] = get_z_location().calcDerivative(derivComponents,
-            SimTK::Vector(1, _zCoordinate->getValue(s)));
+        dPdq_B[2] = get_z_location().calcDerivativeAt(
+            _zCoordinate->getValue(s), 1);
     }
 
     return dPdq_B;
 }
 
+void MovingPathPoint::updatePathPointCaches(
+        const Component& root, const SimTK::State& s)
+{
+    OPENSIM_THROW_IF(s.getSystemStage() < SimTK::Stage::Time, Exception,
+            "Expected the state to be realized to at least Stage::Time.");
+    for (const auto& point : root.getComponentList<MovingPathPoint>()) {
+        point.getLocation(s);
+        point.getdPointdQ(s);
+    }
+    for (const auto& point : root.getComponentList<ConditionalPathPoint>()) {
+        point.isActive(s);
+    }
+}
+
 void MovingPathPoint::
 extendScale(const SimTK::State& s, const ScaleSet& scaleSet)
 {
@@ -98,15 +98,29 @@ public:
     // Override methods from PathPoint.
     bool isActive(const SimTK::State& s) const override { return true; }
 
-    /** Get the local location of the MovingPathPoint in its Frame */
+    /** Get the local location of the MovingPathPoint in its Frame. The
+        location is computed once per State and cached (at the Position
+        stage). */
     SimTK::Vec3 getLocation(const SimTK::State& s) const override;
     /** Get the local velocity of the MovingPathPoint w.r.t to and 
         expressed in its Frame. To get the velocity of the point w.r.t.
         and expressed in Ground, call getVelocityInGround(). */
     SimTK::Vec3 getVelocity(const SimTK::State& s) const;
 
+    /** The derivative of each component of the location with respect to its
+        coordinate (cached like the location). */
     SimTK::Vec3 getdPointdQ(const SimTK::State& s) const override; 
 
+    /** Compute and cache the location and its derivative of every
+        MovingPathPoint (and whether every ConditionalPathPoint is active) in
+        the tree rooted at `root` (e.g., a Model). The State must be realized
+        to at least Stage::Time. The caches are otherwise filled the first
+        time each point is used; filling them all at once avoids writing to
+        the State later, e.g., before the paths are evaluated from several
+        threads that share the State in read-only fashion. */
+    static void updatePathPointCaches(
+            const Component& root, const SimTK::State& s);
+
     /** Scale the underlying MultiplierFunctions associated with the
         MovingPathPoint. */
     void extendScale(const SimTK::State& s, const ScaleSet& scaleSet) override;
@@ -114,6 +128,10 @@ public:
 private:
     void constructProperties();
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+    SimTK::Vec3 calcLocation(const SimTK::State& s) const;
+    SimTK::Vec3 calcdPointdQ(const SimTK::State& s) const;
 
     SimTK::Vec3 calcLocationInGround(const SimTK::State& state) const override;
     SimTK::Vec3 calcVelocityInGround(const SimTK::State& state) const override;
@@ -124,6 +142,9 @@ private:
     SimTK::ReferencePtr<const Coordinate> _yCoordinate;
     SimTK::ReferencePtr<const Coordinate> _zCoordinate;
 
+    mutable CacheVariable<SimTK::Vec3> _locationInFrameCV;
+    mutable CacheVariable<SimTK::Vec3> _dPointdQCV;
+
 //=============================================================================
 };  // END of class MovingPathPoint
 //=============================================================================
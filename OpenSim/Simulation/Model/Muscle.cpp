@@ -208,6 +208,8 @@ void Muscle::extendConnectToModel(Model& aModel)
     _optimalFiberLength = getOptimalFiberLength();
     _pennationAngleAtOptimal = getPennationAngleAtOptimalFiberLength();
     _tendonSlackLength = getTendonSlackLength();
+
+    _equilibriumTable.clear();
 }
 
 // Add Muscle's contributions to the underlying system
@@ -618,6 +620,13 @@ void Muscle::calcMuscleDynamicsInfo(const SimTK::State& s, MuscleDynamicsInfo& m
         + "::calcMuscleDynamicsInfo() NOT IMPLEMENTED.");
 }
 
+/* analytic partial derivatives of the tendon force and fiber dynamics */
+Muscle::ForceJacobian Muscle::calcForceJacobian(const SimTK::State& s) const
+{
+    throw Exception("ERROR- "+getConcreteClassName()
+        + "::calcForceJacobian() NOT IMPLEMENTED.");
+}
+
 /* calculate muscle's fiber and tendon potential energy */
 void Muscle::calcMusclePotentialEnergyInfo(const SimTK::State& s, 
     MusclePotentialEnergyInfo& mpei) const
@@ -640,6 +649,25 @@ double Muscle::calcInextensibleTendonActiveFiberForce(SimTK::State& s,
         *mli.cosPennationAngle;
 }
 
+double Muscle::lookUpEquilibriumGuess(double activation,
+        double muscleTendonLength,
+        const std::function<double(double, double)>& solve) const
+{
+    if (!_useEquilibriumTable) return SimTK::NaN;
+
+    const double lengthScale = getOptimalFiberLength() + getTendonSlackLength();
+    if (!_equilibriumTable.isBuilt()) {
+        log_debug("Building the equilibrium table of muscle '{}'.", getName());
+        _equilibriumTable.build(
+                [&](double tableActivation, double normMuscleTendonLength) {
+                    return solve(tableActivation,
+                            normMuscleTendonLength * lengthScale);
+                });
+    }
+    return _equilibriumTable.interpolate(
+            activation, muscleTendonLength / lengthScale);
+}
+
 //=============================================================================
 // FORCE APPLICATION
 //=============================================================================
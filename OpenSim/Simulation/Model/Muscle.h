@@ -26,6 +26,7 @@
 
 // INCLUDE
 #include "PathActuator.h"
+#include "MuscleEquilibriumTable.h"
 
 #ifdef SWIG
     #ifdef OSIMSIMULATION_API
@@ -340,9 +341,59 @@ public:
     void computeEquilibrium(SimTK::State& s) const override final {
         return computeInitialFiberEquilibrium(s);
     }
+    /** The number of solver iterations used by the most recent call to
+    computeEquilibrium() for this muscle, or -1 if the muscle does not solve
+    for its equilibrium iteratively (or does not report its iterations).
+    @see Model::equilibrateMusclesWithDiagnostics() */
+    virtual int getNumEquilibriumIterations() const { return -1; }
+    /** Start computeEquilibrium() from a table of equilibrium solutions over
+    activation and musculotendon length (see MuscleEquilibriumTable); with a
+    good starting point, the equilibrium solver often converges without
+    iterating. The table is built the first time it is needed, which takes
+    hundreds of equilibrium solves, so this pays off only when the muscle is
+    equilibrated many times (e.g., for ensembles of simulations). This option
+    is not serialized, and is ignored by muscles that do not support it
+    (supported by Thelen2003Muscle, Millard2012EquilibriumMuscle and
+    DeGrooteFregly2016Muscle). Default: false. */
+    void setUseEquilibriumTable(bool tf) { _useEquilibriumTable = tf; }
+    bool getUseEquilibriumTable() const { return _useEquilibriumTable; }
     // End of Muscle's State Dependent Accessors.
     //@} 
 
+    /** @name Muscle partial derivatives
+     */
+    //@{
+    /** Analytic partial derivatives of the force-generating equations of a
+    muscle, computed by calcForceJacobian(). Each Vec4 holds the partial
+    derivatives with respect to, in order, activation, normalized fiber
+    length, normalized fiber velocity, and musculotendon length (m); these
+    are treated as independent variables, as in an implicit formulation of
+    the fiber dynamics. */
+    struct ForceJacobian {
+        /// Partial derivatives of the tendon force (N). With a rigid
+        /// tendon, these are the same as for fiberForceAlongTendon.
+        SimTK::Vec4 tendonForce{0};
+        /// Partial derivatives of the fiber force along the tendon (N). The
+        /// muscle is in equilibrium when this force equals the tendon force.
+        SimTK::Vec4 fiberForceAlongTendon{0};
+        /// Partial derivatives of the time derivative of normalized fiber
+        /// length (1/s) when the normalized fiber velocity is found from the
+        /// equilibrium between the fiber and tendon forces, as in an explicit
+        /// formulation of the fiber dynamics. The entry for the normalized
+        /// fiber velocity is therefore zero. All entries are zero with a
+        /// rigid tendon.
+        SimTK::Vec4 normFiberLengthDerivative{0};
+    };
+    /** Whether this muscle implements calcForceJacobian(). */
+    virtual bool hasForceJacobian() const { return false; }
+    /** Compute analytic partial derivatives of the tendon force and the
+    fiber dynamics at the current state, which must be realized to
+    SimTK::Stage::Velocity. These can be used by implicit integrators and
+    optimal control solvers in place of finite differences. The default
+    implementation throws an exception; see hasForceJacobian(). */
+    virtual ForceJacobian calcForceJacobian(const SimTK::State& s) const;
+    //@}
+
     ///@cond
     //--------------------------------------------------------------------------
     // Estimate the muscle force for a given activation based on a rigid tendon 
@@ -412,6 +463,15 @@ protected:
     computeFiberEquilibriumAtZeroVelocity(). */
     virtual void computeInitialFiberEquilibrium(SimTK::State& s) const = 0;
 
+    /** For use in computeInitialFiberEquilibrium(): if
+    getUseEquilibriumTable() is true, interpolate a starting point for the
+    equilibrium solver from the equilibrium table, building the table if
+    necessary by calling `solve(activation, muscleTendonLength)`, which
+    returns the equilibrium value (or NaN if there is none) at a grid point.
+    Returns NaN if the table is not used or does not cover the given point. */
+    double lookUpEquilibriumGuess(double activation, double muscleTendonLength,
+            const std::function<double(double, double)>& solve) const;
+
     // End of Muscle's State Related Calculations.
     //@} 
 
@@ -868,6 +928,11 @@ protected:
     mutable CacheVariable<Muscle::MuscleDynamicsInfo> _dynamicsInfoCV;
     mutable CacheVariable<Muscle::MusclePotentialEnergyInfo> _potentialEnergyInfoCV;
 
+    bool _useEquilibriumTable = false;
+    /** Built on first use; cleared when the muscle is connected to a model,
+    since its parameters may have changed. */
+    mutable MuscleEquilibriumTable _equilibriumTable;
+
 //=============================================================================
 };  // END of class Muscle
 //=============================================================================
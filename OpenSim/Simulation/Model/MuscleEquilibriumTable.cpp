@@ -0,0 +1,88 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  MuscleEquilibriumTable.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MuscleEquilibriumTable.h"
+
+#include <OpenSim/Common/Exception.h>
+#include <SimTKcommon.h>
+#include <algorithm>
+
+using namespace OpenSim;
+
+MuscleEquilibriumTable::MuscleEquilibriumTable(double minNormLength,
+        double maxNormLength, int numLengths, int numActivations)
+        : m_minNormLength(minNormLength), m_maxNormLength(maxNormLength),
+          m_numLengths(numLengths), m_numActivations(numActivations) {
+    OPENSIM_THROW_IF(maxNormLength <= minNormLength, Exception,
+            "Expected the maximum normalized length to be greater than the "
+            "minimum.");
+    OPENSIM_THROW_IF(numLengths < 2 || numActivations < 2, Exception,
+            "Expected at least 2 lengths and 2 activations.");
+}
+
+void MuscleEquilibriumTable::build(const Solver& solve) {
+    std::vector<double> values(m_numActivations * m_numLengths);
+    for (int i = 0; i < m_numActivations; ++i) {
+        const double activation = double(i) / (m_numActivations - 1);
+        for (int j = 0; j < m_numLengths; ++j) {
+            const double normLength = m_minNormLength +
+                    (m_maxNormLength - m_minNormLength) * j /
+                            (m_numLengths - 1);
+            double value = SimTK::NaN;
+            try {
+                value = solve(activation, normLength);
+            } catch (const std::exception&) {
+                // No solution at this grid point; interpolation near it
+                // returns NaN.
+            }
+            values[i * m_numLengths + j] = value;
+        }
+    }
+    m_values = std::move(values);
+}
+
+double MuscleEquilibriumTable::interpolate(
+        double activation, double normMuscleTendonLength) const {
+    if (!isBuilt() || !(activation >= 0 && activation <= 1) ||
+            !(normMuscleTendonLength >= m_minNormLength &&
+                    normMuscleTendonLength <= m_maxNormLength)) {
+        return SimTK::NaN;
+    }
+
+    const auto locate = [](double x, int n, int& index, double& weight) {
+        const double position = x * (n - 1);
+        index = std::min((int)position, n - 2);
+        weight = position - index;
+    };
+    int i, j;
+    double wa, wl;
+    locate(activation, m_numActivations, i, wa);
+    locate((normMuscleTendonLength - m_minNormLength) /
+                    (m_maxNormLength - m_minNormLength),
+            m_numLengths, j, wl);
+
+    const double* row0 = &m_values[i * m_numLengths + j];
+    const double* row1 = row0 + m_numLengths;
+    // The result is NaN if any of the corners is NaN.
+    return (1 - wa) * ((1 - wl) * row0[0] + wl * row0[1]) +
+           wa * ((1 - wl) * row1[0] + wl * row1[1]);
+}
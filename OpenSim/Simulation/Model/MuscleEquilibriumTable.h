@@ -0,0 +1,77 @@
+#ifndef OPENSIM_MUSCLE_EQUILIBRIUM_TABLE_H_
+#define OPENSIM_MUSCLE_EQUILIBRIUM_TABLE_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  MuscleEquilibriumTable.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <functional>
+#include <vector>
+
+namespace OpenSim {
+
+/** A table of the equilibrium solutions of a muscle over a grid of
+activation and normalized musculotendon length (the musculotendon length
+divided by the sum of the optimal fiber length and the tendon slack length),
+used by Muscle to start its equilibrium solver close to the solution. The
+tabulated value is whatever the muscle solves for (e.g., the normalized fiber
+length); the table is built by calling the muscle's solver at each grid point
+and is interpolated bilinearly.
+
+@see Muscle::setUseEquilibriumTable() */
+class OSIMSIMULATION_API MuscleEquilibriumTable {
+public:
+    /** Solve for the equilibrium value at the given activation and
+    normalized musculotendon length. Return NaN if there is no solution. */
+    using Solver = std::function<double(double activation,
+            double normMuscleTendonLength)>;
+
+    /** The grid spans activations in [0, 1] and normalized musculotendon
+    lengths in [minNormLength, maxNormLength]. */
+    MuscleEquilibriumTable(double minNormLength = 0.5,
+            double maxNormLength = 1.5, int numLengths = 51,
+            int numActivations = 11);
+
+    bool isBuilt() const { return !m_values.empty(); }
+    /** Discard the tabulated values, e.g., after the muscle's parameters have
+    changed. */
+    void clear() { m_values.clear(); }
+    /** Tabulate the equilibrium values by calling `solve` at each grid
+    point. */
+    void build(const Solver& solve);
+
+    /** Interpolate the equilibrium value at the given point. This is NaN if
+    the table has not been built, if the point is outside the grid, or if
+    there was no solution at one of the neighboring grid points. */
+    double interpolate(double activation, double normMuscleTendonLength) const;
+
+private:
+    double m_minNormLength;
+    double m_maxNormLength;
+    int m_numLengths;
+    int m_numActivations;
+    // Row-major: one row of lengths per activation.
+    std::vector<double> m_values;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MUSCLE_EQUILIBRIUM_TABLE_H_
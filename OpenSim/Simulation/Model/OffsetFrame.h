@@ -164,6 +164,7 @@ protected:
     /**@{**/
     void extendFinalizeFromProperties() override;
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     /**@}**/
 
     // The transform X_GO for this OffsetFrame, O, in Ground, G.
@@ -183,6 +184,14 @@ private:
 
     // the Offset transform in its parent frame
     SimTK::Transform _offsetTransform;
+
+    // The base frame, B, of this OffsetFrame and the composed transform X_BO
+    // of the chain of offsets leading to it, resolved when the frame is added
+    // to the system. The kinematics in Ground are computed directly from the
+    // (cached) kinematics of the base frame instead of recursing through the
+    // intermediate offset frames.
+    mutable SimTK::ReferencePtr<const Frame> _baseFrame;
+    mutable SimTK::Transform _offsetInBaseFrame;
 //=============================================================================
 }; // END of class OffsetFrame
 //=============================================================================
@@ -251,6 +260,9 @@ template <class C>
 SimTK::Transform OffsetFrame<C>::
 calcTransformInGround(const SimTK::State& state) const
 {
+    if (!_baseFrame.empty()) {
+        return _baseFrame->getTransformInGround(state)*_offsetInBaseFrame;
+    }
     return this->getParentFrame().getTransformInGround(state)*getOffsetTransform();
 }
 
@@ -258,6 +270,13 @@ template <class C>
 SimTK::SpatialVec OffsetFrame<C>::
 calcVelocityInGround(const SimTK::State& state) const
 {
+    if (!_baseFrame.empty()) {
+        const SimTK::Vec3 r = _baseFrame->getTransformInGround(state).R()*
+            _offsetInBaseFrame.p();
+        SimTK::SpatialVec V_GB = _baseFrame->getVelocityInGround(state);
+        V_GB(1) += V_GB(0) % r;
+        return V_GB;
+    }
     // The rigid offset of the OffsetFrame expressed in ground
     const SimTK::Vec3& r = this->getParentFrame().getTransformInGround(state).R()*
         getOffsetTransform().p();
@@ -273,6 +292,14 @@ template <class C>
 SimTK::SpatialVec OffsetFrame<C>::
 calcAccelerationInGround(const SimTK::State& state) const
 {
+    if (!_baseFrame.empty()) {
+        const SimTK::Vec3 r = _baseFrame->getTransformInGround(state).R()*
+            _offsetInBaseFrame.p();
+        const SimTK::SpatialVec& V_GB = _baseFrame->getVelocityInGround(state);
+        SimTK::SpatialVec A_GB = _baseFrame->getAccelerationInGround(state);
+        A_GB[1] += (A_GB[0] % r + V_GB[0] % (V_GB[0] % r));
+        return A_GB;
+    }
     // The rigid offset of the OffsetFrame expressed in ground
     const SimTK::Vec3& r = this->getParentFrame().getTransformInGround(state).R()*
         getOffsetTransform().p();
@@ -360,6 +387,17 @@ void OffsetFrame<C>::extendConnectToModel(Model& model)
     Super::extendConnectToModel(model);
     OPENSIM_THROW_IF(this == &getParentFrame(), Exception,
         getConcreteClassName() + " cannot connect to itself!");
+    _baseFrame.reset();
+}
+
+template<class C>
+void OffsetFrame<C>::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    // All frames are connected by now, so the chain of offsets can be
+    // composed once rather than on every evaluation of the kinematics.
+    _offsetInBaseFrame = this->findTransformInBaseFrame();
+    _baseFrame.reset(&this->findBaseFrame());
 }
 
 } // end of namespace OpenSim
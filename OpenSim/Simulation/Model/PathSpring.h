@@ -184,6 +184,11 @@ protected:
         values.append(getTension(state));
         return values;
     }
+    int writeRecordValues(const SimTK::State& state,
+            double* values) const override {
+        values[0] = getTension(state);
+        return 1;
+    }
 
 private:
     void constructProperties();
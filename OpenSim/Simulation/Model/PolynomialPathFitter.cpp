@@ -0,0 +1,367 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  PolynomialPathFitter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "PolynomialPathFitter.h"
+#include "FunctionBasedPath.h"
+#include "Model.h"
+#include <OpenSim/Common/MultivariatePolynomialFunction.h>
+
+#include <array>
+
+using namespace OpenSim;
+
+namespace {
+
+/// The exponents of each term of a MultivariatePolynomialFunction, in the
+/// order of the coefficients of that class.
+std::vector<std::array<int, 4>> createExponents(int dimension, int order) {
+    std::vector<std::array<int, 4>> exponents;
+    std::array<int, 4> nq{{0, 0, 0, 0}};
+    for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
+        const int nq2_s = dimension < 2 ? 0 : order - nq[0];
+        for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
+            const int nq3_s = dimension < 3 ? 0 : order - nq[0] - nq[1];
+            for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
+                const int nq4_s =
+                        dimension < 4 ? 0 : order - nq[0] - nq[1] - nq[2];
+                for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
+                    exponents.push_back(nq);
+                }
+            }
+        }
+    }
+    return exponents;
+}
+
+double calcTerm(const std::array<int, 4>& exponents, const double* x,
+        int dimension) {
+    double value = 1;
+    for (int i = 0; i < dimension; ++i) {
+        value *= std::pow(x[i], exponents[i]);
+    }
+    return value;
+}
+
+double calcTermDerivative(const std::array<int, 4>& exponents,
+        const double* x, int dimension, int derivComponent) {
+    if (exponents[derivComponent] == 0) return 0;
+    double value = 1;
+    for (int i = 0; i < dimension; ++i) {
+        if (i == derivComponent) {
+            value *= exponents[i] * std::pow(x[i], exponents[i] - 1);
+        } else {
+            value *= std::pow(x[i], exponents[i]);
+        }
+    }
+    return value;
+}
+
+} // anonymous namespace
+
+std::vector<PolynomialPathFitter::PathFitResult> PolynomialPathFitter::fit(
+        Model& model, bool replacePaths) const {
+    OPENSIM_THROW_IF(m_maxOrder < 1, Exception,
+            "Expected the maximum polynomial order to be at least 1, but got "
+            "{}.", m_maxOrder);
+    OPENSIM_THROW_IF(m_numSamples < 1, Exception,
+            "Expected the number of samples to be at least 1, but got {}.",
+            m_numSamples);
+
+    SimTK::State state = model.initSystem();
+    const SimTK::Vector defaultQ = state.getQ();
+
+    std::vector<const GeometryPath*> paths;
+    for (const auto& path : model.getComponentList<GeometryPath>()) {
+        if (dynamic_cast<const FunctionBasedPath*>(&path)) continue;
+        paths.push_back(&path);
+    }
+    const int numPaths = (int)paths.size();
+    if (!numPaths) return {};
+
+    std::vector<const Coordinate*> coords;
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        if (coord.isConstrained(state)) continue;
+        coords.push_back(&coord);
+    }
+    const int numCoords = (int)coords.size();
+
+    // Columns of the coordinate trajectory, if provided, for each coordinate.
+    const bool useTrajectory = m_trajectory.getNumRows() > 0;
+    const int numSamples =
+            useTrajectory ? (int)m_trajectory.getNumRows() : m_numSamples;
+    std::vector<int> trajectoryColumn(numCoords, -1);
+    std::vector<double> trajectoryScale(numCoords, 1.0);
+    if (useTrajectory) {
+        bool inDegrees = false;
+        if (m_trajectory.hasTableMetaDataKey("inDegrees")) {
+            inDegrees = m_trajectory.getTableMetaDataAsString("inDegrees") ==
+                        "yes";
+        }
+        const auto& labels = m_trajectory.getColumnLabels();
+        for (int ic = 0; ic < numCoords; ++ic) {
+            const std::string coordPath = coords[ic]->getAbsolutePathString();
+            for (int icol = 0; icol < (int)labels.size(); ++icol) {
+                if (labels[icol] == coordPath ||
+                        labels[icol] == coordPath + "/value") {
+                    trajectoryColumn[ic] = icol;
+                    break;
+                }
+            }
+            if (inDegrees &&
+                    coords[ic]->getMotionType() == Coordinate::Rotational) {
+                trajectoryScale[ic] = SimTK_DEGREE_TO_RADIAN;
+            }
+        }
+    }
+
+    // Coupler constraints must be satisfied for the sampled lengths to be
+    // meaningful.
+    const bool assemble = model.getConstraintSet().getSize() > 0;
+    auto realizePose = [&]() {
+        if (assemble) model.assemble(state);
+        model.realizePosition(state);
+    };
+
+    // Detect the coordinates spanned by each path by sweeping each
+    // coordinate across its range, with the other coordinates at their
+    // default values.
+    const int numSweepPoints = 5;
+    std::vector<std::vector<int>> spanned(numPaths);
+    std::vector<bool> isSampled(numCoords, false);
+    for (int ic = 0; ic < numCoords; ++ic) {
+        const Coordinate& coord = *coords[ic];
+        std::vector<double> minLength(numPaths, SimTK::Infinity);
+        std::vector<double> maxLength(numPaths, -SimTK::Infinity);
+        for (int k = 0; k < numSweepPoints; ++k) {
+            state.updQ() = defaultQ;
+            coord.setValue(state,
+                    coord.getRangeMin() + k * (coord.getRangeMax() -
+                                                      coord.getRangeMin()) /
+                                                  (numSweepPoints - 1),
+                    false);
+            realizePose();
+            for (int ip = 0; ip < numPaths; ++ip) {
+                const double length = paths[ip]->getLength(state);
+                minLength[ip] = std::min(minLength[ip], length);
+                maxLength[ip] = std::max(maxLength[ip], length);
+            }
+        }
+        for (int ip = 0; ip < numPaths; ++ip) {
+            if (maxLength[ip] - minLength[ip] > m_sensitivity) {
+                spanned[ip].push_back(ic);
+                isSampled[ic] = true;
+            }
+        }
+    }
+
+    std::vector<PathFitResult> results(numPaths);
+    for (int ip = 0; ip < numPaths; ++ip) {
+        PathFitResult& result = results[ip];
+        result.ownerPath = paths[ip]->getOwner().getAbsolutePathString();
+        for (int ic : spanned[ip]) {
+            result.coordinates.push_back(coords[ic]->getAbsolutePathString());
+        }
+        if (spanned[ip].empty()) {
+            result.message = "The path does not span any coordinate.";
+        } else if (spanned[ip].size() > 4) {
+            result.message = fmt::format("The path spans {} coordinates, but "
+                    "at most 4 are supported.", spanned[ip].size());
+        }
+    }
+
+    // Sample the lengths and moment arms at random poses or along the
+    // coordinate trajectory.
+    SimTK::Random::Uniform random(0.0, 1.0);
+    random.setSeed(m_seed);
+    SimTK::Matrix coordValues(numSamples, numCoords, 0.0);
+    SimTK::Matrix lengths(numSamples, numPaths, 0.0);
+    std::vector<SimTK::Matrix> momentArms(numPaths);
+    for (int ip = 0; ip < numPaths; ++ip) {
+        momentArms[ip].resize(numSamples, (int)spanned[ip].size());
+    }
+    for (int j = 0; j < numSamples; ++j) {
+        state.updQ() = defaultQ;
+        for (int ic = 0; ic < numCoords; ++ic) {
+            const Coordinate& coord = *coords[ic];
+            if (useTrajectory) {
+                if (trajectoryColumn[ic] == -1) continue;
+                coord.setValue(state,
+                        trajectoryScale[ic] *
+                                m_trajectory.getMatrix()(
+                                        j, trajectoryColumn[ic]),
+                        false);
+                continue;
+            }
+            if (!isSampled[ic]) continue;
+            coord.setValue(state, coord.getRangeMin() +
+                    random.getValue() *
+                            (coord.getRangeMax() - coord.getRangeMin()),
+                    false);
+        }
+        realizePose();
+        for (int ic = 0; ic < numCoords; ++ic) {
+            coordValues(j, ic) = coords[ic]->getValue(state);
+        }
+        for (int ip = 0; ip < numPaths; ++ip) {
+            if (!results[ip].message.empty()) continue;
+            lengths(j, ip) = paths[ip]->getLength(state);
+            if (!m_includeMomentArms) continue;
+            for (int k = 0; k < (int)spanned[ip].size(); ++k) {
+                momentArms[ip](j, k) = paths[ip]->computeMomentArm(
+                        state, *coords[spanned[ip][k]]);
+            }
+        }
+    }
+
+    // Fit the polynomials, increasing the order until the length tolerance
+    // is met.
+    for (int ip = 0; ip < numPaths; ++ip) {
+        PathFitResult& result = results[ip];
+        if (!result.message.empty()) continue;
+        const int dim = (int)spanned[ip].size();
+        const int numRows = numSamples * (m_includeMomentArms ? dim + 1 : 1);
+
+        SimTK::Matrix x(numSamples, dim);
+        for (int j = 0; j < numSamples; ++j) {
+            for (int k = 0; k < dim; ++k) {
+                x(j, k) = coordValues(j, spanned[ip][k]);
+            }
+        }
+
+        for (int order = 1; order <= m_maxOrder; ++order) {
+            const auto exponents = createExponents(dim, order);
+            const int numCoeffs = (int)exponents.size();
+            if (numCoeffs > numRows) break;
+
+            SimTK::Matrix A(numRows, numCoeffs);
+            SimTK::Vector b(numRows);
+            std::vector<double> xj(dim);
+            const double* xp = xj.data();
+            int row = 0;
+            for (int j = 0; j < numSamples; ++j) {
+                for (int k = 0; k < dim; ++k) xj[k] = x(j, k);
+                for (int c = 0; c < numCoeffs; ++c) {
+                    A(row, c) = calcTerm(exponents[c], xp, dim);
+                }
+                b[row++] = lengths(j, ip);
+                if (!m_includeMomentArms) continue;
+                for (int k = 0; k < dim; ++k) {
+                    for (int c = 0; c < numCoeffs; ++c) {
+                        A(row, c) =
+                                -calcTermDerivative(exponents[c], xp, dim, k);
+                    }
+                    b[row++] = momentArms[ip](j, k);
+                }
+            }
+
+            SimTK::Vector coeffs;
+            SimTK::FactorQTZ qtz(A);
+            qtz.solve(b, coeffs);
+
+            // Errors.
+            double sumSqLength = 0, maxLength = 0;
+            double sumSqMomentArm = 0, maxMomentArm = 0;
+            for (int j = 0; j < numSamples; ++j) {
+                for (int k = 0; k < dim; ++k) xj[k] = x(j, k);
+                double length = 0;
+                for (int c = 0; c < numCoeffs; ++c) {
+                    length += coeffs[c] * calcTerm(exponents[c], xp, dim);
+                }
+                const double lengthError = std::abs(length - lengths(j, ip));
+                sumSqLength += SimTK::square(lengthError);
+                maxLength = std::max(maxLength, lengthError);
+                if (!m_includeMomentArms) continue;
+                for (int k = 0; k < dim; ++k) {
+                    double momentArm = 0;
+                    for (int c = 0; c < numCoeffs; ++c) {
+                        momentArm -= coeffs[c] *
+                                calcTermDerivative(exponents[c], xp, dim, k);
+                    }
+                    const double momentArmError =
+                            std::abs(momentArm - momentArms[ip](j, k));
+                    sumSqMomentArm += SimTK::square(momentArmError);
+                    maxMomentArm = std::max(maxMomentArm, momentArmError);
+                }
+            }
+
+            result.success = true;
+            result.order = order;
+            result.coefficients = coeffs;
+            result.lengthRMSError = std::sqrt(sumSqLength / numSamples);
+            result.lengthMaxError = maxLength;
+            if (m_includeMomentArms) {
+                result.momentArmRMSError =
+                        std::sqrt(sumSqMomentArm / (numSamples * dim));
+                result.momentArmMaxError = maxMomentArm;
+            }
+            if (result.lengthRMSError < m_lengthTolerance) break;
+        }
+        if (!result.success) {
+            result.message = fmt::format("Not enough samples ({}) to fit a "
+                    "polynomial of order 1.", numSamples);
+        }
+    }
+
+    if (replacePaths) {
+        // Create all replacement paths before modifying the model, since
+        // replacing a path deletes the original GeometryPath.
+        std::vector<std::unique_ptr<FunctionBasedPath>> newPaths(numPaths);
+        for (int ip = 0; ip < numPaths; ++ip) {
+            const PathFitResult& result = results[ip];
+            if (!result.success) continue;
+            newPaths[ip].reset(new FunctionBasedPath(*paths[ip]));
+            for (const auto& coordPath : result.coordinates) {
+                newPaths[ip]->appendCoordinate(coordPath);
+            }
+            newPaths[ip]->setLengthFunction(MultivariatePolynomialFunction(
+                    result.coefficients, (int)result.coordinates.size(),
+                    result.order));
+        }
+        for (int ip = 0; ip < numPaths; ++ip) {
+            if (!newPaths[ip]) continue;
+            Component& owner = model.updComponent(results[ip].ownerPath);
+            owner.updPropertyByName(GeometryPath::getClassName())
+                    .setValueAsObject(*newPaths[ip]);
+        }
+        model.finalizeFromProperties();
+    }
+
+    return results;
+}
+
+void PolynomialPathFitter::printResults(
+        const std::vector<PathFitResult>& results) {
+    log_info("{:<40} {:>6} {:>5} {:>14} {:>14} {:>14} {:>14}", "path",
+            "ncoord", "order", "length RMS", "length max", "MA RMS",
+            "MA max");
+    for (const auto& result : results) {
+        if (!result.success) {
+            log_info("{:<40} {}", result.ownerPath, result.message);
+            continue;
+        }
+        log_info("{:<40} {:>6} {:>5} {:>14.6e} {:>14.6e} {:>14.6e} "
+                 "{:>14.6e}",
+                result.ownerPath, result.coordinates.size(), result.order,
+                result.lengthRMSError, result.lengthMaxError,
+                result.momentArmRMSError, result.momentArmMaxError);
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+#define OPENSIM_POLYNOMIAL_PATH_FITTER_H_
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  PolynomialPathFitter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <SimTKcommon.h>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** Fit a MultivariatePolynomialFunction to the length of every GeometryPath
+in a model and (optionally) replace the paths with FunctionBasedPath%s.
+
+The coordinates spanned by each path are detected by sweeping each
+unconstrained coordinate across its range and checking whether the length of
+the path changes. The model is then sampled at random poses within the ranges
+of the spanned coordinates. At each pose, the lengths and moment arms of the
+original (wrapped) paths are computed, and the polynomial coefficients are
+found with a linear least-squares fit to both the lengths and the moment arms
+(the moment arms are the negated derivatives of the polynomial). The polynomial
+order is increased until the root-mean-square length error is below the
+length tolerance or the maximum order is reached.
+
+Alternatively, the paths can be sampled along a known coordinate trajectory
+(setCoordinateTrajectory()), such as the prescribed kinematics of a
+MocoInverse problem. The fit is then accurate near that trajectory, which is
+all that is needed when the kinematics are prescribed.
+
+Because MultivariatePolynomialFunction supports at most 4 arguments, paths
+spanning more than 4 coordinates are not fitted; this is noted in the result
+for that path.
+
+@code
+Model model("subject.osim");
+PolynomialPathFitter fitter;
+fitter.setMaximumPolynomialOrder(5);
+auto results = fitter.fit(model);
+PolynomialPathFitter::printResults(results);
+model.initSystem(); // The fitted paths are now FunctionBasedPaths.
+@endcode */
+class OSIMSIMULATION_API PolynomialPathFitter {
+public:
+    /** Fit diagnostics for a single path. The errors are computed over all
+    of the sampled poses. */
+    struct PathFitResult {
+        /// Absolute path of the component that owns the path (e.g., a muscle).
+        std::string ownerPath;
+        /// Absolute paths of the coordinates spanned by the path.
+        std::vector<std::string> coordinates;
+        /// Whether a polynomial has been fitted for this path.
+        bool success = false;
+        /// Explanation of why a path could not be fitted.
+        std::string message;
+        int order = 0;
+        SimTK::Vector coefficients;
+        double lengthRMSError = SimTK::NaN;
+        double lengthMaxError = SimTK::NaN;
+        double momentArmRMSError = SimTK::NaN;
+        double momentArmMaxError = SimTK::NaN;
+    };
+
+    PolynomialPathFitter() = default;
+
+    /** The highest polynomial order to try (default: 6). */
+    void setMaximumPolynomialOrder(int order) { m_maxOrder = order; }
+    int getMaximumPolynomialOrder() const { return m_maxOrder; }
+    /** The number of random poses at which the paths are sampled
+    (default: 1000). */
+    void setNumSamples(int numSamples) { m_numSamples = numSamples; }
+    int getNumSamples() const { return m_numSamples; }
+    /** Stop increasing the polynomial order once the root-mean-square length
+    error falls below this value, in meters (default: 0.5 mm). */
+    void setLengthTolerance(double tol) { m_lengthTolerance = tol; }
+    double getLengthTolerance() const { return m_lengthTolerance; }
+    /** A path is considered to span a coordinate if its length changes by
+    more than this value, in meters, over the coordinate's range
+    (default: 0.1 mm). */
+    void setCoordinateSensitivity(double sens) { m_sensitivity = sens; }
+    double getCoordinateSensitivity() const { return m_sensitivity; }
+    /** Include the moment arms (computed with the MomentArmSolver) in the
+    fit and in the error report (default: true). Without moment arms,
+    sampling is much faster but the moment arms of the fitted paths are less
+    accurate. */
+    void setIncludeMomentArms(bool tf) { m_includeMomentArms = tf; }
+    bool getIncludeMomentArms() const { return m_includeMomentArms; }
+    /** Seed for the random poses, so fits are reproducible (default: 0). */
+    void setRandomSeed(int seed) { m_seed = seed; }
+    /** Sample the paths at the poses in the rows of this table instead of at
+    random poses; the number of samples is then the number of rows. Column
+    labels are absolute coordinate paths, optionally followed by "/value" (as
+    in a states table). Other columns (e.g., speeds or muscle states) are
+    ignored, and coordinates without a column keep their default values.
+    Rotational coordinates are converted to radians if the table metadata
+    has inDegrees=yes. Pass an empty table to sample random poses again. */
+    void setCoordinateTrajectory(TimeSeriesTable trajectory) {
+        m_trajectory = std::move(trajectory);
+    }
+
+    /** Fit all GeometryPath%s in the model (FunctionBasedPath%s are skipped).
+    If `replacePaths` is true, each path that was fitted successfully is
+    replaced with a FunctionBasedPath that uses the fitted polynomial; call
+    initSystem() on the model afterwards. */
+    std::vector<PathFitResult> fit(Model& model,
+            bool replacePaths = true) const;
+
+    /** Log a table with the fit errors of each path. */
+    static void printResults(const std::vector<PathFitResult>& results);
+
+private:
+    int m_maxOrder = 6;
+    int m_numSamples = 1000;
+    double m_lengthTolerance = 0.0005;
+    double m_sensitivity = 0.0001;
+    bool m_includeMomentArms = true;
+    int m_seed = 0;
+    TimeSeriesTable m_trajectory;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_POLYNOMIAL_PATH_FITTER_H_
@@ -0,0 +1,329 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ModelSceneExporter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelSceneExporter.h"
+
+#include "StatesTrajectory.h"
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/TableUtilities.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+using namespace OpenSim;
+
+ModelSceneExporter::Scene ModelSceneExporter::generate(
+        const Model& modelIn, const TimeSeriesTable& statesIn) const {
+    OPENSIM_THROW_IF(!(m_frameRate > 0), Exception,
+            "Expected a positive frame rate, but got {}.", m_frameRate);
+    OPENSIM_THROW_IF(statesIn.getNumRows() == 0, Exception,
+            "Expected the states table to have at least one row.");
+
+    Model model(modelIn);
+    model.setUseVisualizer(false);
+    SimTK::State state = model.initSystem();
+
+    TimeSeriesTable states = statesIn;
+    if (TableUtilities::isInDegrees(states)) {
+        model.getSimbodyEngine().convertDegreesToRadians(states);
+    }
+    if (states.getNumRows() > 1) {
+        states = TableUtilities::resampleWithInterval(
+                states, 1.0 / m_frameRate);
+    }
+
+    // Columns that contain state variables.
+    const auto stateVariableNames = model.getStateVariableNames();
+    std::vector<int> columns;
+    std::vector<std::string> names;
+    const auto& labels = states.getColumnLabels();
+    for (int i = 0; i < (int)labels.size(); ++i) {
+        if (stateVariableNames.findIndex(labels[i]) != -1) {
+            columns.push_back(i);
+            names.push_back(labels[i]);
+        }
+    }
+    OPENSIM_THROW_IF(names.empty(), Exception,
+            "None of the column labels of the states table are paths to "
+            "state variables of model '{}'.", model.getName());
+
+    Scene scene;
+    scene.frameRate = m_frameRate;
+    const auto& times = states.getIndependentColumn();
+    const int numFrames = (int)times.size();
+    scene.frames.resize(numFrames);
+
+    // Set the state to a frame of the table.
+    auto setState = [&](const Model& m, const std::vector<int>& indices,
+                            SimTK::State& s, int frame) {
+        s.setTime(times[frame]);
+        const auto row = states.getRowAtIndex(frame);
+        SimTK::Vector values((int)columns.size());
+        for (int i = 0; i < (int)columns.size(); ++i) {
+            values[i] = row[columns[i]];
+        }
+        m.setStateVariableValuesAtSystemIndices(s, indices, values);
+    };
+
+    // The fixed decorations are the same for all frames.
+    setState(model, model.getStateVariableSystemIndices(names), state, 0);
+    model.realizePosition(state);
+    model.generateDecorations(true, model.getDisplayHints(), state,
+            scene.fixedDecorations);
+
+    int numThreads = m_numThreads;
+    if (numThreads <= 0) {
+        numThreads = getNumAvailableThreads();
+    }
+    numThreads = std::max(1, std::min(numThreads, numFrames));
+    const ThreadReservation reservation(numThreads);
+
+    // Each thread generates a contiguous chunk of frames with its own copy of
+    // the model, since decorations may be created lazily (e.g., meshes are
+    // loaded when they are first displayed). Copying the model concurrently
+    // is not known to be safe, so the copies are made here.
+    std::vector<std::unique_ptr<Model>> copies;
+    for (int t = 0; t < numThreads; ++t) copies.emplace_back(model.clone());
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto generateChunk = [&](int t) {
+        try {
+            const int first = (int)((long long)numFrames * t / numThreads);
+            const int last = (int)((long long)numFrames * (t + 1) / numThreads);
+            Model& copy = *copies[t];
+            SimTK::State s = copy.initSystem();
+            const auto indices = copy.getStateVariableSystemIndices(names);
+            const auto& matter = copy.getMatterSubsystem();
+            for (int i = first; i < last; ++i) {
+                setState(copy, indices, s, i);
+                // Realizing to Report allows, for example, muscles to be
+                // colored by their activation.
+                copy.realizeReport(s);
+                Frame& frame = scene.frames[i];
+                frame.time = times[i];
+                frame.bodyTransforms.resize(matter.getNumBodies());
+                for (int b = 0; b < matter.getNumBodies(); ++b) {
+                    frame.bodyTransforms[b] =
+                            matter.getMobilizedBody(SimTK::MobilizedBodyIndex(b))
+                                    .getBodyTransform(s);
+                }
+                copy.generateDecorations(false, copy.getDisplayHints(), s,
+                        frame.decorations);
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; ++t) threads.emplace_back(generateChunk, t);
+    generateChunk(0);
+    for (auto& thread : threads) thread.join();
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return scene;
+}
+
+ModelSceneExporter::Scene ModelSceneExporter::generate(
+        const Model& model, const StatesTrajectory& states) const {
+    // The table contains all state variables, so the states can be
+    // reproduced by each thread's copy of the model.
+    Model copy(model);
+    copy.initSystem();
+    return generate(copy, states.exportToTable(copy));
+}
+
+namespace {
+
+// Writes values in little-endian byte order, regardless of the host.
+class SceneOutput {
+public:
+    explicit SceneOutput(const std::string& filepath)
+            : m_stream(filepath, std::ios::binary) {
+        OPENSIM_THROW_IF(!m_stream, Exception,
+                "Could not open '{}' for writing.", filepath);
+    }
+    template <typename T>
+    void write(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (isBigEndian()) std::reverse(bytes, bytes + sizeof(T));
+        m_stream.write(bytes, sizeof(T));
+    }
+    void writeU32(std::size_t value) { write<std::uint32_t>((std::uint32_t)value); }
+    void writeF32(double value) { write<float>((float)value); }
+    void writeVec3(const SimTK::Vec3& v) {
+        for (int i = 0; i < 3; ++i) writeF32(v[i]);
+    }
+    void writeTransform(const SimTK::Transform& X) {
+        const SimTK::Quaternion q = X.R().convertRotationToQuaternion();
+        for (int i = 0; i < 4; ++i) writeF32(q[i]);
+        writeVec3(X.p());
+    }
+    void writeString(const std::string& str) {
+        writeU32(str.size());
+        m_stream.write(str.data(), str.size());
+    }
+    void writeBytes(const char* bytes, std::size_t n) {
+        m_stream.write(bytes, n);
+    }
+    bool good() const { return m_stream.good(); }
+private:
+    static bool isBigEndian() {
+        const std::uint16_t word = 1;
+        return *reinterpret_cast<const unsigned char*>(&word) == 0;
+    }
+    std::ofstream m_stream;
+};
+
+class DecorationWriter : public SimTK::DecorativeGeometryImplementation {
+public:
+    explicit DecorationWriter(SceneOutput& out) : m_out(out) {}
+    void implementPointGeometry(const SimTK::DecorativePoint& dg) override {
+        writeCommon(0, dg);
+        m_out.writeVec3(dg.getPoint());
+    }
+    void implementLineGeometry(const SimTK::DecorativeLine& dg) override {
+        writeCommon(1, dg);
+        m_out.writeVec3(dg.getPoint1());
+        m_out.writeVec3(dg.getPoint2());
+        m_out.writeF32(dg.getLineThickness());
+    }
+    void implementBrickGeometry(const SimTK::DecorativeBrick& dg) override {
+        writeCommon(2, dg);
+        m_out.writeVec3(dg.getHalfLengths());
+    }
+    void implementCylinderGeometry(
+            const SimTK::DecorativeCylinder& dg) override {
+        writeCommon(3, dg);
+        m_out.writeF32(dg.getRadius());
+        m_out.writeF32(dg.getHalfHeight());
+    }
+    void implementCircleGeometry(const SimTK::DecorativeCircle& dg) override {
+        writeCommon(4, dg);
+        m_out.writeF32(dg.getRadius());
+    }
+    void implementSphereGeometry(const SimTK::DecorativeSphere& dg) override {
+        writeCommon(5, dg);
+        m_out.writeF32(dg.getRadius());
+    }
+    void implementEllipsoidGeometry(
+            const SimTK::DecorativeEllipsoid& dg) override {
+        writeCommon(6, dg);
+        m_out.writeVec3(dg.getRadii());
+    }
+    void implementFrameGeometry(const SimTK::DecorativeFrame& dg) override {
+        writeCommon(7, dg);
+        m_out.writeF32(dg.getAxisLength());
+    }
+    void implementTextGeometry(const SimTK::DecorativeText& dg) override {
+        writeCommon(8, dg);
+        m_out.writeString(dg.getText());
+    }
+    void implementMeshGeometry(const SimTK::DecorativeMesh& dg) override {
+        writeCommon(9, dg);
+        const SimTK::PolygonalMesh& mesh = dg.getMesh();
+        m_out.writeU32(mesh.getNumVertices());
+        for (int v = 0; v < mesh.getNumVertices(); ++v) {
+            m_out.writeVec3(mesh.getVertexPosition(v));
+        }
+        m_out.writeU32(mesh.getNumFaces());
+        for (int f = 0; f < mesh.getNumFaces(); ++f) {
+            const int n = mesh.getNumVerticesForFace(f);
+            m_out.writeU32(n);
+            for (int k = 0; k < n; ++k) m_out.writeU32(mesh.getFaceVertex(f, k));
+        }
+    }
+    void implementMeshFileGeometry(
+            const SimTK::DecorativeMeshFile& dg) override {
+        writeCommon(10, dg);
+        m_out.writeString(dg.getMeshFile());
+    }
+    void implementArrowGeometry(const SimTK::DecorativeArrow& dg) override {
+        writeCommon(11, dg);
+        m_out.writeVec3(dg.getStartPoint());
+        m_out.writeVec3(dg.getEndPoint());
+        m_out.writeF32(dg.getTipLength());
+    }
+    void implementTorusGeometry(const SimTK::DecorativeTorus& dg) override {
+        writeCommon(12, dg);
+        m_out.writeF32(dg.getTorusRadius());
+        m_out.writeF32(dg.getTubeRadius());
+    }
+    void implementConeGeometry(const SimTK::DecorativeCone& dg) override {
+        writeCommon(13, dg);
+        m_out.writeVec3(dg.getOrigin());
+        m_out.writeVec3(dg.getDirection());
+        m_out.writeF32(dg.getHeight());
+        m_out.writeF32(dg.getBaseRadius());
+    }
+private:
+    void writeCommon(std::uint8_t type, const SimTK::DecorativeGeometry& dg) {
+        m_out.write(type);
+        m_out.write<std::int32_t>(dg.getBodyId());
+        m_out.writeTransform(dg.getTransform());
+        m_out.writeVec3(dg.getScaleFactors());
+        m_out.writeVec3(dg.getColor());
+        m_out.writeF32(dg.getOpacity());
+        m_out.write<std::int8_t>((std::int8_t)dg.getRepresentation());
+    }
+    SceneOutput& m_out;
+};
+
+void writeDecorations(SceneOutput& out,
+        const SimTK::Array_<SimTK::DecorativeGeometry>& decorations) {
+    DecorationWriter writer(out);
+    out.writeU32(decorations.size());
+    for (const auto& decoration : decorations) {
+        decoration.implementGeometry(writer);
+    }
+}
+
+} // anonymous namespace
+
+void ModelSceneExporter::write(const Scene& scene, const std::string& filepath) {
+    SceneOutput out(filepath);
+    out.writeBytes("OSIMSCN1", 8);
+    out.writeU32(1);
+    out.write<double>(scene.frameRate);
+    const std::size_t numBodies = scene.frames.empty()
+            ? 0 : scene.frames.front().bodyTransforms.size();
+    out.writeU32(numBodies);
+    writeDecorations(out, scene.fixedDecorations);
+    out.writeU32(scene.frames.size());
+    for (const auto& frame : scene.frames) {
+        OPENSIM_THROW_IF(frame.bodyTransforms.size() != numBodies, Exception,
+                "Expected every frame to have {} body transforms, but the "
+                "frame at time {} has {}.",
+                numBodies, frame.time, frame.bodyTransforms.size());
+        out.write<double>(frame.time);
+        for (const auto& X : frame.bodyTransforms) out.writeTransform(X);
+        writeDecorations(out, frame.decorations);
+    }
+    OPENSIM_THROW_IF(!out.good(), Exception,
+            "An error occurred while writing '{}'.", filepath);
+}
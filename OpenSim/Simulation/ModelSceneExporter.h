@@ -0,0 +1,144 @@
+#ifndef OPENSIM_MODEL_SCENE_EXPORTER_H_
+#define OPENSIM_MODEL_SCENE_EXPORTER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ModelSceneExporter.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <SimTKcommon.h>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+class StatesTrajectory;
+
+/** Generate the decorations (the geometry that the simbody-visualizer would
+draw) of a model for every frame of a motion, without a display, and write
+them to a compact binary scene file. This is meant for rendering many result
+animations on servers: the scene file can be turned into images or a video by
+an offscreen renderer without needing OpenSim.
+
+Unlike VisualizerUtilities::showMotion(), frames are not paced in real time.
+The motion is resampled at the frame rate (setFrameRate()), and the frames are
+divided among threads (setNumThreads()), each of which uses its own copy of
+the model. The decorations are those of Model::generateDecorations() with the
+model's ModelDisplayHints: the fixed decorations (e.g., meshes attached to
+bodies) are recorded once, and the remaining decorations (e.g., muscle paths)
+are recorded for each frame.
+
+@code
+Model model("subject.osim");
+ModelSceneExporter exporter;
+exporter.setFrameRate(60);
+exporter.exportMotion(model, TimeSeriesTable("solution_states.sto"),
+        "solution.osimscene");
+@endcode
+
+<b>Scene file format</b> (version 1). All values are little-endian; `f32` and
+`f64` are IEEE floats, strings are a `u32` length followed by the bytes.
+A transform is 7 `f32`: a quaternion (w, x, y, z) and a position (x, y, z).
+
+- header: the 8 bytes "OSIMSCN1", `u32` version, `f64` frame rate, `u32`
+  number of bodies (mobilized bodies, including ground as body 0), `u32`
+  number of fixed decorations followed by the fixed decorations, `u32`
+  number of frames.
+- each frame: `f64` time, one transform per body (the pose of the body in
+  ground), `u32` number of decorations followed by the decorations.
+- each decoration: `u8` type, `i32` body, transform (of the decoration in the
+  body frame), 3 `f32` scale factors, 3 `f32` color, `f32` opacity, `i8`
+  representation (SimTK::DecorativeGeometry::Representation), then, by type:
+  - 0 point: point (3 `f32`);
+  - 1 line: point 1, point 2 (3 `f32` each), thickness (`f32`);
+  - 2 brick: half lengths (3 `f32`);
+  - 3 cylinder: radius, half height (`f32` each);
+  - 4 circle: radius (`f32`);
+  - 5 sphere: radius (`f32`);
+  - 6 ellipsoid: radii (3 `f32`);
+  - 7 frame: axis length (`f32`);
+  - 8 text: the text (string);
+  - 9 mesh: `u32` number of vertices, the vertices (3 `f32` each), `u32`
+    number of faces, and for each face a `u32` number of vertices followed
+    by the `u32` vertex indices;
+  - 10 mesh file: the absolute path of the file (string);
+  - 11 arrow: start point, end point (3 `f32` each), tip length (`f32`);
+  - 12 torus: torus radius, tube radius (`f32` each);
+  - 13 cone: origin, direction (3 `f32` each), height, base radius (`f32`
+    each).
+
+Unset scale factors, colors and opacities are written as -1, as in
+SimTK::DecorativeGeometry. */
+class OSIMSIMULATION_API ModelSceneExporter {
+public:
+    /** The decorations of one frame. */
+    struct Frame {
+        double time = SimTK::NaN;
+        /// The pose of each mobilized body in ground.
+        std::vector<SimTK::Transform> bodyTransforms;
+        /// The decorations that are not fixed, in their body frames.
+        SimTK::Array_<SimTK::DecorativeGeometry> decorations;
+    };
+    struct Scene {
+        double frameRate = SimTK::NaN;
+        /// The decorations that are fixed to bodies, in their body frames.
+        SimTK::Array_<SimTK::DecorativeGeometry> fixedDecorations;
+        std::vector<Frame> frames;
+    };
+
+    ModelSceneExporter() = default;
+
+    /** The number of frames per second of motion (default: 30). */
+    void setFrameRate(double frameRate) { m_frameRate = frameRate; }
+    double getFrameRate() const { return m_frameRate; }
+    /** The number of threads that generate the frames. The default (0) uses
+    the number of hardware threads. */
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+    int getNumThreads() const { return m_numThreads; }
+
+    /** Generate the scene for a motion. The column labels of the states
+    table are paths to state variables (e.g., /jointset/knee/knee_angle/value,
+    as in a states file); state variables without a column keep their default
+    values. Rotational coordinates are converted to radians if the table
+    metadata has inDegrees=yes. The model is copied; it need not be
+    initialized. */
+    Scene generate(const Model& model, const TimeSeriesTable& states) const;
+    /** The states must be consistent with the model. */
+    Scene generate(const Model& model, const StatesTrajectory& states) const;
+
+    /** Write a scene to a file in the format described above. */
+    static void write(const Scene& scene, const std::string& filepath);
+
+    /** Generate the scene for a motion and write it to a file. */
+    void exportMotion(const Model& model, const TimeSeriesTable& states,
+            const std::string& filepath) const {
+        write(generate(model, states), filepath);
+    }
+
+private:
+    double m_frameRate = 30;
+    int m_numThreads = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MODEL_SCENE_EXPORTER_H_
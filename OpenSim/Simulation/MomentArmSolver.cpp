@@ -132,6 +132,52 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+Matrix MomentArmSolver::solve(const State &state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const
+{
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    const int nc = (int)coordinates.size();
+    const int np = (int)paths.size();
+
+    // compute the coupling between coordinates due to constraints; one column
+    // per coordinate of interest
+    Matrix coupling(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        coupling(j) = computeCouplingVector(s_ma, *coordinates[j]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    const SimbodyMatterSubsystem& matter = 
+        getModel().getMultibodySystem().getMatterSubsystem();
+
+    Matrix momentArms(np, nc);
+    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
+    for (int i = 0; i < np; ++i) {
+        // zero out all the forces
+        _bodyForces *= 0;
+        pathDependentMobilityForces = 0;
+
+        // apply a tension of unity to the bodies of the path
+        paths[i]->addInEquivalentForces(s_ma, 1.0, _bodyForces, 
+            pathDependentMobilityForces);
+
+        // f = ~J(q) * F, as above.
+        matter.multiplyBySystemJacobianTranspose(s_ma, _bodyForces, 
+            _generalizedForces);
+        _generalizedForces += pathDependentMobilityForces;
+
+        // moment-arms about all coordinates of interest.
+        momentArms[i] = ~_generalizedForces*coupling;
+    }
+    return momentArms;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
@@ -83,6 +83,22 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Solve for the effective moment-arms of several GeometryPaths about 
+        several coordinates at once. The coupling of each coordinate to the 
+        others due to constraints is computed once per coordinate and the 
+        generalized forces due to a unit tension along each path are computed
+        once per path, so the cost grows with the number of paths plus the 
+        number of coordinates rather than with their product. 
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @return ma                  resulting moment-arms with one row per path and
+                                one column per coordinate
+    */
+    SimTK::Matrix solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const;
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -93,6 +93,117 @@ bool IMUPlacer::run(bool visualizeResults) {
     TimeSeriesTable_<SimTK::Quaternion> quatTable(
             get_orientation_file_for_calibration());
 
+    // Heading correction requires initSystem is already called. Do it now.
+    SimTK::State& s0 = _model->initSystem();
+    _model->realizePosition(s0);
+    const TimeSeriesTable_<SimTK::Rotation> orientationsData =
+            computeOrientationsInGround(*_model, s0, std::move(quatTable));
+    auto& times = orientationsData.getIndependentColumn();
+
+    std::vector<std::string> imuNames;
+    std::vector<SimTK::Rotation> offsets;
+    computeSensorRotations(*_model, s0, orientationsData, imuNames, offsets);
+    applySensorRotations(*_model, imuNames, offsets);
+
+    _model->finalizeConnections();
+
+    if (!get_output_model_file().empty())
+        _model->print(get_output_model_file());
+
+    _calibrated = true;
+    if (visualizeResults) {
+        _model->setUseVisualizer(true);
+        SimTK::State& s = _model->initSystem();
+
+        s.updTime() = times[0];
+
+        // create the solver given the input data
+        OrientationsReference oRefs(orientationsData);
+        SimTK::Array_<CoordinateReference> coordRefs{};
+
+        const double accuracy = 1e-4;
+        InverseKinematicsSolver ikSolver(*_model, nullptr,
+                std::make_shared<OrientationsReference>(oRefs), coordRefs);
+        ikSolver.setAccuracy(accuracy);
+
+        SimTK::Visualizer& viz = _model->updVisualizer().updSimbodyVisualizer();
+        // We use the input silo to get key presses.
+        auto silo = &_model->updVisualizer().updInputSilo();
+        silo->clear(); // Ignore any previous key presses.
+
+        SimTK::DecorativeText help("Press any key to quit.");
+        help.setIsScreenText(true);
+        viz.addDecoration(SimTK::MobilizedBodyIndex(0), SimTK::Vec3(0), help);
+        _model->getVisualizer().getSimbodyVisualizer().setShowSimTime(true);
+        ikSolver.assemble(s);
+        _model->getVisualizer().show(s);
+
+        unsigned key, modifiers;
+        silo->waitForKeyHit(key, modifiers);
+        viz.shutdown();
+    }
+    return true;
+}
+
+Model& IMUPlacer::getCalibratedModel() const {
+    if (_calibrated) return *_model;
+    OPENSIM_THROW(Exception, "Attempt to retrieve calibrated model without "
+                             "invoking IMU_Placer::run.");
+}
+
+std::vector<TimeSeriesTable_<SimTK::Quaternion>>
+IMUPlacer::computeSensorOffsets(const std::vector<std::string>& calibrationFiles) {
+    if (_model.empty() && get_model_file().size() == 0) {
+        OPENSIM_THROW(Exception, "No model or model_file was specified for IMUPlacer.");
+    }
+    if (_model.empty()) { _model.reset(new Model(get_model_file())); }
+    // The model is initialized once for all sessions.
+    SimTK::State& s0 = _model->initSystem();
+    _model->realizePosition(s0);
+    std::vector<TimeSeriesTable_<SimTK::Quaternion>> offsets;
+    for (const auto& calibrationFile : calibrationFiles) {
+        log_info("Computing sensor offsets from '{}'.", calibrationFile);
+        offsets.push_back(computeSensorOffsets(*_model, s0,
+                TimeSeriesTable_<SimTK::Quaternion>(calibrationFile)));
+    }
+    return offsets;
+}
+
+TimeSeriesTable_<SimTK::Quaternion> IMUPlacer::computeSensorOffsets(
+        Model& model, const SimTK::State& state,
+        TimeSeriesTable_<SimTK::Quaternion> calibrationData) const {
+    const TimeSeriesTable_<SimTK::Rotation> orientationsData =
+            computeOrientationsInGround(
+                    model, state, std::move(calibrationData));
+    std::vector<std::string> imuNames;
+    std::vector<SimTK::Rotation> rotations;
+    computeSensorRotations(model, state, orientationsData, imuNames, rotations);
+
+    SimTK::RowVector_<SimTK::Quaternion> row((int)rotations.size());
+    for (int i = 0; i < row.size(); ++i) {
+        row[i] = rotations[i].convertRotationToQuaternion();
+    }
+    TimeSeriesTable_<SimTK::Quaternion> offsets;
+    offsets.setColumnLabels(imuNames);
+    offsets.appendRow(orientationsData.getIndependentColumn()[0], row);
+    return offsets;
+}
+
+void IMUPlacer::applySensorOffsets(
+        Model& model, const TimeSeriesTable_<SimTK::Quaternion>& offsets) {
+    OPENSIM_THROW_IF(offsets.getNumRows() != 1, Exception,
+            "Expected the table of sensor offsets to have 1 row, but it has "
+            "{}.", offsets.getNumRows());
+    const auto row = offsets.getRowAtIndex(0);
+    std::vector<SimTK::Rotation> rotations;
+    for (int i = 0; i < row.size(); ++i) rotations.emplace_back(row[i]);
+    applySensorRotations(model, offsets.getColumnLabels(), rotations);
+    model.finalizeConnections();
+}
+
+TimeSeriesTable_<SimTK::Rotation> IMUPlacer::computeOrientationsInGround(
+        Model& model, const SimTK::State& s0,
+        TimeSeriesTable_<SimTK::Quaternion> quatTable) const {
     const SimTK::Vec3& sensor_to_opensim_rotations =
             get_sensor_to_opensim_rotations();
     SimTK::Rotation sensorToOpenSim =
@@ -102,9 +213,6 @@ bool IMUPlacer::run(bool visualizeResults) {
                     sensor_to_opensim_rotations[2], SimTK::ZAxis);
     // Rotate data so Y-Axis is up
     OpenSenseUtilities::rotateOrientationTable(quatTable, sensorToOpenSim);
-    // Heading correction requires initSystem is already called. Do it now.
-    SimTK::State& s0 = _model->initSystem();
-    _model->realizePosition(s0);
     // Check consistent heading correction specification
     // both base_heading_axis and base_imu_label should be specified
     // finer error checking is done downstream
@@ -134,7 +242,7 @@ bool IMUPlacer::run(bool visualizeResults) {
         // Compute rotation matrix so that (e.g. "pelvis_imu"+ SimTK::ZAxis)
         // lines up with model forward (+X)
         SimTK::Vec3 headingRotationVec3 =
-                OpenSenseUtilities::computeHeadingCorrection(*_model, s0, quatTable,
+                OpenSenseUtilities::computeHeadingCorrection(model, s0, quatTable,
                         get_base_imu_label(), directionOnIMU);
         SimTK::Rotation headingRotation(
                 SimTK::BodyOrSpaceType::SpaceRotationSequence,
@@ -146,44 +254,46 @@ bool IMUPlacer::run(bool visualizeResults) {
         log_info("No heading correction is applied.");
 
     // This is now plain conversion, no Rotation or magic underneath
-    TimeSeriesTable_<SimTK::Rotation>
-            orientationsData =
-    OpenSenseUtilities::convertQuaternionsToRotations(quatTable);
+    return OpenSenseUtilities::convertQuaternionsToRotations(quatTable);
+}
 
-    auto imuLabels = orientationsData.getColumnLabels();
-    auto& times = orientationsData.getIndependentColumn();
+void IMUPlacer::computeSensorRotations(const Model& model,
+        const SimTK::State& state,
+        const TimeSeriesTable_<SimTK::Rotation>& orientationsData,
+        std::vector<std::string>& imuNames,
+        std::vector<SimTK::Rotation>& rotations) {
+    const auto& imuLabels = orientationsData.getColumnLabels();
 
     // The rotations of the IMUs at the start time in order
     // the labels in the TimerSeriesTable of orientations
-    auto rotations = orientationsData.updRowAtIndex(0);
-
-    s0.updTime() = times[0];
+    const auto row = orientationsData.getRowAtIndex(0);
 
     // default pose of the model defined by marker-based IK
-    _model->realizePosition(s0);
-
-    size_t imuix = 0;
-    std::vector<PhysicalFrame*> bodies{imuLabels.size(), nullptr};
-    std::map<std::string, SimTK::Rotation> imuBodiesInGround;
-
-    // First compute the transform of each of the imu bodies in ground
-    int cnt = 0; // check name match between data and model frames
-    for (auto& imuName : imuLabels) {
+    SimTK::State s0 = state;
+    s0.updTime() = orientationsData.getIndependentColumn()[0];
+    model.realizePosition(s0);
+
+    // Compute the relative offset of each IMU measurement relative to its
+    // body (check name match between data and model frames).
+    imuNames.clear();
+    rotations.clear();
+    for (int imuix = 0; imuix < (int)imuLabels.size(); ++imuix) {
+        const auto& imuName = imuLabels[imuix];
         auto ix = imuName.rfind("_imu");
-        if (ix != std::string::npos) {
-            auto bodyName = imuName.substr(0, ix);
-            auto body = _model->findComponent<PhysicalFrame>(bodyName);
-            if (body) {
-                bodies[imuix] = const_cast<PhysicalFrame*>(body);
-                imuBodiesInGround[imuName] = body->getTransformInGround(s0).R();
-                cnt++;
-            }
-        }
-        ++imuix;
+        if (ix == std::string::npos) continue;
+        auto bodyName = imuName.substr(0, ix);
+        auto body = model.findComponent<PhysicalFrame>(bodyName);
+        if (!body) continue;
+        log_info("Computed offset for {}", imuName);
+        SimTK::Rotation R_FB =
+                ~body->getTransformInGround(s0).R() * row[imuix];
+        log_info("Offset is {}", R_FB);
+        imuNames.push_back(imuName);
+        rotations.push_back(R_FB);
     }
     // we check cnt >= 1 since no frames is rather meaningless I think
     // -Ayman 10/20
-    if (cnt < 1) {
+    if (imuNames.empty()) {
         log_error("IMUPlacer: Calibration data does not "
                   "correspond to any model frames. "
                   "Column names must formatted as (bodyname)_imu");
@@ -191,87 +301,43 @@ bool IMUPlacer::run(bool visualizeResults) {
                         "correspond to any model frames."
                         "Column names must formatted as (bodyname)_imu");
     }
-    // Now cycle through each imu with a body and compute the relative
-    // offset of the IMU measurement relative to the body and
-    // update the modelOffset OR add an offset if none exists
-    imuix = 0;
-    for (auto& imuName : imuLabels) {
-        log_info("Processing {}", imuName);
-        if (imuBodiesInGround.find(imuName) != imuBodiesInGround.end()) {
-            log_info("Computed offset for {}", imuName);
-            SimTK::Rotation R_FB =
-                    ~imuBodiesInGround[imuName] * rotations[int(imuix)];
-            log_info("Offset is {}", R_FB);
-            PhysicalOffsetFrame* imuOffset = nullptr;
-            const PhysicalOffsetFrame* mo = nullptr;
-            if ((mo = _model->findComponent<PhysicalOffsetFrame>(imuName))) {
-                imuOffset = const_cast<PhysicalOffsetFrame*>(mo);
-                auto X = imuOffset->getOffsetTransform();
-                X.updR() = R_FB;
-                imuOffset->setOffsetTransform(X);
-            } else {
-                log_info("Creating offset frame for {}", imuName);
-                OpenSim::Body* body =
-                        dynamic_cast<OpenSim::Body*>(bodies[imuix]);
-                SimTK::Vec3 p_FB(0);
-                if (body) { p_FB = body->getMassCenter(); }
-
-                imuOffset = new PhysicalOffsetFrame(
-                        imuName, *bodies[imuix], SimTK::Transform(R_FB, p_FB));
-                auto* brick = new Brick(Vec3(0.02, 0.01, 0.005));
-                brick->setColor(SimTK::Orange);
-                imuOffset->attachGeometry(brick);
-                bodies[imuix]->addComponent(imuOffset);
-                log_info("Added offset frame for {}.", imuName);
-            }
-            log_info("{} offset computed from {} data from file.",
-                    imuOffset->getName(), imuName);
-        }
-        imuix++;
-    }
-
-    _model->finalizeConnections();
-
-    if (!get_output_model_file().empty())
-        _model->print(get_output_model_file());
-
-    _calibrated = true;
-    if (visualizeResults) {
-        _model->setUseVisualizer(true);
-        SimTK::State& s = _model->initSystem();
-
-        s.updTime() = times[0];
-
-        // create the solver given the input data
-        OrientationsReference oRefs(orientationsData);
-        SimTK::Array_<CoordinateReference> coordRefs{};
-
-        const double accuracy = 1e-4;
-        InverseKinematicsSolver ikSolver(*_model, nullptr,
-                std::make_shared<OrientationsReference>(oRefs), coordRefs);
-        ikSolver.setAccuracy(accuracy);
-
-        SimTK::Visualizer& viz = _model->updVisualizer().updSimbodyVisualizer();
-        // We use the input silo to get key presses.
-        auto silo = &_model->updVisualizer().updInputSilo();
-        silo->clear(); // Ignore any previous key presses.
-
-        SimTK::DecorativeText help("Press any key to quit.");
-        help.setIsScreenText(true);
-        viz.addDecoration(SimTK::MobilizedBodyIndex(0), SimTK::Vec3(0), help);
-        _model->getVisualizer().getSimbodyVisualizer().setShowSimTime(true);
-        ikSolver.assemble(s);
-        _model->getVisualizer().show(s);
-
-        unsigned key, modifiers;
-        silo->waitForKeyHit(key, modifiers);
-        viz.shutdown();
-    }
-    return true;
 }
 
-Model& IMUPlacer::getCalibratedModel() const {
-    if (_calibrated) return *_model;
-    OPENSIM_THROW(Exception, "Attempt to retrieve calibrated model without "
-                             "invoking IMU_Placer::run.");
+void IMUPlacer::applySensorRotations(Model& model,
+        const std::vector<std::string>& imuNames,
+        const std::vector<SimTK::Rotation>& rotations) {
+    // Update the modelOffset OR add an offset if none exists
+    for (int i = 0; i < (int)imuNames.size(); ++i) {
+        const auto& imuName = imuNames[i];
+        const SimTK::Rotation& R_FB = rotations[i];
+        PhysicalOffsetFrame* imuOffset = nullptr;
+        const PhysicalOffsetFrame* mo = nullptr;
+        if ((mo = model.findComponent<PhysicalOffsetFrame>(imuName))) {
+            imuOffset = const_cast<PhysicalOffsetFrame*>(mo);
+            auto X = imuOffset->getOffsetTransform();
+            X.updR() = R_FB;
+            imuOffset->setOffsetTransform(X);
+        } else {
+            log_info("Creating offset frame for {}", imuName);
+            const auto bodyName = imuName.substr(0, imuName.rfind("_imu"));
+            auto* frame = const_cast<PhysicalFrame*>(
+                    model.findComponent<PhysicalFrame>(bodyName));
+            OPENSIM_THROW_IF(!frame, Exception,
+                    "Could not find frame '{}' for IMU '{}' in the model.",
+                    bodyName, imuName);
+            OpenSim::Body* body = dynamic_cast<OpenSim::Body*>(frame);
+            SimTK::Vec3 p_FB(0);
+            if (body) { p_FB = body->getMassCenter(); }
+
+            imuOffset = new PhysicalOffsetFrame(
+                    imuName, *frame, SimTK::Transform(R_FB, p_FB));
+            auto* brick = new Brick(Vec3(0.02, 0.01, 0.005));
+            brick->setColor(SimTK::Orange);
+            imuOffset->attachGeometry(brick);
+            frame->addComponent(imuOffset);
+            log_info("Added offset frame for {}.", imuName);
+        }
+        log_info("{} offset computed from {} data.", imuOffset->getName(),
+                imuName);
+    }
 }
@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Common/Object.h>
+#include <OpenSim/Common/TimeSeriesTable.h>
 #include <OpenSim/Simulation/osimSimulationDLL.h>
 #include <Simbody.h>
 namespace OpenSim {
@@ -92,8 +93,51 @@ public:
     */
     Model& getCalibratedModel() const;
 
+    /** Calibrate many sessions with the same model. The model (from
+    setModel() or model_file) is loaded and initialized once, and the sensor
+    offsets are computed from each of the given orientation files (as with
+    orientation_file_for_calibration) without modifying or writing the model.
+    See computeSensorOffsets(Model&, const SimTK::State&,
+    TimeSeriesTable_<SimTK::Quaternion>) for the contents of each table. */
+    std::vector<TimeSeriesTable_<SimTK::Quaternion>> computeSensorOffsets(
+            const std::vector<std::string>& calibrationFiles);
+    /** Compute the orientation of each IMU relative to the frame it is
+    attached to, given the sensor orientations in `calibrationData`, with
+    the model in the pose of `state` (which must be realized to Position).
+    The rotation and heading correction properties of this IMUPlacer are
+    used, but the model is not modified. The result has one row (at the time
+    of the first row of the calibration data) with a column for each IMU that
+    was matched to a frame (labeled as in the calibration data, e.g.,
+    "pelvis_imu"). The table can be written to an .sto file and applied to a
+    model with applySensorOffsets() or the sensor_offsets_file property of
+    IMUInverseKinematicsTool. */
+    TimeSeriesTable_<SimTK::Quaternion> computeSensorOffsets(Model& model,
+            const SimTK::State& state,
+            TimeSeriesTable_<SimTK::Quaternion> calibrationData) const;
+    /** Place the IMU frames in the model according to a table from
+    computeSensorOffsets(); this has the same effect on the model as run().
+    Existing IMU frames (PhysicalOffsetFrame%s named as the columns) are
+    rotated, and missing ones are added to their bodies. */
+    static void applySensorOffsets(Model& model,
+            const TimeSeriesTable_<SimTK::Quaternion>& offsets);
+
 private:
     void constructProperties();
+    /** Rotate the calibration data into the OpenSim ground frame and apply
+    the heading correction, if requested. */
+    TimeSeriesTable_<SimTK::Rotation> computeOrientationsInGround(
+            Model& model, const SimTK::State& s0,
+            TimeSeriesTable_<SimTK::Quaternion> quatTable) const;
+    /** The rotation of each IMU relative to its frame, using the first row
+    of the orientations. */
+    static void computeSensorRotations(const Model& model,
+            const SimTK::State& state,
+            const TimeSeriesTable_<SimTK::Rotation>& orientationsData,
+            std::vector<std::string>& imuNames,
+            std::vector<SimTK::Rotation>& rotations);
+    static void applySensorRotations(Model& model,
+            const std::vector<std::string>& imuNames,
+            const std::vector<SimTK::Rotation>& rotations);
     /** Pointer to the model being _calibrated. */
     SimTK::ReferencePtr<Model> _model;
     /** Flag indicating if Calibration run has been invoked already */
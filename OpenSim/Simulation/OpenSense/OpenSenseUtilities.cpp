@@ -20,6 +20,7 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/MarkersReference.h>
@@ -42,19 +43,22 @@ TimeSeriesTable_<SimTK::Rotation> OpenSenseUtilities::
 
     size_t nt = int(quaternionsTable.getNumRows());
 
-    std::vector<double> newTimes(nt, SimTK::NaN);
+    std::vector<double> newTimes(times.begin(), times.end());
     SimTK::Matrix_<SimTK::Rotation> matrix(int(nt), nc, Rotation());
 
-    int cnt = 0;
-    for (size_t i = 0; i < nt; ++i) {
-        newTimes[cnt] = times[i];
-        const auto& quatRow = quaternionsTable.getRowAtIndex(i);
-        for (int j = 0; j < nc; ++j) {
-            const Quaternion& quatO = quatRow[j];
-            matrix.updElt(cnt, j) = Rotation(quatO);
+    // Long recordings (many sensors, hours of data) have millions of
+    // quaternions, so blocks of rows are converted on multiple threads.
+    const auto& quatMatrix = quaternionsTable.getMatrix();
+    const int blockSize = 4096;
+    const int numBlocks = (int(nt) + blockSize - 1) / blockSize;
+    parallelFor(numBlocks, [&](int block) {
+        const int end = std::min(int(nt), (block + 1) * blockSize);
+        for (int i = block * blockSize; i < end; ++i) {
+            for (int j = 0; j < nc; ++j) {
+                matrix.updElt(i, j) = Rotation(quatMatrix.getElt(i, j));
+            }
         }
-        cnt++;
-    }
+    });
 
     TimeSeriesTable_<SimTK::Rotation> orientationTable(newTimes,
         matrix,
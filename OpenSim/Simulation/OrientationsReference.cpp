@@ -25,6 +25,7 @@
 #include <OpenSim/Common/Units.h>
 #include <OpenSim/Common/TRCFileAdapter.h>
 #include <SimTKcommon/internal/State.h>
+#include <algorithm>
 
 using namespace std;
 using namespace SimTK;
@@ -159,10 +160,24 @@ void OrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
 
-    // get values for time
-    SimTK::RowVector_<Rotation> row = _orientationData.getRow(time);
+    // get values for time; the row must match the time exactly. Check the
+    // row after the previous one before searching the whole table.
+    const std::vector<double>& times = _orientationData.getIndependentColumn();
+    size_t index = _rowHint;
+    if (!(index < times.size() && times[index] == time)) {
+        ++index;
+        if (!(index < times.size() && times[index] == time)) {
+            const auto it =
+                    std::lower_bound(times.begin(), times.end(), time);
+            // Throws if there is no row at this time.
+            if (it == times.end() || *it != time) _orientationData.getRow(time);
+            index = std::distance(times.begin(), it);
+        }
+    }
+    _rowHint = index;
+    const auto row = _orientationData.getRowAtIndex(index);
 
-    int n = row.size();
+    int n = row.ncol();
     values.resize(n);
 
     for (int i = 0; i < n; ++i) {
@@ -165,6 +165,9 @@ private:
     SimTK::Array_<std::string> _orientationNames;
     // corresponding list of weights guaranteed to be in the same order as names above
     SimTK::Array_<double> _weights;
+    // Row returned by the last call to getValuesAtTime(); the next time is
+    // usually in this row or the following one.
+    mutable size_t _rowHint = 0;
 
 //=============================================================================
 };  // END of class OrientationsReference
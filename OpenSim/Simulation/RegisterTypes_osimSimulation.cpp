@@ -49,6 +49,7 @@
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/BatchedSmoothSphereHalfSpaceForce.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -60,6 +61,7 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/FunctionBasedPath.h"
 #include "Model/PrescribedForce.h"
 #include "Model/ExternalForce.h"
 #include "Model/PointToPointSpring.h"
@@ -88,6 +90,7 @@
 #include "Control/ControlConstant.h"
 #include "Control/ControlLinear.h"
 #include "Control/PrescribedController.h"
+#include "Control/StreamingController.h"
 
 #include "Wrap/PathWrap.h"
 #include "Wrap/PathWrapSet.h"
@@ -148,141 +151,144 @@ OSIMSIMULATION_API void RegisterTypes_osimSimulation()
 {
   try {
 
-    Object::registerType( AnalysisSet() );
-    Object::registerType( Model() );
-    Object::registerType( BodyScale() );
-    Object::registerType( BodyScaleSet());
-    Object::registerType( BodySet());
-    Object::registerType( ComponentSet() );
-    Object::registerType( ControllerSet() );
-    Object::registerType( ConstraintSet() );
-    Object::registerType( CoordinateSet() );
-    Object::registerType( ForceSet() );
-    Object::registerType( ExternalLoads() );
-
-    Object::registerType( JointSet() );
-    Object::registerType( Marker() );
-    Object::registerType( Station() );
-    Object::registerType( MarkerSet() );
-    Object::registerType( PathPoint() );
-    Object::registerType( PathPointSet() );
-    Object::registerType( ConditionalPathPoint() );
-    Object::registerType( MovingPathPoint() );
-    Object::registerType( SurfaceProperties());
-    Object::registerType( Appearance());
-    Object::registerType( ModelVisualPreferences());
-
-    Object::registerType(MarkersReference());
-    Object::registerType(MarkerWeight());
-    Object::registerType(Set<MarkerWeight>());
-
-
-    Object::registerType( Brick());
-    Object::registerType( Sphere());
-    Object::registerType( Cylinder());
-    Object::registerType( Ellipsoid());
-    Object::registerType( Mesh());
-    Object::registerType( Torus());
-    Object::registerType( Cone());
-    Object::registerType( LineGeometry());
-    Object::registerType( FrameGeometry());
-    Object::registerType( Arrow());
-    Object::registerType( GeometryPath());
-
-    Object::registerType( ControlSet() );
-    Object::registerType( ControlConstant() );
-    Object::registerType( ControlLinear() );
-    Object::registerType( ControlLinearNode() );
-
-    Object::registerType( PathWrap() );
-    Object::registerType( PathWrapSet() );
-    Object::registerType( WrapCylinder() );
-    Object::registerType( WrapEllipsoid() );
-    Object::registerType( WrapSphere() );
-    Object::registerType( WrapTorus() );
-    Object::registerType( WrapObjectSet() );
-    Object::registerType( WrapCylinderObst() );
-    Object::registerType( WrapSphereObst() );
-    Object::registerType( WrapDoubleCylinderObst() );
+    Object::registerTypeLazily<AnalysisSet>();
+    Object::registerTypeLazily<Model>();
+    Object::registerTypeLazily<BodyScale>();
+    Object::registerTypeLazily<BodyScaleSet>();
+    Object::registerTypeLazily<BodySet>();
+    Object::registerTypeLazily<ComponentSet>();
+    Object::registerTypeLazily<ControllerSet>();
+    Object::registerTypeLazily<ConstraintSet>();
+    Object::registerTypeLazily<CoordinateSet>();
+    Object::registerTypeLazily<ForceSet>();
+    Object::registerTypeLazily<ExternalLoads>();
+
+    Object::registerTypeLazily<JointSet>();
+    Object::registerTypeLazily<Marker>();
+    Object::registerTypeLazily<Station>();
+    Object::registerTypeLazily<MarkerSet>();
+    Object::registerTypeLazily<PathPoint>();
+    Object::registerTypeLazily<PathPointSet>();
+    Object::registerTypeLazily<ConditionalPathPoint>();
+    Object::registerTypeLazily<MovingPathPoint>();
+    Object::registerTypeLazily<SurfaceProperties>();
+    Object::registerTypeLazily<Appearance>();
+    Object::registerTypeLazily<ModelVisualPreferences>();
+
+    Object::registerTypeLazily<MarkersReference>();
+    Object::registerTypeLazily<MarkerWeight>();
+    Object::registerTypeLazily<Set<MarkerWeight>>();
+
+
+    Object::registerTypeLazily<Brick>();
+    Object::registerTypeLazily<Sphere>();
+    Object::registerTypeLazily<Cylinder>();
+    Object::registerTypeLazily<Ellipsoid>();
+    Object::registerTypeLazily<Mesh>();
+    Object::registerTypeLazily<Torus>();
+    Object::registerTypeLazily<Cone>();
+    Object::registerTypeLazily<LineGeometry>();
+    Object::registerTypeLazily<FrameGeometry>();
+    Object::registerTypeLazily<Arrow>();
+    Object::registerTypeLazily<GeometryPath>();
+    Object::registerTypeLazily<FunctionBasedPath>();
+
+    Object::registerTypeLazily<ControlSet>();
+    Object::registerTypeLazily<ControlConstant>();
+    Object::registerTypeLazily<ControlLinear>();
+    Object::registerTypeLazily<ControlLinearNode>();
+
+    Object::registerTypeLazily<PathWrap>();
+    Object::registerTypeLazily<PathWrapSet>();
+    Object::registerTypeLazily<WrapCylinder>();
+    Object::registerTypeLazily<WrapEllipsoid>();
+    Object::registerTypeLazily<WrapSphere>();
+    Object::registerTypeLazily<WrapTorus>();
+    Object::registerTypeLazily<WrapObjectSet>();
+    Object::registerTypeLazily<WrapCylinderObst>();
+    Object::registerTypeLazily<WrapSphereObst>();
+    Object::registerTypeLazily<WrapDoubleCylinderObst>();
 
     // CURRENT RELEASE
-    Object::registerType( SimbodyEngine() );
-    Object::registerType( OpenSim::Body() );
-    Object::registerType( OpenSim::Ground());
-    Object::registerType( PhysicalOffsetFrame());
-
-    Object::registerType( WeldJoint());
-    Object::registerType( CustomJoint());
-    Object::registerType( EllipsoidJoint() );
-    Object::registerType( FreeJoint() );
-    Object::registerType( BallJoint() );
-    Object::registerType( GimbalJoint() );
-    Object::registerType( ScapulothoracicJoint() );
-    Object::registerType( UniversalJoint() );
-    Object::registerType( PinJoint() );
-    Object::registerType( SliderJoint() );
-    Object::registerType( PlanarJoint() );
-    Object::registerType( TransformAxis() );
-    Object::registerType( Coordinate() );
-    Object::registerType( SpatialTransform() );
-
-    Object::registerType(WeldConstraint());
-    Object::registerType(PointConstraint());
-    Object::registerType(ConstantDistanceConstraint());
-    Object::registerType(CoordinateCouplerConstraint());
-    Object::registerType(PointOnLineConstraint());
-    Object::registerType(RollingOnSurfaceConstraint());
-
-    Object::registerType( ContactGeometrySet() );
-    Object::registerType( ContactHalfSpace() );
-    Object::registerType( ContactMesh() );
-    Object::registerType( ContactSphere() );
-    Object::registerType( CoordinateLimitForce() );
-    Object::registerType( SmoothSphereHalfSpaceForce() );
-    Object::registerType( HuntCrossleyForce() );
-    Object::registerType( ElasticFoundationForce() );
-    Object::registerType( HuntCrossleyForce::ContactParameters() );
-    Object::registerType( HuntCrossleyForce::ContactParametersSet() );
-    Object::registerType( ElasticFoundationForce::ContactParameters() );
-    Object::registerType( ElasticFoundationForce::ContactParametersSet() );
-
-    Object::registerType( Ligament() );
-    Object::registerType( Blankevoort1991Ligament() );
-    Object::registerType( PrescribedForce() );
-    Object::registerType( ExternalForce() );
-    Object::registerType( PointToPointSpring() );
-    Object::registerType( ExpressionBasedPointToPointForce() );
-    Object::registerType( PathSpring() );
-    Object::registerType( BushingForce() );
-    Object::registerType( FunctionBasedBushingForce() );
-    Object::registerType( ExpressionBasedBushingForce() );
-    Object::registerType( ExpressionBasedCoordinateForce() );
-
-    Object::registerType( ControlSetController() );
-    Object::registerType( PrescribedController() );
-
-    Object::registerType( PathActuator() );
-    Object::registerType( ProbeSet() );
-    Object::registerType( JointInternalPowerProbe() );
-    Object::registerType( SystemEnergyProbe() );
-    Object::registerType( ActuatorForceProbe() );
-    Object::registerType( ActuatorPowerProbe() );
-    Object::registerType( Umberger2010MuscleMetabolicsProbe() );
-    Object::registerType( Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet() );
-    Object::registerType( Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter() );
-    Object::registerType( Bhargava2004MuscleMetabolicsProbe() );
-    Object::registerType( Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet() );
-    Object::registerType( Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter() );
-    Object::registerType( OrientationWeight() );
-
-    Object::registerType( IMUPlacer() );
+    Object::registerTypeLazily<SimbodyEngine>();
+    Object::registerTypeLazily<OpenSim::Body>();
+    Object::registerTypeLazily<OpenSim::Ground>();
+    Object::registerTypeLazily<PhysicalOffsetFrame>();
+
+    Object::registerTypeLazily<WeldJoint>();
+    Object::registerTypeLazily<CustomJoint>();
+    Object::registerTypeLazily<EllipsoidJoint>();
+    Object::registerTypeLazily<FreeJoint>();
+    Object::registerTypeLazily<BallJoint>();
+    Object::registerTypeLazily<GimbalJoint>();
+    Object::registerTypeLazily<ScapulothoracicJoint>();
+    Object::registerTypeLazily<UniversalJoint>();
+    Object::registerTypeLazily<PinJoint>();
+    Object::registerTypeLazily<SliderJoint>();
+    Object::registerTypeLazily<PlanarJoint>();
+    Object::registerTypeLazily<TransformAxis>();
+    Object::registerTypeLazily<Coordinate>();
+    Object::registerTypeLazily<SpatialTransform>();
+
+    Object::registerTypeLazily<WeldConstraint>();
+    Object::registerTypeLazily<PointConstraint>();
+    Object::registerTypeLazily<ConstantDistanceConstraint>();
+    Object::registerTypeLazily<CoordinateCouplerConstraint>();
+    Object::registerTypeLazily<PointOnLineConstraint>();
+    Object::registerTypeLazily<RollingOnSurfaceConstraint>();
+
+    Object::registerTypeLazily<ContactGeometrySet>();
+    Object::registerTypeLazily<ContactHalfSpace>();
+    Object::registerTypeLazily<ContactMesh>();
+    Object::registerTypeLazily<ContactSphere>();
+    Object::registerTypeLazily<CoordinateLimitForce>();
+    Object::registerTypeLazily<SmoothSphereHalfSpaceForce>();
+    Object::registerTypeLazily<BatchedSmoothSphereHalfSpaceForce>();
+    Object::registerTypeLazily<HuntCrossleyForce>();
+    Object::registerTypeLazily<ElasticFoundationForce>();
+    Object::registerTypeLazily<HuntCrossleyForce::ContactParameters>();
+    Object::registerTypeLazily<HuntCrossleyForce::ContactParametersSet>();
+    Object::registerTypeLazily<ElasticFoundationForce::ContactParameters>();
+    Object::registerTypeLazily<ElasticFoundationForce::ContactParametersSet>();
+
+    Object::registerTypeLazily<Ligament>();
+    Object::registerTypeLazily<Blankevoort1991Ligament>();
+    Object::registerTypeLazily<PrescribedForce>();
+    Object::registerTypeLazily<ExternalForce>();
+    Object::registerTypeLazily<PointToPointSpring>();
+    Object::registerTypeLazily<ExpressionBasedPointToPointForce>();
+    Object::registerTypeLazily<PathSpring>();
+    Object::registerTypeLazily<BushingForce>();
+    Object::registerTypeLazily<FunctionBasedBushingForce>();
+    Object::registerTypeLazily<ExpressionBasedBushingForce>();
+    Object::registerTypeLazily<ExpressionBasedCoordinateForce>();
+
+    Object::registerTypeLazily<ControlSetController>();
+    Object::registerTypeLazily<PrescribedController>();
+    Object::registerTypeLazily<StreamingController>();
+
+    Object::registerTypeLazily<PathActuator>();
+    Object::registerTypeLazily<ProbeSet>();
+    Object::registerTypeLazily<JointInternalPowerProbe>();
+    Object::registerTypeLazily<SystemEnergyProbe>();
+    Object::registerTypeLazily<ActuatorForceProbe>();
+    Object::registerTypeLazily<ActuatorPowerProbe>();
+    Object::registerTypeLazily<Umberger2010MuscleMetabolicsProbe>();
+    Object::registerTypeLazily<Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameterSet>();
+    Object::registerTypeLazily<Umberger2010MuscleMetabolicsProbe_MetabolicMuscleParameter>();
+    Object::registerTypeLazily<Bhargava2004MuscleMetabolicsProbe>();
+    Object::registerTypeLazily<Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameterSet>();
+    Object::registerTypeLazily<Bhargava2004MuscleMetabolicsProbe_MetabolicMuscleParameter>();
+    Object::registerTypeLazily<OrientationWeight>();
+
+    Object::registerTypeLazily<IMUPlacer>();
     
-    Object::registerType( StatesTrajectoryReporter() );
+    Object::registerTypeLazily<StatesTrajectoryReporter>();
 
-    Object::registerType( TableProcessor() );
+    Object::registerTypeLazily<TableProcessor>();
 
-    Object::registerType( TabOpLowPassFilter() );
-    Object::registerType( TabOpUseAbsoluteStateNames() );
+    Object::registerTypeLazily<TabOpLowPassFilter>();
+    Object::registerTypeLazily<TabOpUseAbsoluteStateNames>();
 
     // OLD Versions
     // Associate an instance with old name to help deserialization.
@@ -95,6 +95,17 @@ public:
      * conjunction with getRecordLabels() and must return an Array of equal
      * size. */
     virtual Array<double> getRecordValues(const SimTK::State& state) const;
+    /**
+     * Same as getRecordValues(), but the values are written into `values`,
+     * which must have room for getRecordLabels().getSize() values. Returns
+     * the number of values written. */
+    virtual int writeRecordValues(const SimTK::State& state,
+            double* values) const {
+        const Array<double> recordValues = getRecordValues(state);
+        for (int i = 0; i < recordValues.getSize(); ++i)
+            values[i] = recordValues[i];
+        return recordValues.getSize();
+    }
 
     /**
     * This method specifies the interface that a constraint must implement
@@ -30,24 +30,28 @@
 
 // Helper class to construct functions when user's specify a dependency as qd = f(qi)
 // this function casts as C(q) = 0 = f(qi) - qd;
+// The derivatives of C are those of f, which Simbody uses for the constraint
+// Jacobian (e.g., when assembling), so they are exact if f's are.
 
 // Excluding this from Doxygen until it has better documentation! -Sam Hamner
     /// @cond
 class CompoundFunction : public SimTK::Function {
-// returns f1(x[0]) - x[1];
+// returns scale * f1(x[0], ..., x[n-1]) - x[n], where n is the number of
+// independent coordinates.
 private:
     std::unique_ptr<const SimTK::Function> f1;
     const double scale;
+    const int numIndependent;
 
 public:
     
-    CompoundFunction(const SimTK::Function *cf, double scale) : f1(cf), scale(scale) {
+    CompoundFunction(const SimTK::Function *cf, double scale,
+            int numIndependent) : f1(cf), scale(scale),
+            numIndependent(numIndependent) {
     }
 
     double calcValue(const SimTK::Vector& x) const override {
-        SimTK::Vector xf(1);
-        xf[0] = x[0];
-        return scale*f1->calcValue(xf)-x[1];
+        return scale*f1->calcValue(updArgument(x)) - x[numIndependent];
     }
 
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const {
@@ -55,27 +59,18 @@ public:
     }
 
     double calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const override {
-        if (derivComponents.size() == 1){
-            if (derivComponents[0]==0){
-                SimTK::Vector x1(1);
-                x1[0] = x[0];
-                return scale*f1->calcDerivative(derivComponents, x1);
+        // C is linear in the dependent coordinate, and the dependent
+        // coordinate does not appear in f1.
+        for (const int component : derivComponents) {
+            if (component == numIndependent) {
+                return derivComponents.size() == 1 ? -1 : 0;
             }
-            else if (derivComponents[0]==1)
-                return -1;
         }
-        else if(derivComponents.size() == 2){
-            if (derivComponents[0]==0 && derivComponents[1] == 0){
-                SimTK::Vector x1(1);
-                x1[0] = x[0];
-                return scale*f1->calcDerivative(derivComponents, x1);
-            }
-        }
-        return 0;
+        return scale*f1->calcDerivative(derivComponents, updArgument(x));
     }
 
     int getArgumentSize() const override {
-        return 2;
+        return numIndependent + 1;
     }
     int getMaxDerivativeOrder() const override {
         return 2;
@@ -84,6 +79,16 @@ public:
     void setFunction(const SimTK::Function *cf) {
         f1.reset(cf);
     }
+
+private:
+    // The argument of f1 (the independent coordinates); reused so that
+    // evaluating the constraint does not allocate.
+    const SimTK::Vector& updArgument(const SimTK::Vector& x) const {
+        static thread_local SimTK::Vector argument;
+        argument.resize(numIndependent);
+        for (int i = 0; i < numIndependent; ++i) argument[i] = x[i];
+        return argument;
+    }
 };
 
 
@@ -224,7 +229,16 @@ void CoordinateCouplerConstraint::extendAddToSystem(SimTK::MultibodySystem& syst
 
     // Create and set the underlying coupler constraint function;
     const Function& f = get_coupled_coordinates_function();
-    SimTK::Function *simtkCouplerFunction = new CompoundFunction(f.createSimTKFunction(), get_scale_factor());
+    // Some functions (e.g., Constant) take fewer arguments than they are
+    // given.
+    OPENSIM_THROW_IF_FRMOBJ(
+            f.getArgumentSize() > independentCoordNames.getSize(), Exception,
+            "The coupled coordinates function takes {} arguments, but there "
+            "are only {} independent coordinates.",
+            f.getArgumentSize(), independentCoordNames.getSize());
+    SimTK::Function *simtkCouplerFunction = new CompoundFunction(
+            f.createSimTKFunction(), get_scale_factor(),
+            independentCoordNames.getSize());
 
 
     // Now create a Simbody Constraint::CoordinateCoupler
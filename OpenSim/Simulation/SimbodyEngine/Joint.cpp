@@ -383,6 +383,40 @@ SimTK::SpatialVec Joint::calcEquivalentSpatialForce(const SimTK::State &s,
     multiplied by the mobilities (internal coordinate velocities). Only constraints
     internal to the joint are accounted for, not external constraints that affect
     joint motion. */
+SimTK::SpatialVec Joint::calcReactionOnParentExpressedInGround(
+        const SimTK::State& s,
+        const SimTK::Vector_<SimTK::SpatialVec>& mobilizerReactions) const
+{
+    const SimTK::MobilizedBody& mobod = getChildFrame().getMobilizedBody();
+    const SimTK::SpatialVec reactionOnChild =
+            calcReactionOnChildExpressedInGround(s, mobilizerReactions);
+
+    // Shift the reaction from the origin of M to the origin of F, and apply
+    // the equal and opposite reaction to the parent.
+    const SimTK::Vec3 p_GM =
+            mobod.getBodyTransform(s) * mobod.getOutboardFrame(s).p();
+    const SimTK::Vec3 p_GF =
+            mobod.getParentMobilizedBody().getBodyTransform(s) *
+            mobod.getInboardFrame(s).p();
+    const SimTK::Vec3 momentAboutF =
+            reactionOnChild[0] + (p_GM - p_GF) % reactionOnChild[1];
+    return SimTK::SpatialVec(-momentAboutF, -reactionOnChild[1]);
+}
+
+SimTK::SpatialVec Joint::calcReactionOnChildExpressedInGround(
+        const SimTK::State& s,
+        const SimTK::Vector_<SimTK::SpatialVec>& mobilizerReactions) const
+{
+    const SimTK::MobilizedBodyIndex mbx =
+            getChildFrame().getMobilizedBodyIndex();
+    OPENSIM_THROW_IF_FRMOBJ(mbx >= mobilizerReactions.size(), Exception,
+            "Expected reactions for {} mobilizers, but got {}. Use "
+            "Model::calcMobilizerReactionForces() to compute them.",
+            getModel().getMatterSubsystem().getNumBodies(),
+            mobilizerReactions.size());
+    return mobilizerReactions[mbx];
+}
+
 double Joint::calcPower(const SimTK::State &s) const
 {
     double power = 0;
@@ -274,6 +274,28 @@ public:
             .findMobilizerReactionOnBodyAtMInGround(state);
     }
 
+    /** Same as calcReactionOnParentExpressedInGround(), but extracted from
+        the reactions of all mobilizers computed with
+        Model::calcMobilizerReactionForces(). Use this when computing the
+        reactions of many joints at the same state.
+    @param[in]  state containing the generalized coordinate and speed values
+    @param[in]  mobilizerReactions the reactions of all mobilizers at state
+    @return     SpatialVec of reaction force, RP_G, acting on parent frame, P,
+                and expressed in ground, G.  */
+    SimTK::SpatialVec calcReactionOnParentExpressedInGround(
+            const SimTK::State& state,
+            const SimTK::Vector_<SimTK::SpatialVec>& mobilizerReactions) const;
+    /** Same as calcReactionOnChildExpressedInGround(), but extracted from the
+        reactions of all mobilizers computed with
+        Model::calcMobilizerReactionForces().
+    @param[in]  state containing the generalized coordinate and speed values
+    @param[in]  mobilizerReactions the reactions of all mobilizers at state
+    @return     SpatialVec of reaction force, RP_G, acting on child frame, C,
+                and expressed in ground, G.  */
+    SimTK::SpatialVec calcReactionOnChildExpressedInGround(
+            const SimTK::State& state,
+            const SimTK::Vector_<SimTK::SpatialVec>& mobilizerReactions) const;
+
     /** Joints in general do not contribute power since the reaction space
         forces are orthogonal to the mobility space. However, when joint motion 
         is prescribed, the internal forces that move the joint will do work. In 
@@ -24,6 +24,8 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <unordered_map>
+
 #include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/Storage.h>
@@ -899,6 +901,47 @@ formCompleteStorages( const SimTK::State& s, const OpenSim::Storage &aQIn,
 //=============================================================================
 // UTILITY
 //=============================================================================
+namespace {
+// For each column label, whether the column holds a rotational coordinate
+// or speed of the model. A label may be a coordinate name, a path ending in
+// the coordinate name (e.g., /jointset/hip/hip_flexion), or a path to a
+// coordinate's state variable (e.g., /jointset/hip/hip_flexion/speed).
+// The coordinates are looked up by name once, not once per label.
+std::vector<bool> findRotationalDofColumns(const CoordinateSet& coordinateSet,
+        const std::vector<std::string>& labels) {
+    std::unordered_map<std::string, bool> isRotational;
+    for (int i = 0; i < coordinateSet.getSize(); ++i) {
+        const Coordinate& coord = coordinateSet.get(i);
+        isRotational[coord.getName()] =
+                coord.getMotionType() == Coordinate::Rotational;
+    }
+    const auto find = [&isRotational](const std::string& name) -> int {
+        const auto it = isRotational.find(name);
+        if (it == isRotational.end()) return -1;
+        return it->second ? 1 : 0;
+    };
+
+    std::vector<bool> rotational(labels.size(), false);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        const std::string& name = labels[i];
+        int found = find(name);
+        if (found < 0) {
+            std::string::size_type back = name.rfind("/");
+            const std::string prefix = name.substr(0, back);
+            found = find(name.substr(back+1, name.length()-back));
+            // This is a necessary hack to use new component naming,
+            // but SimbodyEngine will be deprecated and so will this code- aseth
+            if (found < 0) { // could be a speed then trim off _u
+                back = prefix.rfind("/");
+                found = find(prefix.substr(back+1, prefix.length()-back));
+            }
+        }
+        rotational[i] = found == 1;
+    }
+    return rotational;
+}
+}
+
 //_____________________________________________________________________________
 /**
  */
@@ -910,39 +953,19 @@ void SimbodyEngine::scaleRotationalDofColumns(Storage &rStorage, double factor)
         throw Exception("SimbodyEngine.scaleRotationalDofColumns: ERROR- storage has no labels, can't determine coordinate types for deg<->rad conversion",
                              __FILE__,__LINE__);
 
-    // Loop through the coordinates in the model. For each one that is rotational,
-    // see if it has a corresponding column of data. If it does, multiply that
-    // column by the given scaling factor.
-    std::string shortName = "";
-    std::string prefix = "";
-    int index = -1;
-    const CoordinateSet& coordinateSet = _model->getCoordinateSet();
-    
+    // Find the columns of rotational coordinates once, then scale all of
+    // them in a single pass over the rows.
     // first column is time, so skip
-    for (int i = 1; i < ncols; i++) {
-        const std::string& name = columnLabels[i];
-        index = coordinateSet.getIndex(name);
-        if (index < 0){
-            std::string::size_type back = name.rfind("/");
-            prefix = name.substr(0, back);
-            shortName = name.substr(back+1, name.length()-back);
-            index = coordinateSet.getIndex(shortName);
-            // This is a necessary hack to use new component naming,
-            // but SimbodyEngine will be deprecated and so will this code- aseth
-            if (index < 0){ // could be a speed then trim off _u
-                back = prefix.rfind("/");
-                shortName = prefix.substr(back+1, prefix.length()-back);
-                index = coordinateSet.getIndex(shortName);
-            }
-        }
-        if (index >= 0){
-            const Coordinate& coord = coordinateSet.get(index);
-            if (coord.getMotionType() == Coordinate::Rotational) {
-                // assumes first data column is 0 whereas labels has time as 0
-                rStorage.multiplyColumn(i-1, factor);
-            }
-        }
+    std::vector<std::string> labels;
+    for (int i = 1; i < ncols; i++) labels.push_back(columnLabels[i]);
+    const std::vector<bool> rotational =
+            findRotationalDofColumns(_model->getCoordinateSet(), labels);
+    std::vector<int> indices;
+    for (int i = 0; i < (int)rotational.size(); i++) {
+        // data column i corresponds to label i+1, since label 0 is time
+        if (rotational[i]) indices.push_back(i);
     }
+    rStorage.multiplyColumns(indices, factor);
 }
 
 void SimbodyEngine::scaleRotationalDofColumns(TimeSeriesTable& table,
@@ -952,38 +975,12 @@ void SimbodyEngine::scaleRotationalDofColumns(TimeSeriesTable& table,
         throw Exception("SimbodyEngine.scaleRotationalDofColumns: ERROR- storage has no labels, can't determine coordinate types for deg<->rad conversion",
                              __FILE__,__LINE__);
 
-    // Loop through the coordinates in the model. For each one that is rotational,
-    // see if it has a corresponding column of data. If it does, multiply that
-    // column by the given scaling factor.
-    std::string shortName = "";
-    std::string prefix = "";
-    int index = -1;
-    const CoordinateSet& coordinateSet = _model->getCoordinateSet();
-    
-    // first column is time, so skip
+    // The columns of the table's matrix are contiguous, so each rotational
+    // column is scaled in one sweep.
+    const std::vector<bool> rotational = findRotationalDofColumns(
+            _model->getCoordinateSet(), table.getColumnLabels());
     for (size_t i = 0; i < ncols; i++) {
-        const std::string& name = table.getColumnLabel(i);
-        index = coordinateSet.getIndex(name);
-        if (index < 0){
-            std::string::size_type back = name.rfind("/");
-            prefix = name.substr(0, back);
-            shortName = name.substr(back+1, name.length()-back);
-            index = coordinateSet.getIndex(shortName);
-            // This is a necessary hack to use new component naming,
-            // but SimbodyEngine will be deprecated and so will this code- aseth
-            if (index < 0){ // could be a speed then trim off _u
-                back = prefix.rfind("/");
-                shortName = prefix.substr(back+1, prefix.length()-back);
-                index = coordinateSet.getIndex(shortName);
-            }
-        }
-        if (index >= 0){
-            const Coordinate& coord = coordinateSet.get(index);
-            if (coord.getMotionType() == Coordinate::Rotational) {
-                // assumes first data column is 0 whereas labels has time as 0
-                table.updDependentColumnAtIndex(i) *= factor;
-            }
-        }
+        if (rotational[i]) table.updDependentColumnAtIndex(i) *= factor;
     }
 }
 //_____________________________________________________________________________
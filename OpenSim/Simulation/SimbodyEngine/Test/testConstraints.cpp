@@ -55,6 +55,7 @@
 #include <OpenSim/Simulation/SimbodyEngine/PlanarJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/CustomJoint.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SpatialTransform.h>
 
 #include <OpenSim/Simulation/SimbodyEngine/PointConstraint.h>
@@ -136,6 +137,7 @@ void testCoordinateLocking();
 void testWeldConstraint();
 void testPointOnLineConstraint();
 void testCoordinateCouplerConstraint();
+void testCoordinateCouplerMultipleIndependentCoordinates();
 void testPointConstraint();
 void testConstantDistanceConstraint();
 void testSerializeDeserialize();
@@ -151,6 +153,7 @@ int main()
         testPointOnLineConstraint();
         // Compare behavior of CoordinateCouplerConstraint as a custom knee
         testCoordinateCouplerConstraint();
+        testCoordinateCouplerMultipleIndependentCoordinates();
         // test OpenSim roll constraint against a composite of Simbody constraints
         testRollingOnSurfaceConstraint();
         testSerializeDeserialize();
@@ -936,6 +939,68 @@ void testCoordinateCouplerConstraint()
     forceReport->printResults("CouplerModelForces");
 }
 
+void testCoordinateCouplerMultipleIndependentCoordinates()
+{
+    using namespace SimTK;
+
+    cout << endl;
+    cout << "=================================================================" << endl;
+    cout << " OpenSim CoordinateCouplerConstraint with 2 independent coordinates" << endl;
+    cout << "=================================================================" << endl;
+
+    // Three sliders in series; q3 = 0.1 + 0.5 q1 - 0.2 q2.
+    Model model;
+    const PhysicalFrame* parent = &model.getGround();
+    for (int i = 1; i <= 3; ++i) {
+        const std::string name = std::to_string(i);
+        auto* body = new OpenSim::Body("b" + name, 1, Vec3(0), Inertia(1));
+        auto* joint = new SliderJoint("slider" + name, *parent, *body);
+        joint->updCoordinate().setName("q" + name);
+        model.addBody(body);
+        model.addJoint(joint);
+        parent = body;
+    }
+    // Coefficients of 1, q2, and q1.
+    MultivariatePolynomialFunction f(Vector(Vec3(0.1, -0.2, 0.5)), 2, 1);
+    auto* coupler = new CoordinateCouplerConstraint();
+    coupler->setName("coupler");
+    coupler->setIndependentCoordinateNames(
+            OpenSim::Array<std::string>("", 2, 2));
+    coupler->set_independent_coordinate_names(0, "q1");
+    coupler->set_independent_coordinate_names(1, "q2");
+    coupler->setDependentCoordinateName("q3");
+    coupler->setFunction(f);
+    model.addConstraint(coupler);
+
+    State& s = model.initSystem();
+    const auto& q1 = model.getCoordinateSet().get("q1");
+    const auto& q2 = model.getCoordinateSet().get("q2");
+    const auto& q3 = model.getCoordinateSet().get("q3");
+    q1.setValue(s, 0.3, false);
+    q2.setValue(s, -0.4, false);
+    q3.setValue(s, 0.0, false);
+    model.assemble(s);
+    ASSERT_EQUAL(0.1 + 0.5 * q1.getValue(s) - 0.2 * q2.getValue(s),
+            q3.getValue(s), 1e-8, __FILE__, __LINE__,
+            "Coupled coordinate does not satisfy the constraint.");
+
+    // The velocity constraint uses the partial derivatives of the function.
+    q1.setSpeedValue(s, 1.0);
+    q2.setSpeedValue(s, 2.0);
+    q3.setSpeedValue(s, 0.0);
+    model.getMultibodySystem().projectU(s, 1e-10);
+    ASSERT_EQUAL(0.5 * q1.getSpeedValue(s) - 0.2 * q2.getSpeedValue(s),
+            q3.getSpeedValue(s), 1e-8, __FILE__, __LINE__,
+            "Coupled speed does not satisfy the constraint.");
+
+    // The function must not take more arguments than there are independent
+    // coordinates.
+    model.updComponent<CoordinateCouplerConstraint>("/constraintset/coupler")
+            .setFunction(MultivariatePolynomialFunction(
+                    Vector(4, 0.0), 3, 1));
+    ASSERT_THROW(OpenSim::Exception, model.initSystem());
+}
+
 void testRollingOnSurfaceConstraint()
 {
     using namespace SimTK;
@@ -25,11 +25,17 @@
 
 #include "Manager/Manager.h"
 #include "Model/Model.h"
+#include "Model/Probe.h"
+#include "Model/Bhargava2004MuscleMetabolicsProbe.h"
+#include "Model/Umberger2010MuscleMetabolicsProbe.h"
 
 #include <simbody/internal/Visualizer_InputListener.h>
 
 #include <OpenSim/Common/TableUtilities.h>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace OpenSim;
 
 SimTK::State OpenSim::simulate(Model& model,
@@ -244,25 +250,20 @@ std::vector<std::string> OpenSim::createStateVariableNamesInSystemOrder(
         const Model& model, std::unordered_map<int, int>& yIndexMap) {
     yIndexMap.clear();
     std::vector<std::string> svNamesInSysOrder;
-    auto s = model.getWorkingState();
     const auto svNames = model.getStateVariableNames();
-    s.updY() = 0;
+    std::vector<std::string> names(svNames.size());
+    for (int isv = 0; isv < svNames.size(); ++isv) names[isv] = svNames[isv];
+    const auto indices = model.getStateVariableSystemIndices(names);
+    // Sort the state variables by their index in Y (unused slots for
+    // quaternions have no state variable).
+    std::vector<int> order(names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+            [&](int a, int b) { return indices[a] < indices[b]; });
     std::vector<int> yIndices;
-    for (int iy = 0; iy < s.getNY(); ++iy) {
-        s.updY()[iy] = SimTK::NaN;
-        const auto svValues = model.getStateVariableValues(s);
-        for (int isv = 0; isv < svNames.size(); ++isv) {
-            if (SimTK::isNaN(svValues[isv])) {
-                svNamesInSysOrder.push_back(svNames[isv]);
-                yIndices.emplace_back(iy);
-                s.updY()[iy] = 0;
-                break;
-            }
-        }
-        if (SimTK::isNaN(s.updY()[iy])) {
-            // If we reach here, this is an unused slot for a quaternion.
-            s.updY()[iy] = 0;
-        }
+    for (const auto& isv : order) {
+        svNamesInSysOrder.push_back(names[isv]);
+        yIndices.push_back(indices[isv]);
     }
     int count = 0;
     for (const auto& iy : yIndices) {
@@ -278,23 +279,12 @@ std::vector<std::string> OpenSim::createStateVariableNamesInSystemOrder(
 std::unordered_map<std::string, int> OpenSim::createSystemYIndexMap(
         const Model& model) {
     std::unordered_map<std::string, int> sysYIndices;
-    auto s = model.getWorkingState();
     const auto svNames = model.getStateVariableNames();
-    s.updY() = 0;
-    for (int iy = 0; iy < s.getNY(); ++iy) {
-        s.updY()[iy] = SimTK::NaN;
-        const auto svValues = model.getStateVariableValues(s);
-        for (int isv = 0; isv < svNames.size(); ++isv) {
-            if (SimTK::isNaN(svValues[isv])) {
-                sysYIndices[svNames[isv]] = iy;
-                s.updY()[iy] = 0;
-                break;
-            }
-        }
-        if (SimTK::isNaN(s.updY()[iy])) {
-            // If we reach here, this is an unused slot for a quaternion.
-            s.updY()[iy] = 0;
-        }
+    std::vector<std::string> names(svNames.size());
+    for (int isv = 0; isv < svNames.size(); ++isv) names[isv] = svNames[isv];
+    const auto indices = model.getStateVariableSystemIndices(names);
+    for (int isv = 0; isv < svNames.size(); ++isv) {
+        sysYIndices[svNames[isv]] = indices[isv];
     }
     SimTK_ASSERT2_ALWAYS(svNames.size() == (int)sysYIndices.size(),
             "Expected to find %i state indices but found %i.", svNames.size(),
@@ -391,3 +381,139 @@ void OpenSim::checkLabelsMatchModelStates(const Model& model,
                 label);
     }
 }
+
+std::map<std::string, TimeSeriesTable> OpenSim::analyzeProbes(Model model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable, int numThreads) {
+
+    // Evaluate the probes directly instead of integrating them, and report
+    // the metabolic rate of each muscle.
+    model.finalizeFromProperties();
+    for (auto& probe : model.updComponentList<Probe>()) {
+        probe.setOperation("value");
+        if (auto* umberger =
+                        dynamic_cast<Umberger2010MuscleMetabolicsProbe*>(
+                                &probe)) {
+            umberger->set_report_total_metabolics_only(false);
+        } else if (auto* bhargava =
+                           dynamic_cast<Bhargava2004MuscleMetabolicsProbe*>(
+                                   &probe)) {
+            bhargava->set_report_total_metabolics_only(false);
+        }
+    }
+    model.initSystem();
+
+    std::vector<std::string> probePaths;
+    for (const auto& probe : model.getComponentList<Probe>()) {
+        if (probe.isEnabled()) {
+            probePaths.push_back(probe.getAbsolutePathString());
+        }
+    }
+    OPENSIM_THROW_IF(probePaths.empty(), Exception,
+            "Expected the model to contain at least one enabled Probe.");
+
+    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            statesTable.getNumRows(), controlsTable.getNumRows());
+
+    // A states table from a simulation may contain the states of integrating
+    // probes, which this model does not have.
+    const auto statesTraj = StatesTrajectory::createFromStatesTable(
+            model, statesTable, false, true);
+    const std::vector<std::string>& controlNames =
+            controlsTable.getColumnLabels();
+    const std::unordered_map<std::string, int> controlMap =
+            createSystemControlIndexMap(model);
+
+    const int numTimes = (int)statesTraj.getSize();
+    const int numProbes = (int)probePaths.size();
+    std::vector<SimTK::Matrix> data(numProbes);
+    std::vector<std::vector<std::string>> labels(numProbes);
+    for (int iprobe = 0; iprobe < numProbes; ++iprobe) {
+        const auto& probe = model.getComponent<Probe>(probePaths[iprobe]);
+        const Array<std::string> probeLabels = probe.getProbeOutputLabels();
+        for (int ilabel = 0; ilabel < probeLabels.size(); ++ilabel) {
+            labels[iprobe].push_back(probeLabels[ilabel]);
+        }
+        data[iprobe].resize(numTimes, probe.getNumProbeInputs());
+    }
+
+    // Fill the rows [begin, end) of the tables using the provided
+    // (initialized) copy of the model. The threads write to separate rows.
+    auto evaluateTimePoints = [&](const Model& localModel, int begin,
+                                      int end) {
+        std::vector<const Probe*> probes;
+        for (const auto& path : probePaths) {
+            probes.push_back(&localModel.getComponent<Probe>(path));
+        }
+        SimTK::State state = localModel.getWorkingState();
+        SimTK::Vector controls(localModel.getNumControls(), 0.0);
+        for (int itime = begin; itime < end; ++itime) {
+            state.setTime(statesTraj[itime].getTime());
+            state.setY(statesTraj[itime].getY());
+            localModel.getSystem().prescribe(state);
+
+            const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+            for (int icontrol = 0; icontrol < (int)controlNames.size();
+                    ++icontrol) {
+                controls[controlMap.at(controlNames[icontrol])] =
+                        controlsRow[icontrol];
+            }
+            localModel.realizeVelocity(state);
+            localModel.setControls(state, controls);
+            localModel.realizeReport(state);
+
+            for (int iprobe = 0; iprobe < numProbes; ++iprobe) {
+                data[iprobe].updRow(itime) =
+                        ~probes[iprobe]->computeProbeInputs(state);
+            }
+        }
+    };
+
+    if (numThreads <= 0) {
+        numThreads = getNumAvailableThreads();
+    }
+    numThreads = std::max(1, std::min(numThreads, numTimes));
+    const ThreadReservation reservation(numThreads);
+    std::vector<std::unique_ptr<Model>> localModels;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        localModels.emplace_back(model.clone());
+    }
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto evaluateChunk = [&](int ithread) {
+        try {
+            const Model* localModel = &model;
+            if (ithread > 0) {
+                localModel = localModels[ithread - 1].get();
+                localModels[ithread - 1]->initSystem();
+            }
+            evaluateTimePoints(*localModel, ithread * numTimes / numThreads,
+                    (ithread + 1) * numTimes / numThreads);
+        } catch (...) {
+            errors[ithread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(evaluateChunk, ithread);
+    }
+    evaluateChunk(0);
+    for (auto& thread : threads) { thread.join(); }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    std::vector<double> times(numTimes);
+    for (int itime = 0; itime < numTimes; ++itime) {
+        times[itime] = statesTraj[itime].getTime();
+    }
+    std::map<std::string, TimeSeriesTable> tables;
+    for (int iprobe = 0; iprobe < numProbes; ++iprobe) {
+        tables.emplace(probePaths[iprobe],
+                TimeSeriesTable(times, data[iprobe], labels[iprobe]));
+    }
+    return tables;
+}
@@ -25,10 +25,13 @@
 
 #include "StatesTrajectory.h"
 #include "osimSimulationDLL.h"
+#include <map>
 #include <regex>
+#include <thread>
 
 #include <SimTKcommon/internal/State.h>
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -203,6 +206,12 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 ///
 /// Controls missing from the controls table are given a value of 0.
 ///
+/// The time points can be analyzed in parallel by providing `numThreads`
+/// greater than 1 (or a value less than or equal to 0 to use the number of
+/// hardware threads). The time points are split into contiguous chunks, each of
+/// which is analyzed with a separate copy of the model, so the components in
+/// the model must not share mutable state between copies.
+///
 /// @note The provided trajectory is not modified to satisfy kinematic
 /// constraints, but SimTK::Motions in the Model (e.g., PositionMotion) are
 /// applied. Therefore, this function expects that you've provided a trajectory
@@ -215,13 +224,18 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 template <typename T>
 TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
         const TimeSeriesTable& controlsTable,
-        const std::vector<std::string>& outputPaths) {
+        const std::vector<std::string>& outputPaths, int numThreads = 1) {
 
     // Initialize the system so we can access the outputs.
     model.initSystem();
     // Create the reporter object to which we'll add the output data to create
     // the report.
     auto* reporter = new TableReporter_<T>();
+    // Compile the output path patterns once, rather than for every output.
+    std::vector<std::regex> outputPathRegexes;
+    for (const auto& outputPathArg : outputPaths) {
+        outputPathRegexes.emplace_back(outputPathArg);
+    }
     // Loop through all the outputs for all components in the model, and if
     // the output path matches one provided in the argument and the output type
     // agrees with the template argument type, add it to the report.
@@ -229,9 +243,8 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
         for (const auto& outputName : comp.getOutputNames()) {
             const auto& output = comp.getOutput(outputName);
             auto thisOutputPath = output.getPathName();
-            for (const auto& outputPathArg : outputPaths) {
-                if (std::regex_match(
-                        thisOutputPath, std::regex(outputPathArg))) {
+            for (const auto& outputPathRegex : outputPathRegexes) {
+                if (std::regex_match(thisOutputPath, outputPathRegex)) {
                     // Make sure the output type agrees with the template.
                     if (dynamic_cast<const Output<T>*>(&output)) {
                         log_debug("Adding output {} of type {}.",
@@ -255,7 +268,6 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
             controlsTable.getColumnLabels();
     const std::unordered_map<std::string, int> controlMap =
             createSystemControlIndexMap(model);
-    SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
 
     OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
             Exception,
@@ -264,33 +276,130 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
             "and controlsTable contains {} rows.",
             statesTable.getNumRows(), controlsTable.getNumRows());
 
-    // Loop through the states trajectory to create the report.
-    for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
-        // Get the current state.
-        auto state = statesTraj[itime];
+    // Create the report for the time points [begin, end) using the
+    // provided (initialized) copy of the model.
+    auto analyzeTimePoints = [&](const Model& localModel, int begin, int end) {
+        SimTK::State state = localModel.getWorkingState();
+        SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
+        for (int itime = begin; itime < end; ++itime) {
+            // Get the current state. Only the time and the continuous state
+            // variables are copied, so that the state is compatible with
+            // localModel.
+            state.setTime(statesTraj[itime].getTime());
+            state.setY(statesTraj[itime].getY());
+
+            // Enforce any SimTK::Motion's included in the model.
+            localModel.getSystem().prescribe(state);
+
+            // Create a SimTK::Vector of the control values for the current
+            // state.
+            const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+            for (int icontrol = 0; icontrol < (int)controlNames.size();
+                    ++icontrol) {
+                controls[controlMap.at(controlNames[icontrol])] =
+                        controlsRow[icontrol];
+            }
 
-        // Enforce any SimTK::Motion's included in the model.
-        model.getSystem().prescribe(state);
+            // Set the controls on the state object.
+            localModel.realizeVelocity(state);
+            localModel.setControls(state, controls);
 
-        // Create a SimTK::Vector of the control values for the current state.
-        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
-        for (int icontrol = 0; icontrol < (int)controlNames.size();
-                ++icontrol) {
-            controls[controlMap.at(controlNames[icontrol])] =
-                    controlsRow[icontrol];
+            // Generate report results for the current state.
+            localModel.realizeReport(state);
         }
+    };
 
-        // Set the controls on the state object.
-        model.realizeVelocity(state);
-        model.setControls(state, controls);
+    const int numTimes = (int)statesTraj.getSize();
+    if (numThreads <= 0) {
+        numThreads = getNumAvailableThreads();
+    }
+    numThreads = std::max(1, std::min(numThreads, numTimes));
+    const ThreadReservation reservation(numThreads);
+    if (numThreads == 1) {
+        analyzeTimePoints(model, 0, numTimes);
+        return reporter->getTable();
+    }
 
-        // Generate report results for the current state.
-        model.realizeReport(state);
+    // Copy the model for each of the other threads before any thread starts,
+    // since analyzing the time points updates the model's cached values.
+    const std::string reporterPath = reporter->getAbsolutePathString();
+    std::vector<std::unique_ptr<Model>> localModels;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        localModels.emplace_back(model.clone());
+    }
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto analyzeChunk = [&](int ithread) {
+        try {
+            const Model* localModel = &model;
+            if (ithread > 0) {
+                localModel = localModels[ithread - 1].get();
+                localModels[ithread - 1]->initSystem();
+            }
+            analyzeTimePoints(*localModel, ithread * numTimes / numThreads,
+                    (ithread + 1) * numTimes / numThreads);
+        } catch (...) {
+            errors[ithread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        threads.emplace_back(analyzeChunk, ithread);
+    }
+    analyzeChunk(0);
+    for (auto& thread : threads) { thread.join(); }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
     }
 
-    return reporter->getTable();
+    // Merge the reports of the chunks, in order.
+    const TimeSeriesTable_<T>& firstTable = reporter->getTable();
+    const int numColumns = (int)firstTable.getNumColumns();
+    std::vector<double> times;
+    times.reserve(numTimes);
+    SimTK::Matrix_<T> data(numTimes, numColumns);
+    int irow = 0;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        const TimeSeriesTable_<T>& table = ithread == 0
+                ? firstTable
+                : localModels[ithread - 1]
+                          ->template getComponent<TableReporter_<T>>(
+                                  reporterPath)
+                          .getTable();
+        const int numRows = (int)table.getNumRows();
+        if (numRows == 0) continue;
+        times.insert(times.end(), table.getIndependentColumn().begin(),
+                table.getIndependentColumn().end());
+        data.updBlock(irow, 0, numRows, numColumns) = table.getMatrix();
+        irow += numRows;
+    }
+    std::vector<std::string> labels;
+    if (firstTable.hasColumnLabels()) labels = firstTable.getColumnLabels();
+    return TimeSeriesTable_<T>(times, data, labels);
 }
 
+/// Evaluate the enabled Probe%s in the model (e.g.,
+/// Umberger2010MuscleMetabolicsProbe and Bhargava2004MuscleMetabolicsProbe)
+/// at every row of the provided states and controls tables, for post-hoc
+/// analysis of a solution (e.g., from Moco or CMC). The result maps the
+/// absolute path of each probe to a table whose columns are the probe's
+/// inputs (Probe::getProbeOutputLabels()).
+///
+/// The probes are evaluated directly with Probe::computeProbeInputs(): the
+/// model is copied and each probe's operation is set to "value", so
+/// integrating probes do not add states that the states table does not
+/// contain (columns for such states in the states table are ignored). For
+/// the metabolics probes, report_total_metabolics_only is set
+/// to false so that the tables contain the total, the basal rate, and the
+/// rate of each muscle. Each time point is realized once for all of the
+/// probes.
+///
+/// The states and controls are handled as in analyze(), including
+/// `numThreads` and the note about kinematic constraints.
+/// @ingroup simulationutil
+OSIMSIMULATION_API std::map<std::string, TimeSeriesTable> analyzeProbes(
+        Model model, const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable, int numThreads = 1);
+
 } // end of namespace OpenSim
 
 #endif // OPENSIM_SIMULATION_UTILITIES_H_
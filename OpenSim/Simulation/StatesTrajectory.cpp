@@ -140,14 +140,16 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     size_t numDepColumns = stateVars.size();
 
     // Fill up the table with the data.
+    TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
+    SimTK::Vector values;
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
-        TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
 
         // Get each state variable's value.
         if (requestedStateVars.empty()) {
             // This is *much* faster than getting the values one-by-one.
-            row = model.getStateVariableValues(state).transpose();
+            model.getStateVariableValues(state, values);
+            row = values.transpose();
         } else {
             for (unsigned icol = 0; icol < numDepColumns; ++icol) {
                 row[static_cast<int>(icol)] =
@@ -178,11 +180,25 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
         bool allowExtraColumns,
         bool assemble) {
 
-    // Assemble the required objects.
-    // ==============================
-
     // This is what we'll return.
     StatesTrajectory states;
+    // Reserve the memory we'll need to fit all the states.
+    states.m_states.reserve(table.getNumRows());
+    forEachStateInStatesTable(model, table, allowMissingColumns,
+            allowExtraColumns, assemble,
+            [&states](const SimTK::State& state) { states.append(state); });
+    return states;
+}
+
+void StatesTrajectory::forEachStateInStatesTable(const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble,
+        const std::function<void(const SimTK::State&)>& appendState) {
+
+    // Assemble the required objects.
+    // ==============================
 
     // Make a copy of the model so that we can get a corresponding state.
     Model localModel(model);
@@ -247,8 +263,32 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // Fill up trajectory.
     // ===================
 
-    // Reserve the memory we'll need to fit all the states.
-    states.m_states.reserve(table.getNumRows());
+    // Resolve the index in the State's Y vector of each state variable once,
+    // so that each row can be written straight into Y. This is not possible
+    // if a state variable is not stored in Y (e.g., a discrete variable), in
+    // which case the values are set through the state variables.
+    std::vector<int> yIndices;
+    try {
+        std::vector<std::string> names(modelStateNames.getSize());
+        for (int is = 0; is < modelStateNames.getSize(); ++is) {
+            names[is] = modelStateNames[is];
+        }
+        yIndices = localModel.getStateVariableSystemIndices(names);
+    } catch (const Exception&) {
+        yIndices.clear();
+    }
+    const bool writeY = !yIndices.empty() || modelStateNames.getSize() == 0;
+
+    // The entries of Y for the missing columns; these are reset for each row
+    // since assembling may change them.
+    std::vector<int> missingYIndices;
+    if (writeY) {
+        std::vector<bool> isFilled(modelStateNames.getSize(), false);
+        for (const auto& kv : statesToFillUp) isFilled[kv.second] = true;
+        for (int is = 0; is < modelStateNames.getSize(); ++is) {
+            if (!isFilled[is]) missingYIndices.push_back(yIndices[is]);
+        }
+    }
 
     // Working memory for state. Initialize so that missing columns end up as
     // NaN.
@@ -257,28 +297,35 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // Initialize so that missing columns end up as NaN.
     state.updY().setToNaN();
 
+    const auto& times = table.getIndependentColumn();
+    const auto& matrix = table.getMatrix();
+
     // Loop through all rows of the Storage.
     for (int itime = 0; itime < (int)table.getNumRows(); ++itime) {
-        const auto& row = table.getRowAtIndex(itime);
-
         // Set the correct time in the state.
-        state.setTime(table.getIndependentColumn()[itime]);
+        state.setTime(times[itime]);
 
         // Fill up current State with the data for the current time.
-        for (const auto& kv : statesToFillUp) {
-            // 'first': index for Storage; 'second': index for Model.
-            statesValues[kv.second] = row[kv.first];
+        if (writeY) {
+            SimTK::Vector& y = state.updY();
+            for (const auto& kv : statesToFillUp) {
+                // 'first': index for Storage; 'second': index for Model.
+                y[yIndices[kv.second]] = matrix(itime, kv.first);
+            }
+            for (const int iy : missingYIndices) y[iy] = SimTK::NaN;
+        } else {
+            for (const auto& kv : statesToFillUp) {
+                statesValues[kv.second] = matrix(itime, kv.first);
+            }
+            localModel.setStateVariableValues(state, statesValues);
         }
-        localModel.setStateVariableValues(state, statesValues);
         if (assemble) {
             localModel.assemble(state);
         }
 
-        // Make a copy of the edited state and put it in the trajectory.
-        states.append(state);
+        // The caller copies the edited state into the trajectory.
+        appendState(state);
     }
-
-    return states;
 }
 
 StatesTrajectory StatesTrajectory::createFromStatesStorage(
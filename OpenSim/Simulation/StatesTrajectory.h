@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <functional>
 #include <vector>
 
 #include <OpenSim/Common/Exception.h>
@@ -289,8 +290,20 @@ public:
 
 private:
 
+    /* Create a state for each row of a states table and pass it to
+    appendState(); see createFromStatesTable(). The same state object is
+    edited for each row. */
+    static void forEachStateInStatesTable(const Model& model,
+            const TimeSeriesTable& table,
+            bool allowMissingColumns,
+            bool allowExtraColumns,
+            bool assemble,
+            const std::function<void(const SimTK::State&)>& appendState);
+
     std::vector<SimTK::State> m_states;
 
+    friend class CompactStatesTrajectory;
+
 public:
 
     /** Thrown when trying to append a state that is not consistent with the
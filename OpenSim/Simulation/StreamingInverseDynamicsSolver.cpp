@@ -0,0 +1,224 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  StreamingInverseDynamicsSolver.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StreamingInverseDynamicsSolver.h"
+#include "Model/Model.h"
+#include "Model/PhysicalFrame.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+using SimTK::Vec3;
+
+constexpr int StreamingInverseDynamicsSolver::NumValuesPerLoad;
+
+StreamingInverseDynamicsSolver::StreamingInverseDynamicsSolver(
+        const Model& model, int windowSize, int lag, int loadBufferSize)
+        : InverseDynamicsSolver(model), _windowSize(windowSize),
+          _lag(lag < 0 ? (windowSize - 1) / 2 : lag),
+          _loadBufferSize(loadBufferSize),
+          _loadBuffer(std::max(1, loadBufferSize), 0,
+                  DataRingBuffer_<double>::OverflowPolicy::DropNewest) {
+    OPENSIM_THROW_IF(windowSize < 3, Exception,
+            "Expected a window of at least 3 frames, but got {}.",
+            windowSize);
+    OPENSIM_THROW_IF(_lag >= windowSize, Exception,
+            "Expected a lag less than the window size ({}), but got {}.",
+            windowSize, _lag);
+    OPENSIM_THROW_IF(loadBufferSize < 1, Exception,
+            "Expected a positive load buffer size, but got {}.",
+            loadBufferSize);
+    _frameTimes.resize(windowSize);
+    _frameQs.resize(windowSize);
+    _weights.resize(windowSize);
+    _loadTimes.resize(loadBufferSize);
+}
+
+int StreamingInverseDynamicsSolver::addAppliedLoad(
+        const std::string& framePath) {
+    const auto& frame = getModel().getComponent<PhysicalFrame>(framePath);
+    _loadBodies.push_back(frame.getMobilizedBodyIndex());
+    _loadValues.resize(
+            (size_t)_loadBufferSize * NumValuesPerLoad * _loadBodies.size());
+    _loadHistoryStart = 0;
+    _numLoadSamples = 0;
+    return (int)_loadBodies.size() - 1;
+}
+
+bool StreamingInverseDynamicsSolver::pushLoads(
+        double time, const SimTK::Vector& loads) {
+    OPENSIM_THROW_IF(loads.size() != NumValuesPerLoad * getNumAppliedLoads(),
+            Exception, "Expected {} values ({} per applied load), but got {}.",
+            NumValuesPerLoad * getNumAppliedLoads(), NumValuesPerLoad,
+            loads.size());
+    return _loadBuffer.push(time, loads);
+}
+
+void StreamingInverseDynamicsSolver::reset() {
+    _numFrames = 0;
+    double time;
+    while (_loadBuffer.tryPop(time, _row)) {}
+    _loadHistoryStart = 0;
+    _numLoadSamples = 0;
+}
+
+bool StreamingInverseDynamicsSolver::update(SimTK::State& s, double time,
+        const SimTK::Vector& q, double& estimateTime,
+        SimTK::Vector& generalizedForces) {
+    OPENSIM_THROW_IF(s.getNQ() != s.getNU(), Exception,
+            "Models with nq != nu (e.g., with quaternions) are not "
+            "supported.");
+    OPENSIM_THROW_IF(q.size() != s.getNQ(), Exception,
+            "Expected {} coordinate values, but got {}.", s.getNQ(),
+            q.size());
+    if (_numFrames > 0) {
+        const double prevTime =
+                _frameTimes[(size_t)((_numFrames - 1) % _windowSize)];
+        OPENSIM_THROW_IF(time <= prevTime, Exception,
+                "Expected a time after the previous frame's ({}), but got "
+                "{}.", prevTime, time);
+    }
+
+    const size_t slot = (size_t)(_numFrames % _windowSize);
+    _frameTimes[slot] = time;
+    _frameQs[slot] = q;
+    ++_numFrames;
+    if (_numFrames < _windowSize) return false;
+
+    estimateTime = _frameTimes[(size_t)(
+            (_numFrames - 1 - _lag) % _windowSize)];
+    estimateKinematics(estimateTime);
+
+    s.setTime(estimateTime);
+    s.updQ() = _q;
+    s.updU() = _u;
+
+    // Forces computed by the model, plus the streamed loads.
+    const auto& system = getModel().getMultibodySystem();
+    system.realize(s, SimTK::Stage::Dynamics);
+    _mobilityForces = system.getMobilityForces(s, SimTK::Stage::Dynamics);
+    _bodyForces = system.getRigidBodyForces(s, SimTK::Stage::Dynamics);
+    applyLoads(s, estimateTime);
+
+    generalizedForces = solve(s, _udot, _mobilityForces, _bodyForces);
+    return true;
+}
+
+void StreamingInverseDynamicsSolver::estimateKinematics(double estimateTime) {
+    // Least-squares fit of q(x) = c0 + c1 x + c2 x^2 over the window, with
+    // the time normalized by the mean frame spacing h: x = (t - te) / h.
+    const size_t first = (size_t)(_numFrames % _windowSize);  // oldest frame
+    const size_t last = (size_t)((_numFrames - 1) % _windowSize);
+    const double h =
+            (_frameTimes[last] - _frameTimes[first]) / (_windowSize - 1);
+
+    SimTK::Mat33 normal(0);
+    for (int k = 0; k < _windowSize; ++k) {
+        const double x = (_frameTimes[k] - estimateTime) / h;
+        const Vec3 phi(1, x, x * x);
+        normal += phi * ~phi;
+    }
+    const SimTK::Mat33 normalInv = normal.invert();
+    for (int k = 0; k < _windowSize; ++k) {
+        const double x = (_frameTimes[k] - estimateTime) / h;
+        _weights[k] = normalInv * Vec3(1, x, x * x);
+    }
+
+    const int nq = _frameQs[0].size();
+    _q.resize(nq);
+    _u.resize(nq);
+    _udot.resize(nq);
+    for (int i = 0; i < nq; ++i) {
+        Vec3 c(0);
+        for (int k = 0; k < _windowSize; ++k) {
+            c += _weights[k] * _frameQs[k][i];
+        }
+        _q[i] = c[0];
+        _u[i] = c[1] / h;
+        _udot[i] = 2 * c[2] / (h * h);
+    }
+}
+
+void StreamingInverseDynamicsSolver::applyLoads(
+        const SimTK::State& s, double time) {
+    const int width = NumValuesPerLoad * getNumAppliedLoads();
+    if (width == 0) return;
+
+    // Keep the last _loadBufferSize samples.
+    double sampleTime;
+    while (_loadBuffer.tryPop(sampleTime, _row)) {
+        int slot;
+        if (_numLoadSamples < _loadBufferSize) {
+            slot = (_loadHistoryStart + _numLoadSamples) % _loadBufferSize;
+            ++_numLoadSamples;
+        } else {
+            slot = _loadHistoryStart;
+            _loadHistoryStart = (_loadHistoryStart + 1) % _loadBufferSize;
+        }
+        _loadTimes[slot] = sampleTime;
+        for (int i = 0; i < width; ++i) {
+            _loadValues[slot * width + i] = _row[i];
+        }
+    }
+    if (_numLoadSamples == 0) return;
+
+    // The samples surrounding `time`; hold the first and last samples
+    // outside of them.
+    int prev = -1;
+    int next = -1;
+    for (int k = 0; k < _numLoadSamples; ++k) {
+        const int slot = (_loadHistoryStart + k) % _loadBufferSize;
+        if (_loadTimes[slot] <= time) {
+            prev = slot;
+        } else {
+            next = slot;
+            break;
+        }
+    }
+    double w = 0;
+    if (prev < 0) {
+        prev = next;
+    } else if (next < 0) {
+        next = prev;
+    } else {
+        w = (time - _loadTimes[prev]) / (_loadTimes[next] - _loadTimes[prev]);
+    }
+    const double* a = &_loadValues[prev * width];
+    const double* b = &_loadValues[next * width];
+    const auto value = [&](int i) { return (1 - w) * a[i] + w * b[i]; };
+
+    const auto& matter = getModel().getMatterSubsystem();
+    for (int j = 0; j < getNumAppliedLoads(); ++j) {
+        const int offset = j * NumValuesPerLoad;
+        const Vec3 force(value(offset), value(offset + 1), value(offset + 2));
+        const Vec3 point(
+                value(offset + 3), value(offset + 4), value(offset + 5));
+        const Vec3 torque(
+                value(offset + 6), value(offset + 7), value(offset + 8));
+        const SimTK::MobilizedBody& mobod =
+                matter.getMobilizedBody(_loadBodies[j]);
+        // Shift the force from its point to the body's origin.
+        const Vec3 r = point - mobod.getBodyOriginLocation(s);
+        _bodyForces[_loadBodies[j]] += SimTK::SpatialVec(torque + r % force,
+                force);
+    }
+}
@@ -0,0 +1,167 @@
+#ifndef OPENSIM_STREAMING_INVERSE_DYNAMICS_SOLVER_H_
+#define OPENSIM_STREAMING_INVERSE_DYNAMICS_SOLVER_H_
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  StreamingInverseDynamicsSolver.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "InverseDynamicsSolver.h"
+#include <OpenSim/Common/DataQueue.h>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * An InverseDynamicsSolver for live data: coordinate values arrive one frame
+ * at a time (e.g., from an InverseKinematicsSolver tracking a
+ * BufferedOrientationsReference), and the generalized forces are computed
+ * for each frame with a bounded delay, without fitting splines to the whole
+ * trial.
+ *
+ * The speeds and accelerations are estimated with a causal fixed-lag filter:
+ * a quadratic is fit by least squares to the last `windowSize` frames
+ * (which may be unevenly spaced), and is evaluated at the frame that is
+ * `lag` frames older than the newest one. The estimate for a frame is
+ * therefore available `lag` frames after the frame arrives; lag =
+ * (windowSize - 1) / 2 gives a centered (Savitzky-Golay) filter, and a
+ * smaller lag trades noise for latency.
+ *
+ * External loads (e.g., from force plates) are sent from another thread
+ * with pushLoads(), through a lock-free single-producer, single-consumer
+ * DataRingBuffer_, and are interpolated linearly to the time of each
+ * estimate. Each load is applied to a frame that was added with
+ * addAppliedLoad(), in addition to the forces computed by the model. Until
+ * loads have been received, no external loads are applied.
+ *
+ * @code
+ * SimTK::State state = model.initSystem();
+ * StreamingInverseDynamicsSolver id(model);
+ * id.addAppliedLoad("/bodyset/calcn_r");
+ * std::thread forcePlate([&]() {
+ *     // ... read the force plate ...
+ *     id.pushLoads(time, forcePointTorque);
+ * });
+ * double estimateTime;
+ * SimTK::Vector tau;
+ * while (ikSolver.hasNext()) {
+ *     ikSolver.track(ikState);
+ *     if (id.update(state, ikState.getTime(), ikState.getQ(),
+ *             estimateTime, tau)) {
+ *         // ... tau are the generalized forces at estimateTime ...
+ *     }
+ * }
+ * @endcode
+ *
+ * Only models whose coordinates are their generalized coordinates (nq ==
+ * nu; e.g., no BallJoint or FreeJoint quaternions) are supported.
+ */
+class OSIMSIMULATION_API StreamingInverseDynamicsSolver
+        : public InverseDynamicsSolver {
+OpenSim_DECLARE_CONCRETE_OBJECT(
+        StreamingInverseDynamicsSolver, InverseDynamicsSolver);
+
+public:
+    /** The number of values per load sent to pushLoads(): force (3), point
+    of application (3) and torque (3), all expressed in ground. */
+    static constexpr int NumValuesPerLoad = 9;
+
+    /** @param model The model, whose system must have been created (e.g., by
+            initSystem()).
+        @param windowSize Number of frames in the filter window (at least 3).
+        @param lag Number of frames between the newest frame and the frame
+            that is estimated (0 <= lag < windowSize); the default centers the
+            window.
+        @param loadBufferSize Maximum number of load samples waiting to be
+            consumed, and the number of consumed samples kept for
+            interpolation. */
+    explicit StreamingInverseDynamicsSolver(const Model& model,
+            int windowSize = 9, int lag = -1, int loadBufferSize = 256);
+
+    /** Apply a streamed load to the PhysicalFrame at `framePath` (e.g.,
+    "/bodyset/calcn_r"). Loads are sent in the order they are added. Returns
+    the index of the load. This must not be called while another thread
+    pushes loads. */
+    int addAppliedLoad(const std::string& framePath);
+    int getNumAppliedLoads() const { return (int)_loadBodies.size(); }
+
+    /** (Producer) Send the loads at the given time: NumValuesPerLoad values
+    per applied load, in the order of addAppliedLoad(). Samples are normally
+    pushed in order of increasing time. Returns false, dropping the sample,
+    if the buffer is full. */
+    bool pushLoads(double time, const SimTK::Vector& loads);
+
+    /** The number of load samples dropped because the buffer was full. */
+    int getNumDroppedLoads() const { return _loadBuffer.getNumDropped(); }
+
+    /** (Consumer) Add the coordinate values `q` (in the order of the state's
+    Q) of the frame at `time`, which must be after the previous frame. Once
+    the window is full, this estimates q, u and udot at the frame `lag`
+    frames older than this one, sets the time, Q and U of `s` to them,
+    computes the generalized forces into `generalizedForces`, sets
+    `estimateTime` and returns true; otherwise, it returns false. */
+    bool update(SimTK::State& s, double time, const SimTK::Vector& q,
+            double& estimateTime, SimTK::Vector& generalizedForces);
+
+    /** Forget the received frames and consumed loads. This must not be
+    called while another thread pushes loads. */
+    void reset();
+
+    int getWindowSize() const { return _windowSize; }
+    int getLag() const { return _lag; }
+
+private:
+    // Fit the window and set _q, _u and _udot at the estimate time.
+    void estimateKinematics(double estimateTime);
+    // Move the waiting load samples into the history, and add the loads
+    // interpolated to `time` to _bodyForces.
+    void applyLoads(const SimTK::State& s, double time);
+
+    int _windowSize;
+    int _lag;
+    int _loadBufferSize;
+
+    // Ring of the last _windowSize frames; _numFrames counts all frames.
+    std::vector<double> _frameTimes;
+    std::vector<SimTK::Vector> _frameQs;
+    long long _numFrames = 0;
+    // Filter weights for the value, first and second derivative (per unit
+    // of the normalized time) of each frame of the window.
+    std::vector<SimTK::Vec3> _weights;
+
+    std::vector<SimTK::MobilizedBodyIndex> _loadBodies;
+    DataRingBuffer_<double> _loadBuffer;
+    // Ring of the last _loadBufferSize consumed load samples.
+    std::vector<double> _loadTimes;
+    std::vector<double> _loadValues;
+    int _loadHistoryStart = 0;
+    int _numLoadSamples = 0;
+    SimTK::Vector _row;
+
+    SimTK::Vector _q, _u, _udot;
+    SimTK::Vector _mobilityForces;
+    SimTK::Vector_<SimTK::SpatialVec> _bodyForces;
+
+//=============================================================================
+};  // END of class StreamingInverseDynamicsSolver
+//=============================================================================
+} // namespace
+
+#endif // OPENSIM_STREAMING_INVERSE_DYNAMICS_SOLVER_H_
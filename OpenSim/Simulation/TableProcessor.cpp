@@ -0,0 +1,125 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: TableProcessor.cpp                                                *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2021 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TableProcessor.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+
+using namespace OpenSim;
+
+namespace {
+struct TableCache {
+    ResultCache<TimeSeriesTable> tables;
+    std::atomic<bool> enabled{false};
+    std::string directory;
+    std::mutex directoryMutex;
+};
+// The cache lives in this translation unit (rather than in the header) so
+// that there is a single cache even when the library is used from other
+// libraries.
+TableCache& getTableCache() {
+    static TableCache cache;
+    return cache;
+}
+} // namespace
+
+TimeSeriesTable TableProcessor::process(
+        std::string relativeToDirectory, const Model* model) const {
+    OPENSIM_THROW_IF_FRMOBJ(get_filepath().empty() && !m_tableProvided,
+            Exception, "No source table.");
+    OPENSIM_THROW_IF_FRMOBJ(!get_filepath().empty() && m_tableProvided,
+            Exception,
+            "Expected either an in-memory table or a filepath, but "
+            "both were provided.");
+    if (m_tableProvided) {
+        TimeSeriesTable table = m_table;
+        for (int i = 0; i < getProperty_operators().size(); ++i) {
+            get_operators(i).operate(table, model);
+        }
+        return table;
+    }
+
+    std::string path = get_filepath();
+    if (!relativeToDirectory.empty()) {
+        using SimTK::Pathname;
+        path = Pathname::getAbsolutePathnameUsingSpecifiedWorkingDirectory(
+                relativeToDirectory, path);
+    }
+
+    auto& cache = getTableCache();
+    std::string key;
+    std::string cacheFile;
+    if (cache.enabled) {
+        const std::string fileHash = createFNV1aHashOfFile(path);
+        // If the file cannot be read, let the TimeSeriesTable constructor
+        // below report the error.
+        if (!fileHash.empty()) {
+            key = createFNV1aHash(dump() + "\n" + path + "\n" + fileHash +
+                                  "\n" + (model ? model->dump() : ""));
+            TimeSeriesTable table;
+            if (cache.tables.find(key, table)) return table;
+            const std::string directory = getCacheDirectory();
+            if (!directory.empty()) {
+                cacheFile = directory + "/TableProcessor_" + key + ".sto";
+                if (IO::FileExists(cacheFile)) {
+                    table = TimeSeriesTable(cacheFile);
+                    cache.tables.insert(key, table);
+                    return table;
+                }
+            }
+        }
+    }
+
+    TimeSeriesTable table(path);
+    for (int i = 0; i < getProperty_operators().size(); ++i) {
+        get_operators(i).operate(table, model);
+    }
+    if (!key.empty()) {
+        cache.tables.insert(key, table);
+        if (!cacheFile.empty()) STOFileAdapter::write(table, cacheFile);
+    }
+    return table;
+}
+
+void TableProcessor::setUseCache(bool tf) {
+    auto& cache = getTableCache();
+    cache.enabled = tf;
+    if (!tf) cache.tables.clear();
+}
+
+bool TableProcessor::getUseCache() { return getTableCache().enabled; }
+
+void TableProcessor::setCacheDirectory(std::string directory) {
+    auto& cache = getTableCache();
+    std::lock_guard<std::mutex> lock(cache.directoryMutex);
+    cache.directory = std::move(directory);
+}
+
+std::string TableProcessor::getCacheDirectory() {
+    auto& cache = getTableCache();
+    std::lock_guard<std::mutex> lock(cache.directoryMutex);
+    return cache.directory;
+}
+
+void TableProcessor::setCacheCapacity(int capacity) {
+    getTableCache().tables.setCapacity(capacity);
+}
+
+int TableProcessor::getCacheSize() { return getTableCache().tables.size(); }
+
+void TableProcessor::clearCache() { getTableCache().tables.clear(); }
@@ -79,32 +79,7 @@ public:
     contains such an operator, then the operator will throw an exception
     if you do not provide a model when invoking this function. */
     TimeSeriesTable process(std::string relativeToDirectory,
-            const Model* model = nullptr) const {
-        OPENSIM_THROW_IF_FRMOBJ(get_filepath().empty() && !m_tableProvided,
-                Exception, "No source table.");
-        OPENSIM_THROW_IF_FRMOBJ(!get_filepath().empty() && m_tableProvided,
-                Exception,
-                "Expected either an in-memory table or a filepath, but "
-                "both were provided.");
-        TimeSeriesTable table;
-        if (m_tableProvided) {
-            table = m_table;
-        } else {
-            std::string path = get_filepath();
-            if (!relativeToDirectory.empty()) {
-                using SimTK::Pathname;
-                path = Pathname::
-                        getAbsolutePathnameUsingSpecifiedWorkingDirectory(
-                                relativeToDirectory, path);
-            }
-            table = TimeSeriesTable(path);
-        }
-
-        for (int i = 0; i < getProperty_operators().size(); ++i) {
-            get_operators(i).operate(table, model);
-        }
-        return table;
-    }
+            const Model* model = nullptr) const;
     /** Same as above, but paths are evaluated with respect to the current
     working directory. */
     TimeSeriesTable process(const Model* model = nullptr) const {
@@ -154,6 +129,33 @@ public:
         return append(right);
     }
 
+    /// @name Caching processed tables
+    /// When caching is enabled, process() stores a copy of each processed
+    /// table, keyed by a hash of this processor (its filepath and operators),
+    /// the content of the source file, and the model (if provided). Processing
+    /// the same file with the same operators again (e.g., for each trial of a
+    /// batch) then returns the stored copy. Only processors whose source table
+    /// is a file are cached. Files that operators read themselves are not part
+    /// of the key. The cache is shared by all processors.
+    /// @{
+    /** Enable or disable caching of processed tables (default: disabled).
+    Disabling the cache also clears it. */
+    static void setUseCache(bool tf);
+    static bool getUseCache();
+    /** If not empty, processed tables are also stored as .sto files in this
+    directory, so that they can be reused across runs (default: empty). The
+    directory must exist. */
+    static void setCacheDirectory(std::string directory);
+    static std::string getCacheDirectory();
+    /** The maximum number of tables kept in memory (default: 16). */
+    static void setCacheCapacity(int capacity);
+    /** The number of tables currently kept in memory. */
+    static int getCacheSize();
+    /** Remove all tables kept in memory. Files in the cache directory are
+    not removed. */
+    static void clearCache();
+    /// @}
+
 private:
     bool m_tableProvided = false;
     TimeSeriesTable m_table;
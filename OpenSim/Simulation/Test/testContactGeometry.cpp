@@ -77,6 +77,8 @@ int testBallToBallContact(bool useElasticFoundation, bool useMesh1, bool useMesh
 void compareHertzAndMeshContactResults();
 template <typename ContactType> // e.g., HuntCrossley.
 void testIntermediateFrames();
+void testMeshLoading();
+void testContactEvents();
 
 int main()
 {
@@ -97,6 +99,8 @@ int main()
 
         testIntermediateFrames<OpenSim::HuntCrossleyForce>();
         testIntermediateFrames<OpenSim::ElasticFoundationForce>();
+        testMeshLoading();
+        testContactEvents();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -612,3 +616,131 @@ void testIntermediateFrames() {
 
 
 
+
+// Mesh files can be loaded ahead of drawing, and ContactMeshes that use the
+// same file share the parsed mesh.
+void testMeshLoading() {
+    Model model;
+    auto* found = new OpenSim::Mesh(mesh_files[0]);
+    model.updGround().attachGeometry(found);
+    auto* missing = new OpenSim::Mesh("testContactGeometry_missing.obj");
+    model.updGround().attachGeometry(missing);
+    auto* mesh1 = new ContactMesh(mesh_files[2], Vec3(0), Vec3(0),
+            model.getGround(), "mesh1");
+    model.addContactGeometry(mesh1);
+    auto* mesh2 = new ContactMesh(mesh_files[2], Vec3(0), Vec3(0),
+            model.getGround(), "mesh2");
+    model.addContactGeometry(mesh2);
+    model.initSystem();
+
+    ASSERT(found->loadMeshFile());
+    ASSERT(!missing->loadMeshFile());
+
+    using SimTK::ContactGeometry;
+    const ContactGeometry geom1 = mesh1->createSimTKContactGeometry();
+    const ContactGeometry geom2 = mesh2->createSimTKContactGeometry();
+    const int numFaces =
+            ContactGeometry::TriangleMesh::getAs(geom1).getNumFaces();
+    ASSERT(numFaces > 0);
+    ASSERT(numFaces ==
+            ContactGeometry::TriangleMesh::getAs(geom2).getNumFaces());
+
+    // The contact meshes share a cached bounding-volume tree, and the tree
+    // of each copy covers all of the faces.
+    const auto root1 =
+            ContactGeometry::TriangleMesh::getAs(geom1).getOBBTreeNode();
+    const auto root2 =
+            ContactGeometry::TriangleMesh::getAs(geom2).getOBBTreeNode();
+    ASSERT(root1.getNumTriangles() == numFaces);
+    ASSERT(root2.getNumTriangles() == numFaces);
+    ASSERT_EQUAL(root1.getBounds().getSize(), root2.getBounds().getSize(),
+            1e-12, __FILE__, __LINE__,
+            "Expected identical bounding-volume trees.");
+
+    // A copy of the model reloads its contact meshes.
+    Model copy(model);
+    copy.initSystem();
+    const auto& copyMesh =
+            copy.getComponent<ContactMesh>("/contactgeometryset/mesh1");
+    ASSERT(numFaces == ContactGeometry::TriangleMesh::getAs(
+                               copyMesh.createSimTKContactGeometry())
+                               .getNumFaces());
+}
+
+// Localize the impact of a falling ball with event triggers and use a tighter
+// accuracy right after the impact.
+void testContactEvents()
+{
+    cout << "Testing contact events" << endl;
+    const auto createModel = [](bool localize) {
+        auto model = std::unique_ptr<Model>(new Model);
+        auto* ball = new OpenSim::Body("ball", mass, Vec3(0), Inertia(1.0));
+        model->addBody(ball);
+        model->addJoint(new FreeJoint("free", model->getGround(), *ball));
+        model->addContactGeometry(new ContactHalfSpace(Vec3(0),
+                Vec3(0, 0, -0.5 * SimTK_PI), model->getGround(), "floor"));
+        model->addContactGeometry(
+                new ContactSphere(radius, Vec3(0), *ball, "sphere"));
+        auto* contactParams = new OpenSim::HuntCrossleyForce::ContactParameters(
+                1.0e6, 1e-5, 0.0, 0.0, 0.0);
+        contactParams->addGeometry("sphere");
+        contactParams->addGeometry("floor");
+        auto* force = new OpenSim::HuntCrossleyForce(contactParams);
+        force->setName("contact");
+        force->set_localize_contact_events(localize);
+        model->addForce(force);
+        model->setGravity(gravity_vec);
+        return model;
+    };
+
+    auto unlocalized = createModel(false);
+    const auto& floor = unlocalized->getComponent<ContactGeometry>(
+            "/contactgeometryset/floor");
+    const auto& sphere = unlocalized->getComponent<ContactGeometry>(
+            "/contactgeometryset/sphere");
+    ASSERT(ContactEventHandler::isSupported(sphere, floor));
+    ASSERT(!ContactEventHandler::isSupported(floor, floor));
+
+    // The ball reaches the floor when it has fallen height - radius.
+    const double onsetTime =
+            std::sqrt(2 * (height - radius) / -gravity_vec[1]);
+    auto model = createModel(true);
+    const auto& force =
+            model->getComponent<OpenSim::HuntCrossleyForce>("/forceset/contact");
+    SimTK::State state = model->initSystem();
+    state.updQ()[4] = height;
+    SimTK_TEST(force.getContactEventStatistics().size() == 1);
+    SimTK_TEST(!force.isInImpactWindow(state));
+
+    IntegratorAccuracyPolicy policy(integ_accuracy);
+    policy.addPhase("impact", [&force](const SimTK::State& s) {
+                return force.isInImpactWindow(s);
+            }, 1e-7);
+    Manager manager(*model);
+    manager.setIntegratorAccuracyPolicy(policy);
+    manager.initialize(state);
+    state = manager.integrate(onsetTime + 0.5 * force.get_impact_window());
+
+    const auto& stats = force.getContactEventStatistics()[0];
+    SimTK_TEST(stats.numOnsets == 1);
+    ASSERT_EQUAL(onsetTime, stats.lastOnsetTime, 1e-4, __FILE__, __LINE__,
+            "The contact onset was not localized.");
+    ASSERT_EQUAL(onsetTime, force.getLastContactOnsetTime(state), 1e-4,
+            __FILE__, __LINE__, "The onset time in the state is wrong.");
+    SimTK_TEST(force.isInImpactWindow(state));
+    SimTK_TEST(manager.getIntegratorAccuracyPolicyStatistics()
+                       .numStepsPerPhase[1] > 0);
+
+    // Continue through the bounce; each onset is followed by a release.
+    state = manager.integrate(duration);
+    SimTK_TEST(stats.numOnsets >= 1);
+    SimTK_TEST(stats.numReleases == stats.numOnsets ||
+               stats.numReleases == stats.numOnsets - 1);
+    cout << "Onsets: " << stats.numOnsets << ", releases: "
+         << stats.numReleases << ", rejected steps: "
+         << manager.getIntegrator().getNumErrorTestFailures() << endl;
+
+    model->updComponent<OpenSim::HuntCrossleyForce>("/forceset/contact")
+            .resetContactEventStatistics();
+    SimTK_TEST(stats.numOnsets == 0);
+}
@@ -35,15 +35,22 @@
 //      9. PathSpring
 //     10. ExpressionBasedPointToPointForce
 //     11. Blankevoort1991Ligament
+//     12. Parallel force evaluation (Model's use_parallel_forces)
+//     13. BatchedSmoothSphereHalfSpaceForce
+//     14. ExternalForce presampling
+//     15. Recording force values without allocation (writeRecordValues)
 //
 //     Add tests here as Forces are added to OpenSim
 //
 //==============================================================================
 #include "SimTKcommon/internal/Xml.h"
 #include <ctime> // clock(), clock_t, CLOCKS_PER_SEC
+#include <thread>
 
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Analyses/osimAnalyses.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Simulation/Model/ForceAdapter.h>
 #include <OpenSim/Simulation/osimSimulation.h>
 
 using namespace OpenSim;
@@ -74,6 +81,10 @@ void testSerializeDeserialize();
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord,
         double start_h, Component& componentWithDamping);
 void testBlankevoort1991Ligament();
+void testParallelForces();
+void testBatchedSmoothSphereHalfSpaceForce();
+void testExternalForcePresampling();
+void testWriteRecordValues();
 
 int main() {
     SimTK::Array_<std::string> failures;
@@ -174,6 +185,30 @@ int main() {
         failures.push_back("testBlankevoort1991Ligament");
     }
 
+    try { testParallelForces(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelForces");
+    }
+
+    try { testBatchedSmoothSphereHalfSpaceForce(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testBatchedSmoothSphereHalfSpaceForce");
+    }
+
+    try { testExternalForcePresampling(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testExternalForcePresampling");
+    }
+
+    try { testWriteRecordValues(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testWriteRecordValues");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -284,6 +319,15 @@ void testExpressionBasedCoordinateForce() {
 
     osimModel.print("ExpressionBasedCoordinateForceModel.osim");
 
+    // An expression may use a subset of the variables but no others.
+    spring.setExpression("-10*q");
+    SimTK::State& s = osimModel.initSystem();
+    sliderCoord.setValue(s, 0.3);
+    sliderCoord.setSpeedValue(s, 2.0);
+    ASSERT_EQUAL(-3.0, spring.calcExpressionForce(s), 1e-12);
+    spring.setExpression("-10*x");
+    ASSERT_THROW(OpenSim::Exception, osimModel.initSystem());
+
     osimModel.disownAllComponents();
 }
 
@@ -2382,3 +2426,354 @@ void testBlankevoort1991Ligament() {
         "reference state be equal to the strain value input "
         "to setSlackLengthFromReferenceStrain().");
 }
+
+// Records the thread on which its force is computed.
+class NonThreadSafeForce : public Force {
+OpenSim_DECLARE_CONCRETE_OBJECT(NonThreadSafeForce, Force);
+public:
+    bool isComputeForceThreadSafe() const override { return false; }
+    mutable std::thread::id threadId;
+protected:
+    void computeForce(const SimTK::State&, SimTK::Vector_<SimTK::SpatialVec>&,
+            SimTK::Vector&) const override {
+        threadId = std::this_thread::get_id();
+    }
+};
+
+class ThrowingForce : public Force {
+OpenSim_DECLARE_CONCRETE_OBJECT(ThrowingForce, Force);
+protected:
+    void computeForce(const SimTK::State&, SimTK::Vector_<SimTK::SpatialVec>&,
+            SimTK::Vector&) const override {
+        OPENSIM_THROW_FRMOBJ(Exception, "Expected failure.");
+    }
+};
+
+void testParallelForces() {
+    using namespace SimTK;
+
+    // A free body held by many springs, and a coordinate actuator whose
+    // control comes from a controller.
+    const auto populateModel = [](Model& model, bool parallel) {
+        model.set_use_parallel_forces(parallel);
+        auto* body = new OpenSim::Body("body", 1.0, Vec3(0),
+                Inertia::brick(0.1, 0.2, 0.3));
+        model.addBody(body);
+        auto* joint = new FreeJoint("joint", model.getGround(), *body);
+        model.addJoint(joint);
+        for (int i = 0; i < 50; ++i) {
+            const double angle = 2 * Pi * i / 50.0;
+            auto* spring = new PointToPointSpring(model.getGround(),
+                    Vec3(cos(angle), 1.0 + 0.01 * i, sin(angle)), *body,
+                    Vec3(0.1 * sin(angle), 0, 0.1 * cos(angle)),
+                    10.0 + i, 0.5);
+            spring->setName("spring" + std::to_string(i));
+            model.addForce(spring);
+        }
+        auto* actu = new CoordinateActuator(
+                joint->getCoordinate(FreeJoint::Coord::TranslationY).getName());
+        actu->setName("actuator");
+        actu->setOptimalForce(1.0);
+        model.addForce(actu);
+        auto* controller = new PrescribedController();
+        controller->addActuator(*actu);
+        controller->prescribeControlForActuator("actuator", new Constant(3.0));
+        model.addController(controller);
+    };
+
+    Model serialModel;
+    populateModel(serialModel, false);
+    Model parallelModel;
+    populateModel(parallelModel, true);
+    auto* nonThreadSafe = new NonThreadSafeForce();
+    nonThreadSafe->setName("non_thread_safe");
+    parallelModel.addForce(nonThreadSafe);
+
+    SimTK::State serialState = serialModel.initSystem();
+    SimTK::State parallelState = parallelModel.initSystem();
+    const auto setState = [](const Model& model, SimTK::State& state) {
+        for (int i = 0; i < state.getNQ(); ++i) {
+            state.updQ()[i] = 0.1 * (i + 1);
+        }
+        for (int i = 0; i < state.getNU(); ++i) {
+            state.updU()[i] = -0.2 * (i + 1);
+        }
+        model.realizeAcceleration(state);
+    };
+    setState(serialModel, serialState);
+    setState(parallelModel, parallelState);
+    ASSERT_EQUAL<SimTK::Vector>(serialState.getUDot(),
+            parallelState.getUDot(), 1e-10, __FILE__, __LINE__,
+            "Parallel force evaluation changed the accelerations.");
+    ASSERT(nonThreadSafe->threadId == std::this_thread::get_id(), __FILE__,
+            __LINE__, "Expected the non-thread-safe force to be computed on "
+            "the calling thread.");
+
+    // Forces that are not applied are skipped.
+    serialModel.getComponent<Force>("/forceset/spring3")
+            .setAppliesForce(serialState, false);
+    parallelModel.getComponent<Force>("/forceset/spring3")
+            .setAppliesForce(parallelState, false);
+    setState(serialModel, serialState);
+    setState(parallelModel, parallelState);
+    ASSERT_EQUAL<SimTK::Vector>(serialState.getUDot(),
+            parallelState.getUDot(), 1e-10, __FILE__, __LINE__,
+            "Disabled forces are not respected in parallel.");
+
+    // In deterministic mode, repeated evaluations are bitwise identical.
+    ParallelForceAdapter::setDeterministic(true);
+    setState(parallelModel, parallelState);
+    const SimTK::Vector udot = parallelState.getUDot();
+    for (int i = 0; i < 20; ++i) {
+        setState(parallelModel, parallelState);
+        ASSERT_EQUAL<SimTK::Vector>(udot, parallelState.getUDot(), 0.0,
+                __FILE__, __LINE__, "Deterministic parallel force evaluation "
+                "is not reproducible.");
+    }
+    ASSERT_EQUAL<SimTK::Vector>(serialState.getUDot(), udot, 1e-10,
+            __FILE__, __LINE__,
+            "Deterministic parallel force evaluation changed the "
+            "accelerations.");
+    ParallelForceAdapter::setDeterministic(false);
+
+    // An exception thrown on a worker thread reaches the caller.
+    Model throwingModel;
+    populateModel(throwingModel, true);
+    throwingModel.addForce(new ThrowingForce());
+    SimTK::State throwingState = throwingModel.initSystem();
+    ASSERT_THROW(std::exception, throwingModel.realizeDynamics(throwingState));
+}
+
+void testBatchedSmoothSphereHalfSpaceForce() {
+    using namespace SimTK;
+
+    // A free body with several spheres resting on the floor. The batched
+    // force must reproduce one SmoothSphereHalfSpaceForce per sphere.
+    const int numSpheres = 6;
+    const auto populateModel = [&](Model& model, bool batched) {
+        model.setGravity(gravity_vec);
+        auto* body = new OpenSim::Body("foot", 1.5, Vec3(0),
+                Inertia::brick(0.1, 0.02, 0.05));
+        model.addBody(body);
+        model.addJoint(new FreeJoint("joint", model.getGround(), *body));
+
+        auto* floor = new ContactHalfSpace(
+                Vec3(0), Vec3(0, 0, -0.5 * Pi), model.getGround(), "floor");
+        model.addContactGeometry(floor);
+
+        BatchedSmoothSphereHalfSpaceForce* batch = nullptr;
+        if (batched) {
+            batch = new BatchedSmoothSphereHalfSpaceForce("contact", *floor);
+            model.addForce(batch);
+        }
+        for (int i = 0; i < numSpheres; ++i) {
+            auto* sphere = new ContactSphere(0.02 + 0.002 * i,
+                    Vec3(-0.1 + 0.04 * i, -0.03, 0.02 * (i % 2)), *body,
+                    "sphere" + std::to_string(i));
+            model.addContactGeometry(sphere);
+            if (batched) {
+                batch->addContactSphere(
+                        "/contactgeometryset/" + sphere->getName());
+            } else {
+                auto* force = new OpenSim::SmoothSphereHalfSpaceForce(
+                        "contact" + std::to_string(i), *sphere, *floor);
+                force->set_stiffness(1e6);
+                force->set_dissipation(2.0);
+                force->set_static_friction(0.8);
+                force->set_dynamic_friction(0.6);
+                force->set_viscous_friction(0.2);
+                model.addForce(force);
+            }
+        }
+        if (batch) {
+            batch->set_stiffness(1e6);
+            batch->set_dissipation(2.0);
+            batch->set_static_friction(0.8);
+            batch->set_dynamic_friction(0.6);
+            batch->set_viscous_friction(0.2);
+        }
+        model.finalizeConnections();
+    };
+
+    Model individualModel;
+    populateModel(individualModel, false);
+    Model batchedModel;
+    populateModel(batchedModel, true);
+
+    // A batched force survives serialization.
+    batchedModel.print("testForces_BatchedSmoothSphereHalfSpaceForce.osim");
+    Model deserializedModel("testForces_BatchedSmoothSphereHalfSpaceForce.osim");
+
+    SimTK::State individualState = individualModel.initSystem();
+    SimTK::State batchedState = batchedModel.initSystem();
+    SimTK::State deserializedState = deserializedModel.initSystem();
+    const auto setState = [](const Model& model, SimTK::State& state) {
+        // Slightly tilted and sliding, with some spheres penetrating.
+        for (int i = 0; i < state.getNQ(); ++i) {
+            state.updQ()[i] = 0.05 * (i + 1);
+        }
+        state.updQ()[4] = 0.015;
+        for (int i = 0; i < state.getNU(); ++i) {
+            state.updU()[i] = 0.1 * (i % 3) - 0.05;
+        }
+        model.realizeAcceleration(state);
+    };
+    setState(individualModel, individualState);
+    setState(batchedModel, batchedState);
+    setState(deserializedModel, deserializedState);
+    ASSERT_EQUAL<SimTK::Vector>(individualState.getUDot(),
+            batchedState.getUDot(), 1e-8, __FILE__, __LINE__,
+            "Batched contact forces changed the accelerations.");
+    ASSERT_EQUAL<SimTK::Vector>(batchedState.getUDot(),
+            deserializedState.getUDot(), 1e-12, __FILE__, __LINE__,
+            "Deserialized batched contact gives different accelerations.");
+
+    // The reported force on each sphere matches the individual force.
+    const auto& batch = batchedModel.getComponent<
+            BatchedSmoothSphereHalfSpaceForce>("/forceset/contact");
+    const Array<double> batchValues = batch.getRecordValues(batchedState);
+    ASSERT(batchValues.size() == 6 * numSpheres);
+    ASSERT(batch.getRecordLabels().size() == 6 * numSpheres);
+    for (int i = 0; i < numSpheres; ++i) {
+        const auto& force =
+                individualModel.getComponent<OpenSim::SmoothSphereHalfSpaceForce>(
+                        "/forceset/contact" + std::to_string(i));
+        const Array<double> values = force.getRecordValues(individualState);
+        for (int j = 0; j < 6; ++j) {
+            ASSERT_EQUAL(values[j], batchValues[6 * i + j],
+                    1e-8 * (1 + std::abs(values[j])), __FILE__, __LINE__,
+                    "Reported contact forces do not match.");
+        }
+    }
+}
+
+void testExternalForcePresampling() {
+    using namespace SimTK;
+
+    // Time-varying force, point and torque data.
+    Storage data;
+    data.setName("presampling_data");
+    Array<std::string> labels("time", 1);
+    for (const std::string& name : {"force", "point", "torque"}) {
+        labels.append(name + ".X");
+        labels.append(name + ".Y");
+        labels.append(name + ".Z");
+    }
+    data.setColumnLabels(labels);
+    std::vector<double> dataTimes;
+    for (int i = 0; i < 21; ++i) {
+        const double t = 0.05 * i;
+        dataTimes.push_back(t);
+        SimTK::Vector row(9);
+        for (int j = 0; j < 9; ++j) { row[j] = std::sin(t * (j + 1)) + j; }
+        data.append(t, row);
+    }
+
+    Model model;
+    auto* body = new OpenSim::Body("body", 1.0, Vec3(0), Inertia(0.1));
+    model.addBody(body);
+    model.addJoint(new FreeJoint("joint", model.getGround(), *body));
+    auto* force = new ExternalForce(
+            data, "force", "point", "torque", "body", "ground", "body");
+    force->setName("external");
+    model.addForce(force);
+    SimTK::State s = model.initSystem();
+    for (int i = 0; i < s.getNQ(); ++i) { s.updQ()[i] = 0.1 * (i + 1); }
+    for (int i = 0; i < s.getNU(); ++i) { s.updU()[i] = -0.1 * i; }
+
+    // Accelerations at the data times and between them.
+    std::vector<double> times;
+    for (int i = 0; i < 40; ++i) times.push_back(0.025 * i);
+    std::vector<SimTK::Vector> expected;
+    for (double t : times) {
+        s.setTime(t);
+        model.realizeAcceleration(s);
+        expected.push_back(s.getUDot());
+    }
+
+    // Presample at every other time; the rest are interpolated.
+    std::vector<double> sampleTimes;
+    for (int i = 0; i < (int)times.size(); i += 2) {
+        sampleTimes.push_back(times[i]);
+    }
+    auto& external = model.updComponent<ExternalForce>("/forceset/external");
+    external.presampleAtTimes(sampleTimes);
+    ASSERT(external.getNumPresampledTimes() == (int)sampleTimes.size());
+    for (int i = 0; i < (int)times.size(); ++i) {
+        s.setTime(times[i]);
+        model.realizeAcceleration(s);
+        ASSERT_EQUAL<SimTK::Vector>(expected[i], s.getUDot(), 1e-10,
+                __FILE__, __LINE__,
+                "Presampled external force changed the accelerations.");
+    }
+    // Also in reverse order.
+    for (int i = (int)times.size() - 1; i >= 0; --i) {
+        s.setTime(times[i]);
+        model.realizeAcceleration(s);
+        ASSERT_EQUAL<SimTK::Vector>(expected[i], s.getUDot(), 1e-10,
+                __FILE__, __LINE__,
+                "Presampled external force changed the accelerations.");
+    }
+
+    ASSERT_THROW(OpenSim::Exception,
+            external.presampleAtTimes(std::vector<double>{0.2, 0.1}));
+    external.presampleAtTimes(sampleTimes);
+    external.setDataSource(data);
+    ASSERT(external.getNumPresampledTimes() == 0);
+}
+
+void testWriteRecordValues() {
+    using namespace SimTK;
+    cout << "Running testWriteRecordValues" << endl;
+
+    Model model;
+    auto* body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.1));
+    model.addBody(body);
+    auto* joint = new FreeJoint("free", model.getGround(), *body);
+    model.addJoint(joint);
+
+    auto* spring = new PathSpring("spring", 0.1, 10.0, 0.01);
+    spring->updGeometryPath().appendNewPathPoint(
+            "origin", model.getGround(), Vec3(0, 0.5, 0));
+    spring->updGeometryPath().appendNewPathPoint(
+            "insertion", *body, Vec3(0.1, 0, 0));
+    model.addForce(spring);
+    auto* bushing = new BushingForce("bushing", model.getGround(), *body,
+            Vec3(10), Vec3(20), Vec3(0.1), Vec3(0.2));
+    model.addForce(bushing);
+    auto* actuator = new CoordinateActuator(
+            joint->getCoordinate(FreeJoint::Coord::TranslationY).getName());
+    actuator->setName("actuator");
+    model.addForce(actuator);
+
+    auto* reporter = new ForceReporter(&model);
+    model.addAnalysis(reporter);
+
+    State state = model.initSystem();
+    for (int i = 0; i < state.getNQ(); ++i) state.updQ()[i] = 0.1 * (i + 1);
+    for (int i = 0; i < state.getNU(); ++i) state.updU()[i] = -0.3 * (i + 1);
+    model.realizeDynamics(state);
+
+    // The values written into a buffer match the Array-returning version.
+    for (const auto& force : model.getComponentList<Force>()) {
+        const Array<double> expected = force.getRecordValues(state);
+        std::vector<double> values(force.getRecordLabels().getSize(), NaN);
+        const int n = force.writeRecordValues(state, values.data());
+        ASSERT(n == expected.getSize(), __FILE__, __LINE__,
+                "Wrong number of values written for " + force.getName());
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQUAL(expected[i], values[i], 0.0, __FILE__, __LINE__,
+                    "Wrong value written for " + force.getName());
+        }
+    }
+
+    // The reporter records one row with a column for each value.
+    reporter->begin(state);
+    Storage& store = reporter->updForceStorage();
+    ASSERT(store.getSize() == 1);
+    ASSERT(store.getSmallestNumberOfStates() + 1 ==
+            store.getColumnLabels().getSize());
+    Array<double> springTension;
+    store.getDataColumn("spring_tension", springTension);
+    ASSERT_EQUAL(spring->getTension(state), springTension[0], 1e-12);
+}
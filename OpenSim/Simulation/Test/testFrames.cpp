@@ -31,6 +31,7 @@ Tests Include:
     5. PhysicalOffsetFrame on PhysicalOffsetFrame in non-Multibody tree order
     6. Filtering of Frames by their type
     7. Velocity and acceleration methods
+    8. Kinematics of a chain of PhysicalOffsetFrames and bulk station queries
       
      Add tests here as Frames are added to OpenSim
 
@@ -50,6 +51,7 @@ void testPhysicalOffsetFrameOnPhysicalOffsetFrame();
 void testPhysicalOffsetFrameOnPhysicalOffsetFrameOrder();
 void testFilterByFrameType();
 void testVelocityAndAccelerationMethods();
+void testOffsetFrameChainKinematics();
 
 class OrdinaryOffsetFrame : public OffsetFrame < Frame > {
     OpenSim_DECLARE_CONCRETE_OBJECT(OrdinaryOffsetFrame, OffsetFrame<Frame>);
@@ -107,6 +109,12 @@ int main()
         failures.push_back("testVelocityAndAccelerationMethods");
     }
 
+    try { testOffsetFrameChainKinematics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testOffsetFrameChainKinematics");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -538,3 +546,87 @@ void testVelocityAndAccelerationMethods()
     SimTK_TEST_EQ(rod2.getAccelerationInGround(s)[1],
                   rod2.getLinearAccelerationInGround(s));
 }
+
+void testOffsetFrameChainKinematics()
+{
+    cout << "\nRunning testOffsetFrameChainKinematics" << endl;
+
+    Model pendulum("double_pendulum.osim");
+    const OpenSim::Body& rod2 = pendulum.getBodySet().get("rod2");
+
+    // A chain of offset frames on rod2, each with a different offset.
+    std::vector<PhysicalOffsetFrame*> chain;
+    const PhysicalFrame* parent = &rod2;
+    for (int i = 0; i < 4; ++i) {
+        SimTK::Transform X_PO;
+        X_PO.setP(SimTK::Vec3(0.1*(i + 1), -0.2, 0.05*i));
+        X_PO.updR().setRotationToBodyFixedXYZ(
+                SimTK::Vec3(0.3, -0.2*i, 0.1 + 0.1*i));
+        auto* frame = new PhysicalOffsetFrame(*parent, X_PO);
+        frame->setName("chain" + std::to_string(i));
+        pendulum.addComponent(frame);
+        chain.push_back(frame);
+        parent = frame;
+    }
+
+    SimTK::State& s = pendulum.initSystem();
+    pendulum.getCoordinateSet().get("q1").setValue(s, 0.7);
+    pendulum.getCoordinateSet().get("q2").setValue(s, -0.4);
+    pendulum.getCoordinateSet().get("q1").setSpeedValue(s, 1.5);
+    pendulum.getCoordinateSet().get("q2").setSpeedValue(s, -2.0);
+    pendulum.realizeAcceleration(s);
+
+    // The composed kinematics must match the kinematics obtained by
+    // propagating each offset from its parent.
+    const SimTK::Vec3 tol(1e-12);
+    for (const auto* frame : chain) {
+        const Frame& p = frame->getParentFrame();
+        const SimTK::Transform& X_PO = frame->getOffsetTransform();
+        const SimTK::Transform X_GO = p.getTransformInGround(s)*X_PO;
+        ASSERT_EQUAL(X_GO.p(), frame->getTransformInGround(s).p(), tol,
+            __FILE__, __LINE__,
+            "testOffsetFrameChainKinematics(): incorrect position in ground.");
+        ASSERT_EQUAL(X_GO.R().convertRotationToBodyFixedXYZ(),
+            frame->getTransformInGround(s).R().convertRotationToBodyFixedXYZ(),
+            tol, __FILE__, __LINE__,
+            "testOffsetFrameChainKinematics(): incorrect rotation in ground.");
+
+        const SimTK::Vec3 r = p.getTransformInGround(s).R()*X_PO.p();
+        const SimTK::SpatialVec& V_GP = p.getVelocityInGround(s);
+        const SimTK::SpatialVec& A_GP = p.getAccelerationInGround(s);
+        SimTK_TEST_EQ_TOL(V_GP[0], frame->getAngularVelocityInGround(s), 1e-12);
+        SimTK_TEST_EQ_TOL(V_GP[1] + V_GP[0] % r,
+                frame->getLinearVelocityInGround(s), 1e-12);
+        SimTK_TEST_EQ_TOL(A_GP[0], frame->getAngularAccelerationInGround(s),
+                1e-12);
+        SimTK_TEST_EQ_TOL(A_GP[1] + A_GP[0] % r + V_GP[0] % (V_GP[0] % r),
+                frame->getLinearAccelerationInGround(s), 1e-12);
+    }
+
+    // The bulk station query agrees with the single-station query.
+    const PhysicalOffsetFrame& leaf = *chain.back();
+    SimTK::Vector_<SimTK::Vec3> stations(3);
+    stations[0] = SimTK::Vec3(0.1, 0.2, 0.3);
+    stations[1] = SimTK::Vec3(-0.4, 0.0, 0.25);
+    stations[2] = SimTK::Vec3(0);
+    SimTK::Vector_<SimTK::Vec3> locations;
+    leaf.findStationLocationsInGround(s, stations, locations);
+    ASSERT(locations.size() == stations.size(), __FILE__, __LINE__,
+        "testOffsetFrameChainKinematics(): incorrect number of locations.");
+    for (int i = 0; i < stations.size(); ++i) {
+        SimTK_TEST_EQ(leaf.findStationLocationInGround(s, stations[i]),
+                locations[i]);
+    }
+
+    // Changing an offset in the middle of the chain takes effect in the
+    // frames attached to it once the system is rebuilt.
+    SimTK::Transform X_new = chain[1]->getOffsetTransform();
+    X_new.updP() += SimTK::Vec3(0.5, 0, 0);
+    chain[1]->setOffsetTransform(X_new);
+    SimTK::State& s2 = pendulum.initSystem();
+    const SimTK::Transform X_GL =
+        leaf.getParentFrame().getTransformInGround(s2)*leaf.getOffsetTransform();
+    ASSERT_EQUAL(X_GL.p(), leaf.getTransformInGround(s2).p(), tol,
+        __FILE__, __LINE__,
+        "testOffsetFrameChainKinematics(): offset change was not applied.");
+}
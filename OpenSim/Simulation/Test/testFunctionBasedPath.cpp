@@ -0,0 +1,203 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testFunctionBasedPath.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// testFunctionBasedPath fits polynomial paths to a model with a wrapped
+// PathSpring and checks that the FunctionBasedPath reproduces the lengths,
+// lengthening speeds, moment arms and generalized forces of the original
+// GeometryPath.
+//=============================================================================
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+using namespace OpenSim;
+using namespace SimTK;
+using namespace std;
+
+Model createPulleyModel() {
+    const double r = 0.05;
+    Model model;
+    model.setName("pulley");
+
+    auto* body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.1));
+    model.addBody(body);
+    auto* joint = new PinJoint("pin", model.getGround(), *body);
+    auto& coord = joint->updCoordinate();
+    coord.setName("q");
+    coord.setRangeMin(-0.5 * Pi);
+    coord.setRangeMax(0.5 * Pi);
+    model.addJoint(joint);
+
+    auto* cylinder = new WrapCylinder();
+    cylinder->setName("cylinder");
+    cylinder->set_radius(r);
+    cylinder->set_length(0.1);
+    model.updGround().addWrapObject(cylinder);
+
+    auto* spring = new PathSpring("spring", 0.1, 10.0, 0.01);
+    spring->updGeometryPath().appendNewPathPoint(
+            "origin", model.getGround(), Vec3(-0.2, 0.1, 0));
+    spring->updGeometryPath().appendNewPathPoint(
+            "insertion", *body, Vec3(0.3, 0, 0));
+    spring->updGeometryPath().addPathWrap(*cylinder);
+    model.addForce(spring);
+
+    model.finalizeConnections();
+    return model;
+}
+
+void testPolynomialPathFitter() {
+    Model original = createPulleyModel();
+    Model fitted = createPulleyModel();
+
+    PolynomialPathFitter fitter;
+    fitter.setNumSamples(200);
+    fitter.setMaximumPolynomialOrder(8);
+    const auto results = fitter.fit(fitted);
+    PolynomialPathFitter::printResults(results);
+
+    ASSERT(results.size() == 1, __FILE__, __LINE__,
+            "Expected one fitted path.");
+    ASSERT(results[0].success, __FILE__, __LINE__, results[0].message);
+    ASSERT(results[0].coordinates.size() == 1, __FILE__, __LINE__,
+            "Expected the path to span one coordinate.");
+    ASSERT(results[0].coordinates[0] == "/jointset/pin/q", __FILE__,
+            __LINE__, "Expected the path to span /jointset/pin/q.");
+    ASSERT(results[0].lengthRMSError < 1e-3, __FILE__, __LINE__,
+            "Length RMS error is too large.");
+
+    const auto& spring = fitted.getComponent<PathSpring>("/forceset/spring");
+    ASSERT(dynamic_cast<const FunctionBasedPath*>(
+                   &spring.getGeometryPath()) != nullptr,
+            __FILE__, __LINE__, "Expected the path to be replaced.");
+
+    // The fitted path survives a round trip through a file.
+    fitted.print("testFunctionBasedPath_fitted.osim");
+    Model deserialized("testFunctionBasedPath_fitted.osim");
+    const auto& deserializedSpring =
+            deserialized.getComponent<PathSpring>("/forceset/spring");
+    ASSERT(dynamic_cast<const FunctionBasedPath*>(
+                   &deserializedSpring.getGeometryPath()) != nullptr,
+            __FILE__, __LINE__, "Expected a FunctionBasedPath after reading "
+                                "the model from file.");
+
+    SimTK::State sOrig = original.initSystem();
+    SimTK::State sFit = deserialized.initSystem();
+    const auto& coordOrig = original.getCoordinateSet().get("q");
+    const auto& coordFit = deserialized.getCoordinateSet().get("q");
+    const auto& pathOrig = original.getComponent<PathSpring>(
+            "/forceset/spring").getGeometryPath();
+    const auto& pathFit = deserializedSpring.getGeometryPath();
+
+    for (double q = -0.4 * Pi; q <= 0.4 * Pi; q += 0.1 * Pi) {
+        coordOrig.setValue(sOrig, q);
+        coordOrig.setSpeedValue(sOrig, 1.3);
+        coordFit.setValue(sFit, q);
+        coordFit.setSpeedValue(sFit, 1.3);
+        original.realizeVelocity(sOrig);
+        deserialized.realizeVelocity(sFit);
+
+        ASSERT_EQUAL(pathOrig.getLength(sOrig), pathFit.getLength(sFit),
+                2e-3, __FILE__, __LINE__, "Lengths do not match.");
+        ASSERT_EQUAL(pathOrig.getLengtheningSpeed(sOrig),
+                pathFit.getLengtheningSpeed(sFit), 5e-3, __FILE__, __LINE__,
+                "Lengthening speeds do not match.");
+        const double momentArm = pathFit.computeMomentArm(sFit, coordFit);
+        ASSERT_EQUAL(pathOrig.computeMomentArm(sOrig, coordOrig), momentArm,
+                5e-3, __FILE__, __LINE__, "Moment arms do not match.");
+        ASSERT_EQUAL(-momentArm * 1.3, pathFit.getLengtheningSpeed(sFit),
+                1e-10, __FILE__, __LINE__,
+                "Speed is inconsistent with the moment arm.");
+
+        // The generalized force from a unit tension is the moment arm.
+        deserialized.realizeDynamics(sFit);
+        SimTK::Vector_<SimTK::SpatialVec> bodyForces(
+                deserialized.getMatterSubsystem().getNumBodies(),
+                SimTK::SpatialVec(Vec3(0), Vec3(0)));
+        SimTK::Vector mobilityForces(sFit.getNU(), 0.0);
+        pathFit.addInEquivalentForces(sFit, 1.0, bodyForces, mobilityForces);
+        ASSERT_EQUAL(momentArm, mobilityForces[0], 1e-10, __FILE__, __LINE__,
+                "Generalized force does not match the moment arm.");
+    }
+}
+
+void testPolynomialPathFitterAlongTrajectory() {
+    Model original = createPulleyModel();
+    Model fitted = createPulleyModel();
+
+    // A trajectory in degrees that covers only part of the coordinate range;
+    // the speed column is ignored.
+    TimeSeriesTable trajectory;
+    trajectory.setColumnLabels({"/jointset/pin/q/value", "/jointset/pin/q/speed"});
+    trajectory.addTableMetaData<std::string>("inDegrees", "yes");
+    for (int i = 0; i < 50; ++i) {
+        const double angle = -30 + 50.0 * i / 49;
+        trajectory.appendRow(0.01 * i, {angle, 5.0});
+    }
+
+    PolynomialPathFitter fitter;
+    fitter.setCoordinateTrajectory(trajectory);
+    const auto results = fitter.fit(fitted);
+    ASSERT(results.size() == 1 && results[0].success, __FILE__, __LINE__,
+            "Expected the path to be fitted.");
+    ASSERT(results[0].lengthMaxError < 1e-4, __FILE__, __LINE__,
+            "Length error along the trajectory is too large.");
+
+    SimTK::State sOrig = original.initSystem();
+    SimTK::State sFit = fitted.initSystem();
+    const auto& pathOrig = original.getComponent<PathSpring>(
+            "/forceset/spring").getGeometryPath();
+    const auto& pathFit = fitted.getComponent<PathSpring>(
+            "/forceset/spring").getGeometryPath();
+    for (double angle = -25; angle <= 15; angle += 5) {
+        const double q = angle * SimTK_DEGREE_TO_RADIAN;
+        original.getCoordinateSet().get("q").setValue(sOrig, q);
+        fitted.getCoordinateSet().get("q").setValue(sFit, q);
+        ASSERT_EQUAL(pathOrig.getLength(sOrig), pathFit.getLength(sFit),
+                1e-4, __FILE__, __LINE__, "Lengths do not match.");
+    }
+}
+
+void testFunctionBasedPathRequiresFunction() {
+    Model model = createPulleyModel();
+    auto& spring = model.updComponent<PathSpring>("/forceset/spring");
+    FunctionBasedPath path(spring.getGeometryPath());
+    path.appendCoordinate("/jointset/pin/q");
+    spring.updPropertyByName("GeometryPath").setValueAsObject(path);
+    ASSERT_THROW(InvalidPropertyValue, model.initSystem());
+}
+
+int main() {
+    try {
+        testPolynomialPathFitter();
+        cout << "testPolynomialPathFitter PASSED" << endl;
+        testPolynomialPathFitterAlongTrajectory();
+        cout << "testPolynomialPathFitterAlongTrajectory PASSED" << endl;
+        testFunctionBasedPathRequiresFunction();
+        cout << "testFunctionBasedPathRequiresFunction PASSED" << endl;
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
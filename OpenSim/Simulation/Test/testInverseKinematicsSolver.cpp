@@ -82,6 +82,15 @@ void testUpdateMarkerWeights();
 // Verify that the track() solution is also effected by updating marker
 // weights and marker error is being reduced as its weighting increases.
 void testTrackWithUpdateMarkerWeights();
+// Verify that the solve times of track() are recorded.
+void testTrackingStatistics();
+// Verify that masking a marker (or setting its weight to zero) between calls
+// to track() removes it from the solution without reinitializing the
+// assembler.
+void testTrackWithMaskedMarkers();
+// Verify that the marker locations and squared errors computed in a single
+// pass match those computed separately.
+void testMarkerLocationsAndSquaredErrors();
 
 // Verify that solver does not confuse/mismanage markers when reference
 // has more markers than the model, order is changed or marker reference
@@ -119,6 +128,24 @@ int main()
         failures.push_back("testTrackWithUpdateMarkerWeights");
     }
 
+    try { testTrackingStatistics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackingStatistics");
+    }
+
+    try { testTrackWithMaskedMarkers(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testTrackWithMaskedMarkers");
+    }
+
+    try { testMarkerLocationsAndSquaredErrors(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMarkerLocationsAndSquaredErrors");
+    }
+
     try { testNumberOfMarkersMismatch(); }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -576,6 +603,167 @@ void testTrackWithUpdateMarkerWeights()
     }
 }
 
+void testTrackingStatistics()
+{
+    cout << "\ntestInverseKinematicsSolver::testTrackingStatistics()" << endl;
+
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+    SimTK::State state = pendulum->initSystem();
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    Sine coordRefFunc(0.5, 2.0, 0.0);
+    coordRefs.push_back(CoordinateReference(coord.getName(), coordRefFunc));
+
+    InverseKinematicsSolver ikSolver(*pendulum, nullptr, coordRefs);
+    ikSolver.assemble(state);
+    SimTK_ASSERT_ALWAYS(ikSolver.getTrackingStatistics().numFrames == 0,
+        "InverseKinematicsSolver recorded track() times before tracking.");
+
+    // A zero budget is exceeded by every frame.
+    ikSolver.setTrackingTimeBudget(0);
+    const int numFrames = 50;
+    for (int i = 1; i <= numFrames; ++i) {
+        state.updTime() = 0.01*i;
+        ikSolver.track(state);
+    }
+    auto stats = ikSolver.getTrackingStatistics();
+    cout << "track() times (s): median = " << stats.medianTime
+        << ", p99 = " << stats.p99Time << ", max = " << stats.maxTime << endl;
+    SimTK_ASSERT_ALWAYS(stats.numFrames == numFrames,
+        "InverseKinematicsSolver did not record every track() call.");
+    SimTK_ASSERT_ALWAYS(stats.numOverBudget == numFrames,
+        "InverseKinematicsSolver did not count the frames over budget.");
+    SimTK_ASSERT_ALWAYS(stats.medianTime <= stats.p99Time &&
+                        stats.p99Time <= stats.maxTime &&
+                        stats.meanTime <= stats.maxTime,
+        "InverseKinematicsSolver track() time statistics are inconsistent.");
+
+    // Reassembling starts a new set of statistics.
+    ikSolver.assemble(state);
+    SimTK_ASSERT_ALWAYS(ikSolver.getTrackingStatistics().numFrames == 0,
+        "InverseKinematicsSolver::assemble() did not reset the statistics.");
+}
+
+void testTrackWithMaskedMarkers()
+{
+    cout << "\ntestInverseKinematicsSolver::testTrackWithMaskedMarkers()"
+         << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    const double dt = 0.01;
+    for (int i = 0; i < 60; ++i) {
+        state.updTime() = i*dt;
+        coord.setValue(state, SimTK::Pi / 3);
+        states.append(state);
+    }
+
+    // Only the last marker is biased, so the pendulum angle is exact once
+    // that marker is skipped.
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    biases[2] = SimTK::Vec3(0.05, 0.05, 0);
+    std::shared_ptr<MarkersReference> markersRef(
+            new MarkersReference(generateMarkerDataFromModelAndStates(
+                    *pendulum, states, biases, 0, true),
+                    Set<MarkerWeight>()));
+    for (const auto& name : markersRef->getNames()) {
+        markersRef->updMarkerWeightSet().adoptAndAppend(
+            new MarkerWeight(name, 1.0));
+    }
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    coord.setValue(state, 0.0);
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    ikSolver.setAccuracy(1e-8);
+    ikSolver.assemble(state);
+    const int numInitializations =
+        ikSolver.getAssembler().getNumInitializations();
+
+    SimTK::Array_<double> errors;
+    for (int i = 1; i < 60; ++i) {
+        state.updTime() = i*dt;
+        // Mask, unmask, then drop the marker through its weight.
+        const bool masked = (i >= 20 && i < 40) || i >= 50;
+        if (i < 40) ikSolver.setMarkerMasked(2, masked);
+        else ikSolver.updateMarkerWeight(2, masked ? 0.0 : 1.0);
+        SimTK_ASSERT_ALWAYS(ikSolver.isMarkerMasked(2) == masked,
+            "InverseKinematicsSolver did not update the marker mask.");
+        ikSolver.track(state);
+
+        const double angleError = std::abs(coord.getValue(state) - SimTK::Pi/3);
+        if (masked) {
+            SimTK_ASSERT1_ALWAYS(angleError < 1e-6,
+                "Masked marker still affects the solution (error = %g).",
+                angleError);
+        } else {
+            SimTK_ASSERT1_ALWAYS(angleError > 1e-4,
+                "Unmasked biased marker does not affect the solution "
+                "(error = %g).", angleError);
+        }
+    }
+    SimTK_ASSERT_ALWAYS(ikSolver.getAssembler().getNumInitializations() ==
+                        numInitializations,
+        "Masking markers reinitialized the assembler.");
+
+    ikSolver.clearMarkerMasks();
+    SimTK_ASSERT_ALWAYS(!ikSolver.isMarkerMasked(2),
+        "InverseKinematicsSolver did not clear the marker masks.");
+}
+
+void testMarkerLocationsAndSquaredErrors()
+{
+    cout << "\ntestInverseKinematicsSolver::"
+            "testMarkerLocationsAndSquaredErrors()" << endl;
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+    SimTK::State state = pendulum->initSystem();
+
+    StatesTrajectory states;
+    for (int i = 0; i < 10; ++i) {
+        state.updTime() = 0.01*i;
+        coord.setValue(state, 0.1*i);
+        states.append(state);
+    }
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    biases[1] = SimTK::Vec3(0.02, -0.01, 0.03);
+    std::shared_ptr<MarkersReference> markersRef(
+            new MarkersReference(generateMarkerDataFromModelAndStates(
+                    *pendulum, states, biases, 0, true),
+                    Set<MarkerWeight>()));
+
+    SimTK::Array_<CoordinateReference> coordRefs;
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    state.updTime() = 0;
+    ikSolver.assemble(state);
+
+    SimTK::Array_<SimTK::Vec3> locations, expectedLocations;
+    SimTK::Array_<double> sqErrors, expectedSqErrors;
+    for (int i = 1; i < 10; ++i) {
+        state.updTime() = 0.01*i;
+        ikSolver.track(state);
+        ikSolver.computeCurrentMarkerLocationsAndSquaredErrors(
+                locations, sqErrors);
+        ikSolver.computeCurrentMarkerLocations(expectedLocations);
+        ikSolver.computeCurrentSquaredMarkerErrors(expectedSqErrors);
+        SimTK_ASSERT_ALWAYS(locations.size() == expectedLocations.size() &&
+                            sqErrors.size() == expectedSqErrors.size(),
+            "Marker locations and errors have the wrong size.");
+        double total = 0;
+        for (unsigned j = 0; j < locations.size(); ++j) {
+            SimTK_ASSERT_ALWAYS(
+                (locations[j] - expectedLocations[j]).norm() < 1e-14 &&
+                std::abs(sqErrors[j] - expectedSqErrors[j]) < 1e-14,
+                "Marker locations or errors do not match.");
+            total += sqErrors[j];
+        }
+        SimTK_ASSERT_ALWAYS(total > 0,
+            "Expected a nonzero error from the biased marker.");
+    }
+}
+
 void testNumberOfMarkersMismatch()
 {
     cout << 
@@ -37,6 +37,23 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testManagerEnsemble: Integrate several runs of a pendulum on multiple
+   threads and compare them to serial integrations with a Manager.
+8. testRecordingPolicies: Record states at fixed intervals and on changes of
+   the state variables.
+9. testCheckpointRestore: Resume a simulation from a checkpoint and compare it
+   to an uninterrupted simulation.
+10. testStreamingControls: Stream excitations into a simulation of arm26 that
+    is paced to real time.
+11. testFixedStepping: Advance a pendulum with Manager::step() and compare it
+    to integrating with specified time steps.
+12. testIMEXStepper: Simulate arm26 with implicit muscle states and compare
+    to an accurate simulation with a Manager.
+13. testModelBatch: Advance a batch of pendulums in lockstep and compare them
+    to separate simulations.
+14. testIntegratorAccuracyPolicy: Integrate a pendulum with a tight accuracy
+    during part of the simulation and compare the step counts to a
+    fixed-accuracy simulation.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -44,10 +61,20 @@ Manager Tests:
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Manager/ManagerEnsemble.h>
+#include <OpenSim/Simulation/Manager/IMEXStepper.h>
+#include <OpenSim/Simulation/Manager/ModelBatch.h>
+#include <OpenSim/Simulation/Manager/SimulationCheckpoint.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Simulation/Control/StreamingController.h>
 #include <OpenSim/Common/Constant.h>
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 void testStationCalcWithManager();
@@ -56,6 +83,15 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testManagerEnsemble();
+void testRecordingPolicies();
+void testCheckpointRestore();
+void testStreamingControls();
+void testFixedStepping();
+void testIMEXStepper();
+void testModelBatch();
+void testIntegratorAccuracyPolicy();
+void testIntegrationStatistics();
 
 int main()
 {
@@ -97,6 +133,60 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testManagerEnsemble(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testManagerEnsemble");
+    }
+
+    try { testRecordingPolicies(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRecordingPolicies");
+    }
+
+    try { testCheckpointRestore(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testCheckpointRestore");
+    }
+
+    try { testStreamingControls(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testStreamingControls");
+    }
+
+    try { testFixedStepping(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testFixedStepping");
+    }
+
+    try { testIMEXStepper(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testIMEXStepper");
+    }
+
+    try { testModelBatch(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testModelBatch");
+    }
+
+    try { testIntegratorAccuracyPolicy(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testIntegratorAccuracyPolicy");
+    }
+
+    try { testIntegrationStatistics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testIntegrationStatistics");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +568,615 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testManagerEnsemble()
+{
+    cout << "Running testManagerEnsemble" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(-0.5, 0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State state = model.initSystem();
+    const Coordinate& coord = pin->getCoordinate();
+
+    const double finalTime = 0.5;
+    ManagerEnsemble ensemble(model);
+    ensemble.setNumThreads(3);
+    ensemble.setReportInterval(0.05);
+    ensemble.setIntegratorAccuracy(1e-9);
+    std::vector<SimTK::State> initialStates;
+    for (int i = 0; i < 6; ++i) {
+        coord.setValue(state, -0.2 * i);
+        coord.setSpeedValue(state, 0.1 * i);
+        initialStates.push_back(state);
+        ensemble.addRun(state, finalTime);
+    }
+
+    // Stop once the pendulum falls below the horizontal.
+    auto& haltedRun = ensemble.addRun(initialStates[1], finalTime);
+    haltedRun.haltCondition = [&coord](const SimTK::State& s) {
+        return coord.getValue(s) < -0.4;
+    };
+
+    // Integrate without gravity, so the pendulum rotates at constant speed.
+    auto& modifiedRun = ensemble.addRun(initialStates[2], finalTime);
+    modifiedRun.modelModifier = [](Model& m) { m.setGravity(Vec3(0)); };
+
+    // An initial state from another model makes only its own run fail.
+    Model ball;
+    auto ballBody = new Body("ball", 1., Vec3(0), SimTK::Inertia(0.1));
+    ball.addBody(ballBody);
+    ball.addJoint(new FreeJoint("free", ball.getGround(), *ballBody));
+    ensemble.addRun(ball.initSystem(), finalTime);
+
+    const auto results = ensemble.integrate();
+    ASSERT(results.size() == 9, __FILE__, __LINE__,
+            "Expected a result for each run.");
+
+    for (int i = 0; i < 6; ++i) {
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-9);
+        manager.initialize(initialStates[i]);
+        const SimTK::State& expected = manager.integrate(finalTime);
+
+        ASSERT(results[i].success, __FILE__, __LINE__,
+                results[i].errorMessage);
+        ASSERT(!results[i].halted, __FILE__, __LINE__,
+                "Expected the run to reach the final time.");
+        ASSERT_EQUAL(finalTime, results[i].finalState.getTime(), 1e-12,
+                __FILE__, __LINE__, "Final time does not match.");
+        ASSERT_EQUAL(coord.getValue(expected),
+                coord.getValue(results[i].finalState), 1e-6, __FILE__,
+                __LINE__, "Final coordinate values do not match.");
+        ASSERT_EQUAL(coord.getSpeedValue(expected),
+                coord.getSpeedValue(results[i].finalState), 1e-6, __FILE__,
+                __LINE__, "Final coordinate speeds do not match.");
+        // The initial state and one state per report interval.
+        ASSERT(results[i].trajectory.getSize() == 11, __FILE__, __LINE__,
+                "Expected 11 states in the trajectory.");
+        // The results can be used with the original model.
+        model.realizePosition(results[i].trajectory.back());
+    }
+
+    ASSERT(results[6].success && results[6].halted, __FILE__, __LINE__,
+            "Expected the run to be halted.");
+    ASSERT(coord.getValue(results[6].finalState) < -0.4, __FILE__, __LINE__,
+            "Expected the run to halt after its halt condition was met.");
+    ASSERT(results[6].finalState.getTime() < finalTime, __FILE__, __LINE__,
+            "Expected the halted run to stop before the final time.");
+
+    ASSERT(results[7].success, __FILE__, __LINE__, results[7].errorMessage);
+    ASSERT_EQUAL(coord.getValue(initialStates[2]) +
+                         finalTime * coord.getSpeedValue(initialStates[2]),
+            coord.getValue(results[7].finalState), 1e-6, __FILE__, __LINE__,
+            "Expected the model modifier to remove gravity.");
+
+    ASSERT(!results[8].success && !results[8].errorMessage.empty(), __FILE__,
+            __LINE__, "Expected the run with an inconsistent state to fail.");
+
+    // A halt condition requires a report interval.
+    ensemble.setReportInterval(0);
+    ASSERT_THROW(OpenSim::Exception, ensemble.integrate());
+}
+
+void testRecordingPolicies()
+{
+    cout << "Running testRecordingPolicies" << endl;
+
+    using SimTK::Vec3;
+
+    // A pendulum.
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1.0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State initState = model.initSystem();
+    pin->getCoordinate().setValue(initState, 0.5);
+    const double finalTime = 1.0;
+
+    auto simulate = [&](Manager::RecordingPolicy policy, double setting) {
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-8);
+        manager.setRecordingPolicy(policy);
+        if (policy == Manager::RecordingPolicy::FixedInterval) {
+            manager.setRecordingInterval(setting);
+        } else if (policy == Manager::RecordingPolicy::StateChange) {
+            manager.setRecordingStateChangeThreshold(setting);
+        }
+        SimTK::State state(initState);
+        manager.initialize(state);
+        manager.integrate(finalTime);
+        return manager.getStatesTable();
+    };
+
+    const auto everyStep = simulate(Manager::RecordingPolicy::EveryStep, 0);
+
+    // Fixed interval: the initial state, 9 interpolated states and the final
+    // state.
+    {
+        const auto table =
+                simulate(Manager::RecordingPolicy::FixedInterval, 0.1);
+        const auto& times = table.getIndependentColumn();
+        ASSERT(times.size() == 11, __FILE__, __LINE__,
+                "Expected 11 recorded states, but got " +
+                std::to_string(times.size()) + ".");
+        for (int i = 0; i < (int)times.size(); ++i) {
+            ASSERT_EQUAL(0.1 * i, times[i], 1e-10);
+        }
+        ASSERT(times.size() < everyStep.getNumRows());
+        // The interpolated states are accurate, and the final state matches
+        // the final state of the simulation that records every step.
+        const auto& q = table.getDependentColumnAtIndex(0);
+        const auto& qEvery = everyStep.getDependentColumnAtIndex(0);
+        ASSERT_EQUAL(qEvery[qEvery.size() - 1], q[q.size() - 1], 1e-6);
+        ASSERT_EQUAL(0.5, q[0], 1e-10);
+    }
+
+    // State change: consecutive recorded states differ by more than the
+    // threshold in at least one state variable.
+    {
+        const double threshold = 0.05;
+        const auto table =
+                simulate(Manager::RecordingPolicy::StateChange, threshold);
+        const int numRows = (int)table.getNumRows();
+        ASSERT(numRows > 2 && numRows < (int)everyStep.getNumRows(),
+                __FILE__, __LINE__,
+                "Expected fewer recorded states than when recording every "
+                "step.");
+        const auto& matrix = table.getMatrix();
+        for (int i = 1; i < numRows - 1; ++i) {
+            double maxChange = 0;
+            for (int j = 0; j < matrix.ncol(); ++j) {
+                maxChange = std::max(maxChange,
+                        std::abs(matrix(i, j) - matrix(i - 1, j)));
+            }
+            ASSERT(maxChange > threshold);
+        }
+    }
+
+    // Invalid settings.
+    {
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::FixedInterval);
+        manager.initialize(initState);
+        ASSERT_THROW(Exception, manager.integrate(finalTime));
+    }
+    {
+        Manager manager(model);
+        manager.setUseConstantDT(true);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::StateChange);
+        manager.setRecordingStateChangeThreshold(0.1);
+        manager.initialize(initState);
+        ASSERT_THROW(Exception, manager.integrate(finalTime));
+    }
+}
+
+void testCheckpointRestore()
+{
+    cout << "Running testCheckpointRestore" << endl;
+
+    using SimTK::Vec3;
+
+    // A pendulum.
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1.0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State initState = model.initSystem();
+    pin->getCoordinate().setValue(initState, 0.5);
+    const double finalTime = 1.0;
+    const std::string fileName = "testManager_checkpoint.ckpt";
+
+    // Uninterrupted simulation.
+    SimTK::State finalState;
+    {
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-8);
+        manager.initialize(initState);
+        finalState = manager.integrate(finalTime);
+    }
+
+    // A simulation that is "terminated" at 0.6 s; the last checkpoint was
+    // written shortly after 0.5 s.
+    {
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-8);
+        manager.setCheckpointFile(fileName);
+        manager.setCheckpointInterval(0.25);
+        manager.initialize(initState);
+        manager.integrate(0.6);
+    }
+
+    auto checkpoint = SimulationCheckpoint::read(fileName);
+    ASSERT(checkpoint.getTime() >= 0.5 && checkpoint.getTime() < 0.6,
+            __FILE__, __LINE__, "Unexpected checkpoint time.");
+    ASSERT(SimTK::isFinite(checkpoint.getStepSize()));
+    ASSERT(checkpoint.hasStatesStorage());
+
+    // Resume from the checkpoint.
+    Manager manager(model);
+    manager.setIntegratorAccuracy(1e-8);
+    SimTK::State state = model.initSystem();
+    manager.initializeFromCheckpoint(fileName, state);
+    ASSERT_EQUAL(checkpoint.getTime(), state.getTime(), 0.0);
+    const SimTK::State& resumedState = manager.integrate(finalTime);
+    ASSERT_EQUAL(finalTime, resumedState.getTime(), 1e-12);
+    for (int i = 0; i < finalState.getNY(); ++i) {
+        ASSERT_EQUAL(finalState.getY()[i], resumedState.getY()[i], 1e-5);
+    }
+
+    // The states recorded before the checkpoint are restored, in order.
+    const auto table = manager.getStatesTable();
+    const auto& times = table.getIndependentColumn();
+    ASSERT_EQUAL(0.0, times.front(), 0.0);
+    ASSERT_EQUAL(finalTime, times.back(), 1e-12);
+    ASSERT(std::is_sorted(times.begin(), times.end()));
+    ASSERT(std::adjacent_find(times.begin(), times.end()) == times.end(),
+            __FILE__, __LINE__, "Expected no duplicate times.");
+    ASSERT(std::find(times.begin(), times.end(), checkpoint.getTime()) !=
+            times.end());
+
+    // A checkpoint does not fit a model with different states.
+    Model other;
+    auto otherBody = new Body("b", 1., Vec3(0), SimTK::Inertia(0.1));
+    other.addBody(otherBody);
+    other.addJoint(new FreeJoint("free", other.getGround(), *otherBody));
+    SimTK::State otherState = other.initSystem();
+    ASSERT_THROW(Exception, checkpoint.applyTo(otherState));
+    ASSERT_THROW(Exception, SimulationCheckpoint::read("nonexistent.ckpt"));
+}
+
+void testStreamingControls()
+{
+    cout << "Running testStreamingControls" << endl;
+    LoadOpenSimLibrary("osimActuators");
+    Model arm("arm26.osim");
+    const Muscle& muscle = arm.getMuscles().get(0);
+    auto* controller = new StreamingController();
+    controller->addActuator(muscle);
+    arm.addController(controller);
+    SimTK::State state = arm.initSystem();
+
+    ASSERT_THROW(Exception, controller->pushControls(0, SimTK::Vector(2, 0.)));
+    SimTK_TEST(controller->pushControls(0.0, SimTK::Vector(1, 0.3)));
+    SimTK_TEST(controller->pushControls(0.1, SimTK::Vector(1, 0.7)));
+    auto excitationAt = [&](double time) {
+        state.setTime(time);
+        arm.realizeDynamics(state);
+        return muscle.getExcitation(state);
+    };
+    SimTK_TEST_EQ(0.3, excitationAt(0.05));
+    SimTK_TEST_EQ(0.7, excitationAt(0.2));
+    controller->set_interpolation("linear");
+    SimTK_TEST_EQ(0.5, excitationAt(0.05));
+    controller->set_interpolation("latest");
+    SimTK_TEST_EQ(0.7, excitationAt(0.0));
+
+    // The buffer holds at most buffer_size unconsumed samples.
+    controller->set_interpolation("hold");
+    controller->set_buffer_size(2);
+    state = arm.initSystem();
+    SimTK_TEST(controller->pushControls(0.0, SimTK::Vector(1, 0.1)));
+    SimTK_TEST(controller->pushControls(0.1, SimTK::Vector(1, 0.2)));
+    SimTK_TEST(!controller->pushControls(0.2, SimTK::Vector(1, 0.3)));
+    SimTK_TEST(controller->getNumDroppedSamples() == 1);
+
+    // Stream samples from another thread into a simulation that is paced to
+    // real time.
+    controller->set_buffer_size(1024);
+    state = arm.initSystem();
+    const double finalTime = 0.2;
+    std::thread producer([&]() {
+        for (int i = 0; i <= 20; ++i) {
+            controller->pushControls(0.01 * i, SimTK::Vector(1, 0.01 * i));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+    Manager manager(arm);
+    manager.setRealTimeFactor(1.0);
+    manager.setIntegratorMaximumStepSize(0.005);
+    manager.initialize(state);
+    const auto start = std::chrono::steady_clock::now();
+    state = manager.integrate(finalTime);
+    const double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    producer.join();
+    cout << "Paced simulation took " << elapsed << " s with "
+         << manager.getNumRealTimeOverruns() << " overruns." << endl;
+    SimTK_TEST(elapsed >= finalTime);
+    SimTK_TEST(controller->getNumDroppedSamples() == 0);
+    arm.realizeDynamics(state);
+    const double excitation = muscle.getExcitation(state);
+    SimTK_TEST(excitation <= 0.2);
+
+    ASSERT_THROW(Exception, manager.setRealTimeFactor(-1));
+}
+
+void testFixedStepping()
+{
+    cout << "Running testFixedStepping" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1.0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State initState = model.initSystem();
+    pin->getCoordinate().setValue(initState, 0.5);
+    const double dt = 0.001;
+
+    // Reference: integrate() with specified time steps.
+    SimTK::State reference;
+    {
+        Manager manager(model);
+        manager.setIntegratorMethod(Manager::IntegratorMethod::RungeKutta2);
+        manager.setUseSpecifiedDT(true);
+        manager.setDTArray(SimTK::Vector(500, dt));
+        manager.initialize(initState);
+        reference = manager.integrate(0.5);
+    }
+
+    Manager manager(model);
+    manager.setIntegratorMethod(Manager::IntegratorMethod::RungeKutta2);
+    ASSERT_THROW(Exception, manager.step(dt));
+    manager.initialize(initState);
+    ASSERT_THROW(Exception, manager.step(0));
+    ASSERT_THROW(Exception, manager.step(dt, 0));
+    for (int i = 0; i < 500; ++i) manager.step(dt);
+    const SimTK::State& state = manager.getState();
+    SimTK_TEST_EQ(0.5, state.getTime());
+    SimTK_TEST_EQ_TOL(reference.getQ(), state.getQ(), 1e-10);
+    SimTK_TEST_EQ_TOL(reference.getU(), state.getU(), 1e-10);
+
+    const auto& stats = manager.getStepStatistics();
+    SimTK_TEST(stats.numSteps == 500);
+    SimTK_TEST(stats.numIncompleteSteps == 0);
+    SimTK_TEST(stats.maxWallTime >= stats.meanWallTime);
+    SimTK_TEST(stats.meanWallTime > 0);
+    cout << "Mean wall time per step: " << stats.meanWallTime << " s" << endl;
+
+    // Substeps that exceed the limit leave the step incomplete.
+    manager.resetStepStatistics();
+    manager.setMaximumSubsteps(2);
+    manager.step(dt, 4);
+    SimTK_TEST(manager.getStepStatistics().numIncompleteSteps == 1);
+    SimTK_TEST(manager.getState().getTime() < 0.5 + dt);
+    ASSERT_THROW(Exception, manager.setMaximumSubsteps(-1));
+}
+
+void testIMEXStepper()
+{
+    cout << "Running testIMEXStepper" << endl;
+    LoadOpenSimLibrary("osimActuators");
+    Model arm("arm26.osim");
+    SimTK::State initState = arm.initSystem();
+    arm.equilibrateMuscles(initState);
+    const double finalTime = 0.1;
+
+    SimTK::State reference;
+    {
+        Manager manager(arm);
+        manager.setIntegratorAccuracy(1e-8);
+        manager.initialize(initState);
+        reference = manager.integrate(finalTime);
+    }
+
+    IMEXStepper stepper(arm);
+    ASSERT_THROW(Exception, stepper.step());
+    ASSERT_THROW(Exception, stepper.setStepSize(0));
+    stepper.setStepSize(1e-3);
+    stepper.initialize(initState);
+    const SimTK::State& state = stepper.integrate(finalTime);
+    SimTK_TEST_EQ(finalTime, state.getTime());
+
+    const auto& stats = stepper.getStatistics();
+    cout << "IMEXStepper: " << stats.numSteps << " steps, "
+         << stats.numNewtonIterations << " Newton iterations, "
+         << stats.numJacobianEvaluations << " Jacobian evaluations." << endl;
+    SimTK_TEST(stats.numSteps == 100);
+    SimTK_TEST(stats.numNonconvergedSteps == 0);
+    // Each muscle has an activation and a fiber length, so the Jacobian
+    // needs two evaluations per step regardless of the number of muscles.
+    SimTK_TEST(stats.numJacobianEvaluations == 2 * stats.numSteps);
+    SimTK_TEST(stepper.getStatesTrajectory().getSize() == 101);
+
+    SimTK::State finalState = state;
+    arm.realizeDynamics(reference);
+    arm.realizeDynamics(finalState);
+    SimTK_TEST_EQ_TOL(reference.getQ(), finalState.getQ(), 5e-3);
+    for (const auto& muscle : arm.getComponentList<Muscle>()) {
+        SimTK_TEST_EQ_TOL(muscle.getActivation(reference),
+                muscle.getActivation(finalState), 5e-3);
+    }
+}
+
+void testModelBatch()
+{
+    cout << "Running testModelBatch" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1.0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State state = model.initSystem();
+    const auto& coord = pin->getCoordinate();
+
+    const int numInstances = 7;
+    ModelBatch batch(model, numInstances, 3);
+    SimTK_TEST(batch.getNumInstances() == numInstances);
+    SimTK_TEST(batch.getNumStateVariables() == 2);
+    for (int i = 0; i < numInstances; ++i) {
+        coord.setValue(state, 0.1 * i);
+        batch.setState(i, state);
+    }
+    for (int k = 0; k < 200; ++k) batch.step(0.005);
+    SimTK_TEST_EQ(1.0, batch.getTime());
+
+    for (int i = 0; i < numInstances; i += 3) {
+        coord.setValue(state, 0.1 * i);
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-10);
+        manager.initialize(state);
+        const SimTK::State& expected = manager.integrate(1.0);
+        const SimTK::State actual = batch.getState(i);
+        SimTK_TEST_EQ(expected.getTime(), actual.getTime());
+        SimTK_TEST_EQ_TOL(expected.getY(), actual.getY(), 1e-6);
+    }
+
+    ASSERT_THROW(Exception, batch.setControls(SimTK::Matrix(numInstances, 1)));
+    ASSERT_THROW(Exception, batch.step(0));
+    ASSERT_THROW(IndexOutOfRange, batch.getState(numInstances));
+}
+
+void testIntegratorAccuracyPolicy()
+{
+    cout << "Running testIntegratorAccuracyPolicy" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1.0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State initState = model.initSystem();
+    pin->getCoordinate().setValue(initState, 1.0);
+    const double finalTime = 2.0;
+
+    // Fixed, tight accuracy.
+    SimTK::State reference;
+    int numStepsReference;
+    {
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-8);
+        manager.initialize(initState);
+        reference = manager.integrate(finalTime);
+        numStepsReference = manager.getIntegrator().getNumStepsTaken();
+    }
+
+    // Tight accuracy only in the first half; the predicate is a state
+    // predicate on the pendulum's angle in the second phase.
+    IntegratorAccuracyPolicy policy(1e-4);
+    policy.addPhase("start",
+            IntegratorAccuracyPolicy::isTimeInInterval(0, 0.5), 1e-8);
+    const auto& coord = pin->getCoordinate();
+    policy.addPhase("bottom", [&coord](const SimTK::State& s) {
+                return std::abs(coord.getValue(s)) < 0.1;
+            }, 1e-8);
+    policy.setCompareWithFixedAccuracy(true);
+    ASSERT_THROW(Exception, policy.addPhase("bad",
+            IntegratorAccuracyPolicy::isTimeInInterval(0, 1), 0));
+    ASSERT_THROW(Exception, policy.getAccuracy(2));
+    SimTK_TEST(policy.getTightestAccuracy() == 1e-8);
+
+    Manager manager(model);
+    manager.setIntegratorAccuracyPolicy(policy);
+    manager.initialize(initState);
+    const SimTK::State& state = manager.integrate(finalTime);
+    SimTK_TEST_EQ(finalTime, state.getTime());
+    SimTK_TEST_EQ_TOL(reference.getQ(), state.getQ(), 1e-2);
+
+    const auto& stats = manager.getIntegratorAccuracyPolicyStatistics();
+    SimTK_TEST(stats.phaseNames.size() == 3);
+    SimTK_TEST(stats.numStepsPerPhase[0] > 0);
+    SimTK_TEST(stats.numStepsPerPhase[1] > 0);
+    SimTK_TEST(stats.numPhaseChanges >= 2);
+    SimTK_TEST(stats.numSteps == stats.numStepsPerPhase[0] +
+                                 stats.numStepsPerPhase[1] +
+                                 stats.numStepsPerPhase[2]);
+    SimTK_TEST(stats.numSteps == manager.getIntegrator().getNumStepsTaken());
+    // The comparison run uses the same settings as the reference.
+    SimTK_TEST(std::abs(stats.numStepsFixedAccuracy - numStepsReference) <= 2);
+    SimTK_TEST(stats.getNumStepsSaved() > 0);
+    cout << "Steps saved by the accuracy policy: " << stats.getNumStepsSaved()
+         << " of " << stats.numStepsFixedAccuracy << endl;
+
+    // The policy cannot be used with fixed steps.
+    Manager fixedManager(model);
+    fixedManager.setIntegratorAccuracyPolicy(policy);
+    SimTK_TEST(fixedManager.hasIntegratorAccuracyPolicy());
+    fixedManager.setUseSpecifiedDT(true);
+    fixedManager.setDTArray(SimTK::Vector(100, 0.01));
+    fixedManager.initialize(initState);
+    ASSERT_THROW(Exception, fixedManager.integrate(0.5));
+}
+
+void testIntegrationStatistics()
+{
+    cout << "Running testIntegrationStatistics" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto body = new Body("body", 1., Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0, 1.0, 0), Vec3(0));
+    model.addJoint(pin);
+    SimTK::State initState = model.initSystem();
+    pin->getCoordinate().setValue(initState, 0.5);
+
+    for (auto method : {Manager::IntegratorMethod::RungeKuttaMerson,
+                 Manager::IntegratorMethod::Verlet,
+                 Manager::IntegratorMethod::SemiExplicitEuler2}) {
+        Manager manager(model);
+        manager.setIntegratorMethod(method);
+        ASSERT_THROW(Exception, manager.getIntegrationStatistics());
+        manager.initialize(initState);
+
+        // Nothing has been integrated yet.
+        auto stats = manager.getIntegrationStatistics();
+        SimTK_TEST(stats.numStepsTaken == 0);
+        SimTK_TEST(stats.integrationWallTime == 0);
+
+        manager.integrate(0.5);
+        stats = manager.getIntegrationStatistics();
+        SimTK_TEST(stats.numStepsTaken > 0);
+        SimTK_TEST(stats.numStepsAttempted >= stats.numStepsTaken);
+        SimTK_TEST(stats.numRealizationsOfStage.size() ==
+                   (size_t)SimTK::Stage::NValid);
+        SimTK_TEST(stats.numRealizationsOfStage[SimTK::Stage::Acceleration] >=
+                   stats.numStepsTaken);
+        SimTK_TEST(stats.numRealizationsOfStage[SimTK::Stage::Topology] == 0);
+        SimTK_TEST(stats.integrationWallTime > 0);
+        SimTK_TEST(stats.recordingWallTime > 0);
+        // One state is recorded per step (plus the initial and final states).
+        SimTK_TEST(manager.getStateStorage().getSize() >=
+                   stats.numStepsTaken);
+
+        const std::string fileName = "testManager_integration_statistics.txt";
+        manager.writeIntegrationStatistics(fileName);
+        std::ifstream file(fileName);
+        std::string contents((std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>());
+        SimTK_TEST(contents.find("num_steps_taken: " +
+                           std::to_string(stats.numStepsTaken)) !=
+                   std::string::npos);
+        SimTK_TEST(contents.find("num_realizations_acceleration: ") !=
+                   std::string::npos);
+    }
+}
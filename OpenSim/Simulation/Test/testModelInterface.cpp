@@ -22,9 +22,16 @@
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/ModelCache.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Common/ComponentPhaseProfiler.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/FileAdapter.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
 using namespace OpenSim;
@@ -32,6 +39,10 @@ using namespace std;
 
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
+void testCloneWithSystem();
+void testInitSystemProfilerAndPathLookup();
+void testModelCache();
+void testRealizeProfiler();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -39,6 +50,10 @@ int main() {
     SimTK_START_TEST("testModelInterface");
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
+        SimTK_SUBTEST(testCloneWithSystem);
+        SimTK_SUBTEST(testInitSystemProfilerAndPathLookup);
+        SimTK_SUBTEST(testModelCache);
+        SimTK_SUBTEST(testRealizeProfiler);
     SimTK_END_TEST();
 }
 
@@ -227,3 +242,240 @@ void testModelTopologyErrors()
 
     ASSERT_THROW(JointFramesHaveSameBaseFrame, degenerate.initSystem());
 }
+
+void testCloneWithSystem()
+{
+    Model model("arm26.osim");
+    SimTK::State& state = model.initSystem();
+    const Coordinate& elbow = model.getCoordinateSet().get("r_elbow_flex");
+    const Coordinate& shoulder = model.getCoordinateSet().get("r_shoulder_elev");
+    elbow.setValue(state, 0.7);
+    elbow.setSpeedValue(state, -0.3);
+    shoulder.setLocked(state, true);
+    const Muscle& muscle = model.getMuscles().get("BIClong");
+    muscle.setActivation(state, 0.4);
+
+    std::unique_ptr<Model> copy(model.cloneWithSystem());
+    SimTK::State& copyState = copy->updWorkingState();
+    ASSERT(copyState.getNY() == state.getNY());
+    ASSERT_EQUAL<double>(state.getTime(), copyState.getTime(), 0);
+    for (int i = 0; i < state.getNY(); ++i) {
+        ASSERT_EQUAL<double>(state.getY()[i], copyState.getY()[i], 0);
+    }
+    const Coordinate& copyShoulder =
+            copy->getCoordinateSet().get("r_shoulder_elev");
+    ASSERT(copyShoulder.getLocked(copyState));
+
+    model.realizeDynamics(state);
+    copy->realizeDynamics(copyState);
+    const Muscle& copyMuscle = copy->getMuscles().get("BIClong");
+    ASSERT_EQUAL(muscle.getLength(state), copyMuscle.getLength(copyState),
+            1e-12);
+    ASSERT_EQUAL(muscle.getActuation(state),
+            copyMuscle.getActuation(copyState), 1e-10);
+
+    // The copy simulates the same motion as the original.
+    Manager manager(model, state);
+    const SimTK::State& finalState = manager.integrate(0.05);
+    Manager copyManager(*copy, copyState);
+    const SimTK::State& copyFinalState = copyManager.integrate(0.05);
+    ASSERT_EQUAL(elbow.getValue(finalState),
+            copy->getCoordinateSet().get("r_elbow_flex").getValue(
+                    copyFinalState),
+            1e-10);
+    ASSERT_EQUAL(shoulder.getValue(finalState),
+            copyShoulder.getValue(copyFinalState), 1e-10);
+
+    // A copy of a model without a System is initialized as by initSystem().
+    Model uninitialized("arm26.osim");
+    std::unique_ptr<Model> copy2(uninitialized.cloneWithSystem());
+    ASSERT(copy2->isValidSystem());
+}
+
+void testInitSystemProfilerAndPathLookup()
+{
+    using SimTK::Vec3;
+
+    // A chain of bodies, so that the BodySet and JointSet are indexed by name.
+    Model model;
+    const PhysicalFrame* parent = &model.getGround();
+    for (int i = 0; i < 20; ++i) {
+        auto* body = new OpenSim::Body("body" + std::to_string(i), 1.0,
+                Vec3(0), SimTK::Inertia(0.1));
+        model.addBody(body);
+        model.addJoint(new PinJoint("pin" + std::to_string(i), *parent,
+                Vec3(0), Vec3(0), *body, Vec3(0.1, 0, 0), Vec3(0)));
+        parent = body;
+    }
+
+    ComponentPhaseProfiler profiler;
+    profiler.start();
+    ASSERT(profiler.isActive());
+    model.initSystem();
+    profiler.stop();
+    ASSERT(!profiler.isActive());
+
+    bool foundPinJoint = false;
+    for (const auto& entry : profiler.getEntries()) {
+        if (entry.phase == ComponentPhaseProfiler::Phase::AddToSystem &&
+                entry.className == "PinJoint") {
+            foundPinJoint = true;
+            ASSERT(entry.count == 20);
+        }
+        ASSERT(entry.seconds >= 0);
+    }
+    ASSERT(foundPinJoint);
+    using Phase = ComponentPhaseProfiler::Phase;
+    for (Phase phase : {Phase::FinalizeFromProperties,
+                 Phase::FinalizeConnections, Phase::AddToSystem,
+                 Phase::InitStateFromProperties}) {
+        ASSERT(profiler.getTotalSeconds(phase) > 0);
+    }
+    // Only one profiler may be active on a thread.
+    profiler.start();
+    ComponentPhaseProfiler other;
+    ASSERT_THROW(OpenSim::Exception, other.start());
+    profiler.stop();
+
+    model.setProfileInitSystem(true);
+    model.initSystem();
+
+    // Paths resolve through the index, and renamed components are still
+    // found by their new names (but not by their old names).
+    ASSERT(&model.getComponent<OpenSim::Body>("/bodyset/body13") ==
+            &model.getBodySet().get("body13"));
+    ASSERT(&model.getComponent<PinJoint>("bodyset/body13/../../jointset/pin7")
+            == &model.getJointSet().get("pin7"));
+    ASSERT(!model.hasComponent("/bodyset/body20"));
+    model.updBodySet().get("body5").setName("renamed");
+    ASSERT(model.hasComponent<OpenSim::Body>("/bodyset/renamed"));
+    ASSERT(!model.hasComponent("/bodyset/body5"));
+}
+
+void testModelCache()
+{
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("cached");
+    auto* body = new OpenSim::Body("body", 1.0, Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    model.addJoint(new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0), Vec3(0)));
+    model.print("testModelCache.osim");
+
+    ModelCache::clear();
+    auto first = ModelCache::load("testModelCache.osim");
+    ASSERT(ModelCache::getSize() == 1);
+    ASSERT(first->getName() == "cached");
+    ASSERT(first->getInputFileName() == "testModelCache.osim");
+
+    // Copies are independent of the cache.
+    first->setName("modified");
+    first->updBodySet().get("body").setMass(2.0);
+    auto second = ModelCache::load("testModelCache.osim");
+    ASSERT(ModelCache::getSize() == 1);
+    ASSERT(second->getName() == "cached");
+    ASSERT_EQUAL(1.0, second->getBodySet().get("body").getMass(), 0.0);
+    second->initSystem();
+
+    // A changed file replaces the stale entry.
+    model.updBodySet().get("body").setMass(3.0);
+    model.print("testModelCache.osim");
+    auto third = ModelCache::load("testModelCache.osim");
+    ASSERT(ModelCache::getSize() == 1);
+    ASSERT_EQUAL(3.0, third->getBodySet().get("body").getMass(), 0.0);
+
+    ModelCache::clear();
+    ASSERT(ModelCache::getSize() == 0);
+    ASSERT_THROW(FileDoesNotExist,
+            ModelCache::load("testModelCache_doesNotExist.osim"));
+}
+
+void testRealizeProfiler()
+{
+    using SimTK::Vec3;
+
+    Model model;
+    model.setName("profiled");
+    auto* body = new OpenSim::Body("body", 1.0, Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto* pin = new PinJoint("pin", model.getGround(), Vec3(0), Vec3(0),
+            *body, Vec3(0), Vec3(0));
+    model.addJoint(pin);
+    auto* actuator = new CoordinateActuator();
+    actuator->setName("actu");
+    actuator->setCoordinate(&pin->updCoordinate());
+    model.addForce(actuator);
+    auto* controller = new PrescribedController();
+    controller->setName("controller");
+    controller->addActuator(*actuator);
+    controller->prescribeControlForActuator("actu", new Constant(1.0));
+    model.addController(controller);
+
+    ASSERT(!model.getProfileRealize());
+    ASSERT_THROW(OpenSim::Exception, model.getRealizeProfiler());
+    model.setProfileRealize(true);
+    SimTK::State state = model.initSystem();
+    for (int i = 0; i < 5; ++i) {
+        state.setTime(0.1 * i);
+        model.realizeAcceleration(state);
+    }
+
+    using Section = ComponentRealizeProfiler::Section;
+    const auto& profiler = model.getRealizeProfiler();
+    bool foundForce = false;
+    bool foundControls = false;
+    long long numForceCalls = 0;
+    for (const auto& entry : profiler.getEntries()) {
+        if (entry.path == "/forceset/actu" &&
+                entry.section == Section::ComputeForce) {
+            foundForce = true;
+            // initSystem() may also compute the forces.
+            numForceCalls = entry.count;
+            ASSERT(numForceCalls >= 5);
+            ASSERT(entry.className == "CoordinateActuator");
+        }
+        if (entry.path == "/controllerset/controller" &&
+                entry.section == Section::ComputeControls) {
+            foundControls = true;
+        }
+        ASSERT(entry.seconds >= 0);
+    }
+    ASSERT(foundForce && foundControls);
+    ASSERT(profiler.getTotalSeconds(Section::ComputeForce) > 0);
+
+    // Entries by class sum over the components of that class.
+    bool foundPinJoint = false;
+    for (const auto& entry : profiler.getEntriesByClass()) {
+        ASSERT(entry.path.empty());
+        if (entry.className == "PinJoint") foundPinJoint = true;
+    }
+    ASSERT(foundPinJoint);
+
+    const TimeSeriesTable table = profiler.getAsTable();
+    ASSERT(table.getNumRows() == 2);
+    ASSERT(table.getNumColumns() == profiler.getEntries().size());
+    ASSERT_EQUAL((double)numForceCalls,
+            table.getDependentColumn("/forceset/actu:computeForce")[0], 0.0);
+    const std::string stacks = profiler.getFoldedStacks();
+    ASSERT(stacks.find("profiled;forceset;actu;computeForce ") !=
+            std::string::npos);
+
+    // A copy is not profiled, and calls on the copy are not recorded.
+    Model copy(model);
+    ASSERT(!copy.getProfileRealize());
+    SimTK::State copyState = copy.initSystem();
+    copy.realizeAcceleration(copyState);
+    for (const auto& entry : profiler.getEntries()) {
+        if (entry.path == "/forceset/actu" &&
+                entry.section == Section::ComputeForce) {
+            ASSERT(entry.count == numForceCalls);
+        }
+    }
+
+    model.updRealizeProfiler().clear();
+    ASSERT(model.getRealizeProfiler().getEntries().empty());
+    model.setProfileRealize(false);
+    ASSERT(!model.getProfileRealize());
+}
@@ -56,6 +56,10 @@ void testMomentArmDefinitionForModel(const string &filename,
 
 void testMomentArmsAcrossCompoundJoint();
 
+void testMomentArmMatrix(const string& filename);
+
+void testPathReuse(const string& filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -67,6 +71,15 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testMomentArmMatrix("testMomentArmsConstraintB.osim");
+        testMomentArmMatrix("gait2354_simbody.osim");
+        cout << "Batched moment-arm matrix: PASSED\n" << endl;
+
+        testPathReuse("gait2354_simbody.osim");
+        testPathReuse("WrapPathCustomJointMomentArmTest.osim");
+        cout << "Reusing paths when their coordinates are unchanged: PASSED\n"
+             << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -442,3 +455,90 @@ void testMomentArmDefinitionForModel(const string &filename, const string &coord
     // dL/dTheta definition or is at least dynamically consistent, in which dL/dTheta is not
     ASSERT(passesDefinition || passesDynamicConsistency, __FILE__, __LINE__, errorMessage);
 }
+
+// The moment-arm matrix computed in a single pass for all muscles and 
+// coordinates must match the moment-arms computed one at a time.
+void testMomentArmMatrix(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+
+    std::vector<const Coordinate*> coords;
+    for (const auto& coord : model.getComponentList<Coordinate>())
+        coords.push_back(&coord);
+    std::vector<const GeometryPath*> paths;
+    std::vector<const Muscle*> muscles;
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        paths.push_back(&muscle.getGeometryPath());
+        muscles.push_back(&muscle);
+    }
+
+    const auto& knee = model.getCoordinateSet().get("knee_angle_r");
+    for (double angle = -SimTK::Pi/2; angle <= 0; angle += SimTK::Pi/8) {
+        knee.setValue(s, angle);
+        model.realizeVelocity(s);
+
+        const SimTK::Matrix momentArms = 
+            GeometryPath::computeMomentArmMatrix(s, paths, coords);
+        ASSERT(momentArms.nrow() == (int)paths.size());
+        ASSERT(momentArms.ncol() == (int)coords.size());
+
+        for (size_t i = 0; i < paths.size(); ++i) {
+            const SimTK::Vector row = paths[i]->computeMomentArms(s, coords);
+            for (size_t j = 0; j < coords.size(); ++j) {
+                const double expected = 
+                    muscles[i]->computeMomentArm(s, 
+                        const_cast<Coordinate&>(*coords[j]));
+                ASSERT_EQUAL(expected, momentArms(int(i), int(j)), 1e-10,
+                    __FILE__, __LINE__, "Moment-arm matrix of " + 
+                    muscles[i]->getName() + " about " + coords[j]->getName() +
+                    " does not match computeMomentArm().");
+                ASSERT_EQUAL(expected, row[int(j)], 1e-10,
+                    __FILE__, __LINE__, "computeMomentArms() does not match "
+                    "computeMomentArm().");
+            }
+        }
+    }
+}
+
+// Perturb one coordinate at a time (as finite differences do) so that most
+// paths are reused, and compare the lengths to those of paths that are always
+// recomputed from scratch.
+void testPathReuse(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    Model reference(filename);
+    SimTK::State& sRef = reference.initSystem();
+
+    std::vector<const GeometryPath*> paths;
+    for (const auto& path : model.getComponentList<GeometryPath>())
+        paths.push_back(&path);
+    std::vector<const GeometryPath*> refPaths;
+    for (const auto& path : reference.getComponentList<GeometryPath>())
+        refPaths.push_back(&path);
+
+    auto compareLengths = [&](const std::string& when) {
+        model.realizePosition(s);
+        // Invalidating the instance discards the snapshots of the paths.
+        sRef.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        reference.realizePosition(sRef);
+        for (size_t i = 0; i < paths.size(); ++i) {
+            ASSERT_EQUAL(refPaths[i]->getLength(sRef),
+                    paths[i]->getLength(s), 1e-8, __FILE__, __LINE__,
+                    "Length of " + paths[i]->getAbsolutePathString() +
+                    " is incorrect " + when + ".");
+        }
+    };
+
+    compareLengths("initially");
+    for (int i = 0; i < s.getNQ(); ++i) {
+        const double q = s.getQ()[i];
+        s.updQ()[i] = q + 0.05;
+        sRef.updQ()[i] = q + 0.05;
+        compareLengths("after perturbing q" + std::to_string(i));
+        s.updQ()[i] = q;
+        sRef.updQ()[i] = q;
+        compareLengths("after restoring q" + std::to_string(i));
+    }
+}
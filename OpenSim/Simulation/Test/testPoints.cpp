@@ -27,6 +27,8 @@ Tests Include:
     1. Station
     2. Marker
     3. Stations on a Frame computations 
+    4. Cached MovingPathPoint and ConditionalPathPoint evaluation
+    5. Bulk kinematics of stations and markers
       
      Add tests here as Points are added to OpenSim
 
@@ -35,6 +37,12 @@ Tests Include:
 #include <OpenSim/Simulation/SimbodyEngine/EllipsoidJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/GimbalJoint.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
+#include <OpenSim/Simulation/Model/MovingPathPoint.h>
+#include <OpenSim/Simulation/Model/ConditionalPathPoint.h>
+#include <OpenSim/Simulation/Model/PathSpring.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
+#include <OpenSim/Simulation/KinematicsSnapshot.h>
+#include <OpenSim/Common/LinearFunction.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -43,6 +51,9 @@ using SimTK::Transform;
 
 void testStationOnBody();
 void testStationOnOffsetFrame();
+void testCachedPathPoints();
+void testKinematicsSnapshot();
+void testMarkerSetKinematics();
 
 class OrdinaryOffsetFrame : public OffsetFrame < Frame > {
     OpenSim_DECLARE_CONCRETE_OBJECT(OrdinaryOffsetFrame, OffsetFrame<Frame>);
@@ -70,6 +81,24 @@ int main()
         failures.push_back("testStationOnOffsetFrame");
     }
 
+    try { testCachedPathPoints(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testCachedPathPoints");
+    }
+
+    try { testKinematicsSnapshot(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testKinematicsSnapshot");
+    }
+
+    try { testMarkerSetKinematics(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMarkerSetKinematics");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -229,3 +258,207 @@ void testStationOnOffsetFrame()
         SimTK_TEST_EQ(a, ao);
     }
 }
+
+void testCachedPathPoints()
+{
+    using SimTK::Vec3;
+    cout << "Running testCachedPathPoints" << endl;
+
+    Model model;
+    auto* body = new OpenSim::Body("body", 1, Vec3(0), SimTK::Inertia(0.1));
+    model.addBody(body);
+    auto* joint = new PinJoint("pin", model.getGround(), *body);
+    model.addJoint(joint);
+    const Coordinate& coord = joint->getCoordinate();
+
+    auto* spring = new PathSpring("spring", 0.1, 10.0, 0.01);
+    GeometryPath& path = spring->updGeometryPath();
+    path.appendNewPathPoint("origin", model.getGround(), Vec3(0, 0.1, 0));
+
+    // x = 0.5 q + 0.2, y = -0.1 q.
+    auto* moving = new MovingPathPoint();
+    moving->setName("moving");
+    moving->setParentFrame(*body);
+    moving->set_x_location(LinearFunction(0.5, 0.2));
+    moving->set_y_location(LinearFunction(-0.1, 0.0));
+    moving->setXCoordinate(coord);
+    moving->setYCoordinate(coord);
+    path.updPathPointSet().adoptAndAppend(moving);
+
+    auto* conditional = new ConditionalPathPoint();
+    conditional->setName("conditional");
+    conditional->setParentFrame(*body);
+    conditional->setLocation(Vec3(0.1, 0, 0));
+    conditional->setCoordinate(coord);
+    conditional->setRangeMin(0);
+    conditional->setRangeMax(1);
+    path.updPathPointSet().adoptAndAppend(conditional);
+
+    path.appendNewPathPoint("insertion", *body, Vec3(0.3, 0, 0));
+    model.addForce(spring);
+
+    SimTK::State state = model.initSystem();
+    for (double q = -0.8; q <= 1.5; q += 0.3) {
+        coord.setValue(state, q);
+        coord.setSpeedValue(state, 2 * q);
+        model.realizeTime(state);
+        // Fill the caches of all points up front.
+        MovingPathPoint::updatePathPointCaches(model, state);
+
+        const Vec3 expected(0.5 * q + 0.2, -0.1 * q, 0);
+        ASSERT_EQUAL(expected, moving->getLocation(state), Vec3(1e-15),
+            __FILE__, __LINE__,
+            "testCachedPathPoints(): MovingPathPoint location is incorrect.");
+        ASSERT_EQUAL(Vec3(0.5, -0.1, 0), moving->getdPointdQ(state),
+            Vec3(1e-15), __FILE__, __LINE__,
+            "testCachedPathPoints(): MovingPathPoint dPdq is incorrect.");
+        ASSERT_EQUAL(Vec3(0.5, -0.1, 0) * 2 * q, moving->getVelocity(state),
+            Vec3(1e-15), __FILE__, __LINE__,
+            "testCachedPathPoints(): MovingPathPoint velocity is incorrect.");
+        ASSERT(conditional->isActive(state) == (q >= 0 && q <= 1),
+            __FILE__, __LINE__,
+            "testCachedPathPoints(): ConditionalPathPoint activity is "
+            "incorrect.");
+    }
+
+    // Before Stage::Time, the points are evaluated without the cache.
+    coord.setValue(state, 0.4);
+    state.invalidateAllCacheAtOrAbove(SimTK::Stage::Time);
+    ASSERT_EQUAL(Vec3(0.4, -0.04, 0), moving->getLocation(state),
+        Vec3(1e-15), __FILE__, __LINE__,
+        "testCachedPathPoints(): uncached location is incorrect.");
+}
+
+void testKinematicsSnapshot()
+{
+    using SimTK::Vec3;
+    cout << "Running testKinematicsSnapshot" << endl;
+
+    Model pendulum;
+    auto* rod1 = new Body("rod1", 0.5, Vec3(0.1, 0.5, 0.2),
+        SimTK::Inertia::cylinderAlongY(0.025, 0.55));
+    auto* rod2 = rod1->clone();
+    rod2->setName("rod2");
+    pendulum.addBody(rod1);
+    pendulum.addBody(rod2);
+    auto* hip = new GimbalJoint("hip", pendulum.getGround(), Vec3(0),
+        Vec3(1, 2, 3), *rod1, Vec3(0, 0.25, 0), Vec3(0.9, 0.5, 0.2));
+    auto* knee = new PinJoint("knee", *rod1, Vec3(0, -0.25, 0), Vec3(0.2, 0, 0),
+        *rod2, Vec3(0, 0.25, 0), Vec3(0));
+    pendulum.addJoint(hip);
+    pendulum.addJoint(knee);
+
+    SimTK::Transform X_RO(SimTK::Rotation(SimTK::Pi/3.33, SimTK::ZAxis),
+        Vec3(1.234, -0.2667, 0));
+    auto* offsetFrame = new PhysicalOffsetFrame("offset", *rod2, X_RO);
+    pendulum.addComponent(offsetFrame);
+
+    SimTK::State state = pendulum.initSystem();
+    for (int i = 0; i < state.getNQ(); ++i) {
+        state.updQ()[i] = 0.3 * (i + 1);
+        state.updU()[i] = -0.2 * (i + 1);
+    }
+
+    KinematicsSnapshot snapshot;
+    snapshot.addStation(*rod1, rod1->get_mass_center());
+    snapshot.addStation(*offsetFrame, Vec3(0.5, 1, -1.5));
+    snapshot.addStation(pendulum.getGround(), Vec3(1, 2, 3));
+    ASSERT(snapshot.getNumStations() == 3);
+
+    // Only the positions are available at Stage::Position.
+    pendulum.realizePosition(state);
+    snapshot.update(state);
+    ASSERT(snapshot.getVelocitiesInGround()[0][1].isNaN());
+    ASSERT(snapshot.getAccelerationsInGround()[0][1].isNaN());
+
+    pendulum.realizeAcceleration(state);
+    snapshot.update(state);
+    const PhysicalFrame* frames[] = {rod1, offsetFrame, &pendulum.getGround()};
+    const Vec3 stations[] = {rod1->get_mass_center(), Vec3(0.5, 1, -1.5),
+        Vec3(1, 2, 3)};
+    const Vec3 tol(1e-12);
+    for (int i = 0; i < 3; ++i) {
+        const PhysicalFrame& frame = *frames[i];
+        ASSERT_EQUAL(frame.findStationLocationInGround(state, stations[i]),
+            snapshot.getLocationsInGround()[i], tol, __FILE__, __LINE__,
+            "Snapshot location does not match.");
+        ASSERT_EQUAL(frame.findStationVelocityInGround(state, stations[i]),
+            snapshot.getVelocitiesInGround()[i][1], tol, __FILE__, __LINE__,
+            "Snapshot velocity does not match.");
+        ASSERT_EQUAL(frame.findStationAccelerationInGround(state, stations[i]),
+            snapshot.getAccelerationsInGround()[i][1], tol, __FILE__, __LINE__,
+            "Snapshot acceleration does not match.");
+        ASSERT_EQUAL(frame.getVelocityInGround(state)[0],
+            snapshot.getVelocitiesInGround()[i][0], tol, __FILE__, __LINE__,
+            "Snapshot angular velocity does not match.");
+        ASSERT_EQUAL(frame.getAccelerationInGround(state)[0],
+            snapshot.getAccelerationsInGround()[i][0], tol, __FILE__, __LINE__,
+            "Snapshot angular acceleration does not match.");
+        const SimTK::Rotation R = frame.getTransformInGround(state).R();
+        ASSERT_EQUAL(R.convertRotationToBodyFixedXYZ(),
+            snapshot.getRotationsInGround()[i].convertRotationToBodyFixedXYZ(),
+            tol, __FILE__, __LINE__, "Snapshot rotation does not match.");
+    }
+}
+
+void testMarkerSetKinematics()
+{
+    using SimTK::Vec3;
+    cout << "Running testMarkerSetKinematics" << endl;
+
+    Model pendulum;
+    auto* rod1 = new Body("rod1", 0.5, Vec3(0.1, 0.5, 0.2),
+        SimTK::Inertia::cylinderAlongY(0.025, 0.55));
+    auto* rod2 = rod1->clone();
+    rod2->setName("rod2");
+    pendulum.addBody(rod1);
+    pendulum.addBody(rod2);
+    auto* hip = new GimbalJoint("hip", pendulum.getGround(), Vec3(0),
+        Vec3(1, 2, 3), *rod1, Vec3(0, 0.25, 0), Vec3(0.9, 0.5, 0.2));
+    auto* knee = new PinJoint("knee", *rod1, Vec3(0, -0.25, 0), Vec3(0.2, 0, 0),
+        *rod2, Vec3(0, 0.25, 0), Vec3(0));
+    pendulum.addJoint(hip);
+    pendulum.addJoint(knee);
+
+    SimTK::Transform X_RO(SimTK::Rotation(SimTK::Pi/3.33, SimTK::ZAxis),
+        Vec3(1.234, -0.2667, 0));
+    auto* offsetFrame = new PhysicalOffsetFrame("offset", *rod2, X_RO);
+    pendulum.addComponent(offsetFrame);
+
+    pendulum.addMarker(new Marker("m0", *rod1, Vec3(0.1, -0.2, 0.3)));
+    pendulum.addMarker(new Marker("m1", *offsetFrame, Vec3(0.5, 1, -1.5)));
+    pendulum.addMarker(new Marker("m2", pendulum.getGround(), Vec3(1, 2, 3)));
+    pendulum.addMarker(new Marker("m3", *rod2, Vec3(0)));
+
+    SimTK::State state = pendulum.initSystem();
+    for (int i = 0; i < state.getNQ(); ++i) {
+        state.updQ()[i] = 0.3 * (i + 1);
+        state.updU()[i] = -0.2 * (i + 1);
+    }
+    pendulum.realizeVelocity(state);
+
+    const MarkerSet& markers = pendulum.getMarkerSet();
+    SimTK::Vector_<Vec3> locations;
+    SimTK::Matrix jacobian;
+    markers.calcMarkerLocationsInGround(state, locations, jacobian);
+    ASSERT(locations.size() == markers.getSize());
+    ASSERT(jacobian.nrow() == 3 * markers.getSize());
+    ASSERT(jacobian.ncol() == state.getNU());
+
+    SimTK::Vector_<Vec3> locationsOnly;
+    markers.calcMarkerLocationsInGround(state, locationsOnly);
+
+    // The stacked Jacobian maps the speeds to the marker velocities.
+    const SimTK::Vector velocities = jacobian * state.getU();
+    const Vec3 tol(1e-12);
+    for (int i = 0; i < markers.getSize(); ++i) {
+        const Marker& marker = markers.get(i);
+        ASSERT_EQUAL(marker.getLocationInGround(state), locations[i], tol,
+            __FILE__, __LINE__, "Marker location does not match.");
+        ASSERT_EQUAL(locations[i], locationsOnly[i], tol,
+            __FILE__, __LINE__, "Marker locations are inconsistent.");
+        const Vec3 v(velocities[3*i], velocities[3*i+1], velocities[3*i+2]);
+        ASSERT_EQUAL(marker.getVelocityInGround(state), v, tol,
+            __FILE__, __LINE__, "Marker Jacobian does not match velocity.");
+    }
+}
@@ -116,9 +116,62 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testTableReporterManyRows() {
+    // Create a model consisting of a falling ball.
+    Model model;
+    model.setName("world");
+
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    auto* reporter = new TableReporter();
+    reporter->addToReport(slider->getCoordinate().getOutput("value"));
+    reporter->addToReport(slider->getCoordinate().getOutput("speed"));
+    model.addComponent(reporter);
+
+    // Report enough rows that the reporter's buffer must grow several times,
+    // and read the table partway through.
+    State& state = model.initSystem();
+    const auto& coord = slider->getCoordinate();
+    const int numRows = 1000;
+    for (int i = 0; i < numRows; ++i) {
+        state.setTime(0.001 * i);
+        coord.setValue(state, 0.5 * i, false);
+        coord.setSpeedValue(state, -1.0 * i);
+        model.realizeReport(state);
+        if (i == 99) {
+            SimTK_TEST(reporter->getTable().getNumRows() == 100);
+        }
+    }
+
+    const auto& table = reporter->getTable();
+    SimTK_TEST(table.getNumRows() == numRows);
+    SimTK_TEST(table.getNumColumns() == 2);
+    for (int i = 0; i < numRows; i += 37) {
+        SimTK_TEST_EQ(table.getIndependentColumn()[i], 0.001 * i);
+        SimTK_TEST_EQ(table.getRowAtIndex(i)[0], 0.5 * i);
+        SimTK_TEST_EQ(table.getRowAtIndex(i)[1], -1.0 * i);
+    }
+
+    // Reporting a time that is not increasing is an error, and clearTable()
+    // allows reporting from the start again.
+    state.setTime(0.0);
+    SimTK_TEST_MUST_THROW_EXC(model.realizeReport(state), Exception);
+    reporter->clearTable();
+    SimTK_TEST(reporter->getTable().getNumRows() == 0);
+    model.realizeReport(state);
+    SimTK_TEST(reporter->getTable().getNumRows() == 1);
+    SimTK_TEST(reporter->getTable().getColumnLabels().size() == 2);
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testTableReporterManyRows);
     SimTK_END_TEST();
 };
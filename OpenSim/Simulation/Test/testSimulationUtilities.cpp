@@ -25,18 +25,29 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
+#include <OpenSim/Simulation/Model/Umberger2010MuscleMetabolicsProbe.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
+#include <set>
+
 using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testStateVariableSystemIndices();
+void testAnalyzeInParallel();
+void testAnalyzeProbes();
+void testConvertDegreesToRadians();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testStateVariableSystemIndices);
+        SimTK_SUBTEST(testAnalyzeInParallel);
+        SimTK_SUBTEST(testAnalyzeProbes);
+        SimTK_SUBTEST(testConvertDegreesToRadians);
     SimTK_END_TEST();
 }
 
@@ -193,3 +204,214 @@ void testUpdatePre40KinematicsFor40MotionType() {
 
 
 
+
+void testStateVariableSystemIndices() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
+    SimTK::State state = model.initSystem();
+
+    const auto svNames = model.getStateVariableNames();
+    std::vector<std::string> names;
+    for (int isv = 0; isv < svNames.size(); ++isv) {
+        names.push_back(svNames[isv]);
+    }
+    const auto indices = model.getStateVariableSystemIndices(names);
+    SimTK_TEST((int)indices.size() == svNames.size());
+
+    // Each state variable has its own entry in Y.
+    const auto yIndexMap = createSystemYIndexMap(model);
+    std::set<int> uniqueIndices(indices.begin(), indices.end());
+    SimTK_TEST(uniqueIndices.size() == indices.size());
+    for (int isv = 0; isv < svNames.size(); ++isv) {
+        SimTK_TEST(yIndexMap.at(svNames[isv]) == indices[isv]);
+    }
+
+    // Set the values through the indices and read them back by name.
+    SimTK::Vector values(svNames.size());
+    for (int isv = 0; isv < svNames.size(); ++isv) values[isv] = 0.01 * isv;
+    model.setStateVariableValuesAtSystemIndices(state, indices, values);
+    for (int isv = 0; isv < svNames.size(); ++isv) {
+        SimTK_TEST_EQ(model.getStateVariableValue(state, svNames[isv]),
+                values[isv]);
+    }
+
+    // The values are written into the caller's Vector.
+    SimTK::Vector byIndex;
+    model.getStateVariableValuesAtSystemIndices(state, indices, byIndex);
+    SimTK_TEST_EQ(byIndex, values);
+    SimTK::Vector all(3, SimTK::NaN);
+    model.getStateVariableValues(state, all);
+    SimTK_TEST_EQ(all, model.getStateVariableValues(state));
+    SimTK_TEST_EQ(all, values);
+
+    SimTK_TEST_MUST_THROW_EXC(
+            model.getStateVariableSystemIndices({"not_a_state_variable"}),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(model.setStateVariableValuesAtSystemIndices(
+                                      state, indices, SimTK::Vector(2, 0.0)),
+            OpenSim::Exception);
+}
+
+void testAnalyzeInParallel() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
+    SimTK::State state = model.initSystem();
+
+    // Create a trajectory in which the knee flexes.
+    const auto& knee = model.getCoordinateSet().get("knee_angle_r");
+    StatesTrajectory statesTraj;
+    const int numTimes = 23;
+    std::vector<double> times;
+    for (int itime = 0; itime < numTimes; ++itime) {
+        state.setTime(0.01 * itime);
+        knee.setValue(state, -0.05 * itime);
+        statesTraj.append(state);
+        times.push_back(state.getTime());
+    }
+    const TimeSeriesTable statesTable = statesTraj.exportToTable(model);
+    const TimeSeriesTable controlsTable(times);
+
+    const std::vector<std::string> outputPaths{".*\\|length"};
+    const auto serial =
+            analyze<double>(model, statesTable, controlsTable, outputPaths);
+    const auto parallel = analyze<double>(
+            model, statesTable, controlsTable, outputPaths, 4);
+
+    SimTK_TEST(serial.getNumRows() == (size_t)numTimes);
+    SimTK_TEST(serial.getNumColumns() > 0);
+    SimTK_TEST(parallel.getNumRows() == serial.getNumRows());
+    SimTK_TEST(parallel.getColumnLabels() == serial.getColumnLabels());
+    SimTK_TEST(parallel.getIndependentColumn() ==
+               serial.getIndependentColumn());
+    SimTK_TEST_EQ(parallel.getMatrix(), serial.getMatrix());
+
+    // The muscles crossing the knee change length.
+    const auto& length = serial.getDependentColumn(
+            "/forceset/bifemsh_r|length");
+    SimTK_TEST(length[0] != length[numTimes - 1]);
+}
+
+void testAnalyzeProbes() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
+    // An integrating probe that reports only the total; analyzeProbes()
+    // evaluates it directly and reports each muscle.
+    auto* probe = new Umberger2010MuscleMetabolicsProbe(true, true, true, true);
+    probe->setName("metabolics");
+    probe->setOperation("integrate");
+    probe->set_report_total_metabolics_only(true);
+    model.addProbe(probe);
+    model.finalizeFromProperties();
+    const int numMuscles = model.getMuscles().getSize();
+    for (int imusc = 0; imusc < numMuscles; ++imusc) {
+        probe->addMuscle(model.getMuscles()[imusc].getName(), 0.5);
+    }
+    SimTK::State state = model.initSystem();
+
+    // Create a trajectory in which the knee flexes. The table contains the
+    // state of the integrating probe.
+    const auto& knee = model.getCoordinateSet().get("knee_angle_r");
+    StatesTrajectory statesTraj;
+    const int numTimes = 11;
+    for (int itime = 0; itime < numTimes; ++itime) {
+        state.setTime(0.01 * itime);
+        knee.setValue(state, -0.05 * itime);
+        knee.setSpeedValue(state, -5.0);
+        statesTraj.append(state);
+    }
+    const TimeSeriesTable statesTable = statesTraj.exportToTable(model);
+    const auto controlNames = createControlNamesFromModel(model);
+    TimeSeriesTable controlsTable(statesTable.getIndependentColumn(),
+            SimTK::Matrix(numTimes, (int)controlNames.size(), 0.3),
+            controlNames);
+
+    const auto serial = analyzeProbes(model, statesTable, controlsTable);
+    const auto parallel =
+            analyzeProbes(model, statesTable, controlsTable, 3);
+    SimTK_TEST(serial.size() == 1);
+    const auto& table = serial.at("/probeset/metabolics");
+    SimTK_TEST(table.getNumRows() == (size_t)numTimes);
+    SimTK_TEST(table.getNumColumns() == (size_t)(2 + numMuscles));
+    SimTK_TEST(table.getColumnLabel(0) == "metabolics_TOTAL");
+    SimTK_TEST_EQ(parallel.at("/probeset/metabolics").getMatrix(),
+            table.getMatrix());
+
+    // The total is the sum of the basal rate and the muscle rates.
+    const SimTK::Matrix& rates = table.getMatrix();
+    for (int itime = 0; itime < numTimes; ++itime) {
+        double sum = 0;
+        for (int icol = 1; icol < (int)table.getNumColumns(); ++icol) {
+            sum += rates(itime, icol);
+        }
+        SimTK_TEST_EQ(rates(itime, 0), sum);
+        SimTK_TEST(rates(itime, 1) > 0);
+    }
+}
+
+void testConvertDegreesToRadians() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
+    model.initSystem();
+    const auto& engine = model.getSimbodyEngine();
+
+    // Coordinate names, coordinate paths, state variable paths, and a
+    // column that is not a coordinate.
+    const std::vector<std::string> labels{"pelvis_tilt", "pelvis_tx",
+            "/jointset/hip_r/hip_flexion_r/value",
+            "/jointset/knee_r/knee_angle_r/speed",
+            "/jointset/ground_pelvis/pelvis_ty/value",
+            "/forceset/soleus_r/activation"};
+    const std::vector<bool> rotational{true, false, true, true, false, false};
+    const int numColumns = (int)labels.size();
+    const int numRows = 5;
+
+    TimeSeriesTable table;
+    table.setColumnLabels(labels);
+    SimTK::RowVector row(numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) row[j] = 10.0 * i + j;
+        table.appendRow(0.1 * i, row);
+    }
+
+    // TimeSeriesTable.
+    TimeSeriesTable converted = table;
+    converted.addTableMetaData<std::string>("inDegrees", "yes");
+    engine.convertDegreesToRadians(converted);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            const double expected = table.getMatrix()(i, j) *
+                    (rotational[j] ? SimTK_DEGREE_TO_RADIAN : 1.0);
+            SimTK_TEST_EQ(converted.getMatrix()(i, j), expected);
+        }
+    }
+
+    // Storage.
+    Storage storage;
+    Array<std::string> storageLabels;
+    storageLabels.append("time");
+    for (const auto& label : labels) storageLabels.append(label);
+    storage.setColumnLabels(storageLabels);
+    for (int i = 0; i < numRows; ++i) {
+        std::vector<double> data(numColumns);
+        for (int j = 0; j < numColumns; ++j) data[j] = table.getMatrix()(i, j);
+        storage.append(table.getIndependentColumn()[i], numColumns,
+                data.data());
+    }
+    storage.setInDegrees(true);
+    engine.convertDegreesToRadians(storage);
+    SimTK_TEST(!storage.isInDegrees());
+    for (int i = 0; i < numRows; ++i) {
+        const Array<double>& data = storage.getStateVector(i)->getData();
+        for (int j = 0; j < numColumns; ++j) {
+            const double expected = table.getMatrix()(i, j) *
+                    (rotational[j] ? SimTK_DEGREE_TO_RADIAN : 1.0);
+            SimTK_TEST_EQ(data[j], expected);
+        }
+    }
+
+    // And back.
+    engine.convertRadiansToDegrees(storage);
+    SimTK_TEST(storage.isInDegrees());
+    for (int i = 0; i < numRows; ++i) {
+        const Array<double>& data = storage.getStateVector(i)->getData();
+        for (int j = 0; j < numColumns; ++j) {
+            SimTK_TEST_EQ(data[j], table.getMatrix()(i, j));
+        }
+    }
+}
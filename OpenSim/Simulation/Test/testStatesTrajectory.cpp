@@ -770,6 +770,76 @@ void testExport() {
             OpenSim::Exception);
 }
 
+void testCompactStatesTrajectory() {
+    Model gait("gait2354_simbody.osim");
+    gait.initSystem();
+    Storage sto(statesStoFname);
+    const auto table = sto.exportToTable();
+    const auto states = StatesTrajectory::createFromStatesTable(gait, table);
+    auto compact = CompactStatesTrajectory::createFromStatesTable(gait, table);
+    SimTK_TEST(compact.getSize() == states.getSize());
+
+    // The materialized states match the full states, including discrete
+    // variables, and a reused state gives the same values.
+    const auto& knee = gait.getCoordinateSet().get("knee_angle_r");
+    SimTK::State reused;
+    for (size_t itime = 0; itime < states.getSize(); ++itime) {
+        SimTK_TEST(compact.getTime(itime) == states[itime].getTime());
+        SimTK_TEST_EQ(compact.getY(itime), states[itime].getY());
+        const SimTK::State state = compact.getState(itime);
+        SimTK_TEST(state.isConsistent(states[itime]));
+        SimTK_TEST_EQ(state.getY(), states[itime].getY());
+        compact.copyToState(itime, reused);
+        SimTK_TEST_EQ(reused.getY(), states[itime].getY());
+        SimTK_TEST(knee.getLocked(reused) == knee.getLocked(states[itime]));
+    }
+
+    // A discrete variable (the locked flag) changes along the trajectory.
+    {
+        SimTK::State state = gait.initSystem();
+        CompactStatesTrajectory locking;
+        for (int itime = 0; itime < 4; ++itime) {
+            state.setTime(0.1 * itime);
+            knee.setLocked(state, itime % 2 == 1);
+            locking.append(state);
+        }
+        for (int itime = 0; itime < 4; ++itime) {
+            locking.copyToState(itime, reused);
+            SimTK_TEST(knee.getLocked(reused) == (itime % 2 == 1));
+        }
+        state.setTime(0.0);
+        SimTK_TEST_MUST_THROW(locking.append(state));
+    }
+
+    // Export paths match those of StatesTrajectory.
+    SimTK_TEST_EQ(compact.exportToTable(gait).getMatrix(),
+            states.exportToTable(gait).getMatrix());
+    const std::vector<std::string> columns{
+        knee.getStateVariableNames()[0], knee.getStateVariableNames()[1]};
+    const auto kneeTable = compact.exportToTable(gait, columns);
+    SimTK_TEST(kneeTable.getColumnLabels() == columns);
+    SimTK_TEST_EQ(kneeTable.getMatrix(),
+            states.exportToTable(gait, columns).getMatrix());
+    const auto roundTrip = compact.exportToStatesTrajectory();
+    SimTK_TEST(roundTrip.getSize() == states.getSize());
+    SimTK_TEST_EQ(roundTrip.back().getY(), states.back().getY());
+    SimTK_TEST(CompactStatesTrajectory::createFromStatesTrajectory(states)
+                       .getSize() == states.getSize());
+
+    {
+        Model arm26("arm26.osim");
+        arm26.initSystem();
+        SimTK_TEST_MUST_THROW_EXC(compact.exportToTable(arm26),
+                StatesTrajectory::IncompatibleModel);
+        SimTK::State armState = arm26.getWorkingState();
+        armState.setTime(compact.getTime(compact.getSize() - 1) + 1.0);
+        SimTK_TEST_MUST_THROW_EXC(compact.append(armState),
+                StatesTrajectory::InconsistentState);
+    }
+    SimTK_TEST_MUST_THROW_EXC(compact.getTime(compact.getSize()),
+            IndexOutOfRange);
+}
+
 int main() {
     SimTK_START_TEST("testStatesTrajectory");
         // actuators library is not loaded automatically (unless using clang).
@@ -803,5 +873,7 @@ int main() {
         // Export to data table.
         SimTK_SUBTEST(testExport);
 
+        SimTK_SUBTEST(testCompactStatesTrajectory);
+
     SimTK_END_TEST();
 }
@@ -0,0 +1,96 @@
+/* -------------------------------------------------------------------------- *
+ *             OpenSim:  testStreamingInverseDynamicsSolver.cpp               *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulation.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <thread>
+
+using namespace OpenSim;
+using namespace SimTK;
+
+// A block of mass 2 on a slider along ground's x axis follows x = sin(t)
+// while a force plate pushes it with 3 N along x. The generalized force is
+// then m xddot - 3 = -2 sin(t) - 3.
+void testSliderWithStreamedLoad() {
+    Model model;
+    model.setGravity(Vec3(0));
+    auto* block = new OpenSim::Body("block", 2.0, Vec3(0), Inertia(1.0));
+    model.addBody(block);
+    model.addJoint(new SliderJoint("slider", model.getGround(), *block));
+    SimTK::State state = model.initSystem();
+
+    StreamingInverseDynamicsSolver id(model);
+    ASSERT(id.getLag() == 4);
+    ASSERT(id.addAppliedLoad("/bodyset/block") == 0);
+    ASSERT_THROW(OpenSim::Exception, id.pushLoads(0, Vector(3, 0.0)));
+
+    const double dt = 0.01;
+    const int numFrames = 100;
+    // Loads at twice the frame rate, from another thread. The point of
+    // application does not matter for a slider.
+    std::thread forcePlate([&]() {
+        Vector loads(StreamingInverseDynamicsSolver::NumValuesPerLoad, 0.0);
+        loads[0] = 3.0;
+        loads[4] = 0.5;
+        for (int i = 0; i < 2 * numFrames; ++i) {
+            id.pushLoads(0.5 * dt * i, loads);
+        }
+    });
+    forcePlate.join();
+
+    int numEstimates = 0;
+    double estimateTime;
+    Vector tau;
+    for (int i = 0; i < numFrames; ++i) {
+        const double time = dt * i;
+        const bool estimated =
+                id.update(state, time, Vector(1, std::sin(time)),
+                        estimateTime, tau);
+        ASSERT(estimated == (i >= id.getWindowSize() - 1));
+        if (!estimated) continue;
+        ++numEstimates;
+        ASSERT_EQUAL(time - id.getLag() * dt, estimateTime, 1e-12);
+        ASSERT_EQUAL(std::sin(estimateTime), state.getQ()[0], 1e-6);
+        ASSERT_EQUAL(std::cos(estimateTime), state.getU()[0], 1e-4);
+        ASSERT_EQUAL(-2 * std::sin(estimateTime) - 3.0, tau[0], 1e-2);
+    }
+    ASSERT(numEstimates == numFrames - id.getWindowSize() + 1);
+    ASSERT(id.getNumDroppedLoads() == 0);
+
+    // Frames must arrive in order.
+    ASSERT_THROW(OpenSim::Exception,
+            id.update(state, 0, Vector(1, 0.0), estimateTime, tau));
+    id.reset();
+    ASSERT(!id.update(state, 0, Vector(1, 0.0), estimateTime, tau));
+
+    ASSERT_THROW(OpenSim::Exception, StreamingInverseDynamicsSolver(model, 2));
+    ASSERT_THROW(OpenSim::Exception,
+            StreamingInverseDynamicsSolver(model, 5, 5));
+}
+
+int main() {
+    SimTK_START_TEST("testStreamingInverseDynamicsSolver");
+        SimTK_SUBTEST(testSliderWithStreamedLoad);
+    SimTK_END_TEST();
+    return 0;
+}
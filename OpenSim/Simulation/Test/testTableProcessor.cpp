@@ -75,4 +75,52 @@ TEST_CASE("TableProcessor") {
             CHECK(out.getNumRows() == 4);
         }
     }
+
+    SECTION("Cache") {
+        static int numOperations = 0;
+        class CountingTableOperator : public TableOperator {
+            OpenSim_DECLARE_CONCRETE_OBJECT(
+                    CountingTableOperator, TableOperator);
+
+        public:
+            void operate(TimeSeriesTable& table, const Model*) const override {
+                ++numOperations;
+                table.appendRow(10.0, ~createVectorLinspace(
+                                              (int)table.getNumColumns(), 0, 1));
+            }
+        };
+        STOFileAdapter::write(table, "testTableProcessor_cache.sto");
+        TableProcessor proc = TableProcessor("testTableProcessor_cache.sto") |
+                              CountingTableOperator();
+        TableProcessor::setUseCache(true);
+        TableProcessor::clearCache();
+        CHECK(proc.process().getNumRows() == 4);
+        CHECK(proc.process().getNumRows() == 4);
+        CHECK(numOperations == 1);
+        CHECK(TableProcessor::getCacheSize() == 1);
+
+        // Editing the file invalidates the result.
+        table.appendRow(5.0, SimTK::RowVector(2, 0.0));
+        STOFileAdapter::write(table, "testTableProcessor_cache.sto");
+        CHECK(proc.process().getNumRows() == 5);
+        CHECK(numOperations == 2);
+
+        // Processed tables are reused from the cache directory after the
+        // in-memory cache is cleared.
+        TableProcessor::setCacheDirectory(".");
+        TableProcessor::clearCache();
+        proc.process();
+        CHECK(numOperations == 3);
+        TableProcessor::clearCache();
+        CHECK(proc.process().getNumRows() == 5);
+        CHECK(numOperations == 3);
+        TableProcessor::setCacheDirectory("");
+
+        // In-memory tables are not cached.
+        TableProcessor inMemory = TableProcessor(table) | CountingTableOperator();
+        inMemory.process();
+        inMemory.process();
+        CHECK(numOperations == 5);
+        TableProcessor::setUseCache(false);
+    }
 }
@@ -25,8 +25,11 @@
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Simulation/Wrap/WrapMath.h>
 #include <OpenSim/Common/Mtx.h>
+#include <OpenSim/Common/Lmdif.h>
 #include <SimTKcommon/Testing.h>
 
+#include <chrono>
+#include <iostream>
 #include <random>
 
 using namespace OpenSim;
@@ -138,4 +141,156 @@ TEST_CASE("Compare inverting matrices", "") {
     Mtx::Invert(4, &Mc[0][0], &Mcinv[0][0]);
 
     compareMat<SimTK::Mat44, double[][4], 4>(Minv, Mcinv, 1e-10);
-}
\ No newline at end of file
+}
+TEST_CASE("Batched sphere and cylinder wrapping lengths", "") {
+    const double r = 1.0;
+    // 0: points on opposite sides of the surface (wraps).
+    // 1: a segment that passes beside the surface (no wrapping).
+    // 2: a point inside the surface (straight line).
+    // 3: a random pair of points whose straight line passes through the
+    //    surface.
+    std::vector<double> px{-2, -2, 0.5, 0}, py{0, 2, 0, 0}, pz{0, 0, 0, 0};
+    std::vector<double> sx{2, 2, 3, 0}, sy{0, 2, 0, 0}, sz{1, 0, 0, 0};
+    const SimTK::Vec3 P3(generate_v() + 2, 0.5 * generate_v(),
+            0.5 * generate_v());
+    const SimTK::Vec3 S3(-generate_v() - 2, 0.5 * generate_v(),
+            0.5 * generate_v());
+    for (int k = 0; k < 3; ++k) {
+        (k == 0 ? px : k == 1 ? py : pz)[3] = P3[k];
+        (k == 0 ? sx : k == 1 ? sy : sz)[3] = S3[k];
+    }
+    const int n = (int)px.size();
+
+    SECTION("Sphere") {
+        std::vector<double> lengths(n);
+        WrapMath::CalcSphereWrapLengths(n, px.data(), py.data(), pz.data(),
+                sx.data(), sy.data(), sz.data(), r, lengths.data());
+        for (int i = 1; i < 3; ++i) {
+            const SimTK::Vec3 P(px[i], py[i], pz[i]), S(sx[i], sy[i], sz[i]);
+            SimTK_TEST_EQ(lengths[i], (S - P).norm());
+        }
+        // Case 0 in the plane that contains the center and both points.
+        const SimTK::Vec3 P(px[0], py[0], pz[0]), S(sx[0], sy[0], sz[0]);
+        const double theta = std::acos(SimTK::dot(P, S) / (P.norm() * S.norm()));
+        const double expected = std::sqrt(P.normSqr() - r * r) +
+                std::sqrt(S.normSqr() - r * r) +
+                r * (theta - std::acos(r / P.norm()) - std::acos(r / S.norm()));
+        SimTK_TEST_EQ(lengths[0], expected);
+        // A path that wraps is longer than the straight line through the
+        // sphere.
+        CHECK(lengths[3] > (S3 - P3).norm());
+    }
+
+    SECTION("Cylinder") {
+        std::vector<double> lengths(n);
+        WrapMath::CalcCylinderWrapLengths(n, px.data(), py.data(), pz.data(),
+                sx.data(), sy.data(), sz.data(), r, lengths.data());
+        for (int i = 1; i < 3; ++i) {
+            const SimTK::Vec3 P(px[i], py[i], pz[i]), S(sx[i], sy[i], sz[i]);
+            SimTK_TEST_EQ(lengths[i], (S - P).norm());
+        }
+        // Case 0: half the circle minus the tangent angles, and dz = 1.
+        const double planar = 2 * std::sqrt(3.0) + r * SimTK::Pi / 3;
+        SimTK_TEST_EQ(lengths[0], std::sqrt(planar * planar + 1.0));
+        CHECK(lengths[3] >= (S3 - P3).norm());
+    }
+}
+
+namespace {
+struct TorusLine {
+    SimTK::Vec3 p1, p2;
+    double r;
+};
+// The residual function that WrapTorus passed to lmdif_C().
+void calcTorusLineResid(int, int, double q[], double resid[], int*,
+        void* ptr) {
+    const TorusLine* line = (const TorusLine*)ptr;
+    resid[0] = WrapMath::CalcTorusCircleResidual(
+            line->p1, line->p2, line->r, q[0]);
+}
+double solveTorusLineWithLmdif(TorusLine& line) {
+    // The settings that WrapTorus used.
+    int info, num_func_calls, ldfjac = 1, ipvt[2];
+    int mode = 1, nprint = 0, max_iter = 500;
+    double ftol = 1e-4, xtol = 1e-4, gtol = 0.0;
+    double epsfcn = 0.0, step_factor = 0.2;
+    double q[2] = {0.0, 0.0}, resid[2], fjac[2];
+    double diag[2], qtf[2], wa1[2], wa2[2], wa3[2], wa4[2];
+    lmdif_C(calcTorusLineResid, 1, 1, q, resid, ftol, xtol, gtol, max_iter,
+            epsfcn, diag, mode, step_factor, nprint, &info, &num_func_calls,
+            fjac, ldfjac, ipvt, qtf, wa1, wa2, wa3, wa4, (void*)&line);
+    return q[0];
+}
+} // namespace
+
+TEST_CASE("Torus circle residual solver matches lmdif", "") {
+    const double r = 0.05;
+    std::minstd_rand gen(42);
+    std::uniform_real_distribution<double> coord(-0.2, 0.2);
+    const int n = 2000;
+    std::vector<TorusLine> lines(n);
+    for (auto& line : lines) {
+        line.p1 = SimTK::Vec3(coord(gen), coord(gen), coord(gen));
+        line.p2 = SimTK::Vec3(coord(gen), coord(gen), coord(gen));
+        line.r = r;
+    }
+
+    SECTION("Analytic derivative") {
+        const double h = 1e-6;
+        for (int i = 0; i < 20; ++i) {
+            const auto& line = lines[i];
+            const double u = 0.1 * coord(gen);
+            double deriv;
+            WrapMath::CalcTorusCircleResidual(line.p1, line.p2, r, u, &deriv);
+            const double fd = (WrapMath::CalcTorusCircleResidual(
+                                       line.p1, line.p2, r, u + h) -
+                                      WrapMath::CalcTorusCircleResidual(
+                                              line.p1, line.p2, r, u - h)) /
+                              (2 * h);
+            SimTK_TEST_EQ_TOL(deriv, fd, 1e-5 * (1 + std::abs(fd)));
+        }
+    }
+
+    SECTION("Accuracy and speed") {
+        std::vector<double> uLmdif(n), uAnalytic(n, 0.0);
+        std::vector<int> iterations(n);
+
+        const auto startLmdif = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            uLmdif[i] = solveTorusLineWithLmdif(lines[i]);
+        }
+        const auto startAnalytic = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            iterations[i] = WrapMath::SolveTorusCircleResidual(
+                    lines[i].p1, lines[i].p2, r, uAnalytic[i]);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        // Except where the residual has a local minimum away from its root
+        // (where neither solver converges), the new solver finds a root at
+        // least as accurately as lmdif, in a bounded number of iterations.
+        int numAsAccurate = 0;
+        int numSameRoot = 0;
+        for (int i = 0; i < n; ++i) {
+            const auto& line = lines[i];
+            const double residLmdif = std::abs(WrapMath::CalcTorusCircleResidual(
+                    line.p1, line.p2, r, uLmdif[i]));
+            const double residAnalytic = std::abs(
+                    WrapMath::CalcTorusCircleResidual(
+                            line.p1, line.p2, r, uAnalytic[i]));
+            if (residAnalytic <= residLmdif + 1e-10) ++numAsAccurate;
+            if (std::abs(uAnalytic[i] - uLmdif[i]) < 1e-3) ++numSameRoot;
+            if (iterations[i] >= 0) CHECK(residAnalytic < 1e-8);
+        }
+        CHECK(numAsAccurate >= 0.99 * n);
+        CHECK(numSameRoot >= 0.95 * n);
+
+        const std::chrono::duration<double> durLmdif =
+                startAnalytic - startLmdif;
+        const std::chrono::duration<double> durAnalytic = end - startAnalytic;
+        std::cout << "Torus circle residual: lmdif " << durLmdif.count()
+                  << " s, analytic Levenberg-Marquardt "
+                  << durAnalytic.count() << " s for " << n << " lines; "
+                  << numSameRoot << " found the same root." << std::endl;
+    }
+}
@@ -118,6 +118,18 @@ void PathWrap::extendConnectToModel(Model& model)
     }
 }
 
+void PathWrap::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    // Depends on the Instance stage so that the previous wrap is kept while
+    // the q's change.
+    WrapResult coldStart;
+    resetWrapResult(coldStart);
+    this->_previousWrapCV = addCacheVariable("previous_wrap", coldStart,
+            SimTK::Stage::Instance);
+}
+
 void PathWrap::setStartPoint( const SimTK::State& s, int aIndex)
 {
     if ((aIndex != get_range(0)) && 
@@ -136,27 +148,55 @@ void PathWrap::setEndPoint( const SimTK::State& s, int aIndex)
     }
 }
 
-void PathWrap::resetPreviousWrap()
+void PathWrap::resetWrapResult(WrapResult& wrapResult)
 {
-    _previousWrap.startPoint = -1;
-    _previousWrap.endPoint = -1;
+    wrapResult.startPoint = -1;
+    wrapResult.endPoint = -1;
 
-    _previousWrap.wrap_pts.setSize(0);
-    _previousWrap.wrap_path_length = 0.0;
+    wrapResult.wrap_pts.setSize(0);
+    wrapResult.wrap_path_length = 0.0;
 
     int i;
     for (i = 0; i < 3; i++) {
-        _previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        wrapResult.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        wrapResult.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        wrapResult.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
     }
 }
 
+void PathWrap::resetPreviousWrap()
+{
+    resetWrapResult(_previousWrap);
+}
+
 void PathWrap::setPreviousWrap(const WrapResult& aWrapResult)
 {
     _previousWrap = aWrapResult;
 }
 
+const WrapResult& PathWrap::getPreviousWrap(const SimTK::State& s) const
+{
+    if (!isCacheVariableValid(s, _previousWrapCV)) {
+        resetWrapResult(updCacheVariableValue(s, _previousWrapCV));
+        markCacheVariableValid(s, _previousWrapCV);
+    }
+    return getCacheVariableValue(s, _previousWrapCV);
+}
+
+void PathWrap::setPreviousWrap(const SimTK::State& s,
+        const WrapResult& aWrapResult) const
+{
+    _previousWrap = aWrapResult;
+    setCacheVariableValue(s, _previousWrapCV, aWrapResult);
+}
+
+void PathWrap::resetPreviousWrap(const SimTK::State& s) const
+{
+    resetWrapResult(_previousWrap);
+    resetWrapResult(updCacheVariableValue(s, _previousWrapCV));
+    markCacheVariableValid(s, _previousWrapCV);
+}
+
 void PathWrap::setWrapObject(WrapObject& aWrapObject)
 {
     _wrapObject = &aWrapObject;
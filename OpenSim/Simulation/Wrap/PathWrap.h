@@ -112,14 +112,27 @@ public:
     void setMethod(WrapMethod aMethod);
     const std::string& getMethodName() const { return get_method(); }
 
+    /** The most recent wrap computed with any state. */
     const WrapResult& getPreviousWrap() const { return _previousWrap; }
     void setPreviousWrap(const WrapResult& aWrapResult);
     void resetPreviousWrap();
 
+    /** The wrap computed when the path was last evaluated with this state,
+    used to warm-start the wrapping solvers. The previous wrap survives
+    changes to the state's q's and u's but is reset (tangent points are -inf)
+    whenever the Instance stage or an earlier stage changes. */
+    const WrapResult& getPreviousWrap(const SimTK::State& s) const;
+    /** Also updates the state-independent previous wrap. */
+    void setPreviousWrap(const SimTK::State& s,
+            const WrapResult& aWrapResult) const;
+    void resetPreviousWrap(const SimTK::State& s) const;
+
 private:
     void constructProperties();
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     void setNull();
+    static void resetWrapResult(WrapResult& wrapResult);
 
 private:
     WrapMethod _method;
@@ -127,7 +140,9 @@ private:
     const WrapObject* _wrapObject;
     const GeometryPath* _path;
 
-    WrapResult _previousWrap;  // results from previous wrapping
+    mutable WrapResult _previousWrap;  // results from previous wrapping
+    // results from the previous wrapping with a given state
+    mutable CacheVariable<WrapResult> _previousWrapCV;
 
     MemberSubcomponentIndex _wrapPoint1Ix{
         constructSubcomponent<PathWrapPoint>("pwpt1") };
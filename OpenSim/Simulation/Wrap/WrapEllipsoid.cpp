@@ -200,7 +200,7 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
     // In case you need any variables from the previous wrap, copy them from
     // the PathWrap into the WrapResult, re-normalizing the ones that were
     // un-normalized at the end of the previous wrap calculation.
-    const WrapResult& previousWrap = aPathWrap.getPreviousWrap();
+    const WrapResult& previousWrap = aPathWrap.getPreviousWrap(s);
     aWrapResult.factor = previousWrap.factor;
     for (i = 0; i < 3; i++)
     {
@@ -538,9 +538,42 @@ int WrapEllipsoid::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::
 
     vs4 = - Mtx::DotProduct(3, vs, aWrapResult.c1);
 
-    // find r1 & r2 by starting at c1 moving toward p1 & p2
-    calcTangentPoint(p1e, aWrapResult.r1, p1, m, a, vs, vs4);
-    calcTangentPoint(p2e, aWrapResult.r2, p2, m, a, vs, vs4);
+    // find r1 & r2 by starting at c1 moving toward p1 & p2. If this segment
+    // wrapped over the ellipsoid the last time the path was computed with
+    // this state, first try starting from the previous tangent points, which
+    // are usually much closer to the solution. The warm-started solution is
+    // kept only if the solver converged and the tangent point is on the same
+    // side of the line from the end point through the ellipsoid center as c1
+    // (the two tangent points from an end point lie on opposite sides of
+    // this line); otherwise, the solve is restarted from c1. The warm start
+    // is only used when the cold start would begin at c1.
+    const bool warm_start =
+        aWrapResult.r1 == aWrapResult.c1 && aWrapResult.r2 == aWrapResult.c1 &&
+        previousWrap.startPoint == aWrapResult.startPoint &&
+        previousWrap.endPoint == aWrapResult.endPoint &&
+        previousWrap.r1.isFinite() && previousWrap.r2.isFinite();
+    auto findTangentPoint = [&](double pe, SimTK::Vec3& r, SimTK::Vec3& p,
+            const SimTK::Vec3& previous_r) {
+        if (warm_start) {
+            // The previous tangent points were transformed to the frame that
+            // the ellipsoid is attached to (see wrapPathSegment()).
+            SimTK::Vec3 warm_r =
+                _pose.shiftBaseStationToFrame(previous_r) * aWrapResult.factor;
+            if (calcTangentPoint(pe, warm_r, p, m, a, vs, vs4)) {
+                const SimTK::Vec3 pm = m - p;
+                const double side_r = SimTK::dot(SimTK::cross(warm_r - p, pm), vs);
+                const double side_c1 =
+                    SimTK::dot(SimTK::cross(aWrapResult.c1 - p, pm), vs);
+                if (side_r * side_c1 > 0.0) {
+                    r = warm_r;
+                    return;
+                }
+            }
+        }
+        calcTangentPoint(pe, r, p, m, a, vs, vs4);
+    };
+    findTangentPoint(p1e, aWrapResult.r1, p1, previousWrap.r1);
+    findTangentPoint(p2e, aWrapResult.r2, p2, previousWrap.r2);
 
     // create a series of line segments connecting r1 & r2 along the
     // surface of the ellipsoid.
@@ -609,7 +642,8 @@ calc_wrap_path:
  * @param a Ellipsoid axis
  * @param vs Plane vector
  * @param vs4 Plane coefficient
- * @return '1' if the point was adjusted, '0' otherwise
+ * @return '1' if the point satisfies the constraints (to within
+ * ELLIPSOID_TINY), '0' if the solver did not converge
  */
 int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1, SimTK::Vec3& m,
                                                 SimTK::Vec3& a, SimTK::Vec3& vs, double vs4) const
@@ -793,6 +827,9 @@ int WrapEllipsoid::calcTangentPoint(double p1e, SimTK::Vec3& r1, SimTK::Vec3& p1
             ssq = SQR(ee[0]) + SQR(ee[1]) + SQR(ee[2]) + SQR(ee[3]);
             ssqo = ssq;     
         }
+
+        if (ssq > ELLIPSOID_TINY)
+            return 0;
     }   
     return 1;
 
@@ -28,7 +28,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <math.h>
+#include <cmath>
 #include "WrapMath.h"
 #include <OpenSim/Common/Mtx.h>
 #include <OpenSim/Common/SimmMacros.h>
@@ -343,3 +343,167 @@ RotateMatrixQuaternion(double matrix[][4], const double quat[4])
 
     Mtx::Multiply(4, 4, 4, (double*)matrix, (double*)n, (double*)matrix);
 }
+
+/* Length of the shortest path between two points, at distances p and s from
+ * the center of a circle (in 2D) or a sphere, that does not enter the circle
+ * or sphere. theta is the angle between the points as seen from the center,
+ * and straight is the distance between the points. The path wraps if the
+ * angle is larger than the sum of the angles from each point to its tangent
+ * point.
+ */
+static inline double
+calcWrapLength(double p, double s, double theta, double straight, double r)
+{
+    const bool outside = p > r && s > r;
+    // Avoid NaNs from points inside the surface; those entries are unused.
+    const double rp = outside ? r / p : 1.0;
+    const double rs = outside ? r / s : 1.0;
+    const double excess = theta - acos(rp) - acos(rs);
+    const double wrapped = p * sqrt(1.0 - rp * rp) + s * sqrt(1.0 - rs * rs)
+        + r * excess;
+    return (outside && excess > 0.0) ? wrapped : straight;
+}
+
+/* Compute the lengths of the shortest paths between pairs of points
+ * around a sphere centered at the origin.
+ * @param n The number of point pairs
+ * @param px, py, pz The coordinates of the first points
+ * @param sx, sy, sz The coordinates of the second points
+ * @param radius The radius of the sphere
+ * @param lengths The n path lengths (output)
+ */
+void WrapMath::
+CalcSphereWrapLengths(int n,
+    const double* px, const double* py, const double* pz,
+    const double* sx, const double* sy, const double* sz,
+    double radius, double* lengths)
+{
+    for (int i = 0; i < n; ++i) {
+        const double dx = sx[i] - px[i];
+        const double dy = sy[i] - py[i];
+        const double dz = sz[i] - pz[i];
+        const double straight = sqrt(dx * dx + dy * dy + dz * dz);
+
+        const double p = sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+        const double s = sqrt(sx[i] * sx[i] + sy[i] * sy[i] + sz[i] * sz[i]);
+        const double cx = py[i] * sz[i] - pz[i] * sy[i];
+        const double cy = pz[i] * sx[i] - px[i] * sz[i];
+        const double cz = px[i] * sy[i] - py[i] * sx[i];
+        const double theta = atan2(sqrt(cx * cx + cy * cy + cz * cz),
+            px[i] * sx[i] + py[i] * sy[i] + pz[i] * sz[i]);
+
+        lengths[i] = calcWrapLength(p, s, theta, straight, radius);
+    }
+}
+
+/* Compute the lengths of the shortest paths between pairs of points
+ * around an infinite cylinder whose axis is the z axis. The shortest path
+ * is a helix that, projected onto the xy plane, is the shortest path around
+ * the circle; unrolling the cylinder shows that the length is the hypotenuse
+ * of the projected length and the change in z.
+ * @param n The number of point pairs
+ * @param px, py, pz The coordinates of the first points
+ * @param sx, sy, sz The coordinates of the second points
+ * @param radius The radius of the cylinder
+ * @param lengths The n path lengths (output)
+ */
+void WrapMath::
+CalcCylinderWrapLengths(int n,
+    const double* px, const double* py, const double* pz,
+    const double* sx, const double* sy, const double* sz,
+    double radius, double* lengths)
+{
+    for (int i = 0; i < n; ++i) {
+        const double dx = sx[i] - px[i];
+        const double dy = sy[i] - py[i];
+        const double dz = sz[i] - pz[i];
+        const double straight = sqrt(dx * dx + dy * dy);
+
+        const double p = sqrt(px[i] * px[i] + py[i] * py[i]);
+        const double s = sqrt(sx[i] * sx[i] + sy[i] * sy[i]);
+        const double theta = atan2(fabs(px[i] * sy[i] - py[i] * sx[i]),
+            px[i] * sx[i] + py[i] * sy[i]);
+
+        const double planar = calcWrapLength(p, s, theta, straight, radius);
+        lengths[i] = sqrt(planar * planar + dz * dz);
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Calculate the residual whose root gives the point on the line through
+ * p1 and p2 that is nearest to the circle that forms the axis of a torus.
+ *
+ * @param p1 One point on the line
+ * @param p2 Another point on the line
+ * @param radius The radius of the circle
+ * @param u The distance along the line from p1 towards p2
+ * @param dResid_du The derivative of the residual with respect to u (output)
+ * @return The residual
+ */
+double WrapMath::
+CalcTorusCircleResidual(const Vec3& p1, const Vec3& p2, double radius,
+    double u, double* dResid_du)
+{
+    const Vec3 n = (p2 - p1) / (p2 - p1).norm();
+
+    const double c2 = 2.0 * (p1[0] * n[0] + p1[1] * n[1] + p1[2] * n[2]);
+    const double c3 = p1[0] * n[0] + p1[1] * n[1];
+    const double c4 = n[0] * n[0] + n[1] * n[1];
+    const double c5 = p1[0] * p1[0] + p1[1] * p1[1];
+
+    // rho is the distance of x(u) from the z axis, and a = rho * drho/du.
+    const double rho2 = u * (c4 * u + 2.0 * c3) + c5;
+    const double rho = sqrt(rho2);
+    const double a = c4 * u + c3;
+
+    if (dResid_du)
+        *dResid_du = 2.0 - 4.0 * radius * (c4 * rho2 - a * a) / (rho2 * rho);
+    return c2 + 2.0 * u - 4.0 * radius * a / rho;
+}
+
+//_____________________________________________________________________________
+/**
+ * Solve for the root of CalcTorusCircleResidual() with a Levenberg-Marquardt
+ * method (on the squared residual) that uses the analytic derivative.
+ *
+ * @param p1 One point on the line
+ * @param p2 Another point on the line
+ * @param radius The radius of the circle
+ * @param u The initial guess; set to the solution
+ * @param maxIterations The maximum number of iterations
+ * @return The number of iterations, or -1 if the solver did not converge
+ */
+int WrapMath::
+SolveTorusCircleResidual(const Vec3& p1, const Vec3& p2, double radius,
+    double& u, int maxIterations)
+{
+    const double tol = 1e-12 * (radius + p1.norm() + p2.norm());
+
+    double J;
+    double resid = CalcTorusCircleResidual(p1, p2, radius, u, &J);
+    if (!std::isfinite(resid) || !std::isfinite(J)) return -1;
+    double lambda = 1e-3 * J * J;
+
+    for (int iter = 0; iter < maxIterations; ++iter) {
+        if (fabs(resid) <= tol) return iter;
+
+        const double step = -J * resid / (J * J + lambda);
+        double trialJ;
+        const double trialResid =
+            CalcTorusCircleResidual(p1, p2, radius, u + step, &trialJ);
+        if (std::isfinite(trialResid) && std::isfinite(trialJ) &&
+            fabs(trialResid) < fabs(resid)) {
+            u += step;
+            resid = trialResid;
+            J = trialJ;
+            lambda *= 0.1;
+            if (fabs(step) <= tol) return iter + 1;
+        } else {
+            // Shorten the step; the small constant keeps lambda from
+            // remaining zero.
+            lambda = 10.0 * lambda + 1e-3 * J * J + SimTK::Eps;
+        }
+    }
+    return fabs(resid) <= tol ? maxIterations : -1;
+}
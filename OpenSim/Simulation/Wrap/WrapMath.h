@@ -76,6 +76,56 @@ public:
     static void
         RotateMatrixQuaternion(double matrix[][4], const double quat[4]); 
 
+    /** @name Batched wrapping
+    Compute the length of the shortest path between each of `n` pairs of
+    points P and S that does not penetrate a wrap surface. The coordinates
+    are given in structure-of-arrays layout (px[i], py[i], pz[i] is the i-th
+    P), expressed in the frame of the wrap surface, whose center is at the
+    origin. The loops have no data-dependent control flow, so they can be
+    vectorized by the compiler, which makes these functions useful for
+    sampling path lengths over large grids of poses. A pair for which either
+    point is inside the surface gets the straight-line distance (as with
+    WrapObject::insideRadius). These functions do not apply the quadrant
+    constraints of a WrapObject, and cylinders are infinitely long. */
+    /// @{
+    /** A sphere with the given radius. */
+    static void
+        CalcSphereWrapLengths(int n,
+        const double* px, const double* py, const double* pz,
+        const double* sx, const double* sy, const double* sz,
+        double radius, double* lengths);
+    /** A cylinder with the given radius whose axis is the z axis. */
+    static void
+        CalcCylinderWrapLengths(int n,
+        const double* px, const double* py, const double* pz,
+        const double* sx, const double* sy, const double* sz,
+        double radius, double* lengths);
+    /// @}
+
+    /** @name Torus wrapping
+    WrapTorus places the wrapping cylinder at the point of the circle that
+    forms the axis of the torus (radius R, centered at the origin in the
+    z = 0 plane) nearest to the line through p1 and p2. The points of the
+    line are x(u) = p1 + u n, with n the unit vector from p1 to p2, and the
+    nearest point is found from the root of the residual
+    r(u) = d|x|^2/du - 4 R d(rho)/du, where rho is the distance of x from
+    the z axis. */
+    /// @{
+    /** The residual r(u) and, if `dResid_du` is not null, its derivative
+    with respect to u. */
+    static double
+        CalcTorusCircleResidual(const SimTK::Vec3& p1, const SimTK::Vec3& p2,
+        double radius, double u, double* dResid_du = nullptr);
+    /** Minimize r(u)^2 with Levenberg-Marquardt iterations that use the
+    analytic derivative of the residual. `u` holds the initial guess and is
+    set to the solution. Returns the number of iterations, or -1 if the
+    residual did not converge within `maxIterations` (`u` is then the best
+    value found). */
+    static int
+        SolveTorusCircleResidual(const SimTK::Vec3& p1, const SimTK::Vec3& p2,
+        double radius, double& u, int maxIterations = 30);
+    /// @}
+
 
 //=============================================================================
 };  // END class WrapMath
@@ -140,6 +140,21 @@ void WrapObject::extendFinalizeFromProperties()
     }
 }
 
+void WrapObject::extendAddToSystem(SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    this->_transformInGroundCV = addCacheVariable("transform_in_ground",
+            SimTK::Transform(), SimTK::Stage::Position);
+}
+
+const SimTK::Transform& WrapObject::getTransformInGround(
+        const SimTK::State& s) const {
+    if (!isCacheVariableValid(s, _transformInGroundCV)) {
+        setCacheVariableValue(s, _transformInGroundCV,
+                getFrame().getTransformInGround(s) * _pose);
+    }
+    return getCacheVariableValue(s, _transformInGroundCV);
+}
+
 int WrapObject::wrapPathSegment(const SimTK::State& s, 
                                 AbstractPathPoint& aPoint1, AbstractPathPoint& aPoint2,
                                 const PathWrap& aPathWrap, 
@@ -151,17 +166,13 @@ int WrapObject::wrapPathSegment(const SimTK::State& s,
     Vec3 pt2(0.0);
 
     // Convert the path points from the frames of the bodies they are attached
-    // to, to the frame of the wrap object's body
-    pt1 = aPoint1.getParentFrame()
-        .findStationLocationInAnotherFrame(s, aPoint1.getLocation(s), getFrame());
-    
-    pt2 = aPoint2.getParentFrame()
-        .findStationLocationInAnotherFrame(s, aPoint2.getLocation(s), getFrame());
-
-    // Convert the path points from the frame of the wrap object's body
-    // into the frame of the wrap object
-    pt1 = _pose.shiftBaseStationToFrame(pt1);
-    pt2 = _pose.shiftBaseStationToFrame(pt2);
+    // to, to the frame of the wrap object (through ground, using the cached
+    // transform of the wrap object).
+    const SimTK::Transform& X_GW = getTransformInGround(s);
+    pt1 = X_GW.shiftBaseStationToFrame(aPoint1.getParentFrame()
+            .findStationLocationInGround(s, aPoint1.getLocation(s)));
+    pt2 = X_GW.shiftBaseStationToFrame(aPoint2.getParentFrame()
+            .findStationLocationInGround(s, aPoint2.getLocation(s)));
 
     return_code = wrapLine(s, pt1, pt2, aPathWrap, aWrapResult, p_flag);
 
@@ -109,6 +109,10 @@ public:
         return getProperty_quadrant().getValueIsDefault();
     }
     const SimTK::Transform& getTransform() const { return _pose; }
+    /** The transform of the wrap object (its frame with getTransform()
+    applied) in ground. This is cached in the state, so all paths that wrap
+    over this object at the same state share it. */
+    const SimTK::Transform& getTransformInGround(const SimTK::State& s) const;
     virtual const char* getWrapTypeName() const = 0;
 
     // TODO: total SIMM hack!
@@ -146,6 +150,7 @@ protected:
      * based on the name of the quadrant. finalizeFromProperties() should be
      * called whenever the quadrant property changes. */
     void extendFinalizeFromProperties() override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
     void updateFromXMLNode(SimTK::Xml::Element& node, int versionNumber)
         override;
@@ -155,6 +160,8 @@ private:
 
     SimTK::ReferencePtr<const PhysicalFrame> _frame;
 
+    mutable CacheVariable<SimTK::Transform> _transformInGroundCV;
+
 protected:
 
     WrapQuadrant _quadrant{ WrapQuadrant::allQuadrants };
@@ -74,6 +74,12 @@ public:
     WrapResult(const WrapResult& other);
     WrapResult& operator=(const WrapResult& aWrapResult);
 
+    friend std::ostream& operator<<(std::ostream& o, const WrapResult& wr) {
+        o << "WrapResult: r1 = " << wr.r1 << ", r2 = " << wr.r2
+          << ", wrap_path_length = " << wr.wrap_path_length << std::endl;
+        return o;
+    }
+
 private:
     void copyData(const WrapResult& aWrapResult);
 
@@ -27,9 +27,10 @@
 #include "WrapTorus.h"
 #include "WrapCylinder.h"
 #include "WrapResult.h"
+#include "WrapMath.h"
+#include "PathWrap.h"
 #include <OpenSim/Common/ModelDisplayHints.h>
 #include <OpenSim/Common/SimmMacros.h>
-#include <OpenSim/Common/Lmdif.h>
 #include <OpenSim/Common/Mtx.h>
 #include <OpenSim/Simulation/Model/PhysicalFrame.h>
 #include <OpenSim/Common/ScaleSet.h>
@@ -211,7 +212,19 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
     //bool far_side_wrap = false;
     aFlag = true;
 
-    if (findClosestPoint(get_outer_radius(), &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2], _wrapSign, _wrapAxis) == 0)
+    // Start the search from the end of the line at aPoint1 at the point
+    // nearest to the previous tangent points, which is close to the
+    // solution when the path moves continuously.
+    double u1 = 0.0;
+    const WrapResult& previousWrap = aPathWrap.getPreviousWrap(s);
+    const SimTK::Vec3 line = aPoint2 - aPoint1;
+    if (previousWrap.r1.isFinite() && previousWrap.r2.isFinite() &&
+            line.norm() > 0.0) {
+        u1 = ~(0.5 * (previousWrap.r1 + previousWrap.r2) - aPoint1) * line /
+             line.norm();
+    }
+
+    if (findClosestPoint(get_outer_radius(), &aPoint1[0], &aPoint2[0], &closestPt[0], &closestPt[1], &closestPt[2], _wrapSign, _wrapAxis, u1) == 0)
         return noWrap;
 
     // Now put a cylinder at closestPt and call the cylinder wrap code.
@@ -256,7 +269,8 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
 /**
  * Calculate the closest point on an origin-centered circle on the Z=0 plane
  * to the line between p1 and p2. This circle represents the inner axis of
- * the torus.
+ * the torus. The line is searched twice, starting from each end, and the
+ * residual is solved with WrapMath::SolveTorusCircleResidual().
  *
  * @param radius The radius of the circle
  * @param p1 One end of the line
@@ -266,46 +280,27 @@ int WrapTorus::wrapLine(const SimTK::State& s, SimTK::Vec3& aPoint1, SimTK::Vec3
  * @param zc The Z coordinate of the closest point
  * @param wrap_sign If wrap is constrained to a quadrant, the sign of the relevant axis
  * @param wrap_axis If wrap is constrained to a quadrant, the relevant axis
+ * @param u1 Initial guess for the distance from p1 along the line in the first pass
  * @return '1' if a closest point was found, '0' if there was an error while trying to constrain the wrap
  */
 int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
                                           double* xc, double* yc, double* zc,
-                                          int wrap_sign, int wrap_axis) const
+                                          int wrap_sign, int wrap_axis,
+                                          double u1) const
 {
-   int info;                  // output flag
-   int num_func_calls;        // number of calls to func (nfev)
-   int ldfjac = 1;            // leading dimension of fjac (nres)
-   int numResid = 1;
-   int numQs = 1;
-   double q[2], resid[2], fjac[2];            // m X n array
-   CircleCallback cb;
    bool constrained = (bool) (wrap_sign != 0);
-   // solution parameters
-   int mode = 1, nprint = 0, max_iter = 500;
-   double ftol = 1e-4, xtol = 1e-4, gtol = 0.0;
-   double epsfcn = 0.0, step_factor = 0.2;
-   // work arrays
-   int ipvt[2];
-   double diag[2], qtf[2], wa1[2], wa2[2], wa3[2], wa4[2];
    // Circle variables
    double u, mag, nx, ny, nz, x, y, z, a1[3], a2[3], distance1, distance2, betterPt = 0;
+   const Vec3 pt1(p1[0], p1[1], p1[2]);
+   const Vec3 pt2(p2[0], p2[1], p2[2]);
 
-   cb.p1[0] = p1[0];
-   cb.p1[1] = p1[1];
-   cb.p1[2] = p1[2];
-   cb.p2[0] = p2[0];
-   cb.p2[1] = p2[1];
-   cb.p2[2] = p2[2];
-   cb.r = radius;
-
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
-
-   u = q[0];
+   u = u1;
+   if (WrapMath::SolveTorusCircleResidual(pt1, pt2, radius, u) < 0 && u1 != 0.0)
+   {
+      // The warm start failed; start from the end of the line instead.
+      u = 0.0;
+      WrapMath::SolveTorusCircleResidual(pt1, pt2, radius, u);
+   }
 
    mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
 
@@ -325,24 +320,8 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    distance1 = sqrt(x*x + y*y + z*z + radius*radius - 2.0 * radius * sqrt(x*x + y*y));
 
    // Perform the second pass, switching the order of the two points.
-   cb.p1[0] = p2[0];
-   cb.p1[1] = p2[1];
-   cb.p1[2] = p2[2];
-   cb.p2[0] = p1[0];
-   cb.p2[1] = p1[1];
-   cb.p2[2] = p1[2];
-   cb.r = radius;
-
-   q[0] = 0.0;
-
-   lmdif_C(calcCircleResids, numResid, numQs, q, resid,
-           ftol, xtol, gtol, max_iter, epsfcn, diag, mode, step_factor,
-           nprint, &info, &num_func_calls, fjac, ldfjac, ipvt, qtf,
-           wa1, wa2, wa3, wa4, (void*)&cb);
-
-   u = q[0];
-
-   mag = sqrt((p2[0]-p1[0])*(p2[0]-p1[0]) + (p2[1]-p1[1])*(p2[1]-p1[1]) + (p2[2]-p1[2])*(p2[2]-p1[2]));
+   u = 0.0;
+   WrapMath::SolveTorusCircleResidual(pt2, pt1, radius, u);
 
    nx = (p1[0]-p2[0]) / mag;
    ny = (p1[1]-p2[1]) / mag;
@@ -414,44 +393,6 @@ int WrapTorus::findClosestPoint(double radius, double p1[], double p2[],
    return 1;
 }
 
-//_____________________________________________________________________________
-/**
- * A utility function used by findClosestPoint. The single residual that it
- * calculates is the distance between the current point and the circle.
- *
- * @param numResid The number of residuals (1)
- * @param numQs The number of degrees of freedom (1)
- * @param q Array of values of the degrees of freedom
- * @param resid Array of residuals to be calculated
- * @param flag2 A status flag
- * @param ptr Pointer to data structure containing current point and circle radius
- */
-void WrapTorus::calcCircleResids(int numResid, int numQs, double q[],
-                                            double resid[], int *flag2, void *ptr)
-{
-   double mag, nx, ny, nz, u;
-   double c2, c3, c4, c5/*, c6*/;
-   CircleCallback *cb = (CircleCallback*)ptr;
-
-   u = q[0];
-
-   mag = sqrt((cb->p2[0]-cb->p1[0])*(cb->p2[0]-cb->p1[0]) + (cb->p2[1]-cb->p1[1])*(cb->p2[1]-cb->p1[1]) +
-      (cb->p2[2]-cb->p1[2])*(cb->p2[2]-cb->p1[2]));
-
-   nx = (cb->p2[0]-cb->p1[0]) / mag;
-   ny = (cb->p2[1]-cb->p1[1]) / mag;
-   nz = (cb->p2[2]-cb->p1[2]) / mag;
-
-   c2 = 2.0 * (cb->p1[0]*nx + cb->p1[1]*ny + cb->p1[2]*nz);
-   c3 = cb->p1[0]*nx + cb->p1[1]*ny;
-   c4 = nx*nx + ny*ny;
-   c5 = cb->p1[0]*cb->p1[0] + cb->p1[1]*cb->p1[1];
-   //c6 = sqrt (u * u * c4 + 2.0 * c3 * u + c5);
-
-   resid[0] = c2 + 2.0 * u - 2.0 * cb->r * (2.0 * c4 * u + 2.0 * c3) / sqrt (u * u * c4 + 2.0 * c3 * u + c5);
-}
-
-
 // Implement generateDecorations by WrapTorus to replace the previous out of place implementation
 // in ModelVisualizer, not implemented yet in API visualizer
 void WrapTorus::generateDecorations(bool fixed, const ModelDisplayHints& hints, const SimTK::State& state,
@@ -43,11 +43,6 @@ class WrapResult;
 class OSIMSIMULATION_API WrapTorus : public WrapObject {
 OpenSim_DECLARE_CONCRETE_OBJECT(WrapTorus, WrapObject);
 
-private:
-    struct CircleCallback {
-        double p1[3], p2[3], r;
-    };
-
 public:
 //==============================================================================
 // PROPERTIES
@@ -89,9 +84,7 @@ private:
 
     int findClosestPoint(double radius, double p1[], double p2[],
         double* xc, double* yc, double* zc,
-        int wrap_sign, int wrap_axis) const;
-    static void calcCircleResids(int numResid, int numQs, double q[],
-        double resid[], int *flag2, void *ptr);
+        int wrap_sign, int wrap_axis, double u1 = 0.0) const;
 
 //=============================================================================
 };  // END of class WrapTorus
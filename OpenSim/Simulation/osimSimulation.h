@@ -37,10 +37,12 @@
 #include "Model/ContactHalfSpace.h"
 #include "Model/ContactMesh.h"
 #include "Model/ContactSphere.h"
+#include "Model/ContactEventHandler.h"
 #include "Model/CoordinateSet.h"
 #include "Model/ElasticFoundationForce.h"
 #include "Model/HuntCrossleyForce.h"
 #include "Model/SmoothSphereHalfSpaceForce.h"
+#include "Model/BatchedSmoothSphereHalfSpaceForce.h"
 #include "Model/Ligament.h"
 #include "Model/Blankevoort1991Ligament.h"
 #include "Model/JointSet.h"
@@ -52,6 +54,9 @@
 #include "Model/ConditionalPathPoint.h"
 #include "Model/MovingPathPoint.h"
 #include "Model/GeometryPath.h"
+#include "Model/FunctionBasedPath.h"
+#include "Model/ModelCache.h"
+#include "Model/PolynomialPathFitter.h"
 #include "Model/PrescribedForce.h"
 #include "Model/PointToPointSpring.h"
 #include "Model/ExpressionBasedPointToPointForce.h"
@@ -73,12 +78,19 @@
 #include "Model/Ground.h"
 
 #include "Manager/Manager.h"
+#include "Manager/SimulationCheckpoint.h"
+#include "Manager/ManagerEnsemble.h"
+#include "Manager/IMEXStepper.h"
+#include "Manager/ModelBatch.h"
+#include "ModelSceneExporter.h"
+#include "KinematicsSnapshot.h"
 
 #include "Control/ControlSet.h"
 #include "Control/ControlSetController.h"
 #include "Control/ControlConstant.h"
 #include "Control/ControlLinear.h"
 #include "Control/PrescribedController.h"
+#include "Control/StreamingController.h"
 #include "Wrap/PathWrap.h"
 #include "Wrap/PathWrapSet.h"
 #include "Wrap/WrapCylinder.h"
@@ -122,6 +134,8 @@
 #include "Reference.h"
 #include "Solver.h"
 #include "StatesTrajectory.h"
+#include "StreamingInverseDynamicsSolver.h"
+#include "CompactStatesTrajectory.h"
 #include "StatesTrajectoryReporter.h"
 #include "TableProcessor.h"
 #include "OpenSense/OpenSenseUtilities.h"
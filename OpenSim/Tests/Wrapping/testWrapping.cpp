@@ -47,6 +47,8 @@ public:
 };
 
 void testWrapCylinder();
+void testWrapEllipsoidWarmStart();
+void testWrapTorusWarmStart();
 void testWrapObjectUpdateFromXMLNode30515();
 void simulate(Model& osimModel, State& si, double initialTime, double finalTime);
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation=0.5);
@@ -67,6 +69,20 @@ int main()
         std::cout << "Exception: " << e.what() << std::endl;
         failures.push_back("TestShoulderModel (multiple wrap)"); }
 
+    try{
+        testWrapEllipsoidWarmStart();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapEllipsoidWarmStart");
+    }
+
+    try{
+        testWrapTorusWarmStart();
+    } catch (const std::exception& e) {
+         std::cout << "Exception: " << e.what() << std::endl;
+         failures.push_back("testWrapTorusWarmStart");
+    }
+
     try{
         testWrapObjectUpdateFromXMLNode30515();
     } catch (const std::exception& e) {
@@ -403,6 +419,101 @@ void testWrapCylinder()
 }
 
 
+// The ellipsoid tangent points are warm-started from the previous wrap with
+// the same state. Sweep a joint in small steps (as an integrator would) and
+// compare to paths that are computed from a cold start.
+void testWrapEllipsoidWarmStart()
+{
+    Model model;
+    model.setName("testWrapEllipsoidWarmStart");
+
+    auto& ground = model.updGround();
+    auto body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.1, 0.1, 0.01));
+    model.addComponent(body);
+    auto joint = new PinJoint("pin", ground, Vec3(0), Vec3(0),
+            *body, Vec3(-0.3, 0, 0), Vec3(0));
+    model.addComponent(joint);
+
+    WrapEllipsoid* ellipsoid = new WrapEllipsoid();
+    ellipsoid->setName("ellipsoid");
+    ellipsoid->set_dimensions(Vec3(0.1, 0.07, 0.05));
+    ground.addWrapObject(ellipsoid);
+
+    PathSpring* spring = new PathSpring("spring", 1.0, 0.1, 0.01);
+    spring->updGeometryPath().
+        appendNewPathPoint("origin", ground, Vec3(-0.3, 0.02, 0.01));
+    spring->updGeometryPath().
+        appendNewPathPoint("insert", *body, Vec3(0, 0.02, 0));
+    spring->updGeometryPath().addPathWrap(*ellipsoid);
+    model.addComponent(spring);
+
+    SimTK::State& s = model.initSystem();
+    auto& coord = joint->updCoordinate();
+
+    int nsteps = 100;
+    for (int i = 0; i <= nsteps; ++i) {
+        coord.setValue(s, -0.5 + i * 1.0 / nsteps);
+        model.realizePosition(s);
+        const double warmLength = spring->getLength(s);
+
+        // Discarding the instance discards the previous wrap.
+        SimTK::State sCold = s;
+        sCold.invalidateAllCacheAtOrAbove(Stage::Instance);
+        model.realizePosition(sCold);
+        const double coldLength = spring->getLength(sCold);
+
+        ASSERT_EQUAL<double>(coldLength, warmLength, 1e-5, __FILE__, __LINE__,
+            "Warm-started ellipsoid wrap does not match the cold start.");
+    }
+}
+
+void testWrapTorusWarmStart()
+{
+    Model model;
+    model.setName("testWrapTorusWarmStart");
+
+    auto& ground = model.updGround();
+    auto body = new OpenSim::Body("body", 1, Vec3(0), Inertia(0.1, 0.1, 0.01));
+    model.addComponent(body);
+    // The insertion circles the axis of the torus as the pin rotates.
+    auto joint = new PinJoint("pin", ground, *body);
+    model.addComponent(joint);
+
+    WrapTorus* torus = new WrapTorus();
+    torus->setName("torus");
+    torus->set_inner_radius(0.01);
+    torus->set_outer_radius(0.05);
+    ground.addWrapObject(torus);
+
+    // The path passes through the tube of the torus.
+    PathSpring* spring = new PathSpring("spring", 1.0, 0.1, 0.01);
+    spring->updGeometryPath().
+        appendNewPathPoint("origin", ground, Vec3(0.045, 0, -0.1));
+    spring->updGeometryPath().
+        appendNewPathPoint("insert", *body, Vec3(0.045, 0, 0.1));
+    spring->updGeometryPath().addPathWrap(*torus);
+    model.addComponent(spring);
+
+    SimTK::State& s = model.initSystem();
+    auto& coord = joint->updCoordinate();
+
+    int nsteps = 100;
+    for (int i = 0; i <= nsteps; ++i) {
+        coord.setValue(s, -0.5 + i * 1.0 / nsteps);
+        model.realizePosition(s);
+        const double warmLength = spring->getLength(s);
+
+        // Discarding the instance discards the previous wrap.
+        SimTK::State sCold = s;
+        sCold.invalidateAllCacheAtOrAbove(Stage::Instance);
+        model.realizePosition(sCold);
+        const double coldLength = spring->getLength(sCold);
+
+        ASSERT_EQUAL<double>(coldLength, warmLength, 1e-5, __FILE__, __LINE__,
+            "Warm-started torus wrap does not match the cold start.");
+    }
+}
+
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation)
 {
     // Create a new OpenSim model
@@ -529,6 +529,37 @@ void testComponentListComparisonOperators() {
     SimTK_TEST(mutIt != constIt);
 }
 
+// The traversal is cached between ComponentLists, so it must be updated when
+// components are added, and must not be shared with copies.
+void testComponentListAfterTreeChanges() {
+    Model model(modelFilename);
+    model.finalizeFromProperties();
+    const unsigned numBodies = model.countNumComponents<OpenSim::Body>();
+    const unsigned numComponents = model.countNumComponents();
+    // Repeated requests give the same result.
+    SimTK_TEST(model.countNumComponents() == numComponents);
+
+    auto* body = new OpenSim::Body("extra", 1, SimTK::Vec3(0),
+            SimTK::Inertia(1));
+    model.addBody(body);
+    model.addJoint(new PinJoint("extra_pin", model.getGround(), *body));
+    model.finalizeFromProperties();
+    SimTK_TEST(model.countNumComponents<OpenSim::Body>() == numBodies + 1);
+    SimTK_TEST(model.countNumComponents() > numComponents);
+
+    // A copy builds its own traversal, over its own components.
+    Model copy(model);
+    copy.finalizeFromProperties();
+    SimTK_TEST(copy.countNumComponents() == model.countNumComponents());
+    for (const auto& comp : copy.getComponentList()) {
+        SimTK_TEST(&comp.getRoot() == &copy);
+    }
+
+    // Lists of a subcomponent include only its subtree.
+    const auto& joint = model.getComponent<Joint>("/jointset/extra_pin");
+    SimTK_TEST(joint.countNumComponents<Coordinate>() == 1);
+}
+
 int main() {
     LoadOpenSimLibrary("osimActuators");
     SimTK_START_TEST("testIterators");
@@ -537,6 +568,7 @@ int main() {
         SimTK_SUBTEST(testComponentListNonConstWithNonConstIterator);
         SimTK_SUBTEST(testComponentListComparisonOperators);
         SimTK_SUBTEST(testNestedComponentListConsistency);
+        SimTK_SUBTEST(testComponentListAfterTreeChanges);
     SimTK_END_TEST();
 }
 
@@ -21,7 +21,9 @@
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
 #include <OpenSim/Simulation/Control/ControlLinear.h>
@@ -35,6 +37,11 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -59,6 +66,7 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -79,6 +87,7 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(aLoadModelAndInput)
 {
@@ -111,6 +120,7 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -171,6 +181,7 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +202,7 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
 
     _statesStore = NULL;
 
@@ -236,6 +248,13 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used to process the frames of the states. The default value is 1, so the frames "
+                 "are processed serially. A value of 0 uses all available hardware threads. Multiple threads are "
+                 "only used if every analysis records its results in storages and does not depend on previous frames.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("number_of_threads");
+    _propertySet.append( &_numThreadsProp );
+
 }
 
 
@@ -259,6 +278,7 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -311,6 +331,9 @@ createStatesStorageFromCoordinatesAndSpeeds(const Model& aModel, const Storage&
     // that are not zero (for example muscle activations and fiber-lengths)
     SimTK::Vector stateValues = aModel.getStateVariableValues(s);
 
+    // Realize each state only as far as the analyses that are on need.
+    const SimTK::Stage requiredStage = analysisSet.getRequiredStage();
+
     for(int index=0; index<aQStore.getSize(); index++) {
         double t;
         aQStore.getTime(index,t);
@@ -525,6 +548,7 @@ bool AnalyzeTool::run()
 }
 bool AnalyzeTool::run(bool plotting)
 {
+    OPENSIM_TRACE_SCOPE_CATEGORY("AnalyzeTool::run", "tool");
     //cout<<"Running analyze tool "<<getName()<<"."<<endl;
 
     // CHECK FOR A MODEL
@@ -589,8 +613,16 @@ bool AnalyzeTool::run(bool plotting)
     //  _statesStore->getTime(++iInitial,ti);
     //}
 
+    int numThreads = _numThreads > 0 ? _numThreads : getNumAvailableThreads();
+    if(numThreads > 1 && !plotting && !canRunInParallel()) numThreads = 1;
+
     log_info("Executing the analyses from {} to {}...", ti, tf);
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    if(numThreads > 1) {
+        const ThreadReservation reservation(numThreads);
+        runInParallel(iInitial, iFinal, numThreads);
+    } else {
+        run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    }
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -694,8 +726,8 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
                     "time = {}. Reason: {}.", t, e.what());
             }
         }
-        // Make sure model is at least ready to provide kinematics
-        aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+        // Make sure model is ready to provide what the analyses record
+        aModel.getMultibodySystem().realize(s, requiredStage);
 
         if(i==iInitial) {
             analysisSet.begin(s);
@@ -707,3 +739,104 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         }
     }
 }
+
+//_____________________________________________________________________________
+/**
+ * Check whether the frames can be divided among threads: every analysis that
+ * is on must record its results in the storages of its storage list, since
+ * these are the only results that can be merged back into the analyses of
+ * this tool's model.
+ */
+bool AnalyzeTool::canRunInParallel()
+{
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    for(int i=0;i<analysisSet.getSize();i++) {
+        Analysis& analysis = analysisSet.get(i);
+        if(analysis.getOn() && analysis.getStorageList().getSize()==0) {
+            log_warn("AnalyzeTool: analysis '{}' ({}) does not provide a "
+                     "storage list; processing the frames serially.",
+                    analysis.getName(), analysis.getConcreteClassName());
+            return false;
+        }
+    }
+    return true;
+}
+//_____________________________________________________________________________
+/**
+ * Divide the frames [iInitial, iFinal] into contiguous chunks and process each
+ * chunk on its own thread, with its own copy of the model and the analyses.
+ * The copies are created and initialized serially, since loading external
+ * loads may change the working directory. The results of the chunks are then
+ * appended, in time order, to the storages of the analyses of this tool's
+ * model, so that they can be printed as if the frames had been processed
+ * serially.
+ */
+void AnalyzeTool::runInParallel(int iInitial, int iFinal, int aNumThreads)
+{
+    // Each chunk needs at least two frames so that for each chunk, begin()
+    // and end() are called on different frames.
+    const int numFrames = iFinal - iInitial + 1;
+    const int numChunks = std::max(1, std::min(aNumThreads, numFrames/2));
+    log_info("Processing {} frames in {} chunks.", numFrames, numChunks);
+
+    std::vector<std::unique_ptr<Model>> models(numChunks);
+    std::vector<int> firstFrames(numChunks + 1);
+    for(int c=0;c<numChunks;c++) {
+        firstFrames[c] = iInitial + (int)((long long)c*numFrames/numChunks);
+        // The clone takes ownership of copies of the analyses.
+        models[c].reset(_model->clone());
+        AnalysisSet& analysisSet = models[c]->updAnalysisSet();
+        for(int i=0;i<analysisSet.getSize();i++) {
+            analysisSet.get(i).setModel(*models[c]);
+        }
+        models[c]->initSystem();
+    }
+    firstFrames[numChunks] = iFinal + 1;
+
+    std::vector<std::exception_ptr> errors(numChunks);
+    std::vector<std::thread> threads;
+    for(int c=0;c<numChunks;c++) {
+        threads.emplace_back([&, c]() {
+            try {
+                run(models[c]->updWorkingState(), *models[c], firstFrames[c],
+                        firstFrames[c+1] - 1, *_statesStore,
+                        _solveForEquilibriumForAuxiliaryStates);
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    for(const auto& error : errors) {
+        if(error) std::rethrow_exception(error);
+    }
+
+    // MERGE THE RESULTS
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    for(int i=0;i<analysisSet.getSize();i++) {
+        Analysis& analysis = analysisSet.get(i);
+        if(!analysis.getOn()) continue;
+        ArrayPtrs<Storage>& storages = analysis.getStorageList();
+        for(int c=0;c<numChunks;c++) {
+            ArrayPtrs<Storage>& chunkStorages =
+                    models[c]->updAnalysisSet().get(i).getStorageList();
+            OPENSIM_THROW_IF(chunkStorages.getSize() != storages.getSize(),
+                    Exception,
+                    "Analysis '{}' has {} storages, but its copy has {}.",
+                    analysis.getName(), storages.getSize(),
+                    chunkStorages.getSize());
+            for(int j=0;j<storages.getSize();j++) {
+                Storage& storage = *storages[j];
+                const Storage& chunkStorage = *chunkStorages[j];
+                if(c==0) {
+                    storage.purge();
+                    storage.setColumnLabels(chunkStorage.getColumnLabels());
+                    storage.setInDegrees(chunkStorage.isInDegrees());
+                }
+                for(int k=0;k<chunkStorage.getSize();k++) {
+                    storage.append(*chunkStorage.getStateVector(k));
+                }
+            }
+        }
+    }
+}
@@ -68,6 +68,9 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Number of threads over which the frames of the states are divided. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -119,6 +122,18 @@ public:
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
+    /** The number of threads used to process the frames of the states
+    (default: 1, in which case the frames are processed serially). A value
+    of 0 uses as many threads as there are hardware threads (cores). When more
+    than one thread is used, the frames are divided into contiguous chunks and
+    each chunk is processed with its own copy of the model and analyses; the
+    results of the chunks are then merged, in time order, into the analyses of
+    this tool's model. This is only valid for analyses that do not depend on
+    previous frames (e.g., MuscleAnalysis, BodyKinematics, JointReaction) and
+    that record their results in the storages of Analysis::getStorageList();
+    otherwise, the frames are processed serially. */
+    int getNumThreads() const { return _numThreads; }
+    void setNumThreads(int aNumThreads) { _numThreads = aNumThreads; }
     bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
 
@@ -142,6 +157,9 @@ public:
 #ifndef SWIG
     static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
 #endif
+private:
+    bool canRunInParallel();
+    void runInParallel(int iInitial, int iFinal, int aNumThreads);
 //=============================================================================
 };  // END of class AnalyzeTool
 
@@ -940,12 +940,40 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
 
     // ROOT SOLVE FOR EXCITATIONS
+    // The force bounds give the force errors at the ends of the brackets.
+    // The force at the end of the window is close to linear in the control
+    // (exactly so for ideal actuators), so one evaluation at the secant
+    // estimate of each control narrows the brackets, and the root solver
+    // usually needs few (or no) further integrations of the actuators.
     _predictor->setTargetForces(&_f[0]);
+    Array<double> a(xmin),b(xmax);
+    Array<double> fa(0.0,N),fb(0.0,N);
+    Array<double> xGuess(0.0,N),fGuess(0.0,N);
+    for(i=0;i<N;i++) {
+        fa[i] = fmin[i] - _f[i];
+        fb[i] = (xmax[i]==xmin[i]) ? fa[i] : fmax[i] - _f[i];
+        xGuess[i] = xmin[i];
+        if(xmax[i]!=xmin[i] && fmax[i]!=fmin[i]) {
+            double alpha = (_f[i] - fmin[i]) / (fmax[i] - fmin[i]);
+            alpha = std::max(0.0, std::min(1.0, alpha));
+            xGuess[i] = xmin[i] + alpha*(xmax[i] - xmin[i]);
+        }
+    }
+    _predictor->evaluate(s, &xGuess[0], &fGuess[0]);
+    for(i=0;i<N;i++) {
+        // Keep the half of the bracket that still contains the root.
+        if(fa[i]*fb[i] > 0.0) continue;
+        if(fGuess[i]*fa[i] > 0.0) {
+            a[i] = xGuess[i];  fa[i] = fGuess[i];
+        } else {
+            b[i] = xGuess[i];  fb[i] = fGuess[i];
+        }
+    }
     RootSolver rootSolver(_predictor);
     Array<double> tol(4.0e-3,N);
     Array<double> fErrors(0.0,N);
     Array<double> controls(0.0,N);
-    controls = rootSolver.solve(s, xmin,xmax,tol);
+    controls = rootSolver.solve(s, a,b,fa,fb,tol);
     if(_verbose) {
         log_info("CMC::computeControls, root solve (tFinal = {}):", _tf);
         log_info(" -- controls = {}", _tf, controls);
@@ -1097,10 +1125,10 @@ void CMC::computeControls(const SimTK::State& s, SimTK::Vector& controls)  const
     SimTK_ASSERT( _controlSet.getSize() == getActuatorSet().getSize() , 
         "CMC::computeControls number of controls does not match number of actuators.");
     
-    SimTK::Vector actControls(1, 0.0);
+    const std::vector<int>& controlIndices = getActuatorControlIndices();
     for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = _controlSet[_controlSetIndices[i]].getControlValue(s.getTime());
-        getActuatorSet()[i].addInControls(actControls, controls);
+        controls[controlIndices[i]] +=
+                _controlSet[_controlSetIndices[i]].getControlValue(s.getTime());
     }
 
     // double *val = &controls[0];
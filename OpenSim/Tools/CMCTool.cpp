@@ -27,6 +27,7 @@
 #include "ActuatorForceTargetFast.h"
 #include "VectorFunctionForActuators.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -383,6 +384,7 @@ operator=(const CMCTool &aTool)
  */
 bool CMCTool::run()
 {
+    OPENSIM_TRACE_SCOPE_CATEGORY("CMCTool::run", "tool");
     log_info("Running tool '{}'.", getName());
 
     // CHECK FOR A MODEL
@@ -99,6 +99,7 @@ setNull()
 {
     setupProperties();
     _model = NULL;  
+    _yDesIndexHint = 0;
 }
 /**
  ** Assignment operator.
@@ -219,7 +220,8 @@ void CorrectionController::computeControls(const SimTK::State& s, SimTK::Vector&
     // Note: yDesired[0..nq-1] will contain the generalized coordinates
     // and yDesired[nq..nq+nu-1] will contain the generalized speeds.
     Array<double> yDesired(0.0,nq+nu);
-    getDesiredStatesStorage().getDataAtTime(t, nq+nu,yDesired);
+    getDesiredStatesStorage().getDataAtTime(t, nq+nu, &yDesired[0],
+            _yDesIndexHint);
     
     SimTK::Vector actControls(1, 0.0);
 
@@ -63,6 +63,10 @@ protected:
     /** States for the simulation. */
     Storage *_yDesStore;
 
+    /** Row of the desired states found by the previous lookup, from which
+    the next lookup starts. */
+    mutable int _yDesIndexHint;
+
 
 //=============================================================================
 // METHODS
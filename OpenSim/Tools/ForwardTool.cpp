@@ -26,6 +26,7 @@
 #include <OpenSim/Common/XMLDocument.h>
 #include "ForwardTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TraceRecorder.h>
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
@@ -229,6 +230,7 @@ operator=(const ForwardTool &aTool)
  */
 bool ForwardTool::run()
 {
+    OPENSIM_TRACE_SCOPE_CATEGORY("ForwardTool::run", "tool");
     log_warn("Running tool {}...", getName());
     // CHECK FOR A MODEL
     if(_model==NULL) {
@@ -350,6 +352,15 @@ void ForwardTool::printResultsInternal()
         _model->getSimbodyEngine().convertRadiansToDegrees(statesDegrees);
         statesDegrees.setWriteSIMMHeader(true);
         statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
+
+        // Steps, failures, realizations and timing of the integration.
+        try {
+            getManager().writeIntegrationStatistics(getResultsDir() + "/" +
+                    getName() + "_integration_statistics.txt");
+        } catch (const std::exception& x) {
+            log_warn("ForwardTool: could not write the integration "
+                     "statistics: {}", x.what());
+        }
     }
 }
 
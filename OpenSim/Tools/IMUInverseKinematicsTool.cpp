@@ -1,5 +1,6 @@
 
 #include "IMUInverseKinematicsTool.h"
+#include <OpenSim/Simulation/OpenSense/IMUPlacer.h>
 #include <OpenSim/Simulation/OpenSense/OpenSenseUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -11,12 +12,26 @@
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+#include <memory>
 
 
 using namespace OpenSim;
 using namespace SimTK;
 using namespace std;
 
+namespace {
+    // The solution for a single frame, when the frames are solved in chunks
+    // on multiple threads and reported (in order) afterwards.
+    struct IMUFrameSolution {
+        SimTK::Vector q;
+        SimTK::Vector u;
+        SimTK::Array_<double> orientationErrors;
+    };
+}
+
 
 IMUInverseKinematicsTool::IMUInverseKinematicsTool()
         : InverseKinematicsToolBase() {
@@ -38,8 +53,11 @@ void IMUInverseKinematicsTool::constructProperties()
     constructProperty_sensor_to_opensim_rotations(
             SimTK::Vec3(0));
     constructProperty_orientations_file("");
+    constructProperty_sensor_offsets_file("");
     OrientationWeightSet orientationWeights;
     constructProperty_orientation_weights(orientationWeights);
+    constructProperty_number_of_threads(1);
+    constructProperty_chunk_overlap(10);
 }
 /**
 void IMUInverseKinematicsTool::
@@ -192,22 +210,93 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
         model.getVisualizer().show(s0);
         model.getVisualizer().getSimbodyVisualizer().setShowSimTime(true);
     }
+    const int nt = int(times.size());
+    const int numThreads = get_number_of_threads() > 0
+            ? get_number_of_threads()
+            : getNumAvailableThreads();
+    // Each chunk should contain at least as many frames as are used to
+    // warm start it.
+    const int overlap = std::max(0, get_chunk_overlap());
+    const int numChunks = visualizeResults ? 1 :
+            std::max(1, std::min(numThreads, nt / std::max(1, overlap)));
     int step = 0;
-    for (auto time : times) {
-        s0.updTime() = time;
-        ikSolver.track(s0);
-        if (get_report_errors()) {
-            ikSolver.computeCurrentOrientationErrors(orientationErrors);
-            modelOrientationErrors->appendRow(
-                    s0.getTime(), orientationErrors);
+    if (numChunks > 1) {
+        log_info("Solving {} frames in {} chunks (overlap: {} frames).",
+                nt, numChunks, overlap);
+        std::vector<IMUFrameSolution> solutions(nt);
+        std::vector<int> firstFrames(numChunks + 1);
+        // Each chunk has its own copy of the model and the references.
+        std::vector<std::unique_ptr<Model>> models(numChunks);
+        for (int c = 0; c < numChunks; ++c) {
+            firstFrames[c] = (int)((long long)c * nt / numChunks);
+            models[c].reset(model.clone());
+            // The copies are only used for solving; the analyses and the
+            // reporter are stepped with the original model below.
+            models[c]->updAnalysisSet().clearAndDestroy();
+        }
+        firstFrames[numChunks] = nt;
+
+        parallelFor(numChunks, [&](int c) {
+            Model& chunkModel = *models[c];
+            SimTK::State& sc = chunkModel.initSystem();
+            InverseKinematicsSolver chunkSolver(chunkModel, nullptr,
+                    std::make_shared<OrientationsReference>(oRefs),
+                    coordinateReferences);
+            chunkSolver.setAccuracy(accuracy);
+            // Solve the frames before the chunk to warm start it.
+            const int firstSolved = std::max(0, firstFrames[c] - overlap);
+            sc.updTime() = times[firstSolved];
+            chunkSolver.assemble(sc);
+            for (int i = firstSolved; i < firstFrames[c + 1]; ++i) {
+                sc.updTime() = times[i];
+                chunkSolver.track(sc);
+                if (i < firstFrames[c]) continue;
+                IMUFrameSolution& solution = solutions[i];
+                solution.q = sc.getQ();
+                solution.u = sc.getU();
+                if (get_report_errors()) {
+                    solution.orientationErrors.resize(nos);
+                    chunkSolver.computeCurrentOrientationErrors(
+                            solution.orientationErrors);
+                }
+            }
+        }, numChunks);
+
+        for (int i = 0; i < nt; ++i) {
+            s0.updTime() = times[i];
+            s0.updQ() = solutions[i].q;
+            s0.updU() = solutions[i].u;
+            if (get_report_errors()) {
+                modelOrientationErrors->appendRow(
+                        s0.getTime(), solutions[i].orientationErrors);
+            }
+            // realize to report to get reporter to pull values from model
+            analysisSet.step(s0, step++);
+            model.realizeReport(s0);
         }
-        if (visualizeResults)  
-            model.getVisualizer().show(s0);
-        else
-            log_info("Solved at time: {} s", time);
-        // realize to report to get reporter to pull values from model
-        analysisSet.step(s0, step++);
-        model.realizeReport(s0);
+        log_info("Solved {} frames.", nt);
+    } else {
+        for (auto time : times) {
+            s0.updTime() = time;
+            ikSolver.track(s0);
+            if (get_report_errors()) {
+                ikSolver.computeCurrentOrientationErrors(orientationErrors);
+                modelOrientationErrors->appendRow(
+                        s0.getTime(), orientationErrors);
+            }
+            if (visualizeResults)  
+                model.getVisualizer().show(s0);
+            else
+                log_info("Solved at time: {} s", time);
+            // realize to report to get reporter to pull values from model
+            analysisSet.step(s0, step++);
+            model.realizeReport(s0);
+        }
+        const auto trackingStats = ikSolver.getTrackingStatistics();
+        log_info("Tracked {} frames: solve time median = {:.3g} ms, "
+                 "99th percentile = {:.3g} ms, max = {:.3g} ms.",
+                trackingStats.numFrames, 1000 * trackingStats.medianTime,
+                1000 * trackingStats.p99Time, 1000 * trackingStats.maxTime);
     }
 
     auto report = ikReporter->getTable();
@@ -262,6 +351,11 @@ bool IMUInverseKinematicsTool::run(bool visualizeResults)
     if (_model.empty()) {
         _model.reset(new Model(get_model_file()));
     }
+    if (!get_sensor_offsets_file().empty()) {
+        IMUPlacer::applySensorOffsets(*_model,
+                TimeSeriesTable_<SimTK::Quaternion>(
+                        get_sensor_offsets_file()));
+    }
 
     runInverseKinematicsWithOrientationsFromFile(*_model,
                                                  get_orientations_file(),
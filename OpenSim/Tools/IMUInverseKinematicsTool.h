@@ -81,11 +81,31 @@ public:
     OpenSim_DECLARE_PROPERTY(sensor_to_opensim_rotations, SimTK::Vec3,
             "Space fixed Euler angles (XYZ order) from IMU Space to OpenSim."
             " Default to (0, 0, 0).");
+    OpenSim_DECLARE_PROPERTY(sensor_offsets_file, std::string,
+            "Name/path to a .sto file of IMU orientations (as quaternions) "
+            "relative to the frames they are attached to, as computed by "
+            "IMUPlacer::computeSensorOffsets(). If provided, the IMU frames "
+            "are placed on the model before solving, so an uncalibrated "
+            "model can be used. Default: empty (the model is already "
+            "calibrated).");
     OpenSim_DECLARE_PROPERTY(orientation_weights, OrientationWeightSet,
             "Set of orientation weights identified by orientation name with "
             "weight being a positive scalar. If not provided, all IMU "
             "orientations are tracked with weight 1.0.");
 
+    OpenSim_DECLARE_PROPERTY(number_of_threads, int,
+            "Number of threads used to solve the frames (default: 1, the "
+            "frames are solved serially). A value of 0 uses all available "
+            "hardware threads. With multiple threads, the time range is split "
+            "into contiguous chunks that are solved independently. Frames are "
+            "always solved serially when visualizing the results.");
+
+    OpenSim_DECLARE_PROPERTY(chunk_overlap, int,
+            "When using multiple threads, the number of frames before each "
+            "chunk that are solved (and discarded) to warm start the chunk, so "
+            "that the solution at the start of the chunk matches that of a "
+            "serial solve (default: 10).");
+
     //=============================================================================
 // METHODS
 //=============================================================================
@@ -104,6 +124,9 @@ public:
         return run(false);
     };
 
+    void setNumThreads(int numThreads) { set_number_of_threads(numThreads); }
+    int getNumThreads() const { return get_number_of_threads(); }
+
     static TimeSeriesTable_<SimTK::Vec3>
         loadMarkersFile(const std::string& markerFile);
 
@@ -28,6 +28,7 @@
 
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Stopwatch.h>
@@ -236,6 +237,7 @@ void InverseDynamicsTool::getJointsByName(Model &model, const Array<std::string>
  */
 bool InverseDynamicsTool::run()
 {
+    OPENSIM_TRACE_SCOPE_CATEGORY("InverseDynamicsTool::run", "tool");
     bool success = false;
     bool modelFromFile=true;
     try{
@@ -327,6 +329,13 @@ bool InverseDynamicsTool::run()
             times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
         }
 
+        // The external loads are only needed at the frame times, so sample
+        // them once rather than interpolating them in every solve.
+        if (modelHasExternalLoads()) {
+            _modelExternalLoads->presampleAtTimes(
+                    std::vector<double>(times.begin(), times.end()));
+        }
+
         // Preallocate results
         Array_<Vector> genForceTraj(nt, Vector(nq, 0.0));
 
@@ -30,20 +30,99 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Common/XMLDocument.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+    // The solution for a single frame. The solutions of all frames are
+    // reported (in order) after all of the frames have been solved. Only a
+    // summary of the marker errors is kept.
+    struct IKFrameSolution {
+        SimTK::Vector q;
+        SimTK::Vector u;
+        double totalSquaredMarkerError = 0;
+        double maxSquaredMarkerError = 0;
+        int worstMarker = -1;
+    };
+
+    // Track the frames [firstSolved, last], starting from the state s, and
+    // store the solutions of frames [firstStored, last] in solutions, where
+    // solutions[0] corresponds to frame `offset`. The frames before
+    // firstStored only serve to warm start the solver. If
+    // markerLocationRows is not null, the marker locations of each stored
+    // frame are written to its row (of 3 * (number of markers) values) of
+    // this contiguous buffer.
+    void trackFrames(InverseKinematicsSolver& ikSolver, SimTK::State& s,
+            const std::vector<double>& times, int firstSolved,
+            int firstStored, int last, int offset, bool reportErrors,
+            double* markerLocationRows, bool logProgress,
+            std::vector<IKFrameSolution>& solutions) {
+        // Reused for every frame; the locations and errors come from the
+        // same pass over the markers.
+        SimTK::Array_<Vec3> markerLocations;
+        SimTK::Array_<double> squaredMarkerErrors;
+        const int nm = ikSolver.getNumMarkersInUse();
+        for (int i = firstSolved; i <= last; ++i) {
+            s.updTime() = times[i];
+            {
+                OPENSIM_TRACE_SCOPE_CATEGORY("IK frame", "tool");
+                ikSolver.track(s);
+            }
+            // show progress line every 1000 frames so users see progress
+            if (logProgress && std::remainder(i - firstSolved, 1000) == 0 &&
+                    i != firstSolved)
+                log_info("Solved {} frame(s)...", i - firstSolved);
+            if (i < firstStored) continue;
+
+            IKFrameSolution& solution = solutions[i - offset];
+            solution.q = s.getQ();
+            solution.u = s.getU();
+            if (reportErrors) {
+                ikSolver.computeCurrentMarkerLocationsAndSquaredErrors(
+                        markerLocations, squaredMarkerErrors);
+                for (int j = 0; j < nm; ++j) {
+                    solution.totalSquaredMarkerError += squaredMarkerErrors[j];
+                    if (squaredMarkerErrors[j] >
+                            solution.maxSquaredMarkerError) {
+                        solution.maxSquaredMarkerError =
+                                squaredMarkerErrors[j];
+                        solution.worstMarker = j;
+                    }
+                }
+            } else if (markerLocationRows) {
+                ikSolver.computeCurrentMarkerLocations(markerLocations);
+            }
+            if (markerLocationRows) {
+                double* row =
+                        markerLocationRows + (size_t)(i - offset) * 3 * nm;
+                for (int j = 0; j < nm; ++j) {
+                    for (int k = 0; k < 3; ++k) {
+                        row[3 * j + k] = markerLocations[j][k];
+                    }
+                }
+            }
+        }
+    }
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -86,6 +165,8 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_number_of_threads(1);
+    constructProperty_chunk_overlap(10);
 }
 
 //=============================================================================
@@ -102,6 +183,7 @@ void InverseKinematicsTool::constructProperties()
  */
 bool InverseKinematicsTool::run()
 {
+    OPENSIM_TRACE_SCOPE_CATEGORY("InverseKinematicsTool::run", "tool");
     bool success = false;
     bool modelFromFile=true;
     Kinematics* kinematicsReporter = nullptr;
@@ -180,8 +262,6 @@ bool InverseKinematicsTool::run()
         // can be fewer than the number of references if there isn't a
         // corresponding model marker for each reference.
         int nm = ikSolver.getNumMarkersInUse();
-        SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
-        SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
         
         Storage *modelMarkerLocations = get_report_marker_locations() ?
             new Storage(Nframes, "ModelMarkerLocations") : nullptr;
@@ -190,50 +270,106 @@ bool InverseKinematicsTool::run()
 
         Stopwatch watch;
 
+        std::vector<IKFrameSolution> solutions(Nframes);
+        // The model marker locations of all frames, one row per frame.
+        std::vector<double> markerLocationRows;
+        if (get_report_marker_locations()) {
+            markerLocationRows.resize((size_t)Nframes * 3 * nm);
+        }
+        double* const locationRows = markerLocationRows.empty()
+                ? nullptr : markerLocationRows.data();
+        const int numThreads = get_number_of_threads() > 0
+                ? get_number_of_threads()
+                : getNumAvailableThreads();
+        // Each chunk should contain at least as many frames as are used to
+        // warm start it.
+        const int overlap = std::max(0, get_chunk_overlap());
+        const int numChunks = std::max(1,
+                std::min(numThreads, Nframes / std::max(1, overlap)));
+        if (numChunks > 1) {
+            log_info("Solving {} frames in {} chunks (overlap: {} frames).",
+                    Nframes, numChunks, overlap);
+            const ThreadReservation reservation(numChunks);
+            std::vector<int> firstFrames(numChunks + 1);
+            // Each chunk has its own copy of the model and the references.
+            std::vector<std::unique_ptr<Model>> models(numChunks);
+            std::vector<std::shared_ptr<MarkersReference>>
+                    chunkMarkersReferences(numChunks);
+            std::vector<SimTK::Array_<CoordinateReference>>
+                    chunkCoordinateReferences(numChunks, coordinateReferences);
+            for (int c = 0; c < numChunks; ++c) {
+                firstFrames[c] =
+                        start_ix + (int)((long long)c * Nframes / numChunks);
+                models[c].reset(_model->clone());
+                // The copies are only used for solving; the analyses are
+                // stepped with this tool's model below.
+                models[c]->updAnalysisSet().clearAndDestroy();
+                chunkMarkersReferences[c] =
+                        make_shared<MarkersReference>(markersReference);
+            }
+            firstFrames[numChunks] = final_ix + 1;
+
+            std::vector<std::exception_ptr> errors(numChunks);
+            std::vector<std::thread> threads;
+            for (int c = 0; c < numChunks; ++c) {
+                threads.emplace_back([&, c]() {
+                    try {
+                        Model& model = *models[c];
+                        SimTK::State& sc = model.initSystem();
+                        InverseKinematicsSolver chunkSolver(model,
+                                chunkMarkersReferences[c],
+                                chunkCoordinateReferences[c],
+                                get_constraint_weight());
+                        chunkSolver.setAccuracy(get_accuracy());
+                        const int firstSolved =
+                                std::max(start_ix, firstFrames[c] - overlap);
+                        sc.updTime() = times[firstSolved];
+                        chunkSolver.assemble(sc);
+                        trackFrames(chunkSolver, sc, times, firstSolved,
+                                firstFrames[c], firstFrames[c + 1] - 1,
+                                start_ix, get_report_errors(),
+                                locationRows, false, solutions);
+                    } catch (...) {
+                        errors[c] = std::current_exception();
+                    }
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            for (const auto& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        } else {
+            trackFrames(ikSolver, s, times, start_ix, start_ix, final_ix,
+                    start_ix, get_report_errors(), locationRows, true,
+                    solutions);
+        }
+
         for (int i = start_ix; i <= final_ix; ++i) {
+            const IKFrameSolution& solution = solutions[i - start_ix];
             s.updTime() = times[i];
-            ikSolver.track(s);
-            // show progress line every 1000 frames so users see progress
-            if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
-                log_info("Solved {} frame(s)...", i - start_ix);
+            s.updQ() = solution.q;
+            s.updU() = solution.u;
             if(get_report_errors()){
-                Array<double> markerErrors(0.0, 3);
-                double totalSquaredMarkerError = 0.0;
-                double maxSquaredMarkerError = 0.0;
-                int worst = -1;
-
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
-                for(int j=0; j<nm; ++j){
-                    totalSquaredMarkerError += squaredMarkerErrors[j];
-                    if(squaredMarkerErrors[j] > maxSquaredMarkerError){
-                        maxSquaredMarkerError = squaredMarkerErrors[j];
-                        worst = j;
-                    }
-                }
-
+                const double totalSquaredMarkerError =
+                        solution.totalSquaredMarkerError;
+                const double maxSquaredMarkerError =
+                        solution.maxSquaredMarkerError;
                 double rms = nm > 0 ? sqrt(totalSquaredMarkerError / nm) : 0;
-                markerErrors.set(0, totalSquaredMarkerError); 
-                markerErrors.set(1, rms);
-                markerErrors.set(2, sqrt(maxSquaredMarkerError));
-                modelMarkerErrors->append(s.getTime(), 3, &markerErrors[0]);
+                const double markerErrors[3] = {totalSquaredMarkerError, rms,
+                        sqrt(maxSquaredMarkerError)};
+                modelMarkerErrors->append(s.getTime(), 3, markerErrors);
 
                 log_info("Frame {} (t = {}):\t total squared error = {}, "
                          "marker error: RMS = {}, max = {} ({})", 
                     i, s.getTime(), totalSquaredMarkerError, rms,
                     sqrt(maxSquaredMarkerError), 
-                    ikSolver.getMarkerNameForIndex(worst));
+                    solution.worstMarker < 0 ? std::string()
+                        : ikSolver.getMarkerNameForIndex(solution.worstMarker));
             }
 
-            if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
-                Array<double> locations(0.0, 3*nm);
-                for(int j=0; j<nm; ++j){
-                    for(int k=0; k<3; ++k)
-                        locations.set(3*j+k, markerLocations[j][k]);
-                }
-
-                modelMarkerLocations->append(s.getTime(), 3*nm, &locations[0]);
-
+            if(locationRows){
+                modelMarkerLocations->append(s.getTime(), 3*nm,
+                        locationRows + (size_t)(i - start_ix) * 3 * nm);
             }
 
             kinematicsReporter->step(s, i);
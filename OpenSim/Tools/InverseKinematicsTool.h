@@ -71,6 +71,18 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(number_of_threads, int,
+            "Number of threads used to solve the frames (default: 1, the "
+            "frames are solved serially). A value of 0 uses all available "
+            "hardware threads. With multiple threads, the time range is split "
+            "into contiguous chunks that are solved independently.");
+
+    OpenSim_DECLARE_PROPERTY(chunk_overlap, int,
+            "When using multiple threads, the number of frames before each "
+            "chunk that are solved (and discarded) to warm start the chunk, so "
+            "that the solution at the start of the chunk matches that of a "
+            "serial solve (default: 10).");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,6 +114,9 @@ public:
 
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
+    void setNumThreads(int numThreads) { set_number_of_threads(numThreads); }
+    int getNumThreads() const { return get_number_of_threads(); }
+
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -245,6 +245,10 @@ bool MarkerPlacer::processModel(Model* aModel,
     * frames in the user-specified time range.
     */
     TimeSeriesTableVec3 staticPoseTable{aPathToSubject + _markerFileName};
+    // The MarkerData shares the data of the table rather than reading the
+    // file again.
+    std::unique_ptr<MarkerData> staticPose(new MarkerData(
+            staticPoseTable, aPathToSubject + _markerFileName));
     const auto& timeCol = staticPoseTable.getIndependentColumn();
 
     // Users often set a time range that purposely exceeds the range of
@@ -283,23 +287,28 @@ bool MarkerPlacer::processModel(Model* aModel,
                                          staticPoseUnits.getAbbreviation());
     }
     
-    MarkerData* staticPose = new MarkerData(aPathToSubject + _markerFileName);
     staticPose->averageFrames(_maxMarkerMovement, _timeRange[0], _timeRange[1]);
     staticPose->convertToUnits(aModel->getLengthUnits());
 
     /* Delete any markers from the model that are not in the static
      * pose marker file.
      */
-    aModel->deleteUnusedMarkers(staticPose->getMarkerNames());
-
-    // Construct the system and get the working state when done changing the model
-    SimTK::State& s = aModel->initSystem();
+    const int numDeleted =
+            aModel->deleteUnusedMarkers(staticPose->getMarkerNames());
+
+    // Construct the system and get the working state when done changing the
+    // model. If the model already has an up-to-date system (e.g., ModelScaler
+    // just scaled it) and no markers were deleted, only reinitialize the state
+    // instead of rebuilding the system.
+    const bool reuseSystem = numDeleted == 0 && aModel->isValidSystem() &&
+                             aModel->isObjectUpToDateWithProperties();
+    SimTK::State& s = reuseSystem ? aModel->initializeState()
+                                  : aModel->initSystem();
     s.updTime() = _timeRange[0];
     
     // Create references and WeightSets needed to initialize InverseKinemaicsSolver
     Set<MarkerWeight> markerWeightSet;
     _ikTaskSet.createMarkerWeightSet(markerWeightSet); // order in tasks file
-    // MarkersReference takes ownership of marker data (staticPose)
     std::shared_ptr<MarkersReference> markersReference(new MarkersReference(staticPoseTable, markerWeightSet));
     SimTK::Array_<CoordinateReference> coordinateReferences;
 
@@ -389,29 +398,42 @@ bool MarkerPlacer::processModel(Model* aModel,
     _outputStorage->setName("static pose");
     _outputStorage->getStateVector(0)->setTime(s.getTime());
 
-    if(_printResultFiles) {
-        auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
+    if(_printResultFiles) printResultFiles(*aModel, aPathToSubject);
 
-        if (_outputModelFileNameProp.isValidFileName()) {
-            aModel->print(aPathToSubject + _outputModelFileName);
-            log_info("Wrote model file '{}' from model {}.",
-                _outputModelFileName, aModel->getName());
-        }
+    return true;
+}
 
-        if (_outputMarkerFileNameProp.isValidFileName()) {
-            aModel->writeMarkerFile(aPathToSubject + _outputMarkerFileName);
-            log_info("Wrote marker file '{}' from model {}.",
-                _outputMarkerFileName, aModel->getName());
-        }
+//_____________________________________________________________________________
+/**
+ * Write the model with its markers placed, the markers and the static pose
+ * of the last call to processModel() to the output files (if their names are
+ * set).
+ *
+ * @param aModel the model with its markers placed.
+ * @param aPathToSubject the directory to which the file names are relative.
+ */
+void MarkerPlacer::printResultFiles(Model& aModel,
+        const string& aPathToSubject) const
+{
+    auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
 
-        if (_outputMotionFileNameProp.isValidFileName()) {
-            _outputStorage->print(aPathToSubject + _outputMotionFileName,
-                "w", "File generated from solving marker data for model "
-                + aModel->getName());
-        }
+    if (_outputModelFileNameProp.isValidFileName()) {
+        aModel.print(aPathToSubject + _outputModelFileName);
+        log_info("Wrote model file '{}' from model {}.",
+            _outputModelFileName, aModel.getName());
     }
 
-    return true;
+    if (_outputMarkerFileNameProp.isValidFileName()) {
+        aModel.writeMarkerFile(aPathToSubject + _outputMarkerFileName);
+        log_info("Wrote marker file '{}' from model {}.",
+            _outputMarkerFileName, aModel.getName());
+    }
+
+    if (_outputMotionFileNameProp.isValidFileName() && _outputStorage.get()) {
+        _outputStorage->print(aPathToSubject + _outputMotionFileName,
+            "w", "File generated from solving marker data for model "
+            + aModel.getName());
+    }
 }
 
 //_____________________________________________________________________________
@@ -427,7 +449,7 @@ void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel,
         MarkerData& aPose) const
 {
     aPose.averageFrames(0.01);
-    const MarkerFrame &frame = aPose.getFrame(0);
+    const auto& data = aPose.getDataTable().getMatrix();
 
     // const SimbodyEngine& engine = aModel.getSimbodyEngine();
 
@@ -443,7 +465,7 @@ void MarkerPlacer::moveModelMarkersToPose(SimTK::State& s, Model& aModel,
             int index = aPose.getMarkerIndex(modelMarker.getName());
             if (index >= 0)
             {
-                Vec3 globalMarker = frame.getMarker(index);
+                Vec3 globalMarker = data(0, index);
                 if (!globalMarker.isNaN())
                 {
                     Vec3 pt, pt2;
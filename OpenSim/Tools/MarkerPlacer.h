@@ -127,6 +127,11 @@ public:
 #endif
     bool processModel(Model* aModel,
             const std::string& aPathToSubject="") const;
+    /** Write the output model, marker and motion files of the last call to
+    processModel(), relative to `aPathToSubject`. processModel() calls this
+    itself unless setPrintResultFiles(false) was called. */
+    void printResultFiles(Model& aModel,
+            const std::string& aPathToSubject="") const;
 
     //--------------------------------------------------------------------------
     // GET AND SET
@@ -258,23 +258,38 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
              */
             if (_scalingOrder[i] == "measurements")
             {
-                /* Load the static pose marker file, and convert units.
+                /* Load the frames of the static pose marker file in the time
+                 * range, and convert units.
                 */
                 std::unique_ptr<MarkerData> markerData{};
                 if(!_markerFileName.empty() && _markerFileName!=PropertyStr::getDefaultStr()) {
-                    markerData.reset(new MarkerData(aPathToSubject + _markerFileName));
+                    if (_timeRange.getSize() < 2)
+                        markerData.reset(new MarkerData(aPathToSubject + _markerFileName));
+                    else
+                        markerData.reset(new MarkerData(aPathToSubject + _markerFileName,
+                                _timeRange[0], _timeRange[1]));
                     markerData->convertToUnits(aModel->getLengthUnits());
                 }
 
+                /* Measure all the marker pairs in the static pose at once. */
+                std::vector<const Measurement*> measurements;
+                for (int j = 0; j < _measurementSet.getSize(); j++)
+                    if (_measurementSet.get(j).getApply())
+                        measurements.push_back(&_measurementSet.get(j));
+                if(!measurements.empty() && !markerData)
+                    throw Exception("ModelScaler.processModel: ERROR- "+_markerFileNameProp.getName()+
+                                        " not set but measurements are used",__FILE__,__LINE__);
+                MarkerPairLengths experimentalLengths;
+                if(!measurements.empty())
+                    takeExperimentalMarkerMeasurements(*markerData,
+                            measurements, experimentalLengths);
+
                 /* Now take and apply the measurements. */
                 for (int j = 0; j < _measurementSet.getSize(); j++)
                 {
                     if (_measurementSet.get(j).getApply())
                     {
-                        if(!markerData)
-                            throw Exception("ModelScaler.processModel: ERROR- "+_markerFileNameProp.getName()+
-                                                " not set but measurements are used",__FILE__,__LINE__);
-                        double scaleFactor = computeMeasurementScaleFactor(s,*aModel, *markerData, _measurementSet.get(j));
+                        double scaleFactor = computeMeasurementScaleFactor(s,*aModel, experimentalLengths, _measurementSet.get(j));
                         if (!SimTK::isNaN(scaleFactor))
                             _measurementSet.get(j).applyScaleFactor(scaleFactor, theScaleSet);
                         else
@@ -313,21 +328,8 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
         /* Now scale the model. */
         aModel->scale(s, theScaleSet, _preserveMassDist, aSubjectMass);
 
-        if(_printResultFiles) {
-            auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
-
-            if (_outputModelFileNameProp.isValidFileName()) {
-                if (aModel->print(_outputModelFileName))
-                    log_info("Wrote model file '{}' from model.",
-                        _outputModelFileName, aModel->getName());
-            }
-
-            if (_outputScaleFileNameProp.isValidFileName()) {
-                if (theScaleSet.print(_outputScaleFileName))
-                    log_info("Wrote scale file '{}' for model {}.",
-                        _outputScaleFileName, aModel->getName());
-            }
-        }
+        _outputScaleSet.reset(new ScaleSet(theScaleSet));
+        if(_printResultFiles) printResultFiles(*aModel, aPathToSubject);
     }
     catch (const Exception& x) {
         log_error(x.what());
@@ -337,6 +339,32 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
     return true;
 }
 
+//_____________________________________________________________________________
+/**
+ * Write the scaled model and the scale factors of the last call to
+ * processModel() to the output files (if their names are set).
+ *
+ * @param aModel the scaled model.
+ * @param aPathToSubject the directory to which the file names are relative.
+ */
+void ModelScaler::printResultFiles(const Model& aModel,
+        const string& aPathToSubject) const
+{
+    auto cwd = IO::CwdChanger::changeTo(aPathToSubject);
+
+    if (_outputModelFileNameProp.isValidFileName()) {
+        if (aModel.print(_outputModelFileName))
+            log_info("Wrote model file '{}' from model.",
+                _outputModelFileName, aModel.getName());
+    }
+
+    if (_outputScaleFileNameProp.isValidFileName() && _outputScaleSet.get()) {
+        if (_outputScaleSet->print(_outputScaleFileName))
+            log_info("Wrote scale file '{}' for model {}.",
+                _outputScaleFileName, aModel.getName());
+    }
+}
+
 //_____________________________________________________________________________
 /**
  * For measurement based scaling, we average the scale factors across the different marker pairs used.
@@ -344,6 +372,15 @@ bool ModelScaler::processModel(Model* aModel, const string& aPathToSubject,
  * in the experimental marker data by the distance between the pair on the model.
  */
 double ModelScaler::computeMeasurementScaleFactor(const SimTK::State& s, const Model& aModel, const MarkerData& aMarkerData, const Measurement& aMeasurement) const
+{
+    MarkerPairLengths experimentalLengths;
+    takeExperimentalMarkerMeasurements(aMarkerData, {&aMeasurement},
+            experimentalLengths);
+    return computeMeasurementScaleFactor(s, aModel, experimentalLengths,
+            aMeasurement);
+}
+
+double ModelScaler::computeMeasurementScaleFactor(const SimTK::State& s, const Model& aModel, const MarkerPairLengths& aExperimentalLengths, const Measurement& aMeasurement) const
 {
     double scaleFactor = 0;
     log_info("Measurement '{}'", aMeasurement.getName());
@@ -353,7 +390,8 @@ double ModelScaler::computeMeasurementScaleFactor(const SimTK::State& s, const M
         string name1, name2;
         pair.getMarkerNames(name1, name2);
         double modelLength = takeModelMeasurement(s, aModel, name1, name2, aMeasurement.getName());
-        double experimentalLength = takeExperimentalMarkerMeasurement(aMarkerData, name1, name2, aMeasurement.getName());
+        double experimentalLength =
+                aExperimentalLengths.at(std::make_pair(name1, name2));
         if(SimTK::isNaN(modelLength) || SimTK::isNaN(experimentalLength)) return SimTK::NaN;
         log_info("\tpair {} ({}, {}): model = {}, experimental = {}",
             i, name1, name2, modelLength, experimentalLength);
@@ -387,33 +425,57 @@ double ModelScaler::takeModelMeasurement(const SimTK::State& s, const Model& aMo
 
 //_____________________________________________________________________________
 /**
- * Measure the average distance between a marker pair in an experimental marker data.
+ * Measure the average distance between each marker pair of the measurements
+ * in an experimental marker data. Each frame in the time range is visited
+ * once for all pairs, rather than once per pair.
  */
-double ModelScaler::takeExperimentalMarkerMeasurement(const MarkerData& aMarkerData, const string& aName1, const string& aName2, const string& aMeasurementName) const
+void ModelScaler::takeExperimentalMarkerMeasurements(
+        const MarkerData& aMarkerData,
+        const std::vector<const Measurement*>& aMeasurements,
+        MarkerPairLengths& rLengths) const
 {
     const Array<string>& experimentalMarkerNames = aMarkerData.getMarkerNames();
-    int marker1 = experimentalMarkerNames.findIndex(aName1);
-    int marker2 = experimentalMarkerNames.findIndex(aName2);
-    if (marker1 >= 0 && marker2 >= 0) {
-        int startIndex, endIndex;
-        if (_timeRange.getSize()<2) 
-            throw Exception("ModelScaler::takeExperimentalMarkerMeasurement, time_range is unspecified.");
-
-        aMarkerData.findFrameRange(_timeRange[0], _timeRange[1], startIndex, endIndex);
-        double length = 0;
-        for(int i=startIndex; i<=endIndex; i++) {
-            Vec3 p1 = aMarkerData.getFrame(i).getMarker(marker1);
-            Vec3 p2 = aMarkerData.getFrame(i).getMarker(marker2);
-            length += (p2 - p1).norm();
+    std::vector<std::pair<int, int>> markerIndices;
+    std::vector<double*> lengths;
+    for (const Measurement* measurement : aMeasurements) {
+        for (int i = 0; i < measurement->getNumMarkerPairs(); i++) {
+            string name1, name2;
+            measurement->getMarkerPair(i).getMarkerNames(name1, name2);
+            const auto key = std::make_pair(name1, name2);
+            if (rLengths.count(key)) continue;
+
+            int marker1 = experimentalMarkerNames.findIndex(name1);
+            int marker2 = experimentalMarkerNames.findIndex(name2);
+            if (marker1 >= 0 && marker2 >= 0) {
+                markerIndices.emplace_back(marker1, marker2);
+                lengths.push_back(&(rLengths[key] = 0));
+            } else {
+                if (marker1 < 0)
+                    log_warn("Marker {} in {} measurement not found in {}.",
+                            name1, measurement->getName(),
+                            aMarkerData.getFileName());
+                if (marker2 < 0)
+                    log_warn("Marker {} in {} measurement not found in {}.",
+                            name2, measurement->getName(),
+                            aMarkerData.getFileName());
+                rLengths[key] = SimTK::NaN;
+            }
+        }
+    }
+    if (lengths.empty()) return;
+
+    if (_timeRange.getSize()<2) 
+        throw Exception("ModelScaler::takeExperimentalMarkerMeasurements, time_range is unspecified.");
+
+    int startIndex, endIndex;
+    aMarkerData.findFrameRange(_timeRange[0], _timeRange[1], startIndex, endIndex);
+    const auto& data = aMarkerData.getDataTable().getMatrix();
+    for (int i = startIndex; i <= endIndex; i++) {
+        for (size_t k = 0; k < lengths.size(); k++) {
+            const Vec3& p1 = data(i, markerIndices[k].first);
+            const Vec3& p2 = data(i, markerIndices[k].second);
+            *lengths[k] += (p2 - p1).norm();
         }
-        return length/(endIndex-startIndex+1);
-    } else {
-        if (marker1 < 0)
-            log_warn("Marker {} in {} measurement not found in {}.", aName1, 
-                    aMeasurementName, aMarkerData.getFileName());
-        if (marker2 < 0)
-            log_warn("Marker {} in {} measurement not found in {}.", aName2,
-                    aMeasurementName, aMarkerData.getFileName());
-        return SimTK::NaN;
     }
+    for (double* length : lengths) *length /= (endIndex-startIndex+1);
 }
@@ -27,6 +27,9 @@
 // INCLUDE
 #include <OpenSim/Common/ScaleSet.h>
 #include "MeasurementSet.h"
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace SimTK {
 class State;
@@ -95,6 +98,9 @@ protected:
     // Whether or not to write to the designated output files (GUI will set this to false)
     bool _printResultFiles;
 
+    // The scale factors applied by the last call to processModel().
+    mutable SimTK::ResetOnCopy<std::unique_ptr<ScaleSet>> _outputScaleSet;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -113,6 +119,11 @@ public:
 
     bool processModel(Model* aModel, const std::string& aPathToSubject="",
             double aFinalMass = -1.0) const;
+    /** Write the output model and scale files of the last call to
+    processModel(), relative to `aPathToSubject`. processModel() calls this
+    itself unless setPrintResultFiles(false) was called. */
+    void printResultFiles(const Model& aModel,
+            const std::string& aPathToSubject="") const;
     /* Register types to be used when reading a ModelScaler object from xml file. */
     static void registerTypes();
 
@@ -190,10 +201,20 @@ public:
 
     double computeMeasurementScaleFactor(const SimTK::State& s, const Model& aModel, const MarkerData& aMarkerData, const Measurement& aMeasurement) const;
 private:
+    /** Average experimental distance of each marker pair (first, second);
+    NaN if a marker is missing from the marker data. */
+    typedef std::map<std::pair<std::string, std::string>, double>
+        MarkerPairLengths;
+
     void setNull();
     void setupProperties();
+    double computeMeasurementScaleFactor(const SimTK::State& s, const Model& aModel, const MarkerPairLengths& aExperimentalLengths, const Measurement& aMeasurement) const;
     double takeModelMeasurement(const SimTK::State& s, const Model& aModel, const std::string& aName1, const std::string& aName2, const std::string& aMeasurementName) const;
-    double takeExperimentalMarkerMeasurement(const MarkerData& aMarkerData, const std::string& aName1, const std::string& aName2, const std::string& aMeasurementName) const;
+    /** Measure the marker pairs of all the given measurements with a single
+    pass over the frames of the marker data. */
+    void takeExperimentalMarkerMeasurements(const MarkerData& aMarkerData,
+            const std::vector<const Measurement*>& aMeasurements,
+            MarkerPairLengths& rLengths) const;
 
 //=============================================================================
 };  // END of class ModelScaler
@@ -28,6 +28,7 @@
 #include "AnalyzeTool.h"
 #include "VectorFunctionForActuators.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Simulation/Model/CMCActuatorSubsystem.h>
@@ -326,6 +327,7 @@ operator=(const RRATool &aTool)
     _initialTimeForCOMAdjustment = aTool._initialTimeForCOMAdjustment;
     _finalTimeForCOMAdjustment = aTool._finalTimeForCOMAdjustment;
     _verbose = aTool._verbose;
+    _desiredKinematics = aTool._desiredKinematics;
 
     return(*this);
 }
@@ -344,6 +346,7 @@ operator=(const RRATool &aTool)
  */
 bool RRATool::run()
 {
+    OPENSIM_TRACE_SCOPE_CATEGORY("RRATool::run", "tool");
     log_info("Running tool {}.", getName());
 
     // CHECK FOR A MODEL
@@ -412,9 +415,24 @@ bool RRATool::run()
         desiredPointsFlag = true;
     }
 
+    // Prepared kinematics only apply to the same file and filter.
+    if(_desiredKinematics &&
+            (_desiredKinematics->fileName != _desiredKinematicsFileName ||
+             _desiredKinematics->lowpassCutoffFrequency != _lowpassCutoffFrequency)) {
+        log_info("The prepared desired kinematics are from '{}' (cutoff "
+            "frequency {}); preparing '{}' instead.",
+            _desiredKinematics->fileName,
+            _desiredKinematics->lowpassCutoffFrequency,
+            _desiredKinematicsFileName);
+        _desiredKinematics.reset();
+    }
     Storage *desiredKinStore=NULL;
     bool desiredKinFlag = false;
-    if(_desiredKinematicsFileName=="") {
+    if(_desiredKinematics) {
+        log_info("Using the desired kinematics already prepared from '{}'.",
+            _desiredKinematics->fileName);
+        desiredKinFlag = true;
+    } else if(_desiredKinematicsFileName=="") {
         log_warn("A desired kinematics file was not specified.");
     } else {
         log_info("Loading desired kinematics from file '{}'...",
@@ -446,7 +464,8 @@ bool RRATool::run()
 
     // Initial Time
     if(desiredKinFlag) {
-        double ti = desiredKinStore->getFirstTime();
+        double ti = _desiredKinematics ? _desiredKinematics->firstTime
+                                       : desiredKinStore->getFirstTime();
         if(_ti<ti) {
             log_warn("The initial time set for the cmc run precedes the first "
                 "time in the desired kinematics file '{}'. Resetting the "
@@ -455,7 +474,8 @@ bool RRATool::run()
             _ti = ti;
         }
         // Final time
-        double tf = desiredKinStore->getLastTime();
+        double tf = _desiredKinematics ? _desiredKinematics->lastTime
+                                       : desiredKinStore->getLastTime();
         if(_tf>tf) {
             log_warn("The final time set for the cmc run is past the last time "
                 "stamp in the desired kinematics file '{}'. Resetting the "
@@ -482,7 +502,11 @@ bool RRATool::run()
         }
     }
 
-    if(desiredKinFlag) {
+    // Prepared desired kinematics have already been padded and filtered.
+    double firstDesiredKinTime = SimTK::NaN, lastDesiredKinTime = SimTK::NaN;
+    if(desiredKinStore) {
+        firstDesiredKinTime = desiredKinStore->getFirstTime();
+        lastDesiredKinTime = desiredKinStore->getLastTime();
         desiredKinStore->pad(60);
         if (_verbose) desiredKinStore->print("desiredKinematics_padded.sto");
         if(_lowpassCutoffFrequency>=0) {
@@ -513,12 +537,19 @@ bool RRATool::run()
     Storage *qStore=NULL;
     Storage *uStore=NULL;
 
-    if(desiredKinFlag) {
+    if(_desiredKinematics) {
+        OPENSIM_THROW_IF(_desiredKinematics->qSet.getSize() != nq, Exception,
+            "RRATool: the desired kinematics were prepared for {} coordinates "
+            "but the model has {}.", _desiredKinematics->qSet.getSize(), nq);
+        qStore = new Storage(_desiredKinematics->qStore);
+        uStore = new Storage(_desiredKinematics->uStore);
+    } else if(desiredKinFlag) {
         _model->getMultibodySystem().realize(s, Stage::Time );
         // qStore and uStore returned are in radians
         _model->getSimbodyEngine().formCompleteStorages(s, *desiredKinStore,
             qStore, uStore);
     }
+    delete desiredKinStore; desiredKinStore = NULL;
 
     // Adjust COM to reduce residuals (formerly RRA pass 1) if requested
     string massAdjMsg;
@@ -560,13 +591,17 @@ bool RRATool::run()
     GCVSplineSet *uSet=NULL;
     GCVSplineSet *uDotSet=NULL;
 
-    if(desiredKinFlag) {
+    if(_desiredKinematics) {
+        // The splines are adopted by the task set below, so use copies.
+        qSet = new GCVSplineSet(_desiredKinematics->qSet);
+        uSet = new GCVSplineSet(_desiredKinematics->uSet);
+        uDotSet = new GCVSplineSet(_desiredKinematics->uDotSet);
+        delete qStore; qStore = NULL;
+        delete uStore; uStore = NULL;
+    } else if(desiredKinFlag) {
         log_info("Constructing function set for tracking desired kinematics...");
         qSet = new GCVSplineSet(5,qStore);
-        delete qStore; qStore = NULL;
-
         uSet = new GCVSplineSet(5,uStore);
-        delete uStore; uStore=NULL;
 
         Storage *dudtStore = uSet->constructStorage(1);
         uDotSet = new GCVSplineSet(5,dudtStore);
@@ -576,6 +611,22 @@ bool RRATool::run()
             dudtStore->print("desiredKinematics_splinefit_accelerations.sto");
         }
         delete dudtStore; dudtStore=NULL;
+
+        // Keep the prepared kinematics for later passes.
+        auto kinematics = std::make_shared<DesiredKinematics>();
+        kinematics->fileName = _desiredKinematicsFileName;
+        kinematics->lowpassCutoffFrequency = _lowpassCutoffFrequency;
+        kinematics->firstTime = firstDesiredKinTime;
+        kinematics->lastTime = lastDesiredKinTime;
+        kinematics->qStore = *qStore;
+        kinematics->uStore = *uStore;
+        kinematics->qSet = *qSet;
+        kinematics->uSet = *uSet;
+        kinematics->uDotSet = *uDotSet;
+        _desiredKinematics = kinematics;
+
+        delete qStore; qStore = NULL;
+        delete uStore; uStore=NULL;
     }
 
     // ANALYSES
@@ -32,6 +32,9 @@
 #include "osimToolsDLL.h"
 #include <OpenSim/Simulation/Model/AbstractTool.h>
 #include <OpenSim/Simulation/Model/ForceSet.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Storage.h>
+#include <memory>
 
 
 #ifdef SWIG
@@ -44,7 +47,6 @@
 namespace OpenSim {
 
 class ControlSet;
-class Storage;
 //=============================================================================
 //=============================================================================
 /**
@@ -120,6 +122,31 @@ private:
 
     ForceSet _originalForceSet;
 
+public:
+#ifndef SWIG
+    /** Desired kinematics prepared for tracking: padded, low-pass filtered,
+    completed for the model's constrained coordinates and fitted with GCV
+    splines. Preparing them is a large fraction of a run but depends only on
+    the desired kinematics and the model's coordinates, so passes that track
+    the same kinematics (e.g., with a model adjusted by a previous pass) can
+    share them; see setDesiredKinematics(). */
+    struct DesiredKinematics {
+        std::string fileName;
+        double lowpassCutoffFrequency = -1.0;
+        /// Time range of the data before padding.
+        double firstTime = SimTK::NaN;
+        double lastTime = SimTK::NaN;
+        /// Generalized coordinates (radians) and speeds of all coordinates.
+        Storage qStore;
+        Storage uStore;
+        GCVSplineSet qSet;
+        GCVSplineSet uSet;
+        GCVSplineSet uDotSet;
+    };
+#endif
+private:
+    std::shared_ptr<const DesiredKinematics> _desiredKinematics;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -155,6 +182,21 @@ public:
     const std::string &getDesiredKinematicsFileName() { return _desiredKinematicsFileName; }
     void setDesiredKinematicsFileName(const std::string &aFileName) { _desiredKinematicsFileName = aFileName; }
 
+#ifndef SWIG
+    /** Track desired kinematics that were already prepared, typically by a
+    previous run (see getDesiredKinematics()), instead of reading, filtering
+    and fitting the desired kinematics file again. The kinematics are used
+    only if they were prepared from this tool's desired kinematics file and
+    lowpass cutoff frequency, for a model with the same coordinates. */
+    void setDesiredKinematics(
+            std::shared_ptr<const DesiredKinematics> kinematics)
+    {   _desiredKinematics = std::move(kinematics); }
+    /** The desired kinematics tracked by the last run() (or set with
+    setDesiredKinematics()); nullptr if no run has tracked kinematics. */
+    std::shared_ptr<const DesiredKinematics> getDesiredKinematics() const
+    {   return _desiredKinematics; }
+#endif
+
     const std::string &getConstraintsFileName() { return _constraintsFileName; }         
     void setConstraintsFileName(const std::string &aFileName) { _constraintsFileName = aFileName; }          
          
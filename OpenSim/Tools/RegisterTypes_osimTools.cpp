@@ -73,36 +73,36 @@ OSIMTOOLS_API void RegisterTypes_osimTools()
 {
   try {
 
-    Object::registerType( ScaleTool() );
-    //Object::registerType( IKTool() );
-    Object::registerType( CMCTool() );
-    Object::registerType( RRATool() );
-    Object::registerType( ForwardTool() );
-    Object::registerType( AnalyzeTool() );
-
-    Object::registerType( GenericModelMaker() );
-    Object::registerType( IKCoordinateTask() );
-    Object::registerType( IKMarkerTask() );
-    Object::registerType( IKTaskSet() );
-    Object::registerType( MarkerPair() );
-    Object::registerType( MarkerPairSet() );
-    Object::registerType( MarkerPlacer() );
-    Object::registerType( Measurement() );
-    Object::registerType( MeasurementSet() );
-    Object::registerType( ModelScaler() );
-
-    Object::registerType( CorrectionController() );
-    Object::registerType( CMC() );
-    Object::registerType( CMC_Joint() );
-    Object::registerType( CMC_Point() );
-    Object::registerType( MuscleStateTrackingTask() );
-    Object::registerType( CMC_TaskSet() );
-
-    Object::registerType( SMC_Joint() );
-    Object::registerType( OrientationWeightSet());
-    Object::registerType( InverseKinematicsTool() );
-    Object::registerType( IMUInverseKinematicsTool());
-    Object::registerType( InverseDynamicsTool() );
+    Object::registerTypeLazily<ScaleTool>();
+    //Object::registerTypeLazily<IKTool>();
+    Object::registerTypeLazily<CMCTool>();
+    Object::registerTypeLazily<RRATool>();
+    Object::registerTypeLazily<ForwardTool>();
+    Object::registerTypeLazily<AnalyzeTool>();
+
+    Object::registerTypeLazily<GenericModelMaker>();
+    Object::registerTypeLazily<IKCoordinateTask>();
+    Object::registerTypeLazily<IKMarkerTask>();
+    Object::registerTypeLazily<IKTaskSet>();
+    Object::registerTypeLazily<MarkerPair>();
+    Object::registerTypeLazily<MarkerPairSet>();
+    Object::registerTypeLazily<MarkerPlacer>();
+    Object::registerTypeLazily<Measurement>();
+    Object::registerTypeLazily<MeasurementSet>();
+    Object::registerTypeLazily<ModelScaler>();
+
+    Object::registerTypeLazily<CorrectionController>();
+    Object::registerTypeLazily<CMC>();
+    Object::registerTypeLazily<CMC_Joint>();
+    Object::registerTypeLazily<CMC_Point>();
+    Object::registerTypeLazily<MuscleStateTrackingTask>();
+    Object::registerTypeLazily<CMC_TaskSet>();
+
+    Object::registerTypeLazily<SMC_Joint>();
+    Object::registerTypeLazily<OrientationWeightSet>();
+    Object::registerTypeLazily<InverseKinematicsTool>();
+    Object::registerTypeLazily<IMUInverseKinematicsTool>();
+    Object::registerTypeLazily<InverseDynamicsTool>();
     // Old versions
     Object::RenameType("rdCMC_Joint",   "CMC_Joint");
     Object::RenameType("rdCMC_Point",   "CMC_Point");
@@ -26,6 +26,7 @@
 //=============================================================================
 #include "ScaleTool.h"
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/TraceRecorder.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include "GenericModelMaker.h"
 
@@ -249,6 +250,7 @@ Model* ScaleTool::createModel() const
 }
 
 bool ScaleTool::run() const {
+    OPENSIM_TRACE_SCOPE_CATEGORY("ScaleTool::run", "tool");
     std::unique_ptr<Model> model(createModel());
 
     if(model == nullptr) { 
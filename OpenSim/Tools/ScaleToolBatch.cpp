@@ -0,0 +1,136 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ScaleToolBatch.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ScaleToolBatch.h"
+#include "GenericModelMaker.h"
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Simulation/Model/MarkerSet.h>
+
+#include <mutex>
+
+using namespace OpenSim;
+
+namespace {
+    // Reading setup files and writing result files change the process's
+    // working directory, so only one subject does so at a time.
+    std::mutex& getWorkingDirectoryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+}
+
+ScaleToolBatch::ScaleToolBatch(const Model& templateModel)
+        : _templateModel(templateModel.clone()) {
+    _templateModel->finalizeFromProperties();
+}
+
+ScaleToolBatch::ScaleToolBatch(const std::string& templateModelFile)
+        : _templateModel(new Model(templateModelFile)) {
+    _templateModel->finalizeFromProperties();
+}
+
+void ScaleToolBatch::addSubject(const ScaleTool& tool) {
+    std::unique_ptr<ScaleTool> subject(tool.clone());
+    subject->setPathToSubject(SimTK::Pathname::getAbsoluteDirectoryPathname(
+            tool.getPathToSubject()));
+    _subjects.push_back(std::move(subject));
+}
+
+std::vector<ScaleToolBatch::SubjectResult> ScaleToolBatch::run() const {
+    log_info("ScaleToolBatch: scaling {} subjects.", getNumSubjects());
+    std::vector<SubjectResult> results(getNumSubjects());
+    // runSubject() does not throw.
+    parallelFor(getNumSubjects(),
+            [&](int i) { results[i] = runSubject(*_subjects[i]); },
+            _numThreads);
+    return results;
+}
+
+ScaleToolBatch::SubjectResult ScaleToolBatch::runSubject(
+        const ScaleTool& tool) const {
+    SubjectResult result;
+    result.name = tool.getName();
+    const std::string& path = tool.getPathToSubject();
+    try {
+        log_info("Processing subject {}...", tool.getName());
+        // Copying the template concurrently from several threads is not
+        // known to be safe (e.g., the model may cache data), so copies are
+        // made one at a time.
+        static std::mutex copyMutex;
+        std::unique_ptr<Model> model;
+        {
+            std::lock_guard<std::mutex> lock(copyMutex);
+            model.reset(_templateModel->clone());
+        }
+        model->setName(tool.getName());
+        model->finalizeFromProperties();
+
+        // As in GenericModelMaker::processModel().
+        const std::string& markerSetFile =
+                tool.getGenericModelMaker().getMarkerSetFileName();
+        if (!tool.isDefaultGenericModelMaker() && !markerSetFile.empty() &&
+                markerSetFile != "Unassigned") {
+            std::unique_ptr<MarkerSet> markerSet;
+            {
+                std::lock_guard<std::mutex> lock(getWorkingDirectoryMutex());
+                markerSet.reset(new MarkerSet(path + markerSetFile));
+            }
+            model->updateMarkerSet(*markerSet);
+        }
+
+        // As in ScaleTool::run(), but the result files are written while
+        // holding the working directory mutex.
+        if (!tool.isDefaultModelScaler() && tool.getModelScaler().getApply()) {
+            std::unique_ptr<ModelScaler> scaler(
+                    tool.getModelScaler().clone());
+            scaler->setPrintResultFiles(false);
+            OPENSIM_THROW_IF(!scaler->processModel(model.get(), path,
+                                     tool.getSubjectMass()),
+                    Exception, "Scaling failed.");
+            std::lock_guard<std::mutex> lock(getWorkingDirectoryMutex());
+            scaler->printResultFiles(*model, path);
+        } else {
+            log_error("Scaling parameters disabled (apply is false) or not "
+                      "set. Model {} is not scaled.", tool.getName());
+        }
+
+        if (!tool.isDefaultMarkerPlacer()) {
+            std::unique_ptr<MarkerPlacer> placer(
+                    tool.getMarkerPlacer().clone());
+            placer->setPrintResultFiles(false);
+            OPENSIM_THROW_IF(!placer->processModel(model.get(), path),
+                    Exception, "Marker placement failed.");
+            std::lock_guard<std::mutex> lock(getWorkingDirectoryMutex());
+            placer->printResultFiles(*model, path);
+        } else {
+            log_error("Marker placement parameters disabled (apply is false) "
+                      "or not set. No markers have been moved in model {}.",
+                    tool.getName());
+        }
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.errorMessage = e.what();
+        log_error("ScaleToolBatch: subject '{}' failed: {}", tool.getName(),
+                e.what());
+    }
+    return result;
+}
@@ -0,0 +1,97 @@
+#ifndef OPENSIM_SCALE_TOOL_BATCH_H_
+#define OPENSIM_SCALE_TOOL_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ScaleToolBatch.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ScaleTool.h"
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+//=============================================================================
+//=============================================================================
+/**
+ * Scale one generic (template) model to many subjects on a pool of threads.
+ * Each subject is described by a ScaleTool (e.g., read from the subject's
+ * setup file), and is processed as ScaleTool::run() would, except that the
+ * generic model is read once, when the batch is created, and each subject
+ * scales a copy of it instead of reading the tool's generic model file. The
+ * tool's generic marker set file, if any, is still applied to the copy.
+ *
+ * The scaling and marker placement of the subjects run concurrently. Writing
+ * the result files changes the process's working directory, so the files of
+ * one subject are written at a time.
+ *
+ * @code
+ * ScaleToolBatch batch("gait2354_simbody.osim");
+ * for (const auto& setup : setupFiles) batch.addSubject(ScaleTool(setup));
+ * auto results = batch.run();
+ * @endcode
+ */
+class OSIMTOOLS_API ScaleToolBatch {
+public:
+    /** The outcome of a subject. If processing threw an exception or a step
+    failed, `errorMessage` describes the failure. */
+    struct SubjectResult {
+        std::string name;
+        bool success = false;
+        std::string errorMessage;
+    };
+
+    /** Use a copy of `templateModel` as the generic model. */
+    explicit ScaleToolBatch(const Model& templateModel);
+    /** Read the generic model from `templateModelFile`. */
+    explicit ScaleToolBatch(const std::string& templateModelFile);
+
+    const Model& getTemplateModel() const { return *_templateModel; }
+
+    /** Add a subject. File names in the tool are relative to its path to
+    subject (see ScaleTool::getPathToSubject()); a relative path to subject
+    is resolved against the current working directory now. */
+    void addSubject(const ScaleTool& tool);
+    int getNumSubjects() const { return (int)_subjects.size(); }
+
+    /** The maximum number of subjects to process at the same time (default:
+    0, which uses getMaxNumThreads()). See parallelFor(). */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** Scale all subjects and return their results, in the order in which
+    the subjects were added. A subject that fails does not stop the others.
+    */
+    std::vector<SubjectResult> run() const;
+
+private:
+    SubjectResult runSubject(const ScaleTool& tool) const;
+
+    std::unique_ptr<Model> _templateModel;
+    std::vector<std::unique_ptr<ScaleTool>> _subjects;
+    int _numThreads = 0;
+};
+
+} // end of namespace OpenSim
+
+#endif // OPENSIM_SCALE_TOOL_BATCH_H_
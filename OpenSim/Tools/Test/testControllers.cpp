@@ -30,6 +30,7 @@
 //  2. Test a PrescribedController on a block with an ideal actuator
 //  3. Test a CorrectionController tracking a block with an ideal actuator
 //  4. Test a PrescribedController on the arm26 model with reserves.
+//  5. Test that several controllers sharing actuators add into the controls
 //     Add tests here as new controller types are added to OpenSim
 //
 //=============================================================================
@@ -46,6 +47,7 @@ void testCorrectionControllerOnBlock();
 void testPrescribedControllerFromFile(const std::string& modelFile,
                                       const std::string& actuatorsFile,
                                       const std::string& controlsFile);
+void testControllersAddIntoModelControls();
 
 int main()
 {
@@ -60,6 +62,8 @@ int main()
         log_info("Testing PrescribedController from File");
         testPrescribedControllerFromFile("arm26.osim", "arm26_Reserve_Actuators.xml",
                                          "arm26_controls.xml");
+        log_info("Testing controllers that share actuators");
+        testControllersAddIntoModelControls();
     }   
     catch (const std::exception& e) {
         log_error("TestControllers failed due to the following error(s): {}",
@@ -417,3 +421,57 @@ void testPrescribedControllerFromFile(const std::string& modelFile,
      
     osimModel.disownAllComponents();
 }
+
+//==========================================================================================================
+void testControllersAddIntoModelControls()
+{
+    using namespace SimTK;
+
+    Model model;
+    auto* body = new OpenSim::Body("body", 1.0, Vec3(0), Inertia(1));
+    model.addBody(body);
+    auto* joint = new PlanarJoint("planar", model.getGround(), *body);
+    model.addJoint(joint);
+
+    std::vector<std::string> names{"rz", "tx", "ty"};
+    for (int i = 0; i < 3; ++i) {
+        auto* actu = new CoordinateActuator(joint->getCoordinate(
+                (PlanarJoint::Coord)i).getName());
+        actu->setName(names[i]);
+        model.addForce(actu);
+    }
+
+    // The first controller controls "ty" and "rz" (in that order); the
+    // second controls all actuators.
+    auto* first = new PrescribedController();
+    first->setName("first");
+    first->addActuator(model.getComponent<Actuator>("/forceset/ty"));
+    first->addActuator(model.getComponent<Actuator>("/forceset/rz"));
+    first->prescribeControlForActuator("ty", new Constant(3.0));
+    first->prescribeControlForActuator("rz", new LinearFunction(2.0, 0.5));
+    model.addController(first);
+
+    auto* second = new PrescribedController();
+    second->setName("second");
+    second->setActuators(model.updActuators());
+    for (int i = 0; i < 3; ++i) {
+        second->prescribeControlForActuator(i, new Constant(10.0 * (i + 1)));
+    }
+    model.addController(second);
+
+    SimTK::State state = model.initSystem();
+    state.setTime(0.75);
+    model.realizeVelocity(state);
+    const Vector& controls = model.getControls(state);
+    ASSERT(controls.size() == 3);
+
+    const auto& rz = model.getComponent<Actuator>("/forceset/rz");
+    const auto& tx = model.getComponent<Actuator>("/forceset/tx");
+    const auto& ty = model.getComponent<Actuator>("/forceset/ty");
+    ASSERT_EQUAL(2.0 * 0.75 + 0.5 + 10.0, controls[rz.getControlIndex()],
+            1e-15, __FILE__, __LINE__, "Incorrect control for rz.");
+    ASSERT_EQUAL(20.0, controls[tx.getControlIndex()], 1e-15,
+            __FILE__, __LINE__, "Incorrect control for tx.");
+    ASSERT_EQUAL(3.0 + 30.0, controls[ty.getControlIndex()], 1e-15,
+            __FILE__, __LINE__, "Incorrect control for ty.");
+}
@@ -0,0 +1,146 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  testToolResultCache.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Test that ToolResultCache detects which inputs of a tool have changed since
+// the cache was written.
+
+#include <OpenSim/Tools/InverseDynamicsTool.h>
+#include <OpenSim/Tools/InverseKinematicsTool.h>
+#include <OpenSim/Tools/ToolResultCache.h>
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace OpenSim;
+using namespace std;
+
+void writeFile(const string& fileName, const string& content) {
+    ofstream stream(fileName);
+    stream << content;
+}
+
+bool contains(const vector<string>& stages, const string& stage) {
+    return std::find(stages.begin(), stages.end(), stage) != stages.end();
+}
+
+void testInverseDynamicsTool() {
+    writeFile("testToolResultCache_q.sto", "q\nendheader\ntime a\n0 1\n");
+    std::remove("testToolResultCache_id.cache");
+    std::remove("testToolResultCache_id.sto");
+
+    InverseDynamicsTool tool;
+    tool.setModelFileName("arm26.osim");
+    tool.setCoordinatesFileName("testToolResultCache_q.sto");
+    tool.setOutputGenForceFileName("testToolResultCache_id.sto");
+    {
+        // Without a cache file, every stage has changed.
+        ToolResultCache cache(tool, "testToolResultCache_id.cache");
+        const auto changed = cache.findChangedStages();
+        ASSERT(contains(changed, "setup"));
+        ASSERT(contains(changed, "model_file"));
+        ASSERT(contains(changed, "coordinates_file"));
+        // There is no such file (yet).
+        ASSERT(!contains(changed, "output_gen_force_file"));
+        ASSERT(!cache.isUpToDate());
+
+        // "Run" the tool, then record its inputs and outputs.
+        writeFile("testToolResultCache_id.sto", "tau\n");
+        cache.write();
+        ASSERT(cache.isUpToDate());
+    }
+    {
+        ToolResultCache cache(tool, "testToolResultCache_id.cache");
+        ASSERT(cache.isUpToDate());
+
+        // Only the edited input has changed.
+        writeFile("testToolResultCache_q.sto", "q\nendheader\ntime a\n0 2\n");
+        const auto changed = cache.findChangedStages();
+        ASSERT(changed.size() == 1);
+        ASSERT(changed[0] == "coordinates_file");
+        cache.write();
+        ASSERT(cache.isUpToDate());
+
+        // A deleted result causes the tool to run again.
+        std::remove("testToolResultCache_id.sto");
+        const auto changedAfterDelete = cache.findChangedStages();
+        ASSERT(changedAfterDelete.size() == 1);
+        ASSERT(changedAfterDelete[0] == "output_gen_force_file");
+        writeFile("testToolResultCache_id.sto", "tau\n");
+        ASSERT(cache.isUpToDate());
+    }
+    {
+        // Changing a setting changes only the setup.
+        tool.setLowpassCutoffFrequency(6.0);
+        ToolResultCache cache(tool, "testToolResultCache_id.cache");
+        const auto changed = cache.findChangedStages();
+        ASSERT(changed.size() == 1);
+        ASSERT(changed[0] == "setup");
+
+        cache.invalidate();
+        ASSERT(!cache.isUpToDate());
+    }
+}
+
+void testInverseKinematicsTool() {
+    // InverseKinematicsTool uses the newer properties.
+    writeFile("testToolResultCache_markers.trc", "markers\n");
+    std::remove("testToolResultCache_ik.cache");
+
+    InverseKinematicsTool tool;
+    tool.set_model_file("arm26.osim");
+    tool.setMarkerDataFileName("testToolResultCache_markers.trc");
+    ToolResultCache cache(tool, "testToolResultCache_ik.cache");
+    const auto changed = cache.findChangedStages();
+    ASSERT(contains(changed, "model_file"));
+    ASSERT(contains(changed, "marker_file"));
+    cache.write();
+    ASSERT(cache.isUpToDate());
+
+    writeFile("testToolResultCache_markers.trc", "other markers\n");
+    ASSERT(cache.findChangedStages() == vector<string>{"marker_file"});
+}
+
+void testHash() {
+    ASSERT(ToolResultCache::hashString("") == "cbf29ce484222325");
+    ASSERT(ToolResultCache::hashString("a") == "af63dc4c8601ec8c");
+    writeFile("testToolResultCache_hash.txt", "a");
+    ASSERT(ToolResultCache::hashFile("testToolResultCache_hash.txt") ==
+            ToolResultCache::hashString("a"));
+    ASSERT(ToolResultCache::hashFile("testToolResultCache_none.txt").empty());
+}
+
+int main() {
+    try {
+        testHash();
+        cout << "testHash PASSED" << endl;
+        testInverseDynamicsTool();
+        cout << "testInverseDynamicsTool PASSED" << endl;
+        testInverseKinematicsTool();
+        cout << "testInverseKinematicsTool PASSED" << endl;
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        return 1;
+    }
+    cout << "Done" << endl;
+    return 0;
+}
@@ -26,6 +26,8 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/ModelVisualizer.h>
+#include <OpenSim/Simulation/ModelSceneExporter.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
@@ -40,6 +42,8 @@ void populate_composedTransformPrimitives(SimTK::Array_<DecorativeGeometry>&);
 void populate_contactModelPrimitives(SimTK::Array_<DecorativeGeometry>&);
 void populate_wrapModelPrimitives(SimTK::Array_<DecorativeGeometry>&, bool includeFrames=true);
 bool testVisModelAgainstStandard(Model& model, const SimTK::Array_<DecorativeGeometry>& stdPrimitives);
+void testModelSceneExporter();
+void testCachedDynamicGeometry();
 
 // Implementation of DecorativeGeometryImplementation that prints the representation to 
 // a StringStream for comparison
@@ -154,6 +158,11 @@ int main()
         modelWithWrap.updDisplayHints().set_show_frames(false);
         populate_wrapModelPrimitives(standard, false);
         testVisModelAgainstStandard(modelWithWrap, standard);
+
+        testCachedDynamicGeometry();
+        std::cout << "Cached dynamic geometry test Passed" << std::endl;
+        testModelSceneExporter();
+        std::cout << "ModelSceneExporter test Passed" << std::endl;
     }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -163,6 +172,80 @@ int main()
     return 0;
 }
 
+void testCachedDynamicGeometry()
+{
+    // The cached decoration generator produces the same per-frame geometry
+    // as traversing the whole model.
+    Model model("test_wrapAllVis.osim");
+    SimTK::State& state = model.initSystem();
+    model.realizeReport(state);
+    SimTK::DefaultGeometry generator(model);
+    for (bool showPathPoints : {false, true}) {
+        model.updDisplayHints().set_show_path_points(showPathPoints);
+        SimTK::Array_<DecorativeGeometry> expected;
+        model.generateDecorations(false, model.getDisplayHints(), state,
+                expected);
+        SimTK::Array_<DecorativeGeometry> cached;
+        generator.generateDecorations(state, cached);
+        ASSERT(!expected.empty(), __FILE__, __LINE__,
+                "Expected the model to have per-frame geometry.");
+        ASSERT(cached.size() == expected.size(), __FILE__, __LINE__,
+                "Cached per-frame geometry differs from the model's.");
+    }
+}
+
+void testModelSceneExporter()
+{
+    Model model("double_pendulum33.osim");
+    model.initSystem();
+    const std::string q1 =
+            model.getCoordinateSet().get("q1").getAbsolutePathString();
+
+    // Swing the first link; the table is sampled more finely than the frame
+    // rate, so it is resampled.
+    TimeSeriesTable states;
+    states.setColumnLabels({q1 + "/value"});
+    for (int i = 0; i <= 102; ++i) {
+        states.appendRow(0.01 * i, {0.5 * sin(2 * Pi * 0.01 * i)});
+    }
+
+    ModelSceneExporter exporter;
+    exporter.setFrameRate(20);
+    exporter.setNumThreads(2);
+    const auto scene = exporter.generate(model, states);
+    ASSERT(scene.frames.size() == 21, __FILE__, __LINE__,
+            "Expected 21 frames.");
+    const auto& first = scene.frames.front();
+    const auto& quarter = scene.frames[5];
+    ASSERT(first.bodyTransforms.size() ==
+                    (size_t)model.getMatterSubsystem().getNumBodies(),
+            __FILE__, __LINE__, "Expected a transform for every body.");
+    ASSERT_EQUAL(0.25, quarter.time, 1e-12, __FILE__, __LINE__,
+            "Unexpected frame time.");
+    ASSERT((first.bodyTransforms[1].R().asMat33() -
+                   quarter.bodyTransforms[1].R().asMat33()).norm() > 0.1,
+            __FILE__, __LINE__, "Expected the first link to rotate.");
+    ASSERT(!quarter.decorations.empty(), __FILE__, __LINE__,
+            "Expected decorations for each frame.");
+
+    // Frames generated serially match those generated in parallel.
+    exporter.setNumThreads(1);
+    const auto serial = exporter.generate(model, states);
+    ASSERT((quarter.bodyTransforms[2].p() -
+                   serial.frames[5].bodyTransforms[2].p()).norm() < 1e-12,
+            __FILE__, __LINE__, "Serial and parallel frames differ.");
+
+    ModelSceneExporter::write(scene, "testVisualization_scene.osimscene");
+    std::ifstream file("testVisualization_scene.osimscene", std::ios::binary);
+    char magic[8];
+    file.read(magic, 8);
+    ASSERT(file.good() && std::string(magic, 8) == "OSIMSCN1", __FILE__,
+            __LINE__, "Expected the scene file to start with OSIMSCN1.");
+
+    states.setColumnLabels({"not_a_state"});
+    ASSERT_THROW(Exception, exporter.generate(model, states));
+}
+
 void testVisModel(Model& model, const std::string standard_filename)
 {
     bool visualDebug = false; // Turn on only if you want to see API visualizer live
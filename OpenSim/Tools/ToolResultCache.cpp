@@ -0,0 +1,190 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ToolResultCache.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ToolResultCache.h"
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Object.h>
+#include <OpenSim/Common/PropertySet.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+
+using namespace OpenSim;
+
+namespace {
+const std::uint64_t fnvOffsetBasis = 14695981039346656037ull;
+const std::uint64_t fnvPrime = 1099511628211ull;
+
+void hashBytes(std::uint64_t& hash, const char* bytes, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= (unsigned char)bytes[i];
+        hash *= fnvPrime;
+    }
+}
+
+std::string toHex(std::uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return buffer;
+}
+
+bool isAbsolutePath(const std::string& path) {
+    return path[0] == '/' || path[0] == '\\' ||
+           (path.size() > 1 && path[1] == ':');
+}
+} // anonymous namespace
+
+ToolResultCache::ToolResultCache(
+        const Object& tool, const std::string& cacheFile)
+        : m_tool(tool), m_cacheFile(cacheFile) {
+    m_setupHash = hashString(tool.dump());
+
+    const std::string setupDir =
+            IO::getParentDirectory(tool.getDocumentFileName());
+    const auto addFile = [&](const std::string& name,
+                                 const std::string& value) {
+        if (value.empty() || value == "Unassigned") return;
+        const std::string path =
+                isAbsolutePath(value) ? value : setupDir + value;
+        m_files.emplace_back(name, path);
+    };
+
+    // Properties declared with the property macros.
+    for (int i = 0; i < tool.getNumProperties(); ++i) {
+        const AbstractProperty& prop = tool.getPropertyByIndex(i);
+        if (prop.getTypeName() != "string") continue;
+        if (!prop.isListProperty()) {
+            if (prop.size() == 1) {
+                addFile(prop.getName(), prop.getValue<std::string>());
+            }
+            continue;
+        }
+        for (int j = 0; j < prop.size(); ++j) {
+            addFile(prop.getName() + "[" + std::to_string(j) + "]",
+                    prop.getValue<std::string>(j));
+        }
+    }
+
+    // Older properties (e.g., those of AbstractTool).
+    const PropertySet& propertySet = tool.getPropertySet();
+    for (int i = 0; i < propertySet.getSize(); ++i) {
+        const Property_Deprecated* prop = propertySet.get(i);
+        if (prop->getType() == Property_Deprecated::Str) {
+            addFile(prop->getName(), prop->getValueStr());
+        } else if (prop->getType() == Property_Deprecated::StrArray) {
+            const Array<std::string>& values = prop->getValueStrArray();
+            for (int j = 0; j < values.getSize(); ++j) {
+                addFile(prop->getName() + "[" + std::to_string(j) + "]",
+                        values[j]);
+            }
+        }
+    }
+}
+
+ToolResultCache::Stages ToolResultCache::computeStages() const {
+    Stages stages;
+    stages.emplace_back("setup", m_setupHash);
+    for (const auto& file : m_files) {
+        const std::string hash = hashFile(file.second);
+        if (!hash.empty()) stages.emplace_back(file.first, hash);
+    }
+    return stages;
+}
+
+ToolResultCache::Stages ToolResultCache::readCacheFile() const {
+    Stages stages;
+    std::ifstream stream(m_cacheFile);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        const auto space = line.find(' ');
+        if (space == std::string::npos) continue;
+        stages.emplace_back(line.substr(0, space), line.substr(space + 1));
+    }
+    return stages;
+}
+
+std::vector<std::string> ToolResultCache::findChangedStages() const {
+    const Stages current = computeStages();
+    std::vector<std::string> changed;
+    if (!IO::FileExists(m_cacheFile)) {
+        for (const auto& stage : current) changed.push_back(stage.first);
+        return changed;
+    }
+    const Stages cached = readCacheFile();
+    const auto find = [](const Stages& stages, const std::string& name) {
+        for (const auto& stage : stages) {
+            if (stage.first == name) return &stage.second;
+        }
+        return (const std::string*)nullptr;
+    };
+    for (const auto& stage : current) {
+        const std::string* cachedHash = find(cached, stage.first);
+        if (!cachedHash || *cachedHash != stage.second) {
+            changed.push_back(stage.first);
+        }
+    }
+    // A file that no longer exists (e.g., a deleted result).
+    for (const auto& stage : cached) {
+        if (!find(current, stage.first)) changed.push_back(stage.first);
+    }
+    return changed;
+}
+
+bool ToolResultCache::isUpToDate() const {
+    return findChangedStages().empty();
+}
+
+void ToolResultCache::write() const {
+    std::ofstream stream(m_cacheFile);
+    OPENSIM_THROW_IF(!stream.is_open(), Exception,
+            "Could not open cache file '{}' for writing.", m_cacheFile);
+    stream << "# Hashes of the inputs of the last successful run of "
+           << m_tool.getConcreteClassName() << " '" << m_tool.getName()
+           << "'.\n";
+    for (const auto& stage : computeStages()) {
+        stream << stage.first << " " << stage.second << "\n";
+    }
+}
+
+void ToolResultCache::invalidate() const {
+    std::remove(m_cacheFile.c_str());
+}
+
+std::string ToolResultCache::hashString(const std::string& content) {
+    std::uint64_t hash = fnvOffsetBasis;
+    hashBytes(hash, content.data(), content.size());
+    return toHex(hash);
+}
+
+std::string ToolResultCache::hashFile(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) return "";
+    std::uint64_t hash = fnvOffsetBasis;
+    char buffer[65536];
+    while (stream) {
+        stream.read(buffer, sizeof(buffer));
+        hashBytes(hash, buffer, (std::size_t)stream.gcount());
+    }
+    if (stream.bad()) return "";
+    return toHex(hash);
+}
@@ -0,0 +1,101 @@
+#ifndef OPENSIM_TOOL_RESULT_CACHE_H_
+#define OPENSIM_TOOL_RESULT_CACHE_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ToolResultCache.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OpenSim {
+
+class Object;
+
+/** Decide whether a tool must be run again, by comparing content hashes of
+its inputs with those recorded after its last successful run.
+
+The inputs of a tool are divided into stages, which are compared separately:
+ - "setup": the tool's properties, serialized to XML;
+ - one stage per file named by a string property of the tool (e.g.,
+   model_file, marker_file, coordinates_file, external_loads_file, or an
+   entry of force_set_files). Relative paths are relative to the directory of
+   the tool's setup file.
+
+Only files that exist are hashed. The files are hashed again when the cache
+is written (after the tool has run), so files written by the tool (e.g.,
+output_motion_file) are covered as well: deleting or editing a result causes
+the tool to run again. Files referenced by files (e.g., the data file of an
+ExternalLoads file) are not hashed.
+
+@code
+InverseKinematicsTool tool("ik_setup.xml");
+ToolResultCache cache(tool, "ik_setup.xml.cache");
+if (!cache.isUpToDate()) {
+    if (tool.run()) cache.write();
+}
+@endcode
+
+This is used by `opensim-cmd run-tool --cache`. The tool must outlive the
+cache. */
+class OSIMTOOLS_API ToolResultCache {
+public:
+    /** The hash of the setup is computed now, so that the tool's properties
+    can change while the tool runs. */
+    ToolResultCache(const Object& tool, const std::string& cacheFile);
+
+    const std::string& getCacheFile() const { return m_cacheFile; }
+
+    /** The names of the stages whose hashes differ from those in the cache
+    file, including stages that were added or removed. If there is no cache
+    file, all stages are returned. */
+    std::vector<std::string> findChangedStages() const;
+    /** Whether a cache file exists and no stage has changed. */
+    bool isUpToDate() const;
+    /** Record the current hashes of all stages in the cache file. Call this
+    after the tool ran successfully. */
+    void write() const;
+    /** Delete the cache file, so that the tool runs again. */
+    void invalidate() const;
+
+    /** A 64-bit FNV-1a hash as 16 hexadecimal digits. */
+    static std::string hashString(const std::string& content);
+    /** Hash the content of a file; returns an empty string if the file
+    cannot be read. */
+    static std::string hashFile(const std::string& path);
+
+private:
+    /// Pairs of stage name and hash, in the order of the tool's properties.
+    using Stages = std::vector<std::pair<std::string, std::string>>;
+    Stages computeStages() const;
+    Stages readCacheFile() const;
+
+    const Object& m_tool;
+    std::string m_cacheFile;
+    std::string m_setupHash;
+    /// Pairs of stage name and resolved path of each input file.
+    std::vector<std::pair<std::string, std::string>> m_files;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TOOL_RESULT_CACHE_H_
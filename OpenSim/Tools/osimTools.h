@@ -49,6 +49,8 @@
 #include "SMC_Joint.h"
 #include "CMC_TaskSet.h"
 #include "CorrectionController.h"
+#include "ToolResultCache.h"
+#include "ScaleToolBatch.h"
 #include "RegisterTypes_osimTools.h"    // to expose RegisterTypes_osimTools
 
 #endif // OPENSIM_OSIMTOOLS_H_
@@ -543,6 +543,78 @@ TEST_CASE("Check derivatives with analytical deriv.; sparse Jacobian.")
     }
 }
 
+/// Evaluating the constraints uses working memory, so each thread needs its
+/// own copy of the problem.
+class SparseJacobianWithWorkingMemory : public SparseJacobian<double> {
+public:
+    void calc_constraints(
+            const VectorXd& x, Eigen::Ref<VectorXd> constr) const override {
+        m_x = x;
+        SparseJacobian<double>::calc_constraints(m_x, constr);
+    }
+    std::unique_ptr<const Problem<double>> clone_for_thread() const override {
+        ++m_num_copies;
+        return std::unique_ptr<const Problem<double>>(
+                new SparseJacobianWithWorkingMemory(*this));
+    }
+    mutable int m_num_copies = 0;
+private:
+    mutable VectorXd m_x;
+};
+
+TEST_CASE("Finite differences with multiple threads")
+{
+    VectorXd x(4);
+    x << 3.1, -1.5, -0.25, 5.3;
+    VectorXd lambda(5);
+    lambda << 0.5, 1.5, 2.5, 3.0, 0.19;
+    const double obj_factor = 1.0;
+
+    // Compute the Jacobian and Hessian with the given number of threads.
+    auto calc_derivatives = [&](const Problem<double>& problem,
+            int num_threads, VectorXd& jacobian, VectorXd& hessian) {
+        auto proxy = problem.make_decorator();
+        proxy->set_findiff_num_threads(num_threads);
+        proxy->set_findiff_hessian_step_size(1e-3);
+        SparsityCoordinates jac_sparsity;
+        SparsityCoordinates hes_sparsity;
+        proxy->calc_sparsity(proxy->make_initial_guess_from_bounds(),
+                jac_sparsity, true, hes_sparsity);
+        jacobian.resize(jac_sparsity.row.size());
+        proxy->calc_jacobian(problem.get_num_variables(), x.data(), true,
+                (unsigned)jacobian.size(), jacobian.data());
+        hessian.resize(hes_sparsity.row.size());
+        proxy->calc_hessian_lagrangian(problem.get_num_variables(), x.data(),
+                true, obj_factor, problem.get_num_constraints(), lambda.data(),
+                true, (unsigned)hessian.size(), hessian.data());
+    };
+
+    SparseJacobianWithWorkingMemory problem;
+    VectorXd serial_jacobian, serial_hessian;
+    calc_derivatives(problem, 1, serial_jacobian, serial_hessian);
+    REQUIRE(problem.m_num_copies == 0);
+
+    SECTION("Copies of the problem are evaluated concurrently") {
+        VectorXd jacobian, hessian;
+        calc_derivatives(problem, 3, jacobian, hessian);
+        REQUIRE(problem.m_num_copies == 2);
+        // Each perturbation is computed exactly as in serial.
+        REQUIRE(jacobian == serial_jacobian);
+        REQUIRE(hessian == serial_hessian);
+    }
+    SECTION("Problems without copies are evaluated serially") {
+        SparseJacobian<double> no_copies;
+        VectorXd jacobian, hessian;
+        calc_derivatives(no_copies, 3, jacobian, hessian);
+        REQUIRE(jacobian == serial_jacobian);
+        REQUIRE(hessian == serial_hessian);
+    }
+    SECTION("Invalid number of threads") {
+        auto proxy = problem.make_decorator();
+        REQUIRE_THROWS(proxy->set_findiff_num_threads(0));
+    }
+}
+
 TEST_CASE("Check finite differences on bounds", "[finitediff][!mayfail]")
 {
     HS071<adouble> problem;
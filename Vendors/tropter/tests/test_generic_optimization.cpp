@@ -23,6 +23,7 @@
 #include "testing.h"
 
 using Eigen::Vector4d;
+using Eigen::Vector3d;
 using Eigen::Vector2d;
 using Eigen::VectorXd;
 
@@ -274,3 +275,71 @@ TEST_CASE("OptimizerSolver options") {
 }
 
 
+
+/// The target point is tape data, so problems with different targets can
+/// share tapes.
+template<typename T>
+class TapedTarget : public Problem<T> {
+public:
+    TapedTarget(std::string key, Vector2d target)
+            : Problem<T>(2, 1), m_key(std::move(key)), m_target(target) {
+        this->set_variable_bounds(Vector2d(-5, -5), Vector2d(5, 5));
+        this->set_constraint_bounds(VectorXd::Zero(1), VectorXd::Zero(1));
+    }
+    std::string get_tape_key() const override { return m_key; }
+    VectorXd get_tape_data_values() const override { return m_target; }
+    void calc_objective(const VectorX<T>& x, T& obj_value) const override {
+        const auto& target = this->get_tape_data();
+        obj_value = (x[0] - target[0]) * (x[0] - target[0])
+                + (x[1] - target[1]) * (x[1] - target[1]);
+    }
+    void calc_constraints(const VectorX<T>& x,
+            Eigen::Ref<VectorX<T>> constr) const override {
+        constr[0] = x[0] + x[1];
+    }
+private:
+    std::string m_key;
+    Vector2d m_target;
+};
+
+TEST_CASE("Reusing ADOL-C tapes across problems") {
+    // The solution is x = [(a - b) / 2, (b - a) / 2] for target [a, b].
+    const auto solve = [](const std::string& key, Vector2d target) {
+        TapedTarget<adouble> problem(key, target);
+        IPOPTSolver solver(problem);
+        return solver.optimize(Vector2d(0, 0)).variables;
+    };
+    for (const std::string key : {"", "test_generic_optimization_target"}) {
+        CAPTURE(key);
+        TROPTER_REQUIRE_EIGEN(solve(key, Vector2d(1.5, -2)),
+                Vector2d(1.75, -1.75), 1e-8);
+        // The second problem reuses the tapes (if the key is nonempty) but
+        // must use its own target.
+        TROPTER_REQUIRE_EIGEN(solve(key, Vector2d(1, 3)),
+                Vector2d(-1, 1), 1e-8);
+    }
+
+    SECTION("Mismatched structure") {
+        class Larger : public Problem<adouble> {
+        public:
+            Larger() : Problem<adouble>(3, 1) {
+                set_variable_bounds(Vector3d(-5, -5, -5), Vector3d(5, 5, 5));
+                set_constraint_bounds(VectorXd::Zero(1), VectorXd::Zero(1));
+            }
+            std::string get_tape_key() const override
+            {   return "test_generic_optimization_target"; }
+            VectorXd get_tape_data_values() const override
+            {   return Vector2d(0, 0); }
+            void calc_objective(const VectorX<adouble>& x,
+                    adouble& f) const override
+            {   f = x.squaredNorm(); }
+            void calc_constraints(const VectorX<adouble>& x,
+                    Eigen::Ref<VectorX<adouble>> constr) const override
+            {   constr[0] = x.sum(); }
+        };
+        Larger problem;
+        IPOPTSolver solver(problem);
+        REQUIRE_THROWS_WITH(solver.optimize(Vector3d(0, 0, 0)),
+                Catch::Contains("were recorded for a problem with 2"));
+    }
+}
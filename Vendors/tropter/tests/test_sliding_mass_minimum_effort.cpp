@@ -243,3 +243,37 @@ TEST_CASE("SNOPT, hermite-simpson") {
 }
 #endif
 
+
+/// SlidingMass has no working memory, so it can be evaluated from multiple
+/// threads.
+class ThreadSafeSlidingMass : public SlidingMass<double> {
+public:
+    bool is_thread_safe() const override { return true; }
+    std::shared_ptr<const tropter::Problem<double>> clone_for_thread()
+            const override {
+        return std::make_shared<ThreadSafeSlidingMass>(*this);
+    }
+};
+
+TEST_CASE("Multiple threads give the same solution") {
+    auto solve = [](std::shared_ptr<const tropter::Problem<double>> ocp,
+            const std::string& transcription, int num_threads) {
+        DirectCollocationSolver<double> dircol(ocp, transcription, "ipopt");
+        dircol.set_num_threads(num_threads);
+        dircol.get_opt_solver().set_findiff_num_threads(num_threads);
+        dircol.get_opt_solver().set_findiff_hessian_step_size(1e-3);
+        return dircol.solve();
+    };
+    for (const std::string transcription : {"trapezoidal", "hermite-simpson"}) {
+        INFO(transcription);
+        const Solution serial = solve(
+                std::make_shared<SlidingMass<double>>(), transcription, 4);
+        const Solution parallel = solve(
+                std::make_shared<ThreadSafeSlidingMass>(), transcription, 4);
+        REQUIRE(serial.success);
+        REQUIRE(parallel.success);
+        TROPTER_REQUIRE_EIGEN(parallel.states, serial.states, 1e-10);
+        TROPTER_REQUIRE_EIGEN(parallel.controls, serial.controls, 1e-10);
+        REQUIRE(parallel.objective == Approx(serial.objective));
+    }
+}
@@ -100,6 +100,15 @@ public:
     bool get_interpolate_control_midpoints() const
     { return m_interpolate_control_midpoints; }
 
+    /// The number of threads used to evaluate the optimal control problem at
+    /// the mesh points, if the problem is thread-safe (see
+    /// Problem::is_thread_safe()). Only used when the scalar type is double.
+    /// This setting is copied into the underlying transcription scheme.
+    /// Default: 1.
+    void set_num_threads(int num_threads);
+    /// @copydoc set_num_threads()
+    int get_num_threads() const { return m_transcription->get_num_threads(); }
+
     /// Solve the problem using an initial guess that is based on the bounds
     /// on the variables.
     Solution solve() const;
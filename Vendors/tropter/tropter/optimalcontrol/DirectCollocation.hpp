@@ -92,6 +92,11 @@ void DirectCollocationSolver<T>::set_interpolate_control_midpoints(bool tf) {
     m_interpolate_control_midpoints = tf;
 }
 
+template<typename T>
+void DirectCollocationSolver<T>::set_num_threads(int num_threads) {
+    m_transcription->set_num_threads(num_threads);
+}
+
 template<typename T>
 Solution DirectCollocationSolver<T>::solve() const
 {
@@ -19,6 +19,7 @@
 #include "Iterate.h"
 #include <tropter/common.h>
 #include <Eigen/Dense>
+#include <memory>
 
 namespace tropter {
 
@@ -407,6 +408,39 @@ public:
     /// to ensure determine which cost to compute.
     virtual void calc_cost_integrand(
             int cost_index, const Input<T>& in, T& integrand) const;
+    /// Implement this function to allow the transcribed problem's
+    /// finite-difference derivatives to be computed with multiple threads
+    /// (see optimization::Solver::set_findiff_num_threads()). Return a copy of
+    /// this problem that can be evaluated at the same time as this problem
+    /// (e.g., with its own mutable working memory). The default returns
+    /// nullptr, in which case derivatives are computed serially.
+    virtual std::shared_ptr<const Problem<T>> clone_for_thread() const
+    {   return nullptr; }
+    /// Implement this function to return true if
+    /// calc_differential_algebraic_equations() and calc_cost_integrand() can
+    /// be called for different mesh points at the same time, from different
+    /// threads (initialize_on_iterate() is still called from a single thread
+    /// beforehand). The transcriptions then evaluate the mesh points in
+    /// parallel when the scalar type is double (see
+    /// DirectCollocationSolver::set_num_threads()). Default: false.
+    virtual bool is_thread_safe() const { return false; }
+    /// Implement this function to let a later problem with the same key
+    /// reuse the ADOL-C tapes and sparsity patterns of this problem (see
+    /// optimization::Problem::get_tape_key()). The transcriptions add the
+    /// mesh to the key. The key must identify the number of variables and
+    /// everything that the DAE, cost and path constraint functions record on
+    /// the tape, except for the values returned by get_tape_data_values(),
+    /// which must be accessed through get_tape_data(). Default: empty (no
+    /// reuse).
+    virtual std::string get_tape_key() const { return {}; }
+    /// The values of the data that may differ between problems with the same
+    /// tape key (e.g., reference data for tracking). Default: empty.
+    virtual Eigen::VectorXd get_tape_data_values() const { return {}; }
+    /// The tape data (get_tape_data_values(), in the scalar type of the
+    /// problem); this is valid while the problem is being solved.
+    const VectorX<T>& get_tape_data() const { return m_tape_data; }
+    /// This is called by the transcription before the problem is evaluated.
+    void set_tape_data(const VectorX<T>& data) const { m_tape_data = data; }
     /// @}
 
     /// @name Helpers for setting an initial guess
@@ -549,6 +583,7 @@ private:
     std::vector<ParameterInfo> m_parameter_infos;
     std::vector<CostInfo> m_cost_infos;
     std::vector<PathConstraintInfo> m_path_constraint_infos;
+    mutable VectorX<T> m_tape_data;
 };
 
 } // namespace tropter
@@ -21,6 +21,8 @@
 #include <tropter/optimization/ProblemDecorator_adouble.h>
 #include <tropter/optimalcontrol/Iterate.h>
 
+#include <type_traits>
+
 //namespace transcription {
 //
 //class Trapezoidal;
@@ -96,8 +98,43 @@ public:
     std::string get_exact_hessian_block_sparsity_mode () const
     {   return m_exact_hessian_block_sparsity_mode; }
 
+    /// The number of threads used to evaluate the optimal control problem at
+    /// the mesh points within one evaluation of the objective or constraints
+    /// (default: 1). This only has an effect if the scalar type is double and
+    /// the optimal control problem is thread-safe (see
+    /// Problem::is_thread_safe()).
+    void set_num_threads(int num_threads) {
+        TROPTER_VALUECHECK(num_threads >= 1, "num_threads", num_threads,
+                "at least 1");
+        m_num_threads = num_threads;
+    }
+    /// @copydoc set_num_threads()
+    int get_num_threads() const { return m_num_threads; }
+
+protected:
+    /// Give every time point of each row of a trajectory of variable
+    /// magnitudes (see calc_scaling()) the largest magnitude in that row, so
+    /// that a continuous variable is scaled the same way at all times.
+    template <typename TrajectoryView>
+    static void use_largest_magnitude_across_time(TrajectoryView&& traj) {
+        for (Eigen::Index i = 0; i < traj.rows(); ++i) {
+            traj.row(i).setConstant(traj.row(i).maxCoeff());
+        }
+    }
+
+    /// The number of threads to use for the mesh points of the given optimal
+    /// control problem.
+    template <typename OCProblem>
+    int get_num_mesh_threads(const OCProblem& ocproblem) const {
+        if (!std::is_same<T, double>::value || !ocproblem.is_thread_safe()) {
+            return 1;
+        }
+        return m_num_threads;
+    }
+
 private:
     std::string m_exact_hessian_block_sparsity_mode{"dense"};
+    int m_num_threads = 1;
 
 };
 
@@ -18,6 +18,7 @@
 
 #include "HermiteSimpson.h"
 #include <iomanip>
+#include <sstream>
 
 #include <tropter/Exception.hpp>
 #include <tropter/SparsityPattern.h>
@@ -318,6 +319,31 @@ void HermiteSimpson<T>::set_ocproblem(
     m_ocproblem->initialize_on_mesh(m_mesh_and_midpoints);
 }
 
+template <typename T>
+std::unique_ptr<const optimization::Problem<T>>
+HermiteSimpson<T>::clone_for_thread() const {
+    std::shared_ptr<const OCProblem> ocproblem =
+            m_ocproblem->clone_for_thread();
+    if (!ocproblem) return nullptr;
+    ocproblem->initialize_on_mesh(m_mesh_and_midpoints);
+    std::unique_ptr<HermiteSimpson<T>> copy(new HermiteSimpson<T>(*this));
+    copy->m_ocproblem = std::move(ocproblem);
+    return std::move(copy);
+}
+
+template <typename T>
+std::string HermiteSimpson<T>::get_tape_key() const {
+    const std::string ockey = m_ocproblem->get_tape_key();
+    if (ockey.empty()) return {};
+    // The mesh is recorded on the tape as constants.
+    std::ostringstream key;
+    key << "HermiteSimpson:" << ockey << ":";
+    key << (m_interpolate_control_midpoints ? "interpolated" : "free");
+    key << std::setprecision(17);
+    for (const auto& mesh_point : m_mesh) key << ":" << mesh_point;
+    return key.str();
+}
+
 template <typename T>
 void HermiteSimpson<T>::calc_objective(
         const VectorX<T>& x, T& obj_value) const {
@@ -337,6 +363,7 @@ void HermiteSimpson<T>::calc_objective(
     // Initialize on iterate.
     // ----------------------
     m_ocproblem->initialize_on_iterate(parameters);
+    const int num_threads = this->get_num_mesh_threads(*m_ocproblem);
 
     for (int i_cost = 0; i_cost < m_ocproblem->get_num_costs(); ++i_cost) {
         // Compute integral.
@@ -344,27 +371,23 @@ void HermiteSimpson<T>::calc_objective(
         T integral = 0;
         if (m_ocproblem->get_cost_requires_integral(i_cost)) {
             m_integrand.setZero();
-            int i_diff = 0;
-            // TODO avoid this copy. use Ref?
-            VectorX<T> diffuse_to_use;
-            for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
+            parallel_for(m_num_col_points, num_threads,
+                    [&](int i_col, int) {
                 const T time =
                         duration * m_mesh_and_midpoints[i_col] + initial_time;
                 // Only pass diffuse variables on the midpoints where they are
                 // defined, otherwise pass an empty variable.
-                if (i_col % 2) {
-                    diffuse_to_use = diffuses.col(i_diff);
-                    ++i_diff;
-                } else {
-                    diffuse_to_use = m_empty_diffuse_col;
-                }
+                // TODO avoid this copy. use Ref?
+                const VectorX<T> diffuse_to_use = (i_col % 2)
+                        ? VectorX<T>(diffuses.col(i_col / 2))
+                        : m_empty_diffuse_col;
 
                 m_ocproblem->calc_cost_integrand(i_cost,
                         {i_col, time, states.col(i_col), controls.col(i_col),
                                 adjuncts.col(i_col), diffuse_to_use,
                                 parameters},
                         m_integrand[i_col]);
-            }
+            });
 
             for (int i_col = 0; i_col < m_num_col_points; ++i_col) {
                 integral += m_simpson_quadrature_coefficients[i_col] *
@@ -418,29 +441,35 @@ void HermiteSimpson<T>::calc_constraints(
 
     // Obtain state derivatives at each mesh point.
     // --------------------------------------------
-    // Evaluate points on the mesh.
-    int i_mesh = 0;
-    for (int i_col = 0; i_col < m_num_col_points; i_col += 2) {
-        const T time = duration * m_mesh_and_midpoints[i_col] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_col, time, states.col(i_col), controls.col(i_col),
-                        adjuncts.col(i_col), m_empty_diffuse_col, parameters},
-                {m_derivs_mesh.col(i_mesh),
-                        constr_view.path_constraints.col(i_mesh)});
-        i_mesh++;
-    }
-    // Evaluate points on the mesh interval interior.
-    int i_mid = 0;
-    for (int i_col = 1; i_col < m_num_col_points; i_col += 2) {
+    // The collocation points are independent, so they may be evaluated in
+    // parallel; each writes only its own columns of the outputs.
+    // Points on the mesh (even collocation points) are evaluated first,
+    // followed by points on the mesh interval interior (odd points).
+    parallel_for(m_num_col_points, this->get_num_mesh_threads(*m_ocproblem),
+            [&](int index, int) {
+        const int i_col = index < m_num_mesh_points
+                                  ? 2 * index
+                                  : 2 * (index - m_num_mesh_points) + 1;
         const T time = duration * m_mesh_and_midpoints[i_col] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_col, time, states.col(i_col), controls.col(i_col),
-                        adjuncts.col(i_col), diffuses.col(i_mid), parameters},
-                {m_derivs_mid.col(i_mid), m_empty_path_constraint_col});
-        TROPTER_THROW_IF(m_empty_path_constraint_col.size() != 0,
-                "Invalid resize of empty path constraint output.");
-        i_mid++;
-    }
+        if (i_col % 2 == 0) {
+            const int i_mesh = i_col / 2;
+            m_ocproblem->calc_differential_algebraic_equations(
+                    {i_col, time, states.col(i_col), controls.col(i_col),
+                            adjuncts.col(i_col), m_empty_diffuse_col,
+                            parameters},
+                    {m_derivs_mesh.col(i_mesh),
+                            constr_view.path_constraints.col(i_mesh)});
+        } else {
+            const int i_mid = i_col / 2;
+            m_ocproblem->calc_differential_algebraic_equations(
+                    {i_col, time, states.col(i_col), controls.col(i_col),
+                            adjuncts.col(i_col), diffuses.col(i_mid),
+                            parameters},
+                    {m_derivs_mid.col(i_mid), m_empty_path_constraint_col});
+            TROPTER_THROW_IF(m_empty_path_constraint_col.size() != 0,
+                    "Invalid resize of empty path constraint output.");
+        }
+    });
 
     // Compute constraint defects.
     // ---------------------------
@@ -497,6 +526,40 @@ void HermiteSimpson<T>::calc_constraints(
     }
 }
 
+template <typename T>
+void HermiteSimpson<T>::calc_scaling(const Eigen::VectorXd& guess,
+        Eigen::VectorXd& variable_scaling,
+        Eigen::VectorXd& constraint_scaling) const {
+    Base<T>::calc_scaling(guess, variable_scaling, constraint_scaling);
+    auto states = make_states_trajectory_view(variable_scaling);
+    auto controls = make_controls_trajectory_view(variable_scaling);
+    this->use_largest_magnitude_across_time(states);
+    this->use_largest_magnitude_across_time(controls);
+    this->use_largest_magnitude_across_time(
+            make_adjuncts_trajectory_view(variable_scaling));
+    this->use_largest_magnitude_across_time(
+            make_diffuses_trajectory_view(variable_scaling));
+    // The Hermite and Simpson defects have the units of the states, and the
+    // control midpoint constraints have the units of the controls.
+    if (m_num_defects) {
+        Eigen::Map<Eigen::MatrixXd> defects(constraint_scaling.data(),
+                2 * m_num_states, m_num_mesh_intervals);
+        for (int imesh = 0; imesh < m_num_mesh_intervals; ++imesh) {
+            defects.col(imesh).head(m_num_states) = states.col(0);
+            defects.col(imesh).tail(m_num_states) = states.col(0);
+        }
+    }
+    if (m_num_controls && m_interpolate_control_midpoints) {
+        Eigen::Map<Eigen::MatrixXd> control_midpoints(
+                constraint_scaling.data() + m_num_dynamics_constraints +
+                        m_num_path_traj_constraints,
+                m_num_controls, m_num_mesh_intervals);
+        for (int imesh = 0; imesh < m_num_mesh_intervals; ++imesh) {
+            control_midpoints.col(imesh) = controls.col(0);
+        }
+    }
+}
+
 template <typename T>
 void HermiteSimpson<T>::calc_sparsity_hessian_lagrangian(
         const Eigen::VectorXd& x, SymmetricSparsityPattern& hescon_sparsity,
@@ -69,6 +69,20 @@ public:
 
     void set_ocproblem(std::shared_ptr<const OCProblem> ocproblem);
 
+    /// Returns nullptr unless the optimal control problem provides a copy
+    /// with clone_for_thread().
+    std::unique_ptr<const optimization::Problem<T>> clone_for_thread()
+            const override;
+    /// The optimal control problem's tape key, followed by the mesh.
+    /// This is empty if the optimal control problem's key is empty.
+    std::string get_tape_key() const override;
+    Eigen::VectorXd get_tape_data_values() const override {
+        return m_ocproblem->get_tape_data_values();
+    }
+    void set_tape_data(const VectorX<T>& data) const override {
+        optimization::Problem<T>::set_tape_data(data);
+        m_ocproblem->set_tape_data(data);
+    }
     void calc_objective(const VectorX<T>& x, T& obj_value) const override;
     void calc_constraints(const VectorX<T>& x,
             Eigen::Ref<VectorX<T>> constr) const override;
@@ -79,6 +93,12 @@ public:
     void calc_sparsity_hessian_lagrangian(const Eigen::VectorXd& x,
             SymmetricSparsityPattern&,
             SymmetricSparsityPattern&) const override;
+    /// Each continuous variable is given a single magnitude across the mesh,
+    /// and the defects of each state are scaled by the magnitude of that
+    /// state.
+    void calc_scaling(const Eigen::VectorXd& guess,
+            Eigen::VectorXd& variable_scaling,
+            Eigen::VectorXd& constraint_scaling) const override;
 
     /// For continuous variables, the format is
     /// `<continuous-variable-name>_<mesh-point-index>`. The mesh point index is
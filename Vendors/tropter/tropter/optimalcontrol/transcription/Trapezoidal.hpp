@@ -18,6 +18,7 @@
 
 #include "Trapezoidal.h"
 #include <iomanip>
+#include <sstream>
 
 #include <tropter/Exception.hpp>
 #include <tropter/SparsityPattern.h>
@@ -215,6 +216,30 @@ void Trapezoidal<T>::set_ocproblem(std::shared_ptr<const OCProblem> ocproblem) {
     m_ocproblem->initialize_on_mesh(m_mesh_eigen);
 }
 
+template <typename T>
+std::unique_ptr<const optimization::Problem<T>>
+Trapezoidal<T>::clone_for_thread() const {
+    std::shared_ptr<const OCProblem> ocproblem =
+            m_ocproblem->clone_for_thread();
+    if (!ocproblem) return nullptr;
+    ocproblem->initialize_on_mesh(m_mesh_eigen);
+    std::unique_ptr<Trapezoidal<T>> copy(new Trapezoidal<T>(*this));
+    copy->m_ocproblem = std::move(ocproblem);
+    return std::move(copy);
+}
+
+template <typename T>
+std::string Trapezoidal<T>::get_tape_key() const {
+    const std::string ockey = m_ocproblem->get_tape_key();
+    if (ockey.empty()) return {};
+    // The mesh is recorded on the tape as constants.
+    std::ostringstream key;
+    key << "Trapezoidal:" << ockey << ":";
+    key << std::setprecision(17);
+    for (const auto& mesh_point : m_mesh) key << ":" << mesh_point;
+    return key.str();
+}
+
 template <typename T>
 void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
     // TODO move this to a "make_variables_view()"
@@ -232,6 +257,7 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
     // Initialize on iterate.
     // ----------------------
     m_ocproblem->initialize_on_iterate(parameters);
+    const int num_threads = this->get_num_mesh_threads(*m_ocproblem);
 
     for (int i_cost = 0; i_cost < m_ocproblem->get_num_costs(); ++i_cost) {
         // Compute integral.
@@ -239,14 +265,15 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
         T integral = 0;
         if (m_ocproblem->get_cost_requires_integral(i_cost)) {
             m_integrand.setZero();
-            for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
+            parallel_for(m_num_mesh_points, num_threads,
+                    [&](int i_mesh, int) {
                 const T time = duration * m_mesh[i_mesh] + initial_time;
                 m_ocproblem->calc_cost_integrand(i_cost,
                         {i_mesh, time, states.col(i_mesh), controls.col(i_mesh),
                                 adjuncts.col(i_mesh), m_empty_diffuse_col,
                                 parameters},
                         m_integrand[i_mesh]);
-            }
+            });
 
             for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
                 integral += m_trapezoidal_quadrature_coefficients[i_mesh] *
@@ -276,7 +303,6 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
 template <typename T>
 void Trapezoidal<T>::calc_constraints(
         const VectorX<T>& x, Eigen::Ref<VectorX<T>> constraints) const {
-    // TODO parallelize.
     const T& initial_time = x[0];
     const T& final_time = x[1];
     const T duration = final_time - initial_time;
@@ -300,8 +326,10 @@ void Trapezoidal<T>::calc_constraints(
     // --------------------------------------------
     // TODO storing 1 too many derivatives trajectory; don't need the first
     // xdot (at t0). (TODO I don't think this is true anymore).
-    // TODO tradeoff between memory and parallelism.
-    for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
+    // Mesh points are independent, so they may be evaluated in parallel;
+    // each writes only its own column of the outputs.
+    parallel_for(m_num_mesh_points, this->get_num_mesh_threads(*m_ocproblem),
+            [&](int i_mesh, int) {
         // TODO should pass the time.
         const T time = duration * m_mesh[i_mesh] + initial_time;
         m_ocproblem->calc_differential_algebraic_equations(
@@ -309,7 +337,7 @@ void Trapezoidal<T>::calc_constraints(
                         adjuncts.col(i_mesh), m_empty_diffuse_col, parameters},
                 {m_derivs.col(i_mesh),
                         constr_view.path_constraints.col(i_mesh)});
-    }
+    });
 
     // Compute constraint defects.
     // ---------------------------
@@ -330,6 +358,27 @@ void Trapezoidal<T>::calc_constraints(
     }
 }
 
+template <typename T>
+void Trapezoidal<T>::calc_scaling(const Eigen::VectorXd& guess,
+        Eigen::VectorXd& variable_scaling,
+        Eigen::VectorXd& constraint_scaling) const {
+    Base<T>::calc_scaling(guess, variable_scaling, constraint_scaling);
+    auto states = make_states_trajectory_view(variable_scaling);
+    this->use_largest_magnitude_across_time(states);
+    this->use_largest_magnitude_across_time(
+            make_controls_trajectory_view(variable_scaling));
+    this->use_largest_magnitude_across_time(
+            make_adjuncts_trajectory_view(variable_scaling));
+    // The defects have the units of the states.
+    if (m_num_defects) {
+        Eigen::Map<Eigen::MatrixXd> defects(
+                constraint_scaling.data(), m_num_states, m_num_defects);
+        for (int i_interval = 0; i_interval < m_num_defects; ++i_interval) {
+            defects.col(i_interval) = states.col(0);
+        }
+    }
+}
+
 template <typename T>
 void Trapezoidal<T>::calc_sparsity_hessian_lagrangian(const Eigen::VectorXd& x,
         SymmetricSparsityPattern& hescon_sparsity,
@@ -75,6 +75,18 @@ public:
     /// in [-1, 1] clamped by the bounds.
     // TODO rename to random_variables
     Eigen::VectorXd make_random_iterate_within_bounds() const;
+    /// Compute a characteristic (positive) magnitude for each variable and
+    /// each constraint, used by solvers with automatic scaling (see
+    /// Solver::set_automatic_scaling()). The solver sees each variable and
+    /// each constraint divided by its magnitude. By default, the magnitude of
+    /// a variable is its largest finite bound, which is compared with the
+    /// guess if the variable is unbounded on either side; a magnitude of 0 is
+    /// replaced with 1. The constraints are not scaled by default. Override
+    /// this function if the problem knows more (e.g., that a group of
+    /// variables, or a constraint and a variable, share units).
+    virtual void calc_scaling(const Eigen::VectorXd& guess,
+            Eigen::VectorXd& variable_scaling,
+            Eigen::VectorXd& constraint_scaling) const;
     /// When using finite differences to compute derivatives, should we use
     /// the user-supplied sparsity pattern of the Hessian (provided by
     /// implementing calc_sparsity_hessian_lagrangian())? If false, then we
@@ -179,6 +191,26 @@ AbstractProblem::make_initial_guess_from_bounds() const
     }
     return guess;
 }
+inline void AbstractProblem::calc_scaling(const Eigen::VectorXd& guess,
+        Eigen::VectorXd& variable_scaling,
+        Eigen::VectorXd& constraint_scaling) const {
+    const auto& lower = get_variable_lower_bounds();
+    const auto& upper = get_variable_upper_bounds();
+    assert(guess.size() == lower.size());
+    variable_scaling.resize(lower.size());
+    for (Eigen::Index i = 0; i < lower.size(); ++i) {
+        double magnitude = 0;
+        if (!std::isinf(lower[i])) magnitude = std::abs(lower[i]);
+        if (!std::isinf(upper[i]))
+            magnitude = std::max(magnitude, std::abs(upper[i]));
+        if ((std::isinf(lower[i]) || std::isinf(upper[i])) &&
+                !std::isnan(guess[i]))
+            magnitude = std::max(magnitude, std::abs(guess[i]));
+        variable_scaling[i] =
+                magnitude > 0 && !std::isinf(magnitude) ? magnitude : 1.0;
+    }
+    constraint_scaling = Eigen::VectorXd::Ones(get_num_constraints());
+}
 inline Eigen::VectorXd
 AbstractProblem::make_random_iterate_within_bounds() const {
     const auto lower = get_variable_lower_bounds().array();
@@ -41,6 +41,13 @@ public:
     const double& get_optimal_objective_value() const
     {   return m_optimal_obj_value; }
     const int& get_num_iterations() const { return m_num_iterations; }
+    /// Provide the magnitudes of the variables and constraints; IPOPT must
+    /// use nlp_scaling_method=user-scaling.
+    void set_scaling(Eigen::VectorXd variable_scaling,
+            Eigen::VectorXd constraint_scaling) {
+        m_variable_scaling = std::move(variable_scaling);
+        m_constraint_scaling = std::move(constraint_scaling);
+    }
 private:
     // TODO move to Problem if more than one solver would need this.
     // TODO should use fancy arguments to avoid temporaries and to exploit
@@ -67,6 +74,11 @@ private:
                             Index num_constraints, bool init_lambda,
                             Number* lambda) override;
 
+    bool get_scaling_parameters(Number& obj_scaling,
+            bool& use_x_scaling, Index num_variables, Number* x_scaling,
+            bool& use_g_scaling, Index num_constraints,
+            Number* g_scaling) override;
+
     bool eval_f(Index num_variables, const Number* x, bool new_x,
                 Number& obj_value) override;
 
@@ -117,6 +129,8 @@ private:
     unsigned m_num_constraints = std::numeric_limits<unsigned>::max();
 
     Eigen::VectorXd m_initial_guess;
+    Eigen::VectorXd m_variable_scaling;
+    Eigen::VectorXd m_constraint_scaling;
     Eigen::VectorXd m_solution;
     double m_optimal_obj_value = std::numeric_limits<double>::quiet_NaN();
     int m_num_iterations = -1;
@@ -200,6 +214,10 @@ Solution IPOPTSolver::optimize_impl(const VectorXd& guess) const {
         "provided.", jacobian_approx);
     ipoptions->SetStringValue("jacobian_approximation", jacobian_approx);
 
+    if (get_automatic_scaling()) {
+        ipoptions->SetStringValue("nlp_scaling_method", "user-scaling");
+    }
+
     if (const auto opt = get_hessian_approximation()) {
         const auto& value = opt.value();
         TROPTER_THROW_IF(value != "exact" && value != "limited-memory",
@@ -270,6 +288,13 @@ Solution IPOPTSolver::optimize_impl(const VectorXd& guess) const {
             need_exact_hessian, hessian_sparsity);
     nlp->initialize(guess, std::move(jacobian_sparsity),
             std::move(hessian_sparsity));
+    if (get_automatic_scaling()) {
+        VectorXd variable_scaling;
+        VectorXd constraint_scaling;
+        m_problem->calc_scaling(guess, variable_scaling, constraint_scaling);
+        nlp->set_scaling(
+                std::move(variable_scaling), std::move(constraint_scaling));
+    }
 
     // Optimize!!!
     // -----------
@@ -334,6 +359,26 @@ void IPOPTSolver::TNLP::initialize(const VectorXd& guess,
     m_hessian_num_nonzeros = (unsigned)m_hessian_sparsity.row.size();
 }
 
+bool IPOPTSolver::TNLP::get_scaling_parameters(Number& obj_scaling,
+        bool& use_x_scaling, Index num_variables, Number* x_scaling,
+        bool& use_g_scaling, Index num_constraints, Number* g_scaling) {
+    // IPOPT multiplies the variables and constraints by these factors.
+    obj_scaling = 1.0;
+    use_x_scaling = m_variable_scaling.size() == num_variables;
+    if (use_x_scaling) {
+        for (Index ivar = 0; ivar < num_variables; ++ivar) {
+            x_scaling[ivar] = 1.0 / m_variable_scaling[ivar];
+        }
+    }
+    use_g_scaling = m_constraint_scaling.size() == num_constraints;
+    if (use_g_scaling) {
+        for (Index icon = 0; icon < num_constraints; ++icon) {
+            g_scaling[icon] = 1.0 / m_constraint_scaling[icon];
+        }
+    }
+    return true;
+}
+
 bool IPOPTSolver::TNLP::get_bounds_info(
         Index num_variables, Number* x_lower, Number* x_upper,
         Index num_constraints, Number* g_lower, Number* g_upper) {
@@ -64,6 +64,44 @@ public:
     virtual void calc_constraints(const VectorX<T>& variables,
             Eigen::Ref<VectorX<T>> constr) const;
 
+    /// Implement this function to allow finite-difference derivatives to be
+    /// computed with multiple threads (see
+    /// ProblemDecorator::set_findiff_num_threads()). Return a copy of this
+    /// problem, with its own working memory, whose objective and constraints
+    /// can be evaluated at the same time as those of this problem. The
+    /// default returns nullptr, in which case derivatives are computed
+    /// serially.
+    virtual std::unique_ptr<const Problem<T>> clone_for_thread() const
+    {   return nullptr; }
+
+    /// @name Reusing ADOL-C tapes
+    /// With T = adouble, the objective, constraints and Lagrangian are
+    /// recorded on ADOL-C tapes before each solve, and the sparsity of the
+    /// derivatives is computed from the tapes. If get_tape_key() returns a
+    /// non-empty string, the tapes and sparsity patterns are kept after the
+    /// solve, and a later problem with the same key reuses them instead of
+    /// tracing and detecting sparsity again. The key must identify everything
+    /// that is recorded on the tapes: the number of variables and
+    /// constraints, the control flow, and all constants. Data that differs
+    /// between problems with the same structure (e.g., reference data for
+    /// tracking) must be recorded as tape parameters: return the values from
+    /// get_tape_data_values(), and use the elements of get_tape_data() in
+    /// calc_objective() and calc_constraints() instead of the values.
+    /// With T = double, the key is ignored and get_tape_data() holds the
+    /// values.
+    /// @{
+    virtual std::string get_tape_key() const { return {}; }
+    virtual Eigen::VectorXd get_tape_data_values() const { return {}; }
+    /// The tape data, in the scalar type of the problem; this is only valid
+    /// while the decorator evaluates the problem.
+    const VectorX<T>& get_tape_data() const { return m_tape_data; }
+    /// The decorator calls this with the tape data before evaluating the
+    /// objective and constraints. Override it to forward the data to an
+    /// object that evaluates part of the problem.
+    virtual void set_tape_data(const VectorX<T>& data) const
+    {   m_tape_data = data; }
+    /// @}
+
     /// Create an interface to this problem that can provide the derivatives
     /// of the objective and constraint functions. This is for use by the
     /// optimization solver, but users might call this if they are interested
@@ -75,6 +113,8 @@ public:
     //virtual void gradient(const std::vector<T>& x, std::vector<T>& grad) const;
     //virtual void jacobian(const std::vector<T>& x, TODO) const;
     //virtual void hessian() const;
+private:
+    mutable VectorX<T> m_tape_data;
 };
 
 template<typename T>
@@ -67,6 +67,11 @@ public:
     /// @see AbstractOptimizationProblem::make_random_iterate_within_bounds()
     Eigen::VectorXd make_random_iterate_within_bounds() const
     {   return m_problem.make_random_iterate_within_bounds(); }
+    /// @see AbstractProblem::calc_scaling()
+    void calc_scaling(const Eigen::VectorXd& guess,
+            Eigen::VectorXd& variable_scaling,
+            Eigen::VectorXd& constraint_scaling) const
+    {   m_problem.calc_scaling(guess, variable_scaling, constraint_scaling); }
     /// This function determines the sparsity pattern of the Jacobian and
     /// Hessian, using the provided variables.
     /// You must call this function first before calling calc_objective(),
@@ -114,10 +119,18 @@ public:
     ///  - "slow": Slower mode to be used only for debugging. Each nonzero of
     ///    the Hessian of the Lagrangian is computed separately.
     void set_findiff_hessian_mode(std::string value);
+    /// The number of threads used to evaluate the perturbed constraints when
+    /// approximating the Jacobian and Hessian (default: 1). Threads other than
+    /// the calling thread use copies of the problem from
+    /// Problem::clone_for_thread(); if the problem does not provide copies,
+    /// the derivatives are computed serially.
+    void set_findiff_num_threads(int value);
     /// @copydoc set_findiff_hessian_step_size()
     double get_findiff_hessian_step_size() const;
     /// @copydoc set_findiff_hessian_mode()
     const std::string& get_findiff_hessian_mode() const;
+    /// @copydoc set_findiff_num_threads()
+    int get_findiff_num_threads() const;
     /// @}
 
 protected:
@@ -128,6 +141,7 @@ private:
     int m_verbosity = 1;
     double m_findiff_hessian_step_size = 1e-5;
     std::string m_findiff_hessian_mode = "fast";
+    int m_findiff_num_threads = 1;
 };
 
 inline int ProblemDecorator::get_verbosity() const
@@ -136,6 +150,8 @@ inline double ProblemDecorator::get_findiff_hessian_step_size() const
 {   return m_findiff_hessian_step_size; }
 inline const std::string& ProblemDecorator::get_findiff_hessian_mode() const
 {   return m_findiff_hessian_mode; }
+inline int ProblemDecorator::get_findiff_num_threads() const
+{   return m_findiff_num_threads; }
 template<typename ...Types>
 inline void ProblemDecorator::print(
         const std::string& format_string, Types... args) const {
@@ -17,6 +17,9 @@
 #include <tropter/SparsityPattern.h>
 #include <tropter/Exception.hpp>
 
+#include <mutex>
+#include <unordered_map>
+
 #ifdef _MSC_VER
 // Ignore warnings from ADOL-C headers.
     #pragma warning(push)
@@ -36,6 +39,62 @@ using Eigen::Ref;
 namespace tropter {
 namespace optimization {
 
+/// The tags of the objective, constraints and Lagrangian tapes, and the
+/// sparsity patterns detected from them. The structure of the problem is
+/// stored so that a problem whose structure does not match the tapes is
+/// detected.
+struct Problem<adouble>::Decorator::Tapes {
+    Tapes(short int first_tag)
+            : objective_tag(first_tag), constraints_tag(first_tag + 1),
+              lagrangian_tag(first_tag + 2) {}
+    ~Tapes() {
+        // ADOL-C allocates this memory, but we must delete it.
+        delete [] jacobian_row_indices;
+        delete [] jacobian_col_indices;
+        delete [] hessian_row_indices;
+        delete [] hessian_col_indices;
+    }
+    short int objective_tag;
+    short int constraints_tag;
+    short int lagrangian_tag;
+
+    unsigned num_variables = 0;
+    unsigned num_constraints = 0;
+    Eigen::Index num_tape_data = 0;
+    /// Whether the objective and constraints have been traced and the
+    /// Jacobian sparsity has been detected.
+    bool traced = false;
+    /// Whether the Lagrangian has been traced and the Hessian sparsity has
+    /// been detected.
+    bool lagrangian_traced = false;
+
+    int jacobian_num_nonzeros = -1;
+    unsigned int* jacobian_row_indices = nullptr;
+    unsigned int* jacobian_col_indices = nullptr;
+
+    int hessian_num_nonzeros = -1;
+    unsigned int* hessian_row_indices = nullptr;
+    unsigned int* hessian_col_indices = nullptr;
+};
+
+std::shared_ptr<Problem<adouble>::Decorator::Tapes>
+Problem<adouble>::Decorator::find_or_create_tapes(const std::string& key) {
+    // Problems without a key reuse the first three tags (and overwrite each
+    // other's tapes).
+    if (key.empty()) return std::make_shared<Tapes>(1);
+
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<Tapes>> cache;
+    static short int next_tag = 4;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& tapes = cache[key];
+    if (!tapes) {
+        tapes = std::make_shared<Tapes>(next_tag);
+        next_tag += 3;
+    }
+    return tapes;
+}
+
 Problem<adouble>::Decorator::Decorator(
         const Problem<adouble>& problem) :
         ProblemDecorator(problem), m_problem(problem)
@@ -57,24 +116,7 @@ Problem<adouble>::Decorator::Decorator(
     m_sparse_hess_options[1] = 0;
 }
 
-Problem<adouble>::Decorator::~Decorator() {
-    if (m_jacobian_row_indices) {
-        delete [] m_jacobian_row_indices;
-        m_jacobian_row_indices = nullptr;
-    }
-    if (m_jacobian_col_indices) {
-        delete [] m_jacobian_col_indices;
-        m_jacobian_col_indices = nullptr;
-    }
-    if (m_hessian_row_indices) {
-        delete [] m_hessian_row_indices;
-        m_hessian_row_indices = nullptr;
-    }
-    if (m_hessian_col_indices) {
-        delete [] m_hessian_col_indices;
-        m_hessian_col_indices = nullptr;
-    }
-}
+Problem<adouble>::Decorator::~Decorator() = default;
 
 void Problem<adouble>::Decorator::
 calc_sparsity(const Eigen::VectorXd& x,
@@ -87,54 +129,79 @@ calc_sparsity(const Eigen::VectorXd& x,
     const auto& num_constraints = get_num_constraints();
 
     // This function also creates the ADOL-C tapes that are used in the other
-    // function calls.
-
-    // Objective.
-    // ----------
-    {
+    // function calls, unless tapes with the problem's key already exist.
+    const std::string key = m_problem.get_tape_key();
+    m_tapes = find_or_create_tapes(key);
+    m_tape_data_values = m_problem.get_tape_data_values();
+    const auto num_tape_data = m_tape_data_values.size();
+    auto& tapes = *m_tapes;
+
+    if (tapes.traced) {
+        TROPTER_THROW_IF(tapes.num_variables != num_variables ||
+                        tapes.num_constraints != num_constraints ||
+                        tapes.num_tape_data != num_tape_data,
+                "The tapes with key '%s' were recorded for a problem with %i "
+                "variables, %i constraints and %i tape data values, but this "
+                "problem has %i, %i and %i.",
+                key, (int)tapes.num_variables, (int)tapes.num_constraints,
+                (int)tapes.num_tape_data, (int)num_variables,
+                (int)num_constraints, (int)num_tape_data);
+        // Only the data differs from the problem that was traced.
+        if (num_tape_data) {
+            double* data = m_tape_data_values.data();
+            set_param_vec(tapes.objective_tag, num_tape_data, data);
+            set_param_vec(tapes.constraints_tag, num_tape_data, data);
+        }
+    } else {
+        tapes.num_variables = num_variables;
+        tapes.num_constraints = num_constraints;
+        tapes.num_tape_data = num_tape_data;
+
+        // Objective.
+        // ----------
         double obj_value; // We don't actually need the obj. value.
-        trace_objective(m_objective_tag, num_variables, x.data(), obj_value);
-    }
-
-    // Jacobian.
-    // ---------
-    // TODO allow user to provide multiple points at which to determine
-    // sparsity?
-    // TODO if (m_num_constraints)
-    {
+        trace_objective(tapes.objective_tag, num_variables, x.data(),
+                obj_value);
+
+        // Jacobian.
+        // ---------
+        // TODO allow user to provide multiple points at which to determine
+        // sparsity?
+        // TODO if (m_num_constraints)
         Eigen::VectorXd constraint_values(num_constraints); // Unused.
-        trace_constraints(m_constraints_tag,
+        trace_constraints(tapes.constraints_tag,
                 num_variables, x.data(),
                 num_constraints, constraint_values.data());
 
         int repeated_call = 0; // No previous call, need to create tape.
         double* jacobian_values = nullptr; // Unused.
-        int success = ::sparse_jac(m_constraints_tag, num_constraints,
+        int success = ::sparse_jac(tapes.constraints_tag, num_constraints,
                 num_variables, repeated_call, x.data(),
                 // The next 4 arguments are outputs.
-                &m_jacobian_num_nonzeros,
-                &m_jacobian_row_indices, &m_jacobian_col_indices,
+                &tapes.jacobian_num_nonzeros,
+                &tapes.jacobian_row_indices, &tapes.jacobian_col_indices,
                 &jacobian_values,
                 const_cast<int*>(m_sparse_jac_options.data()));
         //assert(success == 3);
         assert(success >= 0);
         delete [] jacobian_values;
-        jacobian_sparsity.row.resize(m_jacobian_num_nonzeros);
-        jacobian_sparsity.col.resize(m_jacobian_num_nonzeros);
-        // Copy ADOL-C's sparsity memory into Tropter's sparsity memory.
-        std::copy(m_jacobian_row_indices,
-                m_jacobian_row_indices + m_jacobian_num_nonzeros,
-                jacobian_sparsity.row.data());
-        std::copy(m_jacobian_col_indices,
-                m_jacobian_col_indices + m_jacobian_num_nonzeros,
-                jacobian_sparsity.col.data());
-        // TODO don't duplicate the memory consumption for storing the sparsity
-        // pattern: store the pointer to Ipopt's sparsity pattern?
+        tapes.traced = true;
 
         //SparsityPattern jac_sparsity(num_constraints, num_variables,
         //        jacobian_row_indices, jacobian_col_indices);
         //jac_sparsity.write("DEBUG_adolc_jacobian_sparsity.csv");
     }
+    jacobian_sparsity.row.resize(tapes.jacobian_num_nonzeros);
+    jacobian_sparsity.col.resize(tapes.jacobian_num_nonzeros);
+    // Copy ADOL-C's sparsity memory into Tropter's sparsity memory.
+    std::copy(tapes.jacobian_row_indices,
+            tapes.jacobian_row_indices + tapes.jacobian_num_nonzeros,
+            jacobian_sparsity.row.data());
+    std::copy(tapes.jacobian_col_indices,
+            tapes.jacobian_col_indices + tapes.jacobian_num_nonzeros,
+            jacobian_sparsity.col.data());
+    // TODO don't duplicate the memory consumption for storing the sparsity
+    // pattern: store the pointer to Ipopt's sparsity pattern?
 
     // Lagrangian.
     // -----------
@@ -142,35 +209,42 @@ calc_sparsity(const Eigen::VectorXd& x,
             "Cannot use supplied sparsity pattern for "
             "Hessian of Lagrangian when using automatic differentiation.");
     if (provide_hessian_sparsity) {
-        VectorXd lambda_vector = Eigen::VectorXd::Ones(num_constraints);
-        double lagr_value; // Unused.
-        trace_lagrangian(m_lagrangian_tag, num_variables, x.data(), 1.0,
-                num_constraints, lambda_vector.data(), lagr_value);
-        int repeated_call = 0; // No previous call, need to create tape.
-        double* hessian_values = nullptr; // Unused.
-        int status = ::sparse_hess(m_lagrangian_tag, num_variables,
-                repeated_call, x.data(), &m_hessian_num_nonzeros,
-                &m_hessian_row_indices, &m_hessian_col_indices,
-                &hessian_values,
-                const_cast<int*>(m_sparse_hess_options.data()));
-
-        // TODO See ADOL-C manual Table 1 to interpret the return value.
-        // TODO improve error handling.
-        assert(status >= 0);
-        delete [] hessian_values;
-        hessian_sparsity.row.resize(m_hessian_num_nonzeros);
-        hessian_sparsity.col.resize(m_hessian_num_nonzeros);
-        std::copy(m_hessian_row_indices,
-                m_hessian_row_indices + m_hessian_num_nonzeros,
+        if (!tapes.lagrangian_traced) {
+            VectorXd lambda_vector = Eigen::VectorXd::Ones(num_constraints);
+            double lagr_value; // Unused.
+            trace_lagrangian(tapes.lagrangian_tag, num_variables, x.data(),
+                    1.0, num_constraints, lambda_vector.data(), lagr_value);
+            int repeated_call = 0; // No previous call, need to create tape.
+            double* hessian_values = nullptr; // Unused.
+            int status = ::sparse_hess(tapes.lagrangian_tag, num_variables,
+                    repeated_call, x.data(), &tapes.hessian_num_nonzeros,
+                    &tapes.hessian_row_indices, &tapes.hessian_col_indices,
+                    &hessian_values,
+                    const_cast<int*>(m_sparse_hess_options.data()));
+
+            // TODO See ADOL-C manual Table 1 to interpret the return value.
+            // TODO improve error handling.
+            assert(status >= 0);
+            delete [] hessian_values;
+            tapes.lagrangian_traced = true;
+        }
+        hessian_sparsity.row.resize(tapes.hessian_num_nonzeros);
+        hessian_sparsity.col.resize(tapes.hessian_num_nonzeros);
+        std::copy(tapes.hessian_row_indices,
+                tapes.hessian_row_indices + tapes.hessian_num_nonzeros,
                 hessian_sparsity.row.data());
-        std::copy(m_hessian_col_indices,
-                m_hessian_col_indices + m_hessian_num_nonzeros,
+        std::copy(tapes.hessian_col_indices,
+                tapes.hessian_col_indices + tapes.hessian_num_nonzeros,
                 hessian_sparsity.col.data());
         // TODO don't duplicate the memory consumption for storing the sparsity
         // pattern: store the pointer to IPOPT's sparsity pattern?
 
-        // Working memory to hold obj_factor and lambda (multipliers).
-        m_hessian_obj_factor_lambda.resize(1 + num_constraints);
+        // Working memory to hold the tape data, obj_factor and lambda
+        // (multipliers).
+        m_hessian_obj_factor_lambda.resize(
+                num_tape_data + 1 + num_constraints);
+        std::copy_n(m_tape_data_values.data(), num_tape_data,
+                m_hessian_obj_factor_lambda.begin());
 
         //SparsityPattern hes_sparsity(num_variables, num_variables,
         //        hessian_sparsity.row, hessian_sparsity.col);
@@ -183,7 +257,7 @@ calc_objective(unsigned num_variables, const double* x,
         bool /*new_x*/,
         double& obj_value) const
 {
-    int status = ::function(m_objective_tag,
+    int status = ::function(m_tapes->objective_tag,
             1, // number of dependent variables.
             num_variables, // number of independent variables.
             // The signature of ::function() should take a const double*; I'm
@@ -202,7 +276,7 @@ calc_constraints(unsigned num_variables, const double* variables,
         unsigned num_constraints, double* constr) const
 {
     // Evaluate the constraints tape.
-    int status = ::function(m_constraints_tag,
+    int status = ::function(m_tapes->constraints_tag,
             num_constraints, // number of dependent variables.
             num_variables, // number of independent variables.
             // The signature of ::function() should take a const double*; I'm
@@ -216,7 +290,7 @@ void Problem<adouble>::Decorator::
 calc_gradient(unsigned num_variables, const double* x, bool /*new_x*/,
         double* grad) const
 {
-    int status = ::gradient(m_objective_tag, num_variables, x, grad);
+    int status = ::gradient(m_tapes->objective_tag, num_variables, x, grad);
     assert(status); // TODO error codes can be -2,-1,0,1,2,3; improve assert!
 }
 
@@ -225,10 +299,10 @@ calc_jacobian(unsigned num_variables, const double* x, bool /*new_x*/,
         unsigned /*num_nonzeros*/, double* jacobian_values) const
 {
     int repeated_call = 1; // We already have the sparsity structure.
-    int status = ::sparse_jac(m_constraints_tag, get_num_constraints(),
+    int status = ::sparse_jac(m_tapes->constraints_tag, get_num_constraints(),
             num_variables, repeated_call, x,
-            &m_jacobian_num_nonzeros,
-            &m_jacobian_row_indices, &m_jacobian_col_indices,
+            &m_tapes->jacobian_num_nonzeros,
+            &m_tapes->jacobian_row_indices, &m_tapes->jacobian_col_indices,
             &jacobian_values, const_cast<int*>(m_sparse_jac_options.data()));
     // TODO create enums for ADOL-C's return values.
     //assert(status == 3);
@@ -278,21 +352,30 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x,
     //    x_and_lambda[icon + num_variables] = lambda[icon];
     //}
 
-    // Update the passive parameters.
-    m_hessian_obj_factor_lambda[0] = obj_factor;
+    // Update the passive parameters (the tape data is already in place).
+    const auto num_tape_data = m_tape_data_values.size();
+    m_hessian_obj_factor_lambda[num_tape_data] = obj_factor;
     std::copy(lambda, lambda + num_constraints,
-            m_hessian_obj_factor_lambda.begin() + 1);
-    set_param_vec(m_lagrangian_tag, 1 + num_constraints,
+            m_hessian_obj_factor_lambda.begin() + num_tape_data + 1);
+    set_param_vec(m_tapes->lagrangian_tag, m_hessian_obj_factor_lambda.size(),
             m_hessian_obj_factor_lambda.data());
 
-    int status = sparse_hess(m_lagrangian_tag, num_variables, repeated_call,
-            x, &m_hessian_num_nonzeros, &m_hessian_row_indices,
-            &m_hessian_col_indices,
+    int status = sparse_hess(m_tapes->lagrangian_tag, num_variables,
+            repeated_call, x, &m_tapes->hessian_num_nonzeros,
+            &m_tapes->hessian_row_indices, &m_tapes->hessian_col_indices,
             &hessian_values,
             const_cast<int*>(m_sparse_hess_options.data()));
     assert(status >= 0);
 }
 
+void Problem<adouble>::Decorator::record_tape_data() const {
+    VectorXa data(m_tape_data_values.size());
+    for (Eigen::Index i = 0; i < data.size(); ++i) {
+        data[i] = ::mkparam(m_tape_data_values[i]);
+    }
+    m_problem.set_tape_data(data);
+}
+
 void Problem<adouble>::Decorator::
 trace_objective(short int tag,
         unsigned num_variables, const double* x,
@@ -305,6 +388,7 @@ trace_objective(short int tag,
     VectorXa x_adouble(num_variables);
     adouble f_adouble = 0;
     for (unsigned i = 0; i < num_variables; ++i) x_adouble[i] <<= x[i];
+    record_tape_data();
     m_problem.calc_objective(x_adouble, f_adouble);
     f_adouble >>= obj_value;
     trace_off();
@@ -326,6 +410,7 @@ trace_constraints(short int tag,
     VectorXa x_adouble(num_variables);
     // TODO efficiently store this result so it can be used in grad_f, etc.
     for (unsigned i = 0; i < num_variables; ++i) x_adouble[i] <<= x[i];
+    record_tape_data();
     VectorXa g_adouble(num_constraints);
     m_problem.calc_constraints(x_adouble, g_adouble);
     for (unsigned i = 0; i < num_constraints; ++i) g_adouble[i] >>= constr[i];
@@ -348,6 +433,9 @@ trace_lagrangian(short int tag,
     VectorXd lambda_vector = Eigen::VectorXd::Map(lambda, num_constraints);
     adouble lagrangian_adouble;
     for (unsigned i = 0; i < num_variables; ++i) x_adouble[i] <<= x[i];
+    // The tape data must be the first parameters on the tape; see
+    // calc_hessian_lagrangian().
+    record_tape_data();
 
     // TODO should not compute obj if obj_factor = 0 but this messes up with
     // ADOL-C.
@@ -19,6 +19,8 @@
 #include "Problem.h"
 #include "ProblemDecorator.h"
 
+#include <string>
+
 namespace tropter {
 
 struct SparsityCoordinates;
@@ -27,6 +29,12 @@ namespace optimization {
 
 /// This specialization uses automatic differentiation (via ADOL-C) to
 /// compute the derivatives of the objective and constraints.
+/// The tapes are recorded, and the sparsity patterns are detected, in
+/// calc_sparsity(). If the problem provides a tape key (see
+/// Problem::get_tape_key()), the tapes and sparsity patterns are retained
+/// for the rest of the process and shared by all decorators whose problems
+/// have the same key; only the tape data is updated for each problem. ADOL-C
+/// is not thread-safe, so problems must not be solved concurrently.
 /// @ingroup optimization
 template<>
 class Problem<adouble>::Decorator
@@ -56,6 +64,14 @@ public:
             unsigned num_constraints, const double* lambda, bool new_lambda,
             unsigned num_nonzeros, double* nonzeros) const override;
 private:
+    struct Tapes;
+    /// Tapes (and sparsity) for the given key; a new, unshared set of tapes
+    /// if the key is empty.
+    static std::shared_ptr<Tapes> find_or_create_tapes(const std::string& key);
+    /// Record the tape data as ADOL-C parameters on the current tape, and
+    /// hand them to the problem. This must be called before the problem is
+    /// evaluated on a tape.
+    void record_tape_data() const;
     void trace_objective(short int tag,
             unsigned num_variables, const double* variables,
             double& obj_value) const;
@@ -72,25 +88,14 @@ private:
 
     // ADOL-C
     // ------
-    // TODO if we want to be able to solve multiple problems at once, these
-    // cannot be static. We could create a registry of tags, and the tags can
-    // be "checked out" and "returned."
-    static const short int m_objective_tag   = 1;
-    static const short int m_constraints_tag = 2;
-    static const short int m_lagrangian_tag  = 3;
-
-    // We must hold onto the sparsity pattern for the Jacobian and
-    // Hessian so that we can pass them to subsequent calls to sparse_jac().
-    // ADOL-C allocates this memory, but we must delete it.
-    mutable int m_jacobian_num_nonzeros = -1;
-    mutable unsigned int* m_jacobian_row_indices = nullptr;
-    mutable unsigned int* m_jacobian_col_indices = nullptr;
+    // The tags of the tapes and the sparsity patterns we pass to subsequent
+    // calls to sparse_jac() and sparse_hess().
+    mutable std::shared_ptr<Tapes> m_tapes;
     std::vector<int> m_sparse_jac_options;
-
-    mutable int m_hessian_num_nonzeros = -1;
-    mutable unsigned int* m_hessian_row_indices = nullptr;
-    mutable unsigned int* m_hessian_col_indices = nullptr;
-    // Working memory for lambda multipliers and the "obj_factor."
+    // The values of the tape data for this problem.
+    mutable Eigen::VectorXd m_tape_data_values;
+    // Working memory for the tape data, lambda multipliers and the
+    // "obj_factor." (the parameters of the Lagrangian tape, in that order).
     mutable std::vector<double> m_hessian_obj_factor_lambda;
     std::vector<int> m_sparse_hess_options;
 };
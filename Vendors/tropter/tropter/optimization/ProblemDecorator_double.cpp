@@ -29,8 +29,11 @@
 //    #endif
 //#endif
 
+#include <mutex>
+
 using Eigen::VectorXd;
 
+
 // References for finite differences:
 // Nocedal and Wright
 // Betts 2010
@@ -52,7 +55,33 @@ Problem<double>::Decorator::~Decorator() {}
 
 Problem<double>::Decorator::Decorator(
         const Problem<double>& problem) :
-        ProblemDecorator(problem), m_problem(problem) {}
+        ProblemDecorator(problem), m_problem(problem) {
+    // Finite differences do not use tapes; the data is used directly.
+    m_problem.set_tape_data(m_problem.get_tape_data_values());
+}
+
+int Problem<double>::Decorator::prepare_thread_problems() const {
+    const int num_threads = get_findiff_num_threads();
+    while (!m_thread_problems_unavailable &&
+            (int)m_thread_problems.size() < num_threads - 1) {
+        auto copy = m_problem.clone_for_thread();
+        if (copy) {
+            copy->set_tape_data(m_problem.get_tape_data());
+            m_thread_problems.push_back(std::move(copy));
+        } else {
+            m_thread_problems_unavailable = true;
+            print("The problem does not implement clone_for_thread(); "
+                  "finite differences are computed with %i thread(s).",
+                    1 + (int)m_thread_problems.size());
+        }
+    }
+    return std::min(num_threads, 1 + (int)m_thread_problems.size());
+}
+
+const Problem<double>& Problem<double>::Decorator::get_thread_problem(
+        int thread) const {
+    return thread == 0 ? m_problem : *m_thread_problems[thread - 1];
+}
 
 void Problem<double>::Decorator::
 calc_sparsity(const Eigen::VectorXd& variables,
@@ -62,6 +91,7 @@ calc_sparsity(const Eigen::VectorXd& variables,
 {
     const auto num_vars = get_num_variables();
     m_x_working = VectorXd::Zero(num_vars);
+    m_problem.set_tape_data(m_problem.get_tape_data_values());
 
     // Gradient.
     // =========
@@ -273,19 +303,24 @@ calc_jacobian(unsigned num_variables, const double* variables, bool /*new_x*/,
     Eigen::Map<const VectorXd> x0(variables, num_variables);
 
     // Compute the dense "compressed Jacobian" using the directions ColPack
-    // told us to use.
-    // TODO for OpenMP: Trapezoidal has working memory!
-    //#pragma omp parallel for firstprivate(m_constr_pos, m_constr_neg)
-    for (Eigen::Index iseed = 0; iseed < num_seeds; ++iseed) {
+    // told us to use. Each seed (color) fills its own column, so the seeds
+    // can be distributed across threads, each with its own copy of the
+    // problem and working memory.
+    const int num_threads = prepare_thread_problems();
+    std::vector<VectorXd> constr_pos(num_threads - 1, m_constr_pos);
+    std::vector<VectorXd> constr_neg(num_threads - 1, m_constr_neg);
+    parallel_for((int)num_seeds, num_threads, [&](int iseed, int thread) {
+        const Problem<double>& problem = get_thread_problem(thread);
+        VectorXd& pos = thread == 0 ? m_constr_pos : constr_pos[thread - 1];
+        VectorXd& neg = thread == 0 ? m_constr_neg : constr_neg[thread - 1];
         const auto direction = seed.col(iseed);
         // Perturb x in the positive direction.
-        m_problem.calc_constraints(x0 + eps * direction, m_constr_pos);
+        problem.calc_constraints(x0 + eps * direction, pos);
         // Perturb x in the negative direction.
-        m_problem.calc_constraints(x0 - eps * direction, m_constr_neg);
+        problem.calc_constraints(x0 - eps * direction, neg);
         // Compute central difference.
-        m_jacobian_compressed.col(iseed) =
-                (m_constr_pos - m_constr_neg) / two_eps;
-    }
+        m_jacobian_compressed.col(iseed) = (pos - neg) / two_eps;
+    });
 
     m_jacobian_coloring->recover(m_jacobian_compressed, jacobian_values);
 }
@@ -336,41 +371,70 @@ calc_hessian_lagrangian(unsigned num_variables, const double* x_raw,
     // Allocate memory (TODO preallocate once in calc_sparsity()).
     // Compressed Hessian of constraints.
     Eigen::MatrixXd hescon_c(num_variables, num_hescon_seeds);
-    // Double-compressed second derivatives; same shape as a compressed
-    // Jacobian. Used in the inner loop.
-    Eigen::MatrixXd hescon_cc(num_constraints, num_jac_seeds);
-    // Store perturbed values of constraints.
-    VectorXd p2(num_constraints);
-    VectorXd p3(num_constraints);
-    VectorXd p4(num_constraints);
-
-    // Loop through Hessian seeds.
-    for (int ihesseed = 0; ihesseed < num_hescon_seeds; ++ihesseed) {
+    const int num_threads = prepare_thread_problems();
+
+    // The constraints perturbed along each Jacobian seed do not depend on the
+    // Hessian seed, so compute them once.
+    Eigen::MatrixXd p3(num_constraints, num_jac_seeds);
+    parallel_for((int)num_jac_seeds, num_threads,
+            [&](int ijacseed, int thread) {
+                VectorXd p3_col = VectorXd::Zero(num_constraints);
+                get_thread_problem(thread).calc_constraints(
+                        x0 + eps * jac_seed.col(ijacseed), p3_col);
+                p3.col(ijacseed) = p3_col;
+            });
+
+    // Working memory for each thread.
+    struct Workspace {
+        // Double-compressed second derivatives; same shape as a compressed
+        // Jacobian. Used in the inner loop.
+        Eigen::MatrixXd hescon_cc;
+        // Store perturbed values of constraints.
+        VectorXd p2;
+        VectorXd p4;
+        Eigen::VectorXd Bgunc_coeffs;
+    };
+    std::vector<Workspace> workspaces(num_threads);
+    for (auto& workspace : workspaces) {
+        workspace.hescon_cc.resize(num_constraints, num_jac_seeds);
+        workspace.p2.resize(num_constraints);
+        workspace.p4.resize(num_constraints);
+        workspace.Bgunc_coeffs.resize(num_jac_nonzeros);
+    }
+    // The JacobianColoring uses internal working memory to recover.
+    std::mutex coloring_mutex;
+
+    // Loop through Hessian seeds; each fills its own column of hescon_c.
+    parallel_for((int)num_hescon_seeds, num_threads,
+            [&](int ihesseed, int thread) {
+        const Problem<double>& problem = get_thread_problem(thread);
+        Workspace& w = workspaces[thread];
         const auto hes_direction = hescon_seed.col(ihesseed);
         VectorXd xb = x0 + eps * hes_direction;
-        p2.setZero();
-        m_problem.calc_constraints(xb, p2);
+        w.p2.setZero();
+        problem.calc_constraints(xb, w.p2);
 
         for (int ijacseed = 0; ijacseed < num_jac_seeds; ++ijacseed) {
             const auto jac_direction = jac_seed.col(ijacseed);
-            p3.setZero();
-            m_problem.calc_constraints(x0 + eps * jac_direction, p3);
-            p4.setZero();
-            m_problem.calc_constraints(xb + eps * jac_direction, p4);
+            w.p4.setZero();
+            problem.calc_constraints(xb + eps * jac_direction, w.p4);
 
             // Finite difference.
-            hescon_cc.col(ijacseed) = (p1 - p2 - p3 + p4) / eps_squared;
+            w.hescon_cc.col(ijacseed) =
+                    (p1 - w.p2 - p3.col(ijacseed) + w.p4) / eps_squared;
         }
 
         // Recover (uncompress).
-        Eigen::VectorXd Bgunc_coeffs(num_jac_nonzeros);
-        m_jacobian_coloring->recover(hescon_cc, Bgunc_coeffs.data());
         // TODO preallocate:
         Eigen::SparseMatrix<double> Bgunc;
-        m_jacobian_coloring->convert(Bgunc_coeffs.data(), Bgunc);
+        {
+            std::lock_guard<std::mutex> lock(coloring_mutex);
+            m_jacobian_coloring->recover(w.hescon_cc, w.Bgunc_coeffs.data());
+            m_jacobian_coloring->convert(w.Bgunc_coeffs.data(), Bgunc);
+        }
 
         hescon_c.col(ihesseed) = Bgunc.transpose() * lambda;
-    }
+    });
 
     // Convert the compressed Hessian of constraints into a SparseMatrix, for
     // ease of combining with Hessian of objective.
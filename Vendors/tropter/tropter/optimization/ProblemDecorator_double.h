@@ -21,6 +21,9 @@
 
 #include <tropter/SparsityPattern.h>
 
+#include <memory>
+#include <vector>
+
 namespace tropter {
 
 namespace optimization {
@@ -83,8 +86,21 @@ private:
             const Eigen::Map<const Eigen::VectorXd>& lambda,
             double& lagrangian_value) const;
 
+    // Create any copies of the problem needed for the number of threads
+    // requested with set_findiff_num_threads(), and return the number of
+    // threads that can be used.
+    int prepare_thread_problems() const;
+    // The problem evaluated by the given thread (0 is the calling thread).
+    const Problem<double>& get_thread_problem(int thread) const;
+
     const Problem<double>& m_problem;
 
+    // Copies of the problem for threads other than the calling thread.
+    mutable std::vector<std::unique_ptr<const Problem<double>>>
+            m_thread_problems;
+    // True if the problem does not implement clone_for_thread().
+    mutable bool m_thread_problems_unavailable = false;
+
     // Working memory shared by multiple functions.
     mutable Eigen::VectorXd m_x_working;
 
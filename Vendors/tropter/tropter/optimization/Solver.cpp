@@ -82,6 +82,12 @@ void Solver::set_sparsity_detection(std::string v) {
 const std::string& Solver::get_sparsity_detection() const {
     return m_sparsity_detection;
 }
+void Solver::set_automatic_scaling(bool v) {
+    m_automatic_scaling = v;
+}
+bool Solver::get_automatic_scaling() const {
+    return m_automatic_scaling;
+}
 
 void Solver::set_findiff_hessian_mode(std::string v) {
     m_problem->set_findiff_hessian_mode(std::move(v));
@@ -89,6 +95,9 @@ void Solver::set_findiff_hessian_mode(std::string v) {
 void Solver::set_findiff_hessian_step_size(double v) {
     m_problem->set_findiff_hessian_step_size(v);
 }
+void Solver::set_findiff_num_threads(int v) {
+    m_problem->set_findiff_num_threads(v);
+}
 
 void Solver::print_option_values(std::ostream& stream) const {
     const std::string unset("<unset>");
@@ -100,10 +100,19 @@ public:
     ///   - "random": perturb about a random point.
     void set_sparsity_detection(std::string v);
 
+    /// Scale the variables and constraints using the magnitudes from
+    /// AbstractProblem::calc_scaling(), evaluated at the initial guess
+    /// (default: false). The problem and its solution are unchanged; only
+    /// the problem seen by the underlying solver is scaled.
+    /// @note This setting currently takes effect only when using IPOPT.
+    void set_automatic_scaling(bool v);
+
     /// @copydoc ProblemDecorator::set_findiff_hessian_mode()
     void set_findiff_hessian_mode(std::string v);
     /// @copydoc ProblemDecorator::set_findiff_hessian_step_size()
     void set_findiff_hessian_step_size(double value);
+    /// @copydoc ProblemDecorator::set_findiff_num_threads()
+    void set_findiff_num_threads(int value);
     /// @}
 
     /// @name Set solver-specific advanced options.
@@ -146,6 +155,8 @@ public:
     /// @copydoc set_hessian_approximation()
     Optional<std::string> get_hessian_approximation() const;
     const std::string& get_sparsity_detection() const;
+    /// @copydoc set_automatic_scaling()
+    bool get_automatic_scaling() const;
     /// @}
 
 protected:
@@ -193,6 +204,7 @@ private:
     std::string m_jacobian_approximation = "exact";
     Optional<std::string> m_hessian_approximation;
     std::string m_sparsity_detection = "initial-guess";
+    bool m_automatic_scaling = false;
 
     OptionsMap<std::string> m_advanced_options_string;
     OptionsMap<int> m_advanced_options_int;
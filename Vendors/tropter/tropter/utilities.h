@@ -16,8 +16,12 @@
 // limitations under the License.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace tropter {
@@ -26,6 +30,40 @@ std::string format(const char* format, ...);
 
 std::vector<double> linspace(double start, double end, int length);
 
+/// Call function(index, thread) for each index in [0, size), distributing the
+/// indices across up to num_threads threads. Thread 0 is the calling thread,
+/// so the thread index can be used to select per-thread working memory.
+/// If any call throws, the remaining indices are skipped and the first
+/// exception is rethrown once all threads have finished.
+template <typename F>
+void parallel_for(int size, int num_threads, F function) {
+    num_threads = std::max(1, std::min(num_threads, size));
+    if (num_threads == 1) {
+        for (int i = 0; i < size; ++i) function(i, 0);
+        return;
+    }
+    std::atomic<int> next(0);
+    std::vector<std::exception_ptr> errors(num_threads);
+    auto worker = [&](int thread) {
+        try {
+            int i;
+            while ((i = next++) < size) function(i, thread);
+        } catch (...) {
+            errors[thread] = std::current_exception();
+            next = size;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int thread = 1; thread < num_threads; ++thread) {
+        threads.emplace_back(worker, thread);
+    }
+    worker(0);
+    for (auto& thread : threads) thread.join();
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
 /// This class stores the formatting of a stream and restores that format
 /// when the StreamFormat is destructed.
 /// This is useful when you want to make temporary changes to the formatting of